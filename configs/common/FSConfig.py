@@ -775,6 +775,7 @@ def makeDistRoot(
     linkspeed,
     linkdelay,
     dumpfile,
+    transport="tcp",
 ):
     self = Root(full_system=True)
     self.testsys = testSystem
@@ -786,6 +787,7 @@ def makeDistRoot(
         dist_size=size,
         server_name=server_name,
         server_port=server_port,
+        transport=transport,
         sync_start=sync_start,
         sync_repeat=sync_repeat,
     )
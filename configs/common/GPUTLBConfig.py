@@ -33,6 +33,7 @@
 # comment
 import m5
 from m5.objects import *
+from m5.util import fatal
 
 
 def TLB_constructor(options, level, gpu_ctrl=None, full_system=False):
@@ -118,9 +119,50 @@ def create_TLB_Coalescer(
         )
 
 
+def _l1_tlb_eventq(options, name, index, width, cu_eventqs):
+    """Get the event queue of the CUs served by an L1 TLB."""
+    n_cu = options.num_compute_units
+    if name == "sqc":
+        cus = range(
+            index * options.cu_per_sqc, (index + 1) * options.cu_per_sqc
+        )
+    elif name == "scalar":
+        cus = range(
+            index * options.cu_per_scalar_cache,
+            (index + 1) * options.cu_per_scalar_cache,
+        )
+    elif width >= n_cu:
+        tlb_per_cu = width // n_cu
+        cus = [index // tlb_per_cu]
+    else:
+        cu_per_tlb = n_cu // width
+        cus = range(index * cu_per_tlb, (index + 1) * cu_per_tlb)
+
+    eventqs = set(cu_eventqs[cu] for cu in cus if cu < n_cu)
+    if len(eventqs) != 1:
+        fatal(
+            "The CUs sharing %s TLB %d must be on the same event queue"
+            % (name, index)
+        )
+    return eventqs.pop()
+
+
 def config_tlb_hierarchy(
-    options, system, shader_idx, gpu_ctrl=None, full_system=False
+    options,
+    system,
+    shader_idx,
+    gpu_ctrl=None,
+    full_system=False,
+    cu_eventqs=None,
+    crossing_latency="1ns",
 ):
+    """Create the GPU TLB hierarchy and connect it to the compute units.
+
+    cu_eventqs optionally lists the event queue of every compute unit. The
+    L1 TLBs and coalescers are then placed on the event queue of the CUs
+    they serve, and reach the L2 coalescer through a ThreadBridge that adds
+    crossing_latency to every request and response crossing event queues.
+    """
     n_cu = options.num_compute_units
 
     if options.TLB_config == "perLane":
@@ -284,13 +326,33 @@ def config_tlb_hierarchy(
     l2_coalescer_index = 0
     for TLB_type in L1:
         name = TLB_type["name"]
+        bridges = []
         for index in range(TLB_type["width"]):
-            exec(
-                "system.%s_tlb[%d].mem_side_ports[0] = \
-                    system.l2_coalescer[0].cpu_side_ports[%d]"
-                % (name, index, l2_coalescer_index)
-            )
+            if cu_eventqs:
+                # Move the L1 TLB next to its CUs. The bridge stays on the
+                # event queue of the system, like the L2 TLB.
+                eventq = _l1_tlb_eventq(
+                    options, name, index, TLB_type["width"], cu_eventqs
+                )
+                tlb = getattr(system, name + "_tlb")[index]
+                coalescer = getattr(system, name + "_coalescer")[index]
+                tlb.eventq_index = eventq
+                coalescer.eventq_index = eventq
+                bridge = ThreadBridge(delay=crossing_latency)
+                tlb.mem_side_ports[0] = bridge.in_port
+                bridge.out_port = system.l2_coalescer[0].cpu_side_ports[
+                    l2_coalescer_index
+                ]
+                bridges.append(bridge)
+            else:
+                exec(
+                    "system.%s_tlb[%d].mem_side_ports[0] = \
+                        system.l2_coalescer[0].cpu_side_ports[%d]"
+                    % (name, index, l2_coalescer_index)
+                )
             l2_coalescer_index += 1
+        if bridges:
+            setattr(system, name + "_tlb_bridge", bridges)
 
     # L2 <-> L3
     system.l2_tlb[0].mem_side_ports[0] = system.l3_coalescer[0].cpu_side_ports[
@@ -424,6 +424,14 @@ def addCommonOptions(parser, default_isa: Optional[ISA] = None):
         type=int,
         help="Message server listen port\nDEFAULT: 2200",
     )
+    parser.add_argument(
+        "--dist-transport",
+        default="tcp",
+        choices=["tcp", "shm"],
+        help="Transport between the dist-gem5 processes. 'shm' requires "
+        "all the processes to run on the same host and uses "
+        "--dist-server-port as the key of the run\nDEFAULT: tcp",
+    )
     parser.add_argument(
         "--dist-sync-repeat",
         default="0us",
@@ -432,6 +440,12 @@ def addCommonOptions(parser, default_isa: Optional[ISA] = None):
         help="Repeat interval for synchronisation barriers among "
         "dist-gem5 processes\nDEFAULT: --ethernet-linkdelay",
     )
+    parser.add_argument(
+        "--dist-sync-adaptive",
+        action="store_true",
+        help="Widen the synchronisation interval up to the link delay "
+        "while the network is idle (switch only)",
+    )
     parser.add_argument(
         "--dist-sync-start",
         default="5200000000000t",
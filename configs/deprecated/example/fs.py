@@ -401,6 +401,7 @@ elif len(bm) == 1 and args.dist:
         args.ethernet_linkspeed,
         args.ethernet_linkdelay,
         args.etherdump,
+        args.dist_transport,
     )
 elif len(bm) == 1:
     root = Root(full_system=True, system=test_sys)
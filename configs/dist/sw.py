@@ -54,8 +54,10 @@ def build_switch(args):
             dist_size=args.dist_size,
             server_name=args.dist_server_name,
             server_port=args.dist_server_port,
+            transport=args.dist_transport,
             sync_start=args.dist_sync_start,
             sync_repeat=args.dist_sync_repeat,
+            sync_adaptive=args.dist_sync_adaptive,
             is_switch=True,
             num_nodes=args.dist_size,
         )
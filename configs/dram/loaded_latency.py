@@ -0,0 +1,314 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script measures loaded latency curves, i.e. the average latency
+# seen by a traffic generator as a function of the bandwidth it
+# achieves, for one or more memory configurations. Each configuration
+# gets a system of its own with a PyTrafficGen, and all of them are
+# swept in the same simulation. Every phase of the sweep injects
+# traffic at a fixed rate and read/write mix, starting with a warm-up
+# window that is excluded from the measurements. The rate is ramped
+# until the memory no longer sustains the offered bandwidth, after
+# which the sweep moves on to the next mix.
+
+import argparse
+import os
+
+import m5
+from m5.objects import *
+from m5.util import (
+    addToPath,
+    convert,
+    fatal,
+)
+
+addToPath("../")
+
+from common import (
+    MemConfig,
+    ObjectList,
+)
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+
+parser.add_argument(
+    "--mem-type",
+    default=["DDR4_2400_8x8"],
+    nargs="+",
+    choices=ObjectList.mem_list.get_names(),
+    help="Memory configurations to sweep, one system per configuration",
+)
+
+parser.add_argument(
+    "--mem-channels", type=int, default=1, help="Number of memory channels"
+)
+
+parser.add_argument(
+    "--mem-ranks", type=int, default=None, help="Number of ranks per channel"
+)
+
+parser.add_argument(
+    "--mode",
+    default="random",
+    choices=["linear", "random"],
+    help="Address pattern of the injected traffic",
+)
+
+parser.add_argument(
+    "--rd-perc",
+    type=int,
+    default=[100, 67, 50],
+    nargs="+",
+    help="Read percentages of the mixes to sweep",
+)
+
+parser.add_argument(
+    "--min-rate",
+    type=float,
+    default=1.0,
+    help="Lowest injection rate of the ramp in GB/s",
+)
+
+parser.add_argument(
+    "--max-rate",
+    type=float,
+    default=64.0,
+    help="Highest injection rate of the ramp in GB/s",
+)
+
+parser.add_argument(
+    "--rate-step",
+    type=float,
+    default=1.0,
+    help="Increment of the injection rate in GB/s",
+)
+
+parser.add_argument(
+    "--block-size", type=int, default=64, help="Size of each request in bytes"
+)
+
+parser.add_argument(
+    "--warmup",
+    default="5us",
+    help="Time at the start of each phase excluded from the measurements",
+)
+
+parser.add_argument(
+    "--period", default="20us", help="Measured time of each phase"
+)
+
+parser.add_argument(
+    "--saturation",
+    type=float,
+    default=0.05,
+    help="Fraction by which the achieved bandwidth may fall short of the "
+    "offered one before the memory is considered saturated",
+)
+
+parser.add_argument(
+    "--post-saturation",
+    type=int,
+    default=1,
+    help="Number of rates to measure beyond the saturation point",
+)
+
+parser.add_argument(
+    "--max-outstanding",
+    type=int,
+    default=0,
+    help="Maximum requests outstanding per generator, 0 for unlimited",
+)
+
+args = parser.parse_args()
+
+if args.rate_step <= 0 or args.min_rate <= 0 or args.max_rate < args.min_rate:
+    fatal("The injection rates must be positive and increasing")
+
+warmup_secs = convert.toLatency(args.warmup)
+period_secs = convert.toLatency(args.period)
+
+# all systems share the memory range, and there is no point in
+# reserving space for the backing store or keeping the data
+mem_range = AddrRange("256MB")
+args.external_memory_system = 0
+args.tlm_memory = 0
+args.elastic_trace_en = 0
+
+
+class Sweep:
+    """
+    The sweep of one memory configuration. The traffic generator pulls
+    its states from traffic(), which injects according to the phase
+    set up by the script, and idles in between phases so that the next
+    one is only picked once the previous one has been measured.
+    """
+
+    def __init__(self, mem_type):
+        self.mem_type = mem_type
+        self.mixes = list(args.rd_perc)
+        self.rate = args.min_rate
+        self.beyond = None
+        self.results = []
+        self.system = self._build()
+
+    def _build(self):
+        system = System(membus=IOXBar(width=32))
+        system.clk_domain = SrcClockDomain(
+            clock="2.0GHz", voltage_domain=VoltageDomain(voltage="1V")
+        )
+        system.mem_ranges = [mem_range]
+        system.mmap_using_noreserve = True
+        system.mem_mode = "timing"
+
+        args.mem_type = self.mem_type
+        MemConfig.config_mem(args, system)
+        for ctrl in system.mem_ctrls:
+            for intf in ("dram", "nvm"):
+                if hasattr(ctrl, intf):
+                    getattr(ctrl, intf).null = True
+
+        system.tgen = PyTrafficGen(
+            max_outstanding_reqs=args.max_outstanding,
+            progress_check="%gs" % max(2 * (warmup_secs + period_secs), 1e-3),
+        )
+        system.tgen.port = system.membus.cpu_side_ports
+        system.system_port = system.membus.cpu_side_ports
+        return system
+
+    def done(self):
+        return not self.mixes
+
+    def traffic(self):
+        tgen = self.system.tgen
+        while True:
+            duration = max(phase_end - m5.curTick(), 1)
+            if self.done():
+                yield tgen.createIdle(duration)
+            else:
+                create = getattr(tgen, "create" + args.mode.capitalize())
+                itt = int(ticks_per_sec * args.block_size / (self.rate * 1e9))
+                yield create(
+                    duration,
+                    0,
+                    mem_range.end,
+                    args.block_size,
+                    itt,
+                    itt,
+                    self.mixes[0],
+                    0,
+                )
+            yield tgen.createIdle(1)
+
+    def _stat(self, name):
+        return self.system.tgen.resolveStat(name).value
+
+    def measure(self):
+        """Record the phase just completed and pick the next one"""
+        if self.done():
+            return
+
+        secs = (phase_end - warm_end) / ticks_per_sec
+        data = self._stat("bytesRead") + self._stat("bytesWritten")
+        achieved = data / secs / 1e9
+
+        def latency(total, count):
+            count = self._stat(count)
+            if not count:
+                return float("nan")
+            return self._stat(total) / count / ticks_per_sec * 1e9
+
+        rd_lat = latency("totalReadLatency", "totalReads")
+        wr_lat = latency("totalWriteLatency", "totalWrites")
+        saturated = achieved < self.rate * (1 - args.saturation)
+        self.results.append(
+            (self.mixes[0], self.rate, achieved, rd_lat, wr_lat, saturated)
+        )
+
+        if saturated and self.beyond is None:
+            self.beyond = args.post_saturation
+        elif self.beyond is not None:
+            self.beyond -= 1
+
+        self.rate += args.rate_step
+        if self.beyond == 0 or self.rate > args.max_rate:
+            self.mixes.pop(0)
+            self.rate = args.min_rate
+            self.beyond = None
+
+
+sweeps = [Sweep(mem_type) for mem_type in args.mem_type]
+
+root = Root(full_system=False)
+root.system = [sweep.system for sweep in sweeps]
+
+m5.instantiate()
+
+warmup = int(m5.ticks.fromSeconds(warmup_secs))
+period = int(m5.ticks.fromSeconds(period_secs))
+ticks_per_sec = m5.ticks.fromSeconds(1)
+
+# the phases are kept in lock-step across the systems, so that the
+# stats can be reset and dumped for all of them at the same time
+warm_end = m5.curTick() + warmup
+phase_end = warm_end + period
+for sweep in sweeps:
+    sweep.system.tgen.start(sweep.traffic())
+
+while not all(sweep.done() for sweep in sweeps):
+    m5.simulate(warm_end - m5.curTick())
+    m5.stats.reset()
+    m5.simulate(phase_end - m5.curTick())
+    m5.stats.dump()
+
+    for sweep in sweeps:
+        sweep.measure()
+
+    warm_end = m5.curTick() + warmup
+    phase_end = warm_end + period
+
+header = "%-8s %10s %10s %10s %10s %s" % (
+    "rd_perc",
+    "offered",
+    "achieved",
+    "rd_lat",
+    "wr_lat",
+    "saturated",
+)
+with open(os.path.join(m5.options.outdir, "loaded_latency.csv"), "w") as csv:
+    csv.write("mem_type,rd_perc,offered_GBps,achieved_GBps,")
+    csv.write("rd_lat_ns,wr_lat_ns,saturated\n")
+    for sweep in sweeps:
+        print(f"\nLoaded latency for {sweep.mem_type} (GB/s, ns)")
+        print(header)
+        for rd_perc, rate, achieved, rd_lat, wr_lat, sat in sweep.results:
+            print(
+                "%-8d %10.2f %10.2f %10.1f %10.1f %s"
+                % (rd_perc, rate, achieved, rd_lat, wr_lat, "*" if sat else "")
+            )
+            row = (sweep.mem_type, rd_perc, rate, achieved, rd_lat, wr_lat)
+            csv.write("%s,%d,%.3f,%.3f,%.2f,%.2f,%d\n" % (row + (sat,)))
@@ -52,6 +52,7 @@ from common import (
     Options,
     Simulation,
 )
+from network import Network
 from ruby import Ruby
 
 # Adding script options
@@ -100,6 +101,39 @@ parser.add_argument(
 parser.add_argument(
     "--simds-per-cu", type=int, default=4, help="SIMD unitsper CU"
 )
+parser.add_argument(
+    "--cu-eventqs",
+    type=int,
+    default=1,
+    help="Number of groups of CUs simulated on their own event queue, and "
+    "thus on their own host thread. A group holds a multiple of "
+    "--cu-per-sqc and --cu-per-scalar-cache CUs. This requires the simple "
+    "network.",
+)
+parser.add_argument(
+    "--cu-crossing-latency",
+    type=str,
+    default="1ns",
+    help="Latency of a TLB request or response crossing between the event "
+    "queue of a CU group and the rest of the GPU",
+)
+parser.add_argument(
+    "--functional-kernels",
+    type=int,
+    default=0,
+    help="Fast-forward through this many GPU kernels (counting only "
+    "non-blit kernels) by executing them functionally, then simulate the "
+    "remaining kernels in timing mode. The stats are reset when the "
+    "switch happens.",
+)
+parser.add_argument(
+    "--kernel-samples",
+    type=int,
+    default=0,
+    help="Simulate this many launches of each distinct GPU kernel in "
+    "detail, execute the later launches functionally and extrapolate "
+    "their timing from the samples (0 disables kernel sampling).",
+)
 parser.add_argument(
     "--cu-per-sa",
     type=int,
@@ -443,6 +477,22 @@ args.num_sqc = num_sqc  # pass this to Ruby
 num_scalar_cache = int(math.ceil(float(n_cu) / args.cu_per_scalar_cache))
 args.num_scalar_cache = num_scalar_cache
 
+# Split the CUs in groups with their own event queue. The CUs sharing an
+# SQC or a scalar cache can't be split.
+cu_eventqs = None
+if args.cu_eventqs > 1:
+    cu_group_unit = (
+        args.cu_per_sqc
+        * args.cu_per_scalar_cache
+        // math.gcd(args.cu_per_sqc, args.cu_per_scalar_cache)
+    )
+    cu_group_size = int(math.ceil(float(n_cu) / args.cu_eventqs))
+    cu_group_size = cu_group_unit * int(
+        math.ceil(float(cu_group_size) / cu_group_unit)
+    )
+    cu_eventqs = [1 + i // cu_group_size for i in range(n_cu)]
+    print("CU groups = ", cu_eventqs[-1], "CUs per group = ", cu_group_size)
+
 print(
     "Num SQC = ",
     num_sqc,
@@ -594,6 +644,9 @@ for i in range(n_cu):
 
 # Attach compute units to GPU
 shader.CUs = compute_units
+if cu_eventqs:
+    for cu, eventq in zip(compute_units, cu_eventqs):
+        cu.eventq_index = eventq
 
 ########################## Creating the CPU system ########################
 # The shader core will be whatever is after the CPU cores are accounted for
@@ -707,8 +760,14 @@ render_driver = GPURenderDriver(filename=f"dri/renderD{renderDriNum}")
 gpu_hsapp = HSAPacketProcessor(
     pioAddr=hsapp_gpu_map_paddr, numHWQueues=args.num_hw_queues
 )
-dispatcher = GPUDispatcher(kernel_exit_events=True)
-gpu_cmd_proc = GPUCommandProcessor(hsapp=gpu_hsapp, dispatcher=dispatcher)
+dispatcher = GPUDispatcher(
+    kernel_exit_events=True, kernel_samples=args.kernel_samples
+)
+gpu_cmd_proc = GPUCommandProcessor(
+    hsapp=gpu_hsapp,
+    dispatcher=dispatcher,
+    functional_non_blit_kernel_id=args.functional_kernels,
+)
 gpu_driver.device = gpu_cmd_proc
 shader.dispatcher = dispatcher
 shader.gpu_cmd_proc = gpu_cmd_proc
@@ -832,7 +891,13 @@ if fast_forward:
         fatal("KvmCPU can only be used in SE mode with x86")
 
 # configure the TLB hierarchy
-GPUTLBConfig.config_tlb_hierarchy(args, system, shader_idx)
+GPUTLBConfig.config_tlb_hierarchy(
+    args,
+    system,
+    shader_idx,
+    cu_eventqs=cu_eventqs,
+    crossing_latency=args.cu_crossing_latency,
+)
 
 system.exit_on_work_items = True
 
@@ -927,6 +992,30 @@ for i in range(n_cu):
     ].in_ports
 gpu_port_idx = gpu_port_idx + 1
 
+# Move the caches of every CU group, and their routers, to the event queue of
+# the group. Only the internal links of the network cross event queues.
+if cu_eventqs:
+    cntrl_eventqs = {}
+    for i in range(n_cu):
+        cu = system.cpu[shader_idx].CUs[i]
+        for port in (cu.memory_port[0], cu.sqc_port, cu.scalar_port):
+            cntrl = port.peer.simobj.get_parent()
+            cntrl_eventqs[cntrl] = cu_eventqs[i]
+
+    router_eventqs = {}
+    for link in system.ruby.network.ext_links:
+        router_id = link.int_node.router_id
+        eventq = cntrl_eventqs.get(link.ext_node, 0)
+        if router_eventqs.setdefault(router_id, eventq) != eventq:
+            fatal(
+                "Router %d connects controllers of different CU groups"
+                % router_id
+            )
+    Network.partition_network(
+        system.ruby.network,
+        {r: eventq for r, eventq in router_eventqs.items() if eventq},
+    )
+
 # attach CP ports to Ruby
 for i in range(args.num_cp):
     system.cpu[cp_idx].createInterruptController()
@@ -1024,6 +1113,9 @@ while True:
         m5.checkpoint(args.checkpoint_dir)
         print("breaking loop with checkpoint")
         break
+    elif "GPU Functional Kernels Done" in exit_event.getCause():
+        print("GPU functional kernels done, reset stats")
+        m5.stats.reset()
     elif "GPU Kernel Completed" in exit_event.getCause():
         print("GPU Kernel Completed dump and reset")
         m5.stats.dump()
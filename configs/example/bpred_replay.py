@@ -0,0 +1,86 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Replay a branch trace through one or more branch predictors and report
+their mispredictions per thousand instructions (MPKI).
+
+The trace is recorded by attaching a BranchTraceRecorder to a core, e.g.:
+
+    cpu.branchTracer = BranchTraceRecorder(manager=cpu)
+
+Each predictor given on the command line gets a replayer of its own, so a
+whole sweep of predictor configurations costs a single pass over the
+trace:
+
+    gem5.opt configs/example/bpred_replay.py \
+        m5out/system.cpu.branchTracer.trc.gz TAGE_SC_L_64KB LTAGE BiModeBP
+
+The MPKI of each predictor is the mpki stat of its replayer.
+"""
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath("../")
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser(
+    description=__doc__, formatter_class=argparse.RawTextHelpFormatter
+)
+parser.add_argument("trace", help="branch trace to replay")
+parser.add_argument(
+    "predictors",
+    nargs="+",
+    choices=ObjectList.bp_list.get_names(),
+    help="branch predictors to evaluate",
+)
+parser.add_argument(
+    "--max-branches",
+    type=int,
+    default=0,
+    help="number of branches to replay, 0 replays the whole trace",
+)
+
+args = parser.parse_args()
+
+root = Root(full_system=False)
+root.replayers = [
+    BranchTraceReplayer(
+        trace_file=args.trace,
+        branch_pred=ObjectList.bp_list.get(name)(),
+        max_branches=args.max_branches,
+    )
+    for name in args.predictors
+]
+
+m5.instantiate()
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
@@ -29,11 +29,15 @@
 import argparse
 import os
 import sys
+import time
 
 import m5
 from m5.defines import buildEnv
 from m5.objects import *
-from m5.util import addToPath
+from m5.util import (
+    addToPath,
+    convert,
+)
 
 addToPath("../")
 
@@ -120,6 +124,14 @@ parser.add_argument(
                         Set to -1 to inject randomly in all vnets.",
 )
 
+parser.add_argument(
+    "--report-router-rate",
+    action="store_true",
+    help="Report the simulation speed in router cycles (number of routers \
+                        times simulated network cycles) per host second, \
+                        to track the performance of the network model.",
+)
+
 #
 # Add the ruby specific and protocol specific options
 #
@@ -182,6 +194,21 @@ m5.ticks.setGlobalFrequency("1ps")
 m5.instantiate()
 
 # simulate until program terminates
+host_start = time.time()
 exit_event = m5.simulate(args.abs_max_tick)
+host_seconds = time.time() - host_start
 
 print("Exiting @ tick", m5.curTick(), "because", exit_event.getCause())
+
+if args.report_router_rate:
+    ruby_period = m5.ticks.fromSeconds(
+        1.0 / convert.toFrequency(args.ruby_clock)
+    )
+    router_cycles = len(system.ruby.network.routers) * (
+        m5.curTick() // ruby_period
+    )
+    print(
+        f"Simulated {router_cycles} router cycles in {host_seconds:.2f} host "
+        f"seconds: {router_cycles / max(host_seconds, 1e-9):.0f} router "
+        "cycles per host second"
+    )
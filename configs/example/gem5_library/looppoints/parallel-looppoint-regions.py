@@ -0,0 +1,145 @@
+# Copyright (c) 2023 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This configuration script shows how to simulate all the LoopPoint regions of
+a workload in parallel and extrapolate the whole application from them.
+
+The checkpoints and the LoopPoint JSON file must first be created, in a
+single pass, with create-looppoint-checkpoints.py. This script then builds
+the detailed board once and forks one gem5 process per region. Every process
+restores its region's checkpoint, runs the warmup (if any) and the region,
+and dumps the region's stats to `m5out/region<i>`. The per region results and
+the extrapolated totals are written to `m5out/looppoint_regions.json`.
+
+Usage
+-----
+```
+./build/X86/gem5.opt \
+    configs/example/gem5_library/looppoints/create-looppoint-checkpoints.py
+./build/X86/gem5.opt \
+    configs/example/gem5_library/looppoints/parallel-looppoint-regions.py
+```
+"""
+import argparse
+from pathlib import Path
+
+from gem5.components.boards.simple_board import SimpleBoard
+from gem5.components.cachehierarchies.classic.private_l1_private_l2_walk_cache_hierarchy import (
+    PrivateL1PrivateL2WalkCacheHierarchy,
+)
+from gem5.components.memory import DualChannelDDR4_2400
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_processor import SimpleProcessor
+from gem5.isas import ISA
+from gem5.resources.looppoint import LooppointJsonLoader
+from gem5.resources.resource import obtain_resource
+from gem5.simulate.simulator import Simulator
+from gem5.utils.multisim.regions import run_looppoint_regions
+from gem5.utils.requires import requires
+
+requires(isa_required=ISA.X86)
+
+parser = argparse.ArgumentParser(
+    description="Simulate all the LoopPoint regions in parallel."
+)
+
+parser.add_argument(
+    "--checkpoint-path",
+    type=str,
+    required=False,
+    default="looppoint_checkpoints_folder",
+    help="The directory the checkpoints were stored in.",
+)
+
+parser.add_argument(
+    "--looppoint-json",
+    type=str,
+    required=False,
+    default="m5out/looppoint.json",
+    help="The LoopPoint JSON file written when taking the checkpoints.",
+)
+
+parser.add_argument(
+    "--processes",
+    type=int,
+    required=False,
+    default=None,
+    help="The maximum number of regions to simulate at the same time. "
+    "Defaults to the number of host CPUs.",
+)
+
+args = parser.parse_args()
+
+cache_hierarchy = PrivateL1PrivateL2WalkCacheHierarchy(
+    l1d_size="32kB",
+    l1i_size="32kB",
+    l2_size="256kB",
+)
+
+memory = DualChannelDDR4_2400(size="2GB")
+
+processor = SimpleProcessor(
+    cpu_type=CPUTypes.TIMING,
+    isa=ISA.X86,
+    # The number of cores must be equal or greater than that used when taking
+    # the checkpoints.
+    num_cores=9,
+)
+
+board = SimpleBoard(
+    clk_freq="3GHz",
+    processor=processor,
+    memory=memory,
+    cache_hierarchy=cache_hierarchy,
+)
+
+# The same workload as when taking the checkpoints. It makes the cores track
+# the PCs of all the regions.
+board.set_workload(
+    obtain_resource("x86-matrix-multiply-omp-100-8-looppoint-csv")
+)
+
+simulator = Simulator(board=board)
+
+results = run_looppoint_regions(
+    simulator,
+    looppoint=LooppointJsonLoader(args.looppoint_json),
+    checkpoint_dir=Path(args.checkpoint_path),
+    processes=args.processes,
+)
+
+for region in results["regions"]:
+    print(
+        f"Region {region['region']}: "
+        + (
+            f"{region['insts']} instructions in {region['ticks']} ticks"
+            if "ticks" in region
+            else f"failed ({region.get('error', region.get('exit_cause'))})"
+        )
+    )
+print(f"Extrapolated ticks: {results['extrapolated_ticks']}")
+print(f"Extrapolated IPC: {results['ipc']}")
@@ -134,6 +134,16 @@ parser.add_argument(
     metavar="NLOADS",
     help="Progress message interval ",
 )
+parser.add_argument(
+    "-n",
+    "--num-systems",
+    type=int,
+    default=1,
+    metavar="N",
+    help="Number of independent tester systems. Each system is "
+    "simulated on its own event queue, i.e., by its own host thread, "
+    "and its testers use different random streams.",
+)
 parser.add_argument(
     "--sys-clock",
     action="store",
@@ -267,22 +277,10 @@ proto_tester = MemTest(
     progress_interval=args.progress,
 )
 
-# Set up the system along with a simple memory and reference memory
-system = System(physmem=SimpleMemory(), cache_line_size=block_size)
-
-system.voltage_domain = VoltageDomain(voltage="1V")
-
-system.clk_domain = SrcClockDomain(
-    clock=args.sys_clock, voltage_domain=system.voltage_domain
-)
-
-# For each level, track the next subsys index to use
-next_subsys_index = [0] * (len(cachespec) + 1)
-
 
 # Recursive function to create a sub-tree of the cache and tester
 # hierarchy
-def make_cache_level(ncaches, prototypes, level, next_cache):
+def make_cache_level(system, ncaches, prototypes, level, next_cache):
     global next_subsys_index, proto_l1, testerspec, proto_tester
 
     index = next_subsys_index[level]
@@ -326,7 +324,9 @@ def make_cache_level(ncaches, prototypes, level, next_cache):
         subsys.cache = tester_caches + tree_caches
         for cache in tree_caches:
             cache.mem_side = xbar.cpu_side_ports
-            make_cache_level(ncaches[1:], prototypes[1:], level - 1, cache)
+            make_cache_level(
+                system, ncaches[1:], prototypes[1:], level - 1, cache
+            )
         for tester, cache in zip(testers, tester_caches):
             tester.port = cache.cpu_side
             cache.mem_side = xbar.cpu_side_ports
@@ -347,38 +347,71 @@ def make_cache_level(ncaches, prototypes, level, next_cache):
             testers[0].port = next_cache.cpu_side
 
 
-# Top level call to create the cache hierarchy, bottom up
-make_cache_level(cachespec, cache_proto, len(cachespec), None)
-
-# Connect the lowest level crossbar to the last-level cache and memory
-# controller
-last_subsys = getattr(system, f"l{len(cachespec)}subsys0")
-last_subsys.xbar.point_of_coherency = True
-if args.noncoherent_cache:
-    system.llc = NoncoherentCache(
-        size="16MB",
-        assoc=16,
-        tag_latency=10,
-        data_latency=10,
-        sequential_access=True,
-        response_latency=20,
-        tgts_per_mshr=8,
-        mshrs=64,
+
+def make_system():
+    global next_subsys_index
+
+    # Set up the system along with a simple memory and reference memory
+    system = System(physmem=SimpleMemory(), cache_line_size=block_size)
+
+    system.voltage_domain = VoltageDomain(voltage="1V")
+
+    system.clk_domain = SrcClockDomain(
+        clock=args.sys_clock, voltage_domain=system.voltage_domain
     )
-    last_subsys.xbar.mem_side_ports = system.llc.cpu_side
-    system.llc.mem_side = system.physmem.port
-else:
-    last_subsys.xbar.mem_side_ports = system.physmem.port
 
-root = Root(full_system=False, system=system)
-if args.atomic:
-    root.system.mem_mode = "atomic"
-else:
-    root.system.mem_mode = "timing"
+    # For each level, track the next subsys index to use
+    next_subsys_index = [0] * (len(cachespec) + 1)
+
+    # Top level call to create the cache hierarchy, bottom up
+    make_cache_level(system, cachespec, cache_proto, len(cachespec), None)
+
+    # Connect the lowest level crossbar to the last-level cache and memory
+    # controller
+    last_subsys = getattr(system, f"l{len(cachespec)}subsys0")
+    last_subsys.xbar.point_of_coherency = True
+    if args.noncoherent_cache:
+        system.llc = NoncoherentCache(
+            size="16MB",
+            assoc=16,
+            tag_latency=10,
+            data_latency=10,
+            sequential_access=True,
+            response_latency=20,
+            tgts_per_mshr=8,
+            mshrs=64,
+        )
+        last_subsys.xbar.mem_side_ports = system.llc.cpu_side
+        system.llc.mem_side = system.physmem.port
+    else:
+        last_subsys.xbar.mem_side_ports = system.physmem.port
+
+    if args.atomic:
+        system.mem_mode = "atomic"
+    else:
+        system.mem_mode = "timing"
 
-# The system port is never used in the tester so merely connect it
-# to avoid problems
-root.system.system_port = last_subsys.xbar.cpu_side_ports
+    # The system port is never used in the tester so merely connect it
+    # to avoid problems
+    system.system_port = last_subsys.xbar.cpu_side_ports
+
+    return system
+
+
+if args.num_systems < 1:
+    print("Error: Must have at least one system")
+    sys.exit(1)
+
+if args.num_systems == 1:
+    root = Root(full_system=False, system=make_system())
+else:
+    # The systems never interact, so they can all run on separate
+    # event queues and the quantum only bounds how far apart their
+    # simulated times drift
+    systems = [make_system() for i in range(args.num_systems)]
+    for i, system in enumerate(systems):
+        system.eventq_index = i
+    root = Root(full_system=False, system=systems, sim_quantum=1000000)
 
 # Instantiate configuration
 m5.instantiate()
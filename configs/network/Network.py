@@ -55,8 +55,9 @@ def define_options(parser):
     parser.add_argument(
         "--network",
         default="simple",
-        choices=["simple", "garnet"],
-        help="""'simple'|'garnet' (garnet2.0 will be deprecated.)""",
+        choices=["simple", "garnet", "analytic"],
+        help="""'simple'|'garnet'|'analytic' (garnet2.0 will be
+            deprecated.)""",
     )
     parser.add_argument(
         "--router-latency",
@@ -144,6 +145,13 @@ def create_network(options, ruby):
         RouterClass = GarnetRouter
         InterfaceClass = GarnetNetworkInterface
 
+    elif options.network == "analytic":
+        NetworkClass = AnalyticNetwork
+        IntLinkClass = BasicIntLink
+        ExtLinkClass = BasicExtLink
+        RouterClass = BasicRouter
+        InterfaceClass = None
+
     else:
         NetworkClass = SimpleNetwork
         IntLinkClass = SimpleIntLink
@@ -282,3 +290,35 @@ def init_network(options, network, InterfaceClass):
         assert options.network == "garnet"
         network.enable_fault_model = True
         network.fault_model = FaultModel()
+
+
+def partition_network(network, router_eventqs):
+    """Simulate regions of a simple network on their own event queues, and
+    thus on their own host threads.
+
+    router_eventqs maps the router_id of a router to the event queue of its
+    region. Routers that aren't in it are left untouched. A controller is
+    moved to the event queue of the router it is attached to, along with
+    its sequencer. Objects connected to a controller through ports, like
+    CPUs and memory controllers, have to be placed on the same event queue
+    by the caller.
+
+    Messages only cross regions on internal links, which need a latency of
+    at least one simulation quantum. Unless Root.sim_quantum is set, the
+    quantum is derived from the shortest of these links.
+    """
+    if not isinstance(network, SimpleNetwork):
+        fatal("Only the simple network can be partitioned")
+
+    for router in network.routers:
+        if router.router_id in router_eventqs:
+            router.eventq_index = router_eventqs[router.router_id]
+
+    for link in network.ext_links:
+        if link.int_node.router_id not in router_eventqs:
+            continue
+        eventq = router_eventqs[link.int_node.router_id]
+        link.ext_node.eventq_index = eventq
+        sequencer = getattr(link.ext_node, "sequencer", None)
+        if isinstance(sequencer, SimObject):
+            sequencer.eventq_index = eventq
@@ -135,6 +135,14 @@ gem5Component::gem5Component(SST::ComponentId_t id, SST::Params& params):
         );
     }
 
+    // gem5 is only entered once per quantum. A larger quantum means fewer
+    // switches between the two simulators, at the cost of responses from
+    // SST reaching gem5 up to a quantum late.
+    quantum = params.find<uint64_t>("quantum", 1);
+    if (quantum == 0) {
+        output.fatal(CALL_INFO, -1, "The quantum must be at least 1.\n");
+    }
+
     // Register a handler to be called on a set frequency.
     timeConverter = registerClock(
         cpu_frequency,
@@ -260,9 +268,17 @@ gem5Component::finish()
 bool
 gem5Component::clockTick(SST::Cycle_t currentCycle)
 {
+    if (currentCycle % quantum != 0)
+        return false;
+
     // what to do in a SST's cycle
     gem5::GlobalSimLoopExitEvent *event = simulateGem5(currentCycle);
     clocksProcessed++;
+
+    // Send out everything the bridges held back during this quantum.
+    for (auto &port : sstPorts) {
+        port->sendPendingRequests();
+    }
     // gem5 exits due to reasons other than reaching simulation limit
     if (event != gem5::simulate_limit_event) {
         output.output("exiting: curTick()=%lu cause=`%s` code=%d\n",
@@ -107,6 +107,8 @@ class gem5Component: public SST::Component
   private:
     SST::Output output;
     uint64_t clocksProcessed;
+    // Number of SST cycles between two hand-offs to gem5.
+    uint64_t quantum;
     SST::TimeConverter* timeConverter;
     gem5::GlobalSimLoopExitEvent *simulateLimitEvent;
     std::vector<char*> args;
@@ -138,7 +140,8 @@ class gem5Component: public SST::Component
     )
 
     SST_ELI_DOCUMENT_PARAMS(
-        {"cmd", "command to run gem5's config"}
+        {"cmd", "command to run gem5's config"},
+        {"quantum", "number of SST cycles gem5 runs for at a time", "1"}
     )
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
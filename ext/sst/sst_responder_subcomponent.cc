@@ -96,6 +96,12 @@ SSTResponderSubComponent::handleTimingReq(
     return true;
 }
 
+void
+SSTResponderSubComponent::sendPendingRequests()
+{
+    responseReceiver->sendPendingRequests();
+}
+
 void
 SSTResponderSubComponent::init(unsigned phase)
 {
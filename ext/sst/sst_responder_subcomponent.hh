@@ -85,6 +85,7 @@ class SSTResponderSubComponent: public SST::SubComponent
     bool findCorrespondingSimObject(gem5::Root* gem5_root);
 
     bool handleTimingReq(SST::Interfaces::StandardMem::Request* request);
+    void sendPendingRequests();
     void handleRecvRespRetry();
     void handleRecvFunctional(gem5::PacketPtr pkt);
     void handleSwapReqResponse(SST::Interfaces::StandardMem::Request* request);
@@ -60,6 +60,14 @@ class X86GPUTLB(ClockedObject):
     )
     allocationPolicy = Param.Bool(True, "Allocate on an access")
     accessDistance = Param.Bool(False, "print accessDistance stats")
+    walkCacheSize = Param.Int(
+        0,
+        "Number of page directory entries held by the page walk cache of "
+        "the last level TLB (0 disables it)",
+    )
+    walkCacheSavings = Param.Int(
+        75, "Cycles saved on a page walk that hits in the page walk cache"
+    )
 
 
 class TLBCoalescer(ClockedObject):
@@ -32,6 +32,7 @@
 
 #include "arch/amdgpu/common/tlb.hh"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 
@@ -78,16 +79,14 @@ namespace X86ISA
         accessDistance = p.accessDistance;
 
         tlb.assign(size, TlbEntry());
+        lastUse.assign(size, 0);
+        useCounter = 0;
 
-        freeList.resize(numSets);
-        entryList.resize(numSets);
-
-        for (int set = 0; set < numSets; ++set) {
-            for (int way = 0; way < assoc; ++way) {
-                int x = set * assoc + way;
-                freeList[set].push_back(&tlb.at(x));
-            }
-        }
+        walkCacheSize = p.walkCacheSize;
+        walkCacheSavings = p.walkCacheSavings;
+        fatal_if(walkCacheSavings > p.missLatency2,
+                 "%s: walkCacheSavings is larger than missLatency2", name());
+        walkCache.reserve(walkCacheSize);
 
         FA = (size == assoc);
 
@@ -167,23 +166,26 @@ namespace X86ISA
          */
         int set = (vpn >> PageShift) & setMask;
 
-        if (!freeList[set].empty()) {
-            newEntry = freeList[set].front();
-            freeList[set].pop_front();
-        } else {
-            newEntry = entryList[set].back();
-            entryList[set].pop_back();
+        // Take a free way if there is one, otherwise evict the LRU way
+        int victim = set * assoc;
+        for (int idx = victim; idx < (set + 1) * assoc; ++idx) {
+            if (lastUse[idx] < lastUse[victim]) {
+                victim = idx;
+                if (!lastUse[idx])
+                    break;
+            }
         }
 
+        newEntry = &tlb[victim];
         *newEntry = entry;
         newEntry->vaddr = vpn;
-        entryList[set].push_front(newEntry);
+        lastUse[victim] = ++useCounter;
 
         return newEntry;
     }
 
-    GpuTLB::EntryList::iterator
-    GpuTLB::lookupIt(Addr va, bool update_lru)
+    int
+    GpuTLB::lookupIdx(Addr va, bool update_lru)
     {
         int set = (va >> PageShift) & setMask;
 
@@ -191,38 +193,36 @@ namespace X86ISA
             assert(!set);
         }
 
-        auto entry = entryList[set].begin();
-        for (; entry != entryList[set].end(); ++entry) {
-            int page_size = (*entry)->size();
+        for (int idx = set * assoc; idx < (set + 1) * assoc; ++idx) {
+            if (!lastUse[idx])
+                continue;
+
+            TlbEntry &entry = tlb[idx];
+            int page_size = entry.size();
 
-            if ((*entry)->vaddr <= va && (*entry)->vaddr + page_size > va) {
+            if (entry.vaddr <= va && entry.vaddr + page_size > va) {
                 DPRINTF(GPUTLB, "Matched vaddr %#x to entry starting at %#x "
-                        "with size %#x.\n", va, (*entry)->vaddr, page_size);
+                        "with size %#x.\n", va, entry.vaddr, page_size);
 
-                if (update_lru) {
-                    entryList[set].push_front(*entry);
-                    entryList[set].erase(entry);
-                    entry = entryList[set].begin();
-                }
+                if (update_lru)
+                    lastUse[idx] = ++useCounter;
 
-                break;
+                return idx;
             }
         }
 
-        return entry;
+        return -1;
     }
 
     TlbEntry*
     GpuTLB::lookup(Addr va, bool update_lru)
     {
-        int set = (va >> PageShift) & setMask;
-
-        auto entry = lookupIt(va, update_lru);
+        int idx = lookupIdx(va, update_lru);
 
-        if (entry == entryList[set].end())
+        if (idx < 0)
             return nullptr;
         else
-            return *entry;
+            return &tlb[idx];
     }
 
     void
@@ -230,13 +230,8 @@ namespace X86ISA
     {
         DPRINTF(GPUTLB, "Invalidating all entries.\n");
 
-        for (int i = 0; i < numSets; ++i) {
-            while (!entryList[i].empty()) {
-                TlbEntry *entry = entryList[i].front();
-                entryList[i].pop_front();
-                freeList[i].push_back(entry);
-            }
-        }
+        std::fill(lastUse.begin(), lastUse.end(), 0);
+        walkCache.clear();
     }
 
     void
@@ -250,30 +245,43 @@ namespace X86ISA
     {
         DPRINTF(GPUTLB, "Invalidating all non global entries.\n");
 
-        for (int i = 0; i < numSets; ++i) {
-            for (auto entryIt = entryList[i].begin();
-                 entryIt != entryList[i].end();) {
-                if (!(*entryIt)->global) {
-                    freeList[i].push_back(*entryIt);
-                    entryList[i].erase(entryIt++);
-                } else {
-                    ++entryIt;
-                }
-            }
+        for (int idx = 0; idx < size; ++idx) {
+            if (lastUse[idx] && !tlb[idx].global)
+                freeEntry(idx);
         }
+        walkCache.clear();
     }
 
     void
     GpuTLB::demapPage(Addr va, uint64_t asn)
     {
+        int idx = lookupIdx(va, false);
 
-        int set = (va >> PageShift) & setMask;
-        auto entry = lookupIt(va, false);
+        if (idx >= 0)
+            freeEntry(idx);
+    }
 
-        if (entry != entryList[set].end()) {
-            freeList[set].push_back(*entry);
-            entryList[set].erase(entry);
+    Cycles
+    GpuTLB::walkLatency(Addr virt_page_addr)
+    {
+        if (!walkCacheSize)
+            return Cycles(missLatency2);
+
+        // One page directory entry maps 2MB
+        const Addr pde = virt_page_addr >> 21;
+        auto it = std::find(walkCache.begin(), walkCache.end(), pde);
+
+        if (it != walkCache.end()) {
+            std::rotate(walkCache.begin(), it, it + 1);
+            stats.numWalkCacheHits++;
+            return Cycles(missLatency2 - walkCacheSavings);
         }
+
+        if (walkCache.size() == walkCacheSize)
+            walkCache.pop_back();
+        walkCache.insert(walkCache.begin(), pde);
+
+        return Cycles(missLatency2);
     }
 
 
@@ -937,7 +945,7 @@ namespace X86ISA
                 assert(tlb_event);
                 tlb_event->updateOutcome(PAGE_WALK);
                 schedule(tlb_event,
-                         curTick() + cyclesToTicks(Cycles(missLatency2)));
+                         curTick() + cyclesToTicks(walkLatency(virtPageAddr)));
             }
         } else if (outcome == PAGE_WALK) {
             if (update_stats)
@@ -1434,6 +1442,8 @@ namespace X86ISA
           ADD_STAT(globalTLBMissRate, "TLB miss rate"),
           ADD_STAT(accessCycles, "Cycles spent accessing this TLB level"),
           ADD_STAT(pageTableCycles, "Cycles spent accessing the page table"),
+          ADD_STAT(numWalkCacheHits, "Number of page walks that hit in the "
+                   "page walk cache"),
           ADD_STAT(numUniquePages, "Number of unique pages touched"),
           ADD_STAT(localCycles, "Number of cycles spent in queue for all "
                    "incoming reqs"),
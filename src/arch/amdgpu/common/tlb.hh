@@ -33,7 +33,6 @@
 #define __GPU_TLB_HH__
 
 #include <fstream>
-#include <list>
 #include <queue>
 #include <string>
 #include <vector>
@@ -67,8 +66,6 @@ namespace X86ISA
       protected:
         friend class Walker;
 
-        typedef std::list<TlbEntry*> EntryList;
-
         uint32_t configAddress;
 
       public:
@@ -103,7 +100,8 @@ namespace X86ISA
         void setConfigAddress(uint32_t addr);
 
       protected:
-        EntryList::iterator lookupIt(Addr va, bool update_lru=true);
+        /** @return The index in tlb of the entry mapping va, or -1. */
+        int lookupIdx(Addr va, bool update_lru=true);
         Walker *walker;
 
       public:
@@ -140,23 +138,36 @@ namespace X86ISA
          */
         bool accessDistance;
 
+        /**
+         * The TLB entries. The ways of a set are contiguous, so that a
+         * lookup only scans assoc consecutive entries.
+         */
         std::vector<TlbEntry> tlb;
 
-        /*
-         * It's a per-set list. As long as we have not reached
-         * the full capacity of the given set, grab an entry from
-         * the freeList.
+        /**
+         * Last use of each entry of tlb, or 0 if the entry is free. It is
+         * used to guide replacement decisions: when a set is full, the
+         * entry with the smallest stamp (the LRU one) is evicted.
          */
-        std::vector<EntryList> freeList;
+        std::vector<uint64_t> lastUse;
+        /** Source of the lastUse stamps. */
+        uint64_t useCounter;
+
+        /** Free the entry at index idx of tlb. */
+        void freeEntry(int idx) { lastUse[idx] = 0; }
 
         /**
-         * An entryList per set is the equivalent of an LRU stack;
-         * it's used to guide replacement decisions. The head of the list
-         * contains the MRU TLB entry of the given set. If the freeList
-         * for this set is empty, the last element of the list
-         * is evicted (i.e., dropped on the floor).
+         * Page walk cache of the last level TLB. It holds the most
+         * recently used page directory entries (i.e., the 2MB regions
+         * whose mapping was walked) in MRU order. A page walk that hits
+         * in it models missLatency2 - walkCacheSavings cycles.
          */
-        std::vector<EntryList> entryList;
+        std::vector<Addr> walkCache;
+        size_t walkCacheSize;
+        int walkCacheSavings;
+
+        /** @return The latency of a page walk for virt_page_addr. */
+        Cycles walkLatency(Addr virt_page_addr);
 
         Fault translateInt(bool read, const RequestPtr &req,
                            ThreadContext *tc);
@@ -374,6 +385,7 @@ namespace X86ISA
             statistics::Scalar accessCycles;
             // from the CU perspective (global)
             statistics::Scalar pageTableCycles;
+            statistics::Scalar numWalkCacheHits;
             statistics::Scalar numUniquePages;
             // from the perspective of this TLB
             statistics::Scalar localCycles;
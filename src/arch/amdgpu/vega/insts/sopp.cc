@@ -167,8 +167,10 @@ namespace VegaISA
             bool kernelEnd =
                 wf->computeUnit->shader->dispatcher().isReachingKernelEnd(wf);
 
+            // functional writes have already updated every copy of the data
             bool relNeeded =
-                wf->computeUnit->shader->impl_kern_end_rel;
+                wf->computeUnit->shader->impl_kern_end_rel &&
+                !wf->functional;
 
             //if it is not a kernel end, then retire the workgroup directly
             if (!kernelEnd || !relNeeded) {
@@ -699,7 +701,7 @@ namespace VegaISA
 
         gpuDynInst->resetEntireStatusVector();
         gpuDynInst->setStatusVector(0, 1);
-        RequestPtr req = std::make_shared<Request>(0, 0, 0,
+        RequestPtr req = Request::create(0, 0, 0,
                                    gpuDynInst->computeUnit()->
                                    requestorId(), 0,
                                    gpuDynInst->wfDynId);
@@ -74,7 +74,6 @@ namespace VegaISA
     void
     Inst_VOP1__V_MOV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
@@ -104,15 +103,11 @@ namespace VegaISA
             processDPP(gpuDynInst, extData.iFmt_VOP_DPP, src_dpp);
 
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src_dpp[lane];
-                }
+                vdst[lane] = src_dpp[lane];
             }
         } else {
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src[lane];
-                }
+                vdst[lane] = src[lane];
             }
         }
 
@@ -220,16 +215,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F64_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
+            vdst[lane] = (VecElemF64)src[lane];
         }
 
         vdst.write();
@@ -252,16 +244,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F32_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
+            vdst[lane] = (VecElemF32)src[lane];
         }
 
         vdst.write();
@@ -284,16 +273,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F32_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
+            vdst[lane] = (VecElemF32)src[lane];
         }
 
         vdst.write();
@@ -589,16 +575,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F32_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
+            vdst[lane] = (VecElemF32)src[lane];
         }
 
         vdst.write();
@@ -621,16 +604,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F64_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
+            vdst[lane] = (VecElemF64)src[lane];
         }
 
         vdst.write();
@@ -653,16 +633,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE0::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 7, 0));
-            }
+            vdst[lane] = (VecElemF32)(bits(src[lane], 7, 0));
         }
 
         vdst.write();
@@ -685,16 +662,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE1::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 15, 8));
-            }
+            vdst[lane] = (VecElemF32)(bits(src[lane], 15, 8));
         }
 
         vdst.write();
@@ -717,16 +691,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE2::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 23, 16));
-            }
+            vdst[lane] = (VecElemF32)(bits(src[lane], 23, 16));
         }
 
         vdst.write();
@@ -749,16 +720,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F32_UBYTE3::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)(bits(src[lane], 31, 24));
-            }
+            vdst[lane] = (VecElemF32)(bits(src[lane], 31, 24));
         }
 
         vdst.write();
@@ -829,16 +797,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_CVT_F64_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
+            vdst[lane] = (VecElemF64)src[lane];
         }
 
         vdst.write();
@@ -1218,16 +1183,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_RCP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
+            vdst[lane] = 1.0 / src[lane];
         }
 
         vdst.write();
@@ -1252,16 +1214,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_RCP_IFLAG_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, instData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
+            vdst[lane] = 1.0 / src[lane];
         }
 
         vdst.write();
@@ -1547,16 +1506,13 @@ namespace VegaISA
     void
     Inst_VOP1__V_NOT_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, instData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~src[lane];
-            }
+            vdst[lane] = ~src[lane];
         }
 
         vdst.write();
@@ -1920,7 +1876,6 @@ namespace VegaISA
     void
     Inst_VOP1__V_MOV_B64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU64 src(gpuDynInst, instData.SRC0);
         VecOperandU64 vdst(gpuDynInst, instData.VDST);
 
@@ -1930,9 +1885,7 @@ namespace VegaISA
         panic_if(isSDWAInst(), "SDWA unimplemented for v_mov_b64");
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src[lane];
-            }
+            vdst[lane] = src[lane];
         }
 
         vdst.write();
@@ -2424,9 +2377,7 @@ namespace VegaISA
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src[lane];
-            }
+            vdst[lane] = src[lane];
         }
 
         vdst.write();
@@ -94,7 +94,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_ADD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         VecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -122,15 +121,11 @@ namespace VegaISA
             processDPP(gpuDynInst, extData.iFmt_VOP_DPP, src0_dpp, src1);
 
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0_dpp[lane] + src1[lane];
-                }
+                vdst[lane] = src0_dpp[lane] + src1[lane];
             }
         } else {
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] + src1[lane];
-                }
+                vdst[lane] = src0[lane] + src1[lane];
             }
         }
 
@@ -155,7 +150,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_SUB_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -164,9 +158,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
+            vdst[lane] = src0[lane] - src1[lane];
         }
 
         vdst.write();
@@ -190,7 +182,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_SUBREV_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -199,9 +190,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
+            vdst[lane] = src1[lane] - src0[lane];
         }
 
         vdst.write();
@@ -224,7 +213,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MUL_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -233,9 +221,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
+            vdst[lane] = src0[lane] * src1[lane];
         }
 
         vdst.write();
@@ -336,7 +322,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MUL_I32_I24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -345,10 +330,8 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
-                    * sext<24>(bits(src1[lane], 23, 0));
-            }
+            vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
+                * sext<24>(bits(src1[lane], 23, 0));
         }
 
         vdst.write();
@@ -411,10 +394,8 @@ namespace VegaISA
         auto opImpl = [](VecOperandU32& src0, VecOperandU32& src1,
                          VecOperandU32& vdst, Wavefront* wf) {
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = bits(src0[lane], 23, 0) *
-                                 bits(src1[lane], 23, 0);
-                }
+                vdst[lane] = bits(src0[lane], 23, 0) *
+                             bits(src1[lane], 23, 0);
             }
         };
 
@@ -473,7 +454,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -482,9 +462,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::fmin(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -507,7 +485,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MAX_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -516,9 +493,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::fmax(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -540,7 +515,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MIN_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -549,9 +523,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::min(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -573,7 +545,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MAX_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -582,9 +553,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::max(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -606,7 +575,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MIN_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -615,9 +583,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::min(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -639,7 +605,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MAX_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -648,9 +613,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::max(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -674,7 +637,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_LSHRREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -683,9 +645,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
+            vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
         }
 
         vdst.write();
@@ -709,7 +669,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_ASHRREV_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, instData.VSRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -718,9 +677,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
+            vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
         }
 
         vdst.write();
@@ -792,9 +749,7 @@ namespace VegaISA
             processSDWA_dst(extData.iFmt_VOP_SDWA, vdst, origVdst);
         } else {
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
-                }
+                vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
             }
         }
 
@@ -818,7 +773,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_AND_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         VecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -846,15 +800,11 @@ namespace VegaISA
             processDPP(gpuDynInst, extData.iFmt_VOP_DPP, src0_dpp, src1);
 
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0_dpp[lane] & src1[lane];
-                }
+                vdst[lane] = src0_dpp[lane] & src1[lane];
             }
         } else {
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] & src1[lane];
-                }
+                vdst[lane] = src0[lane] & src1[lane];
             }
         }
 
@@ -927,9 +877,7 @@ namespace VegaISA
             processSDWA_dst(extData.iFmt_VOP_SDWA, vdst, origVdst);
         } else {
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] | src1[lane];
-                }
+                vdst[lane] = src0[lane] | src1[lane];
             }
         }
 
@@ -953,7 +901,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_XOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -962,9 +909,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
+            vdst[lane] = src0[lane] ^ src1[lane];
         }
 
         vdst.write();
@@ -989,7 +934,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MAC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         VecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -1018,16 +962,12 @@ namespace VegaISA
             processDPP(gpuDynInst, extData.iFmt_VOP_DPP, src0_dpp, src1);
 
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = std::fma(src0_dpp[lane], src1[lane],
-                                          vdst[lane]);
-                }
+                vdst[lane] = std::fma(src0_dpp[lane], src1[lane],
+                                      vdst[lane]);
             }
         } else {
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
-                }
+                vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
             }
         }
 
@@ -1055,7 +995,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MADMK_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -1065,9 +1004,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], k, src1[lane]);
-            }
+            vdst[lane] = std::fma(src0[lane], k, src1[lane]);
         }
 
         vdst.write();
@@ -1094,7 +1031,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MADAK_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -1104,9 +1040,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], k);
-            }
+            vdst[lane] = std::fma(src0[lane], src1[lane], k);
         }
 
         vdst.write();
@@ -1590,7 +1524,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_ADD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1599,9 +1532,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
+            vdst[lane] = src0[lane] + src1[lane];
         }
 
         vdst.write();
@@ -1624,7 +1555,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_SUB_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1633,9 +1563,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
+            vdst[lane] = src0[lane] - src1[lane];
         }
 
         vdst.write();
@@ -1659,7 +1587,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_SUBREV_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1668,9 +1595,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
+            vdst[lane] = src1[lane] - src0[lane];
         }
 
         vdst.write();
@@ -1693,7 +1618,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MUL_LO_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1702,9 +1626,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
+            vdst[lane] = src0[lane] * src1[lane];
         }
 
         vdst.write();
@@ -1727,7 +1649,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_LSHLREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1736,9 +1657,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
-            }
+            vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
         }
 
         vdst.write();
@@ -1874,7 +1793,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MAX_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1883,9 +1801,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::max(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -1907,7 +1823,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MAX_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -1916,9 +1831,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::max(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -1940,7 +1853,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MIN_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, instData.VSRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1949,9 +1861,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::min(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -1973,7 +1883,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_MIN_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, instData.VSRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -1982,9 +1891,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::min(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -2075,9 +1982,7 @@ namespace VegaISA
             processSDWA_dst(extData.iFmt_VOP_SDWA, vdst, origVdst);
         } else {
             for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                if (wf->execMask(lane)) {
-                    vdst[lane] = src0[lane] + src1[lane];
-                }
+                vdst[lane] = src0[lane] + src1[lane];
             }
         }
 
@@ -2100,7 +2005,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_SUB_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -2109,9 +2013,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
+            vdst[lane] = src0[lane] - src1[lane];
         }
 
         vdst.write();
@@ -2133,7 +2035,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_SUBREV_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -2142,9 +2043,7 @@ namespace VegaISA
         src1.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
+            vdst[lane] = src1[lane] - src0[lane];
         }
 
         vdst.write();
@@ -2166,7 +2065,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_FMAC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, instData.VSRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -2176,9 +2074,7 @@ namespace VegaISA
         vdst.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
-            }
+            vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
         }
 
         vdst.write();
@@ -2200,7 +2096,6 @@ namespace VegaISA
     void
     Inst_VOP2__V_XNOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, instData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, instData.VSRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -2210,9 +2105,7 @@ namespace VegaISA
         vdst.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~(src0[lane] ^ src1[lane]);
-            }
+            vdst[lane] = ~(src0[lane] ^ src1[lane]);
         }
 
         vdst.write();
@@ -57,7 +57,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CNDMASK_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstScalarOperandU64 vcc(gpuDynInst, extData.SRC2);
@@ -68,10 +67,8 @@ namespace VegaISA
         vcc.read();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = bits(vcc.rawData(), lane)
-                    ? src1[lane] : src0[lane];
-            }
+            vdst[lane] = bits(vcc.rawData(), lane)
+                ? src1[lane] : src0[lane];
         }
 
         vdst.write();
@@ -94,7 +91,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_ADD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -125,9 +121,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
+            vdst[lane] = src0[lane] + src1[lane];
         }
 
         vdst.write();
@@ -151,7 +145,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_SUB_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -182,9 +175,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
+            vdst[lane] = src0[lane] - src1[lane];
         }
 
         vdst.write();
@@ -208,7 +199,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_SUBREV_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -239,9 +229,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
+            vdst[lane] = src1[lane] - src0[lane];
         }
 
         vdst.write();
@@ -465,7 +453,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MUL_I32_I24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -484,10 +471,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
-                    * sext<24>(bits(src1[lane], 23, 0));
-            }
+            vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
+                * sext<24>(bits(src1[lane], 23, 0));
         }
 
         vdst.write();
@@ -557,7 +542,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MUL_U32_U24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -576,9 +560,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = bits(src0[lane], 23, 0) * bits(src1[lane], 23, 0);
-            }
+            vdst[lane] = bits(src0[lane], 23, 0) * bits(src1[lane], 23, 0);
         }
 
         vdst.write();
@@ -646,7 +628,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MIN_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -677,9 +658,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::fmin(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -702,7 +681,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAX_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -733,9 +711,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::fmax(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -757,7 +733,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MIN_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -776,9 +751,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::min(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -800,7 +773,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAX_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -819,9 +791,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::max(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -843,7 +813,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MIN_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -862,9 +831,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::min(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -886,7 +853,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAX_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -905,9 +871,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::max(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -931,7 +895,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_LSHRREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -950,9 +913,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
+            vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
         }
 
         vdst.write();
@@ -976,7 +937,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_ASHRREV_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         VecOperandI32 vdst(gpuDynInst, instData.VDST);
@@ -995,9 +955,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
-            }
+            vdst[lane] = src1[lane] >> bits(src0[lane], 4, 0);
         }
 
         vdst.write();
@@ -1020,7 +978,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_LSHLREV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -1039,9 +996,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
-            }
+            vdst[lane] = src1[lane] << bits(src0[lane], 4, 0);
         }
 
         vdst.write();
@@ -1064,7 +1019,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_AND_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -1083,9 +1037,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] & src1[lane];
-            }
+            vdst[lane] = src0[lane] & src1[lane];
         }
 
         vdst.write();
@@ -1108,7 +1060,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_OR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -1127,9 +1078,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] | src1[lane];
-            }
+            vdst[lane] = src0[lane] | src1[lane];
         }
 
         vdst.write();
@@ -1152,7 +1101,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_OR3_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -1173,9 +1121,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] | src1[lane] | src2[lane];
-            }
+            vdst[lane] = src0[lane] | src1[lane] | src2[lane];
         }
 
         vdst.write();
@@ -1198,7 +1144,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_XOR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -1217,9 +1162,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] ^ src1[lane];
-            }
+            vdst[lane] = src0[lane] ^ src1[lane];
         }
 
         vdst.write();
@@ -1244,7 +1187,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAC_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
@@ -1276,9 +1218,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
-            }
+            vdst[lane] = std::fma(src0[lane], src1[lane], vdst[lane]);
         }
 
         vdst.write();
@@ -1716,7 +1656,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_ADD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1735,9 +1674,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
+            vdst[lane] = src0[lane] + src1[lane];
         }
 
         vdst.write();
@@ -1760,7 +1697,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_SUB_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1779,9 +1715,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
+            vdst[lane] = src0[lane] - src1[lane];
         }
 
         vdst.write();
@@ -1805,7 +1739,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_SUBREV_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1824,9 +1757,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
+            vdst[lane] = src1[lane] - src0[lane];
         }
 
         vdst.write();
@@ -1849,7 +1780,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MUL_LO_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1868,9 +1798,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane];
-            }
+            vdst[lane] = src0[lane] * src1[lane];
         }
 
         vdst.write();
@@ -1893,7 +1821,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_LSHLREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1912,9 +1839,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
-            }
+            vdst[lane] = src1[lane] << bits(src0[lane], 3, 0);
         }
 
         vdst.write();
@@ -1938,7 +1863,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_LSHRREV_B16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -1963,9 +1887,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
-            }
+            vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
         }
 
         vdst.write();
@@ -1989,7 +1911,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_ASHRREV_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -2008,9 +1929,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
-            }
+            vdst[lane] = src1[lane] >> bits(src0[lane], 3, 0);
         }
 
         vdst.write();
@@ -2076,7 +1995,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAX_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -2101,9 +2019,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::max(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -2125,7 +2041,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAX_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -2150,9 +2065,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::max(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::max(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -2174,7 +2087,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MIN_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         VecOperandU16 vdst(gpuDynInst, instData.VDST);
@@ -2199,9 +2111,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::min(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -2223,7 +2133,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MIN_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         VecOperandI16 vdst(gpuDynInst, instData.VDST);
@@ -2248,9 +2157,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::min(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::min(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -2292,7 +2199,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_ADD_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -2311,9 +2217,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane];
-            }
+            vdst[lane] = src0[lane] + src1[lane];
         }
 
         vdst.write();
@@ -2335,7 +2239,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_SUB_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -2354,9 +2257,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] - src1[lane];
-            }
+            vdst[lane] = src0[lane] - src1[lane];
         }
 
         vdst.write();
@@ -2378,7 +2279,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_SUBREV_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -2397,9 +2297,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] - src0[lane];
-            }
+            vdst[lane] = src1[lane] - src0[lane];
         }
 
         vdst.write();
@@ -2508,16 +2406,13 @@ namespace VegaISA
     void
     Inst_VOP3__V_MOV_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
         src.readSrc();
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src[lane];
-            }
+            vdst[lane] = src[lane];
         }
 
         vdst.write();
@@ -2594,7 +2489,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F64_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -2609,9 +2503,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
+            vdst[lane] = (VecElemF64)src[lane];
         }
 
         vdst.write();
@@ -2634,7 +2526,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F32_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         VecOperandI32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -2651,9 +2542,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
+            vdst[lane] = (VecElemF32)src[lane];
         }
 
         vdst.write();
@@ -2676,7 +2565,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F32_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -2691,9 +2579,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
+            vdst[lane] = (VecElemF32)src[lane];
         }
 
         vdst.write();
@@ -3063,7 +2949,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F32_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -3086,9 +2971,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)src[lane];
-            }
+            vdst[lane] = (VecElemF32)src[lane];
         }
 
         vdst.write();
@@ -3111,7 +2994,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F64_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -3134,9 +3016,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
+            vdst[lane] = (VecElemF64)src[lane];
         }
 
         vdst.write();
@@ -3159,7 +3039,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE0::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -3174,9 +3053,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 7, 0);
-            }
+            vdst[lane] = (VecElemF32)bits(src[lane], 7, 0);
         }
 
         vdst.write();
@@ -3199,7 +3076,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE1::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -3214,9 +3090,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 15, 8);
-            }
+            vdst[lane] = (VecElemF32)bits(src[lane], 15, 8);
         }
 
         vdst.write();
@@ -3239,7 +3113,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE2::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -3254,9 +3127,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 23, 16);
-            }
+            vdst[lane] = (VecElemF32)bits(src[lane], 23, 16);
         }
 
         vdst.write();
@@ -3279,7 +3150,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F32_UBYTE3::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -3294,9 +3164,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF32)bits(src[lane], 31, 24);
-            }
+            vdst[lane] = (VecElemF32)bits(src[lane], 31, 24);
         }
 
         vdst.write();
@@ -3375,7 +3243,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_CVT_F64_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
 
@@ -3390,9 +3257,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (VecElemF64)src[lane];
-            }
+            vdst[lane] = (VecElemF64)src[lane];
         }
 
         vdst.write();
@@ -3868,7 +3733,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_RCP_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -3883,9 +3747,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
+            vdst[lane] = 1.0 / src[lane];
         }
 
         vdst.write();
@@ -3910,7 +3772,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_RCP_IFLAG_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src(gpuDynInst, extData.SRC0);
         VecOperandF32 vdst(gpuDynInst, instData.VDST);
 
@@ -3925,9 +3786,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = 1.0 / src[lane];
-            }
+            vdst[lane] = 1.0 / src[lane];
         }
 
         vdst.write();
@@ -4260,7 +4119,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_NOT_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src(gpuDynInst, extData.SRC0);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
 
@@ -4275,9 +4133,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ~src[lane];
-            }
+            vdst[lane] = ~src[lane];
         }
 
         vdst.write();
@@ -5179,7 +5035,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAD_LEGACY_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -5214,9 +5069,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
+            vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
         }
 
         vdst.write();
@@ -5240,7 +5093,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAD_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -5275,9 +5127,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
+            vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
         }
 
         vdst.write();
@@ -5300,7 +5150,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAD_I32_I24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandI32 src2(gpuDynInst, extData.SRC2);
@@ -5321,10 +5170,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
-                    * sext<24>(bits(src1[lane], 23, 0)) + src2[lane];
-            }
+            vdst[lane] = sext<24>(bits(src0[lane], 23, 0))
+                * sext<24>(bits(src1[lane], 23, 0)) + src2[lane];
         }
 
         vdst.write();
@@ -5347,7 +5194,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAD_U32_U24::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -5368,10 +5214,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = bits(src0[lane], 23, 0) * bits(src1[lane], 23, 0)
-                    + src2[lane];
-            }
+            vdst[lane] = bits(src0[lane], 23, 0) * bits(src1[lane], 23, 0)
+                + src2[lane];
         }
 
         vdst.write();
@@ -5478,7 +5322,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_BFE_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -5499,10 +5342,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] >> bits(src1[lane], 4, 0))
-                    & ((1 << bits(src2[lane], 4, 0)) - 1);
-            }
+            vdst[lane] = (src0[lane] >> bits(src1[lane], 4, 0))
+                & ((1 << bits(src2[lane], 4, 0)) - 1);
         }
 
         vdst.write();
@@ -5578,7 +5419,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_BFI_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -5599,10 +5439,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] & src1[lane]) | (~src0[lane]
-                    & src2[lane]);
-            }
+            vdst[lane] = (src0[lane] & src1[lane]) | (~src0[lane]
+                & src2[lane]);
         }
 
         vdst.write();
@@ -5626,7 +5464,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_FMA_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -5661,9 +5498,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
+            vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
         }
 
         vdst.write();
@@ -5687,7 +5522,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_FMA_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF64 src2(gpuDynInst, extData.SRC2);
@@ -5722,9 +5556,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
+            vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
         }
 
         vdst.write();
@@ -6211,7 +6043,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MED3_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -6246,9 +6077,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
+            vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
         }
 
         vdst.write();
@@ -6270,7 +6099,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MED3_I32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandI32 src2(gpuDynInst, extData.SRC2);
@@ -6291,9 +6119,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
+            vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
         }
 
         vdst.write();
@@ -6315,7 +6141,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MED3_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -6336,9 +6161,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
-            }
+            vdst[lane] = median(src0[lane], src1[lane], src2[lane]);
         }
 
         vdst.write();
@@ -6938,7 +6761,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_DIV_FMAS_F32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandF32 src2(gpuDynInst, extData.SRC2);
@@ -6973,9 +6795,7 @@ namespace VegaISA
         }
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
-            }
+            vdst[lane] = std::fma(src0[lane], src1[lane], src2[lane]);
         }
 
         //vdst.write();
@@ -7244,7 +7064,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_XAD_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -7265,9 +7084,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] ^ src1[lane]) + src2[lane];
-            }
+            vdst[lane] = (src0[lane] ^ src1[lane]) + src2[lane];
         }
 
         vdst.write();
@@ -7289,7 +7106,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_LSHL_ADD_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -7310,10 +7126,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] << bits(src1[lane], 4, 0))
-                           + src2[lane];
-            }
+            vdst[lane] = (src0[lane] << bits(src1[lane], 4, 0))
+                       + src2[lane];
         }
 
         vdst.write();
@@ -7381,7 +7195,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_ADD3_U32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -7402,9 +7215,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] + src1[lane] + src2[lane];
-            }
+            vdst[lane] = src0[lane] + src1[lane] + src2[lane];
         }
 
         vdst.write();
@@ -7426,7 +7237,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_LSHL_OR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -7447,10 +7257,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] << bits(src1[lane], 4, 0))
-                           | src2[lane];
-            }
+            vdst[lane] = (src0[lane] << bits(src1[lane], 4, 0))
+                       | src2[lane];
         }
 
         vdst.write();
@@ -7473,7 +7281,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_AND_OR_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU32 src2(gpuDynInst, extData.SRC2);
@@ -7494,9 +7301,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = (src0[lane] & src1[lane]) | src2[lane];
-            }
+            vdst[lane] = (src0[lane] & src1[lane]) | src2[lane];
         }
 
         vdst.write();
@@ -7542,7 +7347,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAD_U16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandU16 src2(gpuDynInst, extData.SRC2);
@@ -7563,9 +7367,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane] + src2[lane];
-            }
+            vdst[lane] = src0[lane] * src1[lane] + src2[lane];
         }
 
         vdst.write();
@@ -7589,7 +7391,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAD_I16::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandI16 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandI16 src1(gpuDynInst, extData.SRC1);
         ConstVecOperandI16 src2(gpuDynInst, extData.SRC2);
@@ -7610,9 +7411,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src0[lane] * src1[lane] + src2[lane];
-            }
+            vdst[lane] = src0[lane] * src1[lane] + src2[lane];
         }
 
         vdst.write();
@@ -8199,7 +7998,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MIN_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
@@ -8230,9 +8028,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmin(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::fmin(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -8255,7 +8051,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_MAX_F64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandF64 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandF64 src1(gpuDynInst, extData.SRC1);
         VecOperandF64 vdst(gpuDynInst, instData.VDST);
@@ -8286,9 +8081,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = std::fmax(src0[lane], src1[lane]);
-            }
+            vdst[lane] = std::fmax(src0[lane], src1[lane]);
         }
 
         vdst.write();
@@ -8759,7 +8552,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_LSHLREV_B64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU64 src1(gpuDynInst, extData.SRC1);
         VecOperandU64 vdst(gpuDynInst, instData.VDST);
@@ -8778,9 +8570,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] << bits(src0[lane], 5, 0);
-            }
+            vdst[lane] = src1[lane] << bits(src0[lane], 5, 0);
         }
 
         vdst.write();
@@ -8804,7 +8594,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_LSHRREV_B64::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU64 src1(gpuDynInst, extData.SRC1);
         VecOperandU64 vdst(gpuDynInst, instData.VDST);
@@ -8823,9 +8612,7 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = src1[lane] >> bits(src0[lane], 5, 0);
-            }
+            vdst[lane] = src1[lane] >> bits(src0[lane], 5, 0);
         }
 
         vdst.write();
@@ -8919,7 +8706,6 @@ namespace VegaISA
     void
     Inst_VOP3__V_BFM_B32::execute(GPUDynInstPtr gpuDynInst)
     {
-        Wavefront *wf = gpuDynInst->wavefront();
         ConstVecOperandU32 src0(gpuDynInst, extData.SRC0);
         ConstVecOperandU32 src1(gpuDynInst, extData.SRC1);
         VecOperandU32 vdst(gpuDynInst, instData.VDST);
@@ -8938,10 +8724,8 @@ namespace VegaISA
         assert(!(extData.NEG & 0x4));
 
         for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-            if (wf->execMask(lane)) {
-                vdst[lane] = ((1 << bits(src0[lane], 4, 0)) - 1)
-                    << bits(src1[lane], 4, 0);
-            }
+            vdst[lane] = ((1 << bits(src0[lane], 4, 0)) - 1)
+                << bits(src1[lane], 4, 0);
         }
 
         vdst.write();
@@ -32,7 +32,10 @@
 #ifndef __ARCH_VEGA_OPERAND_HH__
 #define __ARCH_VEGA_OPERAND_HH__
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <type_traits>
 
 #include "arch/amdgpu/vega/gpu_registers.hh"
 #include "arch/generic/vec_reg.hh"
@@ -108,8 +111,8 @@ namespace VegaISA
         VecOperand() = delete;
 
         VecOperand(GPUDynInstPtr gpuDynInst, int opIdx)
-            : Operand(gpuDynInst, opIdx), scalar(false), absMod(false),
-              negMod(false), scRegData(gpuDynInst, _opIdx),
+            : Operand(gpuDynInst, opIdx), scalar(false), absMask(~SignBits(0)),
+              negMask(0), scRegData(gpuDynInst, _opIdx),
               vrfData{{ nullptr }}
         {
             vecReg.zero();
@@ -164,9 +167,15 @@ namespace VegaISA
                 assert(vrfData[0]);
                 auto vgpr = vecReg.template as<DataType>();
                 auto reg_file_vgpr = vrfData[0]->template as<VecElemU32>();
-                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                    std::memcpy((void*)&vgpr[lane],
-                        (void*)&reg_file_vgpr[lane], sizeof(DataType));
+                if (sizeof(DataType) == sizeof(VecElemU32)) {
+                    // same layout as the register file, copy it whole
+                    std::memcpy((void*)vgpr, (void*)reg_file_vgpr,
+                        sizeof(VecElemU32) * NumVecElemPerVecReg);
+                } else {
+                    for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                        std::memcpy((void*)&vgpr[lane],
+                            (void*)&reg_file_vgpr[lane], sizeof(DataType));
+                    }
                 }
             } else if (NumDwords == 2) {
                 assert(vrfData[0]);
@@ -194,6 +203,11 @@ namespace VegaISA
          * the data to the actual register file storage. this allows us to do
          * type conversion, etc., in a single call as opposed to doing it
          * in each execute() method.
+         *
+         * only the active lanes are written back, so the execute() methods
+         * of instructions without side effects may compute every lane of
+         * the operand. their lane loops have no branch then, and the host
+         * compiler can vectorize them.
          */
         void
         write() override
@@ -205,6 +219,10 @@ namespace VegaISA
             ComputeUnit *cu = _gpuDynInst->computeUnit();
             VectorMask &exec_mask = _gpuDynInst->isLoad()
                 ? _gpuDynInst->exec_mask : wf->execMask();
+            // destinations are always vector registers
+            assert(!scalar);
+            const uint64_t lane_mask = _gpuDynInst->ignoreExec()
+                ? ~0ULL : exec_mask.to_ullong();
 
             if (NumDwords == 1) {
                 int vgprIdx = cu->registerManager->mapVgpr(wf, _opIdx);
@@ -213,10 +231,26 @@ namespace VegaISA
                 auto reg_file_vgpr = vrfData[0]->template as<VecElemU32>();
                 auto vgpr = vecReg.template as<DataType>();
 
-                for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                    if (exec_mask[lane] || _gpuDynInst->ignoreExec()) {
-                        std::memcpy((void*)&reg_file_vgpr[lane],
-                            (void*)&vgpr[lane], sizeof(DataType));
+                if (sizeof(DataType) == sizeof(VecElemU32) &&
+                    lane_mask == ~0ULL) {
+                    // same layout as the register file, copy it whole
+                    std::memcpy((void*)reg_file_vgpr, (void*)vgpr,
+                        sizeof(VecElemU32) * NumVecElemPerVecReg);
+                } else if (sizeof(DataType) == sizeof(VecElemU32)) {
+                    // blend the active lanes into the register
+                    auto vgpr_u32 = vecReg.template as<VecElemU32>();
+                    for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                        const VecElemU32 active =
+                            -(VecElemU32)((lane_mask >> lane) & 1);
+                        reg_file_vgpr[lane] = (vgpr_u32[lane] & active)
+                            | (reg_file_vgpr[lane] & ~active);
+                    }
+                } else {
+                    for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
+                        if ((lane_mask >> lane) & 1) {
+                            std::memcpy((void*)&reg_file_vgpr[lane],
+                                (void*)&vgpr[lane], sizeof(DataType));
+                        }
                     }
                 }
 
@@ -234,10 +268,12 @@ namespace VegaISA
                 auto vgpr = vecReg.template as<VecElemU64>();
 
                 for (int lane = 0; lane < NumVecElemPerVecReg; ++lane) {
-                    if (exec_mask[lane] || _gpuDynInst->ignoreExec()) {
-                        reg_file_vgpr0[lane] = ((VecElemU32*)&vgpr[lane])[0];
-                        reg_file_vgpr1[lane] = ((VecElemU32*)&vgpr[lane])[1];
-                    }
+                    const VecElemU32 active =
+                        -(VecElemU32)((lane_mask >> lane) & 1);
+                    reg_file_vgpr0[lane] = (((VecElemU32*)&vgpr[lane])[0]
+                        & active) | (reg_file_vgpr0[lane] & ~active);
+                    reg_file_vgpr1[lane] = (((VecElemU32*)&vgpr[lane])[1]
+                        & active) | (reg_file_vgpr1[lane] & ~active);
                 }
 
                 DPRINTF(GPUVRF, "Write v[%d:%d]\n", vgprIdx0, vgprIdx1);
@@ -249,13 +285,15 @@ namespace VegaISA
         void
         negModifier()
         {
-            negMod = true;
+            assert(std::is_floating_point_v<DataType>);
+            negMask = signBit;
         }
 
         void
         absModifier()
         {
-            absMod = true;
+            assert(std::is_floating_point_v<DataType>);
+            absMask = ~signBit;
         }
 
         /**
@@ -269,36 +307,19 @@ namespace VegaISA
         {
             assert(idx < NumVecElemPerVecReg);
 
-            if (scalar) {
-                DataType ret_val = scRegData.rawData();
+            // scalar sources are broadcast to every lane when they are read
+            DataType ret_val = vecReg.template as<DataType>()[idx];
 
-                if (absMod) {
-                    assert(std::is_floating_point_v<DataType>);
-                    ret_val = std::fabs(ret_val);
-                }
-
-                if (negMod) {
-                    assert(std::is_floating_point_v<DataType>);
-                    ret_val = -ret_val;
-                }
-
-                return ret_val;
-            } else {
-                auto vgpr = vecReg.template as<DataType>();
-                DataType ret_val = vgpr[idx];
-
-                if (absMod) {
-                    assert(std::is_floating_point_v<DataType>);
-                    ret_val = std::fabs(ret_val);
-                }
-
-                if (negMod) {
-                    assert(std::is_floating_point_v<DataType>);
-                    ret_val = -ret_val;
-                }
-
-                return ret_val;
+            if constexpr (std::is_floating_point_v<DataType>) {
+                // take the absolute value, then negate, on the sign bit
+                // only. this keeps the lane loops free of branches.
+                SignBits raw_val;
+                std::memcpy(&raw_val, &ret_val, sizeof(raw_val));
+                raw_val = (raw_val & absMask) ^ negMask;
+                std::memcpy(&ret_val, &raw_val, sizeof(raw_val));
             }
+
+            return ret_val;
         }
 
         /**
@@ -310,7 +331,6 @@ namespace VegaISA
         typename std::enable_if<Condition, DataType&>::type
         operator[](size_t idx)
         {
-            assert(!scalar);
             assert(idx < NumVecElemPerVecReg);
 
             return vecReg.template as<DataType>()[idx];
@@ -326,6 +346,14 @@ namespace VegaISA
           {
               scalar = true;
               scRegData.read();
+
+              if constexpr (NumDwords == 1 || NumDwords == 2) {
+                  // copy the scalar to every lane, so that the lane
+                  // accesses don't need to tell scalars from vectors
+                  auto vgpr = vecReg.template as<DataType>();
+                  std::fill(vgpr, vgpr + NumVecElemPerVecReg,
+                            scRegData.rawData());
+              }
           }
 
           using VecRegCont =
@@ -339,10 +367,15 @@ namespace VegaISA
            * absolute value and negative modifiers. VOP3 instructions
            * may indicate that their input/output operands must be
            * modified, either by taking the absolute value or negating
-           * them. these bools indicate which modifier, if any, to use.
+           * them. these masks are applied to the bits of floating point
+           * values to take the absolute value and to negate them.
            */
-          bool absMod;
-          bool negMod;
+          using SignBits = std::conditional_t<
+              sizeof(DataType) == sizeof(uint64_t), uint64_t, uint32_t>;
+          static constexpr SignBits signBit =
+              SignBits(1) << (sizeof(SignBits) * 8 - 1);
+          SignBits absMask;
+          SignBits negMask;
           /**
            * this holds all the operand data in a single vector register
            * object (i.e., if an operand is 64b, this will hold the data
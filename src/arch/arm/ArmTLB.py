@@ -52,6 +52,12 @@ class ArmTLB(BaseTLB):
     sys = Param.System(Parent.any, "system object parameter")
     size = Param.Int(64, "TLB size")
     is_stage2 = Param.Bool(False, "Is this a stage 2 TLB?")
+    indexed = Param.Bool(
+        False,
+        "Index the entries by virtual page rather than searching all of "
+        "them on each lookup and invalidation. This only makes large TLBs "
+        "faster to simulate, and does not change their behaviour",
+    )
 
     partial_levels = VectorParam.ArmLookupLevel(
         [],
@@ -27,7 +27,11 @@
 
 #include "arch/arm/fastmodel/iris/isa.hh"
 
+#include "arch/arm/fastmodel/iris/thread_context.hh"
+#include "arch/arm/regs/cc.hh"
+#include "arch/arm/regs/int.hh"
 #include "arch/arm/regs/misc.hh"
+#include "arch/arm/regs/vec.hh"
 #include "base/logging.hh"
 #include "cpu/thread_context.hh"
 #include "sim/serialize.hh"
@@ -44,10 +48,64 @@ Iris::ISA::serialize(CheckpointOut &cp) const
     SERIALIZE_ARRAY(miscRegs, ArmISA::NUM_PHYS_MISCREGS);
 }
 
+namespace
+{
+
+// Whether software can write a misc register at some exception level.
+// The others, like the identification registers, are part of the
+// configuration of the fast model and are left alone.
+bool
+isWritable(int misc_reg)
+{
+    const auto &info = ArmISA::lookUpMiscReg[misc_reg].info;
+    return info[ArmISA::MISCREG_IMPLEMENTED] &&
+        (info[ArmISA::MISCREG_USR_NS_WR] || info[ArmISA::MISCREG_USR_S_WR] ||
+         info[ArmISA::MISCREG_PRI_NS_WR] || info[ArmISA::MISCREG_PRI_S_WR] ||
+         info[ArmISA::MISCREG_HYP_NS_WR] || info[ArmISA::MISCREG_HYP_S_WR] ||
+         info[ArmISA::MISCREG_MON_NS0_WR] ||
+         info[ArmISA::MISCREG_MON_NS1_WR]);
+}
+
+} // anonymous namespace
+
 void
-Iris::ISA::copyRegsFrom(ThreadContext *src)
+Iris::ISA::copyRegsFrom(gem5::ThreadContext *src)
 {
-    panic("copyRegsFrom not implemented");
+    auto *iris_tc = static_cast<Iris::ThreadContext *>(tc);
+
+    // Only the registers the fast model exposes can be transferred.
+    // The misc registers go first, as CPSR selects how the others are
+    // interpreted.
+    for (int i = 0; i < ArmISA::NUM_MISCREGS; i++) {
+        if (iris_tc->hasMiscReg(i) && isWritable(i))
+            tc->setMiscRegNoEffect(i, src->readMiscRegNoEffect(i));
+    }
+
+    for (auto &id: ArmISA::flatIntRegClass) {
+        if (iris_tc->getIntRegFlatRscId(id.index()) != iris::IRIS_UINT64_MAX)
+            tc->setReg(id, src->getReg(id));
+    }
+
+    for (auto &id: ArmISA::ccRegClass) {
+        if (iris_tc->getCCRegFlatRscId(id.index()) != iris::IRIS_UINT64_MAX)
+            tc->setReg(id, src->getReg(id));
+    }
+
+    // Registers which aren't architected are skipped by the thread
+    // context.
+    ArmISA::VecRegContainer vc;
+    for (auto &id: ArmISA::vecRegClass) {
+        src->getReg(id, &vc);
+        tc->setReg(id, &vc);
+    }
+
+    ArmISA::VecPredRegContainer pc;
+    for (auto &id: ArmISA::vecPredRegClass) {
+        src->getReg(id, &pc);
+        tc->setReg(id, &pc);
+    }
+
+    tc->pcState(src->pcState());
 }
 
 } // namespace gem5
@@ -39,6 +39,7 @@
 
 #include "arch/arm/fastmodel/iris/thread_context.hh"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -46,9 +47,11 @@
 
 #include "arch/arm/fastmodel/iris/cpu.hh"
 #include "arch/arm/fastmodel/iris/memory_spaces.hh"
+#include "arch/arm/regs/mat.hh"
 #include "arch/arm/regs/vec.hh"
 #include "arch/arm/system.hh"
 #include "arch/arm/utility.hh"
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "iris/detail/IrisCppAdapter.h"
 #include "iris/detail/IrisObjects.h"
@@ -574,6 +577,19 @@ ThreadContext::setStatus(Status new_status)
     _status = new_status;
 }
 
+void
+ThreadContext::takeOverFrom(gem5::ThreadContext *old_context)
+{
+    // This is gem5::takeOverFrom() without the process check, fast
+    // model cores only run in full system mode.
+    setStatus(old_context->status());
+    copyArchRegs(old_context);
+    setContextId(old_context->contextId());
+    setThreadId(old_context->threadId());
+
+    old_context->setStatus(Halted);
+}
+
 const PCStateBase &
 ThreadContext::pcState() const
 {
@@ -622,9 +638,22 @@ ThreadContext::getMiscRegRscId(RegIndex misc_reg) const
     return rsc_id;
 }
 
+bool
+ThreadContext::hasMiscReg(RegIndex misc_reg) const
+{
+    return misc_reg < miscRegIds.size() &&
+        miscRegIds.at(misc_reg) != iris::IRIS_UINT64_MAX;
+}
+
 RegVal
 ThreadContext::readMiscRegNoEffect(RegIndex misc_reg) const
 {
+    // Like the other registers the fast model doesn't expose, these read
+    // as zero. This lets the state of the fast model be copied to a gem5
+    // CPU, which asks for all of its misc registers.
+    if (!hasMiscReg(misc_reg))
+        return 0;
+
     iris::ResourceReadResult result;
     call().resource_read(_instId, result, getMiscRegRscId(misc_reg));
     return result.data.at(0);
@@ -674,6 +703,10 @@ ThreadContext::getReg(const RegId &reg, void *val) const
           case CCRegClass:
             *(RegVal *)val = readCCRegFlat(idx);
             break;
+          case MatRegClass:
+            // The fast model doesn't expose the SME state.
+            ((ArmISA::MatRegContainer *)val)->zero();
+            break;
           case MiscRegClass:
             panic("MiscRegs should not be read with getReg.");
           default:
@@ -696,6 +729,10 @@ ThreadContext::getReg(const RegId &reg, void *val) const
           case CCRegClass:
             *(RegVal *)val = readCCReg(idx);
             break;
+          case MatRegClass:
+            // The fast model doesn't expose the SME state.
+            ((ArmISA::MatRegContainer *)val)->zero();
+            break;
           case MiscRegClass:
             panic("MiscRegs should not be read with getReg.");
           default:
@@ -918,6 +955,29 @@ ThreadContext::readVecRegFlat(RegIndex idx) const
     return readVecReg(ArmISA::vecRegClass[idx]);
 }
 
+void
+ThreadContext::setVecReg(const RegId &reg_id,
+                         const ArmISA::VecRegContainer &val)
+{
+    // As for reads, ignore the registers which aren't architected.
+    auto rsc_id = getVecRegRscId(reg_id.index());
+    if (rsc_id == iris::IRIS_UINT64_MAX)
+        return;
+
+    std::vector<uint64_t> data(val.size() / sizeof(uint64_t));
+    memcpy(data.data(), val.as<uint8_t>(), data.size() * sizeof(uint64_t));
+
+    iris::ResourceWriteResult result;
+    call().resource_write(_instId, result, ResourceIds{rsc_id}, data);
+}
+
+RegVal
+ThreadContext::readVecElemFlat(RegIndex idx) const
+{
+    const auto &reg = readVecRegFlat(idx / ArmISA::NumVecElemPerVecReg);
+    return reg.as<ArmISA::VecElem>()[idx % ArmISA::NumVecElemPerVecReg];
+}
+
 iris::ResourceId
 ThreadContext::getVecPredRegRscId(RegIndex vec_reg) const
 {
@@ -963,5 +1023,26 @@ ThreadContext::readVecPredRegFlat(RegIndex idx) const
     return readVecPredReg(ArmISA::vecPredRegClass[idx]);
 }
 
+void
+ThreadContext::setVecPredReg(const RegId &reg_id,
+                             const ArmISA::VecPredRegContainer &val)
+{
+    auto rsc_id = getVecPredRegRscId(reg_id.index());
+    if (rsc_id == iris::IRIS_UINT64_MAX)
+        return;
+
+    // The inverse of readVecPredReg(), one byte per 8 predicate bits.
+    const size_t num_bits = val.NUM_BITS;
+    std::vector<uint64_t> data(divCeil(num_bits, 64), 0);
+    uint8_t *bytes = (uint8_t *)data.data();
+    for (size_t offset = 0; offset < num_bits; offset += 8) {
+        *bytes++ = val.getBits(offset,
+                               std::min<size_t>(8, num_bits - offset));
+    }
+
+    iris::ResourceWriteResult result;
+    call().resource_write(_instId, result, ResourceIds{rsc_id}, data);
+}
+
 } // namespace Iris
 } // namespace gem5
@@ -246,11 +246,7 @@ class ThreadContext : public gem5::ThreadContext
     void suspend() override { setStatus(Suspended); }
     void halt() override { setStatus(Halted); }
 
-    void
-    takeOverFrom(gem5::ThreadContext *old_context) override
-    {
-        panic("%s not implemented.", __FUNCTION__);
-    }
+    void takeOverFrom(gem5::ThreadContext *old_context) override;
 
     void regStats(const std::string &name) override {}
 
@@ -269,7 +265,7 @@ class ThreadContext : public gem5::ThreadContext
     void
     copyArchRegs(gem5::ThreadContext *tc) override
     {
-        panic("%s not implemented.", __FUNCTION__);
+        getIsaPtr()->copyRegsFrom(tc);
     }
 
     void
@@ -302,7 +298,7 @@ class ThreadContext : public gem5::ThreadContext
     virtual RegVal
     readVecElem(const RegId &reg) const
     {
-        panic("%s not implemented.", __FUNCTION__);
+        return readVecElemFlat(reg.index());
     }
 
     iris::ResourceId getVecPredRegRscId(RegIndex vec_reg) const;
@@ -322,11 +318,8 @@ class ThreadContext : public gem5::ThreadContext
 
     virtual void setIntReg(RegIndex reg_idx, RegVal val);
 
-    virtual void
-    setVecReg(const RegId &reg, const ArmISA::VecRegContainer &val)
-    {
-        panic("%s not implemented.", __FUNCTION__);
-    }
+    virtual void setVecReg(const RegId &reg,
+                           const ArmISA::VecRegContainer &val);
 
     virtual void
     setVecElem(const RegId& reg, RegVal val)
@@ -334,12 +327,8 @@ class ThreadContext : public gem5::ThreadContext
         panic("%s not implemented.", __FUNCTION__);
     }
 
-    virtual void
-    setVecPredReg(const RegId &reg,
-                  const ArmISA::VecPredRegContainer &val)
-    {
-        panic("%s not implemented.", __FUNCTION__);
-    }
+    virtual void setVecPredReg(const RegId &reg,
+                               const ArmISA::VecPredRegContainer &val);
 
     virtual void
     setCCReg(RegIndex reg_idx, RegVal val)
@@ -353,6 +342,9 @@ class ThreadContext : public gem5::ThreadContext
     void pcState(const PCStateBase &val) override;
 
     iris::ResourceId getMiscRegRscId(RegIndex misc_reg) const;
+    /** Whether the fast model exposes a misc register. */
+    bool hasMiscReg(RegIndex misc_reg) const;
+
     RegVal readMiscRegNoEffect(RegIndex misc_reg) const override;
     RegVal
     readMiscReg(RegIndex misc_reg) override
@@ -406,14 +398,10 @@ class ThreadContext : public gem5::ThreadContext
     virtual void
     setVecRegFlat(RegIndex idx, const ArmISA::VecRegContainer &val)
     {
-        panic("%s not implemented.", __FUNCTION__);
+        setVecReg(ArmISA::vecRegClass[idx], val);
     }
 
-    virtual RegVal
-    readVecElemFlat(RegIndex idx) const
-    {
-        panic("%s not implemented.", __FUNCTION__);
-    }
+    virtual RegVal readVecElemFlat(RegIndex idx) const;
     virtual void
     setVecElemFlat(RegIndex idx, RegVal val)
     {
@@ -430,7 +418,7 @@ class ThreadContext : public gem5::ThreadContext
     setVecPredRegFlat(RegIndex idx,
             const ArmISA::VecPredRegContainer &val)
     {
-        panic("%s not implemented.", __FUNCTION__);
+        setVecPredReg(ArmISA::vecPredRegClass[idx], val);
     }
 
     iris::ResourceId getCCRegFlatRscId(RegIndex cc_reg) const;
@@ -393,7 +393,7 @@ ArmKvmCPU::dump()
 }
 
 void
-ArmKvmCPU::updateKvmState()
+ArmKvmCPU::updateKvmState(StateMask groups)
 {
     DPRINTF(KvmContext, "Updating KVM state...\n");
 
@@ -402,7 +402,7 @@ ArmKvmCPU::updateKvmState()
 }
 
 void
-ArmKvmCPU::updateThreadContext()
+ArmKvmCPU::updateThreadContext(StateMask groups)
 {
     DPRINTF(KvmContext, "Updating gem5 state...\n");
 
@@ -95,8 +95,9 @@ class ArmKvmCPU : public BaseKvmCPU
 
     Tick kvmRun(Tick ticks);
 
-    void updateKvmState();
-    void updateThreadContext();
+    /** These always transfer all of the state, whatever the groups */
+    void updateKvmState(StateMask groups);
+    void updateThreadContext(StateMask groups);
     void
     stutterPC(PCStateBase &pc) const
     {
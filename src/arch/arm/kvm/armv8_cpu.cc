@@ -222,10 +222,21 @@ ArmV8KvmCPU::dump() const
 }
 
 void
-ArmV8KvmCPU::updateKvmState()
+ArmV8KvmCPU::updateKvmState(StateMask groups)
 {
-    DPRINTF(KvmContext, "In updateKvmState():\n");
+    DPRINTF(KvmContext, "In updateKvmState(%#x):\n", groups);
+
+    if (groups & RegState)
+        updateKvmStateCore();
+    if (groups & FPState)
+        updateKvmStateFP();
+    if (groups & SysState)
+        updateKvmStateSys();
+}
 
+void
+ArmV8KvmCPU::updateKvmStateCore()
+{
     // update pstate register state
     CPSR cpsr(tc->readMiscReg(MISCREG_CPSR));
     cpsr.nz = tc->getReg(cc_reg::Nz);
@@ -257,6 +268,13 @@ ArmV8KvmCPU::updateKvmState()
         setOneReg(ri.kvm, value);
     }
 
+    setOneReg(INT_REG(regs.pc), tc->pcState().instAddr());
+    DPRINTF(KvmContext, "  PC := 0x%x\n", tc->pcState().instAddr());
+}
+
+void
+ArmV8KvmCPU::updateKvmStateFP()
+{
     for (int i = 0; i < NUM_QREGS; ++i) {
         KvmFPReg reg;
         if (!inAArch64(tc))
@@ -270,7 +288,11 @@ ArmV8KvmCPU::updateKvmState()
         setOneReg(kvmFPReg(i), reg.data);
         DPRINTF(KvmContext, "  Q%i: %s\n", i, getAndFormatOneReg(kvmFPReg(i)));
     }
+}
 
+void
+ArmV8KvmCPU::updateKvmStateSys()
+{
     for (const auto &ri : getSysRegMap()) {
         uint64_t value;
         if (ri.is_device) {
@@ -286,16 +308,29 @@ ArmV8KvmCPU::updateKvmState()
         DPRINTF(KvmContext, "  %s := 0x%x\n", ri.name, value);
         setOneReg(ri.kvm, value);
     }
-
-    setOneReg(INT_REG(regs.pc), tc->pcState().instAddr());
-    DPRINTF(KvmContext, "  PC := 0x%x\n", tc->pcState().instAddr());
 }
 
 void
-ArmV8KvmCPU::updateThreadContext()
+ArmV8KvmCPU::updateThreadContext(StateMask groups)
 {
-    DPRINTF(KvmContext, "In updateThreadContext():\n");
+    DPRINTF(KvmContext, "In updateThreadContext(%#x):\n", groups);
+
+    // The mapping of the FP registers depends on the execution state,
+    // so they can't be updated without the core registers.
+    if (groups & FPState)
+        groups |= RegState;
+
+    if (groups & RegState)
+        updateTCStateCore();
+    if (groups & FPState)
+        updateTCStateFP();
+    if (groups & SysState)
+        updateTCStateSys();
+}
 
+void
+ArmV8KvmCPU::updateTCStateCore()
+{
     // Update pstate thread context
     const CPSR cpsr(getOneRegU64(INT_REG(regs.pstate)));
     DPRINTF(KvmContext, "  %s := 0x%x\n", "PSTATE", cpsr);
@@ -333,6 +368,21 @@ ArmV8KvmCPU::updateThreadContext()
         tc->setReg(intRegClass[ri.idx], value);
     }
 
+    PCState pc(getOneRegU64(INT_REG(regs.pc)));
+    pc.aarch64(inAArch64(tc));
+    pc.thumb(cpsr.t);
+    pc.nextAArch64(inAArch64(tc));
+    // TODO: This is a massive assumption that will break when
+    // switching to thumb.
+    pc.nextThumb(cpsr.t);
+    DPRINTF(KvmContext, "  PC := 0x%x (t: %i, a64: %i)\n",
+            pc.instAddr(), pc.thumb(), pc.aarch64());
+    tc->pcState(pc);
+}
+
+void
+ArmV8KvmCPU::updateTCStateFP()
+{
     for (int i = 0; i < NUM_QREGS; ++i) {
         KvmFPReg reg;
         DPRINTF(KvmContext, "  Q%i: %s\n", i, getAndFormatOneReg(kvmFPReg(i)));
@@ -345,7 +395,11 @@ ArmV8KvmCPU::updateThreadContext()
         if (!inAArch64(tc))
             syncVecRegsToElems(tc);
     }
+}
 
+void
+ArmV8KvmCPU::updateTCStateSys()
+{
     for (const auto &ri : getSysRegMap()) {
         const auto value(getOneRegU64(ri.kvm));
         DPRINTF(KvmContext, "  %s := 0x%x\n", ri.name, value);
@@ -359,17 +413,6 @@ ArmV8KvmCPU::updateThreadContext()
             tc->setMiscRegNoEffect(ri.idx, value);
         }
     }
-
-    PCState pc(getOneRegU64(INT_REG(regs.pc)));
-    pc.aarch64(inAArch64(tc));
-    pc.thumb(cpsr.t);
-    pc.nextAArch64(inAArch64(tc));
-    // TODO: This is a massive assumption that will break when
-    // switching to thumb.
-    pc.nextThumb(cpsr.t);
-    DPRINTF(KvmContext, "  PC := 0x%x (t: %i, a64: %i)\n",
-            pc.instAddr(), pc.thumb(), pc.aarch64());
-    tc->pcState(pc);
 }
 
 const std::vector<ArmV8KvmCPU::MiscRegInfo> &
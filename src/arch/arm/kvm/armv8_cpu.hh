@@ -90,8 +90,23 @@ class ArmV8KvmCPU : public BaseArmKvmCPU
     void dump() const override;
 
   protected:
-    void updateKvmState() override;
-    void updateThreadContext() override;
+    /**
+     * RegState covers PSTATE, the X registers, the banked core
+     * registers and the PC, FPState the Q registers and SysState the
+     * remaining system registers.
+     */
+    void updateKvmState(StateMask groups) override;
+    void updateThreadContext(StateMask groups) override;
+
+    /** @{ */
+    /** Transfer one group of state between gem5 and KVM */
+    void updateKvmStateCore();
+    void updateKvmStateFP();
+    void updateKvmStateSys();
+    void updateTCStateCore();
+    void updateTCStateFP();
+    void updateTCStateSys();
+    /** @} */
 
   protected:
     /** Mapping between integer registers in gem5 and KVM */
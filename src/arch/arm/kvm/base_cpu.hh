@@ -72,6 +72,9 @@ class BaseArmKvmCPU : public BaseKvmCPU
     /** Override for synchronizing state in kvm_run */
     void ioctlRun() override;
 
+    /** Only m5ops are handled specially and they don't need any state */
+    StateMask mmioState() const override { return 0; }
+
     /** Cached state of the IRQ line */
     bool irqAsserted;
     /** Cached state of the FIQ line */
@@ -1553,7 +1553,14 @@ MMU::takeOverFrom(BaseMMU *old_mmu)
     BaseMMU::takeOverFrom(old_mmu);
 
     auto *ommu = dynamic_cast<MMU*>(old_mmu);
-    assert(ommu);
+    if (!ommu) {
+        // The previous CPU doesn't use the gem5 Arm MMU, e.g. it is a
+        // fast model core. There is no translation state to inherit, and
+        // whatever was cached before it ran is stale.
+        flushAll();
+        invalidateMiscReg();
+        return;
+    }
 
     _attr = ommu->_attr;
 
@@ -2159,7 +2159,7 @@ TableWalker::fetchDescriptor(Addr desc_addr,
             (this->*doDescriptor)();
         }
     } else {
-        RequestPtr req = std::make_shared<Request>(
+        RequestPtr req = Request::create(
             desc_addr, num_bytes, flags, requestorId);
         req->taskId(context_switch_task_id::DMA);
 
@@ -2408,7 +2408,7 @@ TableWalker::readDataUntimed(ThreadContext *tc, Addr vaddr, Addr desc_addr,
     Fault fault;
 
     // translate to physical address using the second stage MMU
-    auto req = std::make_shared<Request>();
+    auto req = Request::create();
     req->setVirt(desc_addr, num_bytes, flags | Request::PT_WALK,
                 requestorId, 0);
 
@@ -2465,7 +2465,7 @@ TableWalker::Stage2Walk::Stage2Walk(TableWalker &_parent,
     : data(_data), numBytes(0), event(_event), parent(_parent),
       oVAddr(vaddr), mode(_mode), tranType(tran_type), fault(NoFault)
 {
-    req = std::make_shared<Request>();
+    req = Request::create();
 }
 
 void
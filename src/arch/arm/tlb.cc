@@ -40,6 +40,7 @@
 
 #include "arch/arm/tlb.hh"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -63,8 +64,26 @@ TLB::TLB(const ArmTLBParams &p)
       isStage2(p.is_stage2),
       _walkCache(false),
       tableWalker(nullptr),
-      stats(*this), rangeMRU(1), vmid(0)
+      stats(*this), rangeMRU(1), vmid(0), indexed(p.indexed)
 {
+    if (indexed) {
+        // The table starts in the same order as a non indexed one
+        mruPrev.resize(size);
+        mruNext.resize(size);
+        mruStamp.resize(size);
+        for (int x = 0; x < size; x++) {
+            mruPrev[x] = x - 1;
+            mruNext[x] = x + 1 < size ? x + 1 : -1;
+            mruStamp[x] = size - x;
+        }
+        mruHead = 0;
+        mruTail = size - 1;
+        mruSeq = size;
+
+        pageSizeCount.fill(0);
+        slotPageSize.assign(size, NotIndexed);
+    }
+
     for (int lvl = LookupLevel::L0;
          lvl < LookupLevel::Num_ArmLookupLevel; lvl++) {
 
@@ -105,6 +124,9 @@ TLB::setTableWalker(TableWalker *table_walker)
 TlbEntry*
 TLB::match(const Lookup &lookup_data)
 {
+    if (indexed)
+        return matchIndexed(lookup_data);
+
     // Vector of TLB entry candidates.
     // Only one of them will be assigned to retval and will
     // be returned to the MMU (in case of a hit)
@@ -153,6 +175,157 @@ TLB::match(const Lookup &lookup_data)
     return nullptr;
 }
 
+TlbEntry*
+TLB::matchIndexed(const Lookup &lookup_data)
+{
+    // Go through the candidates in the order the entries would have in
+    // the table if it wasn't indexed, to pick the same one as match()
+    collectCandidates(&lookup_data);
+
+    std::array<int, LookupLevel::Num_ArmLookupLevel> hits;
+    hits.fill(-1);
+    for (int slot : candidates) {
+        const TlbEntry &entry = table[slot];
+        if (entry.match(lookup_data)) {
+            hits[entry.lookupLevel] = slot;
+
+            // This is a complete translation, no need to loop further
+            if (!entry.partial)
+                break;
+        }
+    }
+
+    for (auto it = hits.rbegin(); it != hits.rend(); it++) {
+        const int slot = *it;
+        if (slot < 0)
+            continue;
+
+        if (!lookup_data.functional && !nearMRU(slot))
+            touchEntry(slot);
+        return &table[slot];
+    }
+
+    return nullptr;
+}
+
+void
+TLB::indexEntry(int slot)
+{
+    const TlbEntry &entry = table[slot];
+    if (!entry.valid)
+        return;
+
+    // Entries which don't cover an aligned block of 2^N bytes starting
+    // at vpn << N (e.g. the SE mode ones) are checked on every lookup
+    const uint8_t n = entry.N;
+    if (n < PageShift || n >= 58 || entry.size != mask(n) ||
+        (entry.vpn << n) >> n != entry.vpn) {
+        slotPageSize[slot] = Unindexed;
+        unindexed.push_back(slot);
+        return;
+    }
+
+    slotPageSize[slot] = n;
+    pageIndex.emplace(indexKey(entry.vpn, n), slot);
+    if (pageSizeCount[n]++ == 0)
+        pageSizes.push_back(n);
+}
+
+void
+TLB::unindexEntry(int slot)
+{
+    const int n = slotPageSize[slot];
+    slotPageSize[slot] = NotIndexed;
+
+    if (n == NotIndexed) {
+        return;
+    } else if (n == Unindexed) {
+        unindexed.erase(std::find(unindexed.begin(), unindexed.end(), slot));
+        return;
+    }
+
+    auto range = pageIndex.equal_range(indexKey(table[slot].vpn, n));
+    for (auto it = range.first; it != range.second; it++) {
+        if (it->second == slot) {
+            pageIndex.erase(it);
+            break;
+        }
+    }
+    if (--pageSizeCount[n] == 0)
+        pageSizes.erase(std::find(pageSizes.begin(), pageSizes.end(), n));
+}
+
+void
+TLB::touchEntry(int slot)
+{
+    mruStamp[slot] = ++mruSeq;
+    if (slot == mruHead)
+        return;
+
+    // Unlink the entry
+    mruNext[mruPrev[slot]] = mruNext[slot];
+    if (slot == mruTail)
+        mruTail = mruPrev[slot];
+    else
+        mruPrev[mruNext[slot]] = mruPrev[slot];
+
+    // And insert it at the MRU position
+    mruPrev[slot] = -1;
+    mruNext[slot] = mruHead;
+    mruPrev[mruHead] = slot;
+    mruHead = slot;
+}
+
+bool
+TLB::nearMRU(int slot) const
+{
+    int x = mruHead;
+    for (int pos = 0; pos <= rangeMRU && x >= 0; pos++, x = mruNext[x]) {
+        if (x == slot)
+            return true;
+    }
+    return false;
+}
+
+void
+TLB::collectCandidates(const Lookup *lookup_data)
+{
+    candidates.assign(unindexed.begin(), unindexed.end());
+
+    bool scan = !lookup_data;
+    for (auto it = pageSizes.begin(); !scan && it != pageSizes.end(); it++) {
+        const uint8_t n = *it;
+        const Addr first = lookup_data->va >> n;
+        Addr last = first;
+        if (lookup_data->size) {
+            // Range based lookup, check all the pages in the range
+            // unless there are more than there are entries
+            const Addr end = lookup_data->va + lookup_data->size - 1;
+            last = end >> n;
+            scan = end < lookup_data->va || last - first >= size;
+        }
+
+        for (Addr vpn = first; !scan; vpn++) {
+            auto range = pageIndex.equal_range(indexKey(vpn, n));
+            for (auto entry = range.first; entry != range.second; entry++)
+                candidates.push_back(entry->second);
+            if (vpn == last)
+                break;
+        }
+    }
+
+    if (scan) {
+        candidates.clear();
+        for (int x = 0; x < size; x++) {
+            if (slotPageSize[x] != NotIndexed)
+                candidates.push_back(x);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+        [this](int a, int b) { return mruStamp[a] > mruStamp[b]; });
+}
+
 TlbEntry*
 TLB::lookup(const Lookup &lookup_data)
 {
@@ -248,19 +421,29 @@ TLB::insert(TlbEntry &entry)
             entry.ap, static_cast<uint8_t>(entry.domain), entry.ns,
             entry.nstid, regimeToStr(entry.regime));
 
-    if (table[size - 1].valid)
+    const TlbEntry &victim = table[indexed ? mruTail : size - 1];
+    if (victim.valid)
         DPRINTF(TLB, " - Replacing Valid entry %#x, asn %d vmn %d ppn %#x "
                 "size: %#x ap:%d ns:%d nstid:%d g:%d regime: %s\n",
-                table[size-1].vpn << table[size-1].N, table[size-1].asid,
-                table[size-1].vmid, table[size-1].pfn << table[size-1].N,
-                table[size-1].size, table[size-1].ap, table[size-1].ns,
-                table[size-1].nstid, table[size-1].global,
-                regimeToStr(table[size-1].regime));
-
-    // inserting to MRU position and evicting the LRU one
-    for (int i = size - 1; i > 0; --i)
-        table[i] = table[i-1];
-    table[0] = entry;
+                victim.vpn << victim.N, victim.asid,
+                victim.vmid, victim.pfn << victim.N,
+                victim.size, victim.ap, victim.ns,
+                victim.nstid, victim.global,
+                regimeToStr(victim.regime));
+
+    if (indexed) {
+        // Reuse the LRU entry in place
+        const int slot = mruTail;
+        unindexEntry(slot);
+        table[slot] = entry;
+        indexEntry(slot);
+        touchEntry(slot);
+    } else {
+        // inserting to MRU position and evicting the LRU one
+        for (int i = size - 1; i > 0; --i)
+            table[i] = table[i-1];
+        table[0] = entry;
+    }
 
     stats.inserts++;
     ppRefills->notify(1);
@@ -311,12 +494,39 @@ TLB::flushAll()
         ++x;
     }
 
+    if (indexed) {
+        pageIndex.clear();
+        pageSizeCount.fill(0);
+        pageSizes.clear();
+        unindexed.clear();
+        std::fill(slotPageSize.begin(), slotPageSize.end(), NotIndexed);
+    }
+
     stats.flushTlb++;
 }
 
 void
 TLB::flush(const TLBIOp& tlbi_op)
 {
+    if (indexed) {
+        // Only check the entries which may be affected by the operation
+        auto lookup_data = tlbi_op.addrLookup(vmid);
+        collectCandidates(lookup_data ? &*lookup_data : nullptr);
+
+        for (int slot : candidates) {
+            TlbEntry *te = &table[slot];
+            if (tlbi_op.match(te, vmid)) {
+                DPRINTF(TLB, " -  %s\n", te->print());
+                te->valid = false;
+                unindexEntry(slot);
+                stats.flushedEntries++;
+            }
+        }
+
+        stats.flushTlb++;
+        return;
+    }
+
     int x = 0;
     TlbEntry *te;
     while (x < size) {
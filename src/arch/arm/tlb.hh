@@ -41,6 +41,9 @@
 #ifndef __ARCH_ARM_TLB_HH__
 #define __ARCH_ARM_TLB_HH__
 
+#include <array>
+#include <unordered_map>
+#include <vector>
 
 #include "arch/arm/faults.hh"
 #include "arch/arm/pagetable.hh"
@@ -156,6 +159,44 @@ class TLB : public BaseTLB
     int rangeMRU; //On lookup, only move entries ahead when outside rangeMRU
     vmid_t vmid;
 
+    /**
+     * Index the entries by virtual page. The entries then stay in place
+     * in the table, and their recency order is kept in a list instead,
+     * so that lookups, inserts and invalidations by address don't visit
+     * or move all the entries. The behaviour of the TLB is the same.
+     */
+    const bool indexed;
+
+    /** Recency list of the entries when indexed, from MRU to LRU */
+    std::vector<int> mruPrev;
+    std::vector<int> mruNext;
+    int mruHead;
+    int mruTail;
+
+    /** Recency stamp of the entries, decreasing from MRU to LRU */
+    std::vector<uint64_t> mruStamp;
+    uint64_t mruSeq;
+
+    /** Valid entries by page number and page size, see indexKey() */
+    std::unordered_multimap<Addr, int> pageIndex;
+
+    /** Number of entries in the index for each page size */
+    std::array<int, 64> pageSizeCount;
+
+    /** Page sizes there are entries for in the index */
+    std::vector<uint8_t> pageSizes;
+
+    /** Valid entries that can't be indexed by page, always checked */
+    std::vector<int> unindexed;
+
+    /** Page size an entry is indexed with, or NotIndexed/Unindexed */
+    std::vector<int> slotPageSize;
+    static const int NotIndexed = -1;
+    static const int Unindexed = -2;
+
+    /** Scratch list of the entries to check for a lookup */
+    std::vector<int> candidates;
+
   public:
     using Params = ArmTLBParams;
     using Lookup = TlbEntry::Lookup;
@@ -279,6 +320,37 @@ class TLB : public BaseTLB
     /** Helper function looking up for a matching TLB entry
      * Does not update stats; see lookup method instead */
     TlbEntry *match(const Lookup &lookup_data);
+
+    /** Version of match() for indexed TLBs */
+    TlbEntry *matchIndexed(const Lookup &lookup_data);
+
+    /** Key of a page of the index */
+    static Addr
+    indexKey(Addr vpn, uint8_t n)
+    {
+        return (vpn << 6) | n;
+    }
+
+    /** Add a valid entry to the index */
+    void indexEntry(int slot);
+
+    /** Remove an entry from the index */
+    void unindexEntry(int slot);
+
+    /** Make an entry the most recently used of an indexed TLB */
+    void touchEntry(int slot);
+
+    /** Check if an entry is within rangeMRU of the MRU position */
+    bool nearMRU(int slot) const;
+
+    /**
+     * Collect the entries which may match the addresses of a lookup in
+     * the candidates list, ordered from the most recently used.
+     *
+     * @param lookup_data The lookup, or nullptr to collect all the
+     *                    valid entries.
+     */
+    void collectCandidates(const Lookup *lookup_data);
 };
 
 } // namespace ArmISA
@@ -38,6 +38,8 @@
 #ifndef __ARCH_ARM_TLBI_HH__
 #define __ARCH_ARM_TLBI_HH__
 
+#include <optional>
+
 #include "arch/arm/system.hh"
 #include "arch/arm/tlb.hh"
 #include "cpu/thread_context.hh"
@@ -78,6 +80,19 @@ class TLBIOp
 
     virtual bool match(TlbEntry *entry, vmid_t curr_vmid) const = 0;
 
+    /**
+     * Return a lookup matching the addresses of all the entries this
+     * operation can invalidate, if it is restricted to some virtual
+     * addresses. This lets indexed TLBs only check the entries covering
+     * these addresses rather than all of them; match() is still used to
+     * decide whether each of them is invalidated.
+     */
+    virtual std::optional<TlbEntry::Lookup>
+    addrLookup(vmid_t curr_vmid) const
+    {
+        return std::nullopt;
+    }
+
     /**
      * Return true if the TLBI op needs to flush stage1
      * entries, Defaulting to true in the TLBIOp abstract
@@ -302,6 +317,12 @@ class TLBIMVAA : public TLBIOp
 
     bool match(TlbEntry *entry, vmid_t curr_vmid) const override;
 
+    std::optional<TlbEntry::Lookup>
+    addrLookup(vmid_t curr_vmid) const override
+    {
+        return lookupGen(curr_vmid);
+    }
+
     Addr addr;
     bool lastLevel;
 };
@@ -323,6 +344,12 @@ class TLBIMVA : public TLBIOp
 
     bool match(TlbEntry *entry, vmid_t curr_vmid) const override;
 
+    std::optional<TlbEntry::Lookup>
+    addrLookup(vmid_t curr_vmid) const override
+    {
+        return lookupGen(curr_vmid);
+    }
+
     Addr addr;
     uint16_t asid;
     bool lastLevel;
@@ -456,6 +483,14 @@ class TLBIRMVA : public TLBIRange, public TLBIMVA
     {}
 
     bool match(TlbEntry *entry, vmid_t curr_vmid) const override;
+
+    std::optional<TlbEntry::Lookup>
+    addrLookup(vmid_t curr_vmid) const override
+    {
+        TlbEntry::Lookup lookup_data = lookupGen(curr_vmid);
+        lookup_data.size = rangeSize();
+        return lookup_data;
+    }
 };
 
 /** TLB Range Invalidate by VA, All ASIDs */
@@ -469,6 +504,14 @@ class TLBIRMVAA : public TLBIRange, public TLBIMVAA
     {}
 
     bool match(TlbEntry *entry, vmid_t curr_vmid) const override;
+
+    std::optional<TlbEntry::Lookup>
+    addrLookup(vmid_t curr_vmid) const override
+    {
+        TlbEntry::Lookup lookup_data = lookupGen(curr_vmid);
+        lookup_data.size = rangeSize();
+        return lookup_data;
+    }
 };
 
 /** TLB Range Invalidate by VA, All ASIDs */
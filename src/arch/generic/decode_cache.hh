@@ -29,6 +29,7 @@
 #ifndef __ARCH_GENERIC_DECODE_CACHE_HH__
 #define __ARCH_GENERIC_DECODE_CACHE_HH__
 
+#include "base/compiler.hh"
 #include "base/types.hh"
 #include "cpu/decode_cache.hh"
 #include "cpu/static_inst_fwd.hh"
@@ -39,17 +40,36 @@ namespace gem5
 namespace GenericISA
 {
 
+/**
+ * A decode cache shared by all decoders of an ISA. The cached state is
+ * kept per host thread, so decoders on different event queues never
+ * touch the same entries.
+ */
 template <typename Decoder, typename EMI>
 class BasicDecodeCache
 {
   private:
-    decode_cache::InstMap<EMI> instMap;
     struct AddrMapEntry
     {
         StaticInstPtr inst;
         EMI machInst;
     };
-    decode_cache::AddrMap<AddrMapEntry> decodePages;
+
+    struct Caches
+    {
+        decode_cache::InstMap<EMI> instMap;
+        decode_cache::AddrMap<AddrMapEntry> decodePages;
+    };
+
+    /// Get the caches of the calling thread. These are never freed.
+    static Caches &
+    caches()
+    {
+        thread_local Caches *c = nullptr;
+        if (GEM5_UNLIKELY(!c))
+            c = new Caches;
+        return *c;
+    }
 
   public:
     /// Decode a machine instruction.
@@ -58,20 +78,22 @@ class BasicDecodeCache
     StaticInstPtr
     decode(Decoder *const decoder, EMI mach_inst, Addr addr)
     {
-        auto &entry = decodePages.lookup(addr);
+        Caches &c = caches();
+
+        auto &entry = c.decodePages.lookup(addr);
         if (entry.inst && (entry.machInst == mach_inst))
             return entry.inst;
 
         entry.machInst = mach_inst;
 
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
+        auto iter = c.instMap.find(mach_inst);
+        if (iter != c.instMap.end()) {
             entry.inst = iter->second;
             return entry.inst;
         }
 
         entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
+        c.instMap[mach_inst] = entry.inst;
         return entry.inst;
     }
 };
@@ -144,7 +144,7 @@ BaseMMU::MMUTranslationGen::translate(Range &range) const
         next += pageBytes;
     range.size = std::min(range.size, next - range.vaddr);
 
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
             range.vaddr, range.size, flags, Request::funcRequestorId, 0, cid);
 
     range.fault = mmu->translateFunctional(req, tc, mode);
@@ -163,10 +163,12 @@ BaseMMU::takeOverFrom(BaseMMU *old_mmu)
     Port *new_itb_port = itb->getTableWalkerPort();
     Port *new_dtb_port = dtb->getTableWalkerPort();
 
-    // Move over any table walker ports if they exist
-    if (new_itb_port)
+    // Move over any table walker ports if they exist. The old CPU may not
+    // have any, e.g. if it is a fast model, in which case the new ones
+    // must be connected already.
+    if (new_itb_port && old_itb_port)
         new_itb_port->takeOverFrom(old_itb_port);
-    if (new_dtb_port)
+    if (new_dtb_port && old_dtb_port)
         new_dtb_port->takeOverFrom(old_dtb_port);
 
     itb->takeOverFrom(old_mmu->itb);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GENERIC_TLB_LOOKUP_CACHE_HH__
+#define __ARCH_GENERIC_TLB_LOOKUP_CACHE_HH__
+
+#include <array>
+#include <cstddef>
+
+#include "arch/generic/mmu.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Host side lookup cache placed in front of the trie of a TLB. It
+ * remembers the last entry translated for each access type, and keeps
+ * a direct-mapped table of recently looked up keys, so that most
+ * translations avoid walking the trie.
+ *
+ * This only speeds up the simulator and doesn't model any hardware.
+ * The TLB must still update its replacement state and statistics on a
+ * hit in this cache, and call invalidate() or flush() whenever an entry
+ * leaves the trie, so that the result of a lookup never changes.
+ *
+ * @tparam Entry The TLB entry type.
+ * @tparam Sets Number of entries of the direct-mapped table.
+ */
+template <class Entry, size_t Sets = 64>
+class TlbLookupCache
+{
+    static_assert(isPowerOf2(Sets), "The number of sets must be a power of 2");
+
+  public:
+    TlbLookupCache() { flush(); }
+
+    /**
+     * Look up the entry of a trie key.
+     *
+     * @param key The key the entry was inserted with.
+     * @param mode The type of the access.
+     * @return The entry, or nullptr if it has to be looked up in the trie.
+     */
+    Entry *
+    lookup(Addr key, BaseMMU::Mode mode)
+    {
+        Slot &last = lastTranslation[mode];
+        if (last.entry && last.key == key)
+            return last.entry;
+
+        Slot &slot = table[index(key)];
+        if (slot.entry && slot.key == key) {
+            last = slot;
+            return slot.entry;
+        }
+        return nullptr;
+    }
+
+    /** Remember the entry found in the trie for a key */
+    void
+    fill(Addr key, BaseMMU::Mode mode, Entry *entry)
+    {
+        lastTranslation[mode] = { key, entry };
+        table[index(key)] = { key, entry };
+    }
+
+    /** Forget an entry, which is removed from the TLB */
+    void
+    invalidate(const Entry *entry)
+    {
+        for (auto &slot : lastTranslation) {
+            if (slot.entry == entry)
+                slot.entry = nullptr;
+        }
+        for (auto &slot : table) {
+            if (slot.entry == entry)
+                slot.entry = nullptr;
+        }
+    }
+
+    /** Forget all the entries */
+    void
+    flush()
+    {
+        lastTranslation.fill({ 0, nullptr });
+        table.fill({ 0, nullptr });
+    }
+
+  private:
+    struct Slot
+    {
+        Addr key;
+        Entry *entry;
+    };
+
+    static size_t
+    index(Addr key)
+    {
+        // Fibonacci hashing, so that the page number and the address
+        // space identifier bits of the key are all mixed in the index
+        return (key * 0x9e3779b97f4a7c15ULL) >> (64 - floorLog2(Sets));
+    }
+
+    std::array<Slot, 3> lastTranslation;
+    std::array<Slot, Sets> table;
+};
+
+} // namespace gem5
+
+#endif // __ARCH_GENERIC_TLB_LOOKUP_CACHE_HH__
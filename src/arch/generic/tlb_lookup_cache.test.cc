@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "arch/generic/tlb_lookup_cache.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Entry
+{
+    int id;
+};
+
+} // anonymous namespace
+
+TEST(TlbLookupCacheTest, Miss)
+{
+    TlbLookupCache<Entry> cache;
+    EXPECT_EQ(cache.lookup(0x1000, BaseMMU::Read), nullptr);
+    EXPECT_EQ(cache.lookup(0, BaseMMU::Execute), nullptr);
+}
+
+TEST(TlbLookupCacheTest, FillAndHit)
+{
+    TlbLookupCache<Entry> cache;
+    Entry a{0};
+    cache.fill(0x1000, BaseMMU::Read, &a);
+
+    // The table is shared by all the access types
+    EXPECT_EQ(cache.lookup(0x1000, BaseMMU::Read), &a);
+    EXPECT_EQ(cache.lookup(0x1000, BaseMMU::Write), &a);
+    EXPECT_EQ(cache.lookup(0x1000, BaseMMU::Execute), &a);
+    EXPECT_EQ(cache.lookup(0x2000, BaseMMU::Read), nullptr);
+}
+
+/** Keys mapping to the same set are still found as last translations */
+TEST(TlbLookupCacheTest, Conflicts)
+{
+    TlbLookupCache<Entry, 1> cache;
+    Entry a{0}, b{1};
+    cache.fill(0x1000, BaseMMU::Execute, &a);
+    cache.fill(0x2000, BaseMMU::Read, &b);
+
+    EXPECT_EQ(cache.lookup(0x1000, BaseMMU::Execute), &a);
+    EXPECT_EQ(cache.lookup(0x2000, BaseMMU::Read), &b);
+    EXPECT_EQ(cache.lookup(0x1000, BaseMMU::Write), nullptr);
+}
+
+TEST(TlbLookupCacheTest, Invalidate)
+{
+    TlbLookupCache<Entry> cache;
+    Entry a{0}, b{1};
+    cache.fill(0x1000, BaseMMU::Read, &a);
+    cache.fill(0x2000, BaseMMU::Write, &b);
+
+    cache.invalidate(&a);
+    EXPECT_EQ(cache.lookup(0x1000, BaseMMU::Read), nullptr);
+    EXPECT_EQ(cache.lookup(0x2000, BaseMMU::Write), &b);
+
+    cache.flush();
+    EXPECT_EQ(cache.lookup(0x2000, BaseMMU::Write), nullptr);
+}
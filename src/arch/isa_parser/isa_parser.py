@@ -512,11 +512,26 @@ class InstObjParams:
 
 
 class ISAParser(Grammar):
-    def __init__(self, output_dir, decoder_name="Decoder"):
+    def __init__(
+        self,
+        output_dir,
+        decoder_name="Decoder",
+        decoder_splits=None,
+        exec_splits=None,
+    ):
         super().__init__()
         self.lex_kwargs["reflags"] = int(re.MULTILINE)
         self.output_dir = output_dir
 
+        # How many parts the build expects the splittable outputs in, or
+        # None to take whatever the description's 'split' directives
+        # give. A description without split directives for a section
+        # has that section split automatically.
+        self.expectedSplits = {
+            "decoder": decoder_splits,
+            "exec": exec_splits,
+        }
+
         self.filename = None  # for output file watermarking/scaremongering
 
         # variable to hold templates
@@ -938,6 +953,9 @@ class ISAParser(Grammar):
         for f in self.files.values():  # close ALL the files;
             f.close()  # not doing so can cause compilation to fail
 
+        for section in self.expectedSplits:
+            self.finalize_splits(section)
+
         self.write_top_level_files()
 
         t[0] = True
@@ -986,6 +1004,41 @@ class ISAParser(Grammar):
         else:
             return s
 
+    # Make sure a splittable output has as many parts as expected,
+    # splitting it automatically if the description doesn't.
+    def finalize_splits(self, sec):
+        expected = self.expectedSplits[sec]
+        f = self.get_file(sec)
+        if expected is None or self.splits[f] == expected:
+            return
+        if self.splits[f] != 1:
+            error(
+                "The %s output has %d 'split' parts but the build expects %d"
+                % (sec, self.splits[f], expected)
+            )
+
+        opening = "#if !defined(__SPLIT) || (__SPLIT == 1)\n"
+        closing = "\n#endif\n"
+        with open(f.name) as inp:
+            contents = inp.read()
+        start = contents.index(opening) + len(opening)
+        end = contents.rindex(closing)
+        body = contents[start:end]
+
+        cuts = splitPoints(body, expected)
+        cuts += [len(body)] * (expected - 1 - len(cuts))
+        bounds = [0] + cuts + [len(body)]
+        parts = [body[b:e] for b, e in zip(bounds[:-1], bounds[1:])]
+        separators = [
+            "\n#endif\n#if __SPLIT == %u\n" % i
+            for i in range(2, expected + 1)
+        ]
+        body = parts[0] + "".join(s + p for s, p in zip(separators, parts[1:]))
+
+        with open(f.name, "w") as out:
+            out.write(contents[:start] + body + contents[end:])
+        self.splits[f] = expected
+
     # split output file to reduce compilation time
     def p_split(self, t):
         "split : SPLIT output_type SEMI"
@@ -348,12 +348,15 @@ class VecRegOperand(RegOperand):
         if self.is_dest and self.is_src:
             name += "_merger"
 
+        # Read the register in place, the execution context falls back to
+        # a copy in the local container when that isn't safe.
         tmp_name = f"tmp_s{self.src_reg_idx}"
+        container = f"{self.parser.namespace}::VecRegContainer"
         c_read = (
-            f"\t\t{self.parser.namespace}::VecRegContainer "
-            f"{tmp_name};\n"
-            f"\t\txc->getRegOperand(this, {self.src_reg_idx},\n"
-            f"\t\t    &{tmp_name});\n"
+            f"\t\t{container} {tmp_name}_copy;\n"
+            f"\t\tconst auto &{tmp_name} = *(const {container} *)\n"
+            f"\t\t    xc->getRegOperandRef(this, {self.src_reg_idx},\n"
+            f"\t\t        &{tmp_name}_copy);\n"
         )
         # If the parser has detected that elements are being access, create
         # the appropriate view
@@ -395,11 +398,12 @@ class VecPredRegOperand(RegOperand):
 
     def makeRead(self):
         tmp_name = f"tmp_s{self.src_reg_idx}"
+        container = f"{self.parser.namespace}::VecPredRegContainer"
         c_read = (
-            f"\t\t{self.parser.namespace}::VecPredRegContainer \n"
-            f"\t\t        {tmp_name};\n"
-            f"xc->getRegOperand(this, {self.src_reg_idx}, "
-            f"&{tmp_name});\n"
+            f"\t\t{container} {tmp_name}_copy;\n"
+            f"\t\tconst auto &{tmp_name} = *(const {container} *)\n"
+            f"\t\t    xc->getRegOperandRef(this, {self.src_reg_idx},\n"
+            f"\t\t        &{tmp_name}_copy);\n"
         )
         if self.ext:
             c_read += (
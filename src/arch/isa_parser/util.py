@@ -37,6 +37,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import bisect
 import re
 
 ###################
@@ -125,6 +126,75 @@ def protectNonSubstPercents(s):
     return re.sub(r"%(?!\()", "%%", s)
 
 
+# Tokens that matter when looking for the top level of generated C++:
+# preprocessor lines, literals and comments (to skip over them),
+# brackets and ends of lines.
+_cppTokenRE = re.compile(
+    r"^[ \t]*#(?:[^\n\\]|\\.)*"
+    r'|"(?:[^"\\\n]|\\.)*"'
+    r"|'(?:[^'\\\n]|\\.)*'"
+    r"|//[^\n]*"
+    r"|/\*.*?\*/"
+    r"|[{}()\n]",
+    re.MULTILINE | re.DOTALL,
+)
+_ppOpenRE = re.compile(r"#\s*if")
+_ppCloseRE = re.compile(r"#\s*endif")
+_instantiationRE = re.compile(r"\s*(?:extern\s+)?template\s*(?!\s|<)")
+
+
+def splitPoints(code, splits):
+    """Find where to cut a block of generated C++ into the given number
+    of roughly equal parts. Cuts are only made at the start of a line
+    that follows a complete top level definition or declaration, and
+    never inside a preprocessor conditional, so that every part can be
+    compiled on its own. Explicit template instantiations are kept with
+    the definitions before them. Returns the offsets of the cuts, in
+    order; there may be fewer than requested if the code has too few
+    places to cut at."""
+
+    candidates = []
+    depth = 0
+    pp_depth = 0
+    line_start = 0
+    for match in _cppTokenRE.finditer(code):
+        token = match.group()
+        if token == "\n":
+            pos = match.start()
+            if (
+                depth == 0
+                and pp_depth == 0
+                and code[line_start:pos].rstrip().endswith(("}", ";"))
+                and not _instantiationRE.match(code, pos + 1)
+            ):
+                candidates.append(pos + 1)
+            line_start = pos + 1
+        elif token in ("{", "("):
+            depth += 1
+        elif token in ("}", ")"):
+            depth -= 1
+        elif token.lstrip().startswith("#"):
+            directive = token.lstrip()
+            if _ppOpenRE.match(directive):
+                pp_depth += 1
+            elif _ppCloseRE.match(directive):
+                pp_depth -= 1
+
+    cuts = []
+    for i in range(1, splits):
+        target = len(code) * i // splits
+        idx = bisect.bisect_left(candidates, target)
+        best = None
+        for c in candidates[max(idx - 1, 0) : idx + 1]:
+            if cuts and c <= cuts[-1]:
+                continue
+            if best is None or abs(c - target) < abs(best - target):
+                best = c
+        if best is not None:
+            cuts.append(best)
+    return cuts
+
+
 ##############
 # Stack: a simple stack object.  Used for both formats (formatStack)
 # and default cases (defaultStack).  Simply wraps a list to give more
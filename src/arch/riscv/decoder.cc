@@ -95,7 +95,13 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     DPRINTF(Decode, "Decoding instruction 0x%08x at address %#x\n",
             mach_inst.instBits, addr);
 
-    StaticInstPtr &si = instMap[mach_inst];
+    // The dynamic type of the decoder is only known after construction
+    if (GEM5_UNLIKELY(!instMapInit)) {
+        instMap.setContext({typeid(*this), vlen, elen});
+        instMapInit = true;
+    }
+
+    StaticInstPtr &si = instMap.get()[mach_inst];
     if (!si)
         si = decodeInst(mach_inst);
 
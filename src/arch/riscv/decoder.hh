@@ -30,6 +30,10 @@
 #ifndef __ARCH_RISCV_DECODER_HH__
 #define __ARCH_RISCV_DECODER_HH__
 
+#include <tuple>
+#include <typeindex>
+#include <typeinfo>
+
 #include "arch/generic/decode_cache.hh"
 #include "arch/generic/decoder.hh"
 #include "arch/riscv/insts/vector.hh"
@@ -51,7 +55,14 @@ namespace RiscvISA
 class Decoder : public InstDecoder
 {
   private:
-    decode_cache::InstMap<ExtMachInst> instMap;
+    /// Decoding depends on the concrete decoder (decodeInst may be
+    /// overridden) and on the vector configuration it was built with.
+    using DecodeContext = std::tuple<std::type_index, uint32_t, uint32_t>;
+
+    /// Decoded instructions shared with the other decoders on this
+    /// thread that decode in the same context.
+    decode_cache::SharedInstMap<ExtMachInst, DecodeContext> instMap;
+    bool instMapInit = false;
     bool aligned;
     bool mid;
 
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_RISCV_HOST_FP_HH__
+#define __ARCH_RISCV_HOST_FP_HH__
+
+#include <softfloat.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace gem5
+{
+
+namespace RiscvISA
+{
+
+/**
+ * Fast paths for the common floating point operations which use the
+ * host's FPU instead of softfloat.
+ *
+ * Each function returns false without touching its result if the
+ * operation has to go through softfloat instead. The fast path is only
+ * taken when rounding to nearest even, and when the operands and the
+ * result are normal (or a trivially exact zero), so that inexact is the
+ * only exception the operation can raise. Whether the result is inexact
+ * is determined exactly from the rounding error of the host operation,
+ * which avoids reading the host's exception flags. This relies on the
+ * host rounding to nearest even itself, which is its default.
+ *
+ * Single precision operations are done in double precision which, for
+ * these operations, is wide enough for the result to be rounded
+ * correctly when it is then converted back to single precision.
+ */
+namespace host_fp
+{
+
+template <typename F> struct Traits;
+
+template <>
+struct Traits<float32_t>
+{
+    using Host = float;
+    using Bits = uint32_t;
+    static constexpr Bits SignMask = 0x80000000;
+    static constexpr Bits ExpMask = 0x7f800000;
+};
+
+template <>
+struct Traits<float64_t>
+{
+    using Host = double;
+    using Bits = uint64_t;
+    static constexpr Bits SignMask = 0x8000000000000000;
+    static constexpr Bits ExpMask = 0x7ff0000000000000;
+};
+
+/// Whether there's a fast path for a format.
+template <typename F>
+constexpr bool supported =
+    std::is_same_v<F, float32_t> || std::is_same_v<F, float64_t>;
+
+template <typename F>
+inline typename Traits<F>::Host
+toHost(F f)
+{
+    typename Traits<F>::Host h;
+    std::memcpy(&h, &f.v, sizeof(h));
+    return h;
+}
+
+template <typename F>
+inline F
+fromHost(typename Traits<F>::Host h)
+{
+    F f;
+    std::memcpy(&f.v, &h, sizeof(h));
+    return f;
+}
+
+/// Whether f is a normal number or zero.
+template <typename F>
+inline bool
+normalOrZero(F f)
+{
+    using T = Traits<F>;
+    const typename T::Bits exp = f.v & T::ExpMask;
+    return (exp != 0 && exp != T::ExpMask) || (f.v & ~T::SignMask) == 0;
+}
+
+/**
+ * The smallest double precision magnitude for which the rounding error
+ * of a product or quotient, as computed by a fused multiply-add, is
+ * never subnormal and therefore exact.
+ */
+constexpr double minExactError =
+    std::numeric_limits<double>::min() * double(1ULL << 53);
+
+/// Whether an operation can use the host FPU in the current state.
+inline bool
+usable()
+{
+    return softfloat_roundingMode == softfloat_round_near_even;
+}
+
+inline void
+setInexact(bool inexact)
+{
+    if (inexact)
+        softfloat_exceptionFlags |= softfloat_flag_inexact;
+}
+
+/// Check a single precision result computed, and rounded, as a double.
+inline bool
+narrow(double d, float &r)
+{
+    r = float(d);
+    return std::isfinite(r) &&
+        std::fabs(r) > std::numeric_limits<float>::min();
+}
+
+template <typename F>
+inline bool
+add(F a, F b, F &res)
+{
+    if constexpr (!supported<F>) {
+        return false;
+    } else {
+        using Host = typename Traits<F>::Host;
+        if (!usable() || !normalOrZero(a) || !normalOrZero(b))
+            return false;
+
+        const Host x = toHost(a), y = toHost(b);
+        const Host s = x + y;
+        // A sum which cancels to zero is exact. Otherwise leave
+        // overflow and tiny results to softfloat.
+        if (s != 0 && (!std::isfinite(s) ||
+                    std::fabs(s) < std::numeric_limits<Host>::min())) {
+            return false;
+        }
+
+        // The rounding error of s, which is exact without overflow.
+        const Host bv = s - x;
+        const Host err = (x - (s - bv)) + (y - bv);
+        setInexact(err != 0);
+        res = fromHost<F>(s);
+        return true;
+    }
+}
+
+template <typename F>
+inline bool
+sub(F a, F b, F &res)
+{
+    if constexpr (!supported<F>) {
+        return false;
+    } else {
+        b.v ^= Traits<F>::SignMask;
+        return add(a, b, res);
+    }
+}
+
+template <typename F>
+inline bool
+mul(F a, F b, F &res)
+{
+    if constexpr (!supported<F>) {
+        return false;
+    } else {
+        if (!usable() || !normalOrZero(a) || !normalOrZero(b))
+            return false;
+
+        const auto x = toHost(a), y = toHost(b);
+        if (x == 0 || y == 0) {
+            res = fromHost<F>(x * y);
+            return true;
+        }
+
+        if constexpr (std::is_same_v<F, float32_t>) {
+            // The product of two floats is exact as a double.
+            const double d = double(x) * double(y);
+            float r;
+            if (!narrow(d, r))
+                return false;
+            setInexact(double(r) != d);
+            res = fromHost<F>(r);
+        } else {
+            const double r = x * y;
+            if (!std::isfinite(r) || std::fabs(r) < minExactError)
+                return false;
+            setInexact(std::fma(x, y, -r) != 0);
+            res = fromHost<F>(r);
+        }
+        return true;
+    }
+}
+
+template <typename F>
+inline bool
+div(F a, F b, F &res)
+{
+    if constexpr (!supported<F>) {
+        return false;
+    } else {
+        if (!usable() || !normalOrZero(a) || !normalOrZero(b))
+            return false;
+
+        const auto x = toHost(a), y = toHost(b);
+        if (y == 0)
+            return false;
+        if (x == 0) {
+            res = fromHost<F>(x / y);
+            return true;
+        }
+
+        if constexpr (std::is_same_v<F, float32_t>) {
+            float r;
+            if (!narrow(double(x) / double(y), r))
+                return false;
+            // The division was exact iff multiplying back, which is
+            // exact as a double, gives the dividend.
+            setInexact(double(r) * double(y) != double(x));
+            res = fromHost<F>(r);
+        } else {
+            const double q = x / y;
+            if (!std::isfinite(q) || std::fabs(q) < minExactError ||
+                    std::fabs(x) < minExactError) {
+                return false;
+            }
+            setInexact(std::fma(-q, y, x) != 0);
+            res = fromHost<F>(q);
+        }
+        return true;
+    }
+}
+
+template <typename F>
+inline bool
+sqrt(F a, F &res)
+{
+    if constexpr (!supported<F>) {
+        return false;
+    } else {
+        if (!usable() || !normalOrZero(a))
+            return false;
+
+        const auto x = toHost(a);
+        if (x == 0) {
+            res = a;
+            return true;
+        }
+        if (x < 0)
+            return false;
+
+        if constexpr (std::is_same_v<F, float32_t>) {
+            const float r = float(std::sqrt(double(x)));
+            setInexact(double(r) * double(r) != double(x));
+            res = fromHost<F>(r);
+        } else {
+            if (x < minExactError)
+                return false;
+            const double r = std::sqrt(x);
+            setInexact(std::fma(-r, r, x) != 0);
+            res = fromHost<F>(r);
+        }
+        return true;
+    }
+}
+
+} // namespace host_fp
+} // namespace RiscvISA
+} // namespace gem5
+
+#endif // __ARCH_RISCV_HOST_FP_HH__
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <softfloat.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "arch/riscv/host_fp.hh"
+
+using namespace gem5;
+using namespace gem5::RiscvISA;
+
+namespace
+{
+
+/**
+ * Operands covering the special cases every fast path has to reject,
+ * values close to the overflow and underflow thresholds, and values of
+ * moderate magnitude for which the fast path should normally be taken.
+ */
+template <typename F>
+std::vector<F>
+operands(std::mt19937_64 &rng)
+{
+    using T = host_fp::Traits<F>;
+    using Bits = typename T::Bits;
+    using Host = typename T::Host;
+    std::vector<F> ops;
+
+    const Host specials[] = {
+        0.0, -0.0, 1.0, -1.0, 3.0, 0.1, -2.5,
+        std::numeric_limits<Host>::infinity(),
+        -std::numeric_limits<Host>::infinity(),
+        std::numeric_limits<Host>::quiet_NaN(),
+        std::numeric_limits<Host>::signaling_NaN(),
+        std::numeric_limits<Host>::min(),
+        -std::numeric_limits<Host>::min(),
+        std::numeric_limits<Host>::denorm_min(),
+        std::numeric_limits<Host>::min() / 3,
+        std::numeric_limits<Host>::max(),
+        -std::numeric_limits<Host>::max(),
+        std::numeric_limits<Host>::max() / 3,
+        std::numeric_limits<Host>::epsilon(),
+    };
+    for (auto s : specials)
+        ops.push_back(host_fp::fromHost<F>(s));
+
+    // Arbitrary bit patterns
+    for (int i = 0; i < 200; ++i)
+        ops.push_back(F{Bits(rng())});
+
+    // Values within a few binades of 1
+    std::uniform_real_distribution<Host> dist(-64, 64);
+    for (int i = 0; i < 200; ++i)
+        ops.push_back(host_fp::fromHost<F>(dist(rng)));
+
+    return ops;
+}
+
+struct Coverage
+{
+    int fast = 0;
+    int slow = 0;
+};
+
+/**
+ * Compare a fast path against softfloat for one pair of operands. The
+ * result and the exception flags must match bit for bit whenever the
+ * fast path is taken.
+ */
+template <typename F, typename Fast, typename Soft>
+void
+check(F a, F b, Fast fast, Soft soft, Coverage &cov)
+{
+    softfloat_exceptionFlags = 0;
+    const F expected = soft(a, b);
+    const auto expected_flags = softfloat_exceptionFlags;
+
+    softfloat_exceptionFlags = 0;
+    F result{0};
+    if (fast(a, b, result)) {
+        cov.fast++;
+        EXPECT_EQ(result.v, expected.v)
+            << std::hex << "a=" << a.v << " b=" << b.v;
+        EXPECT_EQ(softfloat_exceptionFlags, expected_flags)
+            << std::hex << "a=" << a.v << " b=" << b.v;
+    } else {
+        cov.slow++;
+        EXPECT_EQ(softfloat_exceptionFlags, 0);
+    }
+}
+
+template <typename F, typename Fast, typename Soft>
+Coverage
+checkBinary(Fast fast, Soft soft, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    const auto ops = operands<F>(rng);
+    Coverage cov;
+    for (auto a : ops)
+        for (auto b : ops)
+            check(a, b, fast, soft, cov);
+    return cov;
+}
+
+template <typename F, typename Fast, typename Soft>
+Coverage
+checkUnary(Fast fast, Soft soft, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::vector<F> ops = operands<F>(rng);
+    for (auto &op : operands<F>(rng))
+        ops.push_back(F{op.v & ~host_fp::Traits<F>::SignMask});
+    Coverage cov;
+    for (auto a : ops) {
+        check(a, a,
+              [fast](F a, F, F &r) { return fast(a, r); },
+              [soft](F a, F) { return soft(a); }, cov);
+    }
+    return cov;
+}
+
+class HostFpTest : public testing::Test
+{
+  protected:
+    void
+    SetUp() override
+    {
+        softfloat_roundingMode = softfloat_round_near_even;
+        softfloat_exceptionFlags = 0;
+    }
+};
+
+} // anonymous namespace
+
+#define BINARY_TEST(NAME, OP, SOFT32, SOFT64)                              \
+TEST_F(HostFpTest, NAME)                                                \
+{                                                                       \
+    auto cov32 = checkBinary<float32_t>(                                \
+        host_fp::OP<float32_t>, SOFT32, 1);                             \
+    EXPECT_GT(cov32.fast, 0);                                           \
+    EXPECT_GT(cov32.slow, 0);                                           \
+    auto cov64 = checkBinary<float64_t>(                                \
+        host_fp::OP<float64_t>, SOFT64, 2);                             \
+    EXPECT_GT(cov64.fast, 0);                                           \
+    EXPECT_GT(cov64.slow, 0);                                           \
+}
+
+BINARY_TEST(Add, add, f32_add, f64_add)
+BINARY_TEST(Sub, sub, f32_sub, f64_sub)
+BINARY_TEST(Mul, mul, f32_mul, f64_mul)
+BINARY_TEST(Div, div, f32_div, f64_div)
+
+TEST_F(HostFpTest, Sqrt)
+{
+    auto cov32 = checkUnary<float32_t>(host_fp::sqrt<float32_t>, f32_sqrt, 3);
+    EXPECT_GT(cov32.fast, 0);
+    EXPECT_GT(cov32.slow, 0);
+    auto cov64 = checkUnary<float64_t>(host_fp::sqrt<float64_t>, f64_sqrt, 4);
+    EXPECT_GT(cov64.fast, 0);
+    EXPECT_GT(cov64.slow, 0);
+}
+
+/** Exact and inexact results raise the same flags as softfloat */
+TEST_F(HostFpTest, Inexact)
+{
+    float64_t r{0};
+    ASSERT_TRUE(host_fp::add(host_fp::fromHost<float64_t>(1.5),
+                             host_fp::fromHost<float64_t>(2.25), r));
+    EXPECT_EQ(host_fp::toHost(r), 3.75);
+    EXPECT_EQ(softfloat_exceptionFlags, 0);
+
+    float32_t q{0};
+    ASSERT_TRUE(host_fp::div(host_fp::fromHost<float32_t>(1.0f),
+                             host_fp::fromHost<float32_t>(3.0f), q));
+    EXPECT_EQ(q.v, f32_div(host_fp::fromHost<float32_t>(1.0f),
+                           host_fp::fromHost<float32_t>(3.0f)).v);
+    EXPECT_EQ(softfloat_exceptionFlags, softfloat_flag_inexact);
+}
+
+/** Only round to nearest even uses the host FPU */
+TEST_F(HostFpTest, RoundingMode)
+{
+    const auto one = host_fp::fromHost<float64_t>(1.0);
+    const auto third = host_fp::fromHost<float64_t>(1.0 / 3);
+    float64_t r{0};
+    for (auto mode : { softfloat_round_minMag, softfloat_round_min,
+                       softfloat_round_max, softfloat_round_near_maxMag }) {
+        softfloat_roundingMode = mode;
+        EXPECT_FALSE(host_fp::add(one, third, r));
+        EXPECT_FALSE(host_fp::mul(one, third, r));
+        EXPECT_FALSE(host_fp::div(one, third, r));
+        EXPECT_FALSE(host_fp::sqrt(third, r));
+    }
+    EXPECT_EQ(softfloat_exceptionFlags, 0);
+}
@@ -114,11 +114,17 @@ TLB::evictLRU()
 TlbEntry *
 TLB::lookup(Addr vpn, uint16_t asid, BaseMMU::Mode mode, bool hidden)
 {
-    TlbEntry *entry = trie.lookup(buildKey(vpn, asid));
+    const Addr key = buildKey(vpn, asid);
+    TlbEntry *entry = hidden ? nullptr : lookupCache.lookup(key, mode);
+    if (!entry) {
+        entry = trie.lookup(key);
+        if (entry && !hidden)
+            lookupCache.fill(key, mode, entry);
+    }
 
     DPRINTF(TLBVerbose, "lookup(vpn=%#x, asid=%#x, key=%#x): "
                         "%s ppn=%#x (%#x) %s\n",
-            vpn, asid, buildKey(vpn, asid), entry ? "hit" : "miss",
+            vpn, asid, key, entry ? "hit" : "miss",
             entry ? entry->paddr : 0, entry ? entry->size() : 0,
             hidden ? "hidden" : "");
 
@@ -173,6 +179,10 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
     newEntry = freeList.front();
     freeList.pop_front();
 
+    // A large page may cover keys cached for smaller pages
+    if (entry.logBytes > PageShift)
+        lookupCache.flush();
+
     Addr key = buildKey(vpn, entry.asid);
     *newEntry = entry;
     newEntry->lruSeq = nextSeq();
@@ -242,6 +252,7 @@ TLB::remove(size_t idx)
         tlb[idx].size());
 
     assert(tlb[idx].trieHandle);
+    lookupCache.invalidate(&tlb[idx]);
     trie.remove(tlb[idx].trieHandle);
     tlb[idx].trieHandle = NULL;
     freeList.push_back(&tlb[idx]);
@@ -529,6 +540,7 @@ TLB::unserialize(CheckpointIn &cp)
     }
 
     UNSERIALIZE_SCALAR(lruSeq);
+    lookupCache.flush();
 
     for (uint32_t x = 0; x < _size; x++) {
         TlbEntry *newEntry = freeList.front();
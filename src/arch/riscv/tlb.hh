@@ -35,6 +35,7 @@
 #include <list>
 
 #include "arch/generic/tlb.hh"
+#include "arch/generic/tlb_lookup_cache.hh"
 #include "arch/riscv/isa.hh"
 #include "arch/riscv/pagetable.hh"
 #include "arch/riscv/pma_checker.hh"
@@ -67,6 +68,9 @@ class TLB : public BaseTLB
     EntryList freeList;         // free entries
     uint64_t lruSeq;
 
+    /** Recent translations, to avoid walking the trie */
+    TlbLookupCache<TlbEntry> lookupCache;
+
     Walker *walker;
 
     struct TlbStats : public statistics::Group
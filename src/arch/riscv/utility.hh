@@ -49,6 +49,7 @@
 #include <sstream>
 #include <string>
 
+#include "arch/riscv/host_fp.hh"
 #include "arch/riscv/regs/float.hh"
 #include "arch/riscv/regs/int.hh"
 #include "arch/riscv/regs/vector.hh"
@@ -352,6 +353,10 @@ ftype_freg(freg_t a) -> FloatType
 template<typename FloatType> FloatType
 fadd(FloatType a, FloatType b)
 {
+    FloatType res;
+    if (host_fp::add(a, b, res))
+        return res;
+
     if constexpr(std::is_same_v<float32_t, FloatType>)
         return f32_add(a, b);
     else if constexpr(std::is_same_v<float64_t, FloatType>)
@@ -364,6 +369,10 @@ fadd(FloatType a, FloatType b)
 template<typename FloatType> FloatType
 fsub(FloatType a, FloatType b)
 {
+    FloatType res;
+    if (host_fp::sub(a, b, res))
+        return res;
+
     if constexpr(std::is_same_v<float32_t, FloatType>)
         return f32_sub(a, b);
     else if constexpr(std::is_same_v<float64_t, FloatType>)
@@ -400,6 +409,10 @@ fmax(FloatType a, FloatType b)
 template<typename FloatType> FloatType
 fdiv(FloatType a, FloatType b)
 {
+    FloatType res;
+    if (host_fp::div(a, b, res))
+        return res;
+
     if constexpr(std::is_same_v<float32_t, FloatType>)
         return f32_div(a, b);
     else if constexpr(std::is_same_v<float64_t, FloatType>)
@@ -412,6 +425,10 @@ fdiv(FloatType a, FloatType b)
 template<typename FloatType> FloatType
 fmul(FloatType a, FloatType b)
 {
+    FloatType res;
+    if (host_fp::mul(a, b, res))
+        return res;
+
     if constexpr(std::is_same_v<float32_t, FloatType>)
         return f32_mul(a, b);
     else if constexpr(std::is_same_v<float64_t, FloatType>)
@@ -424,6 +441,10 @@ fmul(FloatType a, FloatType b)
 template<typename FloatType> FloatType
 fsqrt(FloatType a)
 {
+    FloatType res;
+    if (host_fp::sqrt(a, res))
+        return res;
+
     if constexpr(std::is_same_v<float32_t, FloatType>)
         return f32_sqrt(a);
     else if constexpr(std::is_same_v<float64_t, FloatType>)
@@ -49,6 +49,16 @@ class X86PagetableWalker(ClockedObject):
     num_squash_per_cycle = Param.Unsigned(
         4, "Number of outstanding walks that can be squashed per cycle"
     )
+    pwc_size = Param.Unsigned(
+        0,
+        "Number of entries of the page walk cache, holding the non-leaf "
+        "long mode page table entries (0 to disable it)",
+    )
+    memoize_functional = Param.Bool(
+        False,
+        "Remember the result of functional walks until the TLB is "
+        "invalidated, to speed up the simulation of functional accesses",
+    )
 
 
 class X86TLB(BaseTLB):
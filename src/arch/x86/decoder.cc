@@ -48,7 +48,8 @@ Decoder::doResetState()
 {
     origPC = basePC + offset;
     DPRINTF(Decoder, "Setting origPC to %#x\n", origPC);
-    instBytes = &decodePages->lookup(origPC);
+    cacheSlot = &decodePages.get().lookup(origPC);
+    cached = *cacheSlot;
     chunkIdx = 0;
 
     emi.rex = 0;
@@ -66,10 +67,10 @@ Decoder::doResetState()
     emi.modRM = 0;
     emi.sib = 0;
 
-    if (instBytes->si) {
+    if (cached) {
         return FromCacheState;
     } else {
-        instBytes->chunks.clear();
+        instBytes.chunks.clear();
         return PrefixState;
     }
 }
@@ -90,7 +91,7 @@ Decoder::process()
     if (state == FromCacheState) {
         state = doFromCacheState();
     } else {
-        instBytes->chunks.push_back(fetchChunk);
+        instBytes.chunks.push_back(fetchChunk);
     }
 
     // While there's still something to do...
@@ -148,23 +149,24 @@ Decoder::State
 Decoder::doFromCacheState()
 {
     DPRINTF(Decoder, "Looking at cache state.\n");
-    if ((fetchChunk & instBytes->masks[chunkIdx]) !=
-            instBytes->chunks[chunkIdx]) {
+    if ((fetchChunk & cached->masks[chunkIdx]) !=
+            cached->chunks[chunkIdx]) {
         DPRINTF(Decoder, "Decode cache miss.\n");
         // The chached chunks didn't match what was fetched. Fall back to the
-        // predecoder.
-        instBytes->chunks[chunkIdx] = fetchChunk;
-        instBytes->chunks.resize(chunkIdx + 1);
-        instBytes->si = NULL;
+        // predecoder, starting from the chunks which did match.
+        instBytes.chunks.assign(cached->chunks.begin(),
+                                cached->chunks.begin() + chunkIdx);
+        instBytes.chunks.push_back(fetchChunk);
+        cached.reset();
         chunkIdx = 0;
-        fetchChunk = instBytes->chunks[0];
+        fetchChunk = instBytes.chunks[0];
         offset = origPC % sizeof(MachInst);
         basePC = origPC - offset;
         return PrefixState;
-    } else if (chunkIdx == instBytes->chunks.size() - 1) {
+    } else if (chunkIdx == cached->chunks.size() - 1) {
         // We matched the cache, so use its value.
         instDone = true;
-        offset = instBytes->lastOffset;
+        offset = cached->lastOffset;
         if (offset == sizeof(MachInst))
             outOfBytes = true;
         return ResetState;
@@ -671,20 +673,18 @@ Decoder::doImmediateState()
     return nextState;
 }
 
-Decoder::InstBytes Decoder::dummy;
-Decoder::InstCacheMap Decoder::instCacheMap;
-
 StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
     StaticInstPtr si;
 
-    auto iter = instMap->find(mach_inst);
-    if (iter != instMap->end()) {
+    auto &inst_map = instMap.get();
+    auto iter = inst_map.find(mach_inst);
+    if (iter != inst_map.end()) {
         si = iter->second;
     } else {
         si = decodeInst(mach_inst);
-        (*instMap)[mach_inst] = si;
+        inst_map[mach_inst] = si;
     }
 
     si->size(basePC + offset - origPC);
@@ -702,39 +702,43 @@ Decoder::decode(PCStateBase &next_pc)
     instDone = false;
     updateNPC(next_pc.as<PCState>());
 
-    StaticInstPtr &si = instBytes->si;
-    if (si)
-        return si;
+    if (cached)
+        return cached->si;
 
     // We didn't match in the AddrMap, but we still populated an entry. Fix
     // up its byte masks.
     const int chunkSize = sizeof(MachInst);
 
-    instBytes->lastOffset = offset;
+    instBytes.lastOffset = offset;
 
-    Addr firstBasePC = basePC - (instBytes->chunks.size() - 1) * chunkSize;
+    Addr firstBasePC = basePC - (instBytes.chunks.size() - 1) * chunkSize;
     Addr firstOffset = origPC - firstBasePC;
-    Addr totalSize = instBytes->lastOffset - firstOffset +
-        (instBytes->chunks.size() - 1) * chunkSize;
+    Addr totalSize = instBytes.lastOffset - firstOffset +
+        (instBytes.chunks.size() - 1) * chunkSize;
     int start = firstOffset;
-    instBytes->masks.clear();
+    instBytes.masks.clear();
 
     while (totalSize) {
         int end = start + totalSize;
         end = (chunkSize < end) ? chunkSize : end;
         int size = end - start;
-        int idx = instBytes->masks.size();
+        int idx = instBytes.masks.size();
 
         MachInst maskVal = mask(size * 8) << (start * 8);
         assert(maskVal);
 
-        instBytes->masks.push_back(maskVal);
-        instBytes->chunks[idx] &= instBytes->masks[idx];
+        instBytes.masks.push_back(maskVal);
+        instBytes.chunks[idx] &= instBytes.masks[idx];
         totalSize -= size;
         start = 0;
     }
 
-    return decode(emi, origPC);
+    // Publish a new entry rather than updating the old one, which other
+    // decoders may still be matching against.
+    auto entry = std::make_shared<InstBytes>(instBytes);
+    entry->si = decode(emi, origPC);
+    *cacheSlot = entry;
+    return entry->si;
 }
 
 StaticInstPtr
@@ -30,7 +30,7 @@
 #define __ARCH_X86_DECODER_HH__
 
 #include <cassert>
-#include <unordered_map>
+#include <memory>
 #include <vector>
 
 #include "arch/generic/decoder.hh"
@@ -88,11 +88,14 @@ class Decoder : public InstDecoder
         {}
     };
 
-    static InstBytes dummy;
-
     // The bytes to be predecoded.
     MachInst fetchChunk;
-    InstBytes *instBytes = &dummy;
+    // The bytes of the instruction being predecoded.
+    InstBytes instBytes;
+    // The shared cache entry being matched against the fetched bytes.
+    std::shared_ptr<const InstBytes> cached;
+    // Where the shared cache entry for origPC lives.
+    std::shared_ptr<const InstBytes> *cacheSlot = nullptr;
     int chunkIdx;
     // The pc of the start of fetchChunk.
     Addr basePC = 0;
@@ -149,13 +152,13 @@ class Decoder : public InstDecoder
         assert(offset <= sizeof(MachInst));
         if (offset == sizeof(MachInst)) {
             DPRINTF(Decoder, "At the end of a chunk, idx = %d, chunks = %d.\n",
-                    chunkIdx, instBytes->chunks.size());
+                    chunkIdx, instBytes.chunks.size());
             chunkIdx++;
-            if (chunkIdx == instBytes->chunks.size()) {
+            if (chunkIdx == instBytes.chunks.size()) {
                 outOfBytes = true;
             } else {
                 offset = 0;
-                fetchChunk = instBytes->chunks[chunkIdx];
+                fetchChunk = instBytes.chunks[chunkIdx];
                 basePC += sizeof(MachInst);
             }
         }
@@ -236,15 +239,18 @@ class Decoder : public InstDecoder
 
     typedef RegVal CacheKey;
 
-    typedef decode_cache::AddrMap<Decoder::InstBytes> DecodePages;
-    DecodePages *decodePages = nullptr;
-    typedef std::unordered_map<CacheKey, DecodePages *> AddrCacheMap;
-    AddrCacheMap addrCacheMap;
+    /// Cache entries are immutable once published, and are replaced
+    /// rather than updated so that decoders which are part way through
+    /// matching an entry don't see it change under them.
+    typedef decode_cache::AddrMap<std::shared_ptr<const InstBytes>>
+        DecodePages;
+    /// Predecoded instruction bytes shared with the other decoders on
+    /// this thread, indexed by the m5Reg they were decoded under.
+    decode_cache::SharedMap<DecodePages, CacheKey> decodePages;
 
-    decode_cache::InstMap<ExtMachInst> *instMap = nullptr;
-    typedef std::unordered_map<
-            CacheKey, decode_cache::InstMap<ExtMachInst> *> InstCacheMap;
-    static InstCacheMap instCacheMap;
+    /// Decoded instructions shared with the other decoders on this
+    /// thread, indexed by the m5Reg they were decoded under.
+    decode_cache::SharedInstMap<ExtMachInst, CacheKey> instMap;
 
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
@@ -279,21 +285,8 @@ class Decoder : public InstDecoder
         defAddr = m5Reg.defAddr;
         stack = m5Reg.stack;
 
-        AddrCacheMap::iterator amIter = addrCacheMap.find(m5Reg);
-        if (amIter != addrCacheMap.end()) {
-            decodePages = amIter->second;
-        } else {
-            decodePages = new DecodePages;
-            addrCacheMap[m5Reg] = decodePages;
-        }
-
-        InstCacheMap::iterator imIter = instCacheMap.find(m5Reg);
-        if (imIter != instCacheMap.end()) {
-            instMap = imIter->second;
-        } else {
-            instMap = new decode_cache::InstMap<ExtMachInst>;
-            instCacheMap[m5Reg] = instMap;
-        }
+        decodePages.setContext(m5Reg);
+        instMap.setContext(m5Reg);
     }
 
     void
@@ -419,12 +419,14 @@ X86ISA::Interrupts::readReg(ApicRegIndex reg)
         break;
       case APIC_CURRENT_COUNT:
         {
-            if (apicTimerEvent.scheduled()) {
+            catchUpApicTimer();
+            if (apicTimerSkipping || apicTimerEvent.scheduled()) {
                 // Compute how many m5 ticks happen per count.
                 uint64_t ticksPerCount = clockPeriod() *
                     divideFromConf(regs[APIC_DIVIDE_CONFIGURATION]);
                 // Compute how many m5 ticks are left.
-                uint64_t val = apicTimerEvent.when() - curTick();
+                uint64_t val = (apicTimerSkipping ? apicTimerDeadline :
+                                apicTimerEvent.when()) - curTick();
                 // Turn that into a count.
                 val = (val + ticksPerCount - 1) / ticksPerCount;
                 return val;
@@ -607,14 +609,19 @@ X86ISA::Interrupts::setReg(ApicRegIndex reg, uint32_t val)
             // Schedule on the edge of the next tick plus the new count.
             Tick offset = curTick() % clockPeriod();
             if (offset) {
-                reschedule(apicTimerEvent,
-                           curTick() + (newCount + 1) *
-                           clockPeriod() - offset, true);
+                armApicTimer(curTick() + (newCount + 1) *
+                             clockPeriod() - offset,
+                             newCount * clockPeriod());
             } else {
-                if (newCount)
-                    reschedule(apicTimerEvent,
-                               curTick() + newCount *
-                               clockPeriod(), true);
+                if (newCount) {
+                    armApicTimer(curTick() + newCount * clockPeriod(),
+                                 newCount * clockPeriod());
+                } else if (apicTimerSkipping) {
+                    // The pending expiry still happens, but the timer
+                    // isn't rearmed after it
+                    catchUpApicTimer();
+                    armApicTimer(apicTimerDeadline, 0);
+                }
             }
         }
         break;
@@ -627,10 +634,68 @@ X86ISA::Interrupts::setReg(ApicRegIndex reg, uint32_t val)
       default:
         break;
     }
+
+    const bool timer_config = reg == APIC_LVT_TIMER ||
+        reg == APIC_DIVIDE_CONFIGURATION;
+    // Account for the expiries skipped with the old configuration
+    if (timer_config)
+        catchUpApicTimer();
     regs[reg] = newVal;
+    if (timer_config)
+        updateApicTimerMode();
     return;
 }
 
+Tick
+X86ISA::Interrupts::apicTimerPeriodTicks() const
+{
+    return (Tick)bits(regs[APIC_INITIAL_COUNT], 31, 0) *
+        divideFromConf(regs[APIC_DIVIDE_CONFIGURATION]) * clockPeriod();
+}
+
+Tick
+X86ISA::Interrupts::apicTimerNextDeadline() const
+{
+    assert(apicTimerSkipping && apicTimerPeriod);
+    if (curTick() < apicTimerDeadline)
+        return apicTimerDeadline;
+    return apicTimerDeadline + ((curTick() - apicTimerDeadline) /
+            apicTimerPeriod + 1) * apicTimerPeriod;
+}
+
+void
+X86ISA::Interrupts::catchUpApicTimer()
+{
+    if (apicTimerSkipping)
+        apicTimerDeadline = apicTimerNextDeadline();
+}
+
+void
+X86ISA::Interrupts::armApicTimer(Tick when, Tick period)
+{
+    LVTEntry entry = regs[APIC_LVT_TIMER];
+    if (entry.masked && entry.periodic && period) {
+        if (apicTimerEvent.scheduled())
+            deschedule(apicTimerEvent);
+        apicTimerSkipping = true;
+        apicTimerDeadline = when;
+        apicTimerPeriod = period;
+    } else {
+        apicTimerSkipping = false;
+        reschedule(apicTimerEvent, when, true);
+    }
+}
+
+void
+X86ISA::Interrupts::updateApicTimerMode()
+{
+    // Expiries after the next one use the current configuration
+    if (apicTimerSkipping)
+        armApicTimer(apicTimerDeadline, apicTimerPeriodTicks());
+    else if (apicTimerEvent.scheduled())
+        armApicTimer(apicTimerEvent.when(), apicTimerPeriodTicks());
+}
+
 
 X86ISA::Interrupts::Interrupts(const Params &p)
     : BaseInterrupts(p), sys(p.system), clockDomain(*p.clk_domain),
@@ -780,9 +845,12 @@ X86ISA::Interrupts::serialize(CheckpointOut &cp) const
     SERIALIZE_SCALAR(pendingIPIs);
     SERIALIZE_SCALAR(IRRV);
     SERIALIZE_SCALAR(ISRV);
-    bool apicTimerEventScheduled = apicTimerEvent.scheduled();
+    // A skipping timer is stored as if its next expiry was scheduled
+    bool apicTimerEventScheduled = apicTimerEvent.scheduled() ||
+        apicTimerSkipping;
     SERIALIZE_SCALAR(apicTimerEventScheduled);
-    Tick apicTimerEventTick = apicTimerEvent.when();
+    Tick apicTimerEventTick = apicTimerSkipping ?
+        apicTimerNextDeadline() : apicTimerEvent.when();
     SERIALIZE_SCALAR(apicTimerEventTick);
 }
 
@@ -810,11 +878,9 @@ X86ISA::Interrupts::unserialize(CheckpointIn &cp)
     if (apicTimerEventScheduled) {
         Tick apicTimerEventTick;
         UNSERIALIZE_SCALAR(apicTimerEventTick);
-        if (apicTimerEvent.scheduled()) {
-            reschedule(apicTimerEvent, apicTimerEventTick, true);
-        } else {
-            schedule(apicTimerEvent, apicTimerEventTick);
-        }
+        armApicTimer(apicTimerEventTick, apicTimerPeriodTicks());
+    } else {
+        apicTimerSkipping = false;
     }
 }
 
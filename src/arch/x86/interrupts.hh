@@ -101,6 +101,28 @@ class Interrupts : public BaseInterrupts
     EventFunctionWrapper apicTimerEvent;
     void processApicTimerEvent();
 
+    /*
+     * A periodic timer whose interrupt is masked doesn't schedule any
+     * event, as every expiry would only rearm it. This keeps idle cores
+     * from waking up the simulator on each timer period. The next expiry
+     * and the period are recorded instead, and the expiries that went by
+     * are accounted for when the timer is read or reprogrammed.
+     */
+    bool apicTimerSkipping = false;
+    Tick apicTimerDeadline = 0;
+    Tick apicTimerPeriod = 0;
+
+    /** Period of the timer in periodic mode, in ticks */
+    Tick apicTimerPeriodTicks() const;
+    /** Next expiry of a timer that is skipping its expiries */
+    Tick apicTimerNextDeadline() const;
+    /** Move the deadline of a skipping timer past the current tick */
+    void catchUpApicTimer();
+    /** Arm the timer to expire at the given tick */
+    void armApicTimer(Tick when, Tick period);
+    /** Rearm the timer after a change of its configuration */
+    void updateApicTimerMode();
+
     /*
      * A set of variables to keep track of interrupts that don't go through
      * the IRR.
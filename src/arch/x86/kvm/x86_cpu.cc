@@ -726,13 +726,18 @@ X86KvmCPU::dumpMSRs() const
 }
 
 void
-X86KvmCPU::updateKvmState()
-{
-    updateKvmStateRegs();
-    updateKvmStateSRegs();
-    updateKvmStateFPU();
-    updateKvmStateMSRs();
-    updateKvmStateXCRs();
+X86KvmCPU::updateKvmState(StateMask groups)
+{
+    if (groups & RegState)
+        updateKvmStateRegs();
+    if (groups & SysState)
+        updateKvmStateSRegs();
+    if (groups & FPState)
+        updateKvmStateFPU();
+    if (groups & SysState) {
+        updateKvmStateMSRs();
+        updateKvmStateXCRs();
+    }
 
     DPRINTF(KvmContext, "X86KvmCPU::updateKvmState():\n");
     if (debug::KvmContext)
@@ -1016,38 +1021,50 @@ X86KvmCPU::updateKvmStateXCRs()
 }
 
 void
-X86KvmCPU::updateThreadContext()
+X86KvmCPU::updateThreadContext(StateMask groups)
 {
     struct kvm_regs regs;
     struct kvm_sregs sregs;
 
-    getRegisters(regs);
-    getSpecialRegisters(sregs);
+    // The PC is relative to the CS base, so the integer registers need
+    // the special registers as well.
+    if (groups & RegState)
+        getRegisters(regs);
+    if (groups & (RegState | SysState))
+        getSpecialRegisters(sregs);
 
-    DPRINTF(KvmContext, "X86KvmCPU::updateThreadContext():\n");
+    DPRINTF(KvmContext, "X86KvmCPU::updateThreadContext(%#x):\n", groups);
     if (debug::KvmContext)
         dump();
 
-    updateThreadContextRegs(regs, sregs);
-    updateThreadContextSRegs(sregs);
-    if (useXSave) {
-        struct kvm_xsave xsave;
-        getXSave(xsave);
+    if (groups & RegState)
+        updateThreadContextRegs(regs, sregs);
+    if (groups & SysState)
+        updateThreadContextSRegs(sregs);
+    if (groups & FPState) {
+        if (useXSave) {
+            struct kvm_xsave xsave;
+            getXSave(xsave);
 
-       updateThreadContextXSave(xsave);
-    } else {
-        struct kvm_fpu fpu;
-        getFPUState(fpu);
+            updateThreadContextXSave(xsave);
+        } else {
+            struct kvm_fpu fpu;
+            getFPUState(fpu);
 
-        updateThreadContextFPU(fpu);
+            updateThreadContextFPU(fpu);
+        }
+    }
+    if (groups & SysState) {
+        updateThreadContextMSRs();
+        updateThreadContextXCRs();
     }
-    updateThreadContextMSRs();
-    updateThreadContextXCRs();
 
     // The M5 misc reg caches some values from other
-    // registers. Writing to it with side effects causes it to be
-    // updated from its source registers.
-    tc->setMiscReg(misc_reg::M5Reg, 0);
+    // registers (control registers, segments and rflags). Writing to
+    // it with side effects causes it to be updated from its source
+    // registers.
+    if (groups & (RegState | SysState))
+        tc->setMiscReg(misc_reg::M5Reg, 0);
 }
 
 void
@@ -1251,7 +1268,7 @@ X86KvmCPU::deliverInterrupts()
         fault.get()->invoke(tc);
         // Delay the kvm state update since we won't enter KVM on this
         // tick.
-        threadContextDirty = true;
+        threadContextDirty = AllState;
         // HACK: gem5 doesn't actually have any BIOS code, which means
         // that we need to halt the thread and wait for a startup
         // interrupt before restarting the thread. The simulated CPUs
@@ -1262,7 +1279,7 @@ X86KvmCPU::deliverInterrupts()
         fault.get()->invoke(tc);
         // The kvm state is assumed to have been updated when entering
         // kvmRun(), so we need to update manually it here.
-        updateKvmState();
+        updateKvmState(AllState);
     } else if (x86int) {
         struct kvm_interrupt kvm_int;
         kvm_int.irq = x86int->getVector();
@@ -1428,7 +1445,7 @@ X86KvmCPU::handleKvmExitIO()
     // prevent races in multi-core mode.
     EventQueue::ScopedMigration migrate(deviceEventQueue());
     for (int i = 0; i < count; ++i) {
-        RequestPtr io_req = std::make_shared<Request>(
+        RequestPtr io_req = Request::create(
             pAddr, kvm_run.io.size,
             Request::UNCACHEABLE, dataRequestorId());
 
@@ -146,8 +146,14 @@ class X86KvmCPU : public BaseKvmCPU
     void setVCpuEvents(const struct kvm_vcpu_events &events);
     /** @} */
 
-    void updateKvmState() override;
-    void updateThreadContext() override;
+    void updateKvmState(StateMask groups) override;
+    void updateThreadContext(StateMask groups) override;
+
+    /**
+     * Routing MMIOs only needs the local APIC base, which ioctlRun()
+     * reads back after every entry into KVM.
+     */
+    StateMask mmioState() const override { return 0; }
 
     /**
      * Inject pending interrupts from gem5 into the virtual CPU.
@@ -50,6 +50,7 @@
 #include "arch/x86/pagetable_walker.hh"
 
 #include <memory>
+#include <tuple>
 
 #include "arch/x86/faults.hh"
 #include "arch/x86/pagetable.hh"
@@ -97,8 +98,83 @@ Fault
 Walker::startFunctional(ThreadContext * _tc, Addr &addr, unsigned &logBytes,
               BaseMMU::Mode _mode)
 {
+    Addr key = 0;
+    if (memoizeFunctional) {
+        const RegVal cr3 = _tc->readMiscRegNoEffect(misc_reg::Cr3);
+        if (cr3 != memoCr3) {
+            memo.clear();
+            memoCr3 = cr3;
+        }
+
+        key = (addr & ~mask(PageShift)) | (_mode == BaseMMU::Execute);
+        auto it = memo.find(key);
+        if (it != memo.end()) {
+            stats.memoHits++;
+            std::tie(addr, logBytes) = it->second;
+            return NoFault;
+        }
+        stats.memoMisses++;
+    }
+
     funcState.initState(_tc, _mode);
-    return funcState.startFunctional(addr, logBytes);
+    Fault fault = funcState.startFunctional(addr, logBytes);
+
+    // Only remember translations, as a non-present page may be mapped
+    // without invalidating the TLB
+    if (memoizeFunctional && fault == NoFault) {
+        if (memo.size() >= maxMemo)
+            memo.clear();
+        memo[key] = std::make_pair(addr, logBytes);
+    }
+    return fault;
+}
+
+const Walker::PwcEntry *
+Walker::pwcLookup(Addr vaddr, uint64_t pcid)
+{
+    PwcEntry *hit = nullptr;
+    for (auto &pwc_entry : pwc) {
+        if (pwc_entry.valid && pwc_entry.pcid == pcid &&
+            pwc_entry.tag == pwcTag(vaddr, pwc_entry.level) &&
+            (!hit || pwc_entry.level > hit->level)) {
+            hit = &pwc_entry;
+        }
+    }
+
+    if (hit) {
+        hit->lruSeq = ++pwcSeq;
+        stats.pwcHits[hit->level]++;
+    } else {
+        stats.pwcMisses++;
+    }
+    return hit;
+}
+
+void
+Walker::pwcInsert(const PwcEntry &pwc_entry)
+{
+    PwcEntry *victim = &pwc[0];
+    for (auto &e : pwc) {
+        if (e.valid && e.level == pwc_entry.level &&
+            e.tag == pwc_entry.tag && e.pcid == pwc_entry.pcid) {
+            victim = &e;
+            break;
+        }
+        if (!e.valid || (victim->valid && e.lruSeq < victim->lruSeq))
+            victim = &e;
+    }
+
+    *victim = pwc_entry;
+    victim->valid = true;
+    victim->lruSeq = ++pwcSeq;
+}
+
+void
+Walker::flushCaches()
+{
+    for (auto &pwc_entry : pwc)
+        pwc_entry.valid = false;
+    memo.clear();
 }
 
 bool
@@ -312,6 +388,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         }
         entry.noExec = pte.nx;
         nextState = LongPDP;
+        fillPwc(0, pte);
         break;
       case LongPDP:
         DPRINTF(PageTableWalker, "Got long mode PDP entry %#016x.\n", pte);
@@ -326,6 +403,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             break;
         }
         nextState = LongPD;
+        fillPwc(1, pte);
         break;
       case LongPD:
         DPRINTF(PageTableWalker, "Got long mode PD entry %#016x.\n", pte);
@@ -343,6 +421,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             entry.logBytes = 12;
             nextRead = mbits(pte, 51, 12) + vaddr.longl1 * dataSize;
             nextState = LongPTE;
+            fillPwc(2, pte);
             break;
         } else {
             // 2 MB page
@@ -526,7 +605,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         //If we didn't return, we're setting up another read.
         Request::Flags flags = oldRead->req->getFlags();
         flags.set(Request::UNCACHEABLE, uncacheable);
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             nextRead, oldRead->getSize(), flags, walker->requestorId);
         read = new Packet(request, MemCmd::ReadReq);
         read->allocate();
@@ -547,6 +626,26 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     return fault;
 }
 
+void
+Walker::WalkerState::fillPwc(int level, PageTableEntry pte)
+{
+    pathNX = pathNX || pte.nx;
+    if (functional || walker->pwc.empty())
+        return;
+
+    PwcEntry pwc_entry;
+    pwc_entry.level = level;
+    pwc_entry.tag = pwcTag(entry.vaddr, level);
+    pwc_entry.pcid = pcid;
+    pwc_entry.table = mbits(pte, 51, 12);
+    pwc_entry.uncacheable = pte.pcd;
+    pwc_entry.writable = entry.writable;
+    pwc_entry.user = entry.user;
+    pwc_entry.noExec = entry.noExec;
+    pwc_entry.nx = pathNX;
+    walker->pwcInsert(pwc_entry);
+}
+
 void
 Walker::WalkerState::endWalk()
 {
@@ -565,11 +664,33 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     Efer efer = tc->readMiscRegNoEffect(misc_reg::Efer);
     dataSize = 8;
     Addr topAddr;
+    const PwcEntry *pwc_hit = nullptr;
+    pcid = cr4.pcide ? cr3.pcid : 0;
+    pathNX = false;
     if (efer.lma) {
         // Do long mode.
         state = LongPML4;
         topAddr = (cr3.longPdtb << 12) + addr.longl4 * dataSize;
         enableNX = efer.nxe;
+
+        // Skip the levels held in the page walk cache. A fetch through
+        // a level with NX set walks the tables to raise the fault.
+        if (!functional && !walker->pwc.empty())
+            pwc_hit = walker->pwcLookup(vaddr, pcid);
+        if (pwc_hit && pwc_hit->nx && mode == BaseMMU::Execute && enableNX)
+            pwc_hit = nullptr;
+        if (pwc_hit) {
+            const Addr index[] = { addr.longl3, addr.longl2, addr.longl1 };
+            const State next[] = { LongPDP, LongPD, LongPTE };
+            state = next[pwc_hit->level];
+            topAddr = pwc_hit->table + index[pwc_hit->level] * dataSize;
+            entry.writable = pwc_hit->writable;
+            entry.user = pwc_hit->user;
+            entry.noExec = pwc_hit->noExec;
+            if (pwc_hit->level == 2)
+                entry.logBytes = 12;
+            pathNX = pwc_hit->nx;
+        }
     } else {
         // We're in some flavor of legacy mode.
         if (cr4.pae) {
@@ -598,10 +719,12 @@ Walker::WalkerState::setupWalk(Addr vaddr)
 
     // PCD can't be used if CR4.PCIDE=1 [sec 2.5
     // of Intel's Software Developer's manual]
-    if (!cr4.pcide && cr3.pcd)
+    if (pwc_hit)
+        flags.set(Request::UNCACHEABLE, pwc_hit->uncacheable);
+    else if (!cr4.pcide && cr3.pcd)
         flags.set(Request::UNCACHEABLE);
 
-    RequestPtr request = std::make_shared<Request>(
+    RequestPtr request = Request::create(
         topAddr, dataSize, flags, walker->requestorId);
 
     read = new Packet(request, MemCmd::ReadReq);
@@ -749,5 +872,26 @@ Walker::WalkerState::pageFault(bool present)
                                        m5reg.cpl == 3, false);
 }
 
+Walker::WalkerStats::WalkerStats(Walker *parent)
+  : statistics::Group(parent),
+    ADD_STAT(pwcHits, statistics::units::Count::get(),
+             "Walks starting from a page walk cache entry, by level"),
+    ADD_STAT(pwcMisses, statistics::units::Count::get(),
+             "Walks missing in the page walk cache"),
+    ADD_STAT(memoHits, statistics::units::Count::get(),
+             "Functional walks served from a previous one"),
+    ADD_STAT(memoMisses, statistics::units::Count::get(),
+             "Functional walks done through the page tables")
+{
+    pwcHits
+        .init(3)
+        .subname(0, "pml4")
+        .subname(1, "pdp")
+        .subname(2, "pd")
+        .flags(statistics::nozero);
+    memoHits.flags(statistics::nozero);
+    memoMisses.flags(statistics::nozero);
+}
+
 } // namespace X86ISA
 } // namespace gem5
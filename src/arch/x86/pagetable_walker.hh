@@ -38,6 +38,8 @@
 #ifndef __ARCH_X86_PAGE_TABLE_WALKER_HH__
 #define __ARCH_X86_PAGE_TABLE_WALKER_HH__
 
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "arch/generic/mmu.hh"
@@ -48,6 +50,7 @@
 #include "params/X86PagetableWalker.hh"
 #include "sim/clocked_object.hh"
 #include "sim/faults.hh"
+#include "sim/stats.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -115,6 +118,9 @@ namespace X86ISA
             bool retrying;
             bool started;
             bool squashed;
+            // PCID the walk is for, and if any level so far had NX set
+            uint64_t pcid;
+            bool pathNX;
           public:
             WalkerState(Walker * _walker, BaseMMU::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -144,6 +150,7 @@ namespace X86ISA
             void sendPackets();
             void endWalk();
             Fault pageFault(bool present);
+            void fillPwc(int level, PageTableEntry pte);
         };
 
         friend class WalkerState;
@@ -178,6 +185,61 @@ namespace X86ISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        /**
+         * An entry of the page walk cache, holding a non-leaf long mode
+         * page table entry so that walks can skip the levels above it.
+         */
+        struct PwcEntry
+        {
+            bool valid = false;
+            // Level of the entry, 0 for PML4, 1 for PDP and 2 for PD
+            int level = 0;
+            // Virtual address bits above the level, and PCID
+            Addr tag = 0;
+            uint64_t pcid = 0;
+            // Base address of the next level table
+            Addr table = 0;
+            bool uncacheable = false;
+            // Permissions accumulated down to this level
+            bool writable = false;
+            bool user = false;
+            bool noExec = false;
+            bool nx = false;
+            uint64_t lruSeq = 0;
+        };
+
+        static Addr
+        pwcTag(Addr vaddr, int level)
+        {
+            return bits(vaddr, 47, 39 - 9 * level);
+        }
+
+        std::vector<PwcEntry> pwc;
+        uint64_t pwcSeq;
+
+        /** Find the deepest cached entry for an address, if any */
+        const PwcEntry *pwcLookup(Addr vaddr, uint64_t pcid);
+        void pwcInsert(const PwcEntry &pwc_entry);
+
+        /**
+         * Results of functional walks for the current CR3, keyed by
+         * page and whether the access is a fetch.
+         */
+        const bool memoizeFunctional;
+        std::unordered_map<Addr, std::pair<Addr, unsigned>> memo;
+        RegVal memoCr3;
+        static const size_t maxMemo = 4096;
+
+        struct WalkerStats : public statistics::Group
+        {
+            WalkerStats(Walker *parent);
+
+            statistics::Vector pwcHits;
+            statistics::Scalar pwcMisses;
+            statistics::Scalar memoHits;
+            statistics::Scalar memoMisses;
+        } stats;
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -198,6 +260,13 @@ namespace X86ISA
             tlb = _tlb;
         }
 
+        /**
+         * Forget the page walk cache and the memoized functional walks.
+         * Called when the TLB is invalidated, as the page tables may
+         * have changed.
+         */
+        void flushCaches();
+
         using Params = X86PagetableWalkerParams;
 
         Walker(const Params &params) :
@@ -205,6 +274,9 @@ namespace X86ISA
             funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
             requestorId(sys->getRequestorId(this)),
             numSquashable(params.num_squash_per_cycle),
+            pwc(params.pwc_size), pwcSeq(0),
+            memoizeFunctional(params.memoize_functional), memoCr3(0),
+            stats(this),
             startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
         {
         }
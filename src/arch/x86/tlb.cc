@@ -91,6 +91,7 @@ TLB::evictLRU()
     }
 
     assert(tlb[lru].trieHandle);
+    lookupCache.invalidate(&tlb[lru]);
     trie.remove(tlb[lru].trieHandle);
     tlb[lru].trieHandle = NULL;
     freeList.push_back(&tlb[lru]);
@@ -122,6 +123,9 @@ TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
     newEntry->lruSeq = nextSeq();
     newEntry->vaddr = vpn;
     if (FullSystem) {
+        // A large page may cover keys cached for smaller pages
+        if (entry.logBytes > PageShift)
+            lookupCache.flush();
         newEntry->trieHandle =
         trie.insert(vpn, TlbEntryTrie::MaxBits-entry.logBytes, newEntry);
     }
@@ -141,10 +145,26 @@ TLB::lookup(Addr va, bool update_lru)
     return entry;
 }
 
+TlbEntry *
+TLB::lookupCached(Addr va, BaseMMU::Mode mode)
+{
+    TlbEntry *entry = lookupCache.lookup(va, mode);
+    if (!entry) {
+        entry = trie.lookup(va);
+        if (!entry)
+            return nullptr;
+        lookupCache.fill(va, mode, entry);
+    }
+    entry->lruSeq = nextSeq();
+    return entry;
+}
+
 void
 TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
+    lookupCache.flush();
+    walker->flushCaches();
     for (unsigned i = 0; i < size; i++) {
         if (tlb[i].trieHandle) {
             trie.remove(tlb[i].trieHandle);
@@ -164,6 +184,8 @@ void
 TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
+    lookupCache.flush();
+    walker->flushCaches();
     for (unsigned i = 0; i < size; i++) {
         if (tlb[i].trieHandle && !tlb[i].global) {
             trie.remove(tlb[i].trieHandle);
@@ -176,8 +198,12 @@ TLB::flushNonGlobal()
 void
 TLB::demapPage(Addr va, uint64_t asn)
 {
+    // INVLPG also invalidates the paging structure caches
+    walker->flushCaches();
+
     TlbEntry *entry = trie.lookup(va);
     if (entry) {
+        lookupCache.invalidate(entry);
         trie.remove(entry->trieHandle);
         entry->trieHandle = NULL;
         freeList.push_back(entry);
@@ -416,7 +442,7 @@ TLB::translate(const RequestPtr &req,
                 pcid = 0x000;
 
             pageAlignedVaddr = concAddrPcid(pageAlignedVaddr, pcid);
-            TlbEntry *entry = lookup(pageAlignedVaddr);
+            TlbEntry *entry = lookupCached(pageAlignedVaddr, mode);
 
             if (mode == BaseMMU::Read) {
                 stats.rdAccesses++;
@@ -439,7 +465,7 @@ TLB::translate(const RequestPtr &req,
                         delayedResponse = true;
                         return fault;
                     }
-                    entry = lookup(pageAlignedVaddr);
+                    entry = lookupCached(pageAlignedVaddr, mode);
                     assert(entry);
                 } else {
                     Process *p = tc->getProcessPtr();
@@ -615,6 +641,7 @@ TLB::unserialize(CheckpointIn &cp)
     }
 
     UNSERIALIZE_SCALAR(lruSeq);
+    lookupCache.flush();
 
     for (uint32_t x = 0; x < _size; x++) {
         TlbEntry *newEntry = freeList.front();
@@ -42,6 +42,7 @@
 #include <vector>
 
 #include "arch/generic/tlb.hh"
+#include "arch/generic/tlb_lookup_cache.hh"
 #include "arch/x86/pagetable.hh"
 #include "base/trie.hh"
 #include "mem/request.hh"
@@ -86,6 +87,12 @@ namespace X86ISA
 
         EntryList::iterator lookupIt(Addr va, bool update_lru = true);
 
+        /**
+         * Look up the entry of a page aligned and PCID tagged address
+         * for a translation, going through the lookup cache first.
+         */
+        TlbEntry *lookupCached(Addr va, BaseMMU::Mode mode);
+
         Walker * walker;
 
       public:
@@ -107,6 +114,9 @@ namespace X86ISA
         TlbEntryTrie trie;
         uint64_t lruSeq;
 
+        /** Recent translations, to avoid walking the trie */
+        TlbLookupCache<TlbEntry> lookupCache;
+
         AddrRange m5opRange;
 
         struct TlbStats : public statistics::Group
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_ADDR_FILTER_HH__
+#define __BASE_ADDR_FILTER_HH__
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A counting filter over the address ranges of a changing set of
+ * accesses, which tells whether a range may overlap any of them. It is
+ * meant to skip searches through queues of in-flight accesses (e.g. the
+ * load and store queues of a CPU) when they can't find anything.
+ *
+ * The ranges are counted by the blocks of 2^shift bytes they touch, in a
+ * small table indexed by a hash of the block number. The filter is exact
+ * in one direction only: if mayOverlap() returns false, no range in the
+ * set shares a block with the queried range, and thus no byte either.
+ * Ranges which hash to the same buckets can make it return true even
+ * though nothing overlaps.
+ */
+class AddrBlockFilter
+{
+  public:
+    /**
+     * What a range was counted as, kept by its owner so that it can be
+     * removed again.
+     */
+    class Handle
+    {
+      private:
+        friend class AddrBlockFilter;
+
+        Addr first = 0;
+        Addr last = 0;
+        bool counted = false;
+
+      public:
+        bool isCounted() const { return counted; }
+    };
+
+    /** Ranges spanning more blocks than this are counted as wide */
+    static constexpr Addr MaxBlocks = 4;
+
+    AddrBlockFilter(unsigned _shift=0) : shift(_shift) { counts.fill(0); }
+
+    /** Change the block size, which requires the filter to be empty */
+    void
+    setShift(unsigned _shift)
+    {
+        assert(empty());
+        shift = _shift;
+    }
+
+    bool empty() const { return total == 0; }
+
+    /**
+     * Count a range. If the handle was counted already, its old range is
+     * removed first. Empty ranges aren't counted.
+     */
+    void
+    insert(Handle &handle, Addr addr, Addr size)
+    {
+        remove(handle);
+        if (size == 0)
+            return;
+
+        handle.first = addr >> shift;
+        handle.last = (addr + size - 1) >> shift;
+        handle.counted = true;
+        total++;
+        if (isWide(handle.first, handle.last)) {
+            wide++;
+            return;
+        }
+        for (Addr block = handle.first; block <= handle.last; block++)
+            counts[bucket(block)]++;
+    }
+
+    /** Remove the range counted with a handle, if any */
+    void
+    remove(Handle &handle)
+    {
+        if (!handle.counted)
+            return;
+
+        handle.counted = false;
+        assert(total > 0);
+        total--;
+        if (isWide(handle.first, handle.last)) {
+            assert(wide > 0);
+            wide--;
+            return;
+        }
+        for (Addr block = handle.first; block <= handle.last; block++) {
+            assert(counts[bucket(block)] > 0);
+            counts[bucket(block)]--;
+        }
+    }
+
+    /**
+     * Whether a range may overlap any of the counted ones. An empty range
+     * overlaps nothing.
+     */
+    bool
+    mayOverlap(Addr addr, Addr size) const
+    {
+        if (total == 0 || size == 0)
+            return false;
+        if (wide > 0)
+            return true;
+
+        const Addr first = addr >> shift;
+        const Addr last = (addr + size - 1) >> shift;
+        if (isWide(first, last))
+            return true;
+        for (Addr block = first; block <= last; block++) {
+            if (counts[bucket(block)])
+                return true;
+        }
+        return false;
+    }
+
+    /** Forget all the ranges. Their handles must not be used again. */
+    void
+    clear()
+    {
+        counts.fill(0);
+        total = wide = 0;
+    }
+
+  private:
+    static constexpr unsigned BucketBits = 8;
+
+    static bool
+    isWide(Addr first, Addr last)
+    {
+        return last < first || last - first >= MaxBlocks;
+    }
+
+    static unsigned
+    bucket(Addr block)
+    {
+        // Fibonacci hashing, so that strided blocks spread out
+        return (block * 0x9e3779b97f4a7c15ULL) >> (64 - BucketBits);
+    }
+
+    unsigned shift;
+    std::array<uint32_t, 1 << BucketBits> counts;
+    /** Number of ranges counted, and of those which are wide */
+    size_t total = 0;
+    size_t wide = 0;
+};
+
+} // namespace gem5
+
+#endif // __BASE_ADDR_FILTER_HH__
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <deque>
+#include <random>
+
+#include "base/addr_filter.hh"
+
+using namespace gem5;
+
+TEST(AddrBlockFilterTest, Empty)
+{
+    AddrBlockFilter filter(6);
+    EXPECT_TRUE(filter.empty());
+    EXPECT_FALSE(filter.mayOverlap(0x1000, 8));
+}
+
+TEST(AddrBlockFilterTest, InsertRemove)
+{
+    AddrBlockFilter filter(6);
+    AddrBlockFilter::Handle a, b;
+
+    filter.insert(a, 0x1000, 8);
+    EXPECT_TRUE(a.isCounted());
+    EXPECT_TRUE(filter.mayOverlap(0x1000, 1));
+    EXPECT_TRUE(filter.mayOverlap(0x103f, 1));
+    EXPECT_TRUE(filter.mayOverlap(0xff8, 9));
+
+    // A range crossing into the next block
+    filter.insert(b, 0x207c, 8);
+    EXPECT_TRUE(filter.mayOverlap(0x2080, 4));
+
+    filter.remove(a);
+    EXPECT_FALSE(a.isCounted());
+    EXPECT_TRUE(filter.mayOverlap(0x2040, 64));
+    filter.remove(b);
+    EXPECT_TRUE(filter.empty());
+    EXPECT_FALSE(filter.mayOverlap(0x2080, 4));
+
+    // Removing twice is harmless
+    filter.remove(b);
+    EXPECT_TRUE(filter.empty());
+}
+
+TEST(AddrBlockFilterTest, Reinsert)
+{
+    AddrBlockFilter filter(6);
+    AddrBlockFilter::Handle a;
+
+    filter.insert(a, 0x1000, 8);
+    filter.insert(a, 0x5000, 8);
+    filter.remove(a);
+    EXPECT_TRUE(filter.empty());
+    EXPECT_FALSE(filter.mayOverlap(0x1000, 8));
+}
+
+TEST(AddrBlockFilterTest, EmptyRange)
+{
+    AddrBlockFilter filter(6);
+    AddrBlockFilter::Handle a, b;
+
+    filter.insert(a, 0x1000, 0);
+    EXPECT_FALSE(a.isCounted());
+    EXPECT_TRUE(filter.empty());
+
+    filter.insert(b, 0x1000, 8);
+    EXPECT_FALSE(filter.mayOverlap(0x1000, 0));
+}
+
+TEST(AddrBlockFilterTest, Wide)
+{
+    AddrBlockFilter filter(6);
+    AddrBlockFilter::Handle a;
+
+    // A range over more than MaxBlocks blocks overlaps anything
+    filter.insert(a, 0x1000, 64 * AddrBlockFilter::MaxBlocks + 1);
+    EXPECT_TRUE(filter.mayOverlap(0x800000, 1));
+    filter.remove(a);
+    EXPECT_FALSE(filter.mayOverlap(0x800000, 1));
+}
+
+namespace
+{
+
+struct Access
+{
+    Addr addr;
+    Addr size;
+    AddrBlockFilter::Handle handle;
+};
+
+/** Index of the oldest access sharing a block with a range, or -1 */
+int
+firstOverlap(const std::deque<Access> &queue, Addr addr, Addr size,
+             unsigned shift)
+{
+    if (size == 0)
+        return -1;
+    for (int i = 0; i < queue.size(); i++) {
+        const Access &a = queue[i];
+        if (a.size == 0)
+            continue;
+        if ((addr >> shift) <= ((a.addr + a.size - 1) >> shift) &&
+                (a.addr >> shift) <= ((addr + size - 1) >> shift)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+} // anonymous namespace
+
+/**
+ * Model a queue of in-flight accesses, searched with and without the
+ * filter, and check that the searches always agree.
+ */
+TEST(AddrBlockFilterTest, RandomizedEquivalence)
+{
+    std::mt19937_64 rng(1234);
+    for (unsigned shift: {4, 6, 12}) {
+        AddrBlockFilter filter(shift);
+        std::deque<Access> queue;
+        int skipped = 0;
+
+        for (int step = 0; step < 100000; step++) {
+            // Addresses in a small region, so that ranges collide often
+            auto random_addr = [&]() {
+                return rng() % 0x4000;
+            };
+            auto random_size = [&]() {
+                static const Addr sizes[] = {0, 1, 2, 4, 8, 16, 64, 300};
+                return sizes[rng() % 8];
+            };
+
+            switch (rng() % 4) {
+              case 0:
+                if (queue.size() < 128) {
+                    queue.push_back({random_addr(), random_size(), {}});
+                    Access &a = queue.back();
+                    filter.insert(a.handle, a.addr, a.size);
+                }
+                break;
+              case 1:
+                if (!queue.empty()) {
+                    filter.remove(queue.front().handle);
+                    queue.pop_front();
+                }
+                break;
+              case 2:
+                // A squash of the youngest access
+                if (!queue.empty()) {
+                    filter.remove(queue.back().handle);
+                    queue.pop_back();
+                }
+                break;
+              case 3:
+                // An access executing again at another address
+                if (!queue.empty()) {
+                    Access &a = queue[rng() % queue.size()];
+                    a.addr = random_addr();
+                    a.size = random_size();
+                    filter.insert(a.handle, a.addr, a.size);
+                }
+                break;
+            }
+
+            const Addr addr = random_addr();
+            const Addr size = random_size();
+            const int expected = firstOverlap(queue, addr, size, shift);
+            int found = -1;
+            if (filter.mayOverlap(addr, size))
+                found = firstOverlap(queue, addr, size, shift);
+            else
+                skipped++;
+            ASSERT_EQ(expected, found);
+        }
+
+        // The filter should actually save searches
+        EXPECT_GT(skipped, 0);
+        EXPECT_EQ(filter.empty(),
+                  std::none_of(queue.begin(), queue.end(),
+                      [](const Access &a) { return a.size != 0; }));
+    }
+}
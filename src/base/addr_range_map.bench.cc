@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * AddrRangeMap routes packets in the crossbars and finds the memory
+ * behind an address. The maps are small and built once, and lookups
+ * hit a few hot ranges most of the time, so the benchmarks look up
+ * addresses in a map shaped like a system memory map with and without
+ * the lookup cache and freezing.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "base/addr_range_map.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Number of ranges, e.g. the ports of a crossbar */
+const int numRanges = 16;
+/** Size of each range */
+const Addr rangeSize = 0x10000000;
+
+template <class Map>
+void
+fillMap(Map &map)
+{
+    for (int i = 0; i < numRanges; i++)
+        map.insert(RangeSize(i * rangeSize, rangeSize), i);
+}
+
+/**
+ * Addresses which mostly hit a couple of ranges, like the instruction
+ * and data footprint of a workload, with occasional accesses elsewhere.
+ */
+std::vector<Addr>
+makeAddrs()
+{
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<Addr> offset(0, rangeSize - 1);
+    std::uniform_int_distribution<int> range(0, numRanges - 1);
+    std::vector<Addr> addrs(4096);
+    for (size_t i = 0; i < addrs.size(); i++) {
+        int r = (i % 8 == 0) ? range(rng) : (i % 2);
+        addrs[i] = r * rangeSize + offset(rng);
+    }
+    return addrs;
+}
+
+template <class Map>
+void
+lookup(benchmark::State &state, Map &map)
+{
+    const std::vector<Addr> addrs = makeAddrs();
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(map.contains(addrs[i]));
+        i = (i + 1) % addrs.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void
+BM_AddrRangeMapLookup(benchmark::State &state)
+{
+    AddrRangeMap<int> map;
+    fillMap(map);
+    lookup(state, map);
+}
+BENCHMARK(BM_AddrRangeMapLookup);
+
+void
+BM_AddrRangeMapLookupCached(benchmark::State &state)
+{
+    AddrRangeMap<int, 3> map;
+    fillMap(map);
+    lookup(state, map);
+}
+BENCHMARK(BM_AddrRangeMapLookupCached);
+
+void
+BM_AddrRangeMapLookupFrozen(benchmark::State &state)
+{
+    AddrRangeMap<int> map;
+    fillMap(map);
+    map.freeze();
+    lookup(state, map);
+}
+BENCHMARK(BM_AddrRangeMapLookupFrozen);
+
+} // anonymous namespace
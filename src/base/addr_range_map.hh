@@ -46,6 +46,7 @@
 #include <list>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "base/addr_range.hh"
 #include "base/types.hh"
@@ -57,6 +58,12 @@ namespace gem5
  * The AddrRangeMap uses an STL map to implement an interval tree for
  * address decoding. The value stored is a template type and can be
  * e.g. a port identifier, or a pointer.
+ *
+ * Maps that are built once and then only read, e.g. routing tables,
+ * can be frozen. A frozen map additionally holds the start addresses
+ * of its entries in a sorted array, and looks up the entry containing
+ * an address or range with a binary search over that array instead of
+ * walking the tree. Any modification of the map unfreezes it.
  */
 template <typename V, int max_cache_size=0>
 class AddrRangeMap
@@ -89,11 +96,13 @@ class AddrRangeMap
     const_iterator
     contains(const AddrRange &r) const
     {
-        return find(r, [r](const AddrRange r1) { return r.isSubset(r1); });
+        return const_cast<AddrRangeMap *>(this)->contains(r);
     }
     iterator
     contains(const AddrRange &r)
     {
+        if (frozen)
+            return findFrozen(r);
         return find(r, [r](const AddrRange r1) { return r.isSubset(r1); });
     }
     /** @} */ // end of api_addr_range
@@ -157,6 +166,7 @@ class AddrRangeMap
         if (intersects(r) != end())
             return tree.end();
 
+        unfreeze();
         return tree.insert(std::make_pair(r, d)).first;
     }
 
@@ -166,6 +176,7 @@ class AddrRangeMap
     void
     erase(iterator p)
     {
+        unfreeze();
         cache.remove(p);
         tree.erase(p);
     }
@@ -176,6 +187,7 @@ class AddrRangeMap
     void
     erase(iterator p, iterator q)
     {
+        unfreeze();
         for (auto it = p; it != q; it++) {
             cache.remove(p);
         }
@@ -188,10 +200,43 @@ class AddrRangeMap
     void
     clear()
     {
+        unfreeze();
         cache.erase(cache.begin(), cache.end());
         tree.erase(tree.begin(), tree.end());
     }
 
+    /**
+     * Compile the current entries into a sorted array used by all
+     * subsequent contains() lookups until the map is next modified.
+     * Interleaved ranges that merge with each other share a single
+     * array slot and are told apart by their interleaving bits.
+     *
+     * @ingroup api_addr_range
+     */
+    void
+    freeze()
+    {
+        unfreeze();
+
+        for (auto it = tree.begin(); it != tree.end(); ++it) {
+            if (!flatEntries.empty() &&
+                flatEntries.back()->first.mergesWith(it->first)) {
+                flatGroups.back().count++;
+            } else {
+                flatStarts.push_back(it->first.start());
+                flatGroups.push_back({flatEntries.size(), 1});
+            }
+            flatEntries.push_back(it);
+        }
+
+        frozen = true;
+    }
+
+    /**
+     * @ingroup api_addr_range
+     */
+    bool isFrozen() const { return frozen; }
+
     /**
      * @ingroup api_addr_range
      */
@@ -326,8 +371,69 @@ class AddrRangeMap
         return const_cast<AddrRangeMap *>(this)->find(r, cond);
     }
 
+    /**
+     * Find the entry that contains the input address range in the
+     * frozen array. As the entries never overlap, the only candidates
+     * are the ones of the last slot starting at or before the range.
+     */
+    iterator
+    findFrozen(const AddrRange &r)
+    {
+        const Addr addr = r.start();
+        const Addr *base = flatStarts.data();
+        std::size_t n = flatStarts.size();
+
+        if (n == 0 || addr < base[0])
+            return end();
+
+        // Branchless binary search for the last start <= addr, the
+        // comparison compiles to a conditional move
+        while (n > 1) {
+            const std::size_t half = n / 2;
+            base = base[half] <= addr ? base + half : base;
+            n -= half;
+        }
+
+        const FlatGroup &group = flatGroups[base - flatStarts.data()];
+        for (std::size_t i = 0; i < group.count; i++) {
+            iterator it = flatEntries[group.first + i];
+            if (r.isSubset(it->first))
+                return it;
+        }
+
+        return end();
+    }
+
+    void
+    unfreeze()
+    {
+        frozen = false;
+        flatStarts.clear();
+        flatGroups.clear();
+        flatEntries.clear();
+    }
+
     RangeMap tree;
 
+    /** A slot of the frozen array, i.e. a run of merging entries */
+    struct FlatGroup
+    {
+        std::size_t first;
+        std::size_t count;
+    };
+
+    /** Is the frozen array up to date and used for lookups? */
+    bool frozen = false;
+
+    /** Start address of each slot, in ascending order */
+    std::vector<Addr> flatStarts;
+
+    /** The entries of each slot */
+    std::vector<FlatGroup> flatGroups;
+
+    /** Tree entries in address order, indexed by the slots */
+    std::vector<iterator> flatEntries;
+
     /**
      * A list of iterator that correspond to the max_cache_size most
      * recently used entries in the address range map. This mainly
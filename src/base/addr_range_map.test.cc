@@ -156,3 +156,62 @@ TEST(AddrRangeMapTest, InterleavedTest2)
     // intlvMatch = 2 for start = 0x80000000
     EXPECT_EQ(i->second, 2);
 }
+
+/**
+ * A frozen AddrRangeMap must find the same entries as the tree, for
+ * plain and interleaved ranges alike, and lookups must fall back to
+ * the tree once the map is modified.
+ */
+TEST(AddrRangeMapTest, FrozenTest)
+{
+    const auto masks = std::vector<Addr>{0x40, 0x80};
+    const Addr intlv_start = 0x80000000;
+    const Addr intlv_end   = 0xc0000000;
+
+    AddrRangeMap<int, 3> tree;
+    AddrRangeMap<int, 3> flat;
+
+    for (auto *r : {&tree, &flat}) {
+        r->insert(RangeIn(0x0, 0xfff), 100);
+        r->insert(RangeIn(0x2000, 0x2fff), 101);
+        r->insert(RangeIn(0x3000, 0x3fff), 102);
+        for (int k = 0; k < 4; k++)
+            r->insert(AddrRange(intlv_start, intlv_end, masks, k), k);
+    }
+
+    flat.freeze();
+    EXPECT_TRUE(flat.isFrozen());
+    EXPECT_FALSE(tree.isFrozen());
+
+    for (Addr a : {Addr(0x0), Addr(0xfff), Addr(0x1000), Addr(0x2000),
+                   Addr(0x2fff), Addr(0x3000), Addr(0x4000),
+                   intlv_start - 1, intlv_start, intlv_start + 0x40,
+                   intlv_start + 0x80, intlv_start + 0xc0,
+                   intlv_end - 1, intlv_end}) {
+        auto t = tree.contains(a);
+        auto f = flat.contains(a);
+        ASSERT_EQ(t == tree.end(), f == flat.end()) << a;
+        if (t != tree.end()) {
+            EXPECT_EQ(t->second, f->second) << a;
+        }
+    }
+
+    // Ranges spanning entries are not contained in any of them
+    EXPECT_EQ(flat.contains(RangeIn(0x2f00, 0x30ff)), flat.end());
+    EXPECT_EQ(flat.contains(RangeIn(0x2f00, 0x2fff))->second, 101);
+
+    auto i = flat.insert(RangeIn(0x1000, 0x1fff), 103);
+    ASSERT_NE(i, flat.end());
+    EXPECT_FALSE(flat.isFrozen());
+    EXPECT_EQ(flat.contains(0x1800)->second, 103);
+
+    flat.freeze();
+    EXPECT_EQ(flat.contains(0x1800)->second, 103);
+    flat.erase(flat.contains(0x1800));
+    EXPECT_FALSE(flat.isFrozen());
+    EXPECT_EQ(flat.contains(0x1800), flat.end());
+
+    flat.clear();
+    flat.freeze();
+    EXPECT_EQ(flat.contains(0x0), flat.end());
+}
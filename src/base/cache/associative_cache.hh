@@ -198,16 +198,11 @@ class AssociativeCache : public Named
     {
         auto tag = getTag(addr);
 
-        auto candidates = indexingPolicy->getPossibleEntries(addr);
-
-        for (auto candidate : candidates) {
-            Entry *entry = static_cast<Entry*>(candidate);
-            if (entry->matchTag(tag)) {
-                return entry;
-            }
-        }
-
-        return nullptr;
+        return static_cast<Entry*>(indexingPolicy->findPossibleEntry(addr,
+            [tag](ReplaceableEntry *candidate)
+            {
+                return static_cast<Entry*>(candidate)->matchTag(tag);
+            }));
     }
 
     /**
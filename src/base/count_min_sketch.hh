@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_COUNT_MIN_SKETCH_HH__
+#define __BASE_COUNT_MIN_SKETCH_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+/**
+ * A count-min sketch: a fixed size table of counters which estimates
+ * how many times each key was added, without storing the keys. Each key
+ * hashes to one counter in each of the rows. An estimate is the
+ * smallest of those counters, so it is never lower than the real count,
+ * and it is only higher when other keys collide in every row.
+ *
+ * Counters are updated conservatively (only the smallest ones of a key
+ * are incremented), which keeps the overestimation low. They saturate
+ * instead of wrapping, and can be aged by halving all of them.
+ */
+class CountMinSketch
+{
+  public:
+    using Count = uint32_t;
+
+    /**
+     * @param width Number of counters per row, a power of 2.
+     * @param depth Number of rows.
+     */
+    CountMinSketch(unsigned width, unsigned _depth=4)
+        : widthBits(floorLog2(width)), depth(_depth),
+          counters(width * _depth, 0)
+    {
+        fatal_if(!isPowerOf2(width) || width < 2,
+                 "Count-min sketch width must be a power of 2.");
+        fatal_if(depth == 0, "Count-min sketch needs at least one row.");
+    }
+
+    /** Add to the count of a key and return its new estimate. */
+    Count
+    add(uint64_t key, Count count=1)
+    {
+        const Count est = estimate(key);
+        const Count sum = est > MaxCount - count ? MaxCount : est + count;
+
+        for (unsigned row = 0; row < depth; ++row) {
+            Count &counter = counters[index(key, row)];
+            counter = std::max(counter, sum);
+        }
+        return sum;
+    }
+
+    /** The estimated count of a key. */
+    Count
+    estimate(uint64_t key) const
+    {
+        Count est = MaxCount;
+        for (unsigned row = 0; row < depth; ++row)
+            est = std::min(est, counters[index(key, row)]);
+        return est;
+    }
+
+    /** Halve all the counts, so that old events weigh less. */
+    void
+    age()
+    {
+        for (auto &counter : counters)
+            counter >>= 1;
+    }
+
+    void clear() { std::fill(counters.begin(), counters.end(), 0); }
+
+  private:
+    static constexpr Count MaxCount = std::numeric_limits<Count>::max();
+
+    const unsigned widthBits;
+    const unsigned depth;
+
+    /** The rows of counters, one after the other. */
+    std::vector<Count> counters;
+
+    size_t
+    index(uint64_t key, unsigned row) const
+    {
+        // A different odd multiplier per row gives independent hashes.
+        uint64_t h = (key + row) * 0x9e3779b97f4a7c15ULL;
+        h ^= h >> 31;
+        h *= 0xbf58476d1ce4e5b9ULL + 2 * row;
+        return (size_t(row) << widthBits) + (h >> (64 - widthBits));
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_COUNT_MIN_SKETCH_HH__
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+
+#include "base/count_min_sketch.hh"
+
+using namespace gem5;
+
+TEST(CountMinSketchTest, Empty)
+{
+    CountMinSketch sketch(64);
+    EXPECT_EQ(sketch.estimate(0), 0);
+    EXPECT_EQ(sketch.estimate(0x1234), 0);
+}
+
+TEST(CountMinSketchTest, SingleKey)
+{
+    CountMinSketch sketch(64);
+    for (int i = 1; i <= 10; ++i)
+        EXPECT_EQ(sketch.add(42), i);
+    EXPECT_EQ(sketch.estimate(42), 10);
+    EXPECT_EQ(sketch.add(42, 5), 15);
+}
+
+TEST(CountMinSketchTest, AgeAndClear)
+{
+    CountMinSketch sketch(64);
+    sketch.add(7, 9);
+    sketch.age();
+    EXPECT_EQ(sketch.estimate(7), 4);
+    sketch.clear();
+    EXPECT_EQ(sketch.estimate(7), 0);
+}
+
+TEST(CountMinSketchTest, Saturates)
+{
+    CountMinSketch sketch(64);
+    const auto max = std::numeric_limits<CountMinSketch::Count>::max();
+    sketch.add(1, max - 1);
+    EXPECT_EQ(sketch.add(1, 10), max);
+    EXPECT_EQ(sketch.estimate(1), max);
+}
+
+// Estimates never go below the real counts, and with many more
+// counters than keys most of them are exact.
+TEST(CountMinSketchTest, NeverUnderestimates)
+{
+    CountMinSketch sketch(1024);
+    std::unordered_map<uint64_t, CountMinSketch::Count> counts;
+    std::mt19937_64 rng(1);
+
+    for (int i = 0; i < 20000; ++i) {
+        uint64_t key = (rng() % 200) << 12;
+        sketch.add(key);
+        counts[key]++;
+    }
+
+    int exact = 0;
+    for (const auto &[key, count] : counts) {
+        EXPECT_GE(sketch.estimate(key), count);
+        exact += sketch.estimate(key) == count;
+    }
+    EXPECT_GT(exact, counts.size() * 9 / 10);
+}
+
+TEST(CountMinSketchTest, BadWidth)
+{
+    EXPECT_ANY_THROW(CountMinSketch sketch(100));
+}
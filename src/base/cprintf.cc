@@ -58,13 +58,68 @@ Print::Print(std::ostream &stream, const char *format)
     savedWidth = stream.width();
 }
 
+Print::Print(std::ostream &stream, const FormatString &format)
+    : Print(stream, format.source)
+{
+    prepared = &format;
+}
+
 Print::~Print()
 {
 }
 
+FormatString::FormatString(const char *format) : source(format)
+{
+    // Run the regular parser over the whole string once, collecting what
+    // it prints between the conversions.
+    std::ostringstream text;
+    Print print(text, format);
+    while (print.process()) {
+        std::string str = text.str();
+        bool flush = str.find('\n') != std::string::npos;
+        conversions.push_back({std::move(str), flush, print.fmt, print.ptr});
+        text.str("");
+    }
+    tail = text.str();
+    flushTail = tail.find('\n') != std::string::npos;
+}
+
 void
+Print::processPrepared()
+{
+    fmt.clear();
+
+    if (nextConversion == prepared->conversions.size()) {
+        // More arguments than conversions. Print the rest of the string
+        // and let the regular parser, which has nothing left to parse,
+        // take over.
+        stream.write(prepared->tail.data(), prepared->tail.size());
+        if (prepared->flushTail)
+            stream.flush();
+        ptr += strlen(ptr);
+        prepared = nullptr;
+        return;
+    }
+
+    const FormatString::Conversion &conv =
+        prepared->conversions[nextConversion++];
+    stream.write(conv.text.data(), conv.text.size());
+    if (conv.flush)
+        stream.flush();
+    stream.fill(' ');
+    stream.flags((std::ios::fmtflags)0);
+    fmt = conv.fmt;
+    ptr = conv.next;
+}
+
+bool
 Print::process()
 {
+    if (prepared) {
+        processPrepared();
+        return true;
+    }
+
     fmt.clear();
 
     size_t len;
@@ -74,7 +129,7 @@ Print::process()
           case '%':
             if (ptr[1] != '%') {
                 processFlag();
-                return;
+                return true;
             }
             stream.put('%');
             ptr += 2;
@@ -97,6 +152,8 @@ Print::process()
             break;
         }
     }
+
+    return false;
 }
 
 void
@@ -279,6 +336,13 @@ Print::processFlag()
 void
 Print::endArgs()
 {
+    if (prepared && nextConversion == prepared->conversions.size()) {
+        stream.write(prepared->tail.data(), prepared->tail.size());
+        if (prepared->flushTail)
+            stream.flush();
+        ptr += strlen(ptr);
+    }
+
     size_t len;
 
     while (*ptr) {
@@ -34,6 +34,8 @@
 #include <iostream>
 #include <list>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "base/cprintf_formats.hh"
 
@@ -42,6 +44,66 @@ namespace gem5
 
 namespace cp {
 
+/**
+ * A format string which has been split up ahead of time into the
+ * conversion specifications and the text around them, so that formatting
+ * with it doesn't parse the string over and over again.
+ */
+class FormatString
+{
+  public:
+    struct Conversion
+    {
+        /** Text printed before the conversion, with newlines translated */
+        std::string text;
+        /** Whether the text ends lines, which flushes the stream */
+        bool flush;
+        Format fmt;
+        /** Where parsing would resume after the conversion */
+        const char *next;
+    };
+
+    /** The original string */
+    const char *source;
+    std::vector<Conversion> conversions;
+    /** Text printed after the last conversion */
+    std::string tail;
+    bool flushTail;
+
+    /**
+     * Split up a format string. The string must outlive the result.
+     */
+    FormatString(const char *format);
+
+    /**
+     * Prepare a format once, for a call site which is going to use it
+     * for good, if it can be prepared.
+     *
+     * Only arrays of const char, which in practice are string literals,
+     * are prepared. Any other format (e.g. a pointer or a std::string)
+     * could be different on the next call, so nullptr is returned and the
+     * format shouldn't even be evaluated.
+     *
+     * The result is never freed, so that it can be used even from static
+     * destructors.
+     *
+     * @tparam T The type of the format expression, as from decltype(()).
+     * @param get Function returning the format.
+     */
+    template <typename T, typename Get>
+    static const FormatString *
+    prepare(Get get)
+    {
+        using Type = std::remove_reference_t<T>;
+        if constexpr (std::is_array_v<Type> &&
+                std::is_const_v<std::remove_extent_t<Type>>) {
+            return new FormatString(get());
+        } else {
+            return nullptr;
+        }
+    }
+};
+
 struct Print
 {
   protected:
@@ -50,18 +112,27 @@ struct Print
     const char *ptr;
     bool cont;
 
+    /** The prepared format, if any, and the next conversion to print */
+    const FormatString *prepared = nullptr;
+    size_t nextConversion = 0;
+
     std::ios::fmtflags savedFlags;
     char savedFill;
     int savedPrecision;
     int savedWidth;
 
     Format fmt;
-    void process();
+    /** Print up to the next conversion, and return whether there is one */
+    bool process();
+    void processPrepared();
     void processFlag();
 
+    friend class FormatString;
+
   public:
     Print(std::ostream &stream, const std::string &format);
     Print(std::ostream &stream, const char *format);
+    Print(std::ostream &stream, const FormatString &format);
     ~Print();
 
     int
@@ -151,6 +222,16 @@ ccprintf(std::ostream &stream, const char *format, const Args &...args)
 }
 
 
+template<typename ...Args> void
+ccprintf(std::ostream &stream, const cp::FormatString &format,
+         const Args &...args)
+{
+    cp::Print print(stream, format);
+
+    ccprintf(print, args...);
+}
+
+
 template<typename ...Args> void
 cprintf(const char *format, const Args &...args)
 {
@@ -165,6 +246,14 @@ csprintf(const char *format, const Args &...args)
     return stream.str();
 }
 
+template<typename ...Args> std::string
+csprintf(const cp::FormatString &format, const Args &...args)
+{
+    std::stringstream stream;
+    ccprintf(stream, format, args...);
+    return stream.str();
+}
+
 /*
  * functions again with std::string.  We have both so we don't waste
  * time converting const char * to std::string since we don't take
@@ -188,6 +277,20 @@ csprintf(const std::string &format, const Args &...args)
     return csprintf(format.c_str(), args...);
 }
 
+/**
+ * Declare var as a static pointer to the prepared version of the format
+ * which starts the arguments, as returned by cp::FormatString::prepare().
+ * This takes care of only evaluating the format when it is prepared.
+ *
+ * @ingroup api_trace
+ */
+#define GEM5_PREPARED_FORMAT(var, ...)                              \
+    static const ::gem5::cp::FormatString *const var =              \
+        ::gem5::cp::FormatString::prepare<                          \
+            decltype((GEM5_FIRST_ARG_(__VA_ARGS__, 0)))>(           \
+                [&]() { return GEM5_FIRST_ARG_(__VA_ARGS__, 0); })
+#define GEM5_FIRST_ARG_(first, ...) first
+
 } // namespace gem5
 
 #endif // __CPRINTF_HH__
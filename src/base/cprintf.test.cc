@@ -180,3 +180,59 @@ TEST(CPrintf, SpecialFormatting)
     CPRINTF_TEST("%07.*f\n", 4, 1.234);
     CPRINTF_TEST("%#0*x\n", 9, 123412);
 }
+
+/** Check that a prepared format prints the same as the original string. */
+template <typename ...Args>
+void
+preparedTest(const char *format, const Args &...args)
+{
+    cp::FormatString prepared(format);
+    EXPECT_EQ(csprintf(prepared, args...), csprintf(format, args...));
+}
+
+TEST(CPrintf, PreparedFormat)
+{
+    preparedTest("another test\n");
+    preparedTest("%s\n", "foo");
+    preparedTest("%shits%%s + %smisses%%s\n", "test", "test");
+    preparedTest("%%s%-10s %c he went home \'\"%d %#o %#llx %1.5f %1.2E\n",
+                  "sample", 'A', 10, 0xbead, 0xbeadfeedULL, 1.2, 1.3e-23);
+    preparedTest("%0*.*f and %#0*x\r\n", 8, 4, 99.99, 9, 123412);
+    preparedTest("%08.4f %3.2d\r", 99.99, 7);
+    preparedTest("");
+
+    // More conversions than arguments
+    preparedTest("%d %s %x\n", 1);
+    // More arguments than conversions
+    preparedTest("%d\n", 1, 2, "three");
+    // No conversion at all
+    preparedTest("none\n", 1);
+}
+
+TEST(CPrintf, PreparedFormatReuse)
+{
+    cp::FormatString prepared("%d: %s%c");
+    EXPECT_EQ(csprintf(prepared, 1, "first", '!'), "1: first!");
+    EXPECT_EQ(csprintf(prepared, 22, "second", '?'), "22: second?");
+}
+
+TEST(CPrintf, Prepare)
+{
+    const char *ptr = "%d";
+    char buf[] = "%d";
+    std::string str = "%d";
+
+    // Only arrays of const char are prepared.
+    const cp::FormatString *literal =
+        cp::FormatString::prepare<decltype(("%d"))>([] { return "%d"; });
+    ASSERT_NE(literal, nullptr);
+    EXPECT_EQ(csprintf(*literal, 42), "42");
+    delete literal;
+
+    EXPECT_EQ(cp::FormatString::prepare<decltype((ptr))>(
+                [&] { return ptr; }), nullptr);
+    EXPECT_EQ(cp::FormatString::prepare<decltype((buf))>(
+                [&] { return buf; }), nullptr);
+    EXPECT_EQ(cp::FormatString::prepare<decltype((str))>(
+                [&] { return str; }), nullptr);
+}
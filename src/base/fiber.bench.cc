@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Creating, destroying and switching between fibers, which the systemc
+ * kernel and the m5 fiber based threads do for every process switch.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "base/fiber.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+class PingFiber : public Fiber
+{
+  public:
+    bool stop = false;
+
+    void
+    main() override
+    {
+        while (!stop)
+            primaryFiber()->run();
+    }
+};
+
+class EmptyFiber : public Fiber
+{
+  public:
+    void main() override {}
+};
+
+/** Every iteration switches to the fiber and back again. */
+void
+BM_FiberSwitch(benchmark::State &state)
+{
+    PingFiber fiber;
+    for (auto _ : state)
+        fiber.run();
+    state.SetItemsProcessed(2 * state.iterations());
+
+    fiber.stop = true;
+    fiber.run();
+}
+BENCHMARK(BM_FiberSwitch);
+
+void
+BM_FiberCreateRunDestroy(benchmark::State &state)
+{
+    for (auto _ : state) {
+        EmptyFiber fiber;
+        fiber.run();
+        benchmark::DoNotOptimize(fiber.finished());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FiberCreateRunDestroy);
+
+} // anonymous namespace
@@ -45,6 +45,8 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <unordered_map>
+#include <vector>
 
 #include "base/logging.hh"
 
@@ -74,8 +76,121 @@ Fiber *_currentFiber = &_primaryFiber;
 // A pointer to the Fiber which is currently being started/initialized.
 Fiber *startingFiber = nullptr;
 
+/*
+ * Stacks (with their guard page) of fibers which have been destroyed, by
+ * stack size. Fibers come and go often, and reusing a stack saves an mmap,
+ * an mprotect and a munmap each time. The pool is never destroyed since
+ * static Fibers may be torn down after it otherwise would be.
+ */
+std::unordered_map<size_t, std::vector<void *>> &
+stackPool()
+{
+    static auto *pool = new std::unordered_map<size_t, std::vector<void *>>;
+    return *pool;
+}
+
+// The most stacks of a given size the pool will hold on to.
+const size_t MaxPooledStacks = 64;
+
+#if GEM5_FIBER_FAST_SWITCH
+
+#if defined(__x86_64__)
+
+// gem5FiberSwitch pushes rbp, rbx and r12-r15 below its return address.
+const size_t SwitchFrameWords = 6;
+
+#elif defined(__aarch64__)
+
+// gem5FiberSwitch saves x19-x30 and d8-d15. The saved x30 is where it
+// returns to.
+const size_t SwitchFrameWords = 20;
+const size_t SwitchReturnWord = 11;
+
+#endif
+
+#endif // GEM5_FIBER_FAST_SWITCH
+
 } // anonymous namespace
 
+#if GEM5_FIBER_FAST_SWITCH
+
+/*
+ * Save the callee saved registers on the current stack, store the stack
+ * pointer in *save_sp, switch to load_sp and restore the registers saved
+ * there. Like _setjmp, this leaves the floating point control state alone,
+ * so it stays shared by all the fibers.
+ */
+extern "C" void gem5FiberSwitch(void **save_sp, void *load_sp);
+
+#if defined(__x86_64__)
+
+asm(R"(
+    .text
+    .p2align 4
+    .globl gem5FiberSwitch
+    .hidden gem5FiberSwitch
+    .type gem5FiberSwitch, @function
+gem5FiberSwitch:
+    pushq %rbp
+    pushq %rbx
+    pushq %r12
+    pushq %r13
+    pushq %r14
+    pushq %r15
+    movq %rsp, (%rdi)
+    movq %rsi, %rsp
+    popq %r15
+    popq %r14
+    popq %r13
+    popq %r12
+    popq %rbx
+    popq %rbp
+    ret
+    .size gem5FiberSwitch, .-gem5FiberSwitch
+)");
+
+#elif defined(__aarch64__)
+
+asm(R"(
+    .text
+    .p2align 4
+    .globl gem5FiberSwitch
+    .hidden gem5FiberSwitch
+    .type gem5FiberSwitch, %function
+gem5FiberSwitch:
+    sub sp, sp, #160
+    stp x19, x20, [sp, #0]
+    stp x21, x22, [sp, #16]
+    stp x23, x24, [sp, #32]
+    stp x25, x26, [sp, #48]
+    stp x27, x28, [sp, #64]
+    stp x29, x30, [sp, #80]
+    stp d8, d9, [sp, #96]
+    stp d10, d11, [sp, #112]
+    stp d12, d13, [sp, #128]
+    stp d14, d15, [sp, #144]
+    mov x9, sp
+    str x9, [x0]
+    mov sp, x1
+    ldp x19, x20, [sp, #0]
+    ldp x21, x22, [sp, #16]
+    ldp x23, x24, [sp, #32]
+    ldp x25, x26, [sp, #48]
+    ldp x27, x28, [sp, #64]
+    ldp x29, x30, [sp, #80]
+    ldp d8, d9, [sp, #96]
+    ldp d10, d11, [sp, #112]
+    ldp d12, d13, [sp, #128]
+    ldp d14, d15, [sp, #144]
+    add sp, sp, #160
+    ret
+    .size gem5FiberSwitch, .-gem5FiberSwitch
+)");
+
+#endif
+
+#endif // GEM5_FIBER_FAST_SWITCH
+
 void
 Fiber::entryTrampoline()
 {
@@ -90,18 +205,24 @@ Fiber::Fiber(Fiber *link, size_t stack_size) :
     guardPageSize(sysconf(_SC_PAGE_SIZE)), _started(false), _finished(false)
 {
     if (stack_size) {
-        guardPage = mmap(nullptr, guardPageSize + stack_size,
-                         PROT_READ | PROT_WRITE,
-                         MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
-        if (guardPage == (void *)MAP_FAILED) {
-            perror("mmap");
-            fatal("Could not mmap %d byte fiber stack.\n", stack_size);
+        auto &pooled = stackPool()[stack_size];
+        if (!pooled.empty()) {
+            guardPage = pooled.back();
+            pooled.pop_back();
+        } else {
+            guardPage = mmap(nullptr, guardPageSize + stack_size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+            if (guardPage == (void *)MAP_FAILED) {
+                perror("mmap");
+                fatal("Could not mmap %d byte fiber stack.\n", stack_size);
+            }
+            if (mprotect(guardPage, guardPageSize, PROT_NONE)) {
+                perror("mprotect");
+                fatal("Could not forbid access to fiber stack guard page.");
+            }
         }
         stack = (void *)((uint8_t *)guardPage + guardPageSize);
-        if (mprotect(guardPage, guardPageSize, PROT_NONE)) {
-            perror("mprotect");
-            fatal("Could not forbid access to fiber stack guard page.");
-        }
     }
 #if HAVE_VALGRIND
     valgrindStackId = VALGRIND_STACK_REGISTER(
@@ -115,10 +236,65 @@ Fiber::~Fiber()
 #if HAVE_VALGRIND
     VALGRIND_STACK_DEREGISTER(valgrindStackId);
 #endif
-    if (guardPage)
-        munmap(guardPage, guardPageSize + stackSize);
+    if (guardPage) {
+        auto &pooled = stackPool()[stackSize];
+        if (pooled.size() < MaxPooledStacks)
+            pooled.push_back(guardPage);
+        else
+            munmap(guardPage, guardPageSize + stackSize);
+    }
 }
 
+#if GEM5_FIBER_FAST_SWITCH
+
+void
+Fiber::createContext()
+{
+    // Build a frame at the top of the stack which looks like the new fiber
+    // called gem5FiberSwitch just before entering the trampoline, so that
+    // the first switch to it "returns" there. The trampoline never returns
+    // itself, so there is no real frame above it.
+    uintptr_t top = ((uintptr_t)stack + stackSize) & ~(uintptr_t)0xf;
+    uintptr_t *frame;
+#if defined(__x86_64__)
+    // Functions are entered with the stack 8 bytes off 16 byte alignment,
+    // right above the return address. Make that return address a zero.
+    uintptr_t *entry_sp = (uintptr_t *)top - 1;
+    *entry_sp = 0;
+    frame = entry_sp - 1 - SwitchFrameWords;
+    for (size_t i = 0; i < SwitchFrameWords; i++)
+        frame[i] = 0;
+    frame[SwitchFrameWords] = (uintptr_t)&entryTrampoline;
+#else
+    frame = (uintptr_t *)top - SwitchFrameWords;
+    for (size_t i = 0; i < SwitchFrameWords; i++)
+        frame[i] = 0;
+    frame[SwitchReturnWord] = (uintptr_t)&entryTrampoline;
+#endif
+    sp = frame;
+
+    // The trampoline picks the new fiber up from here when it first runs.
+    startingFiber = this;
+}
+
+void
+Fiber::start()
+{
+    // Avoid a dangling pointer.
+    startingFiber = nullptr;
+
+    setStarted();
+
+    main();
+
+    // main has returned, so this Fiber has finished. Switch to the "link"
+    // Fiber.
+    _finished = true;
+    link->run();
+}
+
+#else
+
 void
 Fiber::createContext()
 {
@@ -162,6 +338,8 @@ Fiber::start()
     link->run();
 }
 
+#endif // GEM5_FIBER_FAST_SWITCH
+
 void
 Fiber::run()
 {
@@ -178,8 +356,12 @@ Fiber::run()
     Fiber *prev = _currentFiber;
     Fiber *next = this;
     _currentFiber = next;
+#if GEM5_FIBER_FAST_SWITCH
+    gem5FiberSwitch(&prev->sp, next->sp);
+#else
     if (_setjmp(prev->jmp) == 0)
         _longjmp(next->jmp, 1);
+#endif
 }
 
 Fiber *Fiber::currentFiber() { return _currentFiber; }
@@ -50,6 +50,28 @@
 
 #include "config/have_valgrind.hh"
 
+/*
+ * On x86-64 and aarch64 ELF hosts, fibers switch with a small assembly
+ * routine which only saves the callee saved registers, rather than going
+ * through setjmp/longjmp. Address sanitizer needs to see stack switches, so
+ * it keeps using the portable version.
+ */
+#if defined(__has_feature)
+#  if __has_feature(address_sanitizer)
+#    define GEM5_FIBER_ASAN 1
+#  endif
+#endif
+#if defined(__SANITIZE_ADDRESS__)
+#  define GEM5_FIBER_ASAN 1
+#endif
+
+#if defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__)) && \
+    !defined(GEM5_FIBER_ASAN)
+#  define GEM5_FIBER_FAST_SWITCH 1
+#else
+#  define GEM5_FIBER_FAST_SWITCH 0
+#endif
+
 namespace gem5
 {
 
@@ -145,10 +167,15 @@ class Fiber
     static void entryTrampoline();
     void start();
 
+#if GEM5_FIBER_FAST_SWITCH
+    // Saved stack pointer of this fiber while it isn't running.
+    void *sp;
+#else
     ucontext_t ctx;
     // ucontext is slow in swapcontext. Here we use _setjmp/_longjmp to avoid
     // the additional signals for speed up.
     jmp_buf jmp;
+#endif
 
     Fiber *link;
 
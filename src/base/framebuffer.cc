@@ -39,6 +39,8 @@
 
 #include <zlib.h>
 
+#include <algorithm>
+
 #include "base/bitfield.hh"
 
 namespace gem5
@@ -46,6 +48,25 @@ namespace gem5
 
 const FrameBuffer FrameBuffer::dummy(320, 240);
 
+void
+FrameBuffer::Rect::merge(const Rect &other)
+{
+    if (other.empty())
+        return;
+
+    if (empty()) {
+        *this = other;
+        return;
+    }
+
+    const unsigned x_end = std::max(x + width, other.x + other.width);
+    const unsigned y_end = std::max(y + height, other.y + other.height);
+    x = std::min(x, other.x);
+    y = std::min(y, other.y);
+    width = x_end - x;
+    height = y_end - y;
+}
+
 FrameBuffer::FrameBuffer(unsigned width, unsigned height)
     : pixels(width * height),
       _width(width), _height(height)
@@ -77,6 +98,7 @@ FrameBuffer::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(_width);
     UNSERIALIZE_SCALAR(_height);
     UNSERIALIZE_CONTAINER(pixels);
+    markDirty();
 }
 
 void
@@ -86,6 +108,7 @@ FrameBuffer::resize(unsigned width, unsigned height)
     _height = height;
 
     pixels.resize(width * height);
+    markDirty();
 }
 
 void
@@ -93,6 +116,7 @@ FrameBuffer::fill(const Pixel &pixel)
 {
     for (auto &p : pixels)
         p = pixel;
+    markDirty();
 }
 
 void
@@ -106,19 +130,43 @@ FrameBuffer::clear()
 void
 FrameBuffer::copyIn(const uint8_t *fb, const PixelConverter &conv)
 {
-    for (auto &p : pixels) {
-        p = conv.toPixel(fb);
-        fb += conv.length;
+    // Convert a line at a time to only mark the pixels that changed
+    std::vector<Pixel> line(_width);
+    for (unsigned y = 0; y < _height; ++y) {
+        conv.toPixels(fb, line.data(), _width);
+        setPixels(0, y, line.data(), _width);
+        fb += _width * conv.length;
     }
 }
 
 void
 FrameBuffer::copyOut(uint8_t *fb, const PixelConverter &conv) const
 {
-    for (auto &p : pixels) {
-        conv.fromPixel(fb, p);
-        fb += conv.length;
-    }
+    conv.fromPixels(pixels.data(), fb, pixels.size());
+}
+
+void
+FrameBuffer::setPixels(unsigned x, unsigned y, const Pixel *src,
+                       unsigned count)
+{
+    assert(x + count <= _width);
+    assert(y < _height);
+
+    Pixel *dst = pixels.data() + y * _width + x;
+
+    // Find the first and last pixels that changed
+    unsigned first = 0;
+    while (first < count && dst[first] == src[first])
+        ++first;
+    if (first == count)
+        return;
+
+    unsigned last = count - 1;
+    while (dst[last] == src[last])
+        --last;
+
+    std::copy(src + first, src + last + 1, dst + first);
+    markDirty(Rect{x + first, y, last - first + 1, 1});
 }
 
 uint64_t
@@ -64,10 +64,31 @@ namespace gem5
  * image. That is, the pixel at position (0, 0) is the upper left
  * corner. The backing store is a linear vector of Pixels ordered left
  * to right starting in the upper left corner.
+ *
+ * The frame buffer keeps track of the area that changed since the
+ * last call to clearDirty(), which lets consumers (e.g., a VNC
+ * server) only process the pixels that changed. Updates through
+ * copyIn(), setPixels(), fill() and resize() are tracked
+ * automatically. Writers that modify pixels directly must call
+ * markDirty().
  */
 class FrameBuffer : public Serializable
 {
   public:
+    /** Rectangular area of the frame buffer */
+    struct Rect
+    {
+        unsigned x = 0;
+        unsigned y = 0;
+        unsigned width = 0;
+        unsigned height = 0;
+
+        bool empty() const { return width == 0 || height == 0; }
+
+        /** Grow this rectangle to also cover another one */
+        void merge(const Rect &other);
+    };
+
     /**
      * Create a frame buffer of a given size.
      *
@@ -151,6 +172,26 @@ class FrameBuffer : public Serializable
         copyOut(fb.data(), conv);
     }
 
+    /**
+     * Update a horizontal run of pixels and mark the pixels that
+     * actually changed as dirty.
+     *
+     * @param x Distance of the first pixel from the left margin.
+     * @param y Distance from the top of the frame.
+     * @param src New pixel values.
+     * @param count Number of pixels.
+     */
+    void setPixels(unsigned x, unsigned y, const Pixel *src, unsigned count);
+
+    /** Area that changed since the last call to clearDirty() */
+    const Rect &dirty() const { return _dirty; }
+    /** Mark an area as changed */
+    void markDirty(const Rect &rect) { _dirty.merge(rect); }
+    /** Mark the whole frame as changed */
+    void markDirty() { _dirty = Rect{0, 0, _width, _height}; }
+    /** Start tracking changes from a clean state */
+    void clearDirty() { _dirty = Rect(); }
+
     /**
      * Get a pixel from an (x, y) coordinate
      *
@@ -199,6 +240,9 @@ class FrameBuffer : public Serializable
     unsigned _width;
     /** Height in pixels */
     unsigned _height;
+
+    /** Area changed since the last call to clearDirty() */
+    Rect _dirty;
 };
 
 } // namespace gem5
@@ -68,6 +68,13 @@ class GTestExitLogger : public Logger
 
 } // anonymous namespace
 
+// Panics and fatals are turned into exceptions caught by the test
+// framework, so there is no point in running the exit hooks.
+void
+Logger::addExitHook(std::function<void()> hook)
+{
+}
+
 // We intentionally put all the loggers on the heap to prevent them from being
 // destructed at the end of the program. This make them safe to be used inside
 // destructor of other global objects. Also, we make them function static
@@ -245,6 +245,55 @@ mulSigned(std::make_signed_t<T> val_a, std::make_signed_t<T> val_b)
     return {hi, low};
 };
 
+/**
+ * Compute the reciprocal of a divisor, to be passed to divFloorReciprocal
+ * and divCeilReciprocal.
+ *
+ * @param b The divisor, must not be zero.
+ * @return floor((2^64 - 1) / b).
+ *
+ * @ingroup api_base_utils
+ */
+static constexpr uint64_t
+divReciprocal(uint64_t b)
+{
+    return ~(uint64_t)0 / b;
+}
+
+/**
+ * Divide by a divisor whose reciprocal was computed with divReciprocal,
+ * rounding down. The high half of the product with the reciprocal is at most
+ * two below the quotient, so the division is replaced by a multiplication
+ * and a couple of corrections. This is worthwhile when the same divisor is
+ * used over and over.
+ *
+ * @ingroup api_base_utils
+ */
+static constexpr uint64_t
+divFloorReciprocal(uint64_t a, uint64_t b, uint64_t recip)
+{
+    uint64_t q = mulUnsigned<uint64_t>(a, recip).first;
+    uint64_t r = a - q * b;
+    while (r >= b) {
+        ++q;
+        r -= b;
+    }
+    return q;
+}
+
+/**
+ * Like divFloorReciprocal, but rounding up. Unlike divCeil, this doesn't
+ * overflow for dividends close to the maximum value.
+ *
+ * @ingroup api_base_utils
+ */
+static constexpr uint64_t
+divCeilReciprocal(uint64_t a, uint64_t b, uint64_t recip)
+{
+    uint64_t q = divFloorReciprocal(a, b, recip);
+    return q + (a != q * b);
+}
+
 /**
  * This function is used to align addresses in memory.
  *
@@ -115,6 +115,29 @@ TEST(IntmathTest, divCeil)
     EXPECT_EQ(46, divCeil(451, 10));
 }
 
+TEST(IntmathTest, divReciprocal)
+{
+    const uint64_t divisors[] = {1, 2, 3, 7, 10, 13, 333, 1000, 1442,
+        1000000007, 0x8000000000000000ULL, 0xffffffffffffffffULL};
+    const uint64_t dividends[] = {0, 1, 2, 12, 13, 14, 55, 4800, 7922,
+        999999, 1000000, 1000001, 0x7fffffffffffffffULL,
+        0x8000000000000000ULL, 0xfffffffffffffffeULL,
+        0xffffffffffffffffULL};
+    for (uint64_t b: divisors) {
+        uint64_t recip = divReciprocal(b);
+        for (uint64_t a: dividends) {
+            EXPECT_EQ(a / b, divFloorReciprocal(a, b, recip));
+            EXPECT_EQ(a / b + (a % b != 0),
+                      divCeilReciprocal(a, b, recip));
+        }
+    }
+
+    EXPECT_EQ(5, divCeilReciprocal(55, 13, divReciprocal(13)));
+    EXPECT_EQ(90, divCeilReciprocal(7922, 89, divReciprocal(89)));
+    EXPECT_EQ(4, divCeilReciprocal(75, 24, divReciprocal(24)));
+    EXPECT_EQ(45, divFloorReciprocal(451, 10, divReciprocal(10)));
+}
+
 TEST(IntmathTest, mulUnsignedNarrow)
 {
     uint8_t a = 0xff;
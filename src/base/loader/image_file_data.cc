@@ -119,7 +119,7 @@ ImageFileData::ImageFileData(const std::string &fname)
 
     // Mmap the whole shebang.
     _data = (uint8_t *)mmap(NULL, _len, PROT_READ, MAP_SHARED, fd, 0);
-    close(fd);
+    _fd = fd;
 
     panic_if(_data == MAP_FAILED, "Failed to mmap file %s.\n", fname);
 }
@@ -127,6 +127,7 @@ ImageFileData::ImageFileData(const std::string &fname)
 ImageFileData::~ImageFileData()
 {
     munmap((void *)_data, _len);
+    close(_fd);
 }
 
 } // namespace loader
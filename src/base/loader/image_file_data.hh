@@ -47,12 +47,19 @@ class ImageFileData
     std::string _filename;
     uint8_t *_data;
     size_t _len;
+    int _fd;
 
   public:
     const std::string &filename() const { return _filename; }
     uint8_t const *data() const { return _data; }
     size_t len() const { return _len; }
 
+    /**
+     * Descriptor of the (possibly decompressed) file the data is mapped
+     * from, which stays open so that the data can be mapped elsewhere.
+     */
+    int fd() const { return _fd; }
+
     ImageFileData(const std::string &f_name);
     virtual ~ImageFileData();
 };
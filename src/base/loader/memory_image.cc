@@ -27,6 +27,7 @@
  */
 
 #include "base/loader/memory_image.hh"
+#include "mem/physical.hh"
 #include "mem/port_proxy.hh"
 
 namespace gem5
@@ -58,6 +59,29 @@ MemoryImage::write(const PortProxy &proxy) const
     return true;
 }
 
+bool
+MemoryImage::loadSegment(const Segment &seg,
+                         memory::PhysicalMemory &mem) const
+{
+    if (seg.size == 0)
+        return true;
+    if (seg.ifd) {
+        return mem.loadFile(seg.base, seg.ifd->fd(),
+                            seg.data - seg.ifd->data(), seg.data, seg.size);
+    }
+    return mem.loadBlob(seg.base, seg.data, seg.size);
+}
+
+bool
+MemoryImage::write(memory::PhysicalMemory &mem,
+                   const PortProxy &proxy) const
+{
+    for (auto &seg: _segments)
+        if (!loadSegment(seg, mem) && !writeSegment(seg, proxy))
+            return false;
+    return true;
+}
+
 MemoryImage &
 MemoryImage::move(std::function<Addr(Addr)> mapper)
 {
@@ -46,6 +46,11 @@ namespace gem5
 
 class PortProxy;
 
+namespace memory
+{
+class PhysicalMemory;
+} // namespace memory
+
 namespace loader
 {
 
@@ -98,6 +103,7 @@ class MemoryImage
   private:
     std::vector<Segment> _segments;
     bool writeSegment(const Segment &seg, const PortProxy &proxy) const;
+    bool loadSegment(const Segment &seg, memory::PhysicalMemory &mem) const;
 
   public:
     const std::vector<Segment> &
@@ -120,6 +126,14 @@ class MemoryImage
     }
 
     bool write(const PortProxy &proxy) const;
+
+    /**
+     * Write the image straight into the backing store of a physical
+     * memory before the simulation starts. Segments backed by a file are
+     * mapped lazily where possible, and any segment that doesn't fit in
+     * a single backing store is written through the proxy instead.
+     */
+    bool write(memory::PhysicalMemory &mem, const PortProxy &proxy) const;
     MemoryImage &move(std::function<Addr(Addr)> mapper);
     MemoryImage &
     offset(Addr by)
@@ -41,6 +41,7 @@
 #include "base/logging.hh"
 
 #include <sstream>
+#include <vector>
 
 #include "base/hostinfo.hh"
 
@@ -49,6 +50,25 @@ namespace gem5
 
 namespace {
 
+std::vector<std::function<void()>> &
+exitHooks()
+{
+    static auto *hooks = new std::vector<std::function<void()>>;
+    return *hooks;
+}
+
+void
+runExitHooks()
+{
+    // A hook hitting panic() or fatal() itself must not run them again
+    static bool running = false;
+    if (running)
+        return;
+    running = true;
+    for (auto &hook : exitHooks())
+        hook();
+}
+
 class ExitLogger : public Logger
 {
   public:
@@ -61,6 +81,7 @@ class ExitLogger : public Logger
         std::stringstream ss;
         ccprintf(ss, "Memory Usage: %ld KBytes\n", memUsage());
         Logger::log(loc, s + ss.str());
+        runExitHooks();
     }
 };
 
@@ -75,6 +96,12 @@ class FatalLogger : public ExitLogger
 
 } // anonymous namespace
 
+void
+Logger::addExitHook(std::function<void()> hook)
+{
+    exitHooks().push_back(std::move(hook));
+}
+
 // We intentionally put all the loggers on the heap to prevent them from being
 // destructed at the end of the program. This make them safe to be used inside
 // destructor of other global objects. Also, we make them function static
@@ -42,6 +42,7 @@
 #define __BASE_LOGGING_HH__
 
 #include <cassert>
+#include <functional>
 #include <sstream>
 #include <utility>
 
@@ -123,6 +124,13 @@ class Logger
      */
     [[noreturn]] void exit_helper() { exit(); ::abort(); }
 
+    /**
+     * Register a function called when panic() or fatal() are hit,
+     * before the simulator exits. It can be used to flush diagnostic
+     * state, and must not rely on the simulation being consistent.
+     */
+    static void addExitHook(std::function<void()> hook);
+
   protected:
     bool enabled;
 
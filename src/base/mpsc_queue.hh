@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_MPSC_QUEUE_HH__
+#define __BASE_MPSC_QUEUE_HH__
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+/**
+ * Bounded, lock-free, multi-producer single-consumer FIFO queue.
+ *
+ * Any number of threads may push() concurrently, while a single thread
+ * pops. Each slot carries a sequence number that tells producers and
+ * the consumer whether it is free or holds a value for the current lap
+ * around the buffer, so a push is a single compare-and-swap on the tail
+ * index in the common case and a pop needs no atomic read-modify-write
+ * at all.
+ *
+ * Values pushed by a single thread are popped in the order they were
+ * pushed. A push fails instead of blocking when the queue is full.
+ *
+ * @tparam T Type of the elements, must be default constructible.
+ *
+ * @ingroup api_base_utils
+ */
+template <typename T>
+class MPSCQueue
+{
+  private:
+    struct Slot
+    {
+        std::atomic<uint64_t> seq;
+        T value;
+    };
+
+    const uint64_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    /** Index of the next slot to push to, shared by all producers. */
+    alignas(64) std::atomic<uint64_t> tail;
+    /** Index of the next slot to pop from, only used by the consumer. */
+    alignas(64) uint64_t head;
+
+  public:
+    /**
+     * @param capacity Maximum number of elements, must be a power of 2.
+     */
+    explicit MPSCQueue(size_t capacity)
+        : mask(capacity - 1), slots(new Slot[capacity]), tail(0), head(0)
+    {
+        assert(isPowerOf2(capacity));
+        for (size_t i = 0; i < capacity; ++i)
+            slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    /**
+     * Add a value to the queue. Safe to call from any thread.
+     *
+     * @return false if the queue is full.
+     */
+    bool
+    push(const T &value)
+    {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        Slot *slot;
+        while (true) {
+            slot = &slots[pos & mask];
+            const uint64_t seq = slot->seq.load(std::memory_order_acquire);
+            const int64_t diff = (int64_t)seq - (int64_t)pos;
+            if (diff == 0) {
+                // The slot is free for this lap, try to claim it.
+                if (tail.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // The consumer hasn't freed the slot from the last lap.
+                return false;
+            } else {
+                // Another producer claimed the slot first.
+                pos = tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->value = value;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Remove the oldest value from the queue. Must only be called by
+     * the consumer thread.
+     *
+     * @return false if the queue is empty.
+     */
+    bool
+    pop(T &value)
+    {
+        Slot &slot = slots[head & mask];
+        if (slot.seq.load(std::memory_order_acquire) != head + 1)
+            return false;
+
+        value = slot.value;
+        slot.seq.store(head + mask + 1, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    /**
+     * Apply a function to every value in the queue, oldest first,
+     * without removing them. Must only be called while the consumer
+     * thread is not popping.
+     */
+    template <typename F>
+    void
+    forEach(F f) const
+    {
+        for (uint64_t pos = head;
+             slots[pos & mask].seq.load(std::memory_order_acquire) ==
+                 pos + 1;
+             ++pos) {
+            f(slots[pos & mask].value);
+        }
+    }
+
+    /**
+     * Check if the queue is empty. Must only be called by the consumer
+     * thread; values being pushed concurrently may not be visible yet.
+     */
+    bool
+    empty() const
+    {
+        return slots[head & mask].seq.load(std::memory_order_acquire) !=
+            head + 1;
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_MPSC_QUEUE_HH__
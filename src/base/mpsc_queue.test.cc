@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "base/mpsc_queue.hh"
+
+using namespace gem5;
+
+/** Values come out in the order they were pushed */
+TEST(MPSCQueueTest, Fifo)
+{
+    MPSCQueue<int> queue(8);
+    EXPECT_EQ(queue.capacity(), 8);
+    EXPECT_TRUE(queue.empty());
+
+    for (int i = 0; i < 5; ++i)
+        EXPECT_TRUE(queue.push(i));
+    EXPECT_FALSE(queue.empty());
+
+    int value;
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(queue.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+}
+
+/** Pushing to a full queue fails without losing any value */
+TEST(MPSCQueueTest, Full)
+{
+    MPSCQueue<int> queue(4);
+    int value;
+
+    // Go around the buffer a few times
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i)
+            EXPECT_TRUE(queue.push(lap * 4 + i));
+        EXPECT_FALSE(queue.push(-1));
+
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(queue.pop(value));
+            EXPECT_EQ(value, lap * 4 + i);
+        }
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+/** Concurrent producers preserve the order of their own values */
+TEST(MPSCQueueTest, MultipleProducers)
+{
+    const int num_producers = 4;
+    const int num_values = 100000;
+    MPSCQueue<std::pair<int, int>> queue(64);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < num_values; ++i) {
+                while (!queue.push({p, i}))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<int> next(num_producers, 0);
+    std::pair<int, int> value;
+    for (int received = 0; received < num_producers * num_values;) {
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value.second, next[value.first]);
+        ++next[value.first];
+        ++received;
+    }
+
+    for (auto &t : producers)
+        t.join();
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/parallel_gzip.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+namespace gem5
+{
+
+ParallelGzipWriter::ParallelGzipWriter(const std::string &path,
+                                       unsigned _threads,
+                                       size_t segment_size, int _level)
+    : file(std::fopen(path.c_str(), "wb")),
+      threads(std::max(_threads, 1u)),
+      _segmentSize(std::clamp<size_t>(segment_size, 1, UINT_MAX / 2)),
+      level(_level), failed(false), written(false), pendingFill(0)
+{
+}
+
+ParallelGzipWriter::~ParallelGzipWriter()
+{
+    if (file)
+        close();
+}
+
+bool
+ParallelGzipWriter::write(const uint8_t *data, size_t size)
+{
+    while (size > 0 && good()) {
+        if (pending.empty() || pendingFill == _segmentSize) {
+            if (pending.size() == threads && !flush())
+                return false;
+            pending.emplace_back();
+            pendingFill = 0;
+        }
+
+        const size_t len = std::min(size, _segmentSize - pendingFill);
+        pending.back().push_back({ data, len });
+        pendingFill += len;
+        data += len;
+        size -= len;
+    }
+    return good();
+}
+
+bool
+ParallelGzipWriter::close()
+{
+    if (!file)
+        return false;
+
+    // Make sure the file holds at least one (empty) member
+    if (!written && pending.empty())
+        pending.emplace_back();
+    flush();
+
+    if (std::fclose(file) != 0)
+        failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+bool
+ParallelGzipWriter::flush()
+{
+    std::vector<std::string> out(pending.size());
+    std::vector<char> ok(pending.size(), false);
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < pending.size(); ++i) {
+        workers.emplace_back([this, &out, &ok, i]() {
+            ok[i] = compress(pending[i], level, out[i]);
+        });
+    }
+    if (!pending.empty())
+        ok[0] = compress(pending[0], level, out[0]);
+    for (auto &worker : workers)
+        worker.join();
+
+    for (size_t i = 0; i < pending.size() && !failed; ++i) {
+        if (!ok[i] ||
+            std::fwrite(out[i].data(), 1, out[i].size(), file) !=
+                out[i].size()) {
+            failed = true;
+        }
+        memberSizes.push_back(out[i].size());
+    }
+
+    written = true;
+    pending.clear();
+    pendingFill = 0;
+    return !failed;
+}
+
+bool
+ParallelGzipWriter::compress(const Segment &segment, int level,
+                             std::string &out)
+{
+    z_stream zs = {};
+    // A window size of 15 plus 16 asks zlib for a gzip wrapper
+    if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+
+    size_t total = 0;
+    for (const auto &piece : segment)
+        total += piece.size;
+    out.resize(deflateBound(&zs, total));
+    zs.next_out = reinterpret_cast<Bytef *>(out.data());
+    zs.avail_out = out.size();
+
+    bool ok = true;
+    for (size_t i = 0; i <= segment.size() && ok; ++i) {
+        const bool last = i == segment.size();
+        zs.next_in = last ? nullptr : const_cast<Bytef *>(segment[i].data);
+        zs.avail_in = last ? 0 : segment[i].size;
+
+        int ret;
+        do {
+            if (zs.avail_out == 0) {
+                const size_t used = out.size();
+                out.resize(used * 2);
+                zs.next_out = reinterpret_cast<Bytef *>(out.data()) + used;
+                zs.avail_out = out.size() - used;
+            }
+            ret = deflate(&zs, last ? Z_FINISH : Z_NO_FLUSH);
+            if (ret == Z_STREAM_ERROR) {
+                ok = false;
+                break;
+            }
+        } while (last ? ret != Z_STREAM_END : zs.avail_in > 0);
+    }
+
+    out.resize(out.size() - zs.avail_out);
+    deflateEnd(&zs);
+    return ok;
+}
+
+ParallelGzipReader::ParallelGzipReader(const std::string &path,
+                                       unsigned _threads)
+    : fd(open(path.c_str(), O_RDONLY)), threads(std::max(_threads, 1u))
+{
+}
+
+ParallelGzipReader::~ParallelGzipReader()
+{
+    if (fd >= 0)
+        ::close(fd);
+}
+
+bool
+ParallelGzipReader::read(const std::vector<uint64_t> &members,
+                         size_t segment_size, uint8_t *data, size_t size,
+                         bool sparse)
+{
+    if (!good() || segment_size == 0 ||
+        members.size() != std::max<size_t>(
+            (size + segment_size - 1) / segment_size, 1)) {
+        return false;
+    }
+
+    std::vector<uint64_t> offsets(members.size());
+    for (size_t i = 1; i < members.size(); ++i)
+        offsets[i] = offsets[i - 1] + members[i - 1];
+
+    // Members are handed out one at a time as they take very different
+    // amounts of time to inflate depending on the data.
+    std::atomic<size_t> next(0);
+    std::atomic<bool> ok(true);
+    auto work = [&]() {
+        for (size_t i; ok && (i = next++) < members.size();) {
+            const uint64_t start = i * segment_size;
+            if (!decompress(offsets[i], members[i], data + start,
+                            std::min<uint64_t>(segment_size, size - start),
+                            sparse)) {
+                ok = false;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const size_t nbr_of_workers = std::min<size_t>(threads, members.size());
+    for (size_t i = 1; i < nbr_of_workers; ++i)
+        workers.emplace_back(work);
+    work();
+    for (auto &worker : workers)
+        worker.join();
+
+    return ok;
+}
+
+bool
+ParallelGzipReader::decompress(uint64_t offset, uint64_t compressed_size,
+                               uint8_t *data, size_t size, bool sparse) const
+{
+    std::string in(compressed_size, '\0');
+    for (uint64_t done = 0; done < compressed_size;) {
+        const ssize_t ret = pread(fd, in.data() + done,
+                                  compressed_size - done, offset + done);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+        done += ret;
+    }
+
+    z_stream zs = {};
+    // A window size of 15 plus 16 only accepts a gzip wrapper
+    if (inflateInit2(&zs, 15 + 16) != Z_OK)
+        return false;
+    zs.next_in = reinterpret_cast<Bytef *>(in.data());
+    zs.avail_in = in.size();
+
+    // When sparse, inflate into a small buffer and only copy the words
+    // that are non-zero
+    constexpr size_t bounce_size = 64 * 1024;
+    std::vector<uint8_t> bounce(sparse ? bounce_size : 0);
+
+    int ret = Z_OK;
+    size_t filled = 0;
+    while (ret == Z_OK) {
+        uint8_t *out = sparse ? bounce.data() : data + filled;
+        const size_t len = sparse ?
+            std::min(bounce_size, size - filled) : size - filled;
+        zs.next_out = out;
+        zs.avail_out = len;
+        ret = inflate(&zs, Z_NO_FLUSH);
+        const size_t produced = len - zs.avail_out;
+        if (sparse) {
+            size_t i = 0;
+            for (; i + sizeof(uint64_t) <= produced; i += sizeof(uint64_t)) {
+                uint64_t word;
+                std::memcpy(&word, out + i, sizeof(word));
+                if (word)
+                    std::memcpy(data + filled + i, &word, sizeof(word));
+            }
+            for (; i < produced; ++i) {
+                if (out[i])
+                    data[filled + i] = out[i];
+            }
+        }
+        filled += produced;
+    }
+
+    // The member must decompress to exactly size bytes
+    const bool ok = ret == Z_STREAM_END && filled == size &&
+        zs.avail_in == 0;
+    inflateEnd(&zs);
+    return ok;
+}
+
+} // namespace gem5
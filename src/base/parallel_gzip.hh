@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_PARALLEL_GZIP_HH__
+#define __BASE_PARALLEL_GZIP_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * Writes a gzip file, compressing the data on several host threads.
+ *
+ * The data is split into segments, and each segment is compressed
+ * into its own gzip member. A file made of concatenated members is
+ * still a valid gzip file, so it can be read back with gzread() or
+ * gunzip like any other.
+ *
+ * The writer does not copy the data it is given. Buffers passed to
+ * write() must stay valid and unchanged until close() returns.
+ *
+ * @ingroup api_base_utils
+ */
+class ParallelGzipWriter
+{
+  public:
+    /** Default amount of data compressed by a thread in one go. */
+    static constexpr size_t defaultSegmentSize = 16 * 1024 * 1024;
+
+    /**
+     * @param path File to create
+     * @param threads Number of host threads to compress on
+     * @param segment_size Amount of data in each gzip member
+     * @param level zlib compression level
+     */
+    ParallelGzipWriter(const std::string &path, unsigned threads,
+                       size_t segment_size=defaultSegmentSize,
+                       int level=-1);
+    ~ParallelGzipWriter();
+
+    ParallelGzipWriter(const ParallelGzipWriter &) = delete;
+    ParallelGzipWriter &operator=(const ParallelGzipWriter &) = delete;
+
+    /** Whether the file was opened successfully and no write failed. */
+    bool good() const { return file && !failed; }
+
+    /**
+     * Append data to the file.
+     *
+     * @return false if compressing or writing a segment failed
+     */
+    bool write(const uint8_t *data, size_t size);
+
+    /**
+     * Compress any outstanding data and close the file.
+     *
+     * @return false if anything went wrong since the file was opened
+     */
+    bool close();
+
+    /**
+     * Compressed size of each of the gzip members written so far. Every
+     * member but the last one holds exactly segmentSize() bytes of data,
+     * so recording these lets ParallelGzipReader find the members.
+     */
+    const std::vector<uint64_t> &members() const { return memberSizes; }
+
+    size_t segmentSize() const { return _segmentSize; }
+
+  private:
+    struct Piece
+    {
+        const uint8_t *data;
+        size_t size;
+    };
+
+    /** The pieces making up one gzip member. */
+    using Segment = std::vector<Piece>;
+
+    /** Deflate a segment into a gzip member. */
+    static bool compress(const Segment &segment, int level,
+                         std::string &out);
+
+    /** Compress all pending segments and write them out in order. */
+    bool flush();
+
+    FILE *file;
+    const unsigned threads;
+    const size_t _segmentSize;
+    const int level;
+    bool failed;
+    bool written;
+
+    std::vector<Segment> pending;
+    size_t pendingFill;
+    std::vector<uint64_t> memberSizes;
+};
+
+/**
+ * Reads a gzip file written by ParallelGzipWriter, decompressing its
+ * members on several host threads.
+ *
+ * @ingroup api_base_utils
+ */
+class ParallelGzipReader
+{
+  public:
+    /**
+     * @param path File to read
+     * @param threads Number of host threads to decompress on
+     */
+    ParallelGzipReader(const std::string &path, unsigned threads);
+    ~ParallelGzipReader();
+
+    ParallelGzipReader(const ParallelGzipReader &) = delete;
+    ParallelGzipReader &operator=(const ParallelGzipReader &) = delete;
+
+    /** Whether the file was opened successfully. */
+    bool good() const { return fd >= 0; }
+
+    /**
+     * Decompress the whole file.
+     *
+     * @param members Compressed size of each member, as reported by
+     * ParallelGzipWriter::members()
+     * @param segment_size Amount of data in each member but the last
+     * @param data Buffer for the decompressed data
+     * @param size Expected amount of decompressed data
+     * @param sparse Only write the words of data that are non-zero, so
+     * that untouched pages of a lazily allocated buffer stay unallocated
+     * @return false if the file does not match the members or is corrupt
+     */
+    bool read(const std::vector<uint64_t> &members, size_t segment_size,
+              uint8_t *data, size_t size, bool sparse=false);
+
+  private:
+    /** Inflate one member read from offset into data. */
+    bool decompress(uint64_t offset, uint64_t compressed_size,
+                    uint8_t *data, size_t size, bool sparse) const;
+
+    int fd;
+    const unsigned threads;
+};
+
+} // namespace gem5
+
+#endif // __BASE_PARALLEL_GZIP_HH__
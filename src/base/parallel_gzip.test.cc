@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "base/parallel_gzip.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+std::vector<uint8_t>
+readGzip(const std::string &path)
+{
+    std::vector<uint8_t> data;
+    gzFile in = gzopen(path.c_str(), "rb");
+    EXPECT_NE(in, nullptr);
+    uint8_t buf[4096];
+    int len;
+    while ((len = gzread(in, buf, sizeof(buf))) > 0)
+        data.insert(data.end(), buf, buf + len);
+    EXPECT_EQ(len, 0);
+    gzclose(in);
+    return data;
+}
+
+std::vector<uint8_t>
+testData(size_t size)
+{
+    std::mt19937 rng(1);
+    std::vector<uint8_t> data(size);
+    // Mostly compressible, with runs of random bytes
+    for (size_t i = 0; i < size; ++i)
+        data[i] = (i / 1000) % 3 ? rng() : i / 7;
+    return data;
+}
+
+} // anonymous namespace
+
+/** Data split over several threads and members reads back unchanged */
+TEST(ParallelGzipWriterTest, RoundTrip)
+{
+    const std::string path = testing::TempDir() + "parallel_gzip.gz";
+    const auto data = testData(1000000);
+
+    for (unsigned threads : { 1, 4 }) {
+        ParallelGzipWriter out(path, threads, 65536);
+        ASSERT_TRUE(out.good());
+        // Write in uneven pieces that straddle segment boundaries
+        size_t pos = 0;
+        for (size_t len = 1; pos < data.size(); len = len * 3 + 1) {
+            len = std::min(len, data.size() - pos);
+            ASSERT_TRUE(out.write(data.data() + pos, len));
+            pos += len;
+        }
+        ASSERT_TRUE(out.close());
+        EXPECT_EQ(readGzip(path), data);
+    }
+    std::remove(path.c_str());
+}
+
+/** A file without any data is still a valid, empty gzip file */
+TEST(ParallelGzipWriterTest, Empty)
+{
+    const std::string path = testing::TempDir() + "parallel_gzip_empty.gz";
+    ParallelGzipWriter out(path, 2);
+    ASSERT_TRUE(out.close());
+    EXPECT_TRUE(readGzip(path).empty());
+    std::remove(path.c_str());
+}
+
+/** Failing to create the file is reported */
+TEST(ParallelGzipWriterTest, BadPath)
+{
+    ParallelGzipWriter out("/nonexistent/dir/file.gz", 2);
+    EXPECT_FALSE(out.good());
+    EXPECT_FALSE(out.close());
+}
+
+/** The members can be decompressed in parallel given their sizes */
+TEST(ParallelGzipReaderTest, RoundTrip)
+{
+    const std::string path = testing::TempDir() + "parallel_gzip_read.gz";
+    const auto data = testData(1000000);
+
+    ParallelGzipWriter out(path, 4, 65536);
+    ASSERT_TRUE(out.write(data.data(), data.size()));
+    ASSERT_TRUE(out.close());
+    ASSERT_EQ(out.members().size(), (data.size() + 65535) / 65536);
+
+    for (bool sparse : { false, true }) {
+        ParallelGzipReader in(path, 3);
+        ASSERT_TRUE(in.good());
+        std::vector<uint8_t> result(data.size());
+        ASSERT_TRUE(in.read(out.members(), out.segmentSize(),
+                            result.data(), result.size(), sparse));
+        EXPECT_EQ(result, data);
+    }
+
+    // Sizes that do not match the file are rejected
+    ParallelGzipReader in(path, 3);
+    std::vector<uint8_t> result(data.size() + 1);
+    EXPECT_FALSE(in.read(out.members(), out.segmentSize(),
+                         result.data(), result.size()));
+    auto members = out.members();
+    members[1] += 1;
+    EXPECT_FALSE(in.read(members, out.segmentSize(),
+                         result.data(), data.size()));
+    std::remove(path.c_str());
+}
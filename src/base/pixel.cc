@@ -38,6 +38,7 @@
 #include "base/pixel.hh"
 
 #include <cassert>
+#include <cstring>
 
 #include "base/bitfield.hh"
 
@@ -63,6 +64,12 @@ PixelConverter::PixelConverter(unsigned _length,
       ch_b(bo, bw)
 {
     assert(length > 1);
+
+    byteChannels = length == 4;
+    for (const Channel *ch : { &ch_r, &ch_g, &ch_b }) {
+        if (ch->mask != 0xff || ch->offset % 8 || ch->offset > 24)
+            byteChannels = false;
+    }
 }
 
 PixelConverter::Channel::Channel(unsigned _offset, unsigned width)
@@ -72,6 +79,57 @@ PixelConverter::Channel::Channel(unsigned _offset, unsigned width)
 {
 }
 
+void
+PixelConverter::toPixels(const uint8_t *src, Pixel *dst, size_t count) const
+{
+    if (!byteChannels) {
+        for (size_t i = 0; i < count; ++i, src += length)
+            dst[i] = toPixel(src);
+        return;
+    }
+
+    const unsigned ro = ch_r.offset, go = ch_g.offset, bo = ch_b.offset;
+    auto convert = [=](auto to_host) {
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t word;
+            std::memcpy(&word, src + i * sizeof(word), sizeof(word));
+            word = to_host(word);
+            dst[i] = Pixel(word >> ro, word >> go, word >> bo);
+        }
+    };
+
+    if (byte_order == ByteOrder::little)
+        convert([](uint32_t word) { return letoh(word); });
+    else
+        convert([](uint32_t word) { return betoh(word); });
+}
+
+void
+PixelConverter::fromPixels(const Pixel *src, uint8_t *dst,
+                           size_t count) const
+{
+    if (!byteChannels) {
+        for (size_t i = 0; i < count; ++i, dst += length)
+            fromPixel(dst, src[i]);
+        return;
+    }
+
+    const unsigned ro = ch_r.offset, go = ch_g.offset, bo = ch_b.offset;
+    auto convert = [=](auto from_host) {
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t word = from_host(uint32_t(src[i].red) << ro |
+                                            uint32_t(src[i].green) << go |
+                                            uint32_t(src[i].blue) << bo);
+            std::memcpy(dst + i * sizeof(word), &word, sizeof(word));
+        }
+    };
+
+    if (byte_order == ByteOrder::little)
+        convert([](uint32_t word) { return htole(word); });
+    else
+        convert([](uint32_t word) { return htobe(word); });
+}
+
 uint32_t
 PixelConverter::readWord(const uint8_t *p) const
 {
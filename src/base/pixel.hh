@@ -161,6 +161,29 @@ class PixelConverter
         writeWord(rfb, fromPixel(pixel));
     }
 
+    /**
+     * Convert a sequence of color words stored in memory into Pixels.
+     *
+     * This is equivalent to calling toPixel() for every word, but
+     * formats with byte aligned 8-bit channels in a 32-bit word (see
+     * byteChannels) are converted by a loop without per channel
+     * scaling that the compiler can vectorize.
+     *
+     * @param src Pointer to the first word in memory.
+     * @param dst Output Pixels.
+     * @param count Number of pixels to convert.
+     */
+    void toPixels(const uint8_t *src, Pixel *dst, size_t count) const;
+    /**
+     * Convert a sequence of Pixels into color words and store them in
+     * memory. This is the inverse of toPixels().
+     *
+     * @param src Pixels to convert.
+     * @param dst Pointer to the first word in memory.
+     * @param count Number of pixels to convert.
+     */
+    void fromPixels(const Pixel *src, uint8_t *dst, size_t count) const;
+
     /**
      * Read a word of a given length and endianness from memory.
      *
@@ -198,6 +221,12 @@ class PixelConverter
     /** Blue channel conversion helper */
     Channel ch_b;
 
+    /**
+     * All the channels are 8 bits wide and byte aligned in a 32-bit
+     * word, so no scaling is needed to convert them.
+     */
+    bool byteChannels;
+
     /** Predefined 32-bit RGB (red in least significant bits, 8
      * bits/channel, little endian) conversion helper */
     static const PixelConverter rgba8888_le;
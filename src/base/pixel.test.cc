@@ -37,6 +37,8 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>
+
 #include "base/pixel.hh"
 
 using namespace gem5;
@@ -119,3 +121,39 @@ TEST(FBTest, MemToPixelRGBA8888BE)
     EXPECT_EQ(PixelConverter::rgba8888_be.toPixel(green), pixel_green);
     EXPECT_EQ(PixelConverter::rgba8888_be.toPixel(blue), pixel_blue);
 }
+
+TEST(FBTest, BulkConversion)
+{
+    const PixelConverter bgr888_be(4, 16, 8, 0, 8, 8, 8, ByteOrder::big);
+    const PixelConverter *converters[] = {
+        &PixelConverter::rgba8888_le, &PixelConverter::rgba8888_be,
+        &PixelConverter::rgb565_le, &PixelConverter::rgb565_be,
+        &bgr888_be,
+    };
+
+    std::vector<Pixel> pixels;
+    for (unsigned i = 0; i < 67; ++i)
+        pixels.emplace_back(i * 3, 0xff - i, i * 7);
+
+    for (const PixelConverter *conv : converters) {
+        // The bulk conversion must match the per pixel conversion
+        std::vector<uint8_t> expected(pixels.size() * conv->length);
+        for (unsigned i = 0; i < pixels.size(); ++i)
+            conv->fromPixel(expected.data() + i * conv->length, pixels[i]);
+
+        std::vector<uint8_t> words(expected.size());
+        conv->fromPixels(pixels.data(), words.data(), pixels.size());
+        EXPECT_EQ(words, expected);
+
+        std::vector<Pixel> result(pixels.size());
+        conv->toPixels(words.data(), result.data(), result.size());
+        for (unsigned i = 0; i < pixels.size(); ++i) {
+            EXPECT_EQ(result[i],
+                      conv->toPixel(words.data() + i * conv->length));
+        }
+    }
+
+    EXPECT_TRUE(PixelConverter::rgba8888_le.byteChannels);
+    EXPECT_TRUE(bgr888_be.byteChannels);
+    EXPECT_FALSE(PixelConverter::rgb565_le.byteChannels);
+}
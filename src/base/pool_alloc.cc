@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/pool_alloc.hh"
+
+#include <mutex>
+
+namespace gem5
+{
+
+namespace
+{
+
+std::mutex poolListLock;
+SizeClassPool *poolList = nullptr;
+
+} // anonymous namespace
+
+SizeClassPool *
+SizeClassPool::create()
+{
+    auto *pool = new SizeClassPool;
+    std::lock_guard<std::mutex> lock(poolListLock);
+    pool->nextPool = poolList;
+    poolList = pool;
+    return pool;
+}
+
+SizeClassPool::Counters
+SizeClassPool::counters(unsigned cls)
+{
+    Counters res;
+    std::lock_guard<std::mutex> lock(poolListLock);
+    for (auto *pool = poolList; pool; pool = pool->nextPool) {
+        const Class &c = pool->classes[cls];
+        res.hits += c.hits.load(std::memory_order_relaxed);
+        res.misses += c.misses.load(std::memory_order_relaxed);
+    }
+    return res;
+}
+
+void
+SizeClassPool::resetCounters()
+{
+    std::lock_guard<std::mutex> lock(poolListLock);
+    for (auto *pool = poolList; pool; pool = pool->nextPool) {
+        for (auto &c : pool->classes) {
+            c.hits.store(0, std::memory_order_relaxed);
+            c.misses.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace gem5
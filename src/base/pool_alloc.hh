@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_POOL_ALLOC_HH__
+#define __BASE_POOL_ALLOC_HH__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace gem5
+{
+
+/**
+ * Per-thread, size-class pooled allocator for small, short-lived
+ * objects such as packets, requests and their data buffers.
+ *
+ * Requests are rounded up to the next power of 2 between minBlockSize
+ * and maxBlockSize. Freed blocks are kept on a per-thread free list
+ * for their size class and handed out again by later allocations, so
+ * that the steady state of a simulation does not touch the host
+ * allocator at all. Larger requests go straight to the host allocator.
+ *
+ * A block may be freed by a different thread than the one that
+ * allocated it; it simply ends up on the free list of the freeing
+ * thread. All memory comes from the global operator new, so blocks are
+ * never tied to a particular pool.
+ *
+ * Pooling is bypassed when building with the address sanitizer so that
+ * use-after-free errors are still caught.
+ *
+ * @ingroup api_base_utils
+ */
+class SizeClassPool
+{
+  public:
+    static constexpr unsigned minBlockShift = 4;
+    static constexpr unsigned maxBlockShift = 12;
+    static constexpr size_t minBlockSize = size_t(1) << minBlockShift;
+    static constexpr size_t maxBlockSize = size_t(1) << maxBlockShift;
+    static constexpr unsigned numClasses = maxBlockShift - minBlockShift + 1;
+
+    /** Maximum number of free blocks cached per size class and thread. */
+    static constexpr size_t maxCachedBlocks = 4096;
+
+    /** Allocation counters of a size class, summed over all threads. */
+    struct Counters
+    {
+        /** Allocations served from a free list */
+        uint64_t hits = 0;
+        /** Allocations that had to go to the host allocator */
+        uint64_t misses = 0;
+    };
+
+    /** The pool of the calling thread. */
+    static SizeClassPool &
+    local()
+    {
+        // The pool is deliberately never destroyed: packets may still
+        // be freed by static destructors after thread-local storage
+        // has been torn down.
+        thread_local SizeClassPool *pool = create();
+        return *pool;
+    }
+
+    /** Size class used for an allocation, numClasses if none fits. */
+    static constexpr unsigned
+    sizeClass(size_t bytes)
+    {
+        unsigned cls = 0;
+        while (cls < numClasses && (minBlockSize << cls) < bytes)
+            ++cls;
+        return cls;
+    }
+
+    void *
+    allocate(size_t bytes)
+    {
+        const unsigned cls = sizeClass(bytes);
+        if (cls == numClasses)
+            return ::operator new(bytes);
+
+        Class &c = classes[cls];
+        if (FreeBlock *blk = c.head) {
+            c.head = blk->next;
+            --c.cached;
+            bump(c.hits);
+            return blk;
+        }
+        bump(c.misses);
+        return ::operator new(minBlockSize << cls);
+    }
+
+    void
+    deallocate(void *p, size_t bytes)
+    {
+        if (!p)
+            return;
+        const unsigned cls = sizeClass(bytes);
+        if (cls == numClasses || bypass ||
+                classes[cls].cached >= maxCachedBlocks) {
+            ::operator delete(p);
+            return;
+        }
+
+        Class &c = classes[cls];
+        FreeBlock *blk = static_cast<FreeBlock *>(p);
+        blk->next = c.head;
+        c.head = blk;
+        ++c.cached;
+    }
+
+    /** Counters of a size class, summed over all threads. */
+    static Counters counters(unsigned cls);
+
+    /** Reset the counters of all threads. */
+    static void resetCounters();
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    struct Class
+    {
+        FreeBlock *head = nullptr;
+        size_t cached = 0;
+        /**
+         * Only ever written by the owning thread; atomic so that they
+         * can be read when dumping statistics.
+         */
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+    };
+
+    std::array<Class, numClasses> classes;
+
+    /** Next pool of the list of all pools, used to collect counters. */
+    SizeClassPool *nextPool = nullptr;
+
+#if defined(__SANITIZE_ADDRESS__)
+    static constexpr bool bypass = true;
+#else
+    static constexpr bool bypass = false;
+#endif
+
+    SizeClassPool() = default;
+
+    static SizeClassPool *create();
+
+    static void
+    bump(std::atomic<uint64_t> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Standard allocator drawing from the pool of the calling thread, for
+ * use with std::allocate_shared and containers.
+ */
+template <typename T>
+class PoolAllocator
+{
+  public:
+    using value_type = T;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *
+    allocate(size_t n)
+    {
+        return static_cast<T *>(
+            SizeClassPool::local().allocate(n * sizeof(T)));
+    }
+
+    void
+    deallocate(T *p, size_t n)
+    {
+        SizeClassPool::local().deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const { return false; }
+};
+
+} // namespace gem5
+
+#endif // __BASE_POOL_ALLOC_HH__
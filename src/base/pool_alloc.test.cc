@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base/pool_alloc.hh"
+
+using namespace gem5;
+
+TEST(SizeClassPoolTest, SizeClass)
+{
+    EXPECT_EQ(SizeClassPool::sizeClass(1), 0);
+    EXPECT_EQ(SizeClassPool::sizeClass(SizeClassPool::minBlockSize), 0);
+    EXPECT_EQ(SizeClassPool::sizeClass(SizeClassPool::minBlockSize + 1), 1);
+    EXPECT_EQ(SizeClassPool::sizeClass(64), 2);
+    EXPECT_EQ(SizeClassPool::sizeClass(SizeClassPool::maxBlockSize),
+              SizeClassPool::numClasses - 1);
+    EXPECT_EQ(SizeClassPool::sizeClass(SizeClassPool::maxBlockSize + 1),
+              SizeClassPool::numClasses);
+}
+
+/** Freed blocks are reused by later allocations of the same class */
+TEST(SizeClassPoolTest, Reuse)
+{
+    auto &pool = SizeClassPool::local();
+    const unsigned cls = SizeClassPool::sizeClass(64);
+    SizeClassPool::resetCounters();
+
+    void *a = pool.allocate(64);
+    void *b = pool.allocate(60);
+    EXPECT_NE(a, b);
+    pool.deallocate(a, 64);
+    pool.deallocate(b, 60);
+
+    // Free lists are LIFO
+    EXPECT_EQ(pool.allocate(50), b);
+    EXPECT_EQ(pool.allocate(64), a);
+    pool.deallocate(a, 64);
+    pool.deallocate(b, 50);
+
+    const auto c = SizeClassPool::counters(cls);
+    EXPECT_EQ(c.misses, 2);
+    EXPECT_EQ(c.hits, 2);
+
+    SizeClassPool::resetCounters();
+    EXPECT_EQ(SizeClassPool::counters(cls).hits, 0);
+}
+
+/** Oversized blocks go to the host allocator and are not counted */
+TEST(SizeClassPoolTest, Oversized)
+{
+    auto &pool = SizeClassPool::local();
+    SizeClassPool::resetCounters();
+    void *p = pool.allocate(SizeClassPool::maxBlockSize + 1);
+    ASSERT_NE(p, nullptr);
+    pool.deallocate(p, SizeClassPool::maxBlockSize + 1);
+    for (unsigned cls = 0; cls < SizeClassPool::numClasses; ++cls) {
+        EXPECT_EQ(SizeClassPool::counters(cls).hits, 0);
+        EXPECT_EQ(SizeClassPool::counters(cls).misses, 0);
+    }
+}
+
+/** Blocks can be freed by another thread than the one allocating them */
+TEST(SizeClassPoolTest, CrossThread)
+{
+    SizeClassPool::resetCounters();
+    const unsigned cls = SizeClassPool::sizeClass(128);
+
+    std::vector<void *> blocks;
+    std::thread producer([&blocks]() {
+        for (int i = 0; i < 16; ++i)
+            blocks.push_back(SizeClassPool::local().allocate(128));
+    });
+    producer.join();
+    EXPECT_EQ(SizeClassPool::counters(cls).misses, 16);
+
+    for (auto *p : blocks)
+        SizeClassPool::local().deallocate(p, 128);
+    for (int i = 0; i < 16; ++i)
+        blocks[i] = SizeClassPool::local().allocate(128);
+    EXPECT_EQ(SizeClassPool::counters(cls).hits, 16);
+    for (auto *p : blocks)
+        SizeClassPool::local().deallocate(p, 128);
+}
+
+TEST(PoolAllocatorTest, SharedPtr)
+{
+    struct Value
+    {
+        int a;
+        double b;
+        Value(int _a, double _b) : a(_a), b(_b) {}
+    };
+
+    auto v = std::allocate_shared<Value>(PoolAllocator<Value>(), 1, 2.0);
+    EXPECT_EQ(v->a, 1);
+    EXPECT_EQ(v->b, 2.0);
+    Value *raw = v.get();
+    v.reset();
+
+    // The control block and value are returned to the pool as one block
+    auto w = std::allocate_shared<Value>(PoolAllocator<Value>(), 3, 4.0);
+    EXPECT_EQ(w.get(), raw);
+}
@@ -98,4 +98,41 @@ Random::unserialize(CheckpointIn &cp)
 
 Random random_mt;
 
+uint64_t RandomStream::globalSeed = 5489;
+
+namespace
+{
+
+uint64_t
+splitMix64(uint64_t &x)
+{
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+} // anonymous namespace
+
+void
+RandomStream::seed(uint64_t s)
+{
+    // Spread the seed over the whole state, which must not be all zeros.
+    for (auto &word: state)
+        word = splitMix64(s);
+}
+
+void
+RandomStream::seed(const std::string &name)
+{
+    // FNV-1a, which unlike std::hash gives the same value on every host
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c: name) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    uint64_t mixed = globalSeed;
+    seed(splitMix64(mixed) ^ hash);
+}
+
 } // namespace gem5
@@ -45,11 +45,13 @@
 #ifndef __BASE_RANDOM_HH__
 #define __BASE_RANDOM_HH__
 
+#include <cstdint>
 #include <random>
 #include <string>
 #include <type_traits>
 
 #include "base/compiler.hh"
+#include "base/intmath.hh"
 #include "base/types.hh"
 #include "sim/serialize.hh"
 
@@ -125,6 +127,125 @@ class Random : public Serializable
  */
 extern Random random_mt;
 
+/**
+ * A small and fast random number engine (xoshiro256**), meant to give each
+ * object its own stream of numbers rather than having all of them draw
+ * from random_mt. Besides being a lot cheaper than the Mersenne twister,
+ * a private stream keeps what an object sees independent of how many
+ * numbers the other objects draw, and doesn't need to be shared between
+ * threads.
+ *
+ * A stream is seeded from the global seed (see setGlobalSeed()) and a
+ * name, normally the path of the owning object, so that every object gets
+ * a different but reproducible stream. It meets the requirements of a
+ * uniform random bit generator and can also be used with the standard
+ * distributions.
+ */
+class RandomStream
+{
+  public:
+    using result_type = uint64_t;
+
+    /**
+     * @ingroup api_base_utils
+     * @{
+     */
+    explicit RandomStream(uint64_t s) { seed(s); }
+    explicit RandomStream(const std::string &name) { seed(name); }
+    /** @} */ // end of api_base_utils
+
+    /** Seed the stream with a number */
+    void seed(uint64_t s);
+
+    /** Seed the stream from the global seed and a name */
+    void seed(const std::string &name);
+
+    /**
+     * Set the seed the named streams are derived from. Only streams
+     * seeded afterwards are affected, so this should be done before the
+     * objects are created.
+     */
+    static void setGlobalSeed(uint64_t s) { globalSeed = s; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type
+    operator()()
+    {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    /**
+     * Same as Random::random(), [0, max_value] for integer types.
+     *
+     * @ingroup api_base_utils
+     */
+    template <typename T>
+    typename std::enable_if_t<std::is_integral_v<T>, T>
+    random()
+    {
+        return T((*this)());
+    }
+
+    /**
+     * [0, 1) for real types, with the precision of a double.
+     *
+     * @ingroup api_base_utils
+     */
+    template <typename T>
+    typename std::enable_if_t<std::is_floating_point_v<T>, T>
+    random()
+    {
+        return T(((*this)() >> 11) * 0x1.0p-53);
+    }
+
+    /**
+     * [min, max] for integer types. The random bits are mapped to the
+     * range with a multiply and rejection, which keeps the result
+     * unbiased without the divisions of std::uniform_int_distribution in
+     * the common case.
+     *
+     * @ingroup api_base_utils
+     */
+    template <typename T>
+    typename std::enable_if_t<std::is_integral_v<T>, T>
+    random(T min, T max)
+    {
+        const uint64_t range = uint64_t(max) - uint64_t(min) + 1;
+        if (range == 0)
+            return T((*this)());
+
+        uint64_t high, low;
+        mulUnsigned<uint64_t>(high, low, (*this)(), range);
+        if (low < range) {
+            const uint64_t threshold = -range % range;
+            while (low < threshold)
+                mulUnsigned<uint64_t>(high, low, (*this)(), range);
+        }
+        return T(uint64_t(min) + high);
+    }
+
+  private:
+    static uint64_t
+    rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t state[4];
+
+    static uint64_t globalSeed;
+};
+
 } // namespace gem5
 
 #endif // __BASE_RANDOM_HH__
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/random.hh"
+
+using namespace gem5;
+
+/** Draw a few numbers from a stream. */
+static std::vector<uint64_t>
+draw(RandomStream &stream, int count = 16)
+{
+    std::vector<uint64_t> values;
+    for (int i = 0; i < count; i++)
+        values.push_back(stream());
+    return values;
+}
+
+/** Streams with the same seed produce the same numbers. */
+TEST(RandomStreamTest, Reproducible)
+{
+    RandomStream a(42), b(42);
+    EXPECT_EQ(draw(a), draw(b));
+
+    RandomStream c("system.cpu"), d("system.cpu");
+    EXPECT_EQ(draw(c), draw(d));
+}
+
+/** Streams with another seed or name produce other numbers. */
+TEST(RandomStreamTest, Independent)
+{
+    RandomStream a(1), b(2);
+    EXPECT_NE(draw(a), draw(b));
+
+    RandomStream c("system.cpu0"), d("system.cpu1");
+    EXPECT_NE(draw(c), draw(d));
+}
+
+/** Reseeding restarts the stream. */
+TEST(RandomStreamTest, Reseed)
+{
+    RandomStream a("system.mem");
+    std::vector<uint64_t> first = draw(a);
+    a.seed("system.mem");
+    EXPECT_EQ(first, draw(a));
+}
+
+/** The global seed changes the named streams seeded after it is set. */
+TEST(RandomStreamTest, GlobalSeed)
+{
+    RandomStream a("system.l2");
+    RandomStream::setGlobalSeed(1234);
+    RandomStream b("system.l2");
+    RandomStream::setGlobalSeed(5489);
+    RandomStream c("system.l2");
+    std::vector<uint64_t> first = draw(a);
+    EXPECT_NE(first, draw(b));
+    EXPECT_EQ(first, draw(c));
+}
+
+/** Numbers drawn from a range stay in it and cover it. */
+TEST(RandomStreamTest, Range)
+{
+    RandomStream stream(7);
+    std::vector<int> seen(10, 0);
+    for (int i = 0; i < 10000; i++) {
+        int value = stream.random(-5, 4);
+        ASSERT_GE(value, -5);
+        ASSERT_LE(value, 4);
+        seen[value + 5]++;
+    }
+    // Every value is expected around 1000 times.
+    for (int count: seen) {
+        EXPECT_GT(count, 800);
+        EXPECT_LT(count, 1200);
+    }
+
+    EXPECT_EQ(stream.random<unsigned>(3, 3), 3);
+    const uint64_t any = stream.random<uint64_t>(0, UINT64_MAX);
+    (void)any;
+}
+
+/** Real numbers are drawn from [0, 1). */
+TEST(RandomStreamTest, Real)
+{
+    RandomStream stream(11);
+    double sum = 0;
+    for (int i = 0; i < 10000; i++) {
+        double value = stream.random<double>();
+        ASSERT_GE(value, 0.0);
+        ASSERT_LT(value, 1.0);
+        sum += value;
+    }
+    EXPECT_NEAR(sum / 10000, 0.5, 0.02);
+}
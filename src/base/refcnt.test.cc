@@ -70,6 +70,12 @@ class TestRC : public RefCounted
 };
 typedef RefCountingPtr<TestRC> Ptr;
 
+class DerivedTestRC : public TestRC
+{
+  public:
+    int derivedVal;
+};
+
 } // anonymous namespace
 
 TEST(RefcntTest, NullPointerCheck)
@@ -172,3 +178,20 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, ConversionFromDerivedPointer)
+{
+    // A Ptr to a derived class converts to a Ptr to its base and shares
+    // the reference count with it.
+    RefCountingPtr<DerivedTestRC> derived = new DerivedTestRC();
+    {
+        Ptr base = derived;
+        RefCountingPtr<const TestRC> constBase = derived;
+        EXPECT_EQ(base.get(), derived.get());
+        EXPECT_EQ(constBase.get(), derived.get());
+        EXPECT_EQ(1, liveListSize());
+    }
+    EXPECT_EQ(1, liveListSize());
+    derived = nullptr;
+    EXPECT_EQ(0, liveListSize());
+}
@@ -137,6 +137,7 @@
 #include <csignal>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <iterator>
 #include <sstream>
 #include <string>
@@ -167,6 +168,12 @@ static const char GDBStart = '$';
 static const char GDBEnd = '#';
 static const char GDBGoodP = '+';
 static const char GDBBadP = '-';
+static const char GDBEscape = '}';
+
+// The largest packet we advertise to GDB. We can receive packets of any
+// size, this only bounds the size of the memory reads and writes GDB
+// splits its transfers in.
+static const size_t GDBPacketSize = 0x4000;
 
 class HardBreakpoint : public PCEvent
 {
@@ -456,6 +463,7 @@ void
 BaseRemoteGDB::attach(int f)
 {
     fd = f;
+    inBufferPos = inBufferLen = 0;
 
     attached = true;
     DPRINTFN("remote gdb attached\n");
@@ -631,6 +639,12 @@ BaseRemoteGDB::try_getbyte(uint8_t* c,int timeout_ms)
 {
     if (!c)
         panic("try_getbyte called with a null pointer as c");
+
+    if (inBufferPos < inBufferLen) {
+        *c = inBuffer[inBufferPos++];
+        return true;
+    }
+
     int res,retval;
     //Allow read to fail if it was interrupted by a signal (EINTR).
     errno = 0;
@@ -663,10 +677,14 @@ BaseRemoteGDB::try_getbyte(uint8_t* c,int timeout_ms)
         }while (errno == EINTR);
         if (retval == 0)
             return false;//timed out
-        //reading (retval>0)
-        res = ::read(fd, c, sizeof(*c));
-        if (res == sizeof(*c))
+        //reading (retval>0), take whatever is available at once
+        res = ::read(fd, inBuffer.data(), inBuffer.size());
+        if (res > 0) {
+            inBufferPos = 1;
+            inBufferLen = res;
+            *c = inBuffer[0];
             return true;//read successfully
+        }
         //read failed (?) retrying select
     }
 }
@@ -679,6 +697,20 @@ BaseRemoteGDB::putbyte(uint8_t b)
     throw BadClient("Couldn't write data to the debugger.");
 }
 
+void
+BaseRemoteGDB::putbytes(const char *data, size_t len)
+{
+    while (len) {
+        ssize_t res = ::write(fd, data, len);
+        if (res < 0 && errno == EINTR)
+            continue;
+        if (res <= 0)
+            throw BadClient("Couldn't write data to the debugger.");
+        data += res;
+        len -= res;
+    }
+}
+
 // Receive a packet from gdb
 void
 BaseRemoteGDB::recv(std::vector<char>& bp)
@@ -698,7 +730,7 @@ BaseRemoteGDB::recv(std::vector<char>& bp)
             c = getbyte();
             if (c == GDBEnd)
                 break;
-            c &= 0x7f;
+            // Binary packets use all 8 bits of the data.
             csum += c;
             bp.push_back(c);
         }
@@ -735,26 +767,38 @@ BaseRemoteGDB::recv(std::vector<char>& bp)
 void
 BaseRemoteGDB::send(const char *bp)
 {
-    const char *p;
+    send(bp, strlen(bp));
+}
+
+void
+BaseRemoteGDB::send(const char *bp, size_t len)
+{
     uint8_t csum, c;
 
-    DPRINTF(GDBSend, "send:  %s\n", bp);
+    DPRINTF(GDBSend, "send:  %s\n", std::string(bp, len));
     //removing GDBBadP that could be waiting in the buffer
     while (try_getbyte(&c,0));
+
+    // Frame the packet once and write it out in one go, rather than a
+    // byte at a time.
+    std::string packet;
+    packet.reserve(len + 4);
+    // Start sending a packet
+    packet += GDBStart;
+    // Send the contents, and also keep a check sum.
+    csum = 0;
+    for (size_t i = 0; i < len; i++) {
+        packet += bp[i];
+        csum += bp[i];
+    }
+    // Send the ending character.
+    packet += GDBEnd;
+    // Send the checksum.
+    packet += i2digit(csum >> 4);
+    packet += i2digit(csum);
+
     do {
-        p = bp;
-        // Start sending a packet
-        putbyte(GDBStart);
-        // Send the contents, and also keep a check sum.
-        for (csum = 0; (c = *p); p++) {
-            putbyte(c);
-            csum += c;
-        }
-        // Send the ending character.
-        putbyte(GDBEnd);
-        // Send the checksum.
-        putbyte(i2digit(csum >> 4));
-        putbyte(i2digit(csum));
+        putbytes(packet.data(), packet.size());
         // Try transmitting over and over again until the other end doesn't
         // send an error back.
         c = getbyte();
@@ -1055,7 +1099,9 @@ std::map<char, BaseRemoteGDB::GdbCommand> BaseRemoteGDB::commandMap = {
     // target exited
     { 'W', { "KGDB_TARGET_EXIT", &BaseRemoteGDB::cmdUnsupported } },
     // write memory
-    { 'X', { "KGDB_BINARY_DLOAD", &BaseRemoteGDB::cmdUnsupported } },
+    { 'X', { "KGDB_BINARY_DLOAD", &BaseRemoteGDB::cmdMemWBinary } },
+    // read memory, binary reply
+    { 'x', { "KGDB_BINARY_MEM_R", &BaseRemoteGDB::cmdMemRBinary } },
     // remove breakpoint or watchpoint
     { 'z', { "KGDB_CLR_HW_BKPT", &BaseRemoteGDB::cmdClrHwBkpt } },
     // insert breakpoint or watchpoint
@@ -1211,17 +1257,40 @@ BaseRemoteGDB::cmdMemR(GdbCommand::Context &ctx)
     if (!acc(addr, len))
         throw CmdError("E05");
 
-    char buf[len];
-    if (!read(addr, len, buf))
+    std::vector<char> buf(len);
+    if (!read(addr, len, buf.data()))
         throw CmdError("E05");
 
-    char temp[2 * len + 1];
-    temp[2 * len] = '\0';
-    mem2hex(temp, buf, len);
+    std::string temp(2 * len, '\0');
+    mem2hex(temp.data(), buf.data(), len);
     send(temp);
     return true;
 }
 
+bool
+BaseRemoteGDB::cmdMemRBinary(GdbCommand::Context &ctx)
+{
+    const char *p = ctx.data;
+    Addr addr = hex2i(&p);
+    if (*p++ != ',')
+        throw CmdError("E02");
+    size_t len = hex2i(&p);
+    if (*p != '\0')
+        throw CmdError("E03");
+    if (!acc(addr, len))
+        throw CmdError("E05");
+
+    std::string buf(len, '\0');
+    if (!read(addr, len, buf.data()))
+        throw CmdError("E05");
+
+    std::string encoded = "b";
+    encoded.reserve(len + len / 8 + 1);
+    encodeBinaryData(buf, encoded);
+    send(encoded);
+    return true;
+}
+
 bool
 BaseRemoteGDB::cmdMemW(GdbCommand::Context &ctx)
 {
@@ -1234,18 +1303,55 @@ BaseRemoteGDB::cmdMemW(GdbCommand::Context &ctx)
         throw CmdError("E07");
     if (len * 2 > ctx.len - (p - ctx.data))
         throw CmdError("E08");
-    char buf[len];
-    p = (char *)hex2mem(buf, p, len);
+    std::vector<char> buf(len);
+    p = (char *)hex2mem(buf.data(), p, len);
     if (p == NULL)
         throw CmdError("E09");
     if (!acc(addr, len))
         throw CmdError("E0A");
-    if (!write(addr, len, buf))
+    if (!write(addr, len, buf.data()))
         throw CmdError("E0B");
     send("OK");
     return true;
 }
 
+bool
+BaseRemoteGDB::cmdMemWBinary(GdbCommand::Context &ctx)
+{
+    const char *p = ctx.data;
+    const char *end = ctx.data + ctx.len;
+    Addr addr = hex2i(&p);
+    if (*p++ != ',')
+        throw CmdError("E06");
+    size_t len = hex2i(&p);
+    if (*p++ != ':')
+        throw CmdError("E07");
+
+    // GDB probes for binary download support with an empty write.
+    std::vector<char> buf;
+    buf.reserve(len);
+    while (p < end && buf.size() < len) {
+        char c = *p++;
+        if (c == GDBEscape) {
+            if (p == end)
+                throw CmdError("E08");
+            c = *p++ ^ 0x20;
+        }
+        buf.push_back(c);
+    }
+    if (buf.size() != len || p != end)
+        throw CmdError("E08");
+
+    if (len) {
+        if (!acc(addr, len))
+            throw CmdError("E0A");
+        if (!write(addr, len, buf.data()))
+            throw CmdError("E0B");
+    }
+    send("OK");
+    return true;
+}
+
 bool
 BaseRemoteGDB::cmdMultiLetter(GdbCommand::Context &ctx)
 {
@@ -1347,8 +1453,10 @@ BaseRemoteGDB::querySupported(QuerySetCommand::Context &ctx)
     std::ostringstream oss;
     // This reply field mandatory. We can receive arbitrarily
     // long packets, so we could choose it to be arbitrarily large.
-    // This is just an arbitrary filler value that seems to work.
-    oss << "PacketSize=1024";
+    // It bounds the size of the memory transfers GDB asks for.
+    oss << "PacketSize=" << std::hex << GDBPacketSize << std::dec;
+    // Memory can be read with binary 'x' packets.
+    oss << ";binary-upload+";
     for (const auto& feature : availableFeatures())
         oss << ';' << feature;
     send(oss.str());
@@ -43,6 +43,7 @@
 #define __REMOTE_GDB_HH__
 
 
+#include <array>
 #include <cstdint>
 #include <exception>
 #include <map>
@@ -236,14 +237,22 @@ class BaseRemoteGDB
     // The socket commands come in through.
     int fd;
 
+    // Data received from GDB but not consumed yet, so the socket is read
+    // in chunks rather than a byte at a time.
+    std::array<uint8_t, 4096> inBuffer;
+    size_t inBufferPos = 0;
+    size_t inBufferLen = 0;
+
     // Transfer data to/from GDB.
     uint8_t getbyte();
     bool try_getbyte(uint8_t* c,int timeout=-1);//return true if successful
     void putbyte(uint8_t b);
+    void putbytes(const char *data, size_t len);
 
     void recv(std::vector<char> &bp);
+    void send(const char *data, size_t len);
     void send(const char *data);
-    void send(const std::string &data) { send(data.c_str()); }
+    void send(const std::string &data) { send(data.data(), data.size()); }
 
     template <typename ...Args>
     void
@@ -392,6 +401,8 @@ class BaseRemoteGDB
     bool cmdIsThreadAlive(GdbCommand::Context &ctx);
     bool cmdMemR(GdbCommand::Context &ctx);
     bool cmdMemW(GdbCommand::Context &ctx);
+    bool cmdMemRBinary(GdbCommand::Context &ctx);
+    bool cmdMemWBinary(GdbCommand::Context &ctx);
     bool cmdQueryVar(GdbCommand::Context &ctx);
     bool cmdStep(GdbCommand::Context &ctx);
     bool cmdAsyncStep(GdbCommand::Context &ctx);
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Saturating counters make up the tables of the branch predictors and
+ * of several prefetchers and replacement policies. The benchmark trains
+ * a table of 2-bit counters, as a bimodal predictor does, with a branch
+ * history that is mostly taken.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "base/sat_counter.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+void
+BM_SatCounterTrain(benchmark::State &state)
+{
+    std::vector<SatCounter8> table(state.range(0), SatCounter8(2, 1));
+
+    std::mt19937 rng(0);
+    std::vector<unsigned> indices(4096);
+    std::vector<bool> taken(indices.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        indices[i] = rng() % table.size();
+        taken[i] = rng() % 4 != 0;
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        SatCounter8 &counter = table[indices[i]];
+        benchmark::DoNotOptimize(counter > 1);
+        if (taken[i])
+            counter++;
+        else
+            counter--;
+        i = (i + 1) % indices.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SatCounterTrain)->Arg(2048)->Arg(65536);
+
+} // anonymous namespace
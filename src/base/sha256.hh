@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SHA256_HH__
+#define __BASE_SHA256_HH__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gem5
+{
+
+/**
+ * SHA-256 digest (FIPS 180-4) of a block of memory. Use it where two
+ * blocks must be told apart from their digests alone, with no chance to
+ * compare the data itself, so that a collision can't go unnoticed.
+ */
+class Sha256
+{
+  public:
+    using Digest = std::array<uint8_t, 32>;
+
+    Sha256();
+
+    /** Add data to the message. */
+    void update(const void *data, size_t len);
+
+    /** Finish the message and return its digest. */
+    Digest finish();
+
+    /** Digest of a whole message. */
+    static Digest
+    digest(const void *data, size_t len)
+    {
+        Sha256 sha;
+        sha.update(data, len);
+        return sha.finish();
+    }
+
+  private:
+    void compress(const uint8_t *block);
+
+    std::array<uint32_t, 8> state;
+    std::array<uint8_t, 64> buffer;
+    size_t buffered;
+    uint64_t length;
+};
+
+} // namespace gem5
+
+#endif // __BASE_SHA256_HH__
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include "base/sha256.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+std::string
+hex(const Sha256::Digest &digest)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string str;
+    for (uint8_t byte : digest) {
+        str += digits[byte >> 4];
+        str += digits[byte & 0xf];
+    }
+    return str;
+}
+
+} // anonymous namespace
+
+/** Test vectors from FIPS 180-4 and NIST */
+TEST(Sha256Test, Vectors)
+{
+    EXPECT_EQ(hex(Sha256::digest("", 0)),
+        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(hex(Sha256::digest("abc", 3)),
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    const std::string two_blocks =
+        "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    EXPECT_EQ(hex(Sha256::digest(two_blocks.data(), two_blocks.size())),
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    const std::string million(1000000, 'a');
+    EXPECT_EQ(hex(Sha256::digest(million.data(), million.size())),
+        "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+/** Adding a message in pieces gives the same digest as all at once */
+TEST(Sha256Test, Incremental)
+{
+    std::string msg;
+    for (int i = 0; i < 1000; ++i)
+        msg += char(i * 7);
+
+    for (size_t piece : { 1, 3, 63, 64, 65, 200 }) {
+        Sha256 sha;
+        for (size_t pos = 0; pos < msg.size(); pos += piece)
+            sha.update(msg.data() + pos, std::min(piece, msg.size() - pos));
+        EXPECT_EQ(sha.finish(), Sha256::digest(msg.data(), msg.size()));
+    }
+}
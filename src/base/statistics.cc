@@ -43,6 +43,7 @@
 #include <cassert>
 #include <list>
 #include <map>
+#include <regex>
 #include <string>
 #include <utility>
 
@@ -325,6 +326,97 @@ resolve(const std::string &name)
     }
 }
 
+void
+enableGroup(Group &root)
+{
+    for (auto *info : root.getStats()) {
+        if (!info->check() || !info->baseCheck()) {
+            fatal("statistic '%s' (%d) was not properly initialized "
+                  "by a regStats() function\n", info->name, info->id);
+        }
+
+        if (!(info->flags & display))
+            info->name = csprintf("__Stat%06d", info->id);
+
+        info->enable();
+    }
+
+    for (auto &group : root.getStatGroups())
+        enableGroup(*group.second);
+}
+
+void
+prepareGroup(Group &root)
+{
+    for (auto *info : root.getStats())
+        info->prepare();
+
+    for (auto &group : root.getStatGroups())
+        prepareGroup(*group.second);
+}
+
+void
+dumpGroup(Output &output, const Group &root)
+{
+    for (auto *info : root.getStats())
+        info->visit(output);
+
+    for (auto &group : root.getStatGroups()) {
+        output.beginGroup(group.first.c_str());
+        dumpGroup(output, *group.second);
+        output.endGroup();
+    }
+}
+
+namespace
+{
+
+size_t
+filterStats(Group &group, const std::string &prefix,
+            const std::vector<std::regex> &patterns)
+{
+    size_t disabled = 0;
+    for (auto *info : group.getStats()) {
+        const std::string path = prefix + info->name;
+        bool keep = false;
+        for (const auto &re : patterns) {
+            if (std::regex_match(path, re)) {
+                keep = true;
+                break;
+            }
+        }
+        if (!keep) {
+            info->disable();
+            disabled++;
+        }
+    }
+
+    for (auto &sub : group.getStatGroups())
+        disabled += filterStats(*sub.second, prefix + sub.first + ".",
+                                patterns);
+
+    return disabled;
+}
+
+} // anonymous namespace
+
+size_t
+filterGroup(Group &root, const std::vector<std::string> &patterns)
+{
+    fatal_if(_enabled, "Stats can't be filtered once they are enabled");
+
+    std::vector<std::regex> regexes;
+    for (const auto &pattern : patterns) {
+        try {
+            regexes.emplace_back(pattern, std::regex::optimize);
+        } catch (const std::regex_error &e) {
+            fatal("Invalid stat filter '%s': %s", pattern, e.what());
+        }
+    }
+
+    return filterStats(root, "", regexes);
+}
+
 void
 registerDumpCallback(const std::function<void()> &callback)
 {
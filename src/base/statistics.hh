@@ -107,6 +107,12 @@ class InfoProxy : public Base
     void prepare() { s.prepare(); }
     void reset() { s.reset(); }
     void
+    disable() override
+    {
+        Base::disable();
+        s.disable();
+    }
+    void
     visit(Output &visitor)
     {
         visitor.visit(*static_cast<Base *>(this));
@@ -279,6 +285,13 @@ class DataWrap : public InfoAccess
             warn_once("One of the stats is a legacy stat. " + common_message);
     }
 
+    /**
+     * Stop collecting data, called when the stat is filtered out. Most
+     * stats are cheap enough to keep updating, so this does nothing by
+     * default.
+     */
+    void disable() {}
+
     /**
      * Set the name and marks this stat to print at the end of simulation.
      * @param name The new name.
@@ -1280,6 +1293,8 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
   protected:
     /** The storage for this stat. */
     GEM5_ALIGNED(8) char storage[sizeof(Storage)];
+    /** False if the stat was filtered out and its storage released. */
+    bool active = true;
 
   protected:
     /**
@@ -1324,22 +1339,29 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
      * @param n The number of times to add it, defaults to 1.
      */
     template <typename U>
-    void sample(const U &v, int n = 1) { data()->sample(v, n); }
+    void
+    sample(const U &v, int n = 1)
+    {
+        if (GEM5_LIKELY(active))
+            data()->sample(v, n);
+    }
 
     /**
      * Return the number of entries in this stat.
      * @return The number of entries.
      */
-    size_type size() const { return data()->size(); }
+    size_type size() const { return active ? data()->size() : 0; }
     /**
      * Return true if no samples have been added.
      * @return True if there haven't been any samples.
      */
-    bool zero() const { return data()->zero(); }
+    bool zero() const { return !active || data()->zero(); }
 
     void
     prepare()
     {
+        if (!active)
+            return;
         Info *info = this->info();
         data()->prepare(info->getStorageParams(), info->data);
     }
@@ -1350,13 +1372,30 @@ class DistBase : public DataWrap<Derived, DistInfoProxy>
     void
     reset()
     {
-        data()->reset(this->info()->getStorageParams());
+        if (active)
+            data()->reset(this->info()->getStorageParams());
+    }
+
+    /**
+     * Release the storage and ignore all the following samples.
+     */
+    void
+    disable()
+    {
+        if (active && this->check())
+            data()->~Storage();
+        active = false;
     }
 
     /**
      *  Add the argument distribution to the this distribution.
      */
-    void add(DistBase &d) { data()->add(d.data()); }
+    void
+    add(DistBase &d)
+    {
+        if (active && d.active)
+            data()->add(d.data());
+    }
 };
 
 template <class Stat>
@@ -1375,6 +1414,8 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
 
   protected:
     std::vector<Storage*> storage;
+    /** False if the stat was filtered out and its storage released. */
+    bool active = true;
 
   protected:
     Storage *
@@ -1432,6 +1473,8 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
     bool
     zero() const
     {
+        if (!active)
+            return true;
         for (off_type i = 0; i < size(); ++i)
             if (!data(i)->zero())
                 return false;
@@ -1441,6 +1484,8 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
     void
     prepare()
     {
+        if (!active)
+            return;
         Info *info = this->info();
         size_type size = this->size();
         info->data.resize(size);
@@ -1448,11 +1493,32 @@ class VectorDistBase : public DataWrapVec<Derived, VectorDistInfoProxy>
             data(i)->prepare(info->getStorageParams(), info->data[i]);
     }
 
+    void
+    reset()
+    {
+        if (active)
+            DataWrapVec<Derived, VectorDistInfoProxy>::reset();
+    }
+
     bool
     check() const
     {
         return size() > 0;
     }
+
+    /**
+     * Release the storage and ignore all the following samples. The
+     * size of the vector is kept.
+     */
+    void
+    disable()
+    {
+        for (auto &stor : storage) {
+            delete stor;
+            stor = nullptr;
+        }
+        active = false;
+    }
 };
 
 template <class Stat>
@@ -1488,7 +1554,8 @@ class DistProxy
     void
     sample(const U &v, int n = 1)
     {
-        data()->sample(v, n);
+        if (GEM5_LIKELY(stat.active))
+            data()->sample(v, n);
     }
 
     size_type
@@ -1500,7 +1567,7 @@ class DistProxy
     bool
     zero() const
     {
-        return data()->zero();
+        return !stat.active || data()->zero();
     }
 
     /**
@@ -1950,6 +2017,37 @@ class Scalar : public ScalarBase<Scalar, StatStor>
     }
 };
 
+/**
+ * A scalar counter that can be updated concurrently by the threads of
+ * several event queues. Each thread accumulates into its own slot and
+ * the slots are merged when the stat is read.
+ * @sa Stat, ScalarBase, ThreadStatStor
+ */
+class SharedScalar : public ScalarBase<SharedScalar, ThreadStatStor>
+{
+  public:
+    using ScalarBase<SharedScalar, ThreadStatStor>::operator=;
+
+    SharedScalar(Group *parent = nullptr)
+        : ScalarBase<SharedScalar, ThreadStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    SharedScalar(Group *parent, const char *name,
+                 const char *desc = nullptr)
+        : ScalarBase<SharedScalar, ThreadStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    SharedScalar(Group *parent, const char *name, const units::Base *unit,
+                 const char *desc = nullptr)
+        : ScalarBase<SharedScalar, ThreadStatStor>(parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A stat that calculates the per tick average of a value.
  * @sa Stat, ScalarBase, AvgStor
@@ -2024,6 +2122,34 @@ class Vector : public VectorBase<Vector, StatStor>
     }
 };
 
+/**
+ * A vector of counters that can be updated concurrently by the threads
+ * of several event queues.
+ * @sa Stat, VectorBase, ThreadStatStor
+ */
+class SharedVector : public VectorBase<SharedVector, ThreadStatStor>
+{
+  public:
+    SharedVector(Group *parent = nullptr)
+        : VectorBase<SharedVector, ThreadStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    SharedVector(Group *parent, const char *name,
+                 const char *desc = nullptr)
+        : VectorBase<SharedVector, ThreadStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    SharedVector(Group *parent, const char *name, const units::Base *unit,
+                 const char *desc = nullptr)
+        : VectorBase<SharedVector, ThreadStatStor>(parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A vector of Average stats.
  * @sa Stat, VectorBase, AvgStor
@@ -2699,6 +2825,14 @@ class Temp
         : node(new ScalarStatNode(s.info()))
     { }
 
+    /**
+     * Create a new ScalarStatNode.
+     * @param s The ScalarStat to place in a node.
+     */
+    Temp(const SharedScalar &s)
+        : node(new ScalarStatNode(s.info()))
+    { }
+
     /**
      * Create a new VectorStatNode.
      * @param s The VectorStat to place in a node.
@@ -2711,6 +2845,10 @@ class Temp
         : node(new VectorStatNode(s.info()))
     { }
 
+    Temp(const SharedVector &s)
+        : node(new VectorStatNode(s.info()))
+    { }
+
     /**
      *
      */
@@ -2886,6 +3024,48 @@ void enable();
 bool enabled();
 const Info* resolve(const std::string &name);
 
+/**
+ * Check and enable all the stats of a group hierarchy. Stats that are
+ * not displayed are renamed to an anonymous name based on their id.
+ * This is the C++ equivalent of walking the hierarchy from Python and
+ * avoids creating a Python wrapper for every stat.
+ *
+ * @param root Root of the hierarchy.
+ */
+void enableGroup(Group &root);
+
+/**
+ * Prepare all the stats of a group hierarchy for data access.
+ *
+ * @param root Root of the hierarchy.
+ */
+void prepareGroup(Group &root);
+
+/**
+ * Visit all the stats of a group hierarchy with an output, calling
+ * beginGroup()/endGroup() around every sub-group. The output is
+ * neither begun nor ended.
+ *
+ * @param output Output the stats are dumped to.
+ * @param root Root of the hierarchy.
+ */
+void dumpGroup(Output &output, const Group &root);
+
+/**
+ * Disable all the stats of a group hierarchy whose path does not match
+ * any of the given regular expressions. The path of a stat is made of
+ * the names of its groups and of its own name, separated by dots.
+ * Disabled stats are not displayed and distributions release their
+ * storage and ignore samples. This must be done after regStats() and
+ * before the stats are enabled.
+ *
+ * @param root Root of the hierarchy.
+ * @param patterns ECMAScript regular expressions matched against the
+ * whole path of the stats to keep.
+ * @return Number of disabled stats.
+ */
+size_t filterGroup(Group &root, const std::vector<std::string> &patterns);
+
 /**
  * Register reset and dump handlers.  These are the functions which
  * will actually perform the whole statistics reset/dump actions
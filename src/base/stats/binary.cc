@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2019-2020 Arm Limited
+ * All rights reserved.
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2004-2005 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <ostream>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "base/stats/units.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+template <typename T>
+void
+put(std::string &buf, const T &value)
+{
+    buf.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void
+putString(std::string &buf, const std::string &str)
+{
+    put<uint32_t>(buf, str.size());
+    buf.append(str);
+}
+
+void
+putStrings(std::string &buf, const std::vector<std::string> &strs,
+           size_type size)
+{
+    put<uint32_t>(buf, size);
+    for (size_type i = 0; i < size; ++i)
+        putString(buf, i < strs.size() ? strs[i] : std::string());
+}
+
+} // anonymous namespace
+
+Binary::Binary(std::ostream &_stream)
+    : file(nullptr), stream(&_stream)
+{
+    writeHeader();
+}
+
+Binary::Binary(const std::string &filename)
+    : file(simout.create(filename, true)), stream(file->stream())
+{
+    writeHeader();
+}
+
+Binary::~Binary()
+{
+    if (file)
+        simout.close(file);
+}
+
+bool
+Binary::valid() const
+{
+    return stream->good();
+}
+
+void
+Binary::writeHeader()
+{
+    stream->write(magic, sizeof(magic));
+    stream->write(reinterpret_cast<const char *>(&version), sizeof(version));
+    if (!valid())
+        fatal("Unable to open statistics output for writing\n");
+}
+
+void
+Binary::begin()
+{
+    entries.clear();
+    values.clear();
+    paths.assign(1, std::string());
+    pathStack = std::stack<unsigned>();
+    pathStack.push(0);
+}
+
+void
+Binary::end()
+{
+    assert(pathStack.size() == 1);
+
+    if (entries != lastEntries || paths != lastPaths) {
+        writeSchema();
+        lastEntries.swap(entries);
+        lastPaths.swap(paths);
+    }
+
+    writeRecord(DataRecord, values.data(), values.size() * sizeof(double));
+    stream->flush();
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    const std::string &parent = paths[pathStack.top()];
+    pathStack.push(paths.size());
+    paths.push_back(parent.empty() ? name : parent + "." + name);
+}
+
+void
+Binary::endGroup()
+{
+    assert(pathStack.size() > 1);
+    pathStack.pop();
+}
+
+bool
+Binary::add(const Info &info, Kind kind)
+{
+    // Stats that are not displayed don't have a proper name
+    if (!info.flags.isSet(display))
+        return false;
+
+    entries.push_back({ &info, kind, pathStack.top() });
+    return true;
+}
+
+void
+Binary::appendDist(const DistData &data)
+{
+    values.insert(values.end(), {
+        (double)data.type, data.min, data.max, data.bucket_size,
+        data.min_val, data.max_val, data.underflow, data.overflow,
+        data.sum, data.squares, data.logs, data.samples });
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (add(info, ScalarKind))
+        values.push_back(info.result());
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (add(info, VectorKind)) {
+        const VResult &vec = info.result();
+        values.insert(values.end(), vec.begin(), vec.end());
+        values.push_back(info.total());
+    }
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    if (add(info, FormulaKind)) {
+        const VResult &vec = info.result();
+        values.insert(values.end(), vec.begin(), vec.end());
+        values.push_back(info.total());
+    }
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (add(info, Vector2dKind)) {
+        values.insert(values.end(), info.cvec.begin(), info.cvec.end());
+        values.push_back(info.total());
+    }
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (add(info, DistKind))
+        appendDist(info.data);
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (add(info, VectorDistKind)) {
+        for (const auto &data : info.data)
+            appendDist(data);
+    }
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    if (add(info, SparseHistKind)) {
+        values.push_back(info.data.samples);
+        values.push_back(info.data.cmap.size());
+        for (const auto &[value, count] : info.data.cmap) {
+            values.push_back(value);
+            values.push_back(count);
+        }
+    }
+}
+
+void
+Binary::writeSchema()
+{
+    std::string buf;
+    put<uint32_t>(buf, entries.size());
+    for (const auto &entry : entries) {
+        const Info &info = *entry.info;
+        const std::string &path = paths[entry.path];
+
+        put<uint8_t>(buf, entry.kind);
+        putString(buf, path.empty() ? info.name : path + "." + info.name);
+        putString(buf, info.desc);
+        putString(buf, info.unit->getUnitString());
+        put<uint32_t>(buf, info.flags);
+        put<int32_t>(buf, info.precision);
+
+        switch (entry.kind) {
+          case VectorKind:
+          case FormulaKind: {
+            auto &vinfo = static_cast<const VectorInfo &>(info);
+            putStrings(buf, vinfo.subnames, vinfo.size());
+            break;
+          }
+          case Vector2dKind: {
+            auto &vinfo = static_cast<const Vector2dInfo &>(info);
+            put<uint32_t>(buf, vinfo.x);
+            put<uint32_t>(buf, vinfo.y);
+            putStrings(buf, vinfo.subnames, vinfo.x);
+            putStrings(buf, vinfo.y_subnames, vinfo.y);
+            break;
+          }
+          case DistKind: {
+            auto &dinfo = static_cast<const DistInfo &>(info);
+            put<uint32_t>(buf, dinfo.data.cvec.size());
+            break;
+          }
+          case VectorDistKind: {
+            auto &dinfo = static_cast<const VectorDistInfo &>(info);
+            put<uint32_t>(buf, dinfo.data.size());
+            put<uint32_t>(buf,
+                dinfo.data.empty() ? 0 : dinfo.data[0].cvec.size());
+            putStrings(buf, dinfo.subnames, dinfo.data.size());
+            break;
+          }
+          case ScalarKind:
+          case SparseHistKind:
+            break;
+        }
+    }
+
+    writeRecord(SchemaRecord, buf.data(), buf.size());
+}
+
+void
+Binary::writeRecord(RecordType type, const void *payload, uint64_t size)
+{
+    stream->write(reinterpret_cast<const char *>(&type), sizeof(type));
+    stream->write(reinterpret_cast<const char *>(&size), sizeof(size));
+    stream->write(static_cast<const char *>(payload), size);
+}
+
+std::unique_ptr<Output>
+initBinary(const std::string &filename)
+{
+    return std::make_unique<Binary>(filename);
+}
+
+} // namespace statistics
+} // namespace gem5
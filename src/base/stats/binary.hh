@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2019-2020 Arm Limited
+ * All rights reserved.
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2004-2005 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * Compact binary statistics output.
+ *
+ * The file starts with a magic string and a format version, and is
+ * followed by a sequence of records. A schema record describes the
+ * names, types and shapes of all statistics, and is only written when
+ * the set of dumped statistics changes, normally just before the first
+ * dump. Every dump then emits a single data record containing the raw
+ * values of all statistics in schema order, so a dump costs little more
+ * than copying the values.
+ *
+ * All integers and doubles are stored in host byte order. Strings are
+ * stored as a 32-bit length followed by their characters. A record is a
+ * 32-bit record type, followed by the 64-bit size of its payload.
+ *
+ * The schema payload holds the number of statistics, followed for each
+ * of them by its kind, full name, description, unit, flags, precision
+ * and shape:
+ *  - Scalar: nothing, one value.
+ *  - Vector and Formula: subnames, size + 1 values (the last being the
+ *    total).
+ *  - Vector2d: x, y, subnames and y subnames, x * y + 1 values.
+ *  - Dist: number of buckets b, distFields + b values.
+ *  - VectorDist: size n, b and subnames, n * (distFields + b) values.
+ *  - SparseHist: nothing, a variable number of values starting with the
+ *    number of samples and the number of (value, count) pairs.
+ *
+ * util/stats_binary_to_text.py converts these files to text.
+ */
+class Binary : public Output
+{
+  public:
+    enum RecordType : uint32_t
+    {
+        SchemaRecord = 1,
+        DataRecord = 2,
+    };
+
+    enum Kind : uint8_t
+    {
+        ScalarKind = 0,
+        VectorKind = 1,
+        FormulaKind = 2,
+        Vector2dKind = 3,
+        DistKind = 4,
+        VectorDistKind = 5,
+        SparseHistKind = 6,
+    };
+
+    static constexpr char magic[8] = { 'g', 'e', 'm', '5', 's', 't', 'b',
+                                       '\0' };
+    static constexpr uint32_t version = 1;
+
+    /**
+     * Number of values of every distribution before its buckets: type,
+     * min, max, bucket size, minimum and maximum sampled values,
+     * underflow, overflow, sum, sum of squares, sum of logarithms and
+     * number of samples.
+     */
+    static constexpr unsigned distFields = 12;
+
+    Binary(std::ostream &stream);
+    Binary(const std::string &filename);
+    ~Binary();
+
+    Binary() = delete;
+    Binary(const Binary &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** A statistic visited during a dump, in visiting order. */
+    struct Entry
+    {
+        const Info *info;
+        Kind kind;
+        /** Index of the group path of the statistic in paths. */
+        unsigned path;
+
+        bool
+        operator==(const Entry &other) const
+        {
+            return info == other.info && kind == other.kind &&
+                path == other.path;
+        }
+    };
+
+    /** Record a visited statistic, false if it shouldn't be dumped. */
+    bool add(const Info &info, Kind kind);
+
+    void appendDist(const DistData &data);
+
+    void writeHeader();
+    void writeSchema();
+    void writeRecord(RecordType type, const void *payload, uint64_t size);
+
+    /** Output file, if opened by this object. */
+    OutputStream *file;
+    std::ostream *stream;
+
+    /** Group paths of the current dump, the first one being the root. */
+    std::vector<std::string> paths;
+    /** Indices of the paths of the currently open groups. */
+    std::stack<unsigned> pathStack;
+
+    /** Layout of the current and of the last dump. */
+    std::vector<Entry> entries;
+    std::vector<Entry> lastEntries;
+    std::vector<std::string> lastPaths;
+
+    /** Values of the current dump. */
+    std::vector<double> values;
+};
+
+std::unique_ptr<Output> initBinary(const std::string &filename);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "base/stats/binary.hh"
+#include "base/stats/info.hh"
+#include "base/stats/units.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Sequential reader of the binary stats format. */
+class Reader
+{
+  public:
+    Reader(const std::string &_buf) : buf(_buf), pos(0) {}
+
+    template <typename T>
+    T
+    get()
+    {
+        T value;
+        EXPECT_LE(pos + sizeof(T), buf.size());
+        std::memcpy(&value, buf.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string
+    getString()
+    {
+        const auto size = get<uint32_t>();
+        std::string str = buf.substr(pos, size);
+        pos += size;
+        return str;
+    }
+
+    /** Read a record header, and return its type. */
+    uint32_t
+    record(uint64_t &size)
+    {
+        const auto type = get<uint32_t>();
+        size = get<uint64_t>();
+        return type;
+    }
+
+    void skip(uint64_t size) { pos += size; }
+    bool done() const { return pos == buf.size(); }
+
+  private:
+    const std::string &buf;
+    size_t pos;
+};
+
+struct TestScalar : public statistics::ScalarInfo
+{
+    double v = 0;
+
+    TestScalar(const char *_name, const char *_desc)
+    {
+        name = _name;
+        desc = _desc;
+        unit = statistics::units::Count::get();
+        flags.set(statistics::display);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { v = 0; }
+    bool zero() const override { return v == 0; }
+    void visit(statistics::Output &out) override { out.visit(*this); }
+    statistics::Counter value() const override { return v; }
+    statistics::Result result() const override { return v; }
+    statistics::Result total() const override { return v; }
+};
+
+struct TestVector : public statistics::VectorInfo
+{
+    statistics::VCounter v;
+
+    TestVector(const char *_name, const char *_desc, size_t size)
+        : v(size, 0)
+    {
+        name = _name;
+        desc = _desc;
+        unit = statistics::units::Count::get();
+        flags.set(statistics::display);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &out) override { out.visit(*this); }
+    statistics::size_type size() const override { return v.size(); }
+    const statistics::VCounter &value() const override { return v; }
+    const statistics::VResult &result() const override { return v; }
+
+    statistics::Result
+    total() const override
+    {
+        statistics::Result sum = 0;
+        for (auto x : v)
+            sum += x;
+        return sum;
+    }
+};
+
+struct TestStats
+{
+    TestScalar scalar{"scalar", "A scalar"};
+    TestVector vector{"vector", "A vector", 3};
+
+    TestStats() { vector.subnames = { "", "one" }; }
+
+    void
+    dump(statistics::Output &out, bool with_vector=true)
+    {
+        out.begin();
+        out.beginGroup("system");
+        scalar.visit(out);
+        if (with_vector)
+            vector.visit(out);
+        out.endGroup();
+        out.end();
+    }
+};
+
+} // anonymous namespace
+
+/** Check the schema and the values of consecutive dumps */
+TEST(StatsBinaryTest, Dump)
+{
+    std::ostringstream os;
+    TestStats stats;
+    statistics::Binary out(os);
+
+    stats.scalar.v = 7;
+    stats.vector.v = { 1, 0, 2 };
+    stats.dump(out);
+    stats.scalar.v = 8;
+    stats.dump(out);
+
+    const std::string buf = os.str();
+    Reader reader(buf);
+    for (char c : statistics::Binary::magic)
+        EXPECT_EQ(reader.get<char>(), c);
+    EXPECT_EQ(reader.get<uint32_t>(), statistics::Binary::version);
+
+    uint64_t size;
+    ASSERT_EQ(reader.record(size), statistics::Binary::SchemaRecord);
+    EXPECT_EQ(reader.get<uint32_t>(), 2);
+
+    EXPECT_EQ(reader.get<uint8_t>(), statistics::Binary::ScalarKind);
+    EXPECT_EQ(reader.getString(), "system.scalar");
+    EXPECT_EQ(reader.getString(), "A scalar");
+    EXPECT_EQ(reader.getString(), "Count");
+    reader.get<uint32_t>();
+    reader.get<int32_t>();
+
+    EXPECT_EQ(reader.get<uint8_t>(), statistics::Binary::VectorKind);
+    EXPECT_EQ(reader.getString(), "system.vector");
+    EXPECT_EQ(reader.getString(), "A vector");
+    EXPECT_EQ(reader.getString(), "Count");
+    reader.get<uint32_t>();
+    reader.get<int32_t>();
+    EXPECT_EQ(reader.get<uint32_t>(), 3);
+    EXPECT_EQ(reader.getString(), "");
+    EXPECT_EQ(reader.getString(), "one");
+    EXPECT_EQ(reader.getString(), "");
+
+    // The schema is only written once
+    for (double scalar : { 7, 8 }) {
+        ASSERT_EQ(reader.record(size), statistics::Binary::DataRecord);
+        ASSERT_EQ(size, 5 * sizeof(double));
+        EXPECT_EQ(reader.get<double>(), scalar);
+        EXPECT_EQ(reader.get<double>(), 1);
+        EXPECT_EQ(reader.get<double>(), 0);
+        EXPECT_EQ(reader.get<double>(), 2);
+        EXPECT_EQ(reader.get<double>(), 3);
+    }
+    EXPECT_TRUE(reader.done());
+}
+
+/** A new schema is written when the dumped stats change */
+TEST(StatsBinaryTest, SchemaChange)
+{
+    std::ostringstream os;
+    TestStats stats;
+    statistics::Binary out(os);
+
+    stats.dump(out);
+    stats.dump(out, false);
+    stats.dump(out, false);
+
+    const std::string buf = os.str();
+    Reader reader(buf);
+    reader.skip(sizeof(statistics::Binary::magic) + sizeof(uint32_t));
+
+    std::vector<uint32_t> types;
+    uint64_t size;
+    while (!reader.done()) {
+        types.push_back(reader.record(size));
+        reader.skip(size);
+    }
+    EXPECT_EQ(types, std::vector<uint32_t>({
+        statistics::Binary::SchemaRecord, statistics::Binary::DataRecord,
+        statistics::Binary::SchemaRecord, statistics::Binary::DataRecord,
+        statistics::Binary::DataRecord }));
+}
@@ -140,6 +140,12 @@ class Info
      */
     virtual void enable();
 
+    /**
+     * Filter the stat out: it is not displayed and stats that support it
+     * stop collecting data and release their storage.
+     */
+    virtual void disable();
+
     /**
      * Prepare the stat for dumping.
      */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Updating the storage of the statistics, which happens on the hot
+ * path of every model. Scalars are incremented once per event, while
+ * distributions and histograms sample latencies of a few hundred
+ * cycles with a long tail.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/storage.hh"
+
+using namespace gem5;
+
+// Instantiate the fake class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+std::vector<statistics::Counter>
+makeLatencies()
+{
+    std::mt19937_64 rng(0);
+    std::lognormal_distribution<double> latency(4.0, 1.0);
+    std::vector<statistics::Counter> values(4096);
+    for (auto &value : values)
+        value = latency(rng);
+    return values;
+}
+
+void
+BM_StatStorInc(benchmark::State &state)
+{
+    statistics::StatStor stor(nullptr);
+    for (auto _ : state)
+        stor.inc(1);
+    benchmark::DoNotOptimize(stor.value());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StatStorInc);
+
+void
+BM_AvgStorInc(benchmark::State &state)
+{
+    statistics::AvgStor stor(nullptr);
+    Tick tick = 0;
+    for (auto _ : state) {
+        tickHandler.setCurTick(tick += 500);
+        stor.inc(1);
+    }
+    benchmark::DoNotOptimize(stor.value());
+    state.SetItemsProcessed(state.iterations());
+    tickHandler.setCurTick(0);
+}
+BENCHMARK(BM_AvgStorInc);
+
+void
+BM_DistStorSample(benchmark::State &state)
+{
+    statistics::DistStor::Params params(0, 1023, 16);
+    statistics::DistStor stor(&params);
+    const auto values = makeLatencies();
+    size_t i = 0;
+    for (auto _ : state) {
+        stor.sample(values[i], 1);
+        i = (i + 1) % values.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DistStorSample);
+
+void
+BM_HistStorSample(benchmark::State &state)
+{
+    statistics::HistStor::Params params(state.range(0));
+    statistics::HistStor stor(&params);
+    const auto values = makeLatencies();
+    size_t i = 0;
+    for (auto _ : state) {
+        stor.sample(values[i], 1);
+        i = (i + 1) % values.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HistStorSample)->Arg(10)->Arg(100);
+
+} // anonymous namespace
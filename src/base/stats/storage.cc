@@ -49,6 +49,37 @@ namespace gem5
 namespace statistics
 {
 
+thread_local unsigned _threadSlot = 0;
+
+namespace
+{
+
+unsigned _threadSlots = 1;
+
+} // anonymous namespace
+
+void
+setThreadSlot(unsigned slot)
+{
+    panic_if(slot >= _threadSlots,
+             "Thread stat slot %d out of range, only %d slots available",
+             slot, _threadSlots);
+    _threadSlot = slot;
+}
+
+void
+setThreadSlots(unsigned slots)
+{
+    panic_if(slots == 0, "Stats need at least one thread slot");
+    _threadSlots = slots;
+}
+
+unsigned
+threadSlots()
+{
+    return _threadSlots;
+}
+
 void
 DistStor::sample(Counter val, int number)
 {
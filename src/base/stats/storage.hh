@@ -32,6 +32,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <memory>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
@@ -116,6 +117,134 @@ class StatStor
     bool zero() const { return data == Counter(); }
 };
 
+/** Slot of the calling thread in the per-thread stat storages. */
+extern thread_local unsigned _threadSlot;
+
+/**
+ * Set the slot the calling thread uses in the per-thread stat storages.
+ * Each thread that updates shared stats concurrently with other threads
+ * must use its own slot.
+ *
+ * @param slot Slot of the calling thread, smaller than threadSlots().
+ */
+void setThreadSlot(unsigned slot);
+
+/** @return The slot of the calling thread. */
+inline unsigned threadSlot() { return _threadSlot; }
+
+/**
+ * Set the number of slots of the per-thread stat storages. Only the
+ * storages created afterwards are affected, so this must be done
+ * before the stats are constructed.
+ *
+ * @param slots Number of threads that can update a shared stat.
+ */
+void setThreadSlots(unsigned slots);
+
+/** @return The number of slots of the per-thread stat storages. */
+unsigned threadSlots();
+
+/**
+ * Storage of a counter that is updated by several threads without any
+ * synchronisation. Every thread accumulates into its own cache line
+ * sized slot, and the slots are merged when the value is read. Reads
+ * are therefore only exact when no other thread is updating the stat,
+ * which is the case when stats are dumped or reset.
+ */
+class ThreadStatStor
+{
+  private:
+    struct alignas(64) Slot
+    {
+        Counter data = Counter();
+    };
+
+    /** Number of slots. */
+    unsigned numSlots;
+    /** One accumulator per thread. */
+    std::unique_ptr<Slot[]> slots;
+
+    /** @return The accumulator of the calling thread. */
+    Counter &
+    local()
+    {
+        const unsigned slot = threadSlot();
+        assert(slot < numSlots);
+        return slots[slot].data;
+    }
+
+  public:
+    struct Params : public StorageParams {};
+
+    ThreadStatStor(const StorageParams* const storage_params)
+        : numSlots(threadSlots()), slots(new Slot[numSlots])
+    { }
+
+    /**
+     * Set the stat to the given value. This discards the values of all
+     * the other threads and must therefore not race with them.
+     * @param val The new value.
+     */
+    void
+    set(Counter val)
+    {
+        for (unsigned i = 0; i < numSlots; i++)
+            slots[i].data = Counter();
+        local() = val;
+    }
+
+    /**
+     * Increment the stat by the given value.
+     * @param val The new value.
+     */
+    void inc(Counter val) { local() += val; }
+
+    /**
+     * Decrement the stat by the given value.
+     * @param val The new value.
+     */
+    void dec(Counter val) { local() -= val; }
+
+    /**
+     * Return the sum of the values of all the threads.
+     * @return The value of this stat.
+     */
+    Counter
+    value() const
+    {
+        Counter total = Counter();
+        for (unsigned i = 0; i < numSlots; i++)
+            total += slots[i].data;
+        return total;
+    }
+
+    /**
+     * Return the value of this stat as a result type.
+     * @return The value of this stat.
+     */
+    Result result() const { return (Result)value(); }
+
+    /**
+     * Prepare stat data for dumping or serialization
+     */
+    void prepare(const StorageParams* const storage_params) { }
+
+    /**
+     * Reset stat value to default
+     */
+    void
+    reset(const StorageParams* const storage_params)
+    {
+        for (unsigned i = 0; i < numSlots; i++)
+            slots[i].data = Counter();
+    }
+
+    /**
+     * @return true if zero value
+     */
+    bool zero() const { return value() == Counter(); }
+};
+
 /**
  * Templatized storage and interface to a per-tick average stat. This keeps
  * a current count and updates a total (count * ticks) when this count
@@ -30,6 +30,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <thread>
+#include <vector>
 
 #include "base/gtest/cur_tick_fake.hh"
 #include "base/gtest/logging.hh"
@@ -129,6 +131,58 @@ TEST(StatsStatStorTest, ZeroReset)
     ASSERT_FALSE(stor.zero());
 }
 
+/**
+ * Test that the per-thread storage merges the values accumulated by
+ * several threads.
+ */
+TEST(StatsThreadStatStorTest, MergeThreads)
+{
+    const unsigned num_threads = 4;
+    statistics::setThreadSlots(num_threads);
+    statistics::ThreadStatStor stor(nullptr);
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; t++) {
+        threads.emplace_back([&stor, t]() {
+            statistics::setThreadSlot(t);
+            for (int i = 0; i < 1000; i++)
+                stor.inc(t + 1);
+            stor.dec(1);
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+    statistics::setThreadSlots(1);
+
+    ASSERT_EQ(stor.value(), 1000 * (1 + 2 + 3 + 4) - num_threads);
+    ASSERT_EQ(stor.result(), statistics::Result(stor.value()));
+}
+
+/** Test that set and reset clear the values of all the threads. */
+TEST(StatsThreadStatStorTest, SetZeroReset)
+{
+    statistics::setThreadSlots(2);
+    statistics::ThreadStatStor stor(nullptr);
+
+    ASSERT_TRUE(stor.zero());
+    std::thread([&stor]() {
+        statistics::setThreadSlot(1);
+        stor.inc(5);
+    }).join();
+    stor.inc(3);
+    ASSERT_EQ(stor.value(), 8);
+
+    stor.set(2);
+    ASSERT_EQ(stor.value(), 2);
+
+    stor.reset(nullptr);
+    ASSERT_TRUE(stor.zero());
+
+    // Only the slots that exist can be used
+    ASSERT_ANY_THROW(statistics::setThreadSlot(2));
+    statistics::setThreadSlots(1);
+}
+
 /** Test setting and getting a value to the storage. */
 TEST(StatsAvgStorTest, SetValueResult)
 {
@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2019-2020 Arm Limited
+ * All rights reserved.
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2004-2005 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/stream.hh"
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <ostream>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+std::vector<std::regex>
+compilePatterns(const std::vector<std::string> &patterns)
+{
+    std::vector<std::regex> regexes;
+    for (const auto &pattern : patterns) {
+        try {
+            regexes.emplace_back(pattern, std::regex::optimize);
+        } catch (const std::regex_error &e) {
+            fatal("Invalid stat stream pattern '%s': %s", pattern, e.what());
+        }
+    }
+    return regexes;
+}
+
+int
+connectTo(const std::string &host, int port)
+{
+    struct addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo *res;
+    const std::string service = std::to_string(port);
+    int err = getaddrinfo(host.c_str(), service.c_str(), &hints, &res);
+    fatal_if(err, "Can't resolve stat stream server %s: %s", host,
+             gai_strerror(err));
+
+    int fd = -1;
+    for (auto *ai = res; ai; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd < 0)
+            continue;
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+            break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+
+    fatal_if(fd < 0, "Can't connect to stat stream server %s:%d: %s",
+             host, port, strerror(errno));
+    return fd;
+}
+
+/** Names of the values of a vector stat: its elements and its total. */
+std::vector<std::string>
+vectorNames(const std::vector<std::string> &subnames, size_type size)
+{
+    std::vector<std::string> names;
+    names.reserve(size + 1);
+    for (size_type i = 0; i < size; ++i) {
+        names.push_back(i < subnames.size() && !subnames[i].empty() ?
+                        subnames[i] : std::to_string(i));
+    }
+    names.push_back("total");
+    return names;
+}
+
+/** Names of a stat with a single value. */
+std::vector<std::string>
+noNames()
+{
+    return {};
+}
+
+Result
+mean(const DistData &data)
+{
+    return data.samples ? data.sum / data.samples : 0;
+}
+
+} // anonymous namespace
+
+Stream::Stream(std::ostream &_stream,
+               const std::vector<std::string> &_patterns)
+    : file(nullptr), stream(&_stream), fd(-1),
+      patterns(compilePatterns(_patterns)), cursor(0), nextId(0),
+      emptySize(0)
+{
+    writeHeader();
+}
+
+Stream::Stream(const std::string &filename,
+               const std::vector<std::string> &_patterns)
+    : file(simout.create(filename)), stream(file->stream()), fd(-1),
+      patterns(compilePatterns(_patterns)), cursor(0), nextId(0),
+      emptySize(0)
+{
+    writeHeader();
+}
+
+Stream::Stream(const std::string &host, int port,
+               const std::vector<std::string> &_patterns)
+    : file(nullptr), stream(nullptr), fd(connectTo(host, port)),
+      patterns(compilePatterns(_patterns)), cursor(0), nextId(0),
+      emptySize(0)
+{
+    writeHeader();
+}
+
+Stream::~Stream()
+{
+    if (file)
+        simout.close(file);
+    if (fd >= 0)
+        close(fd);
+}
+
+bool
+Stream::valid() const
+{
+    return stream ? stream->good() : fd >= 0;
+}
+
+void
+Stream::writeHeader()
+{
+    buf = "# gem5 stats stream 1\n";
+    flush();
+    if (!valid())
+        fatal("Unable to open statistics stream for writing\n");
+}
+
+void
+Stream::begin()
+{
+    prefixes.assign(1, std::string());
+    cursor = 0;
+    buf = "T " + std::to_string(curTick()) + "\n";
+    emptySize = buf.size();
+}
+
+void
+Stream::end()
+{
+    // Don't send anything if no value changed
+    if (buf.size() == emptySize)
+        buf.clear();
+    else
+        buf += "E\n";
+    flush();
+}
+
+void
+Stream::flush()
+{
+    if (stream) {
+        stream->write(buf.data(), buf.size());
+        stream->flush();
+    } else if (fd >= 0) {
+        const char *data = buf.data();
+        size_t left = buf.size();
+        while (left) {
+            ssize_t ret = send(fd, data, left, MSG_NOSIGNAL);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret <= 0) {
+                warn("Stat stream connection lost: %s", strerror(errno));
+                close(fd);
+                fd = -1;
+                break;
+            }
+            data += ret;
+            left -= ret;
+        }
+    }
+    buf.clear();
+}
+
+void
+Stream::beginGroup(const char *name)
+{
+    prefixes.push_back(prefixes.back() + name + ".");
+}
+
+void
+Stream::endGroup()
+{
+    assert(prefixes.size() > 1);
+    prefixes.pop_back();
+}
+
+template <typename Names>
+Stream::Entry *
+Stream::lookup(const Info &info, size_type values, Names &&names)
+{
+    // Stats that are not displayed don't have a proper name
+    if (!info.flags.isSet(display))
+        return nullptr;
+
+    Entry *entry;
+    if (cursor < entries.size() && entries[cursor].info == &info &&
+            entries[cursor].last.size() == values) {
+        entry = &entries[cursor];
+    } else {
+        entry = &create(info, values, names());
+    }
+    cursor++;
+    return entry->selected ? entry : nullptr;
+}
+
+Stream::Entry &
+Stream::create(const Info &info, size_type values,
+               const std::vector<std::string> &subnames)
+{
+    // The layout changed, forget everything from here on. The ids of
+    // the new entries are new, so stale values can't be confused.
+    entries.resize(cursor);
+    const std::string name = prefixes.back() + info.name;
+    bool selected = patterns.empty();
+    for (const auto &re : patterns) {
+        if (std::regex_match(name, re)) {
+            selected = true;
+            break;
+        }
+    }
+
+    entries.push_back({&info, selected, nextId,
+        std::vector<Result>(values,
+                            std::numeric_limits<Result>::quiet_NaN())});
+    if (!selected)
+        return entries.back();
+
+    if (subnames.empty()) {
+        buf += "N " + std::to_string(nextId++) + " " + name + "\n";
+    } else {
+        for (const auto &sub : subnames) {
+            buf += "N " + std::to_string(nextId++) + " " + name + "::" +
+                sub + "\n";
+        }
+    }
+    return entries.back();
+}
+
+void
+Stream::update(Entry &entry, size_type i, Result value)
+{
+    Result &last = entry.last[i];
+    if (value == last || (std::isnan(value) && std::isnan(last)))
+        return;
+    last = value;
+
+    char str[48];
+    int len = snprintf(str, sizeof(str), "%u %.12g\n", entry.id + i, value);
+    buf.append(str, len);
+}
+
+
+void
+Stream::visit(const ScalarInfo &info)
+{
+    if (Entry *entry = lookup(info, 1, noNames))
+        update(*entry, 0, info.result());
+}
+
+void
+Stream::visit(const VectorInfo &info)
+{
+    const size_type size = info.size();
+    Entry *entry = lookup(info, size + 1, [&info, size]() {
+        return vectorNames(info.subnames, size);
+    });
+    if (!entry)
+        return;
+
+    const VResult &vec = info.result();
+    for (size_type i = 0; i < size && i < vec.size(); ++i)
+        update(*entry, i, vec[i]);
+    update(*entry, size, info.total());
+}
+
+void
+Stream::visit(const FormulaInfo &info)
+{
+    visit(static_cast<const VectorInfo &>(info));
+}
+
+void
+Stream::visit(const Vector2dInfo &info)
+{
+    if (Entry *entry = lookup(info, 1, noNames))
+        update(*entry, 0, info.total());
+}
+
+void
+Stream::visit(const DistInfo &info)
+{
+    auto names = []() {
+        return std::vector<std::string>{ "samples", "mean" };
+    };
+    if (Entry *entry = lookup(info, 2, names)) {
+        update(*entry, 0, info.data.samples);
+        update(*entry, 1, mean(info.data));
+    }
+}
+
+void
+Stream::visit(const VectorDistInfo &info)
+{
+    const size_type size = info.data.size();
+    Entry *entry = lookup(info, 2 * size, [&info, size]() {
+        std::vector<std::string> names = vectorNames(info.subnames, size);
+        names.pop_back();
+        std::vector<std::string> dist_names;
+        for (const auto &sub : names) {
+            dist_names.push_back(sub + "::samples");
+            dist_names.push_back(sub + "::mean");
+        }
+        return dist_names;
+    });
+    if (!entry)
+        return;
+
+    for (size_type i = 0; i < size; ++i) {
+        update(*entry, 2 * i, info.data[i].samples);
+        update(*entry, 2 * i + 1, mean(info.data[i]));
+    }
+}
+
+void
+Stream::visit(const SparseHistInfo &info)
+{
+    if (Entry *entry = lookup(info, 1, noNames))
+        update(*entry, 0, info.data.samples);
+}
+
+std::unique_ptr<Output>
+initStreamFile(const std::string &filename,
+               const std::vector<std::string> &patterns)
+{
+    return std::make_unique<Stream>(filename, patterns);
+}
+
+std::unique_ptr<Output>
+initStreamSocket(const std::string &host, int port,
+                 const std::vector<std::string> &patterns)
+{
+    return std::make_unique<Stream>(host, port, patterns);
+}
+
+} // namespace statistics
+} // namespace gem5
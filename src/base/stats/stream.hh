@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2019-2020 Arm Limited
+ * All rights reserved.
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2004-2005 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_STREAM_HH__
+#define __BASE_STATS_STREAM_HH__
+
+#include <iosfwd>
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+/**
+ * Streaming statistics output for following long simulations live.
+ *
+ * Every dump emits the values of the selected statistics that changed
+ * since the previous dump, so the cost of a dump mostly depends on the
+ * number of stats that moved rather than on the size of the system.
+ * The output is a line based protocol that is easy to parse
+ * incrementally from a file or a socket:
+ *
+ *  - "# gem5 stats stream 1": header, written once.
+ *  - "N <id> <name>": defines the id of a value, written just before
+ *    the value is sent for the first time. Vectors and formulas send
+ *    one value per element ("<name>::<subname>") and their total
+ *    ("<name>::total"), distributions their number of samples and
+ *    their mean ("<name>::samples", "<name>::mean").
+ *  - "T <tick>": opens the update of a dump.
+ *  - "<id> <value>": new value of a stat.
+ *  - "E": closes the update of a dump.
+ *
+ * Ids are never reused, so a consumer can keep a plain table of the
+ * values it has seen.
+ */
+class Stream : public Output
+{
+  public:
+    /**
+     * @param stream Stream to write to.
+     * @param patterns ECMAScript regular expressions matched against
+     * the full names of the stats to send, all stats are sent if empty.
+     */
+    Stream(std::ostream &stream, const std::vector<std::string> &patterns);
+
+    /**
+     * @param filename Name of the output file in the output directory.
+     * @param patterns Regular expressions of the stats to send.
+     */
+    Stream(const std::string &filename,
+           const std::vector<std::string> &patterns);
+
+    /**
+     * Connect to a TCP server.
+     *
+     * @param host Host name or address of the server.
+     * @param port Port of the server.
+     * @param patterns Regular expressions of the stats to send.
+     */
+    Stream(const std::string &host, int port,
+           const std::vector<std::string> &patterns);
+
+    ~Stream();
+
+    Stream() = delete;
+    Stream(const Stream &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    /** A stat visited during the previous dumps, in visiting order. */
+    struct Entry
+    {
+        const Info *info;
+        /** False if the stat doesn't match the patterns. */
+        bool selected;
+        /** Id of the first value of the stat. */
+        unsigned id;
+        /** Values sent last, NaN until the first one is sent. */
+        std::vector<Result> last;
+    };
+
+    /**
+     * Find the entry of a visited stat, creating it if the layout of
+     * the stats changed since the previous dump.
+     *
+     * @param info Visited stat.
+     * @param values Number of values of the stat.
+     * @param names Callable returning the names of the values of the
+     * stat, only called when the entry is created. Stats with a single
+     * value have no name.
+     * @return The entry, or nullptr if the stat must not be sent.
+     */
+    template <typename Names>
+    Entry *lookup(const Info &info, size_type values, Names &&names);
+
+    /** Create the entry of a stat and define the ids of its values. */
+    Entry &create(const Info &info, size_type values,
+                  const std::vector<std::string> &subnames);
+
+    /** Send the value at index i of an entry if it changed. */
+    void update(Entry &entry, size_type i, Result value);
+
+    void writeHeader();
+    /** Write the buffered data to the output. */
+    void flush();
+
+    /** Output file, if opened by this object. */
+    OutputStream *file;
+    std::ostream *stream;
+    /** Socket the stats are sent to, or -1. */
+    int fd;
+
+    std::vector<std::regex> patterns;
+
+    /** Prefix of the names of the stats of the current group. */
+    std::vector<std::string> prefixes;
+
+    std::vector<Entry> entries;
+    /** Index of the next expected entry of the current dump. */
+    size_t cursor;
+    /** Next free id. */
+    unsigned nextId;
+
+    /** Data of the current update. */
+    std::string buf;
+    /** Size of buf once the update is opened. */
+    size_t emptySize;
+};
+
+std::unique_ptr<Output> initStreamFile(
+        const std::string &filename,
+        const std::vector<std::string> &patterns);
+std::unique_ptr<Output> initStreamSocket(
+        const std::string &host, int port,
+        const std::vector<std::string> &patterns);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_STREAM_HH__
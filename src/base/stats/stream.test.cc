@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/stats/info.hh"
+#include "base/stats/stream.hh"
+#include "base/stats/units.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+GTestTickHandler tickHandler;
+
+struct TestScalar : public statistics::ScalarInfo
+{
+    double v = 0;
+
+    TestScalar(const char *_name)
+    {
+        name = _name;
+        unit = statistics::units::Count::get();
+        flags.set(statistics::display);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override { v = 0; }
+    bool zero() const override { return v == 0; }
+    void visit(statistics::Output &out) override { out.visit(*this); }
+    statistics::Counter value() const override { return v; }
+    statistics::Result result() const override { return v; }
+    statistics::Result total() const override { return v; }
+};
+
+struct TestVector : public statistics::VectorInfo
+{
+    statistics::VCounter v;
+
+    TestVector(const char *_name, size_t size)
+        : v(size, 0)
+    {
+        name = _name;
+        unit = statistics::units::Count::get();
+        flags.set(statistics::display);
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return false; }
+    void visit(statistics::Output &out) override { out.visit(*this); }
+    statistics::size_type size() const override { return v.size(); }
+    const statistics::VCounter &value() const override { return v; }
+    const statistics::VResult &result() const override { return v; }
+
+    statistics::Result
+    total() const override
+    {
+        statistics::Result sum = 0;
+        for (auto x : v)
+            sum += x;
+        return sum;
+    }
+};
+
+struct TestStats
+{
+    TestScalar scalar{"scalar"};
+    TestScalar other{"other"};
+    TestVector vector{"vector", 2};
+
+    TestStats() { vector.subnames = { "", "one" }; }
+
+    void
+    dump(statistics::Output &out, bool with_other=true)
+    {
+        out.begin();
+        out.beginGroup("system");
+        scalar.visit(out);
+        if (with_other)
+            other.visit(out);
+        vector.visit(out);
+        out.endGroup();
+        out.end();
+    }
+};
+
+} // anonymous namespace
+
+/** Check that only the values that changed are sent */
+TEST(StatsStreamTest, Deltas)
+{
+    std::ostringstream os;
+    TestStats stats;
+    statistics::Stream out(os, {});
+
+    stats.scalar.v = 7;
+    stats.vector.v = { 1, 2 };
+    tickHandler.setCurTick(10);
+    stats.dump(out);
+    EXPECT_EQ(os.str(),
+        "# gem5 stats stream 1\n"
+        "T 10\n"
+        "N 0 system.scalar\n"
+        "0 7\n"
+        "N 1 system.other\n"
+        "1 0\n"
+        "N 2 system.vector::0\n"
+        "N 3 system.vector::one\n"
+        "N 4 system.vector::total\n"
+        "2 1\n"
+        "3 2\n"
+        "4 3\n"
+        "E\n");
+
+    os.str("");
+    stats.vector.v = { 1, 4 };
+    tickHandler.setCurTick(20);
+    stats.dump(out);
+    EXPECT_EQ(os.str(), "T 20\n3 4\n4 5\nE\n");
+
+    // Nothing changed, nothing is sent
+    os.str("");
+    tickHandler.setCurTick(30);
+    stats.dump(out);
+    EXPECT_EQ(os.str(), "");
+}
+
+/** Check that a change of the layout defines new ids */
+TEST(StatsStreamTest, LayoutChange)
+{
+    std::ostringstream os;
+    TestStats stats;
+    statistics::Stream out(os, {});
+
+    tickHandler.setCurTick(0);
+    stats.dump(out);
+    os.str("");
+    stats.dump(out, false);
+    EXPECT_EQ(os.str(),
+        "T 0\n"
+        "N 5 system.vector::0\n"
+        "N 6 system.vector::one\n"
+        "N 7 system.vector::total\n"
+        "5 0\n"
+        "6 0\n"
+        "7 0\n"
+        "E\n");
+}
+
+/** Check that only the selected stats are sent */
+TEST(StatsStreamTest, Patterns)
+{
+    std::ostringstream os;
+    TestStats stats;
+    statistics::Stream out(os, { "system\\.s.*", "system\\.vector" });
+
+    tickHandler.setCurTick(0);
+    stats.scalar.v = 1;
+    stats.other.v = 2;
+    stats.dump(out);
+    EXPECT_EQ(os.str(),
+        "# gem5 stats stream 1\n"
+        "T 0\n"
+        "N 0 system.scalar\n"
+        "0 1\n"
+        "N 1 system.vector::0\n"
+        "N 2 system.vector::one\n"
+        "N 3 system.vector::total\n"
+        "1 0\n"
+        "2 0\n"
+        "3 0\n"
+        "E\n");
+}
@@ -137,7 +137,10 @@ Logger::dump(Tick when, const std::string &name,
         }
 
         ccprintf(line, "\n");
-        logMessage(when, name, flag, line.str());
+        if (TraceRing *ring = TraceRing::active())
+            ring->record(when, name, flag, "%s", line.str());
+        else
+            logMessage(when, name, flag, line.str());
 
         if (c < 16)
             break;
@@ -41,6 +41,7 @@
 #include "base/debug.hh"
 #include "base/logging.hh"
 #include "base/match.hh"
+#include "base/trace_ring.hh"
 #include "base/types.hh"
 #include "sim/cur_tick.hh"
 
@@ -96,11 +97,48 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if (TraceRing *ring = TraceRing::active(); GEM5_UNLIKELY(ring)) {
+            ring->record(when, name, flag, fmt, args...);
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
     }
 
+    /**
+     * Log a single message, using the prepared version of the format
+     * string if there is one. The DPRINTF macros use this with a format
+     * prepared once per call site.
+     */
+    template <typename ...Args>
+    void dprintf(Tick when, const std::string &name,
+                 const cp::FormatString *prepared, const char *fmt,
+                 const Args &...args)
+    {
+        dprintf_flag(when, name, "", prepared, fmt, args...);
+    }
+
+    template <typename ...Args>
+    void dprintf_flag(Tick when, const std::string &name,
+            const std::string &flag, const cp::FormatString *prepared,
+            const char *fmt, const Args &...args)
+    {
+        if (!prepared) {
+            dprintf_flag(when, name, flag, fmt, args...);
+            return;
+        }
+        if (!isEnabled(name))
+            return;
+        if (TraceRing *ring = TraceRing::active(); GEM5_UNLIKELY(ring)) {
+            ring->record(when, name, flag, fmt, args...);
+            return;
+        }
+        std::ostringstream line;
+        ccprintf(line, *prepared, args...);
+        logMessage(when, name, flag, line.str());
+    }
+
     /** Dump a block of data of length len */
     void dump(Tick when, const std::string &name,
             const void *d, int len, const std::string &flag);
@@ -209,43 +247,52 @@ struct StringWrap
 
 #define DPRINTF(x, ...) do {                     \
     if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {   \
+        GEM5_PREPARED_FORMAT(_gem5_fmt, __VA_ARGS__);    \
         ::gem5::trace::getDebugLogger()->dprintf_flag(   \
-            ::gem5::curTick(), name(), #x, __VA_ARGS__); \
+            ::gem5::curTick(), name(), #x, _gem5_fmt, __VA_ARGS__); \
     }                                            \
 } while (0)
 
 #define DPRINTFS(x, s, ...) do {                        \
     if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {          \
+        GEM5_PREPARED_FORMAT(_gem5_fmt, __VA_ARGS__);           \
         ::gem5::trace::getDebugLogger()->dprintf_flag(          \
-                ::gem5::curTick(), (s)->name(), #x, __VA_ARGS__); \
+                ::gem5::curTick(), (s)->name(), #x, _gem5_fmt,  \
+                __VA_ARGS__);                                   \
     }                                                   \
 } while (0)
 
 #define DPRINTFR(x, ...) do {                          \
     if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {         \
+        GEM5_PREPARED_FORMAT(_gem5_fmt, __VA_ARGS__);          \
         ::gem5::trace::getDebugLogger()->dprintf_flag(         \
-            (::gem5::Tick)-1, std::string(), #x, __VA_ARGS__); \
+            (::gem5::Tick)-1, std::string(), #x, _gem5_fmt,    \
+            __VA_ARGS__);                                      \
     }                                                  \
 } while (0)
 
 #define DPRINTFV(x, ...) do {                          \
     if (GEM5_UNLIKELY(TRACING_ON && (x))) {              \
+        GEM5_PREPARED_FORMAT(_gem5_fmt, __VA_ARGS__);          \
         ::gem5::trace::getDebugLogger()->dprintf_flag(         \
-            ::gem5::curTick(), name(), x.name(), __VA_ARGS__); \
+            ::gem5::curTick(), name(), x.name(), _gem5_fmt,    \
+            __VA_ARGS__);                                      \
     }                                                  \
 } while (0)
 
 #define DPRINTFN(...) do {                                                \
     if (TRACING_ON) {                                                     \
+        GEM5_PREPARED_FORMAT(_gem5_fmt, __VA_ARGS__);                     \
         ::gem5::trace::getDebugLogger()->dprintf( \
-            ::gem5::curTick(), name(), __VA_ARGS__); \
+            ::gem5::curTick(), name(), _gem5_fmt, __VA_ARGS__); \
     }                                                                     \
 } while (0)
 
 #define DPRINTFNR(...) do {                                          \
     if (TRACING_ON) {                                                \
+        GEM5_PREPARED_FORMAT(_gem5_fmt, __VA_ARGS__);                \
         ::gem5::trace::getDebugLogger()->dprintf( \
-            (::gem5::Tick)-1, "", __VA_ARGS__); \
+            (::gem5::Tick)-1, "", _gem5_fmt, __VA_ARGS__); \
     }                                                                \
 } while (0)
 
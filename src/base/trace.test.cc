@@ -562,6 +562,35 @@ TEST(TraceTest, MacroDPRINTF)
     ASSERT_EQ(getString(trace::output()), "");
 }
 
+/** Test DPRINTF with arguments, with prepared and other formats. */
+TEST(TraceTest, MacroDPRINTFFormats)
+{
+    StringWrap name("Foo");
+    const char *fmt = "Pointer %d";
+
+    trace::enable();
+    EXPECT_TRUE(debug::changeFlag("TraceTestDebugFlag", true));
+    EXPECT_TRUE(debug::changeFlag("FmtFlag", true));
+    for (int i = 0; i < 2; i++) {
+        DPRINTF(TraceTestDebugFlag, "Literal %d %s", i, "message");
+#if TRACING_ON
+        ASSERT_EQ(getString(trace::output()), csprintf(
+            "      0: TraceTestDebugFlag: Foo: Literal %d message", i));
+#endif
+        // A format which isn't a literal must be parsed every time.
+        DPRINTF(TraceTestDebugFlag, fmt, i);
+#if TRACING_ON
+        ASSERT_EQ(getString(trace::output()), csprintf(
+            "      0: TraceTestDebugFlag: Foo: %s %d",
+            i ? "Changed" : "Pointer", i));
+#endif
+        fmt = "Changed %d";
+    }
+
+    trace::disable();
+    EXPECT_TRUE(debug::changeFlag("TraceTestDebugFlag", false));
+}
+
 /** Test DPRINTFS with tracing on. */
 TEST(TraceTest, MacroDPRINTFS)
 {
@@ -685,3 +714,66 @@ TEST(TraceTest, GlobalName)
     DPRINTF(TraceTestDebugFlag, "Test message");
     ASSERT_EQ(getString(trace::output()), "");
 }
+
+/** Test that recorded messages are only formatted when dumped. */
+TEST(TraceRingTest, RecordAndDump)
+{
+    std::stringstream ss;
+    trace::OstreamLogger logger(ss);
+    trace::TraceRing ring(4);
+
+    std::string str = "abc";
+    ring.record(Tick(10), "Foo", "", "%d %#x %s %s\n", 1, 0x20, str, "def");
+    // Arguments are copied when the message is recorded
+    str = "xyz";
+    ring.record(Tick(20), "Bar", "", "%s\n", std::string("temp"));
+    ASSERT_EQ(getString(&logger), "");
+
+    ring.dump(logger);
+    ASSERT_EQ(getString(&logger),
+        "---- Last 2 debug messages of thread 0 ----\n"
+        "     10: Foo: 1 0x20 abc def\n"
+        "     20: Bar: temp\n");
+
+    // The history is cleared once dumped
+    ring.dump(logger);
+    ASSERT_EQ(getString(&logger),
+        "---- Last 0 debug messages of thread 0 ----\n");
+}
+
+/** Test that only the most recent messages are kept. */
+TEST(TraceRingTest, Wrap)
+{
+    std::stringstream ss;
+    trace::OstreamLogger logger(ss);
+    trace::TraceRing ring(2);
+
+    for (int i = 0; i < 5; ++i)
+        ring.record(Tick(i), "Foo", "", "message %d\n", i);
+
+    ring.dump(logger);
+    ASSERT_EQ(getString(&logger),
+        "---- Last 2 debug messages of thread 0 ----\n"
+        "      3: Foo: message 3\n"
+        "      4: Foo: message 4\n");
+}
+
+/** Test that an active ring captures the messages of the loggers. */
+TEST(TraceRingTest, Active)
+{
+    std::stringstream ss;
+    trace::OstreamLogger logger(ss);
+
+    trace::TraceRing::enable(4);
+    logger.dprintf_flag(Tick(3), "Foo", "", "value %d\n", 7);
+    ASSERT_EQ(getString(&logger), "");
+
+    trace::TraceRing::active()->dump(logger);
+    trace::TraceRing::enable(0);
+    ASSERT_EQ(getString(&logger),
+        "---- Last 1 debug messages of thread 0 ----\n"
+        "      3: Foo: value 7\n");
+
+    logger.dprintf_flag(Tick(4), "Foo", "", "value %d\n", 8);
+    ASSERT_EQ(getString(&logger), "      4: Foo: value 8\n");
+}
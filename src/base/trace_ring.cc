@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/trace_ring.hh"
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+TraceRing *TraceRing::_active = nullptr;
+thread_local TraceRing::Buffer *TraceRing::localBuffer = nullptr;
+thread_local uint64_t TraceRing::localRingId = 0;
+std::atomic<uint64_t> TraceRing::lastId{0};
+
+void
+TraceRing::enable(size_t entries)
+{
+    static bool hooked = false;
+    if (!hooked) {
+        ::gem5::Logger::addExitHook(dumpRing);
+        hooked = true;
+    }
+
+    // Old rings are not freed, as other threads may still be using
+    // them, but they will not be recorded into any more
+    _active = entries ? new TraceRing(entries) : nullptr;
+}
+
+TraceRing::Buffer &
+TraceRing::newBuffer()
+{
+    std::lock_guard<std::mutex> lock(buffersLock);
+    buffers.emplace_back(new Buffer(entries));
+    localBuffer = buffers.back().get();
+    localRingId = id;
+    return *localBuffer;
+}
+
+void
+TraceRing::dump(Logger &logger)
+{
+    std::lock_guard<std::mutex> lock(buffersLock);
+
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        Buffer &buf = *buffers[i];
+        const size_t count = buf.wrapped ? buf.size : buf.pos;
+        ccprintf(logger.getOstream(),
+                 "---- Last %d debug messages of thread %d ----\n",
+                 count, i);
+
+        const size_t first = buf.wrapped ? buf.pos : 0;
+        for (size_t n = 0; n < count; ++n) {
+            Entry &e = buf.entries[(first + n) % buf.size];
+            if (e.format) {
+                std::ostringstream line;
+                e.format(line, e.fmt, e.args);
+                logger.logMessage(e.when, e.name, e.flag, line.str());
+            } else {
+                logger.logMessage(e.when, e.name, e.flag, e.text);
+            }
+            e.clear();
+        }
+
+        buf.pos = 0;
+        buf.wrapped = false;
+    }
+    logger.getOstream().flush();
+}
+
+void
+dumpRing()
+{
+    TraceRing *ring = TraceRing::active();
+    if (!ring)
+        return;
+
+    // Disable the ring while dumping, so that the logger prints
+    // rather than records any messages
+    TraceRing::enable(0);
+    ring->dump(*getDebugLogger());
+    TraceRing::_active = ring;
+}
+
+} // namespace trace
+} // namespace gem5
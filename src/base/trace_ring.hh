@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_TRACE_RING_HH__
+#define __BASE_TRACE_RING_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+class Logger;
+
+/**
+ * In-memory history of the most recent debug messages. When a ring is
+ * active, DPRINTFs do not format their message but store the format
+ * string and a copy of their arguments in a buffer private to the
+ * calling thread, overwriting the oldest messages once it is full.
+ * The messages are only formatted when the history is dumped, which
+ * happens on panic() and fatal(), on SIGQUIT, or when requested from
+ * Python. This keeps a trace of what led to a failure deep into a run
+ * without paying for text tracing all along.
+ *
+ * Arguments are stored by value when they are trivially copyable.
+ * C strings, which could point to temporaries, and other types are
+ * converted to strings when the message is recorded.
+ */
+class TraceRing
+{
+  public:
+    /** Bytes available to store the arguments of a message in place */
+    static const size_t argsSize = 128;
+
+    /**
+     * @param entries Number of messages kept per thread
+     */
+    TraceRing(size_t entries) : entries(entries), id(++lastId) {}
+
+    /** The active ring, if any */
+    static TraceRing *active() { return _active; }
+
+    /** Make a ring of the given size active, or disable it with 0 */
+    static void enable(size_t entries);
+
+    /** Format the history of all threads into the logger and clear it */
+    void dump(Logger &logger);
+
+    /** Record a message */
+    template <typename ...Args>
+    void
+    record(Tick when, const std::string &name, const std::string &flag,
+           const char *fmt, const Args &...args)
+    {
+        Entry &e = buffer().next();
+        e.clear();
+        e.when = when;
+        e.name = name;
+        e.flag = flag;
+        e.fmt = fmt;
+
+        using Tuple = std::tuple<typename Stored<Args>::Type...>;
+        if constexpr (sizeof(Tuple) <= argsSize &&
+                      alignof(Tuple) <= alignof(std::max_align_t)) {
+            new (e.args) Tuple(Stored<Args>::store(args)...);
+            e.format = &formatArgs<Tuple>;
+            if constexpr (!std::is_trivially_destructible_v<Tuple>)
+                e.destroy = &destroyArgs<Tuple>;
+        } else {
+            // Too large to keep in place, format the message right away
+            std::ostringstream line;
+            ccprintf(line, fmt, args...);
+            e.text = line.str();
+        }
+    }
+
+  private:
+    /** How an argument of a given type is kept until it is formatted */
+    template <typename T, typename Enable = void>
+    struct Stored
+    {
+        using Type = std::string;
+
+        static std::string
+        store(const T &val)
+        {
+            std::ostringstream os;
+            os << val;
+            return os.str();
+        }
+    };
+
+    template <typename T>
+    struct Stored<T, std::enable_if_t<std::is_trivially_copyable_v<T> &&
+                                      std::is_copy_constructible_v<T> &&
+                                      !std::is_pointer_v<T> &&
+                                      !std::is_array_v<T> &&
+                                      !std::is_same_v<T, std::string_view>>>
+    {
+        using Type = T;
+        static const T &store(const T &val) { return val; }
+    };
+
+    template <typename T>
+    struct Stored<T, std::enable_if_t<std::is_same_v<T, std::string>>>
+    {
+        using Type = std::string;
+        static const std::string &store(const T &val) { return val; }
+    };
+
+    template <typename T>
+    struct Stored<T *>
+    {
+        static const bool isString =
+            std::is_same_v<std::remove_cv_t<T>, char>;
+        using Type = std::conditional_t<isString, std::string, T *>;
+
+        static Type
+        store(T *val)
+        {
+            if constexpr (isString)
+                return val ? std::string(val) : std::string("(null)");
+            else
+                return val;
+        }
+    };
+
+    template <typename T>
+    struct Stored<T, std::enable_if_t<std::is_array_v<T>>>
+        : public Stored<const std::remove_extent_t<T> *>
+    {};
+
+    template <typename Tuple>
+    static void
+    formatArgs(std::ostream &os, const char *fmt, const void *args)
+    {
+        std::apply([&](const auto &...vals) { ccprintf(os, fmt, vals...); },
+                   *static_cast<const Tuple *>(args));
+    }
+
+    template <typename Tuple>
+    static void
+    destroyArgs(void *args)
+    {
+        static_cast<Tuple *>(args)->~Tuple();
+    }
+
+    /** A message of the history */
+    struct Entry
+    {
+        Tick when = 0;
+        std::string name;
+        std::string flag;
+        const char *fmt = nullptr;
+
+        /** Formats the stored arguments, or null if text is used */
+        void (*format)(std::ostream &, const char *, const void *) = nullptr;
+
+        /** Destroys the stored arguments, or null if trivial */
+        void (*destroy)(void *) = nullptr;
+
+        /** Message formatted when recorded, if the arguments are large */
+        std::string text;
+
+        alignas(std::max_align_t) unsigned char args[argsSize];
+
+        Entry() = default;
+        Entry(const Entry &) = delete;
+        Entry &operator=(const Entry &) = delete;
+        ~Entry() { clear(); }
+
+        void
+        clear()
+        {
+            if (destroy)
+                destroy(args);
+            destroy = nullptr;
+            format = nullptr;
+            text.clear();
+        }
+    };
+
+    /** The history of a thread */
+    struct Buffer
+    {
+        Buffer(size_t _size)
+            : entries(new Entry[_size]), size(_size)
+        {}
+
+        Entry &
+        next()
+        {
+            Entry &e = entries[pos];
+            if (++pos == size) {
+                pos = 0;
+                wrapped = true;
+            }
+            return e;
+        }
+
+        std::unique_ptr<Entry[]> entries;
+        const size_t size;
+        size_t pos = 0;
+        bool wrapped = false;
+    };
+
+    /** Get the buffer of the calling thread, creating it if needed */
+    Buffer &
+    buffer()
+    {
+        if (localRingId != id)
+            return newBuffer();
+        return *localBuffer;
+    }
+
+    Buffer &newBuffer();
+
+    /** Number of messages kept per thread */
+    const size_t entries;
+
+    /**
+     * Unique id of the ring. A new ring may be allocated where an old one
+     * was, so the address doesn't tell whether a thread's buffer is part
+     * of this ring.
+     */
+    const uint64_t id;
+    static std::atomic<uint64_t> lastId;
+
+    /** Buffers of all the threads that recorded messages */
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    std::mutex buffersLock;
+
+    static TraceRing *_active;
+    friend void dumpRing();
+
+    /** Buffer of the calling thread, and the id of its ring */
+    static thread_local Buffer *localBuffer;
+    static thread_local uint64_t localRingId;
+};
+
+/** Dump the history of the active ring, if any, to the debug logger */
+void dumpRing();
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_TRACE_RING_HH__
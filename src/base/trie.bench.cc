@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Trie looks up the TLB entries of some ISAs, keyed by the virtual page
+ * number with the page size as the prefix width. The benchmark fills a
+ * trie with a TLB sized mix of small and large pages and looks up
+ * addresses within them.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/trie.hh"
+#include "base/types.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+typedef Trie<Addr, uint32_t> TrieType;
+
+/** Insert 4KiB pages, with every eighth one being a 2MiB page */
+std::vector<Addr>
+fillTrie(TrieType &trie, std::vector<uint32_t> &values)
+{
+    std::mt19937_64 rng(0);
+    std::vector<Addr> addrs;
+    for (size_t i = 0; i < values.size(); i++) {
+        const bool large = i % 8 == 0;
+        const unsigned page_bits = large ? 21 : 12;
+        const Addr addr = (rng() & mask(47)) & ~mask(page_bits);
+        trie.insert(addr, 64 - page_bits, &values[i]);
+        addrs.push_back(addr | (rng() & mask(page_bits)));
+    }
+    return addrs;
+}
+
+void
+BM_TrieLookup(benchmark::State &state)
+{
+    TrieType trie;
+    std::vector<uint32_t> values(state.range(0));
+    const std::vector<Addr> addrs = fillTrie(trie, values);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(trie.lookup(addrs[i]));
+        i = (i + 1) % addrs.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrieLookup)->Arg(64)->Arg(1024);
+
+void
+BM_TrieInsertRemove(benchmark::State &state)
+{
+    TrieType trie;
+    std::vector<uint32_t> values(state.range(0));
+    const std::vector<Addr> addrs = fillTrie(trie, values);
+
+    // Replace an entry, as a TLB does on a miss once it is full
+    uint32_t value = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        auto handle = trie.insert(addrs[i] ^ (1ULL << 46), 52, &value);
+        trie.remove(handle);
+        i = (i + 1) % addrs.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrieInsertRemove)->Arg(64)->Arg(1024);
+
+} // anonymous namespace
@@ -56,6 +56,7 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstddef>
 #include <cstdio>
@@ -118,7 +119,8 @@ VncServer::DataEvent::process(int revent)
 VncServer::VncServer(const Params &p)
     : VncInput(p), listenEvent(NULL), dataEvent(NULL), number(p.number),
       dataFd(-1), listener(p.port.build(p.name)),
-      sendUpdate(false), supportsRawEnc(false), supportsResizeEnc(false)
+      sendUpdate(false), supportsRawEnc(false), supportsResizeEnc(false),
+      encoderBusy(false), encoderFailed(false), encoderStop(false)
 {
     if (p.port)
         listen();
@@ -144,6 +146,15 @@ VncServer::VncServer(const Params &p)
 
 VncServer::~VncServer()
 {
+    if (encoder.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(encoderMutex);
+            encoderStop = true;
+        }
+        encoderCond.notify_all();
+        encoder.join();
+    }
+
     if (dataFd != -1)
         ::close(dataFd);
 
@@ -339,6 +350,13 @@ VncServer::write(const char* str)
 void
 VncServer::detach()
 {
+    // Let the encoder finish with the socket before closing it
+    {
+        std::unique_lock<std::mutex> lock(encoderMutex);
+        encoderCond.wait(lock, [this]() { return !encoderBusy; });
+        encoderFailed = false;
+    }
+
     if (dataFd != -1) {
         ::close(dataFd);
         dataFd = -1;
@@ -556,6 +574,13 @@ VncServer::requestFbUpdate()
     DPRINTF(VNC, " -- x = %d y = %d w = %d h = %d\n", fbr.x, fbr.y, fbr.width,
             fbr.height);
 
+    // A non-incremental request asks for the area even if it didn't
+    // change since the last update
+    if (!fbr.incremental) {
+        updateRect.merge({fbr.x, fbr.y, fbr.width, fbr.height});
+        sendUpdate = true;
+    }
+
     sendFrameBufferUpdate();
 }
 
@@ -626,20 +651,95 @@ VncServer::sendFrameBufferUpdate()
         return;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(encoderMutex);
+        if (encoderBusy) {
+            // The changes are merged into the next update
+            DPRINTF(VNC, "Framebuffer update in flight, deferring update\n");
+            return;
+        }
+    }
+
+    // Report a failure of the previous update
+    if (!waitEncoder())
+        return;
+
+    assert(fb);
+
+    // Clip the update to the current frame, the frame buffer may have
+    // shrunk since the area was recorded
+    FrameBuffer::Rect rect(updateRect);
+    if (rect.x >= videoWidth() || rect.y >= videoHeight()) {
+        rect = FrameBuffer::Rect();
+    } else {
+        rect.width = std::min<unsigned>(rect.width, videoWidth() - rect.x);
+        rect.height = std::min<unsigned>(rect.height, videoHeight() - rect.y);
+    }
+
+    if (rect.empty()) {
+        DPRINTF(VNC, "Nothing to send in framebuffer update\n");
+        return;
+    }
+
     // The client will request data constantly, unless we throttle it
     sendUpdate = false;
+    updateRect = FrameBuffer::Rect();
+
+    DPRINTF(VNC, "Sending framebuffer update: x = %d y = %d w = %d h = %d\n",
+            rect.x, rect.y, rect.width, rect.height);
+
+    // Copy the pixels so the simulation can carry on updating the frame
+    // buffer while the encoder is busy
+    encoderRect = rect;
+    encoderPixels.resize(rect.width * rect.height);
+    for (unsigned y = 0; y < rect.height; ++y) {
+        const Pixel *line = &fb->pixel(rect.x, rect.y + y);
+        std::copy(line, line + rect.width,
+                  encoderPixels.begin() + y * rect.width);
+    }
+
+    if (!encoder.joinable())
+        encoder = std::thread([this]() { encodeLoop(); });
+
+    {
+        std::lock_guard<std::mutex> lock(encoderMutex);
+        encoderBusy = true;
+    }
+    encoderCond.notify_all();
+}
+
+void
+VncServer::encodeLoop()
+{
+    std::unique_lock<std::mutex> lock(encoderMutex);
+    while (true) {
+        encoderCond.wait(lock,
+                         [this]() { return encoderStop || encoderBusy; });
+        if (encoderStop)
+            return;
+
+        lock.unlock();
+        const bool success = encodeUpdate();
+        lock.lock();
 
-    DPRINTF(VNC, "Sending framebuffer update\n");
+        encoderFailed = !success;
+        encoderBusy = false;
+        encoderCond.notify_all();
+    }
+}
 
+bool
+VncServer::encodeUpdate()
+{
     FrameBufferUpdate fbu;
     FrameBufferRect fbr;
 
     fbu.type = ServerFrameBufferUpdate;
     fbu.num_rects = 1;
-    fbr.x = 0;
-    fbr.y = 0;
-    fbr.width = videoWidth();
-    fbr.height = videoHeight();
+    fbr.x = encoderRect.x;
+    fbr.y = encoderRect.y;
+    fbr.width = encoderRect.width;
+    fbr.height = encoderRect.height;
     fbr.encoding = EncodingRaw;
 
     // fix up endian
@@ -650,30 +750,51 @@ VncServer::sendFrameBufferUpdate()
     fbr.height = htobe(fbr.height);
     fbr.encoding = htobe(fbr.encoding);
 
-    // send headers to client
-    if (!write(&fbu) || !write(&fbr))
-        return;
-
-    assert(fb);
+    // This runs outside of the simulation thread, so don't use write(),
+    // which detaches the client on errors
+    if (atomic_write(dataFd, &fbu, sizeof(fbu)) != sizeof(fbu) ||
+        atomic_write(dataFd, &fbr, sizeof(fbr)) != sizeof(fbr)) {
+        return false;
+    }
 
-    std::vector<uint8_t> line_buffer(pixelConverter.length * fb->width());
-    for (int y = 0; y < fb->height(); ++y) {
+    const unsigned width(encoderRect.width);
+    std::vector<uint8_t> line_buffer(pixelConverter.length * width);
+    for (unsigned y = 0; y < encoderRect.height; ++y) {
         // Convert and send a line at a time
-        uint8_t *raw_pixel(line_buffer.data());
-        for (unsigned x = 0; x < fb->width(); ++x) {
-            pixelConverter.fromPixel(raw_pixel, fb->pixel(x, y));
-            raw_pixel += pixelConverter.length;
-        }
-
-        if (!write(line_buffer.data(), line_buffer.size()))
-            return;
+        pixelConverter.fromPixels(&encoderPixels[y * width],
+                                  line_buffer.data(), width);
+        const ssize_t ret = atomic_write(dataFd, line_buffer.data(),
+                                         line_buffer.size());
+        if (ret != line_buffer.size())
+            return false;
     }
+
+    return true;
+}
+
+bool
+VncServer::waitEncoder()
+{
+    std::unique_lock<std::mutex> lock(encoderMutex);
+    encoderCond.wait(lock, [this]() { return !encoderBusy; });
+    if (!encoderFailed)
+        return true;
+
+    lock.unlock();
+    DPRINTF(VNC, "Write failed.\n");
+    detach();
+    return false;
 }
 
 void
 VncServer::sendFrameBufferResized()
 {
     assert(fb && dataFd > 0 && curState == NormalPhase);
+
+    // The resize message must not end up in the middle of an update
+    if (!waitEncoder())
+        return;
+
     DPRINTF(VNC, "Sending framebuffer resize\n");
 
     FrameBufferUpdate fbu;
@@ -703,11 +824,22 @@ VncServer::sendFrameBufferResized()
     // No actual data is sent in this message
 }
 
+void
+VncServer::setFrameBuffer(const FrameBuffer *rfb)
+{
+    // A new frame buffer has to be sent as a whole
+    if (rfb)
+        updateRect = {0, 0, rfb->width(), rfb->height()};
+
+    VncInput::setFrameBuffer(rfb);
+}
+
 void
 VncServer::setDirty()
 {
     VncInput::setDirty();
 
+    updateRect.merge(fb->dirty());
     sendUpdate = true;
     sendFrameBufferUpdate();
 }
@@ -42,10 +42,15 @@
 #ifndef __BASE_VNC_VNC_SERVER_HH__
 #define __BASE_VNC_VNC_SERVER_HH__
 
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "base/circlebuf.hh"
 #include "base/compiler.hh"
+#include "base/framebuffer.hh"
 #include "base/pollevent.hh"
 #include "base/socket.hh"
 #include "base/vnc/vncinput.hh"
@@ -202,6 +207,9 @@ class VncServer : public VncInput
      * client will constantly request data that is pointless */
     bool sendUpdate;
 
+    /** Area of the frame buffer that changed since the last update */
+    FrameBuffer::Rect updateRect;
+
     /** The one and only pixel format we support */
     PixelFormat pixelFormat;
 
@@ -282,7 +290,11 @@ class VncServer : public VncInput
     void sendError(std::string error_msg);
 
     /** Send a updated frame buffer to the client.
-     * @todo this doesn't do anything smart and just sends the entire image
+     * Only the area that changed since the last update is sent. The
+     * pixels are copied and handed over to the encoder thread, which
+     * converts them and writes them to the client. If the previous
+     * update is still in flight, the changes are held back and sent with
+     * the next update instead.
      */
     void sendFrameBufferUpdate();
 
@@ -314,7 +326,46 @@ class VncServer : public VncInput
 
     static const PixelConverter pixelConverter;
 
+    /**
+     * @{
+     * @name Frame buffer update encoding
+     *
+     * Frame buffer updates are converted and written to the client by a
+     * helper thread, so a slow client does not stall the simulation. The
+     * simulation thread never writes to the client while an update is in
+     * flight, and the helper thread only touches the update it was handed
+     * and the data socket.
+     */
+    std::thread encoder;
+    std::mutex encoderMutex;
+    std::condition_variable encoderCond;
+    /** An update was handed over to the encoder and is not done yet */
+    bool encoderBusy;
+    /** The encoder failed to write the last update to the client */
+    bool encoderFailed;
+    /** Tell the encoder thread to exit */
+    bool encoderStop;
+    /** Area of the frame buffer covered by the update */
+    FrameBuffer::Rect encoderRect;
+    /** Copy of the pixels of the update */
+    std::vector<Pixel> encoderPixels;
+
+    /** Main loop of the encoder thread */
+    void encodeLoop();
+
+    /** Convert and write an update to the client (encoder thread)
+     * @return whether the update was written successfully
+     */
+    bool encodeUpdate();
+
+    /** Wait until the encoder is done with the update in flight
+     * @return false if the update failed and the client was detached
+     */
+    bool waitEncoder();
+    /** @} */
+
   public:
+    void setFrameBuffer(const FrameBuffer *rfb) override;
     void setDirty() override;
     void frameBufferResized() override;
 };
@@ -35,6 +35,15 @@ class ExeTracer(InstTracer):
     cxx_header = "cpu/exetrace.hh"
 
 
+class BinExeTracer(InstTracer):
+    type = "BinExeTracer"
+    cxx_class = "gem5::trace::BinExeTracer"
+    cxx_header = "cpu/bin_exetrace.hh"
+    file_name = Param.String(
+        "", "Name of the binary trace, defaults to <name>.bxt"
+    )
+
+
 class IntelTrace(InstTracer):
     type = "IntelTrace"
     cxx_class = "gem5::trace::IntelTrace"
@@ -43,6 +43,12 @@ class CheckerCPU(BaseCPU):
         True,
         "If a load result is incorrect, only print a warning and do not exit",
     )
+    checkInterval = Param.Unsigned(
+        1,
+        "Fully check on average one in this many committed instructions, "
+        "picked at random. The other instructions only update the "
+        "checker's state with the results of the checked CPU.",
+    )
 
     def generateDeviceTree(self, state):
         # The CheckerCPU is not a real CPU and shouldn't generate a DTB
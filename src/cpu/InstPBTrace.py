@@ -34,3 +34,6 @@ class InstPBTrace(InstTracer):
     cxx_class = "gem5::trace::InstPBTrace"
     cxx_header = "cpu/inst_pb_trace.hh"
     file_name = Param.String("Instruction trace output file")
+    compress_threads = Param.Unsigned(
+        1, "Number of threads compressing the trace in the background"
+    )
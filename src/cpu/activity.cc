@@ -28,6 +28,7 @@
 
 #include "cpu/activity.hh"
 
+#include <algorithm>
 #include <string>
 
 #include "cpu/timebuf.hh"
@@ -121,6 +122,13 @@ ActivityRecorder::deactivateStage(const int idx)
     assert(activityCount >= 0);
 }
 
+bool
+ActivityRecorder::communicating() const
+{
+    return activityCount > std::count(stageActive, stageActive + numStages,
+                                      true);
+}
+
 void
 ActivityRecorder::reset()
 {
@@ -90,6 +90,12 @@ class ActivityRecorder
     /** Returns if the CPU should be active. */
     bool active() { return activityCount; }
 
+    /** Returns if there has been any activity within the last
+     * longestLatency cycles, not counting stages that are merely
+     * marked as active.
+     */
+    bool communicating() const;
+
     /** Clears the time buffer and the activity count. */
     void reset();
 
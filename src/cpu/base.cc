@@ -279,7 +279,7 @@ BaseCPU::mwaitAtomic(ThreadID tid, ThreadContext *tc, BaseMMU *mmu)
     assert(tid < numThreads);
     AddressMonitor &monitor = addressMonitor[tid];
 
-    RequestPtr req = std::make_shared<Request>();
+    RequestPtr req = Request::create();
 
     Addr addr = monitor.vAddr;
     Addr block_size = cacheLineSize();
@@ -381,6 +381,8 @@ BaseCPU::regProbePoints()
     ppRetiredLoads = pmuProbePoint("RetiredLoads");
     ppRetiredStores = pmuProbePoint("RetiredStores");
     ppRetiredBranches = pmuProbePoint("RetiredBranches");
+    ppRetiredCtrl = new ProbePointArg<RetiredCtrlProbeArg>(
+        this->getProbeManager(), "RetiredCtrl");
 
     ppSleeping = new ProbePointArg<bool>(this->getProbeManager(),
                                          "Sleeping");
@@ -404,6 +406,12 @@ BaseCPU::probeInstCommit(const StaticInstPtr &inst, Addr pc)
         ppRetiredBranches->notify(1);
 }
 
+void
+BaseCPU::probeCtrlCommit(const StaticInstPtr &inst, const PCStateBase &pc)
+{
+    ppRetiredCtrl->notify(RetiredCtrlProbeArg{inst, pc});
+}
+
 BaseCPU::
 BaseCPUStats::BaseCPUStats(statistics::Group *parent)
     : statistics::Group(parent),
@@ -80,6 +80,17 @@ struct AddressMonitor
     bool gotWakeup;
 };
 
+/**
+ * Argument of the RetiredCtrl probe point: a committed control
+ * instruction and its PC state, with the next PC resolved by its
+ * execution.
+ */
+struct RetiredCtrlProbeArg
+{
+    const StaticInstPtr &inst;
+    const PCStateBase &pc;
+};
+
 class CPUProgressEvent : public Event
 {
   protected:
@@ -500,6 +511,17 @@ class BaseCPU : public ClockedObject
      */
     virtual void probeInstCommit(const StaticInstPtr &inst, Addr pc);
 
+    /**
+     * Helper method to trigger the probes for a committed control
+     * instruction that did not fault. It is called by the CPU models on
+     * top of probeInstCommit() since the latter does not know the
+     * outcome of the branch.
+     *
+     * @param inst Control instruction that just committed
+     * @param pc PC state of the instruction, with its next PC resolved
+     */
+    void probeCtrlCommit(const StaticInstPtr &inst, const PCStateBase &pc);
+
    protected:
     /**
      * Helper method to instantiate probe points belonging to this
@@ -529,6 +551,9 @@ class BaseCPU : public ClockedObject
     /** Retired branches (any type) */
     probing::PMUUPtr ppRetiredBranches;
 
+    /** Retired branches along with their outcome */
+    ProbePointArg<RetiredCtrlProbeArg> *ppRetiredCtrl;
+
     /** CPU cycle counter even if any thread Context is suspended*/
     probing::PMUUPtr ppAllCycles;
 
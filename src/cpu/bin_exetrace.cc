@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/bin_exetrace.hh"
+
+#include <cstring>
+
+#include "base/byteswap.hh"
+#include "base/cprintf.hh"
+#include "base/loader/symtab.hh"
+#include "base/output.hh"
+#include "cpu/static_inst.hh"
+#include "cpu/thread_context.hh"
+#include "debug/ExecEnable.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+namespace
+{
+
+/** Size of the buffer of records before it is written out */
+const size_t bufferSize = 1 << 20;
+
+template <typename T>
+void
+put(std::vector<uint8_t> &buffer, T val)
+{
+    val = htole(val);
+    const size_t pos = buffer.size();
+    buffer.resize(pos + sizeof(val));
+    std::memcpy(buffer.data() + pos, &val, sizeof(val));
+}
+
+} // anonymous namespace
+
+void
+BinExeTracerRecord::dump()
+{
+    tracer.record(*this);
+}
+
+BinExeTracer::BinExeTracer(const BinExeTracerParams &p)
+    : InstTracer(p),
+      fileName(p.file_name.empty() ? name() + ".bxt" : p.file_name)
+{
+    traceStream = simout.create(fileName, true);
+    traceStream->stream()->write("gem5bxt1", 8);
+    buffer.reserve(bufferSize);
+
+    registerExitCallback([this]() { close(); });
+}
+
+BinExeTracer::~BinExeTracer()
+{
+    close();
+}
+
+InstRecord *
+BinExeTracer::getInstRecord(Tick when, ThreadContext *tc,
+                            const StaticInstPtr si, const PCStateBase &pc,
+                            const StaticInstPtr mi)
+{
+    // Only record the trace if Exec debugging is enabled, like the
+    // other instruction tracers
+    if (!debug::ExecEnable)
+        return nullptr;
+
+    return new BinExeTracerRecord(*this, when, tc, si, pc, mi);
+}
+
+uint32_t
+BinExeTracer::instId(const StaticInstPtr &inst, const PCStateBase &pc)
+{
+    auto [it, inserted] = instIds.emplace(
+        InstKey{inst.get(), pc.instAddr()}, insts.size());
+    if (inserted)
+        insts.emplace_back(inst, pc.clone());
+    return it->second;
+}
+
+void
+BinExeTracer::record(const BinExeTracerRecord &rec)
+{
+    if (!traceStream)
+        return;
+
+    const PCStateBase &pc = rec.getPCState();
+    const StaticInstPtr &inst = rec.staticInst;
+
+    uint8_t flags = 0;
+    const bool data_valid = rec.dataStatus != InstRecord::DataInvalid &&
+        rec.dataStatus != InstRecord::DataReg;
+    if (data_valid)
+        flags |= DataValid;
+    if (rec.getMemValid())
+        flags |= MemValid;
+    if (!rec.predicate)
+        flags |= PredicatedFalse;
+    if (rec.faulting)
+        flags |= Faulting;
+
+    put<uint64_t>(buffer, rec.getWhen());
+    put<uint64_t>(buffer, pc.instAddr());
+    put<uint32_t>(buffer, instId(inst, pc));
+    put<uint16_t>(buffer, pc.microPC());
+    put<uint16_t>(buffer, rec.getThread()->contextId());
+    put<uint8_t>(buffer, flags);
+    if (data_valid)
+        put<uint64_t>(buffer, rec.getIntData());
+    if (rec.getMemValid())
+        put<uint64_t>(buffer, rec.getAddr());
+
+    if (buffer.size() >= bufferSize)
+        flush();
+}
+
+void
+BinExeTracer::flush()
+{
+    traceStream->stream()->write(
+        reinterpret_cast<const char *>(buffer.data()), buffer.size());
+    buffer.clear();
+}
+
+void
+BinExeTracer::close()
+{
+    if (!traceStream)
+        return;
+
+    flush();
+    simout.close(traceStream);
+    traceStream = nullptr;
+
+    OutputStream *table = simout.create(fileName + ".insts");
+    std::ostream &os = *table->stream();
+    for (size_t id = 0; id < insts.size(); ++id) {
+        const auto &[inst, pc] = insts[id];
+        ccprintf(os, "%d\t%#x\t%s\n", id, pc->instAddr(),
+                 disassemble(inst, *pc, &loader::debugSymbolTable));
+    }
+    simout.close(table);
+}
+
+} // namespace trace
+} // namespace gem5
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_BIN_EXETRACE_HH__
+#define __CPU_BIN_EXETRACE_HH__
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/types.hh"
+#include "cpu/static_inst_fwd.hh"
+#include "params/BinExeTracer.hh"
+#include "sim/insttracer.hh"
+
+namespace gem5
+{
+
+class OutputStream;
+class ThreadContext;
+
+namespace trace {
+
+class BinExeTracer;
+
+class BinExeTracerRecord : public InstRecord
+{
+  public:
+    BinExeTracerRecord(BinExeTracer &_tracer, Tick when, ThreadContext *tc,
+                       const StaticInstPtr si, const PCStateBase &pc,
+                       const StaticInstPtr mi = nullptr)
+        : InstRecord(when, tc, si, pc, mi), tracer(_tracer)
+    {}
+
+    /** Append the record to the trace of the tracer */
+    void dump() override;
+
+  protected:
+    BinExeTracer &tracer;
+
+    friend class BinExeTracer;
+};
+
+/**
+ * An instruction tracer writing a compact binary trace of the
+ * committed (micro-)instructions, as a cheaper alternative to the
+ * text output of the ExeTracer. Every record holds the tick, PC,
+ * micro-PC, context, an instruction id, and the result and effective
+ * address when valid. The instructions are identified by their
+ * StaticInst and PC, and only disassembled once per id when the
+ * table of instructions is written at the end of the simulation.
+ * util/decode_exetrace.py turns the trace back into text.
+ *
+ * The trace starts with the magic "gem5bxt1", followed by records in
+ * little endian:
+ *   uint64 tick, uint64 pc, uint32 inst id, uint16 micro-pc,
+ *   uint16 context id, uint8 flags,
+ *   uint64 result (if flags & DataValid),
+ *   uint64 effective address (if flags & MemValid)
+ * The table is written to a text file named after the trace with an
+ * ".insts" suffix, holding a line of "id pc disassembly" per
+ * instruction, separated by tabs.
+ */
+class BinExeTracer : public InstTracer
+{
+  public:
+    BinExeTracer(const BinExeTracerParams &p);
+    ~BinExeTracer();
+
+    InstRecord *getInstRecord(Tick when, ThreadContext *tc,
+                              const StaticInstPtr si, const PCStateBase &pc,
+                              const StaticInstPtr mi = nullptr) override;
+
+    /** Flags of a record */
+    enum RecordFlags : uint8_t
+    {
+        DataValid = 1 << 0,
+        MemValid = 1 << 1,
+        PredicatedFalse = 1 << 2,
+        Faulting = 1 << 3,
+    };
+
+  protected:
+    /** Write a record into the buffer, flushing it when full */
+    void record(const BinExeTracerRecord &rec);
+
+    /** Get the id of an instruction, allocating one the first time */
+    uint32_t instId(const StaticInstPtr &inst, const PCStateBase &pc);
+
+    /** Write the buffered records to the trace */
+    void flush();
+
+    /** Flush the trace and write the table of instructions */
+    void close();
+
+    /** Key identifying an instruction of the table */
+    struct InstKey
+    {
+        const StaticInst *inst;
+        Addr pc;
+
+        bool
+        operator==(const InstKey &other) const
+        {
+            return inst == other.inst && pc == other.pc;
+        }
+    };
+
+    struct InstKeyHash
+    {
+        size_t
+        operator()(const InstKey &key) const
+        {
+            return std::hash<const void *>()(key.inst) ^
+                std::hash<Addr>()(key.pc) * 31;
+        }
+    };
+
+    /** Ids of the instructions seen so far */
+    std::unordered_map<InstKey, uint32_t, InstKeyHash> instIds;
+
+    /**
+     * Instructions of the table by id, kept alive and disassembled
+     * only when the table is written
+     */
+    std::vector<std::pair<StaticInstPtr,
+                          std::unique_ptr<PCStateBase>>> insts;
+
+    /** Name of the trace, and of the table with the suffix added */
+    const std::string fileName;
+
+    OutputStream *traceStream;
+
+    /** Records waiting to be written */
+    std::vector<uint8_t> buffer;
+
+    friend class BinExeTracerRecord;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_BIN_EXETRACE_HH__
@@ -67,7 +67,8 @@ CheckerCPU::CheckerCPU(const Params &p)
       systemPtr(NULL), icachePort(NULL), dcachePort(NULL),
       tc(NULL), thread(NULL),
       unverifiedReq(nullptr),
-      unverifiedMemData(nullptr)
+      unverifiedMemData(nullptr),
+      checkRng(name())
 {
     curStaticInst = NULL;
     curMacroStaticInst = NULL;
@@ -82,6 +83,7 @@ CheckerCPU::CheckerCPU(const Params &p)
 
     exitOnError = p.exitOnError;
     warnOnlyOnLoadError = p.warnOnlyOnLoadError;
+    checkInterval = p.checkInterval;
     mmu = p.mmu;
     workload = p.workload;
 
@@ -154,7 +156,7 @@ CheckerCPU::genMemFragmentRequest(Addr frag_addr, int size,
                                                     size_left));
     auto it_end = byte_enable.cbegin() + (size - size_left);
     if (isAnyActiveElement(it_start, it_end)) {
-        mem_req = std::make_shared<Request>(frag_addr, frag_size,
+        mem_req = Request::create(frag_addr, frag_size,
                 flags, requestorId, thread->pcState().instAddr(),
                 tc->contextId());
         mem_req->setByteEnable(std::vector<bool>(it_start, it_end));
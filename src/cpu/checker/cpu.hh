@@ -47,6 +47,7 @@
 #include <queue>
 
 #include "arch/generic/pcstate.hh"
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "cpu/base.hh"
 #include "cpu/exec_context.hh"
@@ -188,6 +189,15 @@ class CheckerCPU : public BaseCPU, public ExecContext
         thread->getReg(si->srcRegIdx(idx), val);
     }
 
+    const void *
+    getRegOperandRef(const StaticInst *si, int idx, void *val) override
+    {
+        const RegId &reg = si->srcRegIdx(idx);
+        if (si->isDestReg(reg))
+            return ExecContext::getRegOperandRef(si, idx, val);
+        return thread->getReadableReg(reg);
+    }
+
     void *
     getWritableRegOperand(const StaticInst *si, int idx) override
     {
@@ -434,6 +444,11 @@ class CheckerCPU : public BaseCPU, public ExecContext
     bool updateOnError;
     bool warnOnlyOnLoadError;
 
+    /** Fully check one in this many instructions on average. */
+    unsigned checkInterval;
+    /** Picks the instructions that are fully checked. */
+    RandomStream checkRng;
+
     InstSeqNum youngestSN;
 };
 
@@ -467,6 +482,22 @@ class Checker : public CheckerCPU
     void handlePendingInt();
 
   private:
+    /**
+     * Decide whether an instruction has to be fully checked. When
+     * sampling, only instructions whose whole effect on the checker's
+     * state can be taken from their results may be skipped.
+     */
+    bool needsCheck(const DynInstPtr &inst);
+
+    /**
+     * Bring the checker past an instruction that is not checked by
+     * copying its results and following its PC.
+     */
+    void skipInst(const DynInstPtr &inst);
+
+    /** Service PC events at the checker's current PC. */
+    void servicePCEvents();
+
     void
     handleError(const DynInstPtr &inst)
     {
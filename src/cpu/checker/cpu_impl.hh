@@ -78,6 +78,75 @@ Checker<DynInstPtr>::advancePC(const Fault &fault)
         }
     }
 }
+
+template <class DynInstPtr>
+bool
+Checker<DynInstPtr>::needsCheck(const DynInstPtr &inst)
+{
+    if (checkInterval <= 1)
+        return true;
+
+    // Faults, externally changed PCs and serializing instructions all
+    // go through the full path, which knows how to handle them.
+    if (changedPC || inst->getFault() != NoFault ||
+        inst->isSerializing() || inst->isNonSpeculative() ||
+        inst->isSquashAfter()) {
+        return true;
+    }
+
+    // Misc register writes may have side effects that the checked CPU
+    // does not record as a result.
+    for (int i = 0; i < inst->numDestRegs(); i++) {
+        if (inst->destRegIdx(i).classValue() == MiscRegClass)
+            return true;
+    }
+
+    return checkRng.random<unsigned>(0, checkInterval - 1) == 0;
+}
+
+template <class DynInstPtr>
+void
+Checker<DynInstPtr>::skipInst(const DynInstPtr &inst)
+{
+    DPRINTF(Checker, "Skipping instruction [sn:%lli] PC:%s.\n",
+            inst->seqNum, inst->pcState());
+
+    numInst++;
+
+    curStaticInst = inst->staticInst;
+    if (curStaticInst->isMicroop())
+        curMacroStaticInst = inst->macroop;
+
+    copyResult(inst, InstResult(), -1);
+
+    // The instruction's PC state holds its resolved next PC.
+    thread->pcState(inst->pcState());
+    advancePC(NoFault);
+
+    if (FullSystem)
+        servicePCEvents();
+}
+
+template <class DynInstPtr>
+void
+Checker<DynInstPtr>::servicePCEvents()
+{
+    // @todo: Determine if these should happen only if the
+    // instruction hasn't faulted.  In the SimpleCPU case this may
+    // not be true, but in the O3 case this may be true.
+    Addr oldpc;
+    int count = 0;
+    do {
+        oldpc = thread->pcState().instAddr();
+        thread->pcEventQueue.service(oldpc, tc);
+        count++;
+    } while (oldpc != thread->pcState().instAddr());
+    if (count > 1) {
+        willChangePC = true;
+        set(newPCState, thread->pcState());
+        DPRINTF(Checker, "PC Event, PC is now %s\n", *newPCState);
+    }
+}
 //////////////////////////////////////////////////
 
 template <class DynInstPtr>
@@ -200,6 +269,17 @@ Checker<DynInstPtr>::verify(const DynInstPtr &completed_inst)
 
         Fault fault = NoFault;
 
+        if (!needsCheck(unverifiedInst)) {
+            skipInst(unverifiedInst);
+
+            if (!instList.empty() && instList.front()->isCompleted()) {
+                unverifiedInst = instList.front();
+                instList.pop_front();
+                continue;
+            }
+            break;
+        }
+
         // Check if any recent PC changes match up with anything we
         // expect to happen.  This is mostly to check if traps or
         // PC-based events have occurred in both the checker and CPU.
@@ -230,7 +310,7 @@ Checker<DynInstPtr>::verify(const DynInstPtr &completed_inst)
             // If not in the middle of a macro instruction
             if (!curMacroStaticInst) {
                 // set up memory request for instruction fetch
-                auto mem_req = std::make_shared<Request>(
+                auto mem_req = Request::create(
                     fetch_PC, decoder->moreBytesSize(), 0, requestorId,
                     fetch_PC, thread->contextId());
 
@@ -389,23 +469,8 @@ Checker<DynInstPtr>::verify(const DynInstPtr &completed_inst)
            advancePC(fault);
         }
 
-        if (FullSystem) {
-            // @todo: Determine if these should happen only if the
-            // instruction hasn't faulted.  In the SimpleCPU case this may
-            // not be true, but in the O3 case this may be true.
-            Addr oldpc;
-            int count = 0;
-            do {
-                oldpc = thread->pcState().instAddr();
-                thread->pcEventQueue.service(oldpc, tc);
-                count++;
-            } while (oldpc != thread->pcState().instAddr());
-            if (count > 1) {
-                willChangePC = true;
-                set(newPCState, thread->pcState());
-                DPRINTF(Checker, "PC Event, PC is now %s\n", *newPCState);
-            }
-        }
+        if (FullSystem)
+            servicePCEvents();
 
         // @todo:  Optionally can check all registers. (Or just those
         // that have been modified).
@@ -29,10 +29,15 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <cassert>
+#include <map>
+#include <optional>
+#include <thread>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -45,6 +50,59 @@ namespace decode_cache
 template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
+/**
+ * Decoder state shared by all decoders that run on the same host
+ * thread and decode in the same context. The context captures any
+ * decoder state the decoding depends on besides the machine
+ * instruction itself (e.g., operating mode or vector length).
+ *
+ * With a single event queue, every core in the simulation shares one
+ * map per context. With several event queues, each simulation thread
+ * gets its own. This keeps lookups lock free and means the non-atomic
+ * reference counts of StaticInsts are never touched by more than one
+ * thread. Maps are never freed since the instructions handed out from
+ * them must remain valid for the lifetime of the simulation.
+ */
+template <typename Map, typename Context>
+class SharedMap
+{
+  private:
+    std::optional<Context> context;
+    Map *map = nullptr;
+    std::thread::id owner;
+
+  public:
+    /// Switch to the map of a different decoding context.
+    void
+    setContext(const Context &ctx)
+    {
+        if (map && context == ctx)
+            return;
+        context = ctx;
+        map = nullptr;
+    }
+
+    /// Get the map for the current context on the calling thread.
+    Map &
+    get()
+    {
+        if (GEM5_UNLIKELY(!map || owner != std::this_thread::get_id())) {
+            assert(context);
+            thread_local std::map<Context, Map *> maps;
+            auto &entry = maps[*context];
+            if (!entry)
+                entry = new Map;
+            map = entry;
+            owner = std::this_thread::get_id();
+        }
+        return *map;
+    }
+};
+
+/// Decoded instructions shared between decoders, see SharedMap.
+template <typename EMI, typename Context>
+using SharedInstMap = SharedMap<InstMap<EMI>, Context>;
+
 /// A sparse map from an Addr to a Value, stored in page chunks.
 template<class Value, Addr CacheChunkShift = 12>
 class AddrMap
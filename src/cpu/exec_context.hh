@@ -74,6 +74,22 @@ class ExecContext
 
     virtual RegVal getRegOperand(const StaticInst *si, int idx) = 0;
     virtual void getRegOperand(const StaticInst *si, int idx, void *val) = 0;
+
+    /**
+     * Read a source register operand without copying it out. Returns a
+     * pointer to the register's storage, which stays valid while the
+     * instruction executes. If the value could change under the
+     * instruction, e.g. because the register is also one of its
+     * destinations which are written in place, it is copied to val
+     * and val is returned instead.
+     */
+    virtual const void *
+    getRegOperandRef(const StaticInst *si, int idx, void *val)
+    {
+        getRegOperand(si, idx, val);
+        return val;
+    }
+
     virtual void *getWritableRegOperand(const StaticInst *si, int idx) = 0;
     virtual void setRegOperand(const StaticInst *si, int idx, RegVal val) = 0;
     virtual void setRegOperand(const StaticInst *si, int idx,
@@ -73,17 +73,19 @@ InstPBTrace::InstPBTrace(const InstPBTraceParams &p)
     : InstTracer(p), buf(nullptr), bufSize(0), curMsg(nullptr)
 {
     // Create our output file
-    createTraceFile(p.file_name);
+    createTraceFile(p.file_name, p.compress_threads);
 }
 
 void
-InstPBTrace::createTraceFile(std::string filename)
+InstPBTrace::createTraceFile(std::string filename,
+                             unsigned compress_threads)
 {
     // Since there is only one output file for all tracers check if it exists
     if (traceStream)
         return;
 
-    traceStream = new ProtoOutputStream(simout.resolve(filename));
+    traceStream = new ProtoOutputStream(simout.resolve(filename),
+                                        compress_threads);
 
     // Output the header
     ProtoMessage::InstHeader header_msg;
@@ -111,8 +111,9 @@ class InstPBTrace : public InstTracer
     /** Create the output file and write the header into it
      * @param filename the file to create (if ends with .gz it will be
      * compressed)
+     * @param compress_threads threads compressing the file in the background
      */
-    void createTraceFile(std::string filename);
+    void createTraceFile(std::string filename, unsigned compress_threads);
 
     /** If there is a pending message still write it out and then close the file
      */
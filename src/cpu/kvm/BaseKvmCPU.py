@@ -75,6 +75,16 @@ class BaseKvmCPU(BaseCPU):
     alwaysSyncTC = Param.Bool(
         False, "Always sync thread contexts on entry/exit"
     )
+    preciseInstStop = Param.Bool(
+        False,
+        "Stop exactly at instruction count events by single-stepping the "
+        "last instructions before them (requires usePerf)",
+    )
+    instStopSkid = Param.UInt64(
+        1000,
+        "Instructions before an instruction count event at which the perf "
+        "counter hands over to single-stepping (preciseInstStop only)",
+    )
 
     hostFreq = Param.Clock("2GHz", "Host clock frequency")
     hostFactor = Param.Float(1.0, "Cycle scale factor")
@@ -46,5 +46,12 @@ class KvmVM(SimObject):
     coalescedMMIO = VectorParam.AddrRange(
         [], "memory ranges for coalesced MMIO"
     )
+    doorbells = VectorParam.Addr(
+        [], "doorbell registers (e.g., virtqueue notify) that don't exit"
+    )
+    doorbellSize = Param.Unsigned(4, "size of a doorbell register in bytes")
+    doorbellValues = Param.Unsigned(
+        8, "number of doorbell values (e.g., virtqueues) to match"
+    )
 
     system = Param.System(Parent.any, "system this VM belongs to")
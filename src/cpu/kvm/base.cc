@@ -44,6 +44,7 @@
 
 #include <cerrno>
 #include <csignal>
+#include <cstring>
 #include <ostream>
 
 #include "base/compiler.hh"
@@ -69,8 +70,11 @@ BaseKvmCPU::BaseKvmCPU(const BaseKvmCPUParams &params)
       dataPort(name() + ".dcache_port", this),
       instPort(name() + ".icache_port", this),
       alwaysSyncTC(params.alwaysSyncTC),
-      threadContextDirty(true),
-      kvmStateDirty(false),
+      preciseInstStop(params.preciseInstStop),
+      instStopSkid(params.instStopSkid),
+      singleStepping(false),
+      threadContextDirty(AllState),
+      kvmStateDirty(0),
       usePerf(params.usePerf),
       vcpuID(-1), vcpuFD(-1), vcpuMMapSize(0),
       _kvmRun(NULL), mmioRing(NULL),
@@ -105,6 +109,9 @@ BaseKvmCPU::BaseKvmCPU(const BaseKvmCPUParams &params)
               "perfControlledByTimer without usePerf\n");
     }
 
+    fatal_if(preciseInstStop && !usePerf,
+             "KVM: preciseInstStop needs usePerf to count instructions\n");
+
     // If we use perf, we create new PerfKVMCounters
     if (usePerf) {
         hwCycles = std::unique_ptr<PerfKvmCounter>(new PerfKvmCounter());
@@ -175,6 +182,10 @@ BaseKvmCPU::startup()
         inform("KVM: Coalesced not supported by host OS\n");
     }
 
+    fatal_if(preciseInstStop && !kvm.capSetGuestDebug(),
+             "KVM: preciseInstStop needs single-stepping support from the "
+             "host OS\n");
+
     schedule(new EventFunctionWrapper([this]{
                 restartEqThread();
             }, name(), true), curTick());
@@ -290,13 +301,20 @@ BaseKvmCPU::StatGroup::StatGroup(statistics::Group *parent)
              "number of VM exits due to memory mapped IO"),
     ADD_STAT(numCoalescedMMIO, statistics::units::Count::get(),
              "number of coalesced memory mapped IO requests"),
+    ADD_STAT(numDoorbells, statistics::units::Count::get(),
+             "number of doorbell writes delivered to devices"),
+    ADD_STAT(numDoorbellWrites, statistics::units::Count::get(),
+             "number of guest doorbell writes that didn't cause an exit"),
     ADD_STAT(numIO, statistics::units::Count::get(),
              "number of VM exits due to legacy IO"),
     ADD_STAT(numHalt, statistics::units::Count::get(),
              "number of VM exits due to wait for interrupt instructions"),
     ADD_STAT(numInterrupts, statistics::units::Count::get(),
              "number of interrupts delivered"),
-    ADD_STAT(numHypercalls, statistics::units::Count::get(), "number of hypercalls")
+    ADD_STAT(numHypercalls, statistics::units::Count::get(), "number of hypercalls"),
+    ADD_STAT(numSingleSteps, statistics::units::Count::get(),
+             "number of instructions single-stepped to reach an instruction "
+             "count event")
 {
 }
 
@@ -321,7 +339,7 @@ BaseKvmCPU::unserializeThread(CheckpointIn &cp, ThreadID tid)
     assert(tid == 0);
     assert(_status == Idle);
     thread->unserialize(cp);
-    threadContextDirty = true;
+    threadContextDirty = AllState;
 }
 
 DrainState
@@ -482,8 +500,8 @@ BaseKvmCPU::takeOverFrom(BaseCPU *cpu)
     // TC as dirty. This is not ideal from a performance point of
     // view, but it makes debugging easier as it allows meaningful KVM
     // state to be dumped before and after a takeover.
-    updateKvmState();
-    threadContextDirty = false;
+    updateKvmState(AllState);
+    threadContextDirty = 0;
 }
 
 void
@@ -625,7 +643,7 @@ BaseKvmCPU::tick()
               curEventQueue()->nextTick() - curTick() : 0);
 
           if (alwaysSyncTC)
-              threadContextDirty = true;
+              threadContextDirty = AllState;
 
           // We might need to update the KVM state.
           syncKvmState();
@@ -656,7 +674,7 @@ BaseKvmCPU::tick()
           // Entering into KVM implies that we'll have to reload the thread
           // context from KVM if we want to access it. Flag the KVM state as
           // dirty with respect to the cached thread context.
-          kvmStateDirty = true;
+          kvmStateDirty = AllState;
 
           if (alwaysSyncTC)
               syncThreadContext();
@@ -673,6 +691,11 @@ BaseKvmCPU::tick()
           // Service any pending instruction events. The vCPU should
           // have exited in time for the event using the instruction
           // counter configured by setupInstStop().
+          if (preciseInstStop && ctrInsts > nextInstEvent) {
+              warn_once("KVM: Overshot an instruction event by %i "
+                        "instructions, consider increasing instStopSkid.\n",
+                        ctrInsts - nextInstEvent);
+          }
           queue.serviceEvents(ctrInsts);
 
           if (tryDrain())
@@ -819,7 +842,7 @@ BaseKvmCPU::kvmRun(Tick ticks)
 
     ++stats.numVMExits;
 
-    return ticksExecuted + flushCoalescedMMIO();
+    return ticksExecuted + flushCoalescedMMIO() + flushDoorbells();
 }
 
 void
@@ -963,15 +986,16 @@ BaseKvmCPU::getAndFormatOneReg(uint64_t id) const
 }
 
 void
-BaseKvmCPU::syncThreadContext()
+BaseKvmCPU::syncThreadContext(StateMask groups)
 {
-    if (!kvmStateDirty)
+    groups &= kvmStateDirty;
+    if (!groups)
         return;
 
     assert(!threadContextDirty);
 
-    updateThreadContext();
-    kvmStateDirty = false;
+    updateThreadContext(groups);
+    kvmStateDirty &= ~groups;
 }
 
 void
@@ -982,8 +1006,8 @@ BaseKvmCPU::syncKvmState()
 
     assert(!kvmStateDirty);
 
-    updateKvmState();
-    threadContextDirty = false;
+    updateKvmState(threadContextDirty);
+    threadContextDirty = 0;
 }
 
 Tick
@@ -1053,6 +1077,9 @@ BaseKvmCPU::handleKvmExit()
          * tick. */
         return 0;
 
+      case KVM_EXIT_DEBUG:
+        return handleKvmExitDebug();
+
       case KVM_EXIT_INTERNAL_ERROR:
         panic("KVM: Internal error (suberror: %u)\n",
               _kvmRun->internal.suberror);
@@ -1085,6 +1112,17 @@ BaseKvmCPU::handleKvmExitIRQWindowOpen()
 }
 
 
+Tick
+BaseKvmCPU::handleKvmExitDebug()
+{
+    panic_if(!singleStepping, "KVM: Unexpected debug exit\n");
+
+    // A single step towards an instruction event. The instruction
+    // counter has already accounted for it.
+    ++stats.numSingleSteps;
+    return 0;
+}
+
 Tick
 BaseKvmCPU::handleKvmExitUnknown()
 {
@@ -1114,9 +1152,9 @@ Tick
 BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
 {
     ThreadContext *tc(thread->getTC());
-    syncThreadContext();
+    syncThreadContext(mmioState());
 
-    RequestPtr mmio_req = std::make_shared<Request>(
+    RequestPtr mmio_req = Request::create(
         paddr, size, Request::UNCACHEABLE, dataRequestorId());
 
     mmio_req->setContext(tc->contextId());
@@ -1135,6 +1173,8 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
     pkt->dataStatic(data);
 
     if (mmio_req->isLocalAccess()) {
+        syncThreadContext();
+
         // Since the PC has already been advanced by KVM, set the next
         // PC to the current PC. KVM doesn't use that value, and that
         // way any gem5 op or syscall which needs to know what the next
@@ -1150,7 +1190,9 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
         // different event queue when doing local accesses. Currently, they
         // are only used for m5ops, so it should be a valid assumption.
         const Cycles ipr_delay = mmio_req->localAccessor(tc, pkt);
-        threadContextDirty = true;
+        // Local accessors only implement m5ops, which return their
+        // result in a register.
+        threadContextDirty |= RegState;
         delete pkt;
         return clockPeriod() * ipr_delay;
     } else {
@@ -1220,6 +1262,30 @@ BaseKvmCPU::flushCoalescedMMIO()
     return ticks;
 }
 
+Tick
+BaseKvmCPU::flushDoorbells()
+{
+    Tick ticks(0);
+    for (const auto &db : vm->getDoorbells()) {
+        uint64_t count;
+        // The eventfd is non-blocking, so this fails with EAGAIN if
+        // the guest hasn't rung the doorbell.
+        if (read(db.fd, &count, sizeof(count)) != sizeof(count))
+            continue;
+
+        DPRINTF(KvmIO, "KVM: Handling doorbell (addr: 0x%x, value: %i, "
+                "writes: %i)\n", db.addr, db.value, count);
+
+        ++stats.numDoorbells;
+        stats.numDoorbellWrites += count;
+        uint8_t data[sizeof(db.value)];
+        memcpy(data, &db.value, db.size);
+        ticks += doMMIOAccess(db.addr, data, db.size, true);
+    }
+
+    return ticks;
+}
+
 /**
  * Dummy handler for KVM kick signals.
  *
@@ -1366,13 +1432,44 @@ BaseKvmCPU::setupInstStop()
 {
     if (thread->comInstEventQueue.empty()) {
         setupInstCounter(0);
+        setSingleStep(false);
     } else {
         Tick next = thread->comInstEventQueue.nextTick();
         assert(next > ctrInsts);
-        setupInstCounter(next - ctrInsts);
+        const uint64_t remaining(next - ctrInsts);
+        if (!preciseInstStop) {
+            setupInstCounter(remaining);
+        } else if (remaining > instStopSkid) {
+            // Stop short of the event so that the skid of the
+            // overflow signal doesn't take us past it.
+            setupInstCounter(remaining - instStopSkid);
+            setSingleStep(false);
+        } else {
+            setupInstCounter(0);
+            setSingleStep(true);
+        }
     }
 }
 
+void
+BaseKvmCPU::setSingleStep(bool enable)
+{
+    if (enable == singleStepping)
+        return;
+
+    struct kvm_guest_debug dbg;
+    std::memset(&dbg, 0, sizeof(dbg));
+    if (enable)
+        dbg.control = KVM_GUESTDBG_ENABLE | KVM_GUESTDBG_SINGLESTEP;
+
+    if (ioctl(KVM_SET_GUEST_DEBUG, (void *)&dbg) == -1)
+        panic("KVM: Failed to set guest debug flags (errno: %i)\n", errno);
+
+    DPRINTF(KvmRun, "KVM: %s single-stepping\n",
+            enable ? "Starting" : "Stopping");
+    singleStepping = enable;
+}
+
 void
 BaseKvmCPU::setupInstCounter(uint64_t period)
 {
@@ -409,32 +409,70 @@ class BaseKvmCPU : public BaseCPU
      */
     std::string getAndFormatOneReg(uint64_t id) const;
 
+    /**
+     * Groups of architectural state which can be transferred between
+     * gem5 and KVM independently of each other. Each group usually
+     * maps to one or a few KVM ioctls.
+     */
+    enum StateGroup : uint32_t
+    {
+        /** Integer registers, flags and the PC */
+        RegState = 1 << 0,
+        /** FP and SIMD registers */
+        FPState = 1 << 1,
+        /** Control, segment and system registers, MSRs, etc. */
+        SysState = 1 << 2,
+        AllState = RegState | FPState | SysState
+    };
+
+    /** A set of StateGroup bits */
+    typedef uint32_t StateMask;
+
     /** @{ */
     /**
      * Update the KVM state from the current thread context
      *
      * The base CPU calls this method before starting the guest CPU
-     * when the contextDirty flag is set. The architecture dependent
-     * CPU implementation is expected to update all guest state
-     * (registers, special registers, and FPU state).
+     * when the thread context is dirty. The architecture dependent
+     * CPU implementation is expected to update at least the guest
+     * state in the requested groups, and may update more. The whole
+     * thread context is up to date when this is called.
+     *
+     * @param groups StateGroups which have been modified in gem5.
      */
-    virtual void updateKvmState() = 0;
+    virtual void updateKvmState(StateMask groups) = 0;
 
     /**
      * Update the current thread context with the KVM state
      *
      * The base CPU after the guest updates any of the KVM state. In
      * practice, this happens after kvmRun is called. The architecture
-     * dependent code is expected to read the state of the guest CPU
-     * and update gem5's thread state.
+     * dependent code is expected to read at least the requested
+     * groups of the guest CPU state and update gem5's thread state.
+     *
+     * @param groups StateGroups which should be read from KVM.
      */
-    virtual void updateThreadContext() = 0;
+    virtual void updateThreadContext(StateMask groups) = 0;
 
     /**
-     * Update a thread context if the KVM state is dirty with respect
-     * to the cached thread context.
+     * Update parts of a thread context if the KVM state is dirty with
+     * respect to the cached thread context.
+     *
+     * Syncing only some groups is meant for reading the thread
+     * context. Code which is going to modify the thread context has to
+     * sync all of it first and then flag what it modified in
+     * threadContextDirty.
+     *
+     * @param groups StateGroups to bring up to date.
      */
-    void syncThreadContext();
+    void syncThreadContext(StateMask groups=AllState);
+
+    /**
+     * State which BaseMMU::finalizePhysical() needs when handling an
+     * MMIO exit. Everything else is only fetched from KVM if the
+     * access has to be handled by gem5 itself (e.g., an m5op).
+     */
+    virtual StateMask mmioState() const { return AllState; }
 
     /**
      * Get a pointer to the event queue owning devices.
@@ -520,6 +558,16 @@ class BaseKvmCPU : public BaseCPU
      * @return Number of ticks delay the next CPU tick
      */
     virtual Tick handleKvmExitFailEntry();
+
+    /**
+     * The guest completed a single step
+     *
+     * This only happens when stepping towards an instruction count
+     * event, see preciseInstStop.
+     *
+     * @return Number of ticks delay the next CPU tick
+     */
+    virtual Tick handleKvmExitDebug();
     /** @} */
 
     /**
@@ -642,16 +690,30 @@ class BaseKvmCPU : public BaseCPU
     const bool alwaysSyncTC;
 
     /**
-     * Is the gem5 context dirty? Set to true to force an update of
-     * the KVM vCPU state upon the next call to kvmRun().
+     * Land exactly on instruction count events. The instruction
+     * counter signals instStopSkid instructions before an event, and
+     * the remaining instructions are single-stepped.
      */
-    bool threadContextDirty;
+    const bool preciseInstStop;
+
+    /** Instructions before an event at which single-stepping starts */
+    const uint64_t instStopSkid;
+
+    /** Is the vCPU currently being single-stepped? */
+    bool singleStepping;
 
     /**
-     * Is the KVM state dirty? Set to true to force an update of
-     * the KVM vCPU state upon the next call to kvmRun().
+     * StateGroups which have been modified in the gem5 context. Set
+     * them to force an update of the KVM vCPU state upon the next call
+     * to kvmRun().
      */
-    bool kvmStateDirty;
+    StateMask threadContextDirty;
+
+    /**
+     * StateGroups of the KVM state which are newer than the gem5
+     * context and which have to be read back before they are used.
+     */
+    StateMask kvmStateDirty;
 
     /** True if using perf; False otherwise*/
     bool usePerf;
@@ -672,6 +734,17 @@ class BaseKvmCPU : public BaseCPU
      */
     Tick flushCoalescedMMIO();
 
+    /**
+     * Service doorbells the guest rang since the last exit.
+     *
+     * Each doorbell written at least once is delivered to the device
+     * as a single write, regardless of how many times the guest wrote
+     * to it.
+     *
+     * @return Number of ticks spent servicing the doorbells
+     */
+    Tick flushDoorbells();
+
     /**
      * Setup a signal handler to catch the timer signal used to
      * switch back to the monitor.
@@ -739,6 +812,9 @@ class BaseKvmCPU : public BaseCPU
      */
     void setupInstStop();
 
+    /** Enable or disable single-stepping the guest */
+    void setSingleStep(bool enable);
+
     /** @{ */
     /** Setup hardware performance counters */
     void setupCounters();
@@ -812,10 +888,13 @@ class BaseKvmCPU : public BaseCPU
         statistics::Scalar numExitSignal;
         statistics::Scalar numMMIO;
         statistics::Scalar numCoalescedMMIO;
+        statistics::Scalar numDoorbells;
+        statistics::Scalar numDoorbellWrites;
         statistics::Scalar numIO;
         statistics::Scalar numHalt;
         statistics::Scalar numInterrupts;
         statistics::Scalar numHypercalls;
+        statistics::Scalar numSingleSteps;
     } stats;
     /* @} */
 
@@ -40,6 +40,7 @@
 
 #include <fcntl.h>
 #include <linux/kvm.h>
+#include <sys/eventfd.h>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -138,6 +139,16 @@ Kvm::capCoalescedMMIO() const
     return checkExtension(KVM_CAP_COALESCED_MMIO);
 }
 
+bool
+Kvm::capIOEventFD() const
+{
+#ifdef KVM_CAP_IOEVENTFD
+    return checkExtension(KVM_CAP_IOEVENTFD) != 0;
+#else
+    return false;
+#endif
+}
+
 int
 Kvm::capNumMemSlots() const
 {
@@ -184,6 +195,16 @@ Kvm::capDebugRegs() const
 #endif
 }
 
+bool
+Kvm::capSetGuestDebug() const
+{
+#ifdef KVM_CAP_SET_GUEST_DEBUG
+    return checkExtension(KVM_CAP_SET_GUEST_DEBUG) != 0;
+#else
+    return false;
+#endif
+}
+
 bool
 Kvm::capXCRs() const
 {
@@ -329,10 +350,18 @@ KvmVM::KvmVM(const KvmVMParams &params)
     /* Setup the coalesced MMIO regions */
     for (int i = 0; i < params.coalescedMMIO.size(); ++i)
         coalesceMMIO(params.coalescedMMIO[i]);
+    /* Setup the doorbell registers */
+    for (auto addr : params.doorbells) {
+        for (int value = 0; value < params.doorbellValues; ++value)
+            registerDoorbell(addr, params.doorbellSize, value);
+    }
 }
 
 KvmVM::~KvmVM()
 {
+    for (const auto &db : doorbells)
+        close(db.fd);
+
     if (vmFD != -1)
         close(vmFD);
 
@@ -343,6 +372,12 @@ KvmVM::~KvmVM()
 void
 KvmVM::notifyFork()
 {
+    for (const auto &db : doorbells) {
+        if (close(db.fd) == -1)
+            warn("kvm VM: notifyFork failed to close doorbell fd\n");
+    }
+    doorbells.clear();
+
     if (vmFD != -1) {
         if (close(vmFD) == -1)
             warn("kvm VM: notifyFork failed to close vmFD\n");
@@ -499,6 +534,34 @@ KvmVM::coalesceMMIO(Addr start, int size)
               errno);
 }
 
+void
+KvmVM::registerDoorbell(Addr addr, int size, uint64_t value)
+{
+    if (!kvm->capIOEventFD())
+        fatal("KVM: ioeventfd doorbells are not supported by the host\n");
+    if (size != 1 && size != 2 && size != 4 && size != 8)
+        fatal("KVM: Unsupported doorbell size (%i)\n", size);
+
+    const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd == -1)
+        panic("KVM: Failed to create doorbell eventfd (%i)\n", errno);
+
+    struct kvm_ioeventfd ioeventfd;
+    memset(&ioeventfd, 0, sizeof(ioeventfd));
+    ioeventfd.datamatch = value;
+    ioeventfd.addr = addr;
+    ioeventfd.len = size;
+    ioeventfd.fd = fd;
+    ioeventfd.flags = KVM_IOEVENTFD_FLAG_DATAMATCH;
+
+    DPRINTF(Kvm, "KVM: Registering doorbell at 0x%x (size: %i, value: %i)\n",
+            addr, size, value);
+    if (ioctl(KVM_IOEVENTFD, (void *)&ioeventfd) == -1)
+        panic("KVM: Failed to register doorbell (%i)\n", errno);
+
+    doorbells.push_back(Doorbell{addr, size, value, fd});
+}
+
 void
 KvmVM::setTSSAddress(Addr tss_address)
 {
@@ -114,6 +114,9 @@ class Kvm
      */
     int capCoalescedMMIO() const;
 
+    /** Support for KvmVM::registerDoorbell() */
+    bool capIOEventFD() const;
+
     /**
      * Attempt to determine how many memory slots are available. If it can't
      * be determined, this function returns 0.
@@ -140,6 +143,9 @@ class Kvm
     /** Support for getting and setting the kvm_debugregs structure. */
     bool capDebugRegs() const;
 
+    /** Support for single-stepping the guest (KVM_SET_GUEST_DEBUG) */
+    bool capSetGuestDebug() const;
+
     /** Support for getting and setting the x86 XCRs. */
     bool capXCRs() const;
 
@@ -333,6 +339,37 @@ class KvmVM : public SimObject
     void coalesceMMIO(const AddrRange &range);
     /** @} */
 
+    /**
+     * Doorbell register serviced through an ioeventfd.
+     *
+     * Guest writes of value to addr complete in the kernel without
+     * exiting to gem5. The kernel counts them in the eventfd, which
+     * the vCPUs poll after every exit from KVM.
+     */
+    struct Doorbell
+    {
+        Addr addr;
+        int size;
+        uint64_t value;
+        int fd;
+    };
+
+    /**
+     * Register a doorbell register that doesn't cause VM exits.
+     *
+     * Repeated writes between two polls are merged into a single
+     * write, so this must only be used for registers where that is
+     * harmless, such as virtqueue notification registers.
+     *
+     * @param addr Physical address of the register in the guest
+     * @param size Size of the register in bytes (1, 2, 4, or 8)
+     * @param value Value the guest must write to ring the doorbell
+     */
+    void registerDoorbell(Addr addr, int size, uint64_t value);
+
+    /** Get the doorbells registered with this VM */
+    const std::vector<Doorbell> &getDoorbells() const { return doorbells; }
+
     /**
      * @addtogroup KvmInterrupts
      * @{
@@ -557,6 +594,9 @@ class KvmVM : public SimObject
     };
     std::vector<MemorySlot> memorySlots;
     uint32_t maxMemorySlot;
+
+    /** Doorbell registers using ioeventfds */
+    std::vector<Doorbell> doorbells;
 };
 
 } // namespace gem5
@@ -45,6 +45,7 @@
 #define __CPU_MINOR_BUFFERS_HH__
 
 #include <iostream>
+#include <new>
 #include <queue>
 #include <sstream>
 #include <string>
@@ -175,6 +176,23 @@ class MinorBuffer : public Named, public TimeBuffer<ElemType>
     { }
 
   public:
+    /** Like TimeBuffer::advance, but only reset the slot which becomes
+     *  the input if it holds anything but a bubble.  Most slots of
+     *  a pipeline are bubbles most of the time and those can be left to
+     *  be written over as they are */
+    void
+    advance()
+    {
+        if (++this->base >= this->size)
+            this->base = 0;
+
+        ElemType &slot = (*this)[this->future];
+        if (!BubbleTraits::isBubble(slot)) {
+            slot.~ElemType();
+            new (&slot) ElemType;
+        }
+    }
+
     /* Is this buffer full of only bubbles */
     bool
     empty() const
@@ -357,7 +375,7 @@ class SelfStallingPipeline : public MinorBuffer<ElemType, ReportTraits>
         bool data_at_end = isPopable();
 
         if (!stalled) {
-            TimeBuffer<ElemType>::advance();
+            MinorBuffer<ElemType, ReportTraits>::advance();
             /* If there was data at the end of the pipe that has now been
              *  advanced out of the pipe, we've lost data */
             if (data_at_end)
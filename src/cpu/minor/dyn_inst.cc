@@ -53,6 +53,29 @@ namespace gem5
 namespace minor
 {
 
+namespace
+{
+
+/* Freed instructions are kept on a free list, linked through their own
+ *  storage, up to a cap big enough for the instructions in flight in a
+ *  handful of CPUs.  Caching is disabled with the address sanitizer so
+ *  that use-after-free errors are still caught */
+#if defined(__SANITIZE_ADDRESS__)
+constexpr unsigned int maxFreeInsts = 0;
+#else
+constexpr unsigned int maxFreeInsts = 1024;
+#endif
+
+struct FreeInst
+{
+    FreeInst *next;
+};
+
+thread_local FreeInst *freeInsts = nullptr;
+thread_local unsigned int numFreeInsts = 0;
+
+} // anonymous namespace
+
 const InstSeqNum InstId::firstStreamSeqNum;
 const InstSeqNum InstId::firstPredictionSeqNum;
 const InstSeqNum InstId::firstLineSeqNum;
@@ -83,6 +106,32 @@ MinorDynInstPtr MinorDynInst::bubbleInst = []() {
     return inst;
 }();
 
+void *
+MinorDynInst::operator new(size_t size)
+{
+    assert(size == sizeof(MinorDynInst));
+
+    if (!freeInsts)
+        return ::operator new(size);
+
+    FreeInst *inst = freeInsts;
+    freeInsts = inst->next;
+    numFreeInsts--;
+    return inst;
+}
+
+void
+MinorDynInst::operator delete(void *ptr)
+{
+    if (numFreeInsts >= maxFreeInsts) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    freeInsts = new (ptr) FreeInst{freeInsts};
+    numFreeInsts++;
+}
+
 bool
 MinorDynInst::isLastOpInInst() const
 {
@@ -282,6 +282,11 @@ class MinorDynInst : public RefCounted
     void setMemAccPredicate(bool val) { memAccPredicate = val; }
 
     ~MinorDynInst();
+
+    /** MinorDynInsts are recycled through a free list rather than given
+     *  back to the host allocator each time one retires */
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
 };
 
 /** Print a summary of the instruction */
@@ -158,6 +158,15 @@ class ExecContext : public gem5::ExecContext
         thread.getReg(si->srcRegIdx(idx), val);
     }
 
+    const void *
+    getRegOperandRef(const StaticInst *si, int idx, void *val) override
+    {
+        const RegId &reg = si->srcRegIdx(idx);
+        if (si->isDestReg(reg))
+            return ExecContext::getRegOperandRef(si, idx, val);
+        return thread.getReadableReg(reg);
+    }
+
     void *
     getWritableRegOperand(const StaticInst *si, int idx) override
     {
@@ -243,6 +243,9 @@ Execute::tryToBranch(MinorDynInstPtr inst, Fault fault, BranchData &branch)
     BranchData::Reason reason = BranchData::NoBranch;
 
     if (fault == NoFault) {
+        if (inst->isInst() && inst->staticInst->isControl())
+            cpu.probeCtrlCommit(inst->staticInst, *target);
+
         inst->staticInst->advancePC(*target);
         thread->pcState(*target);
 
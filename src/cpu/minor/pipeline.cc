@@ -131,8 +131,15 @@ Pipeline::evaluate()
      *  'immediate', 0-time-offset TimeBuffer activity to be visible from
      *  later stages to earlier ones in the same cycle */
     execute.evaluate();
-    decode.evaluate();
-    fetch2.evaluate();
+
+    /* Decode and Fetch2 hold no state of their own beyond what is
+     *  waiting in their input latch and buffers, so skip them while
+     *  those are empty (and no branch needs Fetch2's attention) */
+    if (!decode.isDrained())
+        decode.evaluate();
+    if (!fetch2.isDrained() || !eToF1.empty())
+        fetch2.evaluate();
+
     fetch1.evaluate();
 
     if (debug::MinorTrace)
@@ -91,6 +91,28 @@ class BaseO3CPU(BaseCPU):
     fetchQueueSize = Param.Unsigned(
         32, "Fetch queue size in micro-ops per-thread"
     )
+    uopCacheEntries = Param.Unsigned(
+        0,
+        "Number of instructions the micro-op cache holds the expansion "
+        "of, 0 to leave it out",
+    )
+    uopCacheAssoc = Param.Unsigned(8, "Micro-op cache associativity")
+    legacyDecodeWidth = Param.Unsigned(
+        4,
+        "Micro-ops per cycle the decoders supply when the micro-op "
+        "cache misses",
+    )
+    macroFusion = Param.Bool(
+        False,
+        "Fetch a compare followed by a conditional branch in a single "
+        "fetch slot",
+    )
+    ftqSize = Param.Unsigned(
+        0,
+        "Fetch blocks the branch target buffer may predict ahead of "
+        "fetch and prefetch into the I-cache, 0 to leave the fetch "
+        "target queue out",
+    )
 
     renameToDecodeDelay = Param.Cycles(1, "Rename to decode delay")
     iewToDecodeDelay = Param.Cycles(
@@ -171,6 +193,19 @@ class BaseO3CPU(BaseCPU):
     # most ISAs don't use condition-code regs, so default is 0
     numPhysCCRegs = Param.Unsigned(0, "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
+    tickElision = Param.Bool(
+        False,
+        "Stop ticking while every stage is waiting on an outstanding "
+        "memory access or FU completion, and resume when it completes. "
+        "Timing is unchanged, but per-stage stall cycle stats don't count "
+        "the skipped cycles.",
+    )
+    iqWakeupMatrix = Param.Bool(
+        False,
+        "Track dependences in the instruction queue with a bit-vector "
+        "wakeup matrix rather than per-register linked lists. Timing is "
+        "identical, but wide cores with large windows simulate faster.",
+    )
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
@@ -66,6 +66,7 @@
 #include "params/BaseO3CPU.hh"
 #include "sim/faults.hh"
 #include "sim/full_system.hh"
+#include "sim/timeline.hh"
 
 namespace gem5
 {
@@ -655,6 +656,25 @@ Commit::tick()
     updateStatus();
 }
 
+bool
+Commit::waitingOnMemory(ThreadID tid) const
+{
+    if (commitStatus[tid] != Running || trapInFlight[tid] ||
+        trapSquash[tid] || tcSquash[tid] || squashAfterInst[tid] ||
+        drainPending || interrupt != NoFault ||
+        (FullSystem && cpu->checkInterrupts(0))) {
+        return false;
+    }
+
+    if (rob->isEmpty(tid))
+        return false;
+
+    // The response or writeback of the instruction wakes the CPU up
+    const DynInstPtr &head = rob->readHeadInst(tid);
+    return head->isMemRef() && head->isIssued() && !head->isSquashed() &&
+        !head->readyToCommit();
+}
+
 void
 Commit::handleInterrupt()
 {
@@ -1267,7 +1287,7 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
     rob->retireHead(tid);
 
 #if TRACING_ON
-    if (debug::O3PipeView) {
+    if (debug::O3PipeView || timeline::enabled()) {
         head_inst->commitTick = curTick() - head_inst->fetchTick;
     }
 #endif
@@ -190,6 +190,12 @@ class Commit
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /**
+     * Is the thread unable to do anything until the memory
+     * instruction at the head of its ROB completes?
+     */
+    bool waitingOnMemory(ThreadID tid) const;
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
@@ -107,6 +107,15 @@ CPU::CPU(const BaseO3CPUParams &params)
       decodeQueue(params.backComSize, params.forwardComSize),
       renameQueue(params.backComSize, params.forwardComSize),
       iewQueue(params.backComSize, params.forwardComSize),
+      // Instructions in flight are bounded by the ROB plus those
+      // still travelling between fetch and dispatch
+      _instArena(DynInstArena::create(params.numROBEntries +
+                  params.numThreads * params.fetchQueueSize +
+                  params.fetchWidth * (params.fetchToDecodeDelay +
+                                       params.decodeToRenameDelay +
+                                       params.renameToIEWDelay))),
+      tickElision(params.tickElision),
+      tickElided(false),
       activityRec(name(), NumStages,
                   params.backComSize + params.forwardComSize,
                   params.activity),
@@ -336,8 +345,8 @@ CPU::regProbePoints()
     commit.regProbePoints();
 }
 
-CPU::CPUStats::CPUStats(CPU *cpu)
-    : statistics::Group(cpu),
+CPU::CPUStats::CPUStats(CPU *_cpu)
+    : statistics::Group(_cpu), cpu(_cpu),
       ADD_STAT(timesIdled, statistics::units::Count::get(),
                "Number of times that the entire CPU went into an idle state "
                "and unscheduled itself"),
@@ -346,7 +355,17 @@ CPU::CPUStats::CPUStats(CPU *cpu)
                "to idling"),
       ADD_STAT(quiesceCycles, statistics::units::Cycle::get(),
                "Total number of cycles that CPU has spent quiesced or waiting "
-               "for an interrupt")
+               "for an interrupt"),
+      ADD_STAT(elidedCycles, statistics::units::Cycle::get(),
+               "Total number of cycles that the CPU skipped while waiting "
+               "on memory"),
+      ADD_STAT(peakLiveInsts, statistics::units::Count::get(),
+               "Largest number of dynamic instructions alive at once"),
+      ADD_STAT(instArenaHits, statistics::units::Count::get(),
+               "Number of dynamic instructions allocated from recycled "
+               "memory"),
+      ADD_STAT(instArenaMisses, statistics::units::Count::get(),
+               "Number of dynamic instructions allocated from the host")
 {
     // Register any of the O3CPU's stats here.
     timesIdled
@@ -357,6 +376,28 @@ CPU::CPUStats::CPUStats(CPU *cpu)
 
     quiesceCycles
         .prereq(quiesceCycles);
+
+    elidedCycles
+        .prereq(elidedCycles);
+
+    peakLiveInsts
+        .functor([cpu=_cpu]() { return cpu->instArena()->peakLive(); });
+    instArenaHits
+        .functor([cpu=_cpu]() { return cpu->instArena()->hits(); });
+    instArenaMisses
+        .functor([cpu=_cpu]() { return cpu->instArena()->misses(); });
+}
+
+void
+CPU::CPUStats::resetStats()
+{
+    statistics::Group::resetStats();
+    cpu->instArena()->resetStats();
+}
+
+CPU::~CPU()
+{
+    _instArena->retire();
 }
 
 void
@@ -368,6 +409,7 @@ CPU::tick()
 
     ++baseStats.numCycles;
     updateCycleCounters(BaseCPU::CPU_STATE_ON);
+    tickElided = false;
 
 //    activity = false;
 
@@ -405,6 +447,10 @@ CPU::tick()
             DPRINTF(O3CPU, "Idle!\n");
             lastRunningCycle = curCycle();
             cpuStats.timesIdled++;
+        } else if (canElideTick()) {
+            DPRINTF(O3CPU, "Waiting on memory, eliding ticks!\n");
+            lastRunningCycle = curCycle();
+            tickElided = true;
         } else {
             schedule(tickEvent, clockEdge(Cycles(1)));
             DPRINTF(O3CPU, "Scheduling next tick!\n");
@@ -1002,6 +1048,22 @@ CPU::getReg(PhysRegIdPtr phys_reg, void *val, ThreadID tid)
     regFile.getReg(phys_reg, val);
 }
 
+const void *
+CPU::getReadableReg(PhysRegIdPtr phys_reg, ThreadID tid)
+{
+    switch (phys_reg->classValue()) {
+      case VecRegClass:
+        executeStats[tid]->numVecRegReads++;
+        break;
+      case VecPredRegClass:
+        executeStats[tid]->numVecPredRegReads++;
+        break;
+      default:
+        break;
+    }
+    return regFile.getReadableReg(phys_reg);
+}
+
 void *
 CPU::getWritableReg(PhysRegIdPtr phys_reg, ThreadID tid)
 {
@@ -1154,6 +1216,8 @@ CPU::instDone(ThreadID tid, const DynInstPtr &inst)
     commitStats[tid]->numOpsNotNOP++;
 
     probeInstCommit(inst->staticInst, inst->pcState().instAddr());
+    if (inst->isControl())
+        probeCtrlCommit(inst->staticInst, inst->pcState());
 }
 
 void
@@ -1315,7 +1379,7 @@ CPU::wakeDependents(const DynInstPtr &inst)
 void
 CPU::wakeCPU()
 {
-    if (activityRec.active() || tickEvent.scheduled()) {
+    if ((activityRec.active() && !tickElided) || tickEvent.scheduled()) {
         DPRINTF(Activity, "CPU already running.\n");
         return;
     }
@@ -1326,18 +1390,51 @@ CPU::wakeCPU()
     // @todo: This is an oddity that is only here to match the stats
     if (cycles > 1) {
         --cycles;
-        cpuStats.idleCycles += cycles;
+        if (tickElided)
+            cpuStats.elidedCycles += cycles;
+        else
+            cpuStats.idleCycles += cycles;
         baseStats.numCycles += cycles;
     }
 
-    schedule(tickEvent, clockEdge());
+    if (tickElided) {
+        // Resume on the cycle the tick would have run on, which is
+        // never the cycle that has already been ticked
+        tickElided = false;
+        schedule(tickEvent, curCycle() == lastRunningCycle ?
+                 clockEdge(Cycles(1)) : clockEdge());
+    } else {
+        schedule(tickEvent, clockEdge());
+    }
+}
+
+bool
+CPU::canElideTick()
+{
+    // Nothing may be in flight between the stages, and only the
+    // stages with outstanding memory accesses may be active
+    if (!tickElision || activityRec.communicating() ||
+        removeInstsThisCycle || drainState() == DrainState::Draining) {
+        return false;
+    }
+
+    for (ThreadID tid : activeThreads) {
+        if (!commit.waitingOnMemory(tid))
+            return false;
+    }
+
+    return !activeThreads.empty() && iew.waitingOnEvents();
 }
 
 void
 CPU::wakeup(ThreadID tid)
 {
-    if (thread[tid]->status() != gem5::ThreadContext::Suspended)
+    if (thread[tid]->status() != gem5::ThreadContext::Suspended) {
+        // An interrupt needs the tick to be running to be noticed
+        if (tickElided)
+            wakeCPU();
         return;
+    }
 
     wakeCPU();
 
@@ -1457,7 +1554,7 @@ CPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
     RequestPtr req =
-        std::make_shared<Request>(addr, size, flags, _dataRequestorId);
+        Request::create(addr, size, flags, _dataRequestorId);
 
     req->taskId(taskId());
     req->setContext(thread[tid]->contextId());
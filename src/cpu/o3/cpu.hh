@@ -54,6 +54,7 @@
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
 #include "cpu/o3/decode.hh"
+#include "cpu/o3/dyn_inst_arena.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
@@ -69,6 +70,7 @@
 #include "cpu/timebuf.hh"
 #include "params/BaseO3CPU.hh"
 #include "sim/process.hh"
+#include "sim/timeline.hh"
 
 namespace gem5
 {
@@ -173,9 +175,14 @@ class CPU : public BaseCPU
     /** Constructs a CPU with the given parameters. */
     CPU(const BaseO3CPUParams &params);
 
+    ~CPU();
+
     ProbePointArg<PacketPtr> *ppInstAccessComplete;
     ProbePointArg<std::pair<DynInstPtr, PacketPtr> > *ppDataAccessComplete;
 
+    /** Picks the committed instructions recorded in the timeline. */
+    timeline::Sampler timelineSampler;
+
     /** Register probe points. */
     void regProbePoints() override;
 
@@ -283,6 +290,16 @@ class CPU : public BaseCPU
     /** Get the current instruction sequence number, and increment it. */
     InstSeqNum getAndIncrementInstSeq() { return globalSeqNum++; }
 
+    /**
+     * Returns if every stage is waiting for a memory access or FU
+     * completion, which will wake the CPU up, so that the tick can be
+     * descheduled without changing timing.
+     */
+    bool canElideTick();
+
+    /** Get the arena dynamic instructions are allocated from. */
+    DynInstArena *instArena() const { return _instArena; }
+
     /** Traps to handle given fault. */
     void trap(const Fault &fault, ThreadID tid, const StaticInstPtr &inst);
 
@@ -315,6 +332,7 @@ class CPU : public BaseCPU
 
     RegVal getReg(PhysRegIdPtr phys_reg, ThreadID tid);
     void getReg(PhysRegIdPtr phys_reg, void *val, ThreadID tid);
+    const void *getReadableReg(PhysRegIdPtr phys_reg, ThreadID tid);
     void *getWritableReg(PhysRegIdPtr phys_reg, ThreadID tid);
 
     void setReg(PhysRegIdPtr phys_reg, RegVal val, ThreadID tid);
@@ -477,6 +495,15 @@ class CPU : public BaseCPU
     TimeBuffer<IEWStruct> iewQueue;
 
   private:
+    /** Recycles the memory of dynamic instructions. */
+    DynInstArena *_instArena;
+
+    /** Whether ticks may be skipped while only waiting on memory. */
+    const bool tickElision;
+
+    /** Whether the tick is descheduled while stages are active. */
+    bool tickElided;
+
     /** The activity recorder; used to tell if the CPU has any
      * activity remaining or if it can go to idle and deschedule
      * itself.
@@ -577,6 +604,10 @@ class CPU : public BaseCPU
     {
         CPUStats(CPU *cpu);
 
+        void resetStats() override;
+
+        CPU *cpu;
+
         /** Stat for total number of times the CPU is descheduled. */
         statistics::Scalar timesIdled;
         /** Stat for total number of cycles the CPU spends descheduled. */
@@ -584,6 +615,17 @@ class CPU : public BaseCPU
         /** Stat for total number of cycles the CPU spends descheduled due to a
          * quiesce operation or waiting for an interrupt. */
         statistics::Scalar quiesceCycles;
+        /** Stat for total number of cycles the CPU skipped while
+         * waiting on memory. */
+        statistics::Scalar elidedCycles;
+
+        /** Stat for the largest number of dynamic instructions alive at
+         * once, including squashed ones not freed yet. */
+        statistics::Value peakLiveInsts;
+        /** Stats for dynamic instructions allocated from recycled memory
+         * and from the host allocator. */
+        statistics::Value instArenaHits;
+        statistics::Value instArenaMisses;
     } cpuStats;
 
   public:
@@ -50,6 +50,7 @@
 #include "debug/O3PipeView.hh"
 #include "params/BaseO3CPU.hh"
 #include "sim/full_system.hh"
+#include "sim/timeline.hh"
 
 // clang complains about std::set being overloaded with Packet::set if
 // we open up the entire namespace std
@@ -687,7 +688,7 @@ Decode::decodeInsts(ThreadID tid)
         --insts_available;
 
 #if TRACING_ON
-        if (debug::O3PipeView) {
+        if (debug::O3PipeView || timeline::enabled()) {
             inst->decodeTick = curTick() - inst->fetchTick;
         }
 #endif
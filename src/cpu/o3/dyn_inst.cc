@@ -46,6 +46,7 @@
 #include "debug/DynInst.hh"
 #include "debug/IQ.hh"
 #include "debug/O3PipeView.hh"
+#include "sim/timeline.hh"
 
 namespace gem5
 {
@@ -168,7 +169,8 @@ DynInst::operator new(size_t count, Arrays &arrays)
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
     // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    uint8_t *buf =
+        (uint8_t *)DynInstArena::allocate(arrays.arena, total_size);
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -187,13 +189,13 @@ DynInst::operator new(size_t count, Arrays &arrays)
     return buf;
 }
 
-// Because of the custom "new" operator that allocates more bytes than the
-// size of the DynInst object, AddressSanitizer throw new-delete-type-mismatch.
-// Adding a custom delete function is enough to shut down this false positive
+// The buffer comes from the CPU's arena, which recycles it. This also keeps
+// AddressSanitizer from reporting a new-delete-type-mismatch, as the custom
+// "new" operator allocates more bytes than the size of the DynInst object.
 void
 DynInst::operator delete(void *ptr)
 {
-    ::operator delete(ptr);
+    DynInstArena::release(ptr);
 }
 
 DynInst::~DynInst()
@@ -249,6 +251,11 @@ DynInst::~DynInst()
                     val, valS);
         }
     }
+
+    if (timeline::enabled() && fetchTick != -1 && commitTick != -1 &&
+        cpu->timelineSampler()) {
+        recordTimeline();
+    }
 #endif
 
     delete [] memData;
@@ -267,6 +274,46 @@ DynInst::~DynInst()
 #endif
 };
 
+#if TRACING_ON
+void
+DynInst::recordTimeline() const
+{
+    const Tick fetch = fetchTick;
+    const std::string track = cpu->name() + ".pipeline";
+
+    // The instruction as a whole, with a nested slice for each stage it
+    // went through, from when it entered the stage until it entered the
+    // next one. Stores then wait for their data to be written back.
+    const std::pair<const char *, int32_t> stages[] = {
+        {"fetch", 0}, {"decode", decodeTick}, {"rename", renameTick},
+        {"dispatch", dispatchTick}, {"issue", issueTick},
+        {"complete", completeTick}, {"store", commitTick},
+        {nullptr, storeTick},
+    };
+    const Tick end = fetch + std::max(commitTick, storeTick);
+
+    timeline::asyncSlice(track, staticInst->disassemble(pcState().instAddr()),
+                         seqNum, fetch, end, {
+                             {"sn", std::to_string(seqNum)},
+                             {"pc", csprintf("%#x", pcState().instAddr())},
+                             {"upc", std::to_string(pcState().microPC())},
+                             {"thread", std::to_string(threadNumber)},
+                         });
+
+    const char *stage = nullptr;
+    Tick stage_start = 0;
+    for (const auto &[next, offset]: stages) {
+        if (offset == -1)
+            continue;
+        if (stage)
+            timeline::asyncSlice(track, stage, seqNum, stage_start,
+                                 fetch + offset);
+        stage = next;
+        stage_start = fetch + offset;
+    }
+}
+#endif
+
 
 #ifdef GEM5_DEBUG
 void
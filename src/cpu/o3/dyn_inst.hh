@@ -56,6 +56,7 @@
 #include "cpu/inst_res.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst_arena.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
@@ -92,6 +93,9 @@ class DynInst : public ExecContext, public RefCounted
         PhysRegIdPtr *prevDestIdx;
         PhysRegIdPtr *srcIdx;
         uint8_t *readySrcIdx;
+
+        /** Arena to allocate the instruction from, if any. */
+        DynInstArena *arena = nullptr;
     };
 
     static void *operator new(size_t count, Arrays &arrays);
@@ -995,6 +999,13 @@ class DynInst : public ExecContext, public RefCounted
     int32_t completeTick = -1;
     int32_t commitTick = -1;
     int32_t storeTick = -1;
+
+  private:
+    /** Record the pipeline stages of a committed instruction in the
+     * simulation timeline. */
+    void recordTimeline() const;
+
+  public:
 #endif
 
     /* Values used by LoadToUse stat */
@@ -1128,6 +1139,14 @@ class DynInst : public ExecContext, public RefCounted
         cpu->getReg(reg, val, threadNumber);
     }
 
+    /** Sources and destinations are always different physical registers,
+     *  so sources can be read in place. */
+    const void *
+    getRegOperandRef(const StaticInst *si, int idx, void *val) override
+    {
+        return cpu->getReadableReg(renamedSrcIdx(idx), threadNumber);
+    }
+
     void *
     getWritableRegOperand(const StaticInst *si, int idx) override
     {
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/dyn_inst_arena.hh"
+
+#include <algorithm>
+#include <new>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+namespace
+{
+
+#if defined(__SANITIZE_ADDRESS__)
+constexpr bool cachingEnabled = false;
+#else
+constexpr bool cachingEnabled = true;
+#endif
+
+} // anonymous namespace
+
+DynInstArena *
+DynInstArena::create(size_t capacity)
+{
+    return new DynInstArena(capacity);
+}
+
+DynInstArena::DynInstArena(size_t _capacity)
+    : capacity(cachingEnabled ? _capacity : 0)
+{
+}
+
+DynInstArena::~DynInstArena()
+{
+    for (auto &head : freeLists) {
+        while (head) {
+            FreeBlock *next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+    }
+}
+
+void
+DynInstArena::retire()
+{
+    retired = true;
+    if (_live == 0)
+        delete this;
+}
+
+void *
+DynInstArena::allocate(DynInstArena *arena, size_t size)
+{
+    if (arena)
+        return arena->allocate(size);
+
+    auto *header = static_cast<Header *>(
+        ::operator new(sizeof(Header) + size));
+    header->arena = nullptr;
+    header->sizeClass = 0;
+    return header + 1;
+}
+
+void *
+DynInstArena::allocate(size_t size)
+{
+    const size_t cls = divCeil(sizeof(Header) + size, granularity);
+
+    void *block;
+    if (cls <= numClasses && freeLists[cls]) {
+        block = freeLists[cls];
+        freeLists[cls] = freeLists[cls]->next;
+        --cached;
+        ++_hits;
+    } else {
+        block = ::operator new(cls * granularity);
+        ++_misses;
+    }
+
+    _peakLive = std::max(_peakLive, ++_live);
+
+    auto *header = static_cast<Header *>(block);
+    header->arena = this;
+    header->sizeClass = cls <= numClasses ? cls : 0;
+    return header + 1;
+}
+
+void
+DynInstArena::release(void *ptr)
+{
+    auto *header = static_cast<Header *>(ptr) - 1;
+    if (header->arena)
+        header->arena->release(header);
+    else
+        ::operator delete(header);
+}
+
+void
+DynInstArena::release(Header *header)
+{
+    const uint32_t cls = header->sizeClass;
+    --_live;
+
+    if (!retired && cls != 0 && cached < capacity) {
+        auto *block = reinterpret_cast<FreeBlock *>(header);
+        block->next = freeLists[cls];
+        freeLists[cls] = block;
+        ++cached;
+    } else {
+        ::operator delete(header);
+    }
+
+    if (retired && _live == 0)
+        delete this;
+}
+
+void
+DynInstArena::resetStats()
+{
+    _peakLive = _live;
+    _hits = 0;
+    _misses = 0;
+}
+
+} // namespace o3
+} // namespace gem5
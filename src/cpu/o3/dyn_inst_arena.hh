@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_ARENA_HH__
+#define __CPU_O3_DYN_INST_ARENA_HH__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Recycles the memory of a CPU's dynamic instructions.
+ *
+ * Every fetched instruction, including those on the wrong path, needs
+ * a buffer for the DynInst and its register index arrays, and the
+ * buffer is freed again when the instruction commits or is squashed.
+ * The arena keeps freed buffers on free lists, one per multiple of
+ * granularity bytes, so that fetch can reuse them instead of going
+ * to the host allocator. There are never more instructions in flight
+ * than the pipeline can hold, so the number of cached buffers is
+ * capped at the capacity the arena is created with.
+ *
+ * Each buffer starts with a small header pointing back to its arena,
+ * which is all operator delete needs to return it. Buffers may outlive
+ * the CPU owning the arena, e.g. when an instruction is still
+ * referenced by an outstanding memory request. The CPU therefore
+ * retire()s the arena rather than deleting it, and the arena deletes
+ * itself once its last buffer is released.
+ *
+ * Caching is disabled when building with the address sanitizer so
+ * that use-after-free errors are still caught.
+ */
+class DynInstArena
+{
+  public:
+    static constexpr size_t granularity = 64;
+    static constexpr size_t maxBlockSize = 4096;
+
+    /** Create an arena caching up to capacity free buffers. */
+    static DynInstArena *create(size_t capacity);
+
+    /** Tell the arena its owner is gone. */
+    void retire();
+
+    /**
+     * Allocate a buffer of at least size bytes. If arena is null the
+     * buffer comes from the host allocator, but can still be freed
+     * with release().
+     */
+    static void *allocate(DynInstArena *arena, size_t size);
+
+    /** Free a buffer returned by allocate(). */
+    static void release(void *ptr);
+
+    /** Number of buffers currently handed out. */
+    uint64_t live() const { return _live; }
+    /** Largest number of buffers handed out at once. */
+    uint64_t peakLive() const { return _peakLive; }
+    /** Allocations served from a free list. */
+    uint64_t hits() const { return _hits; }
+    /** Allocations that went to the host allocator. */
+    uint64_t misses() const { return _misses; }
+
+    /** Restart the counters, e.g. when stats are reset. */
+    void resetStats();
+
+  private:
+    static constexpr size_t numClasses = maxBlockSize / granularity;
+
+    struct alignas(alignof(std::max_align_t)) Header
+    {
+        DynInstArena *arena;
+        /** Size class of the buffer; 0 if it is not recycled. */
+        uint32_t sizeClass;
+    };
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    explicit DynInstArena(size_t capacity);
+    ~DynInstArena();
+
+    void *allocate(size_t size);
+    void release(Header *header);
+
+    std::array<FreeBlock *, numClasses + 1> freeLists{};
+
+    const size_t capacity;
+    size_t cached = 0;
+    bool retired = false;
+
+    uint64_t _live = 0;
+    uint64_t _peakLive = 0;
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_DYN_INST_ARENA_HH__
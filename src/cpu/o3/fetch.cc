@@ -68,6 +68,7 @@
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
 #include "sim/system.hh"
+#include "sim/timeline.hh"
 
 namespace gem5
 {
@@ -77,13 +78,20 @@ namespace o3
 
 Fetch::IcachePort::IcachePort(Fetch *_fetch, CPU *_cpu) :
         RequestPort(_cpu->name() + ".icache_port"), fetch(_fetch)
-{}
+{
+    setTimingRespHandler(&directTimingResp);
+}
 
 
 Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
     : fetchPolicy(params.smtFetchPolicy),
       cpu(_cpu),
       branchPred(nullptr),
+      uopCache(params.uopCacheEntries, params.uopCacheAssoc),
+      legacyDecodeWidth(params.legacyDecodeWidth),
+      macroFusion(params.macroFusion),
+      ftqSize(params.ftqSize),
+      ftqPrefetchesInFlight(0),
       decodeToFetchDelay(params.decodeToFetchDelay),
       renameToFetchDelay(params.renameToFetchDelay),
       iewToFetchDelay(params.iewToFetchDelay),
@@ -122,6 +130,7 @@ Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
         pc[i].reset(params.isa[0]->newPCState());
         fetchOffset[i] = 0;
         macroop[i] = nullptr;
+        uopCacheHit[i] = false;
         delayedCommit[i] = false;
         memReq[i] = nullptr;
         stalls[i] = {false, false};
@@ -130,6 +139,11 @@ Fetch::Fetch(CPU *_cpu, const BaseO3CPUParams &params)
         fetchBufferValid[i] = false;
         lastIcacheStall[i] = 0;
         issuePipelinedIfetch[i] = false;
+        ftqPC[i] = 0;
+        ftqHalted[i] = false;
+        ftqVPage[i] = 0;
+        ftqPPage[i] = 0;
+        ftqPageValid[i] = false;
     }
 
     branchPred = params.branchPred;
@@ -190,6 +204,21 @@ Fetch::FetchStatGroup::FetchStatGroup(CPU *cpu, Fetch *fetch)
              "Number of outstanding Icache misses that were squashed"),
     ADD_STAT(tlbSquashes, statistics::units::Count::get(),
              "Number of outstanding ITLB misses that were squashed"),
+    ADD_STAT(uopCacheHits, statistics::units::Count::get(),
+             "Number of instructions found in the micro-op cache"),
+    ADD_STAT(uopCacheMisses, statistics::units::Count::get(),
+             "Number of instructions that missed in the micro-op cache"),
+    ADD_STAT(fusedInsts, statistics::units::Count::get(),
+             "Number of instructions fused with the instruction before"),
+    ADD_STAT(ftqBlocks, statistics::units::Count::get(),
+             "Number of fetch blocks predicted into the fetch target queue"),
+    ADD_STAT(ftqResteers, statistics::units::Count::get(),
+             "Number of times fetch left the predicted fetch blocks"),
+    ADD_STAT(ftqPrefetches, statistics::units::Count::get(),
+             "Number of I-cache prefetches of predicted fetch blocks"),
+    ADD_STAT(ftqUntranslated, statistics::units::Count::get(),
+             "Number of predicted fetch blocks not prefetched for lack of "
+             "a translation"),
     ADD_STAT(nisnDist, statistics::units::Count::get(),
              "Number of instructions fetched each cycle (Total)"),
     ADD_STAT(idleRate, statistics::units::Ratio::get(),
@@ -226,6 +255,20 @@ Fetch::FetchStatGroup::FetchStatGroup(CPU *cpu, Fetch *fetch)
             .prereq(icacheSquashes);
         tlbSquashes
             .prereq(tlbSquashes);
+        uopCacheHits
+            .prereq(uopCacheHits);
+        uopCacheMisses
+            .prereq(uopCacheMisses);
+        fusedInsts
+            .prereq(fusedInsts);
+        ftqBlocks
+            .prereq(ftqBlocks);
+        ftqResteers
+            .prereq(ftqResteers);
+        ftqPrefetches
+            .prereq(ftqPrefetches);
+        ftqUntranslated
+            .prereq(ftqUntranslated);
         nisnDist
             .init(/* base value */ 0,
               /* last value */ fetch->fetchWidth,
@@ -277,6 +320,7 @@ Fetch::clearStates(ThreadID tid)
     set(pc[tid], cpu->pcState(tid));
     fetchOffset[tid] = 0;
     macroop[tid] = NULL;
+    uopCacheHit[tid] = false;
     delayedCommit[tid] = false;
     memReq[tid] = NULL;
     stalls[tid].decode = false;
@@ -284,6 +328,8 @@ Fetch::clearStates(ThreadID tid)
     fetchBufferPC[tid] = 0;
     fetchBufferValid[tid] = false;
     fetchQueue[tid].clear();
+    resteerFetchTargets(tid, pc[tid]->instAddr());
+    ftqPageValid[tid] = false;
 
     // TODO not sure what to do with priorityList for now
     // priorityList.push_back(tid);
@@ -293,6 +339,8 @@ void
 Fetch::resetStage()
 {
     numInst = 0;
+    fetchSlots = 0;
+    legacyUops = 0;
     interruptPending = false;
     cacheBlocked = false;
 
@@ -304,6 +352,7 @@ Fetch::resetStage()
         set(pc[tid], cpu->pcState(tid));
         fetchOffset[tid] = 0;
         macroop[tid] = NULL;
+        uopCacheHit[tid] = false;
 
         delayedCommit[tid] = false;
         memReq[tid] = NULL;
@@ -316,6 +365,9 @@ Fetch::resetStage()
 
         fetchQueue[tid].clear();
 
+        resteerFetchTargets(tid, pc[tid]->instAddr());
+        ftqPageValid[tid] = false;
+
         priorityList.push_back(tid);
     }
 
@@ -326,6 +378,14 @@ Fetch::resetStage()
 void
 Fetch::processCacheCompletion(PacketPtr pkt)
 {
+    if (pkt->req->isPrefetch()) {
+        // A fetch target queue prefetch, nothing waits for its data.
+        assert(ftqPrefetchesInFlight);
+        --ftqPrefetchesInFlight;
+        delete pkt;
+        return;
+    }
+
     ThreadID tid = cpu->contextToThread(pkt->req->contextId());
 
     DPRINTF(Fetch, "[tid:%i] Waking up from cache miss.\n", tid);
@@ -419,7 +479,7 @@ Fetch::isDrained() const
      * cycle if the finish translation event is scheduled, so make
      * sure that's not the case.
      */
-    return !finishTranslationEvent.scheduled();
+    return !finishTranslationEvent.scheduled() && !ftqPrefetchesInFlight;
 }
 
 void
@@ -427,6 +487,7 @@ Fetch::takeOverFrom()
 {
     assert(cpu->getInstPort().isConnected());
     resetStage();
+    uopCache.clear();
 
 }
 
@@ -482,6 +543,15 @@ Fetch::deactivateThread(ThreadID tid)
     }
 }
 
+bool
+Fetch::isFusableCompare(const DynInstPtr &inst)
+{
+    // The compares x86 fuses with the conditional jump after them.
+    const StaticInstPtr &si = inst->macroop ? inst->macroop : inst->staticInst;
+    const std::string name = si->getName();
+    return name == "cmp" || name == "test";
+}
+
 bool
 Fetch::lookupAndUpdateNextPC(const DynInstPtr &inst, PCStateBase &next_pc)
 {
@@ -552,13 +622,16 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Align the fetch address to the start of a fetch buffer segment.
     Addr fetchBufferBlockPC = fetchBufferAlignPC(vaddr);
 
+    if (ftqSize)
+        consumeFetchTargets(tid, vaddr);
+
     DPRINTF(Fetch, "[tid:%i] Fetching cache line %#x for addr %#x\n",
             tid, fetchBufferBlockPC, vaddr);
 
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = Request::create(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instRequestorId(), pc,
         cpu->thread[tid]->contextId());
@@ -608,6 +681,11 @@ Fetch::finishTranslation(const Fault &fault, const RequestPtr &mem_req)
             return;
         }
 
+        // Let the fetch target queue prefetch from the same page.
+        ftqVPage[tid] = fetchBufferBlockPC & ~(ftqPageBytes - 1);
+        ftqPPage[tid] = mem_req->getPaddr() & ~(ftqPageBytes - 1);
+        ftqPageValid[tid] = true;
+
         // Build packet here.
         PacketPtr data_pkt = new Packet(mem_req, MemCmd::ReadReq);
         data_pkt->dataDynamic(new uint8_t[fetchBufferSize]);
@@ -640,7 +718,7 @@ Fetch::finishTranslation(const Fault &fault, const RequestPtr &mem_req)
         }
     } else {
         // Don't send an instruction to decode if we can't handle it.
-        if (!(numInst < fetchWidth) ||
+        if (!(fetchSlots < fetchWidth) ||
                 !(fetchQueue[tid].size() < fetchQueueSize)) {
             assert(!finishTranslationEvent.scheduled());
             finishTranslationEvent.setFault(fault);
@@ -724,6 +802,9 @@ Fetch::doSquash(const PCStateBase &new_pc, const DynInstPtr squashInst,
     // Empty fetch queue
     fetchQueue[tid].clear();
 
+    if (ftqSize)
+        resteerFetchTargets(tid, new_pc.instAddr());
+
     // microops are being squashed, it is not known wheather the
     // youngest non-squashed microop was  marked delayed commit
     // or not. Setting the flag to true ensures that the
@@ -867,6 +948,15 @@ Fetch::tick()
         }
     }
 
+    // Run the branch target buffer ahead of fetch, one block per cycle,
+    // and prefetch the blocks it predicts fetch will need.
+    if (ftqSize) {
+        for (auto tid : *activeThreads) {
+            predictFetchTarget(tid);
+            prefetchFetchTarget(tid);
+        }
+    }
+
     // Send instructions enqueued into the fetch queue to decode.
     // Limit rate by fetchWidth.  Stall if decode is stalled.
     unsigned insts_to_decode = 0;
@@ -912,6 +1002,8 @@ Fetch::tick()
 
     // Reset the number of the instruction we've fetched.
     numInst = 0;
+    fetchSlots = 0;
+    legacyUops = 0;
 }
 
 bool
@@ -1027,6 +1119,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
     DynInst::Arrays arrays;
     arrays.numSrcs = staticInst->numSrcRegs();
     arrays.numDests = staticInst->numDestRegs();
+    arrays.arena = cpu->instArena();
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction = new (arrays) DynInst(
@@ -1056,7 +1149,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
 
     // Write the instruction to the first slot in the queue
     // that heads to decode.
-    assert(numInst < fetchWidth);
+    assert(fetchSlots < fetchWidth);
     fetchQueue[tid].push_back(instruction);
     assert(fetchQueue[tid].size() <= fetchQueueSize);
     DPRINTF(Fetch, "[tid:%i] Fetch queue entry created (%i/%i).\n",
@@ -1171,6 +1264,10 @@ Fetch::fetch(bool &status_change)
     // Need to halt fetch if quiesce instruction detected
     bool quiesce = false;
 
+    // Whether the last macroop fetched this cycle was a compare that a
+    // conditional branch can be fused with.
+    bool after_compare = false;
+
     const unsigned numInsts = fetchBufferSize / instSize;
     unsigned blkOffset = (fetchAddr - fetchBufferPC[tid]) / instSize;
 
@@ -1180,8 +1277,9 @@ Fetch::fetch(bool &status_change)
     // Loop through instruction memory from the cache.
     // Keep issuing while fetchWidth is available and branch is not
     // predicted taken
-    while (numInst < fetchWidth && fetchQueue[tid].size() < fetchQueueSize
-           && !predictedBranch && !quiesce) {
+    while (fetchBandwidthLeft(tid) &&
+           fetchQueue[tid].size() < fetchQueueSize &&
+           !predictedBranch && !quiesce) {
         // We need to process more memory if we aren't going to get a
         // StaticInst from the rom, the current macroop, or what's already
         // in the decoder.
@@ -1223,6 +1321,15 @@ Fetch::fetch(bool &status_change)
                     // Increment stat of fetched instructions.
                     cpu->fetchStats[tid]->numInsts++;
 
+                    if (uopCache.enabled()) {
+                        uopCacheHit[tid] =
+                            uopCache.access(this_pc.instAddr());
+                        if (uopCacheHit[tid])
+                            ++fetchStats.uopCacheHits;
+                        else
+                            ++fetchStats.uopCacheMisses;
+                    }
+
                     if (staticInst->isMacroop()) {
                         curMacroop = staticInst;
                     } else {
@@ -1253,9 +1360,15 @@ Fetch::fetch(bool &status_change)
 
             ppFetch->notify(instruction);
             numInst++;
+            if (uopCache.enabled() && !uopCacheHit[tid])
+                legacyUops++;
+            if (after_compare && instruction->isCondCtrl())
+                ++fetchStats.fusedInsts;
+            else
+                fetchSlots++;
 
 #if TRACING_ON
-            if (debug::O3PipeView) {
+            if (debug::O3PipeView || timeline::enabled()) {
                 instruction->fetchTick = curTick();
             }
 #endif
@@ -1281,6 +1394,7 @@ Fetch::fetch(bool &status_change)
                 blkOffset = (fetchAddr - fetchBufferPC[tid]) / instSize;
                 pcOffset = 0;
                 curMacroop = NULL;
+                after_compare = macroFusion && isFusableCompare(instruction);
             }
 
             if (instruction->isQuiesce()) {
@@ -1292,7 +1406,7 @@ Fetch::fetch(bool &status_change)
                 break;
             }
         } while ((curMacroop || dec_ptr->instReady()) &&
-                 numInst < fetchWidth &&
+                 fetchBandwidthLeft(tid) &&
                  fetchQueue[tid].size() < fetchQueueSize);
 
         // Re-evaluate whether the next instruction to fetch is in micro-op ROM
@@ -1303,7 +1417,7 @@ Fetch::fetch(bool &status_change)
     if (predictedBranch) {
         DPRINTF(Fetch, "[tid:%i] Done fetching, predicted branch "
                 "instruction encountered.\n", tid);
-    } else if (numInst >= fetchWidth) {
+    } else if (!fetchBandwidthLeft(tid)) {
         DPRINTF(Fetch, "[tid:%i] Done fetching, reached fetch bandwidth "
                 "for this cycle.\n", tid);
     } else if (blkOffset >= fetchBufferSize) {
@@ -1531,6 +1645,129 @@ Fetch::pipelineIcacheAccesses(ThreadID tid)
     }
 }
 
+void
+Fetch::predictFetchTarget(ThreadID tid)
+{
+    if (ftqHalted[tid] || ftq[tid].size() >= ftqSize)
+        return;
+
+    const Addr start = ftqPC[tid];
+    const Addr block_end = fetchBufferAlignPC(start) + fetchBufferSize;
+    const Addr step = Addr(1) << branchPred->getInstShiftAmt();
+    Addr end = block_end;
+    Addr next = block_end;
+
+    // The block ends at the first branch the BTB predicts taken. Only the
+    // BTB is consulted: the direction predictors can only be advanced by
+    // real predictions, so conditional branches are assumed taken when
+    // they go backwards and not taken otherwise.
+    for (Addr addr = start; addr < block_end; addr += step) {
+        if (!branchPred->BTBValid(tid, addr))
+            continue;
+
+        const StaticInstPtr inst = branchPred->BTBGetInst(tid, addr);
+        if (inst && inst->isReturn()) {
+            // The return address stack can't be read without disturbing
+            // it, so wait for fetch to get past the return.
+            end = addr + step;
+            ftqHalted[tid] = true;
+            break;
+        }
+
+        const PCStateBase *target = branchPred->BTBPeekTarget(tid, addr);
+        if (!target ||
+                (inst && inst->isCondCtrl() && target->instAddr() > addr))
+            continue;
+
+        end = addr + step;
+        next = target->instAddr();
+        break;
+    }
+
+    DPRINTF(Fetch, "[tid:%i] Predicted fetch block [%#x, %#x), next block "
+            "at %#x.\n", tid, start, end, next);
+
+    ftq[tid].push_back({start, end, false});
+    ftqPC[tid] = next;
+    ++fetchStats.ftqBlocks;
+}
+
+void
+Fetch::prefetchFetchTarget(ThreadID tid)
+{
+    if (cacheBlocked || stalls[tid].drain)
+        return;
+
+    for (auto &target : ftq[tid]) {
+        if (target.prefetched)
+            continue;
+        target.prefetched = true;
+
+        Addr block = fetchBufferAlignPC(target.start);
+        if (block == fetchBufferPC[tid])
+            continue;
+
+        // Prefetches don't walk the page table: they are only sent for
+        // the page fetch translated last.
+        if (!ftqPageValid[tid] ||
+                (block & ~(ftqPageBytes - 1)) != ftqVPage[tid]) {
+            ++fetchStats.ftqUntranslated;
+            continue;
+        }
+
+        Addr paddr = ftqPPage[tid] | (block & (ftqPageBytes - 1));
+        RequestPtr req = Request::create(
+            paddr, fetchBufferSize, Request::INST_FETCH | Request::PREFETCH,
+            cpu->instRequestorId());
+        req->taskId(cpu->taskId());
+
+        PacketPtr pkt = new Packet(req, MemCmd::SoftPFReq);
+        pkt->allocate();
+
+        if (!icachePort.sendTimingReq(pkt)) {
+            // Drop the prefetch, the retry only unblocks the cache.
+            delete pkt;
+            cacheBlocked = true;
+            return;
+        }
+
+        DPRINTF(Fetch, "[tid:%i] Prefetching fetch block %#x.\n",
+                tid, block);
+        ++ftqPrefetchesInFlight;
+        ++fetchStats.ftqPrefetches;
+        return;
+    }
+}
+
+void
+Fetch::consumeFetchTargets(ThreadID tid, Addr vaddr)
+{
+    const Addr block = fetchBufferAlignPC(vaddr);
+    auto &queue = ftq[tid];
+
+    auto it = std::find_if(queue.begin(), queue.end(),
+        [&](const FetchTarget &target)
+        { return fetchBufferAlignPC(target.start) == block; });
+
+    if (it != queue.end()) {
+        queue.erase(queue.begin(), std::next(it));
+    } else if (!queue.empty() || ftqHalted[tid] ||
+               fetchBufferAlignPC(ftqPC[tid]) != block) {
+        DPRINTF(Fetch, "[tid:%i] Fetch left the predicted fetch blocks at "
+                "%#x.\n", tid, vaddr);
+        ++fetchStats.ftqResteers;
+        resteerFetchTargets(tid, vaddr);
+    }
+}
+
+void
+Fetch::resteerFetchTargets(ThreadID tid, Addr pc)
+{
+    ftq[tid].clear();
+    ftqPC[tid] = pc;
+    ftqHalted[tid] = false;
+}
+
 void
 Fetch::profileStall(ThreadID tid)
 {
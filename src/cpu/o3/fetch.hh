@@ -47,6 +47,7 @@
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/uop_cache.hh"
 #include "cpu/pc_event.hh"
 #include "cpu/pred/bpred_unit.hh"
 #include "cpu/timebuf.hh"
@@ -81,12 +82,20 @@ class Fetch
     /**
      * IcachePort class for instruction fetch.
      */
-    class IcachePort : public RequestPort
+    class IcachePort final : public RequestPort
     {
       protected:
         /** Pointer to fetch. */
         Fetch *fetch;
 
+      private:
+        static bool
+        directTimingResp(RequestPort &port, PacketPtr pkt)
+        {
+            return static_cast<IcachePort &>(port)
+                .IcachePort::recvTimingResp(pkt);
+        }
+
       public:
         /** Default constructor. */
         IcachePort(Fetch *_fetch, CPU *_cpu);
@@ -144,7 +153,7 @@ class Fetch
         void
         process()
         {
-            assert(fetch->numInst < fetch->fetchWidth);
+            assert(fetch->fetchSlots < fetch->fetchWidth);
             fetch->finishTranslation(fault, req);
         }
 
@@ -285,6 +294,12 @@ class Fetch
      */
     bool lookupAndUpdateNextPC(const DynInstPtr &inst, PCStateBase &pc);
 
+    /**
+     * Whether inst ends a compare that the decoders would fuse with a
+     * conditional branch right after it.
+     */
+    static bool isFusableCompare(const DynInstPtr &inst);
+
     /**
      * Fetches the cache line that contains the fetch PC.  Returns any
      * fault that happened.  Puts the data into the class variable
@@ -383,6 +398,25 @@ class Fetch
     /** Pipeline the next I-cache access to the current one. */
     void pipelineIcacheAccesses(ThreadID tid);
 
+    /**
+     * Predict the fetch block after the last one in the fetch target
+     * queue of a thread, using the branch target buffer only.
+     */
+    void predictFetchTarget(ThreadID tid);
+
+    /** Prefetch the oldest block of the fetch target queue not yet
+     * prefetched. */
+    void prefetchFetchTarget(ThreadID tid);
+
+    /**
+     * Retire the fetch targets up to the one of the block fetch is
+     * reading vaddr from, or resteer the queue if it has none.
+     */
+    void consumeFetchTargets(ThreadID tid, Addr vaddr);
+
+    /** Empty the fetch target queue and restart predicting it at pc. */
+    void resteerFetchTargets(ThreadID tid, Addr pc);
+
     /** Profile the reasons of fetch stall. */
     void profileStall(ThreadID tid);
 
@@ -432,6 +466,71 @@ class Fetch
     /** Tracks how many instructions has been fetched this cycle. */
     int numInst;
 
+    /**
+     * Tracks how much of the fetch bandwidth has been used this cycle.
+     * This is numInst less the instructions fused into the one before.
+     */
+    unsigned fetchSlots;
+
+    /** Micro-ops fetched this cycle through the legacy decode path. */
+    unsigned legacyUops;
+
+    /** Model of the micro-op cache. */
+    UopCache uopCache;
+
+    /** Micro-ops per cycle the decoders supply on a micro-op cache miss. */
+    unsigned legacyDecodeWidth;
+
+    /** Whether compare and branch pairs are fused. */
+    bool macroFusion;
+
+    /** Whether the current macroop of each thread hit in the uop cache. */
+    bool uopCacheHit[MaxThreads];
+
+    /** A fetch block the branch target buffer predicts fetch to reach. */
+    struct FetchTarget
+    {
+        /** Address of the first instruction of the block. */
+        Addr start;
+        /** Address past the branch (or fetch buffer) ending the block. */
+        Addr end;
+        /** Whether the block has been considered for prefetching. */
+        bool prefetched;
+    };
+
+    /** Size of the fetch target queue, 0 if it is left out. */
+    unsigned ftqSize;
+
+    /** Fetch target queue of each thread, oldest block first. */
+    std::deque<FetchTarget> ftq[MaxThreads];
+
+    /** Start of the next block the fetch target queue will predict. */
+    Addr ftqPC[MaxThreads];
+
+    /** Whether the prediction stopped at a branch it cannot follow. */
+    bool ftqHalted[MaxThreads];
+
+    /** Granularity at which prefetches reuse the fetch translations. */
+    static constexpr Addr ftqPageBytes = 4096;
+
+    /** Virtual and physical page of the last fetch translation. */
+    Addr ftqVPage[MaxThreads];
+    Addr ftqPPage[MaxThreads];
+    bool ftqPageValid[MaxThreads];
+
+    /** Number of prefetches waiting for their response. */
+    unsigned ftqPrefetchesInFlight;
+
+    /** Whether another micro-op fits in the fetch bandwidth this cycle. */
+    bool
+    fetchBandwidthLeft(ThreadID tid) const
+    {
+        return fetchSlots < fetchWidth &&
+            (!uopCache.enabled() || uopCacheHit[tid] ||
+             legacyUops < legacyDecodeWidth) &&
+            numInst < MaxWidth;
+    }
+
     /** Source of possible stalls. */
     struct Stalls
     {
@@ -571,6 +670,20 @@ class Fetch
          * due to a squash.
          */
         statistics::Scalar tlbSquashes;
+        /** Number of instructions found in the micro-op cache. */
+        statistics::Scalar uopCacheHits;
+        /** Number of instructions that missed in the micro-op cache. */
+        statistics::Scalar uopCacheMisses;
+        /** Number of instructions fused into the one before. */
+        statistics::Scalar fusedInsts;
+        /** Number of fetch blocks the fetch target queue predicted. */
+        statistics::Scalar ftqBlocks;
+        /** Number of times fetch left the predicted fetch blocks. */
+        statistics::Scalar ftqResteers;
+        /** Number of I-cache prefetches of predicted fetch blocks. */
+        statistics::Scalar ftqPrefetches;
+        /** Number of predicted blocks off the translated page. */
+        statistics::Scalar ftqUntranslated;
         /** Distribution of number of instructions fetched each cycle. */
         statistics::Distribution nisnDist;
         /** Rate of how often fetch was idle. */
@@ -57,6 +57,7 @@
 #include "debug/IEW.hh"
 #include "debug/O3PipeView.hh"
 #include "params/BaseO3CPU.hh"
+#include "sim/timeline.hh"
 
 namespace gem5
 {
@@ -349,6 +350,14 @@ IEW::drainSanityCheck() const
     ldstQueue.drainSanityCheck();
 }
 
+bool
+IEW::waitingOnEvents()
+{
+    // An inactive stage has no ready instructions, no stores to write
+    // back and isn't unblocking
+    return _status != Active && instQueue.waitingOnEvents();
+}
+
 void
 IEW::takeOverFrom()
 {
@@ -1526,7 +1535,7 @@ IEW::updateExeInstStats(const DynInstPtr& inst)
     cpu->executeStats[tid]->numInsts++;
 
 #if TRACING_ON
-    if (debug::O3PipeView) {
+    if (debug::O3PipeView || timeline::enabled()) {
         inst->completeTick = curTick() - inst->fetchTick;
     }
 #endif
@@ -162,6 +162,12 @@ class IEW
     /** Has the stage drained? */
     bool isDrained() const;
 
+    /**
+     * Returns if the stage can't make progress until a memory access
+     * or FU completion wakes the CPU up.
+     */
+    bool waitingOnEvents();
+
     /** Takes over from another CPU's thread. */
     void takeOverFrom();
 
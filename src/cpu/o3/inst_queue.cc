@@ -89,6 +89,7 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params.fuPool),
+      useWakeupMatrix(params.iqWakeupMatrix),
       iqPolicy(params.smtIQPolicy),
       numThreads(params.numThreads),
       numEntries(params.numIQEntries),
@@ -113,7 +114,10 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
 
     //Create an entry for each physical register within the
     //dependency graph.
-    dependGraph.resize(numPhysRegs);
+    if (useWakeupMatrix)
+        wakeupMatrix.resize(numPhysRegs, numEntries);
+    else
+        dependGraph.resize(numPhysRegs);
 
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
@@ -165,6 +169,7 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
 InstructionQueue::~InstructionQueue()
 {
     dependGraph.reset();
+    wakeupMatrix.reset();
 #ifdef GEM5_DEBUG
     cprintf("Nodes traversed: %i, removed: %i\n",
             dependGraph.nodesTraversed, dependGraph.nodesRemoved);
@@ -452,7 +457,7 @@ InstructionQueue::setTimeBuffer(TimeBuffer<TimeStruct> *tb_ptr)
 bool
 InstructionQueue::isDrained() const
 {
-    bool drained = dependGraph.empty() &&
+    bool drained = dependGraph.empty() && wakeupMatrix.empty() &&
                    instsToExecute.empty() &&
                    wbOutstanding == 0;
     for (ThreadID tid = 0; tid < numThreads; ++tid)
@@ -461,10 +466,20 @@ InstructionQueue::isDrained() const
     return drained;
 }
 
+bool
+InstructionQueue::waitingOnEvents()
+{
+    // Deferred instructions are waiting for translations, which don't
+    // wake the CPU, so they have to be polled
+    return !hasReadyInsts() && deferredMemInsts.empty() &&
+        retryMemInsts.empty() && instsToExecute.empty();
+}
+
 void
 InstructionQueue::drainSanityCheck() const
 {
     assert(dependGraph.empty());
+    assert(wakeupMatrix.empty());
     assert(instsToExecute.empty());
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         memDepUnit[tid].drainSanityCheck();
@@ -1031,11 +1046,7 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
                 dest_reg->index(),
                 dest_reg->className());
 
-        //Go through the dependency chain, marking the registers as
-        //ready within the waiting instructions.
-        DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
-
-        while (dep_inst) {
+        auto wake = [&](const DynInstPtr &dep_inst) {
             DPRINTF(IQ, "Waking up a dependent instruction, [sn:%llu] "
                     "PC %s.\n", dep_inst->seqNum, dep_inst->pcState());
 
@@ -1047,9 +1058,27 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
 
             addIfReady(dep_inst);
 
-            dep_inst = dependGraph.pop(dest_reg->flatIndex());
-
             ++dependents;
+        };
+
+        if (useWakeupMatrix) {
+            wakeupMatrix.wakeup(dest_reg->flatIndex(), wokenInsts);
+            for (const auto &dep_inst : wokenInsts)
+                wake(dep_inst);
+            wokenInsts.clear();
+            wakeupMatrix.clearInst(dest_reg->flatIndex());
+
+            regScoreboard[dest_reg->flatIndex()] = true;
+            continue;
+        }
+
+        //Go through the dependency chain, marking the registers as
+        //ready within the waiting instructions.
+        DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
+
+        while (dep_inst) {
+            wake(dep_inst);
+            dep_inst = dependGraph.pop(dest_reg->flatIndex());
         }
 
         // Reset the head node now that all of its dependents have
@@ -1251,8 +1280,13 @@ InstructionQueue::doSquash(ThreadID tid)
 
                     if (!squashed_inst->readySrcIdx(src_reg_idx) &&
                         !src_reg->isFixedMapping()) {
-                        dependGraph.remove(src_reg->flatIndex(),
-                                           squashed_inst);
+                        if (useWakeupMatrix) {
+                            wakeupMatrix.remove(src_reg->flatIndex(),
+                                                squashed_inst);
+                        } else {
+                            dependGraph.remove(src_reg->flatIndex(),
+                                               squashed_inst);
+                        }
                     }
 
                     ++iqStats.squashedOperandsExamined;
@@ -1315,8 +1349,13 @@ InstructionQueue::doSquash(ThreadID tid)
             if (dest_reg->isFixedMapping()){
                 continue;
             }
-            assert(dependGraph.empty(dest_reg->flatIndex()));
-            dependGraph.clearInst(dest_reg->flatIndex());
+            if (useWakeupMatrix) {
+                assert(wakeupMatrix.empty(dest_reg->flatIndex()));
+                wakeupMatrix.clearInst(dest_reg->flatIndex());
+            } else {
+                assert(dependGraph.empty(dest_reg->flatIndex()));
+                dependGraph.clearInst(dest_reg->flatIndex());
+            }
         }
         instList[tid].erase(squash_it--);
         ++iqStats.squashedInstsExamined;
@@ -1358,7 +1397,10 @@ InstructionQueue::addToDependents(const DynInstPtr &new_inst)
                         new_inst->pcState(), src_reg->index(),
                         src_reg->className());
 
-                dependGraph.insert(src_reg->flatIndex(), new_inst);
+                if (useWakeupMatrix)
+                    wakeupMatrix.insert(src_reg->flatIndex(), new_inst);
+                else
+                    dependGraph.insert(src_reg->flatIndex(), new_inst);
 
                 // Change the return value to indicate that something
                 // was added to the dependency graph.
@@ -1398,14 +1440,25 @@ InstructionQueue::addToProducers(const DynInstPtr &new_inst)
             continue;
         }
 
-        if (!dependGraph.empty(dest_reg->flatIndex())) {
-            dependGraph.dump();
-            panic("Dependency graph %i (%s) (flat: %i) not empty!",
-                  dest_reg->index(), dest_reg->className(),
-                  dest_reg->flatIndex());
-        }
+        if (useWakeupMatrix) {
+            if (!wakeupMatrix.empty(dest_reg->flatIndex())) {
+                wakeupMatrix.dump();
+                panic("Wakeup matrix row %i (%s) (flat: %i) not empty!",
+                      dest_reg->index(), dest_reg->className(),
+                      dest_reg->flatIndex());
+            }
 
-        dependGraph.setInst(dest_reg->flatIndex(), new_inst);
+            wakeupMatrix.setInst(dest_reg->flatIndex(), new_inst);
+        } else {
+            if (!dependGraph.empty(dest_reg->flatIndex())) {
+                dependGraph.dump();
+                panic("Dependency graph %i (%s) (flat: %i) not empty!",
+                      dest_reg->index(), dest_reg->className(),
+                      dest_reg->flatIndex());
+            }
+
+            dependGraph.setInst(dest_reg->flatIndex(), new_inst);
+        }
 
         // Mark the scoreboard to say it's not yet ready.
         regScoreboard[dest_reg->flatIndex()] = false;
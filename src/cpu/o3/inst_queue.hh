@@ -56,6 +56,7 @@
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
 #include "cpu/o3/store_set.hh"
+#include "cpu/o3/wakeup_matrix.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
 #include "enums/SMTQueuePolicy.hh"
@@ -154,6 +155,12 @@ class InstructionQueue
     /** Determine if we are drained. */
     bool isDrained() const;
 
+    /**
+     * Returns if no instruction can issue until an outstanding memory
+     * access or FU completion wakes the CPU up.
+     */
+    bool waitingOnEvents();
+
     /** Perform sanity checks after a drain. */
     void drainSanityCheck() const;
 
@@ -404,6 +411,16 @@ class InstructionQueue
 
     DependencyGraph<DynInstPtr> dependGraph;
 
+    /** Whether dependences are tracked by the wakeup matrix instead of
+     * the dependency graph. */
+    const bool useWakeupMatrix;
+
+    /** Bit-vector wakeup matrix, used if useWakeupMatrix is set. */
+    WakeupMatrix<DynInstPtr> wakeupMatrix;
+
+    /** Scratch space for the instructions woken up by a register. */
+    std::vector<DynInstPtr> wokenInsts;
+
     //////////////////////////////////////
     // Various parameters
     //////////////////////////////////////
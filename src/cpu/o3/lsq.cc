@@ -66,7 +66,9 @@ namespace o3
 
 LSQ::DcachePort::DcachePort(LSQ *_lsq, CPU *_cpu) :
     RequestPort(_cpu->name() + ".dcache_port"), lsq(_lsq), cpu(_cpu)
-{}
+{
+    setTimingRespHandler(&directTimingResp);
+}
 
 LSQ::LSQ(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params)
     : cpu(cpu_ptr), iewStage(iew_ptr),
@@ -840,7 +842,7 @@ LSQ::pushRequest(const DynInstPtr& inst, bool isLoad, uint8_t *data,
             inst->effAddrValid(true);
 
             if (cpu->checker) {
-                inst->reqToVerify = std::make_shared<Request>(*request->req());
+                inst->reqToVerify = Request::create(*request->req());
             }
             Fault fault;
             if (isLoad)
@@ -989,7 +991,7 @@ LSQ::SplitDataRequest::initiateTranslation()
     Addr final_addr = addrBlockAlign(_addr + _size, cacheLineSize);
     uint32_t size_so_far = 0;
 
-    _mainReq = std::make_shared<Request>(base_addr,
+    _mainReq = Request::create(base_addr,
                 _size, _flags, _inst->requestorId(),
                 _inst->pcState().instAddr(), _inst->contextId());
     _mainReq->setByteEnable(_byteEnable);
@@ -1106,7 +1108,7 @@ LSQ::LSQRequest::addReq(Addr addr, unsigned size,
            const std::vector<bool>& byte_enable)
 {
     if (isAnyActiveElement(byte_enable.begin(), byte_enable.end())) {
-        auto req = std::make_shared<Request>(
+        auto req = Request::create(
                 addr, size, _flags, _inst->requestorId(),
                 _inst->pcState().instAddr(), _inst->contextId(),
                 std::move(_amo_op));
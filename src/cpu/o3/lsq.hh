@@ -80,7 +80,7 @@ class LSQ
     /**
      * DcachePort class for the load/store queue.
      */
-    class DcachePort : public RequestPort
+    class DcachePort final : public RequestPort
     {
       protected:
 
@@ -88,6 +88,14 @@ class LSQ
         LSQ *lsq;
         CPU *cpu;
 
+      private:
+        static bool
+        directTimingResp(RequestPort &port, PacketPtr pkt)
+        {
+            return static_cast<DcachePort &>(port)
+                .DcachePort::recvTimingResp(pkt);
+        }
+
       public:
         /** Default constructor. */
         DcachePort(LSQ *_lsq, CPU *_cpu);
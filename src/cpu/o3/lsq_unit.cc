@@ -54,6 +54,7 @@
 #include "debug/O3PipeView.hh"
 #include "mem/packet.hh"
 #include "mem/request.hh"
+#include "sim/timeline.hh"
 
 namespace gem5
 {
@@ -215,6 +216,10 @@ LSQUnit::init(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params,
     DPRINTF(LSQUnit, "Creating LSQUnit%i object.\n",lsqID);
 
     depCheckShift = params.LSQDepCheckShift;
+    const unsigned filter_shift =
+        std::max<unsigned>(depCheckShift, floorLog2(cpu->cacheLineSize()));
+    loadFilter.setShift(filter_shift);
+    storeFilter.setShift(filter_shift);
     checkLoads = params.LSQCheckLoads;
     needsTSO = params.needsTSO;
 
@@ -510,6 +515,14 @@ Fault
 LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
         const DynInstPtr& inst)
 {
+    // Nothing to do if no executed load shares a block with the access.
+    // The loop below considers an empty access to still cover the block of
+    // its address, if unaligned.
+    if (!loadFilter.mayOverlap(inst->effAddr,
+                std::max<Addr>(inst->effSize, 1))) {
+        return NoFault;
+    }
+
     Addr inst_eff_addr1 = inst->effAddr >> depCheckShift;
     Addr inst_eff_addr2 = (inst->effAddr + inst->effSize - 1) >> depCheckShift;
 
@@ -734,6 +747,7 @@ LSQUnit::commitLoad()
                     inst->lastWakeDependents - inst->firstIssue));
     }
 
+    loadFilter.remove(loadQueue.front().filterHandle());
     loadQueue.front().clear();
     loadQueue.pop_front();
 }
@@ -954,6 +968,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         }
         // Clear the smart pointer to make sure it is decremented.
         loadQueue.back().instruction()->setSquashed();
+        loadFilter.remove(loadQueue.back().filterHandle());
         loadQueue.back().clear();
 
         loadQueue.pop_back();
@@ -1025,6 +1040,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         // Must delete request now that it wasn't handed off to
         // memory.  This is quite ugly.  @todo: Figure out the proper
         // place to really handle request deletes.
+        storeFilter.remove(storeQueue.back().filterHandle());
         storeQueue.back().clear();
 
         storeQueue.pop_back();
@@ -1149,6 +1165,7 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            storeFilter.remove(storeQueue.front().filterHandle());
             storeQueue.front().clear();
             storeQueue.pop_front();
         } while (storeQueue.front().completed() &&
@@ -1162,7 +1179,7 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
             store_inst->seqNum, store_idx.idx() - 1, storeQueue.head() - 1);
 
 #if TRACING_ON
-    if (debug::O3PipeView) {
+    if (debug::O3PipeView || timeline::enabled()) {
         store_inst->storeTick =
             curTick() - store_inst->fetchTick;
     }
@@ -1322,6 +1339,11 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     load_entry.setRequest(request);
     assert(load_inst);
 
+    // The load has its address now, so it can be found by the violation
+    // checks of older stores.
+    loadFilter.insert(load_entry.filterHandle(), load_inst->effAddr,
+                      std::max<Addr>(load_inst->effSize, 1));
+
     assert(!load_inst->isExecuted());
 
     // Make sure this isn't a strictly ordered load
@@ -1382,11 +1404,17 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
         return NoFault;
     }
 
-    // Check the SQ for any previous stores that might lead to forwarding
+    // Check the SQ for any previous stores that might lead to forwarding.
+    // Forwarding needs the store to overlap the load, so there is no need
+    // to look if no executed store shares a block with it.
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
+    const bool may_forward = request->mainReq()->getSize() == 0 ||
+        storeFilter.mayOverlap(request->mainReq()->getVaddr(),
+                               request->mainReq()->getSize());
     // End once we've reached the top of the LSQ
-    while (store_it != storeWBIt && !load_inst->isDataPrefetch()) {
+    while (may_forward && store_it != storeWBIt &&
+           !load_inst->isDataPrefetch()) {
         // Move the index to one younger
         store_it--;
         assert(store_it->valid());
@@ -1613,6 +1641,8 @@ LSQUnit::write(LSQRequest *request, uint8_t *data, ssize_t store_idx)
     storeQueue[store_idx].setRequest(request);
     unsigned size = request->_size;
     storeQueue[store_idx].size() = size;
+    storeFilter.insert(storeQueue[store_idx].filterHandle(),
+                       storeQueue[store_idx].instruction()->effAddr, size);
     bool store_no_data =
         request->mainReq()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
@@ -50,6 +50,7 @@
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/generic/vec_reg.hh"
+#include "base/addr_filter.hh"
 #include "base/circular_queue.hh"
 #include "cpu/base.hh"
 #include "cpu/inst_seq.hh"
@@ -103,6 +104,8 @@ class LSQUnit
         uint32_t _size = 0;
         /** Valid entry. */
         bool _valid = false;
+        /** How the access is counted in the address filter of its queue */
+        AddrBlockFilter::Handle _filterHandle;
 
       public:
         ~LSQEntry()
@@ -140,6 +143,7 @@ class LSQUnit
         /** Member accessors. */
         /** @{ */
         bool valid() const { return _valid; }
+        AddrBlockFilter::Handle& filterHandle() { return _filterHandle; }
         uint32_t& size() { return _size; }
         const uint32_t& size() const { return _size; }
         const DynInstPtr& instruction() const { return _inst; }
@@ -457,6 +461,16 @@ class LSQUnit
      */
     unsigned depCheckShift;
 
+    /**
+     * Filters over the addresses of the loads and stores which have
+     * executed, counted by cache line (or dependency check block, if
+     * larger). They let forwarding and violation checks skip walking the
+     * queues when no access there can overlap, without changing what the
+     * walks find otherwise.
+     */
+    AddrBlockFilter loadFilter;
+    AddrBlockFilter storeFilter;
+
     /** Should loads be checked for dependency issues */
     bool checkLoads;
 
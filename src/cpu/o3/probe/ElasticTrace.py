@@ -64,7 +64,17 @@ class ElasticTrace(ProbeListenerObject):
         "zero means start tracing from first "
         "committed instruction.",
     )
+    # Threads compressing and writing each trace in the background
+    compress_threads = Param.Unsigned(
+        1, "Number of threads compressing the traces in the background"
+    )
     # Whether to trace virtual addresses for memory accesses
     traceVirtAddr = Param.Bool(
         False, "Set to true if virtual addresses are to be traced."
     )
+    # Whether to number atomic and locked accesses across all traced CPUs,
+    # allowing TraceCPUs to replay multi-core traces in the recorded order
+    traceSyncPoints = Param.Bool(
+        False,
+        "Set to true to record the global order of synchronization points.",
+    )
@@ -51,17 +51,21 @@ namespace gem5
 namespace o3
 {
 
+std::atomic<uint64_t> ElasticTrace::syncCount(0);
+
 ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
     :  ProbeListenerObject(params),
        regEtraceListenersEvent([this]{ regEtraceListeners(); }, name()),
        firstWin(true),
        lastClearedSeqNum(0),
+       numPhysRegDeps(0),
        depWindowSize(params.depWindowSize),
        dataTraceStream(nullptr),
        instTraceStream(nullptr),
        startTraceInst(params.startTraceInst),
        allProbesReg(false),
        traceVirtAddr(params.traceVirtAddr),
+       traceSyncPoints(params.traceSyncPoints),
        stats(this)
 {
     cpu = dynamic_cast<CPU *>(params.manager);
@@ -81,9 +85,11 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
                 "trace file path to dataDepTraceFile");
     std::string filename = simout.resolve(name() + "." +
                                             params.instFetchTraceFile);
-    instTraceStream = new ProtoOutputStream(filename);
+    instTraceStream = new ProtoOutputStream(filename,
+                                            params.compress_threads);
     filename = simout.resolve(name() + "." + params.dataDepTraceFile);
-    dataTraceStream = new ProtoOutputStream(filename);
+    dataTraceStream = new ProtoOutputStream(filename,
+                                            params.compress_threads);
     // Create a protobuf message for the header and write it to the stream
     ProtoMessage::PacketHeader inst_pkt_header;
     inst_pkt_header.set_obj_id(name());
@@ -254,9 +260,10 @@ ElasticTrace::updateRegDep(const DynInstConstPtr& dyn_inst)
             DPRINTFR(ElasticTrace, "[sn:%lli] Check map for src reg"
                      " %i (%s)\n", seq_num,
                      phys_src_reg->flatIndex(), phys_src_reg->className());
-            auto itr_writer = physRegDepMap.find(phys_src_reg->flatIndex());
-            if (itr_writer != physRegDepMap.end()) {
-                InstSeqNum last_writer = itr_writer->second;
+            RegIndex src_idx_flat = phys_src_reg->flatIndex();
+            InstSeqNum last_writer = src_idx_flat < physRegDepMap.size() ?
+                physRegDepMap[src_idx_flat] : 0;
+            if (last_writer != 0) {
                 // Additionally the dependency distance is kept less than the
                 // window size parameter to limit the memory allocation to
                 // nodes in the graph. If the window were tending to infinite
@@ -287,10 +294,15 @@ ElasticTrace::updateRegDep(const DynInstConstPtr& dyn_inst)
             DPRINTFR(ElasticTrace, "[sn:%lli] Update map for dest reg"
                      " %i (%s)\n", seq_num, phys_dest_reg->flatIndex(),
                      dest_reg.className());
-            physRegDepMap[phys_dest_reg->flatIndex()] = seq_num;
+            RegIndex dest_idx_flat = phys_dest_reg->flatIndex();
+            if (dest_idx_flat >= physRegDepMap.size())
+                physRegDepMap.resize(dest_idx_flat + 1, 0);
+            if (physRegDepMap[dest_idx_flat] == 0)
+                ++numPhysRegDeps;
+            physRegDepMap[dest_idx_flat] = seq_num;
         }
     }
-    stats.maxPhysRegDepMapSize = std::max(physRegDepMap.size(),
+    stats.maxPhysRegDepMapSize = std::max(numPhysRegDeps,
                             (std::size_t)stats.maxPhysRegDepMapSize.value());
 }
 
@@ -299,9 +311,11 @@ ElasticTrace::removeRegDepMapEntry(const SeqNumRegPair &inst_reg_pair)
 {
     DPRINTFR(ElasticTrace, "Remove Map entry for Reg %i\n",
             inst_reg_pair.second);
-    auto itr_regdep_map = physRegDepMap.find(inst_reg_pair.second);
-    if (itr_regdep_map != physRegDepMap.end())
-        physRegDepMap.erase(itr_regdep_map);
+    RegIndex reg_idx = inst_reg_pair.second;
+    if (reg_idx < physRegDepMap.size() && physRegDepMap[reg_idx] != 0) {
+        physRegDepMap[reg_idx] = 0;
+        --numPhysRegDeps;
+    }
 }
 
 void
@@ -415,6 +429,15 @@ ElasticTrace::addDepTraceRecord(const DynInstConstPtr& head_inst,
     new_record->size = head_inst->effSize;
     new_record->pc = head_inst->pcState().instAddr();
 
+    // Atomic and locked accesses synchronize with the other cores. Number
+    // them in the order they commit across all the traced CPUs, so that a
+    // multi-core replay can honour that order.
+    if (traceSyncPoints && commit && (head_inst->isAtomic() ||
+        (head_inst->memReqFlags & (Request::LOCKED_RMW | Request::LLSC)))) {
+        new_record->syncSeq = ++syncCount;
+        ++stats.numSyncPoints;
+    }
+
     // Assign the timing information stored in the execution info object
     new_record->executeTick = exec_info_ptr->executeTick;
     new_record->toCommitTick = exec_info_ptr->toCommitTick;
@@ -801,7 +824,8 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
         // track the comp node in the dependency graph. We filter out such
         // nodes but count them and add a weight field to the subsequent node
         // that we do include in the trace.
-        if (!temp_ptr->isComp() || temp_ptr->numDepts != 0) {
+        if (!temp_ptr->isComp() || temp_ptr->numDepts != 0 ||
+            temp_ptr->syncSeq != 0) {
             DPRINTFR(ElasticTrace, "Instruction with seq. num %lli "
                      "is as follows:\n", temp_ptr->instNum);
             if (temp_ptr->isLoad() || temp_ptr->isStore()) {
@@ -840,6 +864,11 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 dep_pkt.set_size(temp_ptr->size);
             }
             dep_pkt.set_comp_delay(temp_ptr->compDelay);
+            if (temp_ptr->syncSeq != 0) {
+                DPRINTFR(ElasticTrace, "\tis synchronization point %lli\n",
+                         temp_ptr->syncSeq);
+                dep_pkt.set_sync_seq(temp_ptr->syncSeq);
+            }
             if (temp_ptr->robDepList.empty()) {
                 DPRINTFR(ElasticTrace, "\thas no order (rob) dependencies\n");
             }
@@ -886,6 +915,8 @@ ElasticTrace::ElasticTraceStats::ElasticTraceStats(statistics::Group *parent)
     : statistics::Group(parent),
       ADD_STAT(numRegDep, statistics::units::Count::get(),
                "Number of register dependencies recorded during tracing"),
+      ADD_STAT(numSyncPoints, statistics::units::Count::get(),
+               "Number of synchronization points recorded during tracing"),
       ADD_STAT(numOrderDepStores, statistics::units::Count::get(),
                "Number of commit order (rob) dependencies for a store "
                "recorded on a past load/store during tracing"),
@@ -46,6 +46,7 @@
 #ifndef __CPU_O3_PROBE_ELASTIC_TRACE_HH__
 #define __CPU_O3_PROBE_ELASTIC_TRACE_HH__
 
+#include <atomic>
 #include <set>
 #include <unordered_map>
 #include <utility>
@@ -238,10 +239,15 @@ class ElasticTrace : public ProbeListenerObject
 
     /**
      * Map for recording the producer of a physical register to check Read
-     * After Write dependencies. The key is the renamed physical register and
-     * the value is the instruction sequence number of its last producer.
+     * After Write dependencies. It is indexed by the flat index of the
+     * renamed physical register and holds the instruction sequence number
+     * of its last producer, or zero if it has none. The vector grows on
+     * demand to the number of physical registers.
      */
-    std::unordered_map<RegIndex, InstSeqNum> physRegDepMap;
+    std::vector<InstSeqNum> physRegDepMap;
+
+    /** Number of physical registers with a producer in physRegDepMap */
+    std::size_t numPhysRegDeps;
 
     /**
      * @defgroup TraceInfo Struct for a record in the instruction dependency
@@ -292,9 +298,11 @@ class ElasticTrace : public ProbeListenerObject
         Addr virtAddr;
         /* Request size in case of a load/store instruction */
         unsigned size;
+        /* Global order of a synchronization point, zero if it is not one */
+        uint64_t syncSeq;
         /** Default Constructor */
         TraceInfo()
-          : type(Record::INVALID)
+          : type(Record::INVALID), syncSeq(0)
         { }
         /** Is the record a load */
         bool isLoad() const { return (type == Record::LOAD); }
@@ -368,6 +376,15 @@ class ElasticTrace : public ProbeListenerObject
     /** Whether to trace virtual addresses for memory requests. */
     const bool traceVirtAddr;
 
+    /** Whether to number the synchronization points across all CPUs. */
+    const bool traceSyncPoints;
+
+    /**
+     * Number of synchronization points committed by all the traced CPUs,
+     * shared by all instances to give the points a global order.
+     */
+    static std::atomic<uint64_t> syncCount;
+
     /** Pointer to the O3CPU that is this listener's parent a.k.a. manager */
     CPU *cpu;
 
@@ -515,6 +532,9 @@ class ElasticTrace : public ProbeListenerObject
         /** Number of register dependencies recorded during tracing */
         statistics::Scalar numRegDep;
 
+        /** Number of synchronization points recorded during tracing */
+        statistics::Scalar numSyncPoints;
+
         /**
          * Number of stores that got assigned a commit order dependency
          * on a past load/store.
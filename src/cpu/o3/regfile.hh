@@ -241,6 +241,36 @@ class PhysRegFile
         }
     }
 
+    /** Get a pointer to a vector, predicate or matrix register for
+     *  reading it in place. */
+    const void *
+    getReadableReg(PhysRegIdPtr phys_reg) const
+    {
+        const RegClassType type = phys_reg->classValue();
+        const RegIndex idx = phys_reg->index();
+
+        const void *val;
+        switch (type) {
+          case VecRegClass:
+            val = vectorRegFile.ptr(idx);
+            DPRINTF(IEW, "RegFile: Access to vector register %i, has "
+                    "data %s\n", idx, vectorRegFile.regClass.valString(val));
+            return val;
+          case VecPredRegClass:
+            val = vecPredRegFile.ptr(idx);
+            DPRINTF(IEW, "RegFile: Access to predicate register %i, has "
+                    "data %s\n", idx, vecPredRegFile.regClass.valString(val));
+            return val;
+          case MatRegClass:
+            val = matRegFile.ptr(idx);
+            DPRINTF(IEW, "RegFile: Access to matrix register %i, has "
+                    "data %s\n", idx, matRegFile.regClass.valString(val));
+            return val;
+          default:
+            panic("Unrecognized register class type %d.", type);
+        }
+    }
+
     void *
     getWritableReg(PhysRegIdPtr phys_reg)
     {
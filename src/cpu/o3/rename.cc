@@ -51,6 +51,7 @@
 #include "debug/O3PipeView.hh"
 #include "debug/Rename.hh"
 #include "params/BaseO3CPU.hh"
+#include "sim/timeline.hh"
 
 namespace gem5
 {
@@ -797,7 +798,7 @@ Rename::sortInsts()
         const DynInstPtr &inst = fromDecode->insts[i];
         insts[inst->threadNumber].push_back(inst);
 #if TRACING_ON
-        if (debug::O3PipeView) {
+        if (debug::O3PipeView || timeline::enabled()) {
             inst->renameTick = curTick() - inst->fetchTick;
         }
 #endif
@@ -28,6 +28,8 @@
 
 #include "cpu/o3/store_set.hh"
 
+#include <algorithm>
+
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -75,6 +77,8 @@ StoreSet::StoreSet(uint64_t clear_period, int _SSIT_size, int _LFST_size)
     offsetBits = 2;
 
     memOpsPred = 0;
+
+    storeList.resize(InitialStoreListSize);
 }
 
 StoreSet::~StoreSet()
@@ -113,8 +117,27 @@ StoreSet::init(uint64_t clear_period, int _SSIT_size, int _LFST_size)
     offsetBits = 2;
 
     memOpsPred = 0;
+
+    storeList.assign(InitialStoreListSize, StoreListEntry());
+    storeListCount = 0;
+    youngestStore = 0;
 }
 
+void
+StoreSet::growStoreList()
+{
+    std::vector<StoreListEntry> old_list(storeList.size() * 2);
+    old_list.swap(storeList);
+
+    // Slots that were distinct for the old size remain distinct.
+    for (const auto &entry : old_list) {
+        if (entry.seqNum)
+            storeListSlot(entry.seqNum) = entry;
+    }
+
+    DPRINTF(StoreSet, "StoreSet: Store list grown to %i entries.\n",
+            storeList.size());
+}
 
 void
 StoreSet::violation(Addr store_PC, Addr load_PC)
@@ -232,7 +255,17 @@ StoreSet::insertStore(Addr store_PC, InstSeqNum store_seq_num, ThreadID tid)
 
         validLFST[store_SSID] = 1;
 
-        storeList[store_seq_num] = store_SSID;
+        while (storeListSlot(store_seq_num).seqNum &&
+               storeListSlot(store_seq_num).seqNum != store_seq_num) {
+            growStoreList();
+        }
+
+        StoreListEntry &entry = storeListSlot(store_seq_num);
+        if (!entry.seqNum)
+            storeListCount++;
+        entry.seqNum = store_seq_num;
+        entry.ssid = store_SSID;
+        youngestStore = std::max(youngestStore, store_seq_num);
 
         DPRINTF(StoreSet, "Store %#x updated the LFST, SSID: %i\n",
                 store_PC, store_SSID);
@@ -288,10 +321,11 @@ StoreSet::issued(Addr issued_PC, InstSeqNum issued_seq_num, bool is_store)
 
     assert(index < SSITSize);
 
-    SeqNumMapIt store_list_it = storeList.find(issued_seq_num);
+    StoreListEntry &entry = storeListSlot(issued_seq_num);
 
-    if (store_list_it != storeList.end()) {
-        storeList.erase(store_list_it);
+    if (entry.seqNum == issued_seq_num) {
+        entry.seqNum = 0;
+        storeListCount--;
     }
 
     // Make sure the SSIT still has a valid entry for the issued store.
@@ -317,28 +351,37 @@ StoreSet::squash(InstSeqNum squashed_num, ThreadID tid)
     DPRINTF(StoreSet, "StoreSet: Squashing until inum %i\n",
             squashed_num);
 
-    int idx;
-    SeqNumMapIt store_list_it = storeList.begin();
-
-    //@todo:Fix to only delete from correct thread
-    while (!storeList.empty()) {
-        idx = (*store_list_it).second;
-
-        if ((*store_list_it).first <= squashed_num) {
-            break;
-        }
+    if (!storeListCount || youngestStore <= squashed_num)
+        return;
 
-        bool younger = LFST[idx] > squashed_num;
+    auto squash_entry = [&](StoreListEntry &entry) {
+        SSID idx = entry.ssid;
 
-        if (validLFST[idx] && younger) {
+        if (validLFST[idx] && LFST[idx] > squashed_num) {
             DPRINTF(StoreSet, "Squashed [sn:%lli]\n", LFST[idx]);
             validLFST[idx] = false;
+        }
+
+        entry.seqNum = 0;
+        storeListCount--;
+    };
 
-            storeList.erase(store_list_it++);
-        } else if (!validLFST[idx] && younger) {
-            storeList.erase(store_list_it++);
+    //@todo:Fix to only delete from correct thread
+    if (youngestStore - squashed_num < storeList.size()) {
+        // Only walk the squashed part of the sequence number space.
+        for (InstSeqNum sn = youngestStore; sn > squashed_num; --sn) {
+            StoreListEntry &entry = storeListSlot(sn);
+            if (entry.seqNum == sn)
+                squash_entry(entry);
+        }
+    } else {
+        for (auto &entry : storeList) {
+            if (entry.seqNum > squashed_num)
+                squash_entry(entry);
         }
     }
+
+    youngestStore = squashed_num;
 }
 
 void
@@ -352,22 +395,33 @@ StoreSet::clear()
         validLFST[i] = false;
     }
 
-    storeList.clear();
+    for (auto &entry : storeList) {
+        entry.seqNum = 0;
+    }
+    storeListCount = 0;
+    youngestStore = 0;
 }
 
 void
 StoreSet::dump()
 {
-    cprintf("storeList.size(): %i\n", storeList.size());
-    SeqNumMapIt store_list_it = storeList.begin();
+    cprintf("storeList.size(): %i\n", storeListCount);
 
-    int num = 0;
+    std::vector<StoreListEntry> stores;
+    for (const auto &entry : storeList) {
+        if (entry.seqNum)
+            stores.push_back(entry);
+    }
+
+    // Youngest first, like the order stores are squashed in.
+    std::sort(stores.begin(), stores.end(),
+              [](const StoreListEntry &lhs, const StoreListEntry &rhs)
+              { return lhs.seqNum > rhs.seqNum; });
 
-    while (store_list_it != storeList.end()) {
-        cprintf("%i: [sn:%lli] SSID:%i\n",
-                num, (*store_list_it).first, (*store_list_it).second);
+    int num = 0;
+    for (const auto &entry : stores) {
+        cprintf("%i: [sn:%lli] SSID:%i\n", num, entry.seqNum, entry.ssid);
         num++;
-        store_list_it++;
     }
 }
 
@@ -30,7 +30,6 @@
 #define __CPU_O3_STORE_SET_HH__
 
 #include <list>
-#include <map>
 #include <utility>
 #include <vector>
 
@@ -135,12 +134,38 @@ class StoreSet
     /** Bit vector to tell if the LFST has a valid entry. */
     std::vector<bool> validLFST;
 
-    /** Map of stores that have been inserted into the store set, but
-     * not yet issued or squashed.
+    struct StoreListEntry
+    {
+        /** Sequence number of the store, 0 if the slot is free. */
+        InstSeqNum seqNum = 0;
+        SSID ssid = 0;
+    };
+
+    /** Initial number of entries of the store list, a power of 2. */
+    static constexpr size_t InitialStoreListSize = 256;
+
+    /** Stores that have been inserted into the store set, but not yet
+     * issued or squashed. Sequence numbers of in flight stores are
+     * close to each other, so the list is a ring indexed by sequence
+     * number modulo its size. It doubles in size if two live stores
+     * ever map to the same slot.
      */
-    std::map<InstSeqNum, int, ltseqnum> storeList;
+    std::vector<StoreListEntry> storeList;
+
+    /** Number of valid entries in the store list. */
+    size_t storeListCount = 0;
+
+    /** Upper bound on the sequence number of the stores in the list. */
+    InstSeqNum youngestStore = 0;
+
+    StoreListEntry &
+    storeListSlot(InstSeqNum seq_num)
+    {
+        return storeList[seq_num & (storeList.size() - 1)];
+    }
 
-    typedef std::map<InstSeqNum, int, ltseqnum>::iterator SeqNumMapIt;
+    /** Doubles the size of the store list. */
+    void growStoreList();
 
     /** Number of loads/stores to process before wiping predictor so all
      * entries don't get saturated
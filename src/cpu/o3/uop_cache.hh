@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __CPU_O3_UOP_CACHE_HH__
+#define __CPU_O3_UOP_CACHE_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Timing model of a decoded micro-op cache.
+ *
+ * The cache tracks which instructions have recently been expanded by
+ * the decoders, one entry per instruction, in a set associative array
+ * with LRU replacement. It holds no micro-ops itself: the decoder
+ * caches already hand fetch the expanded StaticInsts, so all fetch
+ * needs to know is whether the hardware would have found them here
+ * rather than in the legacy decode path.
+ */
+class UopCache
+{
+  public:
+    UopCache(unsigned num_entries, unsigned assoc)
+        : assoc(assoc), numSets(assoc ? num_entries / assoc : 0),
+          entries(num_entries)
+    {
+        if (!num_entries)
+            return;
+        fatal_if(!assoc || num_entries % assoc,
+                 "Micro-op cache size (%u) is not a multiple of its "
+                 "associativity (%u).", num_entries, assoc);
+        fatal_if(!isPowerOf2(numSets),
+                 "Micro-op cache set count (%u) is not a power of 2.",
+                 numSets);
+    }
+
+    /** Whether the cache is modelled at all. */
+    bool enabled() const { return numSets != 0; }
+
+    /**
+     * Look up the instruction at pc, allocating it on a miss.
+     * @return Whether the instruction was already in the cache.
+     */
+    bool
+    access(Addr pc)
+    {
+        Entry *set = &entries[(pc & (numSets - 1)) * assoc];
+        Entry *victim = set;
+        for (Entry *e = set; e != set + assoc; ++e) {
+            if (e->valid && e->pc == pc) {
+                e->lastUse = ++useCount;
+                return true;
+            }
+            if (!e->valid || (victim->valid && e->lastUse < victim->lastUse))
+                victim = e;
+        }
+        *victim = {pc, ++useCount, true};
+        return false;
+    }
+
+    /** Drop every entry, e.g. when the code may have changed. */
+    void
+    clear()
+    {
+        for (auto &e : entries)
+            e = Entry();
+    }
+
+  private:
+    struct Entry
+    {
+        Addr pc = 0;
+        uint64_t lastUse = 0;
+        bool valid = false;
+    };
+
+    const unsigned assoc;
+    const unsigned numSets;
+    std::vector<Entry> entries;
+    uint64_t useCount = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_UOP_CACHE_HH__
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_WAKEUP_MATRIX_HH__
+#define __CPU_O3_WAKEUP_MATRIX_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/cprintf.hh"
+#include "cpu/o3/comm.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Bit-vector alternative to the DependencyGraph, modelled on the
+ * wakeup matrices of CAM-less schedulers.
+ *
+ * Every instruction waiting on at least one register occupies a slot,
+ * and each physical register has a row with one bit per slot marking
+ * the instructions waiting on it. Slots and rows live in contiguous
+ * arrays, so that inserting a dependence is setting a bit, and waking
+ * up the dependents of a register is a bit scan of its row rather
+ * than a walk down a linked list.
+ *
+ * wakeup() returns the dependents youngest first, which is the order
+ * the dependency chains are popped in, so both structures lead to the
+ * same timing.
+ */
+template <class DynInstPtr>
+class WakeupMatrix
+{
+  public:
+    WakeupMatrix() = default;
+
+    /**
+     * Resize the matrix to have num_regs registers and room for
+     * num_slots waiting instructions. The matrix grows if more
+     * instructions need to wait at once.
+     */
+    void
+    resize(int num_regs, int num_slots)
+    {
+        numRegs = num_regs;
+        producers.resize(numRegs);
+        reshape(std::max(num_slots, 1));
+    }
+
+    /** Clears all dependences. */
+    void
+    reset()
+    {
+        std::fill(rows.begin(), rows.end(), 0);
+        std::fill(producers.begin(), producers.end(), nullptr);
+        for (auto &slot : slots)
+            slot = Slot();
+        freeSlots.clear();
+        for (int i = slots.size() - 1; i >= 0; --i)
+            freeSlots.push_back(i);
+        lastSlot = -1;
+    }
+
+    /** Makes new_inst wait on the given register. */
+    void
+    insert(RegIndex idx, const DynInstPtr &new_inst)
+    {
+        // An instruction's sources are inserted back to back, so they
+        // can share the slot of the previous insertion. A source
+        // register read twice needs a slot of its own, so that it is
+        // woken up twice, just as it would be by the dependency graph.
+        if (lastSlot < 0 || slots[lastSlot].inst != new_inst ||
+            (row(idx)[lastSlot / 64] & (1ULL << (lastSlot % 64)))) {
+            if (freeSlots.empty())
+                reshape(slots.size() * 2);
+            lastSlot = freeSlots.back();
+            freeSlots.pop_back();
+            slots[lastSlot].inst = new_inst;
+        }
+
+        row(idx)[lastSlot / 64] |= 1ULL << (lastSlot % 64);
+        ++slots[lastSlot].waiting;
+    }
+
+    /** Sets the producing instruction of a given register. */
+    void setInst(RegIndex idx, const DynInstPtr &new_inst)
+    { producers[idx] = new_inst; }
+
+    /** Clears the producing instruction. */
+    void clearInst(RegIndex idx) { producers[idx] = nullptr; }
+
+    /** Stops inst_to_remove from waiting on a register. */
+    void
+    remove(RegIndex idx, const DynInstPtr &inst_to_remove)
+    {
+        uint64_t *r = row(idx);
+        for (int w = 0; w < words; ++w) {
+            for (uint64_t bits = r[w]; bits; bits &= bits - 1) {
+                const int slot = w * 64 + findLsbSet(bits);
+                if (slots[slot].inst == inst_to_remove) {
+                    r[w] &= ~(1ULL << (slot % 64));
+                    release(slot);
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * Clears the row of a register and returns all of the instructions
+     * that were waiting on it, youngest first.
+     */
+    void
+    wakeup(RegIndex idx, std::vector<DynInstPtr> &woken)
+    {
+        woken.clear();
+        uint64_t *r = row(idx);
+        for (int w = 0; w < words; ++w) {
+            for (uint64_t bits = r[w]; bits; bits &= bits - 1) {
+                const int slot = w * 64 + findLsbSet(bits);
+                woken.push_back(slots[slot].inst);
+                release(slot);
+            }
+            r[w] = 0;
+        }
+
+        std::sort(woken.begin(), woken.end(),
+                  [](const DynInstPtr &lhs, const DynInstPtr &rhs) {
+                      return lhs->seqNum > rhs->seqNum;
+                  });
+    }
+
+    /** Checks if the entire matrix is empty. */
+    bool empty() const { return freeSlots.size() == slots.size(); }
+
+    /** Checks if there are any dependents on a specific register. */
+    bool
+    empty(RegIndex idx) const
+    {
+        const uint64_t *r = &rows[idx * words];
+        return std::all_of(r, r + words, [](uint64_t w) { return !w; });
+    }
+
+    /** Debugging function to dump out the matrix. */
+    void
+    dump() const
+    {
+        for (int i = 0; i < numRegs; ++i) {
+            if (producers[i]) {
+                cprintf("wakeupMatrix[%i]: producer: %s [sn:%lli] "
+                        "consumer: ", i, producers[i]->pcState(),
+                        producers[i]->seqNum);
+            } else {
+                cprintf("wakeupMatrix[%i]: No producer. consumer: ", i);
+            }
+
+            for (int slot = 0; slot < slots.size(); ++slot) {
+                if (rows[i * words + slot / 64] & (1ULL << (slot % 64))) {
+                    cprintf("%s [sn:%lli] ", slots[slot].inst->pcState(),
+                            slots[slot].inst->seqNum);
+                }
+            }
+
+            cprintf("\n");
+        }
+        cprintf("waiting instructions: %i\n",
+                slots.size() - freeSlots.size());
+    }
+
+  private:
+    struct Slot
+    {
+        DynInstPtr inst = nullptr;
+        /** Number of registers the instruction is waiting on. */
+        int waiting = 0;
+    };
+
+    uint64_t *row(RegIndex idx) { return &rows[idx * words]; }
+
+    void
+    release(int slot)
+    {
+        assert(slots[slot].waiting > 0);
+        if (--slots[slot].waiting == 0) {
+            slots[slot].inst = nullptr;
+            freeSlots.push_back(slot);
+            if (lastSlot == slot)
+                lastSlot = -1;
+        }
+    }
+
+    /** Change the number of slots, keeping all dependences. */
+    void
+    reshape(int num_slots)
+    {
+        const int old_words = words;
+        const int old_slots = slots.size();
+        words = (num_slots + 63) / 64;
+
+        std::vector<uint64_t> new_rows(numRegs * words, 0);
+        for (int i = 0; i < numRegs && old_words; ++i) {
+            std::copy(&rows[i * old_words], &rows[(i + 1) * old_words],
+                      &new_rows[i * words]);
+        }
+        rows.swap(new_rows);
+
+        slots.resize(words * 64);
+        for (int i = slots.size() - 1; i >= old_slots; --i)
+            freeSlots.insert(freeSlots.begin(), i);
+    }
+
+    int numRegs = 0;
+    /** Number of 64 bit words in each row. */
+    int words = 0;
+
+    /** One row of slot bits per register. */
+    std::vector<uint64_t> rows;
+    std::vector<Slot> slots;
+    /** Free slots, the next one to use at the back. */
+    std::vector<int> freeSlots;
+    /** Slot used by the most recent insertion, or -1. */
+    int lastSlot = -1;
+
+    std::vector<DynInstPtr> producers;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_WAKEUP_MATRIX_HH__
@@ -187,7 +187,7 @@ class BPredUnit : public SimObject
                    void * &bp_history, bool squashed,
                    const StaticInstPtr &inst, Addr target) = 0;
 
-
+  public:
     /**
      * Looks up a given PC in the BTB to see if a matching entry exists.
      * @param tid The thread id.
@@ -229,6 +229,24 @@ class BPredUnit : public SimObject
         return btb->getInst(tid, instPC);
     }
 
+    /**
+     * Looks up a given PC in the BTB to get the predicted target without
+     * updating any statistics. A decoupled frontend uses this to run
+     * ahead of fetch, before there is an instruction to predict.
+     *
+     * @param inst_PC The PC to look up.
+     * @return The target of the branch or nullptr on a BTB miss.
+     */
+    const PCStateBase *
+    BTBPeekTarget(ThreadID tid, Addr instPC)
+    {
+        return btb->peekTarget(tid, instPC);
+    }
+
+    /** Number of bits instruction addresses are shifted by. */
+    unsigned getInstShiftAmt() const { return instShiftAmt; }
+
+  protected:
     /**
      * Updates the BTB with the target of a branch.
      * @param inst_PC The branch's PC that will be updated.
@@ -88,6 +88,15 @@ class BranchTargetBuffer : public ClockedObject
      */
     virtual const StaticInstPtr getInst(ThreadID tid, Addr instPC) = 0;
 
+    /** Looks up an address in the BTB to get the target of the branch,
+     * without the lookup counting as a prediction. Does not update
+     * statistics.
+     *  @param inst_PC The address of the branch to look up.
+     *  @return The target of the branch or nullptr if the branch is not
+     *          in the BTB.
+     */
+    virtual const PCStateBase *peekTarget(ThreadID tid, Addr instPC) = 0;
+
 
     /** Updates the BTB with the target of a branch.
      *  @param inst_pc The address of the branch being updated.
@@ -154,6 +154,14 @@ SimpleBTB::getInst(ThreadID tid, Addr instPC)
     return nullptr;
 }
 
+const PCStateBase *
+SimpleBTB::peekTarget(ThreadID tid, Addr instPC)
+{
+    BTBEntry *entry = findEntry(instPC, tid);
+
+    return entry ? entry->target.get() : nullptr;
+}
+
 void
 SimpleBTB::update(ThreadID tid, Addr instPC,
                     const PCStateBase &target,
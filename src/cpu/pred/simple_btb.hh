@@ -65,6 +65,7 @@ class SimpleBTB : public BranchTargetBuffer
                            BranchType type = BranchType::NoBranch,
                            StaticInstPtr inst = nullptr) override;
     const StaticInstPtr getInst(ThreadID tid, Addr instPC) override;
+    const PCStateBase *peekTarget(ThreadID tid, Addr instPC) override;
 
 
   private:
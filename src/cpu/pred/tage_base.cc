@@ -192,15 +192,32 @@ TAGEBase::btbUpdate(ThreadID tid, Addr branch_pc, BranchInfo* &bi)
         DPRINTF(Tage, "BTB miss resets prediction: %lx\n", branch_pc);
         assert(tHist.gHist == &tHist.globalHistory[tHist.ptGhist]);
         tHist.gHist[0] = 0;
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].comp = bi->ci[i];
-            tHist.computeTags[0][i].comp = bi->ct0[i];
-            tHist.computeTags[1][i].comp = bi->ct1[i];
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        restoreFoldedHist(tHist, bi);
+    }
+}
+
+void
+TAGEBase::updateFoldedHist(ThreadHistory &tHist)
+{
+    const uint8_t *h = tHist.gHist;
+    const unsigned in_bit = h[0];
+    for (int i = 1; i <= nHistoryTables; i++) {
+        const unsigned out_bit = h[tHist.computeIndices[i].origLength];
+        tHist.computeIndices[i].update(in_bit, out_bit);
+        tHist.computeTags[0][i].update(in_bit, out_bit);
+        tHist.computeTags[1][i].update(in_bit, out_bit);
+    }
+}
+
+void
+TAGEBase::restoreFoldedHist(ThreadHistory &tHist, const BranchInfo *bi)
+{
+    for (int i = 1; i <= nHistoryTables; i++) {
+        tHist.computeIndices[i].comp = bi->ci[i];
+        tHist.computeTags[0][i].comp = bi->ct0[i];
+        tHist.computeTags[1][i].comp = bi->ct1[i];
     }
+    updateFoldedHist(tHist);
 }
 
 int
@@ -607,17 +624,14 @@ TAGEBase::updateHistories(ThreadID tid, Addr branch_pc, bool taken,
     }
 
     //prepare next index and tag computations for user branchs
-    for (int i = 1; i <= nHistoryTables; i++)
-    {
-        if (speculative) {
+    if (speculative) {
+        for (int i = 1; i <= nHistoryTables; i++) {
             bi->ci[i]  = tHist.computeIndices[i].comp;
             bi->ct0[i] = tHist.computeTags[0][i].comp;
             bi->ct1[i] = tHist.computeTags[1][i].comp;
         }
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
     }
+    updateFoldedHist(tHist);
     DPRINTF(Tage, "Updating global histories with branch:%lx; taken?:%d, "
             "path Hist: %x; pointer:%d\n", branch_pc, taken, tHist.pathHist,
             tHist.ptGhist);
@@ -641,14 +655,7 @@ TAGEBase::squash(ThreadID tid, bool taken, TAGEBase::BranchInfo *bi,
     tHist.ptGhist = bi->ptGhist;
     tHist.gHist = &(tHist.globalHistory[tHist.ptGhist]);
     tHist.gHist[0] = (taken ? 1 : 0);
-    for (int i = 1; i <= nHistoryTables; i++) {
-        tHist.computeIndices[i].comp = bi->ci[i];
-        tHist.computeTags[0][i].comp = bi->ct0[i];
-        tHist.computeTags[1][i].comp = bi->ct1[i];
-        tHist.computeIndices[i].update(tHist.gHist);
-        tHist.computeTags[0][i].update(tHist.gHist);
-        tHist.computeTags[1][i].update(tHist.gHist);
-    }
+    restoreFoldedHist(tHist, bi);
 }
 
 void
@@ -105,13 +105,26 @@ class TAGEBase : public SimObject
 
         void update(uint8_t * h)
         {
-            comp = (comp << 1) | h[0];
-            comp ^= h[origLength] << outpoint;
+            update(h[0], h[origLength]);
+        }
+
+        /**
+         * Shift in the newest history bit and fold out the bit that
+         * leaves the original history length.
+         * @param in_bit The most recent branch outcome.
+         * @param out_bit The outcome origLength branches ago.
+         */
+        void update(unsigned in_bit, unsigned out_bit)
+        {
+            comp = (comp << 1) | in_bit;
+            comp ^= out_bit << outpoint;
             comp ^= (comp >> compLength);
             comp &= (1ULL << compLength) - 1;
         }
     };
 
+    struct ThreadHistory;
+
   public:
 
     // provider type
@@ -267,6 +280,25 @@ class TAGEBase : public SimObject
     */
     void updateGHist(uint8_t * &h, bool dir, uint8_t * tab, int &PT);
 
+    /**
+     * Update the folded histories of all the tagged tables with the
+     * most recent outcome of the global history. The index and both tag
+     * histories of a table fold the same original history length, so the
+     * bits shifted in and out are only read once per table.
+     * @param tHist The thread history to update.
+     */
+    void updateFoldedHist(ThreadHistory &tHist);
+
+    /**
+     * Restore the folded histories of all the tagged tables to their
+     * state before the given branch, and update them with the most
+     * recent outcome of the global history.
+     * @param tHist The thread history to restore.
+     * @param bi Pointer to information on the prediction
+     * recorded at prediction time.
+     */
+    void restoreFoldedHist(ThreadHistory &tHist, const BranchInfo *bi);
+
     /**
      * Update TAGE. Called at execute to repair histories on a misprediction
      * and at commit to update the tables.
@@ -0,0 +1,51 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.Probe import ProbeListenerObject
+from m5.params import *
+from m5.proxy import *
+
+
+class BranchTraceRecorder(ProbeListenerObject):
+    """This probe listener records the control instructions committed by a
+    core and their outcome in a protobuf branch trace. The trace can be
+    replayed through a branch predictor by a BranchTraceReplayer.
+
+    The return address of the calls is derived from the instruction size,
+    which makes the recorder depend on an ISA providing instruction sizes
+    (Arm, RISC-V and X86), like the decoupled front-end.
+    """
+
+    type = "BranchTraceRecorder"
+    cxx_header = "cpu/probes/branch_trace_recorder.hh"
+    cxx_class = "gem5::BranchTraceRecorder"
+
+    trace_file = Param.String(
+        "", "name of the trace file, defaults to <name>.trc.gz"
+    )
+    compress_threads = Param.Unsigned(
+        1, "Number of threads compressing the trace in the background"
+    )
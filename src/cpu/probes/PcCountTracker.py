@@ -44,6 +44,7 @@ class PcCountTrackerManager(SimObject):
     cxx_exports = [
         PyBindMethod("getPcCount"),
         PyBindMethod("getCurrentPcCountPair"),
+        PyBindMethod("setTargets"),
     ]
 
     targets = VectorParam.PcCountPair("the target PC Count pairs")
@@ -0,0 +1,52 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.Probe import ProbeListenerObject
+from m5.params import *
+from m5.proxy import *
+
+
+class PcSampler(ProbeListenerObject):
+    """This probe listener periodically samples the PC of the last
+    instruction committed by a core, and counts the misses of a set of
+    caches per PC of their requests. The profile is written at the end of
+    the simulation in the folded stack format of flame graph tools, with
+    the PCs symbolized using the debug symbol table.
+    """
+
+    type = "PcSampler"
+    cxx_header = "cpu/probes/pc_sampler.hh"
+    cxx_class = "gem5::PcSampler"
+
+    core = Param.BaseCPU("the sampled cpu")
+    manager = Param.SimObject(Self.core, "the object probed for samples")
+    sample_period = Param.Latency("1us", "time between samples of the core")
+    caches = VectorParam.BaseCache(
+        [], "caches whose misses are attributed to the PC of the request"
+    )
+    output = Param.String(
+        "", "name of the output file, defaults to <name>.folded"
+    )
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/branch_trace_recorder.hh"
+
+#include "base/output.hh"
+#include "cpu/base.hh"
+#include "cpu/pred/branch_type.hh"
+#include "proto/branch_trace.pb.h"
+
+namespace gem5
+{
+
+BranchTraceRecorder::BranchTraceRecorder(
+        const BranchTraceRecorderParams &p)
+    : ProbeListenerObject(p), traceStream(nullptr), insts(0)
+{
+    std::string filename = simout.resolve(
+        p.trace_file.empty() ? name() + ".trc.gz" : p.trace_file);
+    traceStream = new ProtoOutputStream(filename, p.compress_threads);
+
+    registerExitCallback([this]() { closeStream(); });
+}
+
+void
+BranchTraceRecorder::regProbeListeners()
+{
+    using RetiredListener = ProbeListenerArg<BranchTraceRecorder, uint64_t>;
+    using CtrlListener =
+        ProbeListenerArg<BranchTraceRecorder, RetiredCtrlProbeArg>;
+    listeners.push_back(new RetiredListener(this, "RetiredInsts",
+                                            &BranchTraceRecorder::retired));
+    listeners.push_back(new CtrlListener(this, "RetiredCtrl",
+                                         &BranchTraceRecorder::retiredCtrl));
+}
+
+void
+BranchTraceRecorder::startup()
+{
+    ProtoMessage::BranchTraceHeader header_msg;
+    header_msg.set_obj_id(name());
+    traceStream->write(header_msg);
+}
+
+void
+BranchTraceRecorder::retiredCtrl(const RetiredCtrlProbeArg &arg)
+{
+    const StaticInstPtr &inst = arg.inst;
+    const bool taken = arg.pc.branching();
+
+    // The next PC is resolved, advancing a copy of the PC state moves it
+    // to the branch target or to the fall-through
+    std::unique_ptr<PCStateBase> next_pc(arg.pc.clone());
+    inst->advancePC(*next_pc);
+
+    ProtoMessage::BranchTrace msg;
+    msg.set_pc(arg.pc.instAddr());
+    msg.set_target(next_pc->instAddr());
+    msg.set_taken(taken);
+    msg.set_type(branch_prediction::getBranchType(inst));
+    if (inst->isCall()) {
+        // The return address of the call, which the predictor pushes on
+        // the RAS
+        msg.set_fall_through(arg.pc.instAddr() + inst->size());
+    } else if (!taken) {
+        msg.set_fall_through(next_pc->instAddr());
+    }
+    // The CPUs notify RetiredInsts before RetiredCtrl, so the branch
+    // itself is already counted
+    msg.set_insts(insts);
+    insts = 0;
+
+    traceStream->write(msg);
+}
+
+void
+BranchTraceRecorder::closeStream()
+{
+    delete traceStream;
+    traceStream = nullptr;
+}
+
+} // namespace gem5
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
+#define __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
+
+#include <cstdint>
+
+#include "params/BranchTraceRecorder.hh"
+#include "proto/protoio.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+struct RetiredCtrlProbeArg;
+
+/**
+ * Records the control instructions committed by a core, along with
+ * their outcome, in a protobuf branch trace (see branch_trace.proto).
+ * The trace is independent of the timing of the core and can be
+ * replayed through any branch predictor by a BranchTraceReplayer, which
+ * makes it cheap to compare predictor configurations.
+ */
+class BranchTraceRecorder : public ProbeListenerObject
+{
+  public:
+    BranchTraceRecorder(const BranchTraceRecorderParams &params);
+
+    void regProbeListeners() override;
+
+    void startup() override;
+
+  private:
+    /** Called on every committed instruction */
+    void retired(const uint64_t &count) { insts += count; }
+
+    /** Called on every committed control instruction */
+    void retiredCtrl(const RetiredCtrlProbeArg &arg);
+
+    /** Flush and close the trace, the destructor is not called on exit */
+    void closeStream();
+
+    /** Trace output stream */
+    ProtoOutputStream *traceStream;
+
+    /** Instructions committed since the last record */
+    uint64_t insts;
+};
+
+} // namespace gem5
+
+#endif // __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
@@ -34,18 +34,26 @@ namespace gem5
 PcCountTrackerManager::PcCountTrackerManager(
     const PcCountTrackerManagerParams &p)
     : SimObject(p)
+{
+    setTargets(p.targets);
+}
+
+void
+PcCountTrackerManager::setTargets(const std::vector<PcCountPair> &targets)
 {
     currentPair = PcCountPair(0,0);
-    ifListNotEmpty = true;
+    counter.clear();
+    targetPair.clear();
 
-    for (int i = 0 ; i < p.targets.size() ; i++) {
+    for (int i = 0 ; i < targets.size() ; i++) {
         // initialize the counter for the inputted PC Count pair
         // unordered_map does not allow duplicate, so counter won't
         // have duplicates
-        counter.insert(std::make_pair(p.targets[i].getPC(),0));
+        counter.insert(std::make_pair(targets[i].getPC(),0));
         // store all the PC Count pair into the targetPair set
-        targetPair.insert(p.targets[i]);
+        targetPair.insert(targets[i]);
     }
+    ifListNotEmpty = !targetPair.empty();
     DPRINTF(PcCountTracker,
             "total %i PCs in counter\n", counter.size());
     DPRINTF(PcCountTracker,
@@ -57,7 +65,13 @@ PcCountTrackerManager::checkCount(Addr pc)
 {
 
     if(ifListNotEmpty) {
-        int count = ++counter.find(pc)->second;
+        auto it = counter.find(pc);
+        if (it == counter.end()) {
+            // the trackers still watch for the PCs of targets that have
+            // been replaced by setTargets
+            return;
+        }
+        int count = ++it->second;
         // increment the counter of the encountered PC address by 1
 
         currentPair = PcCountPair(pc,count);
@@ -31,6 +31,7 @@
 
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "cpu/base.hh"
 #include "params/PcCountTrackerManager.hh"
@@ -50,6 +51,14 @@ class PcCountTrackerManager : public SimObject {
      */
     void checkCount(Addr pc);
 
+    /** replace the target PC Count pairs and restart counting from zero.
+     * The PCs of the new targets must be among the targets the
+     * PcCountTrackers were created with.
+     *
+     * @param targets the new target PC Count pairs
+     */
+    void setTargets(const std::vector<PcCountPair> &targets);
+
   private:
     /** a counter that stores all the target PC addresses and the number
      * of times the target PC has been executed
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/pc_sampler.hh"
+
+#include <map>
+
+#include "base/cprintf.hh"
+#include "base/loader/symtab.hh"
+#include "base/output.hh"
+#include "cpu/base.hh"
+#include "mem/cache/base.hh"
+#include "mem/cache/cache_probe_arg.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+PcSampler::PcSampler(const PcSamplerParams &p)
+    : ProbeListenerObject(p),
+      cpu(p.core), caches(p.caches),
+      period(p.sample_period),
+      fileName(p.output.empty() ? name() + ".folded" : p.output),
+      tableNames{"running", "stalled", "idle"},
+      lastPc(0), committed(false), isSleeping(false),
+      sampleEvent([this]{ sample(); }, name())
+{
+    fatal_if(!cpu, "%s needs a core to sample", name());
+    fatal_if(period == 0, "%s needs a non-zero sample period", name());
+
+    for (auto cache : caches)
+        tableNames.push_back(cache->name() + ".miss");
+    tables.resize(tableNames.size());
+
+    registerExitCallback([this]() { dump(); });
+}
+
+void
+PcSampler::regProbeListeners()
+{
+    using RetiredListener = ProbeListenerArg<PcSampler, Addr>;
+    using SleepingListener = ProbeListenerArg<PcSampler, bool>;
+    listeners.push_back(new RetiredListener(this, "RetiredInstsPC",
+                                            &PcSampler::retired));
+    listeners.push_back(new SleepingListener(this, "Sleeping",
+                                             &PcSampler::sleeping));
+
+    for (size_t i = 0; i < caches.size(); ++i) {
+        const size_t table = NumCoreKinds + i;
+        cacheListeners.emplace_back(
+            new ProbeListenerArgFunc<CacheAccessProbeArg>(
+                caches[i]->getProbeManager(), "Miss",
+                [this, table](const CacheAccessProbeArg &arg)
+                { missed(table, arg); }));
+    }
+}
+
+void
+PcSampler::startup()
+{
+    schedule(sampleEvent, curTick() + period);
+}
+
+void
+PcSampler::retired(const Addr &pc)
+{
+    lastPc = pc;
+    committed = true;
+}
+
+void
+PcSampler::missed(size_t table, const CacheAccessProbeArg &arg)
+{
+    const RequestPtr &req = arg.pkt->req;
+    if (req->hasPC())
+        ++tables[table][req->getPC()];
+}
+
+void
+PcSampler::sample()
+{
+    if (isSleeping)
+        ++tables[Idle][lastPc];
+    else
+        ++tables[committed ? Running : Stalled][lastPc];
+    committed = false;
+
+    schedule(sampleEvent, curTick() + period);
+}
+
+void
+PcSampler::dump()
+{
+    OutputStream *os = simout.create(fileName);
+    std::ostream &out = *os->stream();
+
+    // Fold the PCs into the functions containing them, in a sorted
+    // order to keep the output stable from run to run
+    for (size_t i = 0; i < tables.size(); ++i) {
+        std::map<std::string, uint64_t> folded;
+        for (const auto &[pc, count] : tables[i]) {
+            auto sym = loader::debugSymbolTable.findNearest(pc);
+            if (sym != loader::debugSymbolTable.end())
+                folded[sym->name()] += count;
+            else
+                folded[csprintf("%#x", pc)] += count;
+        }
+
+        for (const auto &[func, count] : folded)
+            ccprintf(out, "%s;%s;%s %d\n", cpu->name(), tableNames[i], func,
+                     count);
+    }
+
+    simout.close(os);
+}
+
+} // namespace gem5
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PROBES_PC_SAMPLER_HH__
+#define __CPU_PROBES_PC_SAMPLER_HH__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/types.hh"
+#include "params/PcSampler.hh"
+#include "sim/eventq.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+class BaseCache;
+class BaseCPU;
+class CacheAccessProbeArg;
+
+/**
+ * A sampling profiler of the guest code running on a core. At every
+ * sample period it looks at the PC of the last committed instruction,
+ * and attributes the sample to it as running, stalled (nothing was
+ * committed since the previous sample) or idle (the core is asleep).
+ * Misses in the attached caches are attributed to the PC of their
+ * request. Samples are aggregated per PC, and at the end of the
+ * simulation they are symbolized using the debug symbol table and
+ * written in the folded stack format used by flame graph tools.
+ */
+class PcSampler : public ProbeListenerObject
+{
+  public:
+    PcSampler(const PcSamplerParams &params);
+
+    void regProbeListeners() override;
+
+    void startup() override;
+
+    /** Write the profile collected so far */
+    void dump();
+
+  private:
+    /** Kinds of samples, each aggregated in a table of its own */
+    enum SampleKind
+    {
+        Running,
+        Stalled,
+        Idle,
+        NumCoreKinds
+    };
+
+    /** A table of sample counts per PC */
+    using PcTable = std::unordered_map<Addr, uint64_t>;
+
+    /** Called on every committed instruction */
+    void retired(const Addr &pc);
+
+    /** Called when the core goes to sleep or wakes up */
+    void sleeping(const bool &asleep) { isSleeping = asleep; }
+
+    /** Called on a miss in the cache of the given table */
+    void missed(size_t table, const CacheAccessProbeArg &arg);
+
+    /** Take a sample of the core */
+    void sample();
+
+    /** Sampled core */
+    BaseCPU *cpu;
+
+    /** Caches whose misses are counted */
+    const std::vector<BaseCache *> caches;
+
+    /** Time between samples of the core */
+    const Tick period;
+
+    /** Name of the output file */
+    const std::string fileName;
+
+    /** Names of the sample tables, the cache misses following the core */
+    std::vector<std::string> tableNames;
+
+    /** Samples per PC of the core and miss counts per PC of each cache */
+    std::vector<PcTable> tables;
+
+    /** Listeners on the caches, separate from the core ones */
+    std::vector<std::unique_ptr<ProbeListener>> cacheListeners;
+
+    /** PC of the last committed instruction */
+    Addr lastPc;
+
+    /** Whether an instruction was committed since the last sample */
+    bool committed;
+
+    /** Whether the core is asleep */
+    bool isSleeping;
+
+    EventFunctionWrapper sampleEvent;
+};
+
+} // namespace gem5
+
+#endif // __CPU_PROBES_PC_SAMPLER_HH__
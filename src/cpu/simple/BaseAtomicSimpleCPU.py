@@ -61,6 +61,11 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    fetch_line_buffer = Param.Bool(
+        False,
+        "Fetch whole cache lines with a single translation and icache "
+        "access and serve sequential fetches from them",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
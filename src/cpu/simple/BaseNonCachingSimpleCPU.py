@@ -52,6 +52,14 @@ class BaseNonCachingSimpleCPU(BaseAtomicSimpleCPU):
 
     numThreads = 1
 
+    data_backdoor = Param.Bool(
+        True,
+        "Serve plain loads and stores that hit a memory backdoor directly "
+        "from host memory instead of sending a packet. Such stores are "
+        "not snooped, so this is only used while the system has a single "
+        "hardware thread",
+    )
+
     @classmethod
     def memory_mode(cls):
         return "atomic_noncaching"
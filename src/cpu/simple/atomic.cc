@@ -41,12 +41,15 @@
 
 #include "cpu/simple/atomic.hh"
 
+#include <cstring>
+
 #include "arch/generic/decoder.hh"
 #include "base/output.hh"
 #include "cpu/exetrace.hh"
 #include "cpu/utils.hh"
 #include "debug/Drain.hh"
 #include "debug/ExecFaulting.hh"
+#include "debug/Fetch.hh"
 #include "debug/SimpleCPU.hh"
 #include "mem/packet.hh"
 #include "mem/packet_access.hh"
@@ -66,6 +69,7 @@ AtomicSimpleCPU::init()
 
     int cid = threadContexts[0]->contextId();
     ifetch_req->setContext(cid);
+    ifetch_line_req->setContext(cid);
     data_read_req->setContext(cid);
     data_write_req->setContext(cid);
     data_amo_req->setContext(cid);
@@ -78,16 +82,21 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      fetchLineBuffer(p.fetch_line_buffer),
+      fetchLine(p.fetch_line_buffer ? cacheLineSize() : 0),
+      fetchLineVaddr(0), fetchLinePaddr(0), fetchLineThread(0),
+      fetchLineValid(false),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = Request::create();
+    ifetch_line_req = Request::create();
+    data_read_req = Request::create();
+    data_write_req = Request::create();
+    data_amo_req = Request::create();
 }
 
 
@@ -148,6 +157,9 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory or translations may have changed while drained
+    fetchLineValid = false;
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -206,6 +218,8 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *old_cpu)
 
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
+
+    fetchLineValid = false;
 }
 
 void
@@ -298,6 +312,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
         }
+        cpu->invalidateFetchLine(pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -325,6 +340,10 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    // Functional writes (e.g., loaders and debuggers) may patch code
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->invalidateFetchLine(pkt->getAddr(), pkt->getSize());
 }
 
 bool
@@ -495,6 +514,9 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 Packet pkt(req, Packet::makeWriteCmd(req));
                 pkt.dataStatic(data);
 
+                // Drop the fetch line if this is self-modifying code
+                invalidateFetchLine(req->getPaddr(), req->getSize());
+
                 if (req->isLocalAccess()) {
                     dcache_latency +=
                         req->localAccessor(thread->getTC(), &pkt);
@@ -586,6 +608,8 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
         Packet pkt(req, Packet::makeWriteCmd(req));
         pkt.dataStatic(data);
 
+        invalidateFetchLine(req->getPaddr(), req->getSize());
+
         if (req->isLocalAccess()) {
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
@@ -620,6 +644,7 @@ AtomicSimpleCPU::tick()
         ContextID cid = threadContexts[curThread]->contextId();
 
         ifetch_req->setContext(cid);
+        ifetch_line_req->setContext(cid);
         data_read_req->setContext(cid);
         data_write_req->setContext(cid);
         data_amo_req->setContext(cid);
@@ -652,6 +677,13 @@ AtomicSimpleCPU::tick()
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+        Tick icache_latency = 0;
+        bool icache_access = false;
+        if (needToFetch && fetchLineBuffer &&
+                fetchFromLine(icache_latency, icache_access)) {
+            needToFetch = false;
+        }
+
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
@@ -660,8 +692,6 @@ AtomicSimpleCPU::tick()
         }
 
         if (fault == NoFault) {
-            Tick icache_latency = 0;
-            bool icache_access = false;
             dcache_access = false; // assume no dcache access
 
             if (needToFetch) {
@@ -700,6 +730,13 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                // Serializing instructions are where ISAs synchronize
+                // instruction fetch with code and translation changes.
+                if (curStaticInst->isSerializing() ||
+                        curStaticInst->isSquashAfter()) {
+                    fetchLineValid = false;
+                }
             }
 
             // @todo remove me after debugging with legion done
@@ -723,6 +760,9 @@ AtomicSimpleCPU::tick()
             }
 
         }
+        if (fault != NoFault)
+            fetchLineValid = false;
+
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
     }
@@ -738,6 +778,61 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+bool
+AtomicSimpleCPU::fetchFromLine(Tick &latency, bool &access)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+    auto &decoder = thread->decoder;
+
+    const Addr inst_addr = thread->pcState().instAddr();
+    const Addr fetch_pc =
+        (inst_addr & decoder->pcMask()) + t_info.fetchOffset;
+    const unsigned size = decoder->moreBytesSize();
+    const Addr line_vaddr = roundDown(fetch_pc, fetchLine.size());
+
+    // Fetches straddling two lines take the regular path
+    if (fetch_pc + size > line_vaddr + fetchLine.size())
+        return false;
+
+    if (!fetchLineValid || fetchLineVaddr != line_vaddr ||
+            fetchLineThread != curThread) {
+        fetchLineValid = false;
+
+        ifetch_line_req->taskId(taskId());
+        ifetch_line_req->setVirt(line_vaddr, fetchLine.size(),
+                                 Request::INST_FETCH, instRequestorId(),
+                                 inst_addr);
+        Fault fault = thread->mmu->translateAtomic(
+            ifetch_line_req, thread->getTC(), BaseMMU::Execute);
+
+        // Let the regular path raise the fault for the actual fetch
+        // address, and don't buffer anything that may have side effects.
+        if (fault != NoFault || ifetch_line_req->isUncacheable() ||
+                ifetch_line_req->isLocalAccess()) {
+            return false;
+        }
+
+        Packet pkt(ifetch_line_req, MemCmd::ReadReq);
+        pkt.dataStatic(fetchLine.data());
+        latency = sendPacket(icachePort, &pkt);
+        access = true;
+        panic_if(pkt.isError(), "Instruction fetch (%s) failed: %s",
+                pkt.getAddrRange().to_string(), pkt.print());
+
+        fetchLineVaddr = line_vaddr;
+        fetchLinePaddr = ifetch_line_req->getPaddr();
+        fetchLineThread = curThread;
+        fetchLineValid = true;
+    }
+
+    DPRINTF(Fetch, "Fetch: Inst PC:%08p, Fetch PC:%08p (line buffer)\n",
+            inst_addr, fetch_pc);
+    std::memcpy(decoder->moreBytesPtr(),
+                fetchLine.data() + (fetch_pc - line_vaddr), size);
+    return true;
+}
+
 Tick
 AtomicSimpleCPU::fetchInstMem()
 {
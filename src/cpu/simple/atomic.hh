@@ -41,6 +41,8 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <vector>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
@@ -67,6 +69,43 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /**
+     * Instruction fetch line buffer. When enabled, the CPU fetches a
+     * whole cache line with a single translation and I-cache access
+     * and serves subsequent fetches from the same line out of the
+     * buffer. The buffer is dropped when the CPU writes to the line,
+     * when a write to it is snooped, and after faults and serializing
+     * instructions, which is where the ISAs require cross-modifying
+     * code and translation changes to become visible.
+     */
+    const bool fetchLineBuffer;
+    std::vector<uint8_t> fetchLine;
+    Addr fetchLineVaddr;
+    Addr fetchLinePaddr;
+    ThreadID fetchLineThread;
+    bool fetchLineValid;
+
+    /**
+     * Try to serve the current instruction fetch from the line buffer,
+     * refilling it if the fetch moved to a different line.
+     *
+     * @param latency Set to the I-cache latency if the line was refilled.
+     * @param access Set if the I-cache was accessed.
+     * @return true if the fetch bytes were provided, false if the
+     *         caller has to fetch through the regular path.
+     */
+    bool fetchFromLine(Tick &latency, bool &access);
+
+    /** Drop the line buffer if it overlaps a physical range. */
+    void
+    invalidateFetchLine(Addr paddr, Addr size)
+    {
+        if (fetchLineValid && paddr < fetchLinePaddr + fetchLine.size() &&
+                fetchLinePaddr < paddr + size) {
+            fetchLineValid = false;
+        }
+    }
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -141,7 +180,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     {
 
       public:
-        AtomicCPUDPort(const std::string &_name, BaseSimpleCPU *_cpu)
+        AtomicCPUDPort(const std::string &_name, AtomicSimpleCPU *_cpu)
             : AtomicCPUPort(_name), cpu(_cpu)
         {
             cacheBlockMask = ~(cpu->cacheLineSize() - 1);
@@ -151,7 +190,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         Addr cacheBlockMask;
       protected:
-        BaseSimpleCPU *cpu;
+        AtomicSimpleCPU *cpu;
 
         virtual Tick recvAtomicSnoop(PacketPtr pkt);
         virtual void recvFunctionalSnoop(PacketPtr pkt);
@@ -163,6 +202,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
 
     RequestPtr ifetch_req;
+    RequestPtr ifetch_line_req;
     RequestPtr data_read_req;
     RequestPtr data_write_req;
     RequestPtr data_amo_req;
@@ -505,6 +505,8 @@ BaseSimpleCPU::advancePC(const Fault &fault)
         thread->decoder->reset();
     } else {
         if (curStaticInst) {
+            if (curStaticInst->isControl())
+                probeCtrlCommit(curStaticInst, thread->pcState());
             if (curStaticInst->isLastMicroop())
                 curMacroStaticInst = nullStaticInstPtr;
             curStaticInst->advancePC(thread);
@@ -196,6 +196,16 @@ class SimpleExecContext : public ExecContext
         thread->getReg(reg, val);
     }
 
+    const void *
+    getRegOperandRef(const StaticInst *si, int idx, void *val) override
+    {
+        const RegId &reg = si->srcRegIdx(idx);
+        if (si->isDestReg(reg))
+            return ExecContext::getRegOperandRef(si, idx, val);
+        (*execContextStats.numRegReads[reg.classValue()])++;
+        return thread->getReadableReg(reg);
+    }
+
     void *
     getWritableRegOperand(const StaticInst *si, int idx) override
     {
@@ -40,13 +40,15 @@
 #include <cassert>
 
 #include "arch/generic/decoder.hh"
+#include "mem/packet.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
 
 NonCachingSimpleCPU::NonCachingSimpleCPU(
         const BaseNonCachingSimpleCPUParams &p)
-    : AtomicSimpleCPU(p)
+    : AtomicSimpleCPU(p), dataBackdoor(p.data_backdoor)
 {
     assert(p.numThreads == 1);
     fatal_if(!FullSystem && p.workload.size() != 1,
@@ -62,9 +64,46 @@ NonCachingSimpleCPU::verifyMemoryMode() const
     }
 }
 
+bool
+NonCachingSimpleCPU::tryBackdoorAccess(const PacketPtr &pkt)
+{
+    // Stores through a backdoor aren't snooped, so they would go unnoticed
+    // by the LL/SC monitors and fetch buffers of any other thread.
+    if (!dataBackdoor || system->threads.size() != 1)
+        return false;
+
+    // Anything with side effects beyond reading or writing the bytes
+    // (LL/SC, uncacheable or ordered accesses, ...) takes the regular path.
+    const bool is_read = pkt->cmd == MemCmd::ReadReq;
+    const bool is_write = pkt->cmd == MemCmd::WriteReq;
+    if (!(is_read || is_write) || pkt->req->isUncacheable() ||
+            pkt->req->isLLSC()) {
+        return false;
+    }
+
+    auto bd_it = memBackdoors.contains(pkt->getAddrRange());
+    if (bd_it == memBackdoors.end())
+        return false;
+
+    auto *bd = bd_it->second;
+    if (is_read ? !bd->readable() : !bd->writeable())
+        return false;
+
+    uint8_t *host_addr = bd->ptr() + (pkt->getAddr() - bd->range().start());
+    if (is_read)
+        pkt->setData(host_addr);
+    else
+        pkt->writeData(host_addr);
+    pkt->makeResponse();
+    return true;
+}
+
 Tick
 NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 {
+    if (tryBackdoorAccess(pkt))
+        return 0;
+
     MemBackdoorPtr bd = nullptr;
     Tick latency = port.sendAtomicBackdoor(pkt, bd);
 
@@ -60,6 +60,18 @@ class NonCachingSimpleCPU : public AtomicSimpleCPU
   protected:
     AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
 
+    /** Whether data accesses may be served through the backdoors. */
+    const bool dataBackdoor;
+
+    /**
+     * Try to complete a plain read or write directly through one of the
+     * recorded backdoors, without going through the memory system.
+     *
+     * @param pkt The packet to serve.
+     * @return Whether the packet was served and turned into a response.
+     */
+    bool tryBackdoorAccess(const PacketPtr &pkt);
+
     Tick sendPacket(RequestPort &port, const PacketPtr &pkt) override;
     Tick fetchInstMem() override;
 };
@@ -341,6 +341,27 @@ class SimpleThread : public ThreadState, public ThreadContext
                 reg_class.valString(val));
     }
 
+    /**
+     * Return a pointer to the storage of a register so it can be read
+     * in place rather than copied out with getReg().
+     */
+    const void *
+    getReadableReg(const RegId &arch_reg) const
+    {
+        const RegId reg = arch_reg.flatten(*isa);
+
+        const RegIndex idx = reg.index();
+
+        const auto &reg_file = regFiles[reg.classValue()];
+        const auto &reg_class = reg_file.regClass;
+
+        const void *val = reg_file.ptr(idx);
+        DPRINTFV(reg_class.debug(), "Reading %s register %s (%d) as %s.\n",
+                reg.className(), reg_class.regName(arch_reg), idx,
+                reg_class.valString(val));
+        return val;
+    }
+
     void *
     getWritableReg(const RegId &arch_reg) override
     {
@@ -218,6 +218,17 @@ class StaticInst : public RefCounted, public StaticInstFlags
     /// Only the entries from 0 through numDestRegs()-1 are valid.
     const RegId &destRegIdx(int i) const { return (this->*_destRegIdxPtr)[i]; }
 
+    /// Return whether reg is one of the destination registers.
+    bool
+    isDestReg(const RegId &reg) const
+    {
+        for (int i = 0; i < _numDestRegs; i++) {
+            if (destRegIdx(i) == reg)
+                return true;
+        }
+        return false;
+    }
+
     void
     setDestRegIdx(int i, const RegId &val)
     {
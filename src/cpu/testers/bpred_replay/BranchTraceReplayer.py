@@ -0,0 +1,50 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.BranchPredictor import BranchPredictor
+from m5.params import *
+from m5.SimObject import SimObject
+
+
+class BranchTraceReplayer(SimObject):
+    """Replays a branch trace recorded by a BranchTraceRecorder through a
+    branch predictor, without any CPU or memory system. Every branch is
+    predicted and immediately resolved, as if the branches were executed
+    one at a time, and the mispredictions are reported per thousand
+    committed instructions. Several replayers, each with a predictor
+    configuration of its own, can sweep the configurations in a single
+    simulation.
+    """
+
+    type = "BranchTraceReplayer"
+    cxx_header = "cpu/testers/bpred_replay/branch_trace_replayer.hh"
+    cxx_class = "gem5::BranchTraceReplayer"
+
+    trace_file = Param.String("branch trace to replay")
+    branch_pred = Param.BranchPredictor("branch predictor to evaluate")
+    max_branches = Param.Counter(
+        0, "number of branches to replay, 0 replays the whole trace"
+    )
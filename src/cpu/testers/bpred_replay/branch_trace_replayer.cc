@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/bpred_replay/branch_trace_replayer.hh"
+
+#include "base/logging.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "proto/branch_trace.pb.h"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+int BranchTraceReplayer::activeReplayers = 0;
+
+BranchTraceReplayer::BranchInst::BranchInst(enums::BranchType type)
+    : StaticInst(enums::BranchTypeStrings[type], No_OpClass)
+{
+    flags[IsControl] = true;
+    switch (type) {
+      case enums::Return:
+        flags[IsReturn] = true;
+        flags[IsIndirectControl] = true;
+        flags[IsUncondControl] = true;
+        break;
+      case enums::CallDirect:
+        flags[IsCall] = true;
+        flags[IsDirectControl] = true;
+        flags[IsUncondControl] = true;
+        break;
+      case enums::CallIndirect:
+        flags[IsCall] = true;
+        flags[IsIndirectControl] = true;
+        flags[IsUncondControl] = true;
+        break;
+      case enums::DirectCond:
+        flags[IsDirectControl] = true;
+        flags[IsCondControl] = true;
+        break;
+      case enums::DirectUncond:
+        flags[IsDirectControl] = true;
+        flags[IsUncondControl] = true;
+        break;
+      case enums::IndirectCond:
+        flags[IsIndirectControl] = true;
+        flags[IsCondControl] = true;
+        break;
+      case enums::IndirectUncond:
+        flags[IsIndirectControl] = true;
+        flags[IsUncondControl] = true;
+        break;
+      default:
+        panic("Unexpected branch type %d", type);
+    }
+}
+
+Fault
+BranchTraceReplayer::BranchInst::execute(ExecContext *xc,
+                                         trace::InstRecord *traceData) const
+{
+    panic("Replayed branches cannot be executed");
+}
+
+void
+BranchTraceReplayer::BranchInst::advancePC(PCStateBase &pc) const
+{
+    pc.as<PCState>().advance();
+}
+
+std::unique_ptr<PCStateBase>
+BranchTraceReplayer::BranchInst::buildRetPC(const PCStateBase &cur_pc,
+                                            const PCStateBase &call_pc) const
+{
+    std::unique_ptr<PCStateBase> ret_pc(call_pc.clone());
+    ret_pc->as<PCState>().advance();
+    return ret_pc;
+}
+
+std::string
+BranchTraceReplayer::BranchInst::generateDisassembly(
+        Addr pc, const loader::SymbolTable *symtab) const
+{
+    return mnemonic;
+}
+
+BranchTraceReplayer::BranchTraceReplayer(
+        const BranchTraceReplayerParams &p)
+    : SimObject(p), trace(p.trace_file), bpred(p.branch_pred),
+      maxBranches(p.max_branches), seqNum(1),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+    fatal_if(!bpred, "%s needs a branch predictor", name());
+
+    for (int type = 0; type < enums::Num_BranchType; ++type) {
+        if (type != enums::NoBranch)
+            insts[type] = new BranchInst(enums::BranchType(type));
+    }
+
+    ProtoMessage::BranchTraceHeader header_msg;
+    fatal_if(!trace.read(header_msg),
+             "Failed to read the header of branch trace %s", p.trace_file);
+
+    ++activeReplayers;
+}
+
+void
+BranchTraceReplayer::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+void
+BranchTraceReplayer::replay()
+{
+    ProtoMessage::BranchTrace msg;
+
+    for (int i = 0; i < batchSize; ++i) {
+        if ((maxBranches && stats.branches.value() >= maxBranches) ||
+            !trace.read(msg)) {
+            if (--activeReplayers == 0)
+                exitSimLoop("branch trace replay done");
+            return;
+        }
+
+        stats.insts += msg.insts();
+        replayBranch(msg.pc(), msg.target(), msg.taken(), msg.type(),
+                     msg.has_fall_through() ? msg.fall_through() : 0);
+    }
+
+    // Give the other replayers and the simulation loop a chance to run
+    schedule(replayEvent, curTick() + 1);
+}
+
+void
+BranchTraceReplayer::replayBranch(Addr pc_addr, Addr target, bool taken,
+                                  unsigned type, Addr fall_through)
+{
+    fatal_if(type >= enums::Num_BranchType || type == enums::NoBranch,
+             "Invalid branch type %d in the branch trace", type);
+    const StaticInstPtr &inst = insts[type];
+
+    // When the fall-through of a taken branch was not recorded, it is
+    // only used for the not taken predictions, which are wrong anyway
+    PCState pc(pc_addr);
+    if (fall_through)
+        pc.npc(fall_through);
+
+    const bool pred_taken = bpred->predict(inst, seqNum, pc, 0);
+
+    ++stats.branches;
+    if (inst->isCondCtrl())
+        ++stats.condBranches;
+
+    // The predictor moved the PC state to the predicted next PC
+    const bool wrong_dir = pred_taken != taken;
+    const bool wrong_target = !wrong_dir && taken && pc.instAddr() != target;
+
+    if (wrong_dir || wrong_target) {
+        ++stats.mispredicted;
+        if (wrong_dir && inst->isCondCtrl())
+            ++stats.condMispredicted;
+        if (wrong_target)
+            ++stats.targetMispredicted;
+
+        bpred->squash(seqNum, PCState(target), taken, 0);
+    }
+
+    bpred->update(seqNum, 0);
+    ++seqNum;
+}
+
+BranchTraceReplayer::BranchTraceReplayerStats::BranchTraceReplayerStats(
+        statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions committed in the replayed trace"),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of branches replayed"),
+      ADD_STAT(condBranches, statistics::units::Count::get(),
+               "Number of conditional branches replayed"),
+      ADD_STAT(mispredicted, statistics::units::Count::get(),
+               "Number of mispredicted branches"),
+      ADD_STAT(condMispredicted, statistics::units::Count::get(),
+               "Number of conditional branches with a mispredicted "
+               "direction"),
+      ADD_STAT(targetMispredicted, statistics::units::Count::get(),
+               "Number of taken branches with a mispredicted target"),
+      ADD_STAT(mpki, statistics::units::Rate<statistics::units::Count,
+                                             statistics::units::Count>::get(),
+               "Mispredicted branches per thousand instructions"),
+      ADD_STAT(condMispredictRate, statistics::units::Ratio::get(),
+               "Fraction of the conditional branches mispredicted")
+{
+    mpki = mispredicted * 1000 / insts;
+    condMispredictRate = condMispredicted / condBranches;
+}
+
+} // namespace gem5
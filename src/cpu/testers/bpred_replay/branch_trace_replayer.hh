@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAYER_HH__
+#define __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAYER_HH__
+
+#include <array>
+
+#include "arch/generic/pcstate.hh"
+#include "base/statistics.hh"
+#include "base/stats/group.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/static_inst.hh"
+#include "enums/BranchType.hh"
+#include "params/BranchTraceReplayer.hh"
+#include "proto/protoio.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+class BPredUnit;
+} // namespace branch_prediction
+
+/**
+ * Replays a branch trace through a branch predictor. The trace is read
+ * in large batches, each of them processed by a single event, so the
+ * replay runs at the speed of the predictor itself. Each branch is
+ * predicted, checked against its recorded outcome, squashed if it was
+ * mispredicted and committed before the next one is predicted.
+ */
+class BranchTraceReplayer : public SimObject
+{
+  public:
+    BranchTraceReplayer(const BranchTraceReplayerParams &params);
+
+    void startup() override;
+
+  private:
+    /**
+     * The PC state of the replayed branches. The fall-through of a
+     * branch is kept as its next PC, so advancing the PC state moves it
+     * to the fall-through like the ISA would.
+     */
+    typedef GenericISA::SimplePCState<4> PCState;
+
+    /**
+     * The static instruction handed to the predictor for the branches of
+     * a given type. It only carries the control flags the predictors look
+     * at and cannot be executed.
+     */
+    class BranchInst : public StaticInst
+    {
+      public:
+        BranchInst(enums::BranchType type);
+
+        Fault execute(ExecContext *xc,
+                      trace::InstRecord *traceData) const override;
+
+        void advancePC(PCStateBase &pc) const override;
+
+        std::unique_ptr<PCStateBase> buildRetPC(
+                const PCStateBase &cur_pc,
+                const PCStateBase &call_pc) const override;
+
+      protected:
+        std::string generateDisassembly(
+                Addr pc, const loader::SymbolTable *symtab) const override;
+    };
+
+    /** Replay a batch of branches */
+    void replay();
+
+    /** Replay a single branch */
+    void replayBranch(Addr pc, Addr target, bool taken, unsigned type,
+                      Addr fall_through);
+
+    /** Number of branches replayed by each event */
+    static constexpr int batchSize = 1 << 16;
+
+    /** Replayers that have not reached the end of their trace yet */
+    static int activeReplayers;
+
+    ProtoInputStream trace;
+
+    branch_prediction::BPredUnit *bpred;
+
+    const Counter maxBranches;
+
+    /** The static instructions, indexed by branch type */
+    std::array<StaticInstPtr, enums::Num_BranchType> insts;
+
+    /** Sequence number of the next branch */
+    InstSeqNum seqNum;
+
+    EventFunctionWrapper replayEvent;
+
+    struct BranchTraceReplayerStats : public statistics::Group
+    {
+        BranchTraceReplayerStats(statistics::Group *parent);
+
+        statistics::Scalar insts;
+        statistics::Scalar branches;
+        statistics::Scalar condBranches;
+        statistics::Scalar mispredicted;
+        statistics::Scalar condMispredicted;
+        statistics::Scalar targetMispredicted;
+        statistics::Formula mpki;
+        statistics::Formula condMispredictRate;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAYER_HH__
@@ -40,8 +40,9 @@
 
 #include "cpu/testers/memtest/memtest.hh"
 
+#include <unordered_map>
+
 #include "base/compiler.hh"
-#include "base/random.hh"
 #include "base/statistics.hh"
 #include "base/trace.hh"
 #include "debug/MemTest.hh"
@@ -52,7 +53,9 @@
 namespace gem5
 {
 
-static unsigned int TESTER_ALLOCATOR = 0;
+// Testers of different systems (see configs/example/memtest.py -n) do
+// not share memory, so the ids are only unique within a system
+static std::unordered_map<const System *, unsigned> TESTER_ALLOCATOR;
 
 bool
 MemTest::CpuPort::recvTimingResp(PacketPtr pkt)
@@ -107,9 +110,9 @@ MemTest::MemTest(const Params &p)
       nextProgressMessage(p.progress_interval),
       maxLoads(p.max_loads),
       atomic(p.system->isAtomicMode()),
-      suppressFuncErrors(p.suppress_func_errors), stats(this)
+      suppressFuncErrors(p.suppress_func_errors), rng(name()), stats(this)
 {
-    id = TESTER_ALLOCATOR++;
+    id = TESTER_ALLOCATOR[p.system]++;
     fatal_if(id >= blockSize, "Too many testers, only %d allowed\n",
              blockSize - 1);
 
@@ -241,12 +244,12 @@ MemTest::tick()
     assert(!waitResponse);
 
     // create a new request
-    unsigned cmd = random_mt.random(0, 100);
-    uint8_t data = random_mt.random<uint8_t>();
-    bool uncacheable = random_mt.random(0, 100) < percentUncacheable;
-    bool do_atomic = (random_mt.random(0, 100) < percentAtomic) &&
+    unsigned cmd = rng.random(0, 100);
+    uint8_t data = rng.random<uint8_t>();
+    bool uncacheable = rng.random(0, 100) < percentUncacheable;
+    bool do_atomic = (rng.random(0, 100) < percentAtomic) &&
                      !uncacheable;
-    unsigned base = random_mt.random(0, 1);
+    unsigned base = rng.random(0, 1);
     Request::Flags flags;
     Addr paddr;
 
@@ -259,7 +262,7 @@ MemTest::tick()
 
     // generate a unique address
     do {
-        unsigned offset = random_mt.random<unsigned>(0, size - 1);
+        unsigned offset = rng.random<unsigned>(0, size - 1);
 
         // use the tester id as offset within the block for false sharing
         offset = blockAlign(offset);
@@ -273,9 +276,9 @@ MemTest::tick()
         }
     } while (outstandingAddrs.find(paddr) != outstandingAddrs.end());
 
-    bool do_functional = (random_mt.random(0, 100) < percentFunctional) &&
+    bool do_functional = (rng.random(0, 100) < percentFunctional) &&
         !uncacheable;
-    RequestPtr req = std::make_shared<Request>(paddr, 1, flags, requestorId);
+    RequestPtr req = Request::create(paddr, 1, flags, requestorId);
     req->setContext(id);
 
     outstandingAddrs.insert(paddr);
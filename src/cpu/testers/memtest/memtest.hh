@@ -44,6 +44,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "base/random.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/MemTest.hh"
@@ -177,6 +178,9 @@ class MemTest : public ClockedObject
     const bool atomic;
 
     const bool suppressFuncErrors;
+
+    /** Stream the accesses are drawn from, private to this tester */
+    RandomStream rng;
   protected:
     struct MemTestStats : public statistics::Group
     {
@@ -51,7 +51,15 @@ class SpatterGen(ClockedObject):
         "Whether to synchronize on kernel boundaries or not."
     )
 
-    port = RequestPort("Port to send memory requests.")
+    port = VectorRequestPort(
+        "Ports to send memory requests. Every send lane (see send_rate) "
+        "picks the next port that can accept a request in round robin order."
+    )
+    max_outstanding_per_port = Param.Int(
+        0,
+        "Maximum number of requests in flight on each port, "
+        "0 means unlimited.",
+    )
 
     int_regfile_size = Param.Int("Size of the integer register file.")
     fp_regfile_size = Param.Int("Size of the floating point register file.")
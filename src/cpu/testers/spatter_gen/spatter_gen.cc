@@ -50,7 +50,8 @@ SpatterGen::SpatterGen(const Params& params):
     numPendingMemRequests(0),
     stats(this),
     mode(params.processing_mode),
-    port(this, name() + ".port"),
+    maxOutstandingPerPort(params.max_outstanding_per_port),
+    nextSendPort(0),
     intRegFileSize(params.int_regfile_size), intRegUsed(0),
     fpRegFileSize(params.fp_regfile_size), fpRegUsed(0),
     requestGenLatency(params.request_gen_latency),
@@ -70,15 +71,36 @@ SpatterGen::SpatterGen(const Params& params):
             "it may result in inaccuracies in your simulation."
             "Ideally: fp_regfile_size >> request_buffer_entries."
     );
+    fatal_if(params.port_port_connection_count == 0,
+            "%s: At least one port has to be connected.", name());
+    fatal_if(maxOutstandingPerPort < 0,
+            "max_outstanding_per_port can not be negative.");
     generatorBusyUntil.resize(requestGenRate, 0);
     portBusyUntil.resize(sendRate, 0);
+    for (int i = 0; i < params.port_port_connection_count; i++) {
+        ports.push_back(new SpatterGenPort(
+                                        this,
+                                        csprintf("%s.port[%d]", name(), i),
+                                        i
+                                        ));
+    }
+    portPendingRequests.resize(ports.size(), 0);
+}
+
+SpatterGen::~SpatterGen()
+{
+    for (auto* port: ports) {
+        delete port;
+    }
 }
 
 Port&
 SpatterGen::getPort(const std::string& if_name, PortID idx)
 {
     if (if_name == "port") {
-        return port;
+        panic_if(idx == InvalidPortID || idx >= ports.size(),
+                "%s: Invalid port index %d.", name(), idx);
+        return *ports[idx];
     } else {
         return ClockedObject::getPort(if_name, idx);
     }
@@ -135,15 +157,26 @@ SpatterGen::recvReqRetry()
 
 bool
 SpatterGen::SpatterGenPort::recvTimingResp(PacketPtr pkt) {
-    return owner->recvTimingResp(pkt);
+    return owner->recvTimingResp(pkt, id);
 }
 
 bool
-SpatterGen::recvTimingResp(PacketPtr pkt)
+SpatterGen::recvTimingResp(PacketPtr pkt, PortID port_id)
 {
-    DPRINTF(SpatterGen, "%s: Received pkt: %s.\n", __func__, pkt->print());
+    DPRINTF(
+        SpatterGen,
+        "%s: Received pkt: %s on port[%d].\n",
+        __func__, pkt->print(), port_id
+    );
     assert(pkt->isResponse());
 
+    portPendingRequests[port_id]--;
+    if (pkt->isRead()) {
+        stats.portBytesRead[port_id] += pkt->getSize();
+    } else {
+        stats.portBytesWritten[port_id] += pkt->getSize();
+    }
+
     // record trip time.
     SpatterAccess* spatter_access = pkt->findNextSenderState<SpatterAccess>();
     Tick trip_time = (curTick() - requestDepartureTime[pkt->req]);
@@ -196,6 +229,12 @@ SpatterGen::recvTimingResp(PacketPtr pkt)
         scheduleNextGenEvent(nextCycle());
     }
 
+    // this response might have brought port_id below its limit.
+    if (nextSendEvent.pending() && portAvailable(port_id)) {
+        nextSendEvent.wake();
+        scheduleNextSendEvent(nextCycle());
+    }
+
     numPendingMemRequests--;
     checkForSimExit();
     return true;
@@ -462,6 +501,27 @@ SpatterGen::processNextGenEvent()
     }
 }
 
+bool
+SpatterGen::portAvailable(PortID port_id) const
+{
+    bool below_limit = (maxOutstandingPerPort == 0) ||
+                    (portPendingRequests[port_id] < maxOutstandingPerPort);
+    return !ports[port_id]->blocked() && below_limit;
+}
+
+PortID
+SpatterGen::pickPort()
+{
+    for (int i = 0; i < ports.size(); i++) {
+        PortID port_id = (nextSendPort + i) % ports.size();
+        if (portAvailable(port_id)) {
+            nextSendPort = (port_id + 1) % ports.size();
+            return port_id;
+        }
+    }
+    return InvalidPortID;
+}
+
 void
 SpatterGen::scheduleNextSendEvent(Tick when)
 {
@@ -500,26 +560,34 @@ SpatterGen::processNextSendEvent()
             );
             break;
         }
+        PortID port_id = pickPort();
+        if (port_id == InvalidPortID) {
+            // Now if all the memory ports are blocked or have too many
+            // requests in flight, no point in continuing the loop.
+            // also no point in scheduling nextSendEvent. recvReqRetry or
+            // recvTimingResp will wake us up.
+            DPRINTF(
+                SpatterGen,
+                "%s: No memory port available this cycle.\n", __func__
+            );
+            nextSendEvent.sleep();
+            break;
+        }
         PacketPtr pkt = requestBuffer.front();
         DPRINTF(
             SpatterGen,
-            "%s: Sending pkt: %s to port[%d].\n",
-            __func__, pkt->print(), i
+            "%s: Sending pkt: %s to port[%d] through mem port[%d].\n",
+            __func__, pkt->print(), i, port_id
         );
         // NOTE: We assume the port will be busy for 1 cycle.
         portBusyUntil[i] = clockEdge(Cycles(1));
-        port.sendPacket(pkt);
+        ports[port_id]->sendPacket(pkt);
         requestBuffer.pop();
         // increase numPendingMemRequests
         numPendingMemRequests++;
+        portPendingRequests[port_id]++;
         // record packet departure time
         requestDepartureTime[pkt->req] = curTick();
-        // Now if we put the port in blocked state no point in continuing
-        // the loop. also no point in scheduling nextSendEvent.
-        if (port.blocked()) {
-            nextSendEvent.sleep();
-            break;
-        }
     }
     // update firstPortAvailableTime after making all changes.
     for (int i = 0; i < sendRate; i++) {
@@ -569,7 +637,17 @@ SpatterGen::SpatterGenStats::SpatterGenStats(SpatterGen* spatter_gen):
     ADD_STAT(valueAccessLatency, statistics::units::Tick::get(),
         "Distribution of latency for accessing the values array."),
     ADD_STAT(totalIndirectAccessLatency, statistics::units::Tick::get(),
-        "Distribution of total latency for indirect accesses.")
+        "Distribution of total latency for indirect accesses."),
+    ADD_STAT(portBytesRead, statistics::units::Byte::get(),
+        "Number of bytes read through each memory port."),
+    ADD_STAT(portBytesWritten, statistics::units::Byte::get(),
+        "Number of bytes written through each memory port."),
+    ADD_STAT(portReadBW, statistics::units::Rate<
+        statistics::units::Byte, statistics::units::Second>::get(),
+        "Read bandwidth achieved by each memory port."),
+    ADD_STAT(portWriteBW, statistics::units::Rate<
+        statistics::units::Byte, statistics::units::Second>::get(),
+        "Write bandwidth achieved by each memory port.")
 {}
 
 void
@@ -579,6 +657,13 @@ SpatterGen::SpatterGenStats::regStats()
     indexAccessLatency.init(8);
     valueAccessLatency.init(16);
     totalIndirectAccessLatency.init(16);
+
+    portBytesRead.init(spatterGen->ports.size());
+    portBytesWritten.init(spatterGen->ports.size());
+    portReadBW.precision(2);
+    portWriteBW.precision(2);
+    portReadBW = portBytesRead / simSeconds;
+    portWriteBW = portBytesWritten / simSeconds;
 }
 
 } // namespace gem5
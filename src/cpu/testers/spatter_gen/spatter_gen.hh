@@ -111,8 +111,13 @@ class SpatterGen: public ClockedObject
         PacketPtr blockedPacket;
 
       public:
-        SpatterGenPort(SpatterGen* owner, const std::string& name):
-            RequestPort(name), owner(owner), blockedPacket(nullptr) {}
+        // index of this port in the vector of ports of owner.
+        const PortID id;
+
+        SpatterGenPort(SpatterGen* owner, const std::string& name,
+                    PortID id):
+            RequestPort(name), owner(owner), blockedPacket(nullptr), id(id)
+        {}
 
         void sendPacket(PacketPtr pkt);
         bool blocked() const { return blockedPacket != nullptr; }
@@ -147,6 +152,11 @@ class SpatterGen: public ClockedObject
         statistics::Histogram valueAccessLatency;
         statistics::Histogram totalIndirectAccessLatency;
 
+        statistics::Vector portBytesRead;
+        statistics::Vector portBytesWritten;
+        statistics::Formula portReadBW;
+        statistics::Formula portWriteBW;
+
         virtual void regStats() override;
 
         SpatterGenStats(SpatterGen* spatter_gen);
@@ -180,7 +190,19 @@ class SpatterGen: public ClockedObject
 
     // param related members (not necessarily one-to-one with params)
     SpatterProcessingMode mode;
-    SpatterGenPort port;
+    // memory side ports, not to be confused with the "ports" used to
+    // model sendRate below.
+    std::vector<SpatterGenPort*> ports;
+    // maximum number of requests in flight on each of ports, 0 if unlimited.
+    int maxOutstandingPerPort;
+    std::vector<int> portPendingRequests;
+    // first port to consider when picking a port for the next request.
+    PortID nextSendPort;
+    // whether port with port_id is not blocked and below its limit.
+    bool portAvailable(PortID port_id) const;
+    // pick the next available port in round robin order,
+    // returns InvalidPortID if no port is available.
+    PortID pickPort();
     // size of the register files,
     // for every memory instruction we need to allocate one register.
     int intRegFileSize;
@@ -226,6 +248,7 @@ class SpatterGen: public ClockedObject
   public:
     PARAMS(SpatterGen);
     SpatterGen(const Params& params);
+    ~SpatterGen();
 
     Port&
     getPort(const std::string& if_name, PortID idx = InvalidPortID) override;
@@ -233,7 +256,7 @@ class SpatterGen: public ClockedObject
     virtual void startup() override;
 
     void recvReqRetry();
-    bool recvTimingResp(PacketPtr pkt);
+    bool recvTimingResp(PacketPtr pkt, PortID port_id);
     // PyBindMethod to interface adding a kernel with python JSON frontend.
     void addKernel(
         uint32_t id, uint32_t delta, uint32_t count,
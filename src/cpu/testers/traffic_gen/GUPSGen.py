@@ -42,7 +42,11 @@ class GUPSGen(ClockedObject):
 
     system = Param.System(Parent.any, "System this generator is a part of")
 
-    port = RequestPort("Port that should be connected to other components")
+    port = VectorRequestPort(
+        "Ports that should be connected to other components. Reads are "
+        "steered across the ports round robin and every write goes out of "
+        "the port its read was sent to."
+    )
 
     start_addr = Param.Addr(
         0,
@@ -65,6 +69,19 @@ class GUPSGen(ClockedObject):
         1024, "Maximum number of parallel outstanding requests"
     )
 
+    max_outstanding_per_port = Param.Int(
+        0,
+        "Maximum number of requests in flight on each port, "
+        "0 means only request_queue_size limits it",
+    )
+
+    index_file = Param.String(
+        "",
+        "File with pre-generated update table indices (whitespace "
+        "separated integers). The indices are replayed in order, wrapping "
+        "around when the file is exhausted, instead of drawing random ones",
+    )
+
     init_memory = Param.Bool(
         False,
         "Whether or not to initialize the memory,"
@@ -40,7 +40,9 @@
 #include <algorithm>
 
 #include "base/logging.hh"
+#include "base/trace.hh"
 #include "cpu/testers/traffic_gen/base.hh"
+#include "debug/TrafficGen.hh"
 
 namespace gem5
 {
@@ -56,8 +58,8 @@ BaseGen::getPacket(Addr addr, unsigned size, const MemCmd& cmd,
                    Request::FlagsType flags)
 {
     // Create new request
-    RequestPtr req = std::make_shared<Request>(addr, size, flags,
-                                               requestorId);
+    RequestPtr req = Request::create(addr, size, flags,
+                                     requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
@@ -82,10 +84,12 @@ StochasticGen::StochasticGen(SimObject &obj,
                              Tick min_period, Tick max_period,
                              uint8_t read_percent, Addr data_limit)
         : BaseGen(obj, requestor_id, _duration),
+          rng(random_mt.random<uint64_t>()), dataManipulated(0),
           startAddr(start_addr), endAddr(end_addr),
           blocksize(_blocksize), cacheLineSize(cacheline_size),
           minPeriod(min_period), maxPeriod(max_period),
-          readPercent(read_percent), dataLimit(data_limit)
+          readPercent(read_percent), dataLimit(data_limit),
+          batchPos(batchSize)
 {
     if (blocksize > cacheLineSize)
         fatal("TrafficGen %s block size (%d) is larger than "
@@ -99,4 +103,27 @@ StochasticGen::StochasticGen(SimObject &obj,
         fatal("%s cannot have min_period > max_period", name());
 }
 
+PacketPtr
+StochasticGen::getNextPacket()
+{
+    if (batchPos == batchSize) {
+        fillBatch(batch.data());
+        batchPos = 0;
+    }
+    const Access &access = batch[batchPos++];
+
+    assert((readPercent == 0 && !access.isRead) ||
+           (readPercent == 100 && access.isRead) ||
+           readPercent != 100);
+
+    DPRINTF(TrafficGen, "StochasticGen::getNextPacket: %c to addr %x, "
+            "size %d\n", access.isRead ? 'r' : 'w', access.addr, blocksize);
+
+    // add the amount of data manipulated to the total
+    dataManipulated += blocksize;
+
+    return getPacket(access.addr, blocksize,
+                     access.isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
+}
+
 } // namespace gem5
@@ -43,9 +43,12 @@
 #ifndef __CPU_TRAFFIC_GEN_BASE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_BASE_GEN_HH__
 
+#include <array>
 #include <cstdint>
 #include <string>
 
+#include "base/intmath.hh"
+#include "base/random.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "mem/request.hh"
@@ -146,7 +149,74 @@ class StochasticGen : public BaseGen
                   Tick min_period, Tick max_period,
                   uint8_t read_percent, Addr data_limit);
 
+    /**
+     * Get the packet for the next access of the pattern, preparing
+     * the next batch of accesses when all of the current one is used.
+     */
+    PacketPtr getNextPacket() override;
+
   protected:
+    /** An access of the pattern, prepared ahead of its packet */
+    struct Access
+    {
+        Addr addr;
+        bool isRead;
+    };
+
+    /** Number of accesses prepared at a time */
+    static const size_t batchSize = 64;
+
+    /**
+     * Prepare the next accesses of the pattern. Generating a batch at
+     * a time keeps the per-packet work down to building the packet,
+     * with one virtual call per batch rather than per access.
+     *
+     * @param accesses Array of batchSize accesses to fill in
+     */
+    virtual void fillBatch(Access *accesses) = 0;
+
+    /**
+     * Drop any accesses prepared before and reset the data counter,
+     * to be called when entering the state.
+     */
+    void
+    resetBatch()
+    {
+        batchPos = batchSize;
+        dataManipulated = 0;
+    }
+
+    /** Draw a number from [min, max] using the generator's own stream */
+    template <typename T>
+    T
+    randomRange(T min, T max) const
+    {
+        return rng.random<T>(min, max);
+    }
+
+    /** Decide if the next access is a read, given the read percent */
+    bool
+    pickRead() const
+    {
+        return readPercent != 0 &&
+            (readPercent == 100 || randomRange(0, 100) < readPercent);
+    }
+
+    /**
+     * Stream for the pattern and the inter-transaction times, seeded
+     * from the global engine since a traffic generator may go through
+     * several generators. Owning it keeps the generated traffic
+     * independent of the other users of the global engine.
+     */
+    mutable RandomStream rng;
+
+    /**
+     * Counter to determine the amount of data
+     * manipulated. Used to determine if we should continue
+     * generating requests.
+     */
+    Addr dataManipulated;
+
     /** Start of address range */
     const Addr startAddr;
 
@@ -170,6 +240,13 @@ class StochasticGen : public BaseGen
 
     /** Maximum amount of data to manipulate */
     const Addr dataLimit;
+
+  private:
+    /** Accesses prepared ahead of their packets */
+    std::array<Access, batchSize> batch;
+
+    /** Position of the next access in the batch */
+    size_t batchPos;
 };
 
 } // namespace gem5
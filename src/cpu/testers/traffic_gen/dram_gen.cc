@@ -39,7 +39,6 @@
 
 #include <algorithm>
 
-#include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/TrafficGen.hh"
 #include "enums/AddrMap.hh"
@@ -77,8 +76,15 @@ DramGen::DramGen(SimObject &obj,
               nbr_of_banks_util, nbr_of_banks_DRAM);
 }
 
-PacketPtr
-DramGen::getNextPacket()
+void
+DramGen::fillBatch(Access *accesses)
+{
+    for (size_t i = 0; i < batchSize; ++i)
+        accesses[i] = nextAccess();
+}
+
+StochasticGen::Access
+DramGen::nextAccess()
 {
     // if this is the first of the packets in series to be generated,
     // start counting again
@@ -86,20 +92,13 @@ DramGen::getNextPacket()
         countNumSeqPkts = numSeqPkts;
 
         // choose if we generate a read or a write here
-        isRead = readPercent != 0 &&
-            (readPercent == 100 || random_mt.random(0, 100) < readPercent);
-
-        assert((readPercent == 0 && !isRead) ||
-               (readPercent == 100 && isRead) ||
-               readPercent != 100);
+        isRead = pickRead();
 
         // pick a random bank
-        unsigned int new_bank =
-            random_mt.random<unsigned int>(0, nbrOfBanksUtil - 1);
+        unsigned int new_bank = randomRange(0u, nbrOfBanksUtil - 1);
 
         // pick a random rank
-        unsigned int new_rank =
-            random_mt.random<unsigned int>(0, nbrOfRanks - 1);
+        unsigned int new_rank = randomRange(0u, nbrOfRanks - 1);
 
         // Generate the start address of the command series
         // routine will update addr variable with bank, rank, and col
@@ -107,46 +106,39 @@ DramGen::getNextPacket()
         genStartAddr(new_bank, new_rank);
 
     } else {
-        // increment the column by one
-        if (addrMapping == enums::RoRaBaCoCh ||
-            addrMapping == enums::RoRaBaChCo)
-            // Simply increment addr by blocksize to increment
-            // the column by one
-            addr += blocksize;
-
-        else if (addrMapping == enums::RoCoRaBaCh) {
-            // Explicity increment the column bits
-            unsigned int new_col = ((addr / blocksize /
-                                       nbrOfBanksDRAM / nbrOfRanks) %
-                                   (pageSize / blocksize)) + 1;
-            replaceBits(addr, blockBits + bankBits + rankBits + pageBits - 1,
-                        blockBits + bankBits + rankBits, new_col);
-        }
+        nextColumn();
     }
 
-    DPRINTF(TrafficGen, "DramGen::getNextPacket: %c to addr %x, "
-            "size %d, countNumSeqPkts: %d, numSeqPkts: %d\n",
-            isRead ? 'r' : 'w', addr, blocksize, countNumSeqPkts, numSeqPkts);
-
-    // create a new request packet
-    PacketPtr pkt = getPacket(addr, blocksize,
-                              isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
-
-    // add the amount of data manipulated to the total
-    dataManipulated += blocksize;
-
     // subtract the number of packets remained to be generated
     --countNumSeqPkts;
 
-    // return the generated packet
-    return pkt;
+    return Access{addr, isRead};
+}
+
+void
+DramGen::nextColumn()
+{
+    // increment the column by one
+    if (addrMapping == enums::RoRaBaCoCh ||
+        addrMapping == enums::RoRaBaChCo) {
+        // Simply increment addr by blocksize to increment
+        // the column by one
+        addr += blocksize;
+    } else if (addrMapping == enums::RoCoRaBaCh) {
+        // Explicity increment the column bits
+        unsigned int new_col = ((addr / blocksize /
+                                   nbrOfBanksDRAM / nbrOfRanks) %
+                               (pageSize / blocksize)) + 1;
+        replaceBits(addr, blockBits + bankBits + rankBits + pageBits - 1,
+                    blockBits + bankBits + rankBits, new_col);
+    }
 }
 
 void
 DramGen::genStartAddr(unsigned int new_bank, unsigned int new_rank)
 {
     // start by picking a random address in the range
-    addr = random_mt.random<Addr>(startAddr, endAddr - 1);
+    addr = randomRange(startAddr, endAddr - 1);
 
     // round down to start address of a block, i.e. a DRAM burst
     addr -= addr % blocksize;
@@ -166,8 +158,7 @@ DramGen::genStartAddr(unsigned int new_bank, unsigned int new_rank)
 
     // pick a random column, but ensure that there is room for
     // numSeqPkts sequential columns in the same page
-    unsigned int new_col =
-        random_mt.random<unsigned int>(0, columns_per_page - numSeqPkts);
+    unsigned int new_col = randomRange(0u, columns_per_page - numSeqPkts);
 
     if (addrMapping == enums::RoRaBaCoCh ||
         addrMapping == enums::RoRaBaChCo) {
@@ -96,8 +96,6 @@ class DramGen : public RandomGen
             enums::AddrMap addr_mapping,
             unsigned int nbr_of_ranks);
 
-    PacketPtr getNextPacket();
-
     /** Insert bank, rank, and column bits into packed
      *  address to create address for 1st command in a
      *  series
@@ -107,6 +105,16 @@ class DramGen : public RandomGen
     void genStartAddr(unsigned int new_bank , unsigned int new_rank);
 
   protected:
+    void fillBatch(Access *accesses) override;
+
+    /**
+     * Generate the next access, starting a new series of sequential
+     * packets when the current one is done.
+     */
+    Access nextAccess();
+
+    /** Move the address on to the next column of the page */
+    void nextColumn();
 
     /** Number of sequential DRAM packets to be generated per cpu request */
     const unsigned int numSeqPkts;
@@ -39,7 +39,6 @@
 
 #include <algorithm>
 
-#include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/TrafficGen.hh"
 #include "enums/AddrMap.hh"
@@ -47,8 +46,15 @@
 namespace gem5
 {
 
-PacketPtr
-DramRotGen::getNextPacket()
+void
+DramRotGen::fillBatch(Access *accesses)
+{
+    for (size_t i = 0; i < batchSize; ++i)
+        accesses[i] = nextAccess();
+}
+
+StochasticGen::Access
+DramRotGen::nextAccess()
 {
     // if this is the first of the packets in series to be generated,
     // start counting again
@@ -67,10 +73,6 @@ DramRotGen::getNextPacket()
            isRead = readPercent != 0;
         }
 
-        assert((readPercent == 0 && !isRead) ||
-               (readPercent == 100 && isRead) ||
-               readPercent != 100);
-
          // Overwrite random bank value
          // Rotate across banks
          unsigned int new_bank = nextSeqCount % nbrOfBanksUtil;
@@ -90,7 +92,7 @@ DramRotGen::getNextPacket()
          nextSeqCount = (nextSeqCount + 1) %
              (nbrOfRanks * maxSeqCountPerRank);
 
-         DPRINTF(TrafficGen, "DramRotGen::getNextPacket nextSeqCount: %d "
+         DPRINTF(TrafficGen, "DramRotGen::nextAccess nextSeqCount: %d "
                  "new_rank: %d  new_bank: %d\n",
                  nextSeqCount, new_rank, new_bank);
 
@@ -100,40 +102,13 @@ DramRotGen::getNextPacket()
         genStartAddr(new_bank, new_rank);
 
     } else {
-        // increment the column by one
-        if (addrMapping == enums::RoRaBaCoCh ||
-            addrMapping == enums::RoRaBaChCo)
-            // Simply increment addr by blocksize to
-            // increment the column by one
-            addr += blocksize;
-
-        else if (addrMapping ==  enums::RoCoRaBaCh) {
-            // Explicity increment the column bits
-
-                    unsigned int new_col = ((addr / blocksize /
-                                      nbrOfBanksDRAM / nbrOfRanks) %
-                                      (pageSize / blocksize)) + 1;
-            replaceBits(addr, blockBits + bankBits + rankBits + pageBits - 1,
-                        blockBits + bankBits + rankBits, new_col);
-        }
+        nextColumn();
     }
 
-    DPRINTF(TrafficGen, "DramRotGen::getNextPacket: %c to addr %x, "
-            "size %d, countNumSeqPkts: %d, numSeqPkts: %d\n",
-            isRead ? 'r' : 'w', addr, blocksize, countNumSeqPkts, numSeqPkts);
-
-    // create a new request packet
-    PacketPtr pkt = getPacket(addr, blocksize,
-                              isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
-
-    // add the amount of data manipulated to the total
-    dataManipulated += blocksize;
-
     // subtract the number of packets remained to be generated
     --countNumSeqPkts;
 
-    // return the generated packet
-    return pkt;
+    return Access{addr, isRead};
 }
 
 } // namespace gem5
@@ -112,9 +112,16 @@ class DramRotGen : public DramGen
         }
     }
 
-    PacketPtr getNextPacket();
+  protected:
+    void fillBatch(Access *accesses) override;
 
   private:
+    /**
+     * Generate the next access, rotating the bank and rank of every
+     * new series of sequential packets.
+     */
+    Access nextAccess();
+
     /** Number of command series issued before the rank is
         changed.  Should rotate to the next rank after rorating
         throughall the banks for each specified command type     */
@@ -29,7 +29,9 @@
 #include "cpu/testers/traffic_gen/gups_gen.hh"
 
 #include <cstring>
+#include <fstream>
 #include <string>
+#include <tuple>
 
 #include "base/random.hh"
 #include "debug/GUPSGen.hh"
@@ -44,15 +46,35 @@ GUPSGen::GUPSGen(const GUPSGenParams& params):
     nextSendEvent([this]{ sendNextReq(); }, name()),
     system(params.system),
     requestorId(system->getRequestorId(this)),
-    port(name() + ".port", this),
+    nextReadPort(0),
     startAddr(params.start_addr),
     memSize(params.mem_size),
     updateLimit(params.update_limit),
     elementSize(sizeof(uint64_t)), // every element in the table is a uint64_t
     reqQueueSize(params.request_queue_size),
+    maxOutstandingPerPort(params.max_outstanding_per_port),
+    indexFile(params.index_file),
     initMemory(params.init_memory),
     stats(this)
-{}
+{
+    fatal_if(params.port_port_connection_count == 0,
+             "%s: At least one port has to be connected.", name());
+    fatal_if(maxOutstandingPerPort < 0,
+             "%s: max_outstanding_per_port can not be negative.", name());
+    for (int i = 0; i < params.port_port_connection_count; i++) {
+        ports.push_back(new GenPort(csprintf("%s.port[%d]", name(), i),
+                                    this, i));
+    }
+    requestPools.resize(ports.size());
+    portOnTheFly.resize(ports.size(), 0);
+}
+
+GUPSGen::~GUPSGen()
+{
+    for (auto *port : ports) {
+        delete port;
+    }
+}
 
 Port&
 GUPSGen::getPort(const std::string &if_name, PortID idx)
@@ -60,7 +82,9 @@ GUPSGen::getPort(const std::string &if_name, PortID idx)
     if (if_name != "port") {
         return ClockedObject::getPort(if_name, idx);
     } else {
-        return port;
+        panic_if(idx == InvalidPortID || idx >= ports.size(),
+                 "%s: Invalid port index %d.", name(), idx);
+        return *ports[idx];
     }
 }
 
@@ -70,9 +94,37 @@ GUPSGen::init()
     doneReading = false;
     onTheFlyRequests = 0;
     readRequests = 0;
+    queuedRequests = 0;
 
     tableSize = memSize / elementSize;
     numUpdates = 4 * tableSize;
+
+    if (!indexFile.empty()) {
+        loadIndexFile();
+    }
+}
+
+void
+GUPSGen::loadIndexFile()
+{
+    std::ifstream stream(indexFile);
+    fatal_if(!stream, "%s: Could not open index file %s.",
+             name(), indexFile);
+
+    uint64_t index;
+    while (stream >> index) {
+        fatal_if(index >= tableSize, "%s: Index %lu in %s is out of the "
+                 "bounds of the update table (%lu elements).",
+                 name(), index, indexFile, tableSize);
+        indexStream.push_back(index);
+    }
+    fatal_if(!stream.eof(), "%s: Could not parse index file %s.",
+             name(), indexFile);
+    fatal_if(indexStream.empty(), "%s: Index file %s has no indices.",
+             name(), indexFile);
+
+    DPRINTF(GUPSGen, "%s: Read %d indices from %s.\n",
+            __func__, indexStream.size(), indexFile);
 }
 
 void
@@ -91,7 +143,7 @@ GUPSGen::startup()
             }
             Addr addr = indexToAddr(start_index);
             PacketPtr pkt = getWritePacket(addr, block_size, write_data);
-            port.sendFunctionalPacket(pkt);
+            ports[0]->sendFunctionalPacket(pkt);
             delete pkt;
         }
     }
@@ -108,7 +160,7 @@ GUPSGen::indexToAddr (uint64_t index)
 PacketPtr
 GUPSGen::getReadPacket(Addr addr, unsigned int size)
 {
-    RequestPtr req = std::make_shared<Request>(addr, size, 0, requestorId);
+    RequestPtr req = Request::create(addr, size, 0, requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
@@ -123,8 +175,8 @@ GUPSGen::getReadPacket(Addr addr, unsigned int size)
 PacketPtr
 GUPSGen::getWritePacket(Addr addr, unsigned int size, uint8_t *data)
 {
-    RequestPtr req = std::make_shared<Request>(addr, size, 0,
-                                               requestorId);
+    RequestPtr req = Request::create(addr, size, 0,
+                                     requestorId);
     // Dummy PC to have PC-based prefetchers latch on; get entropy into higher
     // bits
     req->setPC(((Addr)requestorId) << 2);
@@ -136,10 +188,26 @@ GUPSGen::getWritePacket(Addr addr, unsigned int size, uint8_t *data)
     return pkt;
 }
 
+bool
+GUPSGen::canSend(PortID port_id) const
+{
+    return !requestPools[port_id].empty() && !ports[port_id]->blocked() &&
+        (maxOutstandingPerPort == 0 ||
+         portOnTheFly[port_id] < maxOutstandingPerPort);
+}
+
+bool
+GUPSGen::canCreate() const
+{
+    return (queuedRequests < reqQueueSize) &&
+        (!doneReading || !responsePool.empty());
+}
+
 void
-GUPSGen::handleResponse(PacketPtr pkt)
+GUPSGen::handleResponse(PacketPtr pkt, PortID port_id)
 {
     onTheFlyRequests--;
+    portOnTheFly[port_id]--;
     DPRINTF(GUPSGen, "%s: onTheFlyRequests: %d.\n",
                 __func__, onTheFlyRequests);
     if (pkt->isWrite()) {
@@ -150,6 +218,7 @@ GUPSGen::handleResponse(PacketPtr pkt)
         stats.totalUpdates++;
         stats.totalWrites++;
         stats.totalBytesWritten += elementSize;
+        stats.portBytesWritten[port_id] += elementSize;
         stats.totalWriteLat += curTick() - exitTimes[pkt->req];
 
         exitTimes.erase(pkt->req);
@@ -160,30 +229,38 @@ GUPSGen::handleResponse(PacketPtr pkt)
 
         stats.totalReads++;
         stats.totalBytesRead += elementSize;
+        stats.portBytesRead[port_id] += elementSize;
         stats.totalReadLat += curTick() - exitTimes[pkt->req];
 
         exitTimes.erase(pkt->req);
 
-        responsePool.push(pkt);
+        responsePool.emplace(pkt, port_id);
     }
-    if (doneReading && requestPool.empty() && onTheFlyRequests == 0) {
+    if (doneReading && queuedRequests == 0 && responsePool.empty() &&
+        onTheFlyRequests == 0) {
         exitSimLoop(name() + " is finished updating the memory.\n");
         return;
     }
 
-    if ((requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()) &&
-        !nextCreateEvent.scheduled())
-    {
+    if (canCreate() && !nextCreateEvent.scheduled()) {
         schedule(nextCreateEvent, nextCycle());
     }
+
+    // The response might have brought the port below its outstanding limit.
+    wakeUp();
 }
 
 void
 GUPSGen::wakeUp()
 {
-    if (!nextSendEvent.scheduled() && !requestPool.empty()) {
-        schedule(nextSendEvent, nextCycle());
+    if (nextSendEvent.scheduled()) {
+        return;
+    }
+    for (PortID i = 0; i < ports.size(); i++) {
+        if (canSend(i)) {
+            schedule(nextSendEvent, nextCycle());
+            return;
+        }
     }
 }
 
@@ -193,7 +270,9 @@ GUPSGen::createNextReq()
     // Prioritize pending writes over reads
     // Write as soon as the data is read
     if (!responsePool.empty()) {
-        PacketPtr pkt = responsePool.front();
+        PacketPtr pkt;
+        PortID port_id;
+        std::tie(pkt, port_id) = responsePool.front();
         responsePool.pop();
 
         uint64_t *updated_value = pkt->getPtr<uint64_t>();
@@ -205,18 +284,23 @@ GUPSGen::createNextReq()
         PacketPtr new_pkt = getWritePacket(addr,
                             elementSize, (uint8_t*) updated_value);
         delete pkt;
-        requestPool.push(new_pkt);
+        requestPools[port_id].push(new_pkt);
+        queuedRequests++;
     } else if (!doneReading) {
         // If no writes then read
         // Check to make sure we're not reading more than we should.
         assert (readRequests < numUpdates);
 
         uint64_t value = readRequests;
-        uint64_t index = random_mt.random((int64_t) 0, tableSize);
+        uint64_t index = indexStream.empty() ?
+            random_mt.random((int64_t) 0, tableSize) :
+            indexStream[readRequests % indexStream.size()];
         Addr addr = indexToAddr(index);
         PacketPtr pkt = getReadPacket(addr, elementSize);
         updateTable[pkt->req] = value;
-        requestPool.push(pkt);
+        requestPools[nextReadPort].push(pkt);
+        queuedRequests++;
+        nextReadPort = (nextReadPort + 1) % ports.size();
         readRequests++;
 
         if (readRequests >= numUpdates) {
@@ -229,53 +313,51 @@ GUPSGen::createNextReq()
         }
     }
 
-    if (!nextCreateEvent.scheduled() &&
-        (requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()))
-    {
+    if (!nextCreateEvent.scheduled() && canCreate()) {
         schedule(nextCreateEvent, nextCycle());
     }
 
-    if (!nextSendEvent.scheduled() && !requestPool.empty()) {
-        schedule(nextSendEvent, nextCycle());
-    }
+    wakeUp();
 }
 
 void
 GUPSGen::sendNextReq()
 {
-    if (!port.blocked()) {
-        PacketPtr pkt = requestPool.front();
+    // Every port can send one request per cycle.
+    for (PortID i = 0; i < ports.size(); i++) {
+        if (!canSend(i)) {
+            continue;
+        }
+        PacketPtr pkt = requestPools[i].front();
 
         exitTimes[pkt->req] = curTick();
         if (pkt->isWrite()) {
-            DPRINTF(GUPSGen, "%s: Sent write pkt, pkt->addr_range: "
-                    "%s, pkt->data: %lu.\n", __func__,
+            DPRINTF(GUPSGen, "%s: Sent write pkt on port[%d], "
+                    "pkt->addr_range: %s, pkt->data: %lu.\n", __func__, i,
                     pkt->getAddrRange().to_string(),
                     *pkt->getPtr<uint64_t>());
         } else {
-            DPRINTF(GUPSGen, "%s: Sent read pkt, pkt->addr_range: %s.\n",
-                    __func__, pkt->getAddrRange().to_string());
+            DPRINTF(GUPSGen, "%s: Sent read pkt on port[%d], "
+                    "pkt->addr_range: %s.\n", __func__, i,
+                    pkt->getAddrRange().to_string());
+        }
+        ports[i]->sendTimingPacket(pkt);
+        if (ports[i]->blocked()) {
+            stats.portBlocked[i]++;
         }
-        port.sendTimingPacket(pkt);
         onTheFlyRequests++;
+        portOnTheFly[i]++;
         DPRINTF(GUPSGen, "%s: onTheFlyRequests: %d.\n",
                 __func__, onTheFlyRequests);
-        requestPool.pop();
+        requestPools[i].pop();
+        queuedRequests--;
     }
 
-    if (!nextCreateEvent.scheduled() &&
-        (requestPool.size() < reqQueueSize) &&
-        (!doneReading || !responsePool.empty()))
-    {
+    if (!nextCreateEvent.scheduled() && canCreate()) {
         schedule(nextCreateEvent, nextCycle());
     }
 
-    if (!nextSendEvent.scheduled()) {
-        if (!requestPool.empty()) {
-            schedule(nextSendEvent, nextCycle());
-        }
-    }
+    wakeUp();
 }
 
 
@@ -320,12 +402,13 @@ GUPSGen::GenPort::recvReqRetry()
 bool
 GUPSGen::GenPort::recvTimingResp(PacketPtr pkt)
 {
-    owner->handleResponse(pkt);
+    owner->handleResponse(pkt, id);
     return true;
 }
 
 GUPSGen::GUPSGenStat::GUPSGenStat(GUPSGen* parent) :
     statistics::Group(parent),
+    gen(parent),
     ADD_STAT(totalUpdates, statistics::units::Count::get(),
         "Total number of updates the generator made in the memory"),
     ADD_STAT(GUPS, statistics::units::Rate<statistics::units::Count,
@@ -352,7 +435,19 @@ GUPSGen::GUPSGenStat::GUPSGenStat(GUPSGen* parent) :
     ADD_STAT(totalWriteLat, statistics::units::Tick::get(),
         "Total latency of write requests."),
     ADD_STAT(avgWriteLat, statistics::units::Tick::get(),
-        "Average latency for write requests")
+        "Average latency for write requests"),
+    ADD_STAT(portBytesRead, statistics::units::Byte::get(),
+        "Number of bytes read through each port"),
+    ADD_STAT(portReadBW, statistics::units::Rate<statistics::units::Byte,
+                statistics::units::Second>::get(),
+        "Average read bandwidth received through each port"),
+    ADD_STAT(portBytesWritten, statistics::units::Byte::get(),
+        "Number of bytes written through each port"),
+    ADD_STAT(portWriteBW, statistics::units::Rate<statistics::units::Byte,
+                statistics::units::Second>::get(),
+        "Average write bandwidth received through each port"),
+    ADD_STAT(portBlocked, statistics::units::Count::get(),
+        "Number of requests each port had to retry")
 {}
 
 void
@@ -371,6 +466,16 @@ GUPSGen::GUPSGenStat::regStats()
 
     avgWriteBW = totalBytesWritten / simSeconds;
     avgWriteLat = (totalWriteLat) / totalWrites;
+
+    const int num_ports = gen->ports.size();
+    portBytesRead.init(num_ports);
+    portBytesWritten.init(num_ports);
+    portBlocked.init(num_ports);
+    portReadBW.precision(2);
+    portWriteBW.precision(2);
+
+    portReadBW = portBytesRead / simSeconds;
+    portWriteBW = portBytesWritten / simSeconds;
 }
 
 }
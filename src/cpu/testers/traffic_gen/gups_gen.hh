@@ -38,7 +38,9 @@
  */
 
 #include <queue>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -86,9 +88,14 @@ class GUPSGen : public ClockedObject
 
       public:
 
-        GenPort(const std::string& name, GUPSGen *owner) :
+        /**
+         * @brief Index of this port in the vector of ports of its owner.
+         */
+        const PortID id;
+
+        GenPort(const std::string& name, GUPSGen *owner, PortID id) :
             RequestPort(name), owner(owner), _blocked(false),
-            blockedPacket(nullptr)
+            blockedPacket(nullptr), id(id)
         {}
 
         /**
@@ -158,8 +165,27 @@ class GUPSGen : public ClockedObject
     /**
      * @brief Handles the incoming responses from the outside.
      * @param pkt Pointer to the packet that includes the response.
+     * @param port_id Index of the port the response arrived on.
+     */
+    void handleResponse(PacketPtr pkt, PortID port_id);
+
+    /**
+     * @brief Read the pre-generated indices from indexFile into
+     * indexStream.
+     */
+    void loadIndexFile();
+
+    /**
+     * @brief Whether the port has a queued request and is allowed to send
+     * it, i.e. it is not blocked and it is below its outstanding limit.
+     */
+    bool canSend(PortID port_id) const;
+
+    /**
+     * @brief Whether there is room in the request pools and something left
+     * to create.
      */
-    void handleResponse(PacketPtr pkt);
+    bool canCreate() const;
 
     /**
      * @brief This function allows the port to wake its owner GUPSGen object
@@ -169,7 +195,8 @@ class GUPSGen : public ClockedObject
     void wakeUp();
 
     /**
-     * @brief Create the next request and store in the requestPool.
+     * @brief Create the next request and store it in the request pool of
+     * its port.
      */
     void createNextReq();
 
@@ -180,7 +207,7 @@ class GUPSGen : public ClockedObject
     EventFunctionWrapper nextCreateEvent;
 
     /**
-     * @brief Send outstanding requests from requestPool to the port.
+     * @brief Send outstanding requests from the request pools to the ports.
      */
     void sendNextReq();
 
@@ -206,19 +233,25 @@ class GUPSGen : public ClockedObject
     std::unordered_map<RequestPtr, Tick> exitTimes;
 
     /**
-     * @brief A queue to store the outstanding requests whether read or write.
-     * The element at the front of the queue is sent to outside everytime
-     * nextSendEvent is scheduled.
+     * @brief One queue per port to store the outstanding requests whether
+     * read or write. The element at the front of each queue is sent to
+     * outside everytime nextSendEvent is scheduled.
      */
-    std::queue<PacketPtr> requestPool;
+    std::vector<std::queue<PacketPtr>> requestPools;
 
     /**
-     * @brief A queue to store response packets from reads. each response in
-     * the response pool will generate a write request. The write request
-     * updates the value of data in the response packet with its corresponding
-     * value in the update table.
+     * @brief The total number of requests in requestPools.
      */
-    std::queue<PacketPtr> responsePool;
+    int queuedRequests;
+
+    /**
+     * @brief A queue to store response packets from reads along with the
+     * port they were received on. each response in the response pool will
+     * generate a write request. The write request updates the value of data
+     * in the response packet with its corresponding value in the update
+     * table.
+     */
+    std::queue<std::pair<PacketPtr, PortID>> responsePool;
 
     /**
      * @brief The total number of updates (one read and one write) to do for
@@ -244,9 +277,14 @@ class GUPSGen : public ClockedObject
     const RequestorID requestorId;
 
     /**
-     * @brief An instance of GenPort to communicate with the outside.
+     * @brief Instances of GenPort to communicate with the outside.
+     */
+    std::vector<GenPort *> ports;
+
+    /**
+     * @brief The port the next read request will be steered to.
      */
-    GenPort port;
+    PortID nextReadPort;
 
     /**
      * @brief The beginning address for allocating the array.
@@ -270,11 +308,28 @@ class GUPSGen : public ClockedObject
     const int elementSize;
 
     /**
-     * @brief  The maximum number of outstanding requests (i.e. maximum length
-     * of the requestPool), specified as 1024 by the HPCC benchmark.
+     * @brief  The maximum number of outstanding requests (i.e. maximum total
+     * length of the requestPools), specified as 1024 by the HPCC benchmark.
      */
     int reqQueueSize;
 
+    /**
+     * @brief The maximum number of requests in flight on each port, zero
+     * means there is no limit other than reqQueueSize.
+     */
+    int maxOutstandingPerPort;
+
+    /**
+     * @brief Path of the file holding pre-generated table indices, empty
+     * if random indices should be used.
+     */
+    std::string indexFile;
+
+    /**
+     * @brief The pre-generated table indices read from indexFile.
+     */
+    std::vector<uint64_t> indexStream;
+
     /**
      * @brief Boolean value to determine whether we need to initialize the
      * array with the right values, as we don't care about the values, this
@@ -296,6 +351,11 @@ class GUPSGen : public ClockedObject
      */
     int onTheFlyRequests;
 
+    /**
+     * @brief The number of requests in flight on each port.
+     */
+    std::vector<int> portOnTheFly;
+
     /**
      * @brief The number of read requests currently created.
      */
@@ -306,6 +366,8 @@ class GUPSGen : public ClockedObject
         GUPSGenStat(GUPSGen* parent);
         void regStats() override;
 
+        GUPSGen *gen;
+
         statistics::Scalar totalUpdates;
         statistics::Formula GUPS;
 
@@ -320,11 +382,18 @@ class GUPSGen : public ClockedObject
         statistics::Formula avgWriteBW;
         statistics::Scalar totalWriteLat;
         statistics::Formula avgWriteLat;
+
+        statistics::Vector portBytesRead;
+        statistics::Formula portReadBW;
+        statistics::Vector portBytesWritten;
+        statistics::Formula portWriteBW;
+        statistics::Vector portBlocked;
     } stats;
 
   public:
 
     GUPSGen(const GUPSGenParams &params);
+    ~GUPSGen();
 
     Port &getPort(const std::string &if_name,
                 PortID idx=InvalidPortID) override;
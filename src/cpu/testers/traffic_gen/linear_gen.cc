@@ -39,7 +39,6 @@
 
 #include <algorithm>
 
-#include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/TrafficGen.hh"
 
@@ -51,27 +50,21 @@ LinearGen::enter()
 {
     // reset the address and the data counter
     nextAddr = startAddr;
-    dataManipulated = 0;
+    resetBatch();
 }
 
-PacketPtr
-LinearGen::getNextPacket()
+void
+LinearGen::fillBatch(Access *accesses)
 {
-    // choose if we generate a read or a write here
-    bool isRead = readPercent != 0 &&
-        (readPercent == 100 || random_mt.random(0, 100) < readPercent);
-
-    assert((readPercent == 0 && !isRead) || (readPercent == 100 && isRead) ||
-           readPercent != 100);
-
-    DPRINTF(TrafficGen, "LinearGen::getNextPacket: %c to addr %x, size %d\n",
-            isRead ? 'r' : 'w', nextAddr, blocksize);
-
-    // Add the amount of data manipulated to the total
-    dataManipulated += blocksize;
+    for (size_t i = 0; i < batchSize; ++i)
+        accesses[i] = nextAccess();
+}
 
-    PacketPtr pkt = getPacket(nextAddr, blocksize,
-                              isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
+StochasticGen::Access
+LinearGen::nextAccess()
+{
+    // choose if we generate a read or a write here
+    Access access{nextAddr, pickRead()};
 
     // increment the address
     nextAddr += blocksize;
@@ -84,7 +77,7 @@ LinearGen::getNextPacket()
         nextAddr = startAddr;
     }
 
-    return pkt;
+    return access;
 }
 
 Tick
@@ -99,7 +92,7 @@ LinearGen::nextPacketTick(bool elastic, Tick delay) const
         return MaxTick;
     } else {
         // return the time when the next request should take place
-        Tick wait = random_mt.random(minPeriod, maxPeriod);
+        Tick wait = randomRange(minPeriod, maxPeriod);
 
         // compensate for the delay experienced to not be elastic, by
         // default the value we generate is from the time we are
@@ -90,26 +90,22 @@ class LinearGen : public StochasticGen
         : StochasticGen(obj, requestor_id, _duration, start_addr, end_addr,
                         _blocksize, cacheline_size, min_period, max_period,
                         read_percent, data_limit),
-          nextAddr(0),
-          dataManipulated(0)
+          nextAddr(0)
     { }
 
     void enter();
 
-    PacketPtr getNextPacket();
-
     Tick nextPacketTick(bool elastic, Tick delay) const;
 
+  protected:
+    void fillBatch(Access *accesses) override;
+
   private:
+    /** Generate the next access and advance the address */
+    Access nextAccess();
+
     /** Address of next request */
     Addr nextAddr;
-
-    /**
-     * Counter to determine the amount of data
-     * manipulated. Used to determine if we should continue
-     * generating requests.
-     */
-    Addr dataManipulated;
 };
 
 } // namespace gem5
@@ -39,7 +39,6 @@
 
 #include <algorithm>
 
-#include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/TrafficGen.hh"
 
@@ -50,34 +49,20 @@ void
 RandomGen::enter()
 {
     // reset the counter to zero
-    dataManipulated = 0;
+    resetBatch();
 }
 
-PacketPtr
-RandomGen::getNextPacket()
+void
+RandomGen::fillBatch(Access *accesses)
 {
-    // choose if we generate a read or a write here
-    bool isRead = readPercent != 0 &&
-        (readPercent == 100 || random_mt.random(0, 100) < readPercent);
-
-    assert((readPercent == 0 && !isRead) || (readPercent == 100 && isRead) ||
-           readPercent != 100);
-
-    // address of the request
-    Addr addr = random_mt.random(startAddr, endAddr - 1);
-
-    // round down to start address of block
-    addr -= addr % blocksize;
+    for (size_t i = 0; i < batchSize; ++i) {
+        // choose if we generate a read or a write here
+        accesses[i].isRead = pickRead();
 
-    DPRINTF(TrafficGen, "RandomGen::getNextPacket: %c to addr %x, size %d\n",
-            isRead ? 'r' : 'w', addr, blocksize);
-
-    // add the amount of data manipulated to the total
-    dataManipulated += blocksize;
-
-    // create a new request packet
-    return getPacket(addr, blocksize,
-                     isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
+        // address of the request, rounded down to the start of a block
+        Addr addr = randomRange(startAddr, endAddr - 1);
+        accesses[i].addr = addr - addr % blocksize;
+    }
 }
 
 Tick
@@ -93,7 +78,7 @@ RandomGen::nextPacketTick(bool elastic, Tick delay) const
         return MaxTick;
     } else {
         // return the time when the next request should take place
-        Tick wait = random_mt.random(minPeriod, maxPeriod);
+        Tick wait = randomRange(minPeriod, maxPeriod);
 
         // compensate for the delay experienced to not be elastic, by
         // default the value we generate is from the time we are
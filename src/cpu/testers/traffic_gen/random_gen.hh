@@ -87,23 +87,15 @@ class RandomGen : public StochasticGen
               uint8_t read_percent, Addr data_limit)
         : StochasticGen(obj, requestor_id, _duration, start_addr, end_addr,
                         _blocksize, cacheline_size, min_period, max_period,
-                        read_percent, data_limit),
-          dataManipulated(0)
+                        read_percent, data_limit)
     { }
 
     void enter();
 
-    PacketPtr getNextPacket();
-
     Tick nextPacketTick(bool elastic, Tick delay) const;
 
   protected:
-    /**
-     * Counter to determine the amount of data
-     * manipulated. Used to determine if we should continue
-     * generating requests.
-     */
-    Addr dataManipulated;
+    void fillBatch(Access *accesses) override;
 };
 
 } // namespace gem5
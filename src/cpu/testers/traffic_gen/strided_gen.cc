@@ -39,7 +39,6 @@
 
 #include <algorithm>
 
-#include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/TrafficGen.hh"
 
@@ -56,7 +55,7 @@ StridedGen::StridedGen(SimObject& obj, RequestorID requestor_id,
                     block_size, cacheline_size, min_period, max_period,
                     read_percent, data_limit),
     offset(offset), superblockSize(superblock_size), strideSize(stride_size),
-    nextAddr(0), dataManipulated(0)
+    nextAddr(0)
 {
     assert(superblock_size % block_size == 0);
     assert(offset % superblock_size == 0);
@@ -68,27 +67,21 @@ StridedGen::enter()
 {
     // reset the address and the data counter
     nextAddr = startAddr + offset;
-    dataManipulated = 0;
+    resetBatch();
 }
 
-PacketPtr
-StridedGen::getNextPacket()
+void
+StridedGen::fillBatch(Access *accesses)
 {
-    // choose if we generate a read or a write here
-    bool isRead = readPercent != 0 &&
-        (readPercent == 100 || random_mt.random(0, 100) < readPercent);
-
-    assert((readPercent == 0 && !isRead) || (readPercent == 100 && isRead) ||
-           readPercent != 100);
-
-    DPRINTF(TrafficGen, "StridedGen::getNextPacket: %c to addr %x, size %d\n",
-            isRead ? 'r' : 'w', nextAddr, blocksize);
-
-    // Add the amount of data manipulated to the total
-    dataManipulated += blocksize;
+    for (size_t i = 0; i < batchSize; ++i)
+        accesses[i] = nextAccess();
+}
 
-    PacketPtr pkt = getPacket(nextAddr, blocksize,
-                              isRead ? MemCmd::ReadReq : MemCmd::WriteReq);
+StochasticGen::Access
+StridedGen::nextAccess()
+{
+    // choose if we generate a read or a write here
+    Access access{nextAddr, pickRead()};
 
     // increment the address
     nextAddr += blocksize;
@@ -107,7 +100,7 @@ StridedGen::getNextPacket()
         nextAddr = startAddr + offset;
     }
 
-    return pkt;
+    return access;
 }
 
 Tick
@@ -122,7 +115,7 @@ StridedGen::nextPacketTick(bool elastic, Tick delay) const
         return MaxTick;
     } else {
         // return the time when the next request should take place
-        Tick wait = random_mt.random(minPeriod, maxPeriod);
+        Tick wait = randomRange(minPeriod, maxPeriod);
 
         // compensate for the delay experienced to not be elastic, by
         // default the value we generate is from the time we are
@@ -94,11 +94,14 @@ class StridedGen : public StochasticGen
 
     void enter();
 
-    PacketPtr getNextPacket();
-
     Tick nextPacketTick(bool elastic, Tick delay) const;
 
+  protected:
+    void fillBatch(Access *accesses) override;
+
   private:
+    /** Generate the next access and advance the address */
+    Access nextAccess();
 
     Addr offset;
     Addr superblockSize;
@@ -107,13 +110,6 @@ class StridedGen : public StochasticGen
 
     /** Address of next request */
     Addr nextAddr;
-
-    /**
-     * Counter to determine the amount of data
-     * manipulated. Used to determine if we should continue
-     * generating requests.
-     */
-    Addr dataManipulated;
 };
 
 } // namespace gem5
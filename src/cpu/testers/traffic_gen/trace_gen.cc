@@ -42,17 +42,19 @@
 #include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/TrafficGen.hh"
-#include "proto/packet.pb.h"
 #include "sim/core.hh"
 #include "sim/cur_tick.hh"
 
 namespace gem5
 {
 
-TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceGen::InputStream::InputStream(const std::string& filename,
+                                   Tick start_tick)
+    : trace(filename), packets(trace), startTick(start_tick)
 {
     init();
+    seekStart();
+    packets.start();
 }
 
 void
@@ -71,19 +73,36 @@ TraceGen::InputStream::init()
 void
 TraceGen::InputStream::reset()
 {
+    packets.stop();
     trace.reset();
     init();
+    seekStart();
+    packets.start();
+}
+
+void
+TraceGen::InputStream::seekStart()
+{
+    // Never seek back to the header, the remaining packets before the
+    // start tick are skipped when reading
+    if (startTick != 0) {
+        trace.seekRecord(std::max(trace.findTick(startTick),
+                                  trace.record()));
+    }
 }
 
 bool
 TraceGen::InputStream::read(TraceElement& element)
 {
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    while (packets.read(pkt_msg)) {
+        if (pkt_msg.tick() < startTick)
+            continue;
+
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
-        element.tick = pkt_msg.tick();
+        element.tick = pkt_msg.tick() - startTick;
         element.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
         return true;
     }
@@ -48,6 +48,7 @@
 #include "base/intmath.hh"
 #include "base_gen.hh"
 #include "mem/packet.hh"
+#include "proto/packet.pb.h"
 #include "proto/protoio.hh"
 
 namespace gem5
@@ -114,14 +115,27 @@ class TraceGen : public BaseGen
         /// Input file stream for the protobuf trace
         ProtoInputStream trace;
 
+        /// Packets decoded ahead of time on a helper thread
+        ProtoReadAhead<ProtoMessage::Packet> packets;
+
+        /// Packets before this tick are skipped
+        const Tick startTick;
+
+        /**
+         * Seek to the indexed block closest to the start tick, if
+         * there is one.
+         */
+        void seekStart();
+
       public:
 
         /**
          * Create a trace input stream for a given file name.
          *
          * @param filename Path to the file to read from
+         * @param start_tick Tick in the trace to start from
          */
-        InputStream(const std::string& filename);
+        InputStream(const std::string& filename, Tick start_tick = 0);
 
         /**
          * Reset the stream such that it can be played once
@@ -138,7 +152,8 @@ class TraceGen : public BaseGen
         /**
          * Attempt to read a trace element from the stream,
          * and also notify the caller if the end of the file
-         * was reached.
+         * was reached. The element is timed relative to the start
+         * tick.
          *
          * @param element Trace element to populate
          * @return True if an element could be read successfully
@@ -156,11 +171,13 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param start_tick Skip the packets in the trace before this tick
      */
     TraceGen(SimObject &obj, RequestorID requestor_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             Tick start_tick = 0)
         : BaseGen(obj, requestor_id, _duration),
-          trace(trace_file),
+          trace(trace_file, start_tick),
           tickOffset(0),
           addrOffset(addr_offset),
           traceComplete(false)
@@ -36,6 +36,15 @@
 namespace gem5
 {
 
+/**
+ * A circular buffer of T indexed by time relative to now. Users write
+ * into the present (index 0) or the future and read from the past. On
+ * advance() the slot which becomes the furthest future is reset to a
+ * freshly constructed T, but only if it was accessed at a non-negative
+ * index since it was last reset: slots nobody wrote to are still
+ * pristine and are recycled as they are. Writes made through negative
+ * (past) indices are therefore not guaranteed to be cleared.
+ */
 template <class T>
 class TimeBuffer
 {
@@ -47,6 +56,8 @@ class TimeBuffer
 
     char *data;
     std::vector<char *> index;
+    /** Slots which may differ from a freshly constructed T */
+    std::vector<bool> dirty;
     unsigned base;
 
     void valid(int idx) const
@@ -139,7 +150,8 @@ class TimeBuffer
   public:
     TimeBuffer(int p, int f)
         : past(p), future(f), size(past + future + 1),
-          data(new char[size * sizeof(T)]), index(size), base(0)
+          data(new char[size * sizeof(T)]), index(size), dirty(size, false),
+          base(0)
     {
         assert(past >= 0 && future >= 0);
         char *ptr = data;
@@ -184,6 +196,9 @@ class TimeBuffer
         int ptr = base + future;
         if (ptr >= (int)size)
             ptr -= size;
+        if (!dirty[ptr])
+            return;
+        dirty[ptr] = false;
         (reinterpret_cast<T *>(index[ptr]))->~T();
         std::memset(index[ptr], 0, sizeof(T));
         new (index[ptr]) T;
@@ -207,17 +222,27 @@ class TimeBuffer
         return vector_index;
     }
 
+    /** Index of the slot at idx, noting a possible write to it */
+    int
+    writableIndex(int idx)
+    {
+        int vector_index = calculateVectorIndex(idx);
+        if (idx >= 0)
+            dirty[vector_index] = true;
+        return vector_index;
+    }
+
   public:
     T *access(int idx)
     {
-        int vector_index = calculateVectorIndex(idx);
+        int vector_index = writableIndex(idx);
 
         return reinterpret_cast<T *>(index[vector_index]);
     }
 
     T &operator[](int idx)
     {
-        int vector_index = calculateVectorIndex(idx);
+        int vector_index = writableIndex(idx);
 
         return reinterpret_cast<T &>(*index[vector_index]);
     }
@@ -61,6 +61,15 @@ class TraceCPU(ClockedObject):
     dcache_port = RequestPort("Data Port")
     instTraceFile = Param.String("", "Instruction trace file")
     dataTraceFile = Param.String("", "Data dependency trace file")
+
+    # Records to skip at the start of the traces. Seeking is fast for
+    # traces written with a block index next to them.
+    instTraceSkip = Param.UInt64(
+        0, "Number of records to skip at the start of the instruction trace"
+    )
+    dataTraceSkip = Param.UInt64(
+        0, "Number of records to skip at the start of the data trace"
+    )
     sizeStoreBuffer = Param.Unsigned(
         16, "Number of entries in the store buffer"
     )
@@ -81,6 +90,15 @@ class TraceCPU(ClockedObject):
         False, "Exit when any one Trace CPU completes execution"
     )
 
+    # When replaying the traces of several cores recorded with
+    # ElasticTrace.traceSyncPoints set, the Trace CPUs with this enabled
+    # execute the synchronization points, i.e. atomic and locked accesses,
+    # in the order they committed during recording.
+    replaySyncPoints = Param.Bool(
+        False,
+        "Execute synchronization points in the order recorded across cores",
+    )
+
     # If progress msg interval is set to a non-zero value, it is treated as
     # the interval of committed instructions at which an info message is
     # printed.
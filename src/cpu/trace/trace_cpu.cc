@@ -37,6 +37,9 @@
 
 #include "cpu/trace/trace_cpu.hh"
 
+#include <algorithm>
+#include <limits>
+
 #include "base/compiler.hh"
 #include "sim/sim_exit.hh"
 #include "sim/system.hh"
@@ -47,6 +50,9 @@ namespace gem5
 // Declare and initialize the static counter for number of trace CPUs.
 int TraceCPU::numTraceCPUs = 0;
 
+uint64_t TraceCPU::nextSyncSeq = 1;
+std::vector<TraceCPU *> TraceCPU::syncCPUs;
+
 TraceCPU::TraceCPU(const TraceCPUParams &params)
     :   ClockedObject(params),
         cacheLineSize(params.system->cacheLineSize()),
@@ -56,7 +62,8 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
         dataRequestorID(params.system->getRequestorId(this, "data")),
         instTraceFile(params.instTraceFile),
         dataTraceFile(params.dataTraceFile),
-        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile),
+        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile,
+                  params.instTraceSkip),
         dcacheGen(*this, ".dside", dcachePort, dataRequestorID, dataTraceFile,
                   params),
         icacheNextEvent([this]{ schedIcacheNext(); }, name()),
@@ -66,11 +73,16 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
         execCompleteEvent(nullptr),
         enableEarlyExit(params.enableEarlyExit),
         progressMsgInterval(params.progressMsgInterval),
-        progressMsgThreshold(params.progressMsgInterval), traceStats(this)
+        progressMsgThreshold(params.progressMsgInterval),
+        replaySyncPoints(params.replaySyncPoints), waitingSync(0),
+        traceStats(this)
 {
     // Increment static counter for number of Trace CPUs.
     ++TraceCPU::numTraceCPUs;
 
+    if (replaySyncPoints)
+        syncCPUs.push_back(this);
+
     // Check that the python parameters for sizes of ROB, store buffer and
     // load buffer do not overflow the corresponding C++ variables.
     fatal_if(params.sizeROB > UINT16_MAX,
@@ -174,10 +186,79 @@ TraceCPU::schedDcacheNext()
 
     dcacheGen.execute();
     if (dcacheGen.isExecComplete()) {
+        leaveSync();
         checkAndSchedExitEvent();
     }
 }
 
+bool
+TraceCPU::syncReady(uint64_t sync_seq)
+{
+    if (!replaySyncPoints || sync_seq <= nextSyncSeq) {
+        waitingSync = 0;
+        return true;
+    }
+
+    DPRINTF(TraceCPUData, "Synchronization point %lli waits for %lli.\n",
+            sync_seq, nextSyncSeq);
+    waitingSync = sync_seq;
+    skipMissingSync();
+    return waitingSync == 0;
+}
+
+void
+TraceCPU::syncDone(uint64_t sync_seq)
+{
+    if (!replaySyncPoints)
+        return;
+
+    nextSyncSeq = std::max(nextSyncSeq, sync_seq + 1);
+    wakeSync();
+}
+
+void
+TraceCPU::wakeSync()
+{
+    for (auto cpu : syncCPUs) {
+        if (cpu->waitingSync != 0 && cpu->waitingSync <= nextSyncSeq) {
+            cpu->waitingSync = 0;
+            cpu->schedDcacheNextEvent(cpu->clockEdge());
+        }
+    }
+}
+
+void
+TraceCPU::skipMissingSync()
+{
+    // As long as one of the Trace CPUs makes progress, it may still
+    // execute the next synchronization point
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+    for (auto cpu : syncCPUs) {
+        if (cpu->waitingSync == 0)
+            return;
+        next = std::min(next, cpu->waitingSync);
+    }
+
+    if (!syncCPUs.empty() && next > nextSyncSeq) {
+        DPRINTF(TraceCPUData, "Skipping synchronization points %lli to "
+                "%lli that are not replayed.\n", nextSyncSeq, next - 1);
+        nextSyncSeq = next;
+        wakeSync();
+    }
+}
+
+void
+TraceCPU::leaveSync()
+{
+    auto it = std::find(syncCPUs.begin(), syncCPUs.end(), this);
+    if (it == syncCPUs.end())
+        return;
+
+    syncCPUs.erase(it);
+    waitingSync = 0;
+    skipMissingSync();
+}
+
 void
 TraceCPU::checkAndSchedExitEvent()
 {
@@ -237,6 +318,8 @@ ElasticDataGenStatGroup::ElasticDataGenStatGroup(statistics::Group *parent,
              "Number of strictly ordered loads"),
     ADD_STAT(numSOStores, statistics::units::Count::get(),
              "Number of strictly ordered stores"),
+    ADD_STAT(numSyncStalls, statistics::units::Count::get(),
+             "Number of times a synchronization point had to wait"),
     ADD_STAT(dataLastTick, statistics::units::Tick::get(),
              "Last tick simulated from the elastic data trace")
 {
@@ -397,6 +480,7 @@ TraceCPU::ElasticDataGen::execute()
     // Proceed to execute from readyList
     auto graph_itr = depGraph.begin();
     auto free_itr = readyList.begin();
+    bool sync_stall = false;
     // Iterate through readyList until the next free node has its execute
     // tick later than curTick or the end of readyList is reached
     while (free_itr->execTick <= curTick() && free_itr != readyList.end()) {
@@ -406,6 +490,16 @@ TraceCPU::ElasticDataGen::execute()
         assert(graph_itr != depGraph.end());
         GraphNode* node_ptr = graph_itr->second;
 
+        // A synchronization point executes once the ones before it in the
+        // recorded order have executed, possibly on another Trace CPU,
+        // which wakes this one up again
+        if (node_ptr->syncSeq != 0 && !retryPkt &&
+            !owner.syncReady(node_ptr->syncSeq)) {
+            ++elasticStats.numSyncStalls;
+            sync_stall = true;
+            break;
+        }
+
         // If there is a retryPkt send that else execute the load
         if (retryPkt) {
             // The retryPkt must be the request that was created by the
@@ -433,6 +527,9 @@ TraceCPU::ElasticDataGen::execute()
             break;
         }
 
+        if (node_ptr->syncSeq != 0)
+            owner.syncDone(node_ptr->syncSeq);
+
         // Proceed to remove dependencies for the successfully executed node.
         // If it is a load which is not strictly ordered and we sent a
         // request for it successfully, we do not yet mark any register
@@ -528,6 +625,11 @@ TraceCPU::ElasticDataGen::execute()
                 retryPkt->req->getReqInstSeqNum());
         return;
     }
+    if (sync_stall) {
+        DPRINTF(TraceCPUData, "Not scheduling an event as waiting for "
+                "another Trace CPU to reach a synchronization point.\n");
+        return;
+    }
     // If the size of the dependency graph is less than the dependency window
     // then read from the trace file to populate the graph next time we are in
     // execute.
@@ -593,7 +695,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
     }
 
     // Create a request and the packet containing request
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, requestorId);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
@@ -1084,7 +1186,7 @@ TraceCPU::FixedRetryGen::send(Addr addr, unsigned size, const MemCmd& cmd,
 {
 
     // Create new request
-    auto req = std::make_shared<Request>(addr, size, flags, requestorId);
+    auto req = Request::create(addr, size, flags, requestorId);
     req->setPC(pc);
 
     // If this is not done it triggers assert in L1 cache for invalid contextId
@@ -1203,8 +1305,11 @@ TraceCPU::DcachePort::recvReqRetry()
 }
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
+        const std::string& filename, const double time_multiplier,
+        uint64_t skip) :
     trace(filename),
+    records(trace),
+    startRecord(1 + skip),
     timeMultiplier(time_multiplier),
     microOpCount(0)
 {
@@ -1222,19 +1327,24 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
         // when the data dependency trace was captured in the o3cpu model
         windowSize = header_msg.window_size();
     }
+
+    trace.seekRecord(startRecord);
+    records.start();
 }
 
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
-    trace.reset();
+    records.stop();
+    trace.seekRecord(startRecord);
+    records.start();
 }
 
 bool
 TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
 {
     ProtoMessage::InstDepRecord pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (records.read(pkt_msg)) {
         // Required fields
         element->seqNum = pkt_msg.seq_num();
         element->type = pkt_msg.type();
@@ -1287,6 +1397,11 @@ TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
         else
             element->pc = 0;
 
+        if (pkt_msg.has_sync_seq())
+            element->syncSeq = pkt_msg.sync_seq();
+        else
+            element->syncSeq = 0;
+
         // ROB occupancy number
         ++microOpCount;
         if (pkt_msg.has_weight()) {
@@ -1386,8 +1501,9 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
     return Record::RecordType_Name(type);
 }
 
-TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename,
+                                                  uint64_t skip)
+    : trace(filename), packets(trace), startRecord(1 + skip)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
@@ -1399,19 +1515,24 @@ TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
                   header_msg.tick_freq());
         }
     }
+
+    trace.seekRecord(startRecord);
+    packets.start();
 }
 
 void
 TraceCPU::FixedRetryGen::InputStream::reset()
 {
-    trace.reset();
+    packets.stop();
+    trace.seekRecord(startRecord);
+    packets.start();
 }
 
 bool
 TraceCPU::FixedRetryGen::InputStream::read(TraceElement* element)
 {
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    if (packets.read(pkt_msg)) {
         element->cmd = pkt_msg.cmd();
         element->addr = pkt_msg.addr();
         element->blocksize = pkt_msg.size();
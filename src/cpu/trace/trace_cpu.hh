@@ -43,6 +43,7 @@
 #include <queue>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "debug/TraceCPUData.hh"
@@ -190,6 +191,25 @@ class TraceCPU : public ClockedObject
      */
     void schedDcacheNextEvent(Tick when);
 
+    /**
+     * Check if a synchronization point may execute, which is when all the
+     * points before it in the recorded order have executed on any of the
+     * Trace CPUs. If not, this Trace CPU waits to be woken up once they
+     * have.
+     *
+     * @param sync_seq Global number of the synchronization point
+     * @return True if the synchronization point may execute
+     */
+    bool syncReady(uint64_t sync_seq);
+
+    /**
+     * Mark a synchronization point as executed and wake up the Trace CPU
+     * waiting for the next one.
+     *
+     * @param sync_seq Global number of the synchronization point
+     */
+    void syncDone(uint64_t sync_seq);
+
   protected:
 
     /**
@@ -362,13 +382,20 @@ class TraceCPU : public ClockedObject
             // Input file stream for the protobuf trace
             ProtoInputStream trace;
 
+            // Packets decoded ahead of time on a helper thread
+            ProtoReadAhead<ProtoMessage::Packet> packets;
+
+            // Number of the first record to replay, the header is zero
+            const uint64_t startRecord;
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
+             * @param skip Number of records to skip after the header
              */
-            InputStream(const std::string& filename);
+            InputStream(const std::string& filename, uint64_t skip);
 
             /**
              * Reset the stream such that it can be played once
@@ -391,11 +418,11 @@ class TraceCPU : public ClockedObject
         /* Constructor */
         FixedRetryGen(TraceCPU& _owner, const std::string& _name,
                    RequestPort& _port, RequestorID requestor_id,
-                   const std::string& trace_file) :
+                   const std::string& trace_file, uint64_t skip) :
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file),
+            trace(trace_file, skip),
             genName(owner.name() + ".fixedretry." + _name),
             retryPkt(nullptr),
             delta(0),
@@ -575,6 +602,9 @@ class TraceCPU : public ClockedObject
             /** Instruction PC */
             Addr pc;
 
+            /** Global number of a synchronization point, zero if none */
+            uint64_t syncSeq;
+
             /** List of order dependencies. */
             RobDepList robDep;
 
@@ -749,6 +779,12 @@ class TraceCPU : public ClockedObject
             /** Input file stream for the protobuf trace */
             ProtoInputStream trace;
 
+            /** Records decoded ahead of time on a helper thread */
+            ProtoReadAhead<ProtoMessage::InstDepRecord> records;
+
+            /** Number of the first record to replay, the header is zero */
+            const uint64_t startRecord;
+
             /**
              * A multiplier for the compute delays in the trace to modulate
              * the Trace CPU frequency either up or down. The Trace CPU's
@@ -772,9 +808,10 @@ class TraceCPU : public ClockedObject
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param skip Number of records to skip after the header
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier, uint64_t skip);
 
             /**
              * Reset the stream such that it can be played once
@@ -809,7 +846,8 @@ class TraceCPU : public ClockedObject
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier,
+                  params.dataTraceSkip),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
@@ -1007,6 +1045,8 @@ class TraceCPU : public ClockedObject
             statistics::Scalar numSplitReqs;
             statistics::Scalar numSOLoads;
             statistics::Scalar numSOStores;
+            /** Number of times a synchronization point had to wait */
+            statistics::Scalar numSyncStalls;
             /** Tick when ElasticDataGen completes execution */
             statistics::Scalar dataLastTick;
         } elasticStats;
@@ -1089,6 +1129,34 @@ class TraceCPU : public ClockedObject
      * message is printed.
      */
     uint64_t progressMsgThreshold;
+
+    /** Whether to execute synchronization points in the recorded order */
+    const bool replaySyncPoints;
+
+    /** Synchronization point this Trace CPU waits for, zero if none */
+    uint64_t waitingSync;
+
+    /**
+     * Number of the next synchronization point to execute, shared by all
+     * Trace CPUs replaying synchronization points.
+     */
+    static uint64_t nextSyncSeq;
+
+    /** Trace CPUs replaying synchronization points with a trace left */
+    static std::vector<TraceCPU *> syncCPUs;
+
+    /** Wake up the Trace CPUs waiting for executed points */
+    void wakeSync();
+
+    /**
+     * Skip the synchronization points that none of the Trace CPUs is
+     * going to execute once they all wait, e.g. because the points were
+     * recorded on a core that is not replayed.
+     */
+    void skipMissingSync();
+
+    /** Stop taking part in synchronization when the data trace is done */
+    void leaveSync();
     struct TraceStats : public statistics::Group
     {
         TraceStats(TraceCPU *trace);
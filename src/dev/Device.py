@@ -111,6 +111,16 @@ class DmaDevice(PioDevice):
         "several devices attached to it",
     )
 
+    dma_burst_size = Param.MemorySize(
+        "0B",
+        "Maximum size of the DMA packets, 0 for the cache line size. "
+        "Bursts larger than a cache line need a path to memory without "
+        "caches, and must not exceed the memory interleaving granularity",
+    )
+    dma_max_pending = Param.MemorySize(
+        "0B", "Maximum number of DMA bytes in flight, 0 for no limit"
+    )
+
     def addIommuProperty(self, state, node):
         """
         This method takes an FdtState and a FdtNode as parameters, and
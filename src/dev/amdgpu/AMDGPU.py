@@ -112,6 +112,18 @@ class SDMAEngine(DmaVirtDevice):
     gpu_device = Param.AMDGPUDevice(NULL, "GPU Controller")
     walker = Param.VegaPagetableWalker("Page table walker")
 
+    # Large copies (e.g., uploading model weights) dominate the simulation
+    # time when every chunk goes through the timing DMA path
+    bulk_copy_threshold = Param.MemorySize(
+        "0B",
+        "Copy packets of at least this size move their data functionally "
+        "and complete after a delay given by bulk_copy_bandwidth. 0B "
+        "disables the bulk copies.",
+    )
+    bulk_copy_bandwidth = Param.MemoryBandwidth(
+        "32GiB/s", "Bandwidth the bulk copies are modelled with"
+    )
+
 
 class PM4PacketProcessor(DmaVirtDevice):
     type = "PM4PacketProcessor"
@@ -65,8 +65,8 @@ AMDGPUMemoryManager::writeRequest(Addr addr, uint8_t *data, int size,
 
     ChunkGenerator gen(addr, size, cacheLineSize);
     for (; !gen.done(); gen.next()) {
-        RequestPtr req = std::make_shared<Request>(gen.addr(), gen.size(),
-                                                   flag, _requestorId);
+        RequestPtr req = Request::create(gen.addr(), gen.size(),
+                                         flag, _requestorId);
 
         PacketPtr pkt = Packet::createWrite(req);
         uint8_t *dataPtr = new uint8_t[gen.size()];
@@ -109,8 +109,8 @@ AMDGPUMemoryManager::readRequest(Addr addr, uint8_t *data, int size,
 
     ChunkGenerator gen(addr, size, cacheLineSize);
     for (; !gen.done(); gen.next()) {
-        RequestPtr req = std::make_shared<Request>(gen.addr(), gen.size(),
-                                                   flag, _requestorId);
+        RequestPtr req = Request::create(gen.addr(), gen.size(),
+                                         flag, _requestorId);
 
         PacketPtr pkt = Packet::createRead(req);
         pkt->dataStatic<uint8_t>(dataPtr);
@@ -134,6 +134,22 @@ AMDGPUMemoryManager::readRequest(Addr addr, uint8_t *data, int size,
     requestId++;
 }
 
+void
+AMDGPUMemoryManager::functionalAccess(Addr addr, uint8_t *data, int size,
+                                      bool write)
+{
+    assert(data);
+
+    ChunkGenerator gen(addr, size, cacheLineSize);
+    for (; !gen.done(); gen.next()) {
+        RequestPtr req = Request::create(gen.addr(), gen.size(), 0,
+                                         _requestorId);
+        Packet pkt(req, write ? MemCmd::WriteReq : MemCmd::ReadReq);
+        pkt.dataStatic<uint8_t>(data + gen.complete());
+        _gpuMemPort.sendFunctional(&pkt);
+    }
+}
+
 bool
 AMDGPUMemoryManager::GPUMemPort::recvTimingResp(PacketPtr pkt)
 {
@@ -117,6 +117,17 @@ class AMDGPUMemoryManager : public ClockedObject
     void readRequest(Addr addr, uint8_t *data, int size,
                      Request::Flags flag, Event *callback);
 
+    /**
+     * Functionally read or write size amount of data of device memory at
+     * addr, without modelling any timing.
+     *
+     * @param addr Device address to access.
+     * @param data Pointer to the data to write, or to read into.
+     * @param size Number of bytes to access.
+     * @param write True to write data, false to read it.
+     */
+    void functionalAccess(Addr addr, uint8_t *data, int size, bool write);
+
     /**
      * Get the requestorID for the memory manager. This ID is used for all
      * packets which should be routed through the device network.
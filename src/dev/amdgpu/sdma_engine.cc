@@ -33,6 +33,7 @@
 
 #include "arch/amdgpu/vega/pagetable_walker.hh"
 #include "arch/generic/mmu.hh"
+#include "base/chunk_generator.hh"
 #include "debug/SDMAData.hh"
 #include "debug/SDMAEngine.hh"
 #include "dev/amdgpu/interrupt_handler.hh"
@@ -50,7 +51,9 @@ SDMAEngine::SDMAEngine(const SDMAEngineParams &p)
       gfxDoorbell(0), gfxDoorbellOffset(0), gfxWptr(0), pageBase(0),
       pageRptr(0), pageDoorbell(0), pageDoorbellOffset(0),
       pageWptr(0), gpuDevice(nullptr), walker(p.walker),
-      mmioBase(p.mmio_base), mmioSize(p.mmio_size)
+      mmioBase(p.mmio_base), mmioSize(p.mmio_size),
+      bulkCopyThreshold(p.bulk_copy_threshold),
+      bulkCopyBandwidth(p.bulk_copy_bandwidth)
 {
     gfx.ib(&gfxIb);
     gfxIb.parent(&gfx);
@@ -675,6 +678,11 @@ SDMAEngine::copy(SDMAQueue *q, sdmaCopy *pkt)
         }
     }
 
+    if (bulkCopyThreshold && pkt->count >= bulkCopyThreshold) {
+        copyBulk(q, pkt);
+        return;
+    }
+
     // Read data from the source first, then call the copyReadData method
     uint8_t *dmaBuffer = new uint8_t[pkt->count];
     Addr device_addr = getDeviceAddress(pkt->source);
@@ -750,16 +758,80 @@ SDMAEngine::copyReadData(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer)
         dmaWriteVirt(pkt->dest, pkt->count, cb, (void *)dmaBuffer);
     }
 
+    updateGARTShadow(device_addr, dmaBuffer, pkt->count);
+}
+
+void
+SDMAEngine::updateGARTShadow(Addr device_addr, const uint8_t *data,
+                             unsigned size)
+{
     // For destinations in the GART table, gem5 uses a mapping tables instead
     // of functionally going to device memory, so we need to update that copy.
     if (gpuDevice->getVM().inGARTRange(device_addr)) {
+        const uint64_t *data64 = reinterpret_cast<const uint64_t *>(data);
         // GART entries are always 8 bytes.
-        assert((pkt->count % 8) == 0);
-        for (int i = 0; i < pkt->count/8; ++i) {
+        assert((size % 8) == 0);
+        for (int i = 0; i < size/8; ++i) {
             Addr gart_addr = device_addr + i*8 - gpuDevice->getVM().gartBase();
             DPRINTF(SDMAEngine, "Shadow copying to GART table %lx -> %lx\n",
-                    gart_addr, dmaBuffer64[i]);
-            gpuDevice->getVM().gartTable[gart_addr] = dmaBuffer64[i];
+                    gart_addr, data64[i]);
+            gpuDevice->getVM().gartTable[gart_addr] = data64[i];
+        }
+    }
+}
+
+/* Copy packet moving its data functionally, see bulk_copy_threshold. */
+void
+SDMAEngine::copyBulk(SDMAQueue *q, sdmaCopy *pkt)
+{
+    DPRINTF(SDMAEngine, "Bulk copy of %d bytes\n", pkt->count);
+
+    // Same order as the timing copies: read all the source, then write
+    // all the destination
+    uint8_t *dmaBuffer = new uint8_t[pkt->count];
+    functionalAccess(pkt->source, dmaBuffer, pkt->count, false);
+    functionalAccess(pkt->dest, dmaBuffer, pkt->count, true);
+    updateGARTShadow(getDeviceAddress(pkt->dest), dmaBuffer, pkt->count);
+
+    const Tick delay = pkt->count * bulkCopyBandwidth;
+    auto cb = new EventFunctionWrapper(
+        [ = ]{ copyDone(q, pkt, dmaBuffer); }, name(), true);
+    schedule(cb, curTick() + delay);
+}
+
+void
+SDMAEngine::functionalAccess(Addr raw_addr, uint8_t *data, unsigned size,
+                             bool write)
+{
+    if (getDeviceAddress(raw_addr)) {
+        // Access the minimum page size at a time in case the physical
+        // addresses are not contiguous.
+        ChunkGenerator gen(raw_addr, size, AMDGPU_MMHUB_PAGE_SIZE);
+        for (; !gen.done(); gen.next()) {
+            Addr chunk_addr = getDeviceAddress(gen.addr());
+            assert(chunk_addr);
+            gpuDevice->getMemMgr()->functionalAccess(chunk_addr, data,
+                                                     gen.size(), write);
+            data += gen.size();
+        }
+        return;
+    }
+
+    // Host memory, accessed through the DMA port so that the caches are
+    // looked up too
+    const unsigned line_size = dmaPort.sys->cacheLineSize();
+    TranslationGenPtr tgen = translate(raw_addr, size);
+    for (const auto &range : *tgen) {
+        fatal_if(range.fault, "Failed translation: vaddr 0x%x", range.vaddr);
+
+        ChunkGenerator gen(range.paddr, range.size, line_size);
+        for (; !gen.done(); gen.next()) {
+            RequestPtr req = Request::create(gen.addr(), gen.size(), 0,
+                                             dmaPort.requestorId);
+            Packet dma_pkt(req, write ? MemCmd::WriteReq : MemCmd::ReadReq);
+            dma_pkt.dataStatic<uint8_t>(data);
+            dmaPort.sendFunctional(&dma_pkt);
+            data += gen.size();
         }
     }
 }
@@ -162,6 +162,33 @@ class SDMAEngine : public DmaVirtDevice
     Addr mmioBase = 0;
     Addr mmioSize = 0;
 
+    /** Copies of at least this many bytes use copyBulk(), if not 0. */
+    const uint64_t bulkCopyThreshold;
+    /** Bandwidth of the bulk copies, in ticks per byte. */
+    const double bulkCopyBandwidth;
+
+    /**
+     * Functionally access the source or destination of an SDMA packet,
+     * either in device or in host memory.
+     *
+     * @param raw_addr Address as given by the packet.
+     * @param data Pointer to the data to write, or to read into.
+     * @param size Number of bytes to access.
+     * @param write True to write data, false to read it.
+     */
+    void functionalAccess(Addr raw_addr, uint8_t *data, unsigned size,
+                          bool write);
+
+    /**
+     * Update the gem5 copy of the GART table after writing to it.
+     *
+     * @param device_addr Device address written.
+     * @param data The data written.
+     * @param size Number of bytes written.
+     */
+    void updateGARTShadow(Addr device_addr, const uint8_t *data,
+                          unsigned size);
+
   public:
     SDMAEngine(const SDMAEngineParams &p);
 
@@ -230,6 +257,12 @@ class SDMAEngine : public DmaVirtDevice
     void copy(SDMAQueue *q, sdmaCopy *pkt);
     void copyReadData(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer);
     void copyDone(SDMAQueue *q, sdmaCopy *pkt, uint8_t *dmaBuffer);
+    /**
+     * Implements a copy packet without going through the timing memory
+     * system: the data is moved functionally, and the packet completes
+     * after the time it takes to transfer it at bulk_copy_bandwidth.
+     */
+    void copyBulk(SDMAQueue *q, sdmaCopy *pkt);
     void indirectBuffer(SDMAQueue *q, sdmaIndirectBuffer *pkt);
     void fence(SDMAQueue *q, sdmaFence *pkt);
     void fenceDone(SDMAQueue *q, sdmaFence *pkt);
@@ -171,8 +171,8 @@ AMDGPUSystemHub::AtomicResponseEvent::process()
 
     // Create a new write packet which will be modifed then written
     RequestPtr write_req =
-        std::make_shared<Request>(pkt->getAddr(), pkt->getSize(), 0,
-                                  pkt->requestorId());
+        Request::create(pkt->getAddr(), pkt->getSize(), 0,
+                        pkt->requestorId());
 
     PacketPtr write_pkt = Packet::createWrite(write_req);
     uint8_t *write_data = new uint8_t[pkt->getSize()];
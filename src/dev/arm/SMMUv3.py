@@ -78,6 +78,12 @@ class SMMUv3DeviceInterface(ClockedObject):
     tlb_lat = Param.Cycles(3, "Main TLB lookup latency")
     tlb_slots = Param.Cycles(3, "Main TLB lookup slots")
 
+    timing_fast_path = Param.Bool(
+        False,
+        "Translate micro/main TLB hits of an otherwise idle interface "
+        "without a translation process in timing mode",
+    )
+
     prefetch_enable = Param.Bool(False, "Enable prefetch")
     prefetch_reserve_last_way = Param.Bool(
         True, "Reserve last way of the main TLB for prefetched entries"
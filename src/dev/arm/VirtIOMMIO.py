@@ -56,6 +56,11 @@ class MmioVirtIO(BasicPioDevice):
 
     vio = Param.VirtIODeviceBase(VirtIODummyDevice(), "VirtIO device")
 
+    def queueNotifyAddr(self):
+        """Address of the QueueNotify register, which can be passed to
+        KvmVM.doorbells to avoid VM exits on virtqueue notifications."""
+        return int(self.pio_addr) + 0x50
+
     def generateDeviceTree(self, state):
         node = self.generateBasicPioDeviceNode(
             state,
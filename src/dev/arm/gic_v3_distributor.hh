@@ -165,6 +165,14 @@ class Gicv3Distributor : public Serializable
     std::vector <uint8_t> irqNsacr;
     std::vector <IROUTER> irqAffinityRouting;
 
+    /**
+     * Bitmap of the SPIs that are pending, enabled and not active. These
+     * are the only SPIs update() has to look at, so it doesn't need to
+     * scan all the INTIDs on every state change. It is kept in sync with
+     * irqPending, irqEnabled and irqActive by updateCandidate().
+     */
+    std::vector <uint64_t> irqCandidates;
+
     uint32_t gicdTyper;
     uint32_t gicdPidr0;
     uint32_t gicdPidr1;
@@ -184,6 +192,9 @@ class Gicv3Distributor : public Serializable
     void fullUpdate();
     Gicv3::GroupId getIntGroup(int int_id) const;
 
+    /** Refresh the irqCandidates bit of an interrupt */
+    void updateCandidate(uint32_t int_id);
+
     inline bool
     groupEnabled(Gicv3::GroupId group) const
     {
@@ -96,7 +96,7 @@ ItsProcess::doRead(Yield &yield, Addr addr, void *ptr, size_t size)
     ItsAction a;
     a.type = ItsActionType::SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, 0, its.requestorId);
 
     req->taskId(context_switch_task_id::DMA);
@@ -120,7 +120,7 @@ ItsProcess::doWrite(Yield &yield, Addr addr, void *ptr, size_t size)
     ItsAction a;
     a.type = ItsActionType::SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, 0, its.requestorId);
 
     req->taskId(context_switch_task_id::DMA);
@@ -1292,6 +1292,9 @@ Gicv3Its::moveAllPendingState(
         rd1->lpiPendingTablePtr,
         0, sizeof(lpi_pending_table));
 
+    rd1->invalidateLPIPendingCache();
+    rd2->invalidateLPIPendingCache();
+
     rd2->updateDistributor();
 }
 
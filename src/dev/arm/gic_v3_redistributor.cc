@@ -40,7 +40,10 @@
 
 #include "dev/arm/gic_v3_redistributor.hh"
 
+#include <vector>
+
 #include "arch/arm/utility.hh"
+#include "base/bitfield.hh"
 #include "base/compiler.hh"
 #include "debug/GIC.hh"
 #include "dev/arm/gic_v3_cpu_interface.hh"
@@ -70,6 +73,7 @@ Gicv3Redistributor::Gicv3Redistributor(Gicv3 * gic, uint32_t cpu_id)
       irqConfig(Gicv3::SGI_MAX + Gicv3::PPI_MAX, Gicv3::INT_EDGE_TRIGGERED),
       irqGrpmod(Gicv3::SGI_MAX + Gicv3::PPI_MAX, 0),
       irqNsacr(Gicv3::SGI_MAX + Gicv3::PPI_MAX, 0),
+      irqCandidates(0),
       DPG1S(false),
       DPG1NS(false),
       DPG0(false),
@@ -77,6 +81,7 @@ Gicv3Redistributor::Gicv3Redistributor(Gicv3 * gic, uint32_t cpu_id)
       lpiConfigurationTablePtr(0),
       lpiIDBits(0),
       lpiPendingTablePtr(0),
+      lpiPendingCacheValid(false),
       addrRangeSize(gic->params().gicv4 ? 0x40000 : 0x20000)
 {
 }
@@ -413,7 +418,11 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
     switch (addr) {
       case GICR_CTLR: {
           // GICR_TYPER.LPIS is 0 so EnableLPIs is RES0
+          const bool lpis_enabled = EnableLPIs;
           EnableLPIs = data & GICR_CTLR_ENABLE_LPIS;
+          // The pending table is (re)loaded when LPIs get enabled
+          if (EnableLPIs && !lpis_enabled)
+              invalidateLPIPendingCache();
           DPG1S = data & GICR_CTLR_DPG1S;
           DPG1NS = data & GICR_CTLR_DPG1NS;
           DPG0 = data & GICR_CTLR_DPG0;
@@ -468,6 +477,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
 
             if (enable) {
                 irqEnabled[int_id] = true;
+                updateCandidate(int_id);
             }
 
             DPRINTF(GIC, "Gicv3Redistributor::write(): "
@@ -489,6 +499,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
 
             if (disable) {
                 irqEnabled[int_id] = false;
+                updateCandidate(int_id);
             }
 
             DPRINTF(GIC, "Gicv3Redistributor::write(): "
@@ -513,6 +524,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
                         "(GICR_ISPENDR0): int_id %d (PPI) "
                         "pending bit set\n", int_id);
                 irqPending[int_id] = true;
+                updateCandidate(int_id);
                 irqPendingIspendr[int_id] = true;
             }
         }
@@ -533,6 +545,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
 
             if (clear && treatAsEdgeTriggered(int_id)) {
                 irqPending[int_id] = false;
+                updateCandidate(int_id);
             }
         }
 
@@ -556,6 +569,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqActive[int_id] = true;
+                updateCandidate(int_id);
             }
         }
 
@@ -579,6 +593,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
                 }
 
                 irqActive[int_id] = false;
+                updateCandidate(int_id);
             }
         }
 
@@ -674,6 +689,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
               lpiIDBits = 0xf;
           }
 
+          invalidateLPIPendingCache();
           break;
       }
 
@@ -691,6 +707,7 @@ Gicv3Redistributor::write(Addr addr, uint64_t data, size_t size,
         // InnerCache, bits [9:7]
         //   000 Device-nGnRnE
         lpiPendingTablePtr = data & 0xFFFFFFFFF0000;
+        invalidateLPIPendingCache();
         break;
 
       case GICR_INVLPIR: { // Redistributor Invalidate LPI Register
@@ -715,6 +732,7 @@ Gicv3Redistributor::sendPPInt(uint32_t int_id)
     assert((int_id >= Gicv3::SGI_MAX) &&
            (int_id < Gicv3::SGI_MAX + Gicv3::PPI_MAX));
     irqPending[int_id] = true;
+    updateCandidate(int_id);
     irqPendingIspendr[int_id] = false;
     DPRINTF(GIC, "Gicv3Redistributor::sendPPInt(): "
             "int_id %d (PPI) pending bit set\n", int_id);
@@ -729,6 +747,7 @@ Gicv3Redistributor::clearPPInt(uint32_t int_id)
 
     if (isLevelSensitive(int_id)) {
         irqPending[int_id] = false;
+        updateCandidate(int_id);
     }
 }
 
@@ -764,6 +783,7 @@ Gicv3Redistributor::sendSGI(uint32_t int_id, Gicv3::GroupId group, bool ns)
     if (!forward) return;
 
     irqPending[int_id] = true;
+    updateCandidate(int_id);
     irqPendingIspendr[int_id] = false;
     DPRINTF(GIC, "Gicv3ReDistributor::sendSGI(): "
             "int_id %d (SGI) pending bit set\n", int_id);
@@ -804,63 +824,51 @@ Gicv3Redistributor::update()
     if (gic->blockIntUpdate())
         return;
 
-    for (int int_id = 0; int_id < Gicv3::SGI_MAX + Gicv3::PPI_MAX; int_id++) {
+    // Only the SGIs and PPIs that are pending, enabled and not active
+    // need to be considered
+    for (uint32_t bits = irqCandidates; bits; bits &= bits - 1) {
+        const int int_id = ctz32(bits);
         Gicv3::GroupId int_group = getIntGroup(int_id);
-        bool group_enabled = distributor->groupEnabled(int_group);
-
-        if (irqPending[int_id] && irqEnabled[int_id] &&
-                !irqActive[int_id] && group_enabled) {
-            if ((irqPriority[int_id] < cpuInterface->hppi.prio) ||
-                /*
-                 * Multiple pending ints with same priority.
-                 * Implementation choice which one to signal.
-                 * Our implementation selects the one with the lower id.
-                 */
-                (irqPriority[int_id] == cpuInterface->hppi.prio &&
-                 int_id < cpuInterface->hppi.intid)) {
-                cpuInterface->hppi.intid = int_id;
-                cpuInterface->hppi.prio = irqPriority[int_id];
-                cpuInterface->hppi.group = int_group;
-            }
+
+        if (!distributor->groupEnabled(int_group))
+            continue;
+
+        if ((irqPriority[int_id] < cpuInterface->hppi.prio) ||
+            /*
+             * Multiple pending ints with same priority.
+             * Implementation choice which one to signal.
+             * Our implementation selects the one with the lower id.
+             */
+            (irqPriority[int_id] == cpuInterface->hppi.prio &&
+             int_id < cpuInterface->hppi.intid)) {
+            cpuInterface->hppi.intid = int_id;
+            cpuInterface->hppi.prio = irqPriority[int_id];
+            cpuInterface->hppi.group = int_group;
         }
     }
 
-    // Check LPIs
-    if (EnableLPIs) {
-
-        const uint32_t largest_lpi_id = 1 << (lpiIDBits + 1);
-        const uint32_t number_lpis = largest_lpi_id - SMALLEST_LPI_ID + 1;
-
-        uint8_t lpi_pending_table[largest_lpi_id / 8];
-        uint8_t lpi_config_table[number_lpis];
-
-        memProxy->readBlob(lpiPendingTablePtr,
-                           lpi_pending_table,
-                           sizeof(lpi_pending_table));
+    // Check LPIs. LPIs are always Non-secure Group 1 interrupts,
+    // in a system where two Security states are enabled.
+    const Gicv3::GroupId lpi_group = Gicv3::G1NS;
 
-        memProxy->readBlob(lpiConfigurationTablePtr,
-                           lpi_config_table,
-                           sizeof(lpi_config_table));
+    if (EnableLPIs && distributor->groupEnabled(lpi_group)) {
+        fillLPIPendingCache();
 
-        for (int lpi_id = SMALLEST_LPI_ID; lpi_id < largest_lpi_id;
-             lpi_id++) {
-            uint32_t lpi_pending_entry_byte = lpi_id / 8;
-            uint8_t lpi_pending_entry_bit_position = lpi_id % 8;
-            bool lpi_is_pending = lpi_pending_table[lpi_pending_entry_byte] &
-                                  1 << lpi_pending_entry_bit_position;
-            uint32_t lpi_configuration_entry_index = lpi_id - SMALLEST_LPI_ID;
+        const uint32_t largest_lpi_id = 1 << (lpiIDBits + 1);
 
-            LPIConfigurationTableEntry config_entry =
-                lpi_config_table[lpi_configuration_entry_index];
+        // Only the configuration of the pending LPIs is needed
+        for (uint32_t lpi_id : lpiPendingCache) {
+            if (lpi_id >= largest_lpi_id)
+                break;
 
-            bool lpi_is_enable = config_entry.enable;
+            uint8_t lpi_config;
+            memProxy->readBlob(
+                lpiConfigurationTablePtr + lpi_id - SMALLEST_LPI_ID,
+                &lpi_config, sizeof(lpi_config));
 
-            // LPIs are always Non-secure Group 1 interrupts,
-            // in a system where two Security states are enabled.
-            Gicv3::GroupId lpi_group = Gicv3::G1NS;
-            bool group_enabled = distributor->groupEnabled(lpi_group);
+            LPIConfigurationTableEntry config_entry = lpi_config;
 
-            if (lpi_is_pending && lpi_is_enable && group_enabled) {
+            if (config_entry.enable) {
                 uint8_t lpi_priority = config_entry.priority << 2;
 
                 if ((lpi_priority < cpuInterface->hppi.prio) ||
@@ -907,9 +915,37 @@ Gicv3Redistributor::writeEntryLPI(uint32_t lpi_id, uint8_t lpi_pending_entry)
                         sizeof(lpi_pending_entry));
 }
 
+void
+Gicv3Redistributor::fillLPIPendingCache()
+{
+    if (lpiPendingCacheValid)
+        return;
+
+    const uint32_t largest_lpi_id = 1 << (lpiIDBits + 1);
+    std::vector<uint8_t> lpi_pending_table(largest_lpi_id / 8);
+
+    memProxy->readBlob(lpiPendingTablePtr,
+                       lpi_pending_table.data(),
+                       lpi_pending_table.size());
+
+    lpiPendingCache.clear();
+    for (uint32_t byte = SMALLEST_LPI_ID / 8;
+         byte < lpi_pending_table.size(); byte++) {
+        for (uint8_t bits = lpi_pending_table[byte]; bits; bits &= bits - 1)
+            lpiPendingCache.insert(byte * 8 + ctz32(bits));
+    }
+
+    lpiPendingCacheValid = true;
+}
+
 bool
 Gicv3Redistributor::isPendingLPI(uint32_t lpi_id)
 {
+    if (EnableLPIs) {
+        fillLPIPendingCache();
+        return lpiPendingCache.count(lpi_id);
+    }
+
     // Fetch the LPI pending entry from memory
     uint8_t lpi_pending_entry = readEntryLPI(lpi_id);
 
@@ -931,17 +967,14 @@ Gicv3Redistributor::setClrLPI(uint64_t data, bool set)
     uint32_t lpi_id = data & 0xffffffff;
     uint32_t largest_lpi_id = 1 << (lpiIDBits + 1);
 
-    if (lpi_id > largest_lpi_id) {
+    if (lpi_id < SMALLEST_LPI_ID || lpi_id > largest_lpi_id) {
         // Writes to GICR_SETLPIR or GICR_CLRLPIR have not effect if
         // pINTID value specifies an unimplemented LPI.
         return;
     }
 
-    // Fetch the LPI pending entry from memory
-    uint8_t lpi_pending_entry = readEntryLPI(lpi_id);
-
-    uint8_t lpi_pending_entry_bit_position = lpi_id % 8;
-    bool is_set = lpi_pending_entry & (1 << lpi_pending_entry_bit_position);
+    fillLPIPendingCache();
+    bool is_set = lpiPendingCache.count(lpi_id);
 
     if (set) {
         if (is_set) {
@@ -950,7 +983,7 @@ Gicv3Redistributor::setClrLPI(uint64_t data, bool set)
             return;
         }
 
-        lpi_pending_entry |= 1 << (lpi_pending_entry_bit_position);
+        lpiPendingCache.insert(lpi_id);
     } else {
         if (!is_set) {
             // Writes to GICR_SETLPIR have not effect if the pINTID field
@@ -958,17 +991,39 @@ Gicv3Redistributor::setClrLPI(uint64_t data, bool set)
             return;
         }
 
-        lpi_pending_entry &= ~(1 << (lpi_pending_entry_bit_position));
+        lpiPendingCache.erase(lpi_id);
 
         // Remove the pending state from the cpu interface
         cpuInterface->resetHppi(lpi_id);
     }
 
+    // Keep the pending table in memory up to date
+    uint8_t lpi_pending_entry = readEntryLPI(lpi_id);
+    uint8_t lpi_pending_entry_bit_position = lpi_id % 8;
+
+    if (set) {
+        lpi_pending_entry |= 1 << (lpi_pending_entry_bit_position);
+    } else {
+        lpi_pending_entry &= ~(1 << (lpi_pending_entry_bit_position));
+    }
+
     writeEntryLPI(lpi_id, lpi_pending_entry);
 
     updateDistributor();
 }
 
+void
+Gicv3Redistributor::updateCandidate(uint32_t int_id)
+{
+    const uint32_t mask = 1U << int_id;
+
+    if (irqPending[int_id] && irqEnabled[int_id] && !irqActive[int_id]) {
+        irqCandidates |= mask;
+    } else {
+        irqCandidates &= ~mask;
+    }
+}
+
 Gicv3::GroupId
 Gicv3Redistributor::getIntGroup(int int_id) const
 {
@@ -1002,12 +1057,14 @@ Gicv3Redistributor::activateIRQ(uint32_t int_id)
         irqPending[int_id] = false;
     }
     irqActive[int_id] = true;
+    updateCandidate(int_id);
 }
 
 void
 Gicv3Redistributor::deactivateIRQ(uint32_t int_id)
 {
     irqActive[int_id] = false;
+    updateCandidate(int_id);
 }
 
 uint32_t
@@ -1113,6 +1170,12 @@ Gicv3Redistributor::unserialize(CheckpointIn & cp)
     UNSERIALIZE_SCALAR(lpiConfigurationTablePtr);
     UNSERIALIZE_SCALAR(lpiIDBits);
     UNSERIALIZE_SCALAR(lpiPendingTablePtr);
+
+    for (uint32_t int_id = 0; int_id < Gicv3::SGI_MAX + Gicv3::PPI_MAX;
+         int_id++) {
+        updateCandidate(int_id);
+    }
+    invalidateLPIPendingCache();
 }
 
 } // namespace gem5
@@ -41,6 +41,8 @@
 #ifndef __DEV_ARM_GICV3_REDISTRIBUTOR_H__
 #define __DEV_ARM_GICV3_REDISTRIBUTOR_H__
 
+#include <set>
+
 #include "base/addr_range.hh"
 #include "dev/arm/gic_v3.hh"
 #include "sim/serialize.hh"
@@ -166,6 +168,13 @@ class Gicv3Redistributor : public Serializable
     std::vector <uint8_t> irqGrpmod;
     std::vector <uint8_t> irqNsacr;
 
+    /**
+     * Bitmap of the SGIs and PPIs that are pending, enabled and not
+     * active, kept in sync by updateCandidate(). See
+     * Gicv3Distributor::irqCandidates.
+     */
+    uint32_t irqCandidates;
+
     bool DPG1S;
     bool DPG1NS;
     bool DPG0;
@@ -175,6 +184,24 @@ class Gicv3Redistributor : public Serializable
     uint8_t lpiIDBits;
     Addr lpiPendingTablePtr;
 
+    /**
+     * Cached copy of the LPI pending table, i.e. the LPIs of this
+     * redistributor which are pending. Once LPIs are enabled only the
+     * GIC writes the pending table, so there is no need to read and scan
+     * the whole table from memory whenever the highest priority pending
+     * interrupt is recomputed. The table in memory is still kept up to
+     * date. The cache is loaded lazily when LPIs get enabled, when the
+     * tables are moved and after restoring a checkpoint.
+     */
+    std::set<uint32_t> lpiPendingCache;
+    bool lpiPendingCacheValid;
+
+    /** Load the LPI pending table into lpiPendingCache if needed */
+    void fillLPIPendingCache();
+
+    /** Drop lpiPendingCache after the pending table changed in memory */
+    void invalidateLPIPendingCache() { lpiPendingCacheValid = false; }
+
     BitUnion8(LPIConfigurationTableEntry)
         Bitfield<7, 2> priority;
         Bitfield<1> res1;
@@ -230,6 +257,9 @@ class Gicv3Redistributor : public Serializable
 
   protected:
 
+    /** Refresh the irqCandidates bit of an interrupt */
+    void updateCandidate(uint32_t int_id);
+
     bool isLevelSensitive(uint32_t int_id) const
     {
         return irqConfig[int_id] == Gicv3::INT_LEVEL_SENSITIVE;
@@ -518,11 +518,7 @@ HDLcd::lineNext(std::vector<Pixel>::iterator pixel_it, size_t line_length)
 
     bypassLineAddress += fb_line_pitch;
 
-    uint8_t *bufPtr = lineBuffer.data();
-    for (size_t i = 0; i < line_length; i++) {
-        *pixel_it++ = conv.toPixel(bufPtr);
-        bufPtr += conv.length;
-    }
+    conv.toPixels(lineBuffer.data(), &*pixel_it, line_length);
 
     return line_length;
 }
@@ -491,6 +491,7 @@ Pl111::dmaDone()
         fb.copyIn(dmaBuffer, converter);
         if (vnc)
             vnc->setDirty();
+        fb.clearDirty();
 
         if (enableCapture) {
             DPRINTF(PL111, "-- write out frame buffer into bmp\n");
@@ -720,6 +721,7 @@ Pl111::unserialize(CheckpointIn &cp)
         fb.copyIn(dmaBuffer, converter);
         if (vnc)
             vnc->setDirty();
+        fb.clearDirty();
     }
 }
 
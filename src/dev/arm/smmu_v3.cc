@@ -139,6 +139,12 @@ SMMUv3::recvTimingResp(PacketPtr pkt)
     // @todo: We need to pay for this and not just zero it out
     pkt->headerDelay = pkt->payloadDelay = 0;
 
+    if (auto *state = dynamic_cast<SMMUv3DeviceInterface::FastPathState *>(
+            pkt->senderState)) {
+        state->ifc.recvFastPathResp(pkt);
+        return true;
+    }
+
     SMMUProcess *proc =
         safe_cast<SMMUProcess *>(pkt->popSenderState());
 
@@ -738,6 +744,12 @@ SMMUv3::SMMUv3Stats::SMMUv3Stats(statistics::Group *parent)
     ADD_STAT(steFetches, statistics::units::Count::get(), "STE fetches"),
     ADD_STAT(cdL1Fetches, statistics::units::Count::get(), "CD L1 fetches"),
     ADD_STAT(cdFetches, statistics::units::Count::get(), "CD fetches"),
+    ADD_STAT(fastPathTranslations, statistics::units::Count::get(),
+        "Device translations done without a translation process"),
+    ADD_STAT(slowPathTranslations, statistics::units::Count::get(),
+        "Device translations done by a translation process"),
+    ADD_STAT(cmdqReads, statistics::units::Count::get(),
+        "Command queue reads"),
     ADD_STAT(translationTimeDist, statistics::units::Tick::get(),
         "Time to translate address"),
     ADD_STAT(ptwTimeDist, statistics::units::Tick::get(),
@@ -757,6 +769,15 @@ SMMUv3::SMMUv3Stats::SMMUv3Stats(statistics::Group *parent)
     cdFetches
         .flags(pdf);
 
+    fastPathTranslations
+        .flags(pdf);
+
+    slowPathTranslations
+        .flags(pdf);
+
+    cmdqReads
+        .flags(pdf);
+
     translationTimeDist
         .init(0, 2000000, 2000)
         .flags(pdf);
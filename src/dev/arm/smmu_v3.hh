@@ -147,6 +147,9 @@ class SMMUv3 : public ClockedObject
         statistics::Scalar steFetches;
         statistics::Scalar cdL1Fetches;
         statistics::Scalar cdFetches;
+        statistics::Scalar fastPathTranslations;
+        statistics::Scalar slowPathTranslations;
+        statistics::Scalar cmdqReads;
         statistics::Distribution translationTimeDist;
         statistics::Distribution ptwTimeDist;
     } stats;
@@ -37,8 +37,11 @@
 
 #include "dev/arm/smmu_v3_cmdexec.hh"
 
+#include <algorithm>
+
 #include "base/bitfield.hh"
 #include "dev/arm/smmu_v3.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -53,6 +56,11 @@ SMMUCommandExecProcess::main(Yield &yield)
     a.delay = 0;
     yield(a);
 
+    // Commands are read a cache line at a time, so as many of them as
+    // fit share a single memory access.
+    const Addr line_size = smmu.system.cacheLineSize();
+    cmds.resize(std::max<Addr>(line_size / sizeof(SMMUCommand), 1));
+
     while (true) {
         busy = true;
 
@@ -67,19 +75,35 @@ SMMUCommandExecProcess::main(Yield &yield)
             int size_mask_wrap = mask(
                 (smmu.regs.cmdq_base & Q_BASE_SIZE_MASK) + 1);
 
-            if ((smmu.regs.cmdq_cons & size_mask_wrap) ==
-                    (smmu.regs.cmdq_prod & size_mask_wrap))
+            const uint32_t cons = smmu.regs.cmdq_cons & size_mask_wrap;
+            const uint32_t prod = smmu.regs.cmdq_prod & size_mask_wrap;
+            if (cons == prod)
                 break; // command queue empty
 
+            const uint32_t idx = cons & size_mask;
             Addr cmd_addr =
                 (smmu.regs.cmdq_base & Q_BASE_ADDR_MASK) +
-                (smmu.regs.cmdq_cons & size_mask) * sizeof(SMMUCommand);
+                idx * sizeof(SMMUCommand);
+
+            // Take the pending commands up to the end of the queue and
+            // of the cache line
+            size_t num_cmds = (prod - cons) & size_mask_wrap;
+            num_cmds = std::min<size_t>(num_cmds, size_mask + 1 - idx);
+            num_cmds = std::min<size_t>(num_cmds,
+                (line_size - (cmd_addr & (line_size - 1))) /
+                    sizeof(SMMUCommand));
+            num_cmds = std::max<size_t>(num_cmds, 1);
 
             // This deliberately resets the error field in cmdq_cons!
-            smmu.regs.cmdq_cons = (smmu.regs.cmdq_cons + 1) & size_mask_wrap;
+            smmu.regs.cmdq_cons =
+                (smmu.regs.cmdq_cons + num_cmds) & size_mask_wrap;
+
+            doRead(yield, cmd_addr, cmds.data(),
+                   num_cmds * sizeof(SMMUCommand));
+            smmu.stats.cmdqReads++;
 
-            doRead(yield, cmd_addr, &cmd, sizeof(SMMUCommand));
-            smmu.processCommand(cmd);
+            for (size_t i = 0; i < num_cmds; i++)
+                smmu.processCommand(cmds[i]);
         }
 
         busy = false;
@@ -38,6 +38,8 @@
 #ifndef __DEV_ARM_SMMU_V3_CMDEXEC_HH__
 #define __DEV_ARM_SMMU_V3_CMDEXEC_HH__
 
+#include <vector>
+
 #include "dev/arm/smmu_v3_defs.hh"
 #include "dev/arm/smmu_v3_proc.hh"
 
@@ -49,7 +51,8 @@ class SMMUv3;
 class SMMUCommandExecProcess : public SMMUProcess
 {
   private:
-    SMMUCommand cmd;
+    /** Commands read from the command queue in one go. */
+    std::vector<SMMUCommand> cmds;
 
     bool busy;
 
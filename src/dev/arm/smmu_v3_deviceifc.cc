@@ -37,6 +37,9 @@
 
 #include "dev/arm/smmu_v3_deviceifc.hh"
 
+#include <algorithm>
+
+#include "base/cast.hh"
 #include "base/trace.hh"
 #include "debug/SMMUv3.hh"
 #include "dev/arm/smmu_v3.hh"
@@ -75,6 +78,8 @@ SMMUv3DeviceInterface::SMMUv3DeviceInterface(
     prefetchEnable(p.prefetch_enable),
     prefetchReserveLastWay(
         p.prefetch_reserve_last_way),
+    timingFastPath(p.timing_fast_path),
+    fastPathEvent(*this),
     deviceNeedsRetry(false),
     atsDeviceNeedsRetry(false),
     sendDeviceRetryEvent(*this),
@@ -130,6 +135,21 @@ SMMUv3DeviceInterface::recvAtomic(PacketPtr pkt)
     DPRINTF(SMMUv3, "[a] req from %s addr=%#x size=%#x\n",
             devicePort->getPeer(), pkt->getAddr(), pkt->getSize());
 
+    Cycles lat;
+    const Addr addr = pkt->getAddr();
+    if (fastPathTranslate(pkt, lat)) {
+        const unsigned beats = pkt->isWrite() ?
+            (pkt->getSize() + (portWidth-1)) / portWidth : 1;
+        Tick delay = smmu->cyclesToTicks(Cycles(beats) + lat);
+        smmu->stats.translationTimeDist.sample(0);
+
+        delay += smmu->requestPort.sendAtomic(pkt);
+        pkt->setAddr(addr);
+        return delay;
+    }
+
+    smmu->stats.slowPathTranslations++;
+
     std::string proc_name = csprintf("%s.port", name());
     SMMUTranslationProcess proc(proc_name, *smmu, *this);
     proc.beginTransaction(SMMUTranslRequest::fromPacket(pkt));
@@ -159,9 +179,48 @@ SMMUv3DeviceInterface::recvTimingReq(PacketPtr pkt)
         return false;
     }
 
+    // The fast path only runs while no translation process is in
+    // flight, so that it cannot reorder transactions with the same ID.
+    Cycles lat;
+    const Addr addr = pkt->getAddr();
+    if (timingFastPath &&
+        xlateSlotsRemaining + fastPathQueue.size() == params().xlate_slots &&
+        fastPathTranslate(pkt, lat)) {
+        xlateSlotsRemaining--;
+        pendingMemAccesses++;
+        if (pkt->isWrite())
+            wrBufSlotsRemaining -= nbeats;
+
+        pkt->pushSenderState(new FastPathState(*this, addr));
+
+        const unsigned responder_beats = pkt->isWrite() ? nbeats : 1;
+        FastPathReq req;
+        req.pkt = pkt;
+        req.recvTick = smmu->clockEdge(Cycles(responder_beats));
+        req.sendTick = smmu->clockEdge(Cycles(responder_beats) + lat);
+        // Later requests never overtake earlier ones
+        if (!fastPathQueue.empty())
+            req.sendTick = std::max(req.sendTick,
+                                    fastPathQueue.back().sendTick);
+        fastPathQueue.push_back(req);
+
+        if (!fastPathEvent.scheduled())
+            schedule(fastPathEvent, fastPathQueue.front().sendTick);
+        return true;
+    }
+
+    // Likewise, a translation process started now could overtake the
+    // fast path translations still in flight.
+    if (!fastPathQueue.empty()) {
+        deviceNeedsRetry = true;
+        return false;
+    }
+
     if (pkt->isWrite())
         wrBufSlotsRemaining -= nbeats;
 
+    smmu->stats.slowPathTranslations++;
+
     std::string proc_name = csprintf("%s.port", name());
     SMMUTranslationProcess *proc =
         new SMMUTranslationProcess(proc_name, *smmu, *this);
@@ -172,6 +231,119 @@ SMMUv3DeviceInterface::recvTimingReq(PacketPtr pkt)
     return true;
 }
 
+bool
+SMMUv3DeviceInterface::fastPathTranslate(PacketPtr pkt, Cycles &lat)
+{
+    if (!(smmu->regs.cr0 & CR0_SMMUEN_MASK))
+        return false;
+
+    // Leave transactions crossing a 4k boundary to the process, which
+    // reports them.
+    const Addr addr = pkt->getAddr();
+    if ((addr & 0xfffULL) + pkt->getSize() > 0x1000ULL)
+        return false;
+
+    const uint32_t sid = pkt->req->streamId();
+    const uint32_t ssid = pkt->req->hasSubstreamId() ?
+        pkt->req->substreamId() : 0;
+
+    // Probe without touching the replacement state or the stats, as
+    // on a miss the process does the lookups again.
+    const SMMUTLB::Entry *e = microTLBEnable ?
+        microTLB->lookup(sid, ssid, addr, false) : nullptr;
+    const bool micro_hit = e;
+    if (!micro_hit) {
+        e = mainTLBEnable ? mainTLB->lookup(sid, ssid, addr, false) :
+            nullptr;
+        // A hit on a prefetched entry issues the next prefetch, which
+        // needs a process.
+        if (!e || e->prefetched)
+            return false;
+    }
+
+    lat = Cycles(0);
+    if (microTLBEnable) {
+        microTLB->lookup(sid, ssid, addr);
+        lat += microTLBLat;
+    }
+    if (!micro_hit) {
+        mainTLB->lookup(sid, ssid, addr);
+        lat += mainTLBLat;
+
+        if (microTLBEnable) {
+            SMMUTLB::Entry ue = *e;
+            ue.prefetched = false;
+            microTLB->store(ue, SMMUTLB::ALLOC_ANY_WAY);
+        }
+    }
+
+    const Addr paddr = e->pa + (addr & ~e->vaMask);
+    DPRINTF(SMMUv3, "Fast path %s TLB hit vaddr=%#x sid=%#x ssid=%#x "
+            "paddr=%#x\n", micro_hit ? "micro" : "main", addr, sid, ssid,
+            paddr);
+
+    lat += Cycles(pkt->isWrite() ?
+        (pkt->getSize() + (smmu->requestPortWidth-1)) /
+            smmu->requestPortWidth :
+        1);
+
+    pkt->setAddr(paddr);
+    pkt->req->setPaddr(paddr);
+
+    smmu->stats.fastPathTranslations++;
+    return true;
+}
+
+void
+SMMUv3DeviceInterface::sendFastPathReqs()
+{
+    while (!fastPathQueue.empty() &&
+           fastPathQueue.front().sendTick <= curTick()) {
+        const FastPathReq &req = fastPathQueue.front();
+        PacketPtr pkt = req.pkt;
+
+        smmu->stats.translationTimeDist.sample(curTick() - req.recvTick);
+        xlateSlotsRemaining++;
+        if (pkt->isWrite())
+            wrBufSlotsRemaining +=
+                (pkt->getSize() + (portWidth-1)) / portWidth;
+        fastPathQueue.pop_front();
+
+        DPRINTF(SMMUv3, "[t] requestor req  addr=%#x size=%#x\n",
+                pkt->getAddr(), pkt->getSize());
+
+        if (!smmu->packetsToRetry.empty() ||
+            !smmu->requestPort.sendTimingReq(pkt)) {
+            SMMUAction a;
+            a.type = ACTION_SEND_REQ_FINAL;
+            a.pkt = pkt;
+            a.ifc = this;
+            a.delay = 0;
+            smmu->packetsToRetry.push(a);
+        }
+    }
+
+    // Requests refused while the queue was busy can now come in.
+    smmu->scheduleDeviceRetries();
+
+    if (!fastPathQueue.empty())
+        schedule(fastPathEvent, fastPathQueue.front().sendTick);
+}
+
+void
+SMMUv3DeviceInterface::recvFastPathResp(PacketPtr pkt)
+{
+    auto *state = safe_cast<FastPathState *>(pkt->popSenderState());
+    pkt->setAddr(state->addr);
+    delete state;
+
+    schedTimingResp(pkt);
+
+    assert(pendingMemAccesses > 0);
+    if (--pendingMemAccesses == 0)
+        signalDrainDone();
+}
+
 Tick
 SMMUv3DeviceInterface::atsRecvAtomic(PacketPtr pkt)
 {
@@ -38,6 +38,7 @@
 #ifndef __DEV_ARM_SMMU_V3_DEVICEIFC_HH__
 #define __DEV_ARM_SMMU_V3_DEVICEIFC_HH__
 
+#include <deque>
 #include <list>
 
 #include "dev/arm/smmu_v3_caches.hh"
@@ -89,6 +90,50 @@ class SMMUv3DeviceInterface : public ClockedObject
     const bool prefetchEnable;
     const bool prefetchReserveLastWay;
 
+    const bool timingFastPath;
+
+    /**
+     * Sender state of a packet translated by the fast path, holding
+     * the untranslated address to hand back to the device.
+     */
+    struct FastPathState : public Packet::SenderState
+    {
+        FastPathState(SMMUv3DeviceInterface &_ifc, Addr _addr)
+          : ifc(_ifc), addr(_addr)
+        {}
+        SMMUv3DeviceInterface &ifc;
+        const Addr addr;
+    };
+
+    /** A fast path translation waiting for its modelled latency. */
+    struct FastPathReq
+    {
+        PacketPtr pkt;
+        Tick recvTick;
+        Tick sendTick;
+    };
+
+    /** Fast path translations in flight, in the order they were sent. */
+    std::deque<FastPathReq> fastPathQueue;
+
+    /**
+     * Translate a request that hits in the micro or main TLB without
+     * going through an SMMUTranslationProcess. The lookups and TLB
+     * updates are the ones the process would have done.
+     * @param pkt The request, which is retargeted on a hit.
+     * @param lat Set to the lookup and requestor port cycles.
+     * @return Whether the request was translated.
+     */
+    bool fastPathTranslate(PacketPtr pkt, Cycles &lat);
+
+    /** Send the fast path translations whose latency has elapsed. */
+    void sendFastPathReqs();
+    MemberEventWrapper<&SMMUv3DeviceInterface::sendFastPathReqs>
+        fastPathEvent;
+
+    /** Receive the memory response to a fast path translation. */
+    void recvFastPathResp(PacketPtr pkt);
+
     std::list<SMMUTranslationProcess *> duplicateReqs;
     SMMUSignal duplicateReqRemoved;
 
@@ -94,7 +94,8 @@ SMMUTranslationProcess::SMMUTranslationProcess(const std::string &name,
     ifc.xlateSlotsRemaining--;
 
     ifc.pendingMemAccesses++;
-    reinit();
+    // The coroutine is only created once the request is known, by
+    // beginTransaction()
 }
 
 SMMUTranslationProcess::~SMMUTranslationProcess()
@@ -45,6 +45,7 @@
 #include <cstring>
 #include <utility>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/DMA.hh"
@@ -56,12 +57,22 @@ namespace gem5
 {
 
 DmaPort::DmaPort(ClockedObject *dev, System *s,
-                 uint32_t sid, uint32_t ssid)
+                 uint32_t sid, uint32_t ssid,
+                 Addr burst_size, Addr max_pending_bytes)
     : RequestPort(dev->name() + ".dma"),
       device(dev), sys(s), requestorId(s->getRequestorId(dev)),
       sendEvent([this]{ sendDma(); }, dev->name()),
-      defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize())
-{ }
+      defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize()),
+      burstSize(burst_size ? burst_size : cacheLineSize),
+      maxPendingBytes(max_pending_bytes)
+{
+    fatal_if(!isPowerOf2(burstSize) || burstSize < cacheLineSize,
+             "%s: The DMA burst size must be a power of two no smaller "
+             "than the cache line size.", dev->name());
+    fatal_if(maxPendingBytes && maxPendingBytes < burstSize,
+             "%s: The DMA bytes in flight limit is smaller than a burst.",
+             dev->name());
+}
 
 void
 DmaPort::handleRespPacket(PacketPtr pkt, Tick delay)
@@ -127,7 +138,7 @@ DmaPort::handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay)
 PacketPtr
 DmaPort::DmaReqState::createPacket()
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             gen.addr(), gen.size(), flags, id);
     req->setStreamId(sid);
     req->setSubstreamId(ssid);
@@ -149,13 +160,26 @@ DmaPort::recvTimingResp(PacketPtr pkt)
     assert(pkt->req->isUncacheable() ||
            !(pkt->cacheResponding() && !pkt->hasSharers()));
 
+    assert(pendingBytes >= pkt->req->getSize());
+    pendingBytes -= pkt->req->getSize();
+
     handleRespPacket(pkt);
 
+    // Resume sending if we were waiting for bytes in flight to drain
+    if (bytesStalled) {
+        bytesStalled = false;
+        if (!transmitList.empty() && !retryPending &&
+            !sendEvent.scheduled()) {
+            device->schedule(sendEvent, device->clockEdge());
+        }
+    }
+
     return true;
 }
 
 DmaDevice::DmaDevice(const Params &p)
-    : PioDevice(p), dmaPort(this, sys, p.sid, p.ssid)
+    : PioDevice(p),
+      dmaPort(this, sys, p.sid, p.ssid, p.dma_burst_size, p.dma_max_pending)
 { }
 
 void
@@ -194,10 +218,10 @@ DmaPort::dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
             event ? event->scheduled() : -1);
 
     // One DMA request sender state for every action, that is then
-    // split into many requests and packets based on the block size,
-    // i.e. cache line size.
+    // split into many requests and packets based on the burst size,
+    // i.e. the cache line size unless bursts are enabled.
     transmitList.push_back(
-            new DmaReqState(cmd, addr, cacheLineSize, size,
+            new DmaReqState(cmd, addr, burstSize, size,
                 data, flag, requestorId, sid, ssid, event, delay));
 
     // In zero time, also initiate the sending of the packets for the request
@@ -257,6 +281,16 @@ DmaPort::trySendTimingReq()
     // and schedule the following send if it is successful
     DmaReqState *state = transmitList.front();
 
+    // Wait for a response if the next packet would put too many bytes
+    // in flight. A packet waiting for a retry is always sent first.
+    if (!inRetry && maxPendingBytes && pendingBytes &&
+        pendingBytes + state->gen.size() > maxPendingBytes) {
+        DPRINTF(DMA, "Too many bytes in flight (%d), waiting\n",
+                pendingBytes);
+        bytesStalled = true;
+        return;
+    }
+
     PacketPtr pkt = inRetry ? inRetry : state->createPacket();
     inRetry = nullptr;
 
@@ -266,8 +300,10 @@ DmaPort::trySendTimingReq()
     // Check if this was the last packet now, since hypothetically the packet
     // response may come immediately, and state may be deleted.
     bool last = state->gen.last();
+    const Addr pkt_size = pkt->req->getSize();
     if (sendTimingReq(pkt)) {
         pendingCount++;
+        pendingBytes += pkt_size;
     } else {
         retryPending = true;
         inRetry = pkt;
@@ -173,6 +173,15 @@ class DmaPort : public RequestPort, public Drainable
     /** Number of outstanding packets the dma port has. */
     uint32_t pendingCount = 0;
 
+    /** Number of bytes of the outstanding timing packets. */
+    Addr pendingBytes = 0;
+
+    /**
+     * Whether sending is stalled because too many bytes are in flight.
+     * The next response restarts it.
+     */
+    bool bytesStalled = false;
+
     /** The packet (if any) waiting for a retry to send. */
     PacketPtr inRetry = nullptr;
     /**
@@ -189,6 +198,15 @@ class DmaPort : public RequestPort, public Drainable
 
     const Addr cacheLineSize;
 
+    /**
+     * Maximum size of the packets a DMA is split into. This is the
+     * cache line size unless the device is configured to send bursts.
+     */
+    const Addr burstSize;
+
+    /** Maximum number of bytes in flight in timing mode (0: no limit) */
+    const Addr maxPendingBytes;
+
   protected:
 
     bool recvTimingResp(PacketPtr pkt) override;
@@ -196,7 +214,16 @@ class DmaPort : public RequestPort, public Drainable
 
   public:
 
-    DmaPort(ClockedObject *dev, System *s, uint32_t sid=0, uint32_t ssid=0);
+    /**
+     * @param burst_size Maximum size of the DMA packets, 0 for the cache
+     * line size. Packets larger than a cache line must not go through
+     * caches, and must not be larger than the interleaving granularity
+     * of the memory they target.
+     * @param max_pending_bytes Maximum number of bytes in flight in
+     * timing mode, 0 for no limit.
+     */
+    DmaPort(ClockedObject *dev, System *s, uint32_t sid=0, uint32_t ssid=0,
+            Addr burst_size=0, Addr max_pending_bytes=0);
 
     void
     dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
@@ -50,6 +50,19 @@ class HSAPacketProcessor(DmaVirtDevice):
     # See: https://github.com/RadeonOpenCompute/atmi/tree/master/examples/
     #      runtime/kps
     pktProcessDelay = Param.Tick(4400000, "Packet processing delay")
+    aqlBufferSize = Param.Unsigned(
+        16,
+        "Number of AQL packets buffered per hw queue, which is also the "
+        "largest number of packets fetched by a single DMA read",
+    )
+    dispatchBatchSize = Param.Unsigned(
+        1, "Maximum number of AQL packets dispatched per pktProcessDelay"
+    )
+    doorbellWakeup = Param.Bool(
+        False,
+        "Wake up the hw scheduler when the doorbell of an unmapped queue is "
+        "rung, instead of at the end of the scheduling quantum",
+    )
     walker = Param.VegaPagetableWalker(
         VegaPagetableWalker(), "Page table walker"
     )
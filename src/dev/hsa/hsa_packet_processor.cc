@@ -76,10 +76,15 @@ HSAPP_EVENT_DESCRIPTION_GENERATOR(QueueProcessEvent)
 HSAPacketProcessor::HSAPacketProcessor(const Params &p)
     : DmaVirtDevice(p), walker(p.walker),
       numHWQueues(p.numHWQueues), pioAddr(p.pioAddr),
-      pioSize(PAGE_SIZE), pioDelay(10), pktProcessDelay(p.pktProcessDelay)
+      pioSize(PAGE_SIZE), pioDelay(10), pktProcessDelay(p.pktProcessDelay),
+      aqlBufferSize(p.aqlBufferSize),
+      dispatchBatchSize(p.dispatchBatchSize), stats(this)
 {
     DPRINTF(HSAPacketProcessor, "%s:\n", __FUNCTION__);
-    hwSchdlr = new HWScheduler(this, p.wakeupDelay);
+    fatal_if(!aqlBufferSize, "%s: aqlBufferSize must not be 0", name());
+    fatal_if(!dispatchBatchSize, "%s: dispatchBatchSize must not be 0",
+             name());
+    hwSchdlr = new HWScheduler(this, p.wakeupDelay, p.doorbellWakeup);
     regdQList.resize(numHWQueues);
     for (int i = 0; i < numHWQueues; i++) {
         regdQList[i] = new RQLEntry(this, i);
@@ -424,9 +429,9 @@ HSAPacketProcessor::processPkt(void* pkt, uint32_t rl_idx, Addr host_pkt_addr)
     return is_submitted;
 }
 
-// Wakes up every fixed time interval (pktProcessDelay) and processes a single
-// packet from the queue that scheduled this wakeup. If there are more
-// packets in that queue, the next wakeup is scheduled.
+// Wakes up every fixed time interval (pktProcessDelay) and processes up to
+// dispatchBatchSize packets from the queue that scheduled this wakeup. If
+// there are more packets in that queue, the next wakeup is scheduled.
 void
 HSAPacketProcessor::QueueProcessEvent::process()
 {
@@ -443,20 +448,25 @@ HSAPacketProcessor::QueueProcessEvent::process()
             "Dummy wakeup with barrier bit for rdIdx %d\n", rqIdx);
         return;
     }
-    // In the future, we may support batch processing of packets.
-    // Then, we can just remove the break statements and the code
-    // will support batch processing. That is why we are using a
-    // "while loop" here instead on an "if" condition.
+    uint32_t num_dispatched = 0;
     while (hsaPP->regdQList[rqIdx]->dispPending()) {
         void *pkt = aqlRingBuffer->ptr(aqlRingBuffer->dispIdx());
         DPRINTF(HSAPacketProcessor, "%s: Attempting dispatch @ dispIdx[%d]\n",
                 __FUNCTION__, aqlRingBuffer->dispIdx());
         Addr host_addr = aqlRingBuffer->hostDispAddr();
+        Tick fetch_tick = aqlRingBuffer->fetchTick();
         Q_STATE q_state = hsaPP->processPkt(pkt, rqIdx, host_addr);
         if (q_state == UNBLOCKED) {
+             hsaPP->stats.dispatchedPkts++;
+             hsaPP->stats.dispatchLatency.sample(curTick() - fetch_tick);
              aqlRingBuffer->incDispIdx(1);
              DPRINTF(HSAPacketProcessor, "%s: Increment dispIdx[%d]\n",
                      __FUNCTION__, aqlRingBuffer->dispIdx());
+             // A dispatch can set the barrier bit, which blocks the queue
+             if (++num_dispatched < hsaPP->dispatchBatchSize &&
+                 !hsaPP->regdQList[rqIdx]->getBarrierBit()) {
+                 continue;
+             }
              if (hsaPP->regdQList[rqIdx]->dispPending()) {
                  hsaPP->schedAQLProcessing(rqIdx);
              }
@@ -556,6 +566,8 @@ HSAPacketProcessor::getCommandsFromHost(int pid, uint32_t rl_idx)
 
         aqlRingBuffer->saveHostDispAddr(qDesc->ptr(umq_nxt), num_2_xfer,
                                         dma_start_ix);
+        aqlRingBuffer->saveFetchTick(num_2_xfer, dma_start_ix);
+        stats.pktFetches++;
 
         DPRINTF(HSAPacketProcessor,
                 "%s: aql_buf = %p, umq_nxt = %d, dma_ix = %d, num2xfer = %d\n",
@@ -594,6 +606,7 @@ AQLRingBuffer::AQLRingBuffer(uint32_t size,
     _aqlBuf.resize(size);
     _aqlComplete.resize(size);
     _hostDispAddresses.resize(size);
+    _fetchTicks.resize(size);
     // Mark all packets as invalid and incomplete
     for (auto& it : _aqlBuf)
         it.header = HSA_PACKET_TYPE_INVALID;
@@ -758,4 +771,17 @@ HSAPacketProcessor::sendCompletionSignal(hsa_signal_value_t signal)
     dmaWriteVirt(signal_addr, sizeof(hsa_signal_value_t), nullptr, new_signal, 0);
 }
 
+HSAPacketProcessor::HSAPacketProcessorStats::HSAPacketProcessorStats(
+    statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(dispatchedPkts, statistics::units::Count::get(),
+               "Number of AQL packets dispatched"),
+      ADD_STAT(pktFetches, statistics::units::Count::get(),
+               "Number of DMA reads of AQL packets from the host queues"),
+      ADD_STAT(dispatchLatency, statistics::units::Tick::get(),
+               "Ticks from the fetch of an AQL packet to its dispatch")
+{
+    dispatchLatency.init(16);
+}
+
 } // namespace gem5
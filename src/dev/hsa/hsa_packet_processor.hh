@@ -36,6 +36,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "debug/HSAPacketProcessor.hh"
 #include "dev/dma_virt_device.hh"
@@ -43,6 +44,7 @@
 #include "dev/hsa/hsa_queue.hh"
 #include "enums/GfxVersion.hh"
 #include "params/HSAPacketProcessor.hh"
+#include "sim/cur_tick.hh"
 #include "sim/eventq.hh"
 
 #define AQL_PACKET_SIZE 64
@@ -144,6 +146,7 @@ class AQLRingBuffer
      std::vector<hsa_kernel_dispatch_packet_t> _aqlBuf;
      std::string _name;
      std::vector<Addr> _hostDispAddresses;
+     std::vector<Tick> _fetchTicks;
      std::vector<bool> _aqlComplete;
      uint64_t _wrIdx;   // Points to next write location
      uint64_t _rdIdx;   // Read pointer of AQL buffer
@@ -179,6 +182,23 @@ class AQLRingBuffer
          return _hostDispAddresses[dispIdx() % numObjs()];
      }
 
+     /** Record that num_pkts packets starting at ix are being fetched. */
+     void
+     saveFetchTick(int num_pkts, int ix)
+     {
+         for (int i = 0; i < num_pkts; ++i) {
+            _fetchTicks[ix % numObjs()] = curTick();
+            ++ix;
+         }
+     }
+
+     /** @return When the packet at the dispatch pointer was fetched. */
+     Tick
+     fetchTick() const
+     {
+         return _fetchTicks[dispIdx() % numObjs()];
+     }
+
      bool
      dispPending() const
      {
@@ -334,6 +354,10 @@ class HSAPacketProcessor: public DmaVirtDevice
     Addr pioSize;
     Tick pioDelay;
     const Tick pktProcessDelay;
+    /** Number of AQL packets buffered (and fetched at once) per queue. */
+    const uint32_t aqlBufferSize;
+    /** Maximum number of packets dispatched per processing wakeup. */
+    const uint32_t dispatchBatchSize;
 
     typedef HSAPacketProcessorParams Params;
     HSAPacketProcessor(const Params &p);
@@ -391,6 +415,16 @@ class HSAPacketProcessor: public DmaVirtDevice
             uint32_t ix_start, unsigned num_pkts,
             dma_series_ctx *series_ctx, void *dest_4debug);
     void handleReadDMA();
+
+  protected:
+    struct HSAPacketProcessorStats : public statistics::Group
+    {
+        HSAPacketProcessorStats(statistics::Group *parent);
+
+        statistics::Scalar dispatchedPkts;
+        statistics::Scalar pktFetches;
+        statistics::Histogram dispatchLatency;
+    } stats;
 };
 
 } // namespace gem5
@@ -113,7 +113,7 @@ HWScheduler::registerNewQueue(uint64_t hostReadIndexPointer,
        new HSAQueueDescriptor(basePointer, offset,
                               hostReadIndexPointer, size, gfxVersion);
     AQLRingBuffer* aql_buf =
-        new AQLRingBuffer(NUM_DMA_BUFS, hsaPP->name());
+        new AQLRingBuffer(hsaPP->aqlBufferSize, hsaPP->name());
     if (rd_idx > 0) {
         aql_buf->setRdIdx(rd_idx);
         aql_buf->setWrIdx(rd_idx);
@@ -349,6 +349,13 @@ HWScheduler::write(Addr db_addr, uint64_t doorbell_reg)
     // AQL packet
     if (regdListMap.find(al_idx) != regdListMap.end()) {
         hsaPP->getCommandsFromHost(0, regdListMap[al_idx]);
+    } else if (doorbellWakeup) {
+        // Start the round robin search from this queue, so that it is
+        // the one mapped if a hw queue is idle
+        DPRINTF(HSAPacketProcessor, "Doorbell wakeup for unmapped q %d\n",
+                al_idx);
+        nextALId = al_idx;
+        hsaPP->reschedule(&schedWakeupEvent, curTick(), true);
     }
 }
 
@@ -50,9 +50,11 @@ namespace gem5
 class HWScheduler
 {
   public:
-    HWScheduler(HSAPacketProcessor* hsa_pp, Tick wakeup_delay)
+    HWScheduler(HSAPacketProcessor* hsa_pp, Tick wakeup_delay,
+                bool doorbell_wakeup=false)
                : hsaPP(hsa_pp), nextALId(0), nextRLId(0),
-                 wakeupDelay(wakeup_delay), schedWakeupEvent(this)
+                 wakeupDelay(wakeup_delay), doorbellWakeup(doorbell_wakeup),
+                 schedWakeupEvent(this)
     {}
     void write(Addr db_addr, uint64_t doorbell_reg);
     void registerNewQueue(uint64_t hostReadIndexPointer,
@@ -109,6 +111,9 @@ class HWScheduler
     uint32_t nextALId;
     uint32_t nextRLId;
     const Tick wakeupDelay;
+    // Wake up as soon as the doorbell of an unmapped queue is rung, rather
+    // than at the end of the scheduling quantum
+    const bool doorbellWakeup;
     SchedulerWakeupEvent schedWakeupEvent;
 };
 
@@ -73,6 +73,10 @@ class EtherLink(SimObject):
     dump = Param.EtherDump(NULL, "dump object")
 
 
+class DistTransport(Enum):
+    vals = ["tcp", "shm"]
+
+
 class DistEtherLink(SimObject):
     type = "DistEtherLink"
     cxx_header = "dev/net/dist_etherlink.hh"
@@ -88,9 +92,24 @@ class DistEtherLink(SimObject):
     sync_start = Param.Latency("5200000000000t", "first dist sync barrier")
     sync_repeat = Param.Latency("10us", "dist sync barrier repeat")
     server_name = Param.String("localhost", "Message server name")
-    server_port = Param.UInt32("2200", "Message server port")
+    server_port = Param.UInt32(
+        "2200",
+        "Message server port (with the shm transport, the key that "
+        "identifies the dist run on the host)",
+    )
+    transport = Param.DistTransport(
+        "tcp",
+        "Transport between the gem5 processes: tcp sockets or, if all the "
+        "processes run on the same host, shared memory rings",
+    )
     is_switch = Param.Bool(False, "true if this a link in etherswitch")
     dist_sync_on_pseudo_op = Param.Bool(False, "Start sync with pseudo_op")
+    sync_adaptive = Param.Bool(
+        False,
+        "Widen the dist sync interval (up to the shortest link delay) "
+        "while no packets cross the links and fall back to sync_repeat "
+        "on activity (only used by the switch)",
+    )
     num_nodes = Param.UInt32("2", "Number of simulate nodes")
 
 
@@ -216,6 +216,10 @@ class DistEtherLink : public SimObject
     LocalIface *localIface;
 
     Tick linkDelay;
+    /**
+     * Adapt the dist sync interval to the link activity
+     */
+    bool syncAdaptive;
 
   public:
     using Params = DistEtherLinkParams;
@@ -41,6 +41,7 @@
 
 #include "dev/net/dist_iface.hh"
 
+#include <algorithm>
 #include <queue>
 #include <thread>
 
@@ -48,6 +49,7 @@
 #include "base/trace.hh"
 #include "cpu/thread_context.hh"
 #include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
 #include "debug/DistEthernetPkt.hh"
 #include "dev/net/etherpkt.hh"
 #include "sim/cur_tick.hh"
@@ -67,7 +69,8 @@ DistIface *DistIface::primary = nullptr;
 bool DistIface::isSwitch = false;
 
 void
-DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
+DistIface::Sync::init(Tick start_tick, Tick repeat_tick, Tick link_delay,
+                      bool adaptive_sync)
 {
     if (start_tick < nextAt) {
         nextAt = start_tick;
@@ -82,6 +85,10 @@ DistIface::Sync::init(Tick start_tick, Tick repeat_tick)
         inform("Dist synchronisation interval is changed to %lu.\n",
                nextRepeat);
     }
+
+    if (link_delay < maxRepeat)
+        maxRepeat = link_delay;
+    adaptive = adaptive || adaptive_sync;
 }
 
 void
@@ -101,12 +108,16 @@ DistIface::SyncSwitch::SyncSwitch(int num_nodes)
     numExitReq = 0;
     numCkptReq = 0;
     numStopSyncReq = 0;
+    baseRepeat = 0;
     doExit = false;
     doCkpt = false;
     doStopSync = false;
     nextAt = std::numeric_limits<Tick>::max();
     nextRepeat = std::numeric_limits<Tick>::max();
     isAbort = false;
+    adaptive = false;
+    maxRepeat = std::numeric_limits<Tick>::max();
+    linkActive = false;
 }
 
 DistIface::SyncNode::SyncNode()
@@ -121,6 +132,9 @@ DistIface::SyncNode::SyncNode()
     nextAt = std::numeric_limits<Tick>::max();
     nextRepeat = std::numeric_limits<Tick>::max();
     isAbort = false;
+    adaptive = false;
+    maxRepeat = std::numeric_limits<Tick>::max();
+    linkActive = false;
 }
 
 bool
@@ -136,6 +150,7 @@ DistIface::SyncNode::run(bool same_tick)
     header.msgType = MsgType::cmdSyncReq;
     header.sendTick = curTick();
     header.syncRepeat = nextRepeat;
+    header.maxSyncRepeat = maxRepeat;
     header.needCkpt = needCkpt;
     header.needStopSync = needStopSync;
     if (needCkpt != ReqType::none)
@@ -170,10 +185,15 @@ DistIface::SyncSwitch::run(bool same_tick)
         return false;
     assert(!same_tick || (nextAt == curTick()));
     waitNum = numNodes;
+    // The interval may only change at periodic syncs, the other barriers
+    // are used to agree on the initial one.
+    if (same_tick && adaptive)
+        adaptRepeat();
     // Complete the global synchronisation
     header.msgType = MsgType::cmdSyncAck;
     header.sendTick = nextAt;
     header.syncRepeat = nextRepeat;
+    header.maxSyncRepeat = maxRepeat;
     if (doCkpt || numCkptReq == numNodes) {
         doCkpt = true;
         header.needCkpt = ReqType::immediate;
@@ -198,9 +218,31 @@ DistIface::SyncSwitch::run(bool same_tick)
     return true;
 }
 
+void
+DistIface::SyncSwitch::adaptRepeat()
+{
+    // The nodes have all sent their configured interval by the time the
+    // first periodic sync completes.
+    if (baseRepeat == 0)
+        baseRepeat = nextRepeat;
+    if (maxRepeat <= baseRepeat)
+        return;
+
+    Tick repeat = nextRepeat;
+    if (linkActive.exchange(false))
+        nextRepeat = baseRepeat;
+    else if (nextRepeat < maxRepeat)
+        nextRepeat = std::min(2 * nextRepeat, maxRepeat);
+
+    if (nextRepeat != repeat)
+        DPRINTF(DistEthernetCmd, "Dist sync interval %lu -> %lu\n", repeat,
+                nextRepeat);
+}
+
 bool
 DistIface::SyncSwitch::progress(Tick send_tick,
                                  Tick sync_repeat,
+                                 Tick max_repeat,
                                  ReqType need_ckpt,
                                  ReqType need_exit,
                                  ReqType need_stop_sync)
@@ -214,6 +256,8 @@ DistIface::SyncSwitch::progress(Tick send_tick,
         nextAt = send_tick;
     if (nextRepeat > sync_repeat)
         nextRepeat = sync_repeat;
+    if (maxRepeat > max_repeat)
+        maxRepeat = max_repeat;
 
     if (need_ckpt == ReqType::collective)
         numCkptReq++;
@@ -242,6 +286,7 @@ DistIface::SyncSwitch::progress(Tick send_tick,
 bool
 DistIface::SyncNode::progress(Tick max_send_tick,
                                Tick next_repeat,
+                               Tick max_repeat,
                                ReqType do_ckpt,
                                ReqType do_exit,
                                ReqType do_stop_sync)
@@ -697,6 +742,7 @@ DistIface::recvThreadFunc(Event *recv_done, Tick link_delay)
 
         // We got a valid dist header packet, let's process it
         if (header.msgType == MsgType::dataDescriptor) {
+            sync->linkActive.store(true, std::memory_order_relaxed);
             recvPacket(header, new_packet);
             recvScheduler.pushPacket(new_packet,
                                      header.sendTick,
@@ -705,6 +751,7 @@ DistIface::recvThreadFunc(Event *recv_done, Tick link_delay)
             // everything else must be synchronisation related command
             if (!sync->progress(header.sendTick,
                                 header.syncRepeat,
+                                header.maxSyncRepeat,
                                 header.needCkpt,
                                 header.needExit,
                                 header.needStopSync))
@@ -783,7 +830,7 @@ DistIface::unserialize(CheckpointIn &cp)
 }
 
 void
-DistIface::init(const Event *done_event, Tick link_delay)
+DistIface::init(const Event *done_event, Tick link_delay, bool adaptive_sync)
 {
     // Init hook for the underlaying message transport to setup/finalize
     // communication channels
@@ -800,7 +847,7 @@ DistIface::init(const Event *done_event, Tick link_delay)
     // might have different requirements. The singleton sync object
     // will select the minimum values for both params.
     assert(sync != nullptr);
-    sync->init(syncStart, syncRepeat);
+    sync->init(syncStart, syncRepeat, link_delay, adaptive_sync);
 
     // Initialize the seed for random generator to avoid the same sequence
     // in all gem5 peer processes
@@ -76,6 +76,7 @@
 #define __DEV_DIST_IFACE_HH__
 
 #include <array>
+#include <atomic>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -157,8 +158,25 @@ class DistIface : public Drainable, public Serializable
          *  Flag is set if the sync is aborted (e.g. due to connection lost)
          */
         bool isAbort;
+        /**
+         * Flag is set if the sync interval adapts to the link activity
+         * (only the switch makes use of it)
+         */
+        bool adaptive;
+        /**
+         * The upper bound for the sync interval. A packet must not arrive
+         * at its destination before the end of the quantum it was sent in,
+         * so this is the shortest simulated link delay of the dist run.
+         */
+        Tick maxRepeat;
+        /**
+         * Flag is set by the receiver threads if a data packet crossed a
+         * link since the last sync
+         */
+        std::atomic<bool> linkActive;
 
         friend class SyncEvent;
+        friend class DistIface;
 
       public:
         /**
@@ -166,9 +184,11 @@ class DistIface : public Drainable, public Serializable
          *
          * @param start Start tick for dist synchronisation
          * @param repeat Frequency of dist synchronisation
+         * @param link_delay Simulated delay of the link
+         * @param adaptive Enable the adaptive sync interval
          *
          */
-        void init(Tick start, Tick repeat);
+        void init(Tick start, Tick repeat, Tick link_delay, bool adaptive);
         /**
          *  Core method to perform a full dist sync.
          *
@@ -183,6 +203,7 @@ class DistIface : public Drainable, public Serializable
          */
         virtual bool progress(Tick send_tick,
                               Tick next_repeat,
+                              Tick max_repeat,
                               ReqType do_ckpt,
                               ReqType do_exit,
                               ReqType do_stop_sync) = 0;
@@ -225,6 +246,7 @@ class DistIface : public Drainable, public Serializable
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
                       Tick next_repeat,
+                      Tick max_repeat,
                       ReqType do_ckpt,
                       ReqType do_exit,
                       ReqType do_stop_sync) override;
@@ -256,6 +278,18 @@ class DistIface : public Drainable, public Serializable
          *  Number of connected simulated nodes
          */
         unsigned numNodes;
+        /**
+         * The sync interval all the nodes agreed on at the start. The
+         * adaptive interval falls back to it on link activity.
+         */
+        Tick baseRepeat;
+
+        /**
+         * Pick the interval for the next quantum: double it (up to
+         * maxRepeat) if no packet crossed the links during the quantum
+         * that just completed, revert to baseRepeat otherwise.
+         */
+        void adaptRepeat();
 
       public:
         SyncSwitch(int num_nodes);
@@ -264,6 +298,7 @@ class DistIface : public Drainable, public Serializable
         bool run(bool same_tick) override;
         bool progress(Tick max_req_tick,
                       Tick next_repeat,
+                      Tick max_repeat,
                       ReqType do_ckpt,
                       ReqType do_exit,
                       ReqType do_stop_sync) override;
@@ -601,7 +636,7 @@ class DistIface : public Drainable, public Serializable
 
     DrainState drain() override;
     void drainResume() override;
-    void init(const Event *e, Tick link_delay);
+    void init(const Event *e, Tick link_delay, bool adaptive_sync);
     void startup();
 
     void serialize(CheckpointOut &cp) const override;
@@ -111,6 +111,11 @@ class DistHeaderPkt
                 ReqType needExit;
             };
         };
+        /**
+         * Upper bound for the sync interval (only valid for sync
+         * requests, see DistIface::Sync::maxRepeat).
+         */
+        Tick maxSyncRepeat;
     };
 };
 
@@ -60,6 +60,7 @@
 #include "dev/net/etherpkt.hh"
 #include "params/EtherLink.hh"
 #include "sim/cur_tick.hh"
+#include "sim/eventq.hh"
 #include "sim/serialize.hh"
 #include "sim/system.hh"
 
@@ -88,6 +89,36 @@ EtherLink::~EtherLink()
     delete interface[1];
 }
 
+EventQueue *
+EtherLink::peerEventQueue(int num) const
+{
+    // Network interfaces are named after the object they belong to
+    const EtherInt *peer = interface[num]->getPeer();
+    if (!peer)
+        return eventQueue();
+    const std::string &peer_name = peer->name();
+    const auto dot = peer_name.rfind('.');
+    if (dot == std::string::npos)
+        return nullptr;
+    SimObject *owner = SimObject::find(peer_name.substr(0, dot).c_str());
+    return owner ? owner->eventQueue() : nullptr;
+}
+
+void
+EtherLink::init()
+{
+    SimObject::init();
+
+    // Packets only move between event queues if the two ends of the
+    // link are on different ones, assume they are if either can't be
+    // told. A packet takes at least one tick to be transmitted before
+    // it is delayed by the link.
+    EventQueue *eq0 = peerEventQueue(0);
+    EventQueue *eq1 = peerEventQueue(1);
+    if (!eq0 || !eq1 || eq0 != eq1)
+        registerLookahead(params().delay + 1);
+}
+
 Port &
 EtherLink::getPort(const std::string &if_name, PortID idx)
 {
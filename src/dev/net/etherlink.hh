@@ -142,14 +142,22 @@ class EtherLink : public SimObject
     Link *link[2];
     Interface *interface[2];
 
+    /**
+     * Event queue of the object at the other end of an interface, or
+     * nullptr if it can't be found.
+     */
+    EventQueue *peerEventQueue(int num) const;
+
   public:
-    using Params = EtherLinkParams;
+    PARAMS(EtherLink);
     EtherLink(const Params &p);
     virtual ~EtherLink();
 
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
+    void init() override;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
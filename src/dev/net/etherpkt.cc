@@ -29,6 +29,7 @@
 #include "dev/net/etherpkt.hh"
 
 #include <iostream>
+#include <vector>
 
 #include "base/inet.hh"
 #include "base/logging.hh"
@@ -37,6 +38,74 @@
 namespace gem5
 {
 
+namespace
+{
+
+/** Buffers up to this size are recycled (the size NICs use for frames). */
+constexpr unsigned maxPooledSize = 16384;
+/** Smallest pooled size class; larger classes are powers of two. */
+constexpr unsigned minPooledSize = 2048;
+constexpr unsigned numSizeClasses = 4;
+static_assert(minPooledSize << (numSizeClasses - 1) == maxPooledSize);
+/** Bound the number of idle buffers kept per size class. */
+constexpr size_t maxFreeBuffers = 256;
+
+int
+sizeClass(unsigned size)
+{
+    if (size > maxPooledSize)
+        return -1;
+    int cls = 0;
+    while ((minPooledSize << cls) < size)
+        cls++;
+    return cls;
+}
+
+struct BufferPool
+{
+    std::vector<uint8_t *> freeList[numSizeClasses];
+
+    ~BufferPool()
+    {
+        for (auto &list : freeList) {
+            for (auto buf : list)
+                delete [] buf;
+        }
+    }
+};
+
+// Frames may be freed by a different event queue thread than the one
+// that allocated them, the buffer then simply moves to that thread's pool.
+thread_local BufferPool bufferPool;
+
+} // anonymous namespace
+
+uint8_t *
+EthPacketData::allocBuffer(unsigned size)
+{
+    int cls = sizeClass(size);
+    if (cls < 0)
+        return new uint8_t[size];
+
+    auto &list = bufferPool.freeList[cls];
+    if (list.empty())
+        return new uint8_t[minPooledSize << cls];
+    uint8_t *buf = list.back();
+    list.pop_back();
+    return buf;
+}
+
+void
+EthPacketData::freeBuffer(uint8_t *buf, unsigned size)
+{
+    int cls = sizeClass(size);
+    if (cls < 0 || bufferPool.freeList[cls].size() >= maxFreeBuffers) {
+        delete [] buf;
+        return;
+    }
+    bufferPool.freeList[cls].push_back(buf);
+}
+
 void
 EthPacketData::serialize(const std::string &base, CheckpointOut &cp) const
 {
@@ -65,7 +134,7 @@ EthPacketData::unserialize(const std::string &base, CheckpointIn &cp)
     }
     assert(length <= bufLength);
     if (!data)
-        data = new uint8_t[bufLength];
+        data = allocBuffer(bufLength);
     arrayParamIn(cp, base + ".data", data, length);
     if (!optParamIn(cp, base + ".simLength", simLength))
         simLength = length;
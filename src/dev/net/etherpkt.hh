@@ -48,6 +48,15 @@ namespace gem5
  */
 class EthPacketData
 {
+  private:
+    /**
+     * Allocate and free data buffers. Frame sized buffers are recycled
+     * through a per thread free list since NICs allocate a new maximum
+     * sized buffer for every frame they send.
+     */
+    static uint8_t *allocBuffer(unsigned size);
+    static void freeBuffer(uint8_t *buf, unsigned size);
+
   public:
     /**
      * Pointer to packet data will be deleted
@@ -78,10 +87,13 @@ class EthPacketData
     { }
 
     explicit EthPacketData(unsigned size)
-        : data(new uint8_t[size]), bufLength(size), length(0), simLength(0)
+        : data(allocBuffer(size)), bufLength(size), length(0), simLength(0)
     { }
 
-    ~EthPacketData() { if (data) delete [] data; }
+    ~EthPacketData() { if (data) freeBuffer(data, bufLength); }
+
+    EthPacketData(const EthPacketData &) = delete;
+    EthPacketData &operator=(const EthPacketData &) = delete;
 
     void serialize(const std::string &base, CheckpointOut &cp) const;
     void unserialize(const std::string &base, CheckpointIn &cp);
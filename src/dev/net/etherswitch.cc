@@ -130,7 +130,7 @@ EtherSwitch::Interface::Interface(const std::string &name,
     : EtherInt(name), ticksPerByte(rate), switchDelay(delay),
       delayVar(delay_var), interfaceId(id), parent(etherSwitch),
       outputFifo(name + ".outputFifo", outputBufferSize),
-      txEvent([this]{ transmit(); }, name)
+      txEvent([this]{ transmit(); }, name), waitingForPeer(false)
 {
 }
 
@@ -185,7 +185,11 @@ EtherSwitch::Interface::transmit()
 
     if (!sendPacket(outputFifo.front())) {
         DPRINTF(Ethernet, "output port busy...retry later\n");
-        if (!txEvent.scheduled())
+        // A busy link tells us when it is done with its current frame.
+        // Anything else (e.g. a NIC with a full receive fifo) is polled.
+        if (askBusy())
+            waitingForPeer = true;
+        else if (!txEvent.scheduled())
             parent->schedule(txEvent, curTick() + sim_clock::as_int::ns);
     } else {
         DPRINTF(Ethernet, "packet sent: len=%d\n", outputFifo.front()->length);
@@ -198,6 +202,16 @@ EtherSwitch::Interface::transmit()
     }
 }
 
+void
+EtherSwitch::Interface::sendDone()
+{
+    if (!waitingForPeer)
+        return;
+    waitingForPeer = false;
+    if (!outputFifo.empty() && !txEvent.scheduled())
+        parent->schedule(txEvent, curTick());
+}
+
 Tick
 EtherSwitch::Interface::switchingDelay()
 {
@@ -282,6 +296,7 @@ EtherSwitch::Interface::serialize(CheckpointOut &cp) const
         Tick event_time = txEvent.when();
         SERIALIZE_SCALAR(event_time);
     }
+    SERIALIZE_SCALAR(waitingForPeer);
     outputFifo.serializeSection(cp, "outputFifo");
 }
 
@@ -296,6 +311,8 @@ EtherSwitch::Interface::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(event_time);
         parent->schedule(txEvent, event_time);
     }
+    if (!UNSERIALIZE_OPT_SCALAR(waitingForPeer))
+        waitingForPeer = false;
     outputFifo.unserializeSection(cp, "outputFifo");
 }
 
@@ -81,7 +81,11 @@ class EtherSwitch : public SimObject
          * enqueue packet to the outputFifo
          */
         void enqueue(EthPacketPtr packet, unsigned senderId);
-        void sendDone() {}
+        /**
+         * The peer link finished a transmission, so it can take the
+         * frame at the head of the output fifo if we were waiting on it
+         */
+        void sendDone();
         Tick switchingDelay();
 
         Interface* lookupDestPort(networking::EthAddr destAddr);
@@ -173,6 +177,11 @@ class EtherSwitch : public SimObject
         PortFifo outputFifo;
         void transmit();
         EventFunctionWrapper txEvent;
+        /**
+         * Set when the peer link was busy transmitting. It calls
+         * sendDone() once it is free, so there is no need to poll it.
+         */
+        bool waitingForPeer;
     };
 
     struct SwitchTableEntry
@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs.
+ */
+
+#include "dev/net/shm_iface.hh"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "base/types.hh"
+#include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Size of each ring in bytes (must be a power of two). */
+constexpr uint64_t ringSize = 1 << 20;
+/** Number of polls before a waiting thread goes to sleep. */
+constexpr int spinCount = 1000;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+              std::atomic<uint32_t>::is_always_lock_free,
+              "Shared memory rings need address-free atomics");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "Futex words must be plain 32 bit integers");
+
+/**
+ * Sleep until the futex word changes from the expected value. The wait
+ * is bounded so the caller gets a chance to check whether its peer is
+ * still alive.
+ */
+void
+futexWait(std::atomic<uint32_t> &word, uint32_t expected)
+{
+#if defined(__linux__)
+    struct timespec timeout = { 0, 100 * 1000 * 1000 };
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT,
+            expected, &timeout, nullptr, 0);
+#else
+    if (word.load() == expected)
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+#endif
+}
+
+void
+futexWake(std::atomic<uint32_t> &word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+/**
+ * Wait until ready() returns true or lost() reports that the peer went
+ * away. The caller spins for a short while first since the peer usually
+ * responds within a few microseconds during a sync.
+ *
+ * @return False if the peer went away.
+ */
+template <typename Ready, typename Lost>
+bool
+waitUntil(std::atomic<uint32_t> &seq, std::atomic<uint32_t> &waiters,
+          Ready ready, Lost lost)
+{
+    for (int i = 0; i < spinCount; i++) {
+        if (ready())
+            return true;
+    }
+    while (!ready()) {
+        if (lost())
+            return false;
+        uint32_t cur = seq.load();
+        waiters.fetch_add(1);
+        if (!ready())
+            futexWait(seq, cur);
+        waiters.fetch_sub(1);
+    }
+    return true;
+}
+
+/** Wake up the threads waiting in waitUntil() on the given word. */
+void
+notify(std::atomic<uint32_t> &seq, std::atomic<uint32_t> &waiters)
+{
+    seq.fetch_add(1);
+    if (waiters.load())
+        futexWake(seq);
+}
+
+} // anonymous namespace
+
+/**
+ * A single producer/single consumer byte ring. The head and tail fields
+ * are free running byte counters, so the ring is empty if they are equal
+ * and full if they are ringSize bytes apart.
+ */
+struct ShmIface::Ring
+{
+    /** Bytes written so far (only updated by the producer). */
+    alignas(64) std::atomic<uint64_t> head;
+    /** Bytes read so far (only updated by the consumer). */
+    alignas(64) std::atomic<uint64_t> tail;
+    /** Futex words for a consumer waiting for data. */
+    alignas(64) std::atomic<uint32_t> dataSeq;
+    std::atomic<uint32_t> dataWaiters;
+    /** Futex words for a producer waiting for space. */
+    alignas(64) std::atomic<uint32_t> spaceSeq;
+    std::atomic<uint32_t> spaceWaiters;
+    /** Set by the producer when it will not write any more. */
+    std::atomic<uint32_t> closed;
+    alignas(64) uint8_t data[ringSize];
+};
+
+/**
+ * Layout of the shared memory segment of one link. The compute node
+ * creates and publishes the segment, the switch acknowledges it.
+ */
+struct ShmIface::Channel
+{
+    enum State : uint32_t
+    {
+        Empty,
+        NodeReady,
+        Acked
+    };
+
+    struct NodeInfo
+    {
+        unsigned rank;
+        unsigned distIfaceId;
+        unsigned distIfaceNum;
+    };
+
+    std::atomic<uint32_t> state;
+    int nodePid;
+    int switchPid;
+    NodeInfo nodeInfo;
+    NodeInfo ackInfo;
+    Ring toSwitch;
+    Ring toNode;
+};
+
+std::vector<ShmIface *> ShmIface::ifaceRegistry;
+
+ShmIface::ShmIface(unsigned shm_key, unsigned dist_rank, unsigned dist_size,
+                   Tick sync_start, Tick sync_repeat, EventManager *em,
+                   bool use_pseudo_op, bool is_switch, int num_nodes) :
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
+              is_switch, num_nodes), shmKey(shm_key), isSwitch(is_switch),
+    channel(nullptr), txRing(nullptr), rxRing(nullptr), peerPid(-1)
+{
+}
+
+ShmIface::~ShmIface()
+{
+    // Closing our side makes the receiver thread of the peer see the end
+    // of the stream, just like closing a socket. The segment itself stays
+    // mapped as our own receiver thread is only joined by ~DistIface().
+    if (txRing) {
+        txRing->closed.store(1);
+        notify(txRing->dataSeq, txRing->dataWaiters);
+    }
+}
+
+std::string
+ShmIface::segmentName(unsigned node_rank, unsigned iface_id) const
+{
+    return csprintf("/gem5-dist-%u-%u-%u", shmKey, node_rank, iface_id);
+}
+
+bool
+ShmIface::peerLost() const
+{
+    if (rxRing->closed.load())
+        return true;
+    return peerPid > 0 && kill(peerPid, 0) == -1 && errno == ESRCH;
+}
+
+void
+ShmIface::establishConnection()
+{
+    static unsigned cur_rank = 0;
+    static unsigned cur_id = 0;
+
+    if (isSwitch) {
+        // Attach to the segment of the next compute node link in
+        // (rank, distIfaceId) order, which is the same order TCPIface uses
+        // to assign switch ports.
+        std::string seg_name = segmentName(cur_rank, cur_id);
+        DPRINTF(DistEthernet, "Waiting for shared memory segment %s\n",
+                seg_name);
+        for (;;) {
+            int fd = shm_open(seg_name.c_str(), O_RDWR, 0600);
+            if (fd >= 0) {
+                struct stat st;
+                // The node may not have sized the segment yet.
+                if (fstat(fd, &st) == 0 && st.st_size == sizeof(Channel)) {
+                    void *addr = mmap(nullptr, sizeof(Channel),
+                                      PROT_READ | PROT_WRITE, MAP_SHARED,
+                                      fd, 0);
+                    panic_if(addr == MAP_FAILED, "mmap() failed: %s",
+                             strerror(errno));
+                    close(fd);
+                    channel = static_cast<Channel *>(addr);
+                    break;
+                }
+                close(fd);
+            } else {
+                panic_if(errno != ENOENT, "shm_open() failed: %s",
+                         strerror(errno));
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        while (channel->state.load() != Channel::NodeReady)
+            futexWait(channel->state, Channel::Empty);
+
+        Channel::NodeInfo ni = channel->nodeInfo;
+        assert(ni.rank == cur_rank);
+        assert(ni.distIfaceId == cur_id);
+        inform("Link okay  (iface:%d -> (node:%d, iface:%d))",
+               distIfaceId, ni.rank, ni.distIfaceId);
+        if (ni.distIfaceId < ni.distIfaceNum - 1) {
+            cur_id++;
+        } else {
+            cur_rank++;
+            cur_id = 0;
+        }
+        txRing = &channel->toNode;
+        rxRing = &channel->toSwitch;
+        peerPid = channel->nodePid;
+
+        // send ack
+        ni.distIfaceId = distIfaceId;
+        ni.distIfaceNum = distIfaceNum;
+        channel->ackInfo = ni;
+        channel->switchPid = getpid();
+        channel->state.store(Channel::Acked);
+        futexWake(channel->state);
+        // Both sides have the segment mapped now, so the name is not
+        // needed anymore.
+        shm_unlink(seg_name.c_str());
+    } else { // this is not a switch
+        std::string seg_name = segmentName(rank, distIfaceId);
+        // Remove any stale segment left behind by a crashed earlier run.
+        shm_unlink(seg_name.c_str());
+        int fd = shm_open(seg_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        panic_if(fd < 0, "shm_open() failed: %s", strerror(errno));
+        panic_if(ftruncate(fd, sizeof(Channel)) != 0,
+                 "ftruncate() failed: %s", strerror(errno));
+        void *addr = mmap(nullptr, sizeof(Channel), PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd, 0);
+        panic_if(addr == MAP_FAILED, "mmap() failed: %s", strerror(errno));
+        close(fd);
+
+        channel = new (addr) Channel();
+        txRing = &channel->toSwitch;
+        rxRing = &channel->toNode;
+
+        // send link info
+        channel->nodeInfo.rank = rank;
+        channel->nodeInfo.distIfaceId = distIfaceId;
+        channel->nodeInfo.distIfaceNum = distIfaceNum;
+        channel->nodePid = getpid();
+        channel->state.store(Channel::NodeReady);
+        futexWake(channel->state);
+        DPRINTF(DistEthernet, "Published %s, waiting for ack "
+                "(distIfaceId:%d)\n", seg_name, distIfaceId);
+        while (channel->state.load() != Channel::Acked)
+            futexWait(channel->state, Channel::NodeReady);
+
+        assert(channel->ackInfo.rank == rank);
+        peerPid = channel->switchPid;
+        inform("Link okay  (iface:%d -> switch iface:%d)", distIfaceId,
+               channel->ackInfo.distIfaceId);
+    }
+    ifaceRegistry.push_back(this);
+}
+
+void
+ShmIface::sendShm(const void *buf, unsigned length)
+{
+    Ring &ring = *txRing;
+    const uint8_t *src = static_cast<const uint8_t *>(buf);
+
+    while (length > 0) {
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        auto space = [&]() {
+            uint64_t tail = ring.tail.load(std::memory_order_acquire);
+            return ringSize - (head - tail);
+        };
+        if (!waitUntil(ring.spaceSeq, ring.spaceWaiters,
+                       [&]() { return space() > 0; },
+                       [this]() { return peerLost(); })) {
+            exitSimLoop("Message server closed connection, simulation "
+                        "is exiting");
+            return;
+        }
+
+        uint64_t chunk = std::min<uint64_t>(space(), length);
+        uint64_t offset = head & (ringSize - 1);
+        uint64_t first = std::min(chunk, ringSize - offset);
+        memcpy(ring.data + offset, src, first);
+        memcpy(ring.data, src + first, chunk - first);
+        ring.head.store(head + chunk, std::memory_order_release);
+        notify(ring.dataSeq, ring.dataWaiters);
+
+        src += chunk;
+        length -= chunk;
+    }
+}
+
+bool
+ShmIface::recvShm(void *buf, unsigned length)
+{
+    Ring &ring = *rxRing;
+    uint8_t *dst = static_cast<uint8_t *>(buf);
+
+    while (length > 0) {
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        auto avail = [&]() {
+            return ring.head.load(std::memory_order_acquire) - tail;
+        };
+        // Data written before the peer closed the ring is still valid.
+        if (!waitUntil(ring.dataSeq, ring.dataWaiters,
+                       [&]() { return avail() > 0; },
+                       [this]() { return peerLost(); })) {
+            inform("recv(): Connection closed");
+            return false;
+        }
+
+        uint64_t chunk = std::min<uint64_t>(avail(), length);
+        uint64_t offset = tail & (ringSize - 1);
+        uint64_t first = std::min(chunk, ringSize - offset);
+        memcpy(dst, ring.data + offset, first);
+        memcpy(dst + first, ring.data, chunk - first);
+        ring.tail.store(tail + chunk, std::memory_order_release);
+        notify(ring.spaceSeq, ring.spaceWaiters);
+
+        dst += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+void
+ShmIface::sendPacket(const Header &header, const EthPacketPtr &packet)
+{
+    sendShm(&header, sizeof(header));
+    sendShm(packet->data, packet->length);
+}
+
+void
+ShmIface::sendCmd(const Header &header)
+{
+    DPRINTF(DistEthernetCmd, "ShmIface::sendCmd() type: %d\n",
+            static_cast<int>(header.msgType));
+    // Global commands (i.e. sync request) are always sent by the primary
+    // DistIface through all the links of this process.
+    for (auto iface: ifaceRegistry)
+        iface->sendShm(&header, sizeof(header));
+}
+
+bool
+ShmIface::recvHeader(Header &header)
+{
+    bool ret = recvShm(&header, sizeof(header));
+    DPRINTF(DistEthernetCmd, "ShmIface::recvHeader() type: %d ret: %d\n",
+            static_cast<int>(header.msgType), ret);
+    return ret;
+}
+
+void
+ShmIface::recvPacket(const Header &header, EthPacketPtr &packet)
+{
+    packet = std::make_shared<EthPacketData>(header.dataPacketLength);
+    bool ret = recvShm(packet->data, header.dataPacketLength);
+    panic_if(!ret, "Error while reading shared memory ring");
+    packet->simLength = header.simLength;
+    packet->length = header.dataPacketLength;
+}
+
+void
+ShmIface::initTransport()
+{
+    // Like TCPIface, connections are set up here since the number of dist
+    // interfaces per process is only known after the init phase.
+    establishConnection();
+}
+
+} // namespace gem5
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory based interface class for dist-gem5 runs.
+ *
+ * For a high level description about dist-gem5 see comments in
+ * header file dist_iface.hh.
+ *
+ * This transport is a drop-in replacement for TCPIface when all the gem5
+ * processes of a dist run execute on the same host. Every compute node
+ * link shares a POSIX shared memory segment with its peer link in the
+ * switch process. The segment holds one single producer/single consumer
+ * byte ring per direction, so the messages go through exactly the same
+ * byte stream protocol as with TCP, but without any system call on the
+ * fast path. A blocked reader (or a writer facing a full ring) sleeps on
+ * a futex and is only woken up by its peer if it actually went to sleep.
+ */
+#ifndef __DEV_NET_SHM_IFACE_HH__
+#define __DEV_NET_SHM_IFACE_HH__
+
+#include <string>
+#include <vector>
+
+#include "dev/net/dist_iface.hh"
+
+namespace gem5
+{
+
+class EventManager;
+
+class ShmIface : public DistIface
+{
+  private:
+    struct Ring;
+    struct Channel;
+
+    /**
+     * The key that identifies the dist run. The names of all the shared
+     * memory segments of the run are derived from it.
+     */
+    unsigned shmKey;
+
+    bool isSwitch;
+
+    /** The shared memory segment of this link. */
+    Channel *channel;
+    /** The ring this link writes (i.e. the ring read by the peer). */
+    Ring *txRing;
+    /** The ring this link reads (i.e. the ring written by the peer). */
+    Ring *rxRing;
+    /** Process id of the peer gem5 process, used to detect crashes. */
+    int peerPid;
+
+    /**
+     * All the links of this gem5 process (global commands are sent
+     * through all of them).
+     */
+    static std::vector<ShmIface *> ifaceRegistry;
+
+  private:
+    /**
+     * Name of the shared memory segment of a compute node link.
+     *
+     * @param node_rank Rank of the compute node.
+     * @param iface_id Id of the dist interface within the compute node.
+     */
+    std::string segmentName(unsigned node_rank, unsigned iface_id) const;
+
+    /** Check whether the peer gem5 process went away. */
+    bool peerLost() const;
+
+    /**
+     * Send out a message through the shared memory ring.
+     *
+     * @param buf Start address of the message.
+     * @param length Size of the message in bytes.
+     */
+    void sendShm(const void *buf, unsigned length);
+
+    /**
+     * Receive the next incoming message through the shared memory ring.
+     *
+     * @param buf Start address of buffer to store the message.
+     * @param length Exact size of the expected message in bytes.
+     * @return False if the peer closed the connection.
+     */
+    bool recvShm(void *buf, unsigned length);
+
+    void establishConnection();
+
+  protected:
+
+    void sendPacket(const Header &header,
+                    const EthPacketPtr &packet) override;
+
+    void sendCmd(const Header &header) override;
+
+    bool recvHeader(Header &header) override;
+
+    void recvPacket(const Header &header, EthPacketPtr &packet) override;
+
+    void initTransport() override;
+
+  public:
+    /**
+     * @param shm_key Key identifying the dist run. All the gem5 processes
+     * of a run must use the same key and concurrent runs on the same host
+     * must use different keys.
+     * @param sync_start The tick for the first dist synchronisation.
+     * @param sync_repeat The frequency of dist synchronisation.
+     * @param em The EventManager object associated with the simulated
+     * Ethernet link.
+     */
+    ShmIface(unsigned shm_key, unsigned dist_rank, unsigned dist_size,
+             Tick sync_start, Tick sync_repeat, EventManager *em,
+             bool use_pseudo_op, bool is_switch, int num_nodes);
+
+    ~ShmIface() override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_SHM_IFACE_HH__
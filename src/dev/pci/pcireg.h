@@ -114,6 +114,7 @@ union PCIConfig
 #define PCI_BIST                0x0F    // Built in self test           rw
 
 // some pci command reg bitfields
+#define PCI_CMD_INTXDIS 0x400 // INTx emulation disable
 #define PCI_CMD_BME     0x04 // Bus master function enable
 #define PCI_CMD_MSE     0x02 // Memory Space Access enable
 #define PCI_CMD_IOSE    0x01 // I/O space enable
@@ -220,10 +220,15 @@ BasePixelPump::renderPixels()
     // Try to handle multiple pixels at a time; doing so reduces the
     // accuracy of the underrun detection but lowers simulation
     // overhead
+    const unsigned x_start(_posX);
     const unsigned x_end(std::min(_posX + pixelChunk, _timings.width));
     const unsigned pxl_count(x_end - _posX);
     const unsigned pos_y(posY());
 
+    if (lineBuffer.size() < pxl_count)
+        lineBuffer.resize(pxl_count);
+    auto pixel_it = lineBuffer.begin();
+
     Pixel pixel(0, 0, 0);
     const Pixel underrun_pixel(0, 0, 0);
     for (; _posX < x_end && !_underrun; ++_posX) {
@@ -234,20 +239,24 @@ BasePixelPump::renderPixels()
             onUnderrun(_posX, pos_y);
             pixel = underrun_pixel;
         }
-        fb.pixel(_posX, pos_y) = pixel;
+        *pixel_it++ = pixel;
     }
 
     // Fill remaining pixels with a dummy pixel value if we ran out of
     // data
     for (; _posX < x_end; ++_posX)
-        fb.pixel(_posX, pos_y) = underrun_pixel;
+        *pixel_it++ = underrun_pixel;
+
+    fb.setPixels(x_start, pos_y, lineBuffer.data(), pxl_count);
 
     // Schedule a new event to handle the next block of pixels
     if (_posX < _timings.width) {
         schedule(evRenderPixels, clockEdge(Cycles(pxl_count)));
     } else {
-        if (pos_y == _timings.height - 1)
+        if (pos_y == _timings.height - 1) {
             onFrameDone();
+            fb.clearDirty();
+        }
     }
 }
 
@@ -277,6 +286,7 @@ BasePixelPump::renderFrame()
 
     line = _timings.lineFrontPorchStart() - 1;
     onFrameDone();
+    fb.clearDirty();
 
     // Signal vsync until the next frame begins
     line = _timings.lineVSyncStart();
@@ -289,9 +299,12 @@ BasePixelPump::renderLine()
     const unsigned pos_y = posY();
     const size_t _width = fb.width();
 
-    auto pixel_it = fb.pixels.begin() + _width * pos_y;
-    panic_if(nextLine(pixel_it, _width) != _width,
+    if (lineBuffer.size() < _width)
+        lineBuffer.resize(_width);
+
+    panic_if(nextLine(lineBuffer.begin(), _width) != _width,
             "Unexpected underrun in BasePixelPump (%u, %u)", _width, pos_y);
+    fb.setPixels(0, pos_y, lineBuffer.data(), _width);
 }
 
 
@@ -212,7 +212,11 @@ class BasePixelPump
         return visibleLine() ? line - _timings.lineFirstVisible() : 0;
     }
 
-    /** Output frame buffer */
+    /**
+     * Output frame buffer. The dirty area of the frame buffer is
+     * cleared after the onFrameDone() callback, so that it shows the
+     * pixels that changed in the last frame.
+     */
     FrameBuffer fb;
 
   protected: // Callbacks
@@ -363,6 +367,12 @@ class BasePixelPump
 
     /** Did a buffer underrun occur within this refresh interval? */
     bool _underrun;
+
+    /**
+     * Pixels being rendered, they are compared with the frame buffer
+     * to track the area that changed.
+     */
+    std::vector<Pixel> lineBuffer;
 };
 
 } // namespace gem5
@@ -41,6 +41,13 @@ class RawDiskImage(DiskImage):
     type = "RawDiskImage"
     cxx_header = "dev/storage/disk_image.hh"
     cxx_class = "gem5::RawDiskImage"
+    async_io = Param.Bool(
+        True,
+        "Perform the host I/O of asynchronous requests in a helper thread",
+    )
+    cache_size = Param.MemorySize(
+        "4MiB", "Size of the cache for recently accessed sectors"
+    )
 
 
 class CowDiskImage(DiskImage):
@@ -48,5 +55,13 @@ class CowDiskImage(DiskImage):
     cxx_header = "dev/storage/disk_image.hh"
     cxx_class = "gem5::CowDiskImage"
     child = Param.DiskImage(RawDiskImage(read_only=True), "child image")
-    table_size = Param.Int(65536, "initial table size")
+    table_size = Param.Int(65536, "initial table size (sectors)")
+    block_size = Param.MemorySize(
+        "4KiB", "Granularity of the copy-on-write blocks (at most 32KiB)"
+    )
+    overlay_file = Param.String(
+        "",
+        "Sparse host file holding the copy-on-write data, relative to "
+        "the output directory (empty keeps the data in memory)",
+    )
     image_file = ""
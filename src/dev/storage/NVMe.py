@@ -0,0 +1,77 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.PciDevice import (
+    PciDevice,
+    PciMemBar,
+)
+from m5.params import *
+
+
+class NVMeController(PciDevice):
+    type = "NVMeController"
+    cxx_header = "dev/storage/nvme.hh"
+    cxx_class = "gem5::NVMeController"
+
+    image = Param.DiskImage("Disk image of the namespace")
+
+    max_queues = Param.UInt16(64, "Maximum number of I/O queue pairs")
+    max_queue_entries = Param.UInt32(
+        4096, "Maximum number of entries of a queue"
+    )
+    max_outstanding = Param.Unsigned(
+        256, "Maximum number of commands in flight in the controller"
+    )
+    max_transfer = Param.MemorySize(
+        "128KiB", "Maximum data transfer size of a command"
+    )
+
+    read_latency = Param.Latency("20us", "Media read latency")
+    write_latency = Param.Latency("10us", "Media write latency")
+    bandwidth = Param.MemoryBandwidth("3GiB/s", "Media bandwidth")
+
+    VendorID = 0x1B36
+    DeviceID = 0x0010
+    Command = 0x0
+    Status = 0x0010
+    Revision = 0x2
+    ClassCode = 0x01
+    SubClassCode = 0x08
+    ProgIF = 0x02
+    InterruptLine = 0x1F
+    InterruptPin = 0x01
+
+    # Registers, doorbells, MSI-X table and PBA
+    BAR0 = PciMemBar(size="16KiB")
+
+    CapabilityPtr = 0x50
+    MSIXCAPBaseOffset = 0x50
+    MSIXCAPNextCapability = 0x00
+    MSIXCAPCapId = 0x11
+    # 64 vectors, table and PBA in BAR 0
+    MSIXMsgCtrl = 0x003F
+    MSIXTableOffset = 0x2000
+    MSIXPbaOffset = 0x3000
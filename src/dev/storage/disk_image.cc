@@ -32,10 +32,17 @@
 
 #include "dev/storage/disk_image.hh"
 
+#include <fcntl.h>
+#include <sys/ioctl.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <linux/fs.h>
+#endif
+
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <fstream>
@@ -43,6 +50,7 @@
 
 #include "base/callback.hh"
 #include "base/logging.hh"
+#include "base/output.hh"
 #include "base/trace.hh"
 #include "debug/DiskImageRead.hh"
 #include "debug/DiskImageWrite.hh"
@@ -53,18 +61,56 @@
 namespace gem5
 {
 
+////////////////////////////////////////////////////////////////////////
+//
+// Disk image
+//
+void
+DiskImage::readAsync(uint8_t *data, std::streampos offset, unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i) {
+        if (read(data + i * SectorSize, offset + (std::streamoff)i) !=
+                SectorSize) {
+            asyncFailed = true;
+        }
+    }
+}
+
+void
+DiskImage::writeAsync(const uint8_t *data, std::streampos offset,
+                      unsigned count)
+{
+    for (unsigned i = 0; i < count; ++i) {
+        if (write(data + i * SectorSize, offset + (std::streamoff)i) !=
+                SectorSize) {
+            asyncFailed = true;
+        }
+    }
+}
+
+bool
+DiskImage::waitAsync()
+{
+    const bool ok = !asyncFailed;
+    asyncFailed = false;
+    return ok;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Raw Disk image
 //
 RawDiskImage::RawDiskImage(const Params &p)
-    : DiskImage(p), disk_size(0)
+    : DiskImage(p), fd(-1), disk_size(0), asyncIO(p.async_io),
+      ioPending(0), ioStop(false), ioError(false),
+      cacheSectors(p.cache_size / SectorSize)
 {
     open(p.image_file, p.read_only);
 }
 
 RawDiskImage::~RawDiskImage()
 {
+    stopWorker();
     close();
 }
 
@@ -74,11 +120,25 @@ RawDiskImage::notifyFork()
     if (initialized && !readonly)
         panic("Attempting to fork system with read-write raw disk image.");
 
+    // The helper thread is stopped when the system is drained before
+    // forking, it does not exist in the child process.
+    panic_if(worker.joinable(),
+             "Attempting to fork with outstanding disk image I/O.");
+
     const Params &p = dynamic_cast<const Params &>(params());
     close();
     open(p.image_file, p.read_only);
 }
 
+DrainState
+RawDiskImage::drain()
+{
+    // Complete all the host I/O, the data must be in place before the
+    // device models are checkpointed
+    stopWorker();
+    return DrainState::Drained;
+}
+
 void
 RawDiskImage::open(const std::string &filename, bool rd_only)
 {
@@ -87,11 +147,8 @@ RawDiskImage::open(const std::string &filename, bool rd_only)
         readonly = rd_only;
         file = filename;
 
-        std::ios::openmode mode = std::ios::in | std::ios::binary;
-        if (!readonly)
-            mode |= std::ios::out;
-        stream.open(file.c_str(), mode);
-        if (!stream.is_open())
+        fd = ::open(file.c_str(), readonly ? O_RDONLY : O_RDWR);
+        if (fd < 0)
             panic("Error opening %s", filename);
     }
 }
@@ -99,42 +156,172 @@ RawDiskImage::open(const std::string &filename, bool rd_only)
 void
 RawDiskImage::close()
 {
-    stream.close();
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
 }
 
 std::streampos
 RawDiskImage::size() const
 {
     if (disk_size == 0) {
-        if (!stream.is_open())
+        if (fd < 0)
             panic("file not open!\n");
-        stream.seekg(0, std::ios::end);
-        disk_size = stream.tellg();
+        disk_size = lseek(fd, 0, SEEK_END);
     }
 
     return disk_size / SectorSize;
 }
 
+size_t
+RawDiskImage::hostIO(bool write, uint8_t *data, size_t size,
+                     off_t offset) const
+{
+    size_t done = 0;
+    while (done < size) {
+        const ssize_t ret = write ?
+            pwrite(fd, data + done, size - done, offset + done) :
+            pread(fd, data + done, size - done, offset + done);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            break;
+        done += ret;
+    }
+    return done;
+}
+
+void
+RawDiskImage::submit(IoRequest &&req)
+{
+    if (!asyncIO) {
+        uint8_t *data = req.write ? req.buffer.data() : req.data;
+        if (hostIO(req.write, data, req.size, req.offset) != req.size)
+            ioError = true;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(ioMutex);
+    if (!worker.joinable())
+        worker = std::thread([this]() { workerMain(); });
+
+    ioQueue.push_back(std::move(req));
+    ++ioPending;
+    ioCond.notify_one();
+}
+
+void
+RawDiskImage::workerMain()
+{
+    std::unique_lock<std::mutex> lock(ioMutex);
+    while (true) {
+        ioCond.wait(lock, [this]() { return ioStop || !ioQueue.empty(); });
+        if (ioQueue.empty())
+            return;
+
+        IoRequest req = std::move(ioQueue.front());
+        ioQueue.pop_front();
+        lock.unlock();
+
+        uint8_t *data = req.write ? req.buffer.data() : req.data;
+        const bool ok =
+            hostIO(req.write, data, req.size, req.offset) == req.size;
+
+        lock.lock();
+        if (!ok)
+            ioError = true;
+        if (--ioPending == 0)
+            doneCond.notify_all();
+    }
+}
+
+void
+RawDiskImage::stopWorker()
+{
+    if (!worker.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        ioStop = true;
+    }
+    ioCond.notify_all();
+    worker.join();
+    ioStop = false;
+}
+
+void
+RawDiskImage::waitIdle() const
+{
+    std::unique_lock<std::mutex> lock(ioMutex);
+    doneCond.wait(lock, [this]() { return ioPending == 0; });
+}
+
+bool
+RawDiskImage::cacheLookup(uint64_t sector, uint8_t *data) const
+{
+    auto it = cacheMap.find(sector);
+    if (it == cacheMap.end())
+        return false;
+
+    cacheLru.splice(cacheLru.begin(), cacheLru, it->second);
+    memcpy(data, it->second->data, SectorSize);
+    return true;
+}
+
+void
+RawDiskImage::cacheUpdate(uint64_t sector, const uint8_t *data) const
+{
+    if (cacheSectors == 0)
+        return;
+
+    auto it = cacheMap.find(sector);
+    if (it != cacheMap.end()) {
+        cacheLru.splice(cacheLru.begin(), cacheLru, it->second);
+    } else {
+        if (cacheLru.size() >= cacheSectors) {
+            cacheMap.erase(cacheLru.back().sector);
+            cacheLru.pop_back();
+        }
+        cacheLru.emplace_front();
+        cacheLru.front().sector = sector;
+        it = cacheMap.emplace(sector, cacheLru.begin()).first;
+    }
+    memcpy(it->second->data, data, SectorSize);
+}
+
+void
+RawDiskImage::dropCacheFills(uint64_t sector, unsigned count)
+{
+    cacheFills.erase(std::remove_if(cacheFills.begin(), cacheFills.end(),
+        [sector, count](const CacheFill &f) {
+            return f.sector < sector + count && sector < f.sector + f.count;
+        }), cacheFills.end());
+}
+
 std::streampos
 RawDiskImage::read(uint8_t *data, std::streampos offset) const
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
 
-    if (!stream.is_open())
+    if (fd < 0)
         panic("file not open!\n");
 
-    stream.seekg(offset * SectorSize, std::ios::beg);
-    if (!stream.good())
-        panic("Could not seek to location in file");
-
-    std::streampos pos = stream.tellg();
-    stream.read((char *)data, SectorSize);
+    size_t bytes = SectorSize;
+    if (!cacheLookup(offset, data)) {
+        // Reads must observe the asynchronous writes
+        waitIdle();
+        bytes = hostIO(false, data, SectorSize, offset * SectorSize);
+        if (bytes == SectorSize)
+            cacheUpdate(offset, data);
+    }
 
     DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
     DDUMP(DiskImageRead, data, SectorSize);
 
-    return stream.tellg() - pos;
+    return bytes;
 }
 
 std::streampos
@@ -146,31 +333,164 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     if (readonly)
         panic("Cannot write to a read only disk image");
 
-    if (!stream.is_open())
+    if (fd < 0)
         panic("file not open!\n");
 
-    stream.seekp(offset * SectorSize, std::ios::beg);
-    if (!stream.good())
-        panic("Could not seek to location in file");
-
     DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
     DDUMP(DiskImageWrite, data, SectorSize);
 
-    std::streampos pos = stream.tellp();
-    stream.write((const char *)data, SectorSize);
-    return stream.tellp() - pos;
+    waitIdle();
+    dropCacheFills(offset, 1);
+    cacheUpdate(offset, data);
+    return hostIO(true, const_cast<uint8_t *>(data), SectorSize,
+                  offset * SectorSize);
+}
+
+void
+RawDiskImage::readAsync(uint8_t *data, std::streampos offset,
+                        unsigned count)
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (fd < 0)
+        panic("file not open!\n");
+
+    DPRINTF(DiskImageRead, "readAsync: offset=%d count=%d\n",
+            (uint64_t)offset, count);
+
+    // Serve the cached sectors right away and issue a single host read
+    // for every run of sectors missing from the cache
+    const uint64_t first = offset;
+    unsigned run = 0;
+    for (unsigned i = 0; i <= count; ++i) {
+        if (i < count && !cacheLookup(first + i, data + i * SectorSize)) {
+            ++run;
+            continue;
+        }
+        if (run == 0)
+            continue;
+
+        const unsigned start = i - run;
+        uint8_t *dst = data + start * SectorSize;
+        if (cacheSectors)
+            cacheFills.push_back({first + start, run, dst});
+
+        IoRequest req;
+        req.write = false;
+        req.data = dst;
+        req.offset = (first + start) * SectorSize;
+        req.size = run * SectorSize;
+        submit(std::move(req));
+        run = 0;
+    }
+}
+
+void
+RawDiskImage::writeAsync(const uint8_t *data, std::streampos offset,
+                         unsigned count)
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (readonly)
+        panic("Cannot write to a read only disk image");
+
+    if (fd < 0)
+        panic("file not open!\n");
+
+    DPRINTF(DiskImageWrite, "writeAsync: offset=%d count=%d\n",
+            (uint64_t)offset, count);
+    DDUMP(DiskImageWrite, data, count * SectorSize);
+
+    const uint64_t first = offset;
+    dropCacheFills(first, count);
+    for (unsigned i = 0; i < count; ++i)
+        cacheUpdate(first + i, data + i * SectorSize);
+
+    IoRequest req;
+    req.write = true;
+    req.data = nullptr;
+    req.buffer.assign(data, data + count * SectorSize);
+    req.offset = first * SectorSize;
+    req.size = count * SectorSize;
+    submit(std::move(req));
+}
+
+bool
+RawDiskImage::waitAsync()
+{
+    waitIdle();
+
+    const bool ok = DiskImage::waitAsync() && !ioError;
+    ioError = false;
+
+    // The reads are complete, the data can be cached now
+    if (ok) {
+        for (const auto &fill : cacheFills) {
+            for (unsigned i = 0; i < fill.count; ++i)
+                cacheUpdate(fill.sector + i, fill.data + i * SectorSize);
+        }
+    }
+    cacheFills.clear();
+
+    return ok;
 }
 
 ////////////////////////////////////////////////////////////////////////
 //
 // Copy on Write Disk image
 //
-const uint32_t CowDiskImage::VersionMajor = 1;
+const uint32_t CowDiskImage::VersionMajor = 2;
 const uint32_t CowDiskImage::VersionMinor = 0;
 
+namespace
+{
+
+/**
+ * Copy the overlay data of a COW image to another host file.
+ *
+ * Copy-on-write file systems clone the whole file in constant time,
+ * otherwise only the given blocks are copied and the rest of the
+ * destination stays sparse.
+ */
+void
+copyOverlay(int src_fd, int dst_fd, const std::vector<uint64_t> &blocks,
+            unsigned block_size)
+{
+#ifdef FICLONE
+    if (ioctl(dst_fd, FICLONE, src_fd) == 0)
+        return;
+#endif
+
+    if (ftruncate(dst_fd, 0) != 0)
+        panic("Could not truncate COW overlay: %s", strerror(errno));
+
+    std::vector<uint8_t> buf(block_size);
+    for (uint64_t block : blocks) {
+        const off_t off = block * block_size;
+        if (pread(src_fd, buf.data(), block_size, off) != block_size ||
+            pwrite(dst_fd, buf.data(), block_size, off) != block_size) {
+            panic("Could not copy COW overlay: %s", strerror(errno));
+        }
+    }
+}
+
+} // anonymous namespace
+
 CowDiskImage::CowDiskImage(const Params &p)
-    : DiskImage(p), filename(p.image_file), child(p.child), table(NULL)
+    : DiskImage(p), filename(p.image_file), child(p.child),
+      blockSize(p.block_size), sectorsPerBlock(p.block_size / SectorSize),
+      slots(0), overlayFd(-1)
 {
+    fatal_if(blockSize % SectorSize != 0 || sectorsPerBlock == 0 ||
+             sectorsPerBlock > 64,
+             "%s: The block size must be a multiple of %d bytes and at "
+             "most %d bytes.", name(), SectorSize, 64 * SectorSize);
+
+    if (!p.overlay_file.empty())
+        openOverlay(simout.resolve(p.overlay_file));
+
     if (filename.empty()) {
         initSectorTable(p.table_size);
     } else {
@@ -187,12 +507,106 @@ CowDiskImage::CowDiskImage(const Params &p)
 
 CowDiskImage::~CowDiskImage()
 {
-    SectorTable::iterator i = table->begin();
-    SectorTable::iterator end = table->end();
+    if (overlayFd >= 0)
+        ::close(overlayFd);
+}
 
-    while (i != end) {
-        delete (*i).second;
-        ++i;
+void
+CowDiskImage::openOverlay(const std::string &file)
+{
+    const int fd = ::open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        panic("Error opening COW overlay %s: %s", file, strerror(errno));
+
+    if (overlayFd >= 0) {
+        copyOverlay(overlayFd, fd, overlayBlocks(), blockSize);
+        ::close(overlayFd);
+    }
+
+    overlayFd = fd;
+    overlayFile = file;
+}
+
+std::vector<uint64_t>
+CowDiskImage::overlayBlocks() const
+{
+    std::vector<uint64_t> blocks;
+    blocks.reserve(table.size());
+    for (const auto &entry : table)
+        blocks.push_back(entry.first);
+    std::sort(blocks.begin(), blocks.end());
+    return blocks;
+}
+
+const CowDiskImage::Block *
+CowDiskImage::findSector(uint64_t sector) const
+{
+    auto it = table.find(sector / sectorsPerBlock);
+    if (it == table.end() ||
+        !(it->second.valid & (1ULL << (sector % sectorsPerBlock)))) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+uint8_t *
+CowDiskImage::slotData(uint32_t slot) const
+{
+    const unsigned per_chunk = ChunkSize / blockSize;
+    return chunks[slot / per_chunk].get() + (slot % per_chunk) * blockSize;
+}
+
+void
+CowDiskImage::readSector(const Block &block, uint64_t sector,
+                         uint8_t *data) const
+{
+    if (overlayFd >= 0) {
+        // The overlay file has the same layout as the disk
+        const off_t off = sector * SectorSize;
+        if (pread(overlayFd, data, SectorSize, off) != SectorSize)
+            panic("Error reading COW overlay: %s", strerror(errno));
+    } else {
+        const unsigned idx = sector % sectorsPerBlock;
+        memcpy(data, slotData(block.slot) + idx * SectorSize, SectorSize);
+    }
+}
+
+CowDiskImage::Block &
+CowDiskImage::markSector(uint64_t sector)
+{
+    const uint64_t block_num = sector / sectorsPerBlock;
+
+    auto it = table.find(block_num);
+    if (it == table.end()) {
+        Block block;
+        block.valid = 0;
+        block.slot = 0;
+        if (overlayFd < 0) {
+            // Blocks are never freed, so the slots are handed out in
+            // order from chunks of a fixed size
+            const unsigned per_chunk = ChunkSize / blockSize;
+            if (slots % per_chunk == 0)
+                chunks.emplace_back(new uint8_t[ChunkSize]());
+            block.slot = slots++;
+        }
+        it = table.emplace(block_num, block).first;
+    }
+
+    it->second.valid |= 1ULL << (sector % sectorsPerBlock);
+    return it->second;
+}
+
+void
+CowDiskImage::writeSector(uint64_t sector, const uint8_t *data)
+{
+    Block &block = markSector(sector);
+    if (overlayFd >= 0) {
+        const off_t off = sector * SectorSize;
+        if (pwrite(overlayFd, data, SectorSize, off) != SectorSize)
+            panic("Error writing COW overlay: %s", strerror(errno));
+    } else {
+        const unsigned idx = sector % sectorsPerBlock;
+        memcpy(slotData(block.slot) + idx * SectorSize, data, SectorSize);
     }
 }
 
@@ -204,6 +618,11 @@ CowDiskImage::notifyFork()
         inform("Disabling saving of COW image in forked child process.\n");
         filename = "";
     }
+
+    // The overlay file is shared with the parent, give the child its
+    // own copy
+    if (overlayFd >= 0)
+        openOverlay(csprintf("%s.%d", overlayFile, getpid()));
 }
 
 void
@@ -255,24 +674,60 @@ CowDiskImage::open(const std::string &file)
     SafeReadSwap(stream, major_version);
     SafeReadSwap(stream, minor_version);
 
-    if (major_version != VersionMajor && minor_version != VersionMinor)
+    if (major_version != 1 && major_version != VersionMajor)
         panic("Could not open %s: invalid version %d.%d != %d.%d",
               file, major_version, minor_version, VersionMajor, VersionMinor);
 
-    uint64_t sector_count;
-    SafeReadSwap(stream, sector_count);
-    table = new SectorTable(sector_count);
-
-
-    for (uint64_t i = 0; i < sector_count; i++) {
-        uint64_t offset;
-        SafeReadSwap(stream, offset);
-
-        Sector *sector = new Sector;
-        SafeRead(stream, sector, sizeof(Sector));
+    table.clear();
+    chunks.clear();
+    slots = 0;
+
+    if (major_version == 1) {
+        // Version 1 images store individual sectors
+        uint64_t sector_count;
+        SafeReadSwap(stream, sector_count);
+
+        uint8_t data[SectorSize];
+        for (uint64_t i = 0; i < sector_count; i++) {
+            uint64_t offset;
+            SafeReadSwap(stream, offset);
+            SafeRead(stream, data, sizeof(data));
+            writeSector(offset, data);
+        }
+    } else {
+        uint32_t block_size, flags;
+        uint64_t block_count;
+        SafeReadSwap(stream, block_size);
+        SafeReadSwap(stream, flags);
+        SafeReadSwap(stream, block_count);
+
+        if (block_size % SectorSize != 0 || block_size == 0 ||
+            block_size / SectorSize > 64) {
+            panic("Could not open %s: invalid block size %d",
+                  file, block_size);
+        }
+        const unsigned sectors_per_block = block_size / SectorSize;
+
+        std::vector<uint64_t> blocks(block_count), masks(block_count);
+        std::vector<uint8_t> data(block_size);
+        for (uint64_t i = 0; i < block_count; i++) {
+            SafeReadSwap(stream, blocks[i]);
+            SafeReadSwap(stream, masks[i]);
+            if (flags & F_EXTERNAL)
+                continue;
+
+            // The data of the valid sectors follows the index entry
+            SafeRead(stream, data.data(), block_size);
+            for (unsigned idx = 0; idx < sectors_per_block; ++idx) {
+                if (masks[i] & (1ULL << idx)) {
+                    writeSector(blocks[i] * sectors_per_block + idx,
+                                data.data() + idx * SectorSize);
+                }
+            }
+        }
 
-        assert(table->find(offset) == table->end());
-        (*table)[offset] = sector;
+        if (flags & F_EXTERNAL)
+            loadExternal(file + ".data", blocks, masks, block_size);
     }
 
     stream.close();
@@ -281,10 +736,52 @@ CowDiskImage::open(const std::string &file)
     return true;
 }
 
+void
+CowDiskImage::loadExternal(const std::string &file,
+                           const std::vector<uint64_t> &blocks,
+                           const std::vector<uint64_t> &masks,
+                           unsigned block_size)
+{
+    const int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+        panic("Error opening COW data %s: %s", file, strerror(errno));
+
+    const unsigned sectors_per_block = block_size / SectorSize;
+    if (overlayFd >= 0) {
+        // The data files have the same layout as the disk, so the data
+        // can be copied (or cloned) as a whole
+        copyOverlay(fd, overlayFd, blocks, block_size);
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            for (unsigned idx = 0; idx < sectors_per_block; ++idx) {
+                if (masks[i] & (1ULL << idx))
+                    markSector(blocks[i] * sectors_per_block + idx);
+            }
+        }
+    } else {
+        uint8_t data[SectorSize];
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            for (unsigned idx = 0; idx < sectors_per_block; ++idx) {
+                if (!(masks[i] & (1ULL << idx)))
+                    continue;
+
+                const uint64_t sector = blocks[i] * sectors_per_block + idx;
+                if (pread(fd, data, SectorSize, sector * SectorSize) !=
+                        SectorSize) {
+                    panic("Error reading COW data %s: %s", file,
+                          strerror(errno));
+                }
+                writeSector(sector, data);
+            }
+        }
+    }
+
+    ::close(fd);
+}
+
 void
 CowDiskImage::initSectorTable(int hash_size)
 {
-    table = new SectorTable(hash_size);
+    table.rehash(hash_size / sectorsPerBlock);
 
     initialized = true;
 }
@@ -329,6 +826,12 @@ CowDiskImage::save() const
 
 void
 CowDiskImage::save(const std::string &file) const
+{
+    save(file, false);
+}
+
+void
+CowDiskImage::save(const std::string &file, bool external) const
 {
     if (!initialized)
         panic("RawDiskImage not initialized");
@@ -343,33 +846,58 @@ CowDiskImage::save(const std::string &file) const
 
     SafeWriteSwap(stream, (uint32_t)VersionMajor);
     SafeWriteSwap(stream, (uint32_t)VersionMinor);
-    SafeWriteSwap(stream, (uint64_t)table->size());
-
-    uint64_t size = table->size();
-    SectorTable::iterator iter = table->begin();
-    SectorTable::iterator end = table->end();
-
-    for (uint64_t i = 0; i < size; i++) {
-        if (iter == end)
-            panic("Incorrect Table Size during save of COW disk image");
-
-        SafeWriteSwap(stream, (uint64_t)(*iter).first);
-        SafeWrite(stream, (*iter).second->data, sizeof(Sector));
-        ++iter;
+    SafeWriteSwap(stream, (uint32_t)blockSize);
+    SafeWriteSwap(stream, (uint32_t)(external ? F_EXTERNAL : 0));
+    SafeWriteSwap(stream, (uint64_t)table.size());
+
+    // Save the blocks in order to make the file reproducible
+    const std::vector<uint64_t> blocks(overlayBlocks());
+    std::vector<uint8_t> data(blockSize);
+    for (uint64_t block_num : blocks) {
+        const Block &block = table.at(block_num);
+        SafeWriteSwap(stream, block_num);
+        SafeWriteSwap(stream, block.valid);
+        if (external)
+            continue;
+
+        for (unsigned idx = 0; idx < sectorsPerBlock; ++idx) {
+            if (block.valid & (1ULL << idx)) {
+                readSector(block, block_num * sectorsPerBlock + idx,
+                           data.data() + idx * SectorSize);
+            }
+        }
+        SafeWrite(stream, data.data(), blockSize);
     }
 
     stream.close();
+
+    if (external) {
+        const std::string data_file = file + ".data";
+        const int fd = ::open(data_file.c_str(),
+                              O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            panic("Error opening COW data %s: %s", data_file,
+                  strerror(errno));
+        }
+        copyOverlay(overlayFd, fd, blocks, blockSize);
+        ::close(fd);
+    }
 }
 
 void
 CowDiskImage::writeback()
 {
-    SectorTable::iterator i = table->begin();
-    SectorTable::iterator end = table->end();
-
-    while (i != end) {
-        child->write((*i).second->data, (*i).first);
-        ++i;
+    uint8_t data[SectorSize];
+    for (uint64_t block_num : overlayBlocks()) {
+        const Block &block = table.at(block_num);
+        for (unsigned idx = 0; idx < sectorsPerBlock; ++idx) {
+            if (!(block.valid & (1ULL << idx)))
+                continue;
+
+            const uint64_t sector = block_num * sectorsPerBlock + idx;
+            readSector(block, sector, data);
+            child->write(data, sector);
+        }
     }
 }
 
@@ -386,11 +914,11 @@ CowDiskImage::read(uint8_t *data, std::streampos offset) const
     if (offset > size())
         panic("access out of bounds");
 
-    SectorTable::const_iterator i = table->find(offset);
-    if (i == table->end())
+    const Block *block = findSector(offset);
+    if (!block)
         return child->read(data, offset);
     else {
-        memcpy(data, (*i).second->data, SectorSize);
+        readSector(*block, offset, data);
         DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
         DDUMP(DiskImageRead, data, SectorSize);
         return SectorSize;
@@ -406,14 +934,7 @@ CowDiskImage::write(const uint8_t *data, std::streampos offset)
     if (offset > size())
         panic("access out of bounds");
 
-    SectorTable::iterator i = table->find(offset);
-    if (i == table->end()) {
-        Sector *sector = new Sector;
-        memcpy(sector, data, SectorSize);
-        table->insert(make_pair(offset, sector));
-    } else {
-        memcpy((*i).second->data, data, SectorSize);
-    }
+    writeSector(offset, data);
 
     DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
     DDUMP(DiskImageWrite, data, SectorSize);
@@ -421,12 +942,53 @@ CowDiskImage::write(const uint8_t *data, std::streampos offset)
     return SectorSize;
 }
 
+void
+CowDiskImage::readAsync(uint8_t *data, std::streampos offset, unsigned count)
+{
+    if (!initialized)
+        panic("CowDiskImage not initialized");
+
+    if (offset + (std::streamoff)count > size())
+        panic("access out of bounds");
+
+    // Copy the sectors of this layer and forward every run of missing
+    // sectors to the child
+    const uint64_t first = offset;
+    unsigned run = 0;
+    for (unsigned i = 0; i <= count; ++i) {
+        if (i < count) {
+            const Block *block = findSector(first + i);
+            if (!block) {
+                ++run;
+                continue;
+            }
+            readSector(*block, first + i, data + i * SectorSize);
+        }
+
+        if (run) {
+            const unsigned start = i - run;
+            child->readAsync(data + start * SectorSize, first + start, run);
+            run = 0;
+        }
+    }
+}
+
+bool
+CowDiskImage::waitAsync()
+{
+    const bool child_ok = child->waitAsync();
+    const bool ok = DiskImage::waitAsync();
+    return child_ok && ok;
+}
+
 void
 CowDiskImage::serialize(CheckpointOut &cp) const
 {
+    // With a host overlay file, the checkpoint gets a (cloned if
+    // possible) copy of the overlay instead of a dump of the sectors
     std::string cowFilename = name() + ".cow";
     SERIALIZE_SCALAR(cowFilename);
-    save(CheckpointIn::dir() + "/" + cowFilename);
+    save(CheckpointIn::dir() + "/" + cowFilename, overlayFd >= 0);
 }
 
 void
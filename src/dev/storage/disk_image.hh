@@ -33,8 +33,15 @@
 #ifndef __DEV_STORAGE_DISK_IMAGE_HH__
 #define __DEV_STORAGE_DISK_IMAGE_HH__
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "params/CowDiskImage.hh"
 #include "params/DiskImage.hh"
@@ -53,10 +60,14 @@ class DiskImage : public SimObject
 {
   protected:
     bool initialized;
+    /** An asynchronous request failed since the last waitAsync() */
+    bool asyncFailed;
 
   public:
     typedef DiskImageParams Params;
-    DiskImage(const Params &p) : SimObject(p), initialized(false) {}
+    DiskImage(const Params &p)
+        : SimObject(p), initialized(false), asyncFailed(false)
+    {}
     virtual ~DiskImage() {}
 
     virtual std::streampos size() const = 0;
@@ -65,25 +76,145 @@ class DiskImage : public SimObject
                                 std::streampos offset) const = 0;
     virtual std::streampos write(const uint8_t *data,
                                  std::streampos offset) = 0;
+
+    /**
+     * Start reading a range of sectors.
+     *
+     * The host I/O may complete in the background, the buffer must not
+     * be accessed before waitAsync() returns. Device models typically
+     * start the read when a command is issued and wait for it when the
+     * modeled access latency has elapsed. The default implementation
+     * reads the sectors synchronously.
+     *
+     * @param data Buffer for count sectors.
+     * @param offset First sector to read.
+     * @param count Number of sectors to read.
+     */
+    virtual void readAsync(uint8_t *data, std::streampos offset,
+                           unsigned count);
+
+    /**
+     * Start writing a range of sectors.
+     *
+     * The data is copied before this method returns, so the buffer can
+     * be reused right away. Reads issued later always return the
+     * written data. The default implementation writes the sectors
+     * synchronously.
+     *
+     * @param data Data of count sectors.
+     * @param offset First sector to write.
+     * @param count Number of sectors to write.
+     */
+    virtual void writeAsync(const uint8_t *data, std::streampos offset,
+                            unsigned count);
+
+    /**
+     * Wait for all the outstanding asynchronous requests to complete.
+     *
+     * @return False if any asynchronous request failed since the
+     * previous call.
+     */
+    virtual bool waitAsync();
 };
 
 /**
  * Specialization for accessing a raw disk image
+ *
+ * Asynchronous requests are handed to a helper thread that performs
+ * the host I/O in order, so a slow host file system (e.g., network
+ * storage) only stalls the simulation if a device model waits for
+ * the data before the host is done. Recently accessed sectors are
+ * kept in a small LRU cache.
  */
 class RawDiskImage : public DiskImage
 {
   protected:
-    mutable std::fstream stream;
+    int fd;
     std::string file;
     bool readonly;
     mutable std::streampos disk_size;
 
+    /** Host I/O request handled by the helper thread */
+    struct IoRequest
+    {
+        bool write;
+        /** Destination of a read */
+        uint8_t *data;
+        /** Copy of the data of a write */
+        std::vector<uint8_t> buffer;
+        /** Offset into the image in bytes */
+        off_t offset;
+        size_t size;
+    };
+
+    /** Completed read that still has to be added to the cache */
+    struct CacheFill
+    {
+        uint64_t sector;
+        unsigned count;
+        const uint8_t *data;
+    };
+
+    struct CachedSector
+    {
+        uint64_t sector;
+        uint8_t data[SectorSize];
+    };
+    typedef std::list<CachedSector> CacheList;
+
+    /** Hand asynchronous requests to the helper thread */
+    const bool asyncIO;
+
+    /** @{
+     * @name Helper thread state, protected by ioMutex
+     */
+    std::thread worker;
+    mutable std::mutex ioMutex;
+    /** Signals new requests to the helper thread */
+    std::condition_variable ioCond;
+    /** Signals the completion of all the requests */
+    mutable std::condition_variable doneCond;
+    std::deque<IoRequest> ioQueue;
+    /** Number of requests queued or in progress */
+    unsigned ioPending;
+    bool ioStop;
+    bool ioError;
+    /** @} */
+
+    /** Reads to be added to the cache once they are complete */
+    std::vector<CacheFill> cacheFills;
+
+    /** Maximum number of sectors in the cache */
+    const size_t cacheSectors;
+    /** Cached sectors, most recently used first */
+    mutable CacheList cacheLru;
+    mutable std::unordered_map<uint64_t, CacheList::iterator> cacheMap;
+
+    /** Blocking host I/O, returns the number of bytes transferred */
+    size_t hostIO(bool write, uint8_t *data, size_t size,
+                  off_t offset) const;
+
+    /** Queue a request (or perform it right away without a worker) */
+    void submit(IoRequest &&req);
+    /** Main loop of the helper thread */
+    void workerMain();
+    /** Complete all the requests and terminate the helper thread */
+    void stopWorker();
+    /** Wait until all the queued requests have been performed */
+    void waitIdle() const;
+
+    bool cacheLookup(uint64_t sector, uint8_t *data) const;
+    void cacheUpdate(uint64_t sector, const uint8_t *data) const;
+    /** Forget about pending cache fills of overwritten sectors */
+    void dropCacheFills(uint64_t sector, unsigned count);
+
   public:
     typedef RawDiskImageParams Params;
     RawDiskImage(const Params &p);
     ~RawDiskImage();
 
     void notifyFork() override;
+    DrainState drain() override;
 
     void close();
     void open(const std::string &filename, bool rd_only = false);
@@ -92,6 +223,12 @@ class RawDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    void readAsync(uint8_t *data, std::streampos offset,
+                   unsigned count) override;
+    void writeAsync(const uint8_t *data, std::streampos offset,
+                    unsigned count) override;
+    bool waitAsync() override;
 };
 
 /**
@@ -103,6 +240,13 @@ class RawDiskImage : public DiskImage
  * This object is designed to provide a mechanism for persistant
  * changes to a main disk image, or to provide a place for temporary
  * changes to the image to take place that later may be thrown away.
+ *
+ * The layer tracks written data in blocks of several sectors. The
+ * index only holds a bitmap of the valid sectors of every written
+ * block, the data either lives in memory or in a sparse host file
+ * (overlay_file) that has the same layout as the disk. With a host
+ * file, checkpoints only contain the index and a copy of the overlay
+ * file, which is a constant time clone on copy-on-write file systems.
  */
 class CowDiskImage : public DiskImage
 {
@@ -111,16 +255,58 @@ class CowDiskImage : public DiskImage
     static const uint32_t VersionMinor;
 
   protected:
-    struct Sector
+    /** The block data is in a separate file (COW file flag) */
+    static const uint32_t F_EXTERNAL = 0x1;
+
+    /** Size of the chunks the in-memory block data is allocated in */
+    static const unsigned ChunkSize = 1024 * 1024;
+
+    struct Block
     {
-        uint8_t data[SectorSize];
+        /** Bitmap of the sectors present in this layer */
+        uint64_t valid;
+        /** Index of the data in the in-memory storage */
+        uint32_t slot;
     };
-    typedef std::unordered_map<uint64_t, Sector *> SectorTable;
+    typedef std::unordered_map<uint64_t, Block> BlockTable;
 
   protected:
     std::string filename;
     DiskImage *child;
-    SectorTable *table;
+    /** Size of a block in bytes */
+    const unsigned blockSize;
+    const unsigned sectorsPerBlock;
+    BlockTable table;
+
+    /** In-memory block data */
+    std::vector<std::unique_ptr<uint8_t[]>> chunks;
+    /** Number of allocated in-memory blocks */
+    uint32_t slots;
+
+    /** Host file holding the block data, -1 to keep it in memory */
+    int overlayFd;
+    std::string overlayFile;
+
+    /** Switch to a new host overlay file, copying the current data */
+    void openOverlay(const std::string &file);
+    /** Numbers of all the blocks with data, in ascending order */
+    std::vector<uint64_t> overlayBlocks() const;
+
+    /** Find the block of a sector, nullptr if not in this layer */
+    const Block *findSector(uint64_t sector) const;
+    uint8_t *slotData(uint32_t slot) const;
+    void readSector(const Block &block, uint64_t sector,
+                    uint8_t *data) const;
+    /** Mark a sector as present, allocating its block if needed */
+    Block &markSector(uint64_t sector);
+    void writeSector(uint64_t sector, const uint8_t *data);
+
+    /** Load the block data saved in a separate file */
+    void loadExternal(const std::string &file,
+                      const std::vector<uint64_t> &blocks,
+                      const std::vector<uint64_t> &masks,
+                      unsigned block_size);
+    void save(const std::string &file, bool external) const;
 
   public:
     typedef CowDiskImageParams Params;
@@ -142,6 +328,10 @@ class CowDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    void readAsync(uint8_t *data, std::streampos offset,
+                   unsigned count) override;
+    bool waitAsync() override;
 };
 
 void SafeRead(std::ifstream &stream, void *data, int count);
@@ -53,6 +53,7 @@
 #include "base/chunk_generator.hh"
 #include "base/compiler.hh"
 #include "base/cprintf.hh" // csprintf
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/IdeDisk.hh"
 #include "dev/storage/disk_image.hh"
@@ -449,15 +450,12 @@ IdeDisk::doDmaRead()
 void
 IdeDisk::dmaReadDone()
 {
-    uint32_t bytesWritten = 0;
-
-    // write the data to the disk image
-    for (bytesWritten = 0; bytesWritten < curPrd.getByteCount();
-         bytesWritten += SectorSize) {
-
-        cmdBytesLeft -= SectorSize;
-        writeDisk(curSector++, (uint8_t *)(dataBuffer + bytesWritten));
-    }
+    // write the data to the disk image, the image takes a copy of the
+    // data so the buffer can be reused right away
+    const uint32_t sectors = divCeil(curPrd.getByteCount(), SectorSize);
+    image->writeAsync(dataBuffer, curSector, sectors);
+    curSector += sectors;
+    cmdBytesLeft -= sectors * SectorSize;
 
     // check for the EOT
     if (curPrd.getEOT()) {
@@ -481,11 +479,13 @@ IdeDisk::doDmaDataWrite()
 
     memset(dataBuffer, 0, MAX_DMA_SIZE);
     assert(cmdBytesLeft <= MAX_DMA_SIZE);
-    while (bytesRead < curPrd.getByteCount()) {
-        readDisk(curSector++, (uint8_t *)(dataBuffer + bytesRead));
-        bytesRead += SectorSize;
-        cmdBytesLeft -= SectorSize;
-    }
+    // The data is only needed once the disk delay has elapsed, so let
+    // the host I/O proceed in the background until doDmaWrite().
+    const uint32_t sectors = divCeil(curPrd.getByteCount(), SectorSize);
+    image->readAsync(dataBuffer, curSector, sectors);
+    curSector += sectors;
+    bytesRead = sectors * SectorSize;
+    cmdBytesLeft -= bytesRead;
     DPRINTF(IdeDisk, "doDmaWrite, bytesRead: %d cmdBytesLeft: %d\n",
             bytesRead, cmdBytesLeft);
 
@@ -495,6 +495,8 @@ IdeDisk::doDmaDataWrite()
 void
 IdeDisk::doDmaWrite()
 {
+    waitDisk();
+
     if (dmaAborted) {
         DPRINTF(IdeDisk, "DMA Aborted while doing DMA Write\n");
         if (dmaWriteCG)
@@ -563,6 +565,13 @@ IdeDisk::readDisk(uint32_t sector, uint8_t *data)
             name(), bytesRead, SectorSize, errno);
 }
 
+void
+IdeDisk::waitDisk()
+{
+    panic_if(!image->waitAsync(), "Host I/O on the image of %s failed.",
+             name());
+}
+
 void
 IdeDisk::writeDisk(uint32_t sector, uint8_t *data)
 {
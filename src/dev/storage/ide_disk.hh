@@ -349,6 +349,8 @@ class IdeDisk : public SimObject
     // Disk image read/write
     void readDisk(uint32_t sector, uint8_t *data);
     void writeDisk(uint32_t sector, uint8_t *data);
+    /** Wait for the outstanding asynchronous disk image requests */
+    void waitDisk();
 
     // State machine management
     void updateState(DevAction_t action);
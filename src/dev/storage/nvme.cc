@@ -0,0 +1,1367 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * NVM Express controller model.
+ */
+
+#include "dev/storage/nvme.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "base/trace.hh"
+#include "debug/Drain.hh"
+#include "debug/NVMe.hh"
+#include "dev/storage/disk_image.hh"
+#include "mem/packet_access.hh"
+#include "params/NVMeController.hh"
+#include "sim/cur_tick.hh"
+#include "sim/serialize.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** NVMe version 1.2.0 */
+const uint32_t NVMeVersion = 0x00010200;
+
+/** Admin command set */
+enum AdminOpcode : uint8_t
+{
+    ADMIN_DELETE_SQ = 0x00,
+    ADMIN_CREATE_SQ = 0x01,
+    ADMIN_GET_LOG_PAGE = 0x02,
+    ADMIN_DELETE_CQ = 0x04,
+    ADMIN_CREATE_CQ = 0x05,
+    ADMIN_IDENTIFY = 0x06,
+    ADMIN_ABORT = 0x08,
+    ADMIN_SET_FEATURES = 0x09,
+    ADMIN_GET_FEATURES = 0x0a,
+    ADMIN_ASYNC_EVENT = 0x0c,
+};
+
+/** NVM command set */
+enum IoOpcode : uint8_t
+{
+    IO_FLUSH = 0x00,
+    IO_WRITE = 0x01,
+    IO_READ = 0x02,
+};
+
+enum Feature : uint8_t
+{
+    FEAT_NUM_QUEUES = 0x07,
+    FEAT_INT_COALESCING = 0x08,
+    FEAT_INT_VECTOR_CONFIG = 0x09,
+};
+
+/** Size of the Identify data structures */
+const uint32_t IdentifySize = 4096;
+
+void
+setString(uint8_t *dst, const char *src, size_t len)
+{
+    // Identify strings are padded with spaces, not null terminated
+    memset(dst, ' ', len);
+    memcpy(dst, src, std::min(len, strlen(src)));
+}
+
+} // anonymous namespace
+
+NVMeController::CompQueue::CompQueue(NVMeController &ctrl, uint16_t id)
+    : flushEvent([&ctrl, id]{ ctrl.flushCompletions(id); },
+                 ctrl.name() + ".cqFlush")
+{
+}
+
+NVMeController::Vector::Vector(NVMeController &ctrl, uint16_t id)
+    : timer([&ctrl, id]{ ctrl.postInterrupt(id); },
+            ctrl.name() + ".coalesce")
+{
+}
+
+NVMeController::NVMeController(const Params &p)
+    : PciDevice(p), image(p.image),
+      regCap(uint64_t(std::min<uint32_t>(p.max_queue_entries, 0x10000) - 1) |
+             // Contiguous queues required, 7.5s timeout, NVM command set
+             (1ULL << 16) | (15ULL << 24) | (1ULL << 37)),
+      regIntMask(0), regCc(0), regCsts(0), regAqa(0), regAsq(0), regAcq(0),
+      numIoQueues(p.max_queues), coalesceThreshold(0), coalesceTime(0),
+      aerCount(0), intxAsserted(false), generation(0), inFlight(0),
+      pendingDma(0), maxOutstanding(p.max_outstanding), fetchNext(0),
+      maxTransfer(p.max_transfer), readLatency(p.read_latency),
+      writeLatency(p.write_latency), bandwidth(p.bandwidth), mediaFree(0),
+      stats(this)
+{
+    fatal_if(p.max_queues == 0, "%s: At least one I/O queue is needed.",
+             name());
+    fatal_if(p.max_queue_entries < 2,
+             "%s: Queues need at least two entries.", name());
+    fatal_if(maxOutstanding == 0, "%s: max_outstanding must be non-zero.",
+             name());
+    fatal_if(!isPowerOf2(maxTransfer) || maxTransfer < 4096,
+             "%s: max_transfer must be a power of two of at least 4KiB.",
+             name());
+
+    subQueues.resize(p.max_queues + 1);
+    for (uint16_t i = 0; i <= p.max_queues; ++i)
+        compQueues.emplace_back(new CompQueue(*this, i));
+
+    // Without MSI-X all the completion queues share the INTx vector
+    const uint16_t num_vectors = std::max<size_t>(msix_table.size(), 1);
+    for (uint16_t i = 0; i < num_vectors; ++i)
+        vectors.emplace_back(new Vector(*this, i));
+}
+
+NVMeController::~NVMeController()
+{
+}
+
+Tick
+NVMeController::read(PacketPtr pkt)
+{
+    int bar;
+    Addr daddr;
+
+    if (!getBAR(pkt->getAddr(), bar, daddr))
+        panic("Invalid PCI memory access to unmapped memory.\n");
+
+    // Registers, doorbells and MSI-X structures are all in BAR 0
+    assert(bar == 0);
+
+    const unsigned size = pkt->getSize();
+    uint64_t value = 0;
+    if (daddr >= MSIX_TABLE_OFFSET && daddr + size <= MSIX_TABLE_END) {
+        memcpy(&value, (uint8_t *)msix_table.data() +
+               (daddr - MSIX_TABLE_OFFSET), size);
+    } else if (daddr >= MSIX_PBA_OFFSET && daddr + size <= MSIX_PBA_END) {
+        memcpy(&value, (uint8_t *)msix_pba.data() +
+               (daddr - MSIX_PBA_OFFSET), size);
+    } else {
+        value = readRegister(daddr, size);
+    }
+
+    DPRINTF(NVMe, "Read %#x (%d bytes): %#x\n", daddr, size, value);
+
+    pkt->setUintX(value, ByteOrder::little);
+    pkt->makeAtomicResponse();
+    return pioDelay;
+}
+
+Tick
+NVMeController::write(PacketPtr pkt)
+{
+    int bar;
+    Addr daddr;
+
+    if (!getBAR(pkt->getAddr(), bar, daddr))
+        panic("Invalid PCI memory access to unmapped memory.\n");
+
+    assert(bar == 0);
+
+    const unsigned size = pkt->getSize();
+    const uint64_t value = pkt->getUintX(ByteOrder::little);
+
+    DPRINTF(NVMe, "Write %#x (%d bytes): %#x\n", daddr, size, value);
+
+    if (daddr >= MSIX_TABLE_OFFSET && daddr + size <= MSIX_TABLE_END) {
+        memcpy((uint8_t *)msix_table.data() + (daddr - MSIX_TABLE_OFFSET),
+               &value, size);
+        // Unmasking a vector sends its pending message
+        updateMsix();
+    } else if (daddr >= MSIX_PBA_OFFSET && daddr + size <= MSIX_PBA_END) {
+        // The PBA is read-only
+    } else {
+        writeRegister(daddr, size, value);
+    }
+
+    pkt->makeAtomicResponse();
+    return pioDelay;
+}
+
+Tick
+NVMeController::readConfig(PacketPtr pkt)
+{
+    int offset = pkt->getAddr() & PCI_CONFIG_SIZE;
+
+    if (offset < PCI_DEVICE_SPECIFIC)
+        return PciDevice::readConfig(pkt);
+
+    const unsigned size = pkt->getSize();
+    uint32_t value = 0;
+    if (MSIXCAP_BASE != 0 && offset >= MSIXCAP_BASE &&
+        offset + size <= MSIXCAP_BASE + sizeof(MSIXCAP)) {
+        memcpy(&value, &msixcap.data[offset - MSIXCAP_BASE], size);
+    }
+
+    DPRINTF(NVMe, "Read config %#x (%d bytes): %#x\n", offset, size, value);
+
+    pkt->setUintX(value, ByteOrder::little);
+    pkt->makeAtomicResponse();
+    return configDelay;
+}
+
+Tick
+NVMeController::writeConfig(PacketPtr pkt)
+{
+    int offset = pkt->getAddr() & PCI_CONFIG_SIZE;
+
+    if (offset < PCI_DEVICE_SPECIFIC) {
+        Tick delay = PciDevice::writeConfig(pkt);
+        // The command register can disable INTx
+        updateIntx();
+        return delay;
+    }
+
+    const unsigned size = pkt->getSize();
+    const uint32_t value = pkt->getUintX(ByteOrder::little);
+
+    DPRINTF(NVMe, "Write config %#x (%d bytes): %#x\n", offset, size, value);
+
+    if (MSIXCAP_BASE != 0 && offset >= MSIXCAP_BASE &&
+        offset + size <= MSIXCAP_BASE + sizeof(MSIXCAP)) {
+        MSIXCAP cap = msixcap;
+        memcpy(&cap.data[offset - MSIXCAP_BASE], &value, size);
+        // Only the enable and function mask bits are writable
+        msixcap.mxc = (msixcap.mxc & 0x3fff) | (cap.mxc & 0xc000);
+        updateMsix();
+        updateIntx();
+    }
+
+    pkt->makeAtomicResponse();
+    return configDelay;
+}
+
+uint64_t
+NVMeController::readRegister(Addr offset, unsigned size)
+{
+    switch (offset) {
+      case REG_CAP:
+        return size == 8 ? regCap : bits(regCap, 31, 0);
+      case REG_CAP + 4:
+        return bits(regCap, 63, 32);
+      case REG_VS:
+        return NVMeVersion;
+      case REG_INTMS:
+      case REG_INTMC:
+        return regIntMask;
+      case REG_CC:
+        return regCc;
+      case REG_CSTS:
+        return regCsts;
+      case REG_AQA:
+        return regAqa;
+      case REG_ASQ:
+        return size == 8 ? regAsq : bits(regAsq, 31, 0);
+      case REG_ASQ + 4:
+        return bits(regAsq, 63, 32);
+      case REG_ACQ:
+        return size == 8 ? regAcq : bits(regAcq, 31, 0);
+      case REG_ACQ + 4:
+        return bits(regAcq, 63, 32);
+      default:
+        // NSSR, reserved registers and the write-only doorbells
+        return 0;
+    }
+}
+
+void
+NVMeController::writeRegister(Addr offset, unsigned size, uint64_t value)
+{
+    if (offset >= REG_DOORBELL) {
+        const Addr index = (offset - REG_DOORBELL) / 4;
+        writeDoorbell(index / 2, index % 2, value);
+        return;
+    }
+
+    switch (offset) {
+      case REG_INTMS:
+        regIntMask |= value;
+        updateIntx();
+        break;
+      case REG_INTMC:
+        regIntMask &= ~value;
+        updateIntx();
+        break;
+      case REG_CC: {
+        const uint32_t old = regCc;
+        regCc = value;
+        if (!(old & 0x1) && (value & 0x1))
+            enable();
+        else if ((old & 0x1) && !(value & 0x1))
+            reset();
+        // Shutdown notification, there is nothing to flush
+        if (bits(regCc, 15, 14))
+            replaceBits(regCsts, 3, 2, 0x2);
+        else
+            replaceBits(regCsts, 3, 2, 0x0);
+        break;
+      }
+      case REG_AQA:
+        regAqa = value;
+        break;
+      case REG_ASQ:
+        if (size == 8)
+            regAsq = value;
+        else
+            replaceBits(regAsq, 31, 0, value);
+        break;
+      case REG_ASQ + 4:
+        replaceBits(regAsq, 63, 32, value);
+        break;
+      case REG_ACQ:
+        if (size == 8)
+            regAcq = value;
+        else
+            replaceBits(regAcq, 31, 0, value);
+        break;
+      case REG_ACQ + 4:
+        replaceBits(regAcq, 63, 32, value);
+        break;
+      default:
+        warn_once("%s: Write to unimplemented register %#x.\n",
+                  name(), offset);
+        break;
+    }
+}
+
+void
+NVMeController::writeDoorbell(uint16_t qid, bool cq, uint32_t value)
+{
+    if (qid >= subQueues.size()) {
+        warn("%s: Doorbell write to invalid queue %d.\n", name(), qid);
+        return;
+    }
+
+    if (cq) {
+        CompQueue &q = *compQueues[qid];
+        if (!q.valid || value >= q.size) {
+            warn("%s: Invalid CQ %d head doorbell %d.\n", name(), qid, value);
+            return;
+        }
+        q.head = value;
+        // The driver freed queue slots
+        pushCompletions(q);
+        updateIntx();
+    } else {
+        SubQueue &q = subQueues[qid];
+        if (!q.valid || value >= q.size) {
+            warn("%s: Invalid SQ %d tail doorbell %d.\n", name(), qid, value);
+            return;
+        }
+        q.tail = value;
+        fetch();
+    }
+}
+
+void
+NVMeController::enable()
+{
+    DPRINTF(NVMe, "Enabling controller\n");
+
+    SubQueue &sq = subQueues[0];
+    sq.valid = true;
+    sq.base = regAsq & ~mask(12);
+    sq.size = bits(regAqa, 11, 0) + 1;
+    sq.head = sq.tail = 0;
+    sq.cqid = 0;
+    sq.fetching = false;
+
+    CompQueue &cq = *compQueues[0];
+    cq.valid = true;
+    cq.base = regAcq & ~mask(12);
+    cq.size = bits(regAqa, 27, 16) + 1;
+    cq.head = cq.tail = 0;
+    cq.phase = true;
+    cq.ien = true;
+    cq.vector = 0;
+
+    regCsts |= 0x1;
+}
+
+void
+NVMeController::reset()
+{
+    DPRINTF(NVMe, "Resetting controller\n");
+
+    // Commands in flight complete into the void
+    ++generation;
+
+    for (auto &sq : subQueues)
+        sq = SubQueue();
+    for (auto &cq : compQueues) {
+        cq->valid = false;
+        cq->pending.clear();
+        cq->batch.clear();
+        if (cq->flushEvent.scheduled())
+            deschedule(cq->flushEvent);
+    }
+    for (auto &vec : vectors) {
+        vec->coalesceDisable = false;
+        vec->pending = 0;
+        if (vec->timer.scheduled())
+            deschedule(vec->timer);
+    }
+
+    numIoQueues = subQueues.size() - 1;
+    coalesceThreshold = 0;
+    coalesceTime = 0;
+    aerCount = 0;
+    regIntMask = 0;
+    regCsts &= ~0x1;
+
+    updateIntx();
+    // Pending DMAs of fetches and completions are gone for good
+    opDone();
+}
+
+void
+NVMeController::fetch()
+{
+    if (!enabled() || drainState() == DrainState::Draining)
+        return;
+
+    // Round robin arbitration, one fetch per queue at a time
+    const uint16_t num_queues = subQueues.size();
+    for (uint16_t i = 0; i < num_queues && inFlight < maxOutstanding; ++i)
+        fetchQueue((fetchNext + i) % num_queues);
+    fetchNext = (fetchNext + 1) % num_queues;
+}
+
+void
+NVMeController::fetchQueue(uint16_t sqid)
+{
+    SubQueue &sq = subQueues[sqid];
+    if (!sq.valid || sq.fetching || sq.head == sq.tail)
+        return;
+
+    // Fetch all the new commands up to the end of the ring at once
+    const uint32_t avail =
+        sq.tail > sq.head ? sq.tail - sq.head : sq.size - sq.head;
+    const uint32_t count = std::min(avail, maxOutstanding - inFlight);
+    if (!count)
+        return;
+
+    DPRINTF(NVMe, "Fetching %d commands from SQ %d at %d\n",
+            count, sqid, sq.head);
+
+    sq.fetching = true;
+    inFlight += count;
+    ++pendingDma;
+    ++stats.fetches;
+
+    const uint64_t gen = generation;
+    auto *cb = new DmaDone([this, sqid, gen, count](uint8_t *data) {
+            commandsFetched(sqid, gen, count, data);
+        }, count * sizeof(Command));
+    dmaRead(pciToDma(sq.base + sq.head * sizeof(Command)),
+            count * sizeof(Command), cb->getChunkEvent(), cb->buffer.data());
+}
+
+void
+NVMeController::commandsFetched(uint16_t sqid, uint64_t gen, uint32_t count,
+                                const uint8_t *data)
+{
+    --pendingDma;
+
+    if (gen != generation) {
+        inFlight -= count;
+        opDone();
+        return;
+    }
+
+    SubQueue &sq = subQueues[sqid];
+    sq.fetching = false;
+    sq.head = (sq.head + count) % sq.size;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        auto req = std::make_shared<Request>();
+        memcpy(&req->cmd, data + i * sizeof(Command), sizeof(Command));
+        req->sqid = sqid;
+        req->generation = gen;
+        execute(req);
+    }
+
+    fetch();
+}
+
+void
+NVMeController::execute(const RequestPtr &req)
+{
+    DPRINTF(NVMe, "SQ %d: command %#x, cid %d\n",
+            req->sqid, req->cmd.opcode(), req->cmd.cid());
+
+    if (req->sqid == 0)
+        executeAdmin(req);
+    else
+        executeIO(req);
+}
+
+void
+NVMeController::executeAdmin(const RequestPtr &req)
+{
+    const Command &cmd = req->cmd;
+    uint32_t result = 0;
+    uint16_t status;
+
+    ++stats.adminCmds;
+
+    switch (cmd.opcode()) {
+      case ADMIN_DELETE_SQ:
+        status = deleteSubQueue(cmd);
+        break;
+      case ADMIN_CREATE_SQ:
+        status = createSubQueue(cmd);
+        break;
+      case ADMIN_DELETE_CQ:
+        status = deleteCompQueue(cmd);
+        break;
+      case ADMIN_CREATE_CQ:
+        status = createCompQueue(cmd);
+        break;
+      case ADMIN_GET_LOG_PAGE: {
+        // No log page has anything to report
+        const uint32_t dwords =
+            (bits(cmd.cdw10, 31, 16) | bits(cmd.cdw11, 15, 0) << 16) + 1;
+        req->data.assign(dwords * 4, 0);
+        sendData(req);
+        return;
+      }
+      case ADMIN_IDENTIFY:
+        identify(req);
+        return;
+      case ADMIN_ABORT:
+        // Commands are never aborted
+        status = SC_SUCCESS;
+        result = 1;
+        break;
+      case ADMIN_SET_FEATURES:
+        status = setFeatures(cmd, result);
+        break;
+      case ADMIN_GET_FEATURES:
+        status = getFeatures(cmd, result);
+        break;
+      case ADMIN_ASYNC_EVENT:
+        if (aerCount >= AerLimit) {
+            status = SC_AER_LIMIT;
+            break;
+        }
+        // There are no events to report, keep the request forever
+        ++aerCount;
+        --inFlight;
+        opDone();
+        return;
+      default:
+        warn("%s: Unsupported admin command %#x.\n", name(), cmd.opcode());
+        status = SC_INVALID_OPCODE;
+        break;
+    }
+
+    complete(req, status, result);
+}
+
+void
+NVMeController::identify(const RequestPtr &req)
+{
+    const Command &cmd = req->cmd;
+    req->data.assign(IdentifySize, 0);
+    uint8_t *data = req->data.data();
+
+    switch (bits(cmd.cdw10, 7, 0)) {
+      case 0x00: {
+        // Namespace
+        if (cmd.nsid != 1) {
+            complete(req, SC_INVALID_NAMESPACE);
+            return;
+        }
+        const uint64_t sectors = htole<uint64_t>(image->size());
+        memcpy(data + 0, &sectors, 8); // NSZE
+        memcpy(data + 8, &sectors, 8); // NCAP
+        memcpy(data + 16, &sectors, 8); // NUSE
+        // A single LBA format with 512 byte sectors
+        data[130] = floorLog2(SectorSize);
+        break;
+      }
+      case 0x01: {
+        // Controller
+        const uint16_t vid = htole(config.vendor);
+        memcpy(data + 0, &vid, 2);
+        memcpy(data + 2, &vid, 2);
+        setString(data + 4, "GEM5NVME0001", 20);
+        setString(data + 24, "gem5 NVMe controller", 40);
+        setString(data + 64, "1.0", 8);
+        data[72] = 6; // RAB
+        data[77] = floorLog2(maxTransfer / 4096); // MDTS
+        const uint32_t ver = htole(NVMeVersion);
+        memcpy(data + 80, &ver, 4);
+        data[258] = 3; // ACL
+        data[259] = AerLimit - 1; // AERL
+        data[512] = 0x66; // SQES
+        data[513] = 0x44; // CQES
+        const uint32_t nn = htole<uint32_t>(1);
+        memcpy(data + 516, &nn, 4);
+        break;
+      }
+      case 0x02: {
+        // Active namespace list
+        if (cmd.nsid < 1) {
+            const uint32_t nsid = htole<uint32_t>(1);
+            memcpy(data, &nsid, 4);
+        }
+        break;
+      }
+      default:
+        complete(req, SC_INVALID_FIELD);
+        return;
+    }
+
+    sendData(req);
+}
+
+uint16_t
+NVMeController::createSubQueue(const Command &cmd)
+{
+    const uint16_t qid = bits(cmd.cdw10, 15, 0);
+    const uint32_t size = bits(cmd.cdw10, 31, 16) + 1;
+    const uint16_t cqid = bits(cmd.cdw11, 31, 16);
+
+    if (qid == 0 || qid > numIoQueues || subQueues[qid].valid)
+        return SC_INVALID_QID;
+    if (size < 2 || size > bits(regCap, 15, 0) + 1)
+        return SC_INVALID_QSIZE;
+    if (cqid == 0 || cqid > numIoQueues || !compQueues[cqid]->valid)
+        return SC_INVALID_CQ;
+    if (!(cmd.cdw11 & 0x1))
+        return SC_INVALID_FIELD;
+
+    DPRINTF(NVMe, "Creating SQ %d: %d entries at %#x, CQ %d\n",
+            qid, size, cmd.prp1, cqid);
+
+    SubQueue &sq = subQueues[qid];
+    sq = SubQueue();
+    sq.valid = true;
+    sq.base = cmd.prp1;
+    sq.size = size;
+    sq.cqid = cqid;
+    return SC_SUCCESS;
+}
+
+uint16_t
+NVMeController::createCompQueue(const Command &cmd)
+{
+    const uint16_t qid = bits(cmd.cdw10, 15, 0);
+    const uint32_t size = bits(cmd.cdw10, 31, 16) + 1;
+    const uint16_t vector = bits(cmd.cdw11, 31, 16);
+
+    if (qid == 0 || qid > numIoQueues || compQueues[qid]->valid)
+        return SC_INVALID_QID;
+    if (size < 2 || size > bits(regCap, 15, 0) + 1)
+        return SC_INVALID_QSIZE;
+    if (vector >= vectors.size())
+        return SC_INVALID_VECTOR;
+    if (!(cmd.cdw11 & 0x1))
+        return SC_INVALID_FIELD;
+
+    DPRINTF(NVMe, "Creating CQ %d: %d entries at %#x, vector %d\n",
+            qid, size, cmd.prp1, vector);
+
+    CompQueue &cq = *compQueues[qid];
+    cq.valid = true;
+    cq.base = cmd.prp1;
+    cq.size = size;
+    cq.head = cq.tail = 0;
+    cq.phase = true;
+    cq.ien = cmd.cdw11 & 0x2;
+    cq.vector = vector;
+    return SC_SUCCESS;
+}
+
+uint16_t
+NVMeController::deleteSubQueue(const Command &cmd)
+{
+    const uint16_t qid = bits(cmd.cdw10, 15, 0);
+    if (qid == 0 || qid >= subQueues.size() || !subQueues[qid].valid)
+        return SC_INVALID_QID;
+
+    DPRINTF(NVMe, "Deleting SQ %d\n", qid);
+
+    // Commands of the queue still in flight are dropped on completion
+    subQueues[qid].valid = false;
+    return SC_SUCCESS;
+}
+
+uint16_t
+NVMeController::deleteCompQueue(const Command &cmd)
+{
+    const uint16_t qid = bits(cmd.cdw10, 15, 0);
+    if (qid == 0 || qid >= compQueues.size() || !compQueues[qid]->valid)
+        return SC_INVALID_QID;
+
+    for (const auto &sq : subQueues) {
+        if (sq.valid && sq.cqid == qid)
+            return SC_INVALID_DELETION;
+    }
+
+    DPRINTF(NVMe, "Deleting CQ %d\n", qid);
+
+    CompQueue &cq = *compQueues[qid];
+    cq.valid = false;
+    cq.pending.clear();
+    cq.batch.clear();
+    if (cq.flushEvent.scheduled())
+        deschedule(cq.flushEvent);
+    updateIntx();
+    return SC_SUCCESS;
+}
+
+uint16_t
+NVMeController::setFeatures(const Command &cmd, uint32_t &result)
+{
+    switch (bits(cmd.cdw10, 7, 0)) {
+      case FEAT_NUM_QUEUES: {
+        const uint32_t requested = std::max(bits(cmd.cdw11, 15, 0),
+                                            bits(cmd.cdw11, 31, 16)) + 1;
+        numIoQueues = std::min<uint32_t>(requested, subQueues.size() - 1);
+        result = (numIoQueues - 1) | (numIoQueues - 1) << 16;
+        return SC_SUCCESS;
+      }
+      case FEAT_INT_COALESCING:
+        coalesceThreshold = bits(cmd.cdw11, 7, 0);
+        coalesceTime = bits(cmd.cdw11, 15, 8);
+        return SC_SUCCESS;
+      case FEAT_INT_VECTOR_CONFIG: {
+        const uint16_t vector = bits(cmd.cdw11, 15, 0);
+        if (vector >= vectors.size())
+            return SC_INVALID_FIELD;
+        vectors[vector]->coalesceDisable = bits(cmd.cdw11, 16);
+        return SC_SUCCESS;
+      }
+      default:
+        return SC_INVALID_FIELD;
+    }
+}
+
+uint16_t
+NVMeController::getFeatures(const Command &cmd, uint32_t &result)
+{
+    switch (bits(cmd.cdw10, 7, 0)) {
+      case FEAT_NUM_QUEUES:
+        result = (numIoQueues - 1) | (numIoQueues - 1) << 16;
+        return SC_SUCCESS;
+      case FEAT_INT_COALESCING:
+        result = coalesceThreshold | coalesceTime << 8;
+        return SC_SUCCESS;
+      case FEAT_INT_VECTOR_CONFIG: {
+        const uint16_t vector = bits(cmd.cdw11, 15, 0);
+        if (vector >= vectors.size())
+            return SC_INVALID_FIELD;
+        result = vector | vectors[vector]->coalesceDisable << 16;
+        return SC_SUCCESS;
+      }
+      default:
+        return SC_INVALID_FIELD;
+    }
+}
+
+void
+NVMeController::executeIO(const RequestPtr &req)
+{
+    const Command &cmd = req->cmd;
+
+    if (cmd.opcode() == IO_FLUSH) {
+        // The model has no volatile write cache
+        if (cmd.nsid != 1 && cmd.nsid != 0xffffffff)
+            complete(req, SC_INVALID_NAMESPACE);
+        else
+            complete(req, SC_SUCCESS);
+        return;
+    }
+
+    if (cmd.opcode() != IO_READ && cmd.opcode() != IO_WRITE) {
+        warn("%s: Unsupported I/O command %#x.\n", name(), cmd.opcode());
+        complete(req, SC_INVALID_OPCODE);
+        return;
+    }
+
+    if (cmd.nsid != 1) {
+        complete(req, SC_INVALID_NAMESPACE);
+        return;
+    }
+
+    const uint64_t slba = cmd.cdw10 | uint64_t(cmd.cdw11) << 32;
+    const uint32_t nlb = bits(cmd.cdw12, 15, 0) + 1;
+    const uint32_t bytes = nlb * SectorSize;
+
+    if (bytes > maxTransfer) {
+        complete(req, SC_INVALID_FIELD);
+        return;
+    }
+    if (slba + nlb > (uint64_t)image->size()) {
+        complete(req, SC_LBA_OUT_OF_RANGE);
+        return;
+    }
+
+    if (cmd.opcode() == IO_READ) {
+        ++stats.readCmds;
+        stats.readBytes += bytes;
+
+        // Start the host I/O right away, it overlaps the media latency
+        req->data.resize(bytes);
+        image->readAsync(req->data.data(), slba, nlb);
+        const Tick ready = curTick() + mediaDelay(false, bytes);
+
+        mapPrps(req, bytes, [this, req, ready]() {
+            auto send = [this, req]() {
+                if (!image->waitAsync()) {
+                    complete(req, SC_DATA_TRANSFER_ERROR);
+                    return;
+                }
+                sendData(req);
+            };
+            schedule(new EventFunctionWrapper(send, name(), true),
+                     std::max(ready, curTick()));
+        });
+    } else {
+        ++stats.writeCmds;
+        stats.writeBytes += bytes;
+
+        mapPrps(req, bytes, [this, req, slba, nlb, bytes]() {
+            req->data.resize(bytes);
+            transfer(req, false, [this, req, slba, nlb, bytes]() {
+                if (req->generation != generation) {
+                    complete(req, SC_SUCCESS);
+                    return;
+                }
+                image->writeAsync(req->data.data(), slba, nlb);
+                auto done = [this, req]() {
+                    complete(req, image->waitAsync() ?
+                             SC_SUCCESS : SC_DATA_TRANSFER_ERROR);
+                };
+                schedule(new EventFunctionWrapper(done, name(), true),
+                         curTick() + mediaDelay(true, bytes));
+            });
+        });
+    }
+}
+
+void
+NVMeController::mapPrps(const RequestPtr &req, uint32_t bytes,
+                        std::function<void()> done)
+{
+    const Addr page = pageSize();
+    const Addr prp1 = req->cmd.prp1;
+    const uint32_t first = std::min<Addr>(bytes, page - (prp1 & (page - 1)));
+
+    req->segments.clear();
+    req->segments.emplace_back(prp1, first);
+
+    const uint32_t left = bytes - first;
+    if (left == 0) {
+        done();
+    } else if (left <= page) {
+        // PRP2 is the second data page
+        req->segments.emplace_back(req->cmd.prp2, left);
+        done();
+    } else {
+        // PRP2 points to a PRP list
+        readPrpList(req, req->cmd.prp2, left, std::move(done));
+    }
+}
+
+void
+NVMeController::readPrpList(const RequestPtr &req, Addr list, uint32_t bytes,
+                            std::function<void()> done)
+{
+    const Addr page = pageSize();
+    const uint32_t needed = divCeil(bytes, page);
+    const uint32_t fit = (page - (list & (page - 1))) / sizeof(uint64_t);
+    // The last entry of a full list page points to the next list page
+    const bool chained = needed > fit;
+    const uint32_t count = chained ? fit : needed;
+
+    auto *cb = new DmaDone(
+        [this, req, bytes, count, chained, done](uint8_t *data) {
+            const Addr page = pageSize();
+            const uint32_t entries = chained ? count - 1 : count;
+            uint32_t left = bytes;
+            for (uint32_t i = 0; i < entries; ++i) {
+                uint64_t prp;
+                memcpy(&prp, data + i * sizeof(prp), sizeof(prp));
+                const uint32_t len = std::min<Addr>(left, page);
+                req->segments.emplace_back(letoh(prp), len);
+                left -= len;
+            }
+
+            if (chained) {
+                uint64_t next;
+                memcpy(&next, data + entries * sizeof(next), sizeof(next));
+                readPrpList(req, letoh(next), left, done);
+            } else {
+                done();
+            }
+        }, count * sizeof(uint64_t));
+
+    dmaRead(pciToDma(list), count * sizeof(uint64_t), cb->getChunkEvent(),
+            cb->buffer.data());
+}
+
+void
+NVMeController::transfer(const RequestPtr &req, bool to_host,
+                         std::function<void()> done)
+{
+    if (req->generation != generation) {
+        // Do not touch memory that may have been reused by the host
+        done();
+        return;
+    }
+
+    auto *cb = new DmaDone([done](uint8_t *) { done(); });
+    std::vector<Event *> events;
+    for (size_t i = 0; i < req->segments.size(); ++i)
+        events.push_back(cb->getChunkEvent());
+
+    uint8_t *data = req->data.data();
+    for (size_t i = 0; i < req->segments.size(); ++i) {
+        const auto &[addr, len] = req->segments[i];
+        if (to_host)
+            dmaWrite(pciToDma(addr), len, events[i], data);
+        else
+            dmaRead(pciToDma(addr), len, events[i], data);
+        data += len;
+    }
+}
+
+void
+NVMeController::sendData(const RequestPtr &req, uint32_t result)
+{
+    mapPrps(req, req->data.size(), [this, req, result]() {
+        transfer(req, true, [this, req, result]() {
+            complete(req, SC_SUCCESS, result);
+        });
+    });
+}
+
+Tick
+NVMeController::mediaDelay(bool write, uint32_t bytes)
+{
+    // Accesses share the media bandwidth but overlap their latencies
+    const Tick start = std::max(curTick(), mediaFree);
+    mediaFree = start + Tick(bytes * bandwidth);
+    return mediaFree + (write ? writeLatency : readLatency) - curTick();
+}
+
+void
+NVMeController::complete(const RequestPtr &req, uint16_t status,
+                         uint32_t result)
+{
+    --inFlight;
+
+    if (req->generation == generation && subQueues[req->sqid].valid) {
+        const SubQueue &sq = subQueues[req->sqid];
+
+        DPRINTF(NVMe, "SQ %d: cid %d done, status %#x\n",
+                req->sqid, req->cmd.cid(), status);
+
+        Completion cpl = {};
+        cpl.result = htole(result);
+        cpl.sqhd = sq.head;
+        cpl.sqid = req->sqid;
+        cpl.cid = req->cmd.cid();
+        // Errors are not worth retrying in the model
+        cpl.status = status ? status << 1 | 0x8000 : 0;
+        postCompletion(sq.cqid, cpl);
+    }
+
+    fetch();
+    opDone();
+}
+
+void
+NVMeController::postCompletion(uint16_t cqid, const Completion &cpl)
+{
+    CompQueue &cq = *compQueues[cqid];
+    if (!cq.valid)
+        return;
+
+    cq.pending.push_back(cpl);
+    pushCompletions(cq);
+}
+
+void
+NVMeController::pushCompletions(CompQueue &cq)
+{
+    while (!cq.pending.empty() && !cq.full()) {
+        Completion cpl = cq.pending.front();
+        cq.pending.pop_front();
+
+        cpl.status |= cq.phase;
+        if (cq.batch.empty())
+            cq.batchStart = cq.tail;
+        cq.batch.push_back(cpl);
+
+        if (++cq.tail == cq.size) {
+            cq.tail = 0;
+            cq.phase = !cq.phase;
+        }
+
+        // Write all the completions of this tick together
+        if (!cq.flushEvent.scheduled())
+            schedule(cq.flushEvent, curTick());
+    }
+}
+
+void
+NVMeController::flushCompletions(uint16_t cqid)
+{
+    CompQueue &cq = *compQueues[cqid];
+    if (cq.batch.empty())
+        return;
+
+    const unsigned count = cq.batch.size();
+    // The batch may wrap around the end of the queue
+    const unsigned first = std::min(count, cq.size - cq.batchStart);
+
+    DPRINTF(NVMe, "CQ %d: writing %d completions at %d\n",
+            cqid, count, cq.batchStart);
+
+    const uint64_t gen = generation;
+    auto *cb = new DmaDone([this, cqid, gen, count](uint8_t *) {
+            completionsWritten(cqid, gen, count);
+        }, count * sizeof(Completion));
+    memcpy(cb->buffer.data(), cq.batch.data(), count * sizeof(Completion));
+    cq.batch.clear();
+
+    Event *first_event = cb->getChunkEvent();
+    Event *second_event = first < count ? cb->getChunkEvent() : nullptr;
+
+    ++pendingDma;
+    ++stats.cqWrites;
+    dmaWrite(pciToDma(cq.base + cq.batchStart * sizeof(Completion)),
+             first * sizeof(Completion), first_event, cb->buffer.data());
+    if (second_event) {
+        dmaWrite(pciToDma(cq.base), (count - first) * sizeof(Completion),
+                 second_event,
+                 cb->buffer.data() + first * sizeof(Completion));
+    }
+}
+
+void
+NVMeController::completionsWritten(uint16_t cqid, uint64_t gen,
+                                   unsigned count)
+{
+    --pendingDma;
+
+    const CompQueue &cq = *compQueues[cqid];
+    if (gen == generation && cq.valid && cq.ien)
+        signalVector(msixEnabled() ? cq.vector : 0, count, cqid == 0);
+
+    opDone();
+}
+
+void
+NVMeController::signalVector(uint16_t vector, unsigned count, bool admin)
+{
+    Vector &vec = *vectors[vector];
+    vec.pending += count;
+
+    // Coalescing never applies to the admin queue
+    if (admin || vec.coalesceDisable || coalesceTime == 0 ||
+        vec.pending > coalesceThreshold) {
+        postInterrupt(vector);
+    } else if (!vec.timer.scheduled()) {
+        schedule(vec.timer,
+                 curTick() + coalesceTime * 100 * sim_clock::as_int::us);
+    }
+}
+
+void
+NVMeController::postInterrupt(uint16_t vector)
+{
+    Vector &vec = *vectors[vector];
+    vec.pending = 0;
+    if (vec.timer.scheduled())
+        deschedule(vec.timer);
+
+    if (!msixEnabled()) {
+        updateIntx();
+        return;
+    }
+
+    const MSIXTable &entry = msix_table[vector];
+    if ((msixcap.mxc & 0x4000) || (entry.fields.vec_ctrl & 0x1)) {
+        // Masked, the message is sent when the vector is unmasked
+        msix_pba[vector / MSIXVECS_PER_PBA].bits |=
+            1ULL << (vector % MSIXVECS_PER_PBA);
+        return;
+    }
+
+    DPRINTF(NVMe, "Sending MSI-X vector %d\n", vector);
+
+    const Addr addr = Addr(letoh(entry.fields.addr_hi)) << 32 |
+        letoh(entry.fields.addr_lo);
+    auto *cb = new DmaDone([this](uint8_t *) {
+            --pendingDma;
+            opDone();
+        }, sizeof(uint32_t));
+    memcpy(cb->buffer.data(), &entry.fields.msg_data, sizeof(uint32_t));
+
+    ++pendingDma;
+    ++stats.interrupts;
+    dmaWrite(pciToDma(addr), sizeof(uint32_t), cb->getChunkEvent(),
+             cb->buffer.data());
+}
+
+void
+NVMeController::updateMsix()
+{
+    if (!msixEnabled() || (msixcap.mxc & 0x4000))
+        return;
+
+    for (uint16_t v = 0; v < msix_table.size(); ++v) {
+        uint64_t &pba = msix_pba[v / MSIXVECS_PER_PBA].bits;
+        const uint64_t bit = 1ULL << (v % MSIXVECS_PER_PBA);
+        if ((pba & bit) && !(msix_table[v].fields.vec_ctrl & 0x1)) {
+            pba &= ~bit;
+            postInterrupt(v);
+        }
+    }
+}
+
+void
+NVMeController::updateIntx()
+{
+    bool assert_int = false;
+    if (!msixEnabled() && !(regIntMask & 0x1) &&
+        !(letoh(config.command) & PCI_CMD_INTXDIS)) {
+        for (const auto &cq : compQueues) {
+            if (cq->valid && cq->ien && cq->head != cq->tail) {
+                assert_int = true;
+                break;
+            }
+        }
+    }
+
+    if (assert_int == intxAsserted)
+        return;
+
+    intxAsserted = assert_int;
+    if (assert_int) {
+        ++stats.interrupts;
+        intrPost();
+    } else {
+        intrClear();
+    }
+}
+
+bool
+NVMeController::idle() const
+{
+    if (inFlight || pendingDma)
+        return false;
+    for (const auto &cq : compQueues) {
+        if (cq->flushEvent.scheduled())
+            return false;
+    }
+    return true;
+}
+
+void
+NVMeController::opDone()
+{
+    if (drainState() == DrainState::Draining && idle()) {
+        DPRINTF(Drain, "%s done draining\n", name());
+        signalDrainDone();
+    }
+}
+
+DrainState
+NVMeController::drain()
+{
+    if (idle())
+        return DrainState::Drained;
+
+    DPRINTF(Drain, "%s draining, %d commands in flight\n", name(), inFlight);
+    return DrainState::Draining;
+}
+
+void
+NVMeController::drainResume()
+{
+    PciDevice::drainResume();
+    // Fetching stops while draining
+    fetch();
+}
+
+void
+NVMeController::serialize(CheckpointOut &cp) const
+{
+    PciDevice::serialize(cp);
+
+    SERIALIZE_SCALAR(regIntMask);
+    SERIALIZE_SCALAR(regCc);
+    SERIALIZE_SCALAR(regCsts);
+    SERIALIZE_SCALAR(regAqa);
+    SERIALIZE_SCALAR(regAsq);
+    SERIALIZE_SCALAR(regAcq);
+    SERIALIZE_SCALAR(numIoQueues);
+    SERIALIZE_SCALAR(coalesceThreshold);
+    SERIALIZE_SCALAR(coalesceTime);
+    SERIALIZE_SCALAR(aerCount);
+    SERIALIZE_SCALAR(intxAsserted);
+    SERIALIZE_SCALAR(fetchNext);
+    SERIALIZE_SCALAR(mediaFree);
+
+    for (size_t i = 0; i < subQueues.size(); ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("sq%d", i));
+        const SubQueue &sq = subQueues[i];
+        paramOut(cp, "valid", sq.valid);
+        paramOut(cp, "base", sq.base);
+        paramOut(cp, "size", sq.size);
+        paramOut(cp, "head", sq.head);
+        paramOut(cp, "tail", sq.tail);
+        paramOut(cp, "cqid", sq.cqid);
+    }
+
+    for (size_t i = 0; i < compQueues.size(); ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("cq%d", i));
+        const CompQueue &cq = *compQueues[i];
+        paramOut(cp, "valid", cq.valid);
+        paramOut(cp, "base", cq.base);
+        paramOut(cp, "size", cq.size);
+        paramOut(cp, "head", cq.head);
+        paramOut(cp, "tail", cq.tail);
+        paramOut(cp, "phase", cq.phase);
+        paramOut(cp, "ien", cq.ien);
+        paramOut(cp, "vector", cq.vector);
+
+        // Completions waiting for the driver to free queue slots
+        std::vector<uint32_t> pending(cq.pending.size() * 4);
+        for (size_t j = 0; j < cq.pending.size(); ++j)
+            memcpy(&pending[j * 4], &cq.pending[j], sizeof(Completion));
+        arrayParamOut(cp, "pending", pending);
+    }
+
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("vector%d", i));
+        const Vector &vec = *vectors[i];
+        paramOut(cp, "coalesceDisable", vec.coalesceDisable);
+        paramOut(cp, "pending", vec.pending);
+        const Tick timer = vec.timer.scheduled() ? vec.timer.when() : 0;
+        paramOut(cp, "timer", timer);
+    }
+}
+
+void
+NVMeController::unserialize(CheckpointIn &cp)
+{
+    PciDevice::unserialize(cp);
+
+    UNSERIALIZE_SCALAR(regIntMask);
+    UNSERIALIZE_SCALAR(regCc);
+    UNSERIALIZE_SCALAR(regCsts);
+    UNSERIALIZE_SCALAR(regAqa);
+    UNSERIALIZE_SCALAR(regAsq);
+    UNSERIALIZE_SCALAR(regAcq);
+    UNSERIALIZE_SCALAR(numIoQueues);
+    UNSERIALIZE_SCALAR(coalesceThreshold);
+    UNSERIALIZE_SCALAR(coalesceTime);
+    UNSERIALIZE_SCALAR(aerCount);
+    UNSERIALIZE_SCALAR(intxAsserted);
+    UNSERIALIZE_SCALAR(fetchNext);
+    UNSERIALIZE_SCALAR(mediaFree);
+
+    for (size_t i = 0; i < subQueues.size(); ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("sq%d", i));
+        SubQueue &sq = subQueues[i];
+        paramIn(cp, "valid", sq.valid);
+        paramIn(cp, "base", sq.base);
+        paramIn(cp, "size", sq.size);
+        paramIn(cp, "head", sq.head);
+        paramIn(cp, "tail", sq.tail);
+        paramIn(cp, "cqid", sq.cqid);
+        sq.fetching = false;
+    }
+
+    for (size_t i = 0; i < compQueues.size(); ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("cq%d", i));
+        CompQueue &cq = *compQueues[i];
+        paramIn(cp, "valid", cq.valid);
+        paramIn(cp, "base", cq.base);
+        paramIn(cp, "size", cq.size);
+        paramIn(cp, "head", cq.head);
+        paramIn(cp, "tail", cq.tail);
+        paramIn(cp, "phase", cq.phase);
+        paramIn(cp, "ien", cq.ien);
+        paramIn(cp, "vector", cq.vector);
+
+        std::vector<uint32_t> pending;
+        arrayParamIn(cp, "pending", pending);
+        cq.pending.resize(pending.size() / 4);
+        for (size_t j = 0; j < cq.pending.size(); ++j)
+            memcpy(&cq.pending[j], &pending[j * 4], sizeof(Completion));
+    }
+
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        ScopedCheckpointSection sec(cp, csprintf("vector%d", i));
+        Vector &vec = *vectors[i];
+        paramIn(cp, "coalesceDisable", vec.coalesceDisable);
+        paramIn(cp, "pending", vec.pending);
+        Tick timer;
+        paramIn(cp, "timer", timer);
+        if (timer)
+            schedule(vec.timer, timer);
+    }
+}
+
+NVMeController::NVMeStats::NVMeStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(readCmds, statistics::units::Count::get(),
+               "Number of read commands"),
+      ADD_STAT(writeCmds, statistics::units::Count::get(),
+               "Number of write commands"),
+      ADD_STAT(readBytes, statistics::units::Byte::get(),
+               "Number of bytes read"),
+      ADD_STAT(writeBytes, statistics::units::Byte::get(),
+               "Number of bytes written"),
+      ADD_STAT(adminCmds, statistics::units::Count::get(),
+               "Number of admin commands"),
+      ADD_STAT(fetches, statistics::units::Count::get(),
+               "Number of submission queue fetches"),
+      ADD_STAT(cqWrites, statistics::units::Count::get(),
+               "Number of completion queue writes"),
+      ADD_STAT(interrupts, statistics::units::Count::get(),
+               "Number of interrupts sent")
+{
+}
+
+} // namespace gem5
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * NVM Express controller model.
+ */
+
+#ifndef __DEV_STORAGE_NVME_HH__
+#define __DEV_STORAGE_NVME_HH__
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "dev/dma_device.hh"
+#include "dev/pci/device.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+class DiskImage;
+struct NVMeControllerParams;
+
+/**
+ * NVM Express controller with a single namespace backed by a disk
+ * image.
+ *
+ * The controller implements the admin commands needed by common
+ * drivers (queue management, identify, features and log pages) and
+ * the NVM read, write and flush commands, with an arbitrary number of
+ * I/O submission/completion queue pairs. Interrupts are delivered
+ * through MSI-X when the driver enables it and through INTx
+ * otherwise.
+ *
+ * To keep the cost per command low, a submission queue doorbell
+ * fetches all the new commands of the queue with a single DMA, and
+ * completions posted in the same tick are written to the completion
+ * queue with a single DMA. Interrupts can additionally be coalesced
+ * using the Interrupt Coalescing feature.
+ *
+ * The flash media is modeled as a single pipe with a fixed bandwidth
+ * followed by a fixed access latency, so that many outstanding
+ * commands overlap their latencies while the throughput is limited by
+ * the bandwidth.
+ */
+class NVMeController : public PciDevice
+{
+  public:
+    typedef NVMeControllerParams Params;
+    NVMeController(const Params &p);
+    ~NVMeController();
+
+    Tick read(PacketPtr pkt) override;
+    Tick write(PacketPtr pkt) override;
+
+    Tick readConfig(PacketPtr pkt) override;
+    Tick writeConfig(PacketPtr pkt) override;
+
+    DrainState drain() override;
+    void drainResume() override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+  protected:
+    /** @{
+     * @name Controller registers
+     */
+    static const Addr REG_CAP = 0x00;
+    static const Addr REG_VS = 0x08;
+    static const Addr REG_INTMS = 0x0c;
+    static const Addr REG_INTMC = 0x10;
+    static const Addr REG_CC = 0x14;
+    static const Addr REG_CSTS = 0x1c;
+    static const Addr REG_NSSR = 0x20;
+    static const Addr REG_AQA = 0x24;
+    static const Addr REG_ASQ = 0x28;
+    static const Addr REG_ACQ = 0x30;
+    static const Addr REG_DOORBELL = 0x1000;
+    /** @} */
+
+    /** Submission queue entry */
+    struct Command
+    {
+        uint32_t cdw0;
+        uint32_t nsid;
+        uint64_t rsvd;
+        uint64_t mptr;
+        uint64_t prp1;
+        uint64_t prp2;
+        uint32_t cdw10;
+        uint32_t cdw11;
+        uint32_t cdw12;
+        uint32_t cdw13;
+        uint32_t cdw14;
+        uint32_t cdw15;
+
+        uint8_t opcode() const { return cdw0 & 0xff; }
+        uint16_t cid() const { return cdw0 >> 16; }
+    };
+    static_assert(sizeof(Command) == 64);
+
+    /** Completion queue entry */
+    struct Completion
+    {
+        uint32_t result;
+        uint32_t rsvd;
+        uint16_t sqhd;
+        uint16_t sqid;
+        uint16_t cid;
+        uint16_t status;
+    };
+    static_assert(sizeof(Completion) == 16);
+
+    struct SubQueue
+    {
+        bool valid = false;
+        Addr base = 0;
+        uint32_t size = 0;
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        uint16_t cqid = 0;
+        /** A command fetch DMA is in progress */
+        bool fetching = false;
+    };
+
+    struct CompQueue
+    {
+        CompQueue(NVMeController &ctrl, uint16_t id);
+
+        bool valid = false;
+        Addr base = 0;
+        uint32_t size = 0;
+        uint32_t head = 0;
+        uint32_t tail = 0;
+        bool phase = true;
+        bool ien = false;
+        uint16_t vector = 0;
+
+        /** Completions waiting for a free slot in the queue */
+        std::deque<Completion> pending;
+        /** Completions waiting to be written to the queue */
+        std::vector<Completion> batch;
+        /** Slot of the first completion of the batch */
+        uint32_t batchStart = 0;
+        /** Write the batch to the queue at the end of the tick */
+        EventFunctionWrapper flushEvent;
+
+        bool full() const { return (tail + 1) % size == head; }
+    };
+
+    struct Vector
+    {
+        Vector(NVMeController &ctrl, uint16_t id);
+
+        /** Coalescing disabled for this vector */
+        bool coalesceDisable = false;
+        /** Completions that have not been signalled yet */
+        unsigned pending = 0;
+        /** Aggregation time of the interrupt coalescing */
+        EventFunctionWrapper timer;
+    };
+
+    /** State of a command between fetch and completion */
+    struct Request
+    {
+        Command cmd;
+        uint16_t sqid;
+        /** Controller generation the command was fetched in */
+        uint64_t generation;
+        /** Physical memory segments of the data buffer */
+        std::vector<std::pair<Addr, uint32_t>> segments;
+        std::vector<uint8_t> data;
+    };
+    typedef std::shared_ptr<Request> RequestPtr;
+
+    /** DMA completion callback with an optional bounce buffer */
+    class DmaDone : public DmaCallback
+    {
+      public:
+        DmaDone(std::function<void(uint8_t *)> fn, size_t size = 0)
+            : buffer(size), _fn(std::move(fn))
+        {}
+
+        std::vector<uint8_t> buffer;
+
+      protected:
+        void process() override { _fn(buffer.data()); }
+        std::function<void(uint8_t *)> _fn;
+    };
+
+    /** @{
+     * @name Status codes (SCT << 8 | SC)
+     */
+    static const uint16_t SC_SUCCESS = 0x000;
+    static const uint16_t SC_INVALID_OPCODE = 0x001;
+    static const uint16_t SC_INVALID_FIELD = 0x002;
+    static const uint16_t SC_DATA_TRANSFER_ERROR = 0x004;
+    static const uint16_t SC_INVALID_NAMESPACE = 0x00b;
+    static const uint16_t SC_LBA_OUT_OF_RANGE = 0x080;
+    static const uint16_t SC_INVALID_CQ = 0x101;
+    static const uint16_t SC_INVALID_QID = 0x102;
+    static const uint16_t SC_INVALID_QSIZE = 0x103;
+    static const uint16_t SC_AER_LIMIT = 0x105;
+    static const uint16_t SC_INVALID_VECTOR = 0x108;
+    static const uint16_t SC_INVALID_DELETION = 0x10c;
+    /** @} */
+
+    /** Maximum number of AERs that are held by the controller */
+    static const unsigned AerLimit = 4;
+
+    DiskImage *image;
+
+    const uint64_t regCap;
+    uint32_t regIntMask;
+    uint32_t regCc;
+    uint32_t regCsts;
+    uint32_t regAqa;
+    uint64_t regAsq;
+    uint64_t regAcq;
+
+    /** Queue 0 is the admin queue */
+    std::vector<SubQueue> subQueues;
+    std::vector<std::unique_ptr<CompQueue>> compQueues;
+    std::vector<std::unique_ptr<Vector>> vectors;
+
+    /** Number of I/O queues of each kind granted to the driver */
+    uint16_t numIoQueues;
+    /** Interrupt coalescing aggregation threshold (0's based) */
+    uint8_t coalesceThreshold;
+    /** Interrupt coalescing aggregation time (100us units) */
+    uint8_t coalesceTime;
+    /** Outstanding asynchronous event requests (never completed) */
+    unsigned aerCount;
+    bool intxAsserted;
+
+    /** Incremented on every reset to drop stale commands */
+    uint64_t generation;
+    /** Commands between fetch and completion */
+    unsigned inFlight;
+    /** Queue fetches and completion writes in progress */
+    unsigned pendingDma;
+    /** Upper bound of inFlight */
+    const unsigned maxOutstanding;
+    /** Submission queue to start fetching from (round robin) */
+    uint16_t fetchNext;
+
+    const uint32_t maxTransfer;
+    const Tick readLatency;
+    const Tick writeLatency;
+    /** Media bandwidth in ticks per byte */
+    const double bandwidth;
+    /** Time at which the media is free to transfer more data */
+    Tick mediaFree;
+
+  protected:
+    uint32_t pageSize() const { return 4096 << ((regCc >> 7) & 0xf); }
+    bool enabled() const { return regCc & 0x1; }
+    bool msixEnabled() const { return msixcap.mxc & 0x8000; }
+
+    /** @{
+     * @name Register interface
+     */
+    uint64_t readRegister(Addr offset, unsigned size);
+    void writeRegister(Addr offset, unsigned size, uint64_t value);
+    void writeDoorbell(uint16_t qid, bool cq, uint32_t value);
+    void enable();
+    void reset();
+    /** @} */
+
+    /** Fetch new commands from the submission queues */
+    void fetch();
+    void fetchQueue(uint16_t sqid);
+    void commandsFetched(uint16_t sqid, uint64_t gen, uint32_t count,
+                         const uint8_t *data);
+
+    /** @{
+     * @name Command processing
+     */
+    void execute(const RequestPtr &req);
+    void executeAdmin(const RequestPtr &req);
+    void executeIO(const RequestPtr &req);
+    void identify(const RequestPtr &req);
+    uint16_t createSubQueue(const Command &cmd);
+    uint16_t createCompQueue(const Command &cmd);
+    uint16_t deleteSubQueue(const Command &cmd);
+    uint16_t deleteCompQueue(const Command &cmd);
+    uint16_t setFeatures(const Command &cmd, uint32_t &result);
+    uint16_t getFeatures(const Command &cmd, uint32_t &result);
+    /** @} */
+
+    /** @{
+     * @name Data transfers
+     */
+    /**
+     * Translate the PRPs of a command into memory segments and call
+     * done() once the segments are known (this may need to read PRP
+     * lists from memory).
+     */
+    void mapPrps(const RequestPtr &req, uint32_t bytes,
+                 std::function<void()> done);
+    void readPrpList(const RequestPtr &req, Addr list, uint32_t bytes,
+                     std::function<void()> done);
+    /** DMA the request data to or from the memory segments */
+    void transfer(const RequestPtr &req, bool to_host,
+                  std::function<void()> done);
+    /** Send data to the host and complete the command */
+    void sendData(const RequestPtr &req, uint32_t result = 0);
+    /** Time the media needs for an access of the given size */
+    Tick mediaDelay(bool write, uint32_t bytes);
+    /** @} */
+
+    /** @{
+     * @name Completion and interrupts
+     */
+    void complete(const RequestPtr &req, uint16_t status,
+                  uint32_t result = 0);
+    void postCompletion(uint16_t cqid, const Completion &cpl);
+    /** Move pending completions to the free slots of a queue */
+    void pushCompletions(CompQueue &cq);
+    void flushCompletions(uint16_t cqid);
+    void completionsWritten(uint16_t cqid, uint64_t gen, unsigned count);
+    /** Account for new completions of a vector (interrupt coalescing) */
+    void signalVector(uint16_t vector, unsigned count, bool admin);
+    void postInterrupt(uint16_t vector);
+    /** Send the pending MSI-X messages that are no longer masked */
+    void updateMsix();
+    void updateIntx();
+    bool idle() const;
+    /** Account for a finished command or DMA (for draining) */
+    void opDone();
+    /** @} */
+
+    struct NVMeStats : public statistics::Group
+    {
+        NVMeStats(statistics::Group *parent);
+
+        statistics::Scalar readCmds;
+        statistics::Scalar writeCmds;
+        statistics::Scalar readBytes;
+        statistics::Scalar writeBytes;
+        statistics::Scalar adminCmds;
+        statistics::Scalar fetches;
+        statistics::Scalar cqWrites;
+        statistics::Scalar interrupts;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __DEV_STORAGE_NVME_HH__
@@ -314,6 +314,35 @@ VirtQueue::produceDescriptor(VirtDescriptor *desc, uint32_t len)
     used.write();
 }
 
+void
+VirtQueue::produceDescriptors(
+    const std::vector<std::pair<VirtDescriptor *, uint32_t>> &descs)
+{
+    if (descs.empty())
+        return;
+
+    used.readHeader();
+    DPRINTF(VIO, "produceDescriptors: count: %i, used.idx: %i\n",
+            descs.size(), used.header.index);
+
+    for (const auto &[desc, len] : descs) {
+        struct vring_used_elem &e(
+            used.ring[used.header.index % used.ring.size()]);
+        e.id = desc->index();
+        e.len = len;
+        used.header.index += 1;
+    }
+    used.write();
+}
+
+void
+VirtQueue::unconsumeDescriptors(uint16_t count)
+{
+    DPRINTF(VIO, "unconsumeDescriptors: _last_avail: %i, count: %i\n",
+            _last_avail, count);
+    _last_avail -= count;
+}
+
 void
 VirtQueue::dump() const
 {
@@ -40,6 +40,7 @@
 
 #include <cstdint>
 #include <functional>
+#include <utility>
 #include <vector>
 
 #include "base/bitunion.hh"
@@ -384,6 +385,31 @@ class VirtQueue : public Serializable
      * @param len Length of the produced data.
      */
     void produceDescriptor(VirtDescriptor *desc, uint32_t len);
+    /**
+     * Send a batch of descriptor chains to the guest.
+     *
+     * This is equivalent to calling produceDescriptor() for every
+     * element of the batch, but the used ring is only read and written
+     * once.
+     *
+     * @param descs Pairs of chain heads and produced lengths.
+     */
+    void produceDescriptors(
+        const std::vector<std::pair<VirtDescriptor *, uint32_t>> &descs);
+    /**
+     * Hand back descriptor chains that were consumed but not used.
+     *
+     * This rewinds the available ring by the given number of chains,
+     * so that following calls to consumeDescriptor() return them
+     * again. It is useful when a device model finds out that it does
+     * not have enough buffers to complete an operation.
+     *
+     * @note Only chains that have not been produced yet may be handed
+     * back.
+     *
+     * @param count Number of chains to hand back.
+     */
+    void unconsumeDescriptors(uint16_t count);
     /** @} */
 
     /** @{
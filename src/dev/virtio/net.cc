@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dev/virtio/net.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/inet.hh"
+#include "base/trace.hh"
+#include "debug/VIONet.hh"
+#include "params/VirtIONet.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+VirtIONet::VirtIONet(const Params &params)
+    : VirtIODeviceBase(params, ID_NET, sizeof(Config),
+                       F_MAC | F_STATUS |
+                       (params.mergeableRx ? F_MRG_RXBUF : 0) |
+                       (params.numQueuePairs > 1 ? F_CTRL_VQ | F_MQ : 0)),
+      activePairs(1), txNext(0),
+      txFifo(params.txFifoSize), rxFifo(params.rxFifoSize),
+      etherInt(new VirtIONetInt(name() + ".int0", this)),
+      stats(this)
+{
+    fatal_if(params.numQueuePairs == 0,
+             "%s: At least one queue pair is needed.\n", name());
+
+    for (unsigned i = 0; i < params.numQueuePairs; ++i) {
+        rxQueues.emplace_back(new RxQueue(
+            params.system->physProxy, byteOrder, params.qSize,
+            csprintf("%s.qRx%d", name(), i), *this));
+        txQueues.emplace_back(new TxQueue(
+            params.system->physProxy, byteOrder, params.qSize,
+            csprintf("%s.qTx%d", name(), i), *this));
+        registerQueue(*rxQueues.back());
+        registerQueue(*txQueues.back());
+    }
+
+    if (params.numQueuePairs > 1) {
+        ctrlQueue.reset(new CtrlQueue(
+            params.system->physProxy, byteOrder, params.qSize, *this));
+        registerQueue(*ctrlQueue);
+    }
+
+    memcpy(config.mac, params.hardware_address.bytes(), sizeof(config.mac));
+    config.status = S_LINK_UP;
+    config.max_virtqueue_pairs = params.numQueuePairs;
+}
+
+VirtIONet::~VirtIONet()
+{
+    delete etherInt;
+}
+
+void
+VirtIONet::readConfig(PacketPtr pkt, Addr cfgOffset)
+{
+    Config cfg_out;
+    memcpy(cfg_out.mac, config.mac, sizeof(cfg_out.mac));
+    cfg_out.status = htog(config.status, byteOrder);
+    cfg_out.max_virtqueue_pairs = htog(config.max_virtqueue_pairs,
+                                       byteOrder);
+
+    readConfigBlob(pkt, cfgOffset, (uint8_t *)&cfg_out);
+}
+
+void
+VirtIONet::reset()
+{
+    VirtIODeviceBase::reset();
+
+    activePairs = 1;
+    txNext = 0;
+    txFifo.clear();
+    rxFifo.clear();
+}
+
+Port &
+VirtIONet::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name == "interface")
+        return *etherInt;
+    return VirtIODeviceBase::getPort(if_name, idx);
+}
+
+void
+VirtIONet::serialize(CheckpointOut &cp) const
+{
+    VirtIODeviceBase::serialize(cp);
+
+    SERIALIZE_SCALAR(activePairs);
+    SERIALIZE_SCALAR(txNext);
+    txFifo.serialize("txFifo", cp);
+    rxFifo.serialize("rxFifo", cp);
+}
+
+void
+VirtIONet::unserialize(CheckpointIn &cp)
+{
+    VirtIODeviceBase::unserialize(cp);
+
+    UNSERIALIZE_SCALAR(activePairs);
+    UNSERIALIZE_SCALAR(txNext);
+    txFifo.unserialize("txFifo", cp);
+    rxFifo.unserialize("rxFifo", cp);
+}
+
+size_t
+VirtIONet::headerSize() const
+{
+    // The num_buffers field only exists with mergeable rx buffers
+    if (getGuestFeatures() & F_MRG_RXBUF)
+        return sizeof(NetHeader);
+    else
+        return sizeof(NetHeader) - sizeof(uint16_t);
+}
+
+void
+VirtIONet::pullTx()
+{
+    if (getDeviceStatus().driver_ok) {
+        const size_t hdr_size(headerSize());
+        std::vector<std::pair<VirtDescriptor *, uint32_t>> used;
+        bool kick_guest(false);
+
+        // Drain every active transmit queue into the FIFO, starting
+        // with a different queue every time so that a busy queue
+        // cannot starve the others when the FIFO fills up.
+        for (unsigned i = 0; i < activePairs; ++i) {
+            TxQueue &q(*txQueues[(txNext + i) % activePairs]);
+            VirtDescriptor *d;
+            while ((d = q.consumeDescriptor())) {
+                const size_t size(d->chainSize());
+                if (size <= hdr_size || size - hdr_size > txFifo.maxsize()) {
+                    warn("%s: Dropping frame of invalid size (%i)\n",
+                         q.name(), size);
+                    used.emplace_back(d, 0);
+                    continue;
+                }
+
+                const size_t len(size - hdr_size);
+                if (len > txFifo.avail()) {
+                    // No space left, pick it up after the next transfer
+                    q.unconsumeDescriptors(1);
+                    break;
+                }
+
+                EthPacketPtr packet = std::make_shared<EthPacketData>(len);
+                d->chainRead(hdr_size, packet->data, len);
+                packet->length = len;
+                packet->simLength = len;
+                txFifo.push(packet);
+                used.emplace_back(d, 0);
+            }
+
+            if (!used.empty()) {
+                DPRINTF(VIONet, "%s: Pulled %i chains\n", q.name(),
+                        used.size());
+                q.produceDescriptors(used);
+                used.clear();
+                kick_guest = true;
+                ++stats.txBatches;
+            }
+        }
+        txNext = (txNext + 1) % activePairs;
+
+        if (kick_guest)
+            kick();
+    }
+
+    trySend();
+}
+
+void
+VirtIONet::trySend()
+{
+    while (!txFifo.empty()) {
+        EthPacketPtr packet = txFifo.front();
+        if (!etherInt->sendPacket(packet))
+            break;
+
+        DPRINTF(VIONet, "Sent frame (len: %i)\n", packet->length);
+        ++stats.txPackets;
+        stats.txBytes += packet->length;
+        txFifo.pop();
+    }
+}
+
+void
+VirtIONet::transferDone()
+{
+    DPRINTF(VIONet, "Transfer done\n");
+    pullTx();
+}
+
+bool
+VirtIONet::recvPacket(EthPacketPtr packet)
+{
+    DPRINTF(VIONet, "Received frame (len: %i)\n", packet->length);
+
+    if (!getDeviceStatus().driver_ok || !rxFifo.push(packet)) {
+        DPRINTF(VIONet, "Dropping frame, receive FIFO full\n");
+        ++stats.rxDrops;
+        return true;
+    }
+
+    deliverRx();
+    return true;
+}
+
+unsigned
+VirtIONet::steer(const EthPacketPtr &packet) const
+{
+    if (activePairs == 1)
+        return 0;
+
+    networking::IpPtr ip(packet);
+    if (!ip)
+        return 0;
+
+    // Symmetric flow hash, both directions of a connection end up in
+    // the same queue pair.
+    uint32_t hash(ip->src() ^ ip->dst());
+    networking::TcpPtr tcp(ip);
+    networking::UdpPtr udp(ip);
+    if (tcp)
+        hash ^= tcp->sport() ^ tcp->dport();
+    else if (udp)
+        hash ^= udp->sport() ^ udp->dport();
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+
+    return hash % activePairs;
+}
+
+bool
+VirtIONet::copyToGuest(RxQueue &q, const EthPacketPtr &packet,
+    std::vector<std::pair<VirtDescriptor *, uint32_t>> &used)
+{
+    const bool mergeable(getGuestFeatures() & F_MRG_RXBUF);
+    const size_t hdr_size(headerSize());
+    const size_t size(hdr_size + packet->length);
+    const size_t first(used.size());
+
+    // Collect enough chains to hold the header and the frame. Without
+    // mergeable rx buffers every frame has to fit in a single chain.
+    size_t space(0);
+    uint16_t count(0);
+    do {
+        VirtDescriptor *d(q.consumeDescriptor());
+        if (!d) {
+            DPRINTF(VIONet, "%s: Out of buffers\n", q.name());
+            q.unconsumeDescriptors(count);
+            used.resize(first);
+            return false;
+        }
+        space += d->chainSize();
+        used.emplace_back(d, 0);
+        ++count;
+    } while (mergeable && space < size);
+
+    if (space < size || used[first].first->chainSize() < hdr_size) {
+        warn("%s: Dropping frame, receive buffer too small\n", q.name());
+        q.unconsumeDescriptors(count);
+        used.resize(first);
+        ++stats.rxDrops;
+        return true;
+    }
+
+    NetHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.num_buffers = htog(count, byteOrder);
+
+    size_t offset(0);
+    for (size_t i = first; i < used.size(); ++i) {
+        VirtDescriptor *d(used[i].first);
+        size_t written(0);
+        if (i == first) {
+            d->chainWrite(0, (const uint8_t *)&hdr, hdr_size);
+            written = hdr_size;
+        }
+
+        const size_t len(std::min(d->chainSize() - written,
+                                  packet->length - offset));
+        d->chainWrite(written, packet->data + offset, len);
+        offset += len;
+        used[i].second = written + len;
+    }
+
+    ++stats.rxPackets;
+    stats.rxBytes += packet->length;
+    return true;
+}
+
+void
+VirtIONet::deliverRx()
+{
+    if (!getDeviceStatus().driver_ok)
+        return;
+
+    std::vector<std::vector<std::pair<VirtDescriptor *, uint32_t>>> used(
+        rxQueues.size());
+    while (!rxFifo.empty()) {
+        EthPacketPtr packet = rxFifo.front();
+        const unsigned qp(steer(packet));
+        // Frames are delivered in order, so wait for the guest to
+        // refill the queue if it ran out of buffers.
+        if (!copyToGuest(*rxQueues[qp], packet, used[qp]))
+            break;
+        rxFifo.pop();
+    }
+
+    bool kick_guest(false);
+    for (unsigned i = 0; i < rxQueues.size(); ++i) {
+        if (used[i].empty())
+            continue;
+
+        DPRINTF(VIONet, "%s: Delivered %i chains\n", rxQueues[i]->name(),
+                used[i].size());
+        rxQueues[i]->produceDescriptors(used[i]);
+        kick_guest = true;
+        ++stats.rxBatches;
+    }
+
+    if (kick_guest)
+        kick();
+}
+
+uint8_t
+VirtIONet::handleCtrl(uint8_t cls, uint8_t cmd, const uint8_t *data,
+                      size_t size)
+{
+    if (cls == CTRL_MQ && cmd == CTRL_MQ_VQ_PAIRS_SET &&
+        size >= sizeof(uint16_t)) {
+        uint16_t pairs;
+        memcpy(&pairs, data, sizeof(pairs));
+        pairs = gtoh(pairs, byteOrder);
+        if (pairs == 0 || pairs > rxQueues.size())
+            return CTRL_ERR;
+
+        DPRINTF(VIONet, "Enabling %i queue pairs\n", pairs);
+        activePairs = pairs;
+        txNext = 0;
+        return CTRL_OK;
+    }
+
+    DPRINTF(VIONet, "Unsupported control command (class: %i, cmd: %i)\n",
+            cls, cmd);
+    return CTRL_ERR;
+}
+
+void
+VirtIONet::CtrlQueue::onNotifyDescriptor(VirtDescriptor *desc)
+{
+    // The command (class, command and data) is in the device-readable
+    // part of the chain, followed by a single writable ack byte.
+    size_t cmd_size(0);
+    for (VirtDescriptor *d = desc; d && d->isIncoming(); d = d->next())
+        cmd_size += d->size();
+
+    uint8_t ack(CTRL_ERR);
+    if (cmd_size >= 2) {
+        std::vector<uint8_t> cmd(cmd_size);
+        desc->chainRead(0, cmd.data(), cmd_size);
+        ack = parent.handleCtrl(cmd[0], cmd[1], cmd.data() + 2,
+                                cmd_size - 2);
+    }
+
+    desc->chainWrite(cmd_size, &ack, sizeof(ack));
+    produceDescriptor(desc, sizeof(ack));
+    parent.kick();
+}
+
+VirtIONet::NetStats::NetStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(txPackets, statistics::units::Count::get(),
+               "Number of frames sent"),
+      ADD_STAT(txBytes, statistics::units::Byte::get(),
+               "Number of bytes sent"),
+      ADD_STAT(rxPackets, statistics::units::Count::get(),
+               "Number of frames delivered to the guest"),
+      ADD_STAT(rxBytes, statistics::units::Byte::get(),
+               "Number of bytes delivered to the guest"),
+      ADD_STAT(rxDrops, statistics::units::Count::get(),
+               "Number of received frames dropped"),
+      ADD_STAT(txBatches, statistics::units::Count::get(),
+               "Number of used ring updates on the transmit queues"),
+      ADD_STAT(rxBatches, statistics::units::Count::get(),
+               "Number of used ring updates on the receive queues")
+{
+}
+
+} // namespace gem5
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __DEV_VIRTIO_NET_HH__
+#define __DEV_VIRTIO_NET_HH__
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/statistics.hh"
+#include "dev/net/etherint.hh"
+#include "dev/net/etherpkt.hh"
+#include "dev/net/pktfifo.hh"
+#include "dev/virtio/base.hh"
+
+namespace gem5
+{
+
+struct VirtIONetParams;
+class VirtIONetInt;
+
+/**
+ * VirtIO network device
+ *
+ * The VirtIO network device uses the following queues:
+ *  -# Receive queue 0 (from the network to the guest)
+ *  -# Transmit queue 0 (from the guest to the network)
+ *  -# ...
+ *  -# Receive queue N-1
+ *  -# Transmit queue N-1
+ *  -# Control queue (only if multiple queue pairs are supported)
+ *
+ * The device model follows the vhost-net approach of processing whole
+ * batches of descriptor chains every time it is notified: a transmit
+ * notification drains all the chains that fit in the transmit FIFO,
+ * and received frames are delivered in bursts. All the used ring
+ * entries of a batch are returned to the guest with a single used ring
+ * update and a single kick, which saves both simulated memory traffic
+ * and guest interrupts.
+ *
+ * Received frames are steered to the queue pairs enabled by the guest
+ * using a hash of their IPv4 flow. With mergeable receive buffers
+ * negotiated, a frame may span multiple receive chains.
+ *
+ * This implementation does not announce any checksum or segmentation
+ * offload, so the network header of transmitted frames is ignored and
+ * the header of received frames is always empty.
+ *
+ * @see http://docs.oasis-open.org/virtio/virtio/v1.0/virtio-v1.0.html
+ */
+class VirtIONet : public VirtIODeviceBase
+{
+  public:
+    typedef VirtIONetParams Params;
+    VirtIONet(const Params &params);
+    virtual ~VirtIONet();
+
+    void readConfig(PacketPtr pkt, Addr cfgOffset) override;
+
+    void reset() override;
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+    /** @{
+     * @name Ethernet interface callbacks
+     */
+    bool recvPacket(EthPacketPtr packet);
+    void transferDone();
+    /** @} */
+
+  protected:
+    /**
+     * Network device configuration structure
+     */
+    struct GEM5_PACKED Config
+    {
+        uint8_t mac[6];
+        uint16_t status;
+        uint16_t max_virtqueue_pairs;
+    };
+
+    /** Currently active configuration (host byte order) */
+    Config config;
+
+    /** VirtIO device ID */
+    static const DeviceId ID_NET = 0x01;
+
+    /** @{
+     * @name Feature bits
+     */
+    /** Provides the MAC address in the configuration space */
+    static const FeatureBits F_MAC = (1 << 5);
+    /** Supports merging of receive buffers */
+    static const FeatureBits F_MRG_RXBUF = (1 << 15);
+    /** Provides the link status in the configuration space */
+    static const FeatureBits F_STATUS = (1 << 16);
+    /** Supports the control queue */
+    static const FeatureBits F_CTRL_VQ = (1 << 17);
+    /** Supports multiple queue pairs */
+    static const FeatureBits F_MQ = (1 << 22);
+    /** @} */
+
+    /** Link status bit in the configuration space */
+    static const uint16_t S_LINK_UP = 0x01;
+
+    /** @{
+     * @name Control queue commands
+     */
+    static const uint8_t CTRL_MQ = 4;
+    static const uint8_t CTRL_MQ_VQ_PAIRS_SET = 0;
+
+    static const uint8_t CTRL_OK = 0;
+    static const uint8_t CTRL_ERR = 1;
+    /** @} */
+
+    /**
+     * Header prepended to every frame (guest byte order)
+     *
+     * The num_buffers field is only present if mergeable receive
+     * buffers have been negotiated.
+     */
+    struct GEM5_PACKED NetHeader
+    {
+        uint8_t flags;
+        uint8_t gso_type;
+        uint16_t hdr_len;
+        uint16_t gso_size;
+        uint16_t csum_start;
+        uint16_t csum_offset;
+        uint16_t num_buffers;
+    };
+
+  protected:
+    /**
+     * Virtqueue for frames going from the network to the guest.
+     */
+    class RxQueue
+        : public VirtQueue
+    {
+      public:
+        RxQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                const std::string &name, VirtIONet &_parent)
+            : VirtQueue(proxy, bo, size), _name(name), parent(_parent) {}
+        virtual ~RxQueue() {}
+
+        void onNotify() override { parent.deliverRx(); }
+
+        std::string name() const { return _name; }
+
+      protected:
+        const std::string _name;
+        VirtIONet &parent;
+    };
+
+    /**
+     * Virtqueue for frames going from the guest to the network.
+     */
+    class TxQueue
+        : public VirtQueue
+    {
+      public:
+        TxQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                const std::string &name, VirtIONet &_parent)
+            : VirtQueue(proxy, bo, size), _name(name), parent(_parent) {}
+        virtual ~TxQueue() {}
+
+        void onNotify() override { parent.pullTx(); }
+
+        std::string name() const { return _name; }
+
+      protected:
+        const std::string _name;
+        VirtIONet &parent;
+    };
+
+    /**
+     * Virtqueue for control commands from the guest.
+     */
+    class CtrlQueue
+        : public VirtQueue
+    {
+      public:
+        CtrlQueue(PortProxy &proxy, ByteOrder bo, uint16_t size,
+                  VirtIONet &_parent)
+            : VirtQueue(proxy, bo, size), parent(_parent) {}
+        virtual ~CtrlQueue() {}
+
+        void onNotifyDescriptor(VirtDescriptor *desc) override;
+
+        std::string name() const
+        {
+            return parent.name() + ".qCtrl";
+        }
+
+      protected:
+        VirtIONet &parent;
+    };
+
+    /** Size of the network header negotiated with the guest */
+    size_t headerSize() const;
+
+    /**
+     * Pull as many frames as possible from the transmit queues of the
+     * active queue pairs into the transmit FIFO.
+     */
+    void pullTx();
+
+    /** Send frames from the transmit FIFO until the link is busy. */
+    void trySend();
+
+    /**
+     * Deliver as many frames as possible from the receive FIFO to the
+     * guest.
+     */
+    void deliverRx();
+
+    /**
+     * Copy a frame to the guest using one or more receive chains.
+     *
+     * @param q Receive queue of the queue pair the frame is steered to.
+     * @param packet Frame to copy.
+     * @param used Used ring entries of the current batch.
+     * @return False if the guest did not provide enough buffers.
+     */
+    bool copyToGuest(RxQueue &q, const EthPacketPtr &packet,
+        std::vector<std::pair<VirtDescriptor *, uint32_t>> &used);
+
+    /** Select the queue pair the frame should be delivered to */
+    unsigned steer(const EthPacketPtr &packet) const;
+
+    /** Process a control command, returns the acknowledgement */
+    uint8_t handleCtrl(uint8_t cls, uint8_t cmd, const uint8_t *data,
+                       size_t size);
+
+    /** Receive queues, one per queue pair */
+    std::vector<std::unique_ptr<RxQueue>> rxQueues;
+    /** Transmit queues, one per queue pair */
+    std::vector<std::unique_ptr<TxQueue>> txQueues;
+    /** Control queue (only if multiple queue pairs are announced) */
+    std::unique_ptr<CtrlQueue> ctrlQueue;
+
+    /** Number of queue pairs enabled by the guest */
+    unsigned activePairs;
+    /** Transmit queue to start pulling frames from (round robin) */
+    unsigned txNext;
+
+    /** Frames waiting to be sent to the network */
+    PacketFifo txFifo;
+    /** Frames waiting to be delivered to the guest */
+    PacketFifo rxFifo;
+
+    VirtIONetInt *etherInt;
+
+    struct NetStats : public statistics::Group
+    {
+        NetStats(statistics::Group *parent);
+
+        statistics::Scalar txPackets;
+        statistics::Scalar txBytes;
+        statistics::Scalar rxPackets;
+        statistics::Scalar rxBytes;
+        statistics::Scalar rxDrops;
+        statistics::Scalar txBatches;
+        statistics::Scalar rxBatches;
+    } stats;
+};
+
+class VirtIONetInt : public EtherInt
+{
+  private:
+    VirtIONet *dev;
+
+  public:
+    VirtIONetInt(const std::string &name, VirtIONet *d)
+        : EtherInt(name), dev(d)
+    { }
+
+    bool recvPacket(EthPacketPtr pkt) override
+    {
+        return dev->recvPacket(pkt);
+    }
+    void sendDone() override { dev->transferDone(); }
+};
+
+} // namespace gem5
+
+#endif // __DEV_VIRTIO_NET_HH__
@@ -94,6 +94,12 @@ class VectorRegisterFile(RegisterFile):
     cxx_class = "gem5::VectorRegisterFile"
     cxx_header = "gpu-compute/vector_register_file.hh"
 
+    num_banks = Param.Unsigned(
+        0,
+        "Number of single ported banks the registers are interleaved "
+        "across, at most 64 (0 disables the bank conflict model)",
+    )
+
 
 class RegisterFileCache(SimObject):
     type = "RegisterFileCache"
@@ -348,6 +354,12 @@ class GPUDispatcher(SimObject):
     kernel_exit_events = Param.Bool(
         False, "Enable exiting sim loop after a kernel"
     )
+    kernel_samples = Param.Int(
+        0,
+        "Number of launches of each distinct kernel simulated in detail. "
+        "Later launches execute functionally and their timing is "
+        "extrapolated from the samples (0 disables kernel sampling)",
+    )
 
 
 class GPUCommandProcessor(DmaVirtDevice):
@@ -364,6 +376,11 @@ class GPUCommandProcessor(DmaVirtDevice):
         0,
         "Skip kernels until reaching this kernel (counting only non-blit kernels)",
     )
+    functional_non_blit_kernel_id = Param.Int(
+        0,
+        "Execute kernels functionally, without any timing, until reaching "
+        "this kernel (counting only non-blit kernels)",
+    )
 
 
 class StorageClassType(Enum):
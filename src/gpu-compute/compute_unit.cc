@@ -31,6 +31,8 @@
 
 #include "gpu-compute/compute_unit.hh"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
 
 #include "arch/amdgpu/common/gpu_translation_state.hh"
@@ -81,6 +83,9 @@ ComputeUnit::ComputeUnit(const Params &p) : ClockedObject(p),
     scalarMemoryPipe(p, *this),
     tickEvent([this]{ exec(); }, "Compute unit tick event",
           false, Event::CPU_Tick_Pri),
+    scheduledAddsEvent([this]{ execScheduledAdds(); },
+          "Compute unit scheduled adds event", false, Event::CPU_Tick_Pri),
+    sa_n(0),
     cu_id(p.cu_id),
     vrf(p.vector_register_file), srf(p.scalar_register_file),
     rfc(p.register_file_cache),
@@ -139,6 +144,9 @@ ComputeUnit::ComputeUnit(const Params &p) : ClockedObject(p),
              "WF size is larger than the host can support");
     fatal_if(!isPowerOf2(wavefrontSize),
              "Wavefront size should be a power of 2");
+    fatal_if(wavefrontSize > TheGpuISA::NumVecElemPerVecReg,
+             "WF size is larger than the number of lanes of a vector "
+             "register");
     // calculate how many cycles a vector load or store will need to transfer
     // its data over the corresponding buses
     numCyclesPerStoreTransfer =
@@ -242,6 +250,47 @@ ComputeUnit::~ComputeUnit()
     lastVaddrCU.clear();
 }
 
+size_t
+ComputeUnit::dynInstDataSize() const
+{
+    // d_data: up to 4 operands of 8 bytes, a_data and x_data: 8 bytes
+    // per lane, scalar_data: up to 16 Dwords
+    return wfSize() * (4 * sizeof(double) + 8 + 8) + 16 * sizeof(uint32_t);
+}
+
+uint8_t*
+ComputeUnit::allocDynInstData()
+{
+    uint8_t *data;
+
+    {
+        std::lock_guard<std::mutex> lock(dynInstDataLock);
+
+        if (freeDynInstDataBufs.empty()) {
+            size_t buf_size = dynInstDataSize();
+            dynInstDataSlabs.emplace_back(
+                new uint8_t[buf_size * dynInstDataSlabSize]);
+            uint8_t *slab = dynInstDataSlabs.back().get();
+            for (int i = dynInstDataSlabSize - 1; i >= 0; --i) {
+                freeDynInstDataBufs.push_back(slab + i * buf_size);
+            }
+        }
+
+        data = freeDynInstDataBufs.back();
+        freeDynInstDataBufs.pop_back();
+    }
+
+    std::memset(data, 0, dynInstDataSize());
+    return data;
+}
+
+void
+ComputeUnit::freeDynInstData(uint8_t *data)
+{
+    std::lock_guard<std::mutex> lock(dynInstDataLock);
+    freeDynInstDataBufs.push_back(data);
+}
+
 int
 ComputeUnit::numExeUnits() const
 {
@@ -461,8 +510,9 @@ ComputeUnit::resetRegisterPool()
 void
 ComputeUnit::dispWorkgroup(HSAQueueEntry *task, int num_wfs_in_wg)
 {
-    // If we aren't ticking, start it up!
-    if (!tickEvent.scheduled()) {
+    // If we aren't ticking, start it up! A functional WG completes before
+    // this method returns, so it does not need the CU to tick.
+    if (!task->isFunctional() && !tickEvent.scheduled()) {
         DPRINTF(GPUDisp, "CU%d: Scheduling wakeup next cycle\n", cu_id);
         schedule(tickEvent, nextCycle());
     }
@@ -486,6 +536,7 @@ ComputeUnit::dispWorkgroup(HSAQueueEntry *task, int num_wfs_in_wg)
     int wave_id = 0;
 
     int barrier_id = WFBarrier::InvalidID;
+    std::vector<Wavefront*> functional_wfs;
 
     /**
      * If this WG only has one WF it will not consume any barrier
@@ -529,11 +580,62 @@ ComputeUnit::dispWorkgroup(HSAQueueEntry *task, int num_wfs_in_wg)
 
                 registerManager->allocateRegisters(w, vregDemand, sregDemand);
 
+                w->functional = task->isFunctional();
                 startWavefront(w, wave_id, ldsChunk, task, barrier_id);
                 ++wave_id;
+
+                if (w->functional) {
+                    functional_wfs.push_back(w);
+                }
             }
         }
     }
+
+    if (task->isFunctional()) {
+        execFunctionalWorkgroup(functional_wfs, barrier_id);
+    }
+}
+
+/**
+ * Each WF runs until it either ends or waits at the WG's barrier. Once no WF
+ * can make progress, all the remaining WFs must be at the barrier, which is
+ * then released for the next round.
+ */
+void
+ComputeUnit::execFunctionalWorkgroup(const std::vector<Wavefront*> &wfs,
+                                     int bar_id)
+{
+    bool at_barrier = true;
+
+    while (at_barrier) {
+        at_barrier = false;
+
+        for (auto *w : wfs) {
+            while (w->getStatus() == Wavefront::S_RUNNING) {
+                fetchStage.fetchUnit(w->simdId).fetchFunctional(w);
+                w->execFunctional();
+            }
+
+            if (w->getStatus() == Wavefront::S_BARRIER) {
+                at_barrier = true;
+            } else {
+                panic_if(w->getStatus() != Wavefront::S_STOPPED,
+                         "CU%d: functional WF[%d][%d] stalled with status "
+                         "%d\n", cu_id, w->simdId, w->wfSlotId,
+                         w->getStatus());
+            }
+        }
+
+        if (at_barrier) {
+            panic_if(!allAtBarrier(bar_id), "CU%d: functional WG deadlocked "
+                     "at barrier Id%d\n", cu_id, bar_id);
+
+            DPRINTF(GPUSync, "CU[%d] - All functional waves at barrier Id%d. "
+                    "Resetting barrier resources.\n", cu_id, bar_id);
+            resetBarrier(bar_id);
+            releaseWFsFromBarrier(bar_id);
+        }
+    }
 }
 
 void
@@ -790,6 +892,55 @@ ComputeUnit::exec()
     }
 }
 
+void
+ComputeUnit::execScheduledAdds()
+{
+    assert(!sa_when.empty());
+
+    // apply any scheduled adds
+    for (int i = 0; i < sa_n; ++i) {
+        if (sa_when[i] <= curTick()) {
+            *sa_val[i] += sa_x[i];
+            panic_if(*sa_val[i] < 0, "Negative counter value\n");
+            sa_val.erase(sa_val.begin() + i);
+            sa_x.erase(sa_x.begin() + i);
+            sa_when.erase(sa_when.begin() + i);
+            --sa_n;
+            --i;
+        }
+    }
+    if (!sa_when.empty()) {
+        Tick cu_wakeup = *std::max_element(sa_when.begin(),
+                 sa_when.end());
+        DPRINTF(GPUDisp, "CU%d: Scheduling scheduled adds wakeup at %lu\n",
+                cu_id, cu_wakeup);
+        schedule(scheduledAddsEvent, cu_wakeup);
+    } else {
+        DPRINTF(GPUDisp, "CU%d: sa_when empty, no more scheduled adds\n",
+                cu_id);
+    }
+}
+
+void
+ComputeUnit::ScheduleAdd(int *val, Tick when, int x)
+{
+    sa_val.push_back(val);
+    when += curTick();
+    sa_when.push_back(when);
+    sa_x.push_back(x);
+    ++sa_n;
+    if (!scheduledAddsEvent.scheduled() ||
+        (when < scheduledAddsEvent.when())) {
+        DPRINTF(GPUDisp, "CU%d: New scheduled add; scheduling wakeup at "
+                "%lu\n", cu_id, when);
+        reschedule(scheduledAddsEvent, when, true);
+    } else {
+        assert(scheduledAddsEvent.scheduled());
+        DPRINTF(GPUDisp, "CU%d: New scheduled add; wakeup already "
+                "scheduled at %lu\n", cu_id, when);
+    }
+}
+
 void
 ComputeUnit::init()
 {
@@ -1173,7 +1324,7 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
 
     PortID tlbPort_index = perLaneTLB ? index : 0;
 
-    if (shader->timingSim) {
+    if (shader->timingSim && !gpuDynInst->wavefront()->functional) {
         if (!FullSystem && debugSegFault) {
             Process *p = shader->gpuTc->getProcessPtr();
             Addr vaddr = pkt->req->getVaddr();
@@ -1298,6 +1449,10 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
 
         tlbPort[tlbPort_index].sendFunctional(pkt);
 
+        if (!functionalTLB) {
+            stats.tlbCycles += curTick();
+        }
+
         // the addr of the packet is not modified, so we need to create a new
         // packet, or otherwise the memory access will have the old virtual
         // address sent in the translation packet, instead of the physical
@@ -1306,7 +1461,11 @@ ComputeUnit::sendRequest(GPUDynInstPtr gpuDynInst, PortID index, PacketPtr pkt)
         new_pkt->dataStatic(pkt->getPtr<uint8_t>());
 
         // Translation is done. It is safe to send the packet to memory.
-        memPort[0].sendFunctional(new_pkt);
+        if (new_pkt->isAtomicOp()) {
+            sendFunctionalAtomic(memPort[0], new_pkt);
+        } else {
+            memPort[0].sendFunctional(new_pkt);
+        }
 
         DPRINTF(GPUMem, "Functional sendRequest\n");
         DPRINTF(GPUMem, "CU%d: WF[%d][%d]: index %d: addr %#x\n", cu_id,
@@ -1331,6 +1490,36 @@ ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
 
     BaseMMU::Mode tlb_mode = pkt->isRead() ? BaseMMU::Read : BaseMMU::Write;
 
+    if (gpuDynInst->wavefront()->functional) {
+        pkt->senderState = new GpuTranslationState(tlb_mode, shader->gpuTc);
+
+        scalarDTLBPort.sendFunctional(pkt);
+
+        GpuTranslationState *sender_state =
+             safe_cast<GpuTranslationState*>(pkt->senderState);
+
+        delete sender_state->tlbEntry;
+        delete sender_state;
+
+        if (!pkt->req->systemReq()) {
+            pkt->req->requestorId(vramRequestorId());
+        }
+
+        // the translation packet still carries the virtual address
+        PacketPtr new_pkt = new Packet(pkt->req, pkt->cmd);
+        new_pkt->dataStatic(pkt->getPtr<uint8_t>());
+
+        scalarDataPort.sendFunctional(new_pkt);
+
+        DPRINTF(GPUMem, "CU%d: WF[%d][%d]: Functional scalar request for "
+                "addr %#x\n", cu_id, gpuDynInst->simdId,
+                gpuDynInst->wfSlotId, new_pkt->req->getPaddr());
+
+        delete new_pkt;
+        delete pkt;
+        return;
+    }
+
     pkt->senderState =
         new ComputeUnit::ScalarDTLBPort::SenderState(gpuDynInst);
 
@@ -1351,6 +1540,28 @@ ComputeUnit::sendScalarRequest(GPUDynInstPtr gpuDynInst, PacketPtr pkt)
     }
 }
 
+/**
+ * The memory system does not perform atomic operations for functional
+ * accesses, so do the read-modify-write here. As for a timing atomic,
+ * the packet returns the data that was in memory before the operation.
+ */
+void
+ComputeUnit::sendFunctionalAtomic(RequestPort &port, PacketPtr pkt)
+{
+    std::vector<uint8_t> data(pkt->getSize());
+
+    Packet read_pkt(pkt->req, MemCmd::ReadReq);
+    read_pkt.dataStatic(data.data());
+    port.sendFunctional(&read_pkt);
+
+    pkt->setData(data.data());
+    (*pkt->getAtomicOp())(data.data());
+
+    Packet write_pkt(pkt->req, MemCmd::WriteReq);
+    write_pkt.dataStatic(data.data());
+    port.sendFunctional(&write_pkt);
+}
+
 void
 ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
                                   bool kernelMemSync,
@@ -1362,7 +1573,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
     // Fences will never be issued to system memory, so we can mark the
     // requestor as a device memory ID here.
     if (!req) {
-        req = std::make_shared<Request>(
+        req = Request::create(
             0, 0, 0, vramRequestorId(), 0, gpuDynInst->wfDynId);
     } else {
         req->requestorId(vramRequestorId());
@@ -1436,7 +1647,7 @@ ComputeUnit::injectGlobalMemFence(GPUDynInstPtr gpuDynInst,
 void
 ComputeUnit::sendInvL2(Addr paddr)
 {
-    auto req = std::make_shared<Request>(paddr, 64, 0, vramRequestorId());
+    auto req = Request::create(paddr, 64, 0, vramRequestorId());
     req->setCacheCoherenceFlags(Request::GL2_CACHE_INV);
 
     auto pkt = new Packet(req, MemCmd::MemSyncReq);
@@ -1643,7 +1854,7 @@ ComputeUnit::DTLBPort::recvTimingResp(PacketPtr pkt)
             if (!stride)
                 break;
 
-            RequestPtr prefetch_req = std::make_shared<Request>(
+            RequestPtr prefetch_req = Request::create(
                 vaddr + stride * pf * X86ISA::PageBytes,
                 sizeof(uint8_t), 0,
                 computeUnit->requestorId(),
@@ -2003,10 +2214,7 @@ ComputeUnit::updateInstStats(GPUDynInstPtr gpuDynInst)
         }
     } else {
         if (gpuDynInst->isALU()) {
-            shader->total_valu_insts++;
-            if (shader->total_valu_insts == shader->max_valu_insts) {
-                exitSimLoop("max vALU insts");
-            }
+            shader->incValuInsts();
             stats.vALUInsts++;
             stats.instCyclesVALU++;
             stats.threadCyclesVALU
@@ -2188,7 +2396,7 @@ ComputeUnit::sendToLds(GPUDynInstPtr gpuDynInst)
 {
     // this is just a request to carry the GPUDynInstPtr
     // back and forth
-    RequestPtr newRequest = std::make_shared<Request>();
+    RequestPtr newRequest = Request::create();
     newRequest->setPaddr(0x0);
 
     // ReadReq is not evaluted by the LDS but the Packet ctor requires this
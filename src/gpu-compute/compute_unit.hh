@@ -34,6 +34,8 @@
 
 #include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -287,6 +289,17 @@ class ComputeUnit : public ClockedObject
     ScalarMemPipeline scalarMemoryPipe;
 
     EventFunctionWrapper tickEvent;
+    EventFunctionWrapper scheduledAddsEvent;
+
+    // Size of scheduled add queue
+    uint32_t sa_n;
+
+    // Pointer to value to be increments
+    std::vector<int*> sa_val;
+    // When to do the increment
+    std::vector<uint64_t> sa_when;
+    // Amount to increment by
+    std::vector<int32_t> sa_x;
 
     typedef ComputeUnitParams Params;
     std::vector<std::vector<Wavefront*>> wfList;
@@ -402,6 +415,15 @@ class ComputeUnit : public ClockedObject
     int wfSize() const { return wavefrontSize; }
 
     void exec();
+
+    // Run CU scheduled adds
+    void execScheduledAdds();
+
+    // Schedule a 32-bit value to be incremented some time in the future.
+    // This lives in the CU rather than in the shader, so the counters of
+    // the wavefronts are only ever updated on the event queue of their CU.
+    void ScheduleAdd(int *val, Tick when, int x);
+
     void initiateFetch(Wavefront *wavefront);
     void fetch(PacketPtr pkt, Wavefront *wavefront);
     void fillKernelState(Wavefront *w, HSAQueueEntry *task);
@@ -423,6 +445,14 @@ class ComputeUnit : public ClockedObject
     void resetRegisterPool();
 
   private:
+    /**
+     * Run the WFs of a WG that belongs to a functional kernel launch to
+     * completion, one instruction at a time and without advancing time.
+     */
+    void execFunctionalWorkgroup(const std::vector<Wavefront*> &wfs,
+                                 int bar_id);
+    void sendFunctionalAtomic(RequestPort &port, PacketPtr pkt);
+
     WFBarrier&
     barrierSlot(int bar_id)
     {
@@ -966,6 +996,17 @@ class ComputeUnit : public ClockedObject
 
     InstSeqNum getAndIncSeqNum() { return globalSeqNum++; }
 
+    /**
+     * Get a zeroed buffer for the data of a GPUDynInst of this CU, large
+     * enough for its vector, atomic and scalar data (see
+     * dynInstDataSize()), and give it back once the instruction is gone.
+     * The buffers are carved out of slabs that are never freed, so the
+     * allocator is only hit when the number of instructions in flight
+     * reaches a new high.
+     */
+    uint8_t *allocDynInstData();
+    void freeDynInstData(uint8_t *data);
+
   private:
     const int _cacheLineSize;
     const int _numBarrierSlots;
@@ -973,6 +1014,15 @@ class ComputeUnit : public ClockedObject
     InstSeqNum globalSeqNum;
     int wavefrontSize;
 
+    // number of GPUDynInst data buffers per slab
+    static constexpr int dynInstDataSlabSize = 64;
+    size_t dynInstDataSize() const;
+    // the instructions may be released on the event queue of another
+    // object than the CU (e.g., when a TLB drops its packets)
+    std::mutex dynInstDataLock;
+    std::vector<std::unique_ptr<uint8_t[]>> dynInstDataSlabs;
+    std::vector<uint8_t*> freeDynInstDataBufs;
+
     /**
      * TODO: Update these comments once the pipe stage interface has
      *       been fully refactored.
@@ -32,6 +32,8 @@
 
 #include "gpu-compute/dispatcher.hh"
 
+#include <cmath>
+
 #include "debug/GPUAgentDisp.hh"
 #include "debug/GPUDisp.hh"
 #include "debug/GPUKernelInfo.hh"
@@ -52,7 +54,7 @@ GPUDispatcher::GPUDispatcher(const Params &p)
       tickEvent([this]{ exec(); },
           "GPU Dispatcher tick", false, Event::CPU_Tick_Pri),
       dispatchActive(false), kernelExitEvents(p.kernel_exit_events),
-      stats(this)
+      kernelSamples(p.kernel_samples), stats(this)
 {
     schedule(&tickEvent, 0);
 }
@@ -122,6 +124,10 @@ GPUDispatcher::dispatch(HSAQueueEntry *task)
     DPRINTF(GPUAgentDisp, "launching kernel: %s, dispatch ID: %d\n",
             task->kernelName(), task->dispatchId());
 
+    if (kernelSamples > 0) {
+        sampleKernelLaunch(task);
+    }
+
     execIds.push(task->dispatchId());
     dispatchActive = true;
     hsaQueueEntries.emplace(task->dispatchId(), task);
@@ -159,8 +165,9 @@ GPUDispatcher::exec()
         auto task = hsaQueueEntries[exec_id];
         bool launched(false);
 
-        // acq is needed before starting dispatch
-        if (shader->impl_kern_launch_acq) {
+        // acq is needed before starting dispatch, unless the kernel is
+        // functional: functional reads always observe the latest data
+        if (shader->impl_kern_launch_acq && !task->isFunctional()) {
             // try to invalidate cache
             shader->prepareInvalidate(task);
         } else {
@@ -246,6 +253,9 @@ GPUDispatcher::isReachingKernelEnd(Wavefront *wf)
  */
 void
 GPUDispatcher::updateInvCounter(int kern_id, int val) {
+    // Called by the CUs, which may run on their own event queues
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     assert(val == -1 || val == 1);
 
     auto task = hsaQueueEntries[kern_id];
@@ -266,6 +276,9 @@ GPUDispatcher::updateInvCounter(int kern_id, int val) {
  */
 bool
 GPUDispatcher::updateWbCounter(int kern_id, int val) {
+    // Called by the CUs, which may run on their own event queues
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     assert(val == -1 || val == 1);
 
     auto task = hsaQueueEntries[kern_id];
@@ -296,6 +309,9 @@ GPUDispatcher::getOutstandingWbs(int kernId) {
 void
 GPUDispatcher::notifyWgCompl(Wavefront *wf)
 {
+    // Called by the CUs, which may run on their own event queues
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     int kern_id = wf->kernId;
     DPRINTF(GPUDisp, "notify WgCompl %d\n", wf->wgId);
     auto task = hsaQueueEntries[kern_id];
@@ -323,6 +339,10 @@ GPUDispatcher::notifyWgCompl(Wavefront *wf)
                 curTick(), kern_id);
         DPRINTF(GPUKernelInfo, "Completed kernel %d\n", kern_id);
 
+        if (kernelSamples > 0) {
+            sampleKernelCompl(task);
+        }
+
         if (kernelExitEvents) {
             shader->requestKernelExitEvent(task->completionSignal());
         }
@@ -341,13 +361,150 @@ GPUDispatcher::scheduleDispatch()
     }
 }
 
+double
+GPUDispatcher::KernelClass::meanTicks() const
+{
+    return samplesDone ? sumTicks / samplesDone : 0;
+}
+
+double
+GPUDispatcher::KernelClass::varianceTicks() const
+{
+    if (samplesDone < 2)
+        return 0;
+
+    double mean = meanTicks();
+    double var = (sumSqTicks - samplesDone * mean * mean) /
+                 (samplesDone - 1);
+    return var > 0 ? var : 0;
+}
+
+GPUDispatcher::KernelFingerprint
+GPUDispatcher::fingerprint(HSAQueueEntry *task) const
+{
+    /**
+     * The kernarg layout is fixed by the code object, so the argument
+     * values are left out of the fingerprint: launches of the same kernel
+     * with the same shape and segment sizes are assumed to behave alike.
+     */
+    return {
+        task->codeAddr(),
+        (uint64_t)task->gridSize(0), (uint64_t)task->gridSize(1),
+        (uint64_t)task->gridSize(2),
+        (uint64_t)task->wgSize(0), (uint64_t)task->wgSize(1),
+        (uint64_t)task->wgSize(2),
+        (uint64_t)task->ldsSize(), (uint64_t)task->privMemPerItem()
+    };
+}
+
+void
+GPUDispatcher::sampleKernelLaunch(HSAQueueEntry *task)
+{
+    // the kernel was already made functional by the CP
+    if (task->isFunctional())
+        return;
+
+    auto [it, inserted] = kernelClasses.try_emplace(fingerprint(task));
+    KernelClass &kern_class = it->second;
+
+    if (inserted) {
+        ++stats.kernelClasses;
+    }
+
+    /**
+     * Launches that arrive while the samples of their class are still
+     * in flight are simulated in detail as well: there is no measured
+     * duration to extrapolate from yet.
+     */
+    bool sampled = kern_class.samplesDone < kernelSamples;
+
+    if (!sampled) {
+        task->setFunctional(true);
+    }
+
+    DPRINTF(GPUKernelInfo, "Kernel %d (%s) %s, class samples: %d\n",
+            task->dispatchId(), task->kernelName(),
+            sampled ? "sampled" : "extrapolated", kern_class.samplesDone);
+
+    kernelLaunches[task->dispatchId()] = {&kern_class, curTick(), sampled};
+}
+
+void
+GPUDispatcher::sampleKernelCompl(HSAQueueEntry *task)
+{
+    auto it = kernelLaunches.find(task->dispatchId());
+
+    if (it == kernelLaunches.end())
+        return;
+
+    KernelLaunch &launch = it->second;
+    KernelClass &kern_class = *launch.kernClass;
+
+    if (launch.sampled) {
+        double ticks = curTick() - launch.launchTick;
+        ++kern_class.samplesDone;
+        kern_class.sumTicks += ticks;
+        kern_class.sumSqTicks += ticks * ticks;
+        ++stats.sampledKernels;
+        stats.sampledKernelTicks += ticks;
+    } else {
+        ++kern_class.extrapolated;
+        ++stats.extrapolatedKernels;
+        stats.extrapolatedKernelTicks += kern_class.meanTicks();
+    }
+
+    kernelLaunches.erase(it);
+}
+
+/**
+ * Relative standard error of the estimated total kernel time. Each
+ * extrapolated launch is charged the sample mean of its class, so the
+ * error on a class with k extrapolated launches, n samples and sample
+ * variance s^2 is k * s / sqrt(n).
+ */
+double
+GPUDispatcher::extrapolationError() const
+{
+    double total = stats.sampledKernelTicks.value() +
+                   stats.extrapolatedKernelTicks.value();
+
+    if (total == 0)
+        return 0;
+
+    double var = 0;
+    for (const auto &[fp, kern_class] : kernelClasses) {
+        if (kern_class.samplesDone == 0 || kern_class.extrapolated == 0)
+            continue;
+        double k = kern_class.extrapolated;
+        var += k * k * kern_class.varianceTicks() / kern_class.samplesDone;
+    }
+
+    return std::sqrt(var) / total;
+}
+
 GPUDispatcher::GPUDispatcherStats::GPUDispatcherStats(
-    statistics::Group *parent)
+    GPUDispatcher *parent)
     : statistics::Group(parent),
       ADD_STAT(numKernelLaunched, "number of kernel launched"),
       ADD_STAT(cyclesWaitingForDispatch, "number of cycles with outstanding "
-               "wavefronts that are waiting to be dispatched")
+               "wavefronts that are waiting to be dispatched"),
+      ADD_STAT(kernelClasses, "number of distinct kernel classes seen by "
+               "kernel sampling"),
+      ADD_STAT(sampledKernels, "number of kernels simulated in detail"),
+      ADD_STAT(extrapolatedKernels, "number of kernels executed "
+               "functionally with extrapolated timing"),
+      ADD_STAT(sampledKernelTicks, "total ticks of the sampled kernels"),
+      ADD_STAT(extrapolatedKernelTicks, "estimated total ticks of the "
+               "extrapolated kernels"),
+      ADD_STAT(sampleCoverage, "fraction of the completed kernels that "
+               "were simulated in detail"),
+      ADD_STAT(extrapolationError, "estimated relative standard error of "
+               "the total kernel time")
 {
+    sampleCoverage = sampledKernels / (sampledKernels + extrapolatedKernels);
+    extrapolationError.functor([parent]{
+        return parent->extrapolationError();
+    });
 }
 
 } // namespace gem5
@@ -41,6 +41,8 @@
 #ifndef __GPU_COMPUTE_DISPATCHER_HH__
 #define __GPU_COMPUTE_DISPATCHER_HH__
 
+#include <array>
+#include <map>
 #include <queue>
 #include <unordered_map>
 #include <vector>
@@ -95,13 +97,62 @@ class GPUDispatcher : public SimObject
     // Enable exiting sim loop after each kernel completion
     bool kernelExitEvents;
 
+    /**
+     * Kernel sampling. Launches are grouped into classes of identical
+     * kernels: same code object, same grid and WG shape and same segment
+     * sizes. The first kernelSamples launches of each class are simulated
+     * in detail, the remaining ones execute functionally and their timing
+     * is extrapolated from the mean duration of the detailed samples.
+     * Sampling is disabled when kernelSamples is 0.
+     */
+    typedef std::array<uint64_t, 9> KernelFingerprint;
+
+    struct KernelClass
+    {
+        // number of completed detailed launches
+        int samplesDone = 0;
+        // sum and sum of squares of the sampled durations, in ticks
+        double sumTicks = 0;
+        double sumSqTicks = 0;
+        // number of launches whose timing is extrapolated
+        int extrapolated = 0;
+
+        double meanTicks() const;
+        double varianceTicks() const;
+    };
+
+    struct KernelLaunch
+    {
+        KernelClass *kernClass;
+        Tick launchTick;
+        bool sampled;
+    };
+
+    int kernelSamples;
+    std::map<KernelFingerprint, KernelClass> kernelClasses;
+    // launch records of the kernels in flight, indexed by dispatch ID
+    std::unordered_map<int, KernelLaunch> kernelLaunches;
+
+    KernelFingerprint fingerprint(HSAQueueEntry *task) const;
+    void sampleKernelLaunch(HSAQueueEntry *task);
+    void sampleKernelCompl(HSAQueueEntry *task);
+    double extrapolationError() const;
+
   protected:
     struct GPUDispatcherStats : public statistics::Group
     {
-        GPUDispatcherStats(statistics::Group *parent);
+        GPUDispatcherStats(GPUDispatcher *parent);
 
         statistics::Scalar numKernelLaunched;
         statistics::Scalar cyclesWaitingForDispatch;
+
+        statistics::Scalar kernelClasses;
+        statistics::Scalar sampledKernels;
+        statistics::Scalar extrapolatedKernels;
+        statistics::Scalar sampledKernelTicks;
+        statistics::Scalar extrapolatedKernelTicks;
+        statistics::Formula sampleCoverage;
+        statistics::Value extrapolationError;
     } stats;
 };
 
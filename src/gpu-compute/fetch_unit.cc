@@ -31,6 +31,8 @@
 
 #include "gpu-compute/fetch_unit.hh"
 
+#include <algorithm>
+
 #include "arch/amdgpu/common/gpu_translation_state.hh"
 #include "arch/amdgpu/common/tlb.hh"
 #include "base/bitfield.hh"
@@ -162,7 +164,7 @@ FetchUnit::initiateFetch(Wavefront *wavefront)
             computeUnit.cu_id, wavefront->simdId, wavefront->wfSlotId, vaddr);
 
     // set up virtual request
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         vaddr, computeUnit.cacheLineSize(), Request::INST_FETCH,
         computeUnit.requestorId(), 0, 0, nullptr);
 
@@ -329,6 +331,86 @@ FetchUnit::processFetchReturn(PacketPtr pkt)
     delete pkt;
 }
 
+/**
+ * Fetch and decode the instruction at the PC of a WF that belongs to a
+ * functional kernel launch. The fetch buffer is bypassed: the raw
+ * instruction is read with functional ITLB and SQC accesses, and the
+ * decoded instruction is placed directly in the WF's instruction buffer.
+ */
+void
+FetchUnit::fetchFunctional(Wavefront *wavefront)
+{
+    assert(wavefront->functional);
+    assert(wavefront->instructionBuffer.empty());
+
+    TheGpuISA::RawMachInst raw_inst = 0;
+    uint8_t *inst_buf = reinterpret_cast<uint8_t*>(&raw_inst);
+
+    // read the largest possible instruction; it may straddle two lines
+    Addr vaddr = wavefront->pc();
+    Addr inst_end = vaddr + sizeof(raw_inst);
+
+    while (vaddr < inst_end) {
+        Addr line_end = ruby::makeLineAddress(vaddr,
+            computeUnit.getCacheLineBits()) + computeUnit.cacheLineSize();
+        unsigned size = std::min(inst_end, line_end) - vaddr;
+
+        readFunctional(vaddr, size, inst_buf);
+
+        inst_buf += size;
+        vaddr += size;
+    }
+
+    TheGpuISA::MachInst mach_inst
+        = reinterpret_cast<TheGpuISA::MachInst>(&raw_inst);
+    GPUStaticInst *gpu_static_inst = decoder.decode(mach_inst);
+
+    GPUDynInstPtr gpu_dyn_inst
+        = std::make_shared<GPUDynInst>(&computeUnit, wavefront,
+                                       gpu_static_inst,
+                                       computeUnit.getAndIncSeqNum());
+    wavefront->instructionBuffer.push_back(gpu_dyn_inst);
+
+    DPRINTF(GPUFetch, "CU%d: WF[%d][%d]: Id%d: Functionally fetched %s "
+            "(%d bytes) from pc: %#x\n", computeUnit.cu_id,
+            wavefront->simdId, wavefront->wfSlotId, wavefront->wfDynId,
+            gpu_static_inst->disassemble(), gpu_static_inst->instSize(),
+            wavefront->pc());
+}
+
+void
+FetchUnit::readFunctional(Addr vaddr, unsigned size, uint8_t *data)
+{
+    RequestPtr req = Request::create(vaddr, size, Request::INST_FETCH,
+        computeUnit.requestorId(), 0, 0, nullptr);
+
+    PacketPtr pkt = new Packet(req, MemCmd::ReadReq);
+    pkt->senderState =
+        new GpuTranslationState(BaseMMU::Execute, computeUnit.shader->gpuTc);
+
+    computeUnit.sqcTLBPort.sendFunctional(pkt);
+
+    GpuTranslationState *sender_state =
+         safe_cast<GpuTranslationState*>(pkt->senderState);
+
+    delete sender_state->tlbEntry;
+    delete sender_state;
+    delete pkt;
+
+    /**
+     * For full system, if this is a device request we need to set the
+     * requestor ID of the packet to the GPU memory manager so it is routed
+     * through Ruby as a memory request and not a PIO request.
+     */
+    if (!req->systemReq()) {
+        req->requestorId(computeUnit.vramRequestorId());
+    }
+
+    Packet data_pkt(req, MemCmd::ReadReq);
+    data_pkt.dataStatic(data);
+    computeUnit.sqcPort.sendFunctional(&data_pkt);
+}
+
 void
 FetchUnit::flushBuf(int wfSlotId)
 {
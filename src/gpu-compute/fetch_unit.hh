@@ -63,6 +63,7 @@ class FetchUnit
     void initiateFetch(Wavefront *wavefront);
     void fetch(PacketPtr pkt, Wavefront *wavefront);
     void processFetchReturn(PacketPtr pkt);
+    void fetchFunctional(Wavefront *wavefront);
     void flushBuf(int wfSlotId);
     static uint32_t globalFetchUnitID;
 
@@ -254,6 +255,8 @@ class FetchUnit
         void process();
     };
 
+    void readFunctional(Addr vaddr, unsigned size, uint8_t *data);
+
     bool timingSim;
     ComputeUnit &computeUnit;
     TheGpuISA::Decoder decoder;
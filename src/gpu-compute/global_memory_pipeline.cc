@@ -150,16 +150,16 @@ GlobalMemPipeline::exec()
         Tick accessTime = curTick() - m->getAccessTime();
 
         // Decrement outstanding requests count
-        computeUnit.shader->ScheduleAdd(&w->outstandingReqs, m->time, -1);
+        computeUnit.ScheduleAdd(&w->outstandingReqs, m->time, -1);
         if (m->isStore() || m->isAtomic() || m->isMemSync()) {
             computeUnit.shader->sampleStore(accessTime);
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsWrGm,
+            computeUnit.ScheduleAdd(&w->outstandingReqsWrGm,
                                              m->time, -1);
         }
 
         if (m->isLoad() || m->isAtomic() || m->isMemSync()) {
             computeUnit.shader->sampleLoad(accessTime);
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsRdGm,
+            computeUnit.ScheduleAdd(&w->outstandingReqsRdGm,
                                              m->time, -1);
         }
 
@@ -296,11 +296,61 @@ GlobalMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
     wf->outstandingReqs++;
     wf->validateRequestCounters();
 
+    if (wf->functional) {
+        completeFunctional(gpuDynInst);
+        return;
+    }
+
     gpuDynInst->setAccessTime(curTick());
     gpuDynInst->profileRoundTripTime(curTick(), InstMemoryHop::Initiate);
     gmIssuedRequests.push(gpuDynInst);
 }
 
+/**
+ * The memory accesses of a functional WF are performed as soon as the
+ * instruction is issued, and the instruction completes right away. The
+ * memory system only ever holds the latest data when accessed
+ * functionally, so there is nothing for a memory fence to do.
+ */
+void
+GlobalMemPipeline::completeFunctional(GPUDynInstPtr gpuDynInst)
+{
+    Wavefront *wf = gpuDynInst->wavefront();
+
+    DPRINTF(GPUMem, "CU%d: WF[%d][%d]: Functional global mem instr %s\n",
+            gpuDynInst->cu_id, gpuDynInst->simdId, gpuDynInst->wfSlotId,
+            gpuDynInst->disassemble());
+
+    if (!gpuDynInst->isMemSync()) {
+        gpuDynInst->initiateAcc(gpuDynInst);
+    }
+
+    if (gpuDynInst->isStore() && gpuDynInst->isGlobalSeg()) {
+        wf->decExpInstsIssued();
+    }
+
+    if (!gpuDynInst->isMemSync()) {
+        gpuDynInst->completeAcc(gpuDynInst);
+    }
+
+    if (gpuDynInst->isFlat()) {
+        wf->decLGKMInstsIssued();
+    }
+    wf->decVMemInstsIssued();
+
+    wf->outstandingReqs--;
+    if (gpuDynInst->isStore() || gpuDynInst->isAtomic() ||
+        gpuDynInst->isMemSync()) {
+        wf->outstandingReqsWrGm--;
+    }
+    if (gpuDynInst->isLoad() || gpuDynInst->isAtomic() ||
+        gpuDynInst->isMemSync()) {
+        wf->outstandingReqsRdGm--;
+    }
+
+    wf->validateRequestCounters();
+}
+
 void
 GlobalMemPipeline::handleResponse(GPUDynInstPtr gpuDynInst)
 {
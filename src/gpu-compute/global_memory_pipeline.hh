@@ -110,6 +110,9 @@ class GlobalMemPipeline
     void acqCoalescerToken(GPUDynInstPtr mp);
 
   private:
+    /** Perform the accesses of a functional WF's instruction. */
+    void completeFunctional(GPUDynInstPtr gpuDynInst);
+
     ComputeUnit &computeUnit;
     const std::string _name;
     int gmQueueSize;
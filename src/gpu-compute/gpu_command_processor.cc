@@ -59,8 +59,12 @@ namespace gem5
 GPUCommandProcessor::GPUCommandProcessor(const Params &p)
     : DmaVirtDevice(p), dispatcher(*p.dispatcher), _driver(nullptr),
       walker(p.walker), hsaPP(p.hsapp),
-      target_non_blit_kernel_id(p.target_non_blit_kernel_id)
+      target_non_blit_kernel_id(p.target_non_blit_kernel_id),
+      functional_non_blit_kernel_id(p.functional_non_blit_kernel_id)
 {
+    fatal_if(FullSystem && functional_non_blit_kernel_id,
+             "Functional GPU kernels are only supported in SE mode\n");
+
     assert(hsaPP);
     hsaPP->setDevice(this);
     dispatcher.setCommandProcessor(this);
@@ -233,7 +237,7 @@ GPUCommandProcessor::submitDispatchPkt(void *raw_pkt, uint32_t queue_id,
                     dummy, BaseMMU::Mode::Read, is_system_page);
 
                 Request::Flags flags = Request::PHYSICAL;
-                RequestPtr request = std::make_shared<Request>(chunk_addr,
+                RequestPtr request = Request::create(chunk_addr,
                     akc_alignment_granularity, flags,
                     walker->getDevRequestor());
                 Packet *readPkt = new Packet(request, MemCmd::ReadReq);
@@ -340,6 +344,21 @@ GPUCommandProcessor::dispatchKernelObject(AMDKernelCode *akc, void *raw_pkt,
         "LDS size: %d)\n", kernel_name, task->numVectorRegs(),
         task->numScalarRegs(), task->codeAddr(), 0, 0);
 
+    /**
+     * Fast-forward through the kernels that come before the functional
+     * target kernel: their WGs are executed functionally as soon as they
+     * are dispatched. Once the target kernel is reached, tell the run
+     * script that timing simulation of the kernels starts.
+     */
+    if (non_blit_kernel_id < functional_non_blit_kernel_id) {
+        DPRINTF(GPUCommandProc, "Executing kernel functionally (Task ID: "
+                "%i)\n", dynamic_task_id);
+        task->setFunctional(true);
+    } else if (!is_blit_kernel && functional_non_blit_kernel_id &&
+               non_blit_kernel_id == functional_non_blit_kernel_id) {
+        exitSimLoop("GPU Functional Kernels Done");
+    }
+
     initABI(task);
     ++dynamic_task_id;
     if (!is_blit_kernel) ++non_blit_kernel_id;
@@ -161,6 +161,9 @@ class GPUCommandProcessor : public DmaVirtDevice
     // Skip all user (non-blit) kernels until reaching this kernel
     int target_non_blit_kernel_id = 0;
 
+    // Execute all kernels functionally until reaching this user kernel
+    int functional_non_blit_kernel_id = 0;
+
     // Keep track of start times for task dispatches.
     std::unordered_map<Addr, Tick> dispatchStartTime;
 
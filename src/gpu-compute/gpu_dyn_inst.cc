@@ -43,31 +43,22 @@ namespace gem5
 
 GPUDynInst::GPUDynInst(ComputeUnit *_cu, Wavefront *_wf,
                        GPUStaticInst *static_inst, InstSeqNum instSeqNum)
-    : GPUExecContext(_cu, _wf), scalarAddr(0), addr(computeUnit()->wfSize(),
-      (Addr)0), numScalarReqs(0), isSaveRestore(false),
-      _staticInst(static_inst), _seqNum(instSeqNum),
+    : GPUExecContext(_cu, _wf), scalarAddr(0), numScalarReqs(0),
+      isSaveRestore(false), _staticInst(static_inst), _seqNum(instSeqNum),
       maxSrcVecRegOpSize(-1), maxSrcScalarRegOpSize(-1)
 {
     _staticInst->initOperandInfo();
-    statusVector.assign(TheGpuISA::NumVecElemPerVecReg, 0);
-    tlbHitLevel.assign(computeUnit()->wfSize(), -1);
-    // vector instructions can have up to 4 source/destination operands
-    d_data = new uint8_t[computeUnit()->wfSize() * 4 * sizeof(double)];
-    a_data = new uint8_t[computeUnit()->wfSize() * 8];
-    x_data = new uint8_t[computeUnit()->wfSize() * 8];
-    // scalar loads can read up to 16 Dwords of data (see publicly
-    // available Vega ISA manual)
-    scalar_data = new uint8_t[16 * sizeof(uint32_t)];
-    for (int i = 0; i < (16 * sizeof(uint32_t)); ++i) {
-        scalar_data[i] = 0;
-    }
-    for (int i = 0; i < (computeUnit()->wfSize() * 8); ++i) {
-        a_data[i] = 0;
-        x_data[i] = 0;
-    }
-    for (int i = 0; i < (computeUnit()->wfSize() * 4 * sizeof(double)); ++i) {
-        d_data[i] = 0;
-    }
+    addr.fill(0);
+    statusVector.fill(0);
+    tlbHitLevel.fill(-1);
+    // vector instructions can have up to 4 source/destination operands,
+    // atomics need additional data and scalar loads can read up to 16
+    // Dwords of data (see publicly available Vega ISA manual). All of
+    // them share one zeroed buffer from the pool of the CU.
+    d_data = computeUnit()->allocDynInstData();
+    a_data = d_data + computeUnit()->wfSize() * 4 * sizeof(double);
+    x_data = a_data + computeUnit()->wfSize() * 8;
+    scalar_data = x_data + computeUnit()->wfSize() * 8;
     time = 0;
 
     cu_id = _cu->cu_id;
@@ -95,10 +86,7 @@ GPUDynInst::GPUDynInst(ComputeUnit *_cu, Wavefront *_wf,
 
 GPUDynInst::~GPUDynInst()
 {
-    delete[] d_data;
-    delete[] a_data;
-    delete[] x_data;
-    delete[] scalar_data;
+    computeUnit()->freeDynInstData(d_data);
     delete _staticInst;
 }
 
@@ -32,6 +32,7 @@
 #ifndef __GPU_DYN_INST_HH__
 #define __GPU_DYN_INST_HH__
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -168,10 +169,11 @@ class GPUDynInst : public GPUExecContext
     // virtual address for scalar memory operations
     Addr scalarAddr;
     // virtual addressies for vector memory operations
-    std::vector<Addr> addr;
+    std::array<Addr, TheGpuISA::NumVecElemPerVecReg> addr;
     Addr pAddr;
 
-    // vector data to get written
+    // vector data to get written. The data buffers below are carved out
+    // of a single buffer taken from the pool of the CU
     uint8_t *d_data;
     // scalar data to be transferred
     uint8_t *scalar_data;
@@ -459,9 +461,9 @@ class GPUDynInst : public GPUExecContext
 
     // Track the status of memory requests per lane, an int per lane to allow
     // unaligned accesses
-    std::vector<int> statusVector;
+    std::array<int, TheGpuISA::NumVecElemPerVecReg> statusVector;
     // for ld_v# or st_v#
-    std::vector<int> tlbHitLevel;
+    std::array<int, TheGpuISA::NumVecElemPerVecReg> tlbHitLevel;
 
     // for misaligned scalar ops we track the number
     // of outstanding reqs here
@@ -83,7 +83,7 @@ class HSAQueueEntry
                          private_segment_size),
           _contextId(0), _wgId{{ 0, 0, 0 }},
           _numWgTotal(1), numWgArrivedAtBarrier(0), _numWgCompleted(0),
-          _globalWgId(0), dispatchComplete(false)
+          _globalWgId(0), dispatchComplete(false), _functional(false)
 
     {
         // Use the resource descriptors to determine number of GPRs. This will
@@ -407,6 +407,23 @@ class HSAQueueEntry
         return _accumOffset;
     }
 
+    /**
+     * Whether the kernel is executed functionally, i.e., its WGs run
+     * to completion as soon as they are dispatched, without modeling
+     * any pipeline or memory timing.
+     */
+    bool
+    isFunctional() const
+    {
+        return _functional;
+    }
+
+    void
+    setFunctional(bool functional)
+    {
+        _functional = functional;
+    }
+
   private:
     void
     parseKernelCode(AMDKernelCode *akc)
@@ -499,6 +516,8 @@ class HSAQueueEntry
     int _numWgCompleted;
     int _globalWgId;
     bool dispatchComplete;
+    // execute the kernel in functional mode
+    bool _functional;
 
     std::bitset<NumVectorInitFields> initialVgprState;
     std::bitset<NumScalarInitFields> initialSgprState;
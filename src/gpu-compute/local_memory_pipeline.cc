@@ -90,15 +90,15 @@ LocalMemPipeline::exec()
         }
 
         // Decrement outstanding request count
-        computeUnit.shader->ScheduleAdd(&w->outstandingReqs, m->time, -1);
+        computeUnit.ScheduleAdd(&w->outstandingReqs, m->time, -1);
 
         if (m->isStore() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsWrLm,
+            computeUnit.ScheduleAdd(&w->outstandingReqsWrLm,
                                              m->time, -1);
         }
 
         if (m->isLoad() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->outstandingReqsRdLm,
+            computeUnit.ScheduleAdd(&w->outstandingReqsRdLm,
                                              m->time, -1);
         }
 
@@ -144,10 +144,46 @@ LocalMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
     wf->outstandingReqs++;
     wf->validateRequestCounters();
 
+    if (wf->functional) {
+        completeFunctional(gpuDynInst);
+        return;
+    }
+
     gpuDynInst->setAccessTime(curTick());
     lmIssuedRequests.push(gpuDynInst);
 }
 
+/**
+ * LDS instructions of a functional WF access the WG's LDS chunk as soon
+ * as they are issued, without going through the LDS port, and complete
+ * right away.
+ */
+void
+LocalMemPipeline::completeFunctional(GPUDynInstPtr gpuDynInst)
+{
+    Wavefront *wf = gpuDynInst->wavefront();
+
+    DPRINTF(GPUMem, "CU%d: WF[%d][%d]: Functional local mem instr %s\n",
+            gpuDynInst->cu_id, gpuDynInst->simdId, gpuDynInst->wfSlotId,
+            gpuDynInst->disassemble());
+
+    if (!gpuDynInst->isMemSync()) {
+        gpuDynInst->initiateAcc(gpuDynInst);
+        gpuDynInst->completeAcc(gpuDynInst);
+    }
+    wf->decLGKMInstsIssued();
+
+    wf->outstandingReqs--;
+    if (gpuDynInst->isStore() || gpuDynInst->isAtomic()) {
+        wf->outstandingReqsWrLm--;
+    }
+    if (gpuDynInst->isLoad() || gpuDynInst->isAtomic()) {
+        wf->outstandingReqsRdLm--;
+    }
+
+    wf->validateRequestCounters();
+}
+
 
 LocalMemPipeline::
 LocalMemPipelineStats::LocalMemPipelineStats(statistics::Group *parent)
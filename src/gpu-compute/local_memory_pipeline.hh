@@ -85,6 +85,9 @@ class LocalMemPipeline
     }
 
   private:
+    /** Perform the accesses of a functional WF's instruction. */
+    void completeFunctional(GPUDynInstPtr gpuDynInst);
+
     ComputeUnit &computeUnit;
     const std::string _name;
     int lmQueueSize;
@@ -53,7 +53,7 @@ RegisterFile::RegisterFile(const RegisterFileParams &p)
     fatal_if(simdId < 0, "Illegal SIMD id for VRF");
 
     busy.clear();
-    busy.resize(_numRegs, 0);
+    busy.resize(divCeil(_numRegs, 64), 0);
 }
 
 RegisterFile::~RegisterFile()
@@ -71,8 +71,8 @@ RegisterFile::dump() const
 {
     std::stringstream ss;
     ss << "Busy: ";
-    for (int i = 0; i < busy.size(); i++) {
-        ss << (int)busy[i];
+    for (int i = 0; i < _numRegs; i++) {
+        ss << (int)regBusy(i);
     }
     ss << "\n";
     return ss.str();
@@ -89,7 +89,23 @@ RegisterFile::operandsReady(Wavefront *w, GPUDynInstPtr ii) const
 bool
 RegisterFile::regBusy(int idx) const
 {
-    return busy.at(idx);
+    assert(idx >= 0 && idx < _numRegs);
+    return bits(busy[idx / 64], idx % 64);
+}
+
+bool
+RegisterFile::anyRegBusy(int startIdx, int count) const
+{
+    assert(startIdx >= 0 && startIdx + count <= _numRegs);
+    int idx = startIdx;
+    const int end = startIdx + count;
+    while (idx < end) {
+        const int width = std::min(64 - idx % 64, end - idx);
+        if (bits(busy[idx / 64], idx % 64 + width - 1, idx % 64))
+            return true;
+        idx += width;
+    }
+    return false;
 }
 
 void
@@ -97,7 +113,8 @@ RegisterFile::markReg(int regIdx, bool value)
 {
     DPRINTF(GPURF, "SIMD[%d] markReg(): physReg[%d] = %d\n",
             simdId, regIdx, (int)value);
-    busy.at(regIdx) = value;
+    assert(regIdx >= 0 && regIdx < _numRegs);
+    replaceBits(busy[regIdx / 64], regIdx % 64, value);
 }
 
 void
@@ -203,7 +220,11 @@ RegisterFile::RegisterFileStats::RegisterFileStats(statistics::Group *parent)
       ADD_STAT(sramReads,
               "Total number of register file bank SRAM activations for reads"),
       ADD_STAT(sramWrites,
-              "Total number of register file bank SRAM activations for writes")
+              "Total number of register file bank SRAM activations for "
+              "writes"),
+      ADD_STAT(bankConflicts,
+              "Number of times an instruction was not scheduled because of a "
+              "register bank conflict")
 {
 }
 
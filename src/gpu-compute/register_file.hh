@@ -67,6 +67,8 @@ class RegisterFile : public SimObject
     virtual bool operandsReady(Wavefront *w, GPUDynInstPtr ii) const;
     virtual bool regBusy(int idx) const;
     virtual void markReg(int regIdx, bool value);
+    // True if any of the count registers starting at startIdx is busy
+    bool anyRegBusy(int startIdx, int count) const;
 
     // Abstract Register Event
     class RegisterEvent : public Event
@@ -146,8 +148,9 @@ class RegisterFile : public SimObject
     ComputeUnit* computeUnit;
     int simdId;
 
-    // flag indicating if a register is busy
-    std::vector<bool> busy;
+    // flags indicating if a register is busy, 64 registers per word so
+    // that the whole register range of a wavefront can be tested at once
+    std::vector<uint64_t> busy;
 
     // numer of registers in this register file
     int _numRegs;
@@ -171,6 +174,10 @@ class RegisterFile : public SimObject
         statistics::Scalar sramReads;
         // Number of register file SRAM activations for writes
         statistics::Scalar sramWrites;
+
+        // Number of times an instruction could not be scheduled because
+        // it read a bank already read in the same cycle
+        statistics::Scalar bankConflicts;
     } stats;
 };
 
@@ -97,15 +97,15 @@ ScalarMemPipeline::exec()
         }
 
         // Decrement outstanding register count
-        computeUnit.shader->ScheduleAdd(&w->outstandingReqs, m->time, -1);
+        computeUnit.ScheduleAdd(&w->outstandingReqs, m->time, -1);
 
         if (m->isStore() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->scalarOutstandingReqsWrGm,
+            computeUnit.ScheduleAdd(&w->scalarOutstandingReqsWrGm,
                                              m->time, -1);
         }
 
         if (m->isLoad() || m->isAtomic()) {
-            computeUnit.shader->ScheduleAdd(&w->scalarOutstandingReqsRdGm,
+            computeUnit.ScheduleAdd(&w->scalarOutstandingReqsRdGm,
                                              m->time, -1);
         }
 
@@ -157,9 +157,44 @@ ScalarMemPipeline::issueRequest(GPUDynInstPtr gpuDynInst)
     wf->outstandingReqs++;
     wf->validateRequestCounters();
 
+    if (wf->functional) {
+        completeFunctional(gpuDynInst);
+        return;
+    }
+
     issuedRequests.push(gpuDynInst);
 }
 
+/**
+ * The scalar memory accesses of a functional WF are performed as soon as
+ * the instruction is issued, and the instruction completes right away.
+ */
+void
+ScalarMemPipeline::completeFunctional(GPUDynInstPtr gpuDynInst)
+{
+    Wavefront *wf = gpuDynInst->wavefront();
+
+    DPRINTF(GPUMem, "CU%d: WF[%d][%d]: Functional scalar mem instr %s\n",
+            gpuDynInst->cu_id, gpuDynInst->simdId, gpuDynInst->wfSlotId,
+            gpuDynInst->disassemble());
+
+    if (!gpuDynInst->isMemSync()) {
+        gpuDynInst->initiateAcc(gpuDynInst);
+        gpuDynInst->completeAcc(gpuDynInst);
+    }
+    wf->decLGKMInstsIssued();
+
+    wf->outstandingReqs--;
+    if (gpuDynInst->isStore() || gpuDynInst->isAtomic()) {
+        wf->scalarOutstandingReqsWrGm--;
+    }
+    if (gpuDynInst->isLoad() || gpuDynInst->isAtomic()) {
+        wf->scalarOutstandingReqsRdGm--;
+    }
+
+    wf->validateRequestCounters();
+}
+
 void
 ScalarMemPipeline::injectScalarMemFence(GPUDynInstPtr gpuDynInst,
                                         bool kernelMemSync,
@@ -168,7 +203,7 @@ ScalarMemPipeline::injectScalarMemFence(GPUDynInstPtr gpuDynInst,
     assert(gpuDynInst->isScalar());
 
     if (!req) {
-        req = std::make_shared<Request>(
+        req = Request::create(
                 0, 0, 0, computeUnit.requestorId(), 0, gpuDynInst->wfDynId);
     } else {
         req->requestorId(computeUnit.requestorId());
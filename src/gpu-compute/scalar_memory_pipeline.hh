@@ -92,6 +92,9 @@ class ScalarMemPipeline
     const std::string& name() const { return _name; }
 
   private:
+    /** Perform the accesses of a functional WF's instruction. */
+    void completeFunctional(GPUDynInstPtr gpuDynInst);
+
     ComputeUnit &computeUnit;
     const std::string _name;
     int queueSize;
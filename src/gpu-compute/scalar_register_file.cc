@@ -51,6 +51,14 @@ ScalarRegisterFile::ScalarRegisterFile(const ScalarRegisterFileParams &p)
 bool
 ScalarRegisterFile::operandsReady(Wavefront *w, GPUDynInstPtr ii) const
 {
+    // Most of the time, none of the registers of the wavefront is
+    // waiting for a write back, so there is no need to look at the
+    // individual operands
+    if (w->startSgprIndex + w->reservedScalarRegs <= numRegs() &&
+        !anyRegBusy(w->startSgprIndex, w->reservedScalarRegs)) {
+        return true;
+    }
+
     for (const auto& srcScalarOp : ii->srcScalarRegOperands()) {
         for (const auto& physIdx : srcScalarOp.physIndices()) {
             if (regBusy(physIdx)) {
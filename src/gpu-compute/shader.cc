@@ -57,8 +57,6 @@ namespace gem5
 Shader::Shader(const Params &p) : ClockedObject(p),
     _activeCus(0), _lastInactiveTick(0), cpuThread(nullptr),
     gpuTc(nullptr), cpuPointer(p.cpu_pointer),
-    tickEvent([this]{ execScheduledAdds(); }, "Shader scheduled adds event",
-          false, Event::CPU_Tick_Pri),
     timingSim(p.timing), hsail_mode(SIMT),
     impl_kern_launch_acq(p.impl_kern_launch_acq),
     impl_kern_end_rel(p.impl_kern_end_rel),
@@ -66,7 +64,7 @@ Shader::Shader(const Params &p) : ClockedObject(p),
     trace_vgpr_all(1), n_cu((p.CUs).size()), n_wf(p.n_wf),
     n_cu_per_sqc(p.cu_per_sqc),
     globalMemSize(p.globalmem),
-    nextSchedCu(0), sa_n(0), gpuCmdProc(*p.gpu_cmd_proc),
+    nextSchedCu(0), gpuCmdProc(*p.gpu_cmd_proc),
     _dispatcher(*p.dispatcher), systemHub(p.system_hub),
     max_valu_insts(p.max_valu_insts), total_valu_insts(0),
     stats(this, p.CUs[0]->wfSize())
@@ -169,33 +167,6 @@ Shader::updateContext(int cid) {
     assert(gpuTc);
 }
 
-void
-Shader::execScheduledAdds()
-{
-    assert(!sa_when.empty());
-
-    // apply any scheduled adds
-    for (int i = 0; i < sa_n; ++i) {
-        if (sa_when[i] <= curTick()) {
-            *sa_val[i] += sa_x[i];
-            panic_if(*sa_val[i] < 0, "Negative counter value\n");
-            sa_val.erase(sa_val.begin() + i);
-            sa_x.erase(sa_x.begin() + i);
-            sa_when.erase(sa_when.begin() + i);
-            --sa_n;
-            --i;
-        }
-    }
-    if (!sa_when.empty()) {
-        Tick shader_wakeup = *std::max_element(sa_when.begin(),
-                 sa_when.end());
-        DPRINTF(GPUDisp, "Scheduling shader wakeup at %lu\n", shader_wakeup);
-        schedule(tickEvent, shader_wakeup);
-    } else {
-        DPRINTF(GPUDisp, "sa_when empty, shader going to sleep!\n");
-    }
-}
-
 /*
  * dispatcher/shader arranges invalidate requests to the CUs
  */
@@ -214,11 +185,15 @@ Shader::prepareInvalidate(HSAQueueEntry *task) {
     for (int i_cu = 0; i_cu < n_cu; ++i_cu) {
         // create a request to hold INV info; the request's fields will
         // be updated in cu before use
-        auto req = std::make_shared<Request>(0, 0, 0,
-                                             cuList[i_cu]->requestorId(),
-                                             0, -1);
+        auto req = Request::create(0, 0, 0,
+                                   cuList[i_cu]->requestorId(),
+                                   0, -1);
 
         _dispatcher.updateInvCounter(kernId, +1);
+
+        // The CU may be simulated on its own event queue
+        EventQueue::ScopedMigration migrate(cuList[i_cu]->eventQueue());
+
         // all necessary INV flags are all set now, call cu to execute
         cuList[i_cu]->doInvalidate(req, task->dispatchId());
 
@@ -244,10 +219,16 @@ Shader::prepareFlush(GPUDynInstPtr gpuDynInst){
     assert(_dispatcher.getOutstandingWbs(kernId) == 0);
 
     // the first cu, managed by the shader, performs flush operation,
-    // assuming that L2 cache is shared by all cus in the shader
-    int i_cu = 0;
+    // assuming that L2 cache is shared by all cus in the shader. If that
+    // cu is simulated on another event queue than the one ending the
+    // kernel, the latter flushes instead, so that the response is
+    // handled on the event queue of the wavefront.
+    ComputeUnit *cu = cuList[0];
+    if (cu->eventQueue() != gpuDynInst->computeUnit()->eventQueue())
+        cu = gpuDynInst->computeUnit();
+
     _dispatcher.updateWbCounter(kernId, +1);
-    cuList[i_cu]->doFlush(gpuDynInst);
+    cu->doFlush(gpuDynInst);
 }
 
 bool
@@ -265,8 +246,14 @@ Shader::dispatchWorkgroups(HSAQueueEntry *task)
         // dispatch workgroup iff the following two conditions are met:
         // (a) wg_rem is true - there are unassigned workgroups in the grid
         // (b) there are enough free slots in cu cuList[i] for this wg
+        ComputeUnit *cu = cuList[curCu];
         int num_wfs_in_wg = 0;
-        bool can_disp = cuList[curCu]->hasDispResources(task, num_wfs_in_wg);
+        bool can_disp;
+        {
+            // The CU may be simulated on its own event queue
+            EventQueue::ScopedMigration migrate(cu->eventQueue());
+            can_disp = cu->hasDispResources(task, num_wfs_in_wg);
+        }
         if (!task->dispComplete() && can_disp) {
             scheduledSomething = true;
             DPRINTF(GPUDisp, "Dispatching a workgroup to CU %d: WG %d\n",
@@ -276,15 +263,25 @@ Shader::dispatchWorkgroups(HSAQueueEntry *task)
             DPRINTF(GPUWgLatency, "WG Begin cycle:%d wg:%d cu:%d\n",
                     curTick(), task->globalWgId(), curCu);
 
-            if (!cuList[curCu]->tickEvent.scheduled()) {
-                if (!_activeCus)
-                    _lastInactiveTick = curTick();
-                _activeCus++;
+            // Count the CU as active before handing it the workgroup. A CU
+            // on another event queue may go to sleep until it gets it.
+            if (!_activeCus)
+                _lastInactiveTick = curTick();
+            _activeCus++;
+
+            bool was_active;
+            {
+                EventQueue::ScopedMigration migrate(cu->eventQueue());
+                was_active = cu->tickEvent.scheduled();
+                cu->dispWorkgroup(task, num_wfs_in_wg);
             }
+            // a functional WG has already completed, so it did not wake
+            // up the CU either
+            if (was_active || task->isFunctional())
+                _activeCus--;
 
             panic_if(_activeCus <= 0 || _activeCus > cuList.size(),
                      "Invalid activeCu size\n");
-            cuList[curCu]->dispWorkgroup(task, num_wfs_in_wg);
 
             task->markWgDispatch();
             ++disp_count;
@@ -346,8 +343,11 @@ Shader::doFunctionalAccess(const RequestPtr &req, MemCmd cmd, void *data,
 
         // fixme: this should be cuList[cu_id] if cu_id != n_cu
         // The latter requires a memPort in the dispatcher
-        cuList[0]->memPort[0].sendFunctional(new_pkt1);
-        cuList[0]->memPort[0].sendFunctional(new_pkt2);
+        {
+            EventQueue::ScopedMigration migrate(cuList[0]->eventQueue());
+            cuList[0]->memPort[0].sendFunctional(new_pkt1);
+            cuList[0]->memPort[0].sendFunctional(new_pkt2);
+        }
 
         delete new_pkt1;
         delete new_pkt2;
@@ -365,32 +365,16 @@ Shader::doFunctionalAccess(const RequestPtr &req, MemCmd cmd, void *data,
 
         // fixme: this should be cuList[cu_id] if cu_id != n_cu
         // The latter requires a memPort in the dispatcher
-        cuList[0]->memPort[0].sendFunctional(new_pkt);
+        {
+            EventQueue::ScopedMigration migrate(cuList[0]->eventQueue());
+            cuList[0]->memPort[0].sendFunctional(new_pkt);
+        }
 
         delete new_pkt;
         delete pkt;
     }
 }
 
-void
-Shader::ScheduleAdd(int *val,Tick when,int x)
-{
-    sa_val.push_back(val);
-    when += curTick();
-    sa_when.push_back(when);
-    sa_x.push_back(x);
-    ++sa_n;
-    if (!tickEvent.scheduled() || (when < tickEvent.when())) {
-        DPRINTF(GPUDisp, "New scheduled add; scheduling shader wakeup at "
-                "%lu\n", when);
-        reschedule(tickEvent, when, true);
-    } else {
-        assert(tickEvent.scheduled());
-        DPRINTF(GPUDisp, "New scheduled add; wakeup already scheduled at "
-                "%lu\n", when);
-    }
-}
-
 void
 Shader::AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
                   MemCmd cmd, bool suppress_func_errors)
@@ -400,7 +384,7 @@ Shader::AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
     for (ChunkGenerator gen(address, size, cuList.at(cu_id)->cacheLineSize());
          !gen.done(); gen.next()) {
 
-        RequestPtr req = std::make_shared<Request>(
+        RequestPtr req = Request::create(
             gen.addr(), gen.size(), 0,
             cuList[0]->requestorId(), 0, 0, nullptr);
 
@@ -453,7 +437,10 @@ Shader::functionalTLBAccess(PacketPtr pkt, int cu_id, BaseMMU::Mode mode)
     // it's ok tp send all accesses through lane 0
     // since the lane # is not known here,
     // This isn't important since these are functional accesses.
-    cuList[cu_id]->tlbPort[0].sendFunctional(pkt);
+    {
+        EventQueue::ScopedMigration migrate(cuList[cu_id]->eventQueue());
+        cuList[cu_id]->tlbPort[0].sendFunctional(pkt);
+    }
 
     /* safe_cast the senderState */
     GpuTranslationState *sender_state =
@@ -469,6 +456,8 @@ Shader::functionalTLBAccess(PacketPtr pkt, int cu_id, BaseMMU::Mode mode)
 void
 Shader::sampleStore(const Tick accessTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     stats.storeLatencyDist.sample(accessTime);
     stats.allLatencyDist.sample(accessTime);
 }
@@ -479,6 +468,8 @@ Shader::sampleStore(const Tick accessTime)
 void
 Shader::sampleLoad(const Tick accessTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     stats.loadLatencyDist.sample(accessTime);
     stats.allLatencyDist.sample(accessTime);
 }
@@ -486,6 +477,8 @@ Shader::sampleLoad(const Tick accessTime)
 void
 Shader::sampleInstRoundTrip(std::vector<Tick> roundTripTime)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     // Only sample instructions that go all the way to main memory
     if (roundTripTime.size() != InstMemoryHop::InstMemoryHopMax) {
         return;
@@ -506,6 +499,8 @@ Shader::sampleInstRoundTrip(std::vector<Tick> roundTripTime)
 void
 Shader::sampleLineRoundTrip(const std::map<Addr, std::vector<Tick>>& lineMap)
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     stats.coalsrLineAddresses.sample(lineMap.size());
     std::vector<Tick> netTimes;
 
@@ -534,6 +529,8 @@ Shader::sampleLineRoundTrip(const std::map<Addr, std::vector<Tick>>& lineMap)
 
 void
 Shader::notifyCuSleep() {
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     // If all CUs attached to his shader are asleep, update shaderActiveTicks
     panic_if(_activeCus <= 0 || _activeCus > cuList.size(),
              "Invalid activeCu size\n");
@@ -552,9 +549,22 @@ Shader::notifyCuSleep() {
     }
 }
 
+void
+Shader::incValuInsts()
+{
+    EventQueue::ScopedMigration migrate(eventQueue());
+
+    total_valu_insts++;
+    if (total_valu_insts == max_valu_insts) {
+        exitSimLoop("max vALU insts");
+    }
+}
+
 void
 Shader::decNumOutstandingInvL2s()
 {
+    EventQueue::ScopedMigration migrate(eventQueue());
+
     num_outstanding_invl2s--;
 
     if (num_outstanding_invl2s == 0 && !deferred_dispatches.empty()) {
@@ -127,6 +127,7 @@ class Shader : public ClockedObject
     void
     setHwReg(int regIdx, uint32_t val)
     {
+        EventQueue::ScopedMigration migrate(eventQueue());
         hwRegs[regIdx] = val;
     }
 
@@ -227,8 +228,6 @@ class Shader : public ClockedObject
 
     RequestorID vramRequestorId();
 
-    EventFunctionWrapper tickEvent;
-
     // is this simulation going to be timing mode in the memory?
     bool timingSim;
     hsail_mode_e hsail_mode;
@@ -254,16 +253,6 @@ class Shader : public ClockedObject
     // Tracks CU that rr dispatcher should attempt scheduling
     int nextSchedCu;
 
-    // Size of scheduled add queue
-    uint32_t sa_n;
-
-    // Pointer to value to be increments
-    std::vector<int*> sa_val;
-    // When to do the increment
-    std::vector<uint64_t> sa_when;
-    // Amount to increment by
-    std::vector<int32_t> sa_x;
-
     // List of Compute Units (CU's)
     std::vector<ComputeUnit*> cuList;
 
@@ -278,11 +267,6 @@ class Shader : public ClockedObject
     ~Shader();
     virtual void init();
 
-    // Run shader scheduled adds
-    void execScheduledAdds();
-
-    // Schedule a 32-bit value to be incremented some time in the future
-    void ScheduleAdd(int *val, Tick when, int x);
     bool processTimingPacket(PacketPtr pkt);
 
     void AccessMem(uint64_t address, void *ptr, uint32_t size, int cu_id,
@@ -314,20 +298,33 @@ class Shader : public ClockedObject
     Addr mmap(int length);
     void functionalTLBAccess(PacketPtr pkt, int cu_id, BaseMMU::Mode mode);
     void updateContext(int cid);
+
+    /**
+     * @{
+     * @name Compute unit callbacks
+     *
+     * The CUs may be simulated on their own event queues, so these
+     * migrate to the event queue of the shader before touching any
+     * shader state.
+     */
     void notifyCuSleep();
 
     void
     incVectorInstSrcOperand(int num_operands)
     {
+        EventQueue::ScopedMigration migrate(eventQueue());
         stats.vectorInstSrcOperand[num_operands]++;
     }
 
     void
     incVectorInstDstOperand(int num_operands)
     {
+        EventQueue::ScopedMigration migrate(eventQueue());
         stats.vectorInstDstOperand[num_operands]++;
     }
 
+    void incValuInsts();
+
     void
     requestKernelExitEvent(bool is_blit_kernel)
     {
@@ -336,7 +333,15 @@ class Shader : public ClockedObject
     }
 
     void decNumOutstandingInvL2s();
-    void incNumOutstandingInvL2s() { num_outstanding_invl2s++; };
+
+    void
+    incNumOutstandingInvL2s()
+    {
+        EventQueue::ScopedMigration migrate(eventQueue());
+        num_outstanding_invl2s++;
+    }
+    /** @} */
+
     int getNumOutstandingInvL2s() const { return num_outstanding_invl2s; };
 
     void addDeferredDispatch(void *raw_pkt, uint32_t queue_id,
@@ -47,8 +47,10 @@ namespace gem5
 {
 
 VectorRegisterFile::VectorRegisterFile(const VectorRegisterFileParams &p)
-    : RegisterFile(p)
+    : RegisterFile(p), numBanks(p.num_banks), bankReadMask(0),
+      bankReadTick(MaxTick)
 {
+    fatal_if(numBanks > 64, "VRF supports at most 64 register banks\n");
     regFile.resize(numRegs());
 
     for (auto &reg : regFile) {
@@ -59,6 +61,14 @@ VectorRegisterFile::VectorRegisterFile(const VectorRegisterFileParams &p)
 bool
 VectorRegisterFile::operandsReady(Wavefront *w, GPUDynInstPtr ii) const
 {
+    // Most of the time, none of the registers of the wavefront is
+    // waiting for a write back, so there is no need to look at the
+    // individual operands
+    if (w->startVgprIndex + w->reservedVectorRegs <= numRegs() &&
+        !anyRegBusy(w->startVgprIndex, w->reservedVectorRegs)) {
+        return true;
+    }
+
     bool src_ready = true, dst_ready=true;
     for (const auto& srcVecOp : ii->srcVecRegOperands()) {
         for (const auto& physIdx : srcVecOp.physIndices()) {
@@ -95,6 +105,50 @@ VectorRegisterFile::operandsReady(Wavefront *w, GPUDynInstPtr ii) const
     return src_ready && dst_ready;
 }
 
+uint64_t
+VectorRegisterFile::readBankMask(const GPUDynInstPtr &ii) const
+{
+    uint64_t mask = 0;
+    for (const auto& srcVecOp : ii->srcVecRegOperands()) {
+        for (const auto& physIdx : srcVecOp.physIndices()) {
+            mask |= 1ULL << (physIdx % numBanks);
+        }
+    }
+    return mask;
+}
+
+bool
+VectorRegisterFile::canScheduleReadOperands(Wavefront *w, GPUDynInstPtr ii)
+{
+    if (!numBanks || bankReadTick != curTick()) {
+        return true;
+    }
+
+    // Each bank is single ported: an instruction cannot read a bank
+    // another instruction was scheduled to read in the same cycle.
+    if (readBankMask(ii) & bankReadMask) {
+        DPRINTF(GPUVRF, "Bank conflict: WV[%d]: %s\n", w->wfDynId,
+                ii->disassemble());
+        stats.bankConflicts++;
+        return false;
+    }
+    return true;
+}
+
+void
+VectorRegisterFile::scheduleReadOperands(Wavefront *w, GPUDynInstPtr ii)
+{
+    if (!numBanks) {
+        return;
+    }
+
+    if (bankReadTick != curTick()) {
+        bankReadTick = curTick();
+        bankReadMask = 0;
+    }
+    bankReadMask |= readBankMask(ii);
+}
+
 void
 VectorRegisterFile::scheduleWriteOperands(Wavefront *w, GPUDynInstPtr ii)
 {
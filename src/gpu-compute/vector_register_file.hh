@@ -53,6 +53,10 @@ class VectorRegisterFile : public RegisterFile
     ~VectorRegisterFile() { }
 
     virtual bool operandsReady(Wavefront *w, GPUDynInstPtr ii) const override;
+    virtual bool canScheduleReadOperands(Wavefront *w,
+                                         GPUDynInstPtr ii) override;
+    virtual void scheduleReadOperands(Wavefront *w,
+                                      GPUDynInstPtr ii) override;
     virtual void scheduleWriteOperands(Wavefront *w,
                                        GPUDynInstPtr ii) override;
     virtual void scheduleWriteOperandsFromLoad(Wavefront *w,
@@ -105,6 +109,16 @@ class VectorRegisterFile : public RegisterFile
 
   private:
     std::vector<VecRegContainer> regFile;
+
+    // Bank conflict model: registers are interleaved across numBanks
+    // banks, and bankReadMask holds the banks already read by the
+    // instructions scheduled at bankReadTick
+    const unsigned numBanks;
+    uint64_t bankReadMask;
+    Tick bankReadTick;
+
+    // Mask of the banks read by the source operands of ii
+    uint64_t readBankMask(const GPUDynInstPtr &ii) const;
 };
 
 } // namespace gem5
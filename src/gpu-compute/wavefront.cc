@@ -83,6 +83,7 @@ Wavefront::Wavefront(const Params &p)
 
     pendingFetch = false;
     dropFetch = false;
+    functional = false;
     maxVgprs = 0;
     maxSgprs = 0;
 
@@ -1239,6 +1240,67 @@ Wavefront::exec()
     }
 }
 
+/**
+ * Execute the oldest instruction of a WF that belongs to a functional
+ * kernel launch. Functional WFs do not go through the SCB and SCH stages,
+ * so the state changes those stages make before an instruction executes
+ * (barrier and waitcnt status, waitcnt counters and pipeline resource
+ * counters) are made here. The memory pipelines complete the accesses of
+ * functional WFs within execute(), hence nothing is ever outstanding
+ * once the instruction retires.
+ */
+void
+Wavefront::execFunctional()
+{
+    assert(functional);
+    assert(status == S_RUNNING);
+    assert(instructionBuffer.size() == 1);
+
+    GPUDynInstPtr ii = instructionBuffer.front();
+
+    if (isOldestInstBarrier() && hasBarrier()) {
+        setStatus(S_BARRIER);
+    }
+
+    if (ii->isFlat() || ii->isLocalMem() || ii->isGlobalMem()) {
+        if (ii->isScalar() || ii->isGroupSeg()) {
+            incLGKMInstsIssued();
+        } else {
+            incVMemInstsIssued();
+            if (ii->isFlat()) {
+                incLGKMInstsIssued();
+            }
+        }
+        if (ii->isStore() && ii->isGlobalSeg()) {
+            incExpInstsIssued();
+        }
+    }
+    reserveResources();
+
+    const Addr old_pc = pc();
+    DPRINTF(GPUExec, "CU%d: WF[%d][%d]: wave[%d] Functionally executing "
+            "inst: %s (pc: %#x; seqNum: %d)\n", computeUnit->cu_id, simdId,
+            wfSlotId, wfDynId, ii->disassemble(), old_pc, ii->seqNum());
+
+    ii->execute(ii);
+
+    computeUnit->stats.numInstrExecuted++;
+    stats.numInstrExecuted++;
+
+    if (pc() == old_pc) {
+        _gpuISA.advancePC(ii);
+    }
+    instructionBuffer.clear();
+
+    // there is nothing to wait for, or to sleep through, in functional mode
+    if (status == S_WAITCNT) {
+        clearWaitCnts();
+    } else if (status == S_STALLED_SLEEP) {
+        sleepCnt = 0;
+        setStatus(S_RUNNING);
+    }
+}
+
 GPUDynInstPtr
 Wavefront::nextInstr()
 {
@@ -1447,18 +1509,6 @@ Wavefront::pc(Addr new_pc)
     _pc = new_pc;
 }
 
-VectorMask&
-Wavefront::execMask()
-{
-    return _execMask;
-}
-
-bool
-Wavefront::execMask(int lane) const
-{
-    return _execMask[lane];
-}
-
 void
 Wavefront::freeRegisterFile()
 {
@@ -112,6 +112,10 @@ class Wavefront : public SimObject
 
     bool pendingFetch;
     bool dropFetch;
+    // the WF belongs to a kernel launched in functional mode; its
+    // instructions are executed back to back by the CU, bypassing
+    // the pipeline and performing functional memory accesses
+    bool functional;
     // last tick during which all WFs in the CU are not idle
     Tick lastNonIdleTick;
 
@@ -262,6 +266,8 @@ class Wavefront : public SimObject
     void validateRequestCounters();
     void start(uint64_t _wfDynId, uint64_t _base_ptr);
     void exec();
+    // execute the oldest instruction of a functional WF
+    void execFunctional();
     // called by SCH stage to reserve
     std::vector<int> reserveResources();
     bool stopFetch();
@@ -269,8 +275,10 @@ class Wavefront : public SimObject
     Addr pc() const;
     void pc(Addr new_pc);
 
-    VectorMask& execMask();
-    bool execMask(int lane) const;
+    // The exec mask is tested in the lane loop of every vector
+    // instruction, so keep it inline
+    VectorMask& execMask() { return _execMask; }
+    bool execMask(int lane) const { return _execMask[lane]; }
 
 
     void discardFetch();
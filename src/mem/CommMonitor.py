@@ -115,3 +115,17 @@ class CommMonitor(SimObject):
     read_addr_mask = Param.Addr(MaxAddr, "Address mask for read address")
     write_addr_mask = Param.Addr(MaxAddr, "Address mask for write address")
     disable_addr_dists = Param.Bool(True, "Disable address distributions")
+
+    # low overhead mode for monitors that are left in place: burst
+    # length, latency and ITT are counted in fixed power of two
+    # buckets instead of the histograms above, and the address
+    # distributions are not collected
+    fast_stats = Param.Bool(
+        False, "Only use fixed log2 bucket histograms per packet"
+    )
+
+    # only notify the packet probes (e.g. a trace) for one in this
+    # many requests and responses
+    probe_sample_interval = Param.Unsigned(
+        1, "Notify the packet probes for one in this many packets"
+    )
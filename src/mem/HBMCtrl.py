@@ -28,7 +28,7 @@ from m5.objects.MemCtrl import *
 from m5.params import *
 from m5.proxy import *
 
-# HBMCtrl manages two pseudo channels of HBM2
+# HBMCtrl manages two or more pseudo channels of HBM2
 
 
 class HBMCtrl(MemCtrl):
@@ -42,6 +42,17 @@ class HBMCtrl(MemCtrl):
     # HBMCtrl has been tested with two HBM_2000_4H_1x64 interfaces
     dram_2 = Param.DRAMInterface("DRAM memory interface")
 
+    # Pseudo channels beyond the first two. The total number of pseudo
+    # channels must be a power of 2. Each pseudo channel has its own
+    # scheduler and response queue and gets an equal share of the
+    # controller buffers
+    extra_pseudo_channels = VectorParam.DRAMInterface(
+        [], "Additional pseudo channel interfaces"
+    )
+    pseudo_channel_intlv_low_bit = Param.Unsigned(
+        6, "Lowest address bit selecting the pseudo channel"
+    )
+
     # For mixed traffic, HBMCtrl with HBM_2000_4H_1x64 interfaaces
     # gives the best results with following min_r/w_per_switch
     min_reads_per_switch = 64
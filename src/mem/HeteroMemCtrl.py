@@ -54,3 +54,26 @@ class HeteroMemCtrl(MemCtrl):
     # The dram interface `dram` used by HeteroMemCtrl is defined in
     # the MemCtrl
     nvm = Param.NVMInterface("NVM memory interface to use")
+
+    # Page migration between the two media. Hot pages are found by
+    # counting the accesses in a count-min sketch, and are swapped with
+    # a cold DRAM page. The data stays at the address used by the
+    # requests, only the medium (and bank, rank and row) the requests
+    # are timed against changes.
+    migration_enable = Param.Bool(False, "Migrate hot pages to DRAM")
+    migration_page_size = Param.MemorySize("4KiB", "Migration page size")
+    migration_threshold = Param.Unsigned(
+        64, "Estimated accesses for an NVM page to be migrated"
+    )
+    migration_sample_interval = Param.Unsigned(
+        1, "Count one in this many accesses in the hot page sketch"
+    )
+    migration_bandwidth = Param.MemoryBandwidth(
+        "4GiB/s", "Bandwidth of the page copies of a migration"
+    )
+    migration_sketch_width = Param.Unsigned(
+        4096, "Counters per row of the hot page sketch"
+    )
+    migration_aging_period = Param.Unsigned(
+        65536, "Halve the sketch counters every this many counted accesses"
+    )
@@ -43,6 +43,14 @@ class MemChecker(SimObject):
     cxx_header = "mem/mem_checker.hh"
     cxx_class = "gem5::MemChecker"
 
+    history_window = Param.Latency(
+        "0ns",
+        "Prune the history of a location that completed longer ago than "
+        "this, even if older reads are outstanding. Reads outstanding for "
+        "longer than the window are then not checked. Zero keeps all the "
+        "history needed by the outstanding reads.",
+    )
+
 
 class MemCheckerMonitor(SimObject):
     type = "MemCheckerMonitor"
@@ -42,12 +42,15 @@ from m5.citations import add_citation
 from m5.objects.QoSMemCtrl import *
 from m5.params import *
 from m5.proxy import *
+from m5.util.pybind import PyBindMethod
 
 
 # Enum for memory scheduling algorithms, currently First-Come
-# First-Served and a First-Row Hit then First-Come First-Served
+# First-Served and a First-Row Hit then First-Come First-Served. The
+# indexed FR-FCFS scheduler makes the same decisions as FR-FCFS, but
+# keeps the queues indexed by bank and row to avoid scanning them.
 class MemSched(Enum):
-    vals = ["fcfs", "frfcfs"]
+    vals = ["fcfs", "frfcfs", "frfcfs_indexed"]
 
 
 # MemCtrl is a single-channel single-ported Memory controller model
@@ -102,6 +105,22 @@ class MemCtrl(QoSMemCtrl):
     command_window = Param.Latency("10ns", "Static backend latency")
     disable_sanity_check = Param.Bool(False, "Disable port resp Q size check")
 
+    # analytic timing mode, where requests are serviced using a latency
+    # and bandwidth model of the interface instead of the bank and rank
+    # state machines, e.g., to speed up warmup. The mode can be changed
+    # at runtime with setAnalyticMode().
+    analytic_mode = Param.Bool(False, "Start in the analytic timing mode")
+    analytic_row_hit_rate = Param.Float(
+        0.5,
+        "Fraction of row hits assumed in the analytic timing mode, "
+        "until calibrated by the detailed mode",
+    )
+
+    cxx_exports = [
+        PyBindMethod("setAnalyticMode"),
+        PyBindMethod("isAnalyticMode"),
+    ]
+
 
 add_citation(
     MemCtrl,
@@ -1,4 +1,4 @@
-from m5.params import Param
+from m5.params import *
 from m5.proxy import Parent
 from m5.SimObject import SimObject
 
@@ -15,3 +15,11 @@ class SharedMemoryServer(SimObject):
     server_path = Param.String(
         "The unix socket path where the server should be running upon."
     )
+    dirty_page_size = Param.MemorySize(
+        "4KiB", "Granularity of the dirty page notifications."
+    )
+    dirty_page_period = Param.Latency(
+        "10us",
+        "Simulated time between two dirty page notifications to a "
+        "subscriber.",
+    )
@@ -39,8 +39,14 @@ class ThreadBridge(SimObject):
     the issue. The receiver side is expected to use the same EventQueue that
     the ThreadBridge is using.
 
-    Given that this is only used for simulation speed accelerating, only the
-    atomic and functional access are supported.
+    Atomic and functional accesses cross immediately. Timing accesses are
+    delivered on the other side after the delay, in order. This delay is the
+    latency budget of the crossing: it is added to every request and every
+    response, and it can't be shorter than the simulation quantum, since the
+    event queues only synchronize once per quantum. If Root.sim_quantum is
+    not set, the quantum is derived from the smallest delay. A crossing
+    of a few nanoseconds is typically hidden by the latency of the target,
+    e.g., a memory controller, while letting the queues run in parallel.
 
     Example:
 
@@ -58,3 +64,10 @@ class ThreadBridge(SimObject):
 
     in_port = ResponsePort("Incoming port")
     out_port = RequestPort("Outgoing port")
+
+    delay = Param.Latency(
+        "0ns", "Latency of a timing access crossing in either direction"
+    )
+    req_size = Param.Unsigned(
+        16, "Number of requests that can cross to the target at a time"
+    )
@@ -154,6 +154,13 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize("8MiB", "Maximum capacity of snoop filter")
 
+    # By default the capacity is only a sanity check and the snoop
+    # filter tracks every line cached above it. With a non-zero
+    # associativity, the snoop filter is limited to max_capacity worth
+    # of lines in a set-associative structure, and lines that do not
+    # fit are back-invalidated in the caches above.
+    assoc = Param.Unsigned(0, "Associativity of a bounded snoop filter")
+
 
 # We use a coherent crossbar to connect multiple requestors to the L2
 # caches. Normally this crossbar would be part of the cache itself.
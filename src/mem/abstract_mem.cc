@@ -42,6 +42,7 @@
 
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/loader/memory_image.hh"
 #include "base/loader/object_file.hh"
 #include "cpu/thread_context.hh"
@@ -115,6 +116,67 @@ AbstractMemory::setBackingStore(uint8_t* pmem_addr)
     pmemAddr = pmem_addr;
 }
 
+void
+AbstractMemory::startDirtyTracking(Addr page_size)
+{
+    fatal_if(!isPowerOf2(page_size), "%s: Dirty page size %d is not a "
+             "power of 2", name(), page_size);
+    fatal_if(dirtyTrackers && (Addr(1) << dirtyPageShift) != page_size,
+             "%s: Dirty pages already tracked at a different granularity",
+             name());
+
+    if (dirtyTrackers++)
+        return;
+
+    dirtyPageShift = floorLog2(page_size);
+    const Addr pages = divCeil(range.end() - range.start(), page_size);
+    dirtyPageBits.assign(divCeil(pages, 64), 0);
+    dirtyPageList.clear();
+
+    // Writes through the backdoor would go unnoticed
+    backdoor.invalidate();
+}
+
+void
+AbstractMemory::stopDirtyTracking()
+{
+    assert(dirtyTrackers);
+    if (--dirtyTrackers)
+        return;
+
+    dirtyPageShift = 0;
+    dirtyPageBits.clear();
+    dirtyPageList.clear();
+}
+
+void
+AbstractMemory::markDirtyRange(Addr addr, Addr size)
+{
+    if (!size)
+        return;
+
+    const Addr first = (addr - range.start()) >> dirtyPageShift;
+    const Addr last = (addr + size - 1 - range.start()) >> dirtyPageShift;
+    for (Addr page = first; page <= last; ++page) {
+        uint64_t &word = dirtyPageBits[page / 64];
+        const uint64_t mask = uint64_t(1) << (page % 64);
+        if (!(word & mask)) {
+            word |= mask;
+            dirtyPageList.push_back(page);
+        }
+    }
+}
+
+void
+AbstractMemory::collectDirtyPages(std::vector<Addr> &pages)
+{
+    for (Addr page : dirtyPageList) {
+        dirtyPageBits[page / 64] &= ~(uint64_t(1) << (page % 64));
+        pages.push_back(range.start() + (page << dirtyPageShift));
+    }
+    dirtyPageList.clear();
+}
+
 AbstractMemory::MemStats::MemStats(AbstractMemory &_mem)
     : statistics::Group(&_mem), mem(_mem),
     ADD_STAT(bytesRead, statistics::units::Byte::get(),
@@ -400,6 +462,7 @@ AbstractMemory::access(PacketPtr pkt)
             if (pmemAddr) {
                 pkt->setData(host_addr);
                 (*(pkt->getAtomicOp()))(host_addr);
+                markDirty(pkt->getAddr(), pkt->getSize());
             }
         } else {
             std::vector<uint8_t> overwrite_val(pkt->getSize());
@@ -428,8 +491,10 @@ AbstractMemory::access(PacketPtr pkt)
                     panic("Invalid size for conditional read/write\n");
             }
 
-            if (overwrite_mem)
+            if (overwrite_mem) {
                 std::memcpy(host_addr, &overwrite_val[0], pkt->getSize());
+                markDirty(pkt->getAddr(), pkt->getSize());
+            }
 
             assert(!pkt->req->isInstFetch());
             TRACE_PACKET("Read/Write");
@@ -466,6 +531,7 @@ AbstractMemory::access(PacketPtr pkt)
         if (writeOK(pkt)) {
             if (pmemAddr) {
                 pkt->writeData(host_addr);
+                markDirty(pkt->getAddr(), pkt->getSize());
                 DPRINTF(MemoryAccess, "%s write due to %s\n",
                         __func__, pkt->print());
             }
@@ -501,6 +567,7 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
     } else if (pkt->isWrite()) {
         if (pmemAddr) {
             pkt->writeData(host_addr);
+            markDirty(pkt->getAddr(), pkt->getSize());
         }
         TRACE_PACKET("Write");
         pkt->makeResponse();
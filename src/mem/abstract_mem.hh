@@ -46,6 +46,9 @@
 #ifndef __MEM_ABSTRACT_MEMORY_HH__
 #define __MEM_ABSTRACT_MEMORY_HH__
 
+#include <cstdint>
+#include <vector>
+
 #include "mem/backdoor.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
@@ -137,6 +140,26 @@ class AbstractMemory : public ClockedObject
 
     std::list<LockedAddr> lockedAddrList;
 
+    /**
+     * Dirty page tracking for external observers of the backing
+     * store. A bit per page of the range, and the pages whose bit got
+     * set since the last collectDirtyPages(). The page shift is zero
+     * when tracking is off.
+     */
+    unsigned dirtyPageShift = 0;
+    unsigned dirtyTrackers = 0;
+    std::vector<uint64_t> dirtyPageBits;
+    std::vector<Addr> dirtyPageList;
+
+    void markDirtyRange(Addr addr, Addr size);
+
+    void
+    markDirty(Addr addr, Addr size)
+    {
+        if (dirtyPageShift)
+            markDirtyRange(addr, size);
+    }
+
     // helper function for checkLockedAddrs(): we really want to
     // inline a quick check for an empty locked addr list (hopefully
     // the common case), and do the full list search (if necessary) in
@@ -247,10 +270,35 @@ class AbstractMemory : public ClockedObject
     void
     getBackdoor(MemBackdoorPtr &bd_ptr)
     {
-        if (lockedAddrList.empty() && backdoor.ptr())
+        // Writes through a backdoor can't be tracked, so there is no
+        // backdoor while someone watches the dirty pages
+        if (lockedAddrList.empty() && backdoor.ptr() && !dirtyPageShift)
             bd_ptr = &backdoor;
     }
 
+    /**
+     * Start tracking the pages written by access() and
+     * functionalAccess(). Any backdoor is invalidated and no new one
+     * is handed out until all the trackers stopped, so tracking slows
+     * down CPUs that rely on backdoors. Writes that bypass the memory
+     * object altogether (e.g. KVM) are never seen.
+     *
+     * @param page_size Tracking granularity, a power of 2. All the
+     *        trackers of a memory must use the same one.
+     */
+    void startDirtyTracking(Addr page_size);
+
+    /** Stop tracking dirty pages for one of the trackers. */
+    void stopDirtyTracking();
+
+    /**
+     * Move the pages written since the last call to the end of a list
+     * and clear them.
+     *
+     * @param pages Gets the start address of every dirty page
+     */
+    void collectDirtyPages(std::vector<Addr> &pages);
+
     /**
      * Get the list of locked addresses to allow checkpointing.
      */
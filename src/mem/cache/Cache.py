@@ -44,6 +44,7 @@ from m5.objects.Tags import *
 from m5.params import *
 from m5.proxy import *
 from m5.SimObject import SimObject
+from m5.util.pybind import PyBindMethod
 
 
 # Enum for cache clusivity, currently mostly inclusive or mostly
@@ -83,6 +84,10 @@ class BaseCache(ClockedObject):
     cxx_header = "mem/cache/base.hh"
     cxx_class = "gem5::BaseCache"
 
+    cxx_exports = [
+        PyBindMethod("warmFromTrace"),
+    ]
+
     size = Param.MemorySize("Capacity")
     assoc = Param.Unsigned("Associativity")
 
@@ -169,6 +174,23 @@ class BaseCache(ClockedObject):
     # data cache.
     write_allocator = Param.WriteAllocator(NULL, "Write allocator")
 
+    # Keep the tags and replacement state of the cache up to date with
+    # the requests that bypass it in the 'atomic_noncaching' memory
+    # mode, e.g. during a fast functional warmup. The data is only
+    # read from memory when the caches are used again.
+    warm_tags_when_bypassed = Param.Bool(
+        False, "Warm the tags in the 'atomic_noncaching' memory mode"
+    )
+
+    # Do not store a copy of the data of the blocks, only their tags
+    # and coherence state. Data is read from and written through to the
+    # system's physical memory, which is then always up to date. This is
+    # intended for timing-only hierarchies where every cache is set up
+    # this way, and cuts the host memory needed by large caches.
+    tags_only = Param.Bool(
+        False, "Keep the block data in the backing store only"
+    )
+
 
 class Cache(BaseCache):
     type = "Cache"
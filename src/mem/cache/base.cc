@@ -47,6 +47,7 @@
 
 #include "base/compiler.hh"
 #include "base/logging.hh"
+#include "config/have_protobuf.hh"
 #include "debug/Cache.hh"
 #include "debug/CacheComp.hh"
 #include "debug/CachePort.hh"
@@ -64,6 +65,11 @@
 #include "params/WriteAllocator.hh"
 #include "sim/cur_tick.hh"
 
+#if HAVE_PROTOBUF
+#include "proto/packet.pb.h"
+#include "proto/protoio.hh"
+#endif
+
 namespace gem5
 {
 
@@ -76,6 +82,7 @@ BaseCache::CacheResponsePort::CacheResponsePort(const std::string &_name,
       blocked(false), mustSendRetry(false),
       sendRetryEvent([this]{ processSendRetry(); }, _name)
 {
+    queue.enableStats(&_cache, "cpuSideQueue");
 }
 
 BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
@@ -108,6 +115,9 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
       isReadOnly(p.is_read_only),
       replaceExpansions(p.replace_expansions),
       moveContractions(p.move_contractions),
+      warmTagsWhenBypassed(p.warm_tags_when_bypassed),
+      tagsOnly(p.tags_only),
+      warmedBlocksStale(false),
       blocked(0),
       order(0),
       noTargetMSHR(nullptr),
@@ -125,6 +135,9 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
     // forward snoops is overridden in init() once we can query
     // whether the connected requestor is actually snooping or not
 
+    mshrQueue.setChainLengthStat(&stats.mshrLookupChain);
+    writeBuffer.setChainLengthStat(&stats.writeBufferLookupChain);
+
     tempBlock = new TempCacheBlk(blkSize);
 
     tags->tagsInit();
@@ -138,6 +151,11 @@ BaseCache::BaseCache(const BaseCacheParams &p, unsigned blk_size)
         "Compressed cache %s does not have a compression algorithm", name());
     if (compressor)
         compressor->setCache(this);
+
+    fatal_if(compressor && warmTagsWhenBypassed,
+        "Compressed cache %s can't warm its tags when bypassed", name());
+    fatal_if(compressor && tagsOnly,
+        "Compressed cache %s can't be tags-only", name());
 }
 
 BaseCache::~BaseCache()
@@ -249,7 +267,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -634,6 +652,169 @@ BaseCache::recvTimingResp(PacketPtr pkt)
 }
 
 
+void
+BaseCache::warmTags(PacketPtr pkt)
+{
+    // Only cacheable reads and writes leave a block behind
+    if (pkt->req->isUncacheable() || pkt->isClean() ||
+        !(pkt->isRead() || pkt->isWrite())) {
+        pkt->clearBlockWarmed();
+        return;
+    }
+
+    Cycles lat;
+    CacheBlk *blk = tags->accessBlock(pkt, lat);
+
+    if (blk) {
+        stats.warmedTagHits++;
+    } else {
+        stats.warmedTagMisses++;
+
+        // A mostly exclusive cache only allocates blocks that are not
+        // already held by the caches above
+        if (clusivity == enums::mostly_incl || !pkt->isBlockWarmed()) {
+            PacketList writebacks;
+            blk = allocateBlock(pkt, writebacks);
+
+            for (auto wb_pkt : writebacks) {
+                // The victims are clean and their data is stale, so
+                // only tell the snoop filters below they are gone
+                Packet evict(wb_pkt->req, MemCmd::CleanEvict);
+                memSidePort.sendAtomic(&evict);
+                delete wb_pkt;
+            }
+
+            if (blk) {
+                DPRINTF(Cache, "%s: warmed %s\n", __func__, blk->print());
+                blk->setCoherenceBits(CacheBlk::ReadableBit);
+                blk->setWhenReady(curTick());
+                warmedBlocksStale = true;
+            }
+        }
+    }
+
+    if (blk) {
+        pkt->setBlockWarmed();
+    } else {
+        pkt->clearBlockWarmed();
+    }
+}
+
+void
+BaseCache::refreshWarmedBlocks()
+{
+    memory::PhysicalMemory &physmem = system->getPhysMem();
+
+    tags->forEachBlk([&](CacheBlk &blk) {
+        if (!blk.isValid())
+            return;
+
+        const Addr addr = regenerateBlkAddr(&blk);
+        if (!physmem.isMemAddr(addr)) {
+            invalidateBlock(&blk);
+            return;
+        }
+
+        RequestPtr request = Request::create(
+            addr, blkSize, 0, Request::funcRequestorId);
+        if (blk.isSecure()) {
+            request->setFlags(Request::SECURE);
+        }
+
+        Packet packet(request, MemCmd::ReadReq);
+        packet.dataStatic(blk.data);
+        physmem.functionalAccess(&packet);
+    });
+
+    warmedBlocksStale = false;
+}
+
+void
+BaseCache::drainResume()
+{
+    ClockedObject::drainResume();
+
+    // The blocks warmed while the caches were bypassed get their data
+    // as soon as the caches are used again
+    if (warmedBlocksStale && !system->bypassCaches())
+        refreshWarmedBlocks();
+}
+
+uint64_t
+BaseCache::warmFromTrace(const std::string &filename)
+{
+#if HAVE_PROTOBUF
+    fatal_if(!mshrQueue.isEmpty() || !writeBuffer.isEmpty(),
+             "%s: Can't warm from a trace with requests in flight", name());
+    fatal_if(system->bypassCaches(),
+             "%s: Can't warm from a trace while the caches are bypassed",
+             name());
+
+    ProtoInputStream trace(filename);
+    ProtoMessage::PacketHeader header_msg;
+    fatal_if(!trace.read(header_msg),
+             "%s: Failed to read packet header from %s", name(), filename);
+
+    std::vector<uint8_t> data(blkSize);
+    uint64_t lines = 0;
+
+    ProtoMessage::Packet pkt_msg;
+    while (trace.read(pkt_msg)) {
+        const MemCmd cmd(pkt_msg.cmd());
+        const Request::Flags flags(pkt_msg.has_flags() ?
+                                   pkt_msg.flags() : 0);
+
+        // Clean evictions, cache maintenance and uncacheable accesses
+        // don't change what the cache holds
+        if (!(cmd.isRead() || cmd.isWrite()) ||
+            flags.isSet(Request::UNCACHEABLE)) {
+            continue;
+        }
+
+        // The data is never changed, a write gets the block with a read
+        // and then marks it dirty
+        const bool mark_dirty = !isReadOnly &&
+            ((cmd.isWrite() && cmd != MemCmd::WritebackClean) ||
+             cmd.needsWritable());
+
+        const Addr end = pkt_msg.addr() + std::max(pkt_msg.size(), 1u);
+        for (Addr blk_addr = pkt_msg.addr() & ~Addr(blkSize - 1);
+             blk_addr < end; blk_addr += blkSize) {
+            if (!inRange(blk_addr))
+                continue;
+
+            RequestPtr req = Request::create(
+                blk_addr, blkSize, flags, Request::funcRequestorId);
+            Packet pkt(req, MemCmd::ReadReq);
+            pkt.dataStatic(data.data());
+
+            recvAtomic(&pkt);
+
+            // Send the writeback of a temporary block right away rather
+            // than from its event
+            if (writebackTempBlockAtomicEvent.scheduled()) {
+                deschedule(writebackTempBlockAtomicEvent);
+                writebackTempBlockAtomic();
+            }
+
+            if (mark_dirty) {
+                CacheBlk *blk = tags->findBlock(blk_addr, pkt.isSecure());
+                if (blk && blk->isSet(CacheBlk::WritableBit))
+                    blk->setCoherenceBits(CacheBlk::DirtyBit);
+            }
+
+            ++lines;
+        }
+    }
+
+    DPRINTF(Cache, "%s: warmed %llu lines from %s\n", __func__, lines,
+            filename);
+    return lines;
+#else
+    fatal("Can't warm %s from a trace without Protobuf support", name());
+#endif
+}
+
 Tick
 BaseCache::recvAtomic(PacketPtr pkt)
 {
@@ -731,11 +912,17 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
     // needs to be found.  As a result we always update the request if
     // we have it, but only declare it satisfied if we are the owner.
 
+    if (tagsOnly && blk && blk->isValid())
+        loadBlkData(blk);
+
     // see if we have data at all (owned or otherwise)
     bool have_data = blk && blk->isValid()
         && pkt->trySatisfyFunctional(&cbpw, blk_addr, is_secure, blkSize,
                                      blk->data);
 
+    if (tagsOnly && have_data && pkt->isWrite())
+        storeBlkData(blk);
+
     // data we have is dirty if marked as such or if we have an
     // in-service MSHR that is pending a modified line
     bool have_dirty =
@@ -774,6 +961,11 @@ void
 BaseCache::updateBlockData(CacheBlk *blk, const PacketPtr cpkt,
     bool has_old_data)
 {
+    // The shared data chunk of a tags-only cache only holds the old
+    // contents if they were just loaded for the probe listeners
+    if (tagsOnly && has_old_data && ppDataUpdate->hasListeners())
+        loadBlkData(blk);
+
     CacheDataUpdateProbeArg data_update(
         regenerateBlkAddr(blk), blk->isSecure(),
         blk->getSrcRequestorId(), accessor);
@@ -799,6 +991,40 @@ BaseCache::updateBlockData(CacheBlk *blk, const PacketPtr cpkt,
     }
 }
 
+void
+BaseCache::loadBlkData(CacheBlk *blk)
+{
+    assert(tagsOnly);
+
+    Addr blk_addr = regenerateBlkAddr(blk);
+    panic_if(!system->isMemAddr(blk_addr),
+             "Tags-only cache %s has no backing store for %#x",
+             name(), blk_addr);
+
+    RequestPtr req = Request::create(
+        blk_addr, blkSize, 0, Request::funcRequestorId);
+    Packet pkt(req, MemCmd::ReadReq);
+    pkt.dataStatic(blk->data);
+    system->getPhysMem().functionalAccess(&pkt);
+}
+
+void
+BaseCache::storeBlkData(CacheBlk *blk)
+{
+    assert(tagsOnly);
+
+    Addr blk_addr = regenerateBlkAddr(blk);
+    panic_if(!system->isMemAddr(blk_addr),
+             "Tags-only cache %s has no backing store for %#x",
+             name(), blk_addr);
+
+    RequestPtr req = Request::create(
+        blk_addr, blkSize, 0, Request::funcRequestorId);
+    Packet pkt(req, MemCmd::WriteReq);
+    pkt.dataStatic(blk->data);
+    system->getPhysMem().functionalAccess(&pkt);
+}
+
 void
 BaseCache::cmpAndSwap(CacheBlk *blk, PacketPtr pkt)
 {
@@ -845,6 +1071,8 @@ BaseCache::cmpAndSwap(CacheBlk *blk, PacketPtr pkt)
     if (overwrite_mem) {
         std::memcpy(blk_data, &overwrite_val, pkt->getSize());
         blk->setCoherenceBits(CacheBlk::DirtyBit);
+        if (tagsOnly)
+            storeBlkData(blk);
 
         if (ppDataUpdate->hasListeners()) {
             data_update.newData = std::vector<uint64_t>(blk->data,
@@ -1109,6 +1337,9 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
     // assert(!pkt->needsWritable() || blk->isSet(CacheBlk::WritableBit));
     assert(pkt->getOffset(blkSize) + pkt->getSize() <= blkSize);
 
+    if (tagsOnly)
+        loadBlkData(blk);
+
     // Check RMW operations first since both isRead() and
     // isWrite() will be true for them
     if (pkt->cmd == MemCmd::SwapReq) {
@@ -1131,6 +1362,8 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
 
             // execute AMO operation
             (*(pkt->getAtomicOp()))(blk_data);
+            if (tagsOnly)
+                storeBlkData(blk);
 
             // Inform of this block's data contents update
             if (ppDataUpdate->hasListeners()) {
@@ -1153,7 +1386,10 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
         assert(blk->isSet(CacheBlk::WritableBit));
         // Write or WriteLine at the first cache with block in writable state
         if (blk->checkWrite(pkt)) {
+            // A partial write merges with the contents loaded above
             updateBlockData(blk, pkt, true);
+            if (tagsOnly)
+                storeBlkData(blk);
         }
         // Always mark the line as dirty (and thus transition to the
         // Modified state) even if we are a failed StoreCond so we
@@ -1253,6 +1489,11 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     Cycles tag_latency(0);
     blk = tags->accessBlock(pkt, tag_latency);
 
+    if (partitionManager) {
+        partitionManager->notifyAccess(
+            partitionManager->readPacketPartitionID(pkt), blk);
+    }
+
     DPRINTF(Cache, "%s for %s %s\n", __func__, pkt->print(),
             blk ? "hit " + blk->print() : "miss");
 
@@ -1714,7 +1955,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1743,6 +1984,8 @@ BaseCache::writebackBlk(CacheBlk *blk)
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
     pkt->allocate();
+    if (tagsOnly)
+        loadBlkData(blk);
     pkt->setDataFromBlock(blk->data, blkSize);
 
     // When a block is compressed, it must first be decompressed before being
@@ -1757,7 +2000,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1788,6 +2031,8 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
     blk->clearCoherenceBits(CacheBlk::DirtyBit);
 
     pkt->allocate();
+    if (tagsOnly)
+        loadBlkData(blk);
     pkt->setDataFromBlock(blk->data, blkSize);
 
     // When a block is compressed, it must first be decompressed before being
@@ -1810,6 +2055,7 @@ void
 BaseCache::memInvalidate()
 {
     tags->forEachBlk([this](CacheBlk &blk) { invalidateVisitor(blk); });
+    warmedBlocksStale = false;
 }
 
 bool
@@ -1831,7 +2077,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -1839,6 +2085,9 @@ BaseCache::writebackVisitor(CacheBlk &blk)
             request->setFlags(Request::SECURE);
         }
 
+        if (tagsOnly)
+            loadBlkData(&blk);
+
         Packet packet(request, MemCmd::WriteReq);
         packet.dataStatic(blk.data);
 
@@ -1861,6 +2110,17 @@ BaseCache::invalidateVisitor(CacheBlk &blk)
     }
 }
 
+void
+BaseCache::schedulePrefetches()
+{
+    if (prefetcher && mshrQueue.canPrefetch() && !isBlocked()) {
+        Tick next_pf_time = std::max(
+            prefetcher->nextPrefetchReadyTime(), clockEdge());
+        if (next_pf_time != MaxTick)
+            schedMemSideSendEvent(next_pf_time);
+    }
+}
+
 Tick
 BaseCache::nextQueueReadyTime() const
 {
@@ -1923,8 +2183,10 @@ BaseCache::sendMSHRQueuePacket(MSHR* mshr)
     if (mshr->isForward) {
         // not a cache block request, but a response is expected
         // make copy of current packet to forward, keep current
-        // copy for response handling
-        pkt = new Packet(tgt_pkt, false, true);
+        // copy for response handling, the response data is written
+        // straight into the buffer of the current copy
+        pkt = new Packet(tgt_pkt, false, false);
+        pkt->shareData(tgt_pkt);
         assert(!pkt->isWrite());
     }
 
@@ -2288,6 +2550,14 @@ BaseCache::CacheStats::CacheStats(BaseCache &c)
              "number of data expansions"),
     ADD_STAT(dataContractions, statistics::units::Count::get(),
              "number of data contractions"),
+    ADD_STAT(warmedTagHits, statistics::units::Count::get(),
+             "number of bypassing requests hitting in the warmed tags"),
+    ADD_STAT(warmedTagMisses, statistics::units::Count::get(),
+             "number of bypassing requests missing in the warmed tags"),
+    ADD_STAT(mshrLookupChain, statistics::units::Count::get(),
+             "index slots probed per MSHR lookup"),
+    ADD_STAT(writeBufferLookupChain, statistics::units::Count::get(),
+             "index slots probed per write buffer lookup"),
     cmd(MemCmd::NUM_MEM_CMDS)
 {
     for (int idx = 0; idx < MemCmd::NUM_MEM_CMDS; ++idx)
@@ -2517,6 +2787,11 @@ BaseCache::CacheStats::regStats()
 
     dataExpansions.flags(nozero | nonan);
     dataContractions.flags(nozero | nonan);
+    warmedTagHits.flags(nozero | nonan);
+    warmedTagMisses.flags(nozero | nonan);
+
+    mshrLookupChain.init(0, 8, 1).flags(nozero | nonan);
+    writeBufferLookupChain.init(0, 8, 1).flags(nozero | nonan);
 }
 
 void
@@ -2589,6 +2864,14 @@ Tick
 BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
 {
     if (cache.system->bypassCaches()) {
+        if (!cache.warmTagsWhenBypassed) {
+            pkt->clearBlockWarmed();
+        } else if (pkt->isEviction()) {
+            // A cache above dropped a block it warmed, we keep ours
+            return 0;
+        } else {
+            cache.warmTags(pkt);
+        }
         // Forward the request if the system is in cache bypass mode.
         return cache.memSidePort.sendAtomic(pkt);
     } else {
@@ -2596,6 +2879,20 @@ BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
 }
 
+Tick
+BaseCache::CpuSidePort::recvAtomicBackdoor(PacketPtr pkt,
+                                           MemBackdoorPtr &backdoor)
+{
+    // Accesses through a backdoor would not be seen by the tags, so
+    // only hand one out if the cache is bypassed and not warming
+    if (cache.system->bypassCaches() && !cache.warmTagsWhenBypassed) {
+        pkt->clearBlockWarmed();
+        return cache.memSidePort.sendAtomicBackdoor(pkt, backdoor);
+    } else {
+        return recvAtomic(pkt);
+    }
+}
+
 void
 BaseCache::CpuSidePort::recvFunctional(PacketPtr pkt)
 {
@@ -2610,6 +2907,14 @@ BaseCache::CpuSidePort::recvFunctional(PacketPtr pkt)
     cache.functionalAccess(pkt, true);
 }
 
+void
+BaseCache::CpuSidePort::recvMemBackdoorReq(const MemBackdoorReq &req,
+                                           MemBackdoorPtr &backdoor)
+{
+    if (cache.system->bypassCaches() && !cache.warmTagsWhenBypassed)
+        cache.memSidePort.sendMemBackdoorReq(req, backdoor);
+}
+
 AddrRangeList
 BaseCache::CpuSidePort::getAddrRanges() const
 {
@@ -2622,6 +2927,7 @@ CpuSidePort::CpuSidePort(const std::string &_name, BaseCache& _cache,
                          const std::string &_label)
     : CacheResponsePort(_name, _cache, _label)
 {
+    setTimingReqHandler(&directTimingReq);
 }
 
 ///////////////
@@ -2711,6 +3017,9 @@ BaseCache::MemSidePort::MemSidePort(const std::string &_name,
       _reqQueue(*_cache, *this, _snoopRespQueue, _label),
       _snoopRespQueue(*_cache, *this, true, _label), cache(_cache)
 {
+    setTimingRespHandler(&directTimingResp);
+    _reqQueue.enableStats(_cache, "memSideQueue");
+    _snoopRespQueue.enableStats(_cache, "memSideSnoopRespQueue");
 }
 
 void
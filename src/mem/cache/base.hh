@@ -217,7 +217,7 @@ class BaseCache : public ClockedObject
      * The memory-side port extends the base cache request port with
      * access functions for functional, atomic and timing snoops.
      */
-    class MemSidePort : public CacheRequestPort
+    class MemSidePort final : public CacheRequestPort
     {
       private:
 
@@ -239,6 +239,15 @@ class BaseCache : public ClockedObject
 
         virtual void recvFunctionalSnoop(PacketPtr pkt);
 
+      private:
+
+        static bool
+        directTimingResp(RequestPort &port, PacketPtr pkt)
+        {
+            return static_cast<MemSidePort &>(port)
+                .MemSidePort::recvTimingResp(pkt);
+        }
+
       public:
 
         MemSidePort(const std::string &_name, BaseCache *_cache,
@@ -292,7 +301,7 @@ class BaseCache : public ClockedObject
      * The CPU-side port extends the base cache response port with access
      * functions for functional, atomic and timing requests.
      */
-    class CpuSidePort : public CacheResponsePort
+    class CpuSidePort final : public CacheResponsePort
     {
       protected:
         virtual bool recvTimingSnoopResp(PacketPtr pkt) override;
@@ -303,10 +312,25 @@ class BaseCache : public ClockedObject
 
         virtual Tick recvAtomic(PacketPtr pkt) override;
 
+        virtual Tick recvAtomicBackdoor(PacketPtr pkt,
+                                        MemBackdoorPtr &backdoor) override;
+
         virtual void recvFunctional(PacketPtr pkt) override;
 
+        virtual void recvMemBackdoorReq(const MemBackdoorReq &req,
+                                        MemBackdoorPtr &backdoor) override;
+
         virtual AddrRangeList getAddrRanges() const override;
 
+      private:
+
+        static bool
+        directTimingReq(ResponsePort &port, PacketPtr pkt)
+        {
+            return static_cast<CpuSidePort &>(port)
+                .CpuSidePort::recvTimingReq(pkt);
+        }
+
       public:
 
         CpuSidePort(const std::string &_name, BaseCache& _cache,
@@ -341,6 +365,9 @@ class BaseCache : public ClockedObject
         bool coalesce() const override
         { return cache.coalesce(); }
 
+        void prefetchesQueued() const override
+        { cache.schedulePrefetches(); }
+
     } accessor;
 
     /** Miss status registers */
@@ -579,6 +606,23 @@ class BaseCache : public ClockedObject
      */
     virtual void recvTimingSnoopResp(PacketPtr pkt) = 0;
 
+    /**
+     * Update the tags and replacement state for a request that bypasses
+     * the cache in the atomic_noncaching memory mode, allocating a block
+     * on a miss. The data stays in memory, so blocks allocated this way
+     * are refreshed from memory once the caches are used again.
+     *
+     * @param pkt The request forwarded past the cache
+     */
+    void warmTags(PacketPtr pkt);
+
+    /**
+     * Copy the contents of every valid block from memory. All blocks
+     * are clean after the caches have been bypassed, so memory holds
+     * the current data.
+     */
+    void refreshWarmedBlocks();
+
     /**
      * Handle a request in atomic mode that missed in this cache
      *
@@ -629,6 +673,24 @@ class BaseCache : public ClockedObject
     void updateBlockData(CacheBlk *blk, const PacketPtr cpkt,
         bool has_old_data);
 
+    /**
+     * Load the contents of a block of a tags-only cache from the backing
+     * store into its data chunk, so that it can be read.
+     *
+     * @param blk The block to be loaded.
+     */
+    void loadBlkData(CacheBlk *blk);
+
+    /**
+     * Write the data chunk of a block of a tags-only cache through to the
+     * backing store. This is only done where the block is modified on
+     * behalf of a request: the data of fills and writebacks is a copy of
+     * the backing store, possibly older than what it now holds.
+     *
+     * @param blk The block to be stored.
+     */
+    void storeBlkData(CacheBlk *blk);
+
     /**
      * Handle doing the Compare and Swap function for SPARC.
      */
@@ -964,6 +1026,22 @@ class BaseCache : public ClockedObject
      */
     const bool moveContractions;
 
+    /**
+     * Keep the tags and replacement state up to date with the requests
+     * that bypass the cache in the atomic_noncaching memory mode.
+     */
+    const bool warmTagsWhenBypassed;
+
+    /**
+     * The blocks do not hold a copy of their data. Block data is loaded
+     * from the backing store before it is read, and written through to
+     * it when it is updated, so the backing store is always up to date.
+     */
+    const bool tagsOnly;
+
+    /** Blocks were allocated while bypassed and hold no valid data */
+    bool warmedBlocksStale;
+
     /**
      * Bit vector of the blocking reasons for the access path.
      * @sa #BlockedCause
@@ -1148,6 +1226,18 @@ class BaseCache : public ClockedObject
          */
         statistics::Scalar dataContractions;
 
+        /** Number of bypassing requests that hit in the warmed tags. */
+        statistics::Scalar warmedTagHits;
+
+        /** Number of bypassing requests that missed in the warmed tags. */
+        statistics::Scalar warmedTagMisses;
+
+        /** Index slots probed per MSHR lookup. */
+        statistics::Distribution mshrLookupChain;
+
+        /** Index slots probed per write buffer lookup. */
+        statistics::Distribution writeBufferLookupChain;
+
         /** Per-command statistics */
         std::vector<std::unique_ptr<CacheCmdStats>> cmd;
     } stats;
@@ -1161,6 +1251,23 @@ class BaseCache : public ClockedObject
 
     void init() override;
 
+    void drainResume() override;
+
+    /**
+     * Warm the cache from a packet trace in the protobuf format, such
+     * as those recorded by a MemTraceProbe or CommMonitor in front of
+     * the cache. Every cacheable read or write in the trace is replayed
+     * as an atomic access, in trace order and without advancing time,
+     * so the tags, replacement and coherence state end up as if the
+     * trace was run. Blocks that the trace writes are marked dirty if
+     * they are writable. The memory system must be drained and not
+     * bypassing the caches.
+     *
+     * @param filename The trace to read
+     * @return The number of cache lines accessed
+     */
+    uint64_t warmFromTrace(const std::string &filename);
+
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
@@ -1282,6 +1389,12 @@ class BaseCache : public ClockedObject
         memSidePort.schedSendEvent(time);
     }
 
+    /**
+     * Schedule a send event for the next prefetch, if there is one and
+     * the cache can currently issue prefetches.
+     */
+    void schedulePrefetches();
+
     bool inCache(Addr addr, bool is_secure) const {
         return tags->findBlock(addr, is_secure);
     }
@@ -390,7 +390,7 @@ Cache::handleTimingReqMiss(PacketPtr pkt, CacheBlk *blk, Tick forward_time,
 
         if (!mshr) {
             // copy the request and create a new SoftPFReq packet
-            RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
+            RequestPtr req = Request::create(pkt->req->getPaddr(),
                                                     pkt->req->getSize(),
                                                     pkt->req->getFlags(),
                                                     pkt->req->requestorId());
@@ -975,7 +975,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     assert(blk && blk->isValid() && !blk->isSet(CacheBlk::DirtyBit));
 
     // Creating a zero sized write, a message to the snoop filter
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1224,6 +1224,9 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
                  "%s is passing a Modified line through %s, "
                  "but keeping the block", name(), pkt->print());
 
+        if (tagsOnly)
+            loadBlkData(blk);
+
         if (is_timing) {
             doTimingSupplyResponse(pkt, blk->data, is_deferred, pending_inval);
         } else {
@@ -291,7 +291,7 @@ class CacheBlk : public TaggedEntry
     uint32_t getSrcRequestorId() const { return _srcRequestorId; }
 
     /** Getter for _partitionId */
-    uint64_t getPartitionId() const { return _partitionId; }
+    uint64_t getPartitionId() const override { return _partitionId; }
 
     /** Get the number of references to this block since insertion. */
     unsigned getRefCount() const { return _refCount; }
@@ -68,6 +68,12 @@ struct CacheAccessor
 
     /** Determine if cache is coalescing writes */
     virtual bool coalesce() const = 0;
+
+    /**
+     * Notify the cache that prefetches were queued outside of the
+     * handling of an access, so that it schedules sending them.
+     */
+    virtual void prefetchesQueued() const {}
 };
 
 /**
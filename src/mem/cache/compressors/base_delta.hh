@@ -120,6 +120,19 @@ class BaseDelta : public DictionaryCompressor<BaseType>
 
     void addToDictionary(DictionaryEntry data) override;
 
+    /**
+     * Compress a line by checking the deltas of all its values against
+     * the zero base and a single explicit base at once. This gives the
+     * same size and patterns as compressing the line value by value,
+     * and is used whenever the line needs at most one explicit base.
+     *
+     * @param chunks The cache line to be compressed.
+     * @return Cache line after compression, or nullptr if the line does
+     *         not fit in the bases, or is too long for the kernels.
+     */
+    std::unique_ptr<Base::CompressionData> fastCompress(
+        const std::vector<Base::Chunk>& chunks);
+
     std::unique_ptr<Base::CompressionData> compress(
         const std::vector<Base::Chunk>& chunks,
         Cycles& comp_lat, Cycles& decomp_lat) override;
@@ -33,9 +33,11 @@
 #ifndef __MEM_CACHE_COMPRESSORS_BASE_DELTA_IMPL_HH__
 #define __MEM_CACHE_COMPRESSORS_BASE_DELTA_IMPL_HH__
 
+#include "base/bitfield.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/base_delta.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/line_kernels.hh"
 
 namespace gem5
 {
@@ -69,13 +71,58 @@ BaseDelta<BaseType, DeltaSizeBits>::addToDictionary(DictionaryEntry data)
         DictionaryCompressor<BaseType>::numEntries++] = data;
 }
 
+template <class BaseType, std::size_t DeltaSizeBits>
+std::unique_ptr<Base::CompressionData>
+BaseDelta<BaseType, DeltaSizeBits>::fastCompress(
+    const std::vector<Base::Chunk>& chunks)
+{
+    const std::size_t n = chunks.size();
+    if (n > 64) {
+        return nullptr;
+    }
+    const unsigned base_bits = 8 * sizeof(BaseType);
+    const int num_bases = line_kernels::numDeltaBases(chunks.data(), n,
+        base_bits, DeltaSizeBits ? mask(DeltaSizeBits - 1) : 0);
+    if (num_bases < 0) {
+        return nullptr;
+    }
+
+    // Each explicit base is stored as a no-match, and every other value
+    // as a delta match. Unused bases still take space, except for the
+    // implicit zero base
+    const DictionaryEntry zero =
+        DictionaryCompressor<BaseType>::toDictionaryEntry(0);
+    const std::size_t size_bits =
+        num_bases * PatternX(zero, 0).getSizeBits() +
+        (n - num_bases) * PatternM(zero, 0).getSizeBits() +
+        (DEFAULT_MAX_NUM_BASES - 1 - num_bases) * base_bits;
+
+    auto &patterns = DictionaryCompressor<BaseType>::dictionaryStats.patterns;
+    patterns[X] += num_bases;
+    patterns[M] += n - num_bases;
+
+    DPRINTF(CacheComp, "Base%dDelta%d compressed line with %d base(s)\n",
+        base_bits, DeltaSizeBits, num_bases);
+    return DictionaryCompressor<BaseType>::instantiateFastCompData(chunks,
+        size_bits);
+}
+
 template <class BaseType, std::size_t DeltaSizeBits>
 std::unique_ptr<Base::CompressionData>
 BaseDelta<BaseType, DeltaSizeBits>::compress(
     const std::vector<Base::Chunk>& chunks, Cycles& comp_lat,
     Cycles& decomp_lat)
 {
-    std::unique_ptr<Base::CompressionData> comp_data =
+    std::unique_ptr<Base::CompressionData> comp_data = fastCompress(chunks);
+    if (comp_data) {
+        DictionaryCompressor<BaseType>::setLatencies(chunks.size(), comp_lat,
+            decomp_lat);
+        return comp_data;
+    }
+
+    // Otherwise compress value by value. Lines needing more bases fail,
+    // but their patterns must still be accounted
+    comp_data =
         DictionaryCompressor<BaseType>::compress(chunks, comp_lat, decomp_lat);
 
     // If there are more bases than the maximum, the compressor failed.
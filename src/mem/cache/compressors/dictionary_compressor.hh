@@ -236,6 +236,30 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     virtual std::unique_ptr<DictionaryCompressor::CompData>
     instantiateDictionaryCompData() const;
 
+    /**
+     * Create the compression data of a line compressed by a fast path,
+     * which determines the size and patterns of the whole line at once
+     * instead of compressing it value by value. As there are no pattern
+     * entries, the values are kept so that the line can be decompressed.
+     *
+     * @param chunks The cache line that was compressed.
+     * @param size_bits The compressed size of the line, in bits.
+     * @return Cache line after compression.
+     */
+    std::unique_ptr<Base::CompressionData> instantiateFastCompData(
+        const std::vector<Chunk>& chunks, std::size_t size_bits) const;
+
+    /**
+     * Set the compression and decompression latencies of a line from the
+     * degree of parallelization of the compressor.
+     *
+     * @param num_chunks The number of chunks of the line.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     */
+    void setLatencies(std::size_t num_chunks, Cycles& comp_lat,
+        Cycles& decomp_lat) const;
+
     /**
      * Apply compression.
      *
@@ -395,6 +419,9 @@ class DictionaryCompressor<T>::CompData : public CompressionData
     /** The patterns matched in the original line. */
     std::vector<std::unique_ptr<Pattern>> entries;
 
+    /** The original values, if compressed without pattern entries. */
+    std::vector<T> values;
+
     CompData();
     ~CompData() = default;
 
@@ -90,6 +90,29 @@ DictionaryCompressor<T>::instantiateDictionaryCompData() const
     return std::unique_ptr<DictionaryCompressor<T>::CompData>(new CompData());
 }
 
+template <typename T>
+std::unique_ptr<Base::CompressionData>
+DictionaryCompressor<T>::instantiateFastCompData(
+    const std::vector<Chunk>& chunks, std::size_t size_bits) const
+{
+    std::unique_ptr<CompData> comp_data = instantiateDictionaryCompData();
+    comp_data->values.assign(chunks.begin(), chunks.end());
+    comp_data->setSizeBits(size_bits);
+    return comp_data;
+}
+
+template <class T>
+void
+DictionaryCompressor<T>::setLatencies(std::size_t num_chunks,
+    Cycles& comp_lat, Cycles& decomp_lat) const
+{
+    // Set latencies based on the degree of parallelization, and any extra
+    // latencies due to shifting or packaging
+    comp_lat = Cycles(compExtraLatency + (num_chunks / compChunksPerCycle));
+    decomp_lat = Cycles(decompExtraLatency +
+        (num_chunks / decompChunksPerCycle));
+}
+
 template <typename T>
 std::unique_ptr<typename DictionaryCompressor<T>::Pattern>
 DictionaryCompressor<T>::compressValue(const T data)
@@ -153,12 +176,7 @@ std::unique_ptr<Base::CompressionData>
 DictionaryCompressor<T>::compress(const std::vector<Chunk>& chunks,
     Cycles& comp_lat, Cycles& decomp_lat)
 {
-    // Set latencies based on the degree of parallelization, and any extra
-    // latencies due to shifting or packaging
-    comp_lat = Cycles(compExtraLatency +
-        (chunks.size() / compChunksPerCycle));
-    decomp_lat = Cycles(decompExtraLatency +
-        (chunks.size() / decompChunksPerCycle));
+    setLatencies(chunks.size(), comp_lat, decomp_lat);
 
     return compress(chunks);
 }
@@ -192,8 +210,9 @@ DictionaryCompressor<T>::decompress(const CompressionData* comp_data,
     // Reset dictionary
     resetDictionary();
 
-    // Decompress every entry sequentially
-    std::vector<T> decomp_values;
+    // Decompress every entry sequentially. Lines compressed by a fast
+    // path have no entries, but hold their values instead
+    std::vector<T> decomp_values = casted_comp_data->values;
     for (const auto& entry : casted_comp_data->entries) {
         const T value = decompressValue(&*entry);
         decomp_values.push_back(value);
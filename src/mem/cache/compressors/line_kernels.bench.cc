@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Classifying the lines of a base-delta-immediate compressor with the
+ * line kernels and value by value.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "mem/cache/compressors/line_kernels.hh"
+
+using namespace gem5;
+using namespace gem5::compression;
+
+namespace
+{
+
+/**
+ * Value by value model of a base-delta-immediate compressor, following
+ * the dictionary compressor: the dictionary starts with the zero base,
+ * each value is a delta of the first base it fits, and any other value
+ * is allocated as a new base.
+ *
+ * @return The number of explicit bases, or -1 if more than one is needed.
+ */
+template <class T>
+int
+referenceBases(const std::vector<uint64_t> &values, unsigned delta_bits)
+{
+    using S = std::make_signed_t<T>;
+    const S limit = mask(delta_bits - 1);
+    std::vector<T> bases = { 0 };
+    for (const uint64_t value : values) {
+        bool matched = false;
+        for (const T base : bases) {
+            const S delta = static_cast<T>(value) - base;
+            if (delta >= -limit && delta <= limit) {
+                matched = true;
+                break;
+            }
+        }
+        if (!matched)
+            bases.push_back(value);
+    }
+    return bases.size() > 2 ? -1 : bases.size() - 1;
+}
+
+/**
+ * Generate the values of a line, mixing the typical contents of cache
+ * lines: zeros, small integers, pointers around a base, and random data.
+ */
+std::vector<uint64_t>
+makeLine(std::mt19937_64 &rng, std::size_t n, unsigned value_bits)
+{
+    const uint64_t value_mask = mask(value_bits);
+    const uint64_t base = rng() & value_mask;
+    const unsigned kind = rng() % 4;
+    std::vector<uint64_t> values(n);
+    for (auto &value : values) {
+        switch (kind) {
+          case 0:
+            value = (rng() % 8) ? 0 : rng() % 256;
+            break;
+          case 1:
+            value = (rng() % 512 - 256) & value_mask;
+            break;
+          case 2:
+            value = (base + (rng() % 65536) - 32768) & value_mask;
+            break;
+          default:
+            value = (rng() % 2) ? ((base + rng() % 256) & value_mask) :
+                rng() & value_mask;
+            break;
+        }
+    }
+    return values;
+}
+
+std::vector<std::vector<uint64_t>>
+makeLines()
+{
+    std::mt19937_64 rng(3);
+    std::vector<std::vector<uint64_t>> lines;
+    for (int i = 0; i < 4096; ++i)
+        lines.push_back(makeLine(rng, 16, 32));
+    return lines;
+}
+
+void
+BM_ReferenceBases(benchmark::State &state)
+{
+    const auto lines = makeLines();
+    for (auto _ : state) {
+        for (const auto &line : lines)
+            benchmark::DoNotOptimize(referenceBases<uint32_t>(line, 8));
+    }
+    state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_ReferenceBases);
+
+void
+BM_NumDeltaBases(benchmark::State &state)
+{
+    const auto lines = makeLines();
+    for (auto _ : state) {
+        for (const auto &line : lines) {
+            benchmark::DoNotOptimize(
+                line_kernels::numDeltaBases(line.data(), 16, 32, 127));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_NumDeltaBases);
+
+} // anonymous namespace
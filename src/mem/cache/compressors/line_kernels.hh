@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Whole-line kernels used by the fast paths of the dictionary compressors.
+ */
+
+#ifndef __MEM_CACHE_COMPRESSORS_LINE_KERNELS_HH__
+#define __MEM_CACHE_COMPRESSORS_LINE_KERNELS_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "base/bitfield.hh"
+
+namespace gem5
+{
+
+namespace compression
+{
+
+/**
+ * Kernels classifying all the values of a cache line at once. The values
+ * are the chunks of the line, one per 64-bit element, which is how the
+ * compressors receive them. The kernels use AVX2 or NEON when the
+ * simulator is built for a host supporting them, and a plain loop
+ * otherwise; the results are the same either way.
+ */
+namespace line_kernels
+{
+
+/**
+ * Count the values equal to a given value.
+ *
+ * @param values The values to compare.
+ * @param n The number of values.
+ * @param value The value to compare against.
+ * @return The number of values equal to value.
+ */
+inline std::size_t
+countEqual(const uint64_t *values, std::size_t n, uint64_t value)
+{
+    std::size_t count = 0;
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i needle = _mm256_set1_epi64x(value);
+    for (; i + 4 <= n; i += 4) {
+        const __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(values + i));
+        count += popCount(_mm256_movemask_pd(
+            _mm256_castsi256_pd(_mm256_cmpeq_epi64(v, needle))));
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint64x2_t needle = vdupq_n_u64(value);
+    uint64x2_t acc = vdupq_n_u64(0);
+    for (; i + 2 <= n; i += 2)
+        acc = vsubq_u64(acc, vceqq_u64(vld1q_u64(values + i), needle));
+    count = vaddvq_u64(acc);
+#endif
+    for (; i < n; ++i)
+        count += (values[i] == value);
+    return count;
+}
+
+/**
+ * Find which values differ from a base by a delta that fits a signed
+ * container, that is, which values v satisfy -limit <= v - base <= limit
+ * when computed in a value_bits wide type.
+ *
+ * @param values The values to check, at most 64.
+ * @param n The number of values.
+ * @param base The base the deltas are computed against.
+ * @param value_bits The size of the values, in bits.
+ * @param limit The largest magnitude of a delta.
+ * @return A mask with bit i set if the delta of value i fits.
+ */
+inline uint64_t
+deltaFitMask(const uint64_t *values, std::size_t n, uint64_t base,
+             unsigned value_bits, uint64_t limit)
+{
+    assert(n <= 64);
+    assert(value_bits <= 64 && limit < (uint64_t(1) << (value_bits - 1)));
+
+    // v - base fits if v - base + limit, wrapped to the value size,
+    // is at most 2 * limit
+    const uint64_t value_mask = mask(value_bits);
+    const uint64_t offset = limit - base;
+    const uint64_t range = 2 * limit;
+
+    uint64_t fits = 0;
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    // AVX2 only has signed comparisons, so both sides are biased
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i v_offset = _mm256_set1_epi64x(offset);
+    const __m256i v_mask = _mm256_set1_epi64x(value_mask);
+    const __m256i v_range = _mm256_xor_si256(
+        _mm256_set1_epi64x(range), sign);
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(values + i));
+        v = _mm256_and_si256(_mm256_add_epi64(v, v_offset), v_mask);
+        const __m256i over =
+            _mm256_cmpgt_epi64(_mm256_xor_si256(v, sign), v_range);
+        const uint64_t over_mask =
+            _mm256_movemask_pd(_mm256_castsi256_pd(over));
+        fits |= (~over_mask & 0xf) << i;
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const uint64x2_t v_offset = vdupq_n_u64(offset);
+    const uint64x2_t v_mask = vdupq_n_u64(value_mask);
+    const uint64x2_t v_range = vdupq_n_u64(range);
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t v = vld1q_u64(values + i);
+        v = vandq_u64(vaddq_u64(v, v_offset), v_mask);
+        const uint64x2_t le = vcleq_u64(v, v_range);
+        fits |= ((vgetq_lane_u64(le, 0) & 1) |
+                 (vgetq_lane_u64(le, 1) & 2)) << i;
+    }
+#endif
+    for (; i < n; ++i) {
+        if (((values[i] + offset) & value_mask) <= range)
+            fits |= uint64_t(1) << i;
+    }
+    return fits;
+}
+
+/**
+ * Find the number of explicit bases a base-delta-immediate compressor
+ * needs for a line, besides the implicit zero base. The first value which
+ * is not an immediate becomes the explicit base, and all the values must
+ * then be deltas of either base.
+ *
+ * @param values The values of the line, at most 64.
+ * @param n The number of values.
+ * @param value_bits The size of the values, in bits.
+ * @param limit The largest magnitude of a delta.
+ * @return 0 or 1 explicit bases, or -1 if the line needs more bases.
+ */
+inline int
+numDeltaBases(const uint64_t *values, std::size_t n, unsigned value_bits,
+              uint64_t limit)
+{
+    const uint64_t all = mask(n);
+    const uint64_t immediates =
+        deltaFitMask(values, n, 0, value_bits, limit);
+    if (immediates == all)
+        return 0;
+
+    const uint64_t base = values[findLsbSet(~immediates & all)];
+    const uint64_t deltas =
+        deltaFitMask(values, n, base, value_bits, limit);
+    return ((immediates | deltas) == all) ? 1 : -1;
+}
+
+} // namespace line_kernels
+} // namespace compression
+} // namespace gem5
+
+#endif //__MEM_CACHE_COMPRESSORS_LINE_KERNELS_HH__
@@ -36,6 +36,7 @@
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/line_kernels.hh"
 #include "params/RepeatedQwordsCompressor.hh"
 
 namespace gem5
@@ -60,16 +61,27 @@ std::unique_ptr<Base::CompressionData>
 RepeatedQwords::compress(const std::vector<Chunk>& chunks,
     Cycles& comp_lat, Cycles& decomp_lat)
 {
-    std::unique_ptr<Base::CompressionData> comp_data =
-        DictionaryCompressor::compress(chunks);
+    // The first value is allocated in the dictionary, and only the values
+    // equal to it can match; any other value allocates a new entry that
+    // is never matched, so the whole line can be classified at once
+    assert(!chunks.empty());
+    const std::size_t num_repeated =
+        line_kernels::countEqual(chunks.data(), chunks.size(), chunks[0]);
+    dictionaryStats.patterns[X] += 1 + chunks.size() - num_repeated;
+    dictionaryStats.patterns[M] += num_repeated - 1;
 
     // Since there is a single value repeated over and over, there should be
     // a single dictionary entry. If there are more, the compressor failed
-    assert(numEntries >= 1);
-    if (numEntries > 1) {
-        comp_data->setSizeBits(blkSize * 8);
+    std::size_t size_bits = blkSize * 8;
+    if (num_repeated == chunks.size()) {
+        const DictionaryEntry first = toDictionaryEntry(chunks[0]);
+        size_bits = PatternX(first, -1).getSizeBits() +
+            (chunks.size() - 1) * PatternM(first, 0).getSizeBits();
+    } else {
         DPRINTF(CacheComp, "Repeated qwords compression failed\n");
     }
+    std::unique_ptr<Base::CompressionData> comp_data =
+        instantiateFastCompData(chunks, size_bits);
 
     // Set compression latency
     comp_lat = Cycles(1);
@@ -36,6 +36,7 @@
 #include "base/trace.hh"
 #include "debug/CacheComp.hh"
 #include "mem/cache/compressors/dictionary_compressor_impl.hh"
+#include "mem/cache/compressors/line_kernels.hh"
 #include "params/ZeroCompressor.hh"
 
 namespace gem5
@@ -60,14 +61,23 @@ std::unique_ptr<Base::CompressionData>
 Zero::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     Cycles& decomp_lat)
 {
-    std::unique_ptr<Base::CompressionData> comp_data =
-        DictionaryCompressor::compress(chunks);
+    // Every zero value matches the zero pattern, and every other value
+    // is a no-match, so the whole line can be classified at once
+    const std::size_t num_zeros =
+        line_kernels::countEqual(chunks.data(), chunks.size(), 0);
+    dictionaryStats.patterns[Z] += num_zeros;
+    dictionaryStats.patterns[X] += chunks.size() - num_zeros;
 
     // If there is any non-zero entry, the compressor failed
-    if (numEntries > 0) {
-        comp_data->setSizeBits(blkSize * 8);
+    std::size_t size_bits = blkSize * 8;
+    if (num_zeros == chunks.size()) {
+        size_bits = chunks.size() *
+            PatternZ(toDictionaryEntry(0), -1).getSizeBits();
+    } else {
         DPRINTF(CacheComp, "Zero compression failed\n");
     }
+    std::unique_ptr<Base::CompressionData> comp_data =
+        instantiateFastCompData(chunks, size_bits);
 
     // Set compression latency (Assumes full line zero comparison)
     comp_lat = Cycles(1);
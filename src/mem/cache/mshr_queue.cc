@@ -73,9 +73,13 @@ MSHRQueue::allocate(Addr blk_addr, unsigned blk_size, PacketPtr pkt,
 
     mshr->allocate(blk_addr, blk_size, pkt, when_ready, order, alloc_on_fill);
     mshr->allocIter = allocatedList.insert(allocatedList.end(), mshr);
+    addToIndex(mshr);
     mshr->readyIter = addToReadyList(mshr);
 
     allocated += 1;
+    // keep a drain that already counted this queue as drained going
+    // until the new entry is deallocated
+    signalDrainUndone();
     return mshr;
 }
 
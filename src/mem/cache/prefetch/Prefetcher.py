@@ -140,6 +140,17 @@ class QueuedPrefetcher(BasePrefetcher):
     )
     queue_squash = Param.Bool(True, "Squash queued prefetch on demand access")
     queue_filter = Param.Bool(True, "Don't queue redundant prefetches")
+    async_training = Param.Bool(
+        False,
+        "Train on a separate host thread, and queue the prefetch "
+        "candidates once training_latency has elapsed",
+    )
+    training_latency = Param.Cycles(
+        0, "Latency of asynchronous training, in cycles"
+    )
+    training_queue_size = Param.Unsigned(
+        64, "Maximum number of accesses waiting for asynchronous training"
+    )
     cache_snoop = Param.Bool(
         False, "Snoop cache to eliminate redundant request"
     )
@@ -59,7 +59,7 @@ AccessMapPatternMatching::AccessMapPatternMatching(
                      AccessMapEntry(hotZoneSize / blkSize)),
       numGoodPrefetches(0), numTotalPrefetches(0), numRawCacheMisses(0),
       numRawCacheHits(0), degree(startDegree), usefulDegree(startDegree),
-      epochEvent([this]{ processEpochEvent(); }, name())
+      epochEvent([this]{ processEpochEvent(); }, name()), owner(nullptr)
 {
     fatal_if(!isPowerOf2(hotZoneSize),
         "the hot zone size must be a power of 2");
@@ -74,6 +74,9 @@ AccessMapPatternMatching::startup()
 void
 AccessMapPatternMatching::processEpochEvent()
 {
+    if (owner) {
+        owner->waitForTraining();
+    }
     schedule(epochEvent, clockEdge(epochCycles));
     double prefetch_accuracy =
         ((double) numGoodPrefetches) / ((double) numTotalPrefetches);
@@ -261,6 +264,7 @@ AccessMapPatternMatching::calculatePrefetch(const Base::PrefetchInfo &pfi,
 AMPM::AMPM(const AMPMPrefetcherParams &p)
   : Queued(p), ampm(*p.ampm)
 {
+    ampm.setOwner(this);
 }
 
 void
@@ -184,10 +184,19 @@ class AccessMapPatternMatching : public ClockedObject
     void processEpochEvent();
     EventFunctionWrapper epochEvent;
 
+    /** Prefetcher whose training uses this object, if any. */
+    Base *owner;
+
   public:
     AccessMapPatternMatching(const AccessMapPatternMatchingParams &p);
     ~AccessMapPatternMatching() = default;
 
+    /**
+     * Set the prefetcher training with this object, so that the epoch
+     * waits for any training running on another host thread.
+     */
+    void setOwner(Base *pf) { owner = pf; }
+
     void startup() override;
     void calculatePrefetch(const Base::PrefetchInfo &pfi,
         std::vector<Queued::AddrPriority> &addresses,
@@ -204,6 +213,9 @@ class AMPM : public Queued
     void calculatePrefetch(const PrefetchInfo &pfi,
                            std::vector<AddrPriority> &addresses,
                            const CacheAccessor &cache) override;
+
+  protected:
+    bool supportsAsyncTraining() const override { return true; }
 };
 
 } // namespace prefetch
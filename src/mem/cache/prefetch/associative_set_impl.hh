@@ -52,16 +52,11 @@ Entry*
 AssociativeSet<Entry>::findEntry(Addr addr, bool is_secure) const
 {
     Addr tag = indexingPolicy->extractTag(addr);
-    auto candidates = indexingPolicy->getPossibleEntries(addr);
-
-    for (auto candidate : candidates) {
-        Entry* entry = static_cast<Entry*>(candidate);
-        if (entry->matchTag(tag, is_secure)) {
-            return entry;
-        }
-    }
-
-    return nullptr;
+    return static_cast<Entry*>(indexingPolicy->findPossibleEntry(addr,
+        [tag, is_secure](ReplaceableEntry *candidate)
+        {
+            return static_cast<Entry*>(candidate)->matchTag(tag, is_secure);
+        }));
 }
 
 template<class Entry>
@@ -86,6 +86,7 @@ void
 Base::PrefetchListener::notify(const CacheAccessProbeArg &arg)
 {
     if (isFill) {
+        parent.waitForTraining();
         parent.notifyFill(arg);
     } else {
         parent.probeNotify(arg, miss);
@@ -95,8 +96,10 @@ Base::PrefetchListener::notify(const CacheAccessProbeArg &arg)
 void
 Base::PrefetchEvictListener::notify(const EvictionInfo &info)
 {
-    if (info.newData.empty())
+    if (info.newData.empty()) {
+        parent.waitForTraining();
         parent.notifyEvict(info);
+    }
 }
 
 Base::Base(const BasePrefetcherParams &p)
@@ -398,6 +398,13 @@ class Base : public ClockedObject
     virtual void notifyEvict(const EvictionInfo &info)
     {}
 
+    /**
+     * Wait until any training running on another host thread is done.
+     * This must be called before the state of the prefetcher is used
+     * outside of its training, e.g., by other probe notifications.
+     */
+    virtual void waitForTraining() {}
+
     virtual PacketPtr getPacket() = 0;
 
     virtual Tick nextPrefetchReadyTime() const = 0;
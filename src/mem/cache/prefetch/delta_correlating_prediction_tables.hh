@@ -134,6 +134,9 @@ class DCPT : public Queued
     void calculatePrefetch(const PrefetchInfo &pfi,
         std::vector<AddrPriority> &addresses,
         const CacheAccessor &cache) override;
+
+  protected:
+    bool supportsAsyncTraining() const override { return true; }
 };
 
 } // namespace prefetch
@@ -139,6 +139,9 @@ class IrregularStreamBuffer : public Queued
     void calculatePrefetch(const PrefetchInfo &pfi,
                            std::vector<AddrPriority> &addresses,
                            const CacheAccessor &cache) override;
+
+  protected:
+    bool supportsAsyncTraining() const override { return true; }
 };
 
 } // namespace prefetch
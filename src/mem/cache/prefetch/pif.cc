@@ -136,6 +136,9 @@ PIF::CompactorEntry::getPredictedAddresses(unsigned int log_blk_size,
 void
 PIF::notifyRetiredInst(const Addr pc)
 {
+    // The compactors are shared with the training
+    waitForTraining();
+
     // First access to the prefetcher
     if (temporalCompactor.size() == 0) {
         spatialCompactor = CompactorEntry(pc, precSize, succSize);
@@ -177,6 +177,7 @@ class PIF : public Queued
         /** Array of probe listeners */
         std::vector<PrefetchListenerPC *> listenersPC;
 
+        bool supportsAsyncTraining() const override { return true; }
 
     public:
         PIF(const PIFPrefetcherParams &p);
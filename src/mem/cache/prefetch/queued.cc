@@ -47,6 +47,7 @@
 #include "mem/cache/base.hh"
 #include "mem/request.hh"
 #include "params/QueuedPrefetcher.hh"
+#include "sim/cur_tick.hh"
 
 namespace gem5
 {
@@ -60,8 +61,8 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
-                                                0, requestor_id);
+    RequestPtr req = Request::create(paddr, blk_size,
+                                      0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
@@ -104,18 +105,159 @@ Queued::Queued(const QueuedPrefetcherParams &p)
       latency(p.latency), queueSquash(p.queue_squash),
       queueFilter(p.queue_filter), cacheSnoop(p.cache_snoop),
       tagPrefetch(p.tag_prefetch),
-      throttleControlPct(p.throttle_control_percentage), statsQueued(this)
+      throttleControlPct(p.throttle_control_percentage), statsQueued(this),
+      asyncTraining(p.async_training), trainingLatency(p.training_latency),
+      trainingJobs(p.async_training ? p.training_queue_size : 0),
+      jobsIssued(0), jobsTrained(0), jobsQueued(0), trainerSleeping(false),
+      trainerExit(false),
+      trainingDoneEvent([this]{ queueTrainedCandidates(); },
+                        name() + ".trainingDoneEvent")
 {
+    fatal_if(asyncTraining && p.training_queue_size == 0,
+             "%s: asynchronous training needs a non-empty training queue.\n",
+             name());
 }
 
 Queued::~Queued()
 {
+    if (trainer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(trainerMutex);
+            trainerExit = true;
+        }
+        trainerWakeup.notify_one();
+        trainer.join();
+    }
+    for (TrainingJob &job : trainingJobs) {
+        delete job.pkt;
+    }
+
     // Delete the queued prefetch packets
     for (DeferredPacket &p : pfq) {
         delete p.pkt;
     }
 }
 
+void
+Queued::init()
+{
+    Base::init();
+    fatal_if(asyncTraining && !supportsAsyncTraining(),
+             "%s: this prefetcher does not support asynchronous training.\n",
+             name());
+}
+
+void
+Queued::startup()
+{
+    Base::startup();
+    if (asyncTraining) {
+        trainer = std::thread([this]{ trainingLoop(); });
+    }
+}
+
+DrainState
+Queued::drain()
+{
+    return jobsQueued == jobsIssued ? DrainState::Drained :
+        DrainState::Draining;
+}
+
+void
+Queued::preDumpStats()
+{
+    // The training may update the prefetcher's statistics
+    waitForTraining();
+    Base::preDumpStats();
+}
+
+void
+Queued::resetStats()
+{
+    waitForTraining();
+    Base::resetStats();
+}
+
+void
+Queued::waitForTraining()
+{
+    const uint64_t issued = jobsIssued.load(std::memory_order_relaxed);
+    while (jobsTrained.load(std::memory_order_acquire) != issued) {
+        std::this_thread::yield();
+    }
+}
+
+void
+Queued::trainingLoop()
+{
+    // The training sees the tick of the access it trains on as the
+    // current tick, as if it had run inline
+    Tick tick = 0;
+    Gem5Internal::_curTickPtr = &tick;
+
+    uint64_t next = 0;
+    while (!trainerExit) {
+        if (jobsIssued.load(std::memory_order_acquire) == next) {
+            // Sleep until a job is issued. The simulation thread only
+            // notifies if it sees the flag after publishing the job, so
+            // the job counter must be checked again once it is set
+            std::unique_lock<std::mutex> lock(trainerMutex);
+            trainerSleeping = true;
+            trainerWakeup.wait(lock, [&]{
+                return trainerExit || jobsIssued.load() != next;
+            });
+            trainerSleeping = false;
+            continue;
+        }
+
+        // Skip the jobs the simulation thread trained on itself
+        if (jobsTrained.load(std::memory_order_acquire) > next) {
+            ++next;
+            continue;
+        }
+
+        TrainingJob &job = trainingJob(next);
+        tick = job.tick;
+        calculatePrefetch(*job.pfi, job.addresses, *job.cache);
+        jobsTrained.store(++next, std::memory_order_release);
+    }
+}
+
+void
+Queued::queueTrainedCandidates()
+{
+    const CacheAccessor *cache = nullptr;
+    const uint64_t issued = jobsIssued.load(std::memory_order_relaxed);
+    for (; jobsQueued != issued; ++jobsQueued) {
+        TrainingJob &job = trainingJob(jobsQueued);
+        if (job.readyTick > curTick()) {
+            schedule(trainingDoneEvent, job.readyTick);
+            break;
+        }
+
+        // The training ran ahead on the other thread, and is only waited
+        // for if it takes longer on the host than the modelled latency
+        while (jobsTrained.load(std::memory_order_acquire) <= jobsQueued) {
+            std::this_thread::yield();
+        }
+
+        queueCandidates(*job.pfi, job.pkt, job.addresses, *job.cache);
+        cache = job.cache;
+        delete job.pkt;
+        job.pkt = nullptr;
+        job.pfi.reset();
+    }
+
+    if (cache) {
+        cache->prefetchesQueued();
+    }
+
+    if (drainState() == DrainState::Draining && jobsQueued == issued) {
+        DPRINTF(HWPrefetch, "Training queue empty, signalling drained\n");
+        signalDrainDone();
+    }
+}
+
 void
 Queued::printQueue(const std::list<DeferredPacket> &queue) const
 {
@@ -195,10 +337,58 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
         }
     }
 
+    if (asyncTraining) {
+        const uint64_t issued = jobsIssued.load(std::memory_order_relaxed);
+        if (issued - jobsQueued == trainingJobs.size()) {
+            DPRINTF(HWPrefetch, "Training queue full, not training on "
+                    "addr: %#x\n", pfi.getAddr());
+            statsQueued.pfTrainingDropped++;
+            return;
+        }
+
+        // The packet of the access does not outlive it, so keep a copy
+        // of its header, and of its data if it is used for training
+        TrainingJob &job = trainingJob(issued);
+        job.pkt = new Packet(pkt, false, false);
+        job.pfi.reset(new PrefetchInfo(pkt, pfi.getAddr(),
+                                       pfi.isCacheMiss()));
+        job.cache = &cache;
+        job.tick = curTick();
+        job.readyTick = curTick() + clockPeriod() * trainingLatency;
+        job.addresses.clear();
+
+        if (TRACING_ON && (debug::HWPrefetch || debug::HWPrefetchQueue)) {
+            // The trace output is not thread-safe, so train on this
+            // thread while it is enabled. The job still goes through the
+            // ring, so the candidates are queued at the same tick.
+            waitForTraining();
+            calculatePrefetch(*job.pfi, job.addresses, *job.cache);
+            jobsTrained.store(issued + 1, std::memory_order_release);
+            jobsIssued.store(issued + 1);
+        } else {
+            jobsIssued.store(issued + 1);
+            if (trainerSleeping.load()) {
+                std::lock_guard<std::mutex> lock(trainerMutex);
+                trainerWakeup.notify_one();
+            }
+        }
+        if (!trainingDoneEvent.scheduled()) {
+            schedule(trainingDoneEvent, job.readyTick);
+        }
+        return;
+    }
+
     // Calculate prefetches given this access
     std::vector<AddrPriority> addresses;
     calculatePrefetch(pfi, addresses, cache);
+    queueCandidates(pfi, pkt, addresses, cache);
+}
 
+void
+Queued::queueCandidates(const PrefetchInfo &pfi, const PacketPtr &pkt,
+                        std::vector<AddrPriority> &addresses,
+                        const CacheAccessor &cache)
+{
     // Get the maximu number of prefetches that we are allowed to generate
     size_t max_pfs = getMaxPermittedPrefetches(addresses.size());
 
@@ -279,7 +469,10 @@ Queued::QueuedStats::QueuedStats(statistics::Group *parent)
     ADD_STAT(pfSpanPage, statistics::units::Count::get(),
              "number of prefetches that crossed the page"),
     ADD_STAT(pfUsefulSpanPage, statistics::units::Count::get(),
-             "number of prefetches that is useful and crossed the page")
+             "number of prefetches that is useful and crossed the page"),
+    ADD_STAT(pfTrainingDropped, statistics::units::Count::get(),
+             "number of accesses not trained on due to a full training "
+             "queue")
 {
 }
 
@@ -377,7 +570,7 @@ RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = Request::create(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
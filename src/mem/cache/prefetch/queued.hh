@@ -38,15 +38,22 @@
 #ifndef __MEM_CACHE_PREFETCH_QUEUED_HH__
 #define __MEM_CACHE_PREFETCH_QUEUED_HH__
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "arch/generic/mmu.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/cache/prefetch/base.hh"
 #include "mem/packet.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -187,6 +194,7 @@ class Queued : public Base
         statistics::Scalar pfRemovedFull;
         statistics::Scalar pfSpanPage;
         statistics::Scalar pfUsefulSpanPage;
+        statistics::Scalar pfTrainingDropped;
     } statsQueued;
   public:
     using AddrPriority = std::pair<Addr, int32_t>;
@@ -194,9 +202,17 @@ class Queued : public Base
     Queued(const QueuedPrefetcherParams &p);
     virtual ~Queued();
 
+    void init() override;
+    void startup() override;
+    DrainState drain() override;
+    void preDumpStats() override;
+    void resetStats() override;
+
     void
     notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi) override;
 
+    void waitForTraining() override;
+
     void insert(const PacketPtr &pkt, PrefetchInfo &new_pfi, int32_t priority,
                 const CacheAccessor &cache);
 
@@ -212,7 +228,103 @@ class Queued : public Base
 
     void printQueue(const std::list<DeferredPacket> &queue) const;
 
+  protected:
+    /**
+     * Whether calculatePrefetch() can run on another host thread while
+     * the simulation goes on. This requires the training to only use
+     * the prefetcher's own state, and not to query the cache or schedule
+     * events. The prefetcher must also call waitForTraining() before
+     * using that state from anywhere else, like its own events or probe
+     * listeners; fills and evictions are already handled by the base
+     * class.
+     */
+    virtual bool supportsAsyncTraining() const { return false; }
+
   private:
+    /**
+     * An access handed over to asynchronous training. The training
+     * thread fills in the candidates, and the simulation thread queues
+     * them once the modelled training latency has elapsed.
+     */
+    struct TrainingJob
+    {
+        /** Copy of the header of the access. */
+        PacketPtr pkt = nullptr;
+        /** Training information of the access. */
+        std::unique_ptr<PrefetchInfo> pfi;
+        /** Accessor of the cache that was accessed. */
+        const CacheAccessor *cache = nullptr;
+        /** Tick of the access, seen as the current tick by training. */
+        Tick tick = 0;
+        /** Tick when the candidates are queued. */
+        Tick readyTick = 0;
+        /** Prefetch candidates found by the training. */
+        std::vector<AddrPriority> addresses;
+    };
+
+    /**
+     * Train on a separate host thread. The training still runs on the
+     * simulation thread while the prefetcher debug flags are enabled, as
+     * the trace output is not thread-safe.
+     */
+    const bool asyncTraining;
+
+    /** Cycles between an access and queueing its prefetch candidates. */
+    const Cycles trainingLatency;
+
+    /**
+     * Ring of accesses handed over to the training thread. The job
+     * counters below only ever increase, and index it modulo its size.
+     * The simulation thread fills a job and then publishes it through
+     * jobsIssued, the training thread trains it and publishes the
+     * candidates through jobsTrained.
+     */
+    std::vector<TrainingJob> trainingJobs;
+
+    /** Number of jobs handed over to the training thread. */
+    std::atomic<uint64_t> jobsIssued;
+
+    /** Number of jobs the training thread is done with. */
+    std::atomic<uint64_t> jobsTrained;
+
+    /** Number of jobs whose candidates were queued. */
+    uint64_t jobsQueued;
+
+    /** Set while the training thread waits for jobs. */
+    std::atomic<bool> trainerSleeping;
+
+    /** Set to make the training thread exit. */
+    std::atomic<bool> trainerExit;
+
+    std::mutex trainerMutex;
+    std::condition_variable trainerWakeup;
+    std::thread trainer;
+
+    /** Queues the candidates of the trained jobs that are ready. */
+    EventFunctionWrapper trainingDoneEvent;
+
+    TrainingJob &
+    trainingJob(uint64_t seq)
+    {
+        return trainingJobs[seq % trainingJobs.size()];
+    }
+
+    /** Body of the training thread. */
+    void trainingLoop();
+
+    /** Queue the candidates of all jobs whose training latency elapsed. */
+    void queueTrainedCandidates();
+
+    /**
+     * Turn the candidates generated by an access into prefetch requests.
+     * @param pfi information of the access
+     * @param pkt the access
+     * @param addresses the candidates calculated by the prefetcher
+     * @param cache accessor for lookups on the cache
+     */
+    void queueCandidates(const PrefetchInfo &pfi, const PacketPtr &pkt,
+                         std::vector<AddrPriority> &addresses,
+                         const CacheAccessor &cache);
 
     /**
      * Adds a DeferredPacket to the specified queue
@@ -290,6 +290,9 @@ class SignaturePath : public Queued
     void calculatePrefetch(const PrefetchInfo &pfi,
                            std::vector<AddrPriority> &addresses,
                            const CacheAccessor &cache) override;
+
+  protected:
+    bool supportsAsyncTraining() const override { return true; }
 };
 
 } // namespace prefetch
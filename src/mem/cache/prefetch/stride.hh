@@ -170,6 +170,9 @@ class Stride : public Queued
     void calculatePrefetch(const PrefetchInfo &pfi,
                            std::vector<AddrPriority> &addresses,
                            const CacheAccessor &cache) override;
+
+  protected:
+    bool supportsAsyncTraining() const override { return true; }
 };
 
 } // namespace prefetch
@@ -45,12 +45,17 @@
 #ifndef __MEM_CACHE_QUEUE_HH__
 #define __MEM_CACHE_QUEUE_HH__
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <type_traits>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
+#include "base/statistics.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "debug/Drain.hh"
@@ -122,6 +127,106 @@ class Queue : public Drainable, public Named
     /** The number of currently allocated entries. */
     int allocated;
 
+    /**
+     * Open-addressing index of the allocated entries, hashed on the
+     * block address and probed linearly. The lists above still define
+     * the ordering; the index only narrows down the candidates.
+     */
+    std::vector<Entry*> index;
+
+    /** Shift selecting the index slot from the hashed address. */
+    const unsigned indexShift;
+
+    /** Allocation sequence number of each entry, to break ties. */
+    std::vector<uint64_t> allocSeq;
+
+    /** Sequence number given to the next allocated entry. */
+    uint64_t nextAllocSeq;
+
+    /** Optional distribution of the number of slots probed per lookup. */
+    statistics::Distribution *chainLengths;
+
+    size_t
+    indexSlot(Addr blk_addr) const
+    {
+        // Fibonacci hashing, so that the zero block offset bits of
+        // the address do not cluster the entries
+        return (blk_addr * 0x9e3779b97f4a7c15ULL) >> indexShift;
+    }
+
+    uint64_t seqOf(const Entry *entry) const
+    {
+        return allocSeq[entry - entries.data()];
+    }
+
+    /**
+     * Visit every allocated entry sharing the index cluster of the
+     * given block address.
+     *
+     * @param blk_addr The block address to look for.
+     * @param visit Called with each entry with the same block address.
+     */
+    template <typename Visitor>
+    void
+    probeIndex(Addr blk_addr, Visitor &&visit) const
+    {
+        const size_t mask = index.size() - 1;
+        unsigned probes = 0;
+        for (size_t slot = indexSlot(blk_addr); index[slot];
+             slot = (slot + 1) & mask) {
+            ++probes;
+            if (index[slot]->blkAddr == blk_addr)
+                visit(index[slot]);
+        }
+        if (chainLengths)
+            chainLengths->sample(probes);
+    }
+
+    /**
+     * Add a freshly allocated entry to the address index. Must be
+     * called once the entry knows its block address.
+     *
+     * @param entry The entry to index.
+     */
+    void
+    addToIndex(Entry *entry)
+    {
+        allocSeq[entry - entries.data()] = nextAllocSeq++;
+        const size_t mask = index.size() - 1;
+        size_t slot = indexSlot(entry->blkAddr);
+        while (index[slot])
+            slot = (slot + 1) & mask;
+        index[slot] = entry;
+    }
+
+    /**
+     * Remove an entry from the address index, shifting the rest of
+     * its cluster back so that no probe sequence is broken.
+     *
+     * @param entry The entry to remove.
+     */
+    void
+    removeFromIndex(Entry *entry)
+    {
+        const size_t mask = index.size() - 1;
+        size_t hole = indexSlot(entry->blkAddr);
+        while (index[hole] != entry) {
+            assert(index[hole]);
+            hole = (hole + 1) & mask;
+        }
+        for (size_t next = (hole + 1) & mask; index[next];
+             next = (next + 1) & mask) {
+            // An entry can fill the hole if the hole lies between its
+            // home slot and its current slot
+            const size_t home = indexSlot(index[next]->blkAddr);
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                index[hole] = index[next];
+                hole = next;
+            }
+        }
+        index[hole] = nullptr;
+    }
+
   public:
 
     /**
@@ -135,7 +240,10 @@ class Queue : public Drainable, public Named
         Named(name),
         label(_label), numEntries(num_entries + reserve),
         numReserve(reserve), entries(numEntries, name + ".entry"),
-        _numInService(0), allocated(0)
+        _numInService(0), allocated(0),
+        index(size_t(1) << std::max(1, ceilLog2(2 * numEntries)), nullptr),
+        indexShift(64 - std::max(1, ceilLog2(2 * numEntries))),
+        allocSeq(numEntries, 0), nextAllocSeq(0), chainLengths(nullptr)
     {
         for (int i = 0; i < numEntries; ++i) {
             freeList.push_back(&entries[i]);
@@ -157,6 +265,17 @@ class Queue : public Drainable, public Named
         return _numInService;
     }
 
+    /**
+     * Sample the number of index slots probed by every lookup into the
+     * given distribution.
+     *
+     * @param dist The distribution to sample into, or nullptr.
+     */
+    void setChainLengthStat(statistics::Distribution *dist)
+    {
+        chainLengths = dist;
+    }
+
     /**
      * Find the first entry that matches the provided address.
      *
@@ -168,19 +287,22 @@ class Queue : public Drainable, public Named
     Entry* findMatch(Addr blk_addr, bool is_secure,
                      bool ignore_uncacheable = true) const
     {
-        for (const auto& entry : allocatedList) {
-            // we ignore any entries allocated for uncacheable
-            // accesses and simply ignore them when matching, in the
-            // cache we never check for matches when adding new
-            // uncacheable entries, and we do not want normal
-            // cacheable accesses being added to an WriteQueueEntry
-            // serving an uncacheable access
+        // we ignore any entries allocated for uncacheable accesses and
+        // simply ignore them when matching, in the cache we never
+        // check for matches when adding new uncacheable entries, and
+        // we do not want normal cacheable accesses being added to an
+        // WriteQueueEntry serving an uncacheable access. Of several
+        // matches, the oldest allocation wins, like a walk of the
+        // allocated list would find.
+        Entry *match = nullptr;
+        probeIndex(blk_addr, [&](Entry *entry) {
             if (!(ignore_uncacheable && entry->isUncacheable()) &&
-                entry->matchBlockAddr(blk_addr, is_secure)) {
-                return entry;
+                entry->matchBlockAddr(blk_addr, is_secure) &&
+                (!match || seqOf(entry) < seqOf(match))) {
+                match = entry;
             }
-        }
-        return nullptr;
+        });
+        return match;
     }
 
     bool trySatisfyFunctional(PacketPtr pkt)
@@ -206,6 +328,20 @@ class Queue : public Drainable, public Named
      */
     Entry* findPending(const QueueEntry* entry) const
     {
+        // The ready list holds exactly the entries not in service
+        Entry *pending = nullptr;
+        unsigned num_pending = 0;
+        probeIndex(entry->blkAddr, [&](Entry *candidate) {
+            if (!candidate->inService && candidate->conflictAddr(entry)) {
+                pending = candidate;
+                ++num_pending;
+            }
+        });
+        if (num_pending <= 1)
+            return pending;
+
+        // Several ready entries for the same block, the order of the
+        // ready list decides which one is the earliest
         for (const auto& ready_entry : readyList) {
             if (ready_entry->conflictAddr(entry)) {
                 return ready_entry;
@@ -241,6 +377,7 @@ class Queue : public Drainable, public Named
     deallocate(Entry *entry)
     {
         allocatedList.erase(entry->allocIter);
+        removeFromIndex(entry);
         freeList.push_front(entry);
         allocated--;
         if (entry->inService) {
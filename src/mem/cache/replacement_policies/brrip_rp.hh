@@ -54,6 +54,7 @@
 
 #include "base/sat_counter.hh"
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_pool.hh"
 
 namespace gem5
 {
@@ -111,6 +112,9 @@ class BRRIP : public Base
      */
     const unsigned btp;
 
+    /** Storage of the replacement data of all entries. */
+    ReplacementDataPool<BRRIPReplData> replDataPool;
+
   public:
     typedef BRRIPRPParams Params;
     BRRIP(const Params &p);
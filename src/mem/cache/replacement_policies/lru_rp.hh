@@ -36,6 +36,7 @@
 #define __MEM_CACHE_REPLACEMENT_POLICIES_LRU_RP_HH__
 
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_pool.hh"
 
 namespace gem5
 {
@@ -60,6 +61,9 @@ class LRU : public Base
         LRUReplData() : lastTouchTick(0) {}
     };
 
+    /** Storage of the replacement data of all entries. */
+    ReplacementDataPool<LRUReplData> replDataPool;
+
   public:
     typedef LRURPParams Params;
     LRU(const Params &p);
@@ -109,6 +109,14 @@ class ReplaceableEntry
      */
     uint32_t getWay() const { return _way; }
 
+    /**
+     * Get the partition that allocated this entry, as used by the cache
+     * partitioning policies.
+     *
+     * @return The PartitionID of the entry.
+     */
+    virtual uint64_t getPartitionId() const { return 0; }
+
     /**
      * Prints relevant information about this entry.
      *
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Instantiating and touching the replacement data of a 16 MiB cache with
+ * 64 B blocks, with every entry allocated on its own and with entries
+ * coming from a ReplacementDataPool.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/cache/replacement_policies/replacement_data_pool.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+const int numBlocks = 1 << 18;
+
+struct BenchReplData : ReplacementData
+{
+    uint64_t lastTouch = 0;
+};
+
+std::shared_ptr<ReplacementData>
+instantiateIndividual(ReplacementDataPool<BenchReplData> &)
+{
+    return std::shared_ptr<ReplacementData>(new BenchReplData());
+}
+
+std::shared_ptr<ReplacementData>
+instantiatePooled(ReplacementDataPool<BenchReplData> &pool)
+{
+    return pool.instantiate();
+}
+
+template <auto Instantiate>
+std::vector<std::shared_ptr<ReplacementData>>
+instantiateAll(ReplacementDataPool<BenchReplData> &pool)
+{
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    entries.reserve(numBlocks);
+    for (int i = 0; i < numBlocks; ++i)
+        entries.push_back(Instantiate(pool));
+    return entries;
+}
+
+/** Instantiate the replacement data of every block of the cache */
+template <auto Instantiate>
+void
+BM_Instantiate(benchmark::State &state)
+{
+    for (auto _ : state) {
+        ReplacementDataPool<BenchReplData> pool;
+        auto entries = instantiateAll<Instantiate>(pool);
+        benchmark::DoNotOptimize(entries.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numBlocks);
+}
+BENCHMARK_TEMPLATE(BM_Instantiate, instantiateIndividual);
+BENCHMARK_TEMPLATE(BM_Instantiate, instantiatePooled);
+
+/** Touch the replacement data of a random block per iteration */
+template <auto Instantiate>
+void
+BM_Touch(benchmark::State &state)
+{
+    ReplacementDataPool<BenchReplData> pool;
+    auto entries = instantiateAll<Instantiate>(pool);
+
+    std::mt19937 rng(0);
+    uint64_t tick = 0;
+    for (auto _ : state) {
+        static_cast<BenchReplData *>(
+            entries[rng() % numBlocks].get())->lastTouch = ++tick;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Touch, instantiateIndividual);
+BENCHMARK_TEMPLATE(BM_Touch, instantiatePooled);
+
+} // anonymous namespace
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_POOL_HH__
+#define __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_POOL_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+namespace gem5
+{
+
+namespace replacement_policy
+{
+
+/**
+ * Contiguous storage for the replacement data of a policy.
+ *
+ * Replacement data entries are instantiated once per block when a cache
+ * is built, so allocating each one individually costs a heap allocation
+ * and a shared_ptr control block per block, and scatters the entries of
+ * a set all over the host memory. This pool instead constructs entries
+ * into large chunks, in instantiation (i.e., block index) order, and
+ * hands out aliasing shared pointers that share the reference count of
+ * their chunk. A chunk is freed once none of its entries is referenced
+ * anymore.
+ *
+ * Policies that extend another one may construct their own replacement
+ * data, derived from the base policy's, in the base policy's pool. All
+ * the entries of a pool must have the same type, though.
+ *
+ * @tparam T The replacement data type of the policy.
+ */
+template <typename T>
+class ReplacementDataPool
+{
+  private:
+    /** Number of entries per chunk. */
+    const std::size_t chunkSize;
+
+    /**
+     * Chunk entries are currently allocated from. This is a vector of
+     * the type the entries are constructed as.
+     */
+    std::shared_ptr<void> chunk;
+
+    /** Type of the entries, to check they are all constructed alike. */
+    const std::type_info *entryType = nullptr;
+
+  public:
+    ReplacementDataPool(std::size_t chunk_size=4096)
+      : chunkSize(chunk_size)
+    {}
+
+    /**
+     * Construct a new entry.
+     *
+     * @tparam U The type of the entry, T or a type derived from it.
+     * @param args Arguments forwarded to the entry's constructor.
+     * @return A shared pointer to the new entry.
+     */
+    template <typename U=T, typename... Args>
+    std::shared_ptr<ReplacementData>
+    instantiate(Args&&... args)
+    {
+        static_assert(std::is_base_of_v<T, U>);
+        assert(!entryType || *entryType == typeid(U));
+        entryType = &typeid(U);
+
+        // The chunk is never reallocated, as that would invalidate the
+        // pointers to its entries
+        auto entries = std::static_pointer_cast<std::vector<U>>(chunk);
+        if (!entries || entries->size() == entries->capacity()) {
+            entries = std::make_shared<std::vector<U>>();
+            entries->reserve(chunkSize);
+            chunk = entries;
+        }
+        entries->emplace_back(std::forward<Args>(args)...);
+        return std::shared_ptr<ReplacementData>(entries, &entries->back());
+    }
+};
+
+} // namespace replacement_policy
+} // namespace gem5
+
+#endif // __MEM_CACHE_REPLACEMENT_POLICIES_REPLACEMENT_DATA_POOL_HH__
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "mem/cache/replacement_policies/replacement_data_pool.hh"
+
+using namespace gem5;
+using namespace gem5::replacement_policy;
+
+namespace
+{
+
+struct TestReplData : ReplacementData
+{
+    uint64_t lastTouch;
+    const int id;
+
+    TestReplData(int _id) : lastTouch(0), id(_id) {}
+};
+
+struct DerivedReplData : TestReplData
+{
+    const int extra;
+
+    DerivedReplData(int _id) : TestReplData(_id), extra(-_id) {}
+};
+
+TestReplData *
+cast(const std::shared_ptr<ReplacementData> &data)
+{
+    return static_cast<TestReplData *>(data.get());
+}
+
+} // anonymous namespace
+
+/** Entries are laid out contiguously in instantiation order */
+TEST(ReplacementDataPoolTest, Contiguous)
+{
+    ReplacementDataPool<TestReplData> pool(8);
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    for (int i = 0; i < 20; ++i)
+        entries.push_back(pool.instantiate(i));
+
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(cast(entries[i])->id, i);
+        EXPECT_EQ(cast(entries[i])->lastTouch, 0);
+        if (i % 8) {
+            EXPECT_EQ(cast(entries[i]), cast(entries[i - 1]) + 1);
+        }
+    }
+}
+
+/** Entries outlive the pool, and chunks are freed with their entries */
+TEST(ReplacementDataPoolTest, Lifetime)
+{
+    std::weak_ptr<ReplacementData> weak;
+    std::shared_ptr<ReplacementData> entry;
+    {
+        ReplacementDataPool<TestReplData> pool(4);
+        entry = pool.instantiate(1);
+        weak = pool.instantiate(2);
+    }
+    // The second entry is kept alive by the first one's chunk
+    EXPECT_FALSE(weak.expired());
+    EXPECT_EQ(cast(entry)->id, 1);
+
+    entry.reset();
+    EXPECT_TRUE(weak.expired());
+}
+
+
+/** Entries of a derived type are laid out as the derived type */
+TEST(ReplacementDataPoolTest, Derived)
+{
+    ReplacementDataPool<TestReplData> pool(8);
+    std::vector<std::shared_ptr<ReplacementData>> entries;
+    for (int i = 0; i < 20; ++i)
+        entries.push_back(pool.instantiate<DerivedReplData>(i));
+
+    for (int i = 0; i < 20; ++i) {
+        auto *entry = static_cast<DerivedReplData *>(entries[i].get());
+        EXPECT_EQ(entry->id, i);
+        EXPECT_EQ(entry->extra, -i);
+        if (i % 8) {
+            EXPECT_EQ(entry, static_cast<DerivedReplData *>(
+                entries[i - 1].get()) + 1);
+        }
+    }
+}
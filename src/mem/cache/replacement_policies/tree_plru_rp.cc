@@ -112,8 +112,8 @@ void
 TreePLRU::invalidate(const std::shared_ptr<ReplacementData>& replacement_data)
 {
     // Cast replacement data
-    std::shared_ptr<TreePLRUReplData> treePLRU_replacement_data =
-        std::static_pointer_cast<TreePLRUReplData>(replacement_data);
+    TreePLRUReplData* treePLRU_replacement_data =
+        static_cast<TreePLRUReplData*>(replacement_data.get());
     PLRUTree* tree = treePLRU_replacement_data->tree.get();
 
     // Index of the tree entry we are currently checking
@@ -138,8 +138,8 @@ TreePLRU::touch(const std::shared_ptr<ReplacementData>& replacement_data)
 const
 {
     // Cast replacement data
-    std::shared_ptr<TreePLRUReplData> treePLRU_replacement_data =
-        std::static_pointer_cast<TreePLRUReplData>(replacement_data);
+    TreePLRUReplData* treePLRU_replacement_data =
+        static_cast<TreePLRUReplData*>(replacement_data.get());
     PLRUTree* tree = treePLRU_replacement_data->tree.get();
 
     // Index of the tree entry we are currently checking
@@ -174,8 +174,8 @@ TreePLRU::getVictim(const ReplacementCandidates& candidates) const
     assert(candidates.size() > 0);
 
     // Get tree
-    const PLRUTree* tree = std::static_pointer_cast<TreePLRUReplData>(
-            candidates[0]->replacementData)->tree.get();
+    const PLRUTree* tree = static_cast<TreePLRUReplData*>(
+            candidates[0]->replacementData.get())->tree.get();
 
     // Index of the tree entry we are currently checking. Start with root.
     uint64_t tree_index = 0;
@@ -200,18 +200,16 @@ TreePLRU::instantiateEntry()
 {
     // Generate a tree instance every numLeaves created
     if (count % numLeaves == 0) {
-        treeInstance = new PLRUTree(numLeaves - 1, false);
+        treeInstance = std::make_shared<PLRUTree>(numLeaves - 1, false);
     }
 
     // Create replacement data using current tree instance
-    TreePLRUReplData* treePLRUReplData = new TreePLRUReplData(
-        (count % numLeaves) + numLeaves - 1,
-        std::shared_ptr<PLRUTree>(treeInstance));
+    const uint64_t index = (count % numLeaves) + numLeaves - 1;
 
     // Update instance counter
     count++;
 
-    return std::shared_ptr<ReplacementData>(treePLRUReplData);
+    return replDataPool.instantiate(index, treeInstance);
 }
 
 } // namespace replacement_policy
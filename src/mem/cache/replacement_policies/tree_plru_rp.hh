@@ -74,6 +74,7 @@
 #include <vector>
 
 #include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replacement_data_pool.hh"
 
 namespace gem5
 {
@@ -122,7 +123,7 @@ class TreePLRU : public Base
     /**
      * Holds the latest temporary tree instance created by instantiateEntry().
      */
-    PLRUTree* treeInstance;
+    std::shared_ptr<PLRUTree> treeInstance;
 
   protected:
     /**
@@ -154,6 +155,9 @@ class TreePLRU : public Base
         TreePLRUReplData(const uint64_t index, std::shared_ptr<PLRUTree> tree);
     };
 
+    /** Storage of the replacement data of all entries. */
+    ReplacementDataPool<TreePLRUReplData> replDataPool;
+
   public:
     typedef TreePLRURPParams Params;
     TreePLRU(const Params &p);
@@ -65,6 +65,11 @@ class BaseTags(ClockedObject):
         "Percentage of tags to be touched to warm up the cache",
     )
 
+    # Get the data-less mode from the parent (cache)
+    tags_only = Param.Bool(
+        Parent.tags_only, "Do not allocate data storage for the blocks"
+    )
+
     sequential_access = Param.Bool(
         Parent.sequential_access,
         "Whether to access tags and data sequentially",
@@ -98,6 +103,12 @@ class BaseSetAssoc(BaseTags):
         Parent.replacement_policy, "Replacement policy"
     )
 
+    packed_tags = Param.Bool(
+        False,
+        "Keep a packed copy of the tags to look up a whole set at once. "
+        "Requires a SetAssociative indexing policy",
+    )
+
 
 class SectorTags(BaseTags):
     type = "SectorTags"
@@ -145,6 +156,12 @@ class FALRU(BaseTags):
     min_tracked_cache_size = Param.MemorySize(
         "128KiB", "Minimum cache size for which we track statistics"
     )
+    tracked_cache_sample_interval = Param.Unsigned(
+        1,
+        "Only record the statistics of the tracked cache sizes for one "
+        "access out of this many. Zero disables the tracking of the "
+        "smaller cache sizes, which speeds up large caches.",
+    )
 
     # This tag uses its own embedded indexing
     indexing_policy = NULL
@@ -66,7 +66,9 @@ BaseTags::BaseTags(const Params &p)
       partitionManager(p.partitioning_manager),
       warmupBound((p.warmup_percentage/100.0) * (p.size / p.block_size)),
       warmedUp(false), numBlocks(p.size / p.block_size),
-      dataBlks(new uint8_t[p.size]), // Allocate data storage in one big chunk
+      tagsOnly(p.tags_only),
+      // Allocate data storage in one big chunk
+      dataBlks(new uint8_t[p.tags_only ? p.block_size : p.size]),
       stats(*this)
 {
     registerExitCallback([this]() { cleanupRefs(); });
@@ -84,20 +86,12 @@ BaseTags::findBlock(Addr addr, bool is_secure) const
     // Extract block tag
     Addr tag = extractTag(addr);
 
-    // Find possible entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(addr);
-
-    // Search for block
-    for (const auto& location : entries) {
-        CacheBlk* blk = static_cast<CacheBlk*>(location);
-        if (blk->matchTag(tag, is_secure)) {
-            return blk;
-        }
-    }
-
-    // Did not find block
-    return nullptr;
+    // Search for block among the possible entries of the address
+    return static_cast<CacheBlk*>(indexingPolicy->findPossibleEntry(addr,
+        [tag, is_secure](ReplaceableEntry *location)
+        {
+            return static_cast<CacheBlk*>(location)->matchTag(tag, is_secure);
+        }));
 }
 
 void
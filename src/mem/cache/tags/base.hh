@@ -102,9 +102,28 @@ class BaseTags : public ClockedObject
     /** the number of blocks in the cache */
     const unsigned numBlocks;
 
+    /**
+     * Whether the blocks hold no data of their own. If set, all blocks
+     * share a single scratch chunk which the cache fills from the
+     * backing store before it is used.
+     */
+    const bool tagsOnly;
+
     /** The data blocks, 1 per cache block. */
     std::unique_ptr<uint8_t[]> dataBlks;
 
+    /**
+     * Get the data chunk to be associated to a block.
+     *
+     * @param blk_index Index of the block in the tag store.
+     * @return Pointer to the block's data chunk.
+     */
+    uint8_t *
+    blkData(unsigned blk_index) const
+    {
+        return &dataBlks[tagsOnly ? 0 : blkSize * blk_index];
+    }
+
     /**
      * TODO: It would be good if these stats were acquired after warmup.
      */
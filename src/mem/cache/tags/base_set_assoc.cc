@@ -55,10 +55,17 @@ namespace gem5
 BaseSetAssoc::BaseSetAssoc(const Params &p)
     :BaseTags(p), allocAssoc(p.assoc), blks(p.size / p.block_size),
      sequentialAccess(p.sequential_access),
-     replacementPolicy(p.replacement_policy)
+     replacementPolicy(p.replacement_policy),
+     packedIndexing(p.packed_tags ?
+        dynamic_cast<const SetAssociative*>(p.indexing_policy) : nullptr)
 {
     // There must be a indexing policy
     fatal_if(!p.indexing_policy, "An indexing policy is required");
+    fatal_if(p.packed_tags && !packedIndexing,
+             "Packed tags require a SetAssociative indexing policy");
+    if (packedIndexing) {
+        packedTags.init(blks.size() / p.assoc, p.assoc);
+    }
 
     // Check parameters
     if (blkSize < 4 || !isPowerOf2(blkSize)) {
@@ -78,7 +85,7 @@ BaseSetAssoc::tagsInit()
         indexingPolicy->setEntry(blk, blk_index);
 
         // Associate a data chunk to the block
-        blk->data = &dataBlks[blkSize*blk_index];
+        blk->data = blkData(blk_index);
 
         // Associate a replacement data entry to the block
         blk->replacementData = replacementPolicy->instantiateEntry();
@@ -94,6 +101,7 @@ BaseSetAssoc::invalidate(CacheBlk *blk)
     }
 
     BaseTags::invalidate(blk);
+    updatePackedTag(blk);
 
     // Decrease the number of tags in use
     stats.tagsInUse--;
@@ -106,6 +114,8 @@ void
 BaseSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
 {
     BaseTags::moveBlock(src_blk, dest_blk);
+    updatePackedTag(src_blk);
+    updatePackedTag(dest_blk);
 
     // Since the blocks were using different replacement data pointers,
     // we must touch the replacement data of the new entry, and invalidate
@@ -114,4 +124,24 @@ BaseSetAssoc::moveBlock(CacheBlk *src_blk, CacheBlk *dest_blk)
     replacementPolicy->reset(dest_blk->replacementData);
 }
 
+CacheBlk*
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    if (!packedIndexing) {
+        return BaseTags::findBlock(addr, is_secure);
+    }
+
+    const Addr tag = extractTag(addr);
+    const uint32_t set = packedIndexing->extractSet(addr);
+    const int way = packedTags.find(set, PackedTagArray::key(tag, is_secure));
+    if (way < 0) {
+        return nullptr;
+    }
+
+    CacheBlk *blk = static_cast<CacheBlk*>(
+        indexingPolicy->getEntry(set, way));
+    assert(blk->matchTag(tag, is_secure));
+    return blk;
+}
+
 } // namespace gem5
@@ -59,6 +59,8 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/cache/tags/packed_tag_array.hh"
 #include "mem/cache/tags/partitioning_policies/partition_manager.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
@@ -88,6 +90,23 @@ class BaseSetAssoc : public BaseTags
     /** Replacement policy */
     replacement_policy::Base *replacementPolicy;
 
+    /** Indexing policy used for packed lookups, null if disabled. */
+    const SetAssociative *packedIndexing;
+
+    /** Packed copy of the tags of all blocks. */
+    PackedTagArray packedTags;
+
+    /** Update the packed copy of a block's tag after it has changed. */
+    void
+    updatePackedTag(const CacheBlk *blk)
+    {
+        if (packedIndexing) {
+            packedTags.set(blk->getSet(), blk->getWay(), blk->isValid() ?
+                PackedTagArray::key(blk->getTag(), blk->isSecure()) :
+                PackedTagArray::Invalid);
+        }
+    }
+
   public:
     /** Convenience typedef. */
      typedef BaseSetAssocParams Params;
@@ -115,6 +134,15 @@ class BaseSetAssoc : public BaseTags
      */
     void invalidate(CacheBlk *blk) override;
 
+    /**
+     * Find a block, using the packed tags if enabled.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -201,6 +229,7 @@ class BaseSetAssoc : public BaseTags
     {
         // Insert block
         BaseTags::insertBlock(pkt, blk);
+        updatePackedTag(blk);
 
         // Increment tag counter
         stats.tagsInUse++;
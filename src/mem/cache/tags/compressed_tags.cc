@@ -94,7 +94,7 @@ CompressedTags::tagsInit()
             blk = &blks[blk_index];
 
             // Associate a data chunk to the block
-            blk->data = &dataBlks[blkSize*blk_index];
+            blk->data = blkData(blk_index);
 
             // Associate superblock to this block
             blk->setSectorBlock(superblock);
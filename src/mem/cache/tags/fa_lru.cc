@@ -68,17 +68,26 @@ FALRUBlk::print() const
 FALRU::FALRU(const Params &p)
     : BaseTags(p),
 
-      cacheTracking(p.min_tracked_cache_size, size, blkSize, this)
+      cacheTracking(p.min_tracked_cache_size, size, blkSize,
+                    p.tracked_cache_sample_interval, this)
 {
     if (!isPowerOf2(blkSize))
         fatal("cache block size (in bytes) `%d' must be a power of two",
               blkSize);
+    // The lowest bit of the block addresses holds the secure flag in the
+    // hash table
+    if (blkSize < 2)
+        fatal("cache block size (in bytes) `%d' must be at least 2",
+              blkSize);
     if (!isPowerOf2(size))
         fatal("Cache Size must be power of 2 for now");
     if (partitionManager)
         fatal("Cannot use Cache Partitioning Policies with FALRU");
 
     blks = new FALRUBlk[numBlocks];
+
+    tagHashBits = ceilLog2(numBlocks) + 1;
+    tagHash.resize(1ULL << tagHashBits);
 }
 
 FALRU::~FALRU()
@@ -93,7 +102,7 @@ FALRU::tagsInit()
     head->prev = nullptr;
     head->next = &(blks[1]);
     head->setPosition(0, 0);
-    head->data = &dataBlks[0];
+    head->data = blkData(0);
 
     for (unsigned i = 1; i < numBlocks - 1; i++) {
         blks[i].prev = &(blks[i-1]);
@@ -101,14 +110,14 @@ FALRU::tagsInit()
         blks[i].setPosition(0, i);
 
         // Associate a data chunk to the block
-        blks[i].data = &dataBlks[blkSize*i];
+        blks[i].data = blkData(i);
     }
 
     tail = &(blks[numBlocks - 1]);
     tail->prev = &(blks[numBlocks - 2]);
     tail->next = nullptr;
     tail->setPosition(0, numBlocks - 1);
-    tail->data = &dataBlks[(numBlocks - 1) * blkSize];
+    tail->data = blkData(numBlocks - 1);
 
     cacheTracking.init(head, tail);
 }
@@ -117,11 +126,7 @@ void
 FALRU::invalidate(CacheBlk *blk)
 {
     // Erase block entry reference in the hash table
-    [[maybe_unused]] auto num_erased =
-        tagHash.erase(std::make_pair(blk->getTag(), blk->isSecure()));
-
-    // Sanity check; only one block reference should be erased
-    assert(num_erased == 1);
+    tagHashErase(blk);
 
     // Invalidate block entry. Must be done after the hash is erased
     BaseTags::invalidate(blk);
@@ -172,10 +177,7 @@ FALRU::findBlock(Addr addr, bool is_secure) const
     FALRUBlk* blk = nullptr;
 
     Addr tag = extractTag(addr);
-    auto iter = tagHash.find(std::make_pair(tag, is_secure));
-    if (iter != tagHash.end()) {
-        blk = (*iter).second;
-    }
+    blk = tagHash[tagHashFind(tagHashKey(tag, is_secure))].blk;
 
     if (blk && blk->isValid()) {
         assert(blk->getTag() == tag);
@@ -224,7 +226,57 @@ FALRU::insertBlock(const PacketPtr pkt, CacheBlk *blk)
     moveToHead(falruBlk);
 
     // Insert new block in the hash table
-    tagHash[std::make_pair(blk->getTag(), blk->isSecure())] = falruBlk;
+    tagHashInsert(falruBlk);
+}
+
+std::size_t
+FALRU::tagHashFind(Addr key) const
+{
+    const std::size_t mask = tagHash.size() - 1;
+    std::size_t idx = tagHashIndex(key);
+    // The table is never more than half full, so there always is an empty
+    // entry to stop the probing
+    while (tagHash[idx].blk && tagHash[idx].key != key)
+        idx = (idx + 1) & mask;
+    return idx;
+}
+
+void
+FALRU::tagHashInsert(FALRUBlk *blk)
+{
+    const Addr key = tagHashKey(blk->getTag(), blk->isSecure());
+    TagHashEntry &entry = tagHash[tagHashFind(key)];
+    assert(!entry.blk);
+    entry.key = key;
+    entry.blk = blk;
+}
+
+void
+FALRU::tagHashErase(const CacheBlk *blk)
+{
+    const std::size_t mask = tagHash.size() - 1;
+    std::size_t hole =
+        tagHashFind(tagHashKey(blk->getTag(), blk->isSecure()));
+
+    // Sanity check; the block must be referenced by the hash table
+    assert(tagHash[hole].blk == blk);
+
+    // Shift back the entries that follow in the probe sequence, so that
+    // no tombstones are needed
+    std::size_t idx = hole;
+    while (true) {
+        idx = (idx + 1) & mask;
+        if (!tagHash[idx].blk)
+            break;
+        // An entry can fill the hole only if its home slot isn't within
+        // the (cyclic) range (hole, idx]
+        const std::size_t home = tagHashIndex(tagHash[idx].key);
+        if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+            tagHash[hole] = tagHash[idx];
+            hole = idx;
+        }
+    }
+    tagHash[hole] = TagHashEntry();
 }
 
 void
@@ -300,14 +352,17 @@ printSize(std::ostream &stream, size_t size)
 }
 
 FALRU::CacheTracking::CacheTracking(unsigned min_size, unsigned max_size,
-    unsigned block_size, statistics::Group *parent)
+    unsigned block_size, unsigned sample_interval,
+    statistics::Group *parent)
     : statistics::Group(parent),
       blkSize(block_size),
-      minTrackedSize(min_size),
-      numTrackedCaches(max_size > min_size ?
-                       floorLog2(max_size) - floorLog2(min_size) : 0),
+      minTrackedSize(sample_interval ? min_size : max_size),
+      numTrackedCaches(max_size > minTrackedSize ?
+                       floorLog2(max_size) - floorLog2(minTrackedSize) : 0),
       inAllCachesMask(mask(numTrackedCaches)),
       boundaries(numTrackedCaches),
+      sampleInterval(sample_interval ? sample_interval : 1),
+      sampleCountdown(1),
       ADD_STAT(hits, statistics::units::Count::get(),
                "The number of hits in each cache size."),
       ADD_STAT(misses, statistics::units::Count::get(),
@@ -444,6 +499,10 @@ FALRU::CacheTracking::moveBlockToTail(FALRUBlk *blk)
 void
 FALRU::CacheTracking::recordAccess(FALRUBlk *blk)
 {
+    if (--sampleCountdown)
+        return;
+    sampleCountdown = sampleInterval;
+
     for (int i = 0; i < numTrackedCaches; i++) {
         if (blk && ((1U << i) & blk->inCachesMask)) {
             hits[i]++;
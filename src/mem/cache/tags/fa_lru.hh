@@ -50,7 +50,6 @@
 #include <cstdint>
 #include <functional>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/bitfield.hh"
@@ -123,20 +122,51 @@ class FALRU : public BaseTags
     /** The LRU block. */
     FALRUBlk *tail;
 
-    /** Hash table type mapping addresses to cache block pointers. */
-    struct PairHash
+    /**
+     * An entry of the address hash table. The key is the block address,
+     * with the lowest bit set for secure blocks, so that looking up a
+     * block doesn't need to touch the block itself.
+     */
+    struct TagHashEntry
     {
-        template <class T1, class T2>
-        std::size_t operator()(const std::pair<T1, T2> &p) const
-        {
-            return std::hash<T1>()(p.first) ^ std::hash<T2>()(p.second);
-        }
+        Addr key = 0;
+        FALRUBlk *blk = nullptr;
     };
-    typedef std::pair<Addr, bool> TagHashKey;
-    typedef std::unordered_map<TagHashKey, FALRUBlk *, PairHash> TagHash;
 
-    /** The address hash table. */
-    TagHash tagHash;
+    /**
+     * The address hash table. It is an open addressing table with linear
+     * probing, sized to at least twice the number of blocks so that it
+     * never needs to grow.
+     */
+    std::vector<TagHashEntry> tagHash;
+    /** Number of bits of the hash table index. */
+    unsigned tagHashBits;
+
+    /** Build the hash table key of a block address. */
+    static Addr
+    tagHashKey(Addr tag, bool is_secure)
+    {
+        return tag | (is_secure ? 1 : 0);
+    }
+
+    /** Home slot of a key in the hash table (Fibonacci hashing). */
+    std::size_t
+    tagHashIndex(Addr key) const
+    {
+        return (key * 0x9e3779b97f4a7c15ULL) >> (64 - tagHashBits);
+    }
+
+    /**
+     * Position of a key in the hash table: either the entry holding it or
+     * the empty entry that terminates its probe sequence.
+     */
+    std::size_t tagHashFind(Addr key) const;
+
+    /** Add a block to the hash table. */
+    void tagHashInsert(FALRUBlk *blk);
+
+    /** Remove a block from the hash table. */
+    void tagHashErase(const CacheBlk *blk);
 
     /**
      * Move a cache block to the MRU position.
@@ -276,8 +306,14 @@ class FALRU : public BaseTags
     class CacheTracking : public statistics::Group
     {
       public:
+        /**
+         * @param sample_interval The statistics only record one access
+         * out of this many. When zero, the additional cache sizes are not
+         * tracked at all.
+         */
         CacheTracking(unsigned min_size, unsigned max_size,
-                      unsigned block_size, statistics::Group *parent);
+                      unsigned block_size, unsigned sample_interval,
+                      statistics::Group *parent);
 
         /**
          * Initialiaze cache blocks and the tracking mechanism
@@ -346,6 +382,10 @@ class FALRU : public BaseTags
         const CachesMask inAllCachesMask;
         /** Array of pointers to blocks at the cache boundaries. */
         std::vector<FALRUBlk*> boundaries;
+        /** Record the statistics of one access out of this many. */
+        const unsigned sampleInterval;
+        /** Accesses left until the next recorded one. */
+        unsigned sampleCountdown;
 
       protected:
         /**
@@ -51,6 +51,23 @@ class SetAssociative(BaseIndexingPolicy):
     cxx_header = "mem/cache/tags/indexing_policies/set_associative.hh"
 
 
+class XorSetAssociative(SetAssociative):
+    type = "XorSetAssociative"
+    cxx_class = "gem5::XorSetAssociative"
+    cxx_header = "mem/cache/tags/indexing_policies/xor_set_associative.hh"
+
+    # Each set index bit i is the conventional index bit XORed with the
+    # parity of the tag bits selected by set_masks[i], as in the hashed
+    # slice and set selection of commercial last level caches
+    set_masks = VectorParam.UInt64(
+        [],
+        "For every set index bit, starting from the LSB, the mask of the "
+        "address bits XORed to produce it. Besides the index bit itself, "
+        "a mask may only select tag bits. Bits without a mask are not "
+        "hashed.",
+    )
+
+
 class SkewedAssociative(BaseIndexingPolicy):
     type = "SkewedAssociative"
     cxx_class = "gem5::SkewedAssociative"
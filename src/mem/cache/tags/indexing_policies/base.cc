@@ -56,10 +56,15 @@ namespace gem5
 {
 
 BaseIndexingPolicy::BaseIndexingPolicy(const Params &p)
+    : BaseIndexingPolicy(p, false)
+{
+}
+
+BaseIndexingPolicy::BaseIndexingPolicy(const Params &p, bool way_skewed)
     : SimObject(p), assoc(p.assoc),
       numSets(p.size / (p.entry_size * assoc)),
       setShift(floorLog2(p.entry_size)), setMask(numSets - 1), sets(numSets),
-      tagShift(setShift + floorLog2(numSets))
+      tagShift(setShift + floorLog2(numSets)), waySkewed(way_skewed)
 {
     fatal_if(!isPowerOf2(numSets), "# of sets must be non-zero and a power " \
              "of 2");
@@ -101,4 +106,19 @@ BaseIndexingPolicy::extractTag(const Addr addr) const
     return (addr >> tagShift);
 }
 
+void
+BaseIndexingPolicy::getPossibleEntries(const Addr addr,
+    std::vector<ReplaceableEntry*> &entries) const
+{
+    if (!waySkewed) {
+        const auto &set = sets[extractWaySet(addr, 0)];
+        entries.assign(set.begin(), set.end());
+    } else {
+        entries.resize(assoc);
+        for (uint32_t way = 0; way < assoc; ++way) {
+            entries[way] = sets[extractWaySet(addr, way)][way];
+        }
+    }
+}
+
 } // namespace gem5
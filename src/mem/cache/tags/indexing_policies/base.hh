@@ -96,6 +96,20 @@ class BaseIndexingPolicy : public SimObject
      */
     const int tagShift;
 
+    /**
+     * Whether an address may be mapped to a different set in every way.
+     * When false, the set of an address is the same in all the ways, and
+     * only the set of way 0 is computed.
+     */
+    const bool waySkewed;
+
+    /**
+     * Construct a policy whose sets may differ from way to way.
+     *
+     * @param way_skewed Whether the sets depend on the way.
+     */
+    BaseIndexingPolicy(const BaseIndexingPolicyParams &p, bool way_skewed);
+
   public:
     /**
      * Convenience typedef.
@@ -138,16 +152,71 @@ class BaseIndexingPolicy : public SimObject
      */
     virtual Addr extractTag(const Addr addr) const;
 
+    /**
+     * Get the set an address is mapped to in the given way.
+     *
+     * @param addr The address to calculate the set for.
+     * @param way The way to get the set from.
+     * @return The set index for given combination of address and way.
+     */
+    virtual uint32_t extractWaySet(const Addr addr, const uint32_t way)
+                                                                    const = 0;
+
+    /**
+     * Visit the possible entries of an address, in way order, until the
+     * visitor returns true. Unlike getPossibleEntries(), this doesn't
+     * build a container of the entries, so it is meant for the lookups.
+     *
+     * @param addr The addr to a find possible entries for.
+     * @param visitor Callable taking a ReplaceableEntry pointer and
+     *        returning a bool.
+     * @return The entry the visitor stopped at, or nullptr if none.
+     */
+    template <typename Visitor>
+    ReplaceableEntry*
+    findPossibleEntry(const Addr addr, Visitor &&visitor) const
+    {
+        if (!waySkewed) {
+            for (ReplaceableEntry *entry : sets[extractWaySet(addr, 0)]) {
+                if (visitor(entry))
+                    return entry;
+            }
+        } else {
+            for (uint32_t way = 0; way < assoc; ++way) {
+                ReplaceableEntry *entry = sets[extractWaySet(addr, way)][way];
+                if (visitor(entry))
+                    return entry;
+            }
+        }
+        return nullptr;
+    }
+
     /**
      * Find all possible entries for insertion and replacement of an address.
      * Should be called immediately before ReplacementPolicy's findVictim()
      * not to break cache resizing.
      *
      * @param addr The addr to a find possible entries for.
+     * @param entries Filled with the possible entries. Its previous contents
+     *        are discarded, but its storage is reused.
+     */
+    void getPossibleEntries(const Addr addr,
+                            std::vector<ReplaceableEntry*> &entries) const;
+
+    /**
+     * Find all possible entries for insertion and replacement of an address.
+     * @sa getPossibleEntries(const Addr, std::vector<ReplaceableEntry*>&)
+     *
+     * @param addr The addr to a find possible entries for.
      * @return The possible entries.
      */
-    virtual std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr)
-                                                                    const = 0;
+    std::vector<ReplaceableEntry*>
+    getPossibleEntries(const Addr addr) const
+    {
+        std::vector<ReplaceableEntry*> entries;
+        getPossibleEntries(addr, entries);
+        return entries;
+    }
 
     /**
      * Regenerate an entry's address from its tag and assigned indexing bits.
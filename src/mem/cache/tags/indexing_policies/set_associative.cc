@@ -69,10 +69,4 @@ SetAssociative::regenerateAddr(const Addr tag, const ReplaceableEntry* entry)
     return (tag << tagShift) | (entry->getSet() << setShift);
 }
 
-std::vector<ReplaceableEntry*>
-SetAssociative::getPossibleEntries(const Addr addr) const
-{
-    return sets[extractSet(addr)];
-}
-
 } // namespace gem5
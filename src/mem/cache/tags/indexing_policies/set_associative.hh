@@ -47,8 +47,6 @@
 #ifndef __MEM_CACHE_INDEXING_POLICIES_SET_ASSOCIATIVE_HH__
 #define __MEM_CACHE_INDEXING_POLICIES_SET_ASSOCIATIVE_HH__
 
-#include <vector>
-
 #include "mem/cache/tags/indexing_policies/base.hh"
 #include "params/SetAssociative.hh"
 
@@ -81,7 +79,7 @@ class ReplaceableEntry;
  */
 class SetAssociative : public BaseIndexingPolicy
 {
-  protected:
+  public:
     /**
      * Apply a hash function to calculate address set.
      *
@@ -90,7 +88,6 @@ class SetAssociative : public BaseIndexingPolicy
      */
     virtual uint32_t extractSet(const Addr addr) const;
 
-  public:
     /**
      * Convenience typedef.
      */
@@ -107,16 +104,17 @@ class SetAssociative : public BaseIndexingPolicy
     ~SetAssociative() {};
 
     /**
-     * Find all possible entries for insertion and replacement of an address.
-     * Should be called immediately before ReplacementPolicy's findVictim()
-     * not to break cache resizing.
-     * Returns entries in all ways belonging to the set of the address.
+     * All the ways share the set given by extractSet().
      *
-     * @param addr The addr to a find possible entries for.
-     * @return The possible entries.
+     * @param addr The address to calculate the set for.
+     * @param way Unused.
+     * @return The set index of the address.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
-                                                                     override;
+    uint32_t
+    extractWaySet(const Addr addr, const uint32_t way) const override
+    {
+        return extractSet(addr);
+    }
 
     /**
      * Regenerate an entry's address from its tag and assigned set and way.
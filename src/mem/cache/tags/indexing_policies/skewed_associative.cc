@@ -42,7 +42,7 @@ namespace gem5
 {
 
 SkewedAssociative::SkewedAssociative(const Params &p)
-    : BaseIndexingPolicy(p), msbShift(floorLog2(numSets) - 1)
+    : BaseIndexingPolicy(p, true), msbShift(floorLog2(numSets) - 1)
 {
     if (assoc > NUM_SKEWING_FUNCTIONS) {
         warn_once("Associativity higher than number of skewing functions. " \
@@ -57,6 +57,18 @@ SkewedAssociative::SkewedAssociative(const Params &p)
     // We must have more than two sets, otherwise the MSB and LSB are the same
     // bit, and the xor of them will always be 0
     fatal_if(numSets <= 2, "The number of sets must be greater than 2");
+
+    // Tabulate the skewing functions from their effect on each of the
+    // set and tag bits they use
+    const int num_bits = 2 * (msbShift + 1);
+    skewMatrices.reserve(assoc);
+    for (uint32_t way = 0; way < assoc; ++way) {
+        std::vector<uint64_t> columns(num_bits);
+        for (int bit = 0; bit < num_bits; ++bit) {
+            columns[bit] = skew(1ULL << bit, way) & setMask;
+        }
+        skewMatrices.emplace_back(columns);
+    }
 }
 
 Addr
@@ -192,9 +204,9 @@ SkewedAssociative::deskew(const Addr addr, const uint32_t way) const
 }
 
 uint32_t
-SkewedAssociative::extractSet(const Addr addr, const uint32_t way) const
+SkewedAssociative::extractWaySet(const Addr addr, const uint32_t way) const
 {
-    return skew(addr >> setShift, way) & setMask;
+    return skewMatrices[way].apply(addr >> setShift);
 }
 
 Addr
@@ -206,18 +218,4 @@ SkewedAssociative::regenerateAddr(const Addr tag,
            ((deskew(addr_set, entry->getWay()) & setMask) << setShift);
 }
 
-std::vector<ReplaceableEntry*>
-SkewedAssociative::getPossibleEntries(const Addr addr) const
-{
-    std::vector<ReplaceableEntry*> entries;
-
-    // Parse all ways
-    for (uint32_t way = 0; way < assoc; ++way) {
-        // Apply hash to get set, and get way entry in it
-        entries.push_back(sets[extractSet(addr, way)][way]);
-    }
-
-    return entries;
-}
-
 } // namespace gem5
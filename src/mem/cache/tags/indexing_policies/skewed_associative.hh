@@ -37,6 +37,7 @@
 #include <vector>
 
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/indexing_policies/xor_matrix.hh"
 #include "params/SkewedAssociative.hh"
 
 namespace gem5
@@ -85,6 +86,13 @@ class SkewedAssociative : public BaseIndexingPolicy
      */
     const int msbShift;
 
+    /**
+     * The skewing functions only XOR and permute bits, so they are linear
+     * and can be precomputed. This holds the skewing function of every
+     * way, applied to the set and tag bits they use.
+     */
+    std::vector<XorMatrix> skewMatrices;
+
     /**
      * The hash function itself. Uses the hash function H, as described in
      * "Skewed-Associative Caches", from Seznec et al. (section 3.3): It
@@ -129,15 +137,6 @@ class SkewedAssociative : public BaseIndexingPolicy
      */
     Addr deskew(const Addr addr, const uint32_t way) const;
 
-    /**
-     * Apply a skewing function to calculate address' set given a way.
-     *
-     * @param addr The address to calculate the set for.
-     * @param way The way to get the set from.
-     * @return The set index for given combination of address and way.
-     */
-    uint32_t extractSet(const Addr addr, const uint32_t way) const;
-
   public:
     /** Convenience typedef. */
      typedef SkewedAssociativeParams Params;
@@ -153,14 +152,13 @@ class SkewedAssociative : public BaseIndexingPolicy
     ~SkewedAssociative() {};
 
     /**
-     * Find all possible entries for insertion and replacement of an address.
-     * Should be called immediately before ReplacementPolicy's findVictim()
-     * not to break cache resizing.
+     * Apply the skewing function of a way to calculate the address' set.
      *
-     * @param addr The addr to a find possible entries for.
-     * @return The possible entries.
+     * @param addr The address to calculate the set for.
+     * @param way The way to get the set from.
+     * @return The set index for given combination of address and way.
      */
-    std::vector<ReplaceableEntry*> getPossibleEntries(const Addr addr) const
+    uint32_t extractWaySet(const Addr addr, const uint32_t way) const
                                                                    override;
 
     /**
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * A precomputed linear (XOR) hash function over GF(2).
+ */
+
+#ifndef __MEM_CACHE_INDEXING_POLICIES_XOR_MATRIX_HH__
+#define __MEM_CACHE_INDEXING_POLICIES_XOR_MATRIX_HH__
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+
+namespace gem5
+{
+
+/**
+ * A hash function where every output bit is the XOR of a subset of the
+ * input bits, i.e., the product of the input by a binary matrix. Many
+ * cache index functions are of this kind: the skewing functions of skewed
+ * associative caches, or the slice and set selection functions of
+ * commercial last level caches.
+ *
+ * The matrix is applied one input byte at a time, using a table holding
+ * the XOR of the columns for every value of that byte, so hashing an
+ * N-bit input takes ceil(N / 8) lookups regardless of the function.
+ */
+class XorMatrix
+{
+  private:
+    /** For every input byte, the output of each of its 256 values. */
+    std::vector<std::array<uint64_t, 256>> tables;
+
+  public:
+    XorMatrix() = default;
+
+    /**
+     * @param columns The output of each input bit, i.e., columns[i] is
+     *        the hash of (1 << i). Input bits without a column don't
+     *        contribute to the hash.
+     */
+    explicit XorMatrix(const std::vector<uint64_t> &columns)
+      : tables((columns.size() + 7) / 8)
+    {
+        for (size_t byte = 0; byte < tables.size(); byte++) {
+            auto &table = tables[byte];
+            table[0] = 0;
+            for (unsigned value = 1; value < 256; value++) {
+                // Add the column of the lowest set bit to the hash of the
+                // value without that bit
+                const unsigned bit = findLsbSet(value);
+                const size_t column = byte * 8 + bit;
+                table[value] = table[value & (value - 1)] ^
+                    (column < columns.size() ? columns[column] : 0);
+            }
+        }
+    }
+
+    /** Hash an input. */
+    uint64_t
+    apply(uint64_t input) const
+    {
+        uint64_t hash = 0;
+        for (const auto &table : tables) {
+            hash ^= table[input & 0xff];
+            input >>= 8;
+        }
+        return hash;
+    }
+};
+
+} // namespace gem5
+
+#endif //__MEM_CACHE_INDEXING_POLICIES_XOR_MATRIX_HH__
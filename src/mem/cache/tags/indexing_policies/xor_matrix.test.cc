@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/indexing_policies/xor_matrix.hh"
+
+using namespace gem5;
+
+/** Reference implementation: XOR the columns of the set input bits */
+static uint64_t
+referenceHash(const std::vector<uint64_t> &columns, uint64_t input)
+{
+    uint64_t hash = 0;
+    for (size_t bit = 0; bit < columns.size(); bit++) {
+        if ((input >> bit) & 1)
+            hash ^= columns[bit];
+    }
+    return hash;
+}
+
+/** The hash of a single bit is its column */
+TEST(XorMatrixTest, Columns)
+{
+    const std::vector<uint64_t> columns = { 0x1, 0x3, 0x0, 0x80, 0xf0f0,
+        0x1234, 0x8000000000000000ULL, 0x5, 0x6, 0x7 };
+    const XorMatrix matrix(columns);
+
+    for (size_t bit = 0; bit < columns.size(); bit++)
+        EXPECT_EQ(matrix.apply(1ULL << bit), columns[bit]);
+}
+
+/** Input bits without a column are ignored */
+TEST(XorMatrixTest, ExtraInputBits)
+{
+    const XorMatrix matrix({ 0x1, 0x2, 0x4 });
+
+    EXPECT_EQ(matrix.apply(0), 0ULL);
+    EXPECT_EQ(matrix.apply(0x7), 0x7ULL);
+    EXPECT_EQ(matrix.apply(~0ULL << 3), 0ULL);
+    EXPECT_EQ(matrix.apply(~0ULL), 0x7ULL);
+
+    const XorMatrix empty;
+    EXPECT_EQ(empty.apply(~0ULL), 0ULL);
+}
+
+/** Any input is hashed like the reference, for any number of columns */
+TEST(XorMatrixTest, Random)
+{
+    std::mt19937_64 rng(0x5eed);
+    for (size_t num_columns : { 1, 7, 8, 9, 22, 40, 64 }) {
+        std::vector<uint64_t> columns(num_columns);
+        for (auto &column : columns)
+            column = rng() & 0xfffff;
+        const XorMatrix matrix(columns);
+
+        for (int i = 0; i < 1000; i++) {
+            const uint64_t input = rng();
+            EXPECT_EQ(matrix.apply(input), referenceHash(columns, input));
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Definitions of a set associative indexing policy with XOR hashed sets.
+ */
+
+#include "mem/cache/tags/indexing_policies/xor_set_associative.hh"
+
+#include <vector>
+
+#include "base/logging.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+namespace gem5
+{
+
+XorSetAssociative::XorSetAssociative(const Params &p)
+    : SetAssociative(p)
+{
+    const unsigned num_set_bits = tagShift - setShift;
+    fatal_if(p.set_masks.size() > num_set_bits, "%d set masks were given, "
+             "but there are only %d set index bits", p.set_masks.size(),
+             num_set_bits);
+
+    // Transpose the masks into the columns of the tag hash: the set bits
+    // that each tag bit flips
+    std::vector<uint64_t> columns(64 - tagShift, 0);
+    for (unsigned set_bit = 0; set_bit < p.set_masks.size(); set_bit++) {
+        const uint64_t mask = p.set_masks[set_bit];
+        if (mask == 0)
+            continue;
+
+        // The address can only be regenerated if the other index bits and
+        // the block offset don't take part in the hash
+        fatal_if(mbits(mask, tagShift - 1, 0) !=
+                 (1ULL << (setShift + set_bit)), "The mask %#x of set bit "
+                 "%d must select address bit %d and otherwise only tag "
+                 "bits", mask, set_bit, setShift + set_bit);
+
+        for (unsigned bit = 0; bit < columns.size(); bit++) {
+            if (bits(mask, tagShift + bit))
+                columns[bit] |= 1ULL << set_bit;
+        }
+    }
+    tagHash = XorMatrix(columns);
+}
+
+uint32_t
+XorSetAssociative::extractSet(const Addr addr) const
+{
+    return ((addr >> setShift) ^ tagHash.apply(addr >> tagShift)) & setMask;
+}
+
+Addr
+XorSetAssociative::regenerateAddr(const Addr tag,
+                                  const ReplaceableEntry* entry) const
+{
+    const Addr set = (entry->getSet() ^ tagHash.apply(tag)) & setMask;
+    return (tag << tagShift) | (set << setShift);
+}
+
+} // namespace gem5
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a set associative indexing policy with XOR hashed sets.
+ */
+
+#ifndef __MEM_CACHE_INDEXING_POLICIES_XOR_SET_ASSOCIATIVE_HH__
+#define __MEM_CACHE_INDEXING_POLICIES_XOR_SET_ASSOCIATIVE_HH__
+
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
+#include "mem/cache/tags/indexing_policies/xor_matrix.hh"
+#include "params/XorSetAssociative.hh"
+
+namespace gem5
+{
+
+class ReplaceableEntry;
+
+/**
+ * A set associative indexing policy where every set index bit is XORed
+ * with the parity of a subset of the tag bits. That's the kind of function
+ * used to spread the addresses over the slices and sets of the last level
+ * caches of commercial processors.
+ *
+ * Since the hash only depends on the tag, the original set bits can be
+ * recovered from the tag and the set of the entry.
+ */
+class XorSetAssociative : public SetAssociative
+{
+  private:
+    /** The hash of the tag that is XORed with the set index bits. */
+    XorMatrix tagHash;
+
+  public:
+    /** Convenience typedef. */
+    typedef XorSetAssociativeParams Params;
+
+    /**
+     * Construct and initialize this policy.
+     */
+    XorSetAssociative(const Params &p);
+
+    /**
+     * Destructor.
+     */
+    ~XorSetAssociative() {};
+
+    /**
+     * Apply the hash function to calculate address set.
+     *
+     * @param addr The address to calculate the set for.
+     * @return The set index of the address.
+     */
+    uint32_t extractSet(const Addr addr) const override;
+
+    /**
+     * Regenerate an entry's address from its tag and assigned set.
+     *
+     * @param tag The tag bits.
+     * @param entry The entry.
+     * @return the entry's original address.
+     */
+    Addr regenerateAddr(const Addr tag, const ReplaceableEntry* entry) const
+                                                                   override;
+};
+
+} // namespace gem5
+
+#endif //__MEM_CACHE_INDEXING_POLICIES_XOR_SET_ASSOCIATIVE_HH__
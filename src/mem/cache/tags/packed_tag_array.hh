@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PACKED_TAG_ARRAY_HH__
+#define __MEM_CACHE_TAGS_PACKED_TAG_ARRAY_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+/**
+ * A packed copy of the tag information of a set associative structure.
+ *
+ * Each entry holds a single 64-bit key that combines the tag with the
+ * valid and secure bits of an entry, and the keys of a set are stored
+ * contiguously, so that a lookup compares a whole set with a handful of
+ * vector instructions instead of chasing a pointer per way. An unused
+ * entry holds the key 0, which never matches, so lookups must be done
+ * with non-zero keys.
+ *
+ * Sets are padded to a multiple of the vector width. The comparison uses
+ * AVX2 or NEON when the simulator is built for a host supporting them,
+ * and a plain loop otherwise.
+ *
+ * The array is only a copy of the state of the entries, so the owner is
+ * responsible for updating it whenever the tag, validity or security of
+ * an entry changes.
+ */
+class PackedTagArray
+{
+  public:
+    /** Key of unused entries. */
+    static constexpr uint64_t Invalid = 0;
+
+    /** Number of keys compared by one vector instruction. */
+#if defined(__AVX2__)
+    static constexpr unsigned vectorWidth = 4;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    static constexpr unsigned vectorWidth = 2;
+#else
+    static constexpr unsigned vectorWidth = 1;
+#endif
+
+    /**
+     * Key of a valid entry holding the given tag.
+     *
+     * @param tag The entry's tag, its two most significant bits are lost.
+     * @param is_secure Whether the entry is secure.
+     */
+    static uint64_t
+    key(uint64_t tag, bool is_secure)
+    {
+        return (tag << 2) | (is_secure ? 2 : 0) | 1;
+    }
+
+    PackedTagArray() : assoc(0), stride(0) {}
+
+    /**
+     * Allocate storage for the given geometry and clear all entries.
+     *
+     * @param num_sets Number of sets.
+     * @param _assoc Number of ways per set.
+     */
+    void
+    init(uint32_t num_sets, unsigned _assoc)
+    {
+        assoc = _assoc;
+        stride = roundUp(assoc, vectorWidth);
+        keys.assign((uint64_t)num_sets * stride, Invalid);
+    }
+
+    /** Set the key of an entry. */
+    void
+    set(uint32_t set_idx, unsigned way, uint64_t k)
+    {
+        assert(way < assoc);
+        keys[(uint64_t)set_idx * stride + way] = k;
+    }
+
+    /** Mark an entry as unused. */
+    void clear(uint32_t set_idx, unsigned way) { set(set_idx, way, Invalid); }
+
+    /**
+     * Find the way of a set holding a key.
+     *
+     * @param set_idx The set to search.
+     * @param k The key to search for, must not be Invalid.
+     * @return The way holding the key, or -1 if none does.
+     */
+    int
+    find(uint32_t set_idx, uint64_t k) const
+    {
+        assert(k != Invalid);
+        const uint64_t *row = &keys[(uint64_t)set_idx * stride];
+
+#if defined(__AVX2__)
+        const __m256i needle = _mm256_set1_epi64x(k);
+        for (unsigned way = 0; way < stride; way += vectorWidth) {
+            const __m256i v = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(row + way));
+            const unsigned mask = _mm256_movemask_pd(
+                _mm256_castsi256_pd(_mm256_cmpeq_epi64(v, needle)));
+            if (mask)
+                return way + findLsbSet(mask);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const uint64x2_t needle = vdupq_n_u64(k);
+        for (unsigned way = 0; way < stride; way += vectorWidth) {
+            const uint64x2_t eq = vceqq_u64(vld1q_u64(row + way), needle);
+            if (vmaxvq_u32(vreinterpretq_u32_u64(eq))) {
+                return way + (vgetq_lane_u64(eq, 0) ? 0 : 1);
+            }
+        }
+#else
+        for (unsigned way = 0; way < assoc; ++way) {
+            if (row[way] == k)
+                return way;
+        }
+#endif
+        return -1;
+    }
+
+  private:
+    /** Number of ways per set. */
+    unsigned assoc;
+
+    /** Number of keys per set, including padding. */
+    unsigned stride;
+
+    std::vector<uint64_t> keys;
+};
+
+} // namespace gem5
+
+#endif // __MEM_CACHE_TAGS_PACKED_TAG_ARRAY_HH__
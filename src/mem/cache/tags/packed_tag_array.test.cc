@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/packed_tag_array.hh"
+
+using namespace gem5;
+
+/** Lookups find the way holding a key, for any associativity */
+TEST(PackedTagArrayTest, Find)
+{
+    for (unsigned assoc : { 1, 2, 3, 4, 7, 8, 16, 20 }) {
+        PackedTagArray tags;
+        tags.init(4, assoc);
+
+        for (unsigned way = 0; way < assoc; ++way)
+            EXPECT_EQ(tags.find(2, PackedTagArray::key(way, false)), -1);
+
+        for (unsigned way = 0; way < assoc; ++way)
+            tags.set(2, way, PackedTagArray::key(0x100 + way, false));
+        for (unsigned way = 0; way < assoc; ++way) {
+            EXPECT_EQ(tags.find(2, PackedTagArray::key(0x100 + way, false)),
+                      (int)way);
+            // Other sets are unaffected
+            EXPECT_EQ(tags.find(1, PackedTagArray::key(0x100 + way, false)),
+                      -1);
+            EXPECT_EQ(tags.find(3, PackedTagArray::key(0x100 + way, false)),
+                      -1);
+        }
+        EXPECT_EQ(tags.find(2, PackedTagArray::key(0x100 + assoc, false)),
+                  -1);
+
+        tags.clear(2, assoc - 1);
+        EXPECT_EQ(tags.find(2, PackedTagArray::key(0x100 + assoc - 1, false)),
+                  -1);
+    }
+}
+
+/** The secure bit is part of the key */
+TEST(PackedTagArrayTest, Secure)
+{
+    PackedTagArray tags;
+    tags.init(1, 8);
+    tags.set(0, 3, PackedTagArray::key(0x42, true));
+    tags.set(0, 5, PackedTagArray::key(0x42, false));
+    EXPECT_EQ(tags.find(0, PackedTagArray::key(0x42, true)), 3);
+    EXPECT_EQ(tags.find(0, PackedTagArray::key(0x42, false)), 5);
+}
+
+/** A tag of zero is a valid tag */
+TEST(PackedTagArrayTest, ZeroTag)
+{
+    PackedTagArray tags;
+    tags.init(2, 4);
+    EXPECT_EQ(tags.find(0, PackedTagArray::key(0, false)), -1);
+    tags.set(0, 1, PackedTagArray::key(0, false));
+    EXPECT_EQ(tags.find(0, PackedTagArray::key(0, false)), 1);
+}
+
+/** Lookups agree with a scan of a reference copy of the tags */
+TEST(PackedTagArrayTest, Random)
+{
+    const uint32_t num_sets = 64;
+    const unsigned assoc = 12;
+    std::mt19937_64 rng(7);
+
+    PackedTagArray tags;
+    tags.init(num_sets, assoc);
+    std::vector<uint64_t> ref(num_sets * assoc, PackedTagArray::Invalid);
+
+    for (int i = 0; i < 100000; ++i) {
+        const uint32_t set = rng() % num_sets;
+        const uint64_t key = PackedTagArray::key(rng() % 32, rng() % 2);
+        if (rng() % 4 == 0) {
+            const unsigned way = rng() % assoc;
+            // Keys are unique within a set
+            bool present = false;
+            for (unsigned w = 0; w < assoc; ++w)
+                present |= ref[set * assoc + w] == key;
+            if (!present) {
+                ref[set * assoc + way] = key;
+                tags.set(set, way, key);
+            }
+        } else if (rng() % 8 == 0) {
+            const unsigned way = rng() % assoc;
+            ref[set * assoc + way] = PackedTagArray::Invalid;
+            tags.clear(set, way);
+        }
+
+        int expected = -1;
+        for (unsigned w = 0; w < assoc; ++w) {
+            if (ref[set * assoc + w] == key)
+                expected = w;
+        }
+        ASSERT_EQ(tags.find(set, key), expected);
+    }
+}
@@ -92,6 +92,16 @@ class BasePartitioningPolicy : public SimObject
     */
     virtual void
     notifyRelease(const uint64_t partition_id) = 0;
+
+    /**
+    * Get the PartitionIDs this policy is configured for
+    * @return The policied PartitionIDs, none by default
+    */
+    virtual std::vector<uint64_t>
+    getPartitionIds() const
+    {
+        return {};
+    }
 };
 
 } // namespace partitioning_policy
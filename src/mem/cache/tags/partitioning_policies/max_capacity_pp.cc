@@ -93,22 +93,27 @@ MaxCapacityPartitioningPolicy::filterByPartition(
     std::vector<ReplaceableEntry *> &entries,
     const uint64_t id) const
 {
-    if (// No entries to filter
-        entries.empty() ||
-        // This partition_id is not policed
-        partitionIdMaxCapacity.find(id) == partitionIdMaxCapacity.end() ||
-        // This partition_id has not yet used the cache
-        partitionIdCurCapacity.find(id) == partitionIdCurCapacity.end() ||
-        // The partition_id usage is below the maximum
-        partitionIdCurCapacity.at(id) < partitionIdMaxCapacity.at(id))
+    // No entries to filter
+    if (entries.empty())
+        return;
+
+    // This partition_id is not policed
+    const auto max_it = partitionIdMaxCapacity.find(id);
+    if (max_it == partitionIdMaxCapacity.end())
+        return;
+
+    // This partition_id has not yet used the cache, or its usage is
+    // below the maximum
+    const auto cur_it = partitionIdCurCapacity.find(id);
+    if (cur_it == partitionIdCurCapacity.end() ||
+        cur_it->second < max_it->second)
         return;
 
     // Limit reached, restrict allocation only to blocks owned by
     // the Partition ID
     entries.erase(std::remove_if(entries.begin(), entries.end(),
         [id](ReplaceableEntry *entry) {
-            CacheBlk *blk = static_cast<CacheBlk *>(entry);
-            return blk->getPartitionId() != id;
+            return entry->getPartitionId() != id;
         }), entries.end());
 }
 
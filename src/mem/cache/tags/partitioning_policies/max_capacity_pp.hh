@@ -42,7 +42,7 @@
 #include <vector>
 
 #include "debug/PartitionPolicy.hh"
-#include "mem/cache/cache_blk.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/partitioning_policies/base_pp.hh"
 #include "params/BasePartitioningPolicy.hh"
 #include "params/MaxCapacityPartitioningPolicy.hh"
@@ -79,6 +79,12 @@ class MaxCapacityPartitioningPolicy : public BasePartitioningPolicy
     void
     notifyRelease(const uint64_t partition_id) override;
 
+    std::vector<uint64_t>
+    getPartitionIds() const override
+    {
+        return partitionIDs;
+    }
+
   private:
     /**
     * Cache size in number of bytes
@@ -37,6 +37,9 @@
 
 #include "mem/cache/tags/partitioning_policies/partition_manager.hh"
 
+#include <algorithm>
+#include <string>
+
 #include "mem/cache/tags/partitioning_policies/base_pp.hh"
 
 namespace gem5
@@ -47,12 +50,26 @@ namespace partitioning_policy
 
 PartitionManager::PartitionManager(const Params &p)
   : SimObject(p),
-    partitioningPolicies(p.partitioning_policies)
-{}
+    partitioningPolicies(p.partitioning_policies),
+    stats(*this)
+{
+    for (auto partitioning_policy : partitioningPolicies) {
+        for (auto id : partitioning_policy->getPartitionIds()) {
+            if (statIndices.emplace(id, statPartitionIds.size()).second)
+                statPartitionIds.push_back(id);
+        }
+    }
+    // One more entry for the non policied partitions
+    occupancies.resize(statPartitionIds.size() + 1, 0);
+}
 
 void
 PartitionManager::notifyAcquire(uint64_t partition_id)
 {
+    const unsigned idx = statIndex(partition_id);
+    occupancies[idx]++;
+    stats.allocations[idx]++;
+
     // Notify partitioning policies of acquisition of ownership
     for (auto & partitioning_policy : partitioningPolicies) {
         // get partitionId from Packet
@@ -63,12 +80,26 @@ PartitionManager::notifyAcquire(uint64_t partition_id)
 void
 PartitionManager::notifyRelease(uint64_t partition_id)
 {
+    const unsigned idx = statIndex(partition_id);
+    assert(occupancies[idx] > 0);
+    occupancies[idx]--;
+    stats.releases[idx]++;
+
     // Notify partitioning policies of release of ownership
     for (auto partitioning_policy : partitioningPolicies) {
         partitioning_policy->notifyRelease(partition_id);
     }
 }
 
+void
+PartitionManager::notifyAccess(uint64_t partition_id, bool hit)
+{
+    const unsigned idx = statIndex(partition_id);
+    stats.accesses[idx]++;
+    if (!hit)
+        stats.misses[idx]++;
+}
+
 void
 PartitionManager::filterByPartition(
     std::vector<ReplaceableEntry *> &entries,
@@ -80,6 +111,62 @@ PartitionManager::filterByPartition(
     }
 }
 
+PartitionManager::PartitionManagerStats::PartitionManagerStats(
+    PartitionManager &_pm)
+  : statistics::Group(&_pm), pm(_pm),
+    ADD_STAT(accesses, statistics::units::Count::get(),
+             "Number of accesses per PartitionID"),
+    ADD_STAT(misses, statistics::units::Count::get(),
+             "Number of misses per PartitionID"),
+    ADD_STAT(missRate, statistics::units::Ratio::get(),
+             "Miss rate per PartitionID"),
+    ADD_STAT(allocations, statistics::units::Count::get(),
+             "Number of blocks allocated per PartitionID"),
+    ADD_STAT(releases, statistics::units::Count::get(),
+             "Number of blocks released per PartitionID"),
+    ADD_STAT(occupancy, statistics::units::Count::get(),
+             "Number of blocks owned per PartitionID at the time of the "
+             "dump")
+{
+}
+
+void
+PartitionManager::PartitionManagerStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    const size_t size = pm.statPartitionIds.size() + 1;
+    auto subname = [&pm = pm, size](unsigned i) {
+        return i == size - 1 ? std::string("other") :
+            "partid" + std::to_string(pm.statPartitionIds[i]);
+    };
+
+    for (auto vec : {&accesses, &misses, &allocations, &releases,
+                     &occupancy}) {
+        vec->init(size).flags(nozero | nonan);
+        for (unsigned i = 0; i < size; i++)
+            vec->subname(i, subname(i));
+    }
+
+    missRate.flags(nozero | nonan);
+    missRate = misses / accesses;
+    for (unsigned i = 0; i < size; i++)
+        missRate.subname(i, subname(i));
+}
+
+void
+PartitionManager::PartitionManagerStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    // The occupancy is tracked outside of the stats so that it survives
+    // stats resets
+    for (unsigned i = 0; i < pm.occupancies.size(); i++)
+        occupancy[i] = pm.occupancies[i];
+}
+
 } // namespace partitioning_policy
 
 } // namespace gem5
@@ -38,6 +38,10 @@
 #ifndef __MEM_CACHE_TAGS_PARTITIONING_MANAGER_HH__
 #define __MEM_CACHE_TAGS_PARTITIONING_MANAGER_HH__
 
+#include <unordered_map>
+#include <vector>
+
+#include "base/statistics.hh"
 #include "mem/packet.hh"
 #include "params/PartitionManager.hh"
 #include "sim/sim_object.hh"
@@ -79,6 +83,13 @@ class PartitionManager : public SimObject
 
     void notifyRelease(uint64_t partition_id);
 
+    /**
+    * Notify of a cache access, only used for the stats
+    * @param partition_id PartitionID of the upstream memory request
+    * @param hit Whether the access hit in the cache
+    */
+    void notifyAccess(uint64_t partition_id, bool hit);
+
     void filterByPartition(std::vector<ReplaceableEntry *> &entries,
         const uint64_t partition_id) const;
 
@@ -86,6 +97,46 @@ class PartitionManager : public SimObject
     /** Partitioning policies */
     std::vector<partitioning_policy::BasePartitioningPolicy *>
         partitioningPolicies;
+
+    /**
+    * Index in the stats of the PartitionIDs configured in the policies,
+    * all the other PartitionIDs share the last index
+    */
+    std::unordered_map<uint64_t, unsigned> statIndices;
+    std::vector<uint64_t> statPartitionIds;
+
+    /** Number of cache blocks currently owned by each stats index */
+    std::vector<uint64_t> occupancies;
+
+    unsigned
+    statIndex(uint64_t partition_id) const
+    {
+        const auto it = statIndices.find(partition_id);
+        return it == statIndices.end() ? statPartitionIds.size() :
+            it->second;
+    }
+
+    struct PartitionManagerStats : public statistics::Group
+    {
+        PartitionManagerStats(PartitionManager &pm);
+
+        void regStats() override;
+        void preDumpStats() override;
+
+        const PartitionManager &pm;
+
+        /** Accesses and misses of each partition */
+        statistics::Vector accesses;
+        statistics::Vector misses;
+        statistics::Formula missRate;
+
+        /** Blocks allocated and released by each partition */
+        statistics::Vector allocations;
+        statistics::Vector releases;
+
+        /** Blocks currently owned by each partition */
+        statistics::Vector occupancy;
+    } stats;
 };
 
 } // namespace partitioning_policy
@@ -51,7 +51,9 @@ namespace partitioning_policy
 {
 
 WayPartitioningPolicy::WayPartitioningPolicy
-    (const WayPartitioningPolicyParams &params): BasePartitioningPolicy(params)
+    (const WayPartitioningPolicyParams &params)
+  : BasePartitioningPolicy(params),
+    maskWords((params.cache_associativity + 63) / 64)
 {
     // get cache associativity and check it is usable for this policy
     const auto cache_assoc = params.cache_associativity;
@@ -69,8 +71,11 @@ WayPartitioningPolicy::WayPartitioningPolicy
                 "for PartitionID: %d, Way: %d cannot be fullfiled as cache "
                 "associativity is %d", alloc_id, way, cache_assoc);
 
-            if (this->partitionIdWays[alloc_id].count(way) == 0) {
-                this->partitionIdWays[alloc_id].emplace(way);
+            auto &mask = this->partitionIdWays[alloc_id];
+            mask.resize(maskWords, 0);
+            const uint64_t bit = 1ULL << (way % 64);
+            if (!(mask[way / 64] & bit)) {
+                mask[way / 64] |= bit;
             } else {
                 // do not add duplicate allocation to policy and warn
                 warn("Duplicate Way Partitioning Policy allocation for "
@@ -91,25 +96,37 @@ WayPartitioningPolicy::filterByPartition(
     std::vector<ReplaceableEntry *> &entries,
     const uint64_t partition_id) const
 {
-    if (// No entries to filter
-        entries.empty() ||
-        // This partition_id is not policed
-        partitionIdWays.find(partition_id) == partitionIdWays.end()) {
+    // No entries to filter
+    if (entries.empty())
         return;
-    } else {
-        const auto entries_to_remove = std::remove_if(
-            entries.begin(),
-            entries.end(),
-            [this, partition_id]
-            (ReplaceableEntry *entry)
-            {
-                return partitionIdWays.at(partition_id).find(entry->getWay())
-                    == partitionIdWays.at(partition_id).end();
-            }
-        );
 
-        entries.erase(entries_to_remove, entries.end());
-    }
+    // This partition_id is not policed
+    const auto it = partitionIdWays.find(partition_id);
+    if (it == partitionIdWays.end())
+        return;
+
+    const uint64_t *mask = it->second.data();
+    const auto entries_to_remove = std::remove_if(
+        entries.begin(),
+        entries.end(),
+        [mask](ReplaceableEntry *entry)
+        {
+            const uint32_t way = entry->getWay();
+            return !((mask[way / 64] >> (way % 64)) & 1);
+        }
+    );
+
+    entries.erase(entries_to_remove, entries.end());
+}
+
+std::vector<uint64_t>
+WayPartitioningPolicy::getPartitionIds() const
+{
+    std::vector<uint64_t> ids;
+    for (const auto &id_ways : partitionIdWays)
+        ids.push_back(id_ways.first);
+    std::sort(ids.begin(), ids.end());
+    return ids;
 }
 
 } // namespace partitioning_policy
@@ -38,8 +38,9 @@
 #ifndef __MEM_CACHE_TAGS_PARTITIONING_POLICIES_WAY_HH__
 #define __MEM_CACHE_TAGS_PARTITIONING_POLICIES_WAY_HH__
 
+#include <cstdint>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include "debug/PartitionPolicy.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
@@ -85,12 +86,18 @@ class WayPartitioningPolicy : public BasePartitioningPolicy
     void
     notifyRelease(const uint64_t partition_id) override {};
 
+    std::vector<uint64_t> getPartitionIds() const override;
+
   private:
     /**
-    * Map of policied PartitionIDs and their associated cache ways
+    * Map of policied PartitionIDs and the bitmask of their associated
+    * cache ways, with one bit per way
     */
-    std::unordered_map< uint64_t, std::unordered_set< unsigned > >
+    std::unordered_map< uint64_t, std::vector< uint64_t > >
         partitionIdWays;
+
+    /** Number of words of the way bitmasks */
+    const unsigned maskWords;
 };
 
 } // namespace partitioning_policy
@@ -110,7 +110,7 @@ SectorTags::tagsInit()
             blk = &blks[blk_index];
 
             // Associate a data chunk to the block
-            blk->data = &dataBlks[blkSize*blk_index];
+            blk->data = blkData(blk_index);
 
             // Associate sector block to this block
             blk->setSectorBlock(sec_blk);
@@ -271,20 +271,21 @@ SectorTags::findBlock(Addr addr, bool is_secure) const
     // due to sectors being composed of contiguous-address entries
     const Addr offset = extractSectorOffset(addr);
 
-    // Find all possible sector entries that may contain the given address
-    const std::vector<ReplaceableEntry*> entries =
-        indexingPolicy->getPossibleEntries(addr);
-
-    // Search for block
-    for (const auto& sector : entries) {
-        auto blk = static_cast<SectorBlk*>(sector)->blks[offset];
-        if (blk->matchTag(tag, is_secure)) {
-            return blk;
-        }
-    }
+    // Search for block among the sectors that may contain the given address
+    CacheBlk *blk = nullptr;
+    indexingPolicy->findPossibleEntry(addr,
+        [&blk, tag, is_secure, offset](ReplaceableEntry *sector)
+        {
+            CacheBlk *sub_blk = static_cast<SectorBlk*>(sector)->blks[offset];
+            if (sub_blk->matchTag(tag, is_secure)) {
+                blk = sub_blk;
+                return true;
+            }
+            return false;
+        });
 
-    // Did not find block
-    return nullptr;
+    // Null if the block wasn't found
+    return blk;
 }
 
 CacheBlk*
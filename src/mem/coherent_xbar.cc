@@ -790,6 +790,11 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
         }
         snoop_response_cmd = snoop_result.first;
         snoop_response_latency += snoop_result.second;
+    } else if (system->bypassCaches() && snoopFilter) {
+        // caches that keep their tags warm while bypassed tell us
+        // which blocks they hold, make sure the snoop filter knows
+        // once the caches are in use again
+        snoopFilter->updateWarmedTags(pkt, *cpuSidePorts[cpu_side_port_id]);
     }
 
     // set up a sensible default value
@@ -85,7 +85,7 @@ class CoherentXBar : public BaseXBar
      * be instantiated for each of the mem_side_ports connecting to the
      * crossbar.
      */
-    class CoherentXBarResponsePort : public QueuedResponsePort
+    class CoherentXBarResponsePort final : public QueuedResponsePort
     {
 
       private:
@@ -96,13 +96,22 @@ class CoherentXBar : public BaseXBar
         /** A normal packet queue used to store responses. */
         RespPacketQueue queue;
 
+        static bool
+        directTimingReq(ResponsePort &port, PacketPtr pkt)
+        {
+            auto &self = static_cast<CoherentXBarResponsePort &>(port);
+            return self.xbar.recvTimingReq(pkt, self.id);
+        }
+
       public:
 
         CoherentXBarResponsePort(const std::string &_name,
                              CoherentXBar &_xbar, PortID _id)
             : QueuedResponsePort(_name, queue, _id), xbar(_xbar),
               queue(_xbar, *this)
-        { }
+        {
+            setTimingReqHandler(&directTimingReq);
+        }
 
       protected:
 
@@ -156,18 +165,27 @@ class CoherentXBar : public BaseXBar
      * instantiated for each of the CPU-side-port interfaces connecting to the
      * crossbar.
      */
-    class CoherentXBarRequestPort : public RequestPort
+    class CoherentXBarRequestPort final : public RequestPort
     {
       private:
         /** A reference to the crossbar to which this port belongs. */
         CoherentXBar &xbar;
 
+        static bool
+        directTimingResp(RequestPort &port, PacketPtr pkt)
+        {
+            auto &self = static_cast<CoherentXBarRequestPort &>(port);
+            return self.xbar.recvTimingResp(pkt, self.id);
+        }
+
       public:
 
         CoherentXBarRequestPort(const std::string &_name,
                               CoherentXBar &_xbar, PortID _id)
             : RequestPort(_name, _id), xbar(_xbar)
-        { }
+        {
+            setTimingRespHandler(&directTimingResp);
+        }
 
       protected:
 
@@ -39,6 +39,9 @@
 
 #include "mem/comm_monitor.hh"
 
+#include <algorithm>
+
+#include "base/cprintf.hh"
 #include "base/trace.hh"
 #include "debug/CommMonitor.hh"
 #include "sim/core.hh"
@@ -55,6 +58,8 @@ CommMonitor::CommMonitor(const Params &params)
       samplePeriodicEvent([this]{ samplePeriodic(); }, name()),
       samplePeriodTicks(params.sample_period),
       samplePeriod(params.sample_period / sim_clock::as_float::s),
+      probeSampleInterval(std::max(params.probe_sample_interval, 1U)),
+      probeReqCount(0), probeRespCount(0),
       stats(this, params)
 {
     DPRINTF(CommMonitor,
@@ -105,6 +110,8 @@ CommMonitor::MonitorStats::MonitorStats(statistics::Group *parent,
                                         const CommMonitorParams &params)
     : statistics::Group(parent),
 
+      fastStats(params.fast_stats),
+
       disableBurstLengthHists(params.disable_burst_length_hists),
       ADD_STAT(readBurstLengthHist, statistics::units::Byte::get(),
                "Histogram of burst lengths of transmitted packets"),
@@ -166,13 +173,41 @@ CommMonitor::MonitorStats::MonitorStats(statistics::Group *parent,
                "Histogram of write transactions per sample period"),
       writeTrans(0),
 
-      disableAddrDists(params.disable_addr_dists),
+      disableAddrDists(params.disable_addr_dists || params.fast_stats),
       readAddrMask(params.read_addr_mask),
       writeAddrMask(params.write_addr_mask),
       ADD_STAT(readAddrDist, statistics::units::Count::get(),
                "Read address distribution"),
       ADD_STAT(writeAddrDist, statistics::units::Count::get(),
-               "Write address distribution")
+               "Write address distribution"),
+
+      ADD_STAT(readBurstLengthLog2, statistics::units::Count::get(),
+               "Read burst lengths in power of two buckets (bytes)"),
+      ADD_STAT(writeBurstLengthLog2, statistics::units::Count::get(),
+               "Write burst lengths in power of two buckets (bytes)"),
+      ADD_STAT(readLatencyLog2, statistics::units::Count::get(),
+               "Read request-response latency in power of two buckets "
+               "(ticks)"),
+      ADD_STAT(writeLatencyLog2, statistics::units::Count::get(),
+               "Write request-response latency in power of two buckets "
+               "(ticks)"),
+      ADD_STAT(ittReadReadLog2, statistics::units::Count::get(),
+               "Read-to-read inter transaction time in power of two "
+               "buckets (ticks)"),
+      ADD_STAT(ittWriteWriteLog2, statistics::units::Count::get(),
+               "Write-to-write inter transaction time in power of two "
+               "buckets (ticks)"),
+      ADD_STAT(ittReqReqLog2, statistics::units::Count::get(),
+               "Request-to-request inter transaction time in power of two "
+               "buckets (ticks)"),
+
+      fastReadBurstLength(readBurstLengthLog2),
+      fastWriteBurstLength(writeBurstLengthLog2),
+      fastReadLatency(readLatencyLog2),
+      fastWriteLatency(writeLatencyLog2),
+      fastIttReadRead(ittReadReadLog2),
+      fastIttWriteWrite(ittWriteWriteLog2),
+      fastIttReqReq(ittReqReqLog2)
 {
     using namespace statistics;
 
@@ -253,6 +288,66 @@ CommMonitor::MonitorStats::MonitorStats(statistics::Group *parent,
     writeAddrDist
         .init(0)
         .flags(disableAddrDists ? nozero : pdf);
+
+    fastReadBurstLength.init(fastStats && !disableBurstLengthHists);
+    fastWriteBurstLength.init(fastStats && !disableBurstLengthHists);
+    fastReadLatency.init(fastStats && !disableLatencyHists);
+    fastWriteLatency.init(fastStats && !disableLatencyHists);
+    fastIttReadRead.init(fastStats && !disableITTDists);
+    fastIttWriteWrite.init(fastStats && !disableITTDists);
+    fastIttReqReq.init(fastStats && !disableITTDists);
+}
+
+void
+CommMonitor::MonitorStats::Log2Hist::init(bool enabled)
+{
+    stat.init(NumBuckets).flags(enabled ? statistics::total :
+                                          statistics::nozero);
+
+    stat.subname(0, "0");
+    for (int i = 1; i < NumBuckets; ++i) {
+        const uint64_t low = 1ULL << (i - 1);
+        stat.subname(i, csprintf("%d-%d", low, low + (low - 1)));
+    }
+}
+
+void
+CommMonitor::MonitorStats::Log2Hist::flush()
+{
+    for (int i = 0; i < NumBuckets; ++i) {
+        if (counts[i]) {
+            stat[i] += counts[i];
+            counts[i] = 0;
+        }
+    }
+}
+
+void
+CommMonitor::MonitorStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    fastReadBurstLength.flush();
+    fastWriteBurstLength.flush();
+    fastReadLatency.flush();
+    fastWriteLatency.flush();
+    fastIttReadRead.flush();
+    fastIttWriteWrite.flush();
+    fastIttReqReq.flush();
+}
+
+void
+CommMonitor::MonitorStats::resetStats()
+{
+    statistics::Group::resetStats();
+
+    fastReadBurstLength.reset();
+    fastWriteBurstLength.reset();
+    fastReadLatency.reset();
+    fastWriteLatency.reset();
+    fastIttReadRead.reset();
+    fastIttWriteWrite.reset();
+    fastIttReqReq.reset();
 }
 
 void
@@ -266,14 +361,26 @@ CommMonitor::MonitorStats::updateReqStats(
             ++readTrans;
 
         // Get sample of burst length
-        if (!disableBurstLengthHists)
-            readBurstLengthHist.sample(pkt_info.size);
+        if (!disableBurstLengthHists) {
+            if (fastStats)
+                fastReadBurstLength.sample(pkt_info.size);
+            else
+                readBurstLengthHist.sample(pkt_info.size);
+        }
 
         // Sample the masked address
         if (!disableAddrDists)
             readAddrDist.sample(pkt_info.addr & readAddrMask);
 
-        if (!disableITTDists) {
+        if (!disableITTDists && fastStats) {
+            if (timeOfLastRead != 0)
+                fastIttReadRead.sample(curTick() - timeOfLastRead);
+            timeOfLastRead = curTick();
+
+            if (timeOfLastReq != 0)
+                fastIttReqReq.sample(curTick() - timeOfLastReq);
+            timeOfLastReq = curTick();
+        } else if (!disableITTDists) {
             // Sample value of read-read inter transaction time
             if (timeOfLastRead != 0)
                 ittReadRead.sample(curTick() - timeOfLastRead);
@@ -292,8 +399,12 @@ CommMonitor::MonitorStats::updateReqStats(
         if (!disableTransactionHists)
             ++writeTrans;
 
-        if (!disableBurstLengthHists)
-            writeBurstLengthHist.sample(pkt_info.size);
+        if (!disableBurstLengthHists) {
+            if (fastStats)
+                fastWriteBurstLength.sample(pkt_info.size);
+            else
+                writeBurstLengthHist.sample(pkt_info.size);
+        }
 
         // Update the bandwidth stats on the request
         if (!disableBandwidthHists) {
@@ -305,7 +416,15 @@ CommMonitor::MonitorStats::updateReqStats(
         if (!disableAddrDists)
             writeAddrDist.sample(pkt_info.addr & writeAddrMask);
 
-        if (!disableITTDists) {
+        if (!disableITTDists && fastStats) {
+            if (timeOfLastWrite != 0)
+                fastIttWriteWrite.sample(curTick() - timeOfLastWrite);
+            timeOfLastWrite = curTick();
+
+            if (timeOfLastReq != 0)
+                fastIttReqReq.sample(curTick() - timeOfLastReq);
+            timeOfLastReq = curTick();
+        } else if (!disableITTDists) {
             // Sample value of write-to-write inter transaction time
             if (timeOfLastWrite != 0)
                 ittWriteWrite.sample(curTick() - timeOfLastWrite);
@@ -333,8 +452,12 @@ CommMonitor::MonitorStats::updateRespStats(
             --outstandingReadReqs;
         }
 
-        if (!disableLatencyHists)
-            readLatencyHist.sample(latency);
+        if (!disableLatencyHists) {
+            if (fastStats)
+                fastReadLatency.sample(latency);
+            else
+                readLatencyHist.sample(latency);
+        }
 
         // Update the bandwidth stats based on responses for reads
         if (!disableBandwidthHists) {
@@ -349,8 +472,12 @@ CommMonitor::MonitorStats::updateRespStats(
             --outstandingWriteReqs;
         }
 
-        if (!disableLatencyHists)
-            writeLatencyHist.sample(latency);
+        if (!disableLatencyHists) {
+            if (fastStats)
+                fastWriteLatency.sample(latency);
+            else
+                writeLatencyHist.sample(latency);
+        }
     }
 }
 
@@ -360,7 +487,8 @@ CommMonitor::recvAtomic(PacketPtr pkt)
     const bool expects_response(pkt->needsResponse() &&
                                 !pkt->cacheResponding());
     probing::PacketInfo req_pkt_info(pkt);
-    ppPktReq->notify(req_pkt_info);
+    if (sampleProbe(probeReqCount))
+        ppPktReq->notify(req_pkt_info);
 
     const Tick delay(memSidePort.sendAtomic(pkt));
 
@@ -370,8 +498,10 @@ CommMonitor::recvAtomic(PacketPtr pkt)
 
     // Some packets, such as WritebackDirty, don't need response.
     assert(pkt->isResponse() || !expects_response);
-    probing::PacketInfo resp_pkt_info(pkt);
-    ppPktResp->notify(resp_pkt_info);
+    if (sampleProbe(probeRespCount)) {
+        probing::PacketInfo resp_pkt_info(pkt);
+        ppPktResp->notify(resp_pkt_info);
+    }
     return delay;
 }
 
@@ -410,7 +540,7 @@ CommMonitor::recvTimingReq(PacketPtr pkt)
         delete pkt->popSenderState();
     }
 
-    if (successful) {
+    if (successful && sampleProbe(probeReqCount)) {
         ppPktReq->notify(pkt_info);
     }
 
@@ -463,7 +593,8 @@ CommMonitor::recvTimingResp(PacketPtr pkt)
     }
 
     if (successful) {
-        ppPktResp->notify(pkt_info);
+        if (sampleProbe(probeRespCount))
+            ppPktResp->notify(pkt_info);
         DPRINTF(CommMonitor, "Received %s response\n", pkt->isRead() ? "read" :
                 pkt->isWrite() ?  "write" : "non read/write");
         stats.updateRespStats(pkt_info, latency, false);
@@ -40,6 +40,9 @@
 #ifndef __MEM_COMM_MONITOR_HH__
 #define __MEM_COMM_MONITOR_HH__
 
+#include <array>
+
+#include "base/intmath.hh"
 #include "base/statistics.hh"
 #include "mem/port.hh"
 #include "params/CommMonitor.hh"
@@ -59,6 +62,13 @@ namespace gem5
  * (read-read, write-write, read/write-read/write). Furthermore it allows
  * to capture the number of accesses to an address over time ("heat map").
  * All stats can be disabled from Python.
+ *
+ * In the fast stats mode, the per packet stats (burst length, latency
+ * and inter transaction time) are instead counted in fixed power of
+ * two buckets outside of the stats framework, and are only folded into
+ * the stats when they are dumped. The packet probes can also be
+ * notified for only one in N packets. Together this keeps the cost of
+ * a monitor low enough to leave it in place.
  */
 class CommMonitor : public SimObject
 {
@@ -272,6 +282,35 @@ class CommMonitor : public SimObject
     /** Stats declarations, all in a struct for convenience. */
     struct MonitorStats : public statistics::Group
     {
+        /**
+         * Histogram with fixed power of two buckets which is cheap
+         * to update. Bucket 0 counts zero values, bucket i counts
+         * values in [2^(i-1), 2^i). The counts are moved to the
+         * associated stat when stats are dumped.
+         */
+        struct Log2Hist
+        {
+            static constexpr int NumBuckets = 65;
+
+            statistics::Vector &stat;
+            std::array<uint64_t, NumBuckets> counts{};
+
+            Log2Hist(statistics::Vector &_stat) : stat(_stat) {}
+
+            void
+            sample(uint64_t val)
+            {
+                counts[val ? floorLog2(val) + 1 : 0]++;
+            }
+
+            void init(bool enabled);
+            void flush();
+            void reset() { counts.fill(0); }
+        };
+
+        /** Use the log2 histograms instead of the regular ones. */
+        const bool fastStats;
+
         /** Disable flag for burst length histograms **/
         bool disableBurstLengthHists;
 
@@ -378,6 +417,28 @@ class CommMonitor : public SimObject
          */
         statistics::SparseHistogram writeAddrDist;
 
+        /**
+         * @{
+         * Log2 histograms used instead of the burst length, latency
+         * and ITT histograms in the fast stats mode.
+         */
+        statistics::Vector readBurstLengthLog2;
+        statistics::Vector writeBurstLengthLog2;
+        statistics::Vector readLatencyLog2;
+        statistics::Vector writeLatencyLog2;
+        statistics::Vector ittReadReadLog2;
+        statistics::Vector ittWriteWriteLog2;
+        statistics::Vector ittReqReqLog2;
+
+        Log2Hist fastReadBurstLength;
+        Log2Hist fastWriteBurstLength;
+        Log2Hist fastReadLatency;
+        Log2Hist fastWriteLatency;
+        Log2Hist fastIttReadRead;
+        Log2Hist fastIttWriteWrite;
+        Log2Hist fastIttReqReq;
+        /** @} */
+
         /**
          * Create the monitor stats and initialise all the members
          * that are not statistics themselves, but used to control the
@@ -390,8 +451,25 @@ class CommMonitor : public SimObject
                             bool expects_response);
         void updateRespStats(const probing::PacketInfo& pkt, Tick latency,
                              bool is_atomic);
+
+        void preDumpStats() override;
+        void resetStats() override;
     };
 
+    /**
+     * Check whether a packet should be passed to a probe point.
+     *
+     * @param count Number of packets seen by the probe point
+     */
+    bool
+    sampleProbe(unsigned &count)
+    {
+        if (++count < probeSampleInterval)
+            return false;
+        count = 0;
+        return true;
+    }
+
     /** This function is called periodically at the end of each time bin */
     void samplePeriodic();
 
@@ -408,6 +486,11 @@ class CommMonitor : public SimObject
     /** Sample period in seconds */
     const double samplePeriod;
 
+    /** Notify the packet probes for one in this many packets */
+    const unsigned probeSampleInterval;
+    unsigned probeReqCount;
+    unsigned probeRespCount;
+
     /** @} */
 
     /** Instantiate stats */
@@ -171,6 +171,88 @@ DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
     return std::make_pair(selected_pkt_it, selected_col_at);
 }
 
+std::pair<MemPacketQueue::iterator, Tick>
+DRAMInterface::chooseNextFRFCFSIndexed(MemPacketQueue& queue,
+                                       Tick min_col_at) const
+{
+    assert(queue.isIndexed());
+
+    // This makes the same decision as chooseNextFRFCFS, which walks
+    // the queue in arrival order and picks the first of: a seamless
+    // row hit; a row miss to one of the earliest banks if its bank
+    // can be prepared behind the scenes; any other row hit; any row
+    // miss to one of the earliest banks. Instead of walking the
+    // queue, look at the oldest hit and miss of each available bank.
+    MemPacket* seamless_pkt = nullptr;
+    MemPacket* prepped_pkt = nullptr;
+    bool got_miss = false;
+
+    std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
+
+    // older of two candidates, in arrival order
+    auto oldest = [](MemPacket* a, MemPacket* b) {
+        return !a || (b && b->queueSeq < a->queueSeq) ? b : a;
+    };
+
+    for (const auto& [key, bank_queue] : queue.banks(pseudoChannel)) {
+        if (!ranks[bank_queue.rank]->inRefIdleState())
+            continue;
+
+        got_waiting[bank_queue.bankId] = true;
+
+        const Bank& bank = ranks[bank_queue.rank]->banks[bank_queue.bank];
+        MemPacket* hit = bank_queue.oldestHit(bank.openRow);
+        if (hit) {
+            const Tick col_allowed_at = hit->isRead() ? bank.rdAllowedAt :
+                                                        bank.wrAllowedAt;
+            if (col_allowed_at <= min_col_at)
+                seamless_pkt = oldest(seamless_pkt, hit);
+            else
+                prepped_pkt = oldest(prepped_pkt, hit);
+        }
+        got_miss |= bank_queue.oldestMiss(bank.openRow) != nullptr;
+    }
+
+    MemPacket* selected_pkt = seamless_pkt;
+    if (!selected_pkt && got_miss) {
+        std::vector<uint32_t> earliest_banks;
+        bool hidden_bank_prep;
+        std::tie(earliest_banks, hidden_bank_prep) =
+            minBankPrep(got_waiting, min_col_at);
+
+        MemPacket* earliest_pkt = nullptr;
+        for (const auto& [key, bank_queue] : queue.banks(pseudoChannel)) {
+            if (!bits(earliest_banks[bank_queue.rank], bank_queue.bank,
+                      bank_queue.bank)) {
+                continue;
+            }
+            const Bank& bank = ranks[bank_queue.rank]->banks[bank_queue.bank];
+            earliest_pkt = oldest(earliest_pkt,
+                                  bank_queue.oldestMiss(bank.openRow));
+        }
+
+        if (earliest_pkt && (hidden_bank_prep || !prepped_pkt))
+            selected_pkt = earliest_pkt;
+        else
+            selected_pkt = prepped_pkt;
+    } else if (!selected_pkt) {
+        selected_pkt = prepped_pkt;
+    }
+
+    if (!selected_pkt) {
+        DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        return std::make_pair(queue.end(), MaxTick);
+    }
+
+    DPRINTF(DRAM, "%s selected DRAM packet in bank %d, row %d\n",
+            __func__, selected_pkt->bank, selected_pkt->row);
+
+    const Bank& bank = ranks[selected_pkt->rank]->banks[selected_pkt->bank];
+    const Tick col_allowed_at = selected_pkt->isRead() ? bank.rdAllowedAt :
+                                                         bank.wrAllowedAt;
+    return std::make_pair(queue.find(selected_pkt), col_allowed_at);
+}
+
 void
 DRAMInterface::activateBank(Rank& rank_ref, Bank& bank_ref,
                        Tick act_tick, uint32_t row)
@@ -204,8 +286,7 @@ DRAMInterface::activateBank(Rank& rank_ref, Bank& bank_ref,
             "%d active\n", bank_ref.bank, rank_ref.rank, act_at,
             ranks[rank_ref.rank]->numBanksActive);
 
-    rank_ref.cmdList.push_back(Command(MemCommand::ACT, bank_ref.bank,
-                               act_at));
+    rank_ref.pushCommand(MemCommand::ACT, bank_ref.bank, act_at);
 
     DPRINTF(DRAMPower, "%llu,ACT,%d,%d\n", divCeil(act_at, tCK) -
             timeStampOffset, bank_ref.bank, rank_ref.rank);
@@ -322,8 +403,7 @@ DRAMInterface::prechargeBank(Rank& rank_ref, Bank& bank, Tick pre_tick,
 
     if (trace) {
 
-        rank_ref.cmdList.push_back(Command(MemCommand::PRE, bank.bank,
-                                   pre_at));
+        rank_ref.pushCommand(MemCommand::PRE, bank.bank, pre_at);
         DPRINTF(DRAMPower, "%llu,PRE,%d,%d\n", divCeil(pre_at, tCK) -
                 timeStampOffset, bank.bank, rank_ref.rank);
     }
@@ -555,7 +635,7 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
     MemCommand::cmds command = (mem_cmd == "RD") ? MemCommand::RD :
                                                    MemCommand::WR;
 
-    rank_ref.cmdList.push_back(Command(command, mem_pkt->bank, cmd_at));
+    rank_ref.pushCommand(command, mem_pkt->bank, cmd_at);
 
     DPRINTF(DRAMPower, "%llu,%s,%d,%d\n", divCeil(cmd_at, tCK) -
             timeStampOffset, mem_cmd, mem_pkt->bank, mem_pkt->rank);
@@ -1024,20 +1104,34 @@ DRAMInterface::suspend()
     }
 }
 
-std::pair<std::vector<uint32_t>, bool>
-DRAMInterface::minBankPrep(const MemPacketQueue& queue,
-                      Tick min_col_at) const
+Tick
+DRAMInterface::analyticLatency(double row_hit_rate) const
 {
-    Tick min_act_at = MaxTick;
-    std::vector<uint32_t> bank_mask(ranksPerChannel, 0);
+    // a row hit only needs the column access, whereas a row miss
+    // also has to precharge the bank and activate the row, assuming
+    // the bank is not otherwise constrained
+    const Tick hit_lat = tRL + tBURST;
+    const Tick miss_lat = tRP + tRCD_RD + hit_lat;
+    return hit_lat + static_cast<Tick>((1.0 - row_hit_rate) *
+                                       (miss_lat - hit_lat));
+}
 
-    // Flag condition when burst can issue back-to-back with previous burst
-    bool found_seamless_bank = false;
+double
+DRAMInterface::rowHitRate() const
+{
+    const double bursts = stats.readBursts.value() +
+        stats.writeBursts.value();
+    if (bursts == 0)
+        return -1.0;
 
-    // Flag condition when bank can be opened without incurring additional
-    // delay on the data bus
-    bool hidden_bank_prep = false;
+    return (stats.readRowHits.value() + stats.writeRowHits.value()) /
+        bursts;
+}
 
+std::pair<std::vector<uint32_t>, bool>
+DRAMInterface::minBankPrep(const MemPacketQueue& queue,
+                      Tick min_col_at) const
+{
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
@@ -1048,6 +1142,23 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
             got_waiting[p->bankId] = true;
     }
 
+    return minBankPrep(got_waiting, min_col_at);
+}
+
+std::pair<std::vector<uint32_t>, bool>
+DRAMInterface::minBankPrep(const std::vector<bool>& got_waiting,
+                      Tick min_col_at) const
+{
+    Tick min_act_at = MaxTick;
+    std::vector<uint32_t> bank_mask(ranksPerChannel, 0);
+
+    // Flag condition when burst can issue back-to-back with previous burst
+    bool found_seamless_bank = false;
+
+    // Flag condition when bank can be opened without incurring additional
+    // delay on the data bus
+    bool hidden_bank_prep = false;
+
     // Find command with optimal bank timing
     // Will prioritize commands that can issue seamlessly.
     for (int i = 0; i < ranksPerChannel; i++) {
@@ -1122,7 +1233,8 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
       pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
-      wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
+      wakeUpAllowedAt(0), power(_p, false),
+      cmdListFlushBound(cmdListBatchSize), banks(_p.banks_per_rank),
       numBanksActive(0), actTicks(_p.activation_limit, 0), lastBurstTick(0),
       writeDoneEvent([this]{ processWriteDoneEvent(); }, name()),
       activateEvent([this]{ processActivateEvent(); }, name()),
@@ -1228,7 +1340,21 @@ DRAMInterface::Rank::flushCmdList()
     // reset cmdList to only contain commands after curTick
     // if there are no commands after curTick, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
-    cmdList.assign(next_iter, cmdList.end());
+    cmdList.erase(cmdList.begin(), next_iter);
+
+    // if most of the commands are still in the future, wait for the
+    // list to grow further rather than sorting it on every push
+    cmdListFlushBound = std::max(cmdListBatchSize, 2 * cmdList.size());
+}
+
+void
+DRAMInterface::Rank::pushCommand(MemCommand::cmds type, uint8_t bank,
+                                 Tick time_stamp)
+{
+    cmdList.push_back(Command(type, bank, time_stamp));
+
+    if (cmdList.size() >= cmdListFlushBound)
+        flushCmdList();
 }
 
 void
@@ -1364,7 +1490,7 @@ DRAMInterface::Rank::processRefreshEvent()
             }
 
             // precharge all banks in rank
-            cmdList.push_back(Command(MemCommand::PREA, 0, pre_at));
+            pushCommand(MemCommand::PREA, 0, pre_at);
 
             DPRINTF(DRAMPower, "%llu,PREA,0,%d\n",
                     divCeil(pre_at, dram.tCK) -
@@ -1411,7 +1537,7 @@ DRAMInterface::Rank::processRefreshEvent()
         }
 
         // at the moment this affects all ranks
-        cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
+        pushCommand(MemCommand::REF, 0, curTick());
 
         // Update the stats
         updatePowerStats();
@@ -1518,7 +1644,7 @@ DRAMInterface::Rank::powerDownSleep(PowerState pwr_state, Tick tick)
     if (pwr_state == PWR_ACT_PDN) {
         schedulePowerEvent(pwr_state, tick);
         // push command to DRAMPower
-        cmdList.push_back(Command(MemCommand::PDN_F_ACT, 0, tick));
+        pushCommand(MemCommand::PDN_F_ACT, 0, tick);
         DPRINTF(DRAMPower, "%llu,PDN_F_ACT,0,%d\n", divCeil(tick,
                 dram.tCK) - dram.timeStampOffset, rank);
     } else if (pwr_state == PWR_PRE_PDN) {
@@ -1527,7 +1653,7 @@ DRAMInterface::Rank::powerDownSleep(PowerState pwr_state, Tick tick)
         // This is neglected here.
         schedulePowerEvent(pwr_state, tick);
         //push Command to DRAMPower
-        cmdList.push_back(Command(MemCommand::PDN_F_PRE, 0, tick));
+        pushCommand(MemCommand::PDN_F_PRE, 0, tick);
         DPRINTF(DRAMPower, "%llu,PDN_F_PRE,0,%d\n", divCeil(tick,
                 dram.tCK) - dram.timeStampOffset, rank);
     } else if (pwr_state == PWR_REF) {
@@ -1537,7 +1663,7 @@ DRAMInterface::Rank::powerDownSleep(PowerState pwr_state, Tick tick)
         // this is not considered.
         schedulePowerEvent(PWR_PRE_PDN, tick);
         //push Command to DRAMPower
-        cmdList.push_back(Command(MemCommand::PDN_F_PRE, 0, tick));
+        pushCommand(MemCommand::PDN_F_PRE, 0, tick);
         DPRINTF(DRAMPower, "%llu,PDN_F_PRE,0,%d\n", divCeil(tick,
                 dram.tCK) - dram.timeStampOffset, rank);
     } else if (pwr_state == PWR_SREF) {
@@ -1547,7 +1673,7 @@ DRAMInterface::Rank::powerDownSleep(PowerState pwr_state, Tick tick)
         // this is not considered.
         schedulePowerEvent(PWR_SREF, tick);
         // push Command to DRAMPower
-        cmdList.push_back(Command(MemCommand::SREN, 0, tick));
+        pushCommand(MemCommand::SREN, 0, tick);
         DPRINTF(DRAMPower, "%llu,SREN,0,%d\n", divCeil(tick,
                 dram.tCK) - dram.timeStampOffset, rank);
     }
@@ -1597,16 +1723,16 @@ DRAMInterface::Rank::scheduleWakeUpEvent(Tick exit_delay)
     // use pwrStateTrans for cases where we have a power event scheduled
     // to enter low power that has not yet been processed
     if (pwrStateTrans == PWR_ACT_PDN) {
-        cmdList.push_back(Command(MemCommand::PUP_ACT, 0, wake_up_tick));
+        pushCommand(MemCommand::PUP_ACT, 0, wake_up_tick);
         DPRINTF(DRAMPower, "%llu,PUP_ACT,0,%d\n", divCeil(wake_up_tick,
                 dram.tCK) - dram.timeStampOffset, rank);
 
     } else if (pwrStateTrans == PWR_PRE_PDN) {
-        cmdList.push_back(Command(MemCommand::PUP_PRE, 0, wake_up_tick));
+        pushCommand(MemCommand::PUP_PRE, 0, wake_up_tick);
         DPRINTF(DRAMPower, "%llu,PUP_PRE,0,%d\n", divCeil(wake_up_tick,
                 dram.tCK) - dram.timeStampOffset, rank);
     } else if (pwrStateTrans == PWR_SREF) {
-        cmdList.push_back(Command(MemCommand::SREX, 0, wake_up_tick));
+        pushCommand(MemCommand::SREX, 0, wake_up_tick);
         DPRINTF(DRAMPower, "%llu,SREX,0,%d\n", divCeil(wake_up_tick,
                 dram.tCK) - dram.timeStampOffset, rank);
     }
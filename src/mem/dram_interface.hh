@@ -327,6 +327,17 @@ class DRAMInterface : public MemInterface
          */
         std::vector<Command> cmdList;
 
+        /**
+         * Number of commands in cmdList that triggers a flush to
+         * DRAMPower in between refreshes. This keeps the list, and
+         * the cost of sorting it, bounded when refreshes are far
+         * apart, e.g. in self-refresh or with long stats intervals.
+         */
+        static constexpr size_t cmdListBatchSize = 256;
+
+        /** Size of cmdList at which the next batch is flushed */
+        size_t cmdListFlushBound;
+
         /**
          * Vector of Banks. Each rank is made of several devices which in
          * term are made from several banks.
@@ -427,6 +438,17 @@ class DRAMInterface : public MemInterface
          */
         void flushCmdList();
 
+        /**
+         * Record a command for DRAMPower, and submit the commands which
+         * have completed as a batch once enough of them are pending.
+         *
+         * @param type The DRAMPower command type
+         * @param bank The bank the command targets
+         * @param time_stamp When the command is issued
+         */
+        void pushCommand(Data::MemCommand::cmds type, uint8_t bank,
+                         Tick time_stamp);
+
         /**
          * Computes stats just prior to dump event
          */
@@ -649,6 +671,18 @@ class DRAMInterface : public MemInterface
     std::pair<std::vector<uint32_t>, bool>
     minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
 
+    /**
+     * Find which are the earliest banks ready to issue an activate
+     * amongst the banks with queued requests.
+     *
+     * @param got_waiting Banks with queued requests, by bank id
+     * @param min_col_at time of seamless burst command
+     * @return One-hot encoded mask of bank indices
+     * @return boolean indicating burst can issue seamlessly, with no gaps
+     */
+    std::pair<std::vector<uint32_t>, bool>
+    minBankPrep(const std::vector<bool>& got_waiting, Tick min_col_at) const;
+
     /*
      * @return time to send a burst of data without gaps
      */
@@ -715,6 +749,12 @@ class DRAMInterface : public MemInterface
      */
     Tick accessLatency() const override { return (tRP + tRCD_RD + tRL); }
 
+    Tick analyticLatency(double row_hit_rate) const override;
+
+    double rowHitRate() const override;
+
+    Tick analyticBurstDelay() const override { return burstDelay(); }
+
     /**
      * For FR-FCFS policy, find first DRAM command that can issue
      *
@@ -726,6 +766,10 @@ class DRAMInterface : public MemInterface
     std::pair<MemPacketQueue::iterator, Tick>
     chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const override;
 
+    std::pair<MemPacketQueue::iterator, Tick>
+    chooseNextFRFCFSIndexed(MemPacketQueue& queue,
+                            Tick min_col_at) const override;
+
     /**
      * Actually do the burst - figure out the latency it
      * will take to service the req based on bank state, channel state etc
@@ -38,6 +38,7 @@
 #include "mem/dramsim3.hh"
 
 #include "base/callback.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/DRAMsim3.hh"
 #include "debug/Drain.hh"
@@ -52,15 +53,15 @@ namespace memory
 DRAMsim3::DRAMsim3(const Params &p) :
     AbstractMemory(p),
     port(name() + ".port", *this),
-    read_cb(std::bind(&DRAMsim3::readComplete,
-                      this, 0, std::placeholders::_1)),
-    write_cb(std::bind(&DRAMsim3::writeComplete,
-                       this, 0, std::placeholders::_1)),
+    read_cb([this](uint64_t addr) { completions.emplace_back(addr, false); }),
+    write_cb([this](uint64_t addr) { completions.emplace_back(addr, true); }),
     wrapper(p.configFile, p.filePath, read_cb, write_cb),
     retryReq(false), retryResp(false), startTick(0),
     nbrOutstandingReads(0), nbrOutstandingWrites(0),
     sendResponseEvent([this]{ sendResponse(); }, name()),
-    tickEvent([this]{ tick(); }, name())
+    tickEvent([this]{ tick(); }, name()),
+    cyclePeriod(wrapper.clockPeriod() * sim_clock::as_int::ns),
+    nextCycle(0)
 {
     DPRINTF(DRAMsim3,
             "Instantiated DRAMsim3 with clock %d ns and queue size %d\n",
@@ -68,7 +69,7 @@ DRAMsim3::DRAMsim3(const Params &p) :
 
     // Register a callback to compensate for the destructor not
     // being called. The callback prints the DRAMsim3 stats.
-    registerExitCallback([this]() { wrapper.printStats(); });
+    registerExitCallback([this]() { catchUp(); wrapper.printStats(); });
 }
 
 void
@@ -98,6 +99,7 @@ DRAMsim3::startup()
 
 void
 DRAMsim3::resetStats() {
+    catchUp();
     wrapper.resetStats();
 }
 
@@ -137,12 +139,69 @@ DRAMsim3::nbrOutstanding() const
     return nbrOutstandingReads + nbrOutstandingWrites + responseQueue.size();
 }
 
+bool
+DRAMsim3::idle() const
+{
+    return nbrOutstandingReads == 0 && nbrOutstandingWrites == 0 &&
+        !retryReq;
+}
+
+void
+DRAMsim3::catchUp()
+{
+    if (tickEvent.scheduled())
+        return;
+
+    if (nextCycle >= curTick())
+        return;
+
+    // Only tick when it's timing mode
+    if (system()->isTimingMode()) {
+        for (; nextCycle < curTick(); nextCycle += cyclePeriod)
+            wrapper.tick();
+        assert(completions.empty());
+    } else {
+        nextCycle += divCeil(curTick() - nextCycle, cyclePeriod) *
+            cyclePeriod;
+    }
+}
+
+void
+DRAMsim3::wakeUp()
+{
+    if (tickEvent.scheduled())
+        return;
+
+    DPRINTF(DRAMsim3, "Restarting the clock, next cycle at %d\n", nextCycle);
+
+    catchUp();
+    schedule(tickEvent, nextCycle);
+}
+
+void
+DRAMsim3::deliverCompletions()
+{
+    // readComplete() may send responses, which could bring new
+    // requests and completions, so don't iterate over the vector
+    for (size_t i = 0; i < completions.size(); ++i) {
+        const auto [addr, is_write] = completions[i];
+        if (is_write)
+            writeComplete(0, addr);
+        else
+            readComplete(0, addr);
+    }
+    completions.clear();
+}
+
 void
 DRAMsim3::tick()
 {
+    nextCycle = curTick() + cyclePeriod;
+
     // Only tick when it's timing mode
     if (system()->isTimingMode()) {
         wrapper.tick();
+        deliverCompletions();
 
         // is the connected port waiting for a retry, if so check the
         // state and send a retry if conditions have changed
@@ -152,8 +211,10 @@ DRAMsim3::tick()
         }
     }
 
-    schedule(tickEvent,
-        curTick() + wrapper.clockPeriod() * sim_clock::as_int::ns);
+    // Stop the clock while there is nothing to do, the skipped cycles
+    // are run when the next request arrives
+    if (!tickEvent.scheduled() && !idle())
+        schedule(tickEvent, nextCycle);
 }
 
 Tick
@@ -194,6 +255,9 @@ DRAMsim3::recvTimingReq(PacketPtr pkt)
     if (retryReq)
         return false;
 
+    // bring DRAMsim3 up to date if its clock was stopped
+    wakeUp();
+
     // if we cannot accept we need to send a retry once progress can
     // be made
     bool can_accept = nbrOutstanding() < wrapper.queueSize();
@@ -350,6 +414,10 @@ DRAMsim3::getPort(const std::string &if_name, PortID idx)
 DrainState
 DRAMsim3::drain()
 {
+    // run the skipped cycles in the current memory mode, before it
+    // possibly changes
+    catchUp();
+
     // check our outstanding reads and writes and if any they need to
     // drain
     return nbrOutstanding() != 0 ? DrainState::Draining : DrainState::Drained;
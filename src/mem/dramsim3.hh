@@ -46,6 +46,8 @@
 #include <functional>
 #include <queue>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "mem/abstract_mem.hh"
 #include "mem/dramsim3_wrapper.hh"
@@ -173,6 +175,43 @@ class DRAMsim3 : public AbstractMemory
      */
     EventFunctionWrapper tickEvent;
 
+    /** Period of the DRAMsim3 clock in ticks */
+    const Tick cyclePeriod;
+
+    /**
+     * Tick of the next DRAMsim3 clock cycle. Only meaningful when the
+     * clock is stopped, i.e. the tick event isn't scheduled.
+     */
+    Tick nextCycle;
+
+    /**
+     * Whether the clock can stop: nothing is in flight in DRAMsim3
+     * and no requestor waits for a retry.
+     */
+    bool idle() const;
+
+    /**
+     * Run the clock cycles which were skipped while idle, up to, but
+     * not including, the current tick. Nothing is in flight while the
+     * clock is stopped, so this is just a loop over the DRAMsim3 clock
+     * without any event, and leaves DRAMsim3 in the state the per
+     * cycle event would have.
+     */
+    void catchUp();
+
+    /** Restart the clock after an idle period, if it was stopped. */
+    void wakeUp();
+
+    /**
+     * Completions reported by DRAMsim3 during a clock cycle, as an
+     * address and whether it was a write. They are processed once
+     * the cycle is over, rather than from within DRAMsim3.
+     */
+    std::vector<std::pair<Addr, bool>> completions;
+
+    /** Process the completions of the last clock cycle. */
+    void deliverCompletions();
+
     /**
      * Upstream caches need this packet until true is returned, so
      * hold it for deletion until a subsequent call
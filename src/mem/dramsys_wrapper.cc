@@ -49,6 +49,10 @@ DRAMSysWrapper::DRAMSysWrapper(
     tSocket.register_b_transport(this, &DRAMSysWrapper::b_transport);
 
     tSocket.register_transport_dbg(this, &DRAMSysWrapper::transport_dbg);
+    tSocket.register_get_direct_mem_ptr(
+        this, &DRAMSysWrapper::get_direct_mem_ptr);
+    iSocket.register_invalidate_direct_mem_ptr(
+        this, &DRAMSysWrapper::invalidate_direct_mem_ptr);
     iSocket.bind(dramsys->tSocket);
 
     // Register a callback to compensate for the destructor not
@@ -108,5 +112,31 @@ unsigned int DRAMSysWrapper::transport_dbg(tlm::tlm_generic_payload &trans)
     return iSocket->transport_dbg(trans);
 }
 
+bool DRAMSysWrapper::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+                                        tlm::tlm_dmi &dmi_data)
+{
+    // Subtract base address offset
+    trans.set_address(trans.get_address() - range.start());
+
+    bool granted = iSocket->get_direct_mem_ptr(trans, dmi_data);
+
+    // The region is expressed in the address space of DRAMSys, add the
+    // offset back for the initiator. A denied request may describe the
+    // whole address space, so don't let the end wrap around.
+    sc_dt::uint64 end = dmi_data.get_end_address();
+    dmi_data.set_start_address(dmi_data.get_start_address() + range.start());
+    dmi_data.set_end_address(end > MaxAddr - range.start() ?
+                             MaxAddr : end + range.start());
+
+    return granted;
+}
+
+void DRAMSysWrapper::invalidate_direct_mem_ptr(sc_dt::uint64 start_range,
+                                               sc_dt::uint64 end_range)
+{
+    tSocket->invalidate_direct_mem_ptr(start_range + range.start(),
+                                       end_range + range.start());
+}
+
 } // namespace memory
 } // namespace gem5
@@ -80,6 +80,17 @@ class DRAMSysWrapper : public sc_core::sc_module
 
     unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
 
+    /**
+     * Forward DMI requests to DRAMSys, so that the TLM bridge can access
+     * its storage directly, and translate the granted region back to
+     * the address space of gem5.
+     */
+    bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+                            tlm::tlm_dmi &dmi_data);
+
+    void invalidate_direct_mem_ptr(sc_dt::uint64 start_range,
+                                   sc_dt::uint64 end_range);
+
     tlm_utils::simple_initiator_socket<DRAMSysWrapper> iSocket;
     tlm_utils::simple_target_socket<DRAMSysWrapper> tSocket;
 
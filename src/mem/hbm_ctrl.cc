@@ -43,33 +43,53 @@ namespace gem5
 namespace memory
 {
 
+HBMCtrl::PseudoChannel::PseudoChannel(HBMCtrl &ctrl, DRAMInterface *_intf)
+    : intf(_intf),
+      nextReqEvent([this, &ctrl] {ctrl.processNextReqEvent(intf, respQueue,
+                         respondEvent, nextReqEvent, retryWrReq);},
+                   ctrl.name()),
+      respondEvent([this, &ctrl] {ctrl.processRespondEvent(intf, respQueue,
+                         respondEvent, retryRdReq); }, ctrl.name())
+{
+}
+
 HBMCtrl::HBMCtrl(const HBMCtrlParams &p) :
     MemCtrl(p),
-    retryRdReqPC1(false), retryWrReqPC1(false),
-    nextReqEventPC1([this] {processNextReqEvent(pc1Int, respQueuePC1,
-                         respondEventPC1, nextReqEventPC1, retryWrReqPC1);},
-                         name()),
-    respondEventPC1([this] {processRespondEvent(pc1Int, respQueuePC1,
-                         respondEventPC1, retryRdReqPC1); }, name()),
-    pc1Int(p.dram_2)
+    pcIntlvLowBit(p.pseudo_channel_intlv_low_bit)
 {
     DPRINTF(MemCtrl, "Setting up HBM controller\n");
 
-    pc0Int = dynamic_cast<DRAMInterface*>(dram);
-
-    assert(dynamic_cast<DRAMInterface*>(p.dram_2) != nullptr);
-
-    readBufferSize = pc0Int->readBufferSize + pc1Int->readBufferSize;
-    writeBufferSize = pc0Int->writeBufferSize + pc1Int->writeBufferSize;
-
-    fatal_if(!pc0Int, "Memory controller must have pc0 interface");
-    fatal_if(!pc1Int, "Memory controller must have pc1 interface");
-
-    pc0Int->setCtrl(this, commandWindow, 0);
-    pc1Int->setCtrl(this, commandWindow, 1);
+    pcInts.push_back(dynamic_cast<DRAMInterface*>(dram));
+    pcInts.push_back(p.dram_2);
+    pcInts.insert(pcInts.end(), p.extra_pseudo_channels.begin(),
+                  p.extra_pseudo_channels.end());
+
+    fatal_if(!pcInts[0], "Memory controller must have pc0 interface");
+    fatal_if(!pcInts[1], "Memory controller must have pc1 interface");
+    fatal_if(!isPowerOf2(pcInts.size()) || pcInts.size() > 256,
+             "HBMCtrl needs a power of 2 number of pseudo channels, up to "
+             "256.\n");
+    pcIntlvBits = floorLog2(pcInts.size());
+
+    readBufferSize = 0;
+    writeBufferSize = 0;
+    for (int pc = 0; pc < pcInts.size(); ++pc) {
+        DRAMInterface *intf = pcInts[pc];
+        fatal_if(!intf, "Pseudo channel %d has no interface", pc);
+
+        readBufferSize += intf->readBufferSize;
+        writeBufferSize += intf->writeBufferSize;
+
+        intf->setCtrl(this, commandWindow, pc);
+        if (pc > 0)
+            extraPCs.emplace_back(new PseudoChannel(*this, intf));
+    }
 
-    writeHighThreshold = (writeBufferSize/2 * p.write_high_thresh_perc)/100.0;
-    writeLowThreshold = (writeBufferSize/2 * p.write_low_thresh_perc)/100.0;
+    const unsigned num_pcs = pcInts.size();
+    writeHighThreshold =
+        (writeBufferSize / num_pcs * p.write_high_thresh_perc) / 100.0;
+    writeLowThreshold =
+        (writeBufferSize / num_pcs * p.write_low_thresh_perc) / 100.0;
 }
 
 void
@@ -89,38 +109,65 @@ HBMCtrl::startup()
         // have to worry about negative values when computing the time for
         // the next request, this will add an insignificant bubble at the
         // start of simulation
-        pc1Int->nextBurstAt = curTick() + pc1Int->commandOffset();
+        for (auto &pc : extraPCs)
+            pc->intf->nextBurstAt = curTick() + pc->intf->commandOffset();
     }
 }
 
-Tick
-HBMCtrl::recvAtomic(PacketPtr pkt)
+bool
+HBMCtrl::respQEmpty()
 {
-    Tick latency = 0;
+    for (auto &pc : extraPCs) {
+        if (!pc->respQueue.empty())
+            return false;
+    }
+    return respQueue.empty();
+}
 
-    if (pc0Int->getAddrRange().contains(pkt->getAddr())) {
-        latency = recvAtomicLogic(pkt, pc0Int);
-    } else if (pc1Int->getAddrRange().contains(pkt->getAddr())) {
-        latency = recvAtomicLogic(pkt, pc1Int);
-    } else {
-        panic("Can't handle address range for packet %s\n", pkt->print());
+uint8_t
+HBMCtrl::pseudoChannelOf(Addr addr) const
+{
+    const uint8_t pc = bits(addr, pcIntlvLowBit + pcIntlvBits - 1,
+                            pcIntlvLowBit);
+    if (pcInts[pc]->getAddrRange().contains(addr))
+        return pc;
+
+    for (int i = 0; i < pcInts.size(); ++i) {
+        if (pcInts[i]->getAddrRange().contains(addr))
+            return i;
     }
+    panic("Can't handle address %#x\n", addr);
+}
 
-    return latency;
+DRAMInterface *
+HBMCtrl::interfaceOf(Addr addr) const
+{
+    for (auto *intf : pcInts) {
+        if (intf->getAddrRange().contains(addr))
+            return intf;
+    }
+    return nullptr;
+}
+
+Tick
+HBMCtrl::recvAtomic(PacketPtr pkt)
+{
+    DRAMInterface *intf = interfaceOf(pkt->getAddr());
+    panic_if(!intf, "Can't handle address range for packet %s\n",
+             pkt->print());
+
+    return recvAtomicLogic(pkt, intf);
 }
 
 void
 HBMCtrl::recvFunctional(PacketPtr pkt)
 {
-    bool found = recvFunctionalLogic(pkt, pc0Int);
-
-    if (!found) {
-        found = recvFunctionalLogic(pkt, pc1Int);
+    for (auto *intf : pcInts) {
+        if (recvFunctionalLogic(pkt, intf))
+            return;
     }
 
-    if (!found) {
-        panic("Can't handle address range for packet %s\n", pkt->print());
-    }
+    panic("Can't handle address range for packet %s\n", pkt->print());
 }
 
 Tick
@@ -128,15 +175,11 @@ HBMCtrl::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &backdoor)
 {
     Tick latency = recvAtomic(pkt);
 
-    if (pc0Int && pc0Int->getAddrRange().contains(pkt->getAddr())) {
-        pc0Int->getBackdoor(backdoor);
-    } else if (pc1Int && pc1Int->getAddrRange().contains(pkt->getAddr())) {
-        pc1Int->getBackdoor(backdoor);
-    }
-    else {
-        panic("Can't handle address range for packet %s\n",
-              pkt->print());
-    }
+    DRAMInterface *intf = interfaceOf(pkt->getAddr());
+    panic_if(!intf, "Can't handle address range for packet %s\n",
+             pkt->print());
+    intf->getBackdoor(backdoor);
+
     return latency;
 }
 
@@ -145,62 +188,41 @@ HBMCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
         MemBackdoorPtr &backdoor)
 {
     auto &range = req.range();
-    if (pc0Int && pc0Int->getAddrRange().isSubset(range)) {
-        pc0Int->getBackdoor(backdoor);
-    } else if (pc1Int && pc1Int->getAddrRange().isSubset(range)) {
-        pc1Int->getBackdoor(backdoor);
-    }
-    else {
-        panic("Can't handle address range for range %s\n", range.to_string());
+    for (auto *intf : pcInts) {
+        if (intf->getAddrRange().isSubset(range)) {
+            intf->getBackdoor(backdoor);
+            return;
+        }
     }
-}
-
-bool
-HBMCtrl::writeQueueFullPC0(unsigned int neededEntries) const
-{
-    DPRINTF(MemCtrl,
-            "Write queue limit %d, PC0 size %d, entries needed %d\n",
-            writeBufferSize/2, pc0Int->writeQueueSize, neededEntries);
 
-    unsigned int wrsize_new = (pc0Int->writeQueueSize + neededEntries);
-    return wrsize_new > (writeBufferSize/2);
+    panic("Can't handle address range for range %s\n", range.to_string());
 }
 
 bool
-HBMCtrl::writeQueueFullPC1(unsigned int neededEntries) const
+HBMCtrl::writeQueueFullPC(uint8_t pc, unsigned int neededEntries) const
 {
-    DPRINTF(MemCtrl,
-            "Write queue limit %d, PC1 size %d, entries needed %d\n",
-            writeBufferSize/2, pc1Int->writeQueueSize, neededEntries);
+    const unsigned int limit = writeBufferSize / pcInts.size();
 
-    unsigned int wrsize_new = (pc1Int->writeQueueSize + neededEntries);
-    return wrsize_new > (writeBufferSize/2);
-}
-
-bool
-HBMCtrl::readQueueFullPC0(unsigned int neededEntries) const
-{
     DPRINTF(MemCtrl,
-            "Read queue limit %d, PC0 size %d, entries needed %d\n",
-            readBufferSize/2, pc0Int->readQueueSize + respQueue.size(),
-            neededEntries);
+            "Write queue limit %d, PC%d size %d, entries needed %d\n",
+            limit, pc, pcInts[pc]->writeQueueSize, neededEntries);
 
-    unsigned int rdsize_new = pc0Int->readQueueSize + respQueue.size()
-                                               + neededEntries;
-    return rdsize_new > (readBufferSize/2);
+    unsigned int wrsize_new = (pcInts[pc]->writeQueueSize + neededEntries);
+    return wrsize_new > limit;
 }
 
 bool
-HBMCtrl::readQueueFullPC1(unsigned int neededEntries) const
+HBMCtrl::readQueueFullPC(uint8_t pc, unsigned int neededEntries)
 {
+    const unsigned int limit = readBufferSize / pcInts.size();
+    const unsigned int queued =
+        pcInts[pc]->readQueueSize + respQueueOf(pc).size();
+
     DPRINTF(MemCtrl,
-            "Read queue limit %d, PC1 size %d, entries needed %d\n",
-            readBufferSize/2, pc1Int->readQueueSize + respQueuePC1.size(),
-            neededEntries);
+            "Read queue limit %d, PC%d size %d, entries needed %d\n",
+            limit, pc, queued, neededEntries);
 
-    unsigned int rdsize_new = pc1Int->readQueueSize + respQueuePC1.size()
-                                               + neededEntries;
-    return rdsize_new > (readBufferSize/2);
+    return queued + neededEntries > limit;
 }
 
 bool
@@ -222,14 +244,13 @@ HBMCtrl::recvTimingReq(PacketPtr pkt)
     }
     prevArrival = curTick();
 
-    // What type of media does this packet access?
-    bool is_pc0;
+    // Which pseudo channel does this packet access?
+    const uint8_t pc = pseudoChannelOf(pkt->getAddr());
+    DRAMInterface *intf = pcInts[pc];
 
-    // TODO: make the interleaving bit across pseudo channels a parameter
-    if (bits(pkt->getAddr(), 6) == 0) {
-        is_pc0 = true;
-    } else {
-        is_pc0 = false;
+    if (analyticMode) {
+        recvTimingReqAnalytic(pkt, intf);
+        return true;
     }
 
     // Find out how many memory packets a pkt translates to
@@ -237,88 +258,52 @@ HBMCtrl::recvTimingReq(PacketPtr pkt)
     // translates to only one memory packet. Otherwise, a pkt translates to
     // multiple memory packets
     unsigned size = pkt->getSize();
-    uint32_t burst_size = pc0Int->bytesPerBurst();
+    uint32_t burst_size = intf->bytesPerBurst();
     unsigned offset = pkt->getAddr() & (burst_size - 1);
     unsigned int pkt_count = divCeil(offset + size, burst_size);
 
     // run the QoS scheduler and assign a QoS priority value to the packet
     qosSchedule({&readQueue, &writeQueue}, burst_size, pkt);
 
+    EventFunctionWrapper &next_req_event = nextReqEventOf(pc);
+
     // check local buffers and do not accept if full
     if (pkt->isWrite()) {
-        if (is_pc0) {
-            if (writeQueueFullPC0(pkt_count)) {
-                DPRINTF(MemCtrl, "Write queue full, not accepting\n");
-                // remember that we have to retry this port
-                retryWrReq = true;
-                stats.numWrRetry++;
-                return false;
-            } else {
-                addToWriteQueue(pkt, pkt_count, pc0Int);
-                if (!nextReqEvent.scheduled()) {
-                    DPRINTF(MemCtrl, "Request scheduled immediately\n");
-                    schedule(nextReqEvent, curTick());
-                }
-                stats.writeReqs++;
-                stats.bytesWrittenSys += size;
-            }
+        if (writeQueueFullPC(pc, pkt_count)) {
+            DPRINTF(MemCtrl, "Write queue full, not accepting\n");
+            // remember that we have to retry this port
+            retryWrReqOf(pc) = true;
+            stats.numWrRetry++;
+            return false;
         } else {
-            if (writeQueueFullPC1(pkt_count)) {
-                DPRINTF(MemCtrl, "Write queue full, not accepting\n");
-                // remember that we have to retry this port
-                retryWrReqPC1 = true;
-                stats.numWrRetry++;
-                return false;
-            } else {
-                addToWriteQueue(pkt, pkt_count, pc1Int);
-                if (!nextReqEventPC1.scheduled()) {
-                    DPRINTF(MemCtrl, "Request scheduled immediately\n");
-                    schedule(nextReqEventPC1, curTick());
-                }
-                stats.writeReqs++;
-                stats.bytesWrittenSys += size;
+            addToWriteQueue(pkt, pkt_count, intf);
+            if (!next_req_event.scheduled()) {
+                DPRINTF(MemCtrl, "Request scheduled immediately\n");
+                schedule(next_req_event, curTick());
             }
+            stats.writeReqs++;
+            stats.bytesWrittenSys += size;
         }
     } else {
 
         assert(pkt->isRead());
         assert(size != 0);
 
-        if (is_pc0) {
-            if (readQueueFullPC0(pkt_count)) {
-                DPRINTF(MemCtrl, "Read queue full, not accepting\n");
-                // remember that we have to retry this port
-                retryRdReq = true;
-                stats.numRdRetry++;
-                return false;
-            } else {
-                if (!addToReadQueue(pkt, pkt_count, pc0Int)) {
-                    if (!nextReqEvent.scheduled()) {
-                        DPRINTF(MemCtrl, "Request scheduled immediately\n");
-                        schedule(nextReqEvent, curTick());
-                    }
-                }
-
-                stats.readReqs++;
-                stats.bytesReadSys += size;
-            }
+        if (readQueueFullPC(pc, pkt_count)) {
+            DPRINTF(MemCtrl, "Read queue full, not accepting\n");
+            // remember that we have to retry this port
+            retryRdReqOf(pc) = true;
+            stats.numRdRetry++;
+            return false;
         } else {
-            if (readQueueFullPC1(pkt_count)) {
-                DPRINTF(MemCtrl, "Read queue full, not accepting\n");
-                // remember that we have to retry this port
-                retryRdReqPC1 = true;
-                stats.numRdRetry++;
-                return false;
-            } else {
-                if (!addToReadQueue(pkt, pkt_count, pc1Int)) {
-                    if (!nextReqEventPC1.scheduled()) {
-                        DPRINTF(MemCtrl, "Request scheduled immediately\n");
-                        schedule(nextReqEventPC1, curTick());
-                    }
+            if (!addToReadQueue(pkt, pkt_count, intf)) {
+                if (!next_req_event.scheduled()) {
+                    DPRINTF(MemCtrl, "Request scheduled immediately\n");
+                    schedule(next_req_event, curTick());
                 }
-                stats.readReqs++;
-                stats.bytesReadSys += size;
             }
+            stats.readReqs++;
+            stats.bytesReadSys += size;
         }
     }
 
@@ -470,25 +455,35 @@ HBMCtrl::drainResume()
         // if we switched to timing mode, kick things into action,
         // and behave as if we restored from a checkpoint
         startup();
-        pc1Int->startup();
+        for (auto &pc : extraPCs)
+            pc->intf->startup();
     } else if (isTimingMode && !system()->isTimingMode()) {
         // if we switch from timing mode, stop the refresh events to
         // not cause issues with KVM
-        if (pc1Int) {
-            pc1Int->drainRanks();
-        }
+        for (auto &pc : extraPCs)
+            pc->intf->drainRanks();
     }
 
     // update the mode
     isTimingMode = system()->isTimingMode();
 }
 
+bool
+HBMCtrl::allIntfDrained() const
+{
+    for (auto *intf : pcInts) {
+        if (!intf->allRanksDrained())
+            return false;
+    }
+    return true;
+}
+
 AddrRangeList
 HBMCtrl::getAddrRanges()
 {
     AddrRangeList ranges;
-    ranges.push_back(pc0Int->getAddrRange());
-    ranges.push_back(pc1Int->getAddrRange());
+    for (auto *intf : pcInts)
+        ranges.push_back(intf->getAddrRange());
     return ranges;
 }
 
@@ -35,11 +35,13 @@
 #define __HBM_CTRL_HH__
 
 #include <deque>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "mem/mem_ctrl.hh"
 #include "params/HBMCtrl.hh"
 
@@ -59,25 +61,44 @@ class DRAMInterface;
  * the HBM memory controller should be able to control both pseudo channels.
  * This HBM memory controller inherits from gem5's default
  * memory controller (pseudo channel 0) and manages the additional HBM pseudo
- * channel (pseudo channel 1).
+ * channels (pseudo channel 1 and, for configurations like HBM3 with more
+ * pseudo channels per channel, the extra ones).
+ *
+ * Each pseudo channel has its own scheduler, with its own request and
+ * respond events, response queue and share of the read and write buffers.
+ * A pseudo channel with nothing queued has no event scheduled, so idle
+ * pseudo channels cost nothing.
  */
 class HBMCtrl : public MemCtrl
 {
 
   protected:
 
-    bool respQEmpty() override
-    {
-        return (respQueue.empty() && respQueuePC1.empty());
-    }
+    bool respQEmpty() override;
 
   private:
 
     /**
-     * Remember if we have to retry a request for second pseudo channel.
+     * State of a pseudo channel other than the first one, which uses
+     * the queues and events of MemCtrl.
      */
-    bool retryRdReqPC1;
-    bool retryWrReqPC1;
+    struct PseudoChannel
+    {
+        PseudoChannel(HBMCtrl &ctrl, DRAMInterface *_intf);
+
+        DRAMInterface *intf;
+
+        /** Remember if we have to retry a request for this channel. */
+        bool retryRdReq = false;
+        bool retryWrReq = false;
+
+        /** Response queue for pkts sent to this pseudo channel */
+        MemPacketQueue respQueue;
+
+        /** NextReq and Respond events of this pseudo channel */
+        EventFunctionWrapper nextReqEvent;
+        EventFunctionWrapper respondEvent;
+    };
 
     /**
      * Remove commands that have already issued from rowBurstTicks
@@ -87,6 +108,45 @@ class HBMCtrl : public MemCtrl
 
     AddrRangeList getAddrRanges() override;
 
+    bool allIntfDrained() const override;
+
+    /**
+     * Pseudo channel of an address. The address bits above pcIntlvLowBit
+     * give the answer directly for the usual interleaving; the address
+     * ranges of the interfaces are only searched if the configuration
+     * interleaves the pseudo channels differently.
+     */
+    uint8_t pseudoChannelOf(Addr addr) const;
+
+    /** @{ Queues and events of a pseudo channel */
+    MemPacketQueue &
+    respQueueOf(uint8_t pc)
+    {
+        return pc == 0 ? respQueue : extraPCs[pc - 1]->respQueue;
+    }
+
+    EventFunctionWrapper &
+    nextReqEventOf(uint8_t pc)
+    {
+        return pc == 0 ? nextReqEvent : extraPCs[pc - 1]->nextReqEvent;
+    }
+
+    bool &
+    retryRdReqOf(uint8_t pc)
+    {
+        return pc == 0 ? retryRdReq : extraPCs[pc - 1]->retryRdReq;
+    }
+
+    bool &
+    retryWrReqOf(uint8_t pc)
+    {
+        return pc == 0 ? retryWrReq : extraPCs[pc - 1]->retryWrReq;
+    }
+    /** @} */
+
+    /** The interface whose address range holds an address, or null. */
+    DRAMInterface *interfaceOf(Addr addr) const;
+
   public:
     HBMCtrl(const HBMCtrlParams &p);
 
@@ -128,49 +188,26 @@ class HBMCtrl : public MemCtrl
                         Tick max_multi_cmd_split = 0) override;
 
     /**
-     * NextReq and Respond events for second pseudo channel
-     *
-     */
-    EventFunctionWrapper nextReqEventPC1;
-    EventFunctionWrapper respondEventPC1;
-
-    /**
-     * Check if the read queue partition of both pseudo
-     * channels has room for more entries. This is used when the HBM ctrl
-     * is run with partitioned queues
+     * Check if the read queue partition of a pseudo channel has room
+     * for more entries. Each pseudo channel gets an equal share of the
+     * read buffer.
      *
+     * @param pc The pseudo channel
      * @param pkt_count The number of entries needed in the read queue
      * @return true if read queue partition is full, false otherwise
      */
-    bool readQueueFullPC0(unsigned int pkt_count) const;
-    bool readQueueFullPC1(unsigned int pkt_count) const;
+    bool readQueueFullPC(uint8_t pc, unsigned int pkt_count);
 
     /**
-     * Check if the write queue partition of both pseudo
-     * channels has room for more entries. This is used when the HBM ctrl
-     * is run with partitioned queues
+     * Check if the write queue partition of a pseudo channel has room
+     * for more entries. Each pseudo channel gets an equal share of the
+     * write buffer.
      *
+     * @param pc The pseudo channel
      * @param pkt_count The number of entries needed in the write queue
      * @return true if write queue is full, false otherwise
      */
-    bool writeQueueFullPC0(unsigned int pkt_count) const;
-    bool writeQueueFullPC1(unsigned int pkt_count) const;
-
-    /**
-     * Following counters are used to keep track of the entries in read/write
-     * queue for each pseudo channel (useful when the partitioned queues are
-     * used)
-     */
-    uint64_t readQueueSizePC0 = 0;
-    uint64_t readQueueSizePC1 = 0;
-    uint64_t writeQueueSizePC0 = 0;
-    uint64_t writeQueueSizePC1 = 0;
-
-    /**
-     * Response queue for pkts sent to second pseudo channel
-     * The first pseudo channel uses MemCtrl::respQueue
-     */
-    std::deque<MemPacket*> respQueuePC1;
+    bool writeQueueFullPC(uint8_t pc, unsigned int pkt_count) const;
 
     /**
      * Holds count of row commands issued in burst window starting at
@@ -187,18 +224,17 @@ class HBMCtrl : public MemCtrl
     std::unordered_multiset<Tick> colBurstTicks;
 
     /**
-     * Pointers to interfaces of the two pseudo channels
-     * pc0Int is same as MemCtrl::dram (it will be pointing to
-     * the DRAM interface defined in base MemCtrl)
+     * Interfaces of all the pseudo channels, by pseudo channel number.
+     * The first one is the same as MemCtrl::dram.
      */
-    DRAMInterface* pc0Int;
-    DRAMInterface* pc1Int;
+    std::vector<DRAMInterface *> pcInts;
 
-    /**
-     * This indicates if the R/W queues will be partitioned among
-     * pseudo channels
-     */
-    bool partitionedQ;
+    /** State of the pseudo channels 1 and up */
+    std::vector<std::unique_ptr<PseudoChannel>> extraPCs;
+
+    /** Lowest address bit and number of bits selecting the channel */
+    const unsigned pcIntlvLowBit;
+    unsigned pcIntlvBits;
 
   public:
 
@@ -212,8 +248,8 @@ class HBMCtrl : public MemCtrl
         if (pseudo_channel == 0) {
             return MemCtrl::respondEventScheduled(pseudo_channel);
         } else {
-            assert(pseudo_channel == 1);
-            return respondEventPC1.scheduled();
+            assert(pseudo_channel < pcInts.size());
+            return extraPCs[pseudo_channel - 1]->respondEvent.scheduled();
         }
     }
 
@@ -227,8 +263,8 @@ class HBMCtrl : public MemCtrl
         if (pseudo_channel == 0) {
             return MemCtrl::requestEventScheduled(pseudo_channel);
         } else {
-            assert(pseudo_channel == 1);
-            return nextReqEventPC1.scheduled();
+            assert(pseudo_channel < pcInts.size());
+            return extraPCs[pseudo_channel - 1]->nextReqEvent.scheduled();
         }
     }
 
@@ -244,7 +280,7 @@ class HBMCtrl : public MemCtrl
         if (pseudo_channel == 0) {
             MemCtrl::restartScheduler(tick);
         } else {
-            schedule(nextReqEventPC1, tick);
+            schedule(extraPCs[pseudo_channel - 1]->nextReqEvent, tick);
         }
     }
 
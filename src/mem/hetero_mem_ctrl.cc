@@ -40,6 +40,8 @@
 
 #include "mem/hetero_mem_ctrl.hh"
 
+#include <algorithm>
+
 #include "base/trace.hh"
 #include "debug/DRAM.hh"
 #include "debug/Drain.hh"
@@ -59,7 +61,20 @@ namespace memory
 
 HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
     MemCtrl(p),
-    nvm(p.nvm)
+    nvm(p.nvm),
+    migrationEnabled(p.migration_enable),
+    pageSize(p.migration_page_size),
+    migrationThreshold(std::max(p.migration_threshold, 1U)),
+    sampleInterval(std::max(p.migration_sample_interval, 1U)),
+    migrationTicksPerByte(p.migration_bandwidth),
+    agingPeriod(p.migration_aging_period),
+    hotPages(p.migration_sketch_width),
+    accessesToSample(sampleInterval),
+    accessesToAging(agingPeriod),
+    victimCursor(0),
+    migratingPage(0), migratingVictim(0),
+    migrationEvent([this]{ completeMigration(); }, name()),
+    migrationStats(*this)
 {
     DPRINTF(MemCtrl, "Setting up controller\n");
     readQueue.resize(p.qos_priorities);
@@ -85,6 +100,171 @@ HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
         fatal("Write buffer low threshold %d must be smaller than the "
               "high threshold %d\n", p.write_low_thresh_perc,
               p.write_high_thresh_perc);
+
+    if (migrationEnabled) {
+        const AddrRange &dram_range = dram->getAddrRange();
+        const AddrRange &nvm_range = nvm->getAddrRange();
+
+        fatal_if(!isPowerOf2(pageSize) ||
+                 pageSize < dram->bytesPerBurst() ||
+                 pageSize < nvm->bytesPerBurst(),
+                 "HeteroMemCtrl's migration page size must be a power of 2 "
+                 "and at least a burst.\n");
+        fatal_if(dram_range.interleaved() || nvm_range.interleaved(),
+                 "HeteroMemCtrl can't migrate pages of interleaved "
+                 "ranges.\n");
+        fatal_if((dram_range.start() | dram_range.size() |
+                  nvm_range.start() | nvm_range.size()) & (pageSize - 1),
+                 "HeteroMemCtrl's ranges must be page aligned to migrate "
+                 "pages.\n");
+    }
+}
+
+void
+HeteroMemCtrl::setFrame(Addr page, Addr frame)
+{
+    if (page == frame) {
+        pageToFrame.erase(page);
+        frameToPage.erase(frame);
+    } else {
+        pageToFrame[page] = frame;
+        frameToPage[frame] = page;
+    }
+}
+
+Addr
+HeteroMemCtrl::mediaAddr(PacketPtr pkt) const
+{
+    const Addr addr = pkt->getAddr();
+    if (pageToFrame.empty())
+        return addr;
+
+    // Packets spanning several pages are timed at their home address.
+    const Addr page = pageOf(addr);
+    if (pageOf(addr + pkt->getSize() - 1) != page)
+        return addr;
+
+    return frameOf(page) | (addr & (pageSize - 1));
+}
+
+void
+HeteroMemCtrl::remapPacket(PacketPtr pkt, Addr media_addr)
+{
+    if (media_addr == pkt->getAddr())
+        return;
+
+    DPRINTF(MemCtrl, "Remapping %#x to %#x\n", pkt->getAddr(), media_addr);
+    remappedPkts[pkt] = pkt->getAddr();
+    pkt->setAddr(media_addr);
+    migrationStats.remappedAccesses++;
+}
+
+void
+HeteroMemCtrl::recordAccess(Addr addr, bool is_dram)
+{
+    if (is_dram)
+        migrationStats.dramAccesses++;
+    else
+        migrationStats.nvmAccesses++;
+
+    if (!migrationEnabled || --accessesToSample)
+        return;
+    accessesToSample = sampleInterval;
+
+    if (agingPeriod && !--accessesToAging) {
+        hotPages.age();
+        accessesToAging = agingPeriod;
+    }
+
+    const Addr page = pageOf(addr);
+    const CountMinSketch::Count count = hotPages.add(page);
+
+    if (!is_dram && count >= migrationThreshold &&
+        !migrationEvent.scheduled()) {
+        startMigration(page);
+    }
+}
+
+void
+HeteroMemCtrl::startMigration(Addr page)
+{
+    const AddrRange &dram_range = dram->getAddrRange();
+    const Addr num_frames = dram_range.size() / pageSize;
+
+    // Look at a few DRAM frames in turn for one holding a cold page.
+    for (int tries = 0; tries < 8; ++tries) {
+        const Addr frame = dram_range.start() + victimCursor * pageSize;
+        victimCursor = (victimCursor + 1) % num_frames;
+
+        if (hotPages.estimate(pageIn(frame)) < migrationThreshold) {
+            migratingPage = page;
+            migratingVictim = frame;
+
+            // Both pages of the swap are copied.
+            const Tick copy_time = 2 * pageSize * migrationTicksPerByte;
+            DPRINTF(MemCtrl, "Migrating page %#x to frame %#x in %d "
+                    "ticks\n", page, frame, copy_time);
+            schedule(migrationEvent, curTick() + copy_time);
+            return;
+        }
+    }
+
+    migrationStats.noVictim++;
+}
+
+void
+HeteroMemCtrl::completeMigration()
+{
+    const Addr nvm_frame = frameOf(migratingPage);
+    const Addr victim_page = pageIn(migratingVictim);
+
+    setFrame(migratingPage, migratingVictim);
+    setFrame(victim_page, nvm_frame);
+
+    DPRINTF(MemCtrl, "Migrated page %#x to frame %#x, page %#x to frame "
+            "%#x\n", migratingPage, migratingVictim, victim_page, nvm_frame);
+
+    migrationStats.migrations++;
+    migrationStats.migrationBytes += 2 * pageSize;
+}
+
+void
+HeteroMemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
+                                MemInterface* mem_intr)
+{
+    auto it = remappedPkts.find(pkt);
+    if (it != remappedPkts.end()) {
+        pkt->setAddr(it->second);
+        remappedPkts.erase(it);
+    }
+
+    // The data is always accessed at the home address of the packet.
+    if (!mem_intr->getAddrRange().contains(pkt->getAddr()))
+        mem_intr = mem_intr == dram ? nvm : dram;
+
+    MemCtrl::accessAndRespond(pkt, static_latency, mem_intr);
+}
+
+HeteroMemCtrl::MigrationStats::MigrationStats(HeteroMemCtrl &ctrl)
+    : statistics::Group(&ctrl, "migration"),
+
+    ADD_STAT(dramAccesses, statistics::units::Count::get(),
+             "Number of accepted requests served by the DRAM"),
+    ADD_STAT(nvmAccesses, statistics::units::Count::get(),
+             "Number of accepted requests served by the NVM"),
+    ADD_STAT(dramHitRate, statistics::units::Ratio::get(),
+             "Fraction of the requests served by the DRAM",
+             dramAccesses / (dramAccesses + nvmAccesses)),
+    ADD_STAT(remappedAccesses, statistics::units::Count::get(),
+             "Number of requests sent to a frame other than their home"),
+    ADD_STAT(migrations, statistics::units::Count::get(),
+             "Number of page swaps between the DRAM and the NVM"),
+    ADD_STAT(migrationBytes, statistics::units::Byte::get(),
+             "Number of bytes copied by page migrations"),
+    ADD_STAT(noVictim, statistics::units::Count::get(),
+             "Number of hot NVM pages not migrated for lack of a cold "
+             "DRAM page")
+{
 }
 
 Tick
@@ -123,16 +303,24 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
     prevArrival = curTick();
 
     // What type of media does this packet access?
+    const Addr media_addr = mediaAddr(pkt);
     bool is_dram;
-    if (dram->getAddrRange().contains(pkt->getAddr())) {
+    if (dram->getAddrRange().contains(media_addr)) {
         is_dram = true;
-    } else if (nvm->getAddrRange().contains(pkt->getAddr())) {
+    } else if (nvm->getAddrRange().contains(media_addr)) {
         is_dram = false;
     } else {
         panic("Can't handle address range for packet %s\n",
               pkt->print());
     }
 
+    if (analyticMode) {
+        recordAccess(pkt->getAddr(), is_dram);
+        remapPacket(pkt, media_addr);
+        recvTimingReqAnalytic(pkt, is_dram ? dram : nvm);
+        return true;
+    }
+
     // Find out how many memory packets a pkt translates to
     // If the burst size is equal or larger than the pkt size, then a pkt
     // translates to only one memory packet. Otherwise, a pkt translates to
@@ -156,6 +344,8 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
             stats.numWrRetry++;
             return false;
         } else {
+            recordAccess(pkt->getAddr(), is_dram);
+            remapPacket(pkt, media_addr);
             addToWriteQueue(pkt, pkt_count, is_dram ? dram : nvm);
             // If we are not already scheduled to get a request out of the
             // queue, do so now
@@ -176,6 +366,8 @@ HeteroMemCtrl::recvTimingReq(PacketPtr pkt)
             stats.numRdRetry++;
             return false;
         } else {
+            recordAccess(pkt->getAddr(), is_dram);
+            remapPacket(pkt, media_addr);
             if (!addToReadQueue(pkt, pkt_count, is_dram ? dram : nvm)) {
                 // If we are not already scheduled to get a request out of the
                 // queue, do so now
@@ -235,7 +427,8 @@ HeteroMemCtrl::chooseNext(MemPacketQueue& queue, Tick extra_col_delay,
                     break;
                 }
             }
-        } else if (memSchedPolicy == enums::frfcfs) {
+        } else if (memSchedPolicy == enums::frfcfs ||
+                   memSchedPolicy == enums::frfcfs_indexed) {
             Tick col_allowed_at;
             std::tie(ret, col_allowed_at)
                     = chooseNextFRFCFS(queue, extra_col_delay, mem_int);
@@ -434,6 +627,11 @@ HeteroMemCtrl::drain()
 
         return DrainState::Draining;
     } else {
+        // Don't leave a migration half done, finish it right away.
+        if (migrationEvent.scheduled()) {
+            deschedule(migrationEvent);
+            completeMigration();
+        }
         return DrainState::Drained;
     }
 }
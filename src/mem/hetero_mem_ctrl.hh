@@ -46,6 +46,9 @@
 #ifndef __HETERO_MEM_CTRL_HH__
 #define __HETERO_MEM_CTRL_HH__
 
+#include <unordered_map>
+
+#include "base/count_min_sketch.hh"
 #include "mem/mem_ctrl.hh"
 #include "params/HeteroMemCtrl.hh"
 
@@ -121,6 +124,102 @@ class HeteroMemCtrl : public MemCtrl
      */
     virtual bool nvmWriteBlock(MemInterface* mem_intr) override;
 
+    /**
+     * Restore the address of a remapped packet before accessing the
+     * data and responding.
+     */
+    void accessAndRespond(PacketPtr pkt, Tick static_latency,
+                          MemInterface* mem_intr) override;
+
+    /**
+     * @{
+     * @name Page migration
+     *
+     * Pages can be moved between the DRAM and the NVM. A hot NVM page
+     * is swapped with a cold DRAM page, and the remapping table then
+     * sends the requests to the page to its new frame. The data always
+     * stays at the address used by the requests: the remapping only
+     * changes which medium, and which rank, bank and row, a request is
+     * timed against. A copy is modelled as a delay based on the
+     * migration bandwidth, but does not use the memory bandwidth.
+     */
+
+    const bool migrationEnabled;
+    const Addr pageSize;
+    const unsigned migrationThreshold;
+    const unsigned sampleInterval;
+    /** Time to copy one byte of a page. */
+    const double migrationTicksPerByte;
+    const unsigned agingPeriod;
+
+    /** Access counts of the pages, by page address. */
+    CountMinSketch hotPages;
+    unsigned accessesToSample;
+    unsigned accessesToAging;
+
+    /** Current frame of the pages that are not in their home frame. */
+    std::unordered_map<Addr, Addr> pageToFrame;
+    /** Page held by the frames that don't hold their home page. */
+    std::unordered_map<Addr, Addr> frameToPage;
+
+    /** Original addresses of the packets sent to another frame. */
+    std::unordered_map<PacketPtr, Addr> remappedPkts;
+
+    /** Next DRAM frame to consider as a migration victim. */
+    Addr victimCursor;
+
+    /** The NVM page being migrated and the DRAM frame it goes to. */
+    Addr migratingPage;
+    Addr migratingVictim;
+    EventFunctionWrapper migrationEvent;
+
+    Addr pageOf(Addr addr) const { return addr & ~(pageSize - 1); }
+
+    Addr
+    frameOf(Addr page) const
+    {
+        auto it = pageToFrame.find(page);
+        return it == pageToFrame.end() ? page : it->second;
+    }
+
+    Addr
+    pageIn(Addr frame) const
+    {
+        auto it = frameToPage.find(frame);
+        return it == frameToPage.end() ? frame : it->second;
+    }
+
+    void setFrame(Addr page, Addr frame);
+
+    /** Address of the medium a packet is timed against. */
+    Addr mediaAddr(PacketPtr pkt) const;
+
+    /** Make a packet use its media address for its stay in the queues. */
+    void remapPacket(PacketPtr pkt, Addr media_addr);
+
+    /** Count an access and start migrating its page if it is hot. */
+    void recordAccess(Addr addr, bool is_dram);
+
+    void startMigration(Addr page);
+    void completeMigration();
+
+    struct MigrationStats : public statistics::Group
+    {
+        MigrationStats(HeteroMemCtrl &ctrl);
+
+        statistics::Scalar dramAccesses;
+        statistics::Scalar nvmAccesses;
+        statistics::Formula dramHitRate;
+        statistics::Scalar remappedAccesses;
+        statistics::Scalar migrations;
+        statistics::Scalar migrationBytes;
+        statistics::Scalar noVictim;
+    };
+
+    MigrationStats migrationStats;
+
+    /** @} */
+
   public:
 
     HeteroMemCtrl(const HeteroMemCtrlParams &p);
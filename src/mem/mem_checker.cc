@@ -37,6 +37,9 @@
 
 #include "mem/mem_checker.hh"
 
+#include <algorithm>
+#include <utility>
+
 #include "base/logging.hh"
 #include "sim/cur_tick.hh"
 
@@ -66,15 +69,15 @@ MemChecker::WriteCluster::startWrite(MemChecker::Serial serial, Tick _start,
     }
 
     // Create new transaction, and denote completion time to be in the future.
-    writes.insert(std::make_pair(serial,
-                  MemChecker::Transaction(serial, _start, TICK_FUTURE, data)));
+    writes.emplace_back(serial, _start, TICK_FUTURE, data);
 }
 
 void
 MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
     Tick _complete)
 {
-    auto it = writes.find(serial);
+    auto it = std::find_if(writes.begin(), writes.end(),
+        [serial](const Transaction &write) { return write.serial == serial; });
 
     if (it == writes.end()) {
         warn("Could not locate write transaction: serial = %d, "
@@ -83,8 +86,8 @@ MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
     }
 
     // Record completion time of the write
-    assert(it->second.complete == TICK_FUTURE);
-    it->second.complete = _complete;
+    assert(it->complete == TICK_FUTURE);
+    it->complete = _complete;
 
     // Update max completion time for the cluster
     if (completeMax < _complete) {
@@ -105,10 +108,14 @@ MemChecker::WriteCluster::completeWrite(MemChecker::Serial serial,
 void
 MemChecker::WriteCluster::abortWrite(MemChecker::Serial serial)
 {
-    if (!writes.erase(serial)) {
+    auto it = std::find_if(writes.begin(), writes.end(),
+        [serial](const Transaction &write) { return write.serial == serial; });
+
+    if (it == writes.end()) {
         warn("Could not locate write transaction: serial = %d\n", serial);
         return;
     }
+    writes.erase(it);
 
     if (--numIncomplete == 0 && !writes.empty()) {
         // This write cluster is now complete, and we can assign the current
@@ -124,15 +131,16 @@ MemChecker::WriteCluster::abortWrite(MemChecker::Serial serial)
 void
 MemChecker::ByteTracker::startRead(MemChecker::Serial serial, Tick start)
 {
-    outstandingReads.insert(std::make_pair(serial,
-            MemChecker::Transaction(serial, start, TICK_FUTURE)));
+    assert(outstandingReads.empty() ||
+           outstandingReads.back().serial < serial);
+    outstandingReads.emplace_back(serial, start, TICK_FUTURE);
 }
 
 bool
 MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
-    uint8_t data)
+    uint8_t data, std::vector<uint8_t> &expected, const MemChecker &checker)
 {
-    _lastExpectedData.clear();
+    expected.clear();
 
     bool wc_overlap = true;
 
@@ -145,9 +153,7 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
     // preceding & overlapping writes.
     for (auto cluster = writeClusters.rbegin();
          cluster != writeClusters.rend() && wc_overlap; ++cluster) {
-        for (const auto& addr_write : cluster->writes) {
-            const Transaction& write = addr_write.second;
-
+        for (const Transaction& write : cluster->writes) {
             if (write.complete < last_obs.start) {
                 // If this write transaction completed before the last
                 // observation, we ignore it as the last_observation has the
@@ -161,7 +167,7 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
             }
 
             // Record possible, but non-matching data for debugging
-            _lastExpectedData.push_back(write.data);
+            expected.push_back(write.data);
 
             if (write.complete > start) {
                 // This write overlapped with the transaction we want to check
@@ -197,7 +203,7 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
             return true;
         }
         // Record non-matching, but possible value
-        _lastExpectedData.push_back(last_obs.data);
+        expected.push_back(last_obs.data);
     } else {
         // We have not seen any valid observation, and the only writes
         // observed are overlapping, so anything (in particular the
@@ -211,12 +217,13 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
         }
     }
 
-    if (_lastExpectedData.empty()) {
+    if (expected.empty()) {
         assert(last_obs.complete == TICK_INITIAL);
         // We have not found any possible (non-matching data). Can happen in
         // initial system state
-        DPRINTF(MemChecker, "no last observation nor write! start = %d, "\
-                "complete = %d, data = %#x\n", start, complete, data);
+        DPRINTFS(MemChecker, &checker, "no last observation nor write! "
+                 "start = %d, complete = %d, data = %#x\n", start, complete,
+                 data);
         return true;
     }
     return false;
@@ -224,25 +231,36 @@ MemChecker::ByteTracker::inExpectedData(Tick start, Tick complete,
 
 bool
 MemChecker::ByteTracker::completeRead(MemChecker::Serial serial,
-                                      Tick complete, uint8_t data)
+    Tick complete, uint8_t data, Tick horizon,
+    std::vector<uint8_t> &expected, const MemChecker &checker)
 {
-    auto it = outstandingReads.find(serial);
+    auto it = std::lower_bound(outstandingReads.begin(),
+        outstandingReads.end(), serial,
+        [](const Transaction &read, Serial s) { return read.serial < s; });
 
-    if (it == outstandingReads.end()) {
+    if (it == outstandingReads.end() || it->serial != serial) {
         // Can happen if concurrent with reset_address_range
         warn("Could not locate read transaction: serial = %d, complete = %d\n",
              serial, complete);
         return true;
     }
 
-    Tick start = it->second.start;
+    Tick start = it->start;
     outstandingReads.erase(it);
 
-    // Verify data
-    const bool result = inExpectedData(start, complete, data);
+    // Verify data, unless the history the read could have observed may have
+    // been pruned already
+    bool result = true;
+    if (start >= horizon) {
+        result = inExpectedData(start, complete, data, expected, checker);
+    } else {
+        warn_once("MemChecker: reads outstanding for longer than the "
+                  "history window are not checked\n");
+        expected.clear();
+    }
 
     readObservations.emplace_back(serial, start, complete, data);
-    pruneTransactions();
+    pruneTransactions(horizon);
 
     return result;
 }
@@ -266,10 +284,10 @@ MemChecker::ByteTracker::startWrite(MemChecker::Serial serial, Tick start,
 
 void
 MemChecker::ByteTracker::completeWrite(MemChecker::Serial serial,
-    Tick complete)
+    Tick complete, Tick horizon)
 {
     getIncompleteWriteCluster()->completeWrite(serial, complete);
-    pruneTransactions();
+    pruneTransactions(horizon);
 }
 
 void
@@ -279,13 +297,14 @@ MemChecker::ByteTracker::abortWrite(MemChecker::Serial serial)
 }
 
 void
-MemChecker::ByteTracker::pruneTransactions()
+MemChecker::ByteTracker::pruneTransactions(Tick horizon)
 {
     // Obtain tick of first outstanding read. If there are no outstanding
     // reads, we use curTick(), i.e. we will remove all readObservation except
-    // the most recent one.
+    // the most recent one. Reads older than the horizon don't hold back the
+    // pruning, they won't be checked anyway.
     const Tick before = outstandingReads.empty() ? curTick() :
-                        outstandingReads.begin()->second.start;
+        std::max(outstandingReads.front().start, horizon);
 
     // Pruning of readObservations
     readObservations.erase(readObservations.begin(),
@@ -308,10 +327,10 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
             "completing read: serial = %d, complete = %d, "
             "addr = %#llx, size = %d\n", serial, complete, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        ByteTracker *tracker = getByteTracker(addr + i);
-
-        if (!tracker->completeRead(serial, complete, data[i])) {
+    const Tick horizon = historyHorizon(complete);
+    forEachByte(addr, size, [&](ByteTracker &tracker, size_t i) {
+        if (!tracker.completeRead(serial, complete, data[i], horizon,
+                                  expectedData, *this)) {
             // Generate error message, and aggregate all failures for the bytes
             // considered in this transaction in one message.
             if (result) {
@@ -325,15 +344,13 @@ MemChecker::completeRead(MemChecker::Serial serial, Tick complete,
                                      "failed: received %#x, expected ",
                                      (unsigned long long)(addr + i), data[i]);
 
-            for (size_t j = 0; j < tracker->lastExpectedData().size(); ++j) {
+            for (size_t j = 0; j < expectedData.size(); ++j) {
                 errorMessage +=
-                    csprintf("%#x%s",
-                             tracker->lastExpectedData()[j],
-                             (j == tracker->lastExpectedData().size() - 1)
-                             ? "" : "|");
+                    csprintf("%#x%s", expectedData[j],
+                             (j == expectedData.size() - 1) ? "" : "|");
             }
         }
-    }
+    });
 
     if (!result) {
         DPRINTF(MemChecker, "read of %#llx @ cycle %d failed:\n%s\n", addr,
@@ -347,8 +364,77 @@ void
 MemChecker::reset(Addr addr, size_t size)
 {
     for (size_t i = 0; i < size; ++i) {
-        byte_trackers.erase(addr + i);
+        const Addr line_addr = (addr + i) & ~Addr(LineTracker::Size - 1);
+        const size_t slot = findLineSlot(line_addr);
+        if (!lineSlots[slot].used)
+            continue;
+
+        LineTracker &line = lineSlots[slot].tracker;
+        line.erase((addr + i) - line_addr);
+        if (line.empty())
+            eraseLineSlot(slot);
+    }
+}
+
+size_t
+MemChecker::findLineSlot(Addr line_addr) const
+{
+    const size_t mask = lineSlots.size() - 1;
+    size_t slot = lineSlotIndex(line_addr);
+    // The table is kept at most half full, so there always is a free slot
+    // to stop the probing
+    while (lineSlots[slot].used && lineSlots[slot].addr != line_addr)
+        slot = (slot + 1) & mask;
+    return slot;
+}
+
+MemChecker::LineTracker&
+MemChecker::getLineTracker(Addr line_addr)
+{
+    size_t slot = findLineSlot(line_addr);
+    if (lineSlots[slot].used)
+        return lineSlots[slot].tracker;
+
+    if (2 * (numLines + 1) > lineSlots.size()) {
+        // Grow the table, and rehash all the lines
+        std::vector<LineSlot> old_slots(lineSlots.size() * 2);
+        old_slots.swap(lineSlots);
+        for (auto &old_slot : old_slots) {
+            if (old_slot.used)
+                lineSlots[findLineSlot(old_slot.addr)] = std::move(old_slot);
+        }
+        slot = findLineSlot(line_addr);
+    }
+
+    ++numLines;
+    lineSlots[slot].used = true;
+    lineSlots[slot].addr = line_addr;
+    return lineSlots[slot].tracker;
+}
+
+void
+MemChecker::eraseLineSlot(size_t slot)
+{
+    const size_t mask = lineSlots.size() - 1;
+
+    // Shift back the lines that follow in the probe sequence, so that no
+    // tombstones are needed
+    size_t hole = slot;
+    size_t idx = slot;
+    while (true) {
+        idx = (idx + 1) & mask;
+        if (!lineSlots[idx].used)
+            break;
+        // A line can fill the hole only if its home slot isn't within the
+        // (cyclic) range (hole, idx]
+        const size_t home = lineSlotIndex(lineSlots[idx].addr);
+        if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+            lineSlots[hole] = std::move(lineSlots[idx]);
+            hole = idx;
+        }
     }
+    lineSlots[hole] = LineSlot();
+    --numLines;
 }
 
 } // namespace gem5
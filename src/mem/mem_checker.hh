@@ -38,15 +38,15 @@
 #ifndef __MEM_MEM_CHECKER_HH__
 #define __MEM_MEM_CHECKER_HH__
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <list>
-#include <map>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/cprintf.hh"
+#include "base/intmath.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
@@ -70,6 +70,11 @@ namespace gem5
  * on the particular location, and we do not consider the effect of multi-byte
  * reads or writes. This precludes us from discovering single-copy atomicity
  * violations.
+ *
+ * The per-byte trackers are grouped by cache line sized chunks, the bytes
+ * in use being recorded in a mask, and the chunks are kept in an open
+ * addressing hash table, so a transaction only looks up each line it
+ * touches once.
 */
 class MemChecker : public SimObject
 {
@@ -184,31 +189,29 @@ class MemChecker : public SimObject
         Tick complete;  //!< Completion of last write in cluster
 
         /**
-         * Map of Serial --> Transaction of all writes in cluster; contains
-         * all, in-flight or already completed.
+         * All writes in cluster, in-flight or already completed. Clusters
+         * hold few writes, so they are simply searched by serial.
          */
-        std::unordered_map<Serial, Transaction> writes;
+        std::vector<Transaction> writes;
 
       private:
         Tick completeMax;
         size_t numIncomplete;
     };
 
-    typedef std::list<Transaction> TransactionList;
-    typedef std::list<WriteCluster> WriteClusterList;
+    typedef std::vector<Transaction> TransactionList;
+    typedef std::vector<WriteCluster> WriteClusterList;
 
     /**
      * The ByteTracker keeps track of transactions for the *same byte* -- all
      * outstanding reads, the completed reads (and what they observed) and write
      * clusters (see WriteCluster).
      */
-    class ByteTracker : public Named
+    class ByteTracker
     {
       public:
 
-        ByteTracker(Addr addr = 0, const MemChecker *parent = NULL)
-            : Named((parent != NULL ? parent->name() : "") +
-                     csprintf(".ByteTracker@%#llx", addr))
+        ByteTracker()
         {
             // The initial transaction has start == complete == TICK_INITIAL,
             // indicating that there has been no real write to this location;
@@ -247,10 +250,16 @@ class MemChecker : public SimObject
          * @param start     Start time of transaction to validate.
          * @param complete  End time of transaction to validate.
          * @param data      The value that we have actually seen.
+         * @param expected  Filled with the expected data iterated through.
+         *                  If a match is found, the set may be incomplete;
+         *                  otherwise it contains the full set.
+         * @param checker   The checker, to name debug messages after.
          *
          * @return          True if a match is found, false otherwise.
          */
-        bool inExpectedData(Tick start, Tick complete, uint8_t data);
+        bool inExpectedData(Tick start, Tick complete, uint8_t data,
+                            std::vector<uint8_t> &expected,
+                            const MemChecker &checker);
 
         /**
          * Completes a read transaction that is still outstanding.
@@ -258,8 +267,14 @@ class MemChecker : public SimObject
          * @param serial   Unique identifier of a read *previously started*.
          * @param complete When the read got a response.
          * @param data     The data returned by the memory subsystem.
+         * @param horizon  History older than this may have been pruned, so
+         *                 reads started earlier are not checked.
+         * @param expected See inExpectedData().
+         * @param checker  See inExpectedData().
          */
-        bool completeRead(Serial serial, Tick complete, uint8_t data);
+        bool completeRead(Serial serial, Tick complete, uint8_t data,
+                          Tick horizon, std::vector<uint8_t> &expected,
+                          const MemChecker &checker);
 
         /**
          * Starts a write transaction. Wrapper to startWrite of WriteCluster
@@ -278,8 +293,9 @@ class MemChecker : public SimObject
          *
          * @param serial   Unique identifier of a write *previously started*.
          * @param complete When the write was sent off to the memory subsystem.
+         * @param horizon  Tick the history may be pruned up to.
          */
-        void completeWrite(Serial serial, Tick complete);
+        void completeWrite(Serial serial, Tick complete, Tick horizon);
 
         /**
          * Aborts a write transaction. Wrapper to abortWrite of WriteCluster
@@ -289,18 +305,6 @@ class MemChecker : public SimObject
          */
         void abortWrite(Serial serial);
 
-        /**
-         * This function returns the expected data that inExpectedData iterated
-         * through in the last call. If inExpectedData last returned true, the
-         * set may be incomplete; if inExpectedData last returned false, the
-         * vector will contain the full set.
-         *
-         * @return Reference to internally maintained vector maintaining last
-         *         expected data that inExpectedData iterated through.
-         */
-        const std::vector<uint8_t>& lastExpectedData() const
-        { return _lastExpectedData; }
-
       private:
 
         /**
@@ -342,19 +346,21 @@ class MemChecker : public SimObject
          *
          * It depends on the contention / overlap between memory operations to
          * the same location of a particular workload how large each of them
-         * would grow.
+         * would grow, unless a history window bounds it (see horizon).
+         *
+         * @param horizon Also prune the history completed before this tick,
+         *                even if outstanding reads are older.
          */
-        void pruneTransactions();
+        void pruneTransactions(Tick horizon);
 
       private:
 
         /**
-         * Maintains a map of Serial -> Transaction for all outstanding reads.
-         *
-         * Use an ordered map here, as this makes pruneTransactions() more
-         * efficient (find first outstanding read).
+         * All outstanding reads. Serials are handed out in increasing
+         * order, so this is sorted by serial, which makes
+         * pruneTransactions() efficient (find first outstanding read).
          */
-        std::map<Serial, Transaction> outstandingReads;
+        std::vector<Transaction> outstandingReads;
 
         /**
          * List of completed reads, i.e. observations of reads.
@@ -365,19 +371,75 @@ class MemChecker : public SimObject
          * List of write clusters for this address.
          */
         WriteClusterList writeClusters;
+    };
+
+    /**
+     * The ByteTrackers of the bytes in use in a cache line sized chunk of
+     * the address space.
+     */
+    class LineTracker
+    {
+      public:
+        /** Size of the chunks, in bytes. */
+        static constexpr unsigned Size = 64;
 
         /**
-         * See lastExpectedData().
+         * @param offset Offset of the byte in the chunk.
+         * @return The tracker of the byte, created if needed.
          */
-        std::vector<uint8_t> _lastExpectedData;
+        ByteTracker&
+        get(unsigned offset)
+        {
+            const auto idx = index(offset);
+            if (!bits(mask, offset)) {
+                mask |= 1ULL << offset;
+                bytes.emplace(bytes.begin() + idx);
+            }
+            return bytes[idx];
+        }
+
+        /**
+         * Stop tracking a byte.
+         *
+         * @param offset Offset of the byte in the chunk.
+         */
+        void
+        erase(unsigned offset)
+        {
+            if (bits(mask, offset)) {
+                bytes.erase(bytes.begin() + index(offset));
+                mask &= ~(1ULL << offset);
+            }
+        }
+
+        /** @return True if no byte of the chunk is tracked. */
+        bool empty() const { return mask == 0; }
+
+      private:
+        /** Position of the tracker of a byte in the bytes vector. */
+        unsigned
+        index(unsigned offset) const
+        {
+            return popCount(mask & ((1ULL << offset) - 1));
+        }
+
+        /** The bytes being tracked. */
+        uint64_t mask = 0;
+
+        /** Trackers of the bytes set in mask, in offset order. */
+        std::vector<ByteTracker> bytes;
     };
 
   public:
 
     MemChecker(const MemCheckerParams &p)
         : SimObject(p),
-          nextSerial(SERIAL_INITIAL)
-    {}
+          historyWindow(p.history_window),
+          nextSerial(SERIAL_INITIAL),
+          numLines(0)
+    {
+        lineSlots.resize(MinLineSlots);
+    }
 
     virtual ~MemChecker() {}
 
@@ -451,8 +513,12 @@ class MemChecker : public SimObject
      * same serial S and then receive a completion of the transaction before
      * the reset with serial S.
      */
-    void reset()
-    { byte_trackers.clear(); }
+    void
+    reset()
+    {
+        lineSlots.assign(MinLineSlots, LineSlot());
+        numLines = 0;
+    }
 
     /**
      * Resets an address-range. This may be useful in case other unmonitored
@@ -476,20 +542,81 @@ class MemChecker : public SimObject
     const std::string& getErrorMessage() const { return errorMessage; }
 
   private:
+    /** An entry of the open addressing table of line trackers. */
+    struct LineSlot
+    {
+        bool used = false;
+        Addr addr = 0;
+        LineTracker tracker;
+    };
+
+    /** Initial (and minimum) number of slots of the line table. */
+    static constexpr size_t MinLineSlots = 1024;
+
+    /** Home slot of a line in the table (Fibonacci hashing). */
+    size_t
+    lineSlotIndex(Addr line_addr) const
+    {
+        return ((line_addr / LineTracker::Size) * 0x9e3779b97f4a7c15ULL) >>
+            (64 - floorLog2(lineSlots.size()));
+    }
+
+    /**
+     * Position of a line in the table: either the slot holding it, or the
+     * free slot that terminates its probe sequence.
+     */
+    size_t findLineSlot(Addr line_addr) const;
+
+    /**
+     * Returns the tracker of the requested line, created if needed.
+     */
+    LineTracker& getLineTracker(Addr line_addr);
+
+    /** Remove the line held by a slot from the table. */
+    void eraseLineSlot(size_t slot);
+
     /**
-     * Returns the instance of ByteTracker for the requested location.
+     * Iterate over the bytes of an access, one line at a time, so that
+     * each line is only looked up once.
+     *
+     * @param addr Address of the access.
+     * @param size Size of the access.
+     * @param visitor Called with each ByteTracker and the index of its
+     *        byte in the access.
      */
-    ByteTracker* getByteTracker(Addr addr)
+    template <typename Visitor>
+    void
+    forEachByte(Addr addr, size_t size, Visitor &&visitor)
     {
-        auto it = byte_trackers.find(addr);
-        if (it == byte_trackers.end()) {
-            it = byte_trackers.insert(
-                std::make_pair(addr, ByteTracker(addr, this))).first;
+        size_t i = 0;
+        while (i < size) {
+            const Addr byte_addr = addr + i;
+            const Addr line_addr = byte_addr & ~Addr(LineTracker::Size - 1);
+            LineTracker &line = getLineTracker(line_addr);
+            const size_t end = std::min<size_t>(size,
+                i + (line_addr + LineTracker::Size - byte_addr));
+            for (; i < end; ++i)
+                visitor(line.get((addr + i) - line_addr), i);
         }
-        return &it->second;
-    };
+    }
+
+    /**
+     * Tick before which the history may be pruned (see history_window).
+     */
+    Tick
+    historyHorizon(Tick now) const
+    {
+        return historyWindow && now > historyWindow ?
+            now - historyWindow : TICK_INITIAL;
+    }
 
   private:
+    /**
+     * Age after which the completed history of a location is pruned even
+     * if older reads are outstanding. Zero means unbounded.
+     */
+    const Tick historyWindow;
+
     /**
      * Detailed error message of the last violation in completeRead.
      */
@@ -502,17 +629,26 @@ class MemChecker : public SimObject
     Serial nextSerial;
 
     /**
-     * Maintain a map of address --> byte-tracker. Per-byte entries are
-     * initialized as needed.
+     * Expected data of the byte being checked by completeRead.
+     */
+    std::vector<uint8_t> expectedData;
+
+    /**
+     * Open addressing table (with linear probing) of line address -->
+     * line-tracker. Per-line and per-byte entries are initialized as
+     * needed.
      *
      * The required space for this obviously grows with the number of distinct
      * addresses used for a particular workload. The used size is independent on
      * the number of nodes in the system, those may affect the size of per-byte
      * tracking information.
      *
-     * Access via getByteTracker()!
+     * Access via getLineTracker()!
      */
-    std::unordered_map<Addr, ByteTracker> byte_trackers;
+    std::vector<LineSlot> lineSlots;
+
+    /** Number of used slots in lineSlots. */
+    size_t numLines;
 };
 
 inline MemChecker::Serial
@@ -522,9 +658,9 @@ MemChecker::startRead(Tick start, Addr addr, size_t size)
             "starting read: serial = %d, start = %d, addr = %#llx, "
             "size = %d\n", nextSerial, start, addr , size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->startRead(nextSerial, start);
-    }
+    forEachByte(addr, size, [this, start](ByteTracker &tracker, size_t i) {
+        tracker.startRead(nextSerial, start);
+    });
 
     return nextSerial++;
 }
@@ -536,9 +672,10 @@ MemChecker::startWrite(Tick start, Addr addr, size_t size, const uint8_t *data)
             "starting write: serial = %d, start = %d, addr = %#llx, "
             "size = %d\n", nextSerial, start, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->startWrite(nextSerial, start, data[i]);
-    }
+    forEachByte(addr, size,
+                [this, start, data](ByteTracker &tracker, size_t i) {
+        tracker.startWrite(nextSerial, start, data[i]);
+    });
 
     return nextSerial++;
 }
@@ -551,9 +688,11 @@ MemChecker::completeWrite(MemChecker::Serial serial, Tick complete,
             "completing write: serial = %d, complete = %d, "
             "addr = %#llx, size = %d\n", serial, complete, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->completeWrite(serial, complete);
-    }
+    const Tick horizon = historyHorizon(complete);
+    forEachByte(addr, size,
+                [serial, complete, horizon](ByteTracker &tracker, size_t i) {
+        tracker.completeWrite(serial, complete, horizon);
+    });
 }
 
 inline void
@@ -563,9 +702,9 @@ MemChecker::abortWrite(MemChecker::Serial serial, Addr addr, size_t size)
             "aborting write: serial = %d, addr = %#llx, size = %d\n",
             serial, addr, size);
 
-    for (size_t i = 0; i < size; ++i) {
-        getByteTracker(addr + i)->abortWrite(serial);
-    }
+    forEachByte(addr, size, [serial](ByteTracker &tracker, size_t i) {
+        tracker.abortWrite(serial);
+    });
 }
 
 } // namespace gem5
@@ -73,6 +73,8 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
     minWritesPerSwitch(p.min_writes_per_switch),
     minReadsPerSwitch(p.min_reads_per_switch),
     memSchedPolicy(p.mem_sched_policy),
+    analyticMode(p.analytic_mode),
+    analyticRowHitRate(p.analytic_row_hit_rate),
     frontendLatency(p.static_frontend_latency),
     backendLatency(p.static_backend_latency),
     commandWindow(p.command_window),
@@ -83,6 +85,10 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
 
     readQueue.resize(p.qos_priorities);
     writeQueue.resize(p.qos_priorities);
+    for (auto &queue : readQueue)
+        queue.setIndexed(memSchedPolicy == enums::frfcfs_indexed);
+    for (auto &queue : writeQueue)
+        queue.setIndexed(memSchedPolicy == enums::frfcfs_indexed);
 
     dram->setCtrl(this, commandWindow);
 
@@ -425,6 +431,11 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     panic_if(!(dram->getAddrRange().contains(pkt->getAddr())),
              "Can't handle address range for packet %s\n", pkt->print());
 
+    if (analyticMode) {
+        recvTimingReqAnalytic(pkt, dram);
+        return true;
+    }
+
     // Find out how many memory packets a pkt translates to
     // If the burst size is equal or larger than the pkt size, then a pkt
     // translates to only one memory packet. Otherwise, a pkt translates to
@@ -484,6 +495,59 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
     return true;
 }
 
+void
+MemCtrl::recvTimingReqAnalytic(PacketPtr pkt, MemInterface* mem_intr)
+{
+    const unsigned size = pkt->getSize();
+    const uint32_t burst_size = mem_intr->bytesPerBurst();
+    const unsigned offset = pkt->getAddr() & (burst_size - 1);
+    const unsigned int pkt_count = divCeil(offset + size, burst_size);
+    assert(size != 0);
+
+    // the bursts are transferred back to back as soon as the data
+    // bus is free, which limits the bandwidth and adds queueing delay
+    const Tick burst_delay = mem_intr->analyticBurstDelay();
+    const Tick bus_at = std::max(mem_intr->analyticBusFreeAt, curTick());
+    mem_intr->analyticBusFreeAt = bus_at + pkt_count * burst_delay;
+
+    DPRINTF(MemCtrl, "Analytic %s of %d bursts, bus queueing delay %d\n",
+            pkt->isRead() ? "read" : "write", pkt_count, bus_at - curTick());
+
+    if (pkt->isWrite()) {
+        // as in the detailed mode, writes complete once they are in the
+        // write buffer, but still take their share of the bandwidth
+        stats.analyticWriteReqs++;
+        stats.writeReqs++;
+        stats.bytesWrittenSys += size;
+        accessAndRespond(pkt, frontendLatency, mem_intr);
+    } else {
+        assert(pkt->isRead());
+        stats.analyticReadReqs++;
+        stats.readReqs++;
+        stats.bytesReadSys += size;
+        const Tick latency = (bus_at - curTick()) + frontendLatency +
+            mem_intr->analyticLatency(analyticRowHitRate) +
+            (pkt_count - 1) * burst_delay + backendLatency;
+        accessAndRespond(pkt, latency, mem_intr);
+    }
+}
+
+void
+MemCtrl::setAnalyticMode(bool analytic)
+{
+    if (analytic && !analyticMode) {
+        const double row_hit_rate = dram->rowHitRate();
+        if (row_hit_rate >= 0)
+            analyticRowHitRate = row_hit_rate;
+        DPRINTF(MemCtrl, "Switching to the analytic timing mode, "
+                "row hit rate %f\n", analyticRowHitRate);
+    } else if (!analytic && analyticMode) {
+        DPRINTF(MemCtrl, "Switching to the detailed timing mode\n");
+    }
+
+    analyticMode = analytic;
+}
+
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
                         MemPacketQueue& queue,
@@ -586,7 +650,8 @@ MemCtrl::chooseNext(MemPacketQueue& queue, Tick extra_col_delay,
                     break;
                 }
             }
-        } else if (memSchedPolicy == enums::frfcfs) {
+        } else if (memSchedPolicy == enums::frfcfs ||
+                   memSchedPolicy == enums::frfcfs_indexed) {
             Tick col_allowed_at;
             std::tie(ret, col_allowed_at)
                     = chooseNextFRFCFS(queue, extra_col_delay, mem_intr);
@@ -608,8 +673,13 @@ MemCtrl::chooseNextFRFCFS(MemPacketQueue& queue, Tick extra_col_delay,
     const Tick min_col_at = std::max(mem_intr->nextBurstAt + extra_col_delay,
                                     curTick());
 
-    std::tie(selected_pkt_it, col_allowed_at) =
+    if (memSchedPolicy == enums::frfcfs_indexed) {
+        std::tie(selected_pkt_it, col_allowed_at) =
+                 mem_intr->chooseNextFRFCFSIndexed(queue, min_col_at);
+    } else {
+        std::tie(selected_pkt_it, col_allowed_at) =
                  mem_intr->chooseNextFRFCFS(queue, min_col_at);
+    }
 
     if (selected_pkt_it == queue.end()) {
         DPRINTF(MemCtrl, "%s no available packets found\n", __func__);
@@ -1197,6 +1267,10 @@ MemCtrl::CtrlStats::CtrlStats(MemCtrl &_ctrl)
              "Number of controller read bursts serviced by the write queue"),
     ADD_STAT(mergedWrBursts, statistics::units::Count::get(),
              "Number of controller write bursts merged with an existing one"),
+    ADD_STAT(analyticReadReqs, statistics::units::Count::get(),
+             "Number of read requests serviced in the analytic mode"),
+    ADD_STAT(analyticWriteReqs, statistics::units::Count::get(),
+             "Number of write requests serviced in the analytic mode"),
 
     ADD_STAT(neitherReadNorWriteReqs, statistics::units::Count::get(),
              "Number of requests that are neither read nor write"),
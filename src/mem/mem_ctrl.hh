@@ -55,6 +55,7 @@
 #include "base/callback.hh"
 #include "base/statistics.hh"
 #include "enums/MemSched.hh"
+#include "mem/mem_packet_queue.hh"
 #include "mem/qos/mem_ctrl.hh"
 #include "mem/qport.hh"
 #include "params/MemCtrl.hh"
@@ -156,6 +157,9 @@ class MemPacket
      */
     uint8_t _qosValue;
 
+    /** Arrival order in the queue holding the packet */
+    uint64_t queueSeq;
+
     /**
      * Set the packet QoS value
      * (interface compatibility with Packet)
@@ -210,14 +214,14 @@ class MemPacket
           _requestorId(pkt->requestorId()),
           read(is_read), dram(is_dram), pseudoChannel(_channel), rank(_rank),
           bank(_bank), row(_row), bankId(bank_id), addr(_addr), size(_size),
-          burstHelper(NULL), _qosValue(_pkt->qosValue())
+          burstHelper(NULL), _qosValue(_pkt->qosValue()), queueSeq(0)
     { }
 
 };
 
 // The memory packets are store in a multiple dequeue structure,
 // based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+typedef IndexedPacketQueue<MemPacket> MemPacketQueue;
 
 
 /**
@@ -312,6 +316,17 @@ class MemCtrl : public qos::MemCtrl
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
 
+    /**
+     * Service a timing request in the analytic timing mode. The
+     * latency comes from a model of the interface rather than from
+     * the bank and rank state machines, and the only contention
+     * modelled is for the data bus.
+     *
+     * @param pkt The request to service
+     * @param mem_intr The memory interface the packet is sent to
+     */
+    void recvTimingReqAnalytic(PacketPtr pkt, MemInterface* mem_intr);
+
     /**
      * Check if the read queue has room for more entries
      *
@@ -489,7 +504,7 @@ class MemCtrl : public qos::MemCtrl
      * as sizing the read queue, this and the main read queue need to
      * be added together.
      */
-    std::deque<MemPacket*> respQueue;
+    MemPacketQueue respQueue;
 
     /**
      * Holds count of commands issued in burst window starting at
@@ -524,6 +539,16 @@ class MemCtrl : public qos::MemCtrl
      */
     enums::MemSched memSchedPolicy;
 
+    /**
+     * Are requests serviced in the analytic timing mode?
+     */
+    bool analyticMode;
+
+    /**
+     * Fraction of row hits assumed in the analytic timing mode
+     */
+    double analyticRowHitRate;
+
     /**
      * Pipeline latency of the controller frontend. The frontend
      * contribution is added to writes (that complete when they are in
@@ -574,6 +599,8 @@ class MemCtrl : public qos::MemCtrl
         statistics::Scalar writeBursts;
         statistics::Scalar servicedByWrQ;
         statistics::Scalar mergedWrBursts;
+        statistics::Scalar analyticReadReqs;
+        statistics::Scalar analyticWriteReqs;
         statistics::Scalar neitherReadNorWriteReqs;
         // Average queue lengths
         statistics::Average avgRdQLen;
@@ -686,6 +713,20 @@ class MemCtrl : public qos::MemCtrl
 
     DrainState drain() override;
 
+    /**
+     * Switch between the detailed and the analytic timing mode. This
+     * can be done at any time without draining: requests already in
+     * the queues are serviced by the detailed model, while new
+     * requests use the new mode. When switching to the analytic mode,
+     * the row hit rate is calibrated from the detailed model if it
+     * has serviced any bursts since the last stats reset.
+     *
+     * @param analytic true to use the analytic timing mode
+     */
+    void setAnalyticMode(bool analytic);
+
+    bool isAnalyticMode() const { return analyticMode; }
+
     /**
      * Check for command bus contention for single cycle command.
      * If there is contention, shift command to next burst.
@@ -189,6 +189,11 @@ class MemInterface : public AbstractMemory
     Tick nextBurstAt = 0;
     Tick nextReqTime = 0;
 
+    /**
+     * Till when is the data bus busy in the analytic timing mode?
+     */
+    Tick analyticBusFreeAt = 0;
+
     /**
      * Reads/writes performed by the controller for this interface before
      * bus direction is switched
@@ -267,11 +272,54 @@ class MemInterface : public AbstractMemory
     virtual std::pair<MemPacketQueue::iterator, Tick>
     chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const = 0;
 
+    /**
+     * For the indexed FR-FCFS policy, find the same command as
+     * chooseNextFRFCFS() using the bank/row index of the queue. By
+     * default, this falls back to searching the queue.
+     *
+     * @param queue Queued requests to consider
+     * @param min_col_at Minimum tick for 'seamless' issue
+     * @return an iterator to the selected packet, else queue.end()
+     * @return the tick when the packet selected will issue
+     */
+    virtual std::pair<MemPacketQueue::iterator, Tick>
+    chooseNextFRFCFSIndexed(MemPacketQueue& queue, Tick min_col_at) const
+    {
+        return chooseNextFRFCFS(queue, min_col_at);
+    }
+
     /*
      * Function to calulate unloaded latency
      */
     virtual Tick accessLatency() const = 0;
 
+    /**
+     * Latency of a read burst in the analytic timing mode, excluding
+     * the static controller latencies and any queueing on the bus.
+     *
+     * @param row_hit_rate Fraction of bursts expected to hit an open row
+     * @return the average latency of a read burst
+     */
+    virtual Tick
+    analyticLatency(double row_hit_rate) const
+    {
+        return accessLatency();
+    }
+
+    /**
+     * Fraction of the bursts serviced since the last stats reset that
+     * hit an open row, used to calibrate the analytic timing mode.
+     *
+     * @return the row hit rate, or a negative value if unknown
+     */
+    virtual double rowHitRate() const { return -1.0; }
+
+    /**
+     * @return time the data bus is busy with a burst in the analytic
+     * timing mode
+     */
+    virtual Tick analyticBurstDelay() const { return tBURST; }
+
     /**
      * @return number of bytes in a burst for this interface
      */
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the memory controller packet queues and the bank/row
+ * index used by the indexed FR-FCFS scheduler.
+ */
+
+#ifndef __MEM_MEM_PACKET_QUEUE_HH__
+#define __MEM_MEM_PACKET_QUEUE_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A queue of memory packets in arrival order. On top of the plain
+ * deque, the queue can keep an index of the queued DRAM packets per
+ * bank and row. This lets a scheduler find the oldest row hit or
+ * the oldest row miss in a bank without walking the whole queue.
+ *
+ * Packets must only be added with push_back() and removed with
+ * erase(), so that the index and the arrival order stay in sync.
+ *
+ * @tparam Entry Packet type, providing the decoded address fields of
+ *               a MemPacket and a queueSeq member owned by the queue.
+ */
+template <class Entry>
+class IndexedPacketQueue : public std::deque<Entry *>
+{
+  public:
+    using Base = std::deque<Entry *>;
+    using iterator = typename Base::iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    /** Queued packets to one bank, grouped by row */
+    class BankQueue
+    {
+      public:
+        uint8_t pseudoChannel = 0;
+        uint8_t rank = 0;
+        uint8_t bank = 0;
+        uint16_t bankId = 0;
+
+        /** @return the oldest packet to the row, or nullptr */
+        Entry *
+        oldestHit(uint32_t row) const
+        {
+            auto it = rows.find(row);
+            return it == rows.end() ? nullptr : it->second.begin()->second;
+        }
+
+        /** @return the oldest packet to any other row, or nullptr */
+        Entry *
+        oldestMiss(uint32_t row) const
+        {
+            // There is a single head per row, so at most two heads
+            // need to be checked.
+            for (auto it = heads.begin(); it != heads.end(); ++it) {
+                if (it->second->row != row)
+                    return it->second;
+            }
+            return nullptr;
+        }
+
+      private:
+        friend class IndexedPacketQueue;
+
+        void
+        add(Entry *e)
+        {
+            auto &row = rows[e->row];
+            if (row.empty())
+                heads.emplace(e->queueSeq, e);
+            row.emplace(e->queueSeq, e);
+        }
+
+        /** @return true if the bank has no more queued packets */
+        bool
+        remove(Entry *e)
+        {
+            auto it = rows.find(e->row);
+            assert(it != rows.end());
+            auto &row = it->second;
+            auto pkt_it = row.find(e->queueSeq);
+            assert(pkt_it != row.end() && pkt_it->second == e);
+            const bool head = pkt_it == row.begin();
+            row.erase(pkt_it);
+            if (head) {
+                heads.erase(e->queueSeq);
+                if (!row.empty())
+                    heads.emplace(*row.begin());
+            }
+            if (row.empty())
+                rows.erase(it);
+            return rows.empty();
+        }
+
+        /** Queued packets to each row, in arrival order */
+        std::unordered_map<uint32_t, std::map<uint64_t, Entry *>> rows;
+
+        /** The oldest queued packet to each row, in arrival order */
+        std::map<uint64_t, Entry *> heads;
+    };
+
+    void
+    push_back(Entry *e)
+    {
+        e->queueSeq = nextSeq++;
+        if (indexed && e->isDram())
+            bankQueue(e).add(e);
+        Base::push_back(e);
+    }
+
+    iterator
+    erase(const_iterator pos)
+    {
+        Entry *e = *pos;
+        if (indexed && e->isDram()) {
+            assert(e->pseudoChannel < bankQueues.size());
+            auto &pc_banks = bankQueues[e->pseudoChannel];
+            auto it = pc_banks.find(bankKey(e));
+            assert(it != pc_banks.end());
+            if (it->second.remove(e))
+                pc_banks.erase(it);
+        }
+        return Base::erase(pos);
+    }
+
+    void
+    clear()
+    {
+        for (auto &pc_banks : bankQueues)
+            pc_banks.clear();
+        Base::clear();
+    }
+
+    /**
+     * Enable or disable the bank/row index. This can only be done
+     * while the queue is empty.
+     */
+    void
+    setIndexed(bool enable)
+    {
+        assert(this->empty());
+        indexed = enable;
+    }
+
+    bool isIndexed() const { return indexed; }
+
+    /**
+     * Banks of one pseudo channel with queued DRAM packets, only
+     * populated when indexed.
+     */
+    const std::unordered_map<uint32_t, BankQueue> &
+    banks(uint8_t pseudo_channel) const
+    {
+        static const std::unordered_map<uint32_t, BankQueue> noBanks;
+        return pseudo_channel < bankQueues.size() ?
+            bankQueues[pseudo_channel] : noBanks;
+    }
+
+    /**
+     * Find a queued packet. The queue is sorted by arrival, so this
+     * is a binary search.
+     */
+    iterator
+    find(const Entry *e)
+    {
+        auto it = std::lower_bound(this->begin(), this->end(), e,
+            [](const Entry *a, const Entry *b) {
+                return a->queueSeq < b->queueSeq;
+            });
+        assert(it != this->end() && *it == e);
+        return it;
+    }
+
+  private:
+    static uint32_t
+    bankKey(const Entry *e)
+    {
+        return (uint32_t(e->rank) << 8) | e->bank;
+    }
+
+    BankQueue &
+    bankQueue(const Entry *e)
+    {
+        if (e->pseudoChannel >= bankQueues.size())
+            bankQueues.resize(e->pseudoChannel + 1);
+        auto &pc_banks = bankQueues[e->pseudoChannel];
+        auto it = pc_banks.find(bankKey(e));
+        if (it == pc_banks.end()) {
+            it = pc_banks.emplace(bankKey(e), BankQueue()).first;
+            it->second.pseudoChannel = e->pseudoChannel;
+            it->second.rank = e->rank;
+            it->second.bank = e->bank;
+            it->second.bankId = e->bankId;
+        }
+        return it->second;
+    }
+
+    /** Is the bank/row index maintained? */
+    bool indexed = false;
+
+    /** Arrival sequence number of the next packet */
+    uint64_t nextSeq = 0;
+
+    /**
+     * Queued banks of every pseudo channel, so that the scheduler of
+     * a pseudo channel never looks at the banks of the others.
+     */
+    std::vector<std::unordered_map<uint32_t, BankQueue>> bankQueues;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_MEM_PACKET_QUEUE_HH__
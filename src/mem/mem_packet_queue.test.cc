@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "mem/mem_packet_queue.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+/** Minimal stand-in for a MemPacket */
+struct TestPacket
+{
+    bool dram;
+    uint8_t pseudoChannel;
+    uint8_t rank;
+    uint8_t bank;
+    uint32_t row;
+    uint16_t bankId;
+    uint64_t queueSeq = 0;
+
+    bool isDram() const { return dram; }
+};
+
+using TestQueue = IndexedPacketQueue<TestPacket>;
+
+/** Oldest packet to the bank and row, by walking the queue */
+TestPacket *
+scanHit(const TestQueue &queue, const TestPacket &bank, uint32_t row)
+{
+    for (auto *p : queue) {
+        if (p->isDram() && p->pseudoChannel == bank.pseudoChannel &&
+            p->rank == bank.rank && p->bank == bank.bank && p->row == row) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+/** Oldest packet to the bank and another row, by walking the queue */
+TestPacket *
+scanMiss(const TestQueue &queue, const TestPacket &bank, uint32_t row)
+{
+    for (auto *p : queue) {
+        if (p->isDram() && p->pseudoChannel == bank.pseudoChannel &&
+            p->rank == bank.rank && p->bank == bank.bank && p->row != row) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+/** Check every indexed bank against a walk of the queue */
+void
+checkIndex(const TestQueue &queue, std::mt19937 &rng)
+{
+    size_t banks_with_pkts = 0;
+    for (uint8_t pc : { 0, 1 }) {
+        for (const auto &[key, bank_queue] : queue.banks(pc)) {
+            ASSERT_EQ(bank_queue.pseudoChannel, pc);
+            TestPacket bank{true, pc, bank_queue.rank, bank_queue.bank, 0,
+                            bank_queue.bankId};
+            for (int i = 0; i < 4; ++i) {
+                const uint32_t row = rng() % 8;
+                ASSERT_EQ(bank_queue.oldestHit(row),
+                          scanHit(queue, bank, row));
+                ASSERT_EQ(bank_queue.oldestMiss(row),
+                          scanMiss(queue, bank, row));
+            }
+            ASSERT_NE(bank_queue.oldestMiss(UINT32_MAX), nullptr);
+            ++banks_with_pkts;
+        }
+    }
+
+    // Every bank with a queued DRAM packet must be indexed
+    for (auto *p : queue) {
+        if (!p->isDram())
+            continue;
+        bool found = false;
+        for (const auto &[key, bank_queue] : queue.banks(p->pseudoChannel))
+            found |= bank_queue.rank == p->rank && bank_queue.bank == p->bank;
+        ASSERT_TRUE(found);
+    }
+    ASSERT_LE(banks_with_pkts, queue.size());
+}
+
+} // anonymous namespace
+
+/** The queue keeps arrival order and finds packets in it */
+TEST(IndexedPacketQueueTest, ArrivalOrder)
+{
+    std::vector<std::unique_ptr<TestPacket>> pkts;
+    TestQueue queue;
+    queue.setIndexed(true);
+    for (int i = 0; i < 16; ++i) {
+        pkts.emplace_back(new TestPacket{true, 0, 0, uint8_t(i % 4),
+                                         uint32_t(i % 3), uint16_t(i % 4)});
+        queue.push_back(pkts.back().get());
+    }
+
+    queue.erase(queue.find(pkts[5].get()));
+    queue.erase(queue.find(pkts[0].get()));
+    ASSERT_EQ(queue.size(), 14);
+    for (size_t i = 1; i < queue.size(); ++i)
+        ASSERT_LT(queue[i - 1]->queueSeq, queue[i]->queueSeq);
+    for (int i : { 1, 2, 7, 15 })
+        ASSERT_EQ(*queue.find(pkts[i].get()), pkts[i].get());
+
+    // Bank 1 has packets 1, 9, 13 to row 1, 0, 1
+    const auto &bank_queue = queue.banks(0).at(1);
+    EXPECT_EQ(bank_queue.oldestHit(1), pkts[1].get());
+    EXPECT_EQ(bank_queue.oldestHit(0), pkts[9].get());
+    EXPECT_EQ(bank_queue.oldestHit(2), nullptr);
+    EXPECT_EQ(bank_queue.oldestMiss(1), pkts[9].get());
+    EXPECT_EQ(bank_queue.oldestMiss(0), pkts[1].get());
+}
+
+/** Only DRAM packets are indexed, and only when the index is enabled */
+TEST(IndexedPacketQueueTest, Unindexed)
+{
+    TestPacket dram{true, 0, 0, 0, 0, 0};
+    TestPacket nvm{false, 0, 0, 0, 0, 0};
+
+    TestQueue queue;
+    queue.push_back(&dram);
+    EXPECT_TRUE(queue.banks(0).empty());
+    queue.erase(queue.begin());
+
+    queue.setIndexed(true);
+    queue.push_back(&nvm);
+    EXPECT_TRUE(queue.banks(0).empty());
+    queue.push_back(&dram);
+    EXPECT_EQ(queue.banks(0).size(), 1);
+
+    queue.erase(queue.begin());
+    queue.erase(queue.begin());
+    EXPECT_TRUE(queue.banks(0).empty());
+}
+
+/**
+ * Randomly add and remove packets, and move them between queues like
+ * QoS escalation does, checking the index against walks of the queues.
+ */
+TEST(IndexedPacketQueueTest, Random)
+{
+    std::mt19937 rng(7);
+    std::vector<std::unique_ptr<TestPacket>> pkts;
+    std::vector<TestQueue> queues(2);
+    for (auto &queue : queues)
+        queue.setIndexed(true);
+
+    for (int step = 0; step < 4000; ++step) {
+        TestQueue &queue = queues[rng() % 2];
+        const auto r = rng() % 10;
+        if (r < 5 || queue.empty()) {
+            const uint8_t rank = rng() % 2;
+            const uint8_t bank = rng() % 4;
+            pkts.emplace_back(new TestPacket{rng() % 8 != 0,
+                uint8_t(rng() % 2), rank, bank, uint32_t(rng() % 8),
+                uint16_t(rank * 4 + bank)});
+            queue.push_back(pkts.back().get());
+        } else if (r < 9) {
+            queue.erase(queue.begin() + rng() % queue.size());
+        } else {
+            auto it = queue.begin() + rng() % queue.size();
+            TestPacket *p = *it;
+            queue.erase(it);
+            queues[&queue == &queues[0]].push_back(p);
+        }
+        for (const auto &q : queues)
+            checkIndex(q, rng);
+    }
+}
+
+/**
+ * Escalate packets the way the QoS controller does, removing them from
+ * their queue before adding them to the other one, and then serve both
+ * queues through the index until they are empty.
+ */
+TEST(IndexedPacketQueueTest, EscalateThenServe)
+{
+    std::vector<std::unique_ptr<TestPacket>> pkts;
+    std::vector<TestQueue> queues(2);
+    for (auto &queue : queues)
+        queue.setIndexed(true);
+
+    for (int i = 0; i < 32; ++i) {
+        pkts.emplace_back(new TestPacket{true, 0, 0, uint8_t(i % 4),
+                                         uint32_t(i % 3), uint16_t(i % 4)});
+        queues[(i / 4) % 2].push_back(pkts.back().get());
+    }
+
+    // Escalate every packet to an odd bank from the low priority queue
+    auto it = queues[0].begin();
+    while (it != queues[0].end()) {
+        TestPacket *p = *it;
+        if (p->bank % 2) {
+            it = queues[0].erase(it);
+            queues[1].push_back(p);
+        } else {
+            ++it;
+        }
+    }
+
+    std::mt19937 rng(3);
+    checkIndex(queues[0], rng);
+    checkIndex(queues[1], rng);
+
+    // Serve the oldest row hit or miss of a bank until nothing is left
+    size_t served = 0;
+    for (auto &queue : queues) {
+        while (!queue.empty()) {
+            const auto &banks = queue.banks(0);
+            ASSERT_FALSE(banks.empty());
+            const auto &bank_queue = banks.begin()->second;
+            const uint32_t row = rng() % 3;
+            TestPacket *p = bank_queue.oldestHit(row);
+            if (!p)
+                p = bank_queue.oldestMiss(row);
+            ASSERT_NE(p, nullptr);
+            queue.erase(queue.find(p));
+            ++served;
+            checkIndex(queue, rng);
+        }
+        EXPECT_TRUE(queue.banks(0).empty());
+    }
+    EXPECT_EQ(served, pkts.size());
+}
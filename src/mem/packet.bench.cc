@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Allocating and freeing the requests and packets of memory accesses.
+ * Every cache miss creates a request and a packet with a cache line of
+ * data, which live until the response comes back, so the benchmarks
+ * keep a window of outstanding misses like a cache with a few MSHRs.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+
+// Requests record the tick they are created at
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+const unsigned lineSize = 64;
+
+PacketPtr
+makeMiss(Addr addr, bool write)
+{
+    RequestPtr req = Request::create(addr, lineSize, 0, 0);
+    PacketPtr pkt = new Packet(req, write ? MemCmd::WriteReq :
+                                            MemCmd::ReadReq);
+    pkt->allocate();
+    return pkt;
+}
+
+/**
+ * Replace the oldest outstanding miss every iteration. One access in
+ * three is a write. The argument is the number of outstanding misses.
+ */
+void
+BM_PacketAllocFree(benchmark::State &state)
+{
+    std::vector<PacketPtr> window(state.range(0));
+    Addr addr = 0;
+    for (auto &pkt : window) {
+        pkt = makeMiss(addr, false);
+        addr += lineSize;
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        delete window[i];
+        window[i] = makeMiss(addr, addr % (3 * lineSize) == 0);
+        addr += lineSize;
+        i = (i + 1) % window.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    for (auto pkt : window)
+        delete pkt;
+}
+BENCHMARK(BM_PacketAllocFree)->Arg(1)->Arg(16)->Arg(256);
+
+/** Turn a read request into its response and copy the line out. */
+void
+BM_PacketResponse(benchmark::State &state)
+{
+    uint8_t line[lineSize] = {};
+    uint8_t data[lineSize];
+    Addr addr = 0;
+    for (auto _ : state) {
+        PacketPtr pkt = makeMiss(addr, false);
+        pkt->makeResponse();
+        pkt->setData(line);
+        pkt->writeData(data);
+        benchmark::DoNotOptimize(data);
+        delete pkt;
+        addr += lineSize;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PacketResponse);
+
+} // anonymous namespace
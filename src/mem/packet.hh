@@ -58,6 +58,7 @@
 #include "base/extensible.hh"
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/pool_alloc.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
@@ -346,6 +347,10 @@ class Packet : public Printable, public Extensible<Packet>
         VALID_ADDR             = 0x00000100,
         VALID_SIZE             = 0x00000200,
 
+        /// The data is also carried by a packet forwarded on behalf of
+        /// this one, which writes its response data in place
+        LENT_DATA              = 0x00000800,
+
         /// Is the data pointer set to a value that shouldn't be freed
         /// when the packet is destroyed?
         STATIC_DATA            = 0x00001000,
@@ -353,6 +358,9 @@ class Packet : public Printable, public Extensible<Packet>
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data was allocated from the packet pool by
+        /// allocate() and is returned there rather than deleted
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -360,7 +368,11 @@ class Packet : public Printable, public Extensible<Packet>
 
         // Signal block present to squash prefetch and cache evict packets
         // through express snoop flag
-        BLOCK_CACHED          = 0x00010000
+        BLOCK_CACHED          = 0x00010000,
+
+        // Signal that the cache forwarding a request while bypassed
+        // holds the block's tags, for the snoop filters below
+        BLOCK_WARMED          = 0x00020000
     };
 
     Flags flags;
@@ -759,6 +771,9 @@ class Packet : public Printable, public Extensible<Packet>
     void setBlockCached()          { flags.set(BLOCK_CACHED); }
     bool isBlockCached() const     { return flags.isSet(BLOCK_CACHED); }
     void clearBlockCached()        { flags.clear(BLOCK_CACHED); }
+    void setBlockWarmed()          { flags.set(BLOCK_WARMED); }
+    bool isBlockWarmed() const     { return flags.isSet(BLOCK_WARMED); }
+    void clearBlockWarmed()        { flags.clear(BLOCK_WARMED); }
 
     /**
      * QoS Value getter
@@ -1054,6 +1069,22 @@ class Packet : public Printable, public Extensible<Packet>
         deleteData();
     }
 
+    /**
+     * Packets are allocated from the pool of the calling thread, as
+     * they are created and destroyed at a very high rate.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        return SizeClassPool::local().allocate(size);
+    }
+
+    static void
+    operator delete(void *p, size_t size)
+    {
+        SizeClassPool::local().deallocate(p, size);
+    }
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1295,7 +1326,8 @@ class Packet : public Printable, public Extensible<Packet>
         // we should never be copying data onto itself, which means we
         // must idenfity packets with static data, as they carry the
         // same pointer from source to destination and back
-        assert(p != getPtr<uint8_t>() || flags.isSet(STATIC_DATA));
+        assert(p != getPtr<uint8_t>() ||
+               flags.isSet(STATIC_DATA|LENT_DATA));
 
         if (p != getPtr<uint8_t>()) {
             // for packet with allocated dynamic data, we copy data from
@@ -1355,13 +1387,39 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA))
+            SizeClassPool::local().deallocate(data, getSize());
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA|LENT_DATA);
         data = NULL;
     }
 
+    /**
+     * Carry the data of the packet this one is forwarded on behalf of,
+     * rather than a buffer of its own. The response data is then
+     * written in place, and no copy is needed when the original packet
+     * is turned into a response. The original packet keeps ownership
+     * of the data and must outlive this one.
+     *
+     * @param orig The packet this one is forwarded for.
+     */
+    void
+    shareData(Packet *orig)
+    {
+        assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
+        assert(getSize() <= orig->getSize());
+
+        if (orig->flags.isSet(STATIC_DATA|DYNAMIC_DATA)) {
+            data = orig->data;
+            flags.set(STATIC_DATA);
+            orig->flags.set(LENT_DATA);
+        } else {
+            allocate();
+        }
+    }
+
     /** Allocate memory for the packet. */
     void
     allocate()
@@ -1370,8 +1428,9 @@ class Packet : public Printable, public Extensible<Packet>
         // payload, actually allocate space
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
-            flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            flags.set(DYNAMIC_DATA|POOLED_DATA);
+            data = static_cast<PacketDataPtr>(
+                SizeClassPool::local().allocate(getSize()));
         }
     }
 
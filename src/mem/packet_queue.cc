@@ -62,6 +62,25 @@ PacketQueue::~PacketQueue()
 {
 }
 
+PacketQueue::PacketQueueStats::PacketQueueStats(statistics::Group *parent,
+                                                const std::string &name)
+    : statistics::Group(parent, name.c_str()),
+      ADD_STAT(queued, statistics::units::Count::get(),
+               "Number of packets queued"),
+      ADD_STAT(outOfOrder, statistics::units::Count::get(),
+               "Number of packets queued in front of other packets"),
+      ADD_STAT(insertDepth, statistics::units::Count::get(),
+               "Number of packets a queued packet was placed in front of")
+{
+    insertDepth.init(16);
+}
+
+void
+PacketQueue::enableStats(statistics::Group *parent, const std::string &name)
+{
+    stats.reset(new PacketQueueStats(parent, name));
+}
+
 void
 PacketQueue::retry()
 {
@@ -76,8 +95,8 @@ PacketQueue::checkConflict(const PacketPtr pkt, const int blk_size) const
 {
     // caller is responsible for ensuring that all packets have the
     // same alignment
-    for (const auto& p : transmitList) {
-        if (p.pkt->matchBlockAddr(pkt, blk_size))
+    for (size_t i = 0; i < transmitList.size(); ++i) {
+        if (transmitList[i].pkt->matchBlockAddr(pkt, blk_size))
             return true;
     }
     return false;
@@ -88,14 +107,12 @@ PacketQueue::trySatisfyFunctional(PacketPtr pkt)
 {
     pkt->pushLabel(label);
 
-    auto i = transmitList.begin();
     bool found = false;
 
-    while (!found && i != transmitList.end()) {
+    for (size_t i = 0; !found && i < transmitList.size(); ++i) {
         // If the buffered packet contains data, and it overlaps the
         // current packet, then update data
-        found = pkt->trySatisfyFunctional(i->pkt);
-        ++i;
+        found = pkt->trySatisfyFunctional(transmitList[i].pkt);
     }
 
     pkt->popLabel();
@@ -131,24 +148,25 @@ PacketQueue::schedSendTiming(PacketPtr pkt, Tick when)
     // ourselves again before we had a chance to update waitingOnRetry
     // assert(waitingOnRetry || sendEvent.scheduled());
 
-    // this belongs in the middle somewhere, so search from the end to
     // order by tick; however, if forceOrder is set, also make sure
     // not to re-order in front of some existing packet with the same
     // address
-    auto it = transmitList.end();
-    while (it != transmitList.begin()) {
-        --it;
-        if ((forceOrder && it->pkt->matchAddr(pkt)) || it->tick <= when) {
-            // emplace inserts the element before the position pointed to by
-            // the iterator, so advance it one step
-            transmitList.emplace(++it, when, pkt);
-            return;
+    const size_t pos = transmitList.position(pkt, when, forceOrder);
+    const size_t depth = transmitList.size() - pos;
+    transmitList.insert(pos, DeferredPacket(when, pkt));
+
+    if (stats) {
+        ++stats->queued;
+        if (depth) {
+            ++stats->outOfOrder;
+            stats->insertDepth.sample(depth);
         }
     }
-    // either the packet list is empty or this has to be inserted
-    // before every other packet
-    transmitList.emplace_front(when, pkt);
-    schedSendEvent(when);
+
+    // if the packet is now the first one, the send event may have to
+    // happen earlier
+    if (pos == 0)
+        schedSendEvent(when);
 }
 
 void
@@ -201,7 +219,7 @@ PacketQueue::sendDeferredPacket()
     // (most notaly when responding to the timing CPU, leading to a
     // new request hitting in the L1 icache, leading to a new
     // response)
-    transmitList.pop_front();
+    transmitList.popFront();
 
     // use the appropriate implementation of sendTiming based on the
     // type of queue
@@ -213,7 +231,7 @@ PacketQueue::sendDeferredPacket()
         schedSendEvent(deferredPacketReadyTime());
     } else {
         // put the packet back at the front of the list
-        transmitList.emplace_front(dp);
+        transmitList.insert(0, dp);
     }
 }
 
@@ -49,8 +49,10 @@
  * for the flow control of the port.
  */
 
-#include <list>
+#include <memory>
 
+#include "base/statistics.hh"
+#include "mem/packet_ring.hh"
 #include "mem/port.hh"
 #include "sim/drain.hh"
 #include "sim/eventq.hh"
@@ -71,15 +73,31 @@ class PacketQueue : public Drainable
       public:
         Tick tick;      ///< The tick when the packet is ready to transmit
         PacketPtr pkt;  ///< Pointer to the packet to transmit
+        DeferredPacket() : tick(0), pkt(nullptr) {}
         DeferredPacket(Tick t, PacketPtr p)
             : tick(t), pkt(p)
         {}
     };
 
-    typedef std::list<DeferredPacket> DeferredPacketList;
+    /** The outgoing packets, ordered by the tick they are due at */
+    PacketRing<DeferredPacket> transmitList;
 
-    /** A list of outgoing packets. */
-    DeferredPacketList transmitList;
+    struct PacketQueueStats : public statistics::Group
+    {
+        PacketQueueStats(statistics::Group *parent, const std::string &name);
+
+        /** Number of packets queued */
+        statistics::Scalar queued;
+
+        /** Number of packets queued in front of other packets */
+        statistics::Scalar outOfOrder;
+
+        /** Number of packets a queued packet was placed in front of */
+        statistics::Histogram insertDepth;
+    };
+
+    /** Statistics of the queue, only if enabled by the owner */
+    std::unique_ptr<PacketQueueStats> stats;
 
     /** The manager which is used for the event queue */
     EventManager& em;
@@ -172,6 +190,16 @@ class PacketQueue : public Drainable
     Tick deferredPacketReadyTime() const
     { return transmitList.empty() ? MaxTick : transmitList.front().tick; }
 
+    /**
+     * Record statistics about the ordering of the packets in the queue.
+     * This is optional, as the owner has to provide a statistics group
+     * for the queue.
+     *
+     * @param parent Statistics group to add the group of the queue to
+     * @param name Name of the group of the queue
+     */
+    void enableStats(statistics::Group *parent, const std::string &name);
+
     /**
      * Check if a packet corresponding to the same address exists in the
      * queue.
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2012,2015,2018 ARM Limited
+ * All rights reserved.
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2006 The Regents of The University of Michigan
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the ring a PacketQueue keeps its deferred packets in.
+ */
+
+#ifndef __MEM_PACKET_RING_HH__
+#define __MEM_PACKET_RING_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Deferred packets ordered by the tick they are due at, in a ring whose
+ * size is a power of two. The slots are reused, so that queueing a
+ * packet does not allocate unless the ring has to grow, and the packets
+ * are contiguous, which keeps looking for a position and for conflicts
+ * cheap.
+ *
+ * @tparam Entry The deferred packet type, with a tick and a pkt member.
+ */
+template <class Entry>
+class PacketRing
+{
+  private:
+    /** The entries, only count of which from the head are valid */
+    std::vector<Entry> ring;
+
+    /** Position of the first entry in the ring */
+    size_t head = 0;
+
+    /** Number of entries in the ring */
+    size_t count = 0;
+
+    size_t slot(size_t i) const { return (head + i) & (ring.size() - 1); }
+
+  public:
+    PacketRing(size_t size=16)
+      : ring(size)
+    {
+        assert(isPowerOf2(size));
+    }
+
+    size_t size() const { return count; }
+
+    bool empty() const { return !count; }
+
+    /** Get the entry at a position from the head of the ring */
+    Entry &operator[](size_t i) { return ring[slot(i)]; }
+    const Entry &operator[](size_t i) const { return ring[slot(i)]; }
+
+    /** Insert an entry before the one at position pos */
+    void
+    insert(size_t pos, const Entry &entry)
+    {
+        assert(pos <= count);
+
+        if (count == ring.size()) {
+            // Grow the ring, and unwrap it on the way
+            std::vector<Entry> grown(ring.size() * 2);
+            for (size_t i = 0; i < count; ++i)
+                grown[i] = (*this)[i];
+            ring.swap(grown);
+            head = 0;
+        }
+
+        // Make room by moving whichever side of the position is shorter
+        if (pos < count / 2) {
+            head = (head - 1) & (ring.size() - 1);
+            for (size_t i = 0; i < pos; ++i)
+                (*this)[i] = (*this)[i + 1];
+        } else {
+            for (size_t i = count; i > pos; --i)
+                (*this)[i] = (*this)[i - 1];
+        }
+        (*this)[pos] = entry;
+        ++count;
+    }
+
+    Entry &front() { return (*this)[0]; }
+    const Entry &front() const { return (*this)[0]; }
+
+    /** Remove the first entry of the ring */
+    void
+    popFront()
+    {
+        assert(count);
+        head = (head + 1) & (ring.size() - 1);
+        --count;
+    }
+
+    /**
+     * Position at which a packet scheduled at a tick goes, after all the
+     * packets scheduled at the same tick or earlier. When force_order is
+     * set, also after all the packets to the same address.
+     */
+    template <class Packet>
+    size_t
+    position(const Packet &pkt, Tick when, bool force_order) const
+    {
+        // The common case is a packet going at the back of the queue
+        if (!count || (*this)[count - 1].tick <= when)
+            return count;
+
+        if (force_order) {
+            // The packets are not necessarily ordered by tick, as a
+            // packet can be queued behind a later one to the same
+            // address. Search from the end, as the original list did.
+            size_t pos = count;
+            while (pos) {
+                const Entry &entry = (*this)[pos - 1];
+                if (entry.pkt->matchAddr(pkt) || entry.tick <= when)
+                    break;
+                --pos;
+            }
+            return pos;
+        }
+
+        // Without force_order the ring is ordered by tick, find the first
+        // packet scheduled after the new one
+        size_t low = 0, high = count - 1;
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            if ((*this)[mid].tick <= when)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return low;
+    }
+};
+
+} // namespace gem5
+
+#endif // __MEM_PACKET_RING_HH__
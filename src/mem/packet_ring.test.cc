@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <list>
+#include <random>
+#include <vector>
+
+#include "mem/packet_ring.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Minimal stand-in for a Packet */
+struct TestPacket
+{
+    Addr addr;
+
+    bool matchAddr(const TestPacket *pkt) const { return addr == pkt->addr; }
+};
+
+struct TestEntry
+{
+    Tick tick = 0;
+    TestPacket *pkt = nullptr;
+};
+
+/** The PacketQueue insertion, as done on a std::list */
+void
+listInsert(std::list<TestEntry> &list, TestPacket *pkt, Tick when,
+           bool force_order)
+{
+    auto it = list.end();
+    while (it != list.begin()) {
+        --it;
+        if ((force_order && it->pkt->matchAddr(pkt)) || it->tick <= when) {
+            list.insert(++it, TestEntry{when, pkt});
+            return;
+        }
+    }
+    list.push_front(TestEntry{when, pkt});
+}
+
+/**
+ * Queue, send and retry random packets on a ring and on a list, and
+ * check that they hold the same packets in the same order.
+ */
+void
+checkOrder(bool force_order, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<TestPacket> pkts(4096);
+    PacketRing<TestEntry> ring;
+    std::list<TestEntry> list;
+    Tick now = 0;
+
+    for (auto &pkt : pkts) {
+        // Few addresses and close ticks, so that packets often go in
+        // front of others and behind packets to the same address
+        pkt.addr = rng() % 16;
+        const Tick when = now + rng() % 64;
+        const size_t pos = ring.position(&pkt, when, force_order);
+        ring.insert(pos, TestEntry{when, &pkt});
+        listInsert(list, &pkt, when, force_order);
+
+        // Send a few packets, putting some back as if they were
+        // refused and waiting for a retry
+        while (!ring.empty() && rng() % 3 == 0) {
+            ASSERT_EQ(ring.front().pkt, list.front().pkt);
+            now = std::max(now, ring.front().tick);
+            const TestEntry entry = ring.front();
+            ring.popFront();
+            list.pop_front();
+            if (rng() % 4 == 0) {
+                ring.insert(0, entry);
+                list.push_front(entry);
+                break;
+            }
+        }
+
+        ASSERT_EQ(ring.size(), list.size());
+        size_t i = 0;
+        for (const auto &entry : list) {
+            ASSERT_EQ(ring[i].pkt, entry.pkt);
+            ASSERT_EQ(ring[i].tick, entry.tick);
+            ++i;
+        }
+    }
+}
+
+} // anonymous namespace
+
+/** Without forced order, packets are ordered by tick only */
+TEST(PacketRingTest, Order)
+{
+    for (unsigned seed = 0; seed < 8; ++seed)
+        checkOrder(false, seed);
+}
+
+/** With forced order, packets also stay behind those to the same address */
+TEST(PacketRingTest, ForceOrder)
+{
+    for (unsigned seed = 0; seed < 8; ++seed)
+        checkOrder(true, seed);
+}
+
+/** Insertions on both sides of the position keep the ring contiguous */
+TEST(PacketRingTest, Wrap)
+{
+    PacketRing<TestEntry> ring(4);
+    std::vector<TestPacket> pkts(64);
+    std::list<TestEntry> list;
+    for (size_t i = 0; i < pkts.size(); ++i) {
+        if (i % 3 == 2) {
+            ring.popFront();
+            list.pop_front();
+        }
+        const size_t pos = i % 5 ? ring.size() : ring.size() / 4;
+        auto it = list.begin();
+        std::advance(it, pos);
+        ring.insert(pos, TestEntry{i, &pkts[i]});
+        list.insert(it, TestEntry{i, &pkts[i]});
+    }
+
+    ASSERT_EQ(ring.size(), list.size());
+    size_t i = 0;
+    for (const auto &entry : list)
+        EXPECT_EQ(ring[i++].pkt, entry.pkt);
+}
@@ -44,6 +44,90 @@
 namespace gem5
 {
 
+EmulationPageTable::PTableItr
+EmulationPageTable::findRange(Addr vaddr)
+{
+    auto it = pTable.upper_bound(vaddr);
+    if (it == pTable.begin())
+        return pTable.end();
+    --it;
+    if (vaddr - it->first < it->second.size)
+        return it;
+    return pTable.end();
+}
+
+void
+EmulationPageTable::splitAt(Addr vaddr)
+{
+    auto it = findRange(vaddr);
+    if (it == pTable.end() || it->first == vaddr)
+        return;
+
+    const Addr offset = vaddr - it->first;
+    const Range tail = { it->second.size - offset, it->second.paddr + offset,
+                         it->second.flags };
+    it->second.size = offset;
+    pTable.emplace_hint(std::next(it), vaddr, tail);
+}
+
+Addr
+EmulationPageTable::carve(Addr vaddr, Addr size,
+                          std::vector<std::pair<Addr, Range>> *removed)
+{
+    lastRange.size = 0;
+    splitAt(vaddr);
+    splitAt(vaddr + size);
+
+    Addr mapped = 0;
+    auto it = pTable.lower_bound(vaddr);
+    while (it != pTable.end() && it->first < vaddr + size) {
+        mapped += it->second.size;
+        if (removed)
+            removed->emplace_back(*it);
+        it = pTable.erase(it);
+    }
+    return mapped;
+}
+
+void
+EmulationPageTable::insertRange(Addr vaddr, const Range &range)
+{
+    auto contiguous = [](const PTable::value_type &a,
+                         const PTable::value_type &b) {
+        return a.first + a.second.size == b.first &&
+               a.second.paddr + a.second.size == b.second.paddr &&
+               a.second.flags == b.second.flags;
+    };
+
+    lastRange.size = 0;
+    auto it = pTable.emplace(vaddr, range).first;
+
+    auto next = std::next(it);
+    if (next != pTable.end() && contiguous(*it, *next)) {
+        it->second.size += next->second.size;
+        pTable.erase(next);
+    }
+
+    if (it != pTable.begin()) {
+        auto prev = std::prev(it);
+        if (contiguous(*prev, *it)) {
+            prev->second.size += it->second.size;
+            pTable.erase(it);
+        }
+    }
+}
+
+Addr
+EmulationPageTable::firstMapped(Addr vaddr, Addr size)
+{
+    if (findRange(vaddr) != pTable.end())
+        return vaddr;
+    auto it = pTable.lower_bound(vaddr);
+    if (it != pTable.end() && it->first < vaddr + size)
+        return it->first;
+    return MaxAddr;
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -53,22 +137,20 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
-
-        size -= _pageSize;
-        vaddr += _pageSize;
-        paddr += _pageSize;
+    if (size <= 0)
+        return;
+    const Addr bytes = roundUp(size, _pageSize);
+
+    if (clobber) {
+        carve(vaddr, bytes);
+    } else {
+        const Addr mapped = firstMapped(vaddr, bytes);
+        panic_if(mapped != MaxAddr,
+                 "EmulationPageTable::allocate: addr %#x already mapped",
+                 mapped);
     }
+
+    insertRange(vaddr, { bytes, paddr, flags });
 }
 
 void
@@ -80,24 +162,27 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
-    while (size > 0) {
-        [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
+    if (size <= 0)
+        return;
+    const Addr bytes = roundUp(size, _pageSize);
 
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-        new_vaddr += _pageSize;
-    }
+    // Take the old ranges out first so that the two regions may overlap
+    std::vector<std::pair<Addr, Range>> moved;
+    [[maybe_unused]] const Addr mapped = carve(vaddr, bytes, &moved);
+    assert(mapped == bytes);
+    assert(firstMapped(new_vaddr, bytes) == MaxAddr);
+
+    for (const auto &[start, range] : moved)
+        insertRange(new_vaddr + (start - vaddr), range);
 }
 
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    for (const auto &[vaddr, range] : pTable) {
+        for (Addr offset = 0; offset < range.size; offset += _pageSize)
+            addr_maps->emplace_back(vaddr + offset, range.paddr + offset);
+    }
 }
 
 void
@@ -107,13 +192,12 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-    }
+    if (size <= 0)
+        return;
+    const Addr bytes = roundUp(size, _pageSize);
+
+    [[maybe_unused]] const Addr mapped = carve(vaddr, bytes);
+    assert(mapped == bytes);
 }
 
 bool
@@ -122,21 +206,25 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
-    for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
-            return false;
-
-    return true;
+    if (size <= 0)
+        return true;
+    return firstMapped(vaddr, roundUp(size, _pageSize)) == MaxAddr;
 }
 
 const EmulationPageTable::Entry *
 EmulationPageTable::lookup(Addr vaddr)
 {
     Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+    if (page_addr - lastStart >= lastRange.size) {
+        PTableItr iter = findRange(page_addr);
+        if (iter == pTable.end())
+            return nullptr;
+        lastStart = iter->first;
+        lastRange = iter->second;
+    }
+    lookupEntry = Entry(lastRange.paddr + (page_addr - lastStart),
+                        lastRange.flags);
+    return &lookupEntry;
 }
 
 bool
@@ -189,12 +277,13 @@ EmulationPageTable::serialize(CheckpointOut &cp) const
     paramOut(cp, "size", pTable.size());
 
     PTable::size_type count = 0;
-    for (auto &pte : pTable) {
+    for (const auto &[vaddr, range] : pTable) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
 
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
+        paramOut(cp, "vaddr", vaddr);
+        paramOut(cp, "paddr", range.paddr);
+        paramOut(cp, "flags", range.flags);
+        paramOut(cp, "length", range.size);
     }
     assert(count == pTable.size());
 }
@@ -216,7 +305,12 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        // Older checkpoints have one entry per page and no length
+        Addr length;
+        if (!optParamIn(cp, "length", length, false))
+            length = _pageSize;
+
+        insertRange(vaddr, { length, paddr, flags });
     }
 }
 
@@ -224,8 +318,11 @@ const std::string
 EmulationPageTable::externalize() const
 {
     std::stringstream ss;
-    for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
-        ss << std::hex << it->first << ":" << it->second.paddr << ";";
+    for (const auto &[vaddr, range] : pTable) {
+        for (Addr offset = 0; offset < range.size; offset += _pageSize) {
+            ss << std::hex << vaddr + offset << ":" << range.paddr + offset
+               << ";";
+        }
     }
     return ss.str();
 }
@@ -35,8 +35,10 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <map>
 #include <string>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
@@ -63,10 +65,65 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
+    /**
+     * A contiguous run of virtual pages mapped to a contiguous run of
+     * physical pages with the same flags. Large mappings, such as the
+     * ones created by mmap or by huge 2MB/1GB regions, take a single
+     * range rather than one entry per page.
+     */
+    struct Range
+    {
+        Addr size;
+        Addr paddr;
+        uint64_t flags;
+    };
+
+    /** Non-overlapping ranges keyed by their starting virtual address. */
+    typedef std::map<Addr, Range> PTable;
     typedef PTable::iterator PTableItr;
     PTable pTable;
 
+    /**
+     * The last range a lookup hit in. It is a copy rather than an
+     * iterator so that it survives copies of the page table, and is
+     * invalidated by setting its size to 0 whenever pTable changes.
+     */
+    Addr lastStart = 0;
+    Range lastRange = {0, 0, 0};
+
+    /** Storage for the entry returned by lookup(). */
+    Entry lookupEntry;
+
+    /** Find the range containing vaddr, or pTable.end(). */
+    PTableItr findRange(Addr vaddr);
+
+    /**
+     * Split the range containing vaddr, if any, so that a range starts
+     * at vaddr.
+     */
+    void splitAt(Addr vaddr);
+
+    /**
+     * Remove all mappings in a region, splitting the ranges that
+     * straddle its boundaries.
+     * @param removed If not null, the removed ranges are appended to it.
+     * @return The number of bytes that were mapped in the region.
+     */
+    Addr carve(Addr vaddr, Addr size,
+               std::vector<std::pair<Addr, Range>> *removed = nullptr);
+
+    /**
+     * Insert a range into an unmapped region, merging it with its
+     * neighbours when they are contiguous and have the same flags.
+     */
+    void insertRange(Addr vaddr, const Range &range);
+
+    /**
+     * @return The lowest mapped address in a region, or MaxAddr if
+     * nothing in it is mapped.
+     */
+    Addr firstMapped(Addr vaddr, Addr size);
+
     const Addr _pageSize;
     const Addr offsetMask;
 
@@ -137,7 +194,9 @@ class EmulationPageTable : public Serializable
     /**
      * Lookup function
      * @param vaddr The virtual address.
-     * @return The page table entry corresponding to vaddr.
+     * @return The page table entry of the page containing vaddr. The
+     *         entry is only valid until the next call to lookup or until
+     *         the page table is modified.
      */
     const Entry *lookup(Addr vaddr);
 
@@ -189,11 +248,12 @@ class EmulationPageTable : public Serializable
     Fault translate(const RequestPtr &req);
 
     /**
-     * Dump all items in the pTable, to a concatenation of strings of the form
+     * Dump all mapped pages, to a concatenation of strings of the form
      *    Addr:Entry;
      */
     const std::string externalize() const;
 
+    /** Append the virtual and physical address of every mapped page. */
     void getMappings(std::vector<std::pair<Addr, Addr>> *addr_mappings);
 
     void serialize(CheckpointOut &cp) const override;
@@ -39,18 +39,24 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #include "base/intmath.hh"
+#include "base/parallel_gzip.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
@@ -80,11 +86,23 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               bool checkpoint_delta,
+                               uint64_t checkpoint_chunk_size,
+                               unsigned checkpoint_threads,
+                               bool checkpoint_compress) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), checkpointDelta(checkpoint_delta),
+    checkpointChunkSize(checkpoint_chunk_size),
+    checkpointThreads(std::max(checkpoint_threads, 1u)),
+    checkpointCompress(checkpoint_compress)
 {
+    fatal_if(checkpointChunkSize == 0 ||
+             checkpointChunkSize % sizeof(long) != 0,
+             "Checkpoint chunk size must be a non-zero multiple of %d\n",
+             sizeof(long));
+
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
         registerExitCallback([=]() { shm_unlink(shared_backstore.c_str()); });
@@ -131,6 +149,9 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
         }
     }
 
+    // the address map is never modified after this point
+    addrMap.freeze();
+
     // iterate over the increasing addresses and chunks of contiguous
     // space to be mapped to backing store, create it and inform the
     // memories
@@ -275,6 +296,77 @@ PhysicalMemory::isMemAddr(Addr addr) const
     return addrMap.contains(addr) != addrMap.end();
 }
 
+const BackingStoreEntry *
+PhysicalMemory::findBackingStore(Addr addr, Addr size) const
+{
+    for (const auto &s : backingStore) {
+        if (s.inAddrMap && addr >= s.range.start() &&
+            size <= s.range.end() - addr) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+bool
+PhysicalMemory::loadBlob(Addr addr, const uint8_t *data, Addr size)
+{
+    const BackingStoreEntry *store = findBackingStore(addr, size);
+    if (!store)
+        return false;
+
+    uint8_t *host = store->pmem + (addr - store->range.start());
+    if (data)
+        std::memcpy(host, data, size);
+    else
+        std::memset(host, 0, size);
+    return true;
+}
+
+bool
+PhysicalMemory::loadFile(Addr addr, int fd, off_t offset,
+                         const uint8_t *data, Addr size)
+{
+    const BackingStoreEntry *store = findBackingStore(addr, size);
+    if (!store)
+        return false;
+
+    uint8_t *host = store->pmem + (addr - store->range.start());
+
+    // Only private anonymous stores can be remapped, and only if the
+    // host and file offsets of a page are aligned the same.
+    const Addr host_page = sysconf(_SC_PAGESIZE);
+    const Addr host_addr = reinterpret_cast<uintptr_t>(host);
+    const Addr head = roundUp(host_addr, host_page) - host_addr;
+    Addr body = 0;
+    if (store->shmFd == -1 && fd >= 0 &&
+        (host_addr - offset) % host_page == 0 && head < size) {
+        body = roundDown(size - head, host_page);
+    }
+
+    if (body) {
+        void *p = mmap(host + head, body, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_FIXED, fd, offset + head);
+        if (p == MAP_FAILED) {
+            warn("Failed to map %d bytes of image data at %#x, "
+                 "copying instead.\n", body, addr + head);
+            body = 0;
+        } else {
+            DPRINTF(AddrRanges, "Mapped %d bytes of image data at %#x\n",
+                    body, addr + head);
+        }
+    }
+
+    if (!body) {
+        std::memcpy(host, data, size);
+    } else {
+        std::memcpy(host, data, head);
+        std::memcpy(host + head + body, data + head + body,
+                    size - head - body);
+    }
+    return true;
+}
+
 AddrRangeList
 PhysicalMemory::getConfAddrRanges() const
 {
@@ -357,6 +449,41 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
         serializeStore(cp, store_id++, s.range, s.pmem);
     }
+
+    // the next delta checkpoint refers to this one
+    if (checkpointDelta)
+        baseCheckpoint = CheckpointIn::dir();
+}
+
+std::vector<Sha256::Digest>
+PhysicalMemory::hashStore(const BackingStoreEntry &store) const
+{
+    const uint64_t store_size = store.range.size();
+    const uint64_t nbr_of_chunks = divCeil(store_size, checkpointChunkSize);
+    std::vector<Sha256::Digest> hashes(nbr_of_chunks);
+
+    // hashing is bound by memory bandwidth, so spread it over the
+    // same threads used for compression
+    auto hash_range = [&](uint64_t first, uint64_t last) {
+        for (uint64_t i = first; i < last; ++i) {
+            const uint64_t offset = i * checkpointChunkSize;
+            hashes[i] = Sha256::digest(store.pmem + offset,
+                std::min(checkpointChunkSize, store_size - offset));
+        }
+    };
+
+    const uint64_t per_thread = divCeil(nbr_of_chunks, checkpointThreads);
+    std::vector<std::thread> workers;
+    for (uint64_t first = per_thread; first < nbr_of_chunks;
+         first += per_thread) {
+        workers.emplace_back(hash_range, first,
+                             std::min(first + per_thread, nbr_of_chunks));
+    }
+    hash_range(0, std::min(per_thread, nbr_of_chunks));
+    for (auto &worker : workers)
+        worker.join();
+
+    return hashes;
 }
 
 void
@@ -369,41 +496,166 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
         name() + ".store" + std::to_string(store_id) + ".pmem";
     long range_size = range.size();
 
-    DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
-            filename, range_size);
-
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
 
+    std::vector<Sha256::Digest> hashes;
+    if (checkpointDelta) {
+        hashes = hashStore(backingStore[store_id]);
+        chunkHashes.resize(backingStore.size());
+    }
+    const bool delta = checkpointDelta && !baseCheckpoint.empty() &&
+        chunkHashes[store_id].size() == hashes.size();
+
     // write memory file
     std::string filepath = CheckpointIn::dir() + "/" + filename.c_str();
-    gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
-    if (compressed_mem == NULL)
+    if (!delta && !checkpointCompress) {
+        DPRINTF(Checkpoint, "Serializing uncompressed physical memory %s "
+                "with size %d\n", filename, range_size);
+
+        bool compressed = false;
+        SERIALIZE_SCALAR(compressed);
+        serializeRaw(filepath, filename, pmem, range.size());
+        if (checkpointDelta)
+            chunkHashes[store_id].swap(hashes);
+        return;
+    }
+
+    ParallelGzipWriter compressed_mem(filepath, checkpointThreads);
+    if (!compressed_mem.good())
         fatal("Can't open physical memory checkpoint file '%s'\n",
               filename);
 
-    uint64_t pass_size = 0;
+    if (delta) {
+        // refer to the parent relative to this checkpoint, so that a
+        // set of checkpoints can be moved around together
+        std::string delta_parent = std::filesystem::relative(
+            baseCheckpoint, CheckpointIn::dir()).string();
+        uint64_t chunk_size = checkpointChunkSize;
+
+        // runs of changed chunks, as pairs of first chunk and length
+        std::vector<uint64_t> delta_runs;
+        uint64_t changed = 0;
+        for (uint64_t i = 0; i < hashes.size(); ++i) {
+            if (hashes[i] == chunkHashes[store_id][i])
+                continue;
+            const uint64_t offset = i * checkpointChunkSize;
+            const uint64_t len =
+                std::min(checkpointChunkSize, range.size() - offset);
+            if (!compressed_mem.write(pmem + offset, len))
+                break;
+            if (!delta_runs.empty() &&
+                delta_runs[delta_runs.size() - 2] +
+                    delta_runs.back() == i) {
+                ++delta_runs.back();
+            } else {
+                delta_runs.push_back(i);
+                delta_runs.push_back(1);
+            }
+            ++changed;
+        }
 
-    // gzwrite fails if (int)len < 0 (gzwrite returns int)
-    for (uint64_t written = 0; written < range.size();
-         written += pass_size) {
-        pass_size = (uint64_t)INT_MAX < (range.size() - written) ?
-            (uint64_t)INT_MAX : (range.size() - written);
+        DPRINTF(Checkpoint, "Serializing %d of %d chunks of physical "
+                "memory %s as a delta of %s\n", changed, hashes.size(),
+                filename, delta_parent);
 
-        if (gzwrite(compressed_mem, pmem + written,
-                    (unsigned int) pass_size) != (int) pass_size) {
-            fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
-        }
+        SERIALIZE_SCALAR(delta_parent);
+        SERIALIZE_SCALAR(chunk_size);
+        SERIALIZE_CONTAINER(delta_runs);
+    } else {
+        DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
+                filename, range_size);
+
+        compressed_mem.write(pmem, range.size());
     }
 
-    // close the compressed stream and check that the exit status
-    // is zero
-    if (gzclose(compressed_mem))
+    if (!compressed_mem.close())
+        fatal("Write failed on physical memory checkpoint file '%s'\n",
+              filename);
+
+    // the size of every gzip member lets a restore inflate them in
+    // parallel; deltas are small and only ever read sequentially
+    if (!delta) {
+        uint64_t gzip_segment_size = compressed_mem.segmentSize();
+        const std::vector<uint64_t> &gzip_members = compressed_mem.members();
+        SERIALIZE_SCALAR(gzip_segment_size);
+        SERIALIZE_CONTAINER(gzip_members);
+    }
+
+    if (checkpointDelta)
+        chunkHashes[store_id].swap(hashes);
+}
+
+void
+PhysicalMemory::serializeRaw(const std::string &filepath,
+                             const std::string &filename,
+                             const uint8_t *pmem, uint64_t size) const
+{
+    int fd = open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0664);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filename);
+
+    for (uint64_t written = 0; written < size;) {
+        const ssize_t ret = ::write(fd, pmem + written,
+                                    std::min<uint64_t>(size - written,
+                                                       INT_MAX));
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            fatal("Write failed on physical memory checkpoint file "
+                  "'%s'\n", filename);
+        written += ret;
+    }
+
+    if (::close(fd) != 0)
         fatal("Close failed on physical memory checkpoint file '%s'\n",
               filename);
+}
+
+void
+PhysicalMemory::unserializeRaw(const std::string &filepath,
+                               const std::string &filename,
+                               uint8_t *pmem, uint64_t size)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd == -1)
+        fatal("Can't open physical memory checkpoint file '%s'\n",
+              filename);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uint64_t)st.st_size != size)
+        fatal("Physical memory checkpoint file '%s' has the wrong size\n",
+              filename);
 
+    // Map the file copy-on-write over the backing store so that pages
+    // are only read when the guest touches them. This isn't possible
+    // when the backing store is shared with another process, as the
+    // other process would not see the mapping.
+    if (sharedBackstore.empty() && size % pageSize == 0 &&
+        (uintptr_t)pmem % pageSize == 0) {
+        void *map = mmap(pmem, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_FIXED, fd, 0);
+        if (map != MAP_FAILED) {
+            ::close(fd);
+            return;
+        }
+        warn("Could not map physical memory checkpoint file '%s', "
+             "reading it instead\n", filename);
+    }
+
+    for (uint64_t done = 0; done < size;) {
+        const ssize_t ret = ::read(fd, pmem + done,
+                                   std::min<uint64_t>(size - done, INT_MAX));
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            fatal("Read failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        done += ret;
+    }
+    ::close(fd);
 }
 
 void
@@ -429,6 +681,13 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
         unserializeStore(cp);
     }
 
+    // the next delta checkpoint refers to the restored one
+    if (checkpointDelta) {
+        baseCheckpoint = cp.getCptDir();
+        chunkHashes.clear();
+        for (const auto &store : backingStore)
+            chunkHashes.push_back(hashStore(store));
+    }
 }
 
 void
@@ -443,11 +702,6 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
-
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
     AddrRange range = backingStore[store_id].range;
@@ -455,13 +709,52 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     long range_size;
     UNSERIALIZE_SCALAR(range_size);
 
-    DPRINTF(Checkpoint, "Unserializing physical memory %s with size %d\n",
-            filename, range_size);
-
     if (range_size != range.size())
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    std::string delta_parent;
+    if (UNSERIALIZE_OPT_SCALAR(delta_parent)) {
+        unserializeDelta(cp, filename, pmem, range);
+        return;
+    }
+
+    bool compressed = true;
+    UNSERIALIZE_OPT_SCALAR(compressed);
+    if (!compressed) {
+        DPRINTF(Checkpoint, "Mapping uncompressed physical memory %s with "
+                "size %d\n", filename, range_size);
+        unserializeRaw(filepath, filename, pmem, range.size());
+        return;
+    }
+
+    DPRINTF(Checkpoint, "Unserializing physical memory %s with size %d\n",
+            filename, range_size);
+
+    uint64_t gzip_segment_size;
+    if (optParamIn(cp, "gzip_segment_size", gzip_segment_size, false)) {
+        std::vector<uint64_t> gzip_members;
+        UNSERIALIZE_CONTAINER(gzip_members);
+
+        ParallelGzipReader compressed_mem(filepath, checkpointThreads);
+        if (!compressed_mem.good())
+            fatal("Can't open physical memory checkpoint file '%s'",
+                  filename);
+        // Only copy words that are non-zero, so we don't give the VM
+        // system hell
+        if (!compressed_mem.read(gzip_members, gzip_segment_size, pmem,
+                                 range.size(), true)) {
+            fatal("Read failed on physical memory checkpoint file '%s'\n",
+                  filename);
+        }
+        return;
+    }
+
+    // mmap memoryfile
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -491,5 +784,67 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
               filename);
 }
 
+void
+PhysicalMemory::unserializeDelta(CheckpointIn &cp,
+                                 const std::string &filename,
+                                 uint8_t *pmem, AddrRange range)
+{
+    std::string delta_parent;
+    uint64_t chunk_size;
+    std::vector<uint64_t> delta_runs;
+    UNSERIALIZE_SCALAR(delta_parent);
+    UNSERIALIZE_SCALAR(chunk_size);
+    UNSERIALIZE_CONTAINER(delta_runs);
+
+    fatal_if(delta_runs.size() % 2 != 0,
+             "Malformed delta for physical memory checkpoint file '%s'\n",
+             filename);
+
+    std::filesystem::path parent_dir(delta_parent);
+    if (parent_dir.is_relative())
+        parent_dir = std::filesystem::path(cp.getCptDir()) / parent_dir;
+
+    DPRINTF(Checkpoint, "Unserializing physical memory %s as a delta of "
+            "%s\n", filename, parent_dir.string());
+
+    // restore everything the delta doesn't cover from its parent,
+    // which is found in the same section of the parent checkpoint;
+    // opening a checkpoint changes the current checkpoint directory
+    const std::string cpt_dir = CheckpointIn::dir();
+    {
+        CheckpointIn parent(parent_dir.string());
+        unserializeStore(parent);
+    }
+    CheckpointIn::setDir(cpt_dir);
+
+    std::string filepath = cp.getCptDir() + "/" + filename;
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filename);
+
+    // unlike a full restore, zeros must be copied too as they may
+    // overwrite data from the parent
+    for (size_t i = 0; i < delta_runs.size(); i += 2) {
+        const uint64_t offset = delta_runs[i] * chunk_size;
+        fatal_if(offset >= range.size(),
+                 "Delta chunk outside of physical memory checkpoint file "
+                 "'%s'\n", filename);
+        uint64_t len = std::min(delta_runs[i + 1] * chunk_size,
+                                range.size() - offset);
+        for (uint8_t *pos = pmem + offset; len > 0;) {
+            const unsigned pass_size = std::min<uint64_t>(len, INT_MAX);
+            if (gzread(compressed_mem, pos, pass_size) != (int)pass_size)
+                fatal("Read failed on physical memory checkpoint file "
+                      "'%s'\n", filename);
+            pos += pass_size;
+            len -= pass_size;
+        }
+    }
+
+    if (gzclose(compressed_mem))
+        fatal("Close failed on physical memory checkpoint file '%s'\n",
+              filename);
+}
+
 } // namespace memory
 } // namespace gem5
@@ -44,6 +44,7 @@
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "base/sha256.hh"
 #include "mem/packet.hh"
 #include "sim/serialize.hh"
 
@@ -162,6 +163,65 @@ class PhysicalMemory : public Serializable
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // Only write the chunks that changed since the last checkpoint
+    // taken or restored, and reference that checkpoint for the rest
+    const bool checkpointDelta;
+
+    // Granularity at which changes are tracked for delta checkpoints
+    const uint64_t checkpointChunkSize;
+
+    // Number of host threads used to compress checkpointed memory and
+    // to decompress it on restore
+    const unsigned checkpointThreads;
+
+    // Whether full stores are compressed; uncompressed stores can be
+    // mapped on restore rather than read
+    const bool checkpointCompress;
+
+    // Directory of the checkpoint that the next delta refers to, and
+    // the SHA-256 digest of each chunk of each store in it
+    mutable std::string baseCheckpoint;
+    mutable std::vector<std::vector<Sha256::Digest>> chunkHashes;
+
+    /**
+     * Hash every checkpoint chunk of a backing store. A delta checkpoint
+     * leaves out the chunks whose digest didn't change, so the digest
+     * must be a cryptographic one: a collision would silently restore
+     * stale memory contents.
+     */
+    std::vector<Sha256::Digest>
+    hashStore(const BackingStoreEntry &store) const;
+
+    /**
+     * Find the backing store holding a range of the global address map.
+     *
+     * @return The store or nullptr if there is no single one
+     */
+    const BackingStoreEntry *findBackingStore(Addr addr, Addr size) const;
+
+    /**
+     * Write a store as an uncompressed image of its memory.
+     */
+    void serializeRaw(const std::string &filepath,
+                      const std::string &filename,
+                      const uint8_t *pmem, uint64_t size) const;
+
+    /**
+     * Restore an uncompressed store. Where possible, the file is
+     * mapped copy-on-write over the backing store so that only the
+     * pages the simulation touches are ever read.
+     */
+    void unserializeRaw(const std::string &filepath,
+                        const std::string &filename,
+                        uint8_t *pmem, uint64_t size);
+
+    /**
+     * Restore the chunks written to a delta checkpoint on top of the
+     * contents of its parent.
+     */
+    void unserializeDelta(CheckpointIn &cp, const std::string &filename,
+                          uint8_t *pmem, AddrRange range);
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -191,7 +251,11 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   bool checkpoint_delta=false,
+                   uint64_t checkpoint_chunk_size=1024 * 1024,
+                   unsigned checkpoint_threads=1,
+                   bool checkpoint_compress=true);
 
     /**
      * Unmap all the backing store we have used.
@@ -213,6 +277,35 @@ class PhysicalMemory : public Serializable
      */
     bool isMemAddr(Addr addr) const;
 
+    /**
+     * Write data straight into the backing store, bypassing the memory
+     * system. This is only meant for loading workload images before
+     * the simulation starts, when no cache can hold any of the data.
+     *
+     * @param addr Start of the range in the global address map
+     * @param data Data to write, or nullptr to zero the range
+     * @param size Size of the range in bytes
+     * @return False if the range is not within a single backing store
+     */
+    bool loadBlob(Addr addr, const uint8_t *data, Addr size);
+
+    /**
+     * Like loadBlob, but for data read from a file. Where the alignment
+     * allows it, the host pages of the file are privately mapped over
+     * the backing store, so that they are only read when first touched
+     * and never copied unless written to.
+     *
+     * @param addr Start of the range in the global address map
+     * @param fd Descriptor of the file holding the data
+     * @param offset Offset of the data in the file
+     * @param data Host mapping of the same data, used for any part that
+     *             cannot be mapped
+     * @param size Size of the range in bytes
+     * @return False if the range is not within a single backing store
+     */
+    bool loadFile(Addr addr, int fd, off_t offset, const uint8_t *data,
+                  Addr size);
+
     /**
      * Get the memory ranges for all memories that are to be reported
      * to the configuration table. The ranges are merged before they
@@ -223,6 +316,16 @@ class PhysicalMemory : public Serializable
      */
     AddrRangeList getConfAddrRanges() const;
 
+    /**
+     * Get all the memories, including the ones not in the global
+     * address map.
+     */
+    const std::vector<AbstractMemory*> &
+    getMemories() const
+    {
+        return memories;
+    }
+
     /**
      * Get the total physical memory size.
      *
@@ -275,7 +378,9 @@ class PhysicalMemory : public Serializable
     void serialize(CheckpointOut &cp) const override;
 
     /**
-     * Serialize a specific store.
+     * Serialize a specific store. With delta checkpoints enabled and
+     * a previous checkpoint to refer to, only the chunks of the store
+     * that changed since that checkpoint are written.
      *
      * @param store_id Unique identifier of this backing store
      * @param range The address range of this backing store
@@ -292,7 +397,9 @@ class PhysicalMemory : public Serializable
     void unserialize(CheckpointIn &cp) override;
 
     /**
-     * Unserialize a specific backing store, identified by a section.
+     * Unserialize a specific backing store, identified by a
+     * section. A delta checkpoint first restores the store from its
+     * parent checkpoint, recursively.
      */
     void unserializeStore(CheckpointIn &cp);
 
@@ -153,6 +153,7 @@ RequestPort::bind(Port &peer)
              name(), peer.name());
     // request port keeps track of the response port
     _responsePort = response_port;
+    _timingReqHandler = response_port->timingReqHandler;
     Port::bind(peer);
     // response port also keeps track of request port
     _responsePort->responderBind(*this);
@@ -165,6 +166,7 @@ RequestPort::unbind()
     "not bound.", name());
     _responsePort->responderUnbind();
     _responsePort = &defaultResponsePort;
+    _timingReqHandler = nullptr;
     Port::unbind();
 }
 
@@ -177,7 +179,7 @@ RequestPort::getAddrRanges() const
 void
 RequestPort::printAddr(Addr a)
 {
-    auto req = std::make_shared<Request>(
+    auto req = Request::create(
         a, 1, 0, Request::funcRequestorId);
 
     Packet pkt(req, MemCmd::PrintReq);
@@ -248,6 +250,7 @@ void
 ResponsePort::responderUnbind()
 {
     _requestPort = &defaultRequestPort;
+    _timingRespHandler = nullptr;
     Port::unbind();
 }
 
@@ -255,6 +258,7 @@ void
 ResponsePort::responderBind(RequestPort& request_port)
 {
     _requestPort = &request_port;
+    _timingRespHandler = request_port.timingRespHandler;
     Port::bind(request_port);
 }
 
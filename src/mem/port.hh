@@ -52,6 +52,7 @@
 #include <string>
 
 #include "base/addr_range.hh"
+#include "debug/PortTrace.hh"
 #include "mem/packet.hh"
 #include "mem/protocol/atomic.hh"
 #include "mem/protocol/functional.hh"
@@ -67,8 +68,18 @@ class SimObject;
 class MasterPort;
 class SlavePort;
 
+class RequestPort;
 class ResponsePort;
 
+/**
+ * Functions receiving timing requests or responses in place of the
+ * virtual recvTimingReq and recvTimingResp of a port, see
+ * ResponsePort::setTimingReqHandler() and
+ * RequestPort::setTimingRespHandler().
+ */
+typedef bool (*TimingReqHandler)(ResponsePort &port, PacketPtr pkt);
+typedef bool (*TimingRespHandler)(RequestPort &port, PacketPtr pkt);
+
 /**
  * TracingExtension is an Extension of the Packet for recording the trace
  * of the Packet. The stack in the TracingExtension holds the name of the
@@ -139,9 +150,36 @@ class RequestPort: public Port, public AtomicRequestProtocol,
   private:
     ResponsePort *_responsePort;
 
+    /** Direct handler of the response port, if it has one */
+    TimingReqHandler _timingReqHandler = nullptr;
+
+    /** Direct handler for the responses sent to this port, if any */
+    TimingRespHandler timingRespHandler = nullptr;
+
   protected:
     SimObject &owner;
 
+    /**
+     * Let the response port bound to this port deliver timing responses
+     * by calling a function directly, instead of going through the
+     * timing protocol and the virtual recvTimingResp. This saves an
+     * indirect call on every response between ports that are bound
+     * once and for all, like a CPU and its L1 caches.
+     *
+     * The handler must behave exactly like recvTimingResp. It is
+     * typically a static function of a final port class which calls
+     * recvTimingResp non-virtually. It only takes effect for bindings
+     * made after it is set, and the regular protocol is still used
+     * while packets are traced by the PortTrace debug flag.
+     *
+     * @param handler Function receiving the timing responses.
+     */
+    void
+    setTimingRespHandler(TimingRespHandler handler)
+    {
+        timingRespHandler = handler;
+    }
+
   public:
     [[deprecated("RequestPort ownership is deprecated. "
                  "Owner should now be registered in derived classes.")]]
@@ -352,11 +390,31 @@ class ResponsePort : public Port, public AtomicResponseProtocol,
   private:
     RequestPort* _requestPort;
 
+    /** Direct handler of the request port, if it has one */
+    TimingRespHandler _timingRespHandler = nullptr;
+
+    /** Direct handler for the requests sent to this port, if any */
+    TimingReqHandler timingReqHandler = nullptr;
+
     bool defaultBackdoorWarned;
 
   protected:
     SimObject& owner;
 
+    /**
+     * Let the request port bound to this port deliver timing requests by
+     * calling a function directly, instead of going through the timing
+     * protocol and the virtual recvTimingReq. The same rules as for
+     * RequestPort::setTimingRespHandler() apply.
+     *
+     * @param handler Function receiving the timing requests.
+     */
+    void
+    setTimingReqHandler(TimingReqHandler handler)
+    {
+        timingReqHandler = handler;
+    }
+
   public:
     [[deprecated("ResponsePort ownership is deprecated. "
                  "Owner should now be registered in derived classes.")]]
@@ -453,6 +511,11 @@ class ResponsePort : public Port, public AtomicResponseProtocol,
     bool
     sendTimingResp(PacketPtr pkt)
     {
+        if (_timingRespHandler && !debug::PortTrace) {
+            assert(pkt->isResponse());
+            return _timingRespHandler(*_requestPort, pkt);
+        }
+
         try {
             _requestPort->removeTrace(pkt);
             bool succ = TimingResponseProtocol::sendResp(_requestPort, pkt);
@@ -602,6 +665,11 @@ RequestPort::sendMemBackdoorReq(const MemBackdoorReq &req,
 inline bool
 RequestPort::sendTimingReq(PacketPtr pkt)
 {
+    if (_timingReqHandler && !debug::PortTrace) {
+        assert(pkt->isRequest());
+        return _timingReqHandler(*_responsePort, pkt);
+    }
+
     try {
         addTrace(pkt);
         bool succ = TimingRequestProtocol::sendReq(_responsePort, pkt);
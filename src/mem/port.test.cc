@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "mem/packet.hh"
+#include "mem/port.hh"
+#include "mem/request.hh"
+
+using namespace gem5;
+
+// Requests record the tick they are created at
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+class TestResponsePort final : public ResponsePort
+{
+  public:
+    TestResponsePort(bool direct) : ResponsePort("response_port")
+    {
+        if (direct)
+            setTimingReqHandler(&directTimingReq);
+    }
+
+    bool accept = true;
+    uint64_t received = 0;
+    uint64_t directCalls = 0;
+
+    using ResponsePort::sendTimingResp;
+
+  protected:
+    bool
+    recvTimingReq(PacketPtr pkt) override
+    {
+        if (!accept)
+            return false;
+        ++received;
+        return true;
+    }
+
+    Tick recvAtomic(PacketPtr pkt) override { return 0; }
+    void recvFunctional(PacketPtr pkt) override {}
+    void recvRespRetry() override {}
+    AddrRangeList getAddrRanges() const override { return {}; }
+
+  private:
+    static bool
+    directTimingReq(ResponsePort &port, PacketPtr pkt)
+    {
+        auto &self = static_cast<TestResponsePort &>(port);
+        ++self.directCalls;
+        return self.TestResponsePort::recvTimingReq(pkt);
+    }
+};
+
+class TestRequestPort final : public RequestPort
+{
+  public:
+    TestRequestPort(bool direct) : RequestPort("request_port")
+    {
+        if (direct)
+            setTimingRespHandler(&directTimingResp);
+    }
+
+    bool accept = true;
+    uint64_t received = 0;
+    uint64_t directCalls = 0;
+
+  protected:
+    bool
+    recvTimingResp(PacketPtr pkt) override
+    {
+        if (!accept)
+            return false;
+        ++received;
+        return true;
+    }
+
+    void recvReqRetry() override {}
+
+  private:
+    static bool
+    directTimingResp(RequestPort &port, PacketPtr pkt)
+    {
+        auto &self = static_cast<TestRequestPort &>(port);
+        ++self.directCalls;
+        return self.TestRequestPort::recvTimingResp(pkt);
+    }
+};
+
+PacketPtr
+makePacket()
+{
+    auto req = std::make_shared<Request>(0x1000, 64, 0, 0);
+    return new Packet(req, MemCmd::ReadReq);
+}
+
+} // anonymous namespace
+
+/** Requests go through the handler of the response port, if any */
+TEST(PortTest, DirectTimingReq)
+{
+    std::unique_ptr<Packet> pkt(makePacket());
+
+    TestRequestPort request(false);
+    TestResponsePort direct(true), virt(false);
+
+    request.bind(direct);
+    EXPECT_TRUE(request.sendTimingReq(pkt.get()));
+    direct.accept = false;
+    EXPECT_FALSE(request.sendTimingReq(pkt.get()));
+    EXPECT_EQ(1, direct.received);
+    EXPECT_EQ(2, direct.directCalls);
+    request.unbind();
+
+    // The handler doesn't follow the request port to its next binding
+    request.bind(virt);
+    EXPECT_TRUE(request.sendTimingReq(pkt.get()));
+    EXPECT_EQ(1, virt.received);
+    EXPECT_EQ(0, virt.directCalls);
+    EXPECT_EQ(2, direct.directCalls);
+    request.unbind();
+}
+
+/** Responses go through the handler of the request port, if any */
+TEST(PortTest, DirectTimingResp)
+{
+    std::unique_ptr<Packet> pkt(makePacket());
+    pkt->makeResponse();
+
+    TestRequestPort direct(true), virt(false);
+    TestResponsePort response(false);
+
+    direct.bind(response);
+    EXPECT_TRUE(response.sendTimingResp(pkt.get()));
+    direct.accept = false;
+    EXPECT_FALSE(response.sendTimingResp(pkt.get()));
+    EXPECT_EQ(1, direct.received);
+    EXPECT_EQ(2, direct.directCalls);
+    direct.unbind();
+
+    virt.bind(response);
+    EXPECT_TRUE(response.sendTimingResp(pkt.get()));
+    EXPECT_EQ(1, virt.received);
+    EXPECT_EQ(0, virt.directCalls);
+    virt.unbind();
+}
+
@@ -46,6 +46,11 @@ class MemTraceProbe(BaseMemProbe):
     # Boolean to compress the trace or not.
     trace_compress = Param.Bool(True, "Enable trace compression")
 
+    # Threads compressing and writing the trace in the background
+    compress_threads = Param.Unsigned(
+        1, "Number of threads compressing the trace in the background"
+    )
+
     # For requests with a valid PC, include the PC in the trace
     with_pc = Param.Bool(False, "Include PC info in the trace")
 
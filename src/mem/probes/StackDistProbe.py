@@ -53,6 +53,19 @@ class StackDistProbe(BaseMemProbe):
         "equal to the system's line size)",
     )
 
+    # spatial sampling of the tracked lines, trading accuracy for
+    # host memory on long runs
+    sample_rate = Param.Float(
+        1.0,
+        "Fraction of the lines whose stack distance is tracked, chosen "
+        "by hashing the line address (1 for exact stack distances)",
+    )
+    sample_limit = Param.Unsigned(
+        0,
+        "Maximum number of lines tracked when sampling, the sampling rate "
+        "is lowered as needed to stay within it (0 for no limit)",
+    )
+
     # enable verification stack
     verify = Param.Bool(
         False, "Verify behaviuor with reference implementation"
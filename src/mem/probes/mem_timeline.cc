@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/probes/mem_timeline.hh"
+
+#include "base/cprintf.hh"
+#include "params/MemTimelineProbe.hh"
+
+namespace gem5
+{
+
+MemTimelineProbe::MemTimelineProbe(const MemTimelineProbeParams &p)
+    : SimObject(p)
+{
+}
+
+void
+MemTimelineProbe::regProbeListeners()
+{
+    const MemTimelineProbeParams &p =
+        dynamic_cast<const MemTimelineProbeParams &>(params());
+
+    for (auto *obj: p.manager) {
+        tracks.emplace_back(new Track);
+        Track &track = *tracks.back();
+        track.name = obj->name();
+
+        ProbeManager *const mgr(obj->getProbeManager());
+        listeners.emplace_back(new PacketListener(
+            *this, track, false, mgr, p.request_probe_name));
+        listeners.emplace_back(new PacketListener(
+            *this, track, true, mgr, p.response_probe_name));
+    }
+}
+
+void
+MemTimelineProbe::handleRequest(Track &track,
+                                const probing::PacketInfo &pkt_info)
+{
+    if (!timeline::enabled() || !pkt_info.cmd.needsResponse() ||
+        !track.sampler()) {
+        return;
+    }
+    track.inFlight.emplace(pkt_info.pktId, InFlight{curTick(), pkt_info});
+}
+
+void
+MemTimelineProbe::handleResponse(Track &track,
+                                 const probing::PacketInfo &pkt_info)
+{
+    auto it = track.inFlight.find(pkt_info.pktId);
+    if (it == track.inFlight.end())
+        return;
+
+    const probing::PacketInfo &req = it->second.info;
+    timeline::asyncSlice(track.name, req.cmd.toString(), pkt_info.pktId,
+                         it->second.start, curTick(), {
+                             {"addr", csprintf("%#x", req.addr)},
+                             {"size", std::to_string(req.size)},
+                             {"requestor", std::to_string(req.id)},
+                             {"pc", csprintf("%#x", req.pc)},
+                             {"response", pkt_info.cmd.toString()},
+                         });
+    track.inFlight.erase(it);
+}
+
+} // namespace gem5
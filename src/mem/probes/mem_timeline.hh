@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_PROBES_MEM_TIMELINE_HH__
+#define __MEM_PROBES_MEM_TIMELINE_HH__
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/probe/mem.hh"
+#include "sim/sim_object.hh"
+#include "sim/timeline.hh"
+
+namespace gem5
+{
+
+struct MemTimelineProbeParams;
+
+/**
+ * Record the lifetime of packets, from their request to their response,
+ * in the simulation timeline. Each probe manager gets its own track, and
+ * only the sampled packets which expect a response are recorded.
+ */
+class MemTimelineProbe : public SimObject
+{
+  public:
+    MemTimelineProbe(const MemTimelineProbeParams &params);
+
+    void regProbeListeners() override;
+
+  private:
+    /** A packet waiting for its response */
+    struct InFlight
+    {
+        Tick start;
+        probing::PacketInfo info;
+    };
+
+    /** Packets seen by one of the probe managers */
+    struct Track
+    {
+        std::string name;
+        timeline::Sampler sampler;
+        std::unordered_map<PacketId, InFlight> inFlight;
+    };
+
+    void handleRequest(Track &track, const probing::PacketInfo &pkt_info);
+    void handleResponse(Track &track, const probing::PacketInfo &pkt_info);
+
+    class PacketListener : public ProbeListenerArgBase<probing::PacketInfo>
+    {
+      public:
+        PacketListener(MemTimelineProbe &_parent, Track &_track,
+                       bool _response, ProbeManager *pm,
+                       const std::string &name)
+            : ProbeListenerArgBase(pm, name),
+              parent(_parent), track(_track), response(_response) {}
+
+        void
+        notify(const probing::PacketInfo &pkt_info) override
+        {
+            if (response)
+                parent.handleResponse(track, pkt_info);
+            else
+                parent.handleRequest(track, pkt_info);
+        }
+
+      protected:
+        MemTimelineProbe &parent;
+        Track &track;
+        const bool response;
+    };
+
+    std::vector<std::unique_ptr<Track>> tracks;
+    std::vector<std::unique_ptr<PacketListener>> listeners;
+};
+
+} // namespace gem5
+
+#endif //  __MEM_PROBES_MEM_TIMELINE_HH__
@@ -74,7 +74,7 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
                                   (p.trace_compress ? ".gz" : ""));
     }
 
-    traceStream = new ProtoOutputStream(filename);
+    traceStream = new ProtoOutputStream(filename, p.compress_threads);
 
     // Register a callback to compensate for the destructor not
     // being called. The callback forces the stream to flush and
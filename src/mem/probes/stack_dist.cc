@@ -37,23 +37,47 @@
 
 #include "mem/probes/stack_dist.hh"
 
+#include <iterator>
+
 #include "params/StackDistProbe.hh"
 #include "sim/system.hh"
 
 namespace gem5
 {
 
+namespace
+{
+
+/** Mix the line address bits so that the sample is spread uniformly */
+uint64_t
+hashLine(Addr line)
+{
+    uint64_t h = line;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+} // anonymous namespace
+
 StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
     : BaseMemProbe(p),
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
+      sampleThreshold(p.sample_rate * sampleModulus),
+      sampleLimit(p.sample_limit),
       calc(p.verify),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
              "The stack distance probe must use a cache line size that is "
              "larger or equal to the system's cache line size.");
+    fatal_if(p.sample_rate <= 0 || p.sample_rate > 1,
+             "The stack distance sampling rate must be in (0, 1].");
 }
 
 StackDistProbe::StackDistProbeStats::StackDistProbeStats(
@@ -68,7 +92,12 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
       ADD_STAT(writeLogHist, statistics::units::Ratio::get(),
                "Writes logarithmic distribution"),
       ADD_STAT(infiniteSD, statistics::units::Count::get(),
-               "Number of requests with infinite stack distance")
+               "Number of requests with infinite stack distance"),
+      ADD_STAT(sampledReqs, statistics::units::Count::get(),
+               "Number of requests to sampled lines"),
+      ADD_STAT(droppedLines, statistics::units::Count::get(),
+               "Number of lines dropped from the sample to stay within "
+               "the sample limit")
 {
     using namespace statistics;
 
@@ -93,6 +122,37 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
 
     infiniteSD
         .flags(nozero);
+
+    droppedLines
+        .flags(nozero);
+}
+
+bool
+StackDistProbe::sampleLine(Addr line)
+{
+    const uint64_t hash = hashLine(line) % sampleModulus;
+    if (hash >= sampleThreshold)
+        return false;
+
+    if (sampleLimit == 0 ||
+        !sampledLines.emplace(hash, line).second ||
+        sampledLines.size() <= sampleLimit) {
+        return true;
+    }
+
+    // Too many lines, lower the threshold to the highest tracked hash
+    // and stop tracking all the lines at or above it
+    sampleThreshold = sampledLines.rbegin()->first;
+    while (!sampledLines.empty() &&
+           sampledLines.rbegin()->first >= sampleThreshold) {
+        auto last = std::prev(sampledLines.end());
+        if (last->second != line)
+            calc.calcStackDistAndUpdate(last->second, false);
+        sampledLines.erase(last);
+        stats.droppedLines++;
+    }
+
+    return hash < sampleThreshold;
 }
 
 void
@@ -106,13 +166,21 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
+    if (!sampleLine(aligned_addr))
+        return;
+    stats.sampledReqs++;
+
     // Calculate the stack distance
-    const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
+    uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
     if (sd == StackDistCalc::Infinity) {
         stats.infiniteSD++;
         return;
     }
 
+    // Scale the distance within the sample to the full address stream
+    if (sampleThreshold != sampleModulus)
+        sd = sd * sampleModulus / sampleThreshold;
+
     // Sample the stack distance of the address in linear bins
     if (!disableLinearHists) {
         if (pkt_info.cmd.isRead())
@@ -38,6 +38,9 @@
 #ifndef __MEM_PROBES_STACK_DIST_HH__
 #define __MEM_PROBES_STACK_DIST_HH__
 
+#include <set>
+#include <utility>
+
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "mem/stack_dist_calc.hh"
@@ -56,6 +59,17 @@ class StackDistProbe : public BaseMemProbe
   protected:
     void handleRequest(const probing::PacketInfo &pkt_info) override;
 
+    /**
+     * Decide if a line is part of the sample, tracking it if so. When
+     * the number of tracked lines goes over the limit, the lines
+     * with the highest hashes are dropped and the sampling threshold
+     * is lowered to match.
+     *
+     * @param line Address of the line
+     * @return True if the access should be passed to the calculator
+     */
+    bool sampleLine(Addr line);
+
   protected:
     // Cache line size to simulate
     const unsigned lineSize;
@@ -66,6 +80,24 @@ class StackDistProbe : public BaseMemProbe
     // Disable the logarithmic histograms
     const bool disableLogHists;
 
+    /**
+     * Lines are sampled based on a hash of their address, in the style
+     * of SHARDS (Waldspurger et al., FAST'15). A line is tracked when
+     * its hash modulo sampleModulus is below the threshold, so a line
+     * is either always or never sampled and the stack distances of
+     * the sample scale with the inverse of the sampling rate.
+     */
+    static const uint64_t sampleModulus = 1ULL << 24;
+
+    // Threshold of the line hashes to sample
+    uint64_t sampleThreshold;
+
+    // Maximum number of lines tracked, 0 if unlimited
+    const unsigned sampleLimit;
+
+    // Tracked lines ordered by hash, only used with a sample limit
+    std::set<std::pair<uint64_t, Addr>> sampledLines;
+
   protected:
     StackDistCalc calc;
 
@@ -85,8 +117,14 @@ class StackDistProbe : public BaseMemProbe
         // Writes logarithmic histogram
         statistics::SparseHistogram writeLogHist;
 
-        // Writes logarithmic histogram
+        // Requests with infinite stack distance
         statistics::Scalar infiniteSD;
+
+        // Requests passed on to the stack distance calculation
+        statistics::Scalar sampledReqs;
+
+        // Lines dropped from the sample to stay within the limit
+        statistics::Scalar droppedLines;
     } stats;
 };
 
@@ -133,3 +133,8 @@ class QoSPropFairPolicy(QoSPolicy):
                     )
 
     weight = Param.Float(0.5, "Pf score weight")
+    schedule_window = Param.Latency(
+        "0ns",
+        "Time between two rankings of the requestors by score, 0 to "
+        "rank them for every packet",
+    )
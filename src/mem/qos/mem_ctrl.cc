@@ -275,6 +275,8 @@ MemCtrl::addRequestor(RequestorID id)
 {
     if (!hasRequestor(id)) {
         requestors.emplace(id, _system->getRequestorName(id));
+        if (packetPriorities.size() <= id)
+            packetPriorities.resize(id + 1);
         packetPriorities[id].resize(numPriorities(), 0);
 
         DPRINTF(QOS,
@@ -107,8 +107,11 @@ class MemCtrl : public ClockedObject
     /** Hash of requestor ID - requestor name */
     std::unordered_map<RequestorID, const std::string> requestors;
 
-    /** Hash of requestors - number of packets queued per priority */
-    std::unordered_map<RequestorID, std::vector<uint64_t> > packetPriorities;
+    /**
+     * Number of packets queued per priority, per requestor. Indexed by
+     * RequestorID, which is a dense index into the system's requestors.
+     */
+    std::vector<std::vector<uint64_t>> packetPriorities;
 
     /** Hash of requestors - address of request - queue of times of request */
     std::unordered_map<RequestorID,
@@ -421,13 +424,15 @@ MemCtrl::escalateQueues(Queues& queues, uint64_t queue_entry_size,
                 writeQueueSizes[tgt_prio] += moved_entries;
             }
 
+            // Erase element from source packet queue, this will
+            // increment the iterator. This must happen before the
+            // packet joins the target queue, which gives it a new
+            // arrival sequence number.
+            it = queues[curr_prio].erase(it);
+
             // Change QoS priority and move packet
             pkt->qosValue(tgt_prio);
             queues[tgt_prio].push_back(pkt);
-
-            // Erase element from source packet queue, this will
-            // increment the iterator
-            it = queues[curr_prio].erase(it);
             panic_if(packetPriorities[id][curr_prio] < moved_entries,
                      "qos::MemCtrl::escalateQueues requestor %s negative "
                      "packets for priority %d",
@@ -66,35 +66,46 @@ FixedPriorityPolicy::init()
 {
 }
 
+void
+FixedPriorityPolicy::setPriority(
+    const std::pair<RequestorID, uint8_t> &requestor)
+{
+    if (priorities.size() <= requestor.first)
+        priorities.resize(requestor.first + 1);
+
+    // The first priority given to a requestor sticks
+    RequestorPriority &entry = priorities[requestor.first];
+    if (!entry.listed) {
+        entry.listed = true;
+        entry.priority = requestor.second;
+    }
+}
+
 void
 FixedPriorityPolicy::initRequestorName(std::string requestor, uint8_t priority)
 {
-    priorityMap.insert(
-        this->pair<std::string, uint8_t>(requestor, priority));
+    setPriority(this->pair<std::string, uint8_t>(requestor, priority));
 }
 
 void
 FixedPriorityPolicy::initRequestorObj(const SimObject* requestor,
                                    uint8_t priority)
 {
-    priorityMap.insert(
-        this->pair<const SimObject*, uint8_t>(requestor, priority));
+    setPriority(this->pair<const SimObject*, uint8_t>(requestor, priority));
 }
 
 uint8_t
 FixedPriorityPolicy::schedule(const RequestorID id, const uint64_t data)
 {
     // Reads a packet's RequestorID contained in its encapsulated request
-    // if a match is found in the configured priority map, returns the
-    // matching priority, else returns zero
-
-    auto ret = priorityMap.find(id);
+    // if a match is found in the configured priorities, returns the
+    // matching priority, else returns the default one
 
-    if (ret != priorityMap.end()) {
-        return ret->second;
+    if (id < priorities.size() && priorities[id].listed) {
+        return priorities[id].priority;
     } else {
         DPRINTF(QOS, "Requestor %s (RequestorID %d) not present in "
-                     "priorityMap, assigning default priority %d\n",
+                     "priorities, assigning default priority %d\n",
                       memCtrl->system()->getRequestorName(id),
                       id, defaultPriority);
         return defaultPriority;
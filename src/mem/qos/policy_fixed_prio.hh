@@ -39,7 +39,7 @@
 #define __MEM_QOS_POLICY_FIXED_PRIO_HH__
 
 #include <cstdint>
-#include <map>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "mem/qos/policy.hh"
@@ -104,10 +104,18 @@ class FixedPriorityPolicy : public Policy
     const uint8_t defaultPriority;
 
     /**
-     * Priority map, associates configured requestors with
-     * a fixed QoS priority value
+     * Priorities of the configured requestors, indexed by RequestorID.
+     * Requestors which were not configured are marked as not listed.
      */
-    std::map<RequestorID, uint8_t> priorityMap;
+    struct RequestorPriority
+    {
+        bool listed = false;
+        uint8_t priority = 0;
+    };
+    std::vector<RequestorPriority> priorities;
+
+    /** Associate a configured requestor with its fixed priority */
+    void setPriority(const std::pair<RequestorID, uint8_t> &requestor);
 };
 
 } // namespace qos
@@ -38,8 +38,10 @@
 #include "mem/qos/policy_pf.hh"
 
 #include <algorithm>
+#include <cmath>
 
 #include "base/logging.hh"
+#include "sim/cur_tick.hh"
 #include "params/QoSPropFairPolicy.hh"
 
 namespace gem5
@@ -52,7 +54,8 @@ namespace qos
 {
 
 PropFairPolicy::PropFairPolicy(const Params &p)
-  : Policy(p), weight(p.weight)
+  : Policy(p), weight(p.weight), scheduleWindow(p.schedule_window),
+    nextRanking(0), scheduled(0)
 {
     fatal_if(weight < 0 || weight > 1,
         "weight must be a value between 0 and 1");
@@ -69,12 +72,23 @@ PropFairPolicy::initRequestor(const Requestor requestor, const double score)
 
     assert(id != Request::invldRequestorId);
 
-    // Setting the Initial score for the selected requestor.
-    history.push_back(std::make_pair(id, score));
+    if (requestorStates.size() <= id)
+        requestorStates.resize(id + 1);
 
-    fatal_if(history.size() > memCtrl->numPriorities(),
+    // Setting the Initial score for the selected requestor.
+    RequestorState &state = requestorStates[id];
+    if (!state.tracked)
+        ranking.push_back(id);
+    state.tracked = true;
+    state.score = score;
+    state.lastUpdate = scheduled;
+
+    fatal_if(ranking.size() > memCtrl->numPriorities(),
         "Policy's maximum number of requestors is currently dictated "
         "by the maximum number of priorities\n");
+
+    // Rank the requestors again before the next packet
+    nextRanking = 0;
 }
 
 void
@@ -96,37 +110,60 @@ PropFairPolicy::updateScore(
     return ((1.0 - weight) * old_score) + (weight * served_bytes);
 }
 
-uint8_t
-PropFairPolicy::schedule(const RequestorID pkt_id, const uint64_t pkt_size)
+double
+PropFairPolicy::currentScore(const RequestorID id) const
 {
-    auto sort_pred =
-    [] (const RequestorHistory& lhs, const RequestorHistory& rhs)
-    { return lhs.second > rhs.second; };
+    const RequestorState &state = requestorStates[id];
+    const uint64_t steps = scheduled - state.lastUpdate;
+    if (steps == 0)
+        return state.score;
+    return state.score * std::pow(1.0 - weight, steps);
+}
+
+void
+PropFairPolicy::rankRequestors()
+{
+    for (auto id : ranking) {
+        RequestorState &state = requestorStates[id];
+        state.score = currentScore(id);
+        state.lastUpdate = scheduled;
+    }
 
     // Sorting in reverse in base of personal history:
     // First elements have higher history/score -> lower priority.
     // The qos priority is the position in the sorted vector.
-    std::sort(history.begin(), history.end(), sort_pred);
-
-    const double served_bytes = static_cast<double>(pkt_size);
+    std::sort(ranking.begin(), ranking.end(),
+        [this] (RequestorID lhs, RequestorID rhs)
+        {
+            return requestorStates[lhs].score > requestorStates[rhs].score;
+        });
 
-    uint8_t pkt_priority = 0;
-    for (auto m_hist = history.begin(); m_hist != history.end(); m_hist++) {
+    for (size_t i = 0; i < ranking.size(); i++)
+        requestorStates[ranking[i]].priority = i;
 
-        RequestorID curr_id = m_hist->first;
-        double& curr_score = m_hist->second;
+    nextRanking = curTick() + scheduleWindow;
+}
 
-        if (curr_id == pkt_id) {
-            // The qos priority is the position in the sorted vector.
-            pkt_priority = std::distance(history.begin(), m_hist);
+uint8_t
+PropFairPolicy::schedule(const RequestorID pkt_id, const uint64_t pkt_size)
+{
+    if (scheduleWindow == 0 || curTick() >= nextRanking)
+        rankRequestors();
 
-            curr_score = updateScore(curr_score, served_bytes);
-        } else {
-            curr_score = updateScore(curr_score, 0);
-        }
+    if (pkt_id >= requestorStates.size() ||
+        !requestorStates[pkt_id].tracked) {
+        scheduled++;
+        return 0;
     }
 
-    return pkt_priority;
+    // Every scheduled packet decays the score of all the requestors;
+    // only the served one has its score brought up to date now.
+    RequestorState &state = requestorStates[pkt_id];
+    const double served_bytes = static_cast<double>(pkt_size);
+    state.score = updateScore(currentScore(pkt_id), served_bytes);
+    state.lastUpdate = ++scheduled;
+
+    return state.priority;
 }
 
 } // namespace qos
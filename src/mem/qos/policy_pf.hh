@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "base/compiler.hh"
+#include "base/types.hh"
 #include "mem/qos/policy.hh"
 #include "mem/request.hh"
 
@@ -65,6 +66,14 @@ namespace qos
  *
  * This is the formula used by the policy
  * ((1.0 - weight) * old_score) + (weight * served_bytes);
+ *
+ * Every scheduled packet decays the score of all requestors, but as
+ * the decay is the same for all of them it is applied lazily, when a
+ * requestor is served or when the priorities are ranked again. The
+ * priorities are ranked for every packet by default; a non-zero
+ * schedule window ranks them once per window instead, which keeps the
+ * cost per packet constant with many requestors at the price of
+ * priorities trailing the scores by up to a window.
  */
 class PropFairPolicy : public Policy
 {
@@ -111,13 +120,51 @@ class PropFairPolicy : public Policy
     inline double
     updateScore(const double old_score, const uint64_t served_bytes) const;
 
+    /**
+     * Score of a requestor, with the decay of the packets scheduled
+     * since it was last updated applied.
+     */
+    double currentScore(const RequestorID id) const;
+
+    /** Sort the requestors by score and recompute their priorities */
+    void rankRequestors();
+
   protected:
     /** PF Policy weight */
     const double weight;
 
-    /** history is keeping track of every requestor's score */
-    using RequestorHistory = std::pair<RequestorID, double>;
-    std::vector<RequestorHistory> history;
+    /** Time between two rankings of the requestors, 0 for every packet */
+    const Tick scheduleWindow;
+
+    /** Tick at which the requestors are next ranked */
+    Tick nextRanking;
+
+    /** Number of packets scheduled so far */
+    uint64_t scheduled;
+
+    /**
+     * Requestors with a score, from the highest score to the lowest
+     * one as of the last ranking
+     */
+    std::vector<RequestorID> ranking;
+
+    /**
+     * Per requestor state, indexed by RequestorID. Requestor IDs are
+     * dense indices into the system's requestor list, so these are
+     * plain arrays rather than maps.
+     */
+    struct RequestorState
+    {
+        /** Whether the requestor was given an initial score */
+        bool tracked = false;
+        /** Priority assigned by the last ranking */
+        uint8_t priority = 0;
+        /** Score, as of the moment scheduled was lastUpdate */
+        double score = 0;
+        /** Value of scheduled at the last score update */
+        uint64_t lastUpdate = 0;
+    };
+    std::vector<RequestorState> requestorStates;
 };
 
 } // namespace qos
@@ -47,7 +47,8 @@ namespace ruby
 {
 
 Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
-    : m_wakeup_event([this]{ processCurrentEvent(); },
+    : m_wakeup_ticks(_em->clockPeriod()),
+      m_wakeup_event([this]{ processCurrentEvent(); },
                     "Consumer Event", false, ev_prio),
       em(_em)
 { }
@@ -55,14 +56,16 @@ Consumer::Consumer(ClockedObject *_em, Event::Priority ev_prio)
 void
 Consumer::scheduleEvent(Cycles timeDelta)
 {
-    m_wakeup_ticks.insert(em->clockEdge(timeDelta));
+    m_wakeup_ticks.setPeriod(em->clockPeriod());
+    m_wakeup_ticks.add(em->clockEdge(timeDelta));
     scheduleNextWakeup();
 }
 
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
-    m_wakeup_ticks.insert(
+    m_wakeup_ticks.setPeriod(em->clockPeriod());
+    m_wakeup_ticks.add(
         divCeil(evt_time, em->clockPeriod()) * em->clockPeriod());
     scheduleNextWakeup();
 }
@@ -71,9 +74,8 @@ void
 Consumer::scheduleNextWakeup()
 {
     // look for the next tick in the future to schedule
-    auto it = m_wakeup_ticks.lower_bound(em->clockEdge());
-    if (it != m_wakeup_ticks.end()) {
-        Tick when = *it;
+    Tick when = m_wakeup_ticks.next(em->clockEdge());
+    if (when != MaxTick) {
         assert(when >= em->clockEdge());
         if (m_wakeup_event.scheduled() && (when < m_wakeup_event.when()))
             em->reschedule(m_wakeup_event, when, true);
@@ -85,12 +87,12 @@ Consumer::scheduleNextWakeup()
 void
 Consumer::processCurrentEvent()
 {
-    auto curr = m_wakeup_ticks.begin();
-    assert(em->clockEdge() == *curr);
+    assert(alreadyScheduled(em->clockEdge()));
 
     // remove the current tick from the wakeup list, wake up, and then schedule
     // the next wakeup
-    m_wakeup_ticks.erase(curr);
+    m_wakeup_ticks.setPeriod(em->clockPeriod());
+    m_wakeup_ticks.consume(em->clockEdge());
     wakeup();
     scheduleNextWakeup();
 }
@@ -48,8 +48,8 @@
 #define __MEM_RUBY_COMMON_CONSUMER_HH__
 
 #include <iostream>
-#include <set>
 
+#include "mem/ruby/common/WakeupTicks.hh"
 #include "sim/clocked_object.hh"
 
 namespace gem5
@@ -73,9 +73,9 @@ class Consumer
     virtual void storeEventInfo(int info) {}
 
     bool
-    alreadyScheduled(Tick time)
+    alreadyScheduled(Tick time) const
     {
-        return m_wakeup_ticks.find(time) != m_wakeup_ticks.end();
+        return m_wakeup_ticks.contains(time);
     }
 
     ClockedObject *
@@ -88,7 +88,7 @@ class Consumer
     void scheduleEvent(Cycles timeDelta);
 
   private:
-    std::set<Tick> m_wakeup_ticks;
+    WakeupTicks m_wakeup_ticks;
     EventFunctionWrapper m_wakeup_event;
     ClockedObject *em;
 
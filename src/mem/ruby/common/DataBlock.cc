@@ -40,6 +40,8 @@
 
 #include "mem/ruby/common/DataBlock.hh"
 
+#include <algorithm>
+
 #include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -51,7 +53,6 @@ namespace ruby
 
 DataBlock::DataBlock(const DataBlock &cp)
 {
-    uint8_t *block_update;
     size_t block_bytes = RubySystem::getBlockSizeBytes();
     m_data = new uint8_t[block_bytes];
     memcpy(m_data, cp.m_data, block_bytes);
@@ -59,11 +60,8 @@ DataBlock::DataBlock(const DataBlock &cp)
     // If this data block is involved in an atomic operation, the effect
     // of applying the atomic operations on the data block are recorded in
     // m_atomicLog. If so, we must copy over every entry in the change log
-    for (size_t i = 0; i < cp.m_atomicLog.size(); i++) {
-        block_update = new uint8_t[block_bytes];
-        memcpy(block_update, cp.m_atomicLog[i], block_bytes);
-        m_atomicLog.push_back(block_update);
-    }
+    m_atomicLog.assign(cp.m_atomicLog.begin() + cp.m_atomicLogHead,
+                       cp.m_atomicLog.end());
 }
 
 void
@@ -88,24 +86,26 @@ DataBlock::equal(const DataBlock& obj) const
     if (memcmp(m_data, obj.m_data, block_bytes)) {
         return false;
     }
-    if (m_atomicLog.size() != obj.m_atomicLog.size()) {
+    const size_t log_bytes = m_atomicLog.size() - m_atomicLogHead;
+    if (log_bytes != obj.m_atomicLog.size() - obj.m_atomicLogHead) {
         return false;
     }
-    for (size_t i = 0; i < m_atomicLog.size(); i++) {
-        if (memcmp(m_atomicLog[i], obj.m_atomicLog[i], block_bytes)) {
-            return false;
-        }
-    }
-    return true;
+    return !log_bytes || !memcmp(&m_atomicLog[m_atomicLogHead],
+                                 &obj.m_atomicLog[obj.m_atomicLogHead],
+                                 log_bytes);
 }
 
 void
 DataBlock::copyPartial(const DataBlock &dblk, const WriteMask &mask)
 {
-    for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
-        if (mask.getMask(i, 1)) {
-            m_data[i] = dblk.m_data[i];
-        }
+    // Copy the runs of set bytes, which are usually few and long
+    assert(mask.getSize() >= RubySystem::getBlockSizeBytes());
+    const int block_bytes = RubySystem::getBlockSizeBytes();
+    for (int start = mask.firstBitSet(true); start < block_bytes;) {
+        const int end = std::min(mask.firstBitSet(false, start),
+                                 block_bytes);
+        memcpy(&m_data[start], &dblk.m_data[start], end - start);
+        start = mask.firstBitSet(true, end);
     }
 }
 
@@ -113,9 +113,7 @@ void
 DataBlock::atomicPartial(const DataBlock &dblk, const WriteMask &mask,
         bool isAtomicNoReturn)
 {
-    for (int i = 0; i < RubySystem::getBlockSizeBytes(); i++) {
-        m_data[i] = dblk.m_data[i];
-    }
+    memcpy(m_data, dblk.m_data, RubySystem::getBlockSizeBytes());
     mask.performAtomic(m_data, m_atomicLog, isAtomicNoReturn);
 }
 
@@ -134,23 +132,28 @@ DataBlock::print(std::ostream& out) const
 int
 DataBlock::numAtomicLogEntries() const
 {
-    return m_atomicLog.size();
+    return (m_atomicLog.size() - m_atomicLogHead) /
+        RubySystem::getBlockSizeBytes();
 }
-uint8_t*
+const uint8_t*
+DataBlock::getAtomicLogEntryFront() const
+{
+    assert(numAtomicLogEntries() > 0);
+    return &m_atomicLog[m_atomicLogHead];
+}
+void
 DataBlock::popAtomicLogEntryFront()
 {
-    assert(m_atomicLog.size() > 0);
-    auto ret = m_atomicLog.front();
-    m_atomicLog.pop_front();
-    return ret;
+    assert(numAtomicLogEntries() > 0);
+    m_atomicLogHead += RubySystem::getBlockSizeBytes();
+    if (m_atomicLogHead == m_atomicLog.size())
+        clearAtomicLogEntries();
 }
 void
 DataBlock::clearAtomicLogEntries()
 {
-    for (auto log : m_atomicLog) {
-        delete [] log;
-    }
     m_atomicLog.clear();
+    m_atomicLogHead = 0;
 }
 
 const uint8_t*
@@ -183,18 +186,18 @@ DataBlock::setData(PacketPtr pkt)
 DataBlock &
 DataBlock::operator=(const DataBlock & obj)
 {
-    uint8_t *block_update;
+    if (this == &obj)
+        return *this;
+
     size_t block_bytes = RubySystem::getBlockSizeBytes();
     // Copy entire block contents from obj to current block
     memcpy(m_data, obj.m_data, block_bytes);
     // If this data block is involved in an atomic operation, the effect
     // of applying the atomic operations on the data block are recorded in
     // m_atomicLog. If so, we must copy over every entry in the change log
-    for (size_t i = 0; i < obj.m_atomicLog.size(); i++) {
-        block_update = new uint8_t[block_bytes];
-        memcpy(block_update, obj.m_atomicLog[i], block_bytes);
-        m_atomicLog.push_back(block_update);
-    }
+    m_atomicLog.insert(m_atomicLog.end(),
+                       obj.m_atomicLog.begin() + obj.m_atomicLogHead,
+                       obj.m_atomicLog.end());
     return *this;
 }
 
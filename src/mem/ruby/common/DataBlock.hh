@@ -44,9 +44,9 @@
 #include <inttypes.h>
 
 #include <cassert>
-#include <deque>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 #include "mem/packet.hh"
 
@@ -72,12 +72,6 @@ class DataBlock
     {
         if (m_alloc)
             delete [] m_data;
-
-        // If data block involved in atomic
-        // operations, free all meta data
-        for (auto log : m_atomicLog) {
-            delete [] log;
-        }
     }
 
     DataBlock& operator=(const DataBlock& obj);
@@ -87,7 +81,8 @@ class DataBlock
     void clear();
     uint8_t getByte(int whichByte) const;
     const uint8_t *getData(int offset, int len) const;
-    uint8_t* popAtomicLogEntryFront();
+    const uint8_t *getAtomicLogEntryFront() const;
+    void popAtomicLogEntryFront();
     int numAtomicLogEntries() const;
     void clearAtomicLogEntries();
     uint8_t *getDataMod(int offset);
@@ -106,8 +101,12 @@ class DataBlock
     uint8_t *m_data;
     bool m_alloc;
 
-    // Tracks block changes when atomic ops are applied
-    std::deque<uint8_t*> m_atomicLog;
+    // Tracks block changes when atomic ops are applied: one copy of the
+    // block per atomic op, back to back, of which the first
+    // m_atomicLogHead were already popped. An empty log costs nothing
+    // to copy.
+    std::vector<uint8_t> m_atomicLog;
+    size_t m_atomicLogHead = 0;
 };
 
 inline void
@@ -30,6 +30,8 @@
 
 #include <algorithm>
 
+#include "base/bitfield.hh"
+
 namespace gem5
 {
 
@@ -44,16 +46,16 @@ NetDest::NetDest()
 void
 NetDest::add(MachineID newElement)
 {
-    assert(bitIndex(newElement.num) < m_bits[vecIndex(newElement)].getSize());
-    m_bits[vecIndex(newElement)].add(bitIndex(newElement.num));
+    assert(bitIndex(newElement.num) < MachineType_base_count(newElement.type));
+    word(vecIndex(newElement), bitIndex(newElement.num)) |=
+        bitMask(bitIndex(newElement.num));
 }
 
 void
 NetDest::addNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].addSet(netDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] |= netDest.m_bits[i];
     }
 }
 
@@ -63,30 +65,36 @@ NetDest::setNetDest(MachineType machine, const Set& set)
     // assure that there is only one set of destinations for this machine
     assert(MachineType_base_level((MachineType)(machine + 1)) -
            MachineType_base_level(machine) == 1);
-    m_bits[MachineType_base_level(machine)] = set;
+    const int vec_index = MachineType_base_level(machine);
+    for (int w = 0; w < WordsPerType; w++) {
+        m_bits[vec_index * WordsPerType + w] = 0;
+    }
+    for (NodeID j = 0; j < set.getSize(); j++) {
+        if (set.isElement(j)) {
+            word(vec_index, j) |= bitMask(j);
+        }
+    }
 }
 
 void
 NetDest::remove(MachineID oldElement)
 {
-    m_bits[vecIndex(oldElement)].remove(bitIndex(oldElement.num));
+    word(vecIndex(oldElement), bitIndex(oldElement.num)) &=
+        ~bitMask(bitIndex(oldElement.num));
 }
 
 void
 NetDest::removeNetDest(const NetDest& netDest)
 {
-    assert(m_bits.size() == netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].removeSet(netDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        m_bits[i] &= ~netDest.m_bits[i];
     }
 }
 
 void
 NetDest::clear()
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].clear();
-    }
+    m_bits.fill(0);
 }
 
 void
@@ -101,9 +109,11 @@ NetDest::broadcast()
 void
 NetDest::broadcast(MachineType machineType)
 {
-    for (NodeID i = 0; i < MachineType_base_count(machineType); i++) {
-        MachineID mach = {machineType, i};
-        add(mach);
+    const int vec_index = MachineType_base_level(machineType);
+    const NodeID size = MachineType_base_count(machineType);
+    for (NodeID j = 0; j < size; j += 64) {
+        word(vec_index, j) |= size - j >= 64 ? ~uint64_t(0) :
+            bitMask(size - j) - 1;
     }
 }
 
@@ -112,12 +122,12 @@ std::vector<NodeID>
 NetDest::getAllDest()
 {
     std::vector<NodeID> dest;
-    dest.clear();
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                int id = MachineType_base_number((MachineType)i) + j;
-                dest.push_back((NodeID)id);
+    for (int i = 0; i < MachineType_NUM; i++) {
+        const int base = MachineType_base_number((MachineType)i);
+        for (int w = 0; w < WordsPerType; w++) {
+            for (uint64_t bits = m_bits[i * WordsPerType + w]; bits;
+                 bits &= bits - 1) {
+                dest.push_back(base + w * 64 + findLsbSet(bits));
             }
         }
     }
@@ -128,8 +138,8 @@ int
 NetDest::count() const
 {
     int counter = 0;
-    for (int i = 0; i < m_bits.size(); i++) {
-        counter += m_bits[i].count();
+    for (int i = 0; i < NumWords; i++) {
+        counter += popCount(m_bits[i]);
     }
     return counter;
 }
@@ -137,19 +147,19 @@ NetDest::count() const
 NodeID
 NetDest::elementAt(MachineID index)
 {
-    return m_bits[vecIndex(index)].elementAt(bitIndex(index.num));
+    return isElement(index);
 }
 
 MachineID
 NetDest::smallestElement() const
 {
     assert(count() > 0);
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (NodeID j = 0; j < m_bits[i].getSize(); j++) {
-            if (m_bits[i].isElement(j)) {
-                MachineID mach = {MachineType_from_base_level(i), j};
-                return mach;
-            }
+    for (int i = 0; i < NumWords; i++) {
+        if (m_bits[i]) {
+            MachineID mach = {MachineType_from_base_level(i / WordsPerType),
+                              NodeID((i % WordsPerType) * 64 +
+                                     findLsbSet(m_bits[i]))};
+            return mach;
         }
     }
     panic("No smallest element of an empty set.");
@@ -158,10 +168,11 @@ NetDest::smallestElement() const
 MachineID
 NetDest::smallestElement(MachineType machine) const
 {
-    int size = m_bits[MachineType_base_level(machine)].getSize();
-    for (NodeID j = 0; j < size; j++) {
-        if (m_bits[MachineType_base_level(machine)].isElement(j)) {
-            MachineID mach = {machine, j};
+    const int vec_index = MachineType_base_level(machine);
+    for (int w = 0; w < WordsPerType; w++) {
+        const uint64_t bits = m_bits[vec_index * WordsPerType + w];
+        if (bits) {
+            MachineID mach = {machine, NodeID(w * 64 + findLsbSet(bits))};
             return mach;
         }
     }
@@ -173,8 +184,12 @@ NetDest::smallestElement(MachineType machine) const
 bool
 NetDest::isBroadcast() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isBroadcast()) {
+    for (int i = 0; i < MachineType_NUM; i++) {
+        int counter = 0;
+        for (int w = 0; w < WordsPerType; w++) {
+            counter += popCount(m_bits[i * WordsPerType + w]);
+        }
+        if (counter != MachineType_base_count((MachineType)i)) {
             return false;
         }
     }
@@ -185,22 +200,20 @@ NetDest::isBroadcast() const
 bool
 NetDest::isEmpty() const
 {
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isEmpty()) {
-            return false;
-        }
+    uint64_t bits = 0;
+    for (int i = 0; i < NumWords; i++) {
+        bits |= m_bits[i];
     }
-    return true;
+    return bits == 0;
 }
 
 // returns the logical OR of "this" set and orNetDest
 NetDest
 NetDest::OR(const NetDest& orNetDest) const
 {
-    assert(m_bits.size() == orNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].OR(orNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] | orNetDest.m_bits[i];
     }
     return result;
 }
@@ -209,10 +222,9 @@ NetDest::OR(const NetDest& orNetDest) const
 NetDest
 NetDest::AND(const NetDest& andNetDest) const
 {
-    assert(m_bits.size() == andNetDest.getSize());
     NetDest result;
-    for (int i = 0; i < m_bits.size(); i++) {
-        result.m_bits[i] = m_bits[i].AND(andNetDest.m_bits[i]);
+    for (int i = 0; i < NumWords; i++) {
+        result.m_bits[i] = m_bits[i] & andNetDest.m_bits[i];
     }
     return result;
 }
@@ -221,53 +233,49 @@ NetDest::AND(const NetDest& andNetDest) const
 bool
 NetDest::intersectionIsNotEmpty(const NetDest& other_netDest) const
 {
-    assert(m_bits.size() == other_netDest.getSize());
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].intersectionIsEmpty(other_netDest.m_bits[i])) {
-            return true;
-        }
+    uint64_t bits = 0;
+    for (int i = 0; i < NumWords; i++) {
+        bits |= m_bits[i] & other_netDest.m_bits[i];
     }
-    return false;
+    return bits != 0;
 }
 
 bool
 NetDest::isSuperset(const NetDest& test) const
 {
-    assert(m_bits.size() == test.getSize());
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        if (!m_bits[i].isSuperset(test.m_bits[i])) {
-            return false;
-        }
+    uint64_t missing = 0;
+    for (int i = 0; i < NumWords; i++) {
+        missing |= test.m_bits[i] & ~m_bits[i];
     }
-    return true;
+    return missing == 0;
 }
 
 bool
 NetDest::isElement(MachineID element) const
 {
-    return ((m_bits[vecIndex(element)])).isElement(bitIndex(element.num));
+    return word(vecIndex(element), bitIndex(element.num)) &
+        bitMask(bitIndex(element.num));
 }
 
 void
 NetDest::resize()
 {
-    m_bits.resize(MachineType_base_level(MachineType_NUM));
-    assert(m_bits.size() == MachineType_NUM);
-
-    for (int i = 0; i < m_bits.size(); i++) {
-        m_bits[i].setSize(MachineType_base_count((MachineType)i));
+    static_assert(NUMBER_BITS_PER_SET > 0, "Sets can't be empty");
+    assert(MachineType_base_level(MachineType_NUM) == MachineType_NUM);
+    for (int i = 0; i < MachineType_NUM; i++) {
+        assert(MachineType_base_count((MachineType)i) <= NUMBER_BITS_PER_SET);
     }
+    clear();
 }
 
 void
 NetDest::print(std::ostream& out) const
 {
-    out << "[NetDest (" << m_bits.size() << ") ";
+    out << "[NetDest (" << MachineType_NUM << ") ";
 
-    for (int i = 0; i < m_bits.size(); i++) {
-        for (int j = 0; j < m_bits[i].getSize(); j++) {
-            out << (bool) m_bits[i].isElement(j) << " ";
+    for (int i = 0; i < MachineType_NUM; i++) {
+        for (NodeID j = 0; j < MachineType_base_count((MachineType)i); j++) {
+            out << (bool)(word(i, j) & bitMask(j)) << " ";
         }
         out << " - ";
     }
@@ -277,12 +285,16 @@ NetDest::print(std::ostream& out) const
 bool
 NetDest::isEqual(const NetDest& n) const
 {
-    assert(m_bits.size() == n.m_bits.size());
-    for (unsigned int i = 0; i < m_bits.size(); ++i) {
-        if (!m_bits[i].isEqual(n.m_bits[i]))
-            return false;
-    }
-    return true;
+    return m_bits == n.m_bits;
+}
+
+size_t
+NetDest::hash() const
+{
+    uint64_t hval = 0;
+    for (int i = 0; i < NumWords; i++)
+        hval = (hval ^ m_bits[i]) * 0x9e3779b97f4a7c15ULL;
+    return hval ^ (hval >> 32);
 }
 
 } // namespace ruby
@@ -29,6 +29,8 @@
 #ifndef __MEM_RUBY_COMMON_NETDEST_HH__
 #define __MEM_RUBY_COMMON_NETDEST_HH__
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -42,6 +44,10 @@ namespace ruby
 {
 
 // NetDest specifies the network destination of a Message
+//
+// The destinations are kept in a single flat bitmap, with a fixed number
+// of 64 bit words per machine type, so that the set operations work on
+// whole words and copying a NetDest never allocates.
 class NetDest
 {
   public:
@@ -65,6 +71,10 @@ class NetDest
     void broadcast(MachineType machine);
     int count() const;
     bool isEqual(const NetDest& netDest) const;
+    bool operator==(const NetDest& netDest) const { return isEqual(netDest); }
+
+    // Hash of the destinations, to use a NetDest as a key
+    size_t hash() const;
 
     // return the logical OR of this netDest and orNetDest
     NetDest OR(const NetDest& orNetDest) const;
@@ -91,7 +101,7 @@ class NetDest
     MachineID smallestElement(MachineType machine) const;
 
     void resize();
-    int getSize() const { return m_bits.size(); }
+    int getSize() const { return MachineType_NUM; }
 
     // get element for a index
     NodeID elementAt(MachineID index);
@@ -99,19 +109,40 @@ class NetDest
     void print(std::ostream& out) const;
 
   private:
+    // Number of words holding the destinations of a machine type
+    static constexpr int WordsPerType = (NUMBER_BITS_PER_SET + 63) / 64;
+    static constexpr int NumWords = MachineType_NUM * WordsPerType;
+
     // returns a value >= MachineType_base_level("this machine")
     // and < MachineType_base_level("next highest machine")
     int
     vecIndex(MachineID m) const
     {
         int vec_index = MachineType_base_level(m.type);
-        assert(vec_index < m_bits.size());
+        assert(vec_index < MachineType_NUM);
         return vec_index;
     }
 
     NodeID bitIndex(NodeID index) const { return index; }
 
-    std::vector<Set> m_bits;  // a vector of bit vectors - i.e. Sets
+    uint64_t &
+    word(int vec_index, NodeID bit_index)
+    {
+        return m_bits[vec_index * WordsPerType + bit_index / 64];
+    }
+
+    uint64_t
+    word(int vec_index, NodeID bit_index) const
+    {
+        return m_bits[vec_index * WordsPerType + bit_index / 64];
+    }
+
+    static uint64_t bitMask(NodeID bit_index)
+    {
+        return uint64_t(1) << (bit_index % 64);
+    }
+
+    std::array<uint64_t, NumWords> m_bits;
 };
 
 inline std::ostream&
@@ -125,4 +156,16 @@ operator<<(std::ostream& out, const NetDest& obj)
 } // namespace ruby
 } // namespace gem5
 
+namespace std
+{
+    template<>
+    struct hash<gem5::ruby::NetDest>
+    {
+        inline size_t operator()(const gem5::ruby::NetDest& dest) const
+        {
+            return dest.hash();
+        }
+    };
+} // namespace std
+
 #endif // __MEM_RUBY_COMMON_NETDEST_HH__
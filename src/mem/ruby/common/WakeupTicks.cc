@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020-2021 ARM Limited
+ * All rights reserved.
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2012 Mark D. Hill and David A. Wood
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/common/WakeupTicks.hh"
+
+#include <algorithm>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+WakeupTicks::WakeupTicks(Tick period)
+    : m_wakeup_window(0), m_window_base(0), m_window_period(period)
+{
+}
+
+bool
+WakeupTicks::contains(Tick time) const
+{
+    if (time % m_window_period == 0) {
+        const uint64_t offset = time / m_window_period - m_window_base;
+        if (offset < WindowCycles && bits(m_wakeup_window, offset))
+            return true;
+    }
+    return m_far_wakeup_ticks.find(time) != m_far_wakeup_ticks.end();
+}
+
+void
+WakeupTicks::setPeriod(Tick period)
+{
+    if (period == m_window_period)
+        return;
+
+    // The clock changed, so the window no longer matches clock edges.
+    // Keep the wakeups it holds as plain ticks.
+    for (uint64_t w = m_wakeup_window; w; w &= w - 1) {
+        m_far_wakeup_ticks.insert(
+            (m_window_base + findLsbSet(w)) * m_window_period);
+    }
+    m_wakeup_window = 0;
+    m_window_period = period;
+}
+
+void
+WakeupTicks::add(Tick when)
+{
+    if (when % m_window_period != 0) {
+        m_far_wakeup_ticks.insert(when);
+        return;
+    }
+
+    const uint64_t cycle = when / m_window_period;
+    if (!m_wakeup_window) {
+        m_window_base = cycle;
+    } else if (cycle < m_window_base) {
+        // Slide the window back if that doesn't push out any wakeup
+        const uint64_t shift = m_window_base - cycle;
+        if (shift >= WindowCycles ||
+            findMsbSet(m_wakeup_window) + shift >= WindowCycles) {
+            m_far_wakeup_ticks.insert(when);
+            return;
+        }
+        m_wakeup_window <<= shift;
+        m_window_base = cycle;
+    }
+
+    const uint64_t offset = cycle - m_window_base;
+    if (offset < WindowCycles)
+        m_wakeup_window |= 1ULL << offset;
+    else
+        m_far_wakeup_ticks.insert(when);
+}
+
+void
+WakeupTicks::consume(Tick when)
+{
+    // Wakeups are consumed in order, so any wakeup before this one is
+    // stale and is dropped along with it
+    const uint64_t cycle = when / m_window_period;
+    if (cycle >= m_window_base) {
+        const uint64_t offset = cycle - m_window_base;
+        if (offset + 1 < WindowCycles)
+            m_wakeup_window &= ~0ULL << (offset + 1);
+        else
+            m_wakeup_window = 0;
+    }
+    m_far_wakeup_ticks.erase(m_far_wakeup_ticks.begin(),
+                             m_far_wakeup_ticks.upper_bound(when));
+
+    // Move the start of the window up to the earliest wakeup left in
+    // it, so it covers as many future cycles as possible
+    if (m_wakeup_window) {
+        const int first = findLsbSet(m_wakeup_window);
+        m_wakeup_window >>= first;
+        m_window_base += first;
+    }
+}
+
+Tick
+WakeupTicks::next(Tick now) const
+{
+    Tick when = MaxTick;
+
+    uint64_t window = m_wakeup_window;
+    const uint64_t now_cycle = divCeil(now, m_window_period);
+    if (now_cycle > m_window_base) {
+        const uint64_t skip = now_cycle - m_window_base;
+        window = skip < WindowCycles ? window & (~0ULL << skip) : 0;
+    }
+    if (window)
+        when = (m_window_base + findLsbSet(window)) * m_window_period;
+
+    auto it = m_far_wakeup_ticks.lower_bound(now);
+    if (it != m_far_wakeup_ticks.end())
+        when = std::min(when, *it);
+
+    return when;
+}
+
+} // namespace ruby
+} // namespace gem5
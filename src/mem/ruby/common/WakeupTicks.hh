@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020-2021 ARM Limited
+ * All rights reserved.
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Copyright (c) 2012 Mark D. Hill and David A. Wood
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The ticks a Consumer has pending wakeups at.
+ */
+
+#ifndef __MEM_RUBY_COMMON_WAKEUPTICKS_HH__
+#define __MEM_RUBY_COMMON_WAKEUPTICKS_HH__
+
+#include <cstdint>
+#include <set>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * A set of wakeup ticks. Pending wakeups are almost always a few cycles
+ * away, so they are tracked in a bitmap covering a window of cycles: bit
+ * i stands for a wakeup at cycle m_window_base + i of the clock period
+ * the window was built with. The rare wakeups that fall outside of the
+ * window, or not on a clock edge, are kept, as ticks, in
+ * m_far_wakeup_ticks.
+ */
+class WakeupTicks
+{
+  public:
+    WakeupTicks(Tick period);
+
+    bool contains(Tick time) const;
+
+    /**
+     * Use a new clock period for the window. The wakeups the window
+     * holds are kept as plain ticks if the period changes.
+     */
+    void setPeriod(Tick period);
+
+    void add(Tick when);
+
+    /** Remove the wakeup at tick when, and any earlier one */
+    void consume(Tick when);
+
+    /** Earliest pending wakeup at or after tick now, MaxTick if none */
+    Tick next(Tick now) const;
+
+  private:
+    static constexpr int WindowCycles = 64;
+    uint64_t m_wakeup_window;
+    uint64_t m_window_base;
+    Tick m_window_period;
+    std::set<Tick> m_far_wakeup_ticks;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_COMMON_WAKEUPTICKS_HH__
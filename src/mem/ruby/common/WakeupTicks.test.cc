@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+
+#include "base/intmath.hh"
+#include "mem/ruby/common/WakeupTicks.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+namespace
+{
+
+/** The Consumer bookkeeping before the window, a plain set of ticks */
+struct ReferenceTicks
+{
+    std::set<Tick> ticks;
+
+    bool contains(Tick time) const { return ticks.count(time); }
+    void add(Tick when) { ticks.insert(when); }
+
+    void
+    consume(Tick when)
+    {
+        ticks.erase(ticks.begin(), ticks.upper_bound(when));
+    }
+
+    Tick
+    next(Tick now) const
+    {
+        auto it = ticks.lower_bound(now);
+        return it == ticks.end() ? MaxTick : *it;
+    }
+};
+
+/**
+ * Schedule and consume random wakeups, as a Consumer does, and check
+ * that the window and a plain set agree on all of them.
+ *
+ * @param far_percent Percentage of wakeups outside of the window.
+ * @param change_percent Percentage of steps that change the clock.
+ */
+void
+checkWakeups(unsigned seed, unsigned far_percent, unsigned change_percent)
+{
+    std::mt19937_64 rng(seed);
+    Tick period = 1000;
+    Tick now = 0;
+    WakeupTicks wakeups(period);
+    ReferenceTicks reference;
+
+    for (int i = 0; i < 100000; ++i) {
+        if (rng() % 100 < change_percent) {
+            period = 250 * (1 + rng() % 8);
+            wakeups.setPeriod(period);
+        }
+
+        const unsigned op = rng() % 4;
+        if (op < 2) {
+            // Mostly clock edges a few cycles ahead, as scheduleEvent
+            // does, and sometimes far away or off the clock edges
+            const Tick edge = divCeil(now, period) * period;
+            Tick when = edge + period * (rng() % 8);
+            if (rng() % 100 < far_percent)
+                when = now + rng() % (200 * period);
+            wakeups.add(when);
+            reference.add(when);
+        } else if (op == 2) {
+            // Wake up at the next wakeup
+            const Tick when = reference.next(now);
+            ASSERT_EQ(wakeups.next(now), when);
+            if (when != MaxTick) {
+                ASSERT_TRUE(wakeups.contains(when));
+                wakeups.consume(when);
+                reference.consume(when);
+                now = when;
+            }
+        } else {
+            const Tick time = now + period * (rng() % 80) +
+                (rng() % 2 ? 0 : rng() % period);
+            ASSERT_EQ(wakeups.contains(time), reference.contains(time));
+            ASSERT_EQ(wakeups.next(time), reference.next(time));
+        }
+        ASSERT_EQ(wakeups.next(now), reference.next(now));
+    }
+}
+
+} // anonymous namespace
+
+/** Wakeups a few cycles ahead, at a fixed clock */
+TEST(WakeupTicksTest, Near)
+{
+    for (unsigned seed = 0; seed < 4; ++seed)
+        checkWakeups(seed, 0, 0);
+}
+
+/** Wakeups outside of the window and off the clock edges */
+TEST(WakeupTicksTest, Far)
+{
+    for (unsigned seed = 0; seed < 4; ++seed)
+        checkWakeups(seed, 20, 0);
+}
+
+/** Wakeups across clock period changes */
+TEST(WakeupTicksTest, ClockChange)
+{
+    for (unsigned seed = 0; seed < 4; ++seed)
+        checkWakeups(seed, 10, 1);
+}
@@ -39,8 +39,7 @@ namespace ruby
 {
 
 WriteMask::WriteMask()
-    : mSize(RubySystem::getBlockSizeBytes()), mMask(mSize, false),
-      mAtomic(false)
+    : WriteMask(RubySystem::getBlockSizeBytes())
 {}
 
 void
@@ -48,7 +47,7 @@ WriteMask::print(std::ostream& out) const
 {
     std::string str(mSize,'0');
     for (int i = 0; i < mSize; i++) {
-        str[i] = mMask[i] ? ('1') : ('0');
+        str[i] = test(i) ? ('1') : ('0');
     }
     out << "dirty mask="
         << str
@@ -57,10 +56,9 @@ WriteMask::print(std::ostream& out) const
 
 void
 WriteMask::performAtomic(uint8_t * p,
-        std::deque<uint8_t*>& log, bool isAtomicNoReturn) const
+        std::vector<uint8_t>& log, bool isAtomicNoReturn) const
 {
     int offset;
-    uint8_t *block_update;
     // Here, operations occur in FIFO order from the mAtomicOp
     // vector. This is done to match the ordering of packets
     // that was seen when the initial coalesced request was created.
@@ -68,9 +66,7 @@ WriteMask::performAtomic(uint8_t * p,
         if (!isAtomicNoReturn) {
             // Save the old value of the data block in case a
             // return value is needed
-            block_update = new uint8_t[mSize];
-            std::memcpy(block_update, p, mSize);
-            log.push_back(block_update);
+            log.insert(log.end(), p, p + mSize);
         }
         // Perform the atomic operation
         offset = mAtomicOp[i].first;
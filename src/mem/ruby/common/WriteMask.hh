@@ -41,12 +41,16 @@
 #ifndef __MEM_RUBY_COMMON_WRITEMASK_HH__
 #define __MEM_RUBY_COMMON_WRITEMASK_HH__
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <vector>
 
 #include "base/amo.hh"
+#include "base/bitfield.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/common/TypeDefines.hh"
 
@@ -56,55 +60,73 @@ namespace gem5
 namespace ruby
 {
 
+/**
+ * Byte mask of a cache block. The mask is a fixed array of 64 bit
+ * words, so that copying it (it travels with every message carrying a
+ * partial write) costs a few words and no allocation, and so that the
+ * set operations work a word at a time.
+ */
 class WriteMask
 {
   public:
     typedef std::vector<std::pair<int, AtomicOpFunctor* >> AtomicOpVector;
 
+    /** Largest block size a mask can cover */
+    static constexpr int MaxSize = 256;
+
     WriteMask();
 
     WriteMask(int size)
-      : mSize(size), mMask(size, false), mAtomic(false)
-    {}
+      : mSize(size), mMask{}, mAtomic(false)
+    {
+        assert(size <= MaxSize);
+    }
 
     WriteMask(int size, std::vector<bool> & mask)
-      : mSize(size), mMask(mask), mAtomic(false)
-    {}
+      : WriteMask(size)
+    {
+        setFromVector(mask);
+    }
 
     WriteMask(int size, std::vector<bool> &mask, AtomicOpVector atomicOp)
-      : mSize(size), mMask(mask), mAtomic(true), mAtomicOp(atomicOp)
-    {}
+      : WriteMask(size)
+    {
+        setFromVector(mask);
+        mAtomic = true;
+        mAtomicOp = std::move(atomicOp);
+    }
 
     ~WriteMask()
     {}
 
+    int getSize() const { return mSize; }
+
     void
     clear()
     {
-        mMask = std::vector<bool>(mSize, false);
+        mMask.fill(0);
     }
 
     bool
     test(int offset) const
     {
         assert(offset < mSize);
-        return mMask[offset];
+        return bits(mMask[offset / 64], offset % 64);
     }
 
     void
     setMask(int offset, int len, bool val = true)
     {
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            mMask[offset + i] = val;
+        for (int w = 0; w < NumWords; w++) {
+            const uint64_t m = wordMask(w, offset, offset + len);
+            mMask[w] = val ? (mMask[w] | m) : (mMask[w] & ~m);
         }
     }
     void
     fillMask()
     {
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = true;
-        }
+        setMask(0, mSize);
     }
 
     bool
@@ -112,8 +134,9 @@ class WriteMask
     {
         bool tmp = true;
         assert(mSize >= (offset + len));
-        for (int i = 0; i < len; i++) {
-            tmp = tmp & mMask.at(offset + i);
+        for (int w = 0; w < NumWords; w++) {
+            const uint64_t m = wordMask(w, offset, offset + len);
+            tmp &= (mMask[w] & m) == m;
         }
         return tmp;
     }
@@ -121,57 +144,46 @@ class WriteMask
     bool
     isOverlap(const WriteMask &readMask) const
     {
-        bool tmp = false;
+        uint64_t tmp = 0;
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp | mMask.at(i);
-            }
-        }
-        return tmp;
+        for (int w = 0; w < NumWords; w++)
+            tmp |= mMask[w] & readMask.mMask[w];
+        return tmp != 0;
     }
 
     bool
     containsMask(const WriteMask &readMask) const
     {
-        bool tmp = true;
+        uint64_t missing = 0;
         assert(mSize == readMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            if (readMask.mMask.at(i)) {
-                tmp = tmp & mMask.at(i);
-            }
-        }
-        return tmp;
+        for (int w = 0; w < NumWords; w++)
+            missing |= readMask.mMask[w] & ~mMask[w];
+        return missing == 0;
     }
 
     bool isEmpty() const
     {
-        for (int i = 0; i < mSize; i++) {
-            if (mMask.at(i)) {
-                return false;
-            }
-        }
-        return true;
+        uint64_t tmp = 0;
+        for (int w = 0; w < NumWords; w++)
+            tmp |= mMask[w];
+        return tmp == 0;
     }
 
     bool
     isFull() const
     {
-        for (int i = 0; i < mSize; i++) {
-            if (!mMask.at(i)) {
-                return false;
-            }
-        }
-        return true;
+        bool tmp = true;
+        for (int w = 0; w < NumWords; w++)
+            tmp &= mMask[w] == wordMask(w, 0, mSize);
+        return tmp;
     }
 
     void
     andMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) && (writeMask.mMask.at(i));
-        }
+        for (int w = 0; w < NumWords; w++)
+            mMask[w] &= writeMask.mMask[w];
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -183,9 +195,8 @@ class WriteMask
     orMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = (mMask.at(i)) || (writeMask.mMask.at(i));
-        }
+        for (int w = 0; w < NumWords; w++)
+            mMask[w] |= writeMask.mMask[w];
 
         if (writeMask.mAtomic) {
             mAtomic = true;
@@ -197,17 +208,19 @@ class WriteMask
     setInvertedMask(const WriteMask & writeMask)
     {
         assert(mSize == writeMask.mSize);
-        for (int i = 0; i < mSize; i++) {
-            mMask[i] = !writeMask.mMask.at(i);
-        }
+        for (int w = 0; w < NumWords; w++)
+            mMask[w] = ~writeMask.mMask[w] & wordMask(w, 0, mSize);
     }
 
     int
     firstBitSet(bool val, int offset = 0) const
     {
-        for (int i = offset; i < mSize; ++i)
-            if (mMask[i] == val)
-                return i;
+        for (int w = offset / 64; w < NumWords; ++w) {
+            const uint64_t word = (val ? mMask[w] : ~mMask[w]) &
+                wordMask(w, offset, mSize);
+            if (word)
+                return w * 64 + findLsbSet(word);
+        }
         return mSize;
     }
 
@@ -215,8 +228,8 @@ class WriteMask
     count(int offset = 0) const
     {
         int count = 0;
-        for (int i = offset; i < mSize; ++i)
-            count += mMask[i];
+        for (int w = 0; w < NumWords; ++w)
+            count += popCount(mMask[w] & wordMask(w, offset, mSize));
         return count;
     }
 
@@ -225,12 +238,12 @@ class WriteMask
     /*
      * Performs atomic operations on the data block pointed to by p. The
      * atomic operations to perform are in the vector mAtomicOp. The
-     * effect of each atomic operation is pushed to the atomicChangeLog
-     * so that each individual atomic requestor may see the results of their
-     * specific atomic operation.
+     * effect of each atomic operation is appended to the atomicChangeLog,
+     * one block per operation, so that each individual atomic requestor
+     * may see the results of their specific atomic operation.
      */
     void performAtomic(uint8_t * p,
-            std::deque<uint8_t*>& atomicChangeLog,
+            std::vector<uint8_t>& atomicChangeLog,
             bool isAtomicNoReturn=true) const;
 
     const AtomicOpVector&
@@ -247,8 +260,31 @@ class WriteMask
     }
 
   private:
+    static constexpr int NumWords = MaxSize / 64;
+
+    /** The bits of the byte range [lo, hi) that fall in word w */
+    static uint64_t
+    wordMask(int w, int lo, int hi)
+    {
+        const int start = std::max(lo - w * 64, 0);
+        const int end = std::min(hi - w * 64, 64);
+        if (start >= end)
+            return 0;
+        return mask(end - start) << start;
+    }
+
+    void
+    setFromVector(const std::vector<bool> &mask)
+    {
+        assert(mask.size() <= mSize);
+        for (int i = 0; i < mask.size(); i++) {
+            if (mask[i])
+                mMask[i / 64] |= uint64_t(1) << (i % 64);
+        }
+    }
+
     int mSize;
-    std::vector<bool> mMask;
+    std::array<uint64_t, NumWords> mMask;
     bool mAtomic;
     AtomicOpVector mAtomicOp;
 };
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "base/amo.hh"
+#include "mem/ruby/common/DataBlock.hh"
+#include "mem/ruby/common/WriteMask.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+using namespace gem5;
+using namespace gem5::ruby;
+
+// The tests don't build a RubySystem, only the block size it sets up
+uint32_t RubySystem::m_block_size_bytes = 64;
+uint32_t RubySystem::m_block_size_bits = 6;
+
+namespace
+{
+
+/** The mask as one bool per byte, as it was before using words */
+struct ReferenceMask
+{
+    std::vector<bool> bytes;
+
+    ReferenceMask(int size) : bytes(size, false) {}
+
+    void
+    set(int offset, int len, bool val)
+    {
+        for (int i = offset; i < offset + len; ++i)
+            bytes[i] = val;
+    }
+
+    bool
+    get(int offset, int len) const
+    {
+        for (int i = offset; i < offset + len; ++i) {
+            if (!bytes[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+/** Set or clear a few random ranges of both masks */
+void
+randomize(std::mt19937 &rng, WriteMask &mask, ReferenceMask &reference)
+{
+    const int size = mask.getSize();
+    const int ranges = rng() % 4;
+    for (int i = 0; i < ranges; ++i) {
+        const int offset = rng() % size;
+        const int len = rng() % (size - offset + 1);
+        const bool val = rng() % 4;
+        mask.setMask(offset, len, val);
+        reference.set(offset, len, val);
+    }
+}
+
+void
+checkMask(const WriteMask &mask, const ReferenceMask &reference)
+{
+    const int size = mask.getSize();
+    int count = 0;
+    for (int i = 0; i < size; ++i) {
+        ASSERT_EQ(mask.test(i), reference.bytes[i]) << "byte " << i;
+        count += reference.bytes[i];
+    }
+    ASSERT_EQ(mask.count(), count);
+    ASSERT_EQ(mask.isEmpty(), count == 0);
+    ASSERT_EQ(mask.isFull(), count == size);
+
+    for (int offset = 0; offset < size; offset += 7) {
+        int first_set = offset, first_clear = offset;
+        while (first_set < size && !reference.bytes[first_set])
+            ++first_set;
+        while (first_clear < size && reference.bytes[first_clear])
+            ++first_clear;
+        ASSERT_EQ(mask.firstBitSet(true, offset), first_set);
+        ASSERT_EQ(mask.firstBitSet(false, offset), first_clear);
+        for (int len = 0; offset + len <= size; len += 13)
+            ASSERT_EQ(mask.getMask(offset, len), reference.get(offset, len));
+    }
+}
+
+} // anonymous namespace
+
+/** Setting and clearing ranges across words, for every mask size */
+TEST(WriteMaskTest, SetMask)
+{
+    std::mt19937 rng(1);
+    for (int size : { 16, 64, 100, 128, 256 }) {
+        for (int i = 0; i < 500; ++i) {
+            WriteMask mask(size);
+            ReferenceMask reference(size);
+            randomize(rng, mask, reference);
+            checkMask(mask, reference);
+
+            mask.fillMask();
+            reference.set(0, size, true);
+            checkMask(mask, reference);
+        }
+    }
+}
+
+/** Operations between two masks match doing them byte by byte */
+TEST(WriteMaskTest, TwoMasks)
+{
+    std::mt19937 rng(2);
+    for (int size : { 16, 64, 100, 128, 256 }) {
+        for (int i = 0; i < 500; ++i) {
+            WriteMask a(size), b(size);
+            ReferenceMask ref_a(size), ref_b(size);
+            randomize(rng, a, ref_a);
+            randomize(rng, b, ref_b);
+            // Make containment likely in some of the cases
+            if (rng() % 3 == 0) {
+                b.andMask(a);
+                for (int j = 0; j < size; ++j)
+                    ref_b.bytes[j] = ref_b.bytes[j] && ref_a.bytes[j];
+                checkMask(b, ref_b);
+            }
+
+            bool overlap = false, contains = true;
+            for (int j = 0; j < size; ++j) {
+                overlap |= ref_a.bytes[j] && ref_b.bytes[j];
+                contains &= ref_a.bytes[j] || !ref_b.bytes[j];
+            }
+            ASSERT_EQ(a.isOverlap(b), overlap);
+            ASSERT_EQ(a.containsMask(b), contains);
+
+            WriteMask inverted(size);
+            ReferenceMask ref_inverted(size);
+            inverted.setInvertedMask(a);
+            for (int j = 0; j < size; ++j)
+                ref_inverted.bytes[j] = !ref_a.bytes[j];
+            checkMask(inverted, ref_inverted);
+
+            a.orMask(b);
+            for (int j = 0; j < size; ++j)
+                ref_a.bytes[j] = ref_a.bytes[j] || ref_b.bytes[j];
+            checkMask(a, ref_a);
+        }
+    }
+}
+
+/** The log holds the block as it was before each atomic op */
+TEST(WriteMaskTest, AtomicLog)
+{
+    const int block_size = RubySystem::getBlockSizeBytes();
+    AtomicOpAdd<uint32_t> add(5);
+    AtomicOpInc<uint32_t> inc;
+    AtomicOpExch<uint32_t> exch(42);
+    std::vector<bool> bits(block_size, false);
+    WriteMask mask(block_size, bits,
+                   { { 0, &add }, { 4, &inc }, { 0, &exch } });
+
+    DataBlock src;
+    for (int i = 0; i < block_size; ++i)
+        src.setByte(i, i);
+
+    DataBlock dst;
+    dst.atomicPartial(src, mask, false);
+    ASSERT_EQ(dst.numAtomicLogEntries(), 3);
+
+    // Replay the ops on a copy of the block to get the expected entries
+    std::vector<uint8_t> block(src.getData(0, block_size),
+                               src.getData(0, block_size) + block_size);
+    std::vector<std::vector<uint8_t>> expected;
+    for (const auto &[offset, op] : mask.getAtomicOps()) {
+        expected.push_back(block);
+        (*op)(&block[offset]);
+    }
+    for (int i = 0; i < block_size; ++i)
+        EXPECT_EQ(dst.getByte(i), block[i]);
+
+    // A copy only holds the entries that weren't popped yet
+    DataBlock copy(dst);
+    EXPECT_TRUE(copy.equal(dst));
+    dst.popAtomicLogEntryFront();
+    EXPECT_EQ(dst.numAtomicLogEntries(), 2);
+    EXPECT_FALSE(copy.equal(dst));
+    DataBlock partial(dst);
+    EXPECT_EQ(partial.numAtomicLogEntries(), 2);
+
+    for (int entry = 0; entry < 3; ++entry) {
+        ASSERT_EQ(copy.numAtomicLogEntries(), 3 - entry);
+        const uint8_t *front = copy.getAtomicLogEntryFront();
+        EXPECT_EQ(std::vector<uint8_t>(front, front + block_size),
+                  expected[entry]);
+        if (entry) {
+            front = partial.getAtomicLogEntryFront();
+            EXPECT_EQ(std::vector<uint8_t>(front, front + block_size),
+                      expected[entry]);
+            partial.popAtomicLogEntryFront();
+        }
+        copy.popAtomicLogEntryFront();
+    }
+    EXPECT_EQ(copy.numAtomicLogEntries(), 0);
+    EXPECT_EQ(partial.numAtomicLogEntries(), 0);
+
+    // Without a return value, the ops are applied but not logged
+    DataBlock no_return;
+    no_return.atomicPartial(src, mask, true);
+    EXPECT_EQ(no_return.numAtomicLogEntries(), 0);
+    EXPECT_TRUE(no_return.equal(copy));
+}
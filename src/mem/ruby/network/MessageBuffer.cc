@@ -40,14 +40,17 @@
 
 #include "mem/ruby/network/MessageBuffer.hh"
 
+#include <algorithm>
 #include <cassert>
+#include <tuple>
+#include <utility>
 
 #include "base/cprintf.hh"
 #include "base/logging.hh"
-#include "base/random.hh"
 #include "base/stl_helpers.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/ruby/system/RubySystem.hh"
+#include "sim/eventq.hh"
 
 namespace gem5
 {
@@ -65,6 +68,7 @@ MessageBuffer::MessageBuffer(const Params &p)
     m_last_arrival_time(0), m_last_message_strict_fifo_bypassed(false),
     m_strict_fifo(p.ordered),
     m_randomization(p.randomization),
+    m_rng(p.name),
     m_allow_zero_latency(p.allow_zero_latency),
     m_routing_priority(p.routing_priority),
     ADD_STAT(m_not_avail_count, statistics::units::Count::get(),
@@ -202,14 +206,13 @@ MessageBuffer::peek() const
     return msg_ptr;
 }
 
-// FIXME - move me somewhere else
 Tick
-random_time()
+MessageBuffer::randomDelay()
 {
     Tick time = 1;
-    time += random_mt.random(0, 3);  // [0...3]
-    if (random_mt.random(0, 7) == 0) {  // 1 in 8 chance
-        time += 100 + random_mt.random(1, 15); // 100 + [1...15]
+    time += m_rng.random(0, 3);  // [0...3]
+    if (m_rng.random(0, 7) == 0) {  // 1 in 8 chance
+        time += 100 + m_rng.random(1, 15); // 100 + [1...15]
     }
     return time;
 }
@@ -218,15 +221,15 @@ void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
                        bool bypassStrictFIFO)
 {
-    // record current time incase we have a pop that also adjusts my size
-    if (m_time_last_time_enqueue < current_time) {
-        m_msgs_this_cycle = 0;  // first msg this cycle
-        m_time_last_time_enqueue = current_time;
+    // Messages from a producer on another event queue are handed over
+    // to the thread simulating the consumer
+    if (inParallelMode && m_consumer &&
+        m_consumer->getObject()->eventQueue() != curEventQueue()) {
+        enqueueRemote(std::move(message), current_time, delta,
+                      bypassStrictFIFO);
+        return;
     }
 
-    m_msg_counter++;
-    m_msgs_this_cycle++;
-
     // Calculate the arrival time of the message, that is, the first
     // cycle the message can be dequeued.
     panic_if((delta == 0) && !m_allow_zero_latency,
@@ -246,12 +249,29 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
             if (m_last_arrival_time < current_time) {
                 m_last_arrival_time = current_time;
             }
-            arrival_time = m_last_arrival_time + random_time();
+            arrival_time = m_last_arrival_time + randomDelay();
         } else {
-            arrival_time = current_time + random_time();
+            arrival_time = current_time + randomDelay();
         }
     }
 
+    insertMessage(std::move(message), current_time, arrival_time,
+                  bypassStrictFIFO);
+}
+
+void
+MessageBuffer::insertMessage(MsgPtr message, Tick current_time,
+                             Tick arrival_time, bool bypassStrictFIFO)
+{
+    // record current time incase we have a pop that also adjusts my size
+    if (m_time_last_time_enqueue < current_time) {
+        m_msgs_this_cycle = 0;  // first msg this cycle
+        m_time_last_time_enqueue = current_time;
+    }
+
+    m_msg_counter++;
+    m_msgs_this_cycle++;
+
     // Check the arrival time
     assert(arrival_time >= current_time);
     if (m_strict_fifo &&
@@ -259,8 +279,8 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
         if (arrival_time < m_last_arrival_time) {
             panic("FIFO ordering violated: %s name: %s current time: %d "
                   "delta: %d arrival_time: %d last arrival_time: %d\n",
-                  *this, name(), current_time, delta, arrival_time,
-                  m_last_arrival_time);
+                  *this, name(), current_time, arrival_time - current_time,
+                  arrival_time, m_last_arrival_time);
         }
     }
 
@@ -283,7 +303,7 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
     msg_ptr->setMsgCounter(m_msg_counter);
 
     // Insert the message into the priority heap
-    m_prio_heap.push_back(message);
+    m_prio_heap.push_back(std::move(message));
     push_heap(m_prio_heap.begin(), m_prio_heap.end(), std::greater<MsgPtr>());
     // Increment the number of messages statistic
     m_buf_msgs++;
@@ -292,7 +312,7 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
            ((m_prio_heap.size() + m_stall_map_size) <= m_max_size));
 
     DPRINTF(RubyQueue, "Enqueue arrival_time: %lld, Message: %s\n",
-            arrival_time, *(message.get()));
+            arrival_time, *msg_ptr);
 
     // Schedule the wakeup
     assert(m_consumer != NULL);
@@ -300,6 +320,76 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta,
     m_consumer->storeEventInfo(m_vnet_id);
 }
 
+void
+MessageBuffer::enqueueRemote(MsgPtr message, Tick current_time, Tick delta,
+                             bool bypassStrictFIFO)
+{
+    // The arrival time must lie beyond the end of the current quantum,
+    // so that the consumer can't have simulated it yet, and that it is
+    // known before the consumer gets there. Randomization isn't applied
+    // since it could break either.
+    const Tick arrival_time = current_time + delta;
+    panic_if(arrival_time < curTick() + simQuantum,
+             "%s: A message crossing event queues arrives after %d ticks, "
+             "which is less than the simulation quantum (%d ticks).\n",
+             name(), arrival_time - curTick(), simQuantum);
+    panic_if(m_max_size != 0,
+             "%s: Buffers between event queues must be unbounded.\n",
+             name());
+
+    // The messages arriving at the same tick are sorted by the queue
+    // and order they were sent in, which keeps the simulation
+    // deterministic regardless of the order the threads ran in.
+    static thread_local uint64_t remote_seq = 0;
+    RemoteMessage remote{std::move(message), current_time,
+                         curEventQueue()->index(), remote_seq++,
+                         bypassStrictFIFO};
+
+    bool first_at_tick;
+    {
+        std::lock_guard<std::mutex> lock(m_remote_mutex);
+        auto &pending = m_remote_msgs[arrival_time];
+        first_at_tick = pending.empty();
+        pending.push_back(std::move(remote));
+        m_remote_msg_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (first_at_tick) {
+        // Scheduling on another queue goes through its asynchronous
+        // insertion path, which is merged at the end of the quantum
+        auto *deliver = new EventFunctionWrapper(
+            [this, arrival_time]{ deliverRemote(arrival_time); },
+            name() + ".remoteDelivery", true);
+        m_consumer->getObject()->eventQueue()->schedule(deliver,
+                                                        arrival_time);
+    }
+}
+
+void
+MessageBuffer::deliverRemote(Tick arrival_time)
+{
+    std::vector<RemoteMessage> arrived;
+    {
+        std::lock_guard<std::mutex> lock(m_remote_mutex);
+        auto it = m_remote_msgs.find(arrival_time);
+        assert(it != m_remote_msgs.end());
+        arrived = std::move(it->second);
+        m_remote_msgs.erase(it);
+    }
+
+    std::sort(arrived.begin(), arrived.end(),
+              [](const RemoteMessage &a, const RemoteMessage &b) {
+                  return std::tie(a.srcQueue, a.seq) <
+                         std::tie(b.srcQueue, b.seq);
+              });
+
+    for (auto &remote : arrived) {
+        m_remote_msg_count.fetch_sub(1, std::memory_order_relaxed);
+        insertMessage(std::move(remote.msg), remote.sendTime, arrival_time,
+                      remote.bypassStrictFIFO);
+    }
+}
+
 Tick
 MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 {
@@ -577,6 +667,20 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read, WriteMask *mask)
         }
     }
 
+    // Check the messages still on their way from another event queue
+    std::lock_guard<std::mutex> lock(m_remote_mutex);
+    for (auto &pending : m_remote_msgs) {
+        for (auto &remote : pending.second) {
+            Message *msg = remote.msg.get();
+            if (is_read && !mask && msg->functionalRead(pkt))
+                return 1;
+            else if (is_read && mask && msg->functionalRead(pkt, *mask))
+                num_functional_accesses++;
+            else if (!is_read && msg->functionalWrite(pkt))
+                num_functional_accesses++;
+        }
+    }
+
     return num_functional_accesses;
 }
 
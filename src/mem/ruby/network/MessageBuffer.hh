@@ -47,13 +47,17 @@
 #define __MEM_RUBY_NETWORK_MESSAGEBUFFER_HH__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "base/random.hh"
 #include "base/trace.hh"
 #include "debug/RubyQueue.hh"
 #include "mem/packet.hh"
@@ -146,7 +150,12 @@ class MessageBuffer : public SimObject
     void unregisterDequeueCallback();
 
     void recycle(Tick current_time, Tick recycle_latency);
-    bool isEmpty() const { return m_prio_heap.size() == 0; }
+    bool
+    isEmpty() const
+    {
+        return m_prio_heap.size() == 0 &&
+            m_remote_msg_count.load(std::memory_order_relaxed) == 0;
+    }
     bool isStallMapEmpty() { return m_stall_msg_map.size() == 0; }
     unsigned int getStallMapSize() { return m_stall_msg_map.size(); }
 
@@ -196,6 +205,23 @@ class MessageBuffer : public SimObject
   private:
     void reanalyzeList(std::list<MsgPtr> &, Tick);
 
+    /** Random delay of a message when randomization is enabled */
+    Tick randomDelay();
+
+    /** Insert a message that can be dequeued from arrival_time on */
+    void insertMessage(MsgPtr message, Tick current_time,
+                       Tick arrival_time, bool bypassStrictFIFO);
+
+    /**
+     * Hand a message over from a producer simulated on another event
+     * queue than the consumer.
+     */
+    void enqueueRemote(MsgPtr message, Tick current_time, Tick delta,
+                       bool bypassStrictFIFO);
+
+    /** Insert the messages from other event queues arriving now */
+    void deliverRemote(Tick arrival_time);
+
     uint32_t functionalAccess(Packet *pkt, bool is_read, WriteMask *mask);
 
   private:
@@ -233,6 +259,24 @@ class MessageBuffer : public SimObject
     typedef std::unordered_map<Addr, std::vector<MsgPtr>> DeferredMsgMapType;
     DeferredMsgMapType m_deferred_msg_map;
 
+    struct RemoteMessage
+    {
+        MsgPtr msg;
+        Tick sendTime;
+        int srcQueue;
+        uint64_t seq;
+        bool bypassStrictFIFO;
+    };
+
+    /**
+     * Messages sent from other event queues, by arrival time. They are
+     * moved to m_prio_heap by the thread of the consumer when they
+     * arrive. Protected by m_remote_mutex.
+     */
+    std::map<Tick, std::vector<RemoteMessage>> m_remote_msgs;
+    std::mutex m_remote_mutex;
+    std::atomic<unsigned> m_remote_msg_count{0};
+
     /**
      * Current size of the stall map.
      * Track the number of messages held in stall map lists. This is used to
@@ -277,6 +321,8 @@ class MessageBuffer : public SimObject
 
     const bool m_strict_fifo;
     const MessageRandomization m_randomization;
+    // Stream of the random delays, private to this buffer
+    RandomStream m_rng;
     const bool m_allow_zero_latency;
 
     const int m_routing_priority;
@@ -294,8 +340,6 @@ class MessageBuffer : public SimObject
     statistics::Formula m_occupancy;
 };
 
-Tick random_time();
-
 inline std::ostream&
 operator<<(std::ostream& out, const MessageBuffer& obj)
 {
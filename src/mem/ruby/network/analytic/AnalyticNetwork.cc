@@ -0,0 +1,426 @@
+/*
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ * Copyright (c) 2008 Princeton University
+ * Copyright (c) 2016 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/ruby/network/analytic/AnalyticNetwork.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "base/logging.hh"
+#include "debug/RubyNetwork.hh"
+#include "mem/ruby/network/BasicLink.hh"
+#include "mem/ruby/network/BasicRouter.hh"
+#include "mem/ruby/network/MessageBuffer.hh"
+#include "mem/ruby/slicc_interface/Message.hh"
+#include "mem/ruby/system/RubySystem.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+namespace
+{
+
+MachineID
+globalToMachineID(NodeID global_id)
+{
+    for (int m = 0; m < (int) MachineType_NUM; m++) {
+        if ((global_id >= MachineType_base_number((MachineType) m)) &&
+            global_id < MachineType_base_number((MachineType) (m+1))) {
+            return {(MachineType) m,
+                global_id - MachineType_base_number((MachineType) m)};
+        }
+    }
+    panic("Node %d is not a valid machine\n", global_id);
+}
+
+} // anonymous namespace
+
+AnalyticNetwork::AnalyticNetwork(const Params &p)
+    : Network(p), Consumer(this),
+      m_window(p.utilization_window),
+      m_max_utilization(p.max_utilization),
+      networkStats(this, p.number_of_virtual_networks)
+{
+    fatal_if(m_window == 0, "%s: utilization_window must be non-zero\n",
+             name());
+    fatal_if(m_max_utilization <= 0 || m_max_utilization >= 1,
+             "%s: max_utilization must be between 0 and 1\n", name());
+
+    m_router_ports.resize(p.routers.size());
+    m_router_latency.resize(p.routers.size());
+    for (auto *router : p.routers) {
+        const int id = router->params().router_id;
+        fatal_if(id < 0 || id >= (int)p.routers.size(),
+                 "%s: router IDs must be consecutive\n", name());
+        m_router_latency[id] = router->params().latency;
+    }
+
+    m_node_in_link.resize(m_nodes, -1);
+    m_node_router.resize(m_nodes, -1);
+    m_last_arrival.resize(m_nodes,
+        std::vector<Tick>(p.number_of_virtual_networks, 0));
+}
+
+void
+AnalyticNetwork::init()
+{
+    Network::init();
+
+    // The topology pointer should have already been initialized in
+    // the parent class network constructor.
+    assert(m_topology_ptr != NULL);
+    m_topology_ptr->createLinks(this);
+
+    for (auto &queues : m_toNetQueues) {
+        for (auto *queue : queues) {
+            if (queue)
+                queue->setConsumer(this);
+        }
+    }
+}
+
+int
+AnalyticNetwork::addLink(BasicLink *link)
+{
+    fatal_if(link->m_bandwidth_factor <= 0,
+             "%s: link %s needs a positive bandwidth_factor\n",
+             name(), link->name());
+
+    Link l;
+    l.latency = link->m_latency;
+    l.bytesPerCycle = link->m_bandwidth_factor;
+    l.windowStart = Cycles(0);
+    l.windowBytes = 0;
+    l.utilization = 0;
+    l.totalBytes = 0;
+    m_links.push_back(l);
+    return m_links.size() - 1;
+}
+
+// From a switch to an endpoint node
+void
+AnalyticNetwork::makeExtOutLink(SwitchID src, NodeID global_dest,
+                                BasicLink* link,
+                                std::vector<NetDest>& routing_table_entry)
+{
+    assert(getLocalNodeID(global_dest) < m_nodes);
+    m_router_ports[src].push_back(
+        {addLink(link), link->m_weight, -1, routing_table_entry});
+}
+
+// From an endpoint node to a switch
+void
+AnalyticNetwork::makeExtInLink(NodeID global_src, SwitchID dest,
+                               BasicLink* link,
+                               std::vector<NetDest>& routing_table_entry)
+{
+    NodeID local_src = getLocalNodeID(global_src);
+    assert(local_src < m_nodes);
+    m_node_in_link[local_src] = addLink(link);
+    m_node_router[local_src] = dest;
+}
+
+// From a switch to a switch
+void
+AnalyticNetwork::makeInternalLink(SwitchID src, SwitchID dest,
+                                  BasicLink* link,
+                                  std::vector<NetDest>& routing_table_entry,
+                                  PortDirection src_outport,
+                                  PortDirection dst_inport)
+{
+    m_router_ports[src].push_back(
+        {addLink(link), link->m_weight, (int)dest, routing_table_entry});
+}
+
+const AnalyticNetwork::Route &
+AnalyticNetwork::getRoute(NodeID local_src, NodeID global_dest, int vnet)
+{
+    const uint64_t key =
+        ((uint64_t)local_src * MachineType_base_number(MachineType_NUM) +
+         global_dest) * m_virtual_networks + vnet;
+    auto it = m_routes.find(key);
+    if (it != m_routes.end())
+        return it->second;
+
+    const MachineID dest_machine = globalToMachineID(global_dest);
+
+    Route route;
+    panic_if(m_node_in_link[local_src] == -1,
+             "%s: node %d is not connected\n", name(), local_src);
+    route.links.push_back(m_node_in_link[local_src]);
+    route.routerLatency.push_back(Cycles(0));
+
+    // Follow the routing tables built by the topology, taking the
+    // lowest weight link towards the destination at every router,
+    // like the other networks do without adaptive routing
+    int router = m_node_router[local_src];
+    while (router != -1) {
+        panic_if(route.links.size() > m_links.size(),
+                 "%s: routing loop from node %d to node %d\n",
+                 name(), local_src, global_dest);
+
+        const OutPort *best = nullptr;
+        for (const auto &port : m_router_ports[router]) {
+            if (port.routes[vnet].isElement(dest_machine) &&
+                (!best || port.weight < best->weight)) {
+                best = &port;
+            }
+        }
+        panic_if(!best, "%s: no route from router %d to node %d on "
+                 "vnet %d\n", name(), router, global_dest, vnet);
+
+        route.links.push_back(best->link);
+        route.routerLatency.push_back(m_router_latency[router]);
+        router = best->router;
+    }
+
+    return m_routes.emplace(key, std::move(route)).first->second;
+}
+
+Cycles
+AnalyticNetwork::traverseLink(Link &link, Cycles when, unsigned bytes,
+                              Cycles &queueing)
+{
+    // Close the window when the message falls past its end. If more
+    // than one window went by the link has been idle since.
+    if (when >= link.windowStart + m_window) {
+        const Cycles elapsed = when - link.windowStart;
+        link.utilization = elapsed < 2 * m_window ?
+            link.windowBytes / (link.bytesPerCycle * m_window) : 0;
+        link.windowStart = when - Cycles(elapsed % m_window);
+        link.windowBytes = 0;
+    }
+    link.windowBytes += bytes;
+    link.totalBytes += bytes;
+
+    const double service = bytes / link.bytesPerCycle;
+    const double rho = std::min(link.utilization, m_max_utilization);
+
+    // Mean waiting time of an M/D/1 queue
+    queueing = Cycles(std::lround(service * rho / (2 * (1 - rho))));
+
+    return link.latency + Cycles(std::ceil(service)) + queueing;
+}
+
+bool
+AnalyticNetwork::injectMessage(NodeID local_src, int vnet,
+                               MessageBuffer *queue)
+{
+    const Tick now = clockEdge();
+    MsgPtr msg = queue->peekMsgPtr();
+    std::vector<NodeID> dests = msg->getDestination().getAllDest();
+
+    // Hold the message back until every destination has room, as
+    // there is nowhere in the network to buffer it
+    for (NodeID dest : dests) {
+        MessageBuffer *buffer =
+            m_fromNetQueues[getLocalNodeID(dest)][vnet];
+        if (!buffer->areNSlotsAvailable(1, now))
+            return false;
+    }
+
+    queue->dequeue(now);
+
+    const unsigned bytes = MessageSizeType_to_int(msg->getMessageSize());
+    networkStats.m_msg_counts[msg->getMessageSize()]++;
+    networkStats.m_msg_bytes[msg->getMessageSize()] += bytes;
+
+    for (int i = 0; i < dests.size(); i++) {
+        const NodeID dest = dests[i];
+        const NodeID local_dest = getLocalNodeID(dest);
+        const Route &route = getRoute(local_src, dest, vnet);
+
+        Cycles latency = Cycles(0);
+        Cycles queueing = Cycles(0);
+        for (int hop = 0; hop < route.links.size(); hop++) {
+            Cycles link_queueing;
+            latency += route.routerLatency[hop];
+            latency += traverseLink(m_links[route.links[hop]],
+                                    curCycle() + latency, bytes,
+                                    link_queueing);
+            queueing += link_queueing;
+        }
+
+        Tick arrival = std::max(now + cyclesToTicks(latency),
+                                m_last_arrival[local_dest][vnet]);
+        m_last_arrival[local_dest][vnet] = arrival;
+
+        // Every destination gets its own copy addressed to it only,
+        // and the last one takes the original
+        MsgPtr out_msg = msg;
+        if (dests.size() > 1) {
+            if (i != dests.size() - 1)
+                out_msg = msg->clone();
+            NetDest personal_dest;
+            personal_dest.add(globalToMachineID(dest));
+            out_msg->getDestination() = personal_dest;
+        }
+
+        DPRINTF(RubyNetwork, "Node %d sends %s to node %d on vnet %d, "
+                "latency %d cycles (%d queueing)\n", local_src, *out_msg,
+                local_dest, vnet, ticksToCycles(arrival - now), queueing);
+
+        m_fromNetQueues[local_dest][vnet]->enqueue(std::move(out_msg), now,
+                                                   arrival - now);
+
+        networkStats.m_packets_injected[vnet]++;
+        networkStats.m_packets_received[vnet]++;
+        networkStats.m_packet_network_latency[vnet] +=
+            ticksToCycles(arrival - now) - queueing;
+        networkStats.m_packet_queueing_latency[vnet] += queueing;
+        networkStats.m_total_hops += route.links.size() - 1;
+    }
+
+    return true;
+}
+
+void
+AnalyticNetwork::wakeup()
+{
+    const Tick now = clockEdge();
+    bool stalled = false;
+
+    for (NodeID node = 0; node < m_nodes; node++) {
+        for (int vnet = 0; vnet < m_toNetQueues[node].size(); vnet++) {
+            MessageBuffer *queue = m_toNetQueues[node][vnet];
+            if (!queue)
+                continue;
+
+            while (queue->isReady(now)) {
+                if (!injectMessage(node, vnet, queue)) {
+                    stalled = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Messages that are not ready yet wake us up when they are, but
+    // the ones waiting for space at their destination need a retry
+    if (stalled)
+        scheduleEvent(Cycles(1));
+}
+
+void
+AnalyticNetwork::collateStats()
+{
+    RubySystem *rs = params().ruby_system;
+    double time_delta = double(curCycle() - rs->getStartCycle());
+
+    if (time_delta == 0 || m_links.empty())
+        return;
+
+    double utilization = 0;
+    for (const auto &link : m_links)
+        utilization += link.totalBytes / link.bytesPerCycle / time_delta;
+    networkStats.m_average_link_utilization = utilization / m_links.size();
+}
+
+void
+AnalyticNetwork::print(std::ostream& out) const
+{
+    out << "[AnalyticNetwork]";
+}
+
+AnalyticNetwork::
+NetworkStats::NetworkStats(statistics::Group *parent, int num_vnets)
+    : statistics::Group(parent),
+      ADD_STAT(m_packets_injected, statistics::units::Count::get(),
+               "Packets sent into the network"),
+      ADD_STAT(m_packets_received, statistics::units::Count::get(),
+               "Packets delivered by the network"),
+      ADD_STAT(m_packet_network_latency, statistics::units::Cycle::get(),
+               "Total latency of the packets, excluding queueing"),
+      ADD_STAT(m_packet_queueing_latency, statistics::units::Cycle::get(),
+               "Total time packets spent queueing for links"),
+      ADD_STAT(m_avg_packet_vnet_latency, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average network latency per vnet",
+               m_packet_network_latency / m_packets_received),
+      ADD_STAT(m_avg_packet_vqueue_latency, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average queueing latency per vnet",
+               m_packet_queueing_latency / m_packets_received),
+      ADD_STAT(m_avg_packet_network_latency, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average network latency",
+               sum(m_packet_network_latency) / sum(m_packets_received)),
+      ADD_STAT(m_avg_packet_queueing_latency, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average queueing latency",
+               sum(m_packet_queueing_latency) / sum(m_packets_received)),
+      ADD_STAT(m_avg_packet_latency, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average packet latency",
+               m_avg_packet_network_latency + m_avg_packet_queueing_latency),
+      ADD_STAT(m_total_hops, statistics::units::Count::get(),
+               "Total hops taken by the packets"),
+      ADD_STAT(m_avg_hops, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Count>::get(),
+               "Average hops taken by a packet",
+               m_total_hops / sum(m_packets_received)),
+      ADD_STAT(m_average_link_utilization, statistics::units::Ratio::get(),
+               "Average fraction of cycles the links were busy"),
+      ADD_STAT(m_msg_counts, statistics::units::Count::get(),
+               "Messages sent, by message size type"),
+      ADD_STAT(m_msg_bytes, statistics::units::Byte::get(),
+               "Bytes sent, by message size type")
+{
+    m_packets_injected.init(num_vnets).flags(statistics::pdf |
+        statistics::total | statistics::nozero | statistics::oneline);
+    m_packets_received.init(num_vnets).flags(statistics::pdf |
+        statistics::total | statistics::nozero | statistics::oneline);
+    m_packet_network_latency.init(num_vnets).flags(statistics::oneline);
+    m_packet_queueing_latency.init(num_vnets).flags(statistics::oneline);
+    m_avg_packet_vnet_latency.flags(statistics::oneline);
+    m_avg_packet_vqueue_latency.flags(statistics::oneline);
+
+    for (int i = 0; i < num_vnets; i++) {
+        m_packets_injected.subname(i, csprintf("vnet-%i", i));
+        m_packets_received.subname(i, csprintf("vnet-%i", i));
+        m_packet_network_latency.subname(i, csprintf("vnet-%i", i));
+        m_packet_queueing_latency.subname(i, csprintf("vnet-%i", i));
+    }
+
+    m_msg_counts.init(MessageSizeType_NUM).flags(statistics::nozero);
+    m_msg_bytes.init(MessageSizeType_NUM).flags(statistics::nozero);
+    for (MessageSizeType type = MessageSizeType_FIRST;
+         type < MessageSizeType_NUM; ++type) {
+        m_msg_counts.subname(type, MessageSizeType_to_string(type));
+        m_msg_bytes.subname(type, MessageSizeType_to_string(type));
+    }
+}
+
+} // namespace ruby
+} // namespace gem5
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2020 Advanced Micro Devices, Inc.
+ * Copyright (c) 2008 Princeton University
+ * Copyright (c) 2016 Georgia Institute of Technology
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_NETWORK_ANALYTIC_ANALYTICNETWORK_HH__
+#define __MEM_RUBY_NETWORK_ANALYTIC_ANALYTICNETWORK_HH__
+
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "mem/ruby/common/Consumer.hh"
+#include "mem/ruby/common/NetDest.hh"
+#include "mem/ruby/network/Network.hh"
+#include "params/AnalyticNetwork.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+class MessageBuffer;
+
+/**
+ * A network that doesn't move messages hop by hop. When a message is
+ * injected its route through the topology is looked up and the latency
+ * of every link on the way is computed from a contention model, and the
+ * message is enqueued at its destination with the total latency. This
+ * costs a single event per message, yet unlike the SimpleNetwork the
+ * latency grows with the load on the links it crosses.
+ *
+ * Each link tracks the bytes sent over it in windows of a fixed number
+ * of cycles. The utilization of the last complete window predicts the
+ * queueing delay of a message on that link, following an M/D/1 queue.
+ */
+class AnalyticNetwork : public Network, public Consumer
+{
+  public:
+    PARAMS(AnalyticNetwork);
+
+    AnalyticNetwork(const Params &p);
+    ~AnalyticNetwork() = default;
+
+    void init();
+
+    void wakeup();
+
+    // Methods used by Topology to setup the network
+    void makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
+                     std::vector<NetDest>& routing_table_entry);
+    void makeExtInLink(NodeID src, SwitchID dest, BasicLink* link,
+                    std::vector<NetDest>& routing_table_entry);
+    void makeInternalLink(SwitchID src, SwitchID dest, BasicLink* link,
+                          std::vector<NetDest>& routing_table_entry,
+                          PortDirection src_outport,
+                          PortDirection dst_inport);
+
+    void collateStats();
+    void print(std::ostream& out) const;
+
+    /*
+     * Messages in flight are already in their destination buffers,
+     * which the controllers search themselves, so the network never
+     * holds any data.
+     */
+    bool functionalRead(Packet *pkt) { return false; }
+    bool functionalRead(Packet *pkt, WriteMask &mask) { return false; }
+    uint32_t functionalWrite(Packet *pkt) { return 0; }
+
+  private:
+    struct Link
+    {
+        Cycles latency;
+        double bytesPerCycle;
+
+        // Utilization tracking
+        Cycles windowStart;
+        uint64_t windowBytes;
+        double utilization;
+
+        // Total bytes sent, for the link utilization stats
+        uint64_t totalBytes;
+    };
+
+    struct OutPort
+    {
+        int link;
+        int weight;
+        // Router at the far end, or -1 if the link leads to a node
+        int router;
+        std::vector<NetDest> routes;
+    };
+
+    /**
+     * The links a message crosses, and the latency of the router it
+     * goes through before each of them
+     */
+    struct Route
+    {
+        std::vector<int> links;
+        std::vector<Cycles> routerLatency;
+    };
+
+    int addLink(BasicLink *link);
+
+    /** Find or compute the route from a node to another on a vnet */
+    const Route &getRoute(NodeID local_src, NodeID global_dest, int vnet);
+
+    /**
+     * Account for a message of the given size crossing a link at a
+     * given cycle, and return the cycles it spends on the link.
+     *
+     * @param queueing Set to the part spent waiting for the link.
+     */
+    Cycles traverseLink(Link &link, Cycles when, unsigned bytes,
+                        Cycles &queueing);
+
+    /**
+     * Try to send the message at the head of a queue to all its
+     * destinations.
+     *
+     * @return False if a destination has no room for it yet.
+     */
+    bool injectMessage(NodeID local_src, int vnet, MessageBuffer *queue);
+
+    const Cycles m_window;
+    const double m_max_utilization;
+
+    std::vector<Link> m_links;
+    // Output ports of every router
+    std::vector<std::vector<OutPort>> m_router_ports;
+    // Latency through every router
+    std::vector<Cycles> m_router_latency;
+    // Link from each node into the network, and the router it leads to
+    std::vector<int> m_node_in_link;
+    std::vector<int> m_node_router;
+
+    std::unordered_map<uint64_t, Route> m_routes;
+
+    // Last arrival time at every destination buffer. Arrivals are kept
+    // in order so the buffers always see a FIFO stream.
+    std::vector<std::vector<Tick>> m_last_arrival;
+
+    struct NetworkStats : public statistics::Group
+    {
+        NetworkStats(statistics::Group *parent, int num_vnets);
+
+        statistics::Vector m_packets_injected;
+        statistics::Vector m_packets_received;
+        statistics::Vector m_packet_network_latency;
+        statistics::Vector m_packet_queueing_latency;
+        statistics::Formula m_avg_packet_vnet_latency;
+        statistics::Formula m_avg_packet_vqueue_latency;
+        statistics::Formula m_avg_packet_network_latency;
+        statistics::Formula m_avg_packet_queueing_latency;
+        statistics::Formula m_avg_packet_latency;
+
+        statistics::Scalar m_total_hops;
+        statistics::Formula m_avg_hops;
+
+        statistics::Scalar m_average_link_utilization;
+
+        statistics::Vector m_msg_counts;
+        statistics::Vector m_msg_bytes;
+    } networkStats;
+};
+
+inline std::ostream&
+operator<<(std::ostream& out, const AnalyticNetwork& obj)
+{
+    obj.print(out);
+    out << std::flush;
+    return out;
+}
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_NETWORK_ANALYTIC_ANALYTICNETWORK_HH__
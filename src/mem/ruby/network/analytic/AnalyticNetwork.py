@@ -0,0 +1,51 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.objects.Network import RubyNetwork
+from m5.params import *
+
+
+class AnalyticNetwork(RubyNetwork):
+    """A network that computes the latency of every message from a
+    contention model of the links on its route, and delivers it with a
+    single event. Links and routers are the plain BasicIntLink,
+    BasicExtLink and BasicRouter, configured by the usual topologies.
+    The bandwidth_factor of a link is its width in bytes per cycle."""
+
+    type = "AnalyticNetwork"
+    cxx_header = "mem/ruby/network/analytic/AnalyticNetwork.hh"
+    cxx_class = "gem5::ruby::AnalyticNetwork"
+
+    utilization_window = Param.Cycles(
+        1000,
+        "Cycles over which the utilization of each link is measured to "
+        "predict the queueing delay in the next window",
+    )
+    max_utilization = Param.Float(
+        0.95,
+        "Cap on the link utilization used by the queueing model, which "
+        "bounds the predicted delay of a saturated link",
+    )
@@ -71,6 +71,7 @@ GarnetNetwork::GarnetNetwork(const Params &p)
     m_buffers_per_ctrl_vc = p.buffers_per_ctrl_vc;
     m_routing_algorithm = p.routing_algorithm;
     m_next_packet_id = 0;
+    m_num_active_routers = 0;
 
     m_enable_fault_model = p.enable_fault_model;
     if (m_enable_fault_model)
@@ -134,6 +135,20 @@ GarnetNetwork::init()
         m_num_cols = -1;
     }
 
+    // Garnet keeps network-wide state updated by every router and
+    // network interface, so it can't be split across event queues
+    for (auto *router : m_routers) {
+        fatal_if(router->eventQueue() != eventQueue(),
+                 "%s: Garnet routers must use the event queue of their "
+                 "network. Use the simple network to simulate Ruby on "
+                 "multiple event queues.\n", router->name());
+    }
+    for (auto *ni : m_nis) {
+        fatal_if(ni->eventQueue() != eventQueue(),
+                 "%s: Garnet network interfaces must use the event queue "
+                 "of their network.\n", ni->name());
+    }
+
     // FaultModel: declare each router to the fault model
     if (isFaultModelEnabled()) {
         for (std::vector<Router*>::const_iterator i= m_routers.begin();
@@ -615,6 +630,21 @@ GarnetNetwork::update_traffic_distribution(RouteInfo route)
         (*m_ctrl_traffic_distribution[src_node][dest_node])++;
 }
 
+void
+GarnetNetwork::router_activated()
+{
+    if (m_num_active_routers++ == 0)
+        DPRINTF(RubyNetwork, "Routers busy at cycle %lld\n", curCycle());
+}
+
+void
+GarnetNetwork::router_deactivated()
+{
+    assert(m_num_active_routers > 0);
+    if (--m_num_active_routers == 0)
+        DPRINTF(RubyNetwork, "All routers idle at cycle %lld\n", curCycle());
+}
+
 bool
 GarnetNetwork::functionalRead(Packet *pkt, WriteMask &mask)
 {
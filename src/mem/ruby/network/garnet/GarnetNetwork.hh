@@ -95,6 +95,13 @@ class GarnetNetwork : public Network
     int getNumRouters();
     int get_router_id(int ni, int vnet);
 
+    // Routers report when they start and stop buffering flits in their
+    // input VCs, so the network can tell it is idle without visiting
+    // every router.
+    void router_activated();
+    void router_deactivated();
+    bool routersIdle() const { return m_num_active_routers == 0; }
+
 
     // Methods used by Topology to setup the network
     void makeExtOutLink(SwitchID src, NodeID dest, BasicLink* link,
@@ -214,6 +221,7 @@ class GarnetNetwork : public Network
     std::vector<CreditLink *> m_creditlinks; // All credit links in the network
     std::vector<NetworkInterface *> m_nis;   // All NI's in Network
     int m_next_packet_id; // static vairable for packet id allocation
+    int m_num_active_routers; // Routers with flits in their input VCs
 };
 
 inline std::ostream&
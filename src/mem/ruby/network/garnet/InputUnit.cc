@@ -31,8 +31,10 @@
 
 #include "mem/ruby/network/garnet/InputUnit.hh"
 
+#include "base/bitfield.hh"
 #include "debug/RubyNetwork.hh"
 #include "mem/ruby/network/garnet/Credit.hh"
+#include "mem/ruby/network/garnet/GarnetNetwork.hh"
 #include "mem/ruby/network/garnet/Router.hh"
 
 namespace gem5
@@ -46,7 +48,7 @@ namespace garnet
 
 InputUnit::InputUnit(int id, PortDirection direction, Router *router)
   : Consumer(router), m_router(router), m_id(id), m_direction(direction),
-    m_vc_per_vnet(m_router->get_vc_per_vnet())
+    m_vc_per_vnet(m_router->get_vc_per_vnet()), m_num_active_vcs(0)
 {
     const int m_num_vcs = m_router->get_num_vcs();
     m_num_buffer_reads.resize(m_num_vcs/m_vc_per_vnet);
@@ -56,11 +58,18 @@ InputUnit::InputUnit(int id, PortDirection direction, Router *router)
         m_num_buffer_writes[i] = 0;
     }
 
-    // Instantiating the virtual channels
+    // Instantiating the virtual channels, with room for as many flits
+    // as the upstream router has credits for
+    GarnetNetwork *net_ptr = m_router->get_net_ptr();
     virtualChannels.reserve(m_num_vcs);
     for (int i=0; i < m_num_vcs; i++) {
-        virtualChannels.emplace_back();
+        const int vnet = i / m_vc_per_vnet;
+        virtualChannels.emplace_back(
+            net_ptr->get_vnet_type(vnet) == DATA_VNET_ ?
+                net_ptr->getBuffersPerDataVC() :
+                net_ptr->getBuffersPerCtrlVC());
     }
+    m_active_vcs.resize((m_num_vcs + 63) / 64, 0);
 }
 
 /*
@@ -109,6 +118,7 @@ InputUnit::wakeup()
 
         // Buffer the flit
         virtualChannels[vc].insertFlit(t_flit);
+        set_vc_active_bit(vc);
 
         int vnet = vc/m_vc_per_vnet;
         // number of writes same as reads
@@ -139,6 +149,58 @@ InputUnit::wakeup()
     }
 }
 
+void
+InputUnit::set_vc_active_bit(int vc)
+{
+    uint64_t &word = m_active_vcs[vc / 64];
+    const uint64_t bit = 1ULL << (vc % 64);
+    if (word & bit)
+        return;
+
+    word |= bit;
+    if (m_num_active_vcs++ == 0)
+        m_router->inport_activated();
+}
+
+void
+InputUnit::clear_vc_active(int vc)
+{
+    uint64_t &word = m_active_vcs[vc / 64];
+    const uint64_t bit = 1ULL << (vc % 64);
+    assert(word & bit);
+
+    word &= ~bit;
+    if (--m_num_active_vcs == 0)
+        m_router->inport_deactivated();
+}
+
+int
+InputUnit::next_active_vc(int vc) const
+{
+    if (m_num_active_vcs == 0)
+        return -1;
+
+    const int num_vcs = virtualChannels.size();
+    const int num_words = m_active_vcs.size();
+    if (vc >= num_vcs)
+        vc = 0;
+
+    // Search from vc to the end, then wrap around to catch the VCs
+    // below vc. The word holding vc is visited again last, by which
+    // point only its bits below vc can still be set.
+    int word_idx = vc / 64;
+    uint64_t word = m_active_vcs[word_idx] & (~0ULL << (vc % 64));
+    for (int i = 0; i <= num_words; i++) {
+        if (word)
+            return word_idx * 64 + findLsbSet(word);
+        word_idx = (word_idx + 1) % num_words;
+        word = m_active_vcs[word_idx];
+    }
+
+    panic("InputUnit %d tracks %d active VCs but none is set\n",
+          m_id, m_num_active_vcs);
+}
+
 // Send a credit back to upstream router for this VC.
 // Called by SwitchAllocator when the flit in this VC wins the Switch.
 void
@@ -155,6 +217,9 @@ bool
 InputUnit::functionalRead(Packet *pkt, WriteMask &mask)
 {
     bool read = false;
+    if (!has_active_vcs())
+        return read;
+
     for (auto& virtual_channel : virtualChannels) {
         if (virtual_channel.functionalRead(pkt, mask))
             read = true;
@@ -167,6 +232,9 @@ uint32_t
 InputUnit::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
+    if (!has_active_vcs())
+        return num_functional_writes;
+
     for (auto& virtual_channel : virtualChannels) {
         num_functional_writes += virtual_channel.functionalWrite(pkt);
     }
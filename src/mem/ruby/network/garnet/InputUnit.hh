@@ -32,6 +32,7 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_INPUTUNIT_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_INPUTUNIT_HH__
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -116,9 +117,24 @@ class InputUnit : public Consumer
     inline flit*
     getTopFlit(int vc)
     {
-        return virtualChannels[vc].getTopFlit();
+        flit *t_flit = virtualChannels[vc].getTopFlit();
+        if (virtualChannels[vc].isEmpty())
+            clear_vc_active(vc);
+        return t_flit;
     }
 
+    /** True if any VC at this port is holding a flit. */
+    inline bool has_active_vcs() const { return m_num_active_vcs > 0; }
+
+    /**
+     * Find the first VC at or after vc, wrapping around, that is holding
+     * a flit. Allocators use this to walk only the non-empty VCs in the
+     * same round-robin order they would visit every VC in.
+     *
+     * @return The VC, or -1 if all VCs at this port are empty.
+     */
+    int next_active_vc(int vc) const;
+
     inline bool
     need_stage(int vc, flit_stage stage, Tick time)
     {
@@ -169,6 +185,13 @@ class InputUnit : public Consumer
     // Input Virtual channels
     std::vector<VirtualChannel> virtualChannels;
 
+    // One bit per VC, set while the VC is holding flits
+    std::vector<uint64_t> m_active_vcs;
+    int m_num_active_vcs;
+
+    void set_vc_active_bit(int vc);
+    void clear_vc_active(int vc);
+
     // Statistical variables
     std::vector<double> m_num_buffer_writes;
     std::vector<double> m_num_buffer_reads;
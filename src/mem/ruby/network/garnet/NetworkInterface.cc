@@ -211,8 +211,13 @@ NetworkInterface::wakeup()
 
         if (b->isReady(curTime)) { // Is there a message waiting
             msg_ptr = b->peekMsgPtr();
+            const Tick delayed_ticks = msg_ptr->getDelayedTicks();
             if (flitisizeMessage(msg_ptr, vnet)) {
                 b->dequeue(curTime);
+                // The flits to the last destination carry this message,
+                // which must look like the copies made before the
+                // dequeue updated its delay.
+                msg_ptr->setDelayedTicks(delayed_ticks);
             }
         }
     }
@@ -394,7 +399,13 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
         if (vc == -1) {
             return false ;
         }
-        MsgPtr new_msg_ptr = msg_ptr->clone();
+        // Every destination but the last gets a private copy of the
+        // message. Once a vc has been acquired for the last one, the
+        // message is dequeued from the protocol buffer, so the original
+        // can be handed to the flits instead of being copied again. The
+        // caller undoes the delay update of the dequeue.
+        const bool last_dest = ctr == dest_nodes.size() - 1;
+        MsgPtr new_msg_ptr = last_dest ? msg_ptr : msg_ptr->clone();
         NodeID destID = dest_nodes[ctr];
 
         Message *new_net_msg_ptr = new_msg_ptr.get();
@@ -415,7 +426,8 @@ NetworkInterface::flitisizeMessage(MsgPtr msg_ptr, int vnet)
             // removing the destination from the original message to reflect
             // that a message with this particular destination has been
             // flitisized and an output vc is acquired
-            net_msg_ptr->getDestination().removeNetDest(personal_dest);
+            if (!last_dest)
+                net_msg_ptr->getDestination().removeNetDest(personal_dest);
         }
 
         // Embed Route into the flits
@@ -53,7 +53,7 @@ Router::Router(const Params &p)
     m_virtual_networks(p.virt_nets), m_vc_per_vnet(p.vcs_per_vnet),
     m_num_vcs(m_virtual_networks * m_vc_per_vnet), m_bit_width(p.width),
     m_network_ptr(nullptr), routingUnit(this), switchAllocator(this),
-    crossbarSwitch(this)
+    crossbarSwitch(this), m_num_active_inports(0)
 {
     m_input_unit.clear();
     m_output_unit.clear();
@@ -90,7 +90,9 @@ Router::wakeup()
     }
 
     // Switch Allocation
-    switchAllocator.wakeup();
+    // Only flits buffered in an input VC can request the switch
+    if (has_active_vcs())
+        switchAllocator.wakeup();
 
     // Switch Traversal
     crossbarSwitch.wakeup();
@@ -177,6 +179,21 @@ Router::schedule_wakeup(Cycles time)
     scheduleEvent(time);
 }
 
+void
+Router::inport_activated()
+{
+    if (m_num_active_inports++ == 0)
+        m_network_ptr->router_activated();
+}
+
+void
+Router::inport_deactivated()
+{
+    assert(m_num_active_inports > 0);
+    if (--m_num_active_inports == 0)
+        m_network_ptr->router_deactivated();
+}
+
 std::string
 Router::getPortDirectionName(PortDirection direction)
 {
@@ -281,7 +298,7 @@ Router::functionalRead(Packet *pkt, WriteMask &mask)
     if (crossbarSwitch.functionalRead(pkt, mask))
         read = true;
 
-    for (uint32_t i = 0; i < m_input_unit.size(); i++) {
+    for (uint32_t i = 0; has_active_vcs() && i < m_input_unit.size(); i++) {
         if (m_input_unit[i]->functionalRead(pkt, mask))
             read = true;
     }
@@ -300,7 +317,7 @@ Router::functionalWrite(Packet *pkt)
     uint32_t num_functional_writes = 0;
     num_functional_writes += crossbarSwitch.functionalWrite(pkt);
 
-    for (uint32_t i = 0; i < m_input_unit.size(); i++) {
+    for (uint32_t i = 0; has_active_vcs() && i < m_input_unit.size(); i++) {
         num_functional_writes += m_input_unit[i]->functionalWrite(pkt);
     }
 
@@ -120,6 +120,15 @@ class Router : public BasicRouter, public Consumer
     void grant_switch(int inport, flit *t_flit);
     void schedule_wakeup(Cycles time);
 
+    /**
+     * Called by the input units when their first VC fills up or their
+     * last VC drains, so the router and the network know which routers
+     * hold flits without scanning every VC.
+     */
+    void inport_activated();
+    void inport_deactivated();
+    bool has_active_vcs() const { return m_num_active_inports > 0; }
+
     std::string getPortDirectionName(PortDirection direction);
     void printFaultVector(std::ostream& out);
     void printAggregateFaultProbability(std::ostream& out);
@@ -155,6 +164,9 @@ class Router : public BasicRouter, public Consumer
     std::vector<std::shared_ptr<InputUnit>> m_input_unit;
     std::vector<std::shared_ptr<OutputUnit>> m_output_unit;
 
+    // Number of input units with at least one non-empty VC
+    int m_num_active_inports;
+
     // Statistical variables required for power computations
     statistics::Scalar m_buffer_reads;
     statistics::Scalar m_buffer_writes;
@@ -47,6 +47,7 @@ namespace garnet
 {
 
 RoutingUnit::RoutingUnit(Router *router)
+    : m_rng(router->name())
 {
     m_router = router;
     m_routing_table.clear();
@@ -62,12 +63,14 @@ RoutingUnit::addRoute(std::vector<NetDest>& routing_table_entry)
     for (int v = 0; v < routing_table_entry.size(); v++) {
         m_routing_table[v].push_back(routing_table_entry[v]);
     }
+    m_candidates_cache.clear();
 }
 
 void
 RoutingUnit::addWeight(int link_weight)
 {
     m_weight_table.push_back(link_weight);
+    m_candidates_cache.clear();
 }
 
 bool
@@ -94,7 +97,7 @@ RoutingUnit::supportsVnet(int vnet, std::vector<int> sVnets)
  * Correct weight assignments are critical to provide deadlock avoidance.
  */
 int
-RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+RoutingUnit::lookupRoutingTable(int vnet, const NetDest &msg_destination)
 {
     // First find all possible output link candidates
     // For ordered vnet, just choose the first
@@ -102,11 +105,38 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
     // For unordered vnet, randomly choose any of the links
     // To have a strict ordering between links, they should be given
     // different weights in the topology file
+    const std::vector<int> &output_link_candidates =
+        findCandidates(vnet, msg_destination);
+    const int num_candidates = output_link_candidates.size();
+
+    if (output_link_candidates.size() == 0) {
+        fatal("Fatal Error:: No Route exists from this Router.");
+        exit(0);
+    }
+
+    // Randomly select any candidate output link
+    int candidate = 0;
+    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
+        candidate = m_rng.random(0, num_candidates - 1);
+
+    return output_link_candidates.at(candidate);
+}
+
+const std::vector<int> &
+RoutingUnit::findCandidates(int vnet, const NetDest &msg_destination)
+{
+    if (m_candidates_cache.size() <= vnet)
+        m_candidates_cache.resize(vnet + 1);
+    auto &cache = m_candidates_cache[vnet];
+    auto it = cache.find(msg_destination);
+    if (it != cache.end())
+        return it->second;
+
+    if (cache.size() >= MaxCachedRoutes)
+        cache.clear();
 
-    int output_link = -1;
     int min_weight = INFINITE_;
     std::vector<int> output_link_candidates;
-    int num_candidates = 0;
 
     // Identify the minimum weight among the candidate output links
     for (int link = 0; link < m_routing_table[vnet].size(); link++) {
@@ -124,24 +154,13 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
             m_routing_table[vnet][link])) {
 
             if (m_weight_table[link] == min_weight) {
-                num_candidates++;
                 output_link_candidates.push_back(link);
             }
         }
     }
 
-    if (output_link_candidates.size() == 0) {
-        fatal("Fatal Error:: No Route exists from this Router.");
-        exit(0);
-    }
-
-    // Randomly select any candidate output link
-    int candidate = 0;
-    if (!(m_router->get_net_ptr())->isVNetOrdered(vnet))
-        candidate = rand() % num_candidates;
-
-    output_link = output_link_candidates.at(candidate);
-    return output_link;
+    return cache.emplace(msg_destination,
+                         std::move(output_link_candidates)).first->second;
 }
 
 
@@ -31,6 +31,10 @@
 #ifndef __MEM_RUBY_NETWORK_GARNET_0_ROUTINGUNIT_HH__
 #define __MEM_RUBY_NETWORK_GARNET_0_ROUTINGUNIT_HH__
 
+#include <unordered_map>
+#include <vector>
+
+#include "base/random.hh"
 #include "mem/ruby/common/Consumer.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/network/garnet/CommonTypes.hh"
@@ -62,7 +66,7 @@ class RoutingUnit
     void addWeight(int link_weight);
 
     // get output port from routing table
-    int  lookupRoutingTable(int vnet, NetDest net_dest);
+    int  lookupRoutingTable(int vnet, const NetDest &net_dest);
 
     // Topology-specific direction based routing
     void addInDirection(PortDirection inport_dirn, int inport);
@@ -86,10 +90,23 @@ class RoutingUnit
   private:
     Router *m_router;
 
+    // Stream choosing among equally good routes, private to this router
+    RandomStream m_rng;
+
     // Routing Table
     std::vector<std::vector<NetDest>> m_routing_table;
     std::vector<int> m_weight_table;
 
+    // Candidate output links with minimum weight of each destination
+    // set looked up so far, per vnet. The routing table is static, so
+    // they only need to be computed once.
+    std::vector<std::unordered_map<NetDest, std::vector<int>>>
+        m_candidates_cache;
+    static constexpr size_t MaxCachedRoutes = 4096;
+
+    const std::vector<int> &findCandidates(int vnet,
+                                           const NetDest &net_dest);
+
     // Inport and Outport direction to idx maps
     std::map<PortDirection, int> m_inports_dirn2idx;
     std::map<int, PortDirection> m_inports_idx2dirn;
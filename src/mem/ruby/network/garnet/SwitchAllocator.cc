@@ -113,11 +113,15 @@ SwitchAllocator::arbitrate_inports()
     // Select a VC from each input in a round robin manner
     // Independent arbiter at each input port
     for (int inport = 0; inport < m_num_inports; inport++) {
-        int invc = m_round_robin_invc[inport];
+        auto input_unit = m_router->getInputUnit(inport);
 
-        for (int invc_iter = 0; invc_iter < m_num_vcs; invc_iter++) {
-            auto input_unit = m_router->getInputUnit(inport);
+        // Only the VCs holding flits can be in SA, so walk those in
+        // round-robin order starting from this port's pointer
+        const int first_vc =
+            input_unit->next_active_vc(m_round_robin_invc[inport]);
+        int invc = first_vc;
 
+        while (invc != -1) {
             if (input_unit->need_stage(invc, SA_, curTick())) {
                 // This flit is in SA stage
 
@@ -138,9 +142,9 @@ SwitchAllocator::arbitrate_inports()
                 }
             }
 
-            invc++;
-            if (invc >= m_num_vcs)
-                invc = 0;
+            invc = input_unit->next_active_vc(invc + 1);
+            if (invc == first_vc)
+                break;
         }
     }
 }
@@ -358,16 +362,23 @@ SwitchAllocator::check_for_wakeup()
 {
     Tick nextCycle = m_router->clockEdge(Cycles(1));
 
-    if (m_router->alreadyScheduled(nextCycle)) {
+    if (m_router->alreadyScheduled(nextCycle) ||
+        !m_router->has_active_vcs()) {
         return;
     }
 
     for (int i = 0; i < m_num_inports; i++) {
-        for (int j = 0; j < m_num_vcs; j++) {
-            if (m_router->getInputUnit(i)->need_stage(j, SA_, nextCycle)) {
+        auto input_unit = m_router->getInputUnit(i);
+        const int first_vc = input_unit->next_active_vc(0);
+        int vc = first_vc;
+        while (vc != -1) {
+            if (input_unit->need_stage(vc, SA_, nextCycle)) {
                 m_router->schedule_wakeup(Cycles(1));
                 return;
             }
+            vc = input_unit->next_active_vc(vc + 1);
+            if (vc == first_vc)
+                break;
         }
     }
 }
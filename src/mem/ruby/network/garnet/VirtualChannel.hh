@@ -49,7 +49,7 @@ namespace garnet
 class VirtualChannel
 {
   public:
-    VirtualChannel();
+    VirtualChannel(int depth);
     ~VirtualChannel() = default;
 
     bool need_stage(flit_stage stage, Tick time);
@@ -70,6 +70,12 @@ class VirtualChannel
         return inputBuffer.isReady(curTime);
     }
 
+    inline bool
+    isEmpty()
+    {
+        return inputBuffer.isEmpty();
+    }
+
     inline void
     insertFlit(flit *t_flit)
     {
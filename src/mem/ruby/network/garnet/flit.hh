@@ -56,6 +56,21 @@ class flit
 
     virtual ~flit(){};
 
+    // Every flit of a message is allocated by its source interface and
+    // freed at its destination, so flit storage is recycled through a
+    // free list rather than the general purpose allocator
+    static void *
+    operator new(std::size_t size)
+    {
+        return MessagePool<flit>::allocate(size);
+    }
+
+    static void
+    operator delete(void *p, std::size_t size)
+    {
+        MessagePool<flit>::release(p, size);
+    }
+
     int get_outport() {return m_outport; }
     int get_size() { return m_size; }
     Tick get_enqueue_time() { return m_enqueue_time; }
@@ -40,12 +40,22 @@ namespace ruby
 namespace garnet
 {
 
+namespace
+{
+
+/** Capacity of a ring with no known depth */
+constexpr size_t defaultRingSize = 4;
+
+} // anonymous namespace
+
 flitBuffer::flitBuffer()
+    : m_ring(defaultRingSize), m_head(0), m_count(0)
 {
     max_size = INFINITE_;
 }
 
 flitBuffer::flitBuffer(int maximum_size)
+    : m_ring(defaultRingSize), m_head(0), m_count(0)
 {
     max_size = maximum_size;
 }
@@ -53,13 +63,13 @@ flitBuffer::flitBuffer(int maximum_size)
 bool
 flitBuffer::isEmpty()
 {
-    return (m_buffer.size() == 0);
+    return (m_count == 0);
 }
 
 bool
 flitBuffer::isReady(Tick curTime)
 {
-    if (m_buffer.size() != 0 ) {
+    if (m_count != 0) {
         flit *t_flit = peekTopFlit();
         if (t_flit->get_time() <= curTime)
             return true;
@@ -70,13 +80,13 @@ flitBuffer::isReady(Tick curTime)
 void
 flitBuffer::print(std::ostream& out) const
 {
-    out << "[flitBuffer: " << m_buffer.size() << "] " << std::endl;
+    out << "[flitBuffer: " << m_count << "] " << std::endl;
 }
 
 bool
 flitBuffer::isFull()
 {
-    return (m_buffer.size() >= max_size);
+    return (m_count >= max_size);
 }
 
 void
@@ -85,12 +95,33 @@ flitBuffer::setMaxSize(int maximum)
     max_size = maximum;
 }
 
+void
+flitBuffer::reserve(int n)
+{
+    if (n > 0 && n > m_ring.size())
+        grow(n);
+}
+
+void
+flitBuffer::grow(size_t capacity)
+{
+    size_t new_size = m_ring.size();
+    while (new_size < capacity)
+        new_size *= 2;
+
+    std::vector<flit *> ring(new_size);
+    for (unsigned i = 0; i < m_count; ++i)
+        ring[i] = at(i);
+    m_ring.swap(ring);
+    m_head = 0;
+}
+
 bool
 flitBuffer::functionalRead(Packet *pkt, WriteMask &mask)
 {
     bool read = false;
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalRead(pkt, mask)) {
+    for (unsigned int i = 0; i < m_count; ++i) {
+        if (at(i)->functionalRead(pkt, mask)) {
             read = true;
         }
     }
@@ -103,8 +134,8 @@ flitBuffer::functionalWrite(Packet *pkt)
 {
     uint32_t num_functional_writes = 0;
 
-    for (unsigned int i = 0; i < m_buffer.size(); ++i) {
-        if (m_buffer[i]->functionalWrite(pkt)) {
+    for (unsigned int i = 0; i < m_count; ++i) {
+        if (at(i)->functionalWrite(pkt)) {
             num_functional_writes++;
         }
     }
@@ -32,6 +32,7 @@
 #define __MEM_RUBY_NETWORK_GARNET_0_FLITBUFFER_HH__
 
 #include <algorithm>
+#include <cassert>
 #include <iostream>
 #include <vector>
 
@@ -47,6 +48,12 @@ namespace ruby
 namespace garnet
 {
 
+/**
+ * FIFO of flits. The flits are kept in a ring whose capacity is a power
+ * of two. It grows when it runs out of space, but is normally reserved
+ * up front for the depth of the buffer, so that moving flits through
+ * the network doesn't allocate.
+ */
 class flitBuffer
 {
   public:
@@ -58,33 +65,53 @@ class flitBuffer
     void print(std::ostream& out) const;
     bool isFull();
     void setMaxSize(int maximum);
-    int getSize() const { return m_buffer.size(); }
+    int getSize() const { return m_count; }
+
+    /** Make room for n flits without growing the ring later */
+    void reserve(int n);
 
     flit *
     getTopFlit()
     {
-        flit *f = m_buffer.front();
-        m_buffer.pop_front();
+        assert(m_count > 0);
+        flit *f = m_ring[m_head];
+        m_head = (m_head + 1) & (m_ring.size() - 1);
+        --m_count;
         return f;
     }
 
     flit *
     peekTopFlit()
     {
-        return m_buffer.front();
+        assert(m_count > 0);
+        return m_ring[m_head];
     }
 
     void
     insert(flit *flt)
     {
-        m_buffer.push_back(flt);
+        if (m_count == m_ring.size())
+            grow(2 * m_ring.size());
+        m_ring[(m_head + m_count) & (m_ring.size() - 1)] = flt;
+        ++m_count;
     }
 
     bool functionalRead(Packet *pkt, WriteMask &mask);
     uint32_t functionalWrite(Packet *pkt);
 
   private:
-    std::deque<flit *> m_buffer;
+    /** The i-th flit from the head of the buffer */
+    flit *
+    at(unsigned i) const
+    {
+        return m_ring[(m_head + i) & (m_ring.size() - 1)];
+    }
+
+    void grow(size_t capacity);
+
+    std::vector<flit *> m_ring;
+    unsigned m_head;
+    unsigned m_count;
     int max_size;
 };
 
@@ -41,6 +41,7 @@
 #include "mem/ruby/network/simple/PerfectSwitch.hh"
 
 #include <algorithm>
+#include <utility>
 
 #include "base/cast.hh"
 #include "base/cprintf.hh"
@@ -230,32 +231,30 @@ PerfectSwitch::operateMessageBuffer(MessageBuffer *buffer, int vnet)
             break; // go to next incoming port
         }
 
-        MsgPtr unmodified_msg_ptr;
-
-        if (output_links.size() > 1) {
-            // If we are sending this message down more than one link
-            // (size>1), we need to make a copy of the message so each
-            // branch can have a different internal destination we need
-            // to create an unmodified MsgPtr because the MessageBuffer
-            // enqueue func will modify the message
-
-            // This magic line creates a private copy of the message
-            unmodified_msg_ptr = msg_ptr->clone();
-        }
+        // If we are sending this message down more than one link, each
+        // branch needs its own copy of the message so it can have a
+        // different internal destination. The copies are made before
+        // the message is dequeued and enqueued again, as both update
+        // the message. The first link then takes the original message,
+        // with the delay update of the dequeue undone.
+        static thread_local std::vector<MsgPtr> copies;
+        copies.clear();
+        for (int i = 1; i < output_links.size(); i++)
+            copies.push_back(msg_ptr->clone());
+        const Tick delayed_ticks = msg_ptr->getDelayedTicks();
 
         // Dequeue msg
         buffer->dequeue(current_time);
         m_pending_message_count[vnet]--;
+        msg_ptr->setDelayedTicks(delayed_ticks);
 
         // Enqueue it - for all outgoing queues
         for (int i=0; i<output_links.size(); i++) {
             int outgoing = output_links[i].m_link_id;
             OutputPort &out_port = m_out[outgoing];
 
-            if (i > 0) {
-                // create a private copy of the unmodified message
-                msg_ptr = unmodified_msg_ptr->clone();
-            }
+            if (i > 0)
+                msg_ptr = std::move(copies[i - 1]);
 
             // Change the internal destination set of the message so it
             // knows which destinations this link is responsible for.
@@ -78,6 +78,19 @@ Switch::init()
     m_routing_unit.init_parent(this);
 }
 
+void
+Switch::startup()
+{
+    BasicRouter::startup();
+
+    // Messages sent down a link to another event queue must arrive in
+    // a later quantum, so the link latency bounds the quantum
+    for (const auto &throttle : throttles) {
+        if (throttle.crossesEventQueues())
+            registerLookahead(cyclesToTicks(throttle.getLatency()));
+    }
+}
+
 void
 Switch::addInPort(const std::vector<MessageBuffer*>& in)
 {
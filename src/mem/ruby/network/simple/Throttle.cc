@@ -41,6 +41,7 @@
 #include "mem/ruby/network/simple/Throttle.hh"
 
 #include <cassert>
+#include <utility>
 
 #include "base/cast.hh"
 #include "base/cprintf.hh"
@@ -134,6 +135,19 @@ Throttle::addLinks(const std::vector<MessageBuffer*>& in_vec,
            (m_link_bandwidth_multiplier.size() == 1));
 }
 
+bool
+Throttle::crossesEventQueues() const
+{
+    for (auto *out : m_out) {
+        Consumer *consumer = out->getConsumer();
+        if (consumer &&
+            consumer->getObject()->eventQueue() != m_switch->eventQueue()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 int
 Throttle::getLinkBandwidth(int vnet) const
 {
@@ -196,9 +210,10 @@ Throttle::operateVnet(int vnet, int channel, int &total_bw_remaining,
                     m_node, getLinkBandwidth(vnet), units_remaining,
                     m_ruby_system->curCycle());
 
-            // Move the message
+            // Move the message, handing our reference over to the
+            // output buffer
             in->dequeue(current_time);
-            out->enqueue(msg_ptr, current_time,
+            out->enqueue(std::move(msg_ptr), current_time,
                          m_switch->cyclesToTicks(m_link_latency));
 
             // Count the message
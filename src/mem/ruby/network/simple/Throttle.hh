@@ -103,6 +103,12 @@ class Throttle : public Consumer
 
     Cycles getLatency() const { return m_link_latency; }
 
+    /**
+     * Whether the link leads to a router or controller simulated on
+     * another event queue than the switch of the throttle.
+     */
+    bool crossesEventQueues() const;
+
     void print(std::ostream& out) const;
 
   private:
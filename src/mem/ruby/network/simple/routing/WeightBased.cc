@@ -42,7 +42,6 @@
 
 #include <algorithm>
 
-#include "base/random.hh"
 #include "mem/ruby/network/simple/Switch.hh"
 
 namespace gem5
@@ -52,7 +51,7 @@ namespace ruby
 {
 
 WeightBased::WeightBased(const Params &p)
-    :BaseRoutingUnit(p)
+    :BaseRoutingUnit(p), m_rng(p.name)
 {
 }
 
@@ -69,6 +68,7 @@ WeightBased::addOutPort(LinkID link_id,
                         m_out_buffer,
                         0, link_weight});
     sortLinks();
+    m_route_cache.clear();
 }
 
 void
@@ -95,13 +95,30 @@ WeightBased::route(const Message &msg,
                 // improve load distribution by randomizing order of links
                 // with the same queue length
                 link->m_order =
-                    (out_queue_length << 8) | random_mt.random(0, 0xff);
+                    (out_queue_length << 8) | m_rng.random(0, 0xff);
             }
         }
         sortLinks();
     }
 
-    findRoute(msg, out_links);
+    // Adaptive routes depend on the current link congestion
+    if (params().adaptive_routing && !deterministic) {
+        findRoute(msg, out_links);
+        return;
+    }
+
+    auto it = m_route_cache.find(msg.getDestination());
+    if (it == m_route_cache.end()) {
+        if (m_route_cache.size() >= MaxCachedRoutes)
+            m_route_cache.clear();
+        findRoute(msg, out_links);
+        m_route_cache.emplace(msg.getDestination(), out_links);
+        return;
+    }
+
+    assert(out_links.size() == 0);
+    for (const auto &route : it->second)
+        out_links.emplace_back(route);
 }
 
 void
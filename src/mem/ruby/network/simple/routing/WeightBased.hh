@@ -41,6 +41,10 @@
 #ifndef __MEM_RUBY_NETWORK_SIMPLE_WEIGHTBASEDROUTINGUNIT_HH__
 #define __MEM_RUBY_NETWORK_SIMPLE_WEIGHTBASEDROUTINGUNIT_HH__
 
+#include <unordered_map>
+#include <vector>
+
+#include "base/random.hh"
 #include "mem/ruby/network/simple/routing/BaseRoutingUnit.hh"
 #include "params/WeightBased.hh"
 
@@ -80,6 +84,16 @@ class WeightBased : public BaseRoutingUnit
 
     std::vector<std::unique_ptr<LinkInfo>> m_links;
 
+    // Stream breaking ties between the links, private to this unit
+    RandomStream m_rng;
+
+    // The topology is static, so as long as the links are in their
+    // static order the route of a destination set never changes. The
+    // routes (including the multicast fan-out) are kept per destination
+    // set after being computed once.
+    std::unordered_map<NetDest, std::vector<RouteInfo>> m_route_cache;
+    static constexpr size_t MaxCachedRoutes = 4096;
+
     void findRoute(const Message &msg,
                    std::vector<RouteInfo> &out_links) const;
 
@@ -109,6 +109,10 @@ class AbstractCacheEntry : public ReplaceableEntry
     AccessPermission m_Permission; // Access permission for this
                                    // block, required by CacheMemory
 
+    // Partition that allocated the entry, used by the partitioning policies
+    uint64_t m_partition_id = 0;
+    uint64_t getPartitionId() const override { return m_partition_id; }
+
     // Get the last access Tick.
     Tick getLastAccess() { return m_last_touch_tick; }
 
@@ -43,6 +43,7 @@
 
 #include <exception>
 #include <iostream>
+#include <map>
 #include <string>
 #include <unordered_map>
 
@@ -117,6 +118,19 @@ class AbstractController : public ClockedObject, public Consumer
     virtual void regStats();
 
     virtual void recordCacheTrace(int cntrl, CacheRecorder* tr) = 0;
+
+    //! Installs a block of a checkpointed cache trace directly into the
+    //! controller's caches or directory when restoring with direct
+    //! warmup. It is first called on the controller that recorded the
+    //! block (requestor is its own MachineID), and if that succeeds, on
+    //! all the other controllers so that they can update their state to
+    //! match. Returning false makes the recorder replay the block through
+    //! the sequencer instead. Behavior is protocol-specific, by default
+    //! nothing is installed.
+    virtual bool warmupInstall(const Addr& addr, const RubyRequestType& type,
+                               const MachineID& requestor,
+                               const DataBlock& data)
+    { return false; }
     virtual Sequencer* getCPUSequencer() const = 0;
     virtual DMASequencer* getDMASequencer() const = 0;
     virtual GPUCoalescer* getGPUCoalescer() const = 0;
@@ -167,6 +181,14 @@ class AbstractController : public ClockedObject, public Consumer
     virtual void collateStats()
     {fatal("collateStats() should be overridden!");}
 
+    //! Add how many times each possible transition of this controller was
+    //! taken since the start of the simulation to coverage, keyed by
+    //! "<machine> <state> <event>". Unlike the transition stats, these
+    //! counts are not cleared by stats resets.
+    virtual void
+    collateCoverage(std::map<std::string, uint64_t> &coverage) const
+    {}
+
     //! Initialize the message buffers.
     virtual void initNetQueues() = 0;
 
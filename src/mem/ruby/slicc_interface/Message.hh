@@ -41,10 +41,12 @@
 #ifndef __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 #define __MEM_RUBY_SLICC_INTERFACE_MESSAGE_HH__
 
+#include <cstddef>
 #include <iostream>
-#include <memory>
+#include <new>
 #include <stack>
 
+#include "base/refcnt.hh"
 #include "mem/packet.hh"
 #include "mem/ruby/common/NetDest.hh"
 #include "mem/ruby/common/WriteMask.hh"
@@ -57,9 +59,74 @@ namespace ruby
 {
 
 class Message;
-typedef std::shared_ptr<Message> MsgPtr;
 
-class Message
+/**
+ * Messages are reference counted intrusively and without atomics: the
+ * references to a message are only copied by the thread simulating the
+ * buffer that holds it, and a message crossing event queues is handed
+ * over with its reference at a quantum boundary. A pointer copy is thus
+ * one non-atomic increment instead of the atomic update and separate
+ * control block of a shared_ptr.
+ */
+typedef RefCountingPtr<Message> MsgPtr;
+
+/**
+ * Per-class free list of message storage. Every protocol message type
+ * allocates through its own pool, so the storage of a consumed message
+ * is reused by the next message of the same type instead of going back
+ * to the general purpose allocator. The network uses it for its own
+ * short-lived objects, like Garnet flits, as well. Allocations of a
+ * different size (e.g., from a class deriving from T) bypass the pool.
+ */
+template <class T>
+class MessagePool
+{
+  private:
+    struct FreeNode
+    {
+        FreeNode *next;
+    };
+
+    /** Number of released objects kept around for reuse */
+    static constexpr std::size_t maxFree = 4096;
+
+    static thread_local FreeNode *freeList;
+    static thread_local std::size_t numFree;
+
+  public:
+    static void *
+    allocate(std::size_t size)
+    {
+        if (size != sizeof(T) || !freeList)
+            return ::operator new(size);
+        FreeNode *node = freeList;
+        freeList = node->next;
+        --numFree;
+        return node;
+    }
+
+    static void
+    release(void *p, std::size_t size)
+    {
+        if (size != sizeof(T) || numFree >= maxFree) {
+            ::operator delete(p);
+            return;
+        }
+        FreeNode *node = static_cast<FreeNode *>(p);
+        node->next = freeList;
+        freeList = node;
+        ++numFree;
+    }
+};
+
+template <class T>
+thread_local typename MessagePool<T>::FreeNode *MessagePool<T>::freeList =
+    nullptr;
+
+template <class T>
+thread_local std::size_t MessagePool<T>::numFree = 0;
+
+class Message : public RefCounted
 {
   public:
     Message(Tick curTime)
@@ -68,7 +135,28 @@ class Message
           m_DelayedTicks(0), m_msg_counter(0)
     { }
 
-    Message(const Message &other) = default;
+    /** A copy starts out with no references of its own */
+    Message(const Message &other)
+        : RefCounted(),
+          m_time(other.m_time),
+          m_LastEnqueueTime(other.m_LastEnqueueTime),
+          m_DelayedTicks(other.m_DelayedTicks),
+          m_msg_counter(other.m_msg_counter),
+          incoming_link(other.incoming_link),
+          vnet(other.vnet)
+    { }
+
+    Message &
+    operator=(const Message &other)
+    {
+        m_time = other.m_time;
+        m_LastEnqueueTime = other.m_LastEnqueueTime;
+        m_DelayedTicks = other.m_DelayedTicks;
+        m_msg_counter = other.m_msg_counter;
+        incoming_link = other.incoming_link;
+        vnet = other.vnet;
+        return *this;
+    }
 
     virtual ~Message() { }
 
@@ -102,6 +190,7 @@ class Message
         m_DelayedTicks += delta;
     }
     Tick getDelayedTicks() const {return m_DelayedTicks;}
+    void setDelayedTicks(Tick ticks) { m_DelayedTicks = ticks; }
 
     void setLastEnqueueTime(const Tick& time) { m_LastEnqueueTime = time; }
     Tick getLastEnqueueTime() const {return m_LastEnqueueTime;}
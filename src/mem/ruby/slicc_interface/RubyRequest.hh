@@ -220,7 +220,19 @@ class RubyRequest : public Message
 
     RubyRequest(Tick curTime) : Message(curTime) {}
     MsgPtr clone() const
-    { return std::shared_ptr<Message>(new RubyRequest(*this)); }
+    { return MsgPtr(new RubyRequest(*this)); }
+
+    static void *
+    operator new(std::size_t size)
+    {
+        return MessagePool<RubyRequest>::allocate(size);
+    }
+
+    static void
+    operator delete(void *p, std::size_t size)
+    {
+        MessagePool<RubyRequest>::release(p, size);
+    }
 
     Addr getLineAddress() const { return m_LineAddress; }
     Addr getPhysicalAddress() const { return m_PhysicalAddress; }
@@ -50,6 +50,7 @@
 #include "debug/RubyResourceStalls.hh"
 #include "debug/RubyStats.hh"
 #include "mem/cache/replacement_policies/weighted_lru_rp.hh"
+#include "mem/cache/tags/partitioning_policies/partition_manager.hh"
 #include "mem/ruby/protocol/AccessPermission.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
@@ -75,17 +76,23 @@ CacheMemory::CacheMemory(const Params &p)
              p.start_index_bit, p.ruby_system),
     atomicALUArray(p.atomicALUs, p.atomicLatency *
              p.ruby_system->clockPeriod()),
+    m_htmReadSignature(p.htm_read_signature),
+    m_htmWriteSignature(p.htm_write_signature),
     cacheMemoryStats(this)
 {
     m_cache_size = p.size;
     m_cache_assoc = p.assoc;
     m_replacementPolicy_ptr = p.replacement_policy;
+    m_partitionManager = p.partitioning_manager;
     m_start_index_bit = p.start_index_bit;
     m_is_instruction_only_cache = p.is_icache;
     m_resource_stalls = p.resourceStalls;
     m_block_size = p.block_size;  // may be 0 at this point. Updated in init()
     m_use_occupancy = dynamic_cast<replacement_policy::WeightedLRU*>(
                                     m_replacementPolicy_ptr) ? true : false;
+    fatal_if(!m_htmReadSignature != !m_htmWriteSignature,
+             "%s: Needs both HTM read and write signatures, or none",
+             name());
 }
 
 void
@@ -101,6 +108,7 @@ CacheMemory::init()
 
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    m_tag_index.init(m_cache_num_sets, m_cache_assoc);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -139,11 +147,11 @@ CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
+    int way = m_tag_index.find(cacheSet, PackedTagArray::key(tag, false));
+    if (way != -1)
+        if (m_cache[cacheSet][way]->m_Permission !=
             AccessPermission_NotPresent)
-            return it->second;
+            return way;
     return -1; // Not found
 }
 
@@ -155,10 +163,7 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
-    return -1; // Not found
+    return m_tag_index.find(cacheSet, PackedTagArray::key(tag, false));
 }
 
 // Given an unique cache block identifier (idx): return the valid address
@@ -280,6 +285,13 @@ CacheMemory::cacheAvail(Addr address) const
 
 AbstractCacheEntry*
 CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
+{
+    return allocateInPartition(address, entry, 0);
+}
+
+AbstractCacheEntry*
+CacheMemory::allocateInPartition(Addr address, AbstractCacheEntry *entry,
+                                 uint64_t partition_id)
 {
     assert(address == makeLineAddress(address));
     assert(!isTagPresent(address));
@@ -304,7 +316,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: 0x%x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            m_tag_index.set(cacheSet, i, PackedTagArray::key(address, false));
             set[i]->setPosition(cacheSet, i);
             set[i]->replacementData = replacement_data[cacheSet][i];
             set[i]->setLastAccess(curTick());
@@ -313,6 +325,10 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             // replacement policies.
             m_replacementPolicy_ptr->reset(entry->replacementData);
 
+            entry->m_partition_id = partition_id;
+            if (m_partitionManager)
+                m_partitionManager->notifyAcquire(partition_id);
+
             return entry;
         }
     }
@@ -326,26 +342,46 @@ CacheMemory::deallocate(Addr address)
     AbstractCacheEntry* entry = lookup(address);
     assert(entry != nullptr);
     m_replacementPolicy_ptr->invalidate(entry->replacementData);
+    if (m_partitionManager)
+        m_partitionManager->notifyRelease(entry->m_partition_id);
     uint32_t cache_set = entry->getSet();
     uint32_t way = entry->getWay();
     delete entry;
     m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    m_tag_index.clear(cache_set, way);
 }
 
 // Returns with the physical address of the conflicting cache line
 Addr
 CacheMemory::cacheProbe(Addr address) const
+{
+    return cacheProbe(address, 0);
+}
+
+Addr
+CacheMemory::cacheProbe(Addr address, uint64_t partition_id) const
 {
     assert(address == makeLineAddress(address));
     assert(!cacheAvail(address));
 
     int64_t cacheSet = addressToCacheSet(address);
     std::vector<ReplaceableEntry*> candidates;
+    candidates.reserve(m_cache_assoc);
     for (int i = 0; i < m_cache_assoc; i++) {
         candidates.push_back(static_cast<ReplaceableEntry*>(
                                                        m_cache[cacheSet][i]));
     }
+
+    if (m_partitionManager) {
+        m_partitionManager->filterByPartition(candidates, partition_id);
+        // Unlike the Classic caches, the protocol can't give up on the
+        // allocation, so fall back to any line of the set
+        if (candidates.empty()) {
+            for (int i = 0; i < m_cache_assoc; i++)
+                candidates.push_back(m_cache[cacheSet][i]);
+        }
+    }
+
     return m_cache[cacheSet][m_replacementPolicy_ptr->
                         getVictim(candidates)->getWay()]->m_Address;
 }
@@ -495,6 +531,7 @@ CacheMemory::setLocked(Addr address, int context)
     AbstractCacheEntry* entry = lookup(address);
     assert(entry != nullptr);
     entry->setLocked(context);
+    m_lockedLines.insert(address);
 }
 
 void
@@ -509,16 +546,18 @@ CacheMemory::clearLocked(Addr address)
 void
 CacheMemory::clearLockedAll(int context)
 {
-    // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i) {
-        std::vector<AbstractCacheEntry*> set = *i;
-        for (auto j = set.begin(); j != set.end(); ++j) {
-            AbstractCacheEntry *line = *j;
-            if (line && line->isLocked(context)) {
-                DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
-                    line->m_Address);
-                line->clearLocked();
-            }
+    // only the lines that got locked through setLocked can be locked
+    for (auto it = m_lockedLines.begin(); it != m_lockedLines.end();) {
+        AbstractCacheEntry *line = lookup(*it);
+        if (line && line->isLocked(context)) {
+            DPRINTF(RubyCache, "Clear Lock for addr: %#x\n",
+                line->m_Address);
+            line->clearLocked();
+        }
+        if (!line || line->m_locked == -1) {
+            it = m_lockedLines.erase(it);
+        } else {
+            ++it;
         }
     }
 }
@@ -551,6 +590,15 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
       ADD_STAT(htmTransAbortReadSet, "Read set size of a aborted transaction"),
       ADD_STAT(htmTransAbortWriteSet, "Write set size of a aborted "
                                       "transaction"),
+      ADD_STAT(htmSignatureChecks, "Number of remote accesses checked "
+                                   "against the HTM signatures"),
+      ADD_STAT(htmSignatureConflicts, "Number of conflicts reported by the "
+                                      "HTM signatures"),
+      ADD_STAT(htmSignatureFalsePositives, "Number of conflicts reported by "
+               "the HTM signatures for lines in neither set"),
+      ADD_STAT(htmSignatureFalsePositiveRate, "Fraction of the conflicts "
+               "reported by the HTM signatures that are false positives",
+               htmSignatureFalsePositives / htmSignatureConflicts),
       ADD_STAT(m_demand_hits, "Number of cache demand hits"),
       ADD_STAT(m_demand_misses, "Number of cache demand misses"),
       ADD_STAT(m_demand_accesses, "Number of cache demand accesses",
@@ -605,6 +653,18 @@ CacheMemoryStats::CacheMemoryStats(statistics::Group *parent)
         .flags(statistics::pdf | statistics::dist | statistics::nozero |
             statistics::nonan);
 
+    htmSignatureChecks
+        .flags(statistics::nozero);
+
+    htmSignatureConflicts
+        .flags(statistics::nozero);
+
+    htmSignatureFalsePositives
+        .flags(statistics::nozero);
+
+    htmSignatureFalsePositiveRate
+        .flags(statistics::nozero | statistics::nonan);
+
     m_prefetch_hits
         .flags(statistics::nozero);
 
@@ -719,69 +779,109 @@ CacheMemory::isBlockNotBusy(int64_t cache_set, int64_t loc)
 /* hardware transactional memory */
 
 void
-CacheMemory::htmAbortTransaction()
+CacheMemory::htmAddToReadSet(Addr addr)
 {
-    uint64_t htmReadSetSize = 0;
-    uint64_t htmWriteSetSize = 0;
+    AbstractCacheEntry *line = lookup(addr);
+    assert(line);
+    if (!line->getInHtmReadSet() && !line->getInHtmWriteSet())
+        m_htmLines.push_back(addr);
+    line->setInHtmReadSet(true);
+    if (m_htmReadSignature)
+        m_htmReadSignature->set(addr);
+}
 
-    // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
+void
+CacheMemory::htmAddToWriteSet(Addr addr)
+{
+    AbstractCacheEntry *line = lookup(addr);
+    assert(line);
+    if (!line->getInHtmReadSet() && !line->getInHtmWriteSet())
+        m_htmLines.push_back(addr);
+    line->setInHtmWriteSet(true);
+    if (m_htmWriteSignature)
+        m_htmWriteSignature->set(addr);
+}
 
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
+void
+CacheMemory::htmProfileSignatureCheck(Addr addr)
+{
+    if (!m_htmReadSignature)
+        return;
 
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                if (line->getInHtmWriteSet()) {
-                    line->invalidateEntry();
-                }
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-            }
-        }
+    const bool conflict = m_htmReadSignature->isSet(addr) ||
+        m_htmWriteSignature->isSet(addr);
+    const AbstractCacheEntry *line = lookup(addr);
+    const bool in_set = line &&
+        (line->getInHtmReadSet() || line->getInHtmWriteSet());
+    // Signatures may alias, but never miss a line of the sets
+    assert(conflict || !in_set);
+
+    cacheMemoryStats.htmSignatureChecks++;
+    if (conflict) {
+        cacheMemoryStats.htmSignatureConflicts++;
+        if (!in_set)
+            cacheMemoryStats.htmSignatureFalsePositives++;
     }
-
-    cacheMemoryStats.htmTransAbortReadSet.sample(htmReadSetSize);
-    cacheMemoryStats.htmTransAbortWriteSet.sample(htmWriteSetSize);
-    DPRINTF(HtmMem, "htmAbortTransaction: read set=%u write set=%u\n",
-        htmReadSetSize, htmWriteSetSize);
 }
 
 void
-CacheMemory::htmCommitTransaction()
+CacheMemory::htmClearSets(bool abort)
 {
     uint64_t htmReadSetSize = 0;
     uint64_t htmWriteSetSize = 0;
 
-    // iterate through every set and way to get a cache line
-    for (auto i = m_cache.begin(); i != m_cache.end(); ++i)
-    {
-        std::vector<AbstractCacheEntry*> set = *i;
-
-        for (auto j = set.begin(); j != set.end(); ++j)
-        {
-            AbstractCacheEntry *line = *j;
-            if (line != nullptr) {
-                htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
-                htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
-                line->setInHtmWriteSet(false);
-                line->setInHtmReadSet(false);
-                line->clearLocked();
-             }
+    // only the recorded lines can be in a set, the ones that got evicted
+    // since then took their bits with them
+    for (Addr addr : m_htmLines) {
+        AbstractCacheEntry *line = lookup(addr);
+        if (line == nullptr)
+            continue;
+        htmReadSetSize += (line->getInHtmReadSet() ? 1 : 0);
+        htmWriteSetSize += (line->getInHtmWriteSet() ? 1 : 0);
+        if (abort && line->getInHtmWriteSet()) {
+            line->invalidateEntry();
         }
+        line->setInHtmWriteSet(false);
+        line->setInHtmReadSet(false);
+    }
+    m_htmLines.clear();
+
+    for (Addr addr : m_lockedLines) {
+        AbstractCacheEntry *line = lookup(addr);
+        if (line != nullptr)
+            line->clearLocked();
     }
+    m_lockedLines.clear();
 
-    cacheMemoryStats.htmTransCommitReadSet.sample(htmReadSetSize);
-    cacheMemoryStats.htmTransCommitWriteSet.sample(htmWriteSetSize);
-    DPRINTF(HtmMem, "htmCommitTransaction: read set=%u write set=%u\n",
+    if (m_htmReadSignature) {
+        m_htmReadSignature->clear();
+        m_htmWriteSignature->clear();
+    }
+
+    if (abort) {
+        cacheMemoryStats.htmTransAbortReadSet.sample(htmReadSetSize);
+        cacheMemoryStats.htmTransAbortWriteSet.sample(htmWriteSetSize);
+    } else {
+        cacheMemoryStats.htmTransCommitReadSet.sample(htmReadSetSize);
+        cacheMemoryStats.htmTransCommitWriteSet.sample(htmWriteSetSize);
+    }
+    DPRINTF(HtmMem, "%s: read set=%u write set=%u\n",
+        abort ? "htmAbortTransaction" : "htmCommitTransaction",
         htmReadSetSize, htmWriteSetSize);
 }
 
+void
+CacheMemory::htmAbortTransaction()
+{
+    htmClearSets(true);
+}
+
+void
+CacheMemory::htmCommitTransaction()
+{
+    htmClearSets(false);
+}
+
 void
 CacheMemory::profileDemandHit()
 {
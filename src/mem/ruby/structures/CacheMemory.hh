@@ -44,11 +44,14 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "base/filters/base.hh"
 #include "base/statistics.hh"
 #include "mem/cache/replacement_policies/base.hh"
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
+#include "mem/cache/tags/packed_tag_array.hh"
 #include "mem/ruby/common/DataBlock.hh"
 #include "mem/ruby/protocol/CacheRequestType.hh"
 #include "mem/ruby/protocol/CacheResourceType.hh"
@@ -64,6 +67,11 @@
 namespace gem5
 {
 
+namespace partitioning_policy
+{
+class PartitionManager;
+} // namespace partitioning_policy
+
 namespace ruby
 {
 
@@ -108,12 +116,23 @@ class CacheMemory : public SimObject
         allocate(address, new_entry);
     }
 
+    // Same as allocate, with the block accounted to the given partition
+    // of the partitioning manager
+    AbstractCacheEntry* allocateInPartition(Addr address,
+                                            AbstractCacheEntry* new_entry,
+                                            uint64_t partition_id);
+
     // Explicitly free up this address
     void deallocate(Addr address);
 
     // Returns with the physical address of the conflicting cache line
     Addr cacheProbe(Addr address) const;
 
+    // Same as cacheProbe, for a line that will be allocated by the given
+    // partition. The victim is only chosen among the lines the
+    // partitioning policies allow the partition to replace.
+    Addr cacheProbe(Addr address, uint64_t partition_id) const;
+
     // looks an address up in the cache
     AbstractCacheEntry* lookup(Addr address);
     const AbstractCacheEntry* lookup(Addr address) const;
@@ -153,6 +172,12 @@ class CacheMemory : public SimObject
     // hardware transactional memory
     void htmAbortTransaction();
     void htmCommitTransaction();
+    // Add a line to the read/write set of the current transaction
+    void htmAddToReadSet(Addr addr);
+    void htmAddToWriteSet(Addr addr);
+    // Probe the read/write set signatures for a remote access to a line,
+    // and compare the answer with the exact per-line bits
+    void htmProfileSignatureCheck(Addr addr);
 
   public:
     int getCacheSize() const { return m_cache_size; }
@@ -161,6 +186,9 @@ class CacheMemory : public SimObject
     Addr getAddressAtIdx(int idx) const;
 
   private:
+    // Clear the transactional bits and locks of the recorded lines
+    void htmClearSets(bool abort);
+
     // convert a Address to its location in the cache
     int64_t addressToCacheSet(Addr address) const;
 
@@ -179,12 +207,18 @@ class CacheMemory : public SimObject
 
     // The first index is the # of cache lines.
     // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
 
+    // Packed copy of the addresses of the allocated entries, so that a
+    // whole set can be searched at once
+    PackedTagArray m_tag_index;
+
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
 
+    /** Optional cache partitioning, also shared with the Classic caches */
+    partitioning_policy::PartitionManager *m_partitionManager;
+
     BankedArray dataArray;
     BankedArray tagArray;
     ALUFreeListArray atomicALUArray;
@@ -213,6 +247,28 @@ class CacheMemory : public SimObject
      */
     bool m_use_occupancy;
 
+    /**
+     * Lines added to the read or write set of the current transaction,
+     * so that commits and aborts only visit the lines they touched
+     * instead of the whole cache.
+     */
+    std::vector<Addr> m_htmLines;
+
+    /**
+     * Optional signatures of the read and write sets, kept alongside
+     * the exact per-line bits. They are cleared at the end of every
+     * transaction.
+     */
+    bloom_filter::Base *m_htmReadSignature;
+    bloom_filter::Base *m_htmWriteSignature;
+
+    /**
+     * Lines that may hold an LL/SC lock, so that clearing all the locks
+     * doesn't need to walk the cache. A line that lost its lock (or got
+     * evicted) may linger here until the next walk of the set.
+     */
+    std::unordered_set<Addr> m_lockedLines;
+
     private:
       struct CacheMemoryStats : public statistics::Group
       {
@@ -234,6 +290,10 @@ class CacheMemory : public SimObject
           statistics::Histogram htmTransCommitWriteSet;
           statistics::Histogram htmTransAbortReadSet;
           statistics::Histogram htmTransAbortWriteSet;
+          statistics::Scalar htmSignatureChecks;
+          statistics::Scalar htmSignatureConflicts;
+          statistics::Scalar htmSignatureFalsePositives;
+          statistics::Formula htmSignatureFalsePositiveRate;
 
           statistics::Scalar m_demand_hits;
           statistics::Scalar m_demand_misses;
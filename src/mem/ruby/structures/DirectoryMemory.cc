@@ -56,34 +56,49 @@ namespace ruby
 {
 
 DirectoryMemory::DirectoryMemory(const Params &p)
-    : SimObject(p), addrRanges(p.addr_ranges.begin(), p.addr_ranges.end())
+    : SimObject(p), m_num_entries(0), m_resident_entries(0),
+      m_resident_pages(0), m_resident_bytes(0),
+      addrRanges(p.addr_ranges.begin(), p.addr_ranges.end()), stats(*this)
 {
     m_size_bytes = 0;
     for (const auto &r: addrRanges) {
         m_size_bytes += r.size();
     }
     m_size_bits = floorLog2(m_size_bytes);
-    m_num_entries = 0;
 }
 
 void
 DirectoryMemory::init()
 {
     m_num_entries = m_size_bytes / RubySystem::getBlockSizeBytes();
-    m_entries = new AbstractCacheEntry*[m_num_entries];
-    for (int i = 0; i < m_num_entries; i++)
-        m_entries[i] = NULL;
+    m_pages.resize(divCeil(m_num_entries, pageEntries));
+    m_resident_bytes = m_pages.size() * sizeof(m_pages[0]);
 }
 
 DirectoryMemory::~DirectoryMemory()
 {
     // free up all the directory entries
-    for (uint64_t i = 0; i < m_num_entries; i++) {
-        if (m_entries[i] != NULL) {
-            delete m_entries[i];
+    for (auto &page : m_pages) {
+        if (!page)
+            continue;
+        for (auto entry : page->entries) {
+            delete entry;
         }
     }
-    delete [] m_entries;
+}
+
+AbstractCacheEntry *&
+DirectoryMemory::slot(uint64_t idx)
+{
+    assert(idx < m_num_entries);
+    auto &page = m_pages[idx >> pageBits];
+    if (!page) {
+        page = std::make_unique<Page>();
+        m_resident_pages++;
+        m_resident_bytes += sizeof(Page);
+        stats.pageAllocations++;
+    }
+    return page->entries[idx & (pageEntries - 1)];
 }
 
 bool
@@ -119,7 +134,9 @@ DirectoryMemory::lookup(Addr address)
 
     uint64_t idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    return m_entries[idx];
+    // Looking up an entry never materializes its page
+    const auto &page = m_pages[idx >> pageBits];
+    return page ? page->entries[idx & (pageEntries - 1)] : NULL;
 }
 
 AbstractCacheEntry*
@@ -130,10 +147,12 @@ DirectoryMemory::allocate(Addr address, AbstractCacheEntry *entry)
     DPRINTF(RubyCache, "Looking up address: %#x\n", address);
 
     idx = mapAddressToLocalIdx(address);
-    assert(idx < m_num_entries);
-    assert(m_entries[idx] == NULL);
+    AbstractCacheEntry *&entry_slot = slot(idx);
+    assert(entry_slot == NULL);
     entry->changePermission(AccessPermission_Read_Only);
-    m_entries[idx] = entry;
+    entry_slot = entry;
+    m_pages[idx >> pageBits]->count++;
+    m_resident_entries++;
 
     return entry;
 }
@@ -147,9 +166,19 @@ DirectoryMemory::deallocate(Addr address)
 
     idx = mapAddressToLocalIdx(address);
     assert(idx < m_num_entries);
-    assert(m_entries[idx] != NULL);
-    delete m_entries[idx];
-    m_entries[idx] = NULL;
+    auto &page = m_pages[idx >> pageBits];
+    assert(page && page->entries[idx & (pageEntries - 1)] != NULL);
+    delete page->entries[idx & (pageEntries - 1)];
+    page->entries[idx & (pageEntries - 1)] = NULL;
+    m_resident_entries--;
+
+    // Give the page back as soon as it holds no entries
+    if (--page->count == 0) {
+        page.reset();
+        m_resident_pages--;
+        m_resident_bytes -= sizeof(Page);
+        stats.pageReleases++;
+    }
 }
 
 void
@@ -157,6 +186,25 @@ DirectoryMemory::print(std::ostream& out) const
 {
 }
 
+DirectoryMemory::DirectoryMemoryStats::DirectoryMemoryStats(
+    DirectoryMemory &dir)
+    : statistics::Group(&dir),
+      ADD_STAT(residentEntries, statistics::units::Count::get(),
+               "Number of directory entries currently allocated"),
+      ADD_STAT(residentPages, statistics::units::Count::get(),
+               "Number of directory pages currently allocated"),
+      ADD_STAT(residentBytes, statistics::units::Byte::get(),
+               "Host memory used by the directory entry table"),
+      ADD_STAT(pageAllocations, statistics::units::Count::get(),
+               "Number of directory pages allocated"),
+      ADD_STAT(pageReleases, statistics::units::Count::get(),
+               "Number of directory pages released when emptied")
+{
+    residentEntries.scalar(dir.m_resident_entries);
+    residentPages.scalar(dir.m_resident_pages);
+    residentBytes.scalar(dir.m_resident_bytes);
+}
+
 void
 DirectoryMemory::recordRequestType(DirectoryRequestType requestType) {
     DPRINTF(RubyStats, "Recorded statistic: %s\n",
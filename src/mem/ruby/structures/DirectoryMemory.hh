@@ -41,10 +41,14 @@
 #ifndef __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_DIRECTORYMEMORY_HH__
 
+#include <array>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/addr_range.hh"
+#include "base/statistics.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/DirectoryRequestType.hh"
 #include "mem/ruby/slicc_interface/AbstractCacheEntry.hh"
@@ -88,6 +92,9 @@ class DirectoryMemory : public SimObject
     // Explicitly free up this address
     void deallocate(Addr address);
 
+    /** Number of entries currently allocated in the directory. */
+    uint64_t getNumResidentEntries() const { return m_resident_entries; }
+
     void print(std::ostream& out) const;
     void recordRequestType(DirectoryRequestType requestType);
 
@@ -96,20 +103,52 @@ class DirectoryMemory : public SimObject
     DirectoryMemory(const DirectoryMemory& obj);
     DirectoryMemory& operator=(const DirectoryMemory& obj);
 
+    /**
+     * The entry slots are split into fixed-size pages that are only
+     * materialized when an entry in them is allocated, and released
+     * once their last entry is freed. This keeps the directory of a
+     * large, sparsely touched memory small.
+     */
+    static constexpr int pageBits = 10;
+    static constexpr uint64_t pageEntries = 1ULL << pageBits;
+
+    struct Page
+    {
+        std::array<AbstractCacheEntry *, pageEntries> entries{};
+        uint64_t count = 0;
+    };
+
+    AbstractCacheEntry *&slot(uint64_t idx);
+
   private:
     const std::string m_name;
-    AbstractCacheEntry **m_entries;
+    std::vector<std::unique_ptr<Page>> m_pages;
     // int m_size;  // # of memory module blocks this directory is
                     // responsible for
     uint64_t m_size_bytes;
     uint64_t m_size_bits;
     uint64_t m_num_entries;
 
+    uint64_t m_resident_entries;
+    uint64_t m_resident_pages;
+    uint64_t m_resident_bytes;
+
     /**
      * The address range for which the directory responds. Normally
      * this is all possible memory addresses.
      */
     const AddrRangeList addrRanges;
+
+    struct DirectoryMemoryStats : public statistics::Group
+    {
+        DirectoryMemoryStats(DirectoryMemory &dir);
+
+        statistics::Value residentEntries;
+        statistics::Value residentPages;
+        statistics::Value residentBytes;
+        statistics::Scalar pageAllocations;
+        statistics::Scalar pageReleases;
+    } stats;
 };
 
 inline std::ostream&
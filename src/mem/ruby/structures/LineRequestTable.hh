@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_RUBY_STRUCTURES_LINEREQUESTTABLE_HH__
+#define __MEM_RUBY_STRUCTURES_LINEREQUESTTABLE_HH__
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "mem/ruby/common/Address.hh"
+
+namespace gem5
+{
+
+namespace ruby
+{
+
+/**
+ * FIFO of the requests outstanding for a cache line. The first
+ * InlineSize requests are kept in an inline ring and only longer queues
+ * spill to the heap. Requests are only appended at the back and removed
+ * from the front, so a reference to the front request stays valid while
+ * new requests are appended, as it would with a std::list.
+ */
+template <class T, int InlineSize>
+class InlineRequestList
+{
+  public:
+    template <class List, class Value>
+    class Iter
+    {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iter(List *list, size_t pos) : list(list), pos(pos) {}
+
+        Value &operator*() const { return (*list)[pos]; }
+        Value *operator->() const { return &(*list)[pos]; }
+        Iter &operator++() { ++pos; return *this; }
+        Iter operator++(int) { Iter it = *this; ++pos; return it; }
+        bool operator==(const Iter &o) const { return pos == o.pos; }
+        bool operator!=(const Iter &o) const { return pos != o.pos; }
+
+      private:
+        List *list;
+        size_t pos;
+    };
+
+    typedef Iter<InlineRequestList, T> iterator;
+    typedef Iter<const InlineRequestList, const T> const_iterator;
+
+    bool empty() const { return m_inline_size == 0; }
+    size_t size() const { return m_inline_size + m_overflow.size(); }
+
+    T &
+    operator[](size_t i)
+    {
+        return i < m_inline_size ? m_inline[(m_head + i) % InlineSize] :
+                                   m_overflow[i - m_inline_size];
+    }
+
+    const T &
+    operator[](size_t i) const
+    {
+        return i < m_inline_size ? m_inline[(m_head + i) % InlineSize] :
+                                   m_overflow[i - m_inline_size];
+    }
+
+    T &front() { assert(!empty()); return m_inline[m_head]; }
+    const T &front() const { assert(!empty()); return m_inline[m_head]; }
+
+    void
+    push_back(T value)
+    {
+        // The heap part is only used once the ring is full, which keeps
+        // the requests in order
+        if (m_overflow.empty() && m_inline_size < InlineSize) {
+            m_inline[(m_head + m_inline_size) % InlineSize] =
+                std::move(value);
+            m_inline_size++;
+        } else {
+            m_overflow.push_back(std::move(value));
+        }
+    }
+
+    template <class... Args>
+    void
+    emplace_back(Args&&... args)
+    {
+        push_back(T(std::forward<Args>(args)...));
+    }
+
+    void
+    pop_front()
+    {
+        assert(!empty());
+        m_inline[m_head] = T();
+        m_head = (m_head + 1) % InlineSize;
+        m_inline_size--;
+        if (!m_overflow.empty()) {
+            m_inline[(m_head + m_inline_size) % InlineSize] =
+                std::move(m_overflow.front());
+            m_overflow.erase(m_overflow.begin());
+            m_inline_size++;
+        }
+    }
+
+    void
+    clear()
+    {
+        while (!empty())
+            pop_front();
+        m_head = 0;
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+  private:
+    T m_inline[InlineSize] = {};
+    size_t m_head = 0;
+    size_t m_inline_size = 0;
+    std::vector<T> m_overflow;
+};
+
+/**
+ * Table of the requests outstanding per cache line, used in place of a
+ * std::unordered_map<Addr, std::list<T>> by the sequencers. The entries
+ * live in a pool sized for the expected number of outstanding lines and
+ * are located through an open-addressing index, so inserting and
+ * removing lines doesn't allocate in the common case. Entries never move
+ * once allocated: references to an entry's list stay valid while other
+ * lines are inserted or erased.
+ */
+template <class T, int InlineSize = 4>
+class LineRequestTable
+{
+  public:
+    typedef InlineRequestList<T, InlineSize> List;
+
+    struct Entry
+    {
+        Addr first = 0;
+        List second;
+        bool valid = false;
+    };
+
+    template <class Table, class Value>
+    class Iter
+    {
+      public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iter(Table *table, size_t pos) : table(table), pos(pos) { skip(); }
+
+        Value &operator*() const { return table->m_entries[pos]; }
+        Value *operator->() const { return &table->m_entries[pos]; }
+        Iter &operator++() { ++pos; skip(); return *this; }
+        bool operator==(const Iter &o) const { return pos == o.pos; }
+        bool operator!=(const Iter &o) const { return pos != o.pos; }
+
+      private:
+        void
+        skip()
+        {
+            while (pos < table->m_entries.size() &&
+                   !table->m_entries[pos].valid) {
+                ++pos;
+            }
+        }
+
+        Table *table;
+        size_t pos;
+    };
+
+    typedef Iter<LineRequestTable, Entry> iterator;
+    typedef Iter<const LineRequestTable, const Entry> const_iterator;
+
+    /**
+     * @param expected_lines Number of lines expected to be outstanding
+     *        at once, normally the requestor's max_outstanding_requests.
+     *        The table grows past it if needed.
+     */
+    explicit LineRequestTable(int expected_lines)
+        : m_entries(expected_lines), m_size(0), m_used(0)
+    {
+        assert(expected_lines > 0);
+        m_slots.resize(size_t(1) << ceilLog2(2 * expected_lines), Slot());
+        for (int i = expected_lines - 1; i >= 0; i--)
+            m_free.push_back(i);
+    }
+
+    bool empty() const { return m_size == 0; }
+    size_t size() const { return m_size; }
+    size_t count(Addr addr) const { return findSlot(addr) >= 0 ? 1 : 0; }
+
+    iterator
+    find(Addr addr)
+    {
+        int64_t slot = findSlot(addr);
+        return slot < 0 ? end() : iterator(this, m_slots[slot].entry);
+    }
+
+    const_iterator
+    find(Addr addr) const
+    {
+        int64_t slot = findSlot(addr);
+        return slot < 0 ? end() : const_iterator(this, m_slots[slot].entry);
+    }
+
+    List &
+    at(Addr addr)
+    {
+        int64_t slot = findSlot(addr);
+        assert(slot >= 0);
+        return m_entries[m_slots[slot].entry].second;
+    }
+
+    /** Return the list of a line, adding an empty one if needed. */
+    List &
+    operator[](Addr addr)
+    {
+        int64_t slot = findSlot(addr);
+        if (slot >= 0)
+            return m_entries[m_slots[slot].entry].second;
+        return insert(addr).second;
+    }
+
+    void
+    erase(Addr addr)
+    {
+        int64_t slot = findSlot(addr);
+        if (slot < 0)
+            return;
+
+        Entry &entry = m_entries[m_slots[slot].entry];
+        entry.second.clear();
+        entry.valid = false;
+        m_free.push_back(m_slots[slot].entry);
+        m_slots[slot].entry = Slot::Deleted;
+        m_size--;
+    }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_entries.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator
+    end() const
+    {
+        return const_iterator(this, m_entries.size());
+    }
+
+  private:
+    struct Slot
+    {
+        static constexpr int64_t Empty = -1;
+        static constexpr int64_t Deleted = -2;
+
+        Addr addr = 0;
+        int64_t entry = Empty;
+    };
+
+    size_t
+    hash(Addr addr) const
+    {
+        // Fibonacci hashing spreads line addresses, whose low bits are
+        // all zero, over the whole index
+        return (addr * 0x9e3779b97f4a7c15ULL) >> 32 & (m_slots.size() - 1);
+    }
+
+    int64_t
+    findSlot(Addr addr) const
+    {
+        for (size_t i = hash(addr); ; i = (i + 1) & (m_slots.size() - 1)) {
+            const Slot &slot = m_slots[i];
+            if (slot.entry == Slot::Empty)
+                return -1;
+            if (slot.entry >= 0 && slot.addr == addr)
+                return i;
+        }
+    }
+
+    Entry &
+    insert(Addr addr)
+    {
+        // Keep the index at most half full, rebuilding it to drop the
+        // deleted slots or to grow it
+        if (2 * (m_used + 1) > m_slots.size())
+            rehash(2 * (m_size + 1) > m_slots.size() / 2 ?
+                   2 * m_slots.size() : m_slots.size());
+
+        if (m_free.empty()) {
+            m_free.push_back(m_entries.size());
+            m_entries.emplace_back();
+        }
+        int64_t idx = m_free.back();
+        m_free.pop_back();
+
+        size_t i = hash(addr);
+        while (m_slots[i].entry >= 0)
+            i = (i + 1) & (m_slots.size() - 1);
+        if (m_slots[i].entry == Slot::Empty)
+            m_used++;
+        m_slots[i].addr = addr;
+        m_slots[i].entry = idx;
+
+        Entry &entry = m_entries[idx];
+        entry.first = addr;
+        entry.valid = true;
+        m_size++;
+        return entry;
+    }
+
+    void
+    rehash(size_t num_slots)
+    {
+        std::vector<Slot> old_slots(num_slots, Slot());
+        old_slots.swap(m_slots);
+        m_used = 0;
+        for (const auto &slot : old_slots) {
+            if (slot.entry < 0)
+                continue;
+            size_t i = hash(slot.addr);
+            while (m_slots[i].entry != Slot::Empty)
+                i = (i + 1) & (m_slots.size() - 1);
+            m_slots[i] = slot;
+            m_used++;
+        }
+    }
+
+    // Entries are never moved, the deque keeps them in place as it grows
+    std::deque<Entry> m_entries;
+    std::vector<int64_t> m_free;
+    std::vector<Slot> m_slots;
+    size_t m_size;
+    // Slots that are in use or deleted, which both lengthen probes
+    size_t m_used;
+};
+
+} // namespace ruby
+} // namespace gem5
+
+#endif // __MEM_RUBY_STRUCTURES_LINEREQUESTTABLE_HH__
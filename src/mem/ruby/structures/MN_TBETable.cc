@@ -54,8 +54,10 @@ MN_TBETable::chooseNewDistributor()
     std::vector<MiscNode_TBE*> potential_sync_dependency_tbes;
     bool has_waiting_sync = false;
     int waiting_count = 0;
-    for (auto& keyValuePair : m_map) {
-        MiscNode_TBE& tbe = keyValuePair.second;
+    for (int slot = 0; slot < m_entries.size(); slot++) {
+        if (!m_used[slot])
+            continue;
+        MiscNode_TBE& tbe = m_entries[slot];
 
         switch (tbe.getstate()) {
             case MiscNode_State_DvmSync_Distributing:
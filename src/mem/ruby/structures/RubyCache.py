@@ -54,4 +54,19 @@ class RubyCache(SimObject):
     dataAccessLatency = Param.Cycles(1, "cycles for a data array access")
     tagAccessLatency = Param.Cycles(1, "cycles for a tag array access")
     resourceStalls = Param.Bool(False, "stall if there is a resource failure")
+
+    # Hardware transactional memory: optional signatures of the read and
+    # write sets, only used to profile how often a signature based
+    # conflict detection would report false conflicts
+    htm_read_signature = Param.BloomFilterBase(
+        NULL, "Signature of the HTM read set"
+    )
+    htm_write_signature = Param.BloomFilterBase(
+        NULL, "Signature of the HTM write set"
+    )
+    # Optional cache partitioning, see CacheMemory::cacheProbe and
+    # CacheMemory::allocateInPartition
+    partitioning_manager = Param.PartitionManager(
+        NULL, "Cache partitioning manager"
+    )
     ruby_system = Param.RubySystem(Parent.any, "")
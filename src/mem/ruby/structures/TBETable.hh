@@ -41,9 +41,13 @@
 #ifndef __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 
+#include "base/intmath.hh"
 #include "mem/ruby/common/Address.hh"
 
 namespace gem5
@@ -52,13 +56,28 @@ namespace gem5
 namespace ruby
 {
 
+/**
+ * The TBEs are stored in a fixed array of slots allocated upfront, and
+ * an open addressing hash table (linear probing with backward shift
+ * deletion) maps the line addresses to their slot. Allocating, looking
+ * up and deallocating a TBE never allocates memory, and a TBE stays at
+ * the same slot, hence at the same address, while it is allocated.
+ */
 template<class ENTRY>
 class TBETable
 {
   public:
     TBETable(int number_of_TBEs)
-        : m_number_of_TBEs(number_of_TBEs)
+        : m_entries(number_of_TBEs), m_used(number_of_TBEs, false),
+          m_num_used(0), m_number_of_TBEs(number_of_TBEs)
     {
+        // Keep the load factor of the hash table under 1/2
+        const int buckets = std::max(2, 2 * number_of_TBEs);
+        m_hash_bits = ceilLog2(buckets);
+        m_buckets.resize(1ULL << m_hash_bits, Bucket{0, -1});
+        m_free_slots.reserve(number_of_TBEs);
+        for (int slot = number_of_TBEs - 1; slot >= 0; slot--)
+            m_free_slots.push_back(slot);
     }
 
     bool isPresent(Addr address) const;
@@ -67,7 +86,7 @@ class TBETable
     bool
     areNSlotsAvailable(int n, Tick current_time) const
     {
-        return (m_number_of_TBEs - m_map.size()) >= n;
+        return (m_number_of_TBEs - m_num_used) >= n;
     }
 
     ENTRY *getNullEntry();
@@ -82,9 +101,41 @@ class TBETable
     TBETable& operator=(const TBETable& obj);
 
     // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+
+    // The TBE slots, m_used tells which ones are allocated
+    std::vector<ENTRY> m_entries;
+    std::vector<bool> m_used;
+    int m_num_used;
 
   private:
+    struct Bucket
+    {
+        Addr address;
+        // Slot of the TBE, -1 if the bucket is empty
+        int slot;
+    };
+
+    unsigned
+    bucketOf(Addr address) const
+    {
+        // Fibonacci hashing of the line address
+        return (makeLineAddress(address) * 0x9e3779b97f4a7c15ULL) >>
+            (64 - m_hash_bits);
+    }
+
+    unsigned
+    nextBucket(unsigned bucket) const
+    {
+        return (bucket + 1) & (m_buckets.size() - 1);
+    }
+
+    // Bucket holding the address, or the empty bucket ending its probe
+    unsigned findBucket(Addr address) const;
+
+    std::vector<Bucket> m_buckets;
+    unsigned m_hash_bits;
+    std::vector<int> m_free_slots;
+
     int m_number_of_TBEs;
 };
 
@@ -97,22 +148,41 @@ operator<<(std::ostream& out, const TBETable<ENTRY>& obj)
     return out;
 }
 
+template<class ENTRY>
+inline unsigned
+TBETable<ENTRY>::findBucket(Addr address) const
+{
+    unsigned bucket = bucketOf(address);
+    while (m_buckets[bucket].slot >= 0 &&
+           m_buckets[bucket].address != address) {
+        bucket = nextBucket(bucket);
+    }
+    return bucket;
+}
+
 template<class ENTRY>
 inline bool
 TBETable<ENTRY>::isPresent(Addr address) const
 {
     assert(address == makeLineAddress(address));
-    assert(m_map.size() <= m_number_of_TBEs);
-    return !!m_map.count(address);
+    assert(m_num_used <= m_number_of_TBEs);
+    return m_buckets[findBucket(address)].slot >= 0;
 }
 
 template<class ENTRY>
 inline void
 TBETable<ENTRY>::allocate(Addr address)
 {
-    assert(!isPresent(address));
-    assert(m_map.size() < m_number_of_TBEs);
-    m_map[address] = ENTRY();
+    assert(m_num_used < m_number_of_TBEs);
+    const unsigned bucket = findBucket(address);
+    assert(m_buckets[bucket].slot < 0);
+
+    // Free slots are reset when deallocated
+    const int slot = m_free_slots.back();
+    m_free_slots.pop_back();
+    m_buckets[bucket] = Bucket{address, slot};
+    m_used[slot] = true;
+    m_num_used++;
 }
 
 template<class ENTRY>
@@ -120,8 +190,31 @@ inline void
 TBETable<ENTRY>::deallocate(Addr address)
 {
     assert(isPresent(address));
-    assert(m_map.size() > 0);
-    m_map.erase(address);
+    assert(m_num_used > 0);
+    unsigned bucket = findBucket(address);
+    const int slot = m_buckets[bucket].slot;
+
+    m_entries[slot] = ENTRY();
+    m_used[slot] = false;
+    m_free_slots.push_back(slot);
+    m_num_used--;
+
+    // Shift back the following entries of the probe sequence so that
+    // lookups never need to skip over deleted buckets
+    unsigned hole = bucket;
+    for (bucket = nextBucket(bucket); m_buckets[bucket].slot >= 0;
+         bucket = nextBucket(bucket)) {
+        const unsigned home = bucketOf(m_buckets[bucket].address);
+        // Move the entry if its home bucket isn't within (hole, bucket]
+        const bool in_range = hole <= bucket ?
+            (home > hole && home <= bucket) :
+            (home > hole || home <= bucket);
+        if (!in_range) {
+            m_buckets[hole] = m_buckets[bucket];
+            hole = bucket;
+        }
+    }
+    m_buckets[hole].slot = -1;
 }
 
 template<class ENTRY>
@@ -136,8 +229,8 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    const int slot = m_buckets[findBucket(address)].slot;
+    return slot >= 0 ? &m_entries[slot] : nullptr;
 }
 
 
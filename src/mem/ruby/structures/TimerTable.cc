@@ -28,6 +28,9 @@
 
 #include "mem/ruby/structures/TimerTable.hh"
 
+#include <algorithm>
+#include <functional>
+
 #include "mem/ruby/system/RubySystem.hh"
 
 namespace gem5
@@ -37,11 +40,8 @@ namespace ruby
 {
 
 TimerTable::TimerTable()
-    : m_next_time(0)
 {
     m_consumer_ptr  = NULL;
-    m_next_valid = false;
-    m_next_address = 0;
 }
 
 bool
@@ -50,21 +50,17 @@ TimerTable::isReady(Tick curTime) const
     if (m_map.empty())
         return false;
 
-    if (!m_next_valid) {
-        updateNext();
-    }
-    assert(m_next_valid);
-    return (curTime >= m_next_time);
+    prune();
+    assert(!m_heap.empty());
+    return (curTime >= m_heap.front().first);
 }
 
 Addr
 TimerTable::nextAddress() const
 {
-    if (!m_next_valid) {
-        updateNext();
-    }
-    assert(m_next_valid);
-    return m_next_address;
+    prune();
+    assert(!m_heap.empty());
+    return m_heap.front().second;
 }
 
 void
@@ -74,14 +70,10 @@ TimerTable::set(Addr address, Tick ready_time)
     assert(!m_map.count(address));
 
     m_map[address] = ready_time;
+    m_heap.emplace_back(ready_time, address);
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
     assert(m_consumer_ptr != NULL);
     m_consumer_ptr->scheduleEventAbsolute(ready_time);
-    m_next_valid = false;
-
-    // Don't always recalculate the next ready address
-    if (ready_time <= m_next_time) {
-        m_next_valid = false;
-    }
 }
 
 void
@@ -91,9 +83,16 @@ TimerTable::unset(Addr address)
     assert(m_map.count(address));
     m_map.erase(address);
 
-    // Don't always recalculate the next ready address
-    if (address == m_next_address) {
-        m_next_valid = false;
+    // Don't let the stale entries pile up if timers keep being unset
+    // before they are ready
+    if (m_heap.size() > 2 * m_map.size() + 16) {
+        m_heap.erase(std::remove_if(m_heap.begin(), m_heap.end(),
+            [this](const HeapEntry &e) {
+                auto it = m_map.find(e.second);
+                return it == m_map.end() || it->second != e.first;
+            }), m_heap.end());
+        std::make_heap(m_heap.begin(), m_heap.end(),
+                       std::greater<HeapEntry>());
     }
 }
 
@@ -103,28 +102,17 @@ TimerTable::print(std::ostream& out) const
 }
 
 void
-TimerTable::updateNext() const
+TimerTable::prune() const
 {
-    if (m_map.empty()) {
-        assert(!m_next_valid);
-        return;
+    while (!m_heap.empty()) {
+        const HeapEntry &top = m_heap.front();
+        auto it = m_map.find(top.second);
+        if (it != m_map.end() && it->second == top.first)
+            return;
+        std::pop_heap(m_heap.begin(), m_heap.end(),
+                      std::greater<HeapEntry>());
+        m_heap.pop_back();
     }
-
-    AddressMap::const_iterator i = m_map.begin();
-    AddressMap::const_iterator end = m_map.end();
-
-    m_next_address = i->first;
-    m_next_time = i->second;
-    ++i;
-
-    for (; i != end; ++i) {
-        if (i->second < m_next_time) {
-            m_next_address = i->first;
-            m_next_time = i->second;
-        }
-    }
-
-    m_next_valid = true;
 }
 
 } // namespace ruby
@@ -31,8 +31,10 @@
 
 #include <cassert>
 #include <iostream>
-#include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/common/Consumer.hh"
@@ -69,7 +71,8 @@ class TimerTable
     void print(std::ostream& out) const;
 
   private:
-    void updateNext() const;
+    // Drop the stale entries from the top of the heap
+    void prune() const;
 
     // Private copy constructor and assignment operator
     TimerTable(const TimerTable& obj);
@@ -77,13 +80,15 @@ class TimerTable
 
     // Data Members (m_prefix)
 
-    // use a std::map for the address map as this container is sorted
-    // and ensures a well-defined iteration order
-    typedef std::map<Addr, Tick> AddressMap;
+    typedef std::unordered_map<Addr, Tick> AddressMap;
     AddressMap m_map;
-    mutable bool m_next_valid;
-    mutable Tick m_next_time; // Only valid if m_next_valid is true
-    mutable Addr m_next_address;  // Only valid if m_next_valid is true
+
+    // Min-heap of the (ready time, address) pairs, so that the next
+    // address is the one with the earliest time and then the lowest
+    // address. Unset timers are removed lazily: an entry is stale if the
+    // address isn't in m_map with the same ready time anymore.
+    typedef std::pair<Tick, Addr> HeapEntry;
+    mutable std::vector<HeapEntry> m_heap;
 
     //! Consumer to signal a wakeup()
     Consumer* m_consumer_ptr;
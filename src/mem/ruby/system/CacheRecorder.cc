@@ -31,6 +31,7 @@
 
 #include "debug/RubyCacheTrace.hh"
 #include "mem/packet.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
 #include "sim/sim_exit.hh"
@@ -50,24 +51,30 @@ TraceRecord::print(std::ostream& out) const
 }
 
 CacheRecorder::CacheRecorder()
-    : m_uncompressed_trace(NULL),
-      m_uncompressed_trace_size(0),
-      m_block_size_bytes(RubySystem::getBlockSizeBytes())
+    : m_trace(NULL),
+      m_trace_size(0),
+      m_record(NULL),
+      m_block_size_bytes(RubySystem::getBlockSizeBytes()),
+      m_direct_install(false)
 {
 }
 
-CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
-                             uint64_t uncompressed_trace_size,
+CacheRecorder::CacheRecorder(gzFile trace,
+                             uint64_t trace_size,
                              std::vector<RubyPort*>& ruby_port_map,
-                             uint64_t block_size_bytes)
-    : m_uncompressed_trace(uncompressed_trace),
-      m_uncompressed_trace_size(uncompressed_trace_size),
-      m_ruby_port_map(ruby_port_map), m_bytes_read(0),
-      m_records_read(0), m_records_flushed(0),
-      m_block_size_bytes(block_size_bytes)
+                             std::vector<AbstractController*>& cntrls,
+                             uint64_t block_size_bytes,
+                             bool direct_install)
+    : m_trace(trace),
+      m_trace_size(trace_size),
+      m_record(NULL),
+      m_ruby_port_map(ruby_port_map), m_cntrls(cntrls), m_bytes_read(0),
+      m_records_read(0), m_records_installed(0), m_records_flushed(0),
+      m_block_size_bytes(block_size_bytes),
+      m_direct_install(direct_install)
 
 {
-    if (m_uncompressed_trace != NULL) {
+    if (m_trace != NULL) {
         if (m_block_size_bytes < RubySystem::getBlockSizeBytes()) {
             // Block sizes larger than when the trace was recorded are not
             // supported, as we cannot reliably turn accesses to smaller blocks
@@ -75,15 +82,25 @@ CacheRecorder::CacheRecorder(uint8_t* uncompressed_trace,
             panic("Recorded cache block size (%d) < current block size (%d) !!",
                     m_block_size_bytes, RubySystem::getBlockSizeBytes());
         }
+        m_record = (TraceRecord*)malloc(sizeof(TraceRecord) +
+                                        m_block_size_bytes);
     }
 }
 
 CacheRecorder::~CacheRecorder()
 {
-    if (m_uncompressed_trace != NULL) {
-        delete [] m_uncompressed_trace;
-        m_uncompressed_trace = NULL;
+    if (m_trace != NULL) {
+        if (gzclose(m_trace)) {
+            warn("Failed to close cache trace file\n");
+        }
+        m_trace = NULL;
+    }
+    free(m_record);
+    m_record = NULL;
+    for (auto rec : m_records) {
+        free(rec);
     }
+    m_records.clear();
     m_ruby_port_map.clear();
 }
 
@@ -93,9 +110,9 @@ CacheRecorder::enqueueNextFlushRequest()
     if (m_records_flushed < m_records.size()) {
         TraceRecord* rec = m_records[m_records_flushed];
         m_records_flushed++;
-        auto req = std::make_shared<Request>(rec->m_data_address,
-                                             m_block_size_bytes, 0,
-                                             Request::funcRequestorId);
+        auto req = Request::create(rec->m_data_address,
+                                   m_block_size_bytes, 0,
+                                   Request::funcRequestorId);
         MemCmd::Command requestType = MemCmd::FlushReq;
         Packet *pkt = new Packet(req, requestType);
         pkt->req->setReqInstSeqNum(m_records_flushed);
@@ -115,13 +132,65 @@ CacheRecorder::enqueueNextFlushRequest()
     }
 }
 
+TraceRecord*
+CacheRecorder::readNextRecord()
+{
+    if (m_bytes_read >= m_trace_size) {
+        return NULL;
+    }
+
+    int record_size = sizeof(TraceRecord) + m_block_size_bytes;
+    if (gzread(m_trace, m_record, record_size) != record_size) {
+        fatal("Unable to read record %d from the cache trace\n",
+              m_records_read);
+    }
+    m_bytes_read += record_size;
+    m_records_read++;
+    return m_record;
+}
+
+bool
+CacheRecorder::installRecord(const TraceRecord* rec)
+{
+    AbstractController* owner = m_cntrls[rec->m_cntrl_id];
+    MachineID requestor = owner->getMachineID();
+    DataBlock data;
+
+    // Every block of the current size covered by the record has to be
+    // installed, otherwise the whole record is replayed.
+    for (int offset = 0; offset < m_block_size_bytes;
+            offset += RubySystem::getBlockSizeBytes()) {
+        Addr addr = rec->m_data_address + offset;
+        data.setData(rec->m_data + offset, 0,
+                     RubySystem::getBlockSizeBytes());
+        if (!owner->warmupInstall(addr, rec->m_type, requestor, data)) {
+            return false;
+        }
+        for (auto cntrl : m_cntrls) {
+            if (cntrl != owner) {
+                cntrl->warmupInstall(addr, rec->m_type, requestor, data);
+            }
+        }
+    }
+    return true;
+}
+
 void
 CacheRecorder::enqueueNextFetchRequest()
 {
-    if (m_bytes_read < m_uncompressed_trace_size) {
-        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
-                                                                m_bytes_read);
+    TraceRecord* traceRecord = readNextRecord();
+
+    // Install as many records as possible without simulating anything.
+    // The first one that can't be installed is replayed, and this
+    // function is called again when its requests complete.
+    while (m_direct_install && traceRecord != NULL &&
+           installRecord(traceRecord)) {
+        DPRINTF(RubyCacheTrace, "Installed %s\n", *traceRecord);
+        m_records_installed++;
+        traceRecord = readNextRecord();
+    }
 
+    if (traceRecord != NULL) {
         DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
 
         for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
@@ -131,26 +200,29 @@ CacheRecorder::enqueueNextFetchRequest()
 
             if (traceRecord->m_type == RubyRequestType_LD) {
                 requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                     traceRecord->m_data_address + rec_bytes_read,
                     RubySystem::getBlockSizeBytes(), 0,
                                     Request::funcRequestorId);
             }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
                 requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                         traceRecord->m_data_address + rec_bytes_read,
                         RubySystem::getBlockSizeBytes(),
                         Request::INST_FETCH, Request::funcRequestorId);
             }   else {
                 requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
+                req = Request::create(
                     traceRecord->m_data_address + rec_bytes_read,
                     RubySystem::getBlockSizeBytes(), 0,
                                 Request::funcRequestorId);
             }
 
+            // The record buffer is reused for the next record, so every
+            // packet gets its own copy of the data.
             Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
+            pkt->allocate();
+            pkt->setData(traceRecord->m_data + rec_bytes_read);
             pkt->req->setReqInstSeqNum(m_records_read);
 
 
@@ -159,12 +231,10 @@ CacheRecorder::enqueueNextFetchRequest()
             assert(m_ruby_port_ptr != NULL);
             m_ruby_port_ptr->makeRequest(pkt);
         }
-
-        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
-        m_records_read++;
     } else {
         exitSimLoop("Finished Warmup", 0);
-        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+        DPRINTF(RubyCacheTrace, "Fetched all %d records, %d installed\n",
+                m_records_read, m_records_installed);
     }
 }
 
@@ -188,7 +258,7 @@ CacheRecorder::addRecord(int cntrl, Addr data_addr, Addr pc_addr,
 }
 
 uint64_t
-CacheRecorder::aggregateRecords(uint8_t **buf, uint64_t total_size)
+CacheRecorder::writeRecords(gzFile trace)
 {
     std::sort(m_records.begin(), m_records.end(), compareTraceRecords);
 
@@ -197,22 +267,9 @@ CacheRecorder::aggregateRecords(uint8_t **buf, uint64_t total_size)
     int record_size = sizeof(TraceRecord) + m_block_size_bytes;
 
     for (int i = 0; i < size; ++i) {
-        // Determine if we need to expand the buffer size
-        if (current_size + record_size > total_size) {
-            uint8_t* new_buf = new (std::nothrow) uint8_t[total_size * 2];
-            if (new_buf == NULL) {
-                fatal("Unable to allocate buffer of size %s\n",
-                      total_size * 2);
-            }
-            total_size = total_size * 2;
-            uint8_t* old_buf = *buf;
-            memcpy(new_buf, old_buf, current_size);
-            *buf = new_buf;
-            delete [] old_buf;
+        if (gzwrite(trace, m_records[i], record_size) != record_size) {
+            fatal("Unable to write record %d to the cache trace\n", i);
         }
-
-        // Copy the current record into the buffer
-        memcpy(&((*buf)[current_size]), m_records[i], record_size);
         current_size += record_size;
 
         free(m_records[i]);
@@ -35,6 +35,8 @@
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <zlib.h>
+
 #include <vector>
 
 #include "base/types.hh"
@@ -49,6 +51,7 @@ namespace gem5
 namespace ruby
 {
 
+class AbstractController;
 class Sequencer;
 class RubyPort;
 /*!
@@ -76,14 +79,27 @@ class CacheRecorder
     CacheRecorder();
     ~CacheRecorder();
 
-    CacheRecorder(uint8_t* uncompressed_trace,
-                  uint64_t uncompressed_trace_size,
+    /*!
+     * Create a recorder that replays a trace. The records are read from
+     * the compressed trace one at a time as they are replayed, so the
+     * recorder takes ownership of the file and closes it when done.
+     * If direct_install is set, records are first offered to the
+     * controllers' warmupInstall() hooks and only the ones that are
+     * refused are replayed through the sequencers.
+     */
+    CacheRecorder(gzFile trace, uint64_t trace_size,
                   std::vector<RubyPort*>& ruby_port_map,
-                  uint64_t block_size_bytes);
+                  std::vector<AbstractController*>& cntrls,
+                  uint64_t block_size_bytes, bool direct_install);
     void addRecord(int cntrl, Addr data_addr, Addr pc_addr,
                    RubyRequestType type, Tick time, DataBlock& data);
 
-    uint64_t aggregateRecords(uint8_t **data, uint64_t size);
+    /*!
+     * Sort the recorded entries and write them to the compressed trace
+     * one record at a time. The records are freed as they are written.
+     * Returns the uncompressed size of the trace.
+     */
+    uint64_t writeRecords(gzFile trace);
 
     uint64_t getNumRecords() const;
 
@@ -111,14 +127,28 @@ class CacheRecorder
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
+    /** Read the next record of the trace, or nullptr at its end. */
+    TraceRecord* readNextRecord();
+
+    /**
+     * Try to install a record through the warmupInstall() hook of the
+     * controller that recorded it. The other controllers are then told
+     * about the installed blocks so they can update directory state.
+     */
+    bool installRecord(const TraceRecord* rec);
+
     std::vector<TraceRecord*> m_records;
-    uint8_t* m_uncompressed_trace;
-    uint64_t m_uncompressed_trace_size;
+    gzFile m_trace;
+    uint64_t m_trace_size;
+    TraceRecord* m_record;
     std::vector<RubyPort*> m_ruby_port_map;
+    std::vector<AbstractController*> m_cntrls;
     uint64_t m_bytes_read;
     uint64_t m_records_read;
+    uint64_t m_records_installed;
     uint64_t m_records_flushed;
     uint64_t m_block_size_bytes;
+    bool m_direct_install;
 };
 
 inline bool
@@ -31,6 +31,8 @@
 
 #include "mem/ruby/system/GPUCoalescer.hh"
 
+#include <algorithm>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "base/str.hh"
@@ -209,6 +211,7 @@ GPUCoalescer::GPUCoalescer(const Params &p)
       issueEvent([this]{ completeIssue(); }, "Issue coalesced request",
                  false, Event::Progress_Event_Pri),
       uncoalescedTable(this),
+      coalescedTable(p.max_outstanding_requests),
       deadlockCheckEvent([this]{ wakeup(); }, "GPUCoalescer deadlock check"),
       gmTokenPort(name() + ".gmTokenPort")
 {
@@ -568,7 +571,6 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
     // MUST ADD DOING THIS FOR EACH REQUEST IN COALESCER
     std::vector<PacketPtr> pktList = crequest->getPackets();
 
-    uint8_t* log = nullptr;
     DPRINTF(GPUCoalescer, "Responding to %d packets for addr 0x%X\n",
             pktList.size(), request_line_address);
     uint32_t offset;
@@ -606,10 +608,8 @@ GPUCoalescer::hitCallback(CoalescedRequest* crequest,
 
                     // Log entry contains the old value before the current
                     // atomic operation occurred.
-                    log = data.popAtomicLogEntryFront();
-                    pkt->setData(&log[offset]);
-                    delete [] log;
-                    log = nullptr;
+                    pkt->setData(&data.getAtomicLogEntryFront()[offset]);
+                    data.popAtomicLogEntryFront();
                     break;
                 default:
                     panic("Unsupported ruby packet type:%s\n",
@@ -760,21 +760,25 @@ GPUCoalescer::getDynInst(PacketPtr pkt) const
 }
 
 bool
-GPUCoalescer::coalescePacket(PacketPtr pkt)
+GPUCoalescer::coalesceLine(Addr line_addr, PacketPtr *pkts, int num_pkts)
 {
+    PacketPtr pkt = pkts[0];
     uint64_t seqNum = pkt->req->getReqInstSeqNum();
-    Addr line_addr = makeLineAddress(pkt->getAddr());
 
-    // If the packet has the same line address as a request already in the
-    // coalescedTable and has the same sequence number, it can be coalesced.
-    if (coalescedTable.count(line_addr)) {
+    // If the packets have the same line address as a request already in
+    // the coalescedTable and have the same sequence number, they can be
+    // coalesced.
+    auto line = coalescedTable.find(line_addr);
+    if (line != coalescedTable.end()) {
         // Search for a previous coalesced request with the same seqNum.
-        auto& creqQueue = coalescedTable.at(line_addr);
+        auto& creqQueue = line->second;
         auto citer = std::find_if(creqQueue.begin(), creqQueue.end(),
             [&](CoalescedRequest* c) { return c->getSeqNum() == seqNum; }
         );
         if (citer != creqQueue.end()) {
-            (*citer)->insertPacket(pkt);
+            for (int i = 0; i < num_pkts; ++i) {
+                (*citer)->insertPacket(pkts[i]);
+            }
             return true;
         }
     }
@@ -786,15 +790,17 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
                 line_addr);
 
         CoalescedRequest *creq = new CoalescedRequest(seqNum);
-        creq->insertPacket(pkt);
+        for (int i = 0; i < num_pkts; ++i) {
+            creq->insertPacket(pkts[i]);
+        }
         creq->setRubyType(getRequestType(pkt));
         creq->setIssueTime(curCycle());
 
-        if (!coalescedTable.count(line_addr)) {
+        if (line == coalescedTable.end()) {
             // If there is no outstanding request for this line address,
             // create a new coalecsed request and issue it immediately.
             auto reqList = std::deque<CoalescedRequest*> { creq };
-            coalescedTable.insert(std::make_pair(line_addr, reqList));
+            coalescedTable[line_addr].push_back(creq);
             if (!coalescedReqs.count(seqNum)) {
                 coalescedReqs.insert(std::make_pair(seqNum, reqList));
             } else {
@@ -804,7 +810,7 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
             // The request is for a line address that is already outstanding
             // but for a different instruction. Add it as a new request to be
             // issued when the current outstanding request is completed.
-            coalescedTable.at(line_addr).push_back(creq);
+            line->second.push_back(creq);
             DPRINTF(GPUCoalescer, "found address 0x%X with new seqNum %d\n",
                     line_addr, seqNum);
         }
@@ -853,6 +859,72 @@ GPUCoalescer::coalescePacket(PacketPtr pkt)
     return false;
 }
 
+void
+GPUCoalescer::coalesceInstPackets(PerInstPackets &pkt_list)
+{
+    /**
+     * Group the packets of the instruction by line before touching the
+     * coalescing tables, so each line is looked up once rather than once
+     * per lane. The packets are sorted by line and, within a line, by
+     * lane. The lines are then coalesced in the order of their first
+     * packet, and the packets of a line in lane order, which is the order
+     * in which coalescing them one by one would have created and filled
+     * the requests.
+     */
+    coalesceLanes.clear();
+    int lane = 0;
+    for (auto pkt : pkt_list) {
+        coalesceLanes.push_back({makeLineAddress(pkt->getAddr()), lane++,
+                                 pkt});
+    }
+
+    std::sort(coalesceLanes.begin(), coalesceLanes.end(),
+        [](const CoalesceLane &a, const CoalesceLane &b) {
+            return a.lineAddr != b.lineAddr ? a.lineAddr < b.lineAddr
+                                            : a.lane < b.lane;
+        });
+
+    // (first lane, first index in coalesceLanes) of every line
+    coalesceLines.clear();
+    for (int i = 0; i < coalesceLanes.size(); ++i) {
+        if (i == 0 ||
+            coalesceLanes[i].lineAddr != coalesceLanes[i - 1].lineAddr) {
+            coalesceLines.emplace_back(coalesceLanes[i].lane, i);
+        }
+    }
+    std::sort(coalesceLines.begin(), coalesceLines.end());
+
+    coalescedLanes.assign(coalesceLanes.size(), false);
+    for (auto [first_lane, begin] : coalesceLines) {
+        Addr line_addr = coalesceLanes[begin].lineAddr;
+        int end = begin;
+
+        coalescePkts.clear();
+        while (end < coalesceLanes.size() &&
+               coalesceLanes[end].lineAddr == line_addr) {
+            coalescePkts.push_back(coalesceLanes[end++].pkt);
+        }
+
+        if (coalesceLine(line_addr, coalescePkts.data(),
+                         coalescePkts.size())) {
+            for (int i = begin; i < end; ++i) {
+                coalescedLanes[coalesceLanes[i].lane] = true;
+            }
+        }
+    }
+
+    // Erase the packets that were coalesced, and leave the others in the
+    // list to be retried.
+    lane = 0;
+    for (auto it = pkt_list.begin(); it != pkt_list.end(); ++lane) {
+        if (coalescedLanes[lane]) {
+            it = pkt_list.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 void
 GPUCoalescer::completeIssue()
 {
@@ -883,9 +955,7 @@ GPUCoalescer::completeIssue()
             // erase them from the list if coalescing is successful and
             // leave them in the list otherwise. This aggressively attempts
             // to coalesce as many packets as possible from the current inst.
-            pkt_list->remove_if(
-                [&](PacketPtr pkt) { return coalescePacket(pkt); }
-            );
+            coalesceInstPackets(*pkt_list);
 
             if (coalescedReqs.count(seq_num)) {
                 auto& creqs = coalescedReqs.at(seq_num);
@@ -34,6 +34,8 @@
 
 #include <iostream>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "gpu-compute/gpu_dyn_inst.hh"
@@ -45,6 +47,7 @@
 #include "mem/ruby/protocol/RubyAccessMode.hh"
 #include "mem/ruby/protocol/RubyRequestType.hh"
 #include "mem/ruby/protocol/SequencerRequestType.hh"
+#include "mem/ruby/structures/LineRequestTable.hh"
 #include "mem/ruby/system/Sequencer.hh"
 #include "mem/token_port.hh"
 
@@ -179,7 +182,7 @@ class PendingWriteInst
         assert(numPendingStores == 0);
 
         // make a response packet
-        PacketPtr pkt = new Packet(std::make_shared<Request>(),
+        PacketPtr pkt = new Packet(Request::create(),
                                    MemCmd::WriteCompleteResp);
 
         if (!usingRubyTester) {
@@ -405,12 +408,16 @@ class GPUCoalescer : public RubyPort
 
     GPUDynInstPtr getDynInst(PacketPtr pkt) const;
 
-    // Attempt to remove a packet from the uncoalescedTable and coalesce
+    // Attempt to coalesce the packets of an instruction for one line
     // with a previous request from the same instruction. If there is no
     // previous instruction and the max number of outstanding requests has
     // not be reached, a new coalesced request is created and added to the
     // "target" list of the coalescedTable.
-    bool coalescePacket(PacketPtr pkt);
+    bool coalesceLine(Addr line_addr, PacketPtr *pkts, int num_pkts);
+
+    // Attempt to coalesce all the packets of an instruction, removing the
+    // coalesced ones from the list.
+    void coalesceInstPackets(PerInstPackets &pkt_list);
 
     EventFunctionWrapper issueEvent;
 
@@ -435,12 +442,25 @@ class GPUCoalescer : public RubyPort
     // maximum size is equal to the maximum outstanding requests for a CU
     // (typically the number of blocks in TCP). If there are duplicates of
     // an address, the are serviced in age order.
-    std::map<Addr, std::deque<CoalescedRequest*>> coalescedTable;
+    LineRequestTable<CoalescedRequest*> coalescedTable;
     // Map of instruction sequence number to coalesced requests that get
-    // created in coalescePacket, used in completeIssue to send the fully
+    // created in coalesceLine, used in completeIssue to send the fully
     // coalesced request
     std::unordered_map<uint64_t, std::deque<CoalescedRequest*>> coalescedReqs;
 
+    // Scratch space of coalesceInstPackets, kept around to avoid
+    // allocating it for every instruction
+    struct CoalesceLane
+    {
+        Addr lineAddr;
+        int lane;
+        PacketPtr pkt;
+    };
+    std::vector<CoalesceLane> coalesceLanes;
+    std::vector<std::pair<int, int>> coalesceLines;
+    std::vector<bool> coalescedLanes;
+    std::vector<PacketPtr> coalescePkts;
+
     // a map btw an instruction sequence number and PendingWriteInst
     // this is used to do a final call back for each write when it is
     // completely done in the memory system
@@ -299,6 +299,9 @@ RubyPort::MemResponsePort::recvTimingReq(PacketPtr pkt)
     if (requestStatus == RequestStatus_Issued) {
         DPRINTF(RubyPort, "Request %s 0x%x issued\n", pkt->cmdString(),
                 pkt->getAddr());
+        // the request is outstanding until testDrainComplete() sees it
+        // completed, so a drain in progress must wait for it
+        owner.signalDrainUndone();
         return true;
     }
 
@@ -498,7 +501,7 @@ RubyPort::ruby_stale_translation_callback(Addr txnId)
     // Allocate the invalidate request and packet on the stack, as it is
     // assumed they will not be modified or deleted by receivers.
     // TODO: should this really be using funcRequestorId?
-    auto request = std::make_shared<Request>(
+    auto request = Request::create(
         0, RubySystem::getBlockSizeBytes(), Request::TLBI_EXT_SYNC,
         Request::funcRequestorId);
     // Store the txnId in extraData instead of the address
@@ -698,7 +701,7 @@ RubyPort::ruby_eviction_callback(Addr address)
     // Allocate the invalidate request and packet on the stack, as it is
     // assumed they will not be modified or deleted by receivers.
     // TODO: should this really be using funcRequestorId?
-    auto request = std::make_shared<Request>(
+    auto request = Request::create(
         address, RubySystem::getBlockSizeBytes(), 0,
         Request::funcRequestorId);
 
@@ -45,18 +45,22 @@
 
 #include <cstdio>
 #include <list>
+#include <map>
 
 #include "base/compiler.hh"
 #include "base/intmath.hh"
+#include "base/output.hh"
 #include "base/statistics.hh"
 #include "debug/RubyCacheTrace.hh"
 #include "debug/RubySystem.hh"
 #include "mem/ruby/common/Address.hh"
+#include "mem/ruby/common/WriteMask.hh"
 #include "mem/ruby/network/Network.hh"
 #include "mem/ruby/system/DMASequencer.hh"
 #include "mem/ruby/system/Sequencer.hh"
 #include "mem/simple_mem.hh"
 #include "sim/eventq.hh"
+#include "sim/sim_exit.hh"
 #include "sim/simulate.hh"
 #include "sim/system.hh"
 
@@ -78,12 +82,15 @@ bool RubySystem::m_cooldown_enabled = false;
 
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
+      m_direct_warmup(p.direct_warmup),
       m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
 
     m_block_size_bytes = p.block_size_bytes;
     assert(isPowerOf2(m_block_size_bytes));
+    fatal_if(m_block_size_bytes > WriteMask::MaxSize,
+             "Ruby supports blocks of up to %d bytes", WriteMask::MaxSize);
     m_block_size_bits = floorLog2(m_block_size_bytes);
     m_memory_size_bits = p.memory_size_bits;
 
@@ -92,11 +99,41 @@ RubySystem::RubySystem(const Params &p)
 
     // Collate the statistics before they are printed.
     statistics::registerDumpCallback([this]() { collateStats(); });
+    if (!p.coverage_file.empty()) {
+        registerExitCallback(
+            [this, file = p.coverage_file]() { dumpCoverage(file); });
+    }
     // Create the profiler
     m_profiler = new Profiler(p, this);
     m_phys_mem = p.phys_mem;
 }
 
+void
+RubySystem::dumpCoverage(const std::string &file) const
+{
+    std::map<std::string, uint64_t> coverage;
+    for (const auto *cntrl : m_abs_cntrl_vec) {
+        cntrl->collateCoverage(coverage);
+    }
+
+    size_t taken = 0;
+    for (const auto &[transition, count] : coverage) {
+        taken += (count != 0);
+    }
+
+    // One "<machine> <state> <event> <count>" line per possible
+    // transition, so files of different runs are merged by adding up
+    // the counts of identical lines
+    OutputStream *os = simout.create(file);
+    std::ostream &out = *os->stream();
+    ccprintf(out, "# %d of %d possible transitions taken\n", taken,
+             coverage.size());
+    for (const auto &[transition, count] : coverage) {
+        ccprintf(out, "%s %d\n", transition, count);
+    }
+    simout.close(os);
+}
+
 void
 RubySystem::registerNetwork(Network* network_ptr)
 {
@@ -173,7 +210,7 @@ RubySystem::~RubySystem()
 }
 
 void
-RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
+RubySystem::makeCacheRecorder(gzFile trace,
                               uint64_t cache_trace_size,
                               uint64_t block_size_bytes)
 {
@@ -211,9 +248,9 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
     }
 
     // Create the CacheRecorder and record the cache trace
-    m_cache_recorder = new CacheRecorder(uncompressed_trace, cache_trace_size,
-                                         ruby_port_map,
-                                         block_size_bytes);
+    m_cache_recorder = new CacheRecorder(trace, cache_trace_size,
+                                         ruby_port_map, m_abs_cntrl_vec,
+                                         block_size_bytes, m_direct_warmup);
 }
 
 void
@@ -296,9 +333,8 @@ RubySystem::memWriteback()
     // checkpoint is immediately taken.
 }
 
-void
-RubySystem::writeCompressedTrace(uint8_t *raw_data, std::string filename,
-                                 uint64_t uncompressed_trace_size)
+uint64_t
+RubySystem::writeCompressedTrace(std::string filename) const
 {
     // Create the checkpoint file for the memory
     std::string thefile = CheckpointIn::dir() + "/" + filename.c_str();
@@ -314,15 +350,15 @@ RubySystem::writeCompressedTrace(uint8_t *raw_data, std::string filename,
         fatal("Insufficient memory to allocate compression state for %s\n",
               filename);
 
-    if (gzwrite(compressedMemory, raw_data, uncompressed_trace_size) !=
-        uncompressed_trace_size) {
-        fatal("Write failed on memory trace file '%s'\n", filename);
-    }
+    // The records are streamed to the file, so the trace never has to
+    // be held in a single buffer.
+    uint64_t uncompressed_trace_size =
+        m_cache_recorder->writeRecords(compressedMemory);
 
     if (gzclose(compressedMemory)) {
         fatal("Close failed on memory trace file '%s'\n", filename);
     }
-    delete[] raw_data;
+    return uncompressed_trace_size;
 }
 
 void
@@ -342,12 +378,8 @@ RubySystem::serialize(CheckpointOut &cp) const
                 "ruby trace");
     }
 
-    // Aggregate the trace entries together into a single array
-    uint8_t *raw_data = new uint8_t[4096];
-    uint64_t cache_trace_size = m_cache_recorder->aggregateRecords(
-                                                        &raw_data, 4096);
     std::string cache_trace_file = name() + ".cache.gz";
-    writeCompressedTrace(raw_data, cache_trace_file, cache_trace_size);
+    uint64_t cache_trace_size = writeCompressedTrace(cache_trace_file);
 
     SERIALIZE_SCALAR(cache_trace_file);
     SERIALIZE_SCALAR(cache_trace_size);
@@ -364,9 +396,8 @@ RubySystem::drainResume()
     }
 }
 
-void
-RubySystem::readCompressedTrace(std::string filename, uint8_t *&raw_data,
-                                uint64_t &uncompressed_trace_size)
+gzFile
+RubySystem::openCompressedTrace(std::string filename)
 {
     // Read the trace file
     gzFile compressedTrace;
@@ -384,22 +415,12 @@ RubySystem::readCompressedTrace(std::string filename, uint8_t *&raw_data,
               filename);
     }
 
-    raw_data = new uint8_t[uncompressed_trace_size];
-    if (gzread(compressedTrace, raw_data, uncompressed_trace_size) <
-            uncompressed_trace_size) {
-        fatal("Unable to read complete trace from file %s\n", filename);
-    }
-
-    if (gzclose(compressedTrace)) {
-        fatal("Failed to close cache trace file '%s'\n", filename);
-    }
+    return compressedTrace;
 }
 
 void
 RubySystem::unserialize(CheckpointIn &cp)
 {
-    uint8_t *uncompressed_trace = NULL;
-
     // This value should be set to the checkpoint-system's block-size.
     // Optional, as checkpoints without it can be run if the
     // checkpoint-system's block-size == current block-size.
@@ -413,13 +434,13 @@ RubySystem::unserialize(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(cache_trace_size);
     cache_trace_file = cp.getCptDir() + "/" + cache_trace_file;
 
-    readCompressedTrace(cache_trace_file, uncompressed_trace,
-                        cache_trace_size);
+    // The trace is read as it is replayed, so only open it here.
+    gzFile trace = openCompressedTrace(cache_trace_file);
     m_warmup_enabled = true;
     m_systems_to_warmup++;
 
     // Create the cache recorder that will hang around until startup.
-    makeCacheRecorder(uncompressed_trace, cache_trace_size, block_size_bytes);
+    makeCacheRecorder(trace, cache_trace_size, block_size_bytes);
 }
 
 void
@@ -91,6 +91,9 @@ class RubySystem : public ClockedObject
         ClockedObject::regStats();
     }
     void collateStats() { m_profiler->collateStats(); }
+    // Write the transition coverage of all the controllers to file,
+    // see AbstractController::collateCoverage()
+    void dumpCoverage(const std::string &file) const;
     void resetStats() override;
 
     void memWriteback() override;
@@ -121,15 +124,12 @@ class RubySystem : public ClockedObject
     RubySystem(const RubySystem& obj);
     RubySystem& operator=(const RubySystem& obj);
 
-    void makeCacheRecorder(uint8_t *uncompressed_trace,
+    void makeCacheRecorder(gzFile trace,
                            uint64_t cache_trace_size,
                            uint64_t block_size_bytes);
 
-    static void readCompressedTrace(std::string filename,
-                                    uint8_t *&raw_data,
-                                    uint64_t &uncompressed_trace_size);
-    static void writeCompressedTrace(uint8_t *raw_data, std::string file,
-                                     uint64_t uncompressed_trace_size);
+    static gzFile openCompressedTrace(std::string filename);
+    uint64_t writeCompressedTrace(std::string file) const;
 
     void processRubyEvent();
   private:
@@ -144,6 +144,7 @@ class RubySystem : public ClockedObject
     static bool m_cooldown_enabled;
     memory::SimpleMemory *m_phys_mem;
     const bool m_access_backing_store;
+    const bool m_direct_warmup;
 
     //std::vector<Network *> m_networks;
     std::vector<std::unique_ptr<Network>> m_networks;
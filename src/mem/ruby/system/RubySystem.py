@@ -57,6 +57,20 @@ class RubySystem(ClockedObject):
         store and only use ruby for timing.",
     )
 
+    direct_warmup = Param.Bool(
+        False,
+        "When restoring from a checkpoint, install the recorded cache "
+        "contents directly through the protocol's warmupInstall hook and "
+        "only replay the blocks it can't install through the sequencers",
+    )
+
+    coverage_file = Param.String(
+        "ruby_coverage.txt",
+        "File, in the output directory, the number of times each possible "
+        "protocol transition was taken is written to at exit (empty "
+        "disables it)",
+    )
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
@@ -68,7 +68,8 @@ namespace ruby
 {
 
 Sequencer::Sequencer(const Params &p)
-    : RubyPort(p), m_IncompleteTimes(MachineType_NUM),
+    : RubyPort(p), m_RequestTable(p.max_outstanding_requests),
+      m_IncompleteTimes(MachineType_NUM),
       deadlockCheckEvent([this]{ wakeup(); }, "Sequencer deadlock check")
 {
     m_outstanding_count = 0;
@@ -158,7 +159,7 @@ Sequencer::llscLoadLinked(const Addr claddr)
         "%s must have a dcache object to support LLSC requests.", name());
     AbstractCacheEntry *line = m_dataCache_ptr->lookup(claddr);
     if (line) {
-        line->setLocked(m_version);
+        m_dataCache_ptr->setLocked(claddr, m_version);
         DPRINTF(LLSC, "LLSC Monitor - inserting load linked - "
                       "addr=0x%lx - cpu=%u\n", claddr, m_version);
     }
@@ -887,7 +888,7 @@ Sequencer::invL1()
         Addr addr = m_dataCache_ptr->getAddressAtIdx(i);
         // Evict Read-only data
         RubyRequestType request_type = RubyRequestType_REPLACEMENT;
-        std::shared_ptr<RubyRequest> msg = std::make_shared<RubyRequest>(
+        RefCountingPtr<RubyRequest> msg = new RubyRequest(
             clockEdge(), addr, 0, 0,
             request_type, RubyAccessMode_Supervisor,
             nullptr);
@@ -1058,12 +1059,12 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
 
     // check if the packet has data as for example prefetch and flush
     // requests do not
-    std::shared_ptr<RubyRequest> msg;
+    RefCountingPtr<RubyRequest> msg;
     if (pkt->req->isMemMgmt()) {
-        msg = std::make_shared<RubyRequest>(clockEdge(),
-                                            pc, secondary_type,
-                                            RubyAccessMode_Supervisor, pkt,
-                                            proc_id, core_id);
+        msg = new RubyRequest(clockEdge(),
+                              pc, secondary_type,
+                              RubyAccessMode_Supervisor, pkt,
+                              proc_id, core_id);
 
         DPRINTFR(ProtocolTrace, "%15s %3s %10s%20s %6s>%-6s %s\n",
                 curTick(), m_version, "Seq", "Begin", "", "",
@@ -1087,10 +1088,10 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
                     msg->m_tlbiTransactionUid);
         }
     } else {
-        msg = std::make_shared<RubyRequest>(clockEdge(), pkt->getAddr(),
-                                            pkt->getSize(), pc, secondary_type,
-                                            RubyAccessMode_Supervisor, pkt,
-                                            PrefetchBit_No, proc_id, core_id);
+        msg = new RubyRequest(clockEdge(), pkt->getAddr(),
+                              pkt->getSize(), pc, secondary_type,
+                              RubyAccessMode_Supervisor, pkt,
+                              PrefetchBit_No, proc_id, core_id);
 
         if (pkt->isAtomicOp() &&
             ((secondary_type == RubyRequestType_ATOMIC_RETURN) ||
@@ -1126,9 +1127,8 @@ Sequencer::issueRequest(PacketPtr pkt, RubyRequestType secondary_type)
     m_mandatory_q_ptr->enqueue(msg, clockEdge(), latency);
 }
 
-template <class KEY, class VALUE>
-std::ostream &
-operator<<(std::ostream &out, const std::unordered_map<KEY, VALUE> &map)
+static std::ostream &
+operator<<(std::ostream &out, const LineRequestTable<SequencerRequest> &map)
 {
     for (const auto &table_entry : map) {
         out << "[ " << table_entry.first << " =";
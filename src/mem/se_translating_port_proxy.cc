@@ -49,7 +49,11 @@ namespace gem5
 SETranslatingPortProxy::SETranslatingPortProxy(
         ThreadContext *tc, AllocType alloc, Request::Flags _flags) :
     TranslatingPortProxy(tc, _flags), allocating(alloc)
-{}
+{
+    // Syscall emulation copies whole guest buffers and is the main user
+    // of the backdoor path.
+    useBackdoors = true;
+}
 
 bool
 SETranslatingPortProxy::fixupRange(const TranslationGen::Range &range,
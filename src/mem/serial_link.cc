@@ -145,10 +145,8 @@ SerialLink::SerialLinkRequestPort::recvTimingResp(PacketPtr pkt)
     // first flit, but the deserializer (at the host side in this case), will
     // have to wait to receive the whole packet. So we only account for the
     // deserialization latency.
-    Cycles cycles = delay;
-    cycles += Cycles(divCeil(pkt->getSize() * 8, serial_link.num_lanes
-                * serial_link.link_speed));
-     Tick t = serial_link.clockEdge(cycles);
+    Tick t = serial_link.clockEdge(delay +
+                                   serial_link.serializationCycles(pkt));
 
     //@todo: If the processor sends two uncached requests towards HMC and the
     // second one is smaller than the first one. It may happen that the second
@@ -206,10 +204,8 @@ SerialLink::SerialLinkResponsePort::recvTimingReq(PacketPtr pkt)
             // to check its integrity first. So everytime a packet crosses a
             // serial link, we should account for its deserialization latency
             // only.
-            Cycles cycles = delay;
-            cycles += Cycles(divCeil(pkt->getSize() * 8,
-                    serial_link.num_lanes * serial_link.link_speed));
-            Tick t = serial_link.clockEdge(cycles);
+            Tick t = serial_link.clockEdge(
+                delay + serial_link.serializationCycles(pkt));
 
             //@todo: If the processor sends two uncached requests towards HMC
             // and the second one is smaller than the first one. It may happen
@@ -273,31 +269,37 @@ SerialLink::SerialLinkRequestPort::trySendTiming()
 {
     assert(!transmitList.empty());
 
-    DeferredPacket req = transmitList.front();
+    // Send the packets back to back for as long as the next one can
+    // leave at this tick, so a burst only costs one event
+    do {
+        DeferredPacket req = transmitList.front();
 
-    assert(req.tick <= curTick());
+        assert(req.tick <= curTick());
 
-    PacketPtr pkt = req.pkt;
+        PacketPtr pkt = req.pkt;
 
-    DPRINTF(SerialLink, "trySend request addr 0x%x, queue size %d\n",
-            pkt->getAddr(), transmitList.size());
+        DPRINTF(SerialLink, "trySend request addr 0x%x, queue size %d\n",
+                pkt->getAddr(), transmitList.size());
+
+        // if the send failed, then we try again once we receive a
+        // retry, and therefore there is no need to take any action
+        if (!sendTimingReq(pkt))
+            return;
 
-    if (sendTimingReq(pkt)) {
         // send successful
         transmitList.pop_front();
 
         DPRINTF(SerialLink, "trySend request successful\n");
 
-        // If there are more packets to send, schedule event to try again.
+        // If there are more packets to send, work out when the next
+        // one leaves; if that is now, keep going.
         if (!transmitList.empty()) {
-            DeferredPacket next_req = transmitList.front();
-            DPRINTF(SerialLink, "Scheduling next send\n");
-
-            // Make sure bandwidth limitation is met
-            Cycles cycles = Cycles(divCeil(pkt->getSize() * 8,
-                serial_link.num_lanes * serial_link.link_speed));
-            Tick t = serial_link.clockEdge(cycles);
-            serial_link.schedule(sendEvent, std::max(next_req.tick, t));
+            const DeferredPacket &next_req = transmitList.front();
+            Tick when = serial_link.nextDeparture(pkt, next_req.tick);
+            if (when > curTick()) {
+                DPRINTF(SerialLink, "Scheduling next send\n");
+                serial_link.schedule(sendEvent, when);
+            }
         }
 
         // if we have stalled a request due to a full request queue,
@@ -305,10 +307,7 @@ SerialLink::SerialLinkRequestPort::trySendTiming()
         // request we stalled was waiting for the response queue
         // rather than the request queue we might stall it again
         cpu_side_port.retryStalledReq();
-    }
-
-    // if the send failed, then we try again once we receive a retry,
-    // and therefore there is no need to take any action
+    } while (!transmitList.empty() && !sendEvent.scheduled());
 }
 
 void
@@ -316,16 +315,23 @@ SerialLink::SerialLinkResponsePort::trySendTiming()
 {
     assert(!transmitList.empty());
 
-    DeferredPacket resp = transmitList.front();
+    // Send the packets back to back for as long as the next one can
+    // leave at this tick, so a burst only costs one event
+    do {
+        DeferredPacket resp = transmitList.front();
 
-    assert(resp.tick <= curTick());
+        assert(resp.tick <= curTick());
 
-    PacketPtr pkt = resp.pkt;
+        PacketPtr pkt = resp.pkt;
 
-    DPRINTF(SerialLink, "trySend response addr 0x%x, outstanding %d\n",
-            pkt->getAddr(), outstandingResponses);
+        DPRINTF(SerialLink, "trySend response addr 0x%x, outstanding %d\n",
+                pkt->getAddr(), outstandingResponses);
+
+        // if the send failed, then we try again once we receive a
+        // retry, and therefore there is no need to take any action
+        if (!sendTimingResp(pkt))
+            return;
 
-    if (sendTimingResp(pkt)) {
         // send successful
         transmitList.pop_front();
         DPRINTF(SerialLink, "trySend response successful\n");
@@ -333,16 +339,15 @@ SerialLink::SerialLinkResponsePort::trySendTiming()
         assert(outstandingResponses != 0);
         --outstandingResponses;
 
-        // If there are more packets to send, schedule event to try again.
+        // If there are more packets to send, work out when the next
+        // one leaves; if that is now, keep going.
         if (!transmitList.empty()) {
-            DeferredPacket next_resp = transmitList.front();
-            DPRINTF(SerialLink, "Scheduling next send\n");
-
-            // Make sure bandwidth limitation is met
-            Cycles cycles = Cycles(divCeil(pkt->getSize() * 8,
-                serial_link.num_lanes * serial_link.link_speed));
-            Tick t = serial_link.clockEdge(cycles);
-            serial_link.schedule(sendEvent, std::max(next_resp.tick, t));
+            const DeferredPacket &next_resp = transmitList.front();
+            Tick when = serial_link.nextDeparture(pkt, next_resp.tick);
+            if (when > curTick()) {
+                DPRINTF(SerialLink, "Scheduling next send\n");
+                serial_link.schedule(sendEvent, when);
+            }
         }
 
         // if there is space in the request queue and we were stalling
@@ -353,10 +358,7 @@ SerialLink::SerialLinkResponsePort::trySendTiming()
             retryReq = false;
             sendRetryReq();
         }
-    }
-
-    // if the send failed, then we try again once we receive a retry,
-    // and therefore there is no need to take any action
+    } while (!transmitList.empty() && !sendEvent.scheduled());
 }
 
 void
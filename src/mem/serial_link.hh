@@ -140,7 +140,8 @@ class SerialLink : public ClockedObject
         /**
          * Handle send event, scheduled when the packet at the head of
          * the response queue is ready to transmit (for timing
-         * accesses only).
+         * accesses only). All the packets which can leave at this
+         * tick are sent by the same event.
          */
         void trySendTiming();
 
@@ -241,7 +242,8 @@ class SerialLink : public ClockedObject
         /**
          * Handle send event, scheduled when the packet at the head of
          * the outbound queue is ready to transmit (for timing
-         * accesses only).
+         * accesses only). All the packets which can leave at this
+         * tick are sent by the same event.
          */
         void trySendTiming();
 
@@ -313,6 +315,33 @@ class SerialLink : public ClockedObject
     /** Speed of each link (Gb/s) in this serial link */
     uint64_t link_speed;
 
+    /**
+     * Time the lanes take to serialize a packet.
+     *
+     * @param pkt The packet crossing the link
+     * @return The serialization latency in cycles
+     */
+    Cycles
+    serializationCycles(const PacketPtr pkt) const
+    {
+        return Cycles(divCeil(pkt->getSize() * 8, num_lanes * link_speed));
+    }
+
+    /**
+     * Tick at which the packet following pkt on the link can leave,
+     * given the tick at which it was ready.
+     *
+     * @param pkt The packet which was just sent
+     * @param ready Tick at which the next packet is ready
+     * @return The departure tick of the next packet
+     */
+    Tick
+    nextDeparture(const PacketPtr pkt, Tick ready) const
+    {
+        // Make sure bandwidth limitation is met
+        return std::max(ready, clockEdge(serializationCycles(pkt)));
+    }
+
   public:
 
     Port &getPort(const std::string &if_name,
@@ -56,9 +56,12 @@
     }
 #endif
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/output.hh"
 #include "base/pollevent.hh"
+#include "mem/abstract_mem.hh"
+#include "mem/physical.hh"
 
 namespace gem5
 {
@@ -85,9 +88,16 @@ buildListenSocket(const std::string &path, const std::string &name)
 SharedMemoryServer::SharedMemoryServer(const SharedMemoryServerParams& params)
     : SimObject(params),
       system(params.system),
+      dirtyPageSize(params.dirty_page_size),
+      dirtyPagePeriod(params.dirty_page_period),
+      notifyEvent([this] { notifyDirtyPages(); }, name()),
       listener(buildListenSocket(params.server_path, name()))
 {
     fatal_if(system == nullptr, "Requires a system to share memory from!");
+    fatal_if(!isPowerOf2(dirtyPageSize),
+             "%s: The dirty page size must be a power of 2", name());
+    fatal_if(dirtyPagePeriod == 0,
+             "%s: The dirty page period can't be 0", name());
     listener->listen();
 
     listenSocketEvent.reset(new ListenSocketEvent(listener->getfd(), this));
@@ -95,7 +105,11 @@ SharedMemoryServer::SharedMemoryServer(const SharedMemoryServerParams& params)
     inform("%s: listening at %s", name(), *listener);
 }
 
-SharedMemoryServer::~SharedMemoryServer() {}
+SharedMemoryServer::~SharedMemoryServer()
+{
+    if (notifyEvent.scheduled())
+        deschedule(notifyEvent);
+}
 
 SharedMemoryServer::BaseShmPollEvent::BaseShmPollEvent(
     int fd, SharedMemoryServer* shm_server)
@@ -116,8 +130,11 @@ SharedMemoryServer::BaseShmPollEvent::tryReadAll(void* buffer, size_t size)
     char* char_buffer = reinterpret_cast<char*>(buffer);
     for (size_t offset = 0; offset < size;) {
         ssize_t retv = recv(pfd.fd, char_buffer + offset, size - offset, 0);
-        if (retv >= 0) {
+        if (retv > 0) {
             offset += retv;
+        } else if (retv == 0) {
+            // The peer closed the connection
+            return false;
         } else if (errno != EINTR) {
             warn("%s: recv failed: %s", name(), strerror(errno));
             return false;
@@ -139,86 +156,43 @@ SharedMemoryServer::ListenSocketEvent::process(int revents)
 void
 SharedMemoryServer::ClientSocketEvent::process(int revents)
 {
+    // As a consequence of being called from the PollQueue, we might
+    // have been called from a different thread. Migrate to "our"
+    // thread.
+    EventQueue::ScopedMigration migrate(shmServer->eventQueue());
+
     do {
         // Ensure the connection is not closed nor broken.
         if (revents & (POLLHUP | POLLERR | POLLNVAL)) {
             break;
         }
 
+        // A subscriber only ever receives notifications, anything it
+        // sends (including the end of the stream) ends the subscription.
+        if (shmServer->subscribers.count(pfd.fd)) {
+            break;
+        }
+
         // Receive a request packet. We ignore the endianness as unix socket
         // only allows communication on the same system anyway.
         RequestType req_type;
-        struct
-        {
-            uint64_t start;
-            uint64_t end;
-        } request;
         if (!tryReadAll(&req_type, sizeof(req_type))) {
             break;
         }
-        if (req_type != RequestType::kGetPhysRange) {
-            warn("%s: receive unknown request: %d", name(),
-                 static_cast<int>(req_type));
-            break;
-        }
-        if (!tryReadAll(&request, sizeof(request))) {
+        bool done = false;
+        switch (req_type) {
+          case RequestType::kGetPhysRange:
+            done = handleGetPhysRange();
             break;
-        }
-        AddrRange range(request.start, request.end);
-        inform("%s: receive request: %s", name(), range.to_string());
-
-        // Identify the backing store.
-        const auto& stores = shmServer->system->getPhysMem().getBackingStore();
-        auto it = std::find_if(
-            stores.begin(), stores.end(), [&](const BackingStoreEntry& entry) {
-                return entry.shmFd >= 0 && range.isSubset(entry.range);
-            });
-        if (it == stores.end()) {
-            warn("%s: cannot find backing store for %s", name(),
-                 range.to_string());
+          case RequestType::kSubscribeDirtyPages:
+            done = handleSubscribeDirtyPages();
             break;
-        }
-        inform("%s: find shared backing store for %s at %s, shm=%d:%lld",
-               name(), range.to_string(), it->range.to_string(), it->shmFd,
-               (unsigned long long)it->shmOffset);
-
-        // Populate response message.
-        // mmap fd @ offset <===> [start, end] in simulated phys mem.
-        msghdr msg = {};
-        // Setup iovec for fields other than fd. We ignore the endianness as
-        // unix socket only allows communication on the same system anyway.
-        struct
-        {
-            off_t offset;
-        } response;
-        // (offset of the request range in shared memory) =
-        //     (offset of the full range in shared memory) +
-        //     (offset of the request range in the full range)
-        response.offset = it->shmOffset + (range.start() - it->range.start());
-        iovec ios = {.iov_base = &response, .iov_len = sizeof(response)};
-        msg.msg_iov = &ios;
-        msg.msg_iovlen = 1;
-        // Setup fd as an ancillary data.
-        union
-        {
-            char buf[CMSG_SPACE(sizeof(it->shmFd))];
-            struct cmsghdr align;
-        } cmsgs;
-        msg.msg_control = cmsgs.buf;
-        msg.msg_controllen = sizeof(cmsgs.buf);
-        cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
-        cmsg->cmsg_level = SOL_SOCKET;
-        cmsg->cmsg_type = SCM_RIGHTS;
-        cmsg->cmsg_len = CMSG_LEN(sizeof(it->shmFd));
-        memcpy(CMSG_DATA(cmsg), &it->shmFd, sizeof(it->shmFd));
-        // Send the response.
-        int retv = sendmsg(pfd.fd, &msg, 0);
-        if (retv < 0) {
-            warn("%s: sendmsg failed: %s", name(), strerror(errno));
+          default:
+            warn("%s: receive unknown request: %d", name(),
+                 static_cast<int>(req_type));
             break;
         }
-        if (retv != sizeof(response)) {
-            warn("%s: failed to send all response at once", name());
+        if (!done) {
             break;
         }
 
@@ -229,9 +203,217 @@ SharedMemoryServer::ClientSocketEvent::process(int revents)
 
     // If we ever reach here, our client either close the connection or is
     // somehow broken. We'll just close the connection and move on.
-    inform("%s: closing connection", name());
-    close(pfd.fd);
-    shmServer->clientSocketEvents.erase(pfd.fd);
+    shmServer->closeClient(pfd.fd);
+}
+
+bool
+SharedMemoryServer::ClientSocketEvent::handleGetPhysRange()
+{
+    struct
+    {
+        uint64_t start;
+        uint64_t end;
+    } request;
+    if (!tryReadAll(&request, sizeof(request))) {
+        return false;
+    }
+    AddrRange range(request.start, request.end);
+    inform("%s: receive request: %s", name(), range.to_string());
+
+    // Identify the backing store.
+    const auto& stores = shmServer->system->getPhysMem().getBackingStore();
+    auto it = std::find_if(
+        stores.begin(), stores.end(), [&](const BackingStoreEntry& entry) {
+            return entry.shmFd >= 0 && range.isSubset(entry.range);
+        });
+    if (it == stores.end()) {
+        warn("%s: cannot find backing store for %s", name(),
+             range.to_string());
+        return false;
+    }
+    inform("%s: find shared backing store for %s at %s, shm=%d:%lld",
+           name(), range.to_string(), it->range.to_string(), it->shmFd,
+           (unsigned long long)it->shmOffset);
+
+    // Populate response message.
+    // mmap fd @ offset <===> [start, end] in simulated phys mem.
+    msghdr msg = {};
+    // Setup iovec for fields other than fd. We ignore the endianness as
+    // unix socket only allows communication on the same system anyway.
+    struct
+    {
+        off_t offset;
+    } response;
+    // (offset of the request range in shared memory) =
+    //     (offset of the full range in shared memory) +
+    //     (offset of the request range in the full range)
+    response.offset = it->shmOffset + (range.start() - it->range.start());
+    iovec ios = {.iov_base = &response, .iov_len = sizeof(response)};
+    msg.msg_iov = &ios;
+    msg.msg_iovlen = 1;
+    // Setup fd as an ancillary data.
+    union
+    {
+        char buf[CMSG_SPACE(sizeof(it->shmFd))];
+        struct cmsghdr align;
+    } cmsgs;
+    msg.msg_control = cmsgs.buf;
+    msg.msg_controllen = sizeof(cmsgs.buf);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(it->shmFd));
+    memcpy(CMSG_DATA(cmsg), &it->shmFd, sizeof(it->shmFd));
+    // Send the response.
+    int retv = sendmsg(pfd.fd, &msg, 0);
+    if (retv < 0) {
+        warn("%s: sendmsg failed: %s", name(), strerror(errno));
+        return false;
+    }
+    if (retv != sizeof(response)) {
+        warn("%s: failed to send all response at once", name());
+        return false;
+    }
+
+    return true;
+}
+
+bool
+SharedMemoryServer::ClientSocketEvent::handleSubscribeDirtyPages()
+{
+    struct
+    {
+        uint64_t start;
+        uint64_t end;
+    } request;
+    if (!tryReadAll(&request, sizeof(request))) {
+        return false;
+    }
+    AddrRange range(request.start, request.end);
+    inform("%s: receive dirty page subscription: %s", name(),
+           range.to_string());
+
+    // The response is the page size of the notifications, or 0 if the
+    // subscription is refused.
+    const bool subscribed = shmServer->subscribe(pfd.fd, range);
+    uint64_t response = subscribed ? shmServer->dirtyPageSize : 0;
+    ssize_t retv = send(pfd.fd, &response, sizeof(response), MSG_NOSIGNAL);
+    if (retv != sizeof(response)) {
+        warn("%s: failed to send response", name());
+        return false;
+    }
+    return subscribed;
+}
+
+bool
+SharedMemoryServer::subscribe(int fd, const AddrRange &range)
+{
+    Subscriber sub;
+    sub.range = range;
+    for (auto *mem : system->getPhysMem().getMemories()) {
+        if (mem->getAddrRange().intersects(range))
+            sub.memories.push_back(mem);
+    }
+    if (sub.memories.empty()) {
+        warn("%s: no memory in %s", name(), range.to_string());
+        return false;
+    }
+
+    for (auto *mem : sub.memories) {
+        if (trackedMemories[mem]++ == 0)
+            mem->startDirtyTracking(dirtyPageSize);
+    }
+    subscribers.emplace(fd, std::move(sub));
+
+    if (!notifyEvent.scheduled())
+        schedule(notifyEvent, curTick() + dirtyPagePeriod);
+    return true;
+}
+
+void
+SharedMemoryServer::unsubscribe(int fd)
+{
+    auto it = subscribers.find(fd);
+    if (it == subscribers.end())
+        return;
+
+    for (auto *mem : it->second.memories) {
+        auto tracked = trackedMemories.find(mem);
+        assert(tracked != trackedMemories.end());
+        if (--tracked->second == 0) {
+            mem->stopDirtyTracking();
+            trackedMemories.erase(tracked);
+        }
+    }
+    subscribers.erase(it);
+
+    if (subscribers.empty() && notifyEvent.scheduled())
+        deschedule(notifyEvent);
+}
+
+void
+SharedMemoryServer::closeClient(int fd)
+{
+    inform("%s: closing connection %d", name(), fd);
+    unsubscribe(fd);
+    close(fd);
+    clientSocketEvents.erase(fd);
+}
+
+void
+SharedMemoryServer::notifyDirtyPages()
+{
+    std::vector<Addr> pages;
+    for (auto &tracked : trackedMemories)
+        tracked.first->collectDirtyPages(pages);
+
+    std::vector<int> broken;
+    for (auto &[fd, sub] : subscribers) {
+        for (Addr page : pages) {
+            if (page < sub.range.end() &&
+                page + dirtyPageSize > sub.range.start()) {
+                sub.pending.insert(page);
+            }
+        }
+        if (!flush(fd, sub))
+            broken.push_back(fd);
+    }
+    for (int fd : broken)
+        closeClient(fd);
+
+    if (!subscribers.empty())
+        schedule(notifyEvent, curTick() + dirtyPagePeriod);
+}
+
+bool
+SharedMemoryServer::flush(int fd, Subscriber &sub)
+{
+    // Only start a new notification once the previous one is out, the
+    // pages dirtied in the meantime simply stay pending.
+    if (sub.outBuf.empty() && !sub.pending.empty()) {
+        DirtyPageHeader header{curTick(), sub.pending.size()};
+        const char *raw = reinterpret_cast<const char *>(&header);
+        sub.outBuf.insert(sub.outBuf.end(), raw, raw + sizeof(header));
+        for (uint64_t page : sub.pending) {
+            raw = reinterpret_cast<const char *>(&page);
+            sub.outBuf.insert(sub.outBuf.end(), raw, raw + sizeof(page));
+        }
+        sub.pending.clear();
+    }
+
+    while (!sub.outBuf.empty()) {
+        ssize_t retv = send(fd, sub.outBuf.data(), sub.outBuf.size(),
+                            MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (retv >= 0) {
+            sub.outBuf.erase(sub.outBuf.begin(), sub.outBuf.begin() + retv);
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        } else if (errno != EINTR) {
+            warn("%s: send failed: %s", name(), strerror(errno));
+            return false;
+        }
+    }
+    return true;
 }
 
 } // namespace memory
@@ -28,13 +28,17 @@
 #ifndef __MEM_SHARED_MEMORY_SERVER_HH__
 #define __MEM_SHARED_MEMORY_SERVER_HH__
 
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "base/pollevent.hh"
 #include "base/socket.hh"
 #include "params/SharedMemoryServer.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
 
@@ -43,12 +47,40 @@ namespace gem5
 namespace memory
 {
 
+class AbstractMemory;
+
+/**
+ * Share the backing store of the simulated physical memory with other
+ * processes on the same host, see util/mem/shared_memory_client.hh for
+ * the client side.
+ *
+ * A kGetPhysRange request gets the shared memory descriptor and offset
+ * of a physical range so that the client can map it.
+ *
+ * A kSubscribeDirtyPages request turns the connection into a stream of
+ * notifications of the pages written in a physical range. Every
+ * dirty_page_period of simulated time, the pages written since the
+ * last notification are sent as a DirtyPageHeader followed by the
+ * start addresses of the pages. The socket is never allowed to block
+ * the simulation: if a client falls behind, its pages keep piling up
+ * (each page at most once) until its socket drains.
+ */
 class SharedMemoryServer : public SimObject
 {
   public:
     enum class RequestType : int
     {
         kGetPhysRange = 0,
+        kSubscribeDirtyPages = 1,
+    };
+
+    /** Header of a dirty page notification */
+    struct DirtyPageHeader
+    {
+        /** Simulated tick the notification was sent at */
+        uint64_t tick;
+        /** Number of page addresses that follow */
+        uint64_t numPages;
     };
 
     explicit SharedMemoryServer(const SharedMemoryServerParams& params);
@@ -81,10 +113,44 @@ class SharedMemoryServer : public SimObject
       public:
         using BaseShmPollEvent::BaseShmPollEvent;
         void process(int revent) override;
+
+      private:
+        bool handleGetPhysRange();
+        bool handleSubscribeDirtyPages();
     };
 
+    /** A connection that asked for dirty page notifications */
+    struct Subscriber
+    {
+        AddrRange range;
+        /** Memories tracked on behalf of this subscriber */
+        std::vector<AbstractMemory *> memories;
+        /** Dirty pages not sent yet */
+        std::set<Addr> pending;
+        /** Part of the last notification the socket didn't take yet */
+        std::vector<char> outBuf;
+    };
+
+    bool subscribe(int fd, const AddrRange &range);
+    void unsubscribe(int fd);
+    void closeClient(int fd);
+
+    /** Send the pages written since the last period to the subscribers */
+    void notifyDirtyPages();
+    /** Push out as much of a subscriber's notifications as possible */
+    bool flush(int fd, Subscriber &sub);
+
     System* system;
 
+    const Addr dirtyPageSize;
+    const Tick dirtyPagePeriod;
+
+    std::unordered_map<int, Subscriber> subscribers;
+    /** Number of subscribers interested in each tracked memory */
+    std::map<AbstractMemory *, unsigned> trackedMemories;
+
+    EventFunctionWrapper notifyEvent;
+
     ListenSocketPtr listener;
 
     std::unique_ptr<ListenSocketEvent> listenSocketEvent;
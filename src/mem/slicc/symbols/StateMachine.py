@@ -74,6 +74,14 @@ class StateMachine(Symbol):
         super().__init__(symtab, ident, location, pairs)
         self.table = None
 
+        # With dispatch="table" the transitions are dispatched through a
+        # dense state x event table, and doTransitionWorker is emitted
+        # next to the actions so the compiler can inline them
+        dispatch = self.get("dispatch", "switch")
+        if dispatch not in ("switch", "table"):
+            self.error(f"Unknown dispatch mode '{dispatch}'")
+        self.tableDispatch = dispatch == "table"
+
         # Data members in the State Machine that have been declared before
         # the opening brace '{'  of the machine.  Note that these along with
         # the members in self.objects form the entire set of data members.
@@ -365,6 +373,7 @@ class $c_ident : public AbstractController
     void resetStats();
     void regStats();
     void collateStats();
+    void collateCoverage(std::map<std::string, uint64_t> &coverage) const;
 
     void recordCacheTrace(int cntrl, CacheRecorder* tr);
     Sequencer* getCPUSequencer() const;
@@ -447,6 +456,8 @@ ${ident}_State curTransitionNextState() { return m_curTransitionNextState; }
 
 int m_counters[${ident}_State_NUM][${ident}_Event_NUM];
 int m_event_counters[${ident}_Event_NUM];
+// Same as m_counters, but never reset
+uint64_t m_coverage[${ident}_State_NUM][${ident}_Event_NUM];
 bool m_possible[${ident}_State_NUM][${ident}_Event_NUM];
 
 static std::vector<statistics::Vector *> eventVec;
@@ -580,6 +591,12 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
 #include <sys/types.h>
 #include <unistd.h>
 
+"""
+        )
+        if self.tableDispatch:
+            code("#include <array>")
+        code(
+            """
 #include <cassert>
 #include <sstream>
 #include <string>
@@ -683,6 +700,7 @@ for (int state = 0; state < ${ident}_State_NUM; state++) {
     for (int event = 0; event < ${ident}_Event_NUM; event++) {
         m_possible[state][event] = false;
         m_counters[state][event] = 0;
+        m_coverage[state][event] = 0;
     }
 }
 for (int event = 0; event < ${ident}_Event_NUM; event++) {
@@ -1098,6 +1116,7 @@ $c_ident::countTransition(${ident}_State state, ${ident}_Event event)
     assert(m_possible[state][event]);
     m_counters[state][event]++;
     m_event_counters[event]++;
+    m_coverage[state][event]++;
 }
 void
 $c_ident::possibleTransition(${ident}_State state,
@@ -1125,6 +1144,23 @@ $c_ident::getTransitionCount(${ident}_State state,
     return m_counters[state][event];
 }
 
+void
+$c_ident::collateCoverage(std::map<std::string, uint64_t> &coverage) const
+{
+    for (${ident}_State state = ${ident}_State_FIRST;
+         state < ${ident}_State_NUM; ++state) {
+        for (${ident}_Event event = ${ident}_Event_FIRST;
+             event < ${ident}_Event_NUM; ++event) {
+            if (!m_possible[state][event])
+                continue;
+            std::string key = "${ident} " +
+                ${ident}_State_to_string(state) + " " +
+                ${ident}_Event_to_string(event);
+            coverage[key] += m_coverage[state][event];
+        }
+    }
+}
+
 int
 $c_ident::getNumControllers()
 {
@@ -1312,6 +1348,9 @@ $c_ident::${{action.ident}}(Addr addr)
         for func in self.functions:
             code(func.generateCode())
 
+        if self.tableDispatch:
+            self.printTransitionWorker(code)
+
         # Function for functional writes to messages buffered in the controller
         code(
             """
@@ -1696,38 +1735,24 @@ return result;
 """
         )
         code.dedent()
-        code(
-            """
-}
+        code("}")
 
-TransitionResult
-${ident}_Controller::doTransitionWorker(${ident}_Event event,
-                                        ${ident}_State state,
-                                        ${ident}_State& next_state,
-"""
-        )
+        if not self.tableDispatch:
+            self.printTransitionWorker(code)
 
-        if self.TBEType != None:
-            code(
-                """
-                                        ${{self.TBEType.c_ident}}*& m_tbe_ptr,
-"""
-            )
-        if self.EntryType != None:
-            code(
-                """
-                                        ${{self.EntryType.c_ident}}*& m_cache_entry_ptr,
-"""
-            )
         code(
             """
-                                        Addr addr)
-{
-    m_curTransitionEvent = event;
-    m_curTransitionNextState = next_state;
-    switch(HASH_FUN(state, event)) {
+
+} // namespace ruby
+} // namespace gem5
 """
         )
+        code.write(path, f"{self.ident}_Transitions.cc")
+
+    def printTransitionWorker(self, code):
+        """Output the function performing the actions of a transition"""
+
+        ident = self.ident
 
         # This map will allow suppress generating duplicate code
         cases = OrderedDict()
@@ -1830,15 +1855,69 @@ if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
             if case not in cases:
                 cases[case] = []
 
-            cases[case].append(case_string)
+            cases[case].append((case_string, trans))
+
+        if self.tableDispatch:
+            self.printDispatchTable(code, cases)
+
+        code(
+            """
+
+TransitionResult
+${ident}_Controller::doTransitionWorker(${ident}_Event event,
+                                        ${ident}_State state,
+                                        ${ident}_State& next_state,
+"""
+        )
+
+        if self.TBEType != None:
+            code(
+                """
+                                        ${{self.TBEType.c_ident}}*& m_tbe_ptr,
+"""
+            )
+        if self.EntryType != None:
+            code(
+                """
+                                        ${{self.EntryType.c_ident}}*& m_cache_entry_ptr,
+"""
+            )
+        code(
+            """
+                                        Addr addr)
+{
+"""
+        )
+
+        if self.tableDispatch:
+            code(
+                """
+    m_curTransitionEvent = event;
+    m_curTransitionNextState = next_state;
+    switch (${ident}_dispatchTable[state][event]) {
+"""
+            )
+        else:
+            code(
+                """
+    m_curTransitionEvent = event;
+    m_curTransitionNextState = next_state;
+    switch(HASH_FUN(state, event)) {
+"""
+            )
 
         # Walk through all of the unique code blocks and spit out the
         # corresponding case statement elements
-        for case, transitions in cases.items():
-            # Iterative over all the multiple transitions that share
-            # the same code
-            for trans in transitions:
-                code("  case HASH_FUN($trans):")
+        for index, (case, transitions) in enumerate(cases.items()):
+            if self.tableDispatch:
+                # The table maps every transition to the index of its
+                # code block, so each block needs a single label
+                code("  case ${{index + 1}}:")
+            else:
+                # Iterative over all the multiple transitions that share
+                # the same code
+                for case_string, _ in transitions:
+                    code("  case HASH_FUN($case_string):")
             code("    $case\n")
 
         code(
@@ -1851,12 +1930,54 @@ if (!checkResourceAvailable({}_RequestType_{}, addr)) {{
 
     return TransitionResult_Valid;
 }
+"""
+        )
 
-} // namespace ruby
-} // namespace gem5
+    def printDispatchTable(self, code, cases):
+        """Output the table mapping every state and event to the index
+        of the code block handling them in doTransitionWorker, with 0
+        marking the invalid transitions. The dense indices let the
+        worker switch through a compact jump table."""
+
+        ident = self.ident
+        index_type = "uint8_t" if len(cases) < 256 else "uint16_t"
+        assert len(cases) < 65536
+
+        code(
+            """
+
+namespace
+{
+
+using ${ident}_DispatchTable =
+    std::array<std::array<${index_type}, ${ident}_Event_NUM>,
+               ${ident}_State_NUM>;
+
+${ident}_DispatchTable
+make${ident}DispatchTable()
+{
+    ${ident}_DispatchTable table{};
+"""
+        )
+        code.indent()
+        for index, transitions in enumerate(cases.values()):
+            for _, trans in transitions:
+                code(
+                    "table[${ident}_State_${{trans.state.ident}}]"
+                    "[${ident}_Event_${{trans.event.ident}}] = ${{index + 1}};"
+                )
+        code.dedent()
+        code(
+            """
+    return table;
+}
+
+const ${ident}_DispatchTable ${ident}_dispatchTable =
+    make${ident}DispatchTable();
+
+} // anonymous namespace
 """
         )
-        code.write(path, f"{self.ident}_Transitions.cc")
 
     # **************************
     # ******* HTML Files *******
@@ -291,6 +291,24 @@ $klass ${{self.c_ident}}$parent
         code("${{self.c_ident}}")
         code("&operator=(const ${{self.c_ident}}&) = default;")
 
+        # ******** Pooled allocation ********
+        if self.isMessage:
+            code(
+                """
+static void *
+operator new(std::size_t size)
+{
+    return MessagePool<${{self.c_ident}}>::allocate(size);
+}
+
+static void
+operator delete(void *p, std::size_t size)
+{
+    MessagePool<${{self.c_ident}}>::release(p, size);
+}
+"""
+            )
+
         # ******** Full init constructor ********
         if not self.isGlobal:
             params = [
@@ -326,7 +344,7 @@ $klass ${{self.c_ident}}$parent
 MsgPtr
 clone() const
 {
-     return std::shared_ptr<Message>(new ${{self.c_ident}}(*this));
+     return MsgPtr(new ${{self.c_ident}}(*this));
 }
 """
             )
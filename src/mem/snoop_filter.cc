@@ -52,10 +52,74 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
+SnoopFilter::SnoopFilter(const SnoopFilterParams &p)
+    : SimObject(p),
+      cachedLocations(p.assoc ? p.assoc : 8,
+                      p.assoc ? p.max_capacity / p.system->cacheLineSize() /
+                                p.assoc : 1024,
+                      p.assoc != 0, p.system->cacheLineSize()),
+      reqLookupResult(cachedLocations.end()),
+      linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
+      maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+      bounded(p.assoc != 0), system(p.system),
+      stats(this)
+{
+    fatal_if(bounded && (maxEntryCount % p.assoc || !maxEntryCount),
+             "%s: The capacity of %d lines is not a multiple of the "
+             "associativity %d", name(), maxEntryCount, p.assoc);
+}
+
+SnoopFilter::SnoopFilterCache::iterator
+SnoopFilter::allocateEntry(Addr line_addr)
+{
+    auto sf_it = cachedLocations.insert(line_addr);
+    if (sf_it != cachedLocations.end())
+        return sf_it;
+
+    // Lines with requests in flight have responses or snoop
+    // responses on their way that need the entry
+    auto victim = cachedLocations.victim(line_addr,
+        [](const SnoopItem &item) { return item.requested.none(); });
+    panic_if(victim == cachedLocations.end(),
+             "%s: no entry to evict for %#x, all have requests in flight",
+             name(), line_addr);
+
+    backInvalidate(*victim);
+    cachedLocations.erase(victim);
+    return cachedLocations.insert(line_addr);
+}
+
+void
+SnoopFilter::backInvalidate(const SnoopFilterCache::Line &line)
+{
+    DPRINTF(SnoopFilter, "%s: evicting %#x SF value %x.%x\n", __func__,
+            line.addr, line.item.requested, line.item.holder);
+
+    stats.backInvalidations++;
+
+    RequestPtr req = Request::create(
+        line.addr & ~Addr(linesize - 1), linesize,
+        Request::CLEAN | Request::INVALIDATE | Request::DST_POC,
+        Request::wbRequestorId);
+    if (line.addr & LineSecure)
+        req->setFlags(Request::SECURE);
+
+    // A clean and invalidate gets rid of the line in the holders and
+    // the caches above them, and any dirty copy is written back
+    Packet pkt(req, MemCmd::CleanInvalidReq);
+    pkt.setExpressSnoop();
+    for (auto port : maskToPortList(line.item.holder)) {
+        if (system->isTimingMode())
+            port->sendTimingSnoopReq(&pkt);
+        else
+            port->sendAtomicSnoop(&pkt);
+    }
+}
+
 void
 SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
 {
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = sf_it->item;
     if ((sf_item.requested | sf_item.holder).none()) {
         cachedLocations.erase(sf_it);
         DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
@@ -87,12 +151,16 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
     if (!is_hit && !allocate)
         return snoopDown(lookupLatency);
 
+    // An eviction of a line we do not track is from a holder that the
+    // line was back-invalidated in while the eviction was on its way
+    if (!is_hit && bounded && cpkt->isEviction())
+        return snoopDown(lookupLatency);
+
     // If no hit in snoop filter create a new element and update iterator
     if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
+        reqLookupResult.it = allocateEntry(line_addr);
     }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    SnoopItem& sf_item = reqLookupResult.it->item;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -162,7 +230,7 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
     if (reqLookupResult.it != cachedLocations.end()) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
-        assert(reqLookupResult.it->first == \
+        assert(reqLookupResult.it->addr == \
                 (is_secure ? ((addr & ~(Addr(linesize - 1))) | LineSecure) : \
                  (addr & ~(Addr(linesize - 1)))));
         if (will_retry) {
@@ -170,7 +238,7 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            reqLookupResult.it->item = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
@@ -194,7 +262,8 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     auto sf_it = cachedLocations.find(line_addr);
     bool is_hit = (sf_it != cachedLocations.end());
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    panic_if(!bounded && !is_hit &&
+             (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -204,7 +273,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = sf_it->item;
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -264,7 +333,10 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    auto sf_it = cachedLocations.find(line_addr);
+    if (sf_it == cachedLocations.end())
+        sf_it = allocateEntry(line_addr);
+    SnoopItem& sf_item = sf_it->item;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -322,7 +394,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = sf_it->item;
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -358,7 +430,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = sf_it->item;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -405,9 +477,45 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
+               "(>1) holders of the requested data."),
+      ADD_STAT(backInvalidations, statistics::units::Count::get(),
+               "Number of lines invalidated in the caches above to make "
+               "room in a bounded snoop filter.")
 {}
 
+void
+SnoopFilter::updateWarmedTags(const Packet* cpkt,
+                              const ResponsePort& cpu_side_port)
+{
+    if (cpkt->req->isUncacheable() || !cpu_side_port.isSnooping())
+        return;
+
+    const bool evict = cpkt->isEviction();
+    if (!evict && !cpkt->isBlockWarmed())
+        return;
+
+    DPRINTF(SnoopFilter, "%s: src %s packet %s\n", __func__,
+            cpu_side_port.name(), cpkt->print());
+
+    Addr line_addr = cpkt->getBlockAddr(linesize);
+    if (cpkt->isSecure()) {
+        line_addr |= LineSecure;
+    }
+    SnoopMask port_mask = portToMask(cpu_side_port);
+    auto sf_it = cachedLocations.find(line_addr);
+
+    if (evict) {
+        if (sf_it != cachedLocations.end()) {
+            sf_it->item.holder &= ~port_mask;
+            eraseIfNullEntry(sf_it);
+        }
+    } else {
+        if (sf_it == cachedLocations.end())
+            sf_it = allocateEntry(line_addr);
+        sf_it->item.holder |= port_mask;
+    }
+}
+
 void
 SnoopFilter::regStats()
 {
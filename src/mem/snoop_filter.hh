@@ -44,12 +44,12 @@
 #define __MEM_SNOOP_FILTER_HH__
 
 #include <bitset>
-#include <unordered_map>
 #include <utility>
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
 #include "mem/qport.hh"
+#include "mem/snoop_filter_storage.hh"
 #include "params/SnoopFilter.hh"
 #include "sim/sim_object.hh"
 #include "sim/system.hh"
@@ -63,11 +63,14 @@ namespace gem5
  * memory requests from above (reads / writes / ...); and also from
  * below (snoops). The snoop filter precisely knows about the location
  * of lines "above" it through a map from cache line address to
- * sharers/ports. The snoop filter ties into the flows of requests
- * (when they succeed at the lower interface), regular responses from
- * below and also responses from sideway's caches (in update*). This
- * allows the snoop filter to model cache-line residency by snooping
- * the messages.
+ * sharers/ports. Optionally, the map can be limited to a fixed number
+ * of entries in a set-associative structure, as a hardware snoop
+ * filter would be, in which case lines that no longer fit are
+ * back-invalidated in the caches above. The snoop filter ties into
+ * the flows of requests (when they succeed at the lower interface),
+ * regular responses from below and also responses from sideway's
+ * caches (in update*). This allows the snoop filter to model
+ * cache-line residency by snooping the messages.
  *
  * The tracking happens in two fields to be able to distinguish
  * between in-flight requests (in requested) and already pulled in
@@ -95,13 +98,7 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
-        maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
-    {
-    }
+    SnoopFilter (const SnoopFilterParams &p);
 
     /**
      * Init a new snoop filter and tell it about all the cpu_sideports
@@ -200,6 +197,19 @@ class SnoopFilter : public SimObject
      */
     void updateResponse(const Packet *cpkt, const ResponsePort& cpu_side_port);
 
+    /**
+     * Track the blocks held by caches that keep their tags warm while
+     * the system bypasses them. Such caches flag the requests they
+     * forward if they hold the block, and send clean evictions when
+     * they drop one. Unlike the regular lookups this never snoops and
+     * tolerates ports that do not hold the block.
+     *
+     * @param cpkt          Pointer to const Packet forwarded by the cache.
+     * @param cpu_side_port ResponsePort the packet came from.
+     */
+    void updateWarmedTags(const Packet *cpkt,
+                          const ResponsePort& cpu_side_port);
+
     virtual void regStats();
 
   protected:
@@ -221,9 +231,9 @@ class SnoopFilter : public SimObject
         SnoopMask holder;
     };
     /**
-     * HashMap of SnoopItems indexed by line address
+     * Set-associative storage of SnoopItems indexed by line address
      */
-    typedef std::unordered_map<Addr, SnoopItem> SnoopFilterCache;
+    typedef SnoopFilterStorage<SnoopItem> SnoopFilterCache;
 
     /**
      * Simple factory methods for standard return values.
@@ -263,7 +273,25 @@ class SnoopFilter : public SimObject
      */
     void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
 
-    /** Simple hash set of cached addresses. */
+    /**
+     * Create an entry for a line. If the snoop filter is bounded and
+     * the set of the line is full, the least recently used entry
+     * without requests in flight is back-invalidated to make room.
+     *
+     * @param line_addr Line address, including the line status bits.
+     * @return The new entry
+     */
+    SnoopFilterCache::iterator allocateEntry(Addr line_addr);
+
+    /**
+     * Invalidate a line in all the caches holding it, writing back
+     * dirty data, so that the snoop filter can stop tracking it.
+     *
+     * @param line The entry of the line.
+     */
+    void backInvalidate(const SnoopFilterCache::Line &line);
+
+    /** Entries of the tracked cache lines. */
     SnoopFilterCache cachedLocations;
 
     /**
@@ -307,6 +335,13 @@ class SnoopFilter : public SimObject
     const Cycles lookupLatency;
     /** Max capacity in terms of cache blocks tracked, for sanity checking */
     const unsigned maxEntryCount;
+    /**
+     * Is the capacity a hard limit, with entries evicted through
+     * back-invalidations when their set is full?
+     */
+    const bool bounded;
+    /** The system, to know how to send back-invalidations */
+    System *system;
 
     /**
      * Use the lower bits of the address to keep track of the line status
@@ -329,6 +364,8 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        statistics::Scalar backInvalidations;
     } stats;
 };
 
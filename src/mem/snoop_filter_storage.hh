@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of the set-associative storage of the snoop filter.
+ */
+
+#ifndef __MEM_SNOOP_FILTER_STORAGE_HH__
+#define __MEM_SNOOP_FILTER_STORAGE_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/intmath.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * Open-addressing, set-associative storage for the per-line items of
+ * a snoop filter. A line maps to a single set and only the ways of
+ * that set, which are contiguous in memory, are searched on a
+ * lookup. Lines never move while they are stored, except when an
+ * unbounded storage grows.
+ *
+ * An unbounded storage hashes the line addresses to the sets and
+ * doubles the number of sets whenever a line finds its set full, so
+ * an insertion always succeeds. A bounded storage keeps its sets, and
+ * the caller has to evict one of the lines in the set to make room,
+ * as a size-limited snoop filter in hardware would.
+ *
+ * @tparam Item Information tracked per line.
+ */
+template <class Item>
+class SnoopFilterStorage
+{
+  public:
+    struct Line
+    {
+        /** Line address, possibly with status flags in the low bits */
+        Addr addr = 0;
+        Item item{};
+        /** Time of the last access, for the LRU replacement */
+        uint64_t lastUse = 0;
+        bool valid = false;
+    };
+
+    typedef Line *iterator;
+
+    /**
+     * @param assoc Number of ways in a set.
+     * @param num_sets Number of sets, the initial one if unbounded.
+     * @param bounded Keep the number of sets fixed.
+     * @param line_size Size of the lines in bytes, a power of two.
+     */
+    SnoopFilterStorage(unsigned assoc, size_t num_sets, bool bounded,
+                       unsigned line_size)
+        : assoc(assoc), numSets(num_sets), bounded(bounded),
+          lineShift(floorLog2(line_size)), lines(assoc * num_sets)
+    {
+        assert(assoc > 0 && num_sets > 0);
+    }
+
+    iterator end() const { return nullptr; }
+
+    /** @return the line with the address, or end() if not stored */
+    iterator
+    find(Addr addr)
+    {
+        Line *set = setOf(addr);
+        for (unsigned way = 0; way < assoc; ++way) {
+            if (set[way].valid && set[way].addr == addr) {
+                set[way].lastUse = ++useCount;
+                return &set[way];
+            }
+        }
+        return end();
+    }
+
+    /**
+     * Store a new line with a default constructed item. The address
+     * must not be stored already.
+     *
+     * @return the new line, or end() if the set is full and the
+     *         storage is bounded
+     */
+    iterator
+    insert(Addr addr)
+    {
+        assert(find(addr) == end());
+        Line *line = freeWay(addr);
+        while (!line && !bounded) {
+            grow();
+            line = freeWay(addr);
+        }
+        if (!line)
+            return end();
+
+        *line = Line();
+        line->addr = addr;
+        line->lastUse = ++useCount;
+        line->valid = true;
+        ++_size;
+        return line;
+    }
+
+    void
+    erase(iterator it)
+    {
+        assert(it && it->valid);
+        it->valid = false;
+        --_size;
+    }
+
+    /**
+     * Find the least recently used line in the set of an address that
+     * may be evicted.
+     *
+     * @param addr Address to make room for.
+     * @param can_evict Predicate on the item of a candidate line.
+     * @return the victim, or end() if no line in the set may be evicted
+     */
+    template <class Pred>
+    iterator
+    victim(Addr addr, Pred can_evict)
+    {
+        Line *set = setOf(addr);
+        iterator victim = end();
+        for (unsigned way = 0; way < assoc; ++way) {
+            if (set[way].valid && can_evict(set[way].item) &&
+                (!victim || set[way].lastUse < victim->lastUse)) {
+                victim = &set[way];
+            }
+        }
+        return victim;
+    }
+
+    /** Number of lines stored */
+    size_t size() const { return _size; }
+
+    /** Number of lines that can be stored without growing */
+    size_t capacity() const { return lines.size(); }
+
+  private:
+    size_t
+    setIndex(Addr addr) const
+    {
+        uint64_t index = addr >> lineShift;
+        if (!bounded) {
+            // Spread strided addresses over the sets, so that a single
+            // set does not force the storage to grow
+            index *= 0x9e3779b97f4a7c15ULL;
+            index ^= index >> 32;
+        }
+        return index % numSets;
+    }
+
+    Line *setOf(Addr addr) { return &lines[setIndex(addr) * assoc]; }
+
+    Line *
+    freeWay(Addr addr)
+    {
+        Line *set = setOf(addr);
+        for (unsigned way = 0; way < assoc; ++way) {
+            if (!set[way].valid)
+                return &set[way];
+        }
+        return nullptr;
+    }
+
+    /** Double the number of sets and rehash the lines */
+    void
+    grow()
+    {
+        std::vector<Line> old;
+        old.swap(lines);
+
+        bool fits = false;
+        while (!fits) {
+            numSets *= 2;
+            lines.assign(assoc * numSets, Line());
+
+            fits = true;
+            for (const auto &line : old) {
+                if (!line.valid)
+                    continue;
+                Line *dst = freeWay(line.addr);
+                if (!dst) {
+                    fits = false;
+                    break;
+                }
+                *dst = line;
+            }
+        }
+    }
+
+    const unsigned assoc;
+    size_t numSets;
+    const bool bounded;
+    const unsigned lineShift;
+
+    std::vector<Line> lines;
+    size_t _size = 0;
+    uint64_t useCount = 0;
+};
+
+} // namespace gem5
+
+#endif //__MEM_SNOOP_FILTER_STORAGE_HH__
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+
+#include "mem/snoop_filter_storage.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct TestItem
+{
+    int value;
+    bool pinned;
+};
+
+using TestStorage = SnoopFilterStorage<TestItem>;
+
+const unsigned lineSize = 64;
+
+} // anonymous namespace
+
+/** Lines can be found until they are erased */
+TEST(SnoopFilterStorageTest, InsertFindErase)
+{
+    TestStorage storage(4, 16, true, lineSize);
+    EXPECT_EQ(storage.capacity(), 64);
+
+    auto it = storage.insert(0x1000);
+    ASSERT_NE(it, storage.end());
+    it->item.value = 42;
+    EXPECT_EQ(storage.size(), 1);
+
+    // The status bits in the line address are part of the key
+    EXPECT_EQ(storage.find(0x1001), storage.end());
+    ASSERT_EQ(storage.find(0x1000), it);
+    EXPECT_EQ(storage.find(0x1000)->item.value, 42);
+
+    storage.erase(it);
+    EXPECT_EQ(storage.find(0x1000), storage.end());
+    EXPECT_EQ(storage.size(), 0);
+}
+
+/** A bounded storage reports full sets and picks LRU victims */
+TEST(SnoopFilterStorageTest, BoundedVictim)
+{
+    const unsigned assoc = 4;
+    const size_t num_sets = 8;
+    TestStorage storage(assoc, num_sets, true, lineSize);
+
+    // Fill one set, with addresses a set stride apart
+    const Addr stride = num_sets * lineSize;
+    for (unsigned way = 0; way < assoc; ++way)
+        ASSERT_NE(storage.insert(way * stride), storage.end());
+    EXPECT_EQ(storage.insert(assoc * stride), storage.end());
+
+    // Another set is unaffected
+    EXPECT_NE(storage.insert(lineSize), storage.end());
+
+    auto any = [](const TestItem &item) { return !item.pinned; };
+
+    // Touching the first line makes the second one the oldest
+    storage.find(0);
+    auto victim = storage.victim(assoc * stride, any);
+    ASSERT_NE(victim, storage.end());
+    EXPECT_EQ(victim->addr, stride);
+
+    // Pinned lines are never picked
+    victim->item.pinned = true;
+    victim = storage.victim(assoc * stride, any);
+    ASSERT_NE(victim, storage.end());
+    EXPECT_EQ(victim->addr, 2 * stride);
+
+    for (unsigned way = 0; way < assoc; ++way)
+        storage.find(way * stride)->item.pinned = true;
+    EXPECT_EQ(storage.victim(assoc * stride, any), storage.end());
+}
+
+/** An unbounded storage grows and keeps all lines */
+TEST(SnoopFilterStorageTest, UnboundedGrowth)
+{
+    TestStorage storage(8, 4, false, lineSize);
+    std::unordered_map<Addr, int> reference;
+
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 20000; ++i) {
+        const Addr addr = (rng() % (1 << 20)) * lineSize;
+        if (reference.count(addr)) {
+            if (i % 3 == 0) {
+                storage.erase(storage.find(addr));
+                reference.erase(addr);
+            }
+            continue;
+        }
+        auto it = storage.insert(addr);
+        ASSERT_NE(it, storage.end());
+        it->item.value = i;
+        reference[addr] = i;
+    }
+
+    EXPECT_EQ(storage.size(), reference.size());
+    EXPECT_GE(storage.capacity(), storage.size());
+    for (const auto &[addr, value] : reference) {
+        auto it = storage.find(addr);
+        ASSERT_NE(it, storage.end());
+        EXPECT_EQ(it->item.value, value);
+    }
+}
@@ -34,8 +34,13 @@ namespace gem5
 {
 
 ThreadBridge::ThreadBridge(const ThreadBridgeParams &p)
-    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this)
+    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this),
+      delay_(p.delay), req_size_(p.req_size)
 {
+    // Packets take at least the delay to cross, so the event queues
+    // can run this far apart.
+    if (delay_ > 0)
+        registerLookahead(delay_);
 }
 
 ThreadBridge::IncomingPort::IncomingPort(const std::string &name,
@@ -54,12 +59,37 @@ ThreadBridge::IncomingPort::getAddrRanges() const
 bool
 ThreadBridge::IncomingPort::recvTimingReq(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    if (!device_.initiator_queue_) {
+        device_.initiator_queue_ = curEventQueue();
+        fatal_if(device_.initiator_queue_ != device_.eventQueue() &&
+                 (device_.delay_ == 0 || simQuantum > device_.delay_),
+                 "%s: The delay of a timing crossing can't be shorter "
+                 "than the simulation quantum.", device_.name());
+    }
+    assert(device_.initiator_queue_ == curEventQueue());
+
+    std::lock_guard<std::mutex> guard(device_.lock_);
+    if (device_.reqs_.packets.size() >= device_.req_size_) {
+        device_.retry_req_ = true;
+        return false;
+    }
+
+    // As for a Bridge, the delays of the packet are paid before it
+    // crosses, on top of the crossing delay.
+    const Tick when = curTick() + device_.delay_ + pkt->headerDelay +
+        pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    device_.reqs_.packets.emplace_back(when, pkt);
+    device_.scheduleOn(device_.eventQueue(), when,
+                       [this]() { device_.sendReqs(false); }, "sendReq");
+    return true;
 }
+
 void
 ThreadBridge::IncomingPort::recvRespRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.sendResps(true);
 }
 
 // AtomicResponseProtocol
@@ -74,6 +104,17 @@ ThreadBridge::IncomingPort::recvAtomic(PacketPtr pkt)
 void
 ThreadBridge::IncomingPort::recvFunctional(PacketPtr pkt)
 {
+    {
+        // Check the packets crossing in timing mode first
+        std::lock_guard<std::mutex> guard(device_.lock_);
+        for (const auto &crossing : { &device_.reqs_, &device_.resps_ }) {
+            for (const auto &[when, in_flight] : crossing->packets) {
+                if (pkt->trySatisfyFunctional(in_flight))
+                    return;
+            }
+        }
+    }
+
     EventQueue::ScopedMigration migrate(device_.eventQueue());
     device_.out_port_.sendFunctional(pkt);
 }
@@ -94,12 +135,114 @@ ThreadBridge::OutgoingPort::recvRangeChange()
 bool
 ThreadBridge::OutgoingPort::recvTimingResp(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    // Responses are bounded by the requests crossing, so there is
+    // always room for them.
+    std::lock_guard<std::mutex> guard(device_.lock_);
+    const Tick when = curTick() + device_.delay_ + pkt->headerDelay +
+        pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    device_.resps_.packets.emplace_back(when, pkt);
+    device_.scheduleOn(device_.initiator_queue_, when,
+                       [this]() { device_.sendResps(false); }, "sendResp");
+    return true;
 }
+
 void
 ThreadBridge::OutgoingPort::recvReqRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.sendReqs(true);
+}
+
+bool
+ThreadBridge::sendDue(Crossing &crossing, bool retry,
+                      const std::function<bool(PacketPtr)> &send)
+{
+    std::unique_lock<std::mutex> guard(lock_);
+    // Packets becoming due while waiting for a retry are sent once
+    // the retry arrives.
+    if (crossing.waitingRetry && !retry)
+        return false;
+    crossing.waitingRetry = false;
+
+    bool sent = false;
+    while (!crossing.packets.empty() &&
+           crossing.packets.front().first <= curTick()) {
+        PacketPtr pkt = crossing.packets.front().second;
+
+        // The receiver may call back into the bridge, e.g. to send a
+        // response, so don't hold the lock while sending.
+        guard.unlock();
+        const bool accepted = send(pkt);
+        guard.lock();
+
+        if (!accepted) {
+            crossing.waitingRetry = true;
+            break;
+        }
+        crossing.packets.pop_front();
+        sent = true;
+    }
+    return sent;
+}
+
+void
+ThreadBridge::sendReqs(bool retry)
+{
+    const bool sent = sendDue(reqs_, retry, [this](PacketPtr pkt) {
+        return out_port_.sendTimingReq(pkt);
+    });
+    if (!sent)
+        return;
+
+    std::lock_guard<std::mutex> guard(lock_);
+    if (retry_req_ && reqs_.packets.size() < req_size_) {
+        retry_req_ = false;
+        scheduleOn(initiator_queue_, curTick() + delay_,
+                   [this]() { in_port_.sendRetryReq(); }, "retryReq");
+    }
+    checkDrained();
+}
+
+void
+ThreadBridge::sendResps(bool retry)
+{
+    const bool sent = sendDue(resps_, retry, [this](PacketPtr pkt) {
+        return in_port_.sendTimingResp(pkt);
+    });
+    if (!sent)
+        return;
+
+    std::lock_guard<std::mutex> guard(lock_);
+    checkDrained();
+}
+
+void
+ThreadBridge::scheduleOn(EventQueue *queue, Tick when,
+                         const std::function<void()> &func,
+                         const std::string &what)
+{
+    // The events are one-off, so they are never shared between the
+    // two threads.
+    auto *event = new EventFunctionWrapper(func, name() + "." + what, true);
+    queue->schedule(event, when);
+}
+
+void
+ThreadBridge::checkDrained()
+{
+    if (drainState() == DrainState::Draining && reqs_.packets.empty() &&
+        resps_.packets.empty()) {
+        signalDrainDone();
+    }
+}
+
+DrainState
+ThreadBridge::drain()
+{
+    std::lock_guard<std::mutex> guard(lock_);
+    return reqs_.packets.empty() && resps_.packets.empty() ?
+        DrainState::Drained : DrainState::Draining;
 }
 
 Port &
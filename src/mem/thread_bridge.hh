@@ -28,8 +28,14 @@
 #ifndef __MEM_THREAD_BRIDGE_HH__
 #define __MEM_THREAD_BRIDGE_HH__
 
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
 #include "mem/port.hh"
 #include "params/ThreadBridge.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -43,6 +49,8 @@ class ThreadBridge : public SimObject
     Port &getPort(const std::string &if_name,
                   PortID idx = InvalidPortID) override;
 
+    DrainState drain() override;
+
   private:
     class IncomingPort : public ResponsePort
     {
@@ -78,8 +86,68 @@ class ThreadBridge : public SimObject
         ThreadBridge &device_;
     };
 
+    /**
+     * Packets crossing from one event queue to the other in timing
+     * mode, in order, and with the tick they are due on the other side.
+     */
+    struct Crossing
+    {
+        std::deque<std::pair<Tick, PacketPtr>> packets;
+
+        /** Was the packet at the front refused by the receiver? */
+        bool waitingRetry = false;
+    };
+
+    /**
+     * Send the due packets of a crossing, until one is refused. Must
+     * be called from the receiving side's event queue.
+     *
+     * @param crossing Packets to send
+     * @param retry Called for a retry from the receiver
+     * @param send Function sending a packet, returning false if refused
+     * @return true if any packet was sent
+     */
+    bool sendDue(Crossing &crossing, bool retry,
+                 const std::function<bool(PacketPtr)> &send);
+
+    /** Send the due requests on the target side */
+    void sendReqs(bool retry);
+
+    /** Send the due responses on the initiator side */
+    void sendResps(bool retry);
+
+    /**
+     * Schedule a one-off event on either side's event queue. Unless
+     * both sides share a queue, the event must be at least one
+     * crossing delay in the future.
+     */
+    void scheduleOn(EventQueue *queue, Tick when,
+                    const std::function<void()> &func,
+                    const std::string &what);
+
+    /** Signal that draining is done if nothing is in flight */
+    void checkDrained();
+
     IncomingPort in_port_;
     OutgoingPort out_port_;
+
+    /** Latency of a timing mode crossing */
+    const Tick delay_;
+
+    /** Maximum number of requests crossing to the target at a time */
+    const unsigned int req_size_;
+
+    /** Event queue of the initiator side, known from the first request */
+    EventQueue *initiator_queue_ = nullptr;
+
+    /** Protects the crossings, shared by the two event queues */
+    std::mutex lock_;
+
+    Crossing reqs_;
+    Crossing resps_;
+
+    /** Does the initiator wait for a retry? */
+    bool retry_req_ = false;
 };
 
 }  // namespace gem5
@@ -45,6 +45,8 @@
 
 #include "mem/translating_port_proxy.hh"
 
+#include <cstring>
+
 #include "arch/generic/mmu.hh"
 #include "base/chunk_generator.hh"
 #include "cpu/base.hh"
@@ -85,14 +87,55 @@ TranslatingPortProxy::tryOnBlob(BaseMMU::Mode mode, TranslationGenPtr gen,
     return true;
 }
 
+uint8_t *
+TranslatingPortProxy::backdoorPtr(const TranslationGen::Range &range,
+        MemBackdoor::Flags access, MemBackdoorPtr &backdoor) const
+{
+    if (!useBackdoors ||
+        range.flags.isSet(Request::UNCACHEABLE | Request::STRICT_ORDER) ||
+        !_tc->getSystemPtr()->isAtomicMode()) {
+        return nullptr;
+    }
+
+    auto covers = [&range, access](MemBackdoorPtr bd) {
+        return bd && (bd->flags() & access) == access &&
+            !bd->range().interleaved() &&
+            range.paddr >= bd->range().start() &&
+            range.paddr + range.size <= bd->range().end();
+    };
+
+    if (!covers(backdoor)) {
+        backdoor = nullptr;
+        auto *port =
+            dynamic_cast<RequestPort *>(&_tc->getCpuPtr()->getDataPort());
+        if (port) {
+            port->sendMemBackdoorReq(MemBackdoorReq(
+                    RangeSize(range.paddr, range.size), access), backdoor);
+        }
+        if (!covers(backdoor)) {
+            backdoor = nullptr;
+            return nullptr;
+        }
+    }
+
+    return backdoor->ptr() + (range.paddr - backdoor->range().start());
+}
+
 bool
 TranslatingPortProxy::tryReadBlob(Addr addr, void *p, uint64_t size) const
 {
     constexpr auto mode = BaseMMU::Read;
+    MemBackdoorPtr backdoor = nullptr;
     return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
             addr, size, _tc, mode, flags),
-        [this, &p](const auto &range) {
-            PortProxy::readBlobPhys(range.paddr, range.flags, p, range.size);
+        [this, &p, &backdoor](const auto &range) {
+            if (auto *host = backdoorPtr(
+                        range, MemBackdoor::Readable, backdoor)) {
+                std::memcpy(p, host, range.size);
+            } else {
+                PortProxy::readBlobPhys(
+                        range.paddr, range.flags, p, range.size);
+            }
             p = static_cast<uint8_t *>(p) + range.size;
     });
 }
@@ -102,10 +145,17 @@ TranslatingPortProxy::tryWriteBlob(
         Addr addr, const void *p, uint64_t size) const
 {
     constexpr auto mode = BaseMMU::Write;
+    MemBackdoorPtr backdoor = nullptr;
     return tryOnBlob(mode, _tc->getMMUPtr()->translateFunctional(
             addr, size, _tc, mode, flags),
-        [this, &p](const auto &range) {
-            PortProxy::writeBlobPhys(range.paddr, range.flags, p, range.size);
+        [this, &p, &backdoor](const auto &range) {
+            if (auto *host = backdoorPtr(
+                        range, MemBackdoor::Writeable, backdoor)) {
+                std::memcpy(host, p, range.size);
+            } else {
+                PortProxy::writeBlobPhys(
+                        range.paddr, range.flags, p, range.size);
+            }
             p = static_cast<const uint8_t *>(p) + range.size;
     });
 }
@@ -44,6 +44,7 @@
 #include <functional>
 
 #include "arch/generic/mmu.hh"
+#include "mem/backdoor.hh"
 #include "mem/port_proxy.hh"
 
 namespace gem5
@@ -63,6 +64,27 @@ class TranslatingPortProxy : public PortProxy
     ThreadContext* _tc;
     Request::Flags flags;
 
+    /**
+     * Copy data straight through memory backdoors where the memory
+     * system offers them instead of sending a functional packet for
+     * every cache line. Only safe while no timing accesses can be in
+     * flight, so it is solely used with atomic memory modes.
+     */
+    bool useBackdoors = false;
+
+    /**
+     * Find the host pointer of a translated physical range through a
+     * memory backdoor, reusing the backdoor found for the previous
+     * range of the same blob if it covers this one as well.
+     *
+     * @param range The translated range to access.
+     * @param access The required access permissions.
+     * @param backdoor The backdoor to try first, updated on lookup.
+     * @return Host pointer to the range or nullptr if there is none.
+     */
+    uint8_t *backdoorPtr(const TranslationGen::Range &range,
+            MemBackdoor::Flags access, MemBackdoorPtr &backdoor) const;
+
     virtual bool
     fixupRange(const TranslationGen::Range &range, BaseMMU::Mode mode) const
     {
@@ -447,6 +447,10 @@ BaseXBar::recvRangeChange(PortID mem_side_port_id)
     // modules, go ahead and tell our connected memory-side-port modules in
     // turn, this effectively assumes a tree structure of the system
     if (gotAllAddrRanges) {
+        // the routing table is complete and from now on only read,
+        // unless a port changes its ranges again
+        portMap.freeze();
+
         DPRINTF(AddrRanges, "Aggregating address ranges\n");
         xbarRanges.clear();
 
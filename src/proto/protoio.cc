@@ -37,73 +37,254 @@
 
 #include "proto/protoio.hh"
 
+#include <zlib.h>
+
+#include <algorithm>
 #include <string>
 
 #include "base/logging.hh"
+#include "proto/trace_index.pb.h"
 
 using namespace google::protobuf;
 
-ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
+ProtoOutputStream::ProtoOutputStream(const std::string& filename,
+                                     unsigned compress_threads) :
     fileStream(filename.c_str(),
             std::ios::out | std::ios::binary | std::ios::trunc),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    fileName(filename), useGzip(false), records(0), batchStart(true),
+    batchBlock(), bytesWritten(0), nextSubmit(0), nextWrite(0),
+    inFlight(0), maxInFlight(2 * std::max(compress_threads, 1U)),
+    stopping(false), writing(false)
 {
     if (!fileStream.good())
         panic("Could not open %s for writing\n", filename);
 
-    // Wrap the output file in a zero copy stream, that in turn is
-    // wrapped in a gzip stream if the filename ends with .gz. The
-    // latter stream is in turn wrapped in a coded stream
-    wrappedFileStream = new io::OstreamOutputStream(&fileStream);
-    if (filename.find_last_of('.') != std::string::npos &&
-        filename.substr(filename.find_last_of('.') + 1) == "gz") {
-        gzipStream = new io::GzipOutputStream(wrappedFileStream);
-        zeroCopyStream = gzipStream;
-    } else {
-        zeroCopyStream = wrappedFileStream;
-    }
+    // Compress the output if the filename ends with .gz
+    useGzip = filename.find_last_of('.') != std::string::npos &&
+        filename.substr(filename.find_last_of('.') + 1) == "gz";
 
     // Write the magic number to the file
-    io::CodedOutputStream codedStream(zeroCopyStream);
-    codedStream.WriteLittleEndian32(magicNumber);
+    batch.reserve(batchSize);
+    batch.resize(sizeof(magicNumber));
+    io::CodedOutputStream::WriteLittleEndian32ToArray(
+        magicNumber, reinterpret_cast<uint8_t *>(&batch[0]));
 
     // Note that each type of stream (packet, instruction etc) should
     // add its own header and perform the appropriate checks
+
+    for (unsigned i = 0; i < std::max(compress_threads, 1U); i++)
+        threads.emplace_back([this]() { writerThread(); });
 }
 
 ProtoOutputStream::~ProtoOutputStream()
 {
-    // As the compression is optional, see if the stream exists
-    if (gzipStream != NULL)
-        delete gzipStream;
-    delete wrappedFileStream;
+    if (!batch.empty())
+        submit();
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto &thread : threads)
+        thread.join();
+
     fileStream.close();
+    writeIndex();
 }
 
 void
 ProtoOutputStream::write(const Message& msg)
 {
-    // Due to the byte limit of the coded stream we create it for
-    // every single mesage (based on forum discussions around the size
-    // limitation)
-    io::CodedOutputStream codedStream(zeroCopyStream);
-
     // Write the size of the message to the stream
 #   if GOOGLE_PROTOBUF_VERSION < 3001000
         auto msg_size = msg.ByteSize();
 #   else
         auto msg_size = msg.ByteSizeLong();
 #   endif
-    codedStream.WriteVarint32(msg_size);
 
-    // Write the message itself to the stream
-    msg.SerializeWithCachedSizes(&codedStream);
+    // Remember where the batch starts for the index, using the tick
+    // of the first message if it has one
+    if (batchStart) {
+        batchBlock.record = records;
+        const FieldDescriptor *field =
+            msg.GetDescriptor()->FindFieldByName("tick");
+        batchBlock.hasTick = field && !field->is_repeated() &&
+            field->cpp_type() == FieldDescriptor::CPPTYPE_UINT64 &&
+            msg.GetReflection()->HasField(msg, field);
+        batchBlock.tick = batchBlock.hasTick ?
+            msg.GetReflection()->GetUInt64(msg, field) : 0;
+        batchStart = false;
+    }
+    records++;
+
+    // Serialize the size followed by the message straight into the
+    // batch, the background threads take care of the file
+    size_t offset = batch.size();
+    batch.resize(offset + io::CodedOutputStream::VarintSize32(msg_size) +
+                 msg_size);
+    uint8_t *ptr = reinterpret_cast<uint8_t *>(&batch[offset]);
+    ptr = io::CodedOutputStream::WriteVarint32ToArray(msg_size, ptr);
+    msg.SerializeWithCachedSizesToArray(ptr);
+
+    if (batch.size() >= batchSize)
+        submit();
+}
+
+void
+ProtoOutputStream::submit()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    bufferAvailable.wait(guard, [this]() {
+        return inFlight < maxInFlight;
+    });
+
+    pending.emplace_back(nextSubmit++, std::move(batch));
+    index.push_back(batchBlock);
+    batchStart = true;
+    inFlight++;
+
+    if (!freeBuffers.empty()) {
+        batch = std::move(freeBuffers.back());
+        freeBuffers.pop_back();
+    } else {
+        batch = std::string();
+    }
+    batch.clear();
+    batch.reserve(batchSize);
+
+    guard.unlock();
+    workAvailable.notify_one();
+}
+
+void
+ProtoOutputStream::writerThread()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        workAvailable.wait(guard, [this]() {
+            return stopping || !pending.empty();
+        });
+        if (pending.empty())
+            return;
+
+        auto job = std::move(pending.front());
+        pending.pop_front();
+
+        guard.unlock();
+        std::string out;
+        if (useGzip)
+            compress(job.second, out);
+        else
+            out.swap(job.second);
+        guard.lock();
+
+        if (useGzip) {
+            freeBuffers.push_back(std::move(job.second));
+        }
+        done.emplace(job.first, std::move(out));
+
+        // Batches may finish compressing out of order, so only one
+        // thread at a time writes the ones that are next in line
+        if (writing)
+            continue;
+        writing = true;
+        while (!done.empty() && done.begin()->first == nextWrite) {
+            std::string data = std::move(done.begin()->second);
+            done.erase(done.begin());
+            index[nextWrite].offset = bytesWritten;
+            bytesWritten += data.size();
+
+            guard.unlock();
+            fileStream.write(data.data(), data.size());
+            if (!fileStream.good())
+                panic("Failed writing to %s\n", fileName);
+            guard.lock();
+
+            if (!useGzip)
+                freeBuffers.push_back(std::move(data));
+            nextWrite++;
+            inFlight--;
+            bufferAvailable.notify_one();
+        }
+        writing = false;
+    }
+}
+
+void
+ProtoOutputStream::compress(const std::string& in, std::string& out) const
+{
+    z_stream zs = {};
+
+    // A window of 15 bits plus 16 makes zlib emit a gzip header and
+    // trailer, so every batch is a gzip member of its own
+    if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        panic("Unable to initialize compression for %s\n", fileName);
+    }
+
+    out.resize(deflateBound(&zs, in.size()));
+    zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in.data()));
+    zs.avail_in = in.size();
+    zs.next_out = reinterpret_cast<Bytef *>(&out[0]);
+    zs.avail_out = out.size();
+
+    if (deflate(&zs, Z_FINISH) != Z_STREAM_END)
+        panic("Unable to compress trace batch for %s\n", fileName);
+
+    out.resize(zs.total_out);
+    deflateEnd(&zs);
+}
+
+void
+ProtoOutputStream::writeIndex() const
+{
+    // The index is small, so it is written uncompressed using the same
+    // format as the traces
+    const std::string name = fileName + indexSuffix();
+    std::ofstream out(name.c_str(),
+                      std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.good()) {
+        warn("Could not open %s for writing, the trace is not indexed\n",
+             name);
+        return;
+    }
+
+    {
+        io::OstreamOutputStream zero_copy(&out);
+        io::CodedOutputStream coded(&zero_copy);
+        coded.WriteLittleEndian32(magicNumber);
+
+        // The last entry marks the end of the file, allowing a reader to
+        // tell if the index belongs to the trace
+        std::vector<Block> blocks(index);
+        blocks.push_back(Block{bytesWritten, records, 0, false});
+
+        ProtoMessage::TraceBlock block_msg;
+        for (const auto &block : blocks) {
+            block_msg.Clear();
+            block_msg.set_offset(block.offset);
+            block_msg.set_record(block.record);
+            if (block.hasTick)
+                block_msg.set_tick(block.tick);
+#           if GOOGLE_PROTOBUF_VERSION < 3001000
+                coded.WriteVarint32(block_msg.ByteSize());
+#           else
+                coded.WriteVarint32(block_msg.ByteSizeLong());
+#           endif
+            block_msg.SerializeWithCachedSizes(&coded);
+        }
+    }
+
+    if (!out.good())
+        warn("Failed writing the trace index %s\n", name);
 }
 
 ProtoInputStream::ProtoInputStream(const std::string& filename) :
     fileStream(filename.c_str(), std::ios::in | std::ios::binary),
     fileName(filename), useGzip(false),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL),
+    curRecord(0)
 {
     if (!fileStream.good())
         panic("Could not open %s for reading\n", filename);
@@ -118,10 +299,57 @@ ProtoInputStream::ProtoInputStream(const std::string& filename) :
     fileStream.seekg(0, std::ifstream::beg);
 
     createStreams();
+    loadIndex();
 }
 
 void
-ProtoInputStream::createStreams()
+ProtoInputStream::loadIndex()
+{
+    const std::string name = fileName + indexSuffix();
+    std::ifstream probe(name.c_str(), std::ios::in | std::ios::binary);
+    if (!probe.good())
+        return;
+    probe.close();
+
+    // The file stream is in use by the wrapping streams, so look at
+    // the size of the file separately
+    std::ifstream file(fileName.c_str(),
+                       std::ios::in | std::ios::binary | std::ios::ate);
+    const uint64_t file_size = file.tellg();
+
+    ProtoInputStream index_stream(name);
+    ProtoMessage::TraceBlock block_msg;
+    while (index_stream.read(block_msg)) {
+        Block block;
+        block.offset = block_msg.offset();
+        block.record = block_msg.record();
+        block.hasTick = block_msg.has_tick();
+        block.tick = block_msg.tick();
+
+        // An index left behind by an older trace of the same name
+        // does not match the file, so rather not use it at all
+        const bool ordered = index.empty() ?
+            block.offset == 0 && block.record == 0 :
+            block.offset > index.back().offset &&
+            block.record >= index.back().record;
+        if (!ordered)
+            break;
+        index.push_back(block);
+    }
+
+    // An index left behind by an older trace of the same name has to
+    // be ignored, which is detected by the end of file entry
+    if (index.size() < 2 || index.back().offset != file_size) {
+        warn("Ignoring trace index %s as it does not match %s\n",
+             name, fileName);
+        index.clear();
+        return;
+    }
+    index.pop_back();
+}
+
+void
+ProtoInputStream::createStreams(bool check_magic)
 {
     // All streams should be NULL at this point
     assert(wrappedFileStream == NULL && gzipStream == NULL &&
@@ -138,6 +366,10 @@ ProtoInputStream::createStreams()
         zeroCopyStream = wrappedFileStream;
     }
 
+    // Only the first block starts with the magic number
+    if (!check_magic)
+        return;
+
     uint32_t magic_check;
     io::CodedInputStream codedStream(zeroCopyStream);
     if (!codedStream.ReadLittleEndian32(&magic_check) ||
@@ -176,6 +408,60 @@ ProtoInputStream::reset()
     fileStream.clear();
     fileStream.seekg(0, std::ifstream::beg);
     createStreams();
+    curRecord = 0;
+}
+
+bool
+ProtoInputStream::seekRecord(uint64_t record)
+{
+    // Find the last block starting at or before the record, and only
+    // move there if it is ahead of the current position or the record
+    // is behind it
+    auto block = std::upper_bound(index.begin(), index.end(), record,
+        [](uint64_t r, const Block &b) { return r < b.record; });
+    if (block != index.begin() &&
+        (std::prev(block)->record > curRecord || record < curRecord)) {
+        --block;
+        destroyStreams();
+        fileStream.clear();
+        fileStream.seekg(block->offset, std::ifstream::beg);
+        createStreams(block->offset == 0);
+        curRecord = block->record;
+    } else if (record < curRecord) {
+        reset();
+    }
+
+    while (curRecord < record) {
+        if (!skip())
+            return false;
+    }
+    return true;
+}
+
+uint64_t
+ProtoInputStream::findTick(uint64_t tick) const
+{
+    // Blocks without a tick, such as the one with the header, are
+    // treated as starting before any tick. Stop at the first block past
+    // the tick in case the ticks are not strictly increasing.
+    uint64_t record = 0;
+    for (const auto &block : index) {
+        if (block.hasTick && block.tick > tick)
+            break;
+        record = block.record;
+    }
+    return record;
+}
+
+bool
+ProtoInputStream::skip()
+{
+    uint32_t size;
+    io::CodedInputStream codedStream(zeroCopyStream);
+    if (!codedStream.ReadVarint32(&size) || !codedStream.Skip(size))
+        return false;
+    curRecord++;
+    return true;
 }
 
 bool
@@ -195,6 +481,7 @@ ProtoInputStream::read(Message& msg)
             codedStream.PopLimit(limit);
             // All went well, the message is parsed and the limit is
             // popped again
+            curRecord++;
             return true;
         } else {
             panic("Unable to read message from coded stream %s\n",
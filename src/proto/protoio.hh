@@ -49,11 +49,26 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <cassert>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 /**
  * A ProtoStream provides the shared functionality of the input and
- * output streams. At the moment this is limited to magic number.
+ * output streams. At the moment this is limited to magic number and
+ * the block index.
+ *
+ * The output stream writes the file in blocks that can each be decoded
+ * on their own, and records where every block starts in an index file
+ * next to the trace, named after the trace with .idx appended. The
+ * input stream uses the index, if there is one, to seek into a trace
+ * without decoding everything up to the desired position.
  */
 class ProtoStream
 {
@@ -63,6 +78,23 @@ class ProtoStream
     /// Use the ASCII characters gem5 as our magic number
     static const uint32_t magicNumber = 0x356d6567;
 
+    /// Index entry describing where a block of the file starts
+    struct Block
+    {
+        /// Offset of the block in the file
+        uint64_t offset;
+
+        /// Number of the first message in the block
+        uint64_t record;
+
+        /// Tick of the first message, if it has a tick field
+        uint64_t tick;
+        bool hasTick;
+    };
+
+    /// Suffix of the index file name
+    static std::string indexSuffix() { return ".idx"; }
+
     /**
      * Create a ProtoStream.
      */
@@ -86,6 +118,13 @@ class ProtoStream
  * basis to avoid having to deal with huge data structures. The latter
  * is made possible by encoding the length of each message in the
  * stream.
+ *
+ * To keep tracing off the simulation's critical path, messages are
+ * only serialized into an in-memory batch when they are written. Full
+ * batches are handed to background threads that compress and write
+ * them, while the simulation fills the next batch. Each compressed
+ * batch is a complete gzip member, so batches can be compressed in
+ * parallel and the file is still a regular gzip stream.
  */
 class ProtoOutputStream : public ProtoStream
 {
@@ -97,8 +136,11 @@ class ProtoOutputStream : public ProtoStream
      * ends with .gz then the file will be compressed accordinly.
      *
      * @param filename Path to the file to create or truncate
+     * @param compress_threads Number of background threads compressing
+     *        and writing batches, at least one
      */
-    ProtoOutputStream(const std::string& filename);
+    ProtoOutputStream(const std::string& filename,
+                      unsigned compress_threads = 1);
 
     /**
      * Destruct the output stream, and also flush and close the
@@ -116,17 +158,82 @@ class ProtoOutputStream : public ProtoStream
 
   private:
 
+    /// Size at which a batch is handed to the background threads
+    static const size_t batchSize = 1 << 20;
+
+    /**
+     * Hand the current batch to the background threads, waiting if
+     * all of the batch buffers are in use.
+     */
+    void submit();
+
+    /// Main loop of the background threads
+    void writerThread();
+
+    /// Gzip compress a batch as a complete gzip member
+    void compress(const std::string& in, std::string& out) const;
+
+    /// Write the block index next to the trace
+    void writeIndex() const;
+
     /// Underlying file output stream
     std::ofstream fileStream;
 
-    /// Zero Copy stream wrapping the STL output stream
-    google::protobuf::io::OstreamOutputStream* wrappedFileStream;
+    /// Hold on to the file name for error messages
+    const std::string fileName;
 
-    /// Optional Gzip stream to wrap the Zero Copy stream
-    google::protobuf::io::GzipOutputStream* gzipStream;
+    /// Boolean flag to remember whether we use gzip or not
+    bool useGzip;
 
-    /// Top-level zero-copy stream, either with compression or not
-    google::protobuf::io::ZeroCopyOutputStream* zeroCopyStream;
+    /// Batch currently filled by the simulation thread
+    std::string batch;
+
+    /// Number of messages written so far
+    uint64_t records;
+
+    /// Set until the first message of the current batch is written
+    bool batchStart;
+
+    /// Index entry of the current batch, completed when it is written
+    Block batchBlock;
+
+    /// Index entries of the submitted batches
+    std::vector<Block> index;
+
+    /// Number of bytes written to the file
+    uint64_t bytesWritten;
+
+    /// Sequence number of the next batch to submit
+    uint64_t nextSubmit;
+
+    /// Sequence number of the next batch to write to the file
+    uint64_t nextWrite;
+
+    /// Batches waiting to be compressed, with their sequence number
+    std::deque<std::pair<uint64_t, std::string>> pending;
+
+    /// Compressed batches waiting for their turn to be written
+    std::map<uint64_t, std::string> done;
+
+    /// Empty buffers for the simulation thread to reuse
+    std::vector<std::string> freeBuffers;
+
+    /// Number of batch buffers not available to the simulation thread
+    unsigned inFlight;
+
+    /// Maximum number of batches in flight before write() blocks
+    unsigned maxInFlight;
+
+    /// Set when the stream is destroyed to stop the threads
+    bool stopping;
+
+    /// Set while a thread is writing batches to the file
+    bool writing;
+
+    std::mutex lock;
+    std::condition_variable workAvailable;
+    std::condition_variable bufferAvailable;
+    std::vector<std::thread> threads;
 
 };
 
@@ -169,12 +276,52 @@ class ProtoInputStream : public ProtoStream
      */
     void reset();
 
+    /**
+     * Position the stream such that the next read returns the message
+     * with the given number, where the first message in the file is
+     * number zero. Messages between the closest indexed block and the
+     * desired one are skipped without parsing them.
+     *
+     * @param record Number of the message to seek to
+     * @return False if the stream ends before the message
+     */
+    bool seekRecord(uint64_t record);
+
+    /**
+     * Find a message to seek to before reading up to a tick, which is
+     * the first message of the last indexed block starting at or
+     * before the tick. Only messages with a tick field are indexed
+     * with their tick.
+     *
+     * @param tick Tick to look for
+     * @return Number of the message, zero without an index
+     */
+    uint64_t findTick(uint64_t tick) const;
+
+    /// Number of the message the next read returns
+    uint64_t record() const { return curRecord; }
+
+    /// Whether a block index was found for the file
+    bool hasIndex() const { return !index.empty(); }
+
   private:
 
     /**
      * Create the internal streams that are wrapping the input file.
+     *
+     * @param check_magic Check the magic number at the current position
      */
-    void createStreams();
+    void createStreams(bool check_magic = true);
+
+    /**
+     * Skip over a message without parsing it.
+     *
+     * @return False if there is no message left
+     */
+    bool skip();
+
+    /// Load the block index if there is one next to the file
+    void loadIndex();
 
     /**
      * Destroy the internal streams that are wrapping the input file.
@@ -199,6 +346,219 @@ class ProtoInputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyInputStream* zeroCopyStream;
 
+    /// Number of the message the next read returns
+    uint64_t curRecord;
+
+    /// Block index of the file, empty if there is none
+    std::vector<Block> index;
+
+};
+
+/**
+ * A ProtoReadAhead reads messages of a single type from a
+ * ProtoInputStream on a helper thread, so that decompressing and
+ * parsing the trace overlaps with the simulation consuming it. The
+ * decoded messages are handed over in chunks, and the helper thread
+ * stops reading ahead once the chunks waiting to be consumed hold more
+ * than a given number of bytes.
+ *
+ * Any header has to be read from the input stream before the read
+ * ahead is started. While it is running, the input stream must only be
+ * accessed through the ProtoReadAhead.
+ */
+template <class Msg>
+class ProtoReadAhead
+{
+
+  public:
+
+    /**
+     * @param stream Input stream to read the messages from
+     * @param budget Maximum number of bytes of decoded messages waiting
+     *        to be consumed
+     */
+    ProtoReadAhead(ProtoInputStream& stream, size_t budget = 16 << 20)
+        : stream(stream), budget(budget), pos(0), queuedBytes(0),
+          eof(false), stopping(false)
+    {}
+
+    ~ProtoReadAhead() { stop(); }
+
+    /**
+     * Start reading ahead from the current position of the stream.
+     */
+    void
+    start()
+    {
+        assert(!thread.joinable());
+        eof = false;
+        stopping = false;
+        thread = std::thread([this]() { readerThread(); });
+    }
+
+    /**
+     * Stop the helper thread and drop the messages read ahead, leaving
+     * the input stream available to the caller, e.g. to reset it.
+     */
+    void
+    stop()
+    {
+        if (!thread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        spaceAvailable.notify_all();
+        thread.join();
+
+        current.count = 0;
+        pos = 0;
+        for (auto &chunk : full)
+            freeChunks.push_back(std::move(chunk));
+        full.clear();
+        queuedBytes = 0;
+    }
+
+    /**
+     * Read the next message, waiting for the helper thread if needed.
+     *
+     * @param msg Message read from the stream
+     * @return True if a message was read, false at the end
+     */
+    bool
+    read(Msg& msg)
+    {
+        while (pos == current.count) {
+            if (!nextChunk())
+                return false;
+        }
+        msg.Swap(&current.records[pos++]);
+        return true;
+    }
+
+  private:
+
+    /// Number of messages decoded at a time by the helper thread
+    static const size_t chunkRecords = 512;
+
+    struct Chunk
+    {
+        std::vector<Msg> records;
+        size_t count = 0;
+        size_t bytes = 0;
+    };
+
+    /**
+     * Give the consumed chunk back to the helper thread and take the
+     * next one, returns false at the end of the stream.
+     */
+    bool
+    nextChunk()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        if (!current.records.empty())
+            freeChunks.push_back(std::move(current));
+        current = Chunk();
+        pos = 0;
+
+        dataAvailable.wait(guard, [this]() {
+            return !full.empty() || eof;
+        });
+        if (full.empty())
+            return false;
+
+        current = std::move(full.front());
+        full.pop_front();
+        queuedBytes -= current.bytes;
+        guard.unlock();
+        spaceAvailable.notify_one();
+        return true;
+    }
+
+    /// Main loop of the helper thread
+    void
+    readerThread()
+    {
+        bool end = false;
+        while (!end) {
+            Chunk chunk;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (!freeChunks.empty()) {
+                    chunk = std::move(freeChunks.back());
+                    freeChunks.pop_back();
+                }
+            }
+            chunk.records.resize(chunkRecords);
+            chunk.count = 0;
+            chunk.bytes = 0;
+
+            // Decoding happens without holding the lock, the messages
+            // are reused from consumed chunks to save allocations
+            while (chunk.count < chunkRecords) {
+                Msg &msg = chunk.records[chunk.count];
+                if (!stream.read(msg)) {
+                    end = true;
+                    break;
+                }
+#               if GOOGLE_PROTOBUF_VERSION < 3001000
+                    chunk.bytes += msg.ByteSize();
+#               else
+                    chunk.bytes += msg.ByteSizeLong();
+#               endif
+                chunk.count++;
+            }
+
+            std::unique_lock<std::mutex> guard(lock);
+            spaceAvailable.wait(guard, [this, &chunk]() {
+                return stopping || queuedBytes == 0 ||
+                    queuedBytes + chunk.bytes <= budget;
+            });
+            if (stopping)
+                return;
+
+            queuedBytes += chunk.bytes;
+            full.push_back(std::move(chunk));
+            eof = end;
+            guard.unlock();
+            dataAvailable.notify_one();
+        }
+    }
+
+    /// The stream the messages are read from
+    ProtoInputStream& stream;
+
+    /// Maximum number of queued bytes before the helper thread waits
+    const size_t budget;
+
+    /// Chunk being consumed, only used by the consumer
+    Chunk current;
+
+    /// Position of the next message in the current chunk
+    size_t pos;
+
+    /// Decoded chunks waiting to be consumed
+    std::deque<Chunk> full;
+
+    /// Consumed chunks whose messages can be reused
+    std::vector<Chunk> freeChunks;
+
+    /// Bytes of decoded messages in the full chunks
+    size_t queuedBytes;
+
+    /// Set once the last chunk of the stream is queued
+    bool eof;
+
+    /// Set to make the helper thread exit
+    bool stopping;
+
+    std::mutex lock;
+    std::condition_variable dataAvailable;
+    std::condition_variable spaceAvailable;
+    std::thread thread;
+
 };
 
 #endif //__PROTO_PROTOIO_HH
@@ -45,6 +45,7 @@ from .caches.l1dcache import L1DCache
 from .caches.l1icache import L1ICache
 from .caches.l2cache import L2Cache
 from .caches.mmu_cache import MMUCache
+from .sliced_cache import SlicedCache
 
 
 class PrivateL1SharedL2CacheHierarchy(
@@ -80,6 +81,7 @@ class PrivateL1SharedL2CacheHierarchy(
         l1i_assoc: int = 8,
         l2_assoc: int = 16,
         membus: Optional[BaseXBar] = None,
+        l2_slices: int = 1,
     ) -> None:
         """
         :param l1d_size: The size of the L1 Data Cache (e.g., "32kB").
@@ -91,6 +93,10 @@ class PrivateL1SharedL2CacheHierarchy(
         :param membus: The memory bus. This parameter is optional parameter and
                        will default to a 64 bit width SystemXBar is not
                        specified.
+        :param l2_slices: The number of address interleaved slices the L2
+                          cache is split into. Each slice gets an equal share
+                          of the L2 size and its own MSHRs. Must be a power
+                          of 2.
         """
 
         AbstractClassicCacheHierarchy.__init__(self=self)
@@ -105,6 +111,7 @@ class PrivateL1SharedL2CacheHierarchy(
         )
 
         self.membus = membus if membus else self._get_default_membus()
+        self._l2_slices = l2_slices
 
     @overrides(AbstractClassicCacheHierarchy)
     def get_mem_side_port(self) -> Port:
@@ -135,7 +142,18 @@ class PrivateL1SharedL2CacheHierarchy(
             for i in range(board.get_processor().get_num_cores())
         ]
         self.l2bus = L2XBar()
-        self.l2cache = L2Cache(size=self._l2_size, assoc=self._l2_assoc)
+        if self._l2_slices == 1:
+            self.l2cache = L2Cache(size=self._l2_size, assoc=self._l2_assoc)
+        else:
+            self.l2cache = SlicedCache(
+                size=self._l2_size,
+                num_slices=self._l2_slices,
+                mem_ranges=board.mem_ranges,
+                cache_line_size=board.get_cache_line_size(),
+                cache_factory=lambda size: L2Cache(
+                    size=size, assoc=self._l2_assoc
+                ),
+            )
         # ITLB Page walk caches
         self.iptw_caches = [
             MMUCache(size="8KiB", writeback_clean=False)
@@ -170,8 +188,12 @@ class PrivateL1SharedL2CacheHierarchy(
             else:
                 cpu.connect_interrupt()
 
-        self.l2bus.mem_side_ports = self.l2cache.cpu_side
-        self.membus.cpu_side_ports = self.l2cache.mem_side
+        if self._l2_slices == 1:
+            self.l2bus.mem_side_ports = self.l2cache.cpu_side
+            self.membus.cpu_side_ports = self.l2cache.mem_side
+        else:
+            self.l2cache.connect_cpu_side(self.l2bus.mem_side_ports)
+            self.l2cache.connect_mem_side(self.membus.cpu_side_ports)
 
     def _setup_io_cache(self, board: AbstractBoard) -> None:
         """Create a cache for coherent I/O connections"""
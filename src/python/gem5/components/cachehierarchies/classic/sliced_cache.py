@@ -0,0 +1,161 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from typing import (
+    Callable,
+    List,
+    Optional,
+)
+
+from m5.objects import (
+    AddrRange,
+    Cache,
+    Port,
+    SubSystem,
+)
+from m5.util import fatal
+from m5.util.convert import toMemorySize
+
+from ....utils.override import *
+from .caches.l2cache import L2Cache
+
+
+class SlicedCache(SubSystem):
+    """
+    A cache split into address interleaved slices, such as the banks of a
+    shared last level cache. Every slice is a separate classic cache, with
+    its own tags, MSHRs, write buffers and timing, so lookups to different
+    slices don't serialize on a single cache.
+
+    There is no dedicated router: each slice only claims an interleaved
+    part of the memory ranges (through its addr_ranges), so the crossbar
+    the slices are connected to routes every request to its slice.
+
+    The slice of an address is selected by the interleaving bits just above
+    the cache line, optionally XORed with higher address bits to spread
+    strided accesses over the slices. Arbitrary XOR hashes can be given as
+    AddrRange interleaving masks.
+    """
+
+    def __init__(
+        self,
+        size: str,
+        num_slices: int,
+        mem_ranges: List[AddrRange],
+        cache_line_size: int = 64,
+        xor_low_bit: Optional[int] = 20,
+        slice_masks: Optional[List[int]] = None,
+        cache_factory: Callable[[str], Cache] = lambda size: L2Cache(
+            size=size
+        ),
+    ) -> None:
+        """
+        :param size: The total size of the cache. Each slice holds an equal
+                     share of it.
+        :param num_slices: The number of slices. Must be a power of 2.
+        :param mem_ranges: The memory ranges cached by the slices.
+        :param cache_line_size: The cache line size, in bytes. The slices
+                                are interleaved at this granularity.
+        :param xor_low_bit: The lowest address bit XORed with the
+                            interleaving bits. None disables the XOR
+                            hashing.
+        :param slice_masks: The interleaving masks selecting the slice, one
+                            per slice index bit. When given, they replace
+                            the default interleaving (and xor_low_bit).
+        :param cache_factory: Builds a slice for a given slice size.
+        """
+        super().__init__()
+
+        if num_slices <= 0 or num_slices & (num_slices - 1):
+            fatal("The number of cache slices must be a power of 2")
+
+        intlv_bits = num_slices.bit_length() - 1
+        if slice_masks is not None and len(slice_masks) != intlv_bits:
+            fatal(
+                f"{intlv_bits} slice masks are needed for {num_slices} "
+                f"slices, {len(slice_masks)} were given"
+            )
+
+        intlv_low_bit = int(cache_line_size).bit_length() - 1
+        slice_size = f"{toMemorySize(size) // num_slices}B"
+
+        self.slices = [cache_factory(slice_size) for _ in range(num_slices)]
+
+        for index, cache_slice in enumerate(self.slices):
+            ranges = []
+            for mem_range in mem_ranges:
+                if num_slices == 1:
+                    ranges.append(mem_range)
+                elif slice_masks is not None:
+                    ranges.append(
+                        AddrRange(
+                            start=mem_range.start,
+                            size=mem_range.size(),
+                            masks=slice_masks,
+                            intlvMatch=index,
+                        )
+                    )
+                else:
+                    ranges.append(
+                        AddrRange(
+                            start=mem_range.start,
+                            size=mem_range.size(),
+                            intlvHighBit=intlv_low_bit + intlv_bits - 1,
+                            xorHighBit=(
+                                0
+                                if xor_low_bit is None
+                                else xor_low_bit + intlv_bits - 1
+                            ),
+                            intlvBits=intlv_bits,
+                            intlvMatch=index,
+                        )
+                    )
+            cache_slice.addr_ranges = ranges
+
+    def get_slices(self) -> List[Cache]:
+        """
+        :returns: The cache slices.
+        """
+        return self.slices
+
+    def connect_cpu_side(self, port: Port) -> None:
+        """
+        Connect the CPU side of every slice to a crossbar.
+
+        :param port: The memory side ports of the crossbar routing the
+                     requests to the slices.
+        """
+        for cache_slice in self.slices:
+            cache_slice.cpu_side = port
+
+    def connect_mem_side(self, port: Port) -> None:
+        """
+        Connect the memory side of every slice to a crossbar.
+
+        :param port: The CPU side ports of the crossbar below the slices.
+        """
+        for cache_slice in self.slices:
+            cache_slice.mem_side = port
@@ -91,6 +91,26 @@ class AbstractMemorySystem(SubSystem):
         """
         raise NotImplementedError
 
+    def set_analytic_mode(self, analytic: bool) -> None:
+        """Switch the memory controllers between the detailed and the
+        analytic timing mode. In the analytic mode, requests are serviced
+        using a latency and bandwidth model of the memory instead of the
+        bank and rank state machines, which is much faster, e.g., during
+        warmup. This can be done between calls to ``m5.simulate`` without
+        draining the memory system. To start in the analytic timing mode,
+        set the ``analytic_mode`` parameter of the memory controllers
+        instead.
+
+        :param analytic: True to use the analytic timing mode, False to go
+                         back to the detailed timing mode.
+        """
+        for ctrl in self.get_memory_controllers():
+            if not isinstance(ctrl, MemCtrl):
+                raise NotImplementedError(
+                    f"{type(ctrl).__name__} has no analytic timing mode."
+                )
+            ctrl.setAnalyticMode(analytic)
+
     def _post_instantiate(self) -> None:
         """Called to set up anything needed after ``m5.instantiate``."""
         pass
@@ -42,6 +42,7 @@ from m5.objects import (
     DRAMInterface,
     MemCtrl,
     Port,
+    ThreadBridge,
 )
 from m5.util.convert import toMemorySize
 
@@ -123,6 +124,7 @@ class ChanneledMemory(AbstractMemorySystem):
             self._size = self._get_dram_size(num_channels, self._dram_class)
 
         self._create_mem_interfaces_controller()
+        self._parallel_channels = False
 
     def _create_mem_interfaces_controller(self):
         self._dram = [
@@ -177,9 +179,51 @@ class ChanneledMemory(AbstractMemorySystem):
                 f"size: {self._intlv_size}"
             )
 
+    def set_channel_event_queues(
+        self, first_eventq_index: int = 1, crossing_latency: str = "4ns"
+    ) -> None:
+        """Simulate every channel on its own event queue, and thus on its
+        own host thread, so that memory-bound simulations can use more host
+        cores.
+
+        The requests for a channel reach its controller through a
+        ThreadBridge, which adds ``crossing_latency`` to every request and
+        every response. This latency can't be shorter than the simulation
+        quantum. Unless ``Root.sim_quantum`` is set, the quantum is derived
+        from the crossing latency. The channels use the event queues
+        ``first_eventq_index`` to ``first_eventq_index + num_channels - 1``,
+        which must not be used by other components.
+
+        This must be called before the memory is incorporated in a board.
+        It only takes effect in the timing memory mode, since atomic and
+        functional accesses cross the bridges immediately.
+
+        :param first_eventq_index: The event queue of the first channel.
+        :param crossing_latency: The latency of a ThreadBridge crossing.
+        """
+        self.channel_bridge = [
+            ThreadBridge(
+                eventq_index=first_eventq_index + i, delay=crossing_latency
+            )
+            for i in range(self._num_channels)
+        ]
+        for ctrl, bridge in zip(self.mem_ctrl, self.channel_bridge):
+            ctrl.eventq_index = bridge.eventq_index
+            bridge.out_port = ctrl.port
+        self._parallel_channels = True
+
+    def _get_ctrl_port(self, channel: int) -> Port:
+        """Get the port requests for a channel have to be sent to."""
+        if self._parallel_channels:
+            return self.channel_bridge[channel].in_port
+        return self.mem_ctrl[channel].port
+
     @overrides(AbstractMemorySystem)
     def get_mem_ports(self) -> Sequence[Tuple[AddrRange, Port]]:
-        return [(ctrl.dram.range, ctrl.port) for ctrl in self.mem_ctrl]
+        return [
+            (ctrl.dram.range, self._get_ctrl_port(i))
+            for i, ctrl in enumerate(self.mem_ctrl)
+        ]
 
     @overrides(AbstractMemorySystem)
     def get_memory_controllers(self) -> List[MemCtrl]:
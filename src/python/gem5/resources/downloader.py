@@ -32,6 +32,7 @@ import tarfile
 import time
 import urllib.parse
 import urllib.request
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
 from typing import (
     Dict,
@@ -52,16 +53,221 @@ from ..utils.socks_ssl_context import get_proxy_context
 from .client import get_resource_json_obj
 from .client import list_resources as client_list_resources
 from .md5_utils import (
-    md5_dir,
-    md5_file,
+    md5_cached,
+    record_md5,
 )
 
 """
 This Python module contains functions used to download, list, and obtain
 information about resources from resources.gem5.org.
+
+The md5 of a resource present locally is only computed again if its size,
+modification time or inode changed since it was last verified. If the
+``GEM5_RESOURCE_CACHE`` environment variable is set to a directory, verified
+resources are also stored there by md5, and every resource directory on the
+host obtains them from it (via a hard link when possible) instead of
+downloading them again.
 """
 
 
+def _resource_cache_dir() -> Optional[Path]:
+    """Returns the content-addressed resource cache, if one is set."""
+    cache = os.getenv("GEM5_RESOURCE_CACHE")
+    return Path(cache) if cache else None
+
+
+def _link_or_copy(src: Path, dst: Path) -> None:
+    """Hard link ``src`` (a file or directory tree) to ``dst``, falling back
+    to a copy if ``src`` is on another filesystem."""
+
+    def link(s, d):
+        try:
+            os.link(s, d)
+        except OSError:
+            shutil.copy2(s, d)
+
+    if src.is_dir():
+        shutil.copytree(src, dst, copy_function=link)
+    else:
+        link(src, dst)
+
+
+def _get_from_cache(to_path: Path, md5sum: str, quiet: bool) -> bool:
+    """
+    Obtain the resource with md5 ``md5sum`` from the resource cache.
+
+    :returns: ``True`` if the resource was in the cache.
+    """
+    cache = _resource_cache_dir()
+    if not cache:
+        return False
+    entry = cache / md5sum
+    if not entry.exists():
+        return False
+    if md5_cached(entry) != md5sum:
+        # The entry was corrupted (e.g., written through a hard link). It
+        # will be replaced by the download.
+        if entry.is_dir():
+            shutil.rmtree(entry, ignore_errors=True)
+        else:
+            os.remove(entry)
+        return False
+    if not quiet:
+        print(f"Obtaining '{to_path}' from the resource cache '{cache}'.")
+    _link_or_copy(entry, to_path)
+    record_md5(to_path, md5sum)
+    return True
+
+
+def _add_to_cache(to_path: Path, md5sum: str) -> None:
+    """Insert a downloaded resource into the resource cache, if it has the
+    expected md5."""
+    cache = _resource_cache_dir()
+    if not cache or (cache / md5sum).exists():
+        return
+    if md5_cached(to_path) != md5sum:
+        return
+    cache.mkdir(parents=True, exist_ok=True)
+    tmp = cache / f".{md5sum}.{os.getpid()}"
+    try:
+        _link_or_copy(to_path, tmp)
+        os.rename(tmp, cache / md5sum)
+        record_md5(cache / md5sum, md5sum)
+    except OSError:
+        # Another process inserted the same resource first.
+        if tmp.is_dir():
+            shutil.rmtree(tmp, ignore_errors=True)
+        elif tmp.exists():
+            os.remove(tmp)
+
+
+# Files smaller than this are downloaded in a single request.
+_PARALLEL_DOWNLOAD_MIN_SIZE = 64 * 1024 * 1024
+_PARALLEL_DOWNLOAD_CHUNK_SIZE = 16 * 1024 * 1024
+
+
+def _download_threads() -> int:
+    """The number of connections used to download a large file, set with
+    the ``GEM5_RESOURCE_DOWNLOAD_THREADS`` environment variable."""
+    threads = os.getenv("GEM5_RESOURCE_DOWNLOAD_THREADS")
+    if threads:
+        return max(1, int(threads))
+    return min(8, os.cpu_count() or 1)
+
+
+def _retry(action, max_attempts: int):
+    """
+    Run ``action`` until it succeeds, retrying with a Truncated Exponential
+    Backoff algorithm if it fails with a retryable HTTP status code (408,
+    429, or 5xx) or with a connection reset.
+    """
+    attempt = 0
+    while True:
+        try:
+            return action()
+        except HTTPError as e:
+            if not (e.code in (408, 429) or 500 <= e.code < 600):
+                raise e
+            attempt += 1
+            if attempt >= max_attempts:
+                raise Exception(
+                    f"After {attempt} attempts, the resource could not be "
+                    f"retrieved. HTTP Status Code retrieved: {e.code}"
+                )
+        except ConnectionResetError as e:
+            if e.errno != 104:
+                raise e
+            attempt += 1
+            if attempt >= max_attempts:
+                raise Exception(
+                    f"After {attempt} attempts, the resource could not be "
+                    f"retrieved. OS Error Code retrieved: {e.errno}"
+                )
+        time.sleep((2**attempt) + random.uniform(0, 1))
+
+
+def _download_parallel(
+    url: str, download_to: str, threads: int, max_attempts: int = 6
+) -> bool:
+    """
+    Downloads a large file as chunks fetched in parallel by ``threads``
+    connections, if the server supports range requests.
+
+    :returns: ``False`` if the file was not downloaded because the server
+              doesn't support range requests or the file is small.
+    """
+    if threads < 2 or get_proxy_context():
+        return False
+
+    def head():
+        request = urllib.request.Request(url, method="HEAD")
+        with urllib.request.urlopen(request) as response:
+            return (
+                response.headers.get("Accept-Ranges", "").lower(),
+                int(response.headers.get("Content-Length", 0)),
+            )
+
+    try:
+        accept_ranges, size = _retry(head, max_attempts)
+    except Exception:
+        # Let the single request download report the error, if any.
+        return False
+    if accept_ranges != "bytes" or size < _PARALLEL_DOWNLOAD_MIN_SIZE:
+        return False
+
+    chunks = [
+        (start, min(start + _PARALLEL_DOWNLOAD_CHUNK_SIZE, size) - 1)
+        for start in range(0, size, _PARALLEL_DOWNLOAD_CHUNK_SIZE)
+    ]
+
+    with open(download_to, "wb") as f, tqdm(
+        unit="B",
+        unit_scale=True,
+        unit_divisor=1024,
+        miniters=1,
+        total=size,
+        desc=f"Downloading {download_to}",
+    ) as t:
+        f.truncate(size)
+        fd = f.fileno()
+        # `t` is `None` if tqdm is not installed.
+        progress = t.update if t is not None else lambda n: None
+
+        def fetch(chunk):
+            first, last = chunk
+            request = urllib.request.Request(
+                url, headers={"Range": f"bytes={first}-{last}"}
+            )
+            with urllib.request.urlopen(request) as response:
+                if response.status != 206:
+                    raise Exception(
+                        f"Expected a partial response for '{url}', got "
+                        f"HTTP Status Code {response.status}."
+                    )
+                offset = first
+                while offset <= last:
+                    data = response.read(
+                        min(1024 * 1024, last - offset + 1)
+                    )
+                    if not data:
+                        raise ConnectionResetError(
+                            104, "Connection closed mid chunk"
+                        )
+                    os.pwrite(fd, data, offset)
+                    offset += len(data)
+                    progress(len(data))
+
+        with ThreadPoolExecutor(max_workers=threads) as executor:
+            # Consume the results so that the first exception is raised.
+            list(
+                executor.map(
+                    lambda chunk: _retry(lambda: fetch(chunk), max_attempts),
+                    chunks,
+                )
+            )
+    return True
+
+
 def _download(url: str, download_to: str, max_attempts: int = 6) -> None:
     """
     Downloads a file.
@@ -81,6 +287,9 @@ def _download(url: str, download_to: str, max_attempts: int = 6) -> None:
     # TODO: This whole setup will only work for single files we can get via
     # wget. We also need to support git clones going forward.
 
+    if _download_parallel(url, download_to, _download_threads(), max_attempts):
+        return
+
     attempt = 0
     while True:
         # The loop will be broken on a successful download, via a `return`, or
@@ -256,10 +465,7 @@ def get_resource(
         )
 
         if os.path.exists(to_path):
-            if os.path.isfile(to_path):
-                md5 = md5_file(Path(to_path))
-            else:
-                md5 = md5_dir(Path(to_path))
+            md5 = md5_cached(Path(to_path))
 
             if md5 == resource_json["md5sum"]:
                 # In this case, the file has already been download, no need to
@@ -276,6 +482,9 @@ def get_resource(
                     "its md5 value is invalid.".format(to_path)
                 )
 
+        if _get_from_cache(Path(to_path), resource_json["md5sum"], quiet):
+            return
+
         download_dest = to_path
 
         # This if-statement is remain backwards compatable with the older,
@@ -388,6 +597,8 @@ def get_resource(
                 safe_extract(f, unpack_to)
             os.remove(download_dest)
 
+        _add_to_cache(Path(to_path), resource_json["md5sum"])
+
 
 def _file_uri_to_path(uri: str) -> Optional[Path]:
     """
@@ -26,8 +26,17 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 import hashlib
+import json
+import os
 from pathlib import Path
-from typing import Type
+from typing import (
+    Optional,
+    Type,
+)
+
+# Reading large chunks keeps the per-read overhead negligible next to the
+# hashing itself when hashing multi-GB disk images.
+_CHUNK_SIZE = 1024 * 1024
 
 
 def _md5_update_from_file(
@@ -50,7 +59,10 @@ def _md5_update_from_file(
         desc=f"Computing md5sum on {filename}",
         total=filename.stat().st_size,
     ) as f:
-        for chunk in iter(lambda: f.read(4096), b""):
+        if hasattr(os, "posix_fadvise"):
+            # Let the kernel read ahead while the previous chunk is hashed.
+            os.posix_fadvise(f.fileno(), 0, 0, os.POSIX_FADV_SEQUENTIAL)
+        for chunk in iter(lambda: f.read(_CHUNK_SIZE), b""):
             hash.update(chunk)
     return hash
 
@@ -105,3 +117,86 @@ def md5_dir(directory: Path) -> str:
         if empty files are included or filenames are changed.
     """
     return str(_md5_update_from_dir(directory, hashlib.md5()).hexdigest())
+
+
+def _memo_path(path: Path) -> Path:
+    """The file the md5 of ``path`` is memoized in. It is next to ``path``
+    rather than inside it, so that it doesn't change the md5 of a
+    directory."""
+    return path.parent / f"{path.name}.md5"
+
+
+def _stat_signature(path: Path) -> str:
+    """
+    Returns a string which changes whenever the contents of ``path`` are
+    likely to have changed: the size, modification time and inode of the
+    file, or of every file and directory under the directory.
+    """
+
+    def signature(p: Path) -> str:
+        st = p.stat()
+        return f"{st.st_dev}:{st.st_ino}:{st.st_size}:{st.st_mtime_ns}"
+
+    if path.is_file():
+        return signature(path)
+    hash = hashlib.md5(signature(path).encode())
+    for root, dirs, files in os.walk(path):
+        dirs.sort()
+        for name in sorted(files) + dirs:
+            p = Path(root) / name
+            hash.update(f"{p.relative_to(path)}={signature(p)}".encode())
+    return hash.hexdigest()
+
+
+def record_md5(path: Path, md5_value: Optional[str] = None) -> Optional[str]:
+    """
+    Memoize the md5 of a file or directory against its current stat
+    signature, so that ``md5_cached`` doesn't have to hash it again.
+
+    :param path: The file or directory.
+    :param md5_value: The md5 of ``path`` if already known (e.g., it was
+                      verified through another path to the same inode). It
+                      is computed otherwise.
+
+    :returns: The md5 of ``path``.
+    """
+    path = Path(path)
+    signature = _stat_signature(path)
+    if md5_value is None:
+        md5_value = md5(path)
+    memo = _memo_path(path)
+    tmp = memo.parent / f".{memo.name}.{os.getpid()}"
+    try:
+        with open(tmp, "w") as f:
+            json.dump({"signature": signature, "md5": md5_value}, f)
+        os.replace(tmp, memo)
+    except OSError:
+        # Memoization is only an optimization, e.g., the directory may be
+        # read-only.
+        try:
+            os.remove(tmp)
+        except OSError:
+            pass
+    return md5_value
+
+
+def md5_cached(path: Path) -> str:
+    """
+    Gets the md5 value of a file or directory like ``md5``, but only hashes
+    the contents if they changed (according to their size, modification time
+    and inode) since the last time ``md5_cached`` or ``record_md5`` was
+    called on ``path``.
+
+    :param path: The path to get the md5 of.
+    """
+    path = Path(path)
+    if not path.is_file() and not path.is_dir():
+        raise Exception(f"Path '{path}' is not a valid file or directory.")
+    try:
+        with open(_memo_path(path)) as f:
+            memo = json.load(f)
+        if memo["signature"] == _stat_signature(path):
+            return memo["md5"]
+    except (OSError, ValueError, KeyError, TypeError):
+        pass
+    return record_md5(path)
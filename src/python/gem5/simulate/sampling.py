@@ -0,0 +1,283 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Periodic sampling (as in SMARTS) within a single simulation.
+
+The simulation alternates between three phases on a fixed schedule,
+counted in instructions committed by the first core:
+
+    * FUNCTIONAL: fast-forward on the starting cores of a
+      ``SimpleSwitchableProcessor`` (typically atomic, which also warms
+      the caches, or KVM).
+    * WARMUP: run on the detailed cores to warm up the pipeline and
+      predictors before measuring.
+    * MEASURE: run on the detailed cores with fresh statistics.
+
+Each measurement is dumped as its own block of statistics. The CPI of
+every sample is recorded and summarized as a mean with a confidence
+interval.
+
+.. code-block::
+
+    processor = SimpleSwitchableProcessor(
+        starting_core_type=CPUTypes.ATOMIC,
+        switch_core_type=CPUTypes.O3,
+        isa=ISA.X86,
+        num_cores=1,
+    )
+    ...
+    simulator = Simulator(board=board)
+    sampler = PeriodicSampler(
+        processor=processor,
+        period=10_000_000,
+        detailed_warmup=20_000,
+        measurement=1_000,
+    )
+    simulator.schedule_sampling(sampler)
+    simulator.run()
+    print(sampler.get_summary())
+"""
+
+import json
+import math
+import statistics
+from enum import Enum
+from pathlib import Path
+from typing import (
+    Callable,
+    Dict,
+    Generator,
+    List,
+    Optional,
+)
+
+import m5
+from m5.util import warn
+
+from ..components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+
+
+class SamplingPhase(Enum):
+    FUNCTIONAL = "functional"
+    WARMUP = "warmup"
+    MEASURE = "measure"
+
+
+def summarize(values: List[float], confidence: float) -> Dict:
+    """
+    Summarize a list of per-sample measurements as their mean and the
+    half-width of the confidence interval around it, assuming the sample
+    means are normally distributed.
+
+    :param values: The per-sample measurements.
+    :param confidence: The confidence level, in (0, 1).
+    """
+    if not 0 < confidence < 1:
+        raise ValueError("The confidence level must be in (0, 1).")
+
+    n = len(values)
+    summary = {"samples": n, "confidence": confidence}
+    if n == 0:
+        return summary
+
+    mean = statistics.fmean(values)
+    summary["mean"] = mean
+    if n < 2:
+        return summary
+
+    stdev = statistics.stdev(values)
+    z = statistics.NormalDist().inv_cdf((1 + confidence) / 2)
+    half_width = z * stdev / math.sqrt(n)
+    summary["stdev"] = stdev
+    summary["interval"] = half_width
+    summary["relative_error"] = half_width / mean if mean else math.inf
+    return summary
+
+
+class PeriodicSampler:
+    """
+    Drives a periodic sampling schedule through ``MAX_INSTS`` exit events.
+    Use ``Simulator.schedule_sampling`` to attach it to a simulation.
+    """
+
+    def __init__(
+        self,
+        processor: SimpleSwitchableProcessor,
+        period: int,
+        measurement: int,
+        detailed_warmup: int = 0,
+        max_samples: Optional[int] = None,
+        confidence: float = 0.997,
+        output: Optional[Path] = Path("sampling.json"),
+    ) -> None:
+        """
+        :param processor: The processor to sample. Its starting cores are
+                          used for fast-forwarding and its switch cores for
+                          detailed warmup and measurement. It must not have
+                          been switched before the sampling starts.
+        :param period: The number of instructions from the start of one
+                       sample to the start of the next.
+        :param measurement: The number of instructions measured in each
+                            sample.
+        :param detailed_warmup: The number of instructions run on the
+                                detailed cores before each measurement.
+        :param max_samples: Stop sampling and fast-forward to the end of
+                            the workload after this many samples. If not
+                            set, sampling continues until the workload
+                            exits.
+        :param confidence: The confidence level of the reported interval.
+        :param output: A JSON file, relative to the output directory, that
+                       is updated with the results after every sample. No
+                       file is written if ``None``.
+        """
+        if not isinstance(processor, SimpleSwitchableProcessor):
+            raise TypeError("Sampling requires a SimpleSwitchableProcessor.")
+        if measurement <= 0:
+            raise ValueError("The measurement can't be empty.")
+        if detailed_warmup < 0:
+            raise ValueError("The detailed warmup can't be negative.")
+        if period <= detailed_warmup + measurement:
+            raise ValueError(
+                "The period must be longer than the detailed warmup and "
+                "measurement together."
+            )
+        if processor.get_num_cores() > 1:
+            warn(
+                "The sampling schedule is counted on the first core only. "
+                "The other cores are switched with it."
+            )
+
+        self._processor = processor
+        self._period = period
+        self._measurement = measurement
+        self._detailed_warmup = detailed_warmup
+        self._max_samples = max_samples
+        self._confidence = confidence
+        self._output = output
+
+        self._phase = SamplingPhase.FUNCTIONAL
+        self._samples = []
+        self._measure_start = 0
+        self._done = False
+
+    def get_phase(self) -> SamplingPhase:
+        """Get the phase the simulation is currently in."""
+        return self._phase
+
+    def get_samples(self) -> List[Dict]:
+        """Get the measurements of all samples taken so far."""
+        return list(self._samples)
+
+    def get_summary(self) -> Dict:
+        """Get the mean CPI and its confidence interval."""
+        return summarize(
+            [sample["cpi"] for sample in self._samples], self._confidence
+        )
+
+    def _functional_length(self) -> int:
+        return self._period - self._detailed_warmup - self._measurement
+
+    def _schedule(self, insts: int, instantiated: bool) -> None:
+        # The core's instruction stop is relative to its current count.
+        core = self._processor.get_cores()[0]
+        core._set_inst_stop_any_thread(insts, instantiated)
+
+    def _start(self, instantiated: bool) -> None:
+        """Schedule the end of the first fast-forward."""
+        self._schedule(self._functional_length(), instantiated)
+
+    def _write_output(self) -> None:
+        if self._output is None:
+            return
+        path = Path(m5.options.outdir) / self._output
+        with open(path, "w") as f:
+            json.dump(
+                {
+                    "period": self._period,
+                    "detailed_warmup": self._detailed_warmup,
+                    "measurement": self._measurement,
+                    "summary": self.get_summary(),
+                    "samples": self._samples,
+                },
+                f,
+                indent=2,
+            )
+
+    def _handler(
+        self, clock_period: Callable[[], int]
+    ) -> Generator[bool, None, None]:
+        """
+        The ``MAX_INSTS`` exit event handler implementing the schedule.
+
+        :param clock_period: Returns the clock period of the detailed
+                             cores, in ticks.
+        """
+        while True:
+            if self._done:
+                # Sampling is over, the workload runs to completion.
+                pass
+            elif self._phase == SamplingPhase.FUNCTIONAL:
+                self._processor.switch()
+                if self._detailed_warmup:
+                    self._phase = SamplingPhase.WARMUP
+                    self._schedule(self._detailed_warmup, True)
+                else:
+                    self._phase = SamplingPhase.MEASURE
+                    self._measure_start = m5.curTick()
+                    m5.stats.reset()
+                    self._schedule(self._measurement, True)
+            elif self._phase == SamplingPhase.WARMUP:
+                self._phase = SamplingPhase.MEASURE
+                self._measure_start = m5.curTick()
+                m5.stats.reset()
+                self._schedule(self._measurement, True)
+            else:
+                m5.stats.dump()
+                ticks = m5.curTick() - self._measure_start
+                cycles = ticks / clock_period()
+                self._samples.append(
+                    {
+                        "start_tick": self._measure_start,
+                        "ticks": ticks,
+                        "insts": self._measurement,
+                        "cycles": cycles,
+                        "cpi": cycles / self._measurement,
+                    }
+                )
+                self._write_output()
+
+                self._processor.switch()
+                self._phase = SamplingPhase.FUNCTIONAL
+                self._done = (
+                    self._max_samples is not None
+                    and len(self._samples) >= self._max_samples
+                )
+                if not self._done:
+                    self._start(True)
+            yield False
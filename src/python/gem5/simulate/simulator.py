@@ -58,6 +58,7 @@ from .exit_event_generators import (
     switch_generator,
     warn_default_decorator,
 )
+from .sampling import PeriodicSampler
 
 
 class Simulator:
@@ -371,6 +372,7 @@ class Simulator:
             self._on_exit_event = self._default_on_exit_dict
 
         self._instantiated = False
+        self._state_deferred = False
         self._board = board
         self._full_system = full_system
         self._expected_execution_order = expected_execution_order
@@ -469,6 +471,24 @@ class Simulator:
             simpoint_start_insts, self._instantiated
         )
 
+    def schedule_sampling(self, sampler: PeriodicSampler) -> None:
+        """
+        Run the simulation under a periodic sampling schedule. The sampler
+        takes over the ``MAX_INSTS`` exit event, so that event can't be
+        used for anything else in this simulation.
+
+        :param sampler: The sampling schedule to follow.
+        """
+        # Don't modify the defaults, they are the fallback once a user
+        # generator is exhausted.
+        if self._on_exit_event is self._default_on_exit_dict:
+            self._on_exit_event = dict(self._default_on_exit_dict)
+        # The clock period in ticks is only known after instantiation.
+        self._on_exit_event[ExitEvent.MAX_INSTS] = sampler._handler(
+            lambda: self._board.get_clock_domain().clock[0].getValue()
+        )
+        sampler._start(self._instantiated)
+
     def schedule_max_insts(self, inst: int) -> None:
         """
         Schedule a ``MAX_INSTS`` exit event when any thread in any core
@@ -628,13 +648,22 @@ class Simulator:
         options.outdir = str(new_outdir)
         setOutputDir(options.outdir)
 
-    def _instantiate(self) -> None:
+    def _instantiate(self, defer_state: bool = False) -> None:
         """
         This method will instantiate the board and carry out necessary
         boilerplate code before the instantiation such as setting up root and
         setting the sim_quantum (if running in KVM mode).
+
+        :param defer_state: Create and initialize the objects, but don't
+                            initialize their state or restore a checkpoint
+                            until ``restore_checkpoint`` is called.
         """
 
+        if self._state_deferred:
+            if not defer_state:
+                self.restore_checkpoint(None)
+            return
+
         if not self._instantiated:
             # Before anything else we run the AbstractBoard's
             # `_pre_instantiate` function.
@@ -676,6 +705,11 @@ class Simulator:
                 m5.ticks.fixGlobalFrequency()
                 root.sim_quantum = m5.ticks.fromSeconds(0.001)
 
+            if defer_state:
+                m5.instantiate(defer_state=True)
+                self._state_deferred = True
+                return
+
             # m5.instantiate() takes a parameter specifying the path to the
             # checkpoint directory. If the parameter is None, no checkpoint
             # will be restored.
@@ -689,6 +723,30 @@ class Simulator:
             # any final things.
             self._board._post_instantiate()
 
+    def restore_checkpoint(self, checkpoint_dir: Optional[Path]) -> None:
+        """
+        Finish a deferred instantiation by restoring a checkpoint into the
+        already created objects.
+
+        :param checkpoint_dir: The checkpoint to restore. If ``None``, the
+                               board's checkpoint (if any) is restored.
+        """
+        if not self._state_deferred:
+            raise Exception(
+                "The simulation state can only be restored after a deferred "
+                "instantiation."
+            )
+
+        if checkpoint_dir is None:
+            checkpoint_dir = self._board._checkpoint or self._checkpoint_path
+
+        m5.restore_state(
+            Path(checkpoint_dir).as_posix() if checkpoint_dir else None
+        )
+        self._state_deferred = False
+        self._instantiated = True
+        self._board._post_instantiate()
+
     def run(self, max_ticks: Optional[int] = None) -> None:
         """
         This function will start or continue the simulator run and handle exit
@@ -782,3 +840,126 @@ class Simulator:
                                will be saved.
         """
         m5.checkpoint(str(checkpoint_dir))
+
+    def fork_sweep(
+        self,
+        configurations: Dict[str, Callable[[AbstractBoard], None]],
+        run: Optional[Callable[["Simulator"], None]] = None,
+        max_parallel: Optional[int] = None,
+    ) -> Dict[str, Optional[Dict]]:
+        """
+        Fork the simulation once per configuration so that every
+        configuration continues from the current, warmed up, state.
+
+        This is meant to be called once the simulation has been warmed up
+        (e.g., after ``run()`` returned on the exit event marking the end
+        of the warmup). Each child process gets the current state of the
+        simulated system copy-on-write, applies its configuration, resets
+        the statistics and continues the simulation. This avoids simulating
+        the warmup again for every design point.
+
+        A configuration is a function called with the board in the child.
+        It may only make changes that take effect at run time, as the
+        system has already been instantiated. For example, switching the
+        cores of a ``SwitchableProcessor`` with ``switch()``, or calling
+        the setters the SimObjects expose to Python. Changing parameters of
+        instantiated SimObjects has no effect.
+
+        Every child writes its output (including its own ``stats.txt``,
+        dumped when it exits) to a sub-directory of the output directory
+        named after its configuration, and its final statistics to
+        ``sweep_stats.json`` in there.
+
+        .. note::
+
+            Forking requires the simulator listeners to be disabled (see
+            ``m5.disableAllListeners()``).
+
+        :param configurations: The functions applying each configuration,
+                               keyed by the name of the configuration.
+        :param run: The function continuing the simulation in a child. By
+                    default ``run()`` is called, which handles the exit
+                    events as set up for this simulator.
+        :param max_parallel: The maximum number of children running at the
+                             same time. Defaults to the number of host CPUs.
+
+        :returns: The statistics of every configuration, as returned by
+                  ``get_stats()``, keyed by the name of the configuration.
+                  The statistics are None if the child failed.
+        """
+        import json
+
+        if not self._instantiated:
+            raise Exception(
+                "The simulation must be instantiated and warmed up before "
+                "it can be forked."
+            )
+        for name in configurations:
+            if not name or os.sep in name or "%" in name:
+                raise ValueError(f"Invalid configuration name '{name}'")
+
+        if max_parallel is None:
+            max_parallel = os.cpu_count() or 1
+        max_parallel = max(max_parallel, 1)
+
+        outdirs = {}
+        running = {}
+        failed = set()
+
+        def wait_one():
+            pid, status = os.wait()
+            name = running.pop(pid, None)
+            if name is not None and (
+                not os.WIFEXITED(status) or os.WEXITSTATUS(status) != 0
+            ):
+                warn(f"Sweep configuration '{name}' failed.")
+                failed.add(name)
+
+        for name, configure in configurations.items():
+            while len(running) >= max_parallel:
+                wait_one()
+
+            outdirs[name] = os.path.join(m5.options.outdir, name)
+            pid = m5.fork(simout=os.path.join("%(parent)s", name))
+            if pid == 0:
+                # Never return to the sweep in the child, whatever happens
+                status = 1
+                try:
+                    configure(self._board)
+                    m5.stats.reset()
+                    if run:
+                        run(self)
+                    else:
+                        self.run()
+                    with open(
+                        os.path.join(m5.options.outdir, "sweep_stats.json"),
+                        "w",
+                    ) as f:
+                        json.dump(self.get_stats(), f)
+                    status = 0
+                except BaseException:
+                    import traceback
+
+                    traceback.print_exc()
+                finally:
+                    # Exit like gem5 normally does (the exit handlers dump
+                    # the stats), without unwinding the parent's script
+                    import atexit
+
+                    atexit._run_exitfuncs()
+                    sys.stdout.flush()
+                    sys.stderr.flush()
+                    os._exit(status)
+            running[pid] = name
+
+        while running:
+            wait_one()
+
+        results = {}
+        for name, outdir in outdirs.items():
+            results[name] = None
+            if name in failed:
+                continue
+            with open(os.path.join(outdir, "sweep_stats.json")) as f:
+                results[name] = json.load(f)
+        return results
@@ -0,0 +1,183 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+In-memory snapshots of a running simulation, for rewinding.
+
+A snapshot is a forked copy of the simulator that is parked until it is
+either restored or discarded. Forking is cheap: the guest memory and the
+simulator state are shared copy-on-write with the running simulation, so
+snapshots can be taken frequently while fast-forwarding (e.g., on KVM).
+When an interesting point has been found, an earlier snapshot is restored
+and continues, typically after switching to a detailed CPU, from exactly
+where it was taken. Nothing is written to disk.
+
+.. code-block::
+
+    snapshots = SnapshotManager(max_snapshots=16)
+    while True:
+        simulator.run()  # E.g., exits every N instructions on KVM.
+        if snapshots.take():
+            # Only reached in a restored snapshot.
+            processor.switch()
+            simulator.run()
+            sys.exit(0)
+        if found_interesting_region():
+            break
+    snapshots.restore(snapshots.get_snapshots()[-2])
+
+Snapshots rely on ``m5.fork``. Therefore the simulator's listeners must
+be disabled (``m5.disableAllListeners()``) before instantiation.
+Restored snapshots can't run on KVM, as the KVM VM belongs to the
+process that created it. Switch to another CPU type before continuing.
+The memory backing store must not be shared
+(``System.shared_backstore``). Otherwise the snapshots would see the
+memory changes made after they were taken.
+"""
+
+import os
+import sys
+from collections import OrderedDict
+from typing import (
+    List,
+    Optional,
+)
+
+import m5
+
+
+class Snapshot:
+    """A parked copy of the simulator."""
+
+    def __init__(self, pid: int, tick: int, control_fd: int) -> None:
+        self.pid = pid
+        self.tick = tick
+        self._control_fd = control_fd
+
+    def __repr__(self) -> str:
+        return f"Snapshot(pid={self.pid}, tick={self.tick})"
+
+
+class SnapshotManager:
+    """Takes, restores and discards in-memory snapshots."""
+
+    def __init__(
+        self,
+        max_snapshots: Optional[int] = None,
+        outdir: str = "%(parent)s/snapshot.%(tick)i",
+    ) -> None:
+        """
+        :param max_snapshots: The number of snapshots to keep. When a new
+                              snapshot would exceed it, the oldest one is
+                              discarded. If ``None``, snapshots are kept
+                              until they are discarded explicitly.
+        :param outdir: The output directory of a restored snapshot. Besides
+                       the keys supported by ``m5.fork`` it may contain
+                       ``%(tick)i``, the tick the snapshot was taken at.
+        """
+        if max_snapshots is not None and max_snapshots < 1:
+            raise ValueError("At least one snapshot must be kept.")
+
+        self._max_snapshots = max_snapshots
+        self._outdir = outdir
+        self._snapshots = OrderedDict()
+
+    def get_snapshots(self) -> List[Snapshot]:
+        """Get the live snapshots, oldest first."""
+        return list(self._snapshots.values())
+
+    def take(self) -> bool:
+        """
+        Snapshot the simulation at the current tick.
+
+        :returns: ``False`` in the running simulation. ``True`` when
+                  returning in a snapshot that has been restored.
+        """
+        if self._max_snapshots is not None:
+            while len(self._snapshots) >= self._max_snapshots:
+                self.discard(next(iter(self._snapshots.values())))
+
+        tick = m5.curTick()
+        read_fd, write_fd = os.pipe()
+        sys.stdout.flush()
+        sys.stderr.flush()
+        pid = m5.fork(self._outdir.replace("%(tick)i", str(tick)))
+
+        if pid != 0:
+            os.close(read_fd)
+            snapshot = Snapshot(pid, tick, write_fd)
+            self._snapshots[pid] = snapshot
+            return False
+
+        # In the snapshot: drop the control channels of the other
+        # snapshots so that they see the parent exit, then park until
+        # we're told what to do.
+        os.close(write_fd)
+        for other in self._snapshots.values():
+            os.close(other._control_fd)
+        self._snapshots.clear()
+
+        command = os.read(read_fd, 1)
+        os.close(read_fd)
+        if command != b"r":
+            # Discarded, or the parent went away.
+            os._exit(0)
+        return True
+
+    def restore(self, snapshot: Snapshot, wait: bool = True) -> int:
+        """
+        Let a snapshot continue from where it was taken. The other
+        snapshots are unaffected and can be restored later as well.
+
+        :param snapshot: The snapshot to restore.
+        :param wait: Wait for the restored simulation to finish.
+
+        :returns: The exit status of the restored simulation if waiting
+                  for it, otherwise 0.
+        """
+        self._pop(snapshot)
+        os.write(snapshot._control_fd, b"r")
+        os.close(snapshot._control_fd)
+        if not wait:
+            return 0
+        _, status = os.waitpid(snapshot.pid, 0)
+        return os.waitstatus_to_exitcode(status)
+
+    def discard(self, snapshot: Snapshot) -> None:
+        """Drop a snapshot, freeing the memory only it references."""
+        self._pop(snapshot)
+        # Closing the control channel tells the snapshot to exit.
+        os.close(snapshot._control_fd)
+        os.waitpid(snapshot.pid, 0)
+
+    def discard_all(self) -> None:
+        """Drop every snapshot."""
+        for snapshot in self.get_snapshots():
+            self.discard(snapshot)
+
+    def _pop(self, snapshot: Snapshot) -> None:
+        if self._snapshots.pop(snapshot.pid, None) is None:
+            raise ValueError(f"{snapshot} is not a live snapshot.")
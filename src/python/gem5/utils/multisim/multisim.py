@@ -47,14 +47,38 @@ config script is passed as a string referencing the config script as a module.
 This script is then passed to the child processes to load.
 
 2. The config script cannot accept parameters. It must be parameterless.
+
+Scheduling
+----------
+
+Each simulator can be given an estimate of its resident memory and the
+number of host threads it uses when added with `add_simulator`. Jobs are
+then packed, largest memory first, so that the running jobs fit in the host
+memory (see `set_memory_limit`) and in the host CPUs. The larger of the
+estimate and the measured resident memory of each running job is taken into
+account. A job that doesn't fit on its own is run once nothing else is
+running.
+
+Read-only inputs don't need to be accounted for once per job. Uncompressed
+memory checkpoints (taken with `checkpoint_compress_memory = False`) and
+workload images are mapped copy-on-write, and disk images opened read-only
+(e.g., the child of a `CowDiskImage`) are read through the host page cache.
+All the jobs using them therefore share the same host pages, and only the
+pages a job writes are its own.
 """
 
 import importlib
 import multiprocessing
+import multiprocessing.connection
+import os
 from pathlib import Path
 from typing import (
+    Dict,
+    List,
     Optional,
     Set,
+    Tuple,
+    Union,
 )
 
 # A global variable which __main__.py flips to `True` when multisim is run as
@@ -69,6 +93,18 @@ _num_processes = None
 
 _multi_sim: Set["Simulator"] = set()
 
+# The estimated resident memory (in bytes, `None` if unknown) and number of
+# host threads of each simulator, by id.
+_resources: Dict[str, Tuple[Optional[int], int]] = {}
+
+# The host memory (in bytes) the jobs may use. If `None`, the host memory
+# available when the jobs are launched.
+_memory_limit: Optional[int] = None
+
+# How often (in seconds) the resident memory of the running jobs is sampled
+# while waiting for one of them to finish.
+_poll_interval = 1.0
+
 
 def _load_module(module_path: Path) -> None:
     """Load the module at the given path."""
@@ -96,7 +132,12 @@ def _get_simulator_ids_child_process(id_list, module_path: Path) -> None:
     global _multi_sim
     if len(id_list) != 0:
         id_list *= 0
-    id_list.extend([sim.get_id() for sim in _multi_sim])
+    id_list.extend(
+        [
+            (sim.get_id(),) + _resources.get(sim.get_id(), (None, 1))
+            for sim in _multi_sim
+        ]
+    )
 
 
 def _get_num_processes_child_process(
@@ -117,6 +158,24 @@ def _get_num_processes_child_process(
     _load_module(module_path)
     global _num_processes
     num_processes_dict["num_processes"] = _num_processes
+    num_processes_dict["memory_limit"] = _memory_limit
+
+
+def _get_jobs(
+    config_module_path: Path,
+) -> List[Tuple[str, Optional[int], int]]:
+    """Returns the id, the estimated resident memory and the number of
+    threads of every simulation, see `get_simulator_ids`."""
+
+    manager = multiprocessing.Manager()
+    id_list = manager.list()
+    p = multiprocessing.Process(
+        target=_get_simulator_ids_child_process,
+        args=(id_list, config_module_path),
+    )
+    p.start()
+    p.join()
+    return list(id_list)
 
 
 def get_simulator_ids(config_module_path: Path) -> list[str]:
@@ -131,18 +190,10 @@ def get_simulator_ids(config_module_path: Path) -> list[str]:
     return the ids as a set of strings.
     """
 
-    manager = multiprocessing.Manager()
-    id_list = manager.list()
-    p = multiprocessing.Process(
-        target=_get_simulator_ids_child_process,
-        args=(id_list, config_module_path),
-    )
-    p.start()
-    p.join()
-    return id_list
+    return [job[0] for job in _get_jobs(config_module_path)]
 
 
-def get_num_processes(config_module_path: Path) -> Optional[int]:
+def _get_limits(config_module_path: Path) -> Dict[str, Optional[int]]:
     manager = multiprocessing.Manager()
     num_processes_dict = manager.dict()
     p = multiprocessing.Process(
@@ -151,7 +202,96 @@ def get_num_processes(config_module_path: Path) -> Optional[int]:
     )
     p.start()
     p.join()
-    return num_processes_dict["num_processes"]
+    return dict(num_processes_dict)
+
+
+def get_num_processes(config_module_path: Path) -> Optional[int]:
+    return _get_limits(config_module_path)["num_processes"]
+
+
+def _host_memory() -> int:
+    """Returns the host memory available to new processes, in bytes."""
+    try:
+        with open("/proc/meminfo") as meminfo:
+            for line in meminfo:
+                if line.startswith("MemAvailable:"):
+                    return int(line.split()[1]) * 1024
+    except OSError:
+        pass
+    return os.sysconf("SC_PHYS_PAGES") * os.sysconf("SC_PAGE_SIZE")
+
+
+def _resident_memory(pid: int) -> Optional[int]:
+    """Returns the resident memory of a process, in bytes, if known."""
+    try:
+        with open(f"/proc/{pid}/statm") as statm:
+            return int(statm.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+    except (OSError, IndexError, ValueError):
+        return None
+
+
+def _schedule(
+    module_path: Path,
+    jobs: List[Tuple[str, Optional[int], int]],
+    max_processes: Optional[int],
+    memory_limit: Optional[int],
+) -> None:
+    """Run the jobs, packing as many as fit in the host memory and CPUs."""
+    from ..multiprocessing.context import gem5Context
+
+    context = gem5Context()
+    cpus = os.cpu_count() or 1
+    max_processes = max_processes or cpus
+    memory_limit = memory_limit or _host_memory()
+
+    # Jobs without an estimate are assumed to be as large as the largest
+    # estimate, or free if there is none.
+    default_memory = max((job[1] or 0 for job in jobs), default=0)
+    pending = sorted(
+        (
+            (id, memory or default_memory, threads)
+            for id, memory, threads in jobs
+        ),
+        key=lambda job: job[1],
+        reverse=True,
+    )
+
+    # process -> (estimated memory, threads)
+    running = {}
+
+    def memory_in_use() -> int:
+        used = 0
+        for process, (memory, _) in running.items():
+            rss = _resident_memory(process.pid)
+            used += max(memory, rss or 0)
+        return used
+
+    while pending or running:
+        used_memory = memory_in_use()
+        used_threads = sum(threads for _, threads in running.values())
+        for job in list(pending):
+            if len(running) >= max_processes:
+                break
+            id, memory, threads = job
+            fits = (
+                used_memory + memory <= memory_limit
+                and used_threads + threads <= cpus
+            )
+            if fits or not running:
+                process = context.Process(target=_run, args=(module_path, id))
+                process.start()
+                running[process] = (memory, threads)
+                pending.remove(job)
+                used_memory += memory
+                used_threads += threads
+
+        done = multiprocessing.connection.wait(
+            [process.sentinel for process in running],
+            timeout=_poll_interval,
+        )
+        for process in [p for p in running if p.sentinel in done]:
+            process.join()
+            del running[process]
 
 
 def _run(module_path: Path, id: str) -> None:
@@ -186,27 +326,26 @@ def run(module_path: Path, processes: Optional[int] = None) -> None:
         "(prior to determining number of jobs)."
     )
 
-    # Get the simulator IDs. This both provides us a list of targets
-    # and, by-proxy, the number of jobs.
-    ids = get_simulator_ids(module_path)
-    max_num_processes = get_num_processes(module_path)
+    # Get the simulator IDs and their resource estimates. This both provides
+    # us a list of targets and, by-proxy, the number of jobs.
+    jobs = _get_jobs(module_path)
+    limits = _get_limits(module_path)
 
     assert len(_multi_sim) == 0, (
         "Simulators instantiated in main thread instead of child thread "
         "(after determining number of jobs)."
     )
 
-    # Setup the multiprocessing pool. If the number of processes is not
-    # specified (i.e. `None`) the default is the number or available threads.
-    from ..multiprocessing.context import gem5Context
-
-    pool = gem5Context().Pool(processes=max_num_processes, maxtasksperchild=1)
-
-    # Use the starmap function to create N child processes each with same
-    # module path (the config script specifying all simulations using MultiSim)
-    # but a different ID. The ID is used to select the correct simulator to
-    # run.
-    pool.starmap(_run, zip([module_path for _ in range(len(ids))], tuple(ids)))
+    # Each job is run in its own child process, which loads the module (the
+    # config script specifying all simulations using MultiSim) and selects
+    # the simulator to run with its ID. If the number of processes is not
+    # specified (i.e. `None`) it is only limited by the host resources.
+    _schedule(
+        module_path,
+        jobs,
+        processes or limits["num_processes"],
+        limits["memory_limit"],
+    )
 
 
 def set_num_processes(num_processes: int) -> None:
@@ -223,12 +362,33 @@ def set_num_processes(num_processes: int) -> None:
         raise ValueError("Number of processes must be an integer.")
 
 
+def set_memory_limit(memory: Union[int, str]) -> None:
+    """Set the host memory the simulations running in parallel may use.
+
+    :param memory: The memory limit, in bytes or as a string with a unit
+                   (e.g., "200GiB"). By default, the host memory available
+                   when the simulations are launched is used.
+    """
+    from m5.util.convert import toMemorySize
+
+    global _memory_limit
+    _memory_limit = (
+        memory if isinstance(memory, int) else int(toMemorySize(memory))
+    )
+    if _memory_limit <= 0:
+        raise ValueError("The memory limit must be greater than 0.")
+
+
 def num_simulators() -> int:
     """Returns the number of simulators added to the MultiSim."""
     return len(_multi_sim)
 
 
-def add_simulator(simulator: "Simulator") -> None:
+def add_simulator(
+    simulator: "Simulator",
+    memory: Optional[Union[int, str]] = None,
+    threads: int = 1,
+) -> None:
     """Add a single simulator to the Multisim. Doing so informs the simulators
     to run this simulator via multiprocessing.
 
@@ -243,6 +403,11 @@ def add_simulator(simulator: "Simulator") -> None:
     :param id: The id of the simulator. This is used to reference the
     simulation. This is particularly important when referencing the correct
     m5out subdirectory.
+    :param memory: The estimated peak resident memory of the simulation, in
+    bytes or as a string with a unit (e.g., "8GiB"). Pages shared with the
+    other simulations (see the module documentation) can be left out.
+    :param threads: The number of host threads the simulation uses (e.g.,
+    with a parallel event queue or KVM cores).
     """
 
     global _multi_sim
@@ -253,6 +418,14 @@ def add_simulator(simulator: "Simulator") -> None:
         simulator.set_id(f"sim_{len(_multi_sim)}")
     _multi_sim.add(simulator)
 
+    if threads < 1:
+        raise ValueError("Number of threads must be greater than 0.")
+    if isinstance(memory, str):
+        from m5.util.convert import toMemorySize
+
+        memory = int(toMemorySize(memory))
+    _resources[simulator.get_id()] = (memory, threads)
+
     # The following code is used to enable a user to run a single simulation
     # from the config script, based on an ID, in the case the config script is
     # passed a traditional gem5 config and not via the multisim module.
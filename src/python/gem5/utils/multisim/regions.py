@@ -0,0 +1,447 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Run the regions of a SimPoint or LoopPoint checkpoint set in parallel
+from a single configuration.
+
+Unlike ``multisim.run``, which loads the configuration script in every
+child process, the simulation is built and instantiated once. The
+process then forks one child per region. Each child only restores its
+region's checkpoint into the copy-on-write image of the parent, runs the
+warmup and the region, and reports its measurements back. The parent
+aggregates the regions into a weighted CPI.
+
+.. code-block::
+
+    from gem5.utils.multisim.regions import run_regions
+
+    simulator = Simulator(board=board)
+    results = run_regions(
+        simulator,
+        checkpoints=[Path(f"cpts/cpt.{i}") for i in range(4)],
+        weights=simpoint.get_weight_list(),
+        region_insts=simpoint.get_simpoint_interval(),
+        warmup_insts=simpoint.get_warmup_list(),
+    )
+    print(results["weighted_cpi"])
+
+LoopPoint regions are delimited by PC counts instead of instruction
+counts. Take their checkpoints in one pass with
+``looppoint_save_checkpoint_generator`` and write the LoopPoint JSON file,
+which records the counts relative to each checkpoint. Then run all the
+regions and extrapolate the whole application from their multipliers:
+
+.. code-block::
+
+    from gem5.utils.multisim.regions import run_looppoint_regions
+
+    simulator = Simulator(board=board)
+    results = run_looppoint_regions(
+        simulator,
+        looppoint=LooppointJsonLoader("m5out/looppoint.json"),
+        checkpoint_dir=Path("looppoint_checkpoints_folder"),
+    )
+    print(results["extrapolated_ticks"])
+"""
+
+import json
+import os
+import sys
+from pathlib import Path
+from typing import (
+    Callable,
+    Dict,
+    List,
+    Optional,
+    Union,
+)
+
+import m5
+from m5.core import setOutputDir
+from m5.objects import Root
+from m5.params import PcCountPair
+from m5.simulate import notifyFork
+
+from ...resources.looppoint import Looppoint
+from ...simulate.exit_event import ExitEvent
+from ...simulate.simulator import Simulator
+
+
+def _run_region(
+    simulator: Simulator,
+    checkpoint: Path,
+    region_insts: int,
+    warmup_insts: int,
+) -> Dict:
+    """Restore a region's checkpoint and measure it. Runs in the child."""
+    simulator.restore_checkpoint(checkpoint)
+
+    board = simulator._board
+    result = {"checkpoint": str(checkpoint), "insts": region_insts}
+    start = {}
+
+    def begin_region():
+        m5.stats.reset()
+        start["tick"] = m5.curTick()
+        simulator.schedule_max_insts(region_insts)
+
+    def on_max_insts():
+        if "tick" not in start:
+            # End of the warmup
+            begin_region()
+            yield False
+        m5.stats.dump()
+        ticks = m5.curTick() - start["tick"]
+        cycles = ticks / board.get_clock_domain().clock[0].getValue()
+        result["cycles"] = cycles
+        result["cpi"] = cycles / region_insts
+        result["ticks"] = ticks
+        yield True
+
+    simulator._on_exit_event = dict(simulator._on_exit_event)
+    simulator._on_exit_event[ExitEvent.MAX_INSTS] = on_max_insts()
+
+    if warmup_insts > 0:
+        simulator.schedule_max_insts(warmup_insts)
+    else:
+        begin_region()
+
+    simulator.run()
+    result["exit_cause"] = simulator.get_last_exit_event_cause()
+    return result
+
+
+def _run_looppoint_region(
+    simulator: Simulator,
+    looppoint: Looppoint,
+    region_id: Union[int, str],
+    checkpoint: Path,
+) -> Dict:
+    """Restore a LoopPoint region's checkpoint and measure it. Runs in the
+    child."""
+    region = looppoint.get_regions()[region_id]
+    simulation = region.get_simulation()
+    has_warmup = region.get_warmup() is not None
+
+    # The PC counts restart from zero when restoring, so the region is
+    # delimited by the counts relative to the checkpoint.
+    targets = [simulation.get_end()]
+    if has_warmup:
+        targets.append(simulation.get_start())
+    for target in targets:
+        if target.get_relative() is None:
+            raise ValueError(
+                f"Region {region_id} has no relative count for PC "
+                f"{target.get_pc():#x}. The LoopPoint data must come from "
+                "the JSON file written when taking the checkpoints."
+            )
+
+    simulator.restore_checkpoint(checkpoint)
+
+    board = simulator._board
+    board.get_looppoint().get_manager().setTargets(
+        [
+            PcCountPair(target.get_pc(), target.get_relative()).getValue()
+            for target in targets
+        ]
+    )
+    cores = [
+        core.get_simobject() for core in board.get_processor().get_cores()
+    ]
+
+    def total_insts() -> int:
+        return sum(core.totalInsts() for core in cores)
+
+    result = {
+        "region": region_id,
+        "checkpoint": str(checkpoint),
+        "multiplier": region.get_multiplier(),
+    }
+    start = {}
+
+    def begin_region():
+        m5.stats.reset()
+        start["tick"] = m5.curTick()
+        start["insts"] = total_insts()
+
+    def on_pc_count():
+        if "tick" not in start:
+            # End of the warmup
+            begin_region()
+            yield False
+        m5.stats.dump()
+        ticks = m5.curTick() - start["tick"]
+        result["insts"] = total_insts() - start["insts"]
+        result["cycles"] = (
+            ticks / board.get_clock_domain().clock[0].getValue()
+        )
+        result["ticks"] = ticks
+        yield True
+
+    simulator._on_exit_event = dict(simulator._on_exit_event)
+    simulator._on_exit_event[ExitEvent.SIMPOINT_BEGIN] = on_pc_count()
+
+    if not has_warmup:
+        begin_region()
+
+    simulator.run()
+    result["exit_cause"] = simulator.get_last_exit_event_cause()
+    return result
+
+
+def _fork_regions(
+    simulator: Simulator,
+    checkpoints: List[Path],
+    run_region: Callable[[int], Dict],
+    processes: Optional[int],
+) -> List[Dict]:
+    """
+    Instantiate the simulation once and run ``run_region(index)`` for
+    every checkpoint in a forked child, at most ``processes`` at a time.
+    A region is considered measured if its result has ``ticks``.
+    """
+    if simulator._instantiated:
+        raise Exception("The simulator must not have been instantiated.")
+
+    processes = processes or os.cpu_count() or 1
+    outdir = Path(m5.options.outdir)
+
+    # The children would otherwise all try to listen on the same ports.
+    m5.disableAllListeners()
+
+    # Build the object graph once. Only the checkpoint restore is left to
+    # the children.
+    simulator._instantiate(defer_state=True)
+
+    sys.stdout.flush()
+    sys.stderr.flush()
+
+    running = {}
+    regions = [None] * len(checkpoints)
+
+    def reap():
+        pid, status = os.wait()
+        index = running.pop(pid)
+        result_file = outdir / f"region{index}" / "region.json"
+        exit_code = os.waitstatus_to_exitcode(status)
+        if exit_code == 0 and result_file.exists():
+            with open(result_file) as f:
+                regions[index] = json.load(f)
+        else:
+            regions[index] = {
+                "checkpoint": str(checkpoints[index]),
+                "error": f"exit code {exit_code}",
+            }
+
+    for index in range(len(checkpoints)):
+        while len(running) >= processes:
+            reap()
+
+        pid = os.fork()
+        if pid == 0:
+            status = 1
+            try:
+                region_outdir = outdir / f"region{index}"
+                region_outdir.mkdir(parents=True, exist_ok=True)
+                notifyFork(Root.getInstance())
+                m5.options.outdir = str(region_outdir)
+                setOutputDir(str(region_outdir))
+
+                result = run_region(index)
+                with open(region_outdir / "region.json", "w") as f:
+                    json.dump(result, f, indent=2)
+                status = 0 if "ticks" in result else 1
+            finally:
+                sys.stdout.flush()
+                sys.stderr.flush()
+                # Don't run the parent's exit handlers (e.g., stats dumps).
+                os._exit(status)
+        running[pid] = index
+
+    while running:
+        reap()
+
+    return regions
+
+
+def run_regions(
+    simulator: Simulator,
+    checkpoints: List[Path],
+    weights: List[float],
+    region_insts: int,
+    warmup_insts: Union[int, List[int]] = 0,
+    processes: Optional[int] = None,
+    output: Optional[Path] = Path("regions.json"),
+) -> Dict:
+    """
+    Simulate every region from its checkpoint in a forked child of this
+    process and aggregate the results.
+
+    The checkpoints must have been taken from the same configuration as
+    the board being simulated (e.g., with
+    ``simpoints_save_checkpoint_generator``). Stats of region ``i`` are
+    written to ``<outdir>/region<i>``.
+
+    :param simulator: The simulator to run the regions with. It must not
+                      have been run yet. Its ``MAX_INSTS`` exit event is
+                      used to delimit the warmup and the region.
+    :param checkpoints: The checkpoint of each region.
+    :param weights: The weight of each region.
+    :param region_insts: The number of instructions in a region.
+    :param warmup_insts: The instructions to run before measuring each
+                         region, one value for all or one per region.
+    :param processes: The maximum number of regions simulated at the same
+                      time. Defaults to the number of host CPUs.
+    :param output: A JSON file, relative to the output directory, to write
+                   the results to. No file is written if ``None``.
+
+    :returns: A dictionary with the results of every region and their
+              weighted CPI.
+    """
+    if len(checkpoints) != len(weights):
+        raise ValueError("Every checkpoint needs a weight.")
+    if isinstance(warmup_insts, int):
+        warmup_insts = [warmup_insts] * len(checkpoints)
+    if len(warmup_insts) != len(checkpoints):
+        raise ValueError("Every checkpoint needs a warmup length.")
+
+    regions = _fork_regions(
+        simulator,
+        checkpoints,
+        lambda index: _run_region(
+            simulator, checkpoints[index], region_insts, warmup_insts[index]
+        ),
+        processes,
+    )
+    for region, weight in zip(regions, weights):
+        region["weight"] = weight
+
+    measured = [r for r in regions if "cpi" in r]
+    total_weight = sum(r["weight"] for r in measured)
+    results = {
+        "region_insts": region_insts,
+        "regions": regions,
+        "weighted_cpi": (
+            sum(r["weight"] * r["cpi"] for r in measured) / total_weight
+            if total_weight
+            else None
+        ),
+        # The share of the program covered by successfully measured
+        # regions. The weighted CPI is renormalized over these.
+        "measured_weight": total_weight,
+    }
+
+    if output is not None:
+        with open(Path(m5.options.outdir) / output, "w") as f:
+            json.dump(results, f, indent=2)
+
+    return results
+
+
+def run_looppoint_regions(
+    simulator: Simulator,
+    looppoint: Looppoint,
+    checkpoint_dir: Path,
+    region_ids: Optional[List[Union[int, str]]] = None,
+    processes: Optional[int] = None,
+    output: Optional[Path] = Path("looppoint_regions.json"),
+) -> Dict:
+    """
+    Simulate every LoopPoint region from its checkpoint in a forked child
+    of this process and extrapolate the whole application from the region
+    multipliers.
+
+    The board must have been set up with a LoopPoint workload that tracks
+    the PCs of all the regions (e.g., the one the checkpoints were taken
+    with). The checkpoints are expected to be named ``cpt.Region<id>``, as
+    written by ``looppoint_save_checkpoint_generator``. Stats of the
+    ``i``-th region run are written to ``<outdir>/region<i>``.
+
+    :param simulator: The simulator to run the regions with. It must not
+                      have been run yet. Its ``SIMPOINT_BEGIN`` exit event
+                      is used to delimit the warmup and the region.
+    :param looppoint: The LoopPoint data with the counts relative to the
+                      checkpoints, e.g., a ``LooppointJsonLoader`` for the
+                      JSON file written when taking the checkpoints.
+    :param checkpoint_dir: The directory holding the checkpoints.
+    :param region_ids: The regions to simulate. Defaults to all of them.
+    :param processes: The maximum number of regions simulated at the same
+                      time. Defaults to the number of host CPUs.
+    :param output: A JSON file, relative to the output directory, to write
+                   the results to. No file is written if ``None``.
+
+    :returns: A dictionary with the results of every region and the
+              extrapolated ticks, cycles, instructions and IPC of the whole
+              application.
+    """
+    lp_regions = looppoint.get_regions()
+    if region_ids is None:
+        region_ids = list(lp_regions)
+    checkpoints = []
+    for region_id in region_ids:
+        if region_id not in lp_regions:
+            raise ValueError(f"Region ID '{region_id}' cannot be found.")
+        checkpoint = Path(checkpoint_dir) / f"cpt.Region{region_id}"
+        if not checkpoint.is_dir():
+            raise FileNotFoundError(
+                f"No checkpoint for region '{region_id}' at {checkpoint}."
+            )
+        checkpoints.append(checkpoint)
+
+    regions = _fork_regions(
+        simulator,
+        checkpoints,
+        lambda index: _run_looppoint_region(
+            simulator, looppoint, region_ids[index], checkpoints[index]
+        ),
+        processes,
+    )
+    for region, region_id in zip(regions, region_ids):
+        region["region"] = region_id
+        region["multiplier"] = lp_regions[region_id].get_multiplier()
+
+    measured = [r for r in regions if "ticks" in r]
+
+    def extrapolate(key):
+        return sum(r["multiplier"] * r[key] for r in measured)
+
+    cycles = extrapolate("cycles")
+    results = {
+        "regions": regions,
+        "extrapolated_ticks": extrapolate("ticks"),
+        "extrapolated_cycles": cycles,
+        "extrapolated_insts": extrapolate("insts"),
+        "ipc": extrapolate("insts") / cycles if cycles else None,
+        # Regions that failed are missing from the extrapolation.
+        "failed_regions": [r["region"] for r in regions if "ticks" not in r],
+    }
+
+    if output is not None:
+        with open(Path(m5.options.outdir) / output, "w") as f:
+            json.dump(results, f, indent=2)
+
+    return results
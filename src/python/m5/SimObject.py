@@ -1109,36 +1109,44 @@ class SimObject(metaclass=MetaSimObject):
             if port != None:
                 port.unproxy(self)
 
-    def print_ini(self, ini_file):
-        print("[" + self.path() + "]", file=ini_file)  # .ini section header
-
-        instanceDict[self.path()] = self
+    # the (key, value) string pairs of this object's config.ini section,
+    # also used for the binary config dump
+    def ini_entries(self):
+        entries = []
 
         if hasattr(self, "type"):
-            print(f"type={self.type}", file=ini_file)
+            entries.append(("type", self.type))
 
         if len(self._children.keys()):
-            print(
-                "children=%s"
-                % " ".join(
-                    self._children[n].get_name()
-                    for n in sorted(self._children.keys())
-                ),
-                file=ini_file,
+            entries.append(
+                (
+                    "children",
+                    " ".join(
+                        self._children[n].get_name()
+                        for n in sorted(self._children.keys())
+                    ),
+                )
             )
 
         for param in sorted(self._params.keys()):
             value = self._values.get(param)
             if value != None:
-                print(
-                    f"{param}={self._values[param].ini_str()}",
-                    file=ini_file,
-                )
+                entries.append((param, value.ini_str()))
 
         for port_name in sorted(self._ports.keys()):
             port = self._port_refs.get(port_name, None)
             if port != None:
-                print(f"{port_name}={port.ini_str()}", file=ini_file)
+                entries.append((port_name, port.ini_str()))
+
+        return entries
+
+    def print_ini(self, ini_file):
+        print("[" + self.path() + "]", file=ini_file)  # .ini section header
+
+        instanceDict[self.path()] = self
+
+        for key, value in self.ini_entries():
+            print(f"{key}={value}", file=ini_file)
 
         print(file=ini_file)  # blank line between objects
 
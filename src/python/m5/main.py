@@ -233,6 +233,16 @@ def parse_options():
         callback=_stats_help,
         help="Display documentation for available stat visitors",
     )
+    option(
+        "--stats-filter",
+        metavar="PATTERN",
+        action="append",
+        default=[],
+        help="Only collect and dump the stats whose path (e.g. "
+        "'system.cpu.ipc') matches this glob pattern. Prefix the pattern "
+        "with 're:' to use a regular expression. Can be given several "
+        "times.",
+    )
 
     # Configuration Options
     group("Configuration Options")
@@ -242,6 +252,13 @@ def parse_options():
         default="config.ini",
         help="Dump configuration output file [Default: %default]",
     )
+    option(
+        "--bin-config",
+        metavar="FILE",
+        default=None,
+        help="Create a binary dump of the configuration which "
+        "CxxConfigManager can load without Python [Default: %default]",
+    )
     option(
         "--json-config",
         metavar="FILE",
@@ -261,6 +278,15 @@ def parse_options():
         help="Create DOT & pdf outputs of the DVFS configuration"
         + " [Default: %default]",
     )
+    option(
+        "--random-seed",
+        metavar="SEED",
+        type="int",
+        default=None,
+        help="Seed the random number generators of the simulated "
+        "objects, e.g., to get different runs of a random tester "
+        "[Default: %default]",
+    )
 
     # Debugging options
     group("Debugging Options")
@@ -301,6 +327,32 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-ring",
+        metavar="N",
+        type="int",
+        default=0,
+        help="Keep the last N debug messages of each thread in memory "
+        "instead of printing them, and print them to the debug file on "
+        "panic, fatal, SIGQUIT or m5.trace.dumpRing() [Default: %default]",
+    )
+    option(
+        "--timeline-file",
+        metavar="FILE",
+        default="",
+        help="Record a timeline of the simulation in FILE, in the Chrome "
+        "trace format which ui.perfetto.dev can open: the execution of "
+        "events, the packets seen by MemTimelineProbes and the pipeline "
+        "stages of O3 instructions",
+    )
+    option(
+        "--timeline-sample",
+        metavar="N",
+        type="int",
+        default=1,
+        help="Only record one item out of N at each timeline "
+        "instrumentation point [Default: %default]",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -553,11 +605,16 @@ def main():
     # tell C++ about output directory
     core.setOutputDir(options.outdir)
 
+    if options.random_seed is not None:
+        core.seedRandom(options.random_seed)
+
     # update the system path with elements from the -p option
     sys.path[0:0] = options.path
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    if options.stats_filter:
+        stats.setStatFilter(options.stats_filter)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -612,6 +669,10 @@ def main():
 
     trace.output(options.debug_file)
 
+    if options.debug_ring:
+        _check_tracing()
+        trace.enableRing(options.debug_ring)
+
     for activate in options.debug_activate:
         _check_tracing()
         trace.activate(activate)
@@ -893,6 +893,21 @@ class PcCountPair(ParamValue):
     def pybind_predecls(cls, code):
         code('#include "cpu/probes/pc_count_pair.hh"')
 
+    @classmethod
+    def cxx_ini_predecls(cls, code):
+        code("#include <cstdio>")
+
+    @classmethod
+    def cxx_ini_parse(cls, code, src, dest, ret):
+        code("unsigned long long _pc;")
+        code("int _count;")
+        code("char _end;")
+        code("bool _ret = std::sscanf((${src}).c_str(), \"(%llu,%d)%c\",")
+        code("    &_pc, &_count, &_end) == 2;")
+        code("if (_ret)")
+        code("    ${dest} = PcCountPair(_pc, _count);")
+        code("${ret} _ret;")
+
 
 class AddrRange(ParamValue):
     cxx_type = "AddrRange"
@@ -1280,6 +1295,32 @@ class IpAddress(ParamValue):
 
         return IpAddress(self.ip)
 
+    @classmethod
+    def cxx_ini_predecls(cls, code):
+        code("#include <cstdio>")
+
+    # Parse the "a.b.c.d" prefix shared by all the IP params into _ip,
+    # followed by the given suffix format filling in the extra args
+    @classmethod
+    def cxx_ini_parse_ip(cls, code, src, suffix="", args=[]):
+        code("unsigned _a = 0, _b = 0, _c = 0, _d = 0;")
+        code("char _end;")
+        code(
+            "bool _ret = std::sscanf((${src}).c_str(), "
+            + f'"%u.%u.%u.%u{suffix}%c", &_a, &_b, &_c, &_d, '
+            + "".join(f"{arg}, " for arg in args)
+            + f"&_end) == {4 + len(args)};"
+        )
+        code("_ret = _ret && _a < 256 && _b < 256 && _c < 256 && _d < 256;")
+        code("uint32_t _ip = _a << 24 | _b << 16 | _c << 8 | _d;")
+
+    @classmethod
+    def cxx_ini_parse(cls, code, src, dest, ret):
+        cls.cxx_ini_parse_ip(code, src)
+        code("if (_ret)")
+        code("    ${dest} = networking::IpAddress(_ip);")
+        code("${ret} _ret;")
+
 
 # When initializing an IpNetmask, pass in an existing IpNetmask, a string of
 # the form "a.b.c.d/n" or "a.b.c.d/e.f.g.h", or an ip and netmask as
@@ -1357,6 +1398,14 @@ class IpNetmask(IpAddress):
 
         return IpNetmask(self.ip, self.netmask)
 
+    @classmethod
+    def cxx_ini_parse(cls, code, src, dest, ret):
+        code("unsigned _netmask = 0;")
+        cls.cxx_ini_parse_ip(code, src, "/%u", ["&_netmask"])
+        code("if (_ret && _netmask <= 32)")
+        code("    ${dest} = networking::IpNetmask(_ip, _netmask);")
+        code("${ret} _ret && _netmask <= 32;")
+
 
 # When initializing an IpWithPort, pass in an existing IpWithPort, a string of
 # the form "a.b.c.d:p", or an ip and port as positional or keyword arguments.
@@ -1433,6 +1482,14 @@ class IpWithPort(IpAddress):
 
         return IpWithPort(self.ip, self.port)
 
+    @classmethod
+    def cxx_ini_parse(cls, code, src, dest, ret):
+        code("unsigned _port = 0;")
+        cls.cxx_ini_parse_ip(code, src, ":%u", ["&_port"])
+        code("if (_ret && _port <= 0xffff)")
+        code("    ${dest} = networking::IpWithPort(_ip, _port);")
+        code("${ret} _ret && _port <= 0xffff;")
+
 
 time_formats = [
     "%a %b %d %H:%M:%S %Z %Y",
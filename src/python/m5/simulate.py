@@ -59,6 +59,7 @@ from . import (
     params,
     stats,
     ticks,
+    trace,
 )
 from .citations import gather_citations
 from .util import (
@@ -73,12 +74,50 @@ MaxTick = 2**64 - 1
 _drain_manager = _m5.drain.DrainManager.instance()
 
 _instantiated = False  # Has m5.instantiate() been called?
+_state_pending = False  # Is the state initialization still to be done?
+
+
+# Write the resolved configuration of objs (the same values as
+# config.ini) in the binary format read by CxxBinFile, see
+# src/sim/cxx_config_bin.hh. Rebuilding a system from it with
+# CxxConfigManager takes no Python and no text parsing.
+def dump_bin_config(objs, filename):
+    import struct
+
+    strings = {}
+
+    def intern(string):
+        return strings.setdefault(string, len(strings))
+
+    objects = []
+    for obj in objs:
+        entries = [(intern(k), intern(v)) for k, v in obj.ini_entries()]
+        objects.append((intern(obj.path()), entries))
+
+    with open(filename, "wb") as bin_file:
+        bin_file.write(b"gem5cfg\0")
+        bin_file.write(struct.pack("<II", 1, len(strings)))
+        # dicts keep insertion order, which is the order of the indices
+        for string in strings:
+            data = string.encode()
+            bin_file.write(struct.pack("<I", len(data)))
+            bin_file.write(data)
+        bin_file.write(struct.pack("<I", len(objects)))
+        for name, entries in objects:
+            bin_file.write(struct.pack("<II", name, len(entries)))
+            for key, value in entries:
+                bin_file.write(struct.pack("<II", key, value))
 
 
 # The final call to instantiate the SimObject graph and initialize the
-# system.
-def instantiate(ckpt_dir=None):
+# system. If defer_state is set, the objects are created and initialized
+# but their state is neither initialized nor restored from a checkpoint
+# until restore_state() is called. This allows forking the simulator after
+# the (expensive) object construction and restoring a different checkpoint
+# in every child.
+def instantiate(ckpt_dir=None, defer_state=False):
     global _instantiated
+    global _state_pending
     from m5 import options
 
     if _instantiated:
@@ -94,6 +133,11 @@ def instantiate(ckpt_dir=None):
     # we need to fix the global frequency
     ticks.fixGlobalFrequency()
 
+    # The timeline needs the frequency to convert ticks to time
+    if options.timeline_file:
+        trace.timelineStart(options.timeline_file, options.timeline_sample)
+        atexit.register(trace.timelineStop)
+
     # Make sure SimObject-valued params are in the configuration
     # hierarchy so we catch them with future descendants() walks
     for obj in root.descendants():
@@ -110,6 +154,12 @@ def instantiate(ckpt_dir=None):
             obj.print_ini(ini_file)
         ini_file.close()
 
+    if options.bin_config:
+        dump_bin_config(
+            sorted(root.descendants(), key=lambda o: o.path()),
+            os.path.join(options.outdir, options.bin_config),
+        )
+
     if options.json_config:
         try:
             import json
@@ -127,8 +177,13 @@ def instantiate(ckpt_dir=None):
         do_dot(root, options.outdir, options.dot_config)
         do_ruby_dot(root, options.outdir, options.dot_config)
 
-    # Initialize the global statistics
+    # Initialize the global statistics. Stats shared by several event
+    # queues need one slot per queue, and the slots are allocated when
+    # the stats are constructed.
     stats.initSimStats()
+    _m5.stats.setThreadSlots(
+        1 + max(obj.eventq_index for obj in root.descendants())
+    )
 
     # Create the C++ sim objects and connect ports
     for obj in root.descendants():
@@ -143,6 +198,7 @@ def instantiate(ckpt_dir=None):
     # Do a third pass to initialize statistics
     stats._bindStatHierarchy(root)
     root.regStats()
+    stats.applyStatFilter()
 
     # Do a fourth pass to initialize probe points
     for obj in root.descendants():
@@ -161,6 +217,23 @@ def instantiate(ckpt_dir=None):
     # We're done registering statistics.  Enable the stats package now.
     stats.enable()
 
+    _state_pending = True
+    if not defer_state:
+        restore_state(ckpt_dir)
+
+
+# Initialize the state of the objects created by a deferred instantiate(),
+# restoring it from a checkpoint if one is given.
+def restore_state(ckpt_dir=None):
+    global _state_pending
+
+    if not _state_pending:
+        fatal("m5.restore_state() called without a deferred instantiate().")
+
+    _state_pending = False
+
+    root = objects.Root.getInstance()
+
     # Restore checkpoint (if any)
     if ckpt_dir:
         _drain_manager.preCheckpointRestore()
@@ -188,6 +261,9 @@ def simulate(*args, **kwargs):
     if not _instantiated:
         fatal("m5.instantiate() must be called before m5.simulate().")
 
+    if _state_pending:
+        fatal("m5.restore_state() must be called before m5.simulate().")
+
     if need_startup:
         root = objects.Root.getInstance()
         for obj in root.descendants():
@@ -321,7 +397,16 @@ def memInvalidate(root):
         obj.memInvalidate()
 
 
-def checkpoint(dir):
+def checkpoint(dir, binary=False, threads=1):
+    """Write a checkpoint of the simulated system to dir.
+
+    If binary is set the checkpoint file is written in the binary format,
+    which is faster to restore. Both formats can be restored, and
+    util/cpt_convert.py converts between them.
+
+    The SimObjects are serialized on the given number of host threads.
+    Memories use the System's checkpoint_compression_threads instead.
+    """
     root = objects.Root.getInstance()
     if not isinstance(root, objects.Root):
         raise TypeError("Checkpoint must be called on a root object.")
@@ -333,7 +418,8 @@ def checkpoint(dir):
     os.makedirs(dir, exist_ok=True)
 
     print("Writing checkpoint")
-    _m5.core.serializeAll(dir)
+    _m5.core.setBinaryCheckpoints(binary)
+    _m5.core.serializeAll(dir, threads)
 
 
 def _changeMemoryMode(system, mode):
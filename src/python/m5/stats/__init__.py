@@ -55,6 +55,10 @@ from .gem5stats import JsonOutputVistor
 
 outputList = []
 
+# Outputs dumped on their own, as (output, period in ticks), scheduled
+# when the stats are enabled.
+_stream_dumps = []
+
 # Dictionary of stat visitor factories populated by the _url_factory
 # visitor.
 factories = {}
@@ -190,6 +194,83 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["bin"])
+def _binaryFactory(fn):
+    """Output stats in a compact binary format.
+
+    Binary stat files store the names and shapes of all stats once, and
+    then the raw values of every stat dump with no formatting at all.
+    This makes dumps considerably cheaper than with the text format,
+    which matters when dumping large systems periodically. The files
+    can be converted to text with util/stats_binary_to_text.py.
+
+    Example:
+      bin://stats.bin
+
+    """
+
+    return _m5.stats.initBinary(fn)
+
+
+def _addStreamDump(output, period):
+    if period:
+        _stream_dumps.append((output, int(period)))
+    return output
+
+
+@_url_factory(["stream"])
+def _streamFactory(fn, period=0, stats=[]):
+    """Stream stats updates to a file to follow a simulation live.
+
+    Every dump only writes the stats that changed since the previous
+    one, using a simple line based protocol described in
+    src/base/stats/stream.hh. Tools can tail the file while the
+    simulation runs.
+
+    Parameters:
+      * period (int): Also dump this output every period ticks, without
+        dumping the other outputs or resetting the stats (default: 0,
+        only on regular stat dumps)
+      * stats (list): Glob patterns (or regular expressions prefixed
+        with 're:') of the stats to stream (default: all)
+
+    Example:
+      stream://stats.stream?period=1000000000;stats=['system.cpu*.ipc']
+
+    """
+
+    return _addStreamDump(
+        _m5.stats.initStreamFile(fn, _to_regexes(stats)), period
+    )
+
+
+@_url_factory(["tcp"])
+def _tcpStreamFactory(fn, period=0, stats=[]):
+    """Stream stats updates to a TCP server.
+
+    This uses the same protocol as stream:// outputs. The server must be
+    listening before gem5 starts.
+
+    Parameters:
+      * period (int): Also dump this output every period ticks (default:
+        0, only on regular stat dumps)
+      * stats (list): Glob patterns (or regular expressions prefixed
+        with 're:') of the stats to stream (default: all)
+
+    Example:
+      tcp://localhost:3456?period=1000000000
+
+    """
+
+    host, sep, port = fn.rpartition(":")
+    if not sep or not port.isdigit():
+        fatal(f"{fn}: stat stream servers must be given as host:port")
+    return _addStreamDump(
+        _m5.stats.initStreamSocket(host, int(port), _to_regexes(stats)),
+        period,
+    )
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -307,6 +388,75 @@ names = []
 stats_dict = {}
 stats_list = []
 
+# Regular expressions of the stats to keep, all the stats are kept if
+# the list is empty.
+stat_filter = []
+
+
+def _glob_to_regex(pattern):
+    """Translate a glob pattern to an ECMAScript regular expression."""
+
+    regex = ""
+    i = 0
+    while i < len(pattern):
+        c = pattern[i]
+        if c == "*":
+            regex += ".*"
+        elif c == "?":
+            regex += "."
+        elif c == "[":
+            end = pattern.find("]", i + 1)
+            if end < 0:
+                regex += "\\["
+            else:
+                body = pattern[i + 1 : end]
+                if body.startswith("!"):
+                    body = "^" + body[1:]
+                regex += f"[{body}]"
+                i = end
+        elif c.isalnum() or c == "_":
+            regex += c
+        else:
+            regex += "\\" + c
+        i += 1
+    return regex
+
+
+def _to_regexes(patterns):
+    """Translate a list of glob patterns, or of regular expressions
+    prefixed with 're:', to ECMAScript regular expressions."""
+
+    if isinstance(patterns, str):
+        patterns = [patterns]
+    return [
+        p[3:] if p.startswith("re:") else _glob_to_regex(p) for p in patterns
+    ]
+
+
+def setStatFilter(patterns):
+    """Only collect the stats whose path matches one of the patterns.
+
+    Patterns are glob patterns matched against the whole path of a stat
+    (e.g. 'system.cpu*.ipc'), or regular expressions if they start with
+    're:'. The filter is applied once all the stats have been
+    registered. Filtered out stats are not dumped and distributions
+    release their storage and stop sampling. This must be called before
+    m5.instantiate()."""
+
+    if _m5.stats.enabled():
+        fatal("The stat filter must be set before the stats are enabled")
+
+    global stat_filter
+    stat_filter = _to_regexes(patterns)
+
+
+def applyStatFilter():
+    """Disable the stats that don't match the filter set with
+    setStatFilter(). Called by m5.instantiate() after regStats()."""
+
+    if stat_filter:
+        _m5.stats.filterGroup(Root.getInstance().getCCObject(), stat_filter)
+
 
 def enable():
     """Enable the statistics package.  Before the statistics package is
@@ -337,12 +487,15 @@ def enable():
         stats_dict[stat.name] = stat
         stat.enable()
 
-    # New stats
-    _visit_stats(check_stat)
-    _visit_stats(lambda g, s: s.enable())
+    # New stats. The hierarchy is walked in C++ so that no Python
+    # wrapper has to be created for each stat.
+    _m5.stats.enableGroup(Root.getInstance().getCCObject())
 
     _m5.stats.enable()
 
+    for output, period in _stream_dumps:
+        _m5.stats.periodicOutputDump(output, period)
+
 
 def prepare():
     """Prepare all stats for data access.  This must be done before
@@ -353,30 +506,27 @@ def prepare():
         stat.prepare()
 
     # New stats
-    _visit_stats(lambda g, s: s.prepare())
+    sim_root = Root.getInstance()
+    if sim_root:
+        _m5.stats.prepareGroup(sim_root.getCCObject())
 
 
 def _dump_to_visitor(visitor, roots=None):
-    # New stats
-    def dump_group(group):
-        for stat in group.getStats():
-            stat.visit(visitor)
-        for n, g in group.getStatGroups().items():
-            visitor.beginGroup(n)
-            dump_group(g)
-            visitor.endGroup()
+    """Dump the stats to a C++ output. The group hierarchies are walked
+    in C++, only the group prefixes of the selected sub-roots are
+    handled here."""
 
     if roots:
         # New stats from selected subroots.
         for root in roots:
             for p in root.path_list():
                 visitor.beginGroup(p)
-            dump_group(root)
+            _m5.stats.dumpGroup(visitor, root.getCCObject())
             for p in reversed(root.path_list()):
                 visitor.endGroup()
     else:
         # New stats starting from root.
-        dump_group(Root.getInstance())
+        _m5.stats.dumpGroup(visitor, Root.getInstance().getCCObject())
 
         # Legacy stats
         for stat in stats_list:
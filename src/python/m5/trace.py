@@ -28,7 +28,11 @@
 from _m5.trace import (
     activate,
     disable,
+    dumpRing,
     enable,
+    enableRing,
     ignore,
     output,
+    timelineStart,
+    timelineStop,
 )
@@ -113,6 +113,8 @@ init_drain(py::module_ &m_native)
         .def("isDrained", &DrainManager::isDrained)
         .def("state", &DrainManager::state)
         .def("signalDrainDone", &DrainManager::signalDrainDone)
+        .def("drainSummary", &DrainManager::drainSummary,
+             py::arg("max_objects") = 10)
         .def_static("instance", &DrainManager::instance,
                     py::return_value_policy::reference)
         ;
@@ -310,7 +312,10 @@ pybind_init_core(py::module_ &m_native)
         .def("disableAllListeners", &ListenSocket::disableAll)
         .def("listenersDisabled", &ListenSocket::allDisabled)
         .def("listenersLoopbackOnly", &ListenSocket::loopbackOnly)
-        .def("seedRandom", [](uint64_t seed) { random_mt.init(seed); })
+        .def("seedRandom", [](uint64_t seed) {
+                random_mt.init(seed);
+                RandomStream::setGlobalSeed(seed);
+            })
 
 
         .def("fixClockFrequency", &fixClockFrequency)
@@ -333,7 +338,11 @@ pybind_init_core(py::module_ &m_native)
      * Serialization helpers
      */
     m_core
-        .def("serializeAll", &SimObject::serializeAll)
+        .def("serializeAll", &SimObject::serializeAll,
+             py::arg("cpt_dir"), py::arg("threads") = 1)
+        .def("setBinaryCheckpoints", [](bool binary) {
+            Serializable::binaryCheckpoints = binary;
+        })
         .def("getCheckpoint", [](const std::string &cpt_dir) {
             SimObject::setSimObjectResolver(&pybindSimObjectResolver);
             return new CheckpointIn(cpt_dir);
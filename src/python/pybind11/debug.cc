@@ -49,7 +49,11 @@
 #include "base/debug.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
+#include "base/trace_ring.hh"
+#include "sim/core.hh"
 #include "sim/debug.hh"
+#include "sim/init_signals.hh"
+#include "sim/timeline.hh"
 
 namespace py = pybind11;
 
@@ -83,6 +87,21 @@ ignore(const char *expr)
     trace::getDebugLogger()->addIgnore(ignore);
 }
 
+static void
+enableRing(size_t entries)
+{
+    trace::TraceRing::enable(entries);
+    if (entries)
+        initSigQuit();
+}
+
+static void
+timelineStart(const char *filename, unsigned sample_rate)
+{
+    timeline::start(simout.resolve(filename), sample_rate,
+                    sim_clock::Frequency);
+}
+
 void
 pybind_init_debug(py::module_ &m_native)
 {
@@ -133,6 +152,10 @@ pybind_init_debug(py::module_ &m_native)
         .def("ignore", &ignore)
         .def("enable", &trace::enable)
         .def("disable", &trace::disable)
+        .def("enableRing", &enableRing)
+        .def("dumpRing", &trace::dumpRing)
+        .def("timelineStart", &timelineStart)
+        .def("timelineStop", &timeline::stop)
         ;
 }
 
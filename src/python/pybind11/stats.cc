@@ -42,6 +42,8 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/binary.hh"
+#include "base/stats/stream.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -113,6 +115,9 @@ pybind_init_stats(py::module_ &m_native)
         .def("initSimStats", &statistics::initSimStats)
         .def("initText", &statistics::initText,
             py::return_value_policy::reference)
+        .def("initBinary", &statistics::initBinary)
+        .def("initStreamFile", &statistics::initStreamFile)
+        .def("initStreamSocket", &statistics::initStreamSocket)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
@@ -120,12 +125,18 @@ pybind_init_stats(py::module_ &m_native)
              &statistics::registerPythonStatsHandlers)
         .def("schedStatEvent", &statistics::schedStatEvent)
         .def("periodicStatDump", &statistics::periodicStatDump)
+        .def("periodicOutputDump", &statistics::periodicOutputDump)
         .def("updateEvents", &statistics::updateEvents)
         .def("processResetQueue", &statistics::processResetQueue)
         .def("processDumpQueue", &statistics::processDumpQueue)
         .def("enable", &statistics::enable)
         .def("enabled", &statistics::enabled)
         .def("statsList", &statistics::statsList)
+        .def("enableGroup", &statistics::enableGroup)
+        .def("prepareGroup", &statistics::prepareGroup)
+        .def("dumpGroup", &statistics::dumpGroup)
+        .def("filterGroup", &statistics::filterGroup)
+        .def("setThreadSlots", &statistics::setThreadSlots)
         ;
 
     py::class_<statistics::Output>(m, "Output")
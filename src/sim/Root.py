@@ -67,6 +67,16 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # Calendar index on the main event queues. It speeds up scheduling
+    # when many events are pending in the near future (e.g., large
+    # multi-core systems) without changing the simulation results.
+    eventq_calendar_buckets = Param.UInt32(
+        0, "number of calendar buckets per event queue (0 to disable)"
+    )
+    eventq_calendar_width = Param.Tick(
+        1024, "number of ticks covered by a calendar bucket"
+    )
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
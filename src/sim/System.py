@@ -104,6 +104,33 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    # Checkpoints of the same workload (e.g. SimPoint regions) usually
+    # share most of their memory contents. Delta checkpoints only
+    # store the chunks of memory that changed since the previous
+    # checkpoint taken or restored, and refer to that checkpoint for
+    # the rest. All parents must be kept to restore a delta checkpoint.
+    checkpoint_delta = Param.Bool(
+        False,
+        "Only write the memory that changed since the last checkpoint "
+        "taken or restored",
+    )
+    checkpoint_chunk_size = Param.MemorySize(
+        "1MiB", "Granularity of memory change tracking for delta checkpoints"
+    )
+    checkpoint_compression_threads = Param.Unsigned(
+        1,
+        "Number of host threads used to compress checkpointed memory "
+        "and to decompress it on restore",
+    )
+    # Uncompressed memory images are larger, but are mapped
+    # copy-on-write on restore, so restoring only costs the pages the
+    # simulation touches. The checkpoint files must not change while a
+    # simulation restored from them is running. Delta checkpoints are
+    # always compressed, and hash all of memory on restore.
+    checkpoint_compress_memory = Param.Bool(
+        True, "Compress the memory images written to checkpoints"
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
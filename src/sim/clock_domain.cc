@@ -66,6 +66,7 @@ ClockDomain::ClockDomainStats::ClockDomainStats(ClockDomain &cd)
 ClockDomain::ClockDomain(const Params &p, VoltageDomain *voltage_domain)
     : SimObject(p),
       _clockPeriod(0),
+      _clockPeriodReciprocal(0),
       _voltageDomain(voltage_domain),
       stats(*this)
 {
@@ -123,7 +124,7 @@ SrcClockDomain::clockPeriod(Tick clock_period)
         (*m)->updateClockPeriod();
     }
 
-    _clockPeriod = clock_period;
+    setClockPeriod(clock_period);
 
     DPRINTF(ClockDomain,
             "Setting clock period to %d ticks for source clock %s\n",
@@ -215,7 +216,7 @@ DerivedClockDomain::updateClockPeriod()
 
     // recalculate the clock period, relying on the fact that changes
     // propagate downwards in the tree
-    _clockPeriod = parent.clockPeriod() * clockDivider;
+    setClockPeriod(parent.clockPeriod() * clockDivider);
 
     DPRINTF(ClockDomain,
             "Setting clock period to %d ticks for derived clock %s\n",
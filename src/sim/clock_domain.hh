@@ -46,6 +46,7 @@
 
 #include <algorithm>
 
+#include "base/intmath.hh"
 #include "base/statistics.hh"
 #include "params/ClockDomain.hh"
 #include "params/DerivedClockDomain.hh"
@@ -78,6 +79,25 @@ class ClockDomain : public SimObject
      */
     Tick _clockPeriod;
 
+    /**
+     * Reciprocal of the clock period (see divReciprocal), kept in sync
+     * with _clockPeriod so that the members can convert ticks to cycles
+     * without a division.
+     */
+    uint64_t _clockPeriodReciprocal;
+
+    /**
+     * Set the clock period and its reciprocal.
+     *
+     * @param clock_period The new clock period in ticks, must not be zero
+     */
+    void
+    setClockPeriod(Tick clock_period)
+    {
+        _clockPeriod = clock_period;
+        _clockPeriodReciprocal = divReciprocal(clock_period);
+    }
+
     /**
      * Voltage domain this clock domain belongs to
      */
@@ -107,6 +127,20 @@ class ClockDomain : public SimObject
      */
     Tick clockPeriod() const { return _clockPeriod; }
 
+    /**
+     * Number of clock periods needed to cover a number of ticks, rounded
+     * up. Equivalent to divCeil(t, clockPeriod()), but uses the cached
+     * reciprocal of the period instead of a division.
+     *
+     * @param t Number of ticks
+     * @return Number of clock periods
+     */
+    uint64_t
+    periodsCeil(Tick t) const
+    {
+        return divCeilReciprocal(t, _clockPeriod, _clockPeriodReciprocal);
+    }
+
     /**
      * Register a Clocked object with this ClockDomain.
      *
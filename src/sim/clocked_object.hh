@@ -96,7 +96,7 @@ class Clocked
         // if not, we have to recalculate the cycle and tick, we
         // perform the calculations in terms of relative cycles to
         // allow changes to the clock period in the future
-        Cycles elapsedCycles(divCeil(curTick() - tick, clockPeriod()));
+        Cycles elapsedCycles(clockDomain.periodsCeil(curTick() - tick));
         cycle += elapsedCycles;
         tick += elapsedCycles * clockPeriod();
     }
@@ -136,7 +136,7 @@ class Clocked
     void
     resetClock() const
     {
-        Cycles elapsedCycles(divCeil(curTick(), clockPeriod()));
+        Cycles elapsedCycles(clockDomain.periodsCeil(curTick()));
         cycle = elapsedCycles;
         tick = elapsedCycles * clockPeriod();
     }
@@ -221,7 +221,7 @@ class Clocked
     Cycles
     ticksToCycles(Tick t) const
     {
-        return Cycles(divCeil(t, clockPeriod()));
+        return Cycles(clockDomain.periodsCeil(t));
     }
 
     Tick cyclesToTicks(Cycles c) const { return clockPeriod() * c; }
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2014 ARM Limited
+ * All rights reserved
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/cxx_config_bin.hh"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "base/str.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+const char magic[8] = {'g', 'e', 'm', '5', 'c', 'f', 'g', '\0'};
+
+/** Bounds checked little endian reader over the loaded file */
+class Reader
+{
+  public:
+    Reader(const std::string &_data) : data(_data) { }
+
+    bool
+    read(uint32_t &value)
+    {
+        if (data.size() - pos < 4)
+            return false;
+        auto *p = reinterpret_cast<const uint8_t *>(data.data() + pos);
+        value = p[0] | p[1] << 8 | p[2] << 16 | uint32_t(p[3]) << 24;
+        pos += 4;
+        return true;
+    }
+
+    bool
+    read(std::string &value, uint32_t length)
+    {
+        if (data.size() - pos < length)
+            return false;
+        value.assign(data, pos, length);
+        pos += length;
+        return true;
+    }
+
+    bool done() const { return pos == data.size(); }
+
+  private:
+    const std::string &data;
+    size_t pos = 0;
+};
+
+} // anonymous namespace
+
+bool
+CxxBinFile::isBinFile(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    char header[sizeof(magic)];
+
+    return file.read(header, sizeof(header)) &&
+        std::memcmp(header, magic, sizeof(magic)) == 0;
+}
+
+bool
+CxxBinFile::getParam(const std::string &object_name,
+    const std::string &param_name,
+    std::string &value) const
+{
+    auto object = objects.find(object_name);
+    if (object == objects.end())
+        return false;
+
+    auto entry = object->second.find(param_name);
+    if (entry == object->second.end())
+        return false;
+
+    value = strings[entry->second];
+    return true;
+}
+
+bool
+CxxBinFile::getParamVector(const std::string &object_name,
+    const std::string &param_name,
+    std::vector<std::string> &values) const
+{
+    std::string value;
+    bool ret = getParam(object_name, param_name, value);
+
+    if (ret)
+        tokenize(values, value, ' ', true);
+
+    return ret;
+}
+
+bool
+CxxBinFile::getPortPeers(const std::string &object_name,
+    const std::string &port_name,
+    std::vector<std::string> &peers) const
+{
+    return getParamVector(object_name, port_name, peers);
+}
+
+bool
+CxxBinFile::objectExists(const std::string &object) const
+{
+    return objects.find(object) != objects.end();
+}
+
+void
+CxxBinFile::getAllObjectNames(std::vector<std::string> &list) const
+{
+    list.insert(list.end(), objectNames.begin(), objectNames.end());
+}
+
+void
+CxxBinFile::getObjectChildren(const std::string &object_name,
+    std::vector<std::string> &children, bool return_paths) const
+{
+    if (!getParamVector(object_name, "children", children))
+        return;
+
+    if (return_paths && object_name != "root") {
+        for (auto i = children.begin(); i != children.end(); ++i)
+            *i = object_name + "." + *i;
+    }
+}
+
+bool
+CxxBinFile::load(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+
+    const std::string data((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(magic) ||
+        std::memcmp(data.data(), magic, sizeof(magic)) != 0) {
+        return false;
+    }
+
+    Reader reader(data);
+    std::string header;
+    uint32_t file_version, num_strings, num_objects;
+
+    if (!reader.read(header, sizeof(magic)) ||
+        !reader.read(file_version) || file_version != version ||
+        !reader.read(num_strings)) {
+        return false;
+    }
+
+    strings.clear();
+    objects.clear();
+    objectNames.clear();
+
+    strings.resize(num_strings);
+    for (auto &str : strings) {
+        uint32_t length;
+        if (!reader.read(length) || !reader.read(str, length))
+            return false;
+    }
+
+    if (!reader.read(num_objects))
+        return false;
+
+    objectNames.reserve(num_objects);
+    for (uint32_t i = 0; i < num_objects; i++) {
+        uint32_t name, num_entries;
+        if (!reader.read(name) || name >= num_strings ||
+            !reader.read(num_entries)) {
+            return false;
+        }
+
+        Entries &entries = objects[strings[name]];
+        objectNames.push_back(strings[name]);
+        entries.reserve(num_entries);
+
+        for (uint32_t j = 0; j < num_entries; j++) {
+            uint32_t key, value;
+            if (!reader.read(key) || key >= num_strings ||
+                !reader.read(value) || value >= num_strings) {
+                return false;
+            }
+            entries[strings[key]] = value;
+        }
+    }
+
+    return reader.done();
+}
+
+} // namespace gem5
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2014 ARM Limited
+ * All rights reserved
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ *  Binary config file reading wrapper for use with CxxConfigManager.
+ *
+ *  The file holds the same objects and values as config.ini, as written
+ *  by m5.instantiate when given --bin-config, but is loaded without any
+ *  text parsing:
+ *
+ *      char     magic[8]      "gem5cfg\0"
+ *      uint32   version
+ *      uint32   num_strings
+ *      { uint32 length; char data[length]; }   x num_strings
+ *      uint32   num_objects
+ *      { uint32 name; uint32 num_entries;
+ *        { uint32 key; uint32 value; } x num_entries } x num_objects
+ *
+ *  All integers are little endian and all names, keys and values are
+ *  indices into the string table, so that the many values repeated
+ *  across the objects of a large system are stored once.
+ */
+
+#ifndef __SIM_CXX_CONFIG_BIN_HH__
+#define __SIM_CXX_CONFIG_BIN_HH__
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/cxx_config.hh"
+
+namespace gem5
+{
+
+/** CxxConfigManager interface for using binary config files */
+class CxxBinFile : public CxxConfigFileBase
+{
+  protected:
+    typedef std::unordered_map<std::string, uint32_t> Entries;
+
+    /** The string table of the file */
+    std::vector<std::string> strings;
+
+    /** The entries of each object, referring to their value string */
+    std::unordered_map<std::string, Entries> objects;
+
+    /** Object names in file order */
+    std::vector<std::string> objectNames;
+
+  public:
+    static const uint32_t version = 1;
+
+    CxxBinFile() { }
+
+    /** Does the named file start like a binary config file? */
+    static bool isBinFile(const std::string &filename);
+
+    bool getParam(const std::string &object_name,
+        const std::string &param_name,
+        std::string &value) const;
+
+    bool getParamVector(const std::string &object_name,
+        const std::string &param_name,
+        std::vector<std::string> &values) const;
+
+    bool getPortPeers(const std::string &object_name,
+        const std::string &port_name,
+        std::vector<std::string> &peers) const;
+
+    bool objectExists(const std::string &object_name) const;
+
+    void getAllObjectNames(std::vector<std::string> &list) const;
+
+    void getObjectChildren(const std::string &object_name,
+        std::vector<std::string> &children,
+        bool return_paths = false) const;
+
+    bool load(const std::string &filename);
+};
+
+} // namespace gem5
+
+#endif // __SIM_CXX_CONFIG_BIN_HH__
@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2014 ARM Limited
+ * All rights reserved
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/cxx_config_json.hh"
+
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+#include "base/str.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** A parsed JSON value. Numbers keep their text so that no precision is
+ *  lost before the params parse them. */
+struct Value
+{
+    enum Kind { Null, Bool, Number, String, Array, Object };
+
+    Kind kind = Null;
+    std::string text;
+
+    /** Member names of an object, matching items one for one */
+    std::vector<std::string> keys;
+    /** Elements of an array or member values of an object */
+    std::vector<Value> items;
+
+    const Value *
+    member(const std::string &key) const
+    {
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] == key)
+                return &items[i];
+        }
+        return nullptr;
+    }
+
+    bool
+    isPort() const
+    {
+        return kind == Object && member("role") && member("peer");
+    }
+};
+
+/** Minimal recursive descent JSON parser */
+class Parser
+{
+  public:
+    Parser(const std::string &_data) : data(_data) { }
+
+    bool
+    parseDocument(Value &value)
+    {
+        if (!parse(value))
+            return false;
+        skipSpace();
+        return pos == data.size();
+    }
+
+  private:
+    const std::string &data;
+    size_t pos = 0;
+
+    void
+    skipSpace()
+    {
+        while (pos < data.size() && std::isspace((unsigned char)data[pos]))
+            pos++;
+    }
+
+    bool
+    consume(char c)
+    {
+        skipSpace();
+        if (pos < data.size() && data[pos] == c) {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool
+    literal(const char *word)
+    {
+        std::string w(word);
+        if (data.compare(pos, w.size(), w) != 0)
+            return false;
+        pos += w.size();
+        return true;
+    }
+
+    bool
+    parse(Value &value)
+    {
+        skipSpace();
+        if (pos == data.size())
+            return false;
+
+        switch (data[pos]) {
+          case '{':
+            return parseObject(value);
+          case '[':
+            return parseArray(value);
+          case '"':
+            value.kind = Value::String;
+            return parseString(value.text);
+          case 't':
+            value.kind = Value::Bool;
+            value.text = "true";
+            return literal("true");
+          case 'f':
+            value.kind = Value::Bool;
+            value.text = "false";
+            return literal("false");
+          case 'n':
+            value.kind = Value::Null;
+            value.text = "Null";
+            return literal("null");
+          default:
+            return parseNumber(value);
+        }
+    }
+
+    bool
+    parseObject(Value &value)
+    {
+        value.kind = Value::Object;
+        pos++;
+        if (consume('}'))
+            return true;
+
+        do {
+            std::string key;
+            skipSpace();
+            if (!parseString(key) || !consume(':'))
+                return false;
+            value.keys.push_back(key);
+            value.items.emplace_back();
+            if (!parse(value.items.back()))
+                return false;
+        } while (consume(','));
+
+        return consume('}');
+    }
+
+    bool
+    parseArray(Value &value)
+    {
+        value.kind = Value::Array;
+        pos++;
+        if (consume(']'))
+            return true;
+
+        do {
+            value.items.emplace_back();
+            if (!parse(value.items.back()))
+                return false;
+        } while (consume(','));
+
+        return consume(']');
+    }
+
+    bool
+    parseNumber(Value &value)
+    {
+        size_t start = pos;
+        while (pos < data.size() &&
+            (std::isdigit((unsigned char)data[pos]) ||
+             data[pos] == '-' || data[pos] == '+' || data[pos] == '.' ||
+             data[pos] == 'e' || data[pos] == 'E')) {
+            pos++;
+        }
+
+        value.kind = Value::Number;
+        value.text.assign(data, start, pos - start);
+        return pos != start;
+    }
+
+    /** Append code point cp to out as UTF-8 */
+    static void
+    appendUtf8(std::string &out, unsigned cp)
+    {
+        if (cp < 0x80) {
+            out += char(cp);
+        } else if (cp < 0x800) {
+            out += char(0xc0 | cp >> 6);
+            out += char(0x80 | (cp & 0x3f));
+        } else if (cp < 0x10000) {
+            out += char(0xe0 | cp >> 12);
+            out += char(0x80 | (cp >> 6 & 0x3f));
+            out += char(0x80 | (cp & 0x3f));
+        } else {
+            out += char(0xf0 | cp >> 18);
+            out += char(0x80 | (cp >> 12 & 0x3f));
+            out += char(0x80 | (cp >> 6 & 0x3f));
+            out += char(0x80 | (cp & 0x3f));
+        }
+    }
+
+    bool
+    parseHex4(unsigned &cp)
+    {
+        if (data.size() - pos < 4)
+            return false;
+        cp = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = data[pos++];
+            if (!std::isxdigit((unsigned char)c))
+                return false;
+            cp = cp << 4 |
+                (std::isdigit((unsigned char)c) ? c - '0' :
+                 (std::tolower((unsigned char)c) - 'a' + 10));
+        }
+        return true;
+    }
+
+    bool
+    parseString(std::string &out)
+    {
+        if (pos == data.size() || data[pos] != '"')
+            return false;
+        pos++;
+
+        out.clear();
+        while (pos < data.size()) {
+            char c = data[pos++];
+            if (c == '"')
+                return true;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+
+            if (pos == data.size())
+                return false;
+            switch (data[pos++]) {
+              case '"': out += '"'; break;
+              case '\\': out += '\\'; break;
+              case '/': out += '/'; break;
+              case 'b': out += '\b'; break;
+              case 'f': out += '\f'; break;
+              case 'n': out += '\n'; break;
+              case 'r': out += '\r'; break;
+              case 't': out += '\t'; break;
+              case 'u': {
+                unsigned cp;
+                if (!parseHex4(cp))
+                    return false;
+                // Combine UTF-16 surrogate pairs
+                if (cp >= 0xd800 && cp < 0xdc00) {
+                    unsigned low;
+                    if (!literal("\\u") || !parseHex4(low) ||
+                        low < 0xdc00 || low >= 0xe000) {
+                        return false;
+                    }
+                    cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+                }
+                appendUtf8(out, cp);
+                break;
+              }
+              default:
+                return false;
+            }
+        }
+
+        return false;
+    }
+};
+
+/** Append str to list, space separated as in config.ini */
+void
+appendWord(std::string &list, const std::string &str)
+{
+    if (!list.empty())
+        list += ' ';
+    list += str;
+}
+
+std::string
+childPath(const std::string &parent, const std::string &name)
+{
+    return parent == "root" ? name : parent + "." + name;
+}
+
+/** The name of a child object. Vector children are named by
+ *  SimObjectVector rather than by their attribute. */
+std::string
+childName(const Value &child, const std::string &attr)
+{
+    const Value *name = child.member("name");
+    return name && name->kind == Value::String ? name->text : attr;
+}
+
+/** Flattens the object tree into CxxJsonFile's per-object entries */
+class Loader
+{
+  public:
+    Loader(
+        std::unordered_map<std::string,
+            std::unordered_map<std::string, std::string>> &_objects,
+        std::vector<std::string> &_objectNames) :
+        objects(_objects), objectNames(_objectNames)
+    { }
+
+    bool
+    addObject(const Value &object, const std::string &path)
+    {
+        if (!objects.emplace(path, Entries()).second)
+            return false;
+        objectNames.push_back(path);
+
+        std::string children;
+
+        for (size_t i = 0; i < object.keys.size(); i++) {
+            const std::string &key = object.keys[i];
+            const Value &value = object.items[i];
+            std::string entry;
+
+            if (value.isPort()) {
+                if (!portPeers(*value.member("peer"), entry))
+                    return false;
+            } else if (value.kind == Value::Object) {
+                std::string name = childName(value, key);
+                entry = childPath(path, name);
+                if (!addObject(value, entry))
+                    return false;
+                appendWord(children, name);
+            } else if (value.kind == Value::Array &&
+                !value.items.empty() &&
+                value.items.front().kind == Value::Object) {
+                for (size_t j = 0; j < value.items.size(); j++) {
+                    const Value &child = value.items[j];
+                    if (child.kind != Value::Object)
+                        return false;
+                    std::string name = childName(child,
+                        key + std::to_string(j));
+                    std::string child_path = childPath(path, name);
+                    if (!addObject(child, child_path))
+                        return false;
+                    appendWord(children, name);
+                    appendWord(entry, child_path);
+                }
+            } else if (value.kind == Value::Array) {
+                for (const auto &item : value.items) {
+                    if (item.kind == Value::Array ||
+                        item.kind == Value::Object) {
+                        return false;
+                    }
+                    appendWord(entry, item.text);
+                }
+            } else {
+                entry = value.text;
+            }
+
+            // The entries of an object are written after the object has
+            // been recursively added as the map may be rehashed by then.
+            objects[path][key] = entry;
+        }
+
+        if (!children.empty())
+            objects[path]["children"] = children;
+
+        return true;
+    }
+
+  private:
+    typedef std::unordered_map<std::string, std::string> Entries;
+
+    std::unordered_map<std::string, Entries> &objects;
+    std::vector<std::string> &objectNames;
+
+    static bool
+    portPeers(const Value &peer, std::string &peers)
+    {
+        if (peer.kind == Value::String) {
+            if (peer.text != "None")
+                peers = peer.text;
+            return true;
+        } else if (peer.kind == Value::Array) {
+            for (const auto &item : peer.items) {
+                if (item.kind != Value::String)
+                    return false;
+                appendWord(peers, item.text);
+            }
+            return true;
+        }
+        return false;
+    }
+};
+
+} // anonymous namespace
+
+bool
+CxxJsonFile::isJsonFile(const std::string &filename)
+{
+    std::ifstream file(filename);
+    char c;
+
+    while (file.get(c)) {
+        if (!std::isspace((unsigned char)c))
+            return c == '{';
+    }
+    return false;
+}
+
+bool
+CxxJsonFile::getParam(const std::string &object_name,
+    const std::string &param_name,
+    std::string &value) const
+{
+    auto object = objects.find(object_name);
+    if (object == objects.end())
+        return false;
+
+    auto entry = object->second.find(param_name);
+    if (entry == object->second.end())
+        return false;
+
+    value = entry->second;
+    return true;
+}
+
+bool
+CxxJsonFile::getParamVector(const std::string &object_name,
+    const std::string &param_name,
+    std::vector<std::string> &values) const
+{
+    std::string value;
+    bool ret = getParam(object_name, param_name, value);
+
+    if (ret)
+        tokenize(values, value, ' ', true);
+
+    return ret;
+}
+
+bool
+CxxJsonFile::getPortPeers(const std::string &object_name,
+    const std::string &port_name,
+    std::vector<std::string> &peers) const
+{
+    return getParamVector(object_name, port_name, peers);
+}
+
+bool
+CxxJsonFile::objectExists(const std::string &object) const
+{
+    return objects.find(object) != objects.end();
+}
+
+void
+CxxJsonFile::getAllObjectNames(std::vector<std::string> &list) const
+{
+    list.insert(list.end(), objectNames.begin(), objectNames.end());
+}
+
+void
+CxxJsonFile::getObjectChildren(const std::string &object_name,
+    std::vector<std::string> &children, bool return_paths) const
+{
+    if (!getParamVector(object_name, "children", children))
+        return;
+
+    if (return_paths && object_name != "root") {
+        for (auto i = children.begin(); i != children.end(); ++i)
+            *i = object_name + "." + *i;
+    }
+}
+
+bool
+CxxJsonFile::load(const std::string &filename)
+{
+    std::ifstream file(filename);
+    if (!file)
+        return false;
+
+    const std::string data((std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+
+    Value root;
+    Parser parser(data);
+    if (!parser.parseDocument(root) || root.kind != Value::Object)
+        return false;
+
+    objects.clear();
+    objectNames.clear();
+
+    Loader loader(objects, objectNames);
+    return loader.addObject(root, "root");
+}
+
+} // namespace gem5
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2014 ARM Limited
+ * All rights reserved
+ *
+ * The license below extends only to copyright in the software and shall
+ * not be construed as granting a license to any other intellectual
+ * property including but not limited to intellectual property relating
+ * to a hardware implementation of the functionality of the software
+ * licensed hereunder.  You may use the software subject to the license
+ * terms below provided that you ensure that this notice is replicated
+ * unmodified and in its entirety in all distributions of the software,
+ * modified or unmodified, in source code or in binary form.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *
+ *  config.json reading wrapper for use with CxxConfigManager.
+ *
+ *  The file is the nested dictionary written by m5.instantiate from
+ *  SimObject.get_config_as_dict. It is flattened on load into the same
+ *  objects, entries and children lists found in config.ini so that the
+ *  manager sees identical values whichever file it is given:
+ *
+ *   - Dictionaries with a "role" and a "peer" are ports. A "None" peer
+ *     is an unconnected port.
+ *   - Any other dictionary (or list of dictionaries) is a child object.
+ *   - Lists of values are vector params and are joined with spaces.
+ *   - true, false and null become "true", "false" and "Null".
+ */
+
+#ifndef __SIM_CXX_CONFIG_JSON_HH__
+#define __SIM_CXX_CONFIG_JSON_HH__
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/cxx_config.hh"
+
+namespace gem5
+{
+
+/** CxxConfigManager interface for using config.json files */
+class CxxJsonFile : public CxxConfigFileBase
+{
+  protected:
+    typedef std::unordered_map<std::string, std::string> Entries;
+
+    /** The flattened entries of each object, keyed by object path */
+    std::unordered_map<std::string, Entries> objects;
+
+    /** Object paths in file order */
+    std::vector<std::string> objectNames;
+
+  public:
+    CxxJsonFile() { }
+
+    /** Does the named file look like a JSON document? */
+    static bool isJsonFile(const std::string &filename);
+
+    bool getParam(const std::string &object_name,
+        const std::string &param_name,
+        std::string &value) const;
+
+    bool getParamVector(const std::string &object_name,
+        const std::string &param_name,
+        std::vector<std::string> &values) const;
+
+    bool getPortPeers(const std::string &object_name,
+        const std::string &port_name,
+        std::vector<std::string> &peers) const;
+
+    bool objectExists(const std::string &object_name) const;
+
+    void getAllObjectNames(std::vector<std::string> &list) const;
+
+    void getObjectChildren(const std::string &object_name,
+        std::vector<std::string> &children,
+        bool return_paths = false) const;
+
+    bool load(const std::string &filename);
+};
+
+} // namespace gem5
+
+#endif // __SIM_CXX_CONFIG_JSON_HH__
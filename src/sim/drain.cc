@@ -39,6 +39,7 @@
 
 #include <algorithm>
 
+#include "base/cprintf.hh"
 #include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
@@ -52,7 +53,8 @@ DrainManager DrainManager::_instance;
 
 DrainManager::DrainManager()
     : _count(0),
-      _state(DrainState::Running)
+      _state(DrainState::Running),
+      _rounds(0), _drainStart(0), _drainEnd(0)
 {
 }
 
@@ -70,6 +72,15 @@ DrainManager::tryDrain()
              "Drain counter must be zero at the start of a drain cycle\n");
 
     DPRINTF(Drain, "Trying to drain %u objects.\n", drainableCount());
+    if (_state == DrainState::Running) {
+        _rounds = 0;
+        _drainStart = curTick();
+        for (auto *obj : _allDrainable) {
+            obj->_drainRounds = 0;
+            obj->_drainDoneTick = curTick();
+        }
+    }
+    ++_rounds;
     _state = DrainState::Draining;
     for (auto *obj : _allDrainable) {
         DrainState status = obj->dmDrain();
@@ -83,6 +94,9 @@ DrainManager::tryDrain()
 
     if (_count == 0) {
         DPRINTF(Drain, "Drain done.\n");
+        _drainEnd = curTick();
+        if (debug::Drain && _rounds > 1)
+            DPRINTF(Drain, "%s", drainSummary());
         _state = DrainState::Drained;
         return true;
     } else {
@@ -156,6 +170,53 @@ DrainManager::signalDrainDone()
 }
 
 
+bool
+DrainManager::signalDrainUndone()
+{
+    // Once the counter has reached zero the simulation loop is about
+    // to exit, so the work has to be picked up by the next cycle.
+    unsigned count = _count;
+    while (count != 0) {
+        if (_count.compare_exchange_weak(count, count + 1))
+            return true;
+    }
+    return false;
+}
+
+std::string
+DrainManager::drainSummary(unsigned max_objects) const
+{
+    std::lock_guard<std::mutex> lock(globalLock);
+
+    std::vector<const Drainable *> slow;
+    for (const auto *obj : _allDrainable) {
+        if (obj->_drainRounds)
+            slow.push_back(obj);
+    }
+    // The objects that needed the most drain cycles, and then the ones
+    // that finished last, delayed draining the most.
+    std::sort(slow.begin(), slow.end(),
+              [](const Drainable *a, const Drainable *b) {
+                  if (a->_drainRounds != b->_drainRounds)
+                      return a->_drainRounds > b->_drainRounds;
+                  return a->_drainDoneTick > b->_drainDoneTick;
+              });
+
+    std::string summary = csprintf(
+        "Drain took %u cycles and %llu ticks, %u of %u objects were not "
+        "drained at least once.\n", _rounds,
+        (_state == DrainState::Draining ? curTick() : _drainEnd) -
+        _drainStart, slow.size(), _allDrainable.size());
+    for (unsigned i = 0; i < slow.size() && i < max_objects; ++i) {
+        const Named *named = dynamic_cast<const Named *>(slow[i]);
+        summary += csprintf("  %s: not drained in %u cycles, done at "
+                            "tick %llu\n",
+                            named ? named->name() : "(unnamed)",
+                            slow[i]->_drainRounds, slow[i]->_drainDoneTick);
+    }
+    return summary;
+}
+
 void
 DrainManager::registerDrainable(Drainable *obj)
 {
@@ -213,6 +274,8 @@ Drainable::dmDrain()
     _drainState = drain();
     assert(_drainState == DrainState::Draining ||
            _drainState == DrainState::Drained);
+    if (_drainState == DrainState::Draining)
+        ++_drainRounds;
 
     return _drainState;
 }
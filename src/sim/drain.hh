@@ -40,8 +40,12 @@
 
 #include <atomic>
 #include <mutex>
+#include <string>
 #include <vector>
 
+#include "base/types.hh"
+#include "sim/cur_tick.hh"
+
 namespace gem5
 {
 
@@ -159,6 +163,25 @@ class DrainManager
      */
     void signalDrainDone();
 
+    /**
+     * Notify the DrainManager that an object that has finished
+     * draining received new work in the current drain cycle.
+     *
+     * @return true if the object is accounted as draining again and
+     * has to signal when it is done, false if the cycle has already
+     * finished and the next cycle has to pick the work up.
+     */
+    bool signalDrainUndone();
+
+    /**
+     * Describe the objects that delayed the last drain the most.
+     *
+     * @param max_objects Maximum number of objects to list.
+     *
+     * @ingroup api_drain
+     */
+    std::string drainSummary(unsigned max_objects=10) const;
+
   public:
     void registerDrainable(Drainable *obj);
     void unregisterDrainable(Drainable *obj);
@@ -192,6 +215,13 @@ class DrainManager
     /** Global simulator drain state */
     DrainState _state;
 
+    /** Number of drain cycles in the current (or last) drain */
+    unsigned _rounds;
+
+    /** Ticks at which the current (or last) drain started and ended */
+    Tick _drainStart;
+    Tick _drainEnd;
+
     /** Singleton instance of the drain manager */
     static DrainManager _instance;
 };
@@ -310,11 +340,35 @@ class Drainable
             return;
           case DrainState::Draining:
             _drainState = DrainState::Drained;
+            _drainDoneTick = curTick();
             _drainManager.signalDrainDone();
             return;
         }
     }
 
+    /**
+     * Signal that an object is no longer drained
+     *
+     * This method is designed to be called whenever an object that
+     * may have finished draining receives new work (e.g., a queue
+     * accepting a new entry). If that happens in the middle of a
+     * drain cycle, the object goes back to the Draining state and has
+     * to call signalDrainDone() once the work completes. The
+     * simulation then keeps running until the work completes, rather
+     * than exiting to find out the object isn't drained in the next
+     * drain cycle. The method is safe to call at any time.
+     *
+     * @ingroup api_drain
+     */
+    void signalDrainUndone() const {
+        if (_drainState == DrainState::Drained &&
+            _drainManager.state() == DrainState::Draining &&
+            _drainManager.signalDrainUndone()) {
+            _drainState = DrainState::Draining;
+            ++_drainRounds;
+        }
+    }
+
   public:
     /**
      * Return the current drain state of an object.
@@ -358,6 +412,14 @@ class Drainable
      * into a Drained state even if the calling method is const.
      */
     mutable DrainState _drainState;
+
+    /**
+     * Number of times the object wasn't drained in the current (or
+     * last) drain, and tick at which it last finished draining. These
+     * are only used to report what delays draining.
+     */
+    mutable unsigned _drainRounds = 0;
+    mutable Tick _drainDoneTick = 0;
 };
 
 } // namespace gem5
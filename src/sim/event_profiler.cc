@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profiler.hh"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/cur_tick.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Strip the suffixes added by event wrappers to get the owner name. */
+std::string
+ownerName(const Event *event)
+{
+    std::string name = event->name();
+    for (const char *suffix :
+             { ".wrapped_function_event", ".wrapped_event" }) {
+        const size_t len = std::char_traits<char>::length(suffix);
+        if (name.size() > len &&
+                name.compare(name.size() - len, len, suffix) == 0) {
+            name.resize(name.size() - len);
+            break;
+        }
+    }
+    return name;
+}
+
+} // anonymous namespace
+
+EventProfiler::Entry &
+EventProfiler::lookup(Event *event)
+{
+#if EVENTQ_PROFILE
+    if (event->profiler != this) {
+        event->profiler = this;
+        event->profileEntry = &entries[ownerName(event)];
+    }
+    return *event->profileEntry;
+#else
+    return entries[ownerName(event)];
+#endif
+}
+
+void
+EventProfiler::merge(std::unordered_map<std::string, Entry> &table) const
+{
+    for (const auto &[name, entry] : entries) {
+        Entry &merged = table[name];
+        merged.events += entry.events;
+        merged.hostNs += entry.hostNs;
+    }
+}
+
+void
+EventProfiler::reset()
+{
+    for (auto &[name, entry] : entries)
+        entry = Entry();
+}
+
+void
+dumpEventProfile(std::ostream &os)
+{
+    std::unordered_map<std::string, EventProfiler::Entry> table;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->profile().merge(table);
+
+    std::vector<std::pair<std::string, EventProfiler::Entry>> ranked(
+        table.begin(), table.end());
+    std::sort(ranked.begin(), ranked.end(),
+              [](const auto &a, const auto &b) {
+                  return a.second.hostNs > b.second.hostNs;
+              });
+
+    uint64_t total_ns = 0;
+    Counter total_events = 0;
+    for (const auto &[name, entry] : ranked) {
+        total_ns += entry.hostNs;
+        total_events += entry.events;
+    }
+
+    ccprintf(os, "---------- Begin Event Profile @ %d ----------\n",
+             curTick());
+    ccprintf(os, "%-60s %12s %14s %7s %9s\n",
+             "object", "events", "host ns", "%", "ns/event");
+    for (const auto &[name, entry] : ranked) {
+        if (!entry.events)
+            continue;
+        ccprintf(os, "%-60s %12d %14d %6.2f%% %9.1f\n", name, entry.events,
+                 entry.hostNs,
+                 total_ns ? 100.0 * entry.hostNs / total_ns : 0.0,
+                 (double)entry.hostNs / entry.events);
+    }
+    ccprintf(os, "%-60s %12d %14d\n", "total", total_events, total_ns);
+    ccprintf(os, "---------- End Event Profile ----------\n\n");
+}
+
+} // namespace gem5
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Attribution of host time to the objects processing events.
+ */
+
+#ifndef __SIM_EVENT_PROFILER_HH__
+#define __SIM_EVENT_PROFILER_HH__
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+class Event;
+
+/**
+ * Per event queue accounting of the host time spent processing events.
+ *
+ * Every processed event is attributed to the name of the object that
+ * owns it, which is the event name without the suffix added by the
+ * event wrappers. The entry of an event is cached in the event itself
+ * to avoid computing its name every time it is processed. The profiler
+ * is only used by event queues when gem5 is built with EVENTQ_PROFILE.
+ */
+class EventProfiler
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry
+    {
+        Counter events = 0;
+        uint64_t hostNs = 0;
+    };
+
+    /** Find the entry an event should be accounted to. */
+    Entry &lookup(Event *event);
+
+    /** Account a processed event that started at start to an entry. */
+    static void
+    record(Entry &entry, Clock::time_point start)
+    {
+        entry.events++;
+        entry.hostNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - start).count();
+    }
+
+    /** Add the entries of this profiler to a table indexed by name. */
+    void merge(std::unordered_map<std::string, Entry> &table) const;
+
+    void reset();
+
+  private:
+    std::unordered_map<std::string, Entry> entries;
+};
+
+/**
+ * Write the merged profile of all main event queues, ranked by host
+ * time, to a stream.
+ */
+void dumpEventProfile(std::ostream &os);
+
+} // namespace gem5
+
+#endif // __SIM_EVENT_PROFILER_HH__
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Scheduling and servicing events. Each benchmark keeps a population of
+ * self-rescheduling events with the arrival pattern of a typical
+ * simulation: clocked objects waking up on shared clock edges, memory
+ * responses a short, variable latency into the future, and occasional
+ * far-future timers. The queue is measured with and without its
+ * calendar index.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const Tick clockPeriod = 500;
+
+Tick
+mixedDelay(std::mt19937_64 &rng)
+{
+    const auto r = rng() % 100;
+    if (r < 60)
+        return clockPeriod * (1 + rng() % 2);
+    else if (r < 99)
+        return clockPeriod * (1 + rng() % 200) + rng() % clockPeriod;
+    else
+        return clockPeriod * 100000;
+}
+
+class MixedEvent : public Event
+{
+  public:
+    MixedEvent(EventQueue &_eq, std::mt19937_64 &_rng, Priority p)
+        : Event(p), eq(_eq), rng(_rng)
+    {}
+
+    void
+    process() override
+    {
+        eq.schedule(this, eq.getCurTick() + mixedDelay(rng));
+    }
+
+  private:
+    EventQueue &eq;
+    std::mt19937_64 &rng;
+};
+
+/**
+ * Service one event per iteration, which also reschedules it.
+ * Arguments are the number of events and the number of calendar buckets.
+ */
+void
+BM_EventQueueService(benchmark::State &state)
+{
+    EventQueue eq("bench_queue");
+    eq.setCalendar(state.range(1), 1024);
+    curEventQueue(&eq);
+
+    std::mt19937_64 rng(42);
+    std::vector<std::unique_ptr<MixedEvent>> events;
+    for (int i = 0; i < state.range(0); ++i) {
+        events.emplace_back(new MixedEvent(eq, rng, (i % 3) - 1));
+        eq.schedule(events.back().get(), mixedDelay(rng));
+    }
+
+    for (auto _ : state)
+        eq.serviceOne();
+    state.SetItemsProcessed(state.iterations());
+
+    for (auto &event : events)
+        eq.deschedule(event.get());
+    curEventQueue(nullptr);
+}
+BENCHMARK(BM_EventQueueService)
+    ->Args({64, 0})->Args({64, 256})
+    ->Args({1024, 0})->Args({1024, 256})
+    ->Args({4096, 0})->Args({4096, 4096});
+
+} // anonymous namespace
@@ -37,6 +37,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
@@ -47,6 +48,20 @@ namespace gem5
 
 Tick simQuantum = 0;
 
+static Tick _minLookahead = MaxTick;
+
+void
+registerLookahead(Tick latency)
+{
+    _minLookahead = std::min(_minLookahead, latency);
+}
+
+Tick
+minLookahead()
+{
+    return _minLookahead;
+}
+
 //
 // Main Event Queues
 //
@@ -58,13 +73,22 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+uint32_t eventqCalendarBuckets = 0;
+Tick eventqCalendarWidth = 0;
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
     while (numMainEventQueues <= index) {
         numMainEventQueues++;
-        mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+        EventQueue *eq = new EventQueue(csprintf("MainEventQueue-%d", index));
+        eq->setCalendar(eventqCalendarBuckets, eventqCalendarWidth);
+        eq->queueIndex = mainEventQueue.size();
+        mainEventQueue.push_back(eq);
+
+        // Make room to account for insertions from the new queue
+        for (auto q : mainEventQueue)
+            q->asyncInsertCount.resize(numMainEventQueues, 0);
     }
 
     return mainEventQueue[index];
@@ -137,24 +161,53 @@ Event::releaseImpl()
 void
 EventQueue::insert(Event *event)
 {
+    Event *curr;
+
     // Deal with the head case
     if (!head || *event <= *head) {
+        curr = head;
         head = Event::insertBefore(event, head);
-        return;
+    } else {
+        // Figure out either which 'in bin' list we are on, or where a new
+        // list needs to be inserted
+        Event *prev = calendarFind(event);
+        curr = prev->nextBin;
+        while (curr && *curr < *event) {
+            prev = curr;
+            curr = curr->nextBin;
+        }
+
+        // Note: this operation may render all nextBin pointers on the
+        // prev 'in bin' list stale (except for the top one)
+        prev->nextBin = Event::insertBefore(event, curr);
     }
 
-    // Figure out either which 'in bin' list we are on, or where a new list
-    // needs to be inserted
-    Event *prev = head;
-    Event *curr = head->nextBin;
-    while (curr && *curr < *event) {
-        prev = curr;
-        curr = curr->nextBin;
+    if (calendar.empty())
+        return;
+
+    // The event either became the new top of curr's bin or started a
+    // new bin of its own.
+    if (event->nextInBin)
+        calendarReplace(curr, event);
+    else
+        calendarAdd(event);
+}
+
+Event *
+EventQueue::calendarFind(const Event *event)
+{
+    if (calendar.empty())
+        return head;
+
+    const size_t mask = calendar.size() - 1;
+    const size_t slot = event->when() >> calendarShift;
+    for (unsigned i = 0; i < calendarLookback; ++i) {
+        Event *bin = calendar[(slot - i) & mask];
+        if (bin && *bin < *event)
+            return bin;
     }
 
-    // Note: this operation may render all nextBin pointers on the
-    // prev 'in bin' list stale (except for the top one)
-    prev->nextBin = Event::insertBefore(event, curr);
+    return head;
 }
 
 Event *
@@ -199,13 +252,16 @@ EventQueue::remove(Event *event)
     // deal with an event on the head's 'in bin' list (event has the same
     // time as the head)
     if (*head == *event) {
+        Event *top = head;
         head = Event::removeItem(event, head);
+        if (event == top)
+            calendarReplace(event, event->nextInBin);
         return;
     }
 
     // Find the 'in bin' list that this event belongs on
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = calendarFind(event);
+    Event *curr = prev->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -218,6 +274,8 @@ EventQueue::remove(Event *event)
     // we remove an item, it returns the new top item (which may be
     // unchanged)
     prev->nextBin = Event::removeItem(event, curr);
+    if (event == curr)
+        calendarReplace(event, event->nextInBin);
 }
 
 Event *
@@ -239,6 +297,7 @@ EventQueue::serviceOne()
         // the 'in bin' list and point to the next bin list
         head = head->nextBin;
     }
+    calendarReplace(event, next);
 
     // handle action
     if (!event->squashed()) {
@@ -246,7 +305,30 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
+#if EVENTQ_PROFILE
+        // Look the entry up first, the event may not survive process().
+        EventProfiler::Entry &entry = _profile.lookup(event);
+        const auto start = EventProfiler::Clock::now();
         event->process();
+        EventProfiler::record(entry, start);
+#else
+        if (timeline::enabled() && timelineSampler()) {
+            // The event may not survive process(), get its names first.
+            // The events of a SimObject are named after it, put them in
+            // a track of the object.
+            const std::string name = event->name();
+            const std::string desc = event->description();
+            const auto dot = name.rfind('.');
+            const uint64_t start = timeline::hostNow();
+            event->process();
+            timeline::hostSlice(dot == std::string::npos ?
+                                    name : name.substr(0, dot),
+                                desc, start, timeline::hostNow(),
+                                curTick());
+        } else {
+            event->process();
+        }
+#endif
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -375,6 +457,21 @@ EventQueue::debugVerify() const
         nextBin = nextBin->nextBin;
     }
 
+    // Every bucket of the calendar must point to the top of a bin that
+    // is currently in the queue.
+    for (const Event *bin : calendar) {
+        if (!bin)
+            continue;
+        const Event *top = head;
+        while (top && top != bin)
+            top = top->nextBin;
+        if (!top) {
+            cprintf("calendar points outside of the queue!");
+            bin->dump();
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -383,9 +480,29 @@ EventQueue::replaceHead(Event* s)
 {
     Event* t = head;
     head = s;
+    // The calendar might point to bins of the old queue. Start over
+    // and let it be repopulated by future insertions.
+    std::fill(calendar.begin(), calendar.end(), nullptr);
     return t;
 }
 
+void
+EventQueue::setCalendar(uint32_t buckets, Tick width)
+{
+    calendar.clear();
+    if (buckets == 0)
+        return;
+
+    fatal_if(!isPowerOf2(buckets) || !isPowerOf2(width),
+             "%s: event queue calendar size (%d) and bucket width (%d) "
+             "must be powers of two.", name(), buckets, width);
+
+    calendar.resize(buckets, nullptr);
+    calendarShift = floorLog2(width);
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        calendarAdd(bin);
+}
+
 void
 dumpMainQueue()
 {
@@ -442,30 +559,79 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), queueIndex(-1),
+      async_ring(asyncRingSize), async_overflow(false),
+      async_ring_writers(0), calendarShift(0)
 {
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
-    async_queue_mutex.lock();
+    EventQueue *src = curEventQueue();
+    if (src && src->queueIndex >= 0 &&
+            (size_t)src->queueIndex < asyncInsertCount.size()) {
+        ++asyncInsertCount[src->queueIndex];
+    }
+
+    // The writer count and the overflow flag must be sequentially
+    // consistent: a writer either sees the flag, or the thread setting
+    // the flag sees the writer and waits for its push to complete.
+    async_ring_writers.fetch_add(1);
+    const bool pushed = !async_overflow.load() && async_ring.push(event);
+    async_ring_writers.fetch_sub(1);
+    if (pushed)
+        return;
+
+    // The ring is full (or was full), fall back to the locked list.
+    std::lock_guard<UncontendedMutex> lock(async_queue_mutex);
+    if (!async_overflow.load()) {
+        async_overflow.store(true);
+        while (async_ring_writers.load() != 0)
+            ;
+    }
     async_queue.push_back(event);
-    async_queue_mutex.unlock();
+}
+
+Tick
+EventQueue::earliestTick()
+{
+    std::lock_guard<UncontendedMutex> lock(async_queue_mutex);
+
+    Tick when = empty() ? MaxTick : nextTick();
+    async_ring.forEach([&when](const Event *event) {
+        when = std::min(when, event->when());
+    });
+    for (const Event *event : async_queue)
+        when = std::min(when, event->when());
+
+    return when;
 }
 
 void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
 
+    // Events that made it to the ring were always inserted before the
+    // ones that overflowed to the list.
+    Event *event;
+    while (async_ring.pop(event))
+        insert(event);
+
+    if (!async_overflow.load())
+        return;
+
+    // Events may have reached the ring after it was drained above but
+    // before the overflow started, and they come before the list.
+    std::lock_guard<UncontendedMutex> lock(async_queue_mutex);
+    while (async_ring.pop(event))
+        insert(event);
     while (!async_queue.empty()) {
         insert(async_queue.front());
         async_queue.pop_front();
     }
-
-    async_queue_mutex.unlock();
+    async_overflow.store(false);
 }
 
 } // namespace gem5
@@ -36,6 +36,7 @@
 #define __SIM_EVENTQ_HH__
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <functional>
@@ -43,17 +44,22 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/debug.hh"
 #include "base/flags.hh"
+#include "base/mpsc_queue.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
 #include "base/type_traits.hh"
 #include "base/types.hh"
 #include "base/uncontended_mutex.hh"
+#include "config/eventq_profile.hh"
 #include "debug/Event.hh"
 #include "sim/cur_tick.hh"
+#include "sim/event_profiler.hh"
 #include "sim/serialize.hh"
+#include "sim/timeline.hh"
 
 namespace gem5
 {
@@ -68,9 +74,26 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+//! Register the minimum latency of a link that can carry events from
+//! one main event queue to another. When simQuantum isn't set
+//! explicitly, simulate() uses the smallest registered latency as
+//! the simulation quantum.
+void registerLookahead(Tick latency);
+
+//! Smallest latency registered through registerLookahead(), MaxTick if
+//! no link has been registered.
+Tick minLookahead();
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
+//! Number of buckets and bucket width (in ticks) of the calendar
+//! index used by the main event queues. Zero buckets disables the
+//! index. Both are applied to queues allocated by getEventQueue().
+//! @see EventQueue::setCalendar()
+extern uint32_t eventqCalendarBuckets;
+extern Tick eventqCalendarWidth;
+
 //! Array for main event queues.
 extern std::vector<EventQueue *> mainEventQueue;
 
@@ -254,6 +277,7 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class EventProfiler;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -295,6 +319,14 @@ class Event : public EventBase, public Serializable
     Tick whenScheduled; //!< time scheduled
 #endif
 
+#if EVENTQ_PROFILE
+    /// Profiler that last accounted this event, and the entry it was
+    /// accounted to there. Keeping them in the event means they go
+    /// away with it.
+    const EventProfiler *profiler = nullptr;
+    EventProfiler::Entry *profileEntry = nullptr;
+#endif
+
     void
     setWhen(Tick when, EventQueue *q)
     {
@@ -616,17 +648,103 @@ class EventQueue
 {
   private:
     friend void curEventQueue(EventQueue *);
+    friend EventQueue *getEventQueue(uint32_t index);
 
     std::string objName;
     Event *head;
     Tick _curTick;
 
+    //! Index of this queue in mainEventQueue, -1 for other queues.
+    int queueIndex;
+
+    //! Capacity of the lock-free ring for asynchronous insertions.
+    static constexpr size_t asyncRingSize = 4096;
+
+    //! Events added by other threads to this event queue. This is
+    //! where asynchronous insertions normally go.
+    MPSCQueue<Event *> async_ring;
+
+    //! Set when async_ring was full and events had to be added to
+    //! async_queue instead. Insertions then keep using async_queue until
+    //! it is drained so that they are merged in the order they were
+    //! made, which global events rely on.
+    std::atomic<bool> async_overflow;
+
+    //! Number of threads between checking async_overflow and pushing to
+    //! async_ring. Entering the overflow mode waits for them, so that no
+    //! event reaches the ring after one was added to async_queue.
+    std::atomic<unsigned> async_ring_writers;
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
-    //! List of events added by other threads to this event queue.
+    //! Overflow list of events added by other threads to this event queue.
     std::list<Event*> async_queue;
 
+    //! Number of asynchronous insertions into this queue, indexed by
+    //! the main event queue of the thread that made them. Each entry is
+    //! only ever written by the thread running the corresponding queue.
+    std::vector<Counter> asyncInsertCount;
+
+    //! Host time spent processing the events of this queue. Only
+    //! updated when gem5 is built with EVENTQ_PROFILE.
+    EventProfiler _profile;
+
+    //! Picks the events whose execution is recorded in the timeline.
+    timeline::Sampler timelineSampler;
+
+    /**
+     * Optional calendar index over the bins of the queue.
+     *
+     * Each bucket covers a power-of-two number of ticks and, modulo
+     * the number of buckets, points to the latest bin (i.e., the top
+     * event of an 'in bin' list) that falls within it. Insertion and
+     * removal walk the bin list starting from the closest preceding
+     * bucket instead of the head of the queue, which keeps their cost
+     * close to constant when many events are scheduled in the near
+     * future. Buckets only ever point to bins that are in the queue,
+     * so the index never changes the order in which events are
+     * serviced. An empty vector disables the index.
+     */
+    std::vector<Event *> calendar;
+    unsigned calendarShift;
+
+    //! Number of buckets searched backwards for a usable bin before
+    //! falling back to a walk from the head of the queue.
+    static constexpr unsigned calendarLookback = 8;
+
+    Event *&
+    calendarBucket(const Event *event)
+    {
+        return calendar[(event->when() >> calendarShift) &
+                        (calendar.size() - 1)];
+    }
+
+    //! Find a bin that is strictly before the event. Falls back to
+    //! the head of the queue, which must be before the event.
+    Event *calendarFind(const Event *event);
+
+    //! Record a new bin in the calendar.
+    void
+    calendarAdd(Event *top)
+    {
+        Event *&bucket = calendarBucket(top);
+        if (!bucket || *bucket < *top)
+            bucket = top;
+    }
+
+    //! Update the calendar when the top event of a bin changes. A null
+    //! new_top means that the bin has been removed.
+    void
+    calendarReplace(Event *old_top, Event *new_top)
+    {
+        if (calendar.empty())
+            return;
+        Event *&bucket = calendarBucket(old_top);
+        if (bucket == old_top)
+            bucket = new_top;
+    }
+
     /**
      * Lock protecting event handling.
      *
@@ -900,6 +1018,48 @@ class EventQueue
 
     bool debugVerify() const;
 
+    /**
+     * Enable, resize or disable the calendar index of this queue.
+     *
+     * The index is rebuilt from the events currently in the queue, so
+     * this may be called at any time by the thread owning the queue.
+     *
+     * @param buckets Number of buckets (a power of two), 0 to disable.
+     * @param width Number of ticks covered by a bucket (a power of two).
+     */
+    void setCalendar(uint32_t buckets, Tick width);
+
+    /**
+     * Tick of the earliest event in this queue, including asynchronous
+     * insertions that have not been merged yet, or MaxTick if there is
+     * none. Only meaningful while the owning thread is blocked (e.g.,
+     * on a global barrier).
+     */
+    Tick earliestTick();
+
+    //! Index of this queue in mainEventQueue, or -1 if it isn't a main
+    //! event queue.
+    int index() const { return queueIndex; }
+
+    /**
+     * Number of events that the thread running the main event queue
+     * src has scheduled asynchronously on this queue.
+     */
+    Counter
+    asyncInserts(uint32_t src) const
+    {
+        return src < asyncInsertCount.size() ? asyncInsertCount[src] : 0;
+    }
+
+    void
+    resetAsyncInserts()
+    {
+        std::fill(asyncInsertCount.begin(), asyncInsertCount.end(), 0);
+    }
+
+    EventProfiler &profile() { return _profile; }
+    const EventProfiler &profile() const { return _profile; }
+
     /**
      * Function for moving events from the async_queue to the main queue.
      */
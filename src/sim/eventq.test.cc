@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "config/eventq_profile.hh"
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Event that reschedules itself according to an arrival pattern. */
+class PatternEvent : public Event
+{
+  public:
+    using Pattern = std::function<Tick(std::mt19937_64 &)>;
+
+    PatternEvent(EventQueue &_eq, int _id, std::vector<int> &_trace,
+                 const Pattern &_pattern, std::mt19937_64 &_rng,
+                 Priority p)
+        : Event(p), eq(_eq), id(_id), trace(_trace), pattern(_pattern),
+          rng(_rng)
+    {}
+
+    void
+    process() override
+    {
+        trace.push_back(id);
+        eq.schedule(this, eq.getCurTick() + pattern(rng));
+    }
+
+  private:
+    EventQueue &eq;
+    int id;
+    std::vector<int> &trace;
+    const Pattern &pattern;
+    std::mt19937_64 &rng;
+};
+
+/**
+ * Event-arrival patterns modelled on traces of typical simulations:
+ * clocked objects waking up on shared clock edges, memory responses a
+ * short, variable latency into the future, and occasional far-future
+ * timers.
+ */
+const Tick clockPeriod = 500;
+
+Tick
+clockedPattern(std::mt19937_64 &rng)
+{
+    return clockPeriod * (1 + rng() % 2);
+}
+
+Tick
+memoryPattern(std::mt19937_64 &rng)
+{
+    return clockPeriod * (1 + rng() % 200) + rng() % clockPeriod;
+}
+
+Tick
+mixedPattern(std::mt19937_64 &rng)
+{
+    const auto r = rng() % 100;
+    if (r < 60)
+        return clockedPattern(rng);
+    else if (r < 99)
+        return memoryPattern(rng);
+    else
+        return clockPeriod * 100000;
+}
+
+/**
+ * Run a set of self-rescheduling events on a queue and record the
+ * order in which they are serviced.
+ */
+std::vector<int>
+runPattern(uint32_t buckets, const PatternEvent::Pattern &pattern,
+           int num_events, Tick duration)
+{
+    std::vector<int> trace;
+    EventQueue eq("test_queue");
+    eq.setCalendar(buckets, 1024);
+    curEventQueue(&eq);
+
+    std::mt19937_64 rng(42);
+    std::vector<std::unique_ptr<PatternEvent>> events;
+    for (int i = 0; i < num_events; ++i) {
+        events.emplace_back(new PatternEvent(eq, i, trace, pattern, rng,
+                                             (i % 3) - 1));
+        eq.schedule(events.back().get(), pattern(rng));
+    }
+
+    eq.serviceEvents(duration);
+
+    EXPECT_TRUE(eq.debugVerify());
+    for (auto &event : events)
+        eq.deschedule(event.get());
+
+    curEventQueue(nullptr);
+    return trace;
+}
+
+} // anonymous namespace
+
+/** The calendar index must never change the order events are serviced in */
+TEST(EventQueueCalendarTest, SameOrder)
+{
+    for (auto pattern : { clockedPattern, memoryPattern, mixedPattern }) {
+        std::vector<int> list = runPattern(0, pattern, 64, 2000000);
+        std::vector<int> calendar = runPattern(256, pattern, 64, 2000000);
+        ASSERT_FALSE(list.empty());
+        EXPECT_EQ(list, calendar);
+    }
+}
+
+/** Descheduling events in arbitrary order must keep the index coherent */
+TEST(EventQueueCalendarTest, Deschedule)
+{
+    EventQueue eq("test_queue");
+    eq.setCalendar(16, 64);
+    curEventQueue(&eq);
+
+    std::vector<int> trace;
+    std::mt19937_64 rng(1);
+    PatternEvent::Pattern pattern = memoryPattern;
+    std::vector<std::unique_ptr<PatternEvent>> events;
+    for (int i = 0; i < 256; ++i) {
+        events.emplace_back(new PatternEvent(eq, i, trace, pattern, rng, 0));
+        eq.schedule(events.back().get(), (rng() % 64) * 32);
+    }
+    ASSERT_TRUE(eq.debugVerify());
+
+    for (int i = 0; i < 256; i += 2) {
+        eq.deschedule(events[i].get());
+        ASSERT_TRUE(eq.debugVerify());
+    }
+    for (int i = 1; i < 256; i += 4) {
+        eq.reschedule(events[i].get(), (rng() % 64) * 32);
+        ASSERT_TRUE(eq.debugVerify());
+    }
+
+    // The calendar can be resized or disabled while events are pending
+    eq.setCalendar(4, 4096);
+    ASSERT_TRUE(eq.debugVerify());
+    eq.setCalendar(0, 0);
+    ASSERT_TRUE(eq.debugVerify());
+
+    for (auto &event : events) {
+        if (event->scheduled())
+            eq.deschedule(event.get());
+    }
+    EXPECT_TRUE(eq.empty());
+    curEventQueue(nullptr);
+}
+
+/** The order must not depend on how many events share the calendar */
+TEST(EventQueueCalendarTest, Population)
+{
+    for (int num_events : { 16, 256, 4096 }) {
+        std::vector<int> list =
+            runPattern(0, mixedPattern, num_events, 2000000);
+        std::vector<int> calendar =
+            runPattern(4096, mixedPattern, num_events, 2000000);
+        EXPECT_EQ(list, calendar);
+    }
+}
+
+/**
+ * Events scheduled by one thread on another thread's queue must be
+ * merged in the order they were scheduled, also when the lock-free ring
+ * fills up and insertions overflow to the locked list.
+ */
+TEST(EventQueueAsyncTest, Order)
+{
+    constexpr int num_producers = 4;
+    constexpr int events_per_producer = 3 * 4096;
+
+    EventQueue eq("test_queue");
+    curEventQueue(&eq);
+    inParallelMode = true;
+
+    std::vector<std::pair<int, int>> trace;
+    std::vector<std::vector<std::unique_ptr<EventFunctionWrapper>>>
+        events(num_producers);
+    for (int p = 0; p < num_producers; ++p) {
+        for (int i = 0; i < events_per_producer; ++i) {
+            events[p].emplace_back(new EventFunctionWrapper(
+                [&trace, p, i]() { trace.emplace_back(p, i); },
+                "async_event"));
+        }
+    }
+
+    std::atomic<int> done = 0;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&eq, &events, &done, p]() {
+            curEventQueue(nullptr);
+            for (auto &event : events[p])
+                eq.schedule(event.get(), 100);
+            ++done;
+        });
+    }
+
+    // Merge concurrently with the producers, so that the ring keeps
+    // entering and leaving the overflow mode
+    while (done.load() != num_producers)
+        eq.handleAsyncInsertions();
+    for (auto &producer : producers)
+        producer.join();
+    eq.handleAsyncInsertions();
+    inParallelMode = false;
+
+    eq.serviceEvents(100);
+    ASSERT_EQ(trace.size(), num_producers * events_per_producer);
+
+    // Events with the same time and priority are serviced last in,
+    // first out
+    std::vector<int> last(num_producers, events_per_producer);
+    for (auto [p, i] : trace) {
+        ASSERT_LT(i, last[p]);
+        last[p] = i;
+    }
+    curEventQueue(nullptr);
+}
+
+#if EVENTQ_PROFILE
+/** Processed events are attributed to the object owning them */
+TEST(EventQueueProfileTest, Attribution)
+{
+    EventQueue eq("test_queue");
+    curEventQueue(&eq);
+
+    int count = 0;
+    EventFunctionWrapper a([&count]() { ++count; }, "system.a");
+    EventFunctionWrapper b([&count]() { ++count; }, "system.b");
+    for (Tick t = 1; t <= 10; ++t) {
+        eq.schedule(&a, t * 10);
+        if (t % 2)
+            eq.schedule(&b, t * 10 + 1);
+        eq.serviceEvents(t * 10 + 1);
+    }
+    EXPECT_EQ(count, 15);
+
+    std::unordered_map<std::string, EventProfiler::Entry> table;
+    eq.profile().merge(table);
+    EXPECT_EQ(table["system.a"].events, 10);
+    EXPECT_EQ(table["system.b"].events, 5);
+
+    eq.profile().reset();
+    table.clear();
+    eq.profile().merge(table);
+    EXPECT_EQ(table["system.a"].events, 0);
+
+    curEventQueue(nullptr);
+}
+
+/** An event allocated where a freed one was is attributed to its owner */
+TEST(EventQueueProfileTest, ReusedAddress)
+{
+    EventQueue eq("test_queue");
+    curEventQueue(&eq);
+
+    alignas(EventFunctionWrapper) unsigned char
+        storage[sizeof(EventFunctionWrapper)];
+    auto *a = new (storage) EventFunctionWrapper([]() {}, "system.a");
+    eq.schedule(a, 10);
+    eq.serviceEvents(10);
+    a->~EventFunctionWrapper();
+
+    auto *b = new (storage) EventFunctionWrapper([]() {}, "system.b");
+    eq.schedule(b, 20);
+    eq.serviceEvents(20);
+    b->~EventFunctionWrapper();
+
+    std::unordered_map<std::string, EventProfiler::Entry> table;
+    eq.profile().merge(table);
+    EXPECT_EQ(table["system.a"].events, 1);
+    EXPECT_EQ(table["system.b"].events, 1);
+
+    curEventQueue(nullptr);
+}
+#endif
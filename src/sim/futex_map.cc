@@ -28,6 +28,8 @@
 
 #include <sim/futex_map.hh>
 
+#include "base/logging.hh"
+
 namespace gem5
 {
 
@@ -49,142 +51,167 @@ WaiterState::checkMask(int wakeup_bitmask) const
     return bitmask & wakeup_bitmask;
 }
 
+FutexMap::Waiter::Waiter(ThreadContext *_tc, int _bitmask)
+      : WaiterState(_tc, _bitmask) { }
+
+FutexMap::WaiterQueue *
+FutexMap::findQueue(Addr addr, uint64_t tgid)
+{
+    auto it = queues.find(FutexKey(addr, tgid));
+    return it == queues.end() ? nullptr : &it->second;
+}
+
 void
-FutexMap::suspend(Addr addr, uint64_t tgid, ThreadContext *tc)
+FutexMap::enqueue(WaiterQueue &queue, Waiter &waiter)
 {
-    suspend_bitset(addr, tgid, tc, 0xffffffff);
+    waiter.queue = &queue;
+    waiter.prev = queue.tail;
+    waiter.next = nullptr;
+    if (queue.tail)
+        queue.tail->next = &waiter;
+    else
+        queue.head = &waiter;
+    queue.tail = &waiter;
+
+    if (!waiter.matchesAny())
+        queue.partial++;
 }
 
-int
-FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
+void
+FutexMap::dequeue(Waiter &waiter)
 {
-    FutexKey key(addr, tgid);
-    auto it = find(key);
+    WaiterQueue &queue = *waiter.queue;
 
-    if (it == end())
-        return 0;
+    if (waiter.prev)
+        waiter.prev->next = waiter.next;
+    else
+        queue.head = waiter.next;
+    if (waiter.next)
+        waiter.next->prev = waiter.prev;
+    else
+        queue.tail = waiter.prev;
+
+    if (!waiter.matchesAny())
+        queue.partial--;
+
+    waiter.queue = nullptr;
+    waiter.prev = waiter.next = nullptr;
+
+    if (!queue.head)
+        queues.erase(queue.key);
+}
+
+int
+FutexMap::wakeQueue(WaiterQueue &queue, int bitmask, int count)
+{
+    // A plain wake or a wake with a full bitmask matches every waiter,
+    // and so does any wake if no waiter uses a partial bitmask. The
+    // ones to wake are then simply the first ones in the queue.
+    const bool all_match =
+        bitmask == -1 || (queue.partial == 0 && bitmask != 0);
 
     int woken_up = 0;
-    auto &waiterList = it->second;
-
-    while (!waiterList.empty() && woken_up < count) {
-        // Threads may be woken up by access to locked
-        // memory addresses outside of syscalls, so we
-        // must only count threads that were actually
-        // woken up by this syscall.
-        auto& tc = waiterList.front().tc;
-        tc->activate();
-        woken_up++;
-        waiterList.pop_front();
-        waitingTcs.erase(tc);
-    }
+    Waiter *waiter = queue.head;
+
+    while (waiter && woken_up < count) {
+        // The queue goes away with its last waiter, so get the next
+        // waiter before waking this one.
+        Waiter *next = waiter->next;
+
+        if (all_match || waiter->checkMask(bitmask)) {
+            // Threads may be woken up by access to locked
+            // memory addresses outside of syscalls, so we
+            // must only count threads that were actually
+            // woken up by this syscall.
+            ThreadContext *tc = waiter->tc;
+            dequeue(*waiter);
+            waiters.erase(tc);
+            tc->activate();
+            woken_up++;
+        }
 
-    if (waiterList.empty())
-        erase(it);
+        waiter = next;
+    }
 
     return woken_up;
 }
 
+void
+FutexMap::suspend(Addr addr, uint64_t tgid, ThreadContext *tc)
+{
+    suspend_bitset(addr, tgid, tc, 0xffffffff);
+}
+
+int
+FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
+{
+    WaiterQueue *queue = findQueue(addr, tgid);
+    return queue ? wakeQueue(*queue, -1, count) : 0;
+}
+
 void
 FutexMap::suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
                int bitmask)
 {
     FutexKey key(addr, tgid);
-    auto it = find(key);
+    WaiterQueue &queue = queues.try_emplace(key, key).first->second;
 
-    if (it == end()) {
-        WaiterList waiterList {WaiterState(tc, bitmask)};
-        insert({key, waiterList});
-    } else {
-        it->second.push_back(WaiterState(tc, bitmask));
-    }
-    waitingTcs.emplace(tc);
+    auto res = waiters.try_emplace(tc, tc, bitmask);
+    panic_if(!res.second, "Thread context %d is already waiting on a futex.",
+             tc->contextId());
+    enqueue(queue, res.first->second);
 
     /** Suspend the thread context */
     tc->suspend();
 }
 
 int
-FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
+FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask, int count)
 {
-    FutexKey key(addr, tgid);
-    auto it = find(key);
-
-    if (it == end())
-        return 0;
-
-    int woken_up = 0;
-
-    auto &waiterList = it->second;
-    auto iter = waiterList.begin();
-
-    while (iter != waiterList.end()) {
-        WaiterState& waiter = *iter;
-
-        if (waiter.checkMask(bitmask)) {
-            waiter.tc->activate();
-            waitingTcs.erase(waiter.tc);
-            iter = waiterList.erase(iter);
-            woken_up++;
-        } else {
-            ++iter;
-        }
-    }
-
-    if (waiterList.empty())
-        erase(it);
-
-    return woken_up;
+    WaiterQueue *queue = findQueue(addr, tgid);
+    return queue ? wakeQueue(*queue, bitmask, count) : 0;
 }
 
 int
 FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
 {
-    FutexKey key1(addr1, tgid);
-    auto it1 = find(key1);
-
-    if (it1 == end())
+    if (!findQueue(addr1, tgid))
         return 0;
 
-    int woken_up = 0;
-    auto &waiterList1 = it1->second;
+    int woken_up = wakeup(addr1, tgid, count);
 
-    while (!waiterList1.empty() && woken_up < count) {
-        waiterList1.front().tc->activate();
-        waiterList1.pop_front();
-        woken_up++;
-    }
+    WaiterQueue *queue1 = findQueue(addr1, tgid);
+    if (!queue1 || count2 <= 0)
+        return woken_up;
 
-    WaiterList tmpList;
     int requeued = 0;
-
-    while (!waiterList1.empty() && requeued < count2) {
-      auto w = waiterList1.front();
-      waiterList1.pop_front();
-      tmpList.push_back(w);
-      requeued++;
+    if (addr1 == addr2) {
+        // Requeuing onto the same futex leaves the queue as it is.
+        for (Waiter *w = queue1->head; w && requeued < count2; w = w->next)
+            requeued++;
+        return woken_up + requeued;
     }
 
     FutexKey key2(addr2, tgid);
-    auto it2 = find(key2);
-
-    if (it2 == end() && requeued > 0) {
-        insert({key2, tmpList});
-    } else {
-        it2->second.insert(it2->second.end(),
-                           tmpList.begin(), tmpList.end());
+    WaiterQueue &queue2 = queues.try_emplace(key2, key2).first->second;
+
+    while (requeued < count2) {
+        Waiter &waiter = *queue1->head;
+        const bool last = !waiter.next;
+        dequeue(waiter);
+        enqueue(queue2, waiter);
+        requeued++;
+        if (last)
+            break;
     }
 
-    if (waiterList1.empty())
-        erase(it1);
-
     return woken_up + requeued;
 }
 
 bool
 FutexMap::is_waiting(ThreadContext *tc)
 {
-    return waitingTcs.find(tc) != waitingTcs.end();
+    return waiters.find(tc) != waiters.end();
 }
 
 } // namespace gem5
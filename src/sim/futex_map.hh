@@ -29,8 +29,8 @@
 #ifndef __FUTEX_MAP_HH__
 #define __FUTEX_MAP_HH__
 
+#include <limits>
 #include <unordered_map>
-#include <unordered_set>
 
 #include <cpu/thread_context.hh>
 
@@ -99,14 +99,21 @@ class WaiterState
      * a waking thread and this thread's internal bitmask is non-zero
      */
     bool checkMask(int wakeup_bitmask) const;
-};
 
-typedef std::list<WaiterState> WaiterList;
+    /** Does this waiter match any wakeup bitmask? */
+    bool matchesAny() const { return bitmask == -1; }
+};
 
 /**
  * FutexMap class holds a map of all futexes used in the system
+ *
+ * Every futex with waiters has its own FIFO queue, linked through the
+ * per thread waiter entries. Waking, requeuing and removing a thread
+ * is therefore constant time per thread and never scans the other
+ * waiters, unless a bitset wake has to skip waiters whose bitmask does
+ * not match.
  */
-class FutexMap : public std::unordered_map<FutexKey, WaiterList>
+class FutexMap
 {
   public:
     /** Inserts a futex into the map with one waiting TC */
@@ -118,7 +125,12 @@ class FutexMap : public std::unordered_map<FutexKey, WaiterList>
     void suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
                    int bitmask);
 
-    int wakeup_bitset(Addr addr, uint64_t tgid, int bitmask);
+    /**
+     * Wakes up at most count of the threads waiting on a futex with a
+     * bitmask that intersects the given one.
+     */
+    int wakeup_bitset(Addr addr, uint64_t tgid, int bitmask,
+                      int count=std::numeric_limits<int>::max());
 
     /**
      * This operation wakes a given number (val) of waiters. If there are
@@ -139,8 +151,49 @@ class FutexMap : public std::unordered_map<FutexKey, WaiterList>
     bool is_waiting(ThreadContext *tc);
 
   private:
+    struct WaiterQueue;
+
+    /** A waiting thread, linked into the queue of its futex */
+    struct Waiter : public WaiterState
+    {
+        Waiter(ThreadContext *_tc, int _bitmask);
+
+        WaiterQueue *queue = nullptr;
+        Waiter *prev = nullptr;
+        Waiter *next = nullptr;
+    };
+
+    /** The waiters of a futex in the order they started waiting */
+    struct WaiterQueue
+    {
+        WaiterQueue(const FutexKey &_key) : key(_key) {}
+
+        const FutexKey key;
+        Waiter *head = nullptr;
+        Waiter *tail = nullptr;
+        /** Number of waiters that do not match any bitmask */
+        size_t partial = 0;
+    };
+
+    /** Queues of all futexes with waiters */
+    std::unordered_map<FutexKey, WaiterQueue> queues;
+
+    /** All waiting threads, a thread waits on at most one futex */
+    std::unordered_map<ThreadContext *, Waiter> waiters;
 
-    std::unordered_set<ThreadContext *> waitingTcs;
+    WaiterQueue *findQueue(Addr addr, uint64_t tgid);
+
+    /** Append a waiter to a queue */
+    void enqueue(WaiterQueue &queue, Waiter &waiter);
+
+    /** Unlink a waiter, the queue must not be used if it became empty */
+    void dequeue(Waiter &waiter);
+
+    /**
+     * Wake up at most count waiters of a queue that match the bitmask.
+     * The queue is destroyed if it becomes empty.
+     */
+    int wakeQueue(WaiterQueue &queue, int bitmask, int count);
 };
 
 } // namespace gem5
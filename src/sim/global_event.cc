@@ -158,7 +158,19 @@ void
 GlobalSyncEvent::process()
 {
     if (repeat) {
-        schedule(curTick() + repeat);
+        Tick base = curTick();
+        if (skipIdle) {
+            // All queues are waiting on the barrier. Nothing can happen
+            // before the earliest pending event, and nothing that
+            // happens then can reach another queue sooner than a
+            // quantum later, so the idle period can be skipped.
+            Tick earliest = MaxTick;
+            for (uint32_t i = 0; i < numMainEventQueues; ++i)
+                earliest = std::min(earliest,
+                                    mainEventQueue[i]->earliestTick());
+            base = std::max(base, std::min(earliest, MaxTick - repeat));
+        }
+        schedule(base + repeat);
     }
 }
 
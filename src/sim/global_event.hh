@@ -222,11 +222,18 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     };
 
     GlobalSyncEvent(Priority p, Flags f)
-        : Base(p, f), repeat(0)
+        : Base(p, f), repeat(0), skipIdle(false)
     { }
 
-    GlobalSyncEvent(Tick when, Tick _repeat, Priority p, Flags f)
-        : Base(p, f), repeat(_repeat)
+    /**
+     * @param _skip_idle If set, the next synchronization is scheduled
+     * relative to the earliest pending event of any queue rather than
+     * to the current tick. This is only safe when repeat is not larger
+     * than the smallest latency between two queues.
+     */
+    GlobalSyncEvent(Tick when, Tick _repeat, Priority p, Flags f,
+                    bool _skip_idle = false)
+        : Base(p, f), repeat(_repeat), skipIdle(_skip_idle)
     {
         schedule(when);
     }
@@ -238,6 +245,7 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     const char *description() const;
 
     Tick repeat;
+    bool skipIdle;
 };
 
 } // namespace gem5
@@ -144,6 +144,16 @@ exitNowHandler(int sigtype)
     getEventQueue(0)->wakeup();
 }
 
+/// Debug message history signal handler.
+void
+dumpTraceHandler(int sigtype)
+{
+    async_event = true;
+    async_tracedump = true;
+    /* Wake up some event queue to handle event */
+    getEventQueue(0)->wakeup();
+}
+
 /// Abort signal handler.
 void
 abortHandler(int sigtype)
@@ -230,5 +240,11 @@ void restoreSigInt()
     sigaction(SIGINT, &old_int_sa, NULL);
 }
 
+void initSigQuit()
+{
+    // Dump the history of debug messages kept in memory (Ctrl-\)
+    installSignalHandler(SIGQUIT, dumpTraceHandler);
+}
+
 
 } // namespace gem5
@@ -36,12 +36,16 @@ void dumpStatsHandler(int sigtype);
 void dumprstStatsHandler(int sigtype);
 void exitNowHandler(int sigtype);
 void abortHandler(int sigtype);
+void dumpTraceHandler(int sigtype);
 void initSignals();
 
 // separate out sigint handler so that we can restore the python one
 void initSigInt();
 void restoreSigInt();
 
+// dump the debug message history on SIGQUIT, only used with a trace ring
+void initSigQuit();
+
 } // namespace gem5
 
 #endif // __SIM_INIT_SIGNALS_HH__
@@ -37,54 +37,126 @@
 
 #include "sim/linear_solver.hh"
 
+#include <algorithm>
+#include <cmath>
+
 namespace gem5
 {
 
+std::vector <double>
+LinearSystem::rhs() const
+{
+    std::vector <double> b(matrix.size());
+    for (unsigned i = 0; i < matrix.size(); i++)
+        b[i] = -matrix[i][matrix[i].cnt()];
+    return b;
+}
+
 std::vector <double>
 LinearSystem::solve() const
 {
-    // Solve using gauss elimination, not ideal for big matrices
-    std::vector < LinearEquation > smatrix = this->matrix;
-
-    unsigned order = smatrix.size();
-    for (unsigned row = 0; row < order - 1; row++) {
-        // Look for a non-zero row, and swap
-        for (unsigned i = row; i < order; i++) {
-            if (smatrix[i][row] != 0.0f) {
-                if (i != row) {
-                    LinearEquation tmp = smatrix[i];
-                    smatrix[i] = smatrix[row];
-                    smatrix[row] = tmp;
-                }
-                break;
-            }
+    return FactorizedLinearSystem(*this).solve(rhs());
+}
+
+FactorizedLinearSystem::FactorizedLinearSystem(const LinearSystem &ls)
+    : order(ls.size()), coeffs(order), perm(order), lower(order),
+      upper(order), diag(order)
+{
+    // Dense working copy of the coefficients, the factorization is only
+    // computed when the system changes so its cost doesn't matter much
+    std::vector < std::vector <double> > a(order);
+    for (unsigned i = 0; i < order; i++) {
+        a[i].resize(order);
+        for (unsigned j = 0; j < order; j++) {
+            a[i][j] = ls[i][j];
+            if (a[i][j] != 0.0)
+                coeffs[i].push_back({j, a[i][j]});
         }
+        perm[i] = i;
+    }
 
-        // Divide row by leading number to make it 1.0
-        smatrix[row] *= (1.0f / smatrix[row][row]);
+    for (unsigned col = 0; col < order; col++) {
+        // Pick the largest pivot to keep the factorization stable
+        unsigned pivot = col;
+        for (unsigned i = col + 1; i < order; i++) {
+            if (std::fabs(a[i][col]) > std::fabs(a[pivot][col]))
+                pivot = i;
+        }
+        if (pivot != col) {
+            std::swap(a[pivot], a[col]);
+            std::swap(perm[pivot], perm[col]);
+        }
+
+        // Eliminate the column from the rows below, the multipliers are
+        // kept in place as the lower factor
+        for (unsigned i = col + 1; i < order; i++) {
+            if (a[i][col] == 0.0)
+                continue;
+            const double m = a[i][col] / a[col][col];
+            a[i][col] = m;
+            for (unsigned j = col + 1; j < order; j++)
+                a[i][j] -= m * a[col][j];
+        }
+    }
 
-        // Add it (properly scaled) to the rows below
-        for (unsigned i = row + 1; i < order; i++) {
-            LinearEquation t = smatrix[row];
-            t *= -1.0f * smatrix[i][row];
-            smatrix[i] = smatrix[i] + t;
+    for (unsigned i = 0; i < order; i++) {
+        for (unsigned j = 0; j < i; j++) {
+            if (a[i][j] != 0.0)
+                lower[i].push_back({j, a[i][j]});
+        }
+        diag[i] = a[i][i];
+        for (unsigned j = i + 1; j < order; j++) {
+            if (a[i][j] != 0.0)
+                upper[i].push_back({j, a[i][j]});
         }
     }
+}
 
-    // smatrix is now a triangular matrix with diagonal being 1
-    // Just backproagate variable values from order-1 till 0
-    std::vector <double> ret(order, 0.0f);
-    for (int row = order - 1; row >= 0; row--) {
-        // Unknown value
-        ret[row] = -smatrix[row][smatrix[row].cnt()] / smatrix[row][row];
-        // Propagate variable in the cnt term
-        for (int i = row - 1; i >= 0; i--) {
-            smatrix[i][smatrix[i].cnt()] += ret[row] * smatrix[i][row];
-            smatrix[i][row] = 0.0f;
+bool
+FactorizedLinearSystem::sameCoefficients(const LinearSystem &ls) const
+{
+    if (ls.size() != order)
+        return false;
+
+    for (unsigned i = 0; i < order; i++) {
+        auto entry = coeffs[i].begin();
+        for (unsigned j = 0; j < order; j++) {
+            const double c = ls[i][j];
+            if (entry != coeffs[i].end() && entry->col == j) {
+                if (entry->val != c)
+                    return false;
+                ++entry;
+            } else if (c != 0.0) {
+                return false;
+            }
         }
     }
+    return true;
+}
+
+std::vector <double>
+FactorizedLinearSystem::solve(const std::vector <double> &b) const
+{
+    assert(b.size() == order);
+
+    // Forward substitution, L*y = P*b
+    std::vector <double> x(order);
+    for (unsigned i = 0; i < order; i++) {
+        double v = b[perm[i]];
+        for (auto &e : lower[i])
+            v -= e.val * x[e.col];
+        x[i] = v;
+    }
+
+    // Backward substitution, U*x = y
+    for (int i = order - 1; i >= 0; i--) {
+        double v = x[i];
+        for (auto &e : upper[i])
+            v -= e.val * x[e.col];
+        x[i] = v / diag[i];
+    }
 
-    return ret;
+    return x;
 }
 
 } // namespace gem5
@@ -85,6 +85,11 @@ class LinearEquation
         return eq[unkw];
     }
 
+    double operator[] (unsigned unkw) const {
+        assert(unkw < eq.size());
+        return eq[unkw];
+    }
+
     // Get a string representation
     std::string toStr() const {
         std::ostringstream oss;
@@ -121,6 +126,17 @@ class LinearSystem
         return matrix[eq];
     }
 
+    const LinearEquation & operator[] (unsigned eq) const {
+        assert(eq < matrix.size());
+        return matrix[eq];
+    }
+
+    // Number of unknowns (and equations)
+    unsigned size() const { return matrix.size(); }
+
+    // Right hand side b of the system written as A*x = b
+    std::vector <double> rhs() const;
+
     std::string toStr() const {
         std::string r;
         for (auto & eq: matrix)
@@ -134,6 +150,46 @@ class LinearSystem
     std::vector < LinearEquation > matrix;
 };
 
+/**
+ * The LU factorization (with partial pivoting) of the coefficients of a
+ * linear system. It is used to solve repeatedly systems that only differ
+ * in their constant terms, like the nodal equations of a circuit whose
+ * topology doesn't change. The factors are kept in a sparse row format,
+ * so once the system is factorized each solve only costs a forward and a
+ * backward substitution over the non-zero entries.
+ */
+class FactorizedLinearSystem
+{
+  public:
+    FactorizedLinearSystem(const LinearSystem &ls);
+
+    // Check whether ls has the coefficients that were factorized
+    bool sameCoefficients(const LinearSystem &ls) const;
+
+    // Solve A*x = b for the factorized A
+    std::vector <double> solve(const std::vector <double> &b) const;
+
+  private:
+    struct Entry
+    {
+        unsigned col;
+        double val;
+    };
+    typedef std::vector <Entry> SparseRow;
+
+    unsigned order;
+    /** Original coefficients, to detect changes in the system */
+    std::vector <SparseRow> coeffs;
+    /** Row of the original system used as i-th pivot row */
+    std::vector <unsigned> perm;
+    /** Strictly lower part of L (its diagonal is 1) */
+    std::vector <SparseRow> lower;
+    /** Strictly upper part of U */
+    std::vector <SparseRow> upper;
+    /** Diagonal of U */
+    std::vector <double> diag;
+};
+
 } // namespace gem5
 
 #endif
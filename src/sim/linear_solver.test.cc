@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "sim/linear_solver.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+// Kirchhoff equations of a chain of nodes linked by unit conductances,
+// with the first node tied to ground and a source injected at the last one
+LinearSystem
+chain(unsigned nodes, double source)
+{
+    LinearSystem ls(nodes);
+    for (unsigned i = 0; i < nodes; i++) {
+        ls[i][i] = -1.0;
+        if (i > 0) {
+            ls[i][i - 1] = 1.0;
+            ls[i][i] -= 1.0;
+        }
+        if (i + 1 < nodes) {
+            ls[i][i + 1] = 1.0;
+            ls[i][i] -= 1.0;
+        }
+    }
+    ls[nodes - 1][nodes] = source;
+    return ls;
+}
+
+} // anonymous namespace
+
+TEST(LinearSolverTest, Solve)
+{
+    // 2*x0 + x1 - 5 = 0, x0 - x1 - 1 = 0
+    LinearSystem ls(2);
+    ls[0][0] = 2.0;
+    ls[0][1] = 1.0;
+    ls[0][2] = -5.0;
+    ls[1][0] = 1.0;
+    ls[1][1] = -1.0;
+    ls[1][2] = -1.0;
+
+    std::vector<double> x = ls.solve();
+    ASSERT_EQ(2, x.size());
+    EXPECT_NEAR(2.0, x[0], 1e-12);
+    EXPECT_NEAR(1.0, x[1], 1e-12);
+}
+
+TEST(LinearSolverTest, Pivoting)
+{
+    // The first coefficient is zero, so a row swap is needed
+    LinearSystem ls(2);
+    ls[0][1] = 1.0;
+    ls[0][2] = -3.0;
+    ls[1][0] = 1.0;
+    ls[1][1] = 1.0;
+    ls[1][2] = -4.0;
+
+    std::vector<double> x = ls.solve();
+    EXPECT_NEAR(1.0, x[0], 1e-12);
+    EXPECT_NEAR(3.0, x[1], 1e-12);
+}
+
+TEST(LinearSolverTest, ReuseFactorization)
+{
+    const unsigned nodes = 50;
+    LinearSystem ls = chain(nodes, 1.0);
+    FactorizedLinearSystem fls(ls);
+
+    // Changing the constant terms keeps the factorization valid
+    LinearSystem other = chain(nodes, 2.0);
+    other[0][nodes] = 0.5;
+    EXPECT_TRUE(fls.sameCoefficients(other));
+
+    std::vector<double> x = fls.solve(other.rhs());
+    std::vector<double> ref = other.solve();
+    ASSERT_EQ(nodes, x.size());
+    for (unsigned i = 0; i < nodes; i++) {
+        EXPECT_NEAR(ref[i], x[i], 1e-9);
+
+        // Check that the nodal equations hold
+        double res = other[i][nodes];
+        for (unsigned j = 0; j < nodes; j++)
+            res += other[i][j] * x[j];
+        EXPECT_NEAR(0.0, res, 1e-9);
+    }
+}
+
+TEST(LinearSolverTest, CoefficientChange)
+{
+    LinearSystem ls = chain(10, 1.0);
+    FactorizedLinearSystem fls(ls);
+
+    LinearSystem other = chain(10, 1.0);
+    other[3][4] = 0.5;
+    EXPECT_FALSE(fls.sameCoefficients(other));
+
+    other = chain(10, 1.0);
+    other[2][7] = 1.0;
+    EXPECT_FALSE(fls.sameCoefficients(other));
+
+    EXPECT_FALSE(fls.sameCoefficients(chain(11, 1.0)));
+}
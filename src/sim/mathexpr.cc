@@ -38,6 +38,7 @@
 #include "sim/mathexpr.hh"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <regex>
 #include <string>
@@ -158,14 +159,122 @@ MathExpr::eval(const Node *n, EvalCallback fn) const {
     else if (n->op == sVariable)
         return fn(n->variable);
 
+    return apply(n->op, eval(n->l, fn), eval(n->r, fn));
+}
+
+double
+MathExpr::apply(Operator op, double l, double r) const
+{
     for (auto & opt : ops)
-        if (opt.op == n->op)
-            return opt.fn( eval(n->l, fn), eval(n->r, fn) );
+        if (opt.op == op)
+            return opt.fn(l, r);
 
     panic("Invalid node!\n");
     return 0;
 }
 
+MathExpr::Program
+MathExpr::compile(ResolveCallback fn) const
+{
+    Program prog;
+    prog.depth = compile(root, fn, prog);
+    return prog;
+}
+
+unsigned
+MathExpr::compile(const Node *n, ResolveCallback &fn, Program &prog) const
+{
+    if (!n) {
+        // Missing operand, like the left one of a negation
+        prog.code.push_back({sValue, 0, 0});
+        return 1;
+    } else if (n->op == sValue) {
+        prog.code.push_back({sValue, 0, n->value});
+        return 1;
+    } else if (n->op == sVariable) {
+        prog.code.push_back({sVariable, fn(n->variable), 0});
+        return 1;
+    }
+
+    panic_if(n->op == nInvalid, "Invalid node!\n");
+
+    unsigned l_depth = 0;
+    const size_t l_start = prog.code.size();
+    if (n->op != uNeg)
+        l_depth = compile(n->l, fn, prog);
+    const size_t r_start = prog.code.size();
+    const unsigned r_depth = compile(n->r, fn, prog);
+
+    // Fold the operation if both operands are constant
+    const bool l_const = n->op == uNeg ||
+        (r_start == l_start + 1 && prog.code[l_start].op == sValue);
+    if (l_const && prog.code.size() == r_start + 1 &&
+            prog.code[r_start].op == sValue) {
+        const double l = n->op == uNeg ? 0 : prog.code[l_start].value;
+        const double r = prog.code[r_start].value;
+        prog.code.resize(l_start);
+        prog.code.push_back({sValue, 0, apply(n->op, l, r)});
+        return 1;
+    }
+
+    prog.code.push_back({n->op, 0, 0});
+    return std::max(l_depth, r_depth + (n->op == uNeg ? 0 : 1));
+}
+
+double
+MathExpr::Program::eval(const double *vars) const
+{
+    // Expressions are rarely deep, avoid allocating in the common case
+    constexpr unsigned InlineDepth = 16;
+    std::array<double, InlineDepth> inline_stack;
+    std::vector<double> heap_stack;
+    double *stack = inline_stack.data();
+    if (depth > InlineDepth) {
+        heap_stack.resize(depth);
+        stack = heap_stack.data();
+    }
+
+    unsigned sp = 0;
+    for (const auto &i : code) {
+        switch (i.op) {
+          case sValue:
+            stack[sp++] = i.value;
+            break;
+          case sVariable:
+            stack[sp++] = vars[i.var];
+            break;
+          case uNeg:
+            stack[sp - 1] = -stack[sp - 1];
+            break;
+          case bAdd:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] + stack[sp];
+            break;
+          case bSub:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] - stack[sp];
+            break;
+          case bMul:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] * stack[sp];
+            break;
+          case bDiv:
+            sp--;
+            stack[sp - 1] = stack[sp - 1] / stack[sp];
+            break;
+          case bPow:
+            sp--;
+            stack[sp - 1] = std::pow(stack[sp - 1], stack[sp]);
+            break;
+          default:
+            panic("Invalid instruction!\n");
+        }
+    }
+
+    assert(sp == 1);
+    return stack[0];
+}
+
 std::string
 MathExpr::toStr(Node *n, std::string prefix) const {
     std::string ret;
@@ -49,11 +49,56 @@ namespace gem5
 
 class MathExpr
 {
+  private:
+    enum Operator
+    {
+        bAdd, bSub, bMul, bDiv, bPow, uNeg, sValue, sVariable, nInvalid
+    };
+
   public:
 
     MathExpr(std::string expr);
 
     typedef std::function<double(std::string)> EvalCallback;
+    typedef std::function<unsigned(const std::string &)> ResolveCallback;
+
+    /**
+     * An expression compiled into a flat postfix program. The variables
+     * are resolved to indices into a table of values when the program is
+     * built, so an evaluation neither walks the expression tree nor looks
+     * up any variable by name.
+     */
+    class Program
+    {
+      public:
+        /**
+         * Evaluates the program
+         *
+         * @param vars Table of variable values, indexed as returned by the
+         * resolve callback used to compile the program
+         *
+         * @return The value for the expression
+         */
+        double eval(const double *vars) const;
+
+        /** Number of instructions of the program */
+        size_t size() const { return code.size(); }
+
+      private:
+        friend class MathExpr;
+
+        struct Instr
+        {
+            Operator op;
+            unsigned var;
+            double value;
+        };
+
+        std::vector<Instr> code;
+
+        /** Maximum depth of the evaluation stack */
+        unsigned depth = 0;
+    };
 
     /**
      * Prints an ASCII representation of the expression tree
@@ -71,6 +116,16 @@ class MathExpr
      */
     double eval(EvalCallback fn) const { return eval(root, fn); }
 
+    /**
+     * Compiles the expression. Constant sub-expressions are folded.
+     *
+     * @param fn A callback function to map each variable to an index
+     * into the table of values the program is evaluated with
+     *
+     * @return The compiled program
+     */
+    Program compile(ResolveCallback fn) const;
+
     /**
      * Return all variables in the this expression.
      *
@@ -88,11 +143,6 @@ class MathExpr
     }
 
   private:
-    enum Operator
-    {
-        bAdd, bSub, bMul, bDiv, bPow, uNeg, sValue, sVariable, nInvalid
-    };
-
     // Match operators
     const int MAX_PRIO = 4;
     typedef double (*binOp)(double, double);
@@ -144,6 +194,13 @@ class MathExpr
     /** Eval a node */
     double eval(const Node *n, EvalCallback fn) const;
 
+    /** Apply an operator to its operands */
+    double apply(Operator op, double l, double r) const;
+
+    /** Emit the code of a node, returns the stack depth it needs */
+    unsigned compile(const Node *n, ResolveCallback &fn,
+                     Program &prog) const;
+
     /** Return all variable reachable from a node to a vector of
      * strings */
     void getVariables(const Node *n, std::vector<std::string> &vars) const;
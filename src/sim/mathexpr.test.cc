@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sim/mathexpr.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+std::map<std::string, double> testVars = {
+    {"a", 2.0}, {"b", -3.5}, {"c.d", 0.25}, {"x_1", 7.0},
+};
+
+double
+evalTree(const MathExpr &expr)
+{
+    return expr.eval([](std::string v) { return testVars.at(v); });
+}
+
+double
+evalProgram(const MathExpr &expr)
+{
+    std::vector<double> values;
+    MathExpr::Program prog = expr.compile(
+        [&](const std::string &v) {
+            values.push_back(testVars.at(v));
+            return unsigned(values.size() - 1);
+        });
+    return prog.eval(values.data());
+}
+
+} // anonymous namespace
+
+TEST(MathExprTest, Constant)
+{
+    MathExpr expr("1.5 * 4 - 2 ^ 3");
+    EXPECT_DOUBLE_EQ(-2.0, evalTree(expr));
+    EXPECT_DOUBLE_EQ(-2.0, evalProgram(expr));
+}
+
+TEST(MathExprTest, ConstantFolding)
+{
+    // The whole expression folds to a single value
+    MathExpr expr("(2 + 3) * -(4 / 8)");
+    MathExpr::Program prog = expr.compile(
+        [](const std::string &) { return 0u; });
+    EXPECT_EQ(1, prog.size());
+    EXPECT_DOUBLE_EQ(-2.5, prog.eval(nullptr));
+
+    // Only the constant sub-expression is folded
+    MathExpr var_expr("a * (2 + 3)");
+    double a = 3.0;
+    prog = var_expr.compile([](const std::string &) { return 0u; });
+    EXPECT_EQ(3, prog.size());
+    EXPECT_DOUBLE_EQ(15.0, prog.eval(&a));
+}
+
+TEST(MathExprTest, MatchesTreeEvaluation)
+{
+    const std::vector<std::string> exprs = {
+        "a",
+        "-a",
+        "a + b * c.d",
+        "(a + b) * c.d",
+        "a - b - x_1",
+        "a / b / c.d",
+        "a ^ 2 + -b ^ 2",
+        "-(a * x_1) + 3 * (b - (c.d + 1) / (a + 0.5))",
+        "((((a + 1) * (b + 2)) - ((c.d + 3) * (x_1 + 4))) / 2) ^ 0.5",
+    };
+
+    for (auto &e : exprs) {
+        MathExpr expr(e);
+        const double tree = evalTree(expr);
+        const double prog = evalProgram(expr);
+        if (std::isnan(tree))
+            EXPECT_TRUE(std::isnan(prog)) << e;
+        else
+            EXPECT_DOUBLE_EQ(tree, prog) << e;
+    }
+}
+
+TEST(MathExprTest, DeepExpression)
+{
+    // Deeper than the inline evaluation stack
+    std::string e = "a";
+    for (int i = 0; i < 40; i++)
+        e = "x_1 - (" + e + ")";
+
+    MathExpr expr(e);
+    EXPECT_DOUBLE_EQ(evalTree(expr), evalProgram(expr));
+}
@@ -29,6 +29,7 @@
 #include "sim/mem_state.hh"
 
 #include <cassert>
+#include <iterator>
 
 #include "arch/generic/mmu.hh"
 #include "debug/Vma.hh"
@@ -67,7 +68,7 @@ MemState::operator=(const MemState &in)
     _stackMin = in._stackMin;
     _nextThreadStackBase = in._nextThreadStackBase;
     _mmapEnd = in._mmapEnd;
-    _vmaList = in._vmaList; /* This assignment does a deep copy. */
+    _vmaMap = in._vmaMap; /* This assignment does a deep copy. */
 
     return *this;
 }
@@ -78,15 +79,97 @@ MemState::resetOwner(Process *owner)
     _ownerProcess = owner;
 }
 
+std::map<Addr, VMA>::iterator
+MemState::findVma(Addr addr)
+{
+    auto vma = _vmaMap.upper_bound(addr);
+    if (vma != _vmaMap.begin()) {
+        auto prev = std::prev(vma);
+        if (prev->second.end() > addr)
+            return prev;
+    }
+    return vma;
+}
+
+void
+MemState::removeVmas(Addr start_addr, Addr end_addr)
+{
+    const AddrRange range(start_addr, end_addr);
+
+    auto vma = findVma(start_addr);
+    while (vma != _vmaMap.end() && vma->second.start() < end_addr) {
+        if (vma->second.isStrictSuperset(range)) {
+            DPRINTF(Vma, "memstate: split vma [0x%x - 0x%x] into "
+                    "[0x%x - 0x%x] and [0x%x - 0x%x]\n",
+                    vma->second.start(), vma->second.end(),
+                    vma->second.start(), start_addr,
+                    end_addr, vma->second.end());
+            /**
+             * Need to split into two smaller regions.
+             * Create a clone of the old VMA and slice it to the left.
+             */
+            VMA right = vma->second;
+            right.sliceRegionLeft(end_addr);
+
+            /**
+             * Slice old VMA to encapsulate the left region.
+             */
+            vma->second.sliceRegionRight(start_addr);
+            _vmaMap.try_emplace(end_addr, std::move(right));
+
+            /**
+             * Region cannot be in any more VMA, because it is completely
+             * contained in this one!
+             */
+            break;
+        } else if (vma->second.isSubset(range)) {
+            DPRINTF(Vma, "memstate: destroying vma [0x%x - 0x%x]\n",
+                    vma->second.start(), vma->second.end());
+            /**
+             * Need to nuke the existing VMA.
+             */
+            vma = _vmaMap.erase(vma);
+        } else if (vma->second.start() < start_addr) {
+            DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
+                    "into [0x%x - 0x%x]\n",
+                    vma->second.start(), vma->second.end(),
+                    vma->second.start(), start_addr);
+            /**
+             * Overlaps from the right.
+             */
+            vma->second.sliceRegionRight(start_addr);
+            vma++;
+        } else {
+            DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
+                    "into [0x%x - 0x%x]\n",
+                    vma->second.start(), vma->second.end(),
+                    end_addr, vma->second.end());
+            /**
+             * Overlaps from the left, so its start and key move to the
+             * end of the range. Nothing can follow it in the range.
+             */
+            auto node = _vmaMap.extract(vma);
+            node.mapped().sliceRegionLeft(end_addr);
+            node.key() = end_addr;
+            _vmaMap.insert(std::move(node));
+            break;
+        }
+    }
+}
+
 bool
 MemState::isUnmapped(Addr start_addr, Addr length)
 {
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
-    for (const auto &vma : _vmaList) {
-        if (vma.intersects(range))
-            return false;
-    }
+
+    /**
+     * The VMAs do not overlap, so only the first one ending after the
+     * start of the range can be the lowest one intersecting it.
+     */
+    auto vma = findVma(start_addr);
+    if (vma != _vmaMap.end() && vma->second.intersects(range))
+        return false;
 
     /**
      * In case someone skips the VMA interface and just directly maps memory
@@ -182,80 +265,16 @@ MemState::mapRegion(Addr start_addr, Addr length,
     assert(isUnmapped(start_addr, length));
 
     /**
-     * Record the region in our list structure.
+     * Record the region in our map structure.
      */
-    _vmaList.emplace_back(AddrRange(start_addr, start_addr + length),
-                          _pageBytes, region_name, sim_fd, offset);
+    _vmaMap.try_emplace(start_addr, AddrRange(start_addr, start_addr + length),
+                        _pageBytes, region_name, sim_fd, offset);
 }
 
 void
 MemState::unmapRegion(Addr start_addr, Addr length)
 {
-    Addr end_addr = start_addr + length;
-    const AddrRange range(start_addr, end_addr);
-
-    auto vma = std::begin(_vmaList);
-    while (vma != std::end(_vmaList)) {
-        if (vma->isStrictSuperset(range)) {
-            DPRINTF(Vma, "memstate: split vma [0x%x - 0x%x] into "
-                    "[0x%x - 0x%x] and [0x%x - 0x%x]\n",
-                    vma->start(), vma->end(),
-                    vma->start(), start_addr,
-                    end_addr, vma->end());
-            /**
-             * Need to split into two smaller regions.
-             * Create a clone of the old VMA and slice it to the right.
-             */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionRight(start_addr);
-
-            /**
-             * Slice old VMA to encapsulate the left region.
-             */
-            vma->sliceRegionLeft(end_addr);
-
-            /**
-             * Region cannot be in any more VMA, because it is completely
-             * contained in this one!
-             */
-            break;
-        } else if (vma->isSubset(range)) {
-            DPRINTF(Vma, "memstate: destroying vma [0x%x - 0x%x]\n",
-                    vma->start(), vma->end());
-            /**
-             * Need to nuke the existing VMA.
-             */
-            vma = _vmaList.erase(vma);
-
-            continue;
-
-        } else if (vma->intersects(range)) {
-            /**
-             * Trim up the existing VMA.
-             */
-            if (vma->start() < start_addr) {
-                DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
-                        "into [0x%x - 0x%x]\n",
-                        vma->start(), vma->end(),
-                        vma->start(), start_addr);
-                /**
-                 * Overlaps from the right.
-                 */
-                vma->sliceRegionRight(start_addr);
-            } else {
-                DPRINTF(Vma, "memstate: resizing vma [0x%x - 0x%x] "
-                        "into [0x%x - 0x%x]\n",
-                        vma->start(), vma->end(),
-                        end_addr, vma->end());
-                /**
-                 * Overlaps from the left.
-                 */
-                vma->sliceRegionLeft(end_addr);
-            }
-        }
-
-        vma++;
-    }
+    removeVmas(start_addr, start_addr + length);
 
     /**
      * TLBs need to be flushed to remove any stale mappings from regions
@@ -291,71 +310,78 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
-    auto vma = std::begin(_vmaList);
-    while (vma != std::end(_vmaList)) {
-        if (vma->isStrictSuperset(range)) {
+    /**
+     * Cut the parts of the VMAs inside the range out of the map, leaving
+     * the parts outside of it in place.
+     */
+    std::vector<VMA> moved;
+    auto vma = findVma(start_addr);
+    while (vma != _vmaMap.end() && vma->second.start() < end_addr) {
+        if (vma->second.isStrictSuperset(range)) {
             /**
-             * Create clone of the old VMA and slice right.
+             * Create clone of the old VMA and slice left.
              */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionRight(start_addr);
+            VMA right = vma->second;
+            right.sliceRegionLeft(end_addr);
 
             /**
-             * Create clone of the old VMA and slice it left.
+             * Create clone of the old VMA and slice it left and right to
+             * adjust the file backing.
              */
-            _vmaList.push_back(*vma);
-            _vmaList.back().sliceRegionLeft(end_addr);
+            moved.push_back(vma->second);
+            moved.back().sliceRegionLeft(start_addr);
+            moved.back().sliceRegionRight(end_addr);
 
             /**
-             * Slice the old VMA left and right to adjust the file backing,
-             * then overwrite the virtual addresses!
+             * Slice the old VMA to keep the region to the left.
              */
-            vma->sliceRegionLeft(start_addr);
-            vma->sliceRegionRight(end_addr);
-            vma->remap(new_start_addr);
+            vma->second.sliceRegionRight(start_addr);
+            _vmaMap.try_emplace(end_addr, std::move(right));
 
             /**
              * The region cannot be in any more VMAs, because it is
              * completely contained in this one!
              */
             break;
-        } else if (vma->isSubset(range)) {
+        } else if (vma->second.isSubset(range)) {
             /**
-             * Just go ahead and remap it!
+             * Just go ahead and move it!
              */
-            vma->remap(vma->start() - start_addr + new_start_addr);
-        } else if (vma->intersects(range)) {
+            moved.push_back(std::move(vma->second));
+            vma = _vmaMap.erase(vma);
+        } else if (vma->second.start() < start_addr) {
             /**
-             * Create a clone of the old VMA.
+             * Overlaps from the right.
              */
-            _vmaList.push_back(*vma);
-
-            if (vma->start() < start_addr) {
-                /**
-                 * Overlaps from the right.
-                 */
-                _vmaList.back().sliceRegionRight(start_addr);
-
-                /**
-                 * Remap the old region.
-                 */
-                vma->sliceRegionLeft(start_addr);
-                vma->remap(new_start_addr);
-            } else {
-                /**
-                 * Overlaps from the left.
-                 */
-                _vmaList.back().sliceRegionLeft(end_addr);
-
-                /**
-                 * Remap the old region.
-                 */
-                vma->sliceRegionRight(end_addr);
-                vma->remap(new_start_addr + vma->start() - start_addr);
-            }
+            moved.push_back(vma->second);
+            moved.back().sliceRegionLeft(start_addr);
+            vma->second.sliceRegionRight(start_addr);
+            vma++;
+        } else {
+            /**
+             * Overlaps from the left, so the part which stays behind
+             * starts at the end of the range.
+             */
+            moved.push_back(vma->second);
+            moved.back().sliceRegionRight(end_addr);
+
+            auto node = _vmaMap.extract(vma);
+            node.mapped().sliceRegionLeft(end_addr);
+            node.key() = end_addr;
+            _vmaMap.insert(std::move(node));
+            break;
         }
+    }
 
-        vma++;
+    /**
+     * Like a fixed mremap on Linux, the remapped regions replace whatever
+     * was mapped at their destination.
+     */
+    removeVmas(new_start_addr, new_start_addr + length);
+    for (auto &region : moved) {
+        region.remap(region.start() - start_addr + new_start_addr);
+        Addr region_start = region.start();
+        _vmaMap.try_emplace(region_start, std::move(region));
     }
 
     /**
@@ -395,31 +421,31 @@ MemState::fixupFault(Addr vaddr)
      * Check if we are accessing a mapped virtual address. If so then we
      * just haven't allocated it a physical page yet and can do so here.
      */
-    for (const auto &vma : _vmaList) {
-        if (vma.contains(vaddr)) {
-            Addr vpage_start = roundDown(vaddr, _pageBytes);
-            _ownerProcess->allocateMem(vpage_start, _pageBytes);
+    auto vma_it = findVma(vaddr);
+    if (vma_it != _vmaMap.end() && vma_it->second.contains(vaddr)) {
+        const VMA &vma = vma_it->second;
+        Addr vpage_start = roundDown(vaddr, _pageBytes);
+        _ownerProcess->allocateMem(vpage_start, _pageBytes);
 
+        /**
+         * We are assuming that fresh pages are zero-filled, so there is
+         * no need to zero them out when there is no backing file.
+         * This assumption will not hold true if/when physical pages
+         * are recycled.
+         */
+        if (vma.hasHostBuf()) {
             /**
-             * We are assuming that fresh pages are zero-filled, so there is
-             * no need to zero them out when there is no backing file.
-             * This assumption will not hold true if/when physical pages
-             * are recycled.
+             * Write the memory for the host buffer contents for all
+             * ThreadContexts associated with this process.
              */
-            if (vma.hasHostBuf()) {
-                /**
-                 * Write the memory for the host buffer contents for all
-                 * ThreadContexts associated with this process.
-                 */
-                for (auto &cid : _ownerProcess->contextIds) {
-                    auto *tc = _ownerProcess->system->threads[cid];
-                    SETranslatingPortProxy
-                        virt_mem(tc, SETranslatingPortProxy::Always);
-                    vma.fillMemPages(vpage_start, _pageBytes, virt_mem);
-                }
+            for (auto &cid : _ownerProcess->contextIds) {
+                auto *tc = _ownerProcess->system->threads[cid];
+                SETranslatingPortProxy
+                    virt_mem(tc, SETranslatingPortProxy::Always);
+                vma.fillMemPages(vpage_start, _pageBytes, virt_mem);
             }
-            return true;
         }
+        return true;
     }
 
     /**
@@ -486,7 +512,7 @@ MemState::printVmaList()
 {
     std::stringstream file_content;
 
-    for (auto vma : _vmaList) {
+    for (auto &[vma_start, vma] : _vmaMap) {
         std::stringstream line;
         line << std::hex << vma.start() << "-";
         line << std::hex << vma.end() << " ";
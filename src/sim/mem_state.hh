@@ -32,7 +32,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 
-#include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -197,9 +197,9 @@ class MemState : public Serializable
         paramOut(cp, "mmapEnd", _mmapEnd);
 
         ScopedCheckpointSection sec(cp, "vmalist");
-        paramOut(cp, "size", _vmaList.size());
+        paramOut(cp, "size", _vmaMap.size());
         int count = 0;
-        for (auto vma : _vmaList) {
+        for (auto &[vma_start, vma] : _vmaMap) {
             ScopedCheckpointSection sec(cp, csprintf("Vma%d", count++));
             paramOut(cp, "name", vma.getName());
             if (vma.hasHostBuf()) {
@@ -240,8 +240,8 @@ class MemState : public Serializable
             }
             paramIn(cp, "addrRangeStart", start);
             paramIn(cp, "addrRangeEnd", end);
-            _vmaList.emplace_back(AddrRange(start, end), _pageBytes, name,
-                                  host_fd, offset);
+            _vmaMap.try_emplace(start, AddrRange(start, end), _pageBytes,
+                                name, host_fd, offset);
             close(host_fd);
         }
     }
@@ -263,6 +263,24 @@ class MemState : public Serializable
      */
     System * system() const;
 
+    /**
+     * Find the first VMA which ends after an address, i.e. the only
+     * candidate for being the lowest VMA which contains or follows it.
+     *
+     * @param addr The address to look up.
+     * @return Iterator to the VMA, or the end of the map if there is none.
+     */
+    std::map<Addr, VMA>::iterator findVma(Addr addr);
+
+    /**
+     * Remove an address range from the VMAs, splitting or trimming the
+     * ones which partially overlap it. The page tables are not updated.
+     *
+     * @param start_addr Start of the range to remove.
+     * @param end_addr End of the range to remove.
+     */
+    void removeVmas(Addr start_addr, Addr end_addr);
+
     /**
      * Owner process of MemState. Used to manipulate page tables.
      */
@@ -278,18 +296,17 @@ class MemState : public Serializable
     Addr _mmapEnd;
 
     /**
-     * The _vmaList member is a list of virtual memory areas in the target
+     * The _vmaMap member holds the virtual memory areas in the target
      * application space that have been allocated by the target. In most
      * operating systems, lazy allocation is used and these structures (or
      * equivalent ones) are used to track the valid address ranges.
      *
-     * This could use a more efficient data structure like an interval
-     * tree, but it is unclear whether the vmas will be modified often enough
-     * for the improvement in lookup time to matter. Unmapping VMAs currently
-     * modifies the list while iterating so the STL container must either
-     * support this or the unmapping method must be changed.
+     * The VMAs never overlap, and are keyed by their start address. This
+     * lets page faults, mmaps and unmaps find the VMAs they touch in
+     * logarithmic time, as workloads such as JITs and allocators can
+     * create tens of thousands of mappings.
      */
-    std::list<VMA> _vmaList;
+    std::map<Addr, VMA> _vmaMap;
 };
 
 } // namespace gem5
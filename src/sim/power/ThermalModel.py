@@ -102,6 +102,11 @@ class ThermalModel(ClockedObject):
     step = Param.Float(
         0.01, "Simulation step (in seconds) for thermal simulation"
     )
+    async_step = Param.Bool(
+        False,
+        "Solve the thermal equations on a helper thread. The temperatures "
+        "computed in a step are applied at the beginning of the next one.",
+    )
 
     def populate(self):
         if not hasattr(self, "_capacitors"):
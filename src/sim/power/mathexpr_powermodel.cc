@@ -37,6 +37,7 @@
 
 #include "sim/power/mathexpr_powermodel.hh"
 
+#include <algorithm>
 #include <string>
 
 #include "base/statistics.hh"
@@ -71,15 +72,81 @@ MathExprPowerModel::startup()
             statsMap[var] = info;
         }
     }
+
+    // Compile the expressions so that evaluating them doesn't need any
+    // lookup of the stats
+    for (auto [expr, compiled] : {std::make_pair(&dyn_expr, &dyn_prog),
+                                  std::make_pair(&st_expr, &st_prog)}) {
+        std::vector<unsigned> &used = compiled->vars;
+        compiled->prog = expr->compile(
+            [this, expr, &used](const std::string &var) {
+                unsigned idx = resolve(*expr, var);
+                if (std::find(used.begin(), used.end(), idx) == used.end())
+                    used.push_back(idx);
+                return idx;
+            });
+    }
+    values.resize(variables.size());
+}
+
+unsigned
+MathExprPowerModel::resolve(const MathExpr &expr, const std::string &var)
+{
+    using namespace statistics;
+
+    auto it = varIndex.find(var);
+    if (it != varIndex.end())
+        return it->second;
+
+    Variable v = {Variable::Scalar, nullptr, nullptr};
+    if (var == "temp") {
+        v.kind = Variable::Temp;
+    } else if (var == "voltage") {
+        v.kind = Variable::Voltage;
+    } else if (var == "clock_period") {
+        v.kind = Variable::ClockPeriod;
+    } else {
+        const Info *info = statsMap.at(var);
+        // Only these stat types are supported right now
+        if ((v.scalar = dynamic_cast<const ScalarInfo *>(info))) {
+            v.kind = Variable::Scalar;
+        } else if ((v.formula = dynamic_cast<const FormulaInfo *>(info))) {
+            v.kind = Variable::Formula;
+        } else {
+            fatal("Unsupported type for stat %s in expression:\n%s\n",
+                  var, expr.toStr());
+        }
+    }
+
+    variables.push_back(v);
+    return varIndex[var] = variables.size() - 1;
+}
+
+double
+MathExprPowerModel::read(const Variable &var) const
+{
+    switch (var.kind) {
+      case Variable::Temp:
+        return _temp.toCelsius();
+      case Variable::Voltage:
+        return clocked_object->voltage();
+      case Variable::ClockPeriod:
+        return clocked_object->clockPeriod();
+      case Variable::Scalar:
+        return var.scalar->value();
+      case Variable::Formula:
+        return var.formula->total();
+    }
+    panic("Unknown variable type!\n");
 }
 
 double
-MathExprPowerModel::eval(const MathExpr &expr) const
+MathExprPowerModel::eval(const CompiledExpr &expr) const
 {
-    return expr.eval(
-        std::bind(&MathExprPowerModel::getStatValue,
-                  this, std::placeholders::_1)
-        );
+    // Only refresh the variables this expression reads
+    for (auto i : expr.vars)
+        values[i] = read(variables[i]);
+    return expr.prog.eval(values.data());
 }
 
 double
@@ -39,6 +39,7 @@
 #define __SIM_MATHEXPR_POWERMODEL_PM_HH__
 
 #include <unordered_map>
+#include <vector>
 
 #include "params/MathExprPowerModel.hh"
 #include "sim/mathexpr.hh"
@@ -50,6 +51,8 @@ namespace gem5
 namespace statistics
 {
     class Info;
+    class ScalarInfo;
+    class FormulaInfo;
 }
 
 /**
@@ -68,14 +71,14 @@ class MathExprPowerModel : public PowerModelState
      *
      * @return Power (Watts) consumed by this object (dynamic component)
      */
-    double getDynamicPower() const override { return eval(dyn_expr); }
+    double getDynamicPower() const override { return eval(dyn_prog); }
 
     /**
      * Get the static power consumption.
      *
      * @return Power (Watts) consumed by this object (static component)
      */
-    double getStaticPower() const override { return eval(st_expr); }
+    double getStaticPower() const override { return eval(st_prog); }
 
     /**
      * Get the value for a variable (maps to a stat)
@@ -90,18 +93,49 @@ class MathExprPowerModel : public PowerModelState
     void regStats() override;
 
   private:
+    /** A variable of the expressions, resolved when compiling them */
+    struct Variable
+    {
+        enum Kind { Temp, Voltage, ClockPeriod, Scalar, Formula };
+
+        Kind kind;
+        const statistics::ScalarInfo *scalar;
+        const statistics::FormulaInfo *formula;
+    };
+
+    /** Expression compiled against the variables of this object */
+    struct CompiledExpr
+    {
+        MathExpr::Program prog;
+        /** Variables used by the expression */
+        std::vector<unsigned> vars;
+    };
+
     /**
-     * Evaluate an expression in the context of this object, fatal if
-     * evaluation fails.
+     * Evaluate an expression in the context of this object.
      *
-     * @param expr Expression to evaluate
+     * @param expr Compiled expression to evaluate
      * @return Value of expression.
      */
-    double eval(const MathExpr &expr) const;
+    double eval(const CompiledExpr &expr) const;
+
+    /** Resolve a variable, fatal if it doesn't map to a supported stat */
+    unsigned resolve(const MathExpr &expr, const std::string &var);
+
+    /** Read the current value of a variable */
+    double read(const Variable &var) const;
 
     // Math expressions for dynamic and static power
     MathExpr dyn_expr, st_expr;
 
+    // The expressions compiled at startup
+    CompiledExpr dyn_prog, st_prog;
+
+    // Variables of both expressions and their current values
+    std::vector<Variable> variables;
+    mutable std::vector<double> values;
+    std::unordered_map<std::string, unsigned> varIndex;
+
     // Map that contains relevant stats for this power model
     std::unordered_map<std::string, const statistics::Info*> statsMap;
 };
@@ -84,6 +84,8 @@ class ThermalDomain : public SimObject, public ThermalEntity
     ThermalNode * getNode() const { return node; }
 
     /** Get nodal equation imposed by this node */
+    std::vector<ThermalNode *> getNodes() const override { return {node}; }
+
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
 
@@ -38,6 +38,8 @@
 #ifndef __SIM_THERMAL_ENTITY_HH__
 #define __SIM_THERMAL_ENTITY_HH__
 
+#include <vector>
+
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -57,6 +59,10 @@ class ThermalEntity
     // Get the equation given a node and a step in seconds (assuming N nodes)
     virtual LinearEquation getEquation(ThermalNode *tn, unsigned n,
                                        double step) const = 0;
+
+    // Get the nodes whose nodal equation this entity contributes to, the
+    // equation of any other node is empty
+    virtual std::vector<ThermalNode *> getNodes() const = 0;
 };
 
 } // namespace gem5
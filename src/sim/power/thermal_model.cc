@@ -143,39 +143,71 @@ ThermalCapacitor::getEquation(ThermalNode * n, unsigned nnodes,
  * ThermalModel
  */
 ThermalModel::ThermalModel(const Params &p)
-    : ClockedObject(p), stepEvent([this]{ doStep(); }, name()), _step(p.step)
+    : ClockedObject(p), stepEvent([this]{ doStep(); }, name()), _step(p.step),
+      asyncStep(p.async_step)
 {
 }
 
-void
-ThermalModel::doStep()
+ThermalModel::~ThermalModel()
+{
+    // The helper thread uses the solver, wait until it is done
+    if (pendingTemps.valid())
+        pendingTemps.wait();
+}
+
+LinearSystem
+ThermalModel::buildSystem() const
 {
-    // Calculate new temperatures!
     // For each node in the system, create the kirchhoff nodal equation
     LinearSystem ls(eq_nodes.size());
     for (unsigned i = 0; i < eq_nodes.size(); i++) {
         auto n = eq_nodes[i];
-        LinearEquation node_equation (eq_nodes.size());
-        for (auto e : entities) {
-            LinearEquation eq = e->getEquation(n, eq_nodes.size(), _step);
-            node_equation = node_equation + eq;
-        }
-        ls[i] = node_equation;
+        for (auto e : node_entities[i])
+            ls[i] = ls[i] + e->getEquation(n, eq_nodes.size(), _step);
     }
+    return ls;
+}
 
-    // Get temperatures for this iteration
-    std::vector <double> temps = ls.solve();
+void
+ThermalModel::applyTemperatures(const std::vector<double> &temps)
+{
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->temp = Temperature::fromKelvin(temps[i]);
 
-    // Schedule next computation
-    schedule(stepEvent, curTick() + sim_clock::as_int::s * _step);
-
     // Notify everybody
     for (auto dom : domains)
         dom->emitUpdate();
 }
 
+void
+ThermalModel::doStep()
+{
+    // The temperatures of the previous step are needed to build the
+    // equations of this one
+    if (pendingTemps.valid())
+        applyTemperatures(pendingTemps.get());
+
+    // Calculate new temperatures!
+    LinearSystem ls = buildSystem();
+    if (!solver || !solver->sameCoefficients(ls))
+        solver = std::make_unique<FactorizedLinearSystem>(ls);
+
+    // Get temperatures for this iteration
+    if (asyncStep) {
+        // Only the power has to be read from the simulated system, the
+        // helper thread works on its own copy of the constant terms and
+        // the results are applied at the next step
+        const FactorizedLinearSystem *s = solver.get();
+        pendingTemps = std::async(std::launch::async,
+            [s, b = ls.rhs()] { return s->solve(b); });
+    } else {
+        applyTemperatures(solver->solve(ls.rhs()));
+    }
+
+    // Schedule next computation
+    schedule(stepEvent, curTick() + sim_clock::as_int::s * _step);
+}
+
 void
 ThermalModel::startup()
 {
@@ -205,6 +237,20 @@ ThermalModel::startup()
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->id = i;
 
+    // Only the entities connected to a node take part in its equation
+    node_entities.resize(eq_nodes.size());
+    for (auto e : entities) {
+        for (auto n : e->getNodes()) {
+            if (n->isref)
+                continue;
+            assert(n->id >= 0 && n->id < eq_nodes.size());
+            auto &node_ents = node_entities[n->id];
+            // Both ends of an entity could be the same node
+            if (node_ents.empty() || node_ents.back() != e)
+                node_ents.push_back(e);
+        }
+    }
+
     // Schedule first thermal update
     schedule(stepEvent, curTick() + sim_clock::as_int::s * _step);
 }
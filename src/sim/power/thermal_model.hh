@@ -38,10 +38,13 @@
 #ifndef __SIM_THERMAL_MODEL_HH__
 #define __SIM_THERMAL_MODEL_HH__
 
+#include <future>
+#include <memory>
 #include <vector>
 
 #include "base/temperature.hh"
 #include "sim/clocked_object.hh"
+#include "sim/linear_solver.hh"
 #include "sim/power/thermal_domain.hh"
 #include "sim/power/thermal_entity.hh"
 #include "sim/power/thermal_node.hh"
@@ -74,6 +77,12 @@ class ThermalResistor : public SimObject, public ThermalEntity
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
 
+    std::vector<ThermalNode *>
+    getNodes() const override
+    {
+        return {node1, node2};
+    }
+
   private:
     /* Resistance value in K/W */
     const double _resistance;
@@ -95,6 +104,12 @@ class ThermalCapacitor : public SimObject, public ThermalEntity
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
 
+    std::vector<ThermalNode *>
+    getNodes() const override
+    {
+        return {node1, node2};
+    }
+
     void setNodes(ThermalNode * n1, ThermalNode * n2) {
         node1 = n1;
         node2 = n2;
@@ -126,6 +141,9 @@ class ThermalReference : public SimObject, public ThermalEntity
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
 
+    // References don't impose any nodal equation
+    std::vector<ThermalNode *> getNodes() const override { return {}; }
+
     /* Fixed temperature value */
     const Temperature _temperature;
     /* Nodes connected to the resistor */
@@ -146,6 +164,7 @@ class ThermalModel : public ClockedObject
   public:
     typedef ThermalModelParams Params;
     ThermalModel(const Params &p);
+    ~ThermalModel();
 
     void addDomain(ThermalDomain * d);
     void addReference(ThermalReference * r);
@@ -160,6 +179,11 @@ class ThermalModel : public ClockedObject
     void doStep();
 
   private:
+    /** Build the nodal equations of the current step */
+    LinearSystem buildSystem() const;
+
+    /** Update the node temperatures and notify the domains */
+    void applyTemperatures(const std::vector<double> &temps);
 
     /* Keep track of all components used for the thermal model */
     std::vector <ThermalDomain *> domains;
@@ -173,11 +197,27 @@ class ThermalModel : public ClockedObject
     std::vector <ThermalNode*> nodes;
     std::vector <ThermalNode*> eq_nodes;
 
+    /* Entities contributing to the nodal equation of each eq_node */
+    std::vector <std::vector <ThermalEntity *>> node_entities;
+
     /** Stepping event to update the model values */
     EventFunctionWrapper stepEvent;
 
     /** Step in seconds for thermal updates */
     const double _step;
+
+    /**
+     * Factorization of the nodal equations. The conductances don't change
+     * between steps, so it is only recomputed if the coefficients of the
+     * system do.
+     */
+    std::unique_ptr<FactorizedLinearSystem> solver;
+
+    /** Solve the system on a helper thread */
+    const bool asyncStep;
+
+    /** Temperatures being computed by the helper thread */
+    std::future<std::vector<double>> pendingTemps;
 };
 
 } // namespace gem5
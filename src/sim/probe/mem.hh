@@ -62,6 +62,8 @@ struct PacketInfo
     Request::FlagsType flags;
     Addr pc;
     RequestorID id;
+    /** Identifies the packet, a response has the id of its request */
+    PacketId pktId;
 
     explicit PacketInfo(const PacketPtr& pkt) :
         cmd(pkt->cmd),
@@ -69,7 +71,8 @@ struct PacketInfo
         size(pkt->getSize()),
         flags(pkt->req->getFlags()),
         pc(pkt->req->hasPC() ? pkt->req->getPC() : 0),
-        id(pkt->req->requestorId())  { }
+        id(pkt->req->requestorId()),
+        pktId(pkt->id)  { }
 };
 
 /**
@@ -69,8 +69,9 @@ ProbeListenerObject::~ProbeListenerObject()
     listeners.clear();
 }
 
-ProbeListener::ProbeListener(ProbeManager *_manager, const std::string &_name)
-    : manager(_manager), name(_name)
+ProbeListener::ProbeListener(ProbeManager *_manager, const std::string &_name,
+                             bool _batched)
+    : manager(_manager), name(_name), batched(_batched)
 {
     manager->addListener(name, *this);
 }
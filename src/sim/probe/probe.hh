@@ -65,9 +65,11 @@
 #define __SIM_PROBE_PROBE_HH__
 
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "base/compiler.hh"
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "sim/sim_object.hh"
 
@@ -126,16 +128,24 @@ class ProbeListenerObject : public SimObject
 class ProbeListener
 {
   public:
-    ProbeListener(ProbeManager *manager, const std::string &name);
+    ProbeListener(ProbeManager *manager, const std::string &name,
+                  bool batched=false);
     virtual ~ProbeListener();
     ProbeListener(const ProbeListener& other) = delete;
     ProbeListener& operator=(const ProbeListener& other) = delete;
     ProbeListener(ProbeListener&& other) noexcept = delete;
     ProbeListener& operator=(ProbeListener&& other) noexcept = delete;
 
+    /**
+     * Whether the listener is a ProbeListenerArgBatch, which receives
+     * the notifications in batches.
+     */
+    bool isBatched() const { return batched; }
+
   protected:
     ProbeManager *const manager;
     const std::string name;
+    const bool batched;
 };
 
 /**
@@ -215,6 +225,76 @@ class ProbeListenerArgBase : public ProbeListener
         : ProbeListener(pm, name)
     {}
     virtual void notify(const Arg &val) = 0;
+
+  protected:
+    ProbeListenerArgBase(ProbeManager *pm, const std::string &name,
+                         bool batched)
+        : ProbeListener(pm, name, batched)
+    {}
+};
+
+/**
+ * ProbeListener which receives the notifications in batches. The probe
+ * point copies each argument into a buffer of the listener, without any
+ * virtual call, and the listener gets the whole buffer once it holds
+ * batch_size records, or when flush() is called. This suits listeners
+ * which do little work per notification, such as counters, on probe
+ * points which fire at a high rate.
+ *
+ * The records are delivered late, so the arguments must still be
+ * meaningful then: values and reference counted pointers, like
+ * DynInstPtr, are fine, but a PacketPtr may be gone by then. The
+ * listener has to flush() before its results are used, and before it
+ * is destroyed if the last records matter.
+ */
+template <class Arg>
+class ProbeListenerArgBatch : public ProbeListenerArgBase<Arg>
+{
+  public:
+    /**
+     * @param pm The probe manager of the probe point.
+     * @param name The name of the probe point to add this listener to.
+     * @param batch_size The number of records delivered at once.
+     */
+    ProbeListenerArgBatch(ProbeManager *pm, const std::string &name,
+                          size_t batch_size)
+        : ProbeListenerArgBase<Arg>(pm, name, true), batchSize(batch_size)
+    {
+        fatal_if(batchSize == 0, "Probe listener batches can't be empty.");
+        buffer.reserve(batchSize);
+    }
+
+    /** Buffer a record, and deliver the batch if it is full. */
+    void
+    record(const Arg &val)
+    {
+        buffer.push_back(val);
+        if (buffer.size() >= batchSize)
+            flush();
+    }
+
+    void notify(const Arg &val) override { record(val); }
+
+    /** Deliver the buffered records, if any. */
+    void
+    flush()
+    {
+        if (buffer.empty())
+            return;
+        notifyBatch(buffer);
+        buffer.clear();
+    }
+
+  protected:
+    /**
+     * Called with the records received since the last batch, in the
+     * order of the notifications.
+     */
+    virtual void notifyBatch(const std::vector<Arg> &records) = 0;
+
+  private:
+    const size_t batchSize;
+    std::vector<Arg> buffer;
 };
 
 /**
@@ -262,9 +342,15 @@ class ProbeListenerArg : public ProbeListenerArgBase<Arg>
 template <typename Arg>
 class ProbePointArg : public ProbePoint
 {
-    /** The attached listeners. */
+    /** The attached listeners, notified one record at a time. */
     std::vector<ProbeListenerArgBase<Arg> *> listeners;
 
+    /** The attached listeners receiving records in batches. */
+    std::vector<ProbeListenerArgBatch<Arg> *> batchListeners;
+
+    /** Only arguments which can be copied can be batched. */
+    static constexpr bool canBatch = std::is_copy_constructible_v<Arg>;
+
   public:
     ProbePointArg(ProbeManager *manager, std::string name)
         : ProbePoint(manager, name)
@@ -278,7 +364,11 @@ class ProbePointArg : public ProbePoint
      *
      * @return Whether this probe has any listener.
      */
-    bool hasListeners() const { return listeners.size() > 0; }
+    bool
+    hasListeners() const
+    {
+        return !listeners.empty() || !batchListeners.empty();
+    }
 
     /**
      * @brief adds a ProbeListener to this ProbePoints notify list.
@@ -287,6 +377,19 @@ class ProbePointArg : public ProbePoint
     void
     addListener(ProbeListener *l) override
     {
+        // Listeners are added while they are constructed, so their
+        // dynamic type isn't known yet
+        if constexpr (canBatch) {
+            if (l->isBatched()) {
+                auto *batch = static_cast<ProbeListenerArgBatch<Arg> *>(l);
+                if (std::find(batchListeners.begin(), batchListeners.end(),
+                              batch) == batchListeners.end()) {
+                    batchListeners.push_back(batch);
+                }
+                return;
+            }
+        }
+
         // check listener not already added
         if (std::find(listeners.begin(), listeners.end(), l) ==
             listeners.end()) {
@@ -303,6 +406,9 @@ class ProbePointArg : public ProbePoint
     {
         listeners.erase(std::remove(listeners.begin(), listeners.end(), l),
                         listeners.end());
+        batchListeners.erase(std::remove(batchListeners.begin(),
+                                         batchListeners.end(), l),
+                             batchListeners.end());
     }
 
     /**
@@ -312,9 +418,32 @@ class ProbePointArg : public ProbePoint
     void
     notify(const Arg &arg)
     {
+        if (GEM5_LIKELY(!hasListeners()))
+            return;
+
         for (auto l = listeners.begin(); l != listeners.end(); ++l) {
             (*l)->notify(arg);
         }
+        if constexpr (canBatch) {
+            for (auto *l: batchListeners)
+                l->record(arg);
+        }
+    }
+
+    /**
+     * Notify the listeners with an argument which is only built, by
+     * calling make(), if the probe has any listener. This keeps the cost
+     * of a probe point nobody listens to down to a test, whatever it
+     * takes to build its argument.
+     *
+     * @param make Function returning the argument to notify with.
+     */
+    template <typename Make>
+    void
+    notifyWith(Make &&make)
+    {
+        if (GEM5_UNLIKELY(hasListeners()))
+            notify(make());
     }
 };
 
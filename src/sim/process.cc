@@ -44,7 +44,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <climits>
 #include <csignal>
 #include <map>
@@ -302,8 +304,76 @@ Process::initState()
                 tc, SETranslatingPortProxy::Always));
 
     // load object file into target memory
-    image.write(*initVirtMem);
-    interpImage.write(*initVirtMem);
+    loadImage(image);
+    loadImage(interpImage);
+}
+
+void
+Process::loadImage(const loader::MemoryImage &img)
+{
+    auto &mem = system->getPhysMem();
+    const Addr page_size = pTable->pageSize();
+
+    for (auto &seg: img.segments()) {
+        if (seg.size == 0)
+            continue;
+        const Addr end = seg.base + seg.size;
+
+        // Allocate each run of unmapped pages in one go, so that it is
+        // physically contiguous as well.
+        Addr run_start = 0;
+        bool in_run = false;
+        for (Addr page = roundDown(seg.base, page_size); page < end;
+                page += page_size) {
+            const bool mapped = pTable->translate(page);
+            if (!mapped && !in_run) {
+                run_start = page;
+                in_run = true;
+            } else if (mapped && in_run) {
+                allocateMem(run_start, page - run_start);
+                in_run = false;
+            }
+        }
+        if (in_run)
+            allocateMem(run_start, end - run_start);
+
+        Addr vaddr = seg.base;
+        while (vaddr < end) {
+            Addr paddr;
+            [[maybe_unused]] bool mapped = pTable->translate(vaddr, paddr);
+            assert(mapped);
+
+            // Grow the chunk for as long as the pages are contiguous.
+            Addr len = std::min(roundDown(vaddr, page_size) + page_size,
+                                end) - vaddr;
+            Addr next_paddr;
+            while (vaddr + len < end &&
+                    pTable->translate(vaddr + len, next_paddr) &&
+                    next_paddr == paddr + len) {
+                len += std::min(page_size, end - vaddr - len);
+            }
+
+            const Addr off = vaddr - seg.base;
+            bool loaded;
+            if (seg.ifd) {
+                loaded = mem.loadFile(paddr, seg.ifd->fd(),
+                                      seg.data + off - seg.ifd->data(),
+                                      seg.data + off, len);
+            } else {
+                loaded = mem.loadBlob(paddr,
+                                      seg.data ? seg.data + off : nullptr,
+                                      len);
+            }
+
+            if (!loaded) {
+                if (seg.data)
+                    initVirtMem->writeBlob(vaddr, seg.data + off, len);
+                else
+                    initVirtMem->memsetBlob(vaddr, 0, len);
+            }
+            vaddr += len;
+        }
+    }
 }
 
 DrainState
@@ -186,6 +186,11 @@ class Process : public SimObject
     // Memory proxy for initial image load.
     std::unique_ptr<SETranslatingPortProxy> initVirtMem;
 
+    // Map the pages an image covers and load it straight into the
+    // physical memory backing them, falling back to initVirtMem for
+    // anything that isn't in a backing store.
+    void loadImage(const loader::MemoryImage &img);
+
     /**
      * Each instance of a Loader subclass will have a chance to try to load
      * an object file when tryLoaders is called. If they can't because they
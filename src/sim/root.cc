@@ -41,10 +41,14 @@
 
 #include "base/hostinfo.hh"
 #include "base/logging.hh"
+#include "base/output.hh"
+#include "base/pool_alloc.hh"
 #include "base/trace.hh"
+#include "config/eventq_profile.hh"
 #include "debug/TimeSync.hh"
 #include "sim/core.hh"
 #include "sim/cur_tick.hh"
+#include "sim/event_profiler.hh"
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
 #include "sim/root.hh"
@@ -75,6 +79,14 @@ Root::RootStats::RootStats()
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, statistics::units::Byte::get(),
              "Number of bytes of host memory used"),
+    ADD_STAT(hostPoolHits, statistics::units::Count::get(),
+             "Number of packet, request and data allocations served from "
+             "the host memory pools"),
+    ADD_STAT(hostPoolMisses, statistics::units::Count::get(),
+             "Number of pooled allocations that fell back to the host "
+             "allocator"),
+    ADD_STAT(hostPoolHitRate, statistics::units::Ratio::get(),
+             "Fraction of pooled allocations served from the pools"),
 
     statTime(true),
     startTick(0)
@@ -99,6 +111,23 @@ Root::RootStats::RootStats()
 
     hostTickRate.precision(0);
 
+    auto pool_counters = []() {
+        SizeClassPool::Counters total;
+        for (unsigned cls = 0; cls < SizeClassPool::numClasses; ++cls) {
+            const auto c = SizeClassPool::counters(cls);
+            total.hits += c.hits;
+            total.misses += c.misses;
+        }
+        return total;
+    };
+    hostPoolHits.functor([pool_counters]() {
+            return pool_counters().hits;
+        });
+    hostPoolMisses.functor([pool_counters]() {
+            return pool_counters().misses;
+        });
+    hostPoolHitRate = hostPoolHits / (hostPoolHits + hostPoolMisses);
+
     simSeconds = simTicks / simFreq;
     hostTickRate = simTicks / hostSeconds;
 }
@@ -108,6 +137,7 @@ Root::RootStats::resetStats()
 {
     statTime.setTimer();
     startTick = curTick();
+    SizeClassPool::resetCounters();
 
     statistics::Group::resetStats();
 }
@@ -177,7 +207,10 @@ Root::timeSyncSpinThreshold(Time newThreshold)
 
 Root::Root(const RootParams &p, int)
     : SimObject(p), _enabled(false), _periodTick(p.time_sync_period),
-      syncEvent([this]{ timeSync(); }, name())
+      syncEvent([this]{ timeSync(); }, name()),
+      asyncInserts(this, "asyncInserts", statistics::units::Count::get(),
+                   "Number of events scheduled asynchronously on each "
+                   "main event queue by each main event queue")
 {
     _period.setTick(p.time_sync_period);
     _spinThreshold.setTick(p.time_sync_spin_threshold);
@@ -188,6 +221,23 @@ Root::Root(const RootParams &p, int)
 
     simQuantum = p.sim_quantum;
 
+    eventqCalendarBuckets = p.eventq_calendar_buckets;
+    eventqCalendarWidth = p.eventq_calendar_width;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        mainEventQueue[i]->setCalendar(eventqCalendarBuckets,
+                                       eventqCalendarWidth);
+    }
+
+#if EVENTQ_PROFILE
+    auto dump_profile = []() {
+        static OutputStream *os = simout.create("event_profile.txt");
+        dumpEventProfile(*os->stream());
+        os->stream()->flush();
+    };
+    statistics::registerDumpCallback(dump_profile);
+    registerExitCallback(dump_profile);
+#endif
+
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
     // having a single global stat group for global stats. Merge that
@@ -195,6 +245,44 @@ Root::Root(const RootParams &p, int)
     mergeStatGroup(&Root::RootStats::instance);
 }
 
+void
+Root::regStats()
+{
+    SimObject::regStats();
+
+    asyncInserts
+        .init(numMainEventQueues, numMainEventQueues)
+        .flags(statistics::nozero);
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        asyncInserts.subname(i, csprintf("queue%d", i));
+        asyncInserts.ysubname(i, csprintf("queue%d", i));
+    }
+}
+
+void
+Root::preDumpStats()
+{
+    SimObject::preDumpStats();
+
+    // Queues count insertions themselves to avoid sharing any state
+    // between threads, gather them here.
+    for (uint32_t dst = 0; dst < numMainEventQueues; ++dst) {
+        for (uint32_t src = 0; src < numMainEventQueues; ++src)
+            asyncInserts[dst][src] = mainEventQueue[dst]->asyncInserts(src);
+    }
+}
+
+void
+Root::resetStats()
+{
+    SimObject::resetStats();
+
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        mainEventQueue[i]->resetAsyncInserts();
+        mainEventQueue[i]->profile().reset();
+    }
+}
+
 void
 Root::startup()
 {
@@ -80,6 +80,13 @@ class Root : public SimObject
     void timeSync();
     EventFunctionWrapper syncEvent;
 
+    /**
+     * Events scheduled asynchronously on each main event queue (first
+     * dimension) by the thread running each main event queue (second
+     * dimension).
+     */
+    statistics::Vector2d asyncInserts;
+
   public:
     /**
      * Use this function to get a pointer to the single Root object in the
@@ -110,6 +117,10 @@ class Root : public SimObject
         statistics::Formula hostTickRate;
         statistics::Value hostMemory;
 
+        statistics::Value hostPoolHits;
+        statistics::Value hostPoolMisses;
+        statistics::Formula hostPoolHitRate;
+
         static RootStats instance;
 
       private:
@@ -148,6 +159,10 @@ class Root : public SimObject
      */
     void startup() override;
 
+    void regStats() override;
+    void preDumpStats() override;
+    void resetStats() override;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 };
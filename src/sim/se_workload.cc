@@ -27,6 +27,8 @@
 
 #include "sim/se_workload.hh"
 
+#include <algorithm>
+
 #include "cpu/thread_context.hh"
 #include "params/SEWorkload.hh"
 #include "sim/process.hh"
@@ -35,8 +37,21 @@
 namespace gem5
 {
 
+SEWorkload::SyscallStats::SyscallStats(statistics::Group *parent) :
+    statistics::Group(parent, "syscalls"),
+    ADD_STAT(calls, statistics::units::Count::get(),
+             "Number of calls of each emulated syscall"),
+    ADD_STAT(hostSeconds, statistics::units::Second::get(),
+             "Host time spent emulating each syscall")
+{
+    calls.init(maxSyscallStats).flags(statistics::nozero);
+    hostSeconds.init(maxSyscallStats).flags(statistics::nozero);
+    calls.subname(maxSyscallStats - 1, "other");
+    hostSeconds.subname(maxSyscallStats - 1, "other");
+}
+
 SEWorkload::SEWorkload(const Params &p, Addr page_shift) :
-    Workload(p), memPools(page_shift)
+    Workload(p), memPools(page_shift), syscallStats(this)
 {}
 
 void
@@ -71,6 +86,23 @@ SEWorkload::syscall(ThreadContext *tc)
     tc->getProcessPtr()->syscall(tc);
 }
 
+void
+SEWorkload::recordSyscall(const std::string &name, double host_seconds)
+{
+    auto it = syscallSlots.find(name);
+    if (it == syscallSlots.end()) {
+        int slot = std::min<int>(syscallSlots.size(), maxSyscallStats - 1);
+        it = syscallSlots.emplace(name, slot).first;
+        if (slot != maxSyscallStats - 1) {
+            syscallStats.calls.subname(slot, name);
+            syscallStats.hostSeconds.subname(slot, name);
+        }
+    }
+
+    syscallStats.calls[it->second]++;
+    syscallStats.hostSeconds[it->second] += host_seconds;
+}
+
 Addr
 SEWorkload::allocPhysPages(int npages, int pool_id)
 {
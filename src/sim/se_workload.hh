@@ -28,6 +28,10 @@
 #ifndef __SIM_SE_WORKLOAD_HH__
 #define __SIM_SE_WORKLOAD_HH__
 
+#include <string>
+#include <unordered_map>
+
+#include "base/statistics.hh"
 #include "params/SEWorkload.hh"
 #include "sim/mem_pool.hh"
 #include "sim/workload.hh"
@@ -41,6 +45,25 @@ class SEWorkload : public Workload
     /** Memory allocation objects for all physical memories in the system. */
     MemPools memPools;
 
+    /**
+     * Number of syscalls which get their own stats entry. Any further
+     * syscalls are accounted for in the last entry.
+     */
+    static constexpr int maxSyscallStats = 256;
+
+    struct SyscallStats : public statistics::Group
+    {
+        SyscallStats(statistics::Group *parent);
+
+        /** Number of calls of each emulated syscall */
+        statistics::Vector calls;
+        /** Host time spent emulating each syscall */
+        statistics::Vector hostSeconds;
+    } syscallStats;
+
+    /** Stats entry assigned to each syscall name */
+    std::unordered_map<std::string, int> syscallSlots;
+
   public:
     using Params = SEWorkloadParams;
 
@@ -89,6 +112,14 @@ class SEWorkload : public Workload
     // For now, assume the only type of events are system calls.
     void event(ThreadContext *tc) override { syscall(tc); }
 
+    /**
+     * Account for one emulated syscall.
+     *
+     * @param name Name of the syscall.
+     * @param host_seconds Host time spent emulating it.
+     */
+    void recordSyscall(const std::string &name, double host_seconds);
+
     Addr allocPhysPages(int npages, int pool_id=0);
     Addr memSize(int pool_id=0) const;
     Addr freeMemSize(int pool_id=0) const;
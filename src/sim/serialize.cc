@@ -48,7 +48,11 @@
 
 #include <cassert>
 #include <cerrno>
+#include <cstring>
+#include <memory>
+#include <sstream>
 
+#include "base/str.hh"
 #include "base/trace.hh"
 #include "debug/Checkpoint.hh"
 
@@ -58,7 +62,160 @@ namespace gem5
 int ckptMaxCount = 0;
 int ckptCount = 0;
 int ckptPrevCount = -1;
-std::stack<std::string> Serializable::path;
+thread_local std::stack<std::string> Serializable::path;
+bool Serializable::binaryCheckpoints = false;
+
+namespace
+{
+
+/**
+ * The encoder of the binary checkpoint being created, if any. It has to
+ * outlive the stream the checkpoint is written through, and is replaced
+ * when the next checkpoint is generated.
+ */
+std::unique_ptr<BinaryCheckpointBuf> binaryCheckpointBuf;
+
+} // anonymous namespace
+
+/////////////////////////////
+
+const char BinaryCheckpointBuf::magic[8] = "gem5cpt";
+
+BinaryCheckpointBuf::BinaryCheckpointBuf(std::streambuf *out, bool header)
+    : out(out)
+{
+    if (header) {
+        putBytes(magic, sizeof(magic));
+        putBytes(&version, sizeof(version));
+    }
+}
+
+void
+BinaryCheckpointBuf::appendRecords(const std::string &records)
+{
+    if (!line.empty()) {
+        processLine();
+        line.clear();
+    }
+    putBytes(records.data(), records.size());
+    // entries that follow belong to the last section of the records
+    if (!records.empty())
+        inSection = true;
+}
+
+void
+BinaryCheckpointBuf::putBytes(const void *data, size_t size)
+{
+    out->sputn(static_cast<const char *>(data), size);
+}
+
+void
+BinaryCheckpointBuf::putString(const std::string &str)
+{
+    const uint32_t size = str.size();
+    putBytes(&size, sizeof(size));
+    putBytes(str.data(), size);
+}
+
+void
+BinaryCheckpointBuf::processLine()
+{
+    // Lines are interpreted the same way IniFile::load() does.
+    eat_white(line);
+    if (line.empty())
+        return;
+
+    if (line.front() == '[' && line.back() == ']') {
+        std::string section = line.substr(1, line.size() - 2);
+        eat_white(section);
+        out->sputc('S');
+        putString(section);
+        inSection = true;
+        return;
+    }
+
+    // Anything before the first section (e.g., the header comment) is
+    // ignored when loading a text checkpoint, so drop it.
+    if (!inSection)
+        return;
+
+    const auto offset = line.find('=');
+    if (offset == std::string::npos) {
+        warn("Dropping malformed checkpoint line '%s'.", line);
+        return;
+    }
+    const bool append = offset > 0 && line[offset - 1] == '+';
+    std::string key = line.substr(0, append ? offset - 1 : offset);
+    std::string value = line.substr(offset + 1);
+    eat_white(key);
+    eat_white(value);
+
+    out->sputc('E');
+    out->sputc(append ? 1 : 0);
+    putString(key);
+    putString(value);
+}
+
+void
+BinaryCheckpointBuf::rawEntry(const std::string &name, char kind,
+                              uint8_t size, const void *data, uint64_t count)
+{
+    // Raw entries are written directly, so anything still buffered must
+    // come first. The serialization helpers always terminate their lines,
+    // so this is not expected to happen.
+    if (!line.empty()) {
+        processLine();
+        line.clear();
+    }
+
+    out->sputc('R');
+    putString(name);
+    out->sputc(kind);
+    out->sputc(size);
+    putBytes(&count, sizeof(count));
+    putBytes(data, size * count);
+}
+
+BinaryCheckpointBuf::int_type
+BinaryCheckpointBuf::overflow(int_type c)
+{
+    if (traits_type::eq_int_type(c, traits_type::eof()))
+        return traits_type::not_eof(c);
+
+    const char ch = traits_type::to_char_type(c);
+    if (ch == '\n') {
+        processLine();
+        line.clear();
+    } else {
+        line += ch;
+    }
+    return c;
+}
+
+std::streamsize
+BinaryCheckpointBuf::xsputn(const char *s, std::streamsize n)
+{
+    const char *end = s + n;
+    while (s != end) {
+        const char *nl = static_cast<const char *>(
+            std::memchr(s, '\n', end - s));
+        if (!nl) {
+            line.append(s, end);
+            break;
+        }
+        line.append(s, nl);
+        processLine();
+        line.clear();
+        s = nl + 1;
+    }
+    return n;
+}
+
+int
+BinaryCheckpointBuf::sync()
+{
+    return out->pubsync();
+}
 
 /////////////////////////////
 
@@ -97,9 +254,38 @@ Serializable::generateCheckpointOut(const std::string &cpt_dir,
     time_t t = time(NULL);
     if (!outstream)
         fatal("Unable to open file %s for writing\n", cpt_file.c_str());
+
+    if (binaryCheckpoints) {
+        binaryCheckpointBuf =
+            std::make_unique<BinaryCheckpointBuf>(outstream.rdbuf());
+        static_cast<std::ostream &>(outstream).rdbuf(
+            binaryCheckpointBuf.get());
+    }
     outstream << "## checkpoint generated: " << ctime(&t);
 }
 
+CheckpointOutBuffer::CheckpointOutBuffer(CheckpointOut &cp)
+    : os(&buf)
+{
+    if (dynamic_cast<BinaryCheckpointBuf *>(cp.rdbuf())) {
+        binary = std::make_unique<BinaryCheckpointBuf>(&buf, false);
+        os.rdbuf(binary.get());
+    }
+}
+
+void
+CheckpointOutBuffer::appendTo(CheckpointOut &cp)
+{
+    os.flush();
+    if (binary) {
+        auto *bin = dynamic_cast<BinaryCheckpointBuf *>(cp.rdbuf());
+        assert(bin);
+        bin->appendRecords(buf.str());
+    } else {
+        cp << buf.str();
+    }
+}
+
 Serializable::ScopedCheckpointSection::~ScopedCheckpointSection()
 {
     assert(!path.empty());
@@ -163,11 +349,120 @@ CheckpointIn::CheckpointIn(const std::string &cpt_dir)
     : db(), _cptDir(setDir(cpt_dir))
 {
     std::string filename = getCptDir() + "/" + CheckpointIn::baseFilename;
-    if (!db.load(filename)) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(BinaryCheckpointBuf::magic)] = {};
+    file.read(magic, sizeof(magic));
+    binary = file.gcount() == sizeof(magic) &&
+        std::memcmp(magic, BinaryCheckpointBuf::magic, sizeof(magic)) == 0;
+
+    bool loaded;
+    if (binary) {
+        loaded = loadBinary(file);
+    } else {
+        file.clear();
+        file.seekg(0);
+        loaded = file.is_open() && db.load(file);
+    }
+    if (!loaded) {
         fatal("Can't load checkpoint file '%s'\n", filename);
     }
 }
 
+bool
+CheckpointIn::loadBinary(std::istream &is)
+{
+    auto get = [&is](void *data, size_t size) {
+        return bool(is.read(static_cast<char *>(data), size));
+    };
+    auto get_string = [&is, &get](std::string &str) {
+        uint32_t size;
+        if (!get(&size, sizeof(size)))
+            return false;
+        str.resize(size);
+        return get(str.data(), size);
+    };
+
+    uint32_t version;
+    if (!get(&version, sizeof(version)) ||
+            version != BinaryCheckpointBuf::version) {
+        return false;
+    }
+
+    BinarySection *section = nullptr;
+    std::string key, value;
+    char type;
+    while (is.get(type)) {
+        switch (type) {
+          case 'S':
+            if (!get_string(key))
+                return false;
+            section = &binarySections[key];
+            break;
+          case 'E': {
+            uint8_t append;
+            if (!section || !get(&append, sizeof(append)) ||
+                    !get_string(key) || !get_string(value)) {
+                return false;
+            }
+            auto it = section->entries.find(key);
+            if (it == section->entries.end())
+                section->entries.emplace(key, value);
+            else if (append)
+                it->second += " " + value;
+            else
+                it->second = value;
+            break;
+          }
+          case 'R': {
+            RawEntry raw;
+            if (!section || !get_string(key) || !get(&raw.kind, 1) ||
+                    !get(&raw.size, 1) ||
+                    !get(&raw.count, sizeof(raw.count))) {
+                return false;
+            }
+            raw.data.resize(raw.size * raw.count);
+            if (!get(raw.data.data(), raw.data.size()))
+                return false;
+            section->raw[key] = std::move(raw);
+            break;
+          }
+          default:
+            return false;
+        }
+    }
+    return is.eof();
+}
+
+std::string
+CheckpointIn::RawEntry::text() const
+{
+    std::ostringstream os;
+    for (uint64_t i = 0; i < count; i++) {
+        if (i)
+            os << " ";
+        if (kind == 'f')
+            os << element<long double>(i);
+        else if (kind == 'i')
+            os << element<int64_t>(i);
+        else
+            os << element<uint64_t>(i);
+    }
+    return os.str();
+}
+
+const CheckpointIn::RawEntry *
+CheckpointIn::findRaw(const std::string &section,
+                      const std::string &entry) const
+{
+    if (!binary)
+        return nullptr;
+    auto sec = binarySections.find(section);
+    if (sec == binarySections.end())
+        return nullptr;
+    auto raw = sec->second.raw.find(entry);
+    return raw == sec->second.raw.end() ? nullptr : &raw->second;
+}
+
 /**
  * @param section Here we mention the section we are looking for
  * (example: currentsection).
@@ -180,6 +475,11 @@ CheckpointIn::CheckpointIn(const std::string &cpt_dir)
 bool
 CheckpointIn::entryExists(const std::string &section, const std::string &entry)
 {
+    if (binary) {
+        auto sec = binarySections.find(section);
+        return sec != binarySections.end() &&
+            (sec->second.entries.count(entry) || sec->second.raw.count(entry));
+    }
     return db.entryExists(section, entry);
 }
 /**
@@ -196,12 +496,30 @@ bool
 CheckpointIn::find(const std::string &section, const std::string &entry,
         std::string &value)
 {
+    if (binary) {
+        auto sec = binarySections.find(section);
+        if (sec == binarySections.end())
+            return false;
+        auto it = sec->second.entries.find(entry);
+        if (it != sec->second.entries.end()) {
+            value = it->second;
+            return true;
+        }
+        auto raw = sec->second.raw.find(entry);
+        if (raw != sec->second.raw.end()) {
+            value = raw->second.text();
+            return true;
+        }
+        return false;
+    }
     return db.find(section, entry, value);
 }
 
 bool
 CheckpointIn::sectionExists(const std::string &section)
 {
+    if (binary)
+        return binarySections.count(section);
     return db.sectionExists(section);
 }
 
@@ -209,6 +527,16 @@ void
 CheckpointIn::visitSection(const std::string &section,
     IniFile::VisitSectionCallback cb)
 {
+    if (binary) {
+        auto sec = binarySections.find(section);
+        if (sec == binarySections.end())
+            return;
+        for (const auto &[key, value]: sec->second.entries)
+            cb(key, value);
+        for (const auto &[key, raw]: sec->second.raw)
+            cb(key, raw.text());
+        return;
+    }
     db.visitSection(section, cb);
 }
 
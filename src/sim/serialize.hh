@@ -47,9 +47,13 @@
 
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <sstream>
 #include <stack>
 #include <string>
 #include <type_traits>
@@ -65,11 +69,172 @@ namespace gem5
 
 typedef std::ostream CheckpointOut;
 
+/**
+ * Stream buffer that encodes the text written to a CheckpointOut as a
+ * binary checkpoint.
+ *
+ * Serializable objects keep writing sections and entries as text. The
+ * buffer splits that text into lines and stores every section header
+ * and every entry as a length-prefixed record, so loading the checkpoint
+ * back does not require any parsing. Arrays of numbers bypass the text
+ * representation altogether (see rawEntry()) and are stored as native
+ * bytes.
+ *
+ * A binary checkpoint file starts with the 8 byte magic string
+ * "gem5cpt" (including the NUL terminator) followed by a 32 bit version
+ * number, and contains a sequence of the following records:
+ *
+ * - 'S' u32 length, name: Start of a section.
+ * - 'E' u8 append, u32 length, key, u32 length, value: Entry of the
+ *   current section. If append is set the value is appended to an
+ *   existing entry, as with "key+=value" in text checkpoints.
+ * - 'R' u32 length, key, u8 kind, u8 size, u64 count, data: Array of
+ *   count elements of size bytes each. The kind is taken from RawParam.
+ *
+ * All the integers are stored in the byte order of the host.
+ */
+class BinaryCheckpointBuf : public std::streambuf
+{
+  public:
+    static const char magic[8];
+    static constexpr uint32_t version = 1;
+
+    /**
+     * @param out The buffer of the checkpoint file.
+     * @param header Whether to start with the magic string and version,
+     * which is not the case for a CheckpointOutBuffer.
+     */
+    BinaryCheckpointBuf(std::streambuf *out, bool header=true);
+
+    /**
+     * Append records encoded by another BinaryCheckpointBuf.
+     *
+     * @param records The records, which must start with a section.
+     */
+    void appendRecords(const std::string &records);
+
+    /**
+     * Write an array of numbers of the current section.
+     *
+     * @param name Name of the entry.
+     * @param kind The RawParam kind of the elements.
+     * @param size Size of an element in bytes.
+     * @param data The elements.
+     * @param count Number of elements.
+     */
+    void rawEntry(const std::string &name, char kind, uint8_t size,
+                  const void *data, uint64_t count);
+
+  protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+    int sync() override;
+
+  private:
+    /** Encode a complete line of text. */
+    void processLine();
+
+    void putBytes(const void *data, size_t size);
+    void putString(const std::string &str);
+
+    std::streambuf *out;
+    /** The text of the line being written. */
+    std::string line;
+    /** Whether a section header has been seen yet. */
+    bool inSection = false;
+};
+
 class CheckpointIn
 {
+  public:
+    /**
+     * Array of numbers stored as native bytes in a binary checkpoint.
+     */
+    struct RawEntry
+    {
+        /** The RawParam kind of the elements. */
+        char kind;
+        /** Size of an element in bytes. */
+        uint8_t size;
+        uint64_t count;
+        std::string data;
+
+        /**
+         * Read an element, converting it to T.
+         *
+         * @param i Index of the element.
+         */
+        template <class T>
+        T
+        element(uint64_t i) const
+        {
+            const char *ptr = data.data() + i * size;
+            switch (kind) {
+              case 'i':
+                switch (size) {
+                  case 1: return load<int8_t, T>(ptr);
+                  case 2: return load<int16_t, T>(ptr);
+                  case 4: return load<int32_t, T>(ptr);
+                  case 8: return load<int64_t, T>(ptr);
+                }
+                break;
+              case 'u':
+                switch (size) {
+                  case 1: return load<uint8_t, T>(ptr);
+                  case 2: return load<uint16_t, T>(ptr);
+                  case 4: return load<uint32_t, T>(ptr);
+                  case 8: return load<uint64_t, T>(ptr);
+                }
+                break;
+              case 'f':
+                if (size == sizeof(float))
+                    return load<float, T>(ptr);
+                if (size == sizeof(double))
+                    return load<double, T>(ptr);
+                if (size == sizeof(long double))
+                    return load<long double, T>(ptr);
+                break;
+            }
+            panic("Unsupported raw checkpoint entry (kind %c, size %d).",
+                  kind, size);
+        }
+
+        /** @return The elements in the text checkpoint format. */
+        std::string text() const;
+
+      private:
+        template <class S, class T>
+        static T
+        load(const char *ptr)
+        {
+            S value;
+            std::memcpy(&value, ptr, sizeof(value));
+            return static_cast<T>(value);
+        }
+    };
+
   private:
     IniFile db;
 
+    /** Contents of a section of a binary checkpoint. */
+    struct BinarySection
+    {
+        std::unordered_map<std::string, std::string> entries;
+        std::unordered_map<std::string, RawEntry> raw;
+    };
+
+    /** Whether the checkpoint file is a binary checkpoint. */
+    bool binary = false;
+    /** The sections of a binary checkpoint. */
+    std::unordered_map<std::string, BinarySection> binarySections;
+
+    /**
+     * Load a binary checkpoint file.
+     *
+     * @return False if the file is truncated or corrupted.
+     */
+    bool loadBinary(std::istream &is);
+
     const std::string _cptDir;
 
   public:
@@ -93,6 +258,15 @@ class CheckpointIn
         IniFile::VisitSectionCallback cb);
     /** @}*/ //end of api_checkout group
 
+    /**
+     * Find an array stored as raw bytes.
+     *
+     * @return The array, or nullptr if this is not a binary checkpoint or
+     * the entry was stored as text.
+     */
+    const RawEntry *findRaw(const std::string &section,
+                            const std::string &entry) const;
+
     // The following static functions have to do with checkpoint
     // creation rather than restoration.  This class makes a handy
     // namespace for them though.  Currently no Checkpoint object is
@@ -311,8 +485,51 @@ class Serializable
     static void generateCheckpointOut(const std::string &cpt_dir,
         std::ofstream &outstream);
 
+    /**
+     * Whether generateCheckpointOut() creates binary checkpoints (see
+     * BinaryCheckpointBuf) rather than text ones. Both formats are
+     * restored transparently.
+     *
+     * @ingroup api_serialize
+     */
+    static bool binaryCheckpoints;
+
+  private:
+    /**
+     * The stack of active sections. Each host thread has its own, so
+     * independent objects can be serialized concurrently (see
+     * CheckpointOutBuffer).
+     */
+    static thread_local std::stack<std::string> path;
+};
+
+/**
+ * Part of a checkpoint serialized into memory.
+ *
+ * Independent sections can be serialized concurrently on different
+ * host threads, each into a buffer of its own. Appending the buffers to
+ * the checkpoint in a fixed order afterwards produces the same
+ * checkpoint as serializing the sections in that order. A buffer uses
+ * the format (text or binary) of the checkpoint it is created for.
+ */
+class CheckpointOutBuffer
+{
+  public:
+    /**
+     * @param cp The checkpoint the buffer is appended to.
+     */
+    CheckpointOutBuffer(CheckpointOut &cp);
+
+    /** @return The stream to serialize into. */
+    CheckpointOut &stream() { return os; }
+
+    /** Append everything serialized so far to the checkpoint. */
+    void appendTo(CheckpointOut &cp);
+
   private:
-    static std::stack<std::string> path;
+    std::stringbuf buf;
+    std::unique_ptr<BinaryCheckpointBuf> binary;
+    std::ostream os;
 };
 
 /**
@@ -388,9 +605,18 @@ void
 arrayParamOut(CheckpointOut &os, const std::string &name,
               InputIterator start, InputIterator end)
 {
-    os << name << "=";
     auto it = start;
     using Elem = std::remove_cv_t<std::remove_reference_t<decltype(*it)>>;
+    if constexpr (RawParam<Elem>::raw) {
+        if (auto *bin = dynamic_cast<BinaryCheckpointBuf *>(os.rdbuf())) {
+            const std::vector<Elem> values(start, end);
+            bin->rawEntry(name, RawParam<Elem>::kind, sizeof(Elem),
+                          values.data(), values.size());
+            return;
+        }
+    }
+
+    os << name << "=";
     if (it != end)
         ShowParam<Elem>::show(os, *it++);
     while (it != end) {
@@ -442,6 +668,17 @@ arrayParamIn(CheckpointIn &cp, const std::string &name,
              InsertIterator inserter, ssize_t fixed_size=-1)
 {
     const std::string &section = Serializable::currentSection();
+    if constexpr (RawParam<T>::raw) {
+        if (const auto *raw = cp.findRaw(section, name)) {
+            fatal_if(fixed_size >= 0 && raw->count != fixed_size,
+                     "Array size mismatch on %s:%s (Got %u, expected %u)'\n",
+                     section, name, raw->count, fixed_size);
+            for (uint64_t i = 0; i < raw->count; i++)
+                *inserter = raw->element<T>(i);
+            return;
+        }
+    }
+
     std::string str;
     fatal_if(!cp.find(section, name, str),
         "Can't unserialize '%s:%s'.", section, name);
@@ -41,6 +41,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "base/compiler.hh"
@@ -1366,3 +1367,154 @@ TEST_F(SerializeFixture, SerializeMapping)
         ASSERT_THAT(reals, testing::ElementsAre(0.1, 1.345, 892.72, 1e+10));
     }
 }
+
+/**
+ * Test that the entries and arrays of a binary checkpoint are restored
+ * the same way as those of a text checkpoint.
+ */
+TEST_F(SerializeFixture, BinaryCheckpointRoundTrip)
+{
+    const int integer = 5;
+    const std::string str = "some string";
+    const std::vector<bool> booleans = {true, false, true};
+    const std::vector<uint8_t> bytes = {17, 42, 255};
+    const std::vector<int64_t> signeds = {-1, 0, 1LL << 40};
+    const double reals[3] = {0.1, 1.345, 1e+10};
+
+    // Serialization
+    {
+        Serializable::binaryCheckpoints = true;
+        std::ofstream cp;
+        Serializable::generateCheckpointOut(getDirName(), cp);
+        Serializable::binaryCheckpoints = false;
+
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        SERIALIZE_SCALAR(integer);
+        SERIALIZE_SCALAR(str);
+        SERIALIZE_CONTAINER(booleans);
+        SERIALIZE_CONTAINER(bytes);
+        SERIALIZE_CONTAINER(signeds);
+        SERIALIZE_ARRAY(reals, 3);
+        cp.close();
+
+        std::ifstream is(getCptPath(), std::ios::binary);
+        char magic[sizeof(BinaryCheckpointBuf::magic)];
+        is.read(magic, sizeof(magic));
+        ASSERT_EQ(std::string(magic), "gem5cpt");
+    }
+
+    // Unserialization
+    {
+        CheckpointIn cp(getDirName());
+        ASSERT_TRUE(cp.sectionExists("Section1"));
+        ASSERT_TRUE(cp.entryExists("Section1", "integer"));
+        ASSERT_TRUE(cp.entryExists("Section1", "reals"));
+        ASSERT_EQ(cp.findRaw("Section1", "booleans"), nullptr);
+        ASSERT_NE(cp.findRaw("Section1", "bytes"), nullptr);
+
+        std::string value;
+        ASSERT_TRUE(cp.find("Section1", "bytes", value));
+        ASSERT_EQ(value, "17 42 255");
+
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+
+        int integer;
+        std::string str;
+        std::vector<bool> booleans;
+        std::vector<uint8_t> bytes;
+        std::vector<int64_t> signeds;
+        double reals[3];
+        UNSERIALIZE_SCALAR(integer);
+        ASSERT_EQ(integer, 5);
+        UNSERIALIZE_SCALAR(str);
+        ASSERT_EQ(str, "some string");
+        UNSERIALIZE_CONTAINER(booleans);
+        ASSERT_THAT(booleans, testing::ElementsAre(true, false, true));
+        UNSERIALIZE_CONTAINER(bytes);
+        ASSERT_THAT(bytes, testing::ElementsAre(17, 42, 255));
+        UNSERIALIZE_CONTAINER(signeds);
+        ASSERT_THAT(signeds, testing::ElementsAre(-1, 0, 1LL << 40));
+        UNSERIALIZE_ARRAY(reals, 3);
+        ASSERT_THAT(reals, testing::ElementsAre(0.1, 1.345, 1e+10));
+    }
+}
+
+/** Test that a binary array with an unexpected size is not restored. */
+TEST_F(SerializeFixtureDeathTest, BinaryCheckpointArraySizeMismatch)
+{
+    // Serialization
+    {
+        const uint32_t words[3] = {1, 2, 3};
+
+        Serializable::binaryCheckpoints = true;
+        std::ofstream cp;
+        Serializable::generateCheckpointOut(getDirName(), cp);
+        Serializable::binaryCheckpoints = false;
+
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        SERIALIZE_ARRAY(words, 3);
+    }
+
+    // Unserialization
+    {
+        CheckpointIn cp(getDirName());
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+
+        uint32_t words[2];
+        gtestLogOutput.str("");
+        ASSERT_ANY_THROW(UNSERIALIZE_ARRAY(words, 2));
+        ASSERT_THAT(gtestLogOutput.str(), ::testing::HasSubstr(
+            "Array size mismatch on Section1:words (Got 3, expected 2)"));
+    }
+}
+
+/**
+ * Test that sections serialized concurrently into CheckpointOutBuffers
+ * produce the same checkpoint as serializing them in order.
+ */
+TEST_F(SerializeFixture, CheckpointOutBufferConcurrentSections)
+{
+    for (bool binary : { false, true }) {
+        Serializable::binaryCheckpoints = binary;
+        std::ofstream cp;
+        Serializable::generateCheckpointOut(getDirName(), cp);
+        Serializable::binaryCheckpoints = false;
+
+        std::vector<std::unique_ptr<CheckpointOutBuffer>> buffers;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; i++) {
+            buffers.push_back(std::make_unique<CheckpointOutBuffer>(cp));
+            threads.emplace_back([&buffer = *buffers.back(), i]() {
+                CheckpointOut &cp = buffer.stream();
+                Serializable::ScopedCheckpointSection scs(
+                    cp, csprintf("Section%d", i));
+                const std::vector<uint32_t> values(100, i);
+                SERIALIZE_SCALAR(i);
+                SERIALIZE_CONTAINER(values);
+            });
+        }
+        for (auto &thread : threads)
+            thread.join();
+        for (auto &buffer : buffers)
+            buffer->appendTo(cp);
+
+        if (!binary) {
+            const std::string contents = getContents(cp, getCptPath());
+            EXPECT_LT(contents.find("[Section0]"),
+                      contents.find("[Section3]"));
+        }
+        cp.close();
+
+        CheckpointIn cpt(getDirName());
+        for (int i = 0; i < 4; i++) {
+            Serializable::ScopedCheckpointSection scs(
+                cpt, csprintf("Section%d", i));
+            int value;
+            std::vector<uint32_t> values;
+            paramIn(cpt, "i", value);
+            EXPECT_EQ(value, i);
+            arrayParamIn(cpt, "values", values);
+            EXPECT_EQ(values, std::vector<uint32_t>(100, i));
+        }
+    }
+}
@@ -155,6 +155,31 @@ struct ShowParam<bool>
     }
 };
 
+/*
+ * A structure which describes how values of type T are stored in binary
+ * checkpoints. Arrays of types with raw set to true are written as a
+ * single block of native bytes rather than as a list of strings. The
+ * kind is 'i' for signed integers, 'u' for unsigned integers and 'f' for
+ * floating point numbers, and the size of an element is sizeof(T).
+ *
+ * Every other type (including bool, which is shown as a string) falls
+ * back to the text representation provided by ShowParam.
+ */
+template <class T, class Enabled=void>
+struct RawParam
+{
+    static constexpr bool raw = false;
+};
+
+template <class T>
+struct RawParam<T, std::enable_if_t<std::is_arithmetic_v<T> &&
+                                    !std::is_same_v<bool, T>>>
+{
+    static constexpr bool raw = true;
+    static constexpr char kind = std::is_floating_point_v<T> ? 'f' :
+        (std::is_signed_v<T> ? 'i' : 'u');
+};
+
 /** @} */
 
 } // namespace gem5
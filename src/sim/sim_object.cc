@@ -29,7 +29,11 @@
 
 #include "sim/sim_object.hh"
 
+#include <atomic>
 #include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
 
 #include "base/logging.hh"
 #include "base/match.hh"
@@ -129,7 +133,7 @@ SimObject::getPort(const std::string &if_name, PortID idx)
 // static function: serialize all SimObjects.
 //
 void
-SimObject::serializeAll(const std::string &cpt_dir)
+SimObject::serializeAll(const std::string &cpt_dir, unsigned threads)
 {
     std::ofstream cp;
     Serializable::generateCheckpointOut(cpt_dir, cp);
@@ -137,12 +141,41 @@ SimObject::serializeAll(const std::string &cpt_dir)
     SimObjectList::reverse_iterator ri = simObjectList.rbegin();
     SimObjectList::reverse_iterator rend = simObjectList.rend();
 
-    for (; ri != rend; ++ri) {
-        SimObject *obj = *ri;
-        // This works despite name() returning a fully qualified name
-        // since we are at the top level.
-        obj->serializeSection(cp, obj->name());
-   }
+    if (threads <= 1) {
+        for (; ri != rend; ++ri) {
+            SimObject *obj = *ri;
+            // This works despite name() returning a fully qualified name
+            // since we are at the top level.
+            obj->serializeSection(cp, obj->name());
+        }
+        return;
+    }
+
+    // Serialize every object into a buffer of its own, handing the
+    // objects out one at a time as their sizes vary wildly (think of
+    // memories and caches), and append the buffers in the usual order.
+    const std::vector<SimObject *> objs(ri, rend);
+    std::vector<std::unique_ptr<CheckpointOutBuffer>> buffers(objs.size());
+    std::atomic<size_t> next(0);
+    EventQueue *eventq = curEventQueue();
+    auto work = [&]() {
+        // objects may need curTick()
+        curEventQueue(eventq);
+        for (size_t i; (i = next++) < objs.size();) {
+            buffers[i] = std::make_unique<CheckpointOutBuffer>(cp);
+            objs[i]->serializeSection(buffers[i]->stream(), objs[i]->name());
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < std::min<size_t>(threads, objs.size()); ++i)
+        workers.emplace_back(work);
+    work();
+    for (auto &worker : workers)
+        worker.join();
+
+    for (auto &buffer : buffers)
+        buffer->appendTo(cp);
 }
 
 SimObject *
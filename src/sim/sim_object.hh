@@ -326,8 +326,19 @@ class SimObject : public EventManager, public Serializable, public Drainable,
      * in its own section. As such, the serialization functions should not
      * be called on sim objects anywhere else; otherwise, these objects
      * would be needlessly serialized more than once.
+     *
+     * As every object is serialized into a section of its own, the
+     * objects can be serialized concurrently on several host threads.
+     * The resulting checkpoint is the same as with a single thread. The
+     * serialize() method of an object must then only read the state of
+     * the simulated system, which it is expected to do anyway as the
+     * system is drained.
+     *
+     * @param cpt_dir The checkpoint directory.
+     * @param threads Number of host threads to serialize on.
      */
-    static void serializeAll(const std::string &cpt_dir);
+    static void serializeAll(const std::string &cpt_dir,
+                             unsigned threads=1);
 
     /**
      * Find the SimObject with the given name and return a pointer to
@@ -47,6 +47,8 @@
 
 #include "base/logging.hh"
 #include "base/pollevent.hh"
+#include "base/stats/storage.hh"
+#include "base/trace_ring.hh"
 #include "base/types.hh"
 #include "sim/async.hh"
 #include "sim/eventq.hh"
@@ -220,12 +222,27 @@ simulate(Tick num_cycles)
     }
 
     if (numMainEventQueues > 1) {
-        fatal_if(simQuantum == 0,
-                 "Quantum for multi-eventq simulation not specified");
+        // Without an explicit quantum, derive it from the lookahead
+        // advertised by the links between the queues. Since this is the
+        // largest safe quantum, idle periods can be skipped as well.
+        Tick quantum = simQuantum;
+        const bool lookahead = quantum == 0;
+        if (lookahead) {
+            quantum = minLookahead();
+            fatal_if(quantum == MaxTick,
+                     "Quantum for multi-eventq simulation not specified "
+                     "and no link advertised its lookahead");
+            fatal_if(quantum == 0,
+                     "A link between event queues has no lookahead, a "
+                     "quantum must be specified explicitly");
+            inform("Using a lookahead-derived quantum of %d ticks\n",
+                   quantum);
+        }
 
         quantum_event.reset(
-            new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
-                                EventBase::Progress_Event_Pri, 0));
+            new GlobalSyncEvent(curTick() + quantum, quantum,
+                                EventBase::Progress_Event_Pri, 0,
+                                lookahead));
 
         inParallelMode = true;
     }
@@ -290,6 +307,15 @@ doSimLoop(EventQueue *eventq)
 {
     // set the per thread current eventq pointer
     curEventQueue(eventq);
+
+    // Give each main event queue its own accumulator in the stats that
+    // are shared by several queues.
+    if (eventq->index() > 0 && eventq->index() < statistics::threadSlots())
+        statistics::setThreadSlot(eventq->index());
+    else if (eventq->index() > 0)
+        warn_once("Not enough stat thread slots for %d event queues, "
+                  "shared stats may be updated concurrently",
+                  numMainEventQueues);
     eventq->handleAsyncInsertions();
 
     bool mainQueue = eventq == getEventQueue(0);
@@ -317,6 +343,11 @@ doSimLoop(EventQueue *eventq)
                 pollQueue.service();
             }
 
+            if (async_tracedump) {
+                async_tracedump = false;
+                trace::dumpRing();
+            }
+
             if (async_exit) {
                 async_exit = false;
                 exitSimLoop("user interrupt received");
@@ -53,6 +53,7 @@
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "sim/global_event.hh"
+#include "sim/root.hh"
 
 namespace gem5
 {
@@ -142,9 +143,59 @@ periodicStatDump(Tick period)
     }
 }
 
+class OutputDumpEvent : public GlobalEvent
+{
+  private:
+    Output &output;
+    Tick period;
+
+  public:
+    OutputDumpEvent(Output &_output, Tick when, Tick _period)
+        : GlobalEvent(when, Stat_Event_Pri, 0),
+          output(_output), period(_period)
+    {
+    }
+
+    void
+    process() override
+    {
+        Root *root = Root::root();
+        if (root && output.valid()) {
+            processDumpQueue();
+            root->preDumpStats();
+            prepareGroup(*root);
+
+            output.begin();
+            dumpGroup(output, *root);
+            output.end();
+        }
+
+        schedule(curTick() + period);
+    }
+
+    const char *description() const override { return "OutputDumpEvent"; }
+};
+
+std::list<OutputDumpEvent *> outputDumpEvents;
+
+void
+periodicOutputDump(Output &output, Tick period)
+{
+    fatal_if(period == 0, "Periodic output dumps need a period");
+    // See schedStatEvent() for the simQuantum
+    outputDumpEvents.push_back(
+        new OutputDumpEvent(output, curTick() + period + simQuantum, period));
+}
+
 void
 updateEvents()
 {
+    // Shift the periodic output dumps like the dumpEvent below
+    for (auto *event : outputDumpEvents) {
+        if (event->scheduled() && event->when() < curTick())
+            event->reschedule(event->when() + curTick());
+    }
+
     /*
      * If the dumpEvent has been scheduled, but is scheduled in the past, then
      * we need to shift the event to be at a valid point in time. Therefore, we
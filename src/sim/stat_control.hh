@@ -51,6 +51,7 @@ namespace gem5
 namespace statistics
 {
 
+class Output;
 
 void initSimStats();
 
@@ -81,6 +82,15 @@ void schedStatEvent(bool dump, bool reset, Tick when = curTick(),
  * @param period The period at which the dumping should occur.
  */
 void periodicStatDump(Tick period = 0);
+
+/**
+ * Periodically dump the stats to a single output, e.g., a stats stream
+ * that is followed live. Unlike periodicStatDump(), the other outputs
+ * aren't written and the stats are not reset.
+ * @param output The output the stats are dumped to.
+ * @param period The period at which the dumping should occur.
+ */
+void periodicOutputDump(Output &output, Tick period);
 } // namespace statistics
 } // namespace gem5
 
@@ -29,9 +29,13 @@
 
 #include "sim/syscall_desc.hh"
 
+#include <chrono>
+
 #include "base/types.hh"
 #include "sim/eventq.hh"
+#include "sim/se_workload.hh"
 #include "sim/syscall_debug_macros.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
@@ -43,7 +47,7 @@ SyscallDesc::doSyscall(ThreadContext *tc)
 {
     DPRINTF_SYSCALL(Base, "Calling %s...\n", dumper(name(), tc));
 
-    SyscallReturn retval = executor(this, tc);
+    SyscallReturn retval = execute(tc);
 
     if (retval.needsRetry()) {
         // Suspend this ThreadContext while the syscall is pending.
@@ -62,7 +66,7 @@ SyscallDesc::retrySyscall(ThreadContext *tc)
 {
     DPRINTF_SYSCALL(Base, "Retrying %s...\n", dumper(name(), tc));
 
-    SyscallReturn retval = executor(this, tc);
+    SyscallReturn retval = execute(tc);
 
     if (retval.needsRetry()) {
         DPRINTF_SYSCALL(Base, "%s still needs retry.\n", name());
@@ -76,6 +80,20 @@ SyscallDesc::retrySyscall(ThreadContext *tc)
     handleReturn(tc, retval);
 }
 
+SyscallReturn
+SyscallDesc::execute(ThreadContext *tc)
+{
+    const auto start = std::chrono::steady_clock::now();
+    SyscallReturn retval = executor(this, tc);
+    const std::chrono::duration<double> host_time =
+        std::chrono::steady_clock::now() - start;
+
+    if (auto *se = dynamic_cast<SEWorkload *>(tc->getSystemPtr()->workload))
+        se->recordSyscall(_name, host_time.count());
+
+    return retval;
+}
+
 void
 SyscallDesc::setupRetry(ThreadContext *tc)
 {
@@ -102,6 +102,8 @@ class SyscallDesc
     std::string _name;
     int _num;
 
+    /** Run the executor, accounting its host time to the workload. */
+    SyscallReturn execute(ThreadContext *tc);
     void setupRetry(ThreadContext *tc);
     void handleReturn(ThreadContext *tc, const SyscallReturn &ret);
 
@@ -420,7 +420,7 @@ futexFunc(SyscallDesc *desc, ThreadContext *tc,
     } else if (OS::TGT_FUTEX_WAKE == op) {
         return futex_map.wakeup(uaddr, process->tgid(), val);
     } else if (OS::TGT_FUTEX_WAKE_BITSET == op) {
-        return futex_map.wakeup_bitset(uaddr, process->tgid(), val3);
+        return futex_map.wakeup_bitset(uaddr, process->tgid(), val3, val);
     } else if (OS::TGT_FUTEX_REQUEUE == op ||
                OS::TGT_FUTEX_CMP_REQUEUE == op) {
 
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/timeline.hh"
+
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace gem5
+{
+
+namespace timeline
+{
+
+bool _enabled = false;
+unsigned _sampleRate = 1;
+
+namespace
+{
+
+/** Process ids of the two time bases */
+enum Pid
+{
+    SimPid = 1,
+    HostPid = 2
+};
+
+struct Record
+{
+    /** Chrome trace event phase: X, b, e or M */
+    char phase;
+    Pid pid;
+    uint32_t tid;
+    uint64_t id;
+    /** Ticks in simulated time, nanoseconds in host time */
+    uint64_t ts;
+    uint64_t dur;
+    std::string name;
+    Args args;
+};
+
+/** Write a JSON string, with quotes */
+void
+writeString(std::ostream &os, const std::string &str)
+{
+    os << '"';
+    for (char c: str) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            os << buf;
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+class Writer
+{
+  public:
+    Writer(const std::string &path, Tick ticks_per_second);
+    ~Writer();
+
+    /** Get the id of a track, creating it if needed */
+    uint32_t track(Pid pid, const std::string &name);
+
+    void push(Record &&record);
+
+  private:
+    /** Records buffered before waking up the writer thread */
+    static const size_t batchSize = 4096;
+
+    void run();
+    void write(const Record &record);
+    void writeTime(Pid pid, uint64_t time);
+
+    std::ofstream os;
+    /** Microseconds in a tick */
+    const double usPerTick;
+    /** Host time when the timeline was started */
+    const uint64_t hostStart;
+    bool first = true;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Record> pending;
+    bool done = false;
+
+    /** Tracks of each process, by name */
+    std::mutex trackMutex;
+    std::unordered_map<std::string, uint32_t> tracks[2];
+    std::thread thread;
+};
+
+Writer::Writer(const std::string &path, Tick ticks_per_second)
+    : os(path), usPerTick(1e6 / ticks_per_second), hostStart(hostNow())
+{
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    push({'M', SimPid, 0, 0, 0, 0, "process_name",
+          {{"name", "Simulated time"}}});
+    push({'M', HostPid, 0, 0, 0, 0, "process_name",
+          {{"name", "Host time"}}});
+    thread = std::thread(&Writer::run, this);
+}
+
+Writer::~Writer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    cv.notify_one();
+    thread.join();
+    os << "\n]}\n";
+}
+
+uint32_t
+Writer::track(Pid pid, const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(trackMutex);
+    auto &pid_tracks = tracks[pid - SimPid];
+    auto [it, inserted] = pid_tracks.emplace(name, pid_tracks.size() + 1);
+    if (inserted)
+        push({'M', pid, it->second, 0, 0, 0, "thread_name", {{"name", name}}});
+    return it->second;
+}
+
+void
+Writer::push(Record &&record)
+{
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.push_back(std::move(record));
+        wake = pending.size() >= batchSize;
+    }
+    if (wake)
+        cv.notify_one();
+}
+
+void
+Writer::run()
+{
+    std::vector<Record> batch;
+    bool finished = false;
+    while (!finished) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this] {
+                return done || pending.size() >= batchSize;
+            });
+            batch.swap(pending);
+            finished = done;
+        }
+        for (const auto &record: batch)
+            write(record);
+        batch.clear();
+    }
+    os.flush();
+}
+
+void
+Writer::writeTime(Pid pid, uint64_t time)
+{
+    char buf[32];
+    if (pid == SimPid)
+        std::snprintf(buf, sizeof(buf), "%.6f", time * usPerTick);
+    else
+        std::snprintf(buf, sizeof(buf), "%.3f", time / 1e3);
+    os << buf;
+}
+
+void
+Writer::write(const Record &record)
+{
+    os << (first ? "\n" : ",\n");
+    first = false;
+
+    os << "{\"ph\":\"" << record.phase << "\",\"pid\":" << record.pid
+       << ",\"tid\":" << record.tid << ",\"name\":";
+    writeString(os, record.name);
+    if (record.phase != 'M') {
+        os << ",\"ts\":";
+        writeTime(record.pid,
+                  record.pid == HostPid ? record.ts - hostStart : record.ts);
+    }
+    if (record.phase == 'X') {
+        os << ",\"dur\":";
+        writeTime(record.pid, record.dur);
+    } else if (record.phase == 'b' || record.phase == 'e') {
+        // Async slices are matched by category and id, use the track as
+        // the category so that ids only need to be unique in a track
+        os << ",\"cat\":\"t" << record.tid << "\",\"id\":\"0x" << std::hex
+           << record.id << std::dec << '"';
+    }
+    if (!record.args.empty()) {
+        os << ",\"args\":{";
+        for (size_t i = 0; i < record.args.size(); ++i) {
+            if (i)
+                os << ',';
+            writeString(os, record.args[i].first);
+            os << ':';
+            writeString(os, record.args[i].second);
+        }
+        os << '}';
+    }
+    os << '}';
+}
+
+std::unique_ptr<Writer> writer;
+
+} // anonymous namespace
+
+void
+start(const std::string &path, unsigned sample_rate, Tick ticks_per_second)
+{
+    stop();
+    writer.reset(new Writer(path, ticks_per_second));
+    _sampleRate = sample_rate ? sample_rate : 1;
+    _enabled = true;
+}
+
+void
+stop()
+{
+    _enabled = false;
+    writer.reset();
+}
+
+void
+hostSlice(const std::string &track, const std::string &name,
+          uint64_t start, uint64_t end, Tick when)
+{
+    if (!writer)
+        return;
+    writer->push({'X', HostPid, writer->track(HostPid, track), 0, start,
+                  end - start, name, {{"tick", std::to_string(when)}}});
+}
+
+void
+simSlice(const std::string &track, const std::string &name,
+         Tick start, Tick end, const Args &args)
+{
+    if (!writer)
+        return;
+    writer->push({'X', SimPid, writer->track(SimPid, track), 0, start,
+                  end - start, name, args});
+}
+
+void
+asyncSlice(const std::string &track, const std::string &name,
+           uint64_t id, Tick start, Tick end, const Args &args)
+{
+    if (!writer)
+        return;
+    const uint32_t tid = writer->track(SimPid, track);
+    writer->push({'b', SimPid, tid, id, start, 0, name, args});
+    writer->push({'e', SimPid, tid, id, end, 0, name, {}});
+}
+
+} // namespace timeline
+} // namespace gem5
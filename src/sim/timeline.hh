@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Timeline of a simulation in the Chrome trace event format.
+ *
+ * The timeline is a JSON file which can be opened in ui.perfetto.dev or
+ * chrome://tracing. It has two processes. The "Simulated time" process
+ * has a track per SimObject, with slices such as the lifetime of a
+ * packet or the pipeline stages of an instruction, in simulated time.
+ * The "Host time" process has a track per SimObject with the execution
+ * of its events, in host time.
+ *
+ * Recording a slice only queues it. The records are formatted and written
+ * out by a background thread, and the instrumentation points sample one
+ * item out of a configurable number to keep the overhead and file size
+ * down on long runs.
+ */
+
+#ifndef __SIM_TIMELINE_HH__
+#define __SIM_TIMELINE_HH__
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace timeline
+{
+
+/** Key/value annotations of a slice, shown when it is selected */
+typedef std::vector<std::pair<std::string, std::string>> Args;
+
+extern bool _enabled;
+extern unsigned _sampleRate;
+
+/** Whether a timeline is being recorded */
+inline bool enabled() { return _enabled; }
+
+/**
+ * Sampling state of an instrumentation point. Each point keeps its own
+ * sampler, so that the sample rate applies to each kind of item
+ * independently.
+ */
+class Sampler
+{
+  public:
+    /** Return true for one call out of every sample rate calls */
+    bool
+    operator()()
+    {
+        if (++count < _sampleRate)
+            return false;
+        count = 0;
+        return true;
+    }
+
+  private:
+    unsigned count = 0;
+};
+
+/** Current host time in nanoseconds, as used by hostSlice() */
+inline uint64_t
+hostNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Start recording a timeline. Any timeline being recorded is completed
+ * first.
+ *
+ * @param path File to write the timeline to
+ * @param sample_rate Record one item out of sample_rate at each
+ * instrumentation point
+ * @param ticks_per_second Simulated ticks in a second, used to convert
+ * ticks to time
+ */
+void start(const std::string &path, unsigned sample_rate,
+           Tick ticks_per_second);
+
+/** Stop recording, write out the pending records and close the file */
+void stop();
+
+/**
+ * Record a slice in host time, typically the execution of an event.
+ *
+ * @param track Name of the track, usually the name of a SimObject
+ * @param name Name of the slice
+ * @param start Start of the slice, from hostNow()
+ * @param end End of the slice, from hostNow()
+ * @param when Simulated tick the slice happened at
+ */
+void hostSlice(const std::string &track, const std::string &name,
+               uint64_t start, uint64_t end, Tick when);
+
+/**
+ * Record a slice in simulated time which doesn't overlap with the other
+ * slices of the track.
+ *
+ * @param track Name of the track, usually the name of a SimObject
+ * @param name Name of the slice
+ * @param start Start tick of the slice
+ * @param end End tick of the slice
+ */
+void simSlice(const std::string &track, const std::string &name,
+              Tick start, Tick end, const Args &args = {});
+
+/**
+ * Record a slice in simulated time which may overlap with the other
+ * slices of the track, such as the lifetime of a packet. Slices with the
+ * same track and id nest, which can be used to show the steps of an
+ * operation.
+ *
+ * @param track Name of the track, usually the name of a SimObject
+ * @param name Name of the slice
+ * @param id Identifier of the operation within the track
+ * @param start Start tick of the slice
+ * @param end End tick of the slice
+ */
+void asyncSlice(const std::string &track, const std::string &name,
+                uint64_t id, Tick start, Tick end, const Args &args = {});
+
+} // namespace timeline
+} // namespace gem5
+
+#endif // __SIM_TIMELINE_HH__
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "sim/timeline.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+std::string
+readFile(const std::string &path)
+{
+    std::ifstream is(path);
+    std::stringstream ss;
+    ss << is.rdbuf();
+    return ss.str();
+}
+
+} // anonymous namespace
+
+/** Nothing is recorded, and no file written, unless enabled */
+TEST(TimelineTest, Disabled)
+{
+    EXPECT_FALSE(timeline::enabled());
+    timeline::simSlice("system.cpu", "slice", 0, 10);
+}
+
+/** Slices of both time bases are written in the Chrome trace format */
+TEST(TimelineTest, Slices)
+{
+    const std::string path = testing::TempDir() + "timeline.json";
+    // One tick per nanosecond
+    timeline::start(path, 1, 1000000000);
+    EXPECT_TRUE(timeline::enabled());
+
+    timeline::simSlice("system.cpu", "fetch", 1000, 3500,
+                       {{"pc", "0x\"10\""}});
+    timeline::asyncSlice("system.monitor", "ReadReq", 42, 2000, 4000);
+    const uint64_t start = timeline::hostNow();
+    timeline::hostSlice("system.cpu", "tick", start, start + 1500, 1000);
+    timeline::stop();
+    EXPECT_FALSE(timeline::enabled());
+
+    const std::string json = readFile(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(0, json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_EQ(json.size() - 4, json.rfind("\n]}\n"));
+
+    EXPECT_NE(std::string::npos, json.find(
+        "{\"ph\":\"M\",\"pid\":1,\"tid\":0,\"name\":\"process_name\","
+        "\"args\":{\"name\":\"Simulated time\"}}"));
+    EXPECT_NE(std::string::npos, json.find(
+        "{\"ph\":\"M\",\"pid\":1,\"tid\":1,\"name\":\"thread_name\","
+        "\"args\":{\"name\":\"system.cpu\"}}"));
+    EXPECT_NE(std::string::npos, json.find(
+        "{\"ph\":\"X\",\"pid\":1,\"tid\":1,\"name\":\"fetch\","
+        "\"ts\":1.000000,\"dur\":2.500000,"
+        "\"args\":{\"pc\":\"0x\\\"10\\\"\"}}"));
+    EXPECT_NE(std::string::npos, json.find(
+        "{\"ph\":\"b\",\"pid\":1,\"tid\":2,\"name\":\"ReadReq\","
+        "\"ts\":2.000000,\"cat\":\"t2\",\"id\":\"0x2a\"}"));
+    EXPECT_NE(std::string::npos, json.find(
+        "{\"ph\":\"e\",\"pid\":1,\"tid\":2,\"name\":\"ReadReq\","
+        "\"ts\":4.000000,\"cat\":\"t2\",\"id\":\"0x2a\"}"));
+    EXPECT_NE(std::string::npos, json.find(
+        "{\"ph\":\"M\",\"pid\":2,\"tid\":1,\"name\":\"thread_name\","
+        "\"args\":{\"name\":\"system.cpu\"}}"));
+    EXPECT_NE(std::string::npos, json.find(
+        "\"name\":\"tick\",\"ts\":"));
+    EXPECT_NE(std::string::npos, json.find(
+        "\"dur\":1.500,\"args\":{\"tick\":\"1000\"}}"));
+}
+
+/** Each sampler records one item out of the sample rate */
+TEST(TimelineTest, Sampling)
+{
+    const std::string path = testing::TempDir() + "timeline_sample.json";
+    timeline::start(path, 3, 1000000000000);
+
+    timeline::Sampler a, b;
+    int sampled_a = 0, sampled_b = 0;
+    for (int i = 0; i < 9; ++i)
+        sampled_a += a();
+    sampled_b += b();
+    EXPECT_EQ(3, sampled_a);
+    EXPECT_EQ(0, sampled_b);
+
+    timeline::stop();
+    std::remove(path.c_str());
+}
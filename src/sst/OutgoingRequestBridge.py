@@ -37,3 +37,14 @@ class OutgoingRequestBridge(SimObject):
     physical_address_ranges = VectorParam.AddrRange(
         [AddrRange(0x80000000, MaxAddr)], "Physical address ranges."
     )
+    batch_requests = Param.Bool(
+        False,
+        "Hold back timing requests until the SST component collects them "
+        "at the end of each gem5 quantum, instead of forwarding each one "
+        "as it arrives",
+    )
+    max_outstanding_requests = Param.Unsigned(
+        0,
+        "Maximum number of requests waiting for a response from SST, "
+        "or 0 for no limit",
+    )
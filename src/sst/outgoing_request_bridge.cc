@@ -41,7 +41,11 @@ OutgoingRequestBridge::OutgoingRequestBridge(
     outgoingPort(std::string(name()), this),
     sstResponder(nullptr),
     physicalAddressRanges(params.physical_address_ranges.begin(),
-                          params.physical_address_ranges.end())
+                          params.physical_address_ranges.end()),
+    batchRequests(params.batch_requests),
+    maxOutstandingRequests(params.max_outstanding_requests),
+    outstandingRequests(0),
+    needRetry(false)
 {
 }
 
@@ -96,7 +100,52 @@ OutgoingRequestBridge::setResponder(SSTResponderInterface* responder)
 bool
 OutgoingRequestBridge::sendTimingResp(gem5::PacketPtr pkt)
 {
-    return outgoingPort.sendTimingResp(pkt);
+    if (!outgoingPort.sendTimingResp(pkt))
+        return false;
+
+    assert(outstandingRequests > 0);
+    outstandingRequests--;
+    if (needRetry) {
+        needRetry = false;
+        outgoingPort.sendRetryReq();
+    }
+    return true;
+}
+
+void
+OutgoingRequestBridge::forwardRequest(PacketPtr pkt)
+{
+    sstResponder->handleRecvTimingReq(pkt);
+}
+
+bool
+OutgoingRequestBridge::handleRecvTimingReq(PacketPtr pkt)
+{
+    if (pkt->needsResponse()) {
+        if (maxOutstandingRequests &&
+                outstandingRequests >= maxOutstandingRequests) {
+            needRetry = true;
+            return false;
+        }
+        outstandingRequests++;
+    }
+
+    if (batchRequests)
+        pendingRequests.push_back(pkt);
+    else
+        forwardRequest(pkt);
+    return true;
+}
+
+void
+OutgoingRequestBridge::sendPendingRequests()
+{
+    // Take the batch first, a response sent back to gem5 while forwarding
+    // may well trigger new requests.
+    std::vector<PacketPtr> batch;
+    batch.swap(pendingRequests);
+    for (auto pkt: batch)
+        forwardRequest(pkt);
 }
 
 void
@@ -133,8 +182,7 @@ bool
 OutgoingRequestBridge::
 OutgoingRequestPort::recvTimingReq(PacketPtr pkt)
 {
-    owner->sstResponder->handleRecvTimingReq(pkt);
-    return true;
+    return owner->handleRecvTimingReq(pkt);
 }
 
 void
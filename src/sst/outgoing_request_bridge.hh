@@ -79,6 +79,21 @@ class OutgoingRequestBridge: public SimObject
 
     AddrRangeList physicalAddressRanges;
 
+  private:
+    // Whether timing requests are held back until sendPendingRequests().
+    const bool batchRequests;
+    // Maximum number of requests waiting for a response, 0 if unlimited.
+    const unsigned maxOutstandingRequests;
+    // Requests held back while batching.
+    std::vector<PacketPtr> pendingRequests;
+    // Number of requests accepted from gem5 and still waiting for a
+    // response, whether they were forwarded to SST yet or not.
+    unsigned outstandingRequests;
+    // Whether a request was refused because too many were outstanding.
+    bool needRetry;
+
+    void forwardRequest(PacketPtr pkt);
+
   public:
     OutgoingRequestBridge(const OutgoingRequestBridgeParams &params);
     ~OutgoingRequestBridge();
@@ -108,6 +123,13 @@ class OutgoingRequestBridge: public SimObject
     // This function is called when SST wants to sent a timing response to gem5
     bool sendTimingResp(PacketPtr pkt);
 
+    // Handle a timing request from gem5, holding it back when batching.
+    bool handleRecvTimingReq(PacketPtr pkt);
+
+    // The SST component calls this whenever gem5 yields control to SST, so
+    // that all the requests of the last quantum go out together.
+    void sendPendingRequests();
+
     // This function is called when SST sends response having an invalidate .
     void sendTimingSnoopReq(PacketPtr pkt);
 
@@ -28,8 +28,8 @@
 #ifndef __SYSTEMC_CORE_SCHED_EVENT_HH__
 #define __SYSTEMC_CORE_SCHED_EVENT_HH__
 
+#include <cassert>
 #include <functional>
-#include <list>
 
 #include "base/types.hh"
 
@@ -38,15 +38,60 @@ namespace sc_gem5
 
 class ScEvent;
 
-typedef std::list<ScEvent *> ScEvents;
+// The links an ScEvent uses to sit on an ScEvents list.
+struct ScEventLink
+{
+    ScEventLink *prevEvent = nullptr;
+    ScEventLink *nextEvent = nullptr;
+};
+
+// An intrusive list of ScEvents. The links live in the events themselves, so
+// scheduling and descheduling an event never allocates memory.
+class ScEvents
+{
+  private:
+    ScEventLink head;
+
+  public:
+    ScEvents()
+    {
+        head.prevEvent = &head;
+        head.nextEvent = &head;
+    }
+
+    ScEvents(const ScEvents &) = delete;
+    ScEvents &operator=(const ScEvents &) = delete;
+
+    bool empty() const { return head.nextEvent == &head; }
+
+    inline ScEvent *front() const;
+    inline ScEvent *back() const;
 
-class ScEvent
+    void
+    pushBack(ScEventLink *e)
+    {
+        e->prevEvent = head.prevEvent;
+        e->nextEvent = &head;
+        head.prevEvent->nextEvent = e;
+        head.prevEvent = e;
+    }
+
+    static void
+    remove(ScEventLink *e)
+    {
+        e->prevEvent->nextEvent = e->nextEvent;
+        e->nextEvent->prevEvent = e->prevEvent;
+        e->prevEvent = nullptr;
+        e->nextEvent = nullptr;
+    }
+};
+
+class ScEvent : public ScEventLink
 {
   private:
     std::function<void()> work;
     gem5::Tick _when;
     ScEvents *_events;
-    ScEvents::iterator _it;
 
     friend class Scheduler;
 
@@ -56,16 +101,14 @@ class ScEvent
         when(w);
         assert(!scheduled());
         _events = &events;
-        _events->push_back(this);
-        _it = _events->end();
-        _it--;
+        _events->pushBack(this);
     }
 
     void
     deschedule()
     {
         assert(scheduled());
-        _events->erase(_it);
+        ScEvents::remove(this);
         _events = nullptr;
     }
   public:
@@ -84,6 +127,18 @@ class ScEvent
     void run() { deschedule(); work(); }
 };
 
+ScEvent *
+ScEvents::front() const
+{
+    return empty() ? nullptr : static_cast<ScEvent *>(head.nextEvent);
+}
+
+ScEvent *
+ScEvents::back() const
+{
+    return empty() ? nullptr : static_cast<ScEvent *>(head.prevEvent);
+}
+
 } // namespace sc_gem5
 
 #endif // __SYSTEMC_CORE_SCHED_EVENT_HH__
@@ -30,10 +30,10 @@
 
 #include <atomic>
 #include <functional>
-#include <list>
 #include <map>
 #include <mutex>
 #include <set>
+#include <stack>
 #include <vector>
 
 #include "base/logging.hh"
@@ -147,8 +147,6 @@ typedef NodeList<Channel> ChannelList;
 class Scheduler
 {
   public:
-    typedef std::list<ScEvent *> ScEvents;
-
     class TimeSlot : public gem5::Event
     {
       public:
@@ -172,7 +170,9 @@ class Scheduler
 
     };
 
-    typedef std::list<TimeSlot *> TimeSlots;
+    // Time slots keyed by the time they happen at, so finding the slot for
+    // a timed notification doesn't need to walk all the earlier ones.
+    typedef std::map<gem5::Tick, TimeSlot *> TimeSlots;
 
     Scheduler();
     ~Scheduler();
@@ -265,14 +265,12 @@ class Scheduler
         }
 
         // Timed notification/timeout.
-        auto it = timeSlots.begin();
-        while (it != timeSlots.end() && (*it)->targeted_when < tick)
-            it++;
-        if (it == timeSlots.end() || (*it)->targeted_when != tick) {
-            it = timeSlots.emplace(it, acquireTimeSlot(tick));
-            schedule(*it, tick);
+        auto [it, inserted] = timeSlots.try_emplace(tick, nullptr);
+        if (inserted) {
+            it->second = acquireTimeSlot(tick);
+            schedule(it->second, tick);
         }
-        event->schedule((*it)->events, tick);
+        event->schedule(it->second->events, tick);
     }
 
     // For descheduling delayed/timed notifications/timeouts.
@@ -289,15 +287,11 @@ class Scheduler
         }
 
         // Timed notification/timeout.
-        auto tsit = timeSlots.begin();
-        while (tsit != timeSlots.end() &&
-               (*tsit)->targeted_when < event->when())
-            tsit++;
+        auto tsit = timeSlots.find(event->when());
 
-        panic_if(tsit == timeSlots.end() ||
-                 (*tsit)->targeted_when != event->when(),
+        panic_if(tsit == timeSlots.end(),
                 "Descheduling event at time with no events.");
-        TimeSlot *ts = *tsit;
+        TimeSlot *ts = tsit->second;
         ScEvents &events = ts->events;
         assert(on == &events);
         event->deschedule();
@@ -312,7 +306,7 @@ class Scheduler
     void
     completeTimeSlot(TimeSlot *ts)
     {
-        assert(ts == timeSlots.front());
+        assert(ts == timeSlots.begin()->second);
         timeSlots.erase(timeSlots.begin());
         if (!runToTime && starved())
             scheduleStarvationEvent();
@@ -348,7 +342,7 @@ class Scheduler
         if (pendingCurr())
             return 0;
         if (pendingFuture())
-            return timeSlots.front()->targeted_when - getCurTick();
+            return timeSlots.begin()->first - getCurTick();
         return gem5::MaxTick - getCurTick();
     }
 
@@ -409,7 +403,7 @@ class Scheduler
             ts = new TimeSlot(this);
         }
         ts->targeted_when = tick;
-        ts->events.clear();
+        assert(ts->events.empty());
         return ts;
     }
 
@@ -481,7 +475,7 @@ class Scheduler
         return (readyListMethods.empty() && readyListThreads.empty() &&
                 updateList.empty() && deltas.empty() &&
                 (timeSlots.empty() ||
-                 timeSlots.front()->targeted_when > maxTick) &&
+                 timeSlots.begin()->first > maxTick) &&
                 initList.empty());
     }
     gem5::MemberEventWrapper<&Scheduler::pause> starvationEvent;
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * A microbenchmark for the scheduler. Lots of methods with fine grained
+ * timed notifications, a few threads waiting on timeouts, and a ring of
+ * methods passing delta notifications around. Every process stops after a
+ * fixed number of activations so the simulation ends by starvation with a
+ * known amount of work, which makes the host time of a run comparable
+ * across scheduler changes.
+ */
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+
+#include <iostream>
+#include <vector>
+
+#include "systemc.h"
+
+static const int Activations = 2000;
+static const int NumTimedMethods = 64;
+static const int NumThreads = 8;
+static const int RingSize = 16;
+
+SC_MODULE(timed_method)
+{
+    sc_event ev;
+    sc_time delay;
+    int count;
+
+    void
+    run()
+    {
+        if (++count < Activations)
+            ev.notify(delay);
+    }
+
+    SC_HAS_PROCESS(timed_method);
+    timed_method(sc_module_name name, int ns) :
+        sc_module(name), delay(ns, SC_NS), count(0)
+    {
+        SC_METHOD(run);
+        sensitive << ev;
+    }
+};
+
+SC_MODULE(timed_thread)
+{
+    sc_time delay;
+    int count;
+
+    void
+    run()
+    {
+        while (++count < Activations)
+            wait(delay);
+    }
+
+    SC_HAS_PROCESS(timed_thread);
+    timed_thread(sc_module_name name, int ns) :
+        sc_module(name), delay(ns, SC_NS), count(0)
+    {
+        SC_THREAD(run);
+    }
+};
+
+SC_MODULE(delta_ring)
+{
+    sc_event ev[RingSize];
+    int count;
+    int rounds;
+
+    void
+    hop(int idx)
+    {
+        count++;
+        if (idx + 1 < RingSize) {
+            ev[idx + 1].notify(SC_ZERO_TIME);
+        } else if (++rounds < Activations) {
+            ev[0].notify(1, SC_NS);
+        }
+    }
+
+    SC_CTOR(delta_ring) : count(0), rounds(0)
+    {
+        for (int i = 0; i < RingSize; i++) {
+            sc_spawn_options opts;
+            opts.spawn_method();
+            opts.set_sensitivity(&ev[i]);
+            // The first hop starts the first round at initialization.
+            if (i != 0)
+                opts.dont_initialize();
+            sc_spawn([this, i]() { hop(i); }, sc_gen_unique_name("hop"),
+                     &opts);
+        }
+    }
+};
+
+int
+sc_main(int argc, char *argv[])
+{
+    std::vector<timed_method *> methods;
+    for (int i = 0; i < NumTimedMethods; i++) {
+        methods.push_back(new timed_method(
+                    sc_gen_unique_name("method"), 1 + i % 8));
+    }
+    std::vector<timed_thread *> threads;
+    for (int i = 0; i < NumThreads; i++) {
+        threads.push_back(new timed_thread(
+                    sc_gen_unique_name("thread"), 1 + i));
+    }
+    delta_ring ring("ring");
+
+    sc_start();
+
+    long method_count = 0;
+    for (auto m: methods)
+        method_count += m->count;
+    long thread_count = 0;
+    for (auto t: threads)
+        thread_count += t->count;
+
+    std::cout << "method activations: " << method_count << std::endl;
+    std::cout << "thread activations: " << thread_count << std::endl;
+    std::cout << "ring activations: " << ring.count << std::endl;
+
+    return 0;
+}
@@ -58,6 +58,7 @@
 
 #include "systemc/tlm_bridge/gem5_to_tlm.hh"
 
+#include <cstring>
 #include <utility>
 
 #include "params/Gem5ToTlmBridge32.hh"
@@ -275,7 +276,7 @@ Gem5ToTlmBridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
     AddrRange r(start, end);
     auto it = backdoorMap.contains(r);
     if (it != backdoorMap.end())
-        return it->second;
+        return it->second.backdoor;
 
     // If not, ask the target for one.
     tlm::tlm_dmi dmi_data;
@@ -290,11 +291,48 @@ Gem5ToTlmBridge<BITWIDTH>::getBackdoor(tlm::tlm_generic_payload &trans)
     backdoor->readable(dmi_data.is_read_allowed());
     backdoor->writeable(dmi_data.is_write_allowed());
 
-    backdoorMap.insert(dmi_r, backdoor);
+    backdoorMap.insert(dmi_r, {backdoor,
+            dmi_data.get_read_latency().value(),
+            dmi_data.get_write_latency().value()});
 
     return backdoor;
 }
 
+template <unsigned int BITWIDTH>
+bool
+Gem5ToTlmBridge<BITWIDTH>::tryDmiAccess(PacketPtr packet, Tick &latency)
+{
+    if (backdoorMap.empty() || packet->isAtomicOp() ||
+            (packet->req->getFlags() & Request::NO_ACCESS) ||
+            !(packet->isRead() || packet->isWrite()) ||
+            packet->findNextSenderState<Gem5SystemC::TlmSenderState>()) {
+        return false;
+    }
+
+    auto it = backdoorMap.contains(packet->getAddrRange());
+    if (it == backdoorMap.end())
+        return false;
+
+    const DmiRegion &dmi = it->second;
+    uint8_t *host = dmi.backdoor->ptr() +
+        (packet->getAddr() - dmi.backdoor->range().start());
+    if (packet->isRead()) {
+        if (!dmi.backdoor->readable())
+            return false;
+        std::memcpy(packet->getPtr<uint8_t>(), host, packet->getSize());
+        latency = dmi.readLatency;
+    } else {
+        if (!dmi.backdoor->writeable())
+            return false;
+        std::memcpy(host, packet->getConstPtr<uint8_t>(), packet->getSize());
+        latency = dmi.writeLatency;
+    }
+
+    if (packet->needsResponse())
+        packet->makeResponse();
+    return true;
+}
+
 // Similar to TLM's blocking transport (LT)
 template <unsigned int BITWIDTH>
 Tick
@@ -303,6 +341,12 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
     panic_if(packet->cacheResponding(),
              "Should not see packets where cache is responding");
 
+    // Skip the transaction altogether if the target already gave us a
+    // direct pointer to this memory.
+    Tick latency;
+    if (tryDmiAccess(packet, latency))
+        return latency;
+
     // Prepare the transaction.
     auto *trans = packet2payload(packet);
 
@@ -311,6 +355,11 @@ Gem5ToTlmBridge<BITWIDTH>::recvAtomic(PacketPtr packet)
     if (trans->get_command() != tlm::TLM_IGNORE_COMMAND) {
         // Execute b_transport:
         socket->b_transport(*trans, delay);
+        // If the hint said we could use DMI, set it up for next time.
+        if (trans->is_dmi_allowed() &&
+                trans->get_response_status() == tlm::TLM_OK_RESPONSE) {
+            getBackdoor(*trans);
+        }
     }
 
     if (packet->needsResponse())
@@ -562,8 +611,8 @@ Gem5ToTlmBridge<BITWIDTH>::invalidate_direct_mem_ptr(
         if (it == backdoorMap.end())
             break;
 
-        it->second->invalidate();
-        delete it->second;
+        it->second.backdoor->invalidate();
+        delete it->second.backdoor;
         backdoorMap.erase(it);
     };
 }
@@ -185,8 +185,29 @@ class Gem5ToTlmBridge : public Gem5ToTlmBridgeBase
   protected:
     void pec(tlm::tlm_generic_payload &trans, const tlm::tlm_phase &phase);
 
+    /**
+     * A DMI region granted by the TLM target, along with the latencies
+     * it asked us to model for accesses through it.
+     */
+    struct DmiRegion
+    {
+        gem5::MemBackdoorPtr backdoor;
+        gem5::Tick readLatency;
+        gem5::Tick writeLatency;
+    };
+
     gem5::MemBackdoorPtr getBackdoor(tlm::tlm_generic_payload &trans);
-    gem5::AddrRangeMap<gem5::MemBackdoorPtr> backdoorMap;
+    gem5::AddrRangeMap<DmiRegion> backdoorMap;
+
+    /**
+     * Try to complete an atomic access through a DMI region we already
+     * know about, without building a transaction at all.
+     *
+     * @param packet The packet to complete
+     * @param latency Set to the DMI latency if the access was done
+     * @return Whether the access was done
+     */
+    bool tryDmiAccess(gem5::PacketPtr packet, gem5::Tick &latency);
 
     // The gem5 port interface.
     gem5::Tick recvAtomic(gem5::PacketPtr packet);
@@ -138,7 +138,7 @@ payload2packet(RequestorID _id, tlm::tlm_generic_payload &trans)
         AtomicOpFunctorPtr amo_op = AtomicOpFunctorPtr(
             atomic_ex->getAtomicOpFunctor()->clone());
         // FIXME: correct the context_id and pc state.
-        req = std::make_shared<Request>(
+        req = Request::create(
             trans.get_address(), trans.get_data_length(), flags, _id,
             0, 0, std::move(amo_op));
         req->setPaddr(trans.get_address());
@@ -158,7 +158,7 @@ payload2packet(RequestorID _id, tlm::tlm_generic_payload &trans)
                             "command");
         }
         Request::Flags flags;
-        req = std::make_shared<Request>(
+        req = Request::create(
             trans.get_address(), trans.get_data_length(), flags, _id);
     }
 
@@ -221,11 +221,17 @@ TlmToGem5Bridge<BITWIDTH>::sendBeginResp(tlm::tlm_generic_payload &trans,
     }
     Addr start_addr = trans.get_address();
     Addr length = trans.get_data_length();
-
-    MemBackdoorReq req({start_addr, start_addr + length}, flags);
-    MemBackdoorPtr backdoor = nullptr;
-
-    bmp.sendMemBackdoorReq(req, backdoor);
+    AddrRange range(start_addr, start_addr + length);
+
+    // Only go looking for a backdoor if we don't already have one, rather
+    // than sending a request through the memory system for every response.
+    MemBackdoorPtr backdoor =
+        findBackdoor(range, flags == MemBackdoor::Writeable);
+    if (!backdoor) {
+        MemBackdoorReq req(range, flags);
+        bmp.sendMemBackdoorReq(req, backdoor);
+        cacheBackdoor(backdoor);
+    }
 
     if (backdoor)
         trans.set_dmi_allowed(true);
@@ -317,6 +323,20 @@ TlmToGem5Bridge<BITWIDTH>::cacheBackdoor(gem5::MemBackdoorPtr backdoor)
     }
 }
 
+template <unsigned int BITWIDTH>
+gem5::MemBackdoorPtr
+TlmToGem5Bridge<BITWIDTH>::findBackdoor(const AddrRange &range,
+                                        bool write) const
+{
+    for (auto &b : requestedBackdoors) {
+        if (range.isSubset(b->range()) &&
+                (write ? b->writeable() : b->readable())) {
+            return b;
+        }
+    }
+    return nullptr;
+}
+
 template <unsigned int BITWIDTH>
 void
 TlmToGem5Bridge<BITWIDTH>::invalidateDmi(const gem5::MemBackdoor &backdoor)
@@ -375,20 +395,17 @@ TlmToGem5Bridge<BITWIDTH>::b_transport(tlm::tlm_generic_payload &trans,
                                        sc_core::sc_time &t)
 {
     auto [pkt, pkt_created] = payload2packet(_id, trans);
-    pkt->pushSenderState(new Gem5SystemC::TlmSenderState(trans));
+    // The packet is back before we return, so its sender state can live on
+    // the stack.
+    Gem5SystemC::TlmSenderState sender_state(trans);
+    pkt->pushSenderState(&sender_state);
 
-    MemBackdoorPtr backdoor = nullptr;
     Tick ticks = 0;
 
     // Check if we have a backdoor meet the request. If yes, we can just hints
     // the requestor the DMI is supported.
-    for (auto& b : requestedBackdoors) {
-        if (pkt->getAddrRange().isSubset(b->range()) &&
-            ((!pkt->isWrite() && b->readable()) ||
-             (pkt->isWrite() && b->writeable()))) {
-            backdoor = b;
-        }
-    }
+    MemBackdoorPtr backdoor =
+        findBackdoor(pkt->getAddrRange(), pkt->isWrite());
 
     if (backdoor) {
         ticks = bmp.sendAtomic(pkt);
@@ -413,12 +430,9 @@ TlmToGem5Bridge<BITWIDTH>::b_transport(tlm::tlm_generic_payload &trans,
     // update time
     t += delay;
 
-    gem5::Packet::SenderState *senderState = pkt->popSenderState();
-    sc_assert(
-        nullptr != dynamic_cast<Gem5SystemC::TlmSenderState*>(senderState));
-
-    // clean up
-    delete senderState;
+    [[maybe_unused]] gem5::Packet::SenderState *senderState =
+        pkt->popSenderState();
+    sc_assert(senderState == &sender_state);
 
     setPayloadResponse(trans, pkt);
 
@@ -432,16 +446,14 @@ TlmToGem5Bridge<BITWIDTH>::transport_dbg(tlm::tlm_generic_payload &trans)
 {
     auto [pkt, pkt_created] = payload2packet(_id, trans);
     if (pkt != nullptr) {
-        pkt->pushSenderState(new Gem5SystemC::TlmSenderState(trans));
+        Gem5SystemC::TlmSenderState sender_state(trans);
+        pkt->pushSenderState(&sender_state);
 
         bmp.sendFunctional(pkt);
 
-        gem5::Packet::SenderState *senderState = pkt->popSenderState();
-        sc_assert(
-            nullptr != dynamic_cast<Gem5SystemC::TlmSenderState*>(senderState));
-
-        // clean up
-        delete senderState;
+        [[maybe_unused]] gem5::Packet::SenderState *senderState =
+            pkt->popSenderState();
+        sc_assert(senderState == &sender_state);
 
         if (pkt_created)
             destroyPacket(pkt);
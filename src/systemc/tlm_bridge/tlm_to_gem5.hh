@@ -145,6 +145,13 @@ class TlmToGem5Bridge : public TlmToGem5BridgeBase
 
     void cacheBackdoor(gem5::MemBackdoorPtr backdoor);
 
+    /**
+     * Find a backdoor we already got from gem5 which covers a range with
+     * the given access, or nullptr if there is none.
+     */
+    gem5::MemBackdoorPtr findBackdoor(const gem5::AddrRange &range,
+                                      bool write) const;
+
   protected:
     // payload event call back
     void peq_cb(tlm::tlm_generic_payload &trans, const tlm::tlm_phase &phase);
@@ -24,14 +24,26 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import argparse
+
 import m5
 from m5.objects import *
 
 m5.util.addToPath("../../../configs/")
 from common.Caches import *
 
+parser = argparse.ArgumentParser(description="Cache hierarchy tester")
+parser.add_argument("--num-cores", type=int, default=8)
+parser.add_argument(
+    "--tags-only",
+    action="store_true",
+    help="Keep the cache data in the backing memory only",
+)
+
+args = parser.parse_args()
+
 # MAX CORES IS 8 with the fals sharing method
-nb_cores = 8
+nb_cores = args.num_cores
 cpus = [MemTest(max_loads=1e5, progress_interval=1e4) for i in range(nb_cores)]
 
 # system simulated
@@ -49,7 +61,12 @@ system.cpu_clk_domain = SrcClockDomain(
 )
 
 system.toL2Bus = L2XBar(clk_domain=system.cpu_clk_domain)
-system.l2c = L2Cache(clk_domain=system.cpu_clk_domain, size="64kB", assoc=8)
+system.l2c = L2Cache(
+    clk_domain=system.cpu_clk_domain,
+    size="64kB",
+    assoc=8,
+    tags_only=args.tags_only,
+)
 system.l2c.cpu_side = system.toL2Bus.mem_side_ports
 
 # connect l2c to membus
@@ -59,7 +76,7 @@ system.l2c.mem_side = system.membus.cpu_side_ports
 for cpu in cpus:
     # All cpus are associated with cpu_clk_domain
     cpu.clk_domain = system.cpu_clk_domain
-    cpu.l1c = L1Cache(size="32kB", assoc=4)
+    cpu.l1c = L1Cache(size="32kB", assoc=4, tags_only=args.tags_only)
     cpu.l1c.cpu_side = cpu.port
     cpu.l1c.mem_side = system.toL2Bus.cpu_side_ports
 
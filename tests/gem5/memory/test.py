@@ -70,6 +70,17 @@ gem5_verify_config(
     length=constants.long_tag,
 )
 
+# Two tags-only L1s share the backing memory, so every block they fill
+# or write back must not overwrite the data the other one wrote through
+gem5_verify_config(
+    name="memtest_tags_only",
+    verifiers=(),  # No need for verfiers this will return non-zero on fail
+    config=joinpath(getcwd(), "memtest-run.py"),
+    config_args=["--num-cores=2", "--tags-only"],
+    valid_isas=(constants.null_tag,),
+    length=constants.long_tag,
+)
+
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
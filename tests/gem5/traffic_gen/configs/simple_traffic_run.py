@@ -180,6 +180,20 @@ parser.add_argument(
     help="The arguments needed to instantiate the memory class.",
 )
 
+parser.add_argument(
+    "--mem-sched",
+    type=str,
+    default=None,
+    choices=["fcfs", "frfcfs", "frfcfs_indexed"],
+    help="Override the scheduling policy of the memory controllers.",
+)
+
+parser.add_argument(
+    "--channel-event-queues",
+    action="store_true",
+    help="Simulate every memory channel on its own event queue.",
+)
+
 args = parser.parse_args()
 
 cache_hierarchy = cache_factory(args.cache_class)
@@ -189,6 +203,13 @@ memory_class = getattr(
 )
 memory = memory_class(*args.mem_args)
 
+if args.mem_sched:
+    for ctrl in memory.get_memory_controllers():
+        ctrl.mem_sched_policy = args.mem_sched
+
+if args.channel_event_queues:
+    memory.set_channel_event_queues()
+
 generator = generator_factory(
     args.generator_class, args.generator_cores, memory.get_size()
 )
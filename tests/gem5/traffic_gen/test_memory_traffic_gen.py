@@ -128,5 +128,59 @@ def create_dual_core_tests(module, memory_classes):
                 )
 
 
+def create_indexed_sched_tests(module, memory_classes):
+    # The indexed FR-FCFS scheduler must make the same decisions as
+    # FR-FCFS, so it has to match the same trusted stats.
+    generator_classes = ["LinearGenerator", "RandomGenerator", "GUPSGenerator"]
+    for generator_class in generator_classes:
+        for memory_class in memory_classes:
+            test_memory(
+                generator_class,
+                "1",
+                "NoCache",
+                module,
+                memory_class,
+                "512MiB",
+                "--mem-sched=frfcfs_indexed",
+            )
+
+
+def create_channel_event_queue_tests(module, memory_classes):
+    # The crossings between the event queues add latency, so the stats
+    # don't match the trusted ones. Only check that the simulation
+    # completes.
+    for memory_class in memory_classes:
+        gem5_verify_config(
+            name=f"test-memory-channel-eventqs-{memory_class}",
+            fixtures=(),
+            verifiers=(),
+            config=joinpath(
+                config.base_dir,
+                "tests",
+                "gem5",
+                "traffic_gen",
+                "configs",
+                "simple_traffic_run.py",
+            ),
+            config_args=[
+                "RandomGenerator",
+                "1",
+                "NoCache",
+                module,
+                memory_class,
+                "512MiB",
+                "--channel-event-queues",
+            ],
+            valid_isas=(constants.all_compiled_tag,),
+            valid_hosts=constants.supported_hosts,
+            length=constants.quick_tag,
+        )
+
+
 create_single_core_tests("gem5.components.memory", memory_classes)
 create_dual_core_tests("gem5.components.memory", memory_classes)
+create_indexed_sched_tests("gem5.components.memory", memory_classes)
+create_channel_event_queue_tests(
+    "gem5.components.memory",
+    ["DualChannelDDR4_2400", "HBM2Stack"],
+)
@@ -0,0 +1,68 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import math
+import unittest
+
+from gem5.simulate.sampling import summarize
+
+
+class SamplingSummaryTestSuite(unittest.TestCase):
+    """Tests gem5.simulate.sampling.summarize."""
+
+    def test_no_samples(self) -> None:
+        summary = summarize([], 0.95)
+        self.assertEqual(0, summary["samples"])
+        self.assertNotIn("mean", summary)
+
+    def test_one_sample(self) -> None:
+        summary = summarize([1.5], 0.95)
+        self.assertEqual(1, summary["samples"])
+        self.assertEqual(1.5, summary["mean"])
+        self.assertNotIn("interval", summary)
+
+    def test_interval(self) -> None:
+        values = [1.0, 2.0, 3.0, 4.0]
+        summary = summarize(values, 0.95)
+        stdev = math.sqrt(5 / 3)
+        self.assertEqual(4, summary["samples"])
+        self.assertAlmostEqual(2.5, summary["mean"])
+        self.assertAlmostEqual(stdev, summary["stdev"])
+        self.assertAlmostEqual(1.959964 * stdev / 2, summary["interval"], 5)
+        self.assertAlmostEqual(
+            summary["interval"] / 2.5, summary["relative_error"]
+        )
+
+    def test_higher_confidence_is_wider(self) -> None:
+        values = [1.0, 1.2, 0.9, 1.1, 1.05]
+        self.assertLess(
+            summarize(values, 0.9)["interval"],
+            summarize(values, 0.997)["interval"],
+        )
+
+    def test_invalid_confidence(self) -> None:
+        with self.assertRaises(ValueError):
+            summarize([1.0, 2.0], 1.0)
@@ -31,8 +31,10 @@ import unittest
 from pathlib import Path
 
 from gem5.resources.md5_utils import (
+    md5_cached,
     md5_dir,
     md5_file,
+    record_md5,
 )
 
 
@@ -116,3 +118,56 @@ class MD5DirTestSuite(unittest.TestCase):
         shutil.rmtree(dir2)
 
         self.assertEqual(first_md5, second_md5)
+
+
+class MD5CachedTestSuite(unittest.TestCase):
+    """Test cases for gem5.resources.md5_utils.md5_cached()"""
+
+    def setUp(self) -> None:
+        self.dir = Path(tempfile.mkdtemp())
+
+    def tearDown(self) -> None:
+        shutil.rmtree(self.dir)
+
+    def test_md5CachedMatchesMd5(self) -> None:
+        # The memoized md5 must be the real md5 of the file, both when it is
+        # computed and when it is read back.
+        path = self.dir / "file"
+        path.write_text("This is a test string, to be put in a temp file")
+
+        self.assertEqual("b113b29fce251f2023066c3fda2ec9dd", md5_cached(path))
+        self.assertEqual("b113b29fce251f2023066c3fda2ec9dd", md5_cached(path))
+
+    def test_md5CachedUsesMemo(self) -> None:
+        # An unchanged file is not hashed again, so a recorded value is
+        # returned as is.
+        path = self.dir / "file"
+        path.write_text("This is a test")
+        record_md5(path, "recorded")
+
+        self.assertEqual("recorded", md5_cached(path))
+
+    def test_md5CachedDetectsChanges(self) -> None:
+        # Changing the file invalidates the memoized md5.
+        path = self.dir / "file"
+        path.write_text("This is a test")
+        record_md5(path, "recorded")
+        path.write_text("This is another test")
+
+        self.assertEqual(md5_file(path), md5_cached(path))
+
+    def test_md5CachedDir(self) -> None:
+        # The memo of a directory is kept outside of it, so that it doesn't
+        # change the md5 of the directory, and it is invalidated by changes
+        # to the files in the directory.
+        dir = self.dir / "dir"
+        dir.mkdir()
+        (dir / "file1").write_text("Some test data here")
+
+        first_md5 = md5_cached(dir)
+        self.assertEqual(md5_dir(dir), first_md5)
+        self.assertEqual(first_md5, md5_cached(dir))
+
+        (dir / "file2").write_text("Some more test data")
+        self.assertEqual(md5_dir(dir), md5_cached(dir))
+        self.assertNotEqual(first_md5, md5_cached(dir))
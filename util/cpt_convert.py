@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Convert a checkpoint file (m5.cpt) between the text and the binary
+# format (written with m5.checkpoint(dir, binary=True)). The format of the
+# input is detected automatically and the output uses the other one.
+#
+# Usage: cpt_convert.py <m5.cpt> <output>
+#
+# The module can also be imported (see cpt_upgrader.py) to read a binary
+# checkpoint into a ConfigParser and to write it back.
+
+import configparser
+import struct
+import sys
+
+MAGIC = b"gem5cpt\0"
+VERSION = 1
+
+# struct formats of the raw array elements, indexed by (kind, size)
+RAW_FORMATS = {
+    ("i", 1): "b",
+    ("i", 2): "h",
+    ("i", 4): "i",
+    ("i", 8): "q",
+    ("u", 1): "B",
+    ("u", 2): "H",
+    ("u", 4): "I",
+    ("u", 8): "Q",
+    ("f", 4): "f",
+    ("f", 8): "d",
+}
+
+
+def is_binary(path):
+    with open(path, "rb") as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+
+def new_config():
+    cpt = configparser.ConfigParser(interpolation=None)
+    # gem5 is case sensitive with paramaters
+    cpt.optionxform = str
+    return cpt
+
+
+class Reader:
+    def __init__(self, buf):
+        self.buf = buf
+        self.pos = 0
+
+    def unpack(self, fmt):
+        values = struct.unpack_from("=" + fmt, self.buf, self.pos)
+        self.pos += struct.calcsize("=" + fmt)
+        return values
+
+    def string(self):
+        (size,) = self.unpack("I")
+        value = self.buf[self.pos : self.pos + size].decode()
+        self.pos += size
+        return value
+
+
+def read_binary(path):
+    """Read a binary checkpoint.
+
+    Returns a ConfigParser with the contents of the checkpoint, and a
+    dictionary with the (kind, size) of the entries that were stored as
+    raw arrays so that write_binary() can store them the same way.
+    """
+    with open(path, "rb") as f:
+        buf = f.read()
+
+    if buf[: len(MAGIC)] != MAGIC:
+        raise ValueError(f"{path} is not a binary checkpoint")
+    reader = Reader(buf)
+    reader.pos = len(MAGIC)
+    if reader.unpack("I")[0] != VERSION:
+        raise ValueError(f"Unsupported binary checkpoint version in {path}")
+
+    cpt = new_config()
+    raw_types = {}
+    section = None
+    while reader.pos < len(buf):
+        (record,) = reader.unpack("c")
+        if record == b"S":
+            section = reader.string()
+            if not cpt.has_section(section):
+                cpt.add_section(section)
+        elif record == b"E":
+            (append,) = reader.unpack("B")
+            key = reader.string()
+            value = reader.string()
+            if append and cpt.has_option(section, key):
+                value = cpt.get(section, key) + " " + value
+            cpt.set(section, key, value)
+        elif record == b"R":
+            key = reader.string()
+            kind, size, count = reader.unpack("cBQ")
+            kind = kind.decode()
+            fmt = RAW_FORMATS.get((kind, size))
+            if fmt is None:
+                raise ValueError(
+                    f"Unsupported raw entry {section}:{key} "
+                    f"(kind {kind}, size {size})"
+                )
+            values = reader.unpack(f"{count}{fmt}")
+            cpt.set(section, key, " ".join(str(v) for v in values))
+            raw_types[(section, key)] = (kind, size)
+        else:
+            raise ValueError(f"Corrupted binary checkpoint {path}")
+    return cpt, raw_types
+
+
+def read_text(path):
+    cpt = new_config()
+    with open(path) as f:
+        cpt.read_file(f)
+    return cpt
+
+
+def write_binary(cpt, path, raw_types={}):
+    """Write a ConfigParser as a binary checkpoint.
+
+    Entries listed in raw_types are stored as raw arrays if their values
+    still fit the type they had, and as text otherwise.
+    """
+
+    def string(value):
+        data = value.encode()
+        return struct.pack("=I", len(data)) + data
+
+    out = [MAGIC, struct.pack("=I", VERSION)]
+    for section in cpt.sections():
+        out += [b"S", string(section)]
+        for key, value in cpt.items(section):
+            raw = raw_types.get((section, key))
+            if raw:
+                kind, size = raw
+                fmt = RAW_FORMATS[raw]
+                try:
+                    conv = float if kind == "f" else int
+                    values = [conv(v) for v in value.split()]
+                    data = struct.pack(f"={len(values)}{fmt}", *values)
+                except (ValueError, struct.error):
+                    raw = None
+            if raw:
+                out += [b"R", string(key), kind.encode()]
+                out += [struct.pack("=BQ", size, len(values)), data]
+            else:
+                out += [b"E\0", string(key), string(value)]
+
+    with open(path, "wb") as f:
+        f.write(b"".join(out))
+
+
+def write_text(cpt, path):
+    with open(path, "w") as f:
+        cpt.write(f)
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(f"Usage: {sys.argv[0]} <m5.cpt> <output>")
+
+    if is_binary(sys.argv[1]):
+        cpt, _ = read_binary(sys.argv[1])
+        write_text(cpt, sys.argv[2])
+    else:
+        write_binary(read_text(sys.argv[1]), sys.argv[2])
+
+
+if __name__ == "__main__":
+    main()
@@ -76,6 +76,8 @@ import os.path as osp
 import sys
 import types
 
+import cpt_convert
+
 verbose_print = False
 
 
@@ -205,15 +207,21 @@ def process_file(path, **kwargs):
 
         shutil.copyfile(path, path + ".bak")
 
-    cpt = configparser.ConfigParser()
+    # Binary checkpoints are upgraded through their text representation
+    # and written back in the binary format.
+    binary = cpt_convert.is_binary(path)
+    if binary:
+        cpt, raw_types = cpt_convert.read_binary(path)
+    else:
+        cpt = configparser.ConfigParser()
 
-    # gem5 is case sensitive with paramaters
-    cpt.optionxform = str
+        # gem5 is case sensitive with paramaters
+        cpt.optionxform = str
 
-    # Read the current data
-    cpt_file = open(path)
-    cpt.read_file(cpt_file)
-    cpt_file.close()
+        # Read the current data
+        cpt_file = open(path)
+        cpt.read_file(cpt_file)
+        cpt_file.close()
 
     change = False
 
@@ -276,7 +284,10 @@ def process_file(path, **kwargs):
 
     # Write the old data back
     verboseprint("...completed")
-    cpt.write(open(path, "w"))
+    if binary:
+        cpt_convert.write_binary(cpt, path, raw_types)
+    else:
+        cpt.write(open(path, "w"))
 
 
 if __name__ == "__main__":
@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Host-time and accuracy benchmarks for the CPU models.
+
+Runs a fixed set of SE workloads on each requested ISA and CPU model and
+reports, per run, the host seconds, the simulated instructions per host
+second, the peak resident set size of the gem5 process and the simulated
+time. Results are written as JSON so they can be tracked per commit, and
+can be compared against an earlier result file to catch regressions.
+
+Example
+-------
+
+```
+util/cpu-benchmark/benchmark.py --gem5 build/ALL/gem5.opt \\
+    --isa x86 --isa riscv --output results.json
+util/cpu-benchmark/benchmark.py --gem5 build/ALL/gem5.opt \\
+    --compare results.json
+```
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.request
+from pathlib import Path
+
+RESULTS_VERSION = 1
+
+RESOURCE_URL = "http://dist.gem5.org/dist/develop/test-progs/cpu-tests/bin"
+
+# The workloads of tests/gem5/cpu_tests. They are small, deterministic and
+# exist for every ISA with more than one CPU model.
+WORKLOADS = ("Bubblesort", "FloatMM")
+
+ISAS = ("x86", "arm", "riscv")
+
+CPUS = ("atomic", "timing", "minor", "o3", "kvm")
+
+# The host ISA that KVM can accelerate, if any.
+KVM_ISA = {"x86_64": "x86", "aarch64": "arm"}.get(platform.machine())
+
+# Stats taken from the first dump of stats.txt.
+STATS = {
+    "simInsts": "sim_insts",
+    "simOps": "sim_ops",
+    "simSeconds": "sim_seconds",
+    "simTicks": "sim_ticks",
+    "hostSeconds": "host_seconds_stats",
+}
+
+
+def supported(isa, cpu):
+    """The MinorCPU doesn't support x86, and KVM needs a matching host."""
+    if cpu == "minor":
+        return isa != "x86"
+    if cpu == "kvm":
+        return isa == KVM_ISA and os.access("/dev/kvm", os.R_OK | os.W_OK)
+    return True
+
+
+def fetch_workload(bin_dir, isa, workload):
+    path = bin_dir / isa / workload
+    if not path.exists():
+        path.parent.mkdir(parents=True, exist_ok=True)
+        url = f"{RESOURCE_URL}/{isa}/{workload}"
+        print(f"Downloading {url}", file=sys.stderr)
+        tmp = path.with_suffix(".part")
+        urllib.request.urlretrieve(url, tmp)
+        tmp.chmod(0o755)
+        tmp.rename(path)
+    return path
+
+
+def parse_stats(stats_file):
+    stats = {}
+    with open(stats_file) as f:
+        for line in f:
+            if line.startswith("---------- End Simulation Statistics"):
+                break
+            fields = line.split()
+            if len(fields) >= 2 and fields[0] in STATS:
+                stats[STATS[fields[0]]] = float(fields[1])
+    return stats
+
+
+def run_one(args, isa, cpu, workload, binary):
+    result = {"isa": isa, "cpu": cpu, "workload": workload}
+    with tempfile.TemporaryDirectory(prefix="gem5-bench-") as outdir:
+        cmd = [
+            args.gem5,
+            f"--outdir={outdir}",
+            str(Path(__file__).with_name("config.py")),
+            f"--isa={isa}",
+            f"--cpu={cpu}",
+            str(binary),
+        ]
+        start = time.perf_counter()
+        with open(Path(outdir) / "output.log", "w") as log:
+            proc = subprocess.Popen(
+                cmd, stdout=log, stderr=subprocess.STDOUT
+            )
+            # wait4 gives the resource usage of this child alone.
+            _, status, rusage = os.wait4(proc.pid, 0)
+            proc.returncode = os.waitstatus_to_exitcode(status)
+        host_seconds = time.perf_counter() - start
+
+        result["host_seconds"] = host_seconds
+        # ru_maxrss is in KiB on Linux.
+        result["peak_rss_kib"] = rusage.ru_maxrss
+
+        exit_code = proc.returncode
+        stats_file = Path(outdir) / "stats.txt"
+        if exit_code != 0 or not stats_file.exists():
+            result["status"] = "failed"
+            result["exit_code"] = exit_code
+            with open(Path(outdir) / "output.log") as log:
+                result["log_tail"] = log.read()[-2000:]
+            return result
+
+        result.update(parse_stats(stats_file))
+    result["status"] = "ok"
+    if "sim_insts" in result and host_seconds > 0:
+        result["host_inst_rate"] = result["sim_insts"] / host_seconds
+    return result
+
+
+def git_commit():
+    try:
+        return subprocess.check_output(
+            ["git", "rev-parse", "HEAD"],
+            cwd=Path(__file__).parent,
+            stderr=subprocess.DEVNULL,
+            text=True,
+        ).strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def best_runs(results):
+    """Keep the fastest successful run of each configuration."""
+    best = {}
+    for r in results:
+        if r["status"] != "ok":
+            continue
+        key = (r["isa"], r["cpu"], r["workload"])
+        if key not in best or r["host_seconds"] < best[key]["host_seconds"]:
+            best[key] = r
+    return best
+
+
+def compare(old, new, threshold):
+    """
+    Report differences against earlier results. A run regresses if its
+    instruction rate dropped by more than the threshold. Changes in
+    simulated time are flagged too: the workloads are deterministic, so
+    a change there means the model's behavior changed.
+    """
+    old_best = best_runs(old["results"])
+    regressions = 0
+    for key, r in sorted(best_runs(new["results"]).items()):
+        if key not in old_best:
+            continue
+        o = old_best[key]
+        name = "/".join(key)
+        speedup = r["host_inst_rate"] / o["host_inst_rate"]
+        line = f"{name:32} {speedup:6.2f}x host speed"
+        if speedup < 1.0 - threshold:
+            line += "  REGRESSION"
+            regressions += 1
+        if r.get("sim_ticks") != o.get("sim_ticks"):
+            line += f"  sim_ticks {o.get('sim_ticks')} -> {r.get('sim_ticks')}"
+        print(line)
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawTextHelpFormatter
+    )
+    parser.add_argument(
+        "--gem5", required=True, help="The gem5 binary (e.g., ALL/gem5.opt)."
+    )
+    parser.add_argument(
+        "--isa",
+        action="append",
+        choices=ISAS,
+        help="ISA to benchmark. May be repeated. Defaults to all.",
+    )
+    parser.add_argument(
+        "--cpu",
+        action="append",
+        choices=CPUS,
+        help="CPU model to benchmark. May be repeated. Defaults to all "
+        "models supported by each ISA and the host.",
+    )
+    parser.add_argument(
+        "--workload",
+        action="append",
+        choices=WORKLOADS,
+        help="Workload to run. May be repeated. Defaults to all.",
+    )
+    parser.add_argument(
+        "--repeat",
+        type=int,
+        default=1,
+        help="Number of times to run each configuration.",
+    )
+    parser.add_argument(
+        "--bin-dir",
+        type=Path,
+        default=Path.home() / ".cache" / "gem5-cpu-benchmark",
+        help="Where to cache the workload binaries.",
+    )
+    parser.add_argument(
+        "--output", type=Path, help="Write the results to this JSON file."
+    )
+    parser.add_argument(
+        "--compare",
+        type=Path,
+        help="Compare against an earlier result file and exit with an "
+        "error if any configuration regressed.",
+    )
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="Relative slowdown tolerated by --compare.",
+    )
+    args = parser.parse_args()
+
+    results = []
+    for isa in args.isa or ISAS:
+        for cpu in args.cpu or CPUS:
+            if not supported(isa, cpu):
+                continue
+            for workload in args.workload or WORKLOADS:
+                binary = fetch_workload(args.bin_dir, isa, workload)
+                for _ in range(args.repeat):
+                    r = run_one(args, isa, cpu, workload, binary)
+                    rate = r.get("host_inst_rate", 0) / 1e6
+                    print(
+                        f"{isa}/{cpu}/{workload}: {r['status']}, "
+                        f"{r['host_seconds']:.2f}s, {rate:.3f} MIPS, "
+                        f"{r['peak_rss_kib'] / 1024:.0f} MiB",
+                        file=sys.stderr,
+                    )
+                    results.append(r)
+
+    report = {
+        "version": RESULTS_VERSION,
+        "commit": git_commit(),
+        "gem5": os.path.abspath(args.gem5),
+        "date": datetime.datetime.now(datetime.timezone.utc).isoformat(),
+        "host": {
+            "machine": platform.machine(),
+            "processor": platform.processor(),
+            "system": platform.system(),
+            "release": platform.release(),
+            "python": platform.python_version(),
+        },
+        "results": results,
+    }
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(report, f, indent=2)
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        print()
+
+    failed = sum(r["status"] != "ok" for r in results)
+    if args.compare:
+        with open(args.compare) as f:
+            old = json.load(f)
+        if old.get("version") != RESULTS_VERSION:
+            sys.exit(f"{args.compare}: unsupported results version")
+        if compare(old, report, args.threshold):
+            sys.exit(1)
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
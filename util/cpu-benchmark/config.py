@@ -0,0 +1,101 @@
+# Copyright (c) 2022 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+gem5 configuration used by ``benchmark.py`` to run one SE binary on one
+CPU model. The memory system is kept fixed so that differences between
+runs come from the CPU model (and the simulator) only.
+
+Usage
+-----
+
+```
+gem5.opt util/cpu-benchmark/config.py --isa x86 --cpu o3 <binary>
+```
+"""
+
+import argparse
+
+from gem5.components.boards.simple_board import SimpleBoard
+from gem5.components.cachehierarchies.classic.no_cache import NoCache
+from gem5.components.cachehierarchies.classic.private_l1_private_l2_cache_hierarchy import (
+    PrivateL1PrivateL2CacheHierarchy,
+)
+from gem5.components.memory import SingleChannelDDR3_1600
+from gem5.components.processors.cpu_types import (
+    CPUTypes,
+    get_cpu_type_from_str,
+    get_cpu_types_str_set,
+)
+from gem5.components.processors.simple_processor import SimpleProcessor
+from gem5.isas import (
+    get_isa_from_str,
+    get_isas_str_set,
+)
+from gem5.resources.resource import BinaryResource
+from gem5.simulate.simulator import Simulator
+
+parser = argparse.ArgumentParser()
+parser.add_argument("binary", type=str, help="The SE binary to run.")
+parser.add_argument(
+    "--isa", required=True, choices=get_isas_str_set(), help="The ISA."
+)
+parser.add_argument(
+    "--cpu",
+    required=True,
+    choices=get_cpu_types_str_set(),
+    help="The CPU model.",
+)
+args = parser.parse_args()
+
+cpu_type = get_cpu_type_from_str(args.cpu)
+
+# The atomic and KVM CPUs can't use the classic caches in timing mode, so
+# they run straight from memory.
+if cpu_type in (CPUTypes.ATOMIC, CPUTypes.KVM):
+    cache_hierarchy = NoCache()
+else:
+    cache_hierarchy = PrivateL1PrivateL2CacheHierarchy(
+        l1d_size="32KiB", l1i_size="32KiB", l2_size="512KiB"
+    )
+
+board = SimpleBoard(
+    clk_freq="3GHz",
+    processor=SimpleProcessor(
+        cpu_type=cpu_type, isa=get_isa_from_str(args.isa), num_cores=1
+    ),
+    memory=SingleChannelDDR3_1600(size="512MiB"),
+    cache_hierarchy=cache_hierarchy,
+)
+board.set_se_binary_workload(BinaryResource(local_path=args.binary))
+
+simulator = Simulator(board=board)
+simulator.run()
+
+print(
+    f"Exiting @ tick {simulator.get_current_tick()} because "
+    f"{simulator.get_last_exit_event_cause()}."
+)
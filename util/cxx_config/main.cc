@@ -62,7 +62,9 @@
 #include "base/str.hh"
 #include "base/trace.hh"
 #include "cpu/base.hh"
+#include "sim/cxx_config_bin.hh"
 #include "sim/cxx_config_ini.hh"
+#include "sim/cxx_config_json.hh"
 #include "sim/cxx_manager.hh"
 #include "sim/init_signals.hh"
 #include "sim/serialize.hh"
@@ -78,7 +80,7 @@ void
 usage(const std::string &prog_name)
 {
     std::cerr << "Usage: " << prog_name << (
-        " <config-file.ini> [ <option> ]\n\n"
+        " <config-file.ini|bin|json> [ <option> ]\n\n"
         "OPTIONS:\n"
         "    -p <object> <param> <value>  -- set a parameter\n"
         "    -v <object> <param> <values> -- set a vector parameter from"
@@ -123,7 +125,13 @@ main(int argc, char **argv)
 
     const std::string config_file(argv[arg_ptr]);
 
-    CxxConfigFileBase *conf = new CxxIniFile();
+    CxxConfigFileBase *conf;
+    if (CxxBinFile::isBinFile(config_file))
+        conf = new CxxBinFile();
+    else if (CxxJsonFile::isJsonFile(config_file))
+        conf = new CxxJsonFile();
+    else
+        conf = new CxxIniFile();
 
     if (!conf->load(config_file.c_str())) {
         std::cerr << "Can't open config file: " << config_file << '\n';
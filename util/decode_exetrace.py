@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a binary instruction trace written by the
+# BinExeTracer back into text, along the lines of the ExeTracer output.
+# The disassembly comes from the table of instructions written next to
+# the trace, in a file named after it with an ".insts" suffix.
+#
+# Usage: decode_exetrace.py <trace> [<output>]
+
+import gzip
+import struct
+import sys
+
+MAGIC = b"gem5bxt1"
+
+DATA_VALID = 1 << 0
+MEM_VALID = 1 << 1
+PREDICATED_FALSE = 1 << 2
+FAULTING = 1 << 3
+
+# tick, pc, inst id, micro-pc, context id, flags
+HEADER = struct.Struct("<QQIHHB")
+VALUE = struct.Struct("<Q")
+
+
+def open_file(name, mode):
+    if name.endswith(".gz"):
+        return gzip.open(name, mode)
+    return open(name, mode)
+
+
+def read_table(trace_name):
+    table_name = trace_name
+    if table_name.endswith(".gz"):
+        table_name = table_name[:-3]
+    insts = {}
+    with open(table_name + ".insts") as table:
+        for line in table:
+            inst_id, _, disasm = line.rstrip("\n").split("\t", 2)
+            insts[int(inst_id)] = disasm
+    return insts
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print("Usage: %s <trace> [<output>]" % sys.argv[0])
+        exit(-1)
+
+    insts = read_table(sys.argv[1])
+    out = open(sys.argv[2], "w") if len(sys.argv) == 3 else sys.stdout
+
+    with open_file(sys.argv[1], "rb") as trace:
+        if trace.read(len(MAGIC)) != MAGIC:
+            print("%s is not a binary instruction trace" % sys.argv[1])
+            exit(-1)
+
+        while True:
+            header = trace.read(HEADER.size)
+            if len(header) < HEADER.size:
+                break
+            tick, pc, inst_id, upc, context, flags = HEADER.unpack(header)
+
+            line = "%d: C%d : %#x.%2d : %-26s" % (
+                tick,
+                context,
+                pc,
+                upc,
+                insts.get(inst_id, "unknown"),
+            )
+            if flags & PREDICATED_FALSE:
+                line += " : Predicated False"
+            if flags & DATA_VALID:
+                (data,) = VALUE.unpack(trace.read(VALUE.size))
+                line += " : D=%#018x" % data
+            if flags & MEM_VALID:
+                (addr,) = VALUE.unpack(trace.read(VALUE.size))
+                line += " A=%#x" % addr
+            if flags & FAULTING:
+                line += " (faulting)"
+            out.write(line + "\n")
+
+
+if __name__ == "__main__":
+    main()
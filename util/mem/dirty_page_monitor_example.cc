@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "shared_memory_client.hh"
+
+/**
+ * Watch the pages written in a range of the simulated physical memory,
+ * while the simulation keeps running.
+ *
+ * With a SharedMemoryServer with server_path=ram.sock and a memory with
+ * shared_backstore set in the same System, run e.g.
+ * `./dirty_page_monitor_example m5out/ram.sock 0x0 0xfffffff`
+ *
+ * Every notification is printed along with the first word of each dirty
+ * page, read straight from the mapping of the backing store.
+ */
+
+int
+main(int argc, char *argv[])
+{
+    if (argc != 4) {
+        std::cerr << "Usage: " << argv[0] << " <shm_sock_path> <start> <end>"
+                  << std::endl;
+        return 1;
+    }
+
+    gem5::util::memory::SharedMemoryClient shm_client(argv[1]);
+    uint64_t start = std::stoull(argv[2], nullptr, 0);
+    uint64_t end = std::stoull(argv[3], nullptr, 0);
+
+    // Map the range, so that the dirty pages can be inspected without
+    // going through gem5 at all.
+    char *mem = reinterpret_cast<char *>(shm_client.MapMemory(start, end));
+    if (mem == nullptr) {
+        std::cerr << "Unable to map memory" << std::endl;
+        return 1;
+    }
+
+    uint64_t page_size = 0;
+    int sub_fd = shm_client.SubscribeDirtyPages(start, end, &page_size);
+    if (sub_fd < 0) {
+        std::cerr << "Unable to subscribe to dirty pages" << std::endl;
+        return 1;
+    }
+    std::cout << "Tracking dirty pages of " << page_size << " bytes"
+              << std::endl;
+
+    uint64_t tick;
+    std::vector<uint64_t> pages;
+    while (gem5::util::memory::SharedMemoryClient::ReadDirtyPages(
+                sub_fd, &tick, &pages)) {
+        std::printf("tick %" PRIu64 ": %zu dirty pages\n", tick,
+                    pages.size());
+        for (uint64_t page : pages) {
+            // A page may stick out of the range on either side.
+            uint64_t addr = page < start ? start : page;
+            if (addr > end || addr + sizeof(uint64_t) - 1 > end)
+                continue;
+            uint64_t word;
+            memcpy(&word, mem + (addr - start), sizeof(word));
+            std::printf("  %#" PRIx64 ": %#018" PRIx64 "\n", page, word);
+        }
+    }
+
+    std::cout << "Subscription ended" << std::endl;
+    close(sub_fd);
+    gem5::util::memory::SharedMemoryClient::UnmapMemory(mem);
+    return 0;
+}
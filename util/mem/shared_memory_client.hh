@@ -34,6 +34,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <err.h>
 #include <errno.h>
@@ -55,7 +56,8 @@ class SharedMemoryClient
   public:
     enum RequestType : int
     {
-        kGetPhysRange = 0
+        kGetPhysRange = 0,
+        kSubscribeDirtyPages = 1
     };
 
     explicit SharedMemoryClient(const std::string& server_path);
@@ -71,6 +73,26 @@ class SharedMemoryClient
     // Unmap previous mapped region, no client is needed here.
     static bool UnmapMemory(void* mem);
 
+    // Subscribe to the notifications of the pages written in the range
+    // [start, end] of physical memory. Pages are reported at the
+    // granularity returned through ptr_page_size, by their start address.
+    // A notification covers the pages written since the previous one, and
+    // is sent periodically in simulated time (dirty_page_period of the
+    // server) if any page was written. Only writes that reach the memory
+    // are reported: data still held in the simulated caches is not in
+    // the backing store either, and KVM CPUs write behind the back of the
+    // memory. Return a descriptor to read the notifications from with
+    // ReadDirtyPages, or -1 on error. Close the descriptor to unsubscribe.
+    int SubscribeDirtyPages(uint64_t start, uint64_t end,
+                            uint64_t* ptr_page_size);
+
+    // Wait for the next notification on a subscription. On success, the
+    // simulated tick the notification was sent at is written to ptr_tick
+    // and the page addresses to pages. Return false if the subscription
+    // ended (e.g. the simulation exited).
+    static bool ReadDirtyPages(int sub_fd, uint64_t* ptr_tick,
+                               std::vector<uint64_t>* pages);
+
   private:
     using AllocRecordStorage = std::unordered_map<void*, size_t>;
 
@@ -80,6 +102,7 @@ class SharedMemoryClient
     void* DoMap(int shm_fd, off_t shm_offset, size_t size);
 
     bool SendAll(int sock_fd, const void* buffer, size_t size);
+    static bool RecvAll(int sock_fd, void* buffer, size_t size);
 
     static AllocRecordStorage& GetAllocRecordStorage();
 
@@ -151,6 +174,70 @@ SharedMemoryClient::UnmapMemory(void* mem)
     return true;
 }
 
+inline int
+SharedMemoryClient::SubscribeDirtyPages(uint64_t start, uint64_t end,
+                                        uint64_t* ptr_page_size)
+{
+    if (start > end) {
+        warnx("invalid range %" PRIu64 "-%" PRIu64, start, end);
+        return -1;
+    }
+    int sock_fd = GetConnection();
+    if (sock_fd < 0) {
+        warnx("cannot connect to shared memory server");
+        return -1;
+    }
+
+    int req_type = RequestType::kSubscribeDirtyPages;
+    struct
+    {
+        uint64_t start;
+        uint64_t end;
+    } request = {start, end};
+    uint64_t page_size = 0;
+    if (!SendAll(sock_fd, &req_type, sizeof(req_type)) ||
+        !SendAll(sock_fd, &request, sizeof(request)) ||
+        !RecvAll(sock_fd, &page_size, sizeof(page_size))) {
+        warnx("dirty page subscription failed");
+        close(sock_fd);
+        return -1;
+    }
+    if (page_size == 0) {
+        warnx("dirty page subscription refused");
+        close(sock_fd);
+        return -1;
+    }
+
+    if (ptr_page_size) {
+        *ptr_page_size = page_size;
+    }
+    return sock_fd;
+}
+
+inline bool
+SharedMemoryClient::ReadDirtyPages(int sub_fd, uint64_t* ptr_tick,
+                                   std::vector<uint64_t>* pages)
+{
+    // Same layout as SharedMemoryServer::DirtyPageHeader.
+    struct
+    {
+        uint64_t tick;
+        uint64_t num_pages;
+    } header;
+    if (!RecvAll(sub_fd, &header, sizeof(header))) {
+        return false;
+    }
+    pages->resize(header.num_pages);
+    if (!RecvAll(sub_fd, pages->data(),
+                 header.num_pages * sizeof(uint64_t))) {
+        return false;
+    }
+    if (ptr_tick) {
+        *ptr_tick = header.tick;
+    }
+    return true;
+}
+
 inline int
 SharedMemoryClient::GetConnection()
 {
@@ -264,6 +351,24 @@ SharedMemoryClient::SendAll(int sock_fd, const void* buffer, size_t size)
     return true;
 }
 
+inline bool
+SharedMemoryClient::RecvAll(int sock_fd, void* buffer, size_t size)
+{
+    char* char_buffer = reinterpret_cast<char*>(buffer);
+    for (size_t offset = 0; offset < size;) {
+        ssize_t retv = recv(sock_fd, char_buffer + offset, size - offset, 0);
+        if (retv > 0) {
+            offset += retv;
+        } else if (retv == 0) {
+            return false;
+        } else if (errno != EINTR) {
+            warn("recv failed");
+            return false;
+        }
+    }
+    return true;
+}
+
 inline SharedMemoryClient::AllocRecordStorage&
 SharedMemoryClient::GetAllocRecordStorage()
 {
@@ -36,34 +36,115 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 import argparse
+import os
 import subprocess
 import sys
+from collections import defaultdict
+from concurrent.futures import ThreadPoolExecutor
 
 parser = argparse.ArgumentParser()
 
-# This script lets the user run a soak test using the false-sharing
-# memtest.py example script. It runs a number of iterations with
-# random tree topologies generated for each run, and runs for a number
-# of ticks. Both the iteration count and the ticks for each run can be
-# set on the command line.
 
 parser.add_argument("-c", "--count", type=int, default=100)
 parser.add_argument("-t", "--ticks", type=int, default=100000000000)
+parser.add_argument(
+    "-j",
+    "--jobs",
+    type=int,
+    default=1,
+    help="Number of gem5 processes to run at the same time",
+)
+parser.add_argument(
+    "-n",
+    "--num-systems",
+    type=int,
+    default=1,
+    help="Number of independent tester systems simulated by each "
+    "memtest.py process, each of them on its own host thread",
+)
+parser.add_argument(
+    "--config",
+    default=None,
+    help="Run this config script (e.g., one of the Ruby testers) with "
+    "the extra arguments instead of memtest.py",
+)
+parser.add_argument(
+    "-d",
+    "--outdir",
+    default="m5out-soak",
+    help="Every run writes its output to a RUN subdirectory of this",
+)
+parser.add_argument(
+    "--coverage",
+    action="store_true",
+    help="Report how many times each possible Ruby protocol transition "
+    "was taken, combined over all the runs",
+)
 parser.add_argument("binary")
+parser.add_argument("extra", nargs="*", help="Arguments of --config")
 
 args = parser.parse_args()
 
-for i in range(args.count):
-    status = subprocess.call(
-        [
-            args.binary,
+
+def run(i):
+    outdir = os.path.join(args.outdir, str(i))
+    cmd = [
+        args.binary,
+        "-d",
+        outdir,
+        "--random-seed",
+        str(i + 1),
+    ]
+    if args.config:
+        cmd += [args.config] + args.extra
+    else:
+        cmd += [
             "configs/example/memtest.py",
             "-r",
             "-m %d" % (args.ticks),
+            "-n %d" % (args.num_systems),
         ]
-    )
-    if status != 0:
-        print("Error: memtest run failed\n")
-        sys.exit(1)
+    with open(os.path.join(args.outdir, f"{i}.log"), "w") as log:
+        return subprocess.call(cmd, stdout=log, stderr=subprocess.STDOUT)
+
+
+# Every Ruby run writes a "<machine> <state> <event> <count>" line per
+# possible transition to ruby_coverage.txt (see RubySystem.coverage_file)
+def add_transitions(coverage_file, transitions):
+    with open(coverage_file) as f:
+        for line in f:
+            fields = line.split("#")[0].split()
+            if len(fields) != 4:
+                continue
+            transitions[tuple(fields[:3])] += int(fields[3])
+
+
+os.makedirs(args.outdir, exist_ok=True)
+
+failed = []
+with ThreadPoolExecutor(max_workers=args.jobs) as executor:
+    for i, status in enumerate(executor.map(run, range(args.count))):
+        if status != 0:
+            failed.append(i)
+            print(f"Error: run {i} failed, see {args.outdir}/{i}.log")
+
+if args.coverage:
+    transitions = defaultdict(int)
+    for i in range(args.count):
+        coverage_file = os.path.join(
+            args.outdir, str(i), "ruby_coverage.txt"
+        )
+        if os.path.exists(coverage_file):
+            add_transitions(coverage_file, transitions)
+
+    print("Transitions (controller, state, event, times taken):")
+    for (machine, state, event), count in sorted(transitions.items()):
+        print(f"{machine:>16} {state:>16} {event:>24} {count:>12}")
+    taken = sum(1 for count in transitions.values() if count)
+    print(f"{taken} of {len(transitions)} possible transitions taken")
+
+if failed:
+    print(f"Error: {len(failed)} of {args.count} runs failed")
+    sys.exit(1)
 
-print("memtest soak finished without errors")
+print("soak finished without errors")
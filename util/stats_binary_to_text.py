@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Convert a binary statistics file (written when stats are dumped to a
+# "bin://" URL) into the stats.txt-like text format.
+#
+# Usage: stats_binary_to_text.py <stats.bin> [<stats.txt>]
+
+import struct
+import sys
+
+MAGIC = b"gem5stb\0"
+VERSION = 1
+
+SCHEMA_RECORD = 1
+DATA_RECORD = 2
+
+SCALAR, VECTOR, FORMULA, VECTOR2D, DIST, VECTOR_DIST, SPARSE_HIST = range(7)
+
+DIST_FIELDS = 12
+DIST_NAMES = (
+    "type",
+    "min",
+    "max",
+    "bucket_size",
+    "min_val",
+    "max_val",
+    "underflow",
+    "overflow",
+    "sum",
+    "squares",
+    "logs",
+    "samples",
+)
+
+
+class Reader:
+    def __init__(self, buf):
+        self.buf = buf
+        self.pos = 0
+
+    def unpack(self, fmt):
+        values = struct.unpack_from("<" + fmt, self.buf, self.pos)
+        self.pos += struct.calcsize("<" + fmt)
+        return values
+
+    def u32(self):
+        return self.unpack("I")[0]
+
+    def string(self):
+        size = self.u32()
+        value = self.buf[self.pos : self.pos + size].decode()
+        self.pos += size
+        return value
+
+    def strings(self):
+        return [self.string() for _ in range(self.u32())]
+
+
+class Stat:
+    def __init__(self, reader):
+        self.kind = reader.unpack("B")[0]
+        self.name = reader.string()
+        self.desc = reader.string()
+        self.unit = reader.string()
+        self.flags, self.precision = reader.unpack("Ii")
+        self.subnames = []
+        self.y_subnames = []
+        self.buckets = 0
+        self.count = 1
+        if self.kind in (VECTOR, FORMULA):
+            self.subnames = reader.strings()
+            self.count = len(self.subnames)
+        elif self.kind == VECTOR2D:
+            self.x, self.y = reader.unpack("II")
+            self.subnames = reader.strings()
+            self.y_subnames = reader.strings()
+        elif self.kind == DIST:
+            self.buckets = reader.u32()
+        elif self.kind == VECTOR_DIST:
+            self.count, self.buckets = reader.unpack("II")
+            self.subnames = reader.strings()
+
+    def subname(self, i):
+        if i < len(self.subnames) and self.subnames[i]:
+            return self.subnames[i]
+        return str(i)
+
+
+def fmt(value):
+    if value == int(value):
+        return str(int(value))
+    return f"{value:.6f}"
+
+
+def line(out, name, value, stat):
+    out.write(f"{name:<52} {value:>12} # {stat.desc} ({stat.unit})\n")
+
+
+def dist(out, name, stat, values, pos):
+    data = dict(zip(DIST_NAMES, values[pos : pos + DIST_FIELDS]))
+    cvec = values[pos + DIST_FIELDS : pos + DIST_FIELDS + stat.buckets]
+    samples = data["samples"]
+    line(out, f"{name}::samples", fmt(samples), stat)
+    if samples:
+        line(out, f"{name}::mean", fmt(data["sum"] / samples), stat)
+    for i, count in enumerate(cvec):
+        low = data["min"] + i * data["bucket_size"]
+        if data["bucket_size"] > 1:
+            bucket = f"{fmt(low)}-{fmt(low + data['bucket_size'] - 1)}"
+        else:
+            bucket = fmt(low)
+        line(out, f"{name}::{bucket}", fmt(count), stat)
+    line(out, f"{name}::total", fmt(samples), stat)
+    return pos + DIST_FIELDS + stat.buckets
+
+
+def dump(out, schema, values):
+    out.write("\n---------- Begin Simulation Statistics ----------\n")
+    pos = 0
+    for stat in schema:
+        if stat.kind == SCALAR:
+            line(out, stat.name, fmt(values[pos]), stat)
+            pos += 1
+        elif stat.kind in (VECTOR, FORMULA):
+            for i in range(stat.count):
+                name = f"{stat.name}::{stat.subname(i)}"
+                line(out, name, fmt(values[pos + i]), stat)
+            pos += stat.count
+            line(out, f"{stat.name}::total", fmt(values[pos]), stat)
+            pos += 1
+        elif stat.kind == VECTOR2D:
+            for i in range(stat.x):
+                for j in range(stat.y):
+                    y = stat.y_subnames[j] if stat.y_subnames[j] else str(j)
+                    name = f"{stat.name}::{stat.subname(i)}::{y}"
+                    line(out, name, fmt(values[pos + i * stat.y + j]), stat)
+            pos += stat.x * stat.y
+            line(out, f"{stat.name}::total", fmt(values[pos]), stat)
+            pos += 1
+        elif stat.kind == DIST:
+            pos = dist(out, stat.name, stat, values, pos)
+        elif stat.kind == VECTOR_DIST:
+            for i in range(stat.count):
+                name = f"{stat.name}::{stat.subname(i)}"
+                pos = dist(out, name, stat, values, pos)
+        elif stat.kind == SPARSE_HIST:
+            samples, pairs = values[pos], int(values[pos + 1])
+            pos += 2
+            line(out, f"{stat.name}::samples", fmt(samples), stat)
+            for i in range(pairs):
+                value, count = values[pos], values[pos + 1]
+                line(out, f"{stat.name}::{fmt(value)}", fmt(count), stat)
+                pos += 2
+        else:
+            sys.exit(f"Unknown statistic kind {stat.kind}")
+    out.write("\n---------- End Simulation Statistics   ----------\n")
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit(f"Usage: {sys.argv[0]} <stats.bin> [<stats.txt>]")
+
+    with open(sys.argv[1], "rb") as f:
+        buf = f.read()
+
+    if buf[: len(MAGIC)] != MAGIC:
+        sys.exit("Not a binary statistics file")
+    reader = Reader(buf)
+    reader.pos = len(MAGIC)
+    if reader.u32() != VERSION:
+        sys.exit("Unsupported binary statistics version")
+
+    out = open(sys.argv[2], "w") if len(sys.argv) == 3 else sys.stdout
+    schema = None
+    while reader.pos < len(buf):
+        kind, size = reader.unpack("IQ")
+        payload = buf[reader.pos : reader.pos + size]
+        reader.pos += size
+        if kind == SCHEMA_RECORD:
+            record = Reader(payload)
+            schema = [Stat(record) for _ in range(record.u32())]
+        elif kind == DATA_RECORD:
+            if schema is None:
+                sys.exit("Data record without a preceding schema")
+            dump(out, schema, struct.unpack(f"<{size // 8}d", payload))
+        else:
+            sys.exit(f"Unknown record type {kind}")
+
+
+if __name__ == "__main__":
+    main()